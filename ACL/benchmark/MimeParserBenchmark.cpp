@@ -0,0 +1,463 @@
+/*
+ * MimeParserBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file MimeParserBenchmark.cpp
+///
+/// Measures the cost per byte of parsing MIME multipart responses from AVS.  Each workload is a set of responses,
+/// which are fed through @c MimeParser::feed() in chunks, as libcurl would deliver them, with attachments written to
+/// an @c IN_PROCESS @c AttachmentManager.  The built-in workloads are a downchannel carrying only JSON directives,
+/// and @c Speak directives with large MP3 attachments.  Responses recorded by @c TrafficRecorder can be given as
+/// extra workloads.
+///
+/// For each workload and chunk size, the benchmark reports the throughput in MB/s, the number of heap allocations per
+/// MB, and how much of the time is spent in @c MultipartParser and in attachment writes.  The @c MultipartParser time
+/// is measured by feeding the same chunks to a bare @c MultipartReader, and the attachment time by writing the same
+/// attachments directly, in pieces of the chunk size.  The rest of the time is the bookkeeping of @c MimeParser and
+/// the delivery of directives.
+///
+/// Usage: MimeParserBenchmark [--quick] [recording...]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/MessageConsumerInterface.h"
+#include "ACL/Transport/MimeParser.h"
+#include "ACL/Transport/TrafficRecorder.h"
+
+/// The number of heap allocations made by the process.
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+namespace alexaClientSDK {
+namespace acl {
+namespace benchmark {
+
+using namespace avsCommon::avs::attachment;
+
+using Clock = std::chrono::steady_clock;
+
+/// The number of bytes in a MB.
+static const double BYTES_PER_MB = 1024.0 * 1024.0;
+
+/// The boundary of the built-in responses.
+static const std::string BOUNDARY = "------abcde123";
+
+/// The largest chunk libcurl delivers to a write callback, @c CURL_MAX_WRITE_SIZE.
+static const size_t CURL_MAX_WRITE_SIZE = 16384;
+
+/// The chunk size which stands for chunks of random sizes up to @c CURL_MAX_WRITE_SIZE, as libcurl delivers them.
+static const size_t RANDOM_CHUNK_SIZE = 0;
+
+/// The chunk sizes to feed, in the order they are reported.
+static const size_t CHUNK_SIZES[] = {CURL_MAX_WRITE_SIZE, 4096, 1024, 256, RANDOM_CHUNK_SIZE};
+
+/// A MIME multipart response.
+struct Response {
+    /// The boundary of the response.
+    std::string boundary;
+
+    /// The body of the response.
+    std::string body;
+};
+
+/// A set of responses to benchmark.
+struct Workload {
+    /// The name printed for the workload.
+    std::string name;
+
+    /// The responses.
+    std::vector<Response> responses;
+};
+
+/**
+ * A @c MessageConsumerInterface which counts the directives it receives.
+ */
+class CountingConsumer : public MessageConsumerInterface {
+public:
+    /// Constructor.
+    CountingConsumer() : m_count{0} {
+    }
+
+    void consumeMessage(const std::string& contextId, const std::string& message) override {
+        ++m_count;
+    }
+
+    /// The number of directives received.
+    size_t m_count;
+};
+
+/**
+ * Build a built-in response.
+ *
+ * @param parts The parts of the response, each a Content-Type, a Content-ID (empty for none) and a body.
+ * @return The response.
+ */
+static Response buildResponse(const std::vector<std::vector<std::string>>& parts) {
+    Response response;
+    response.boundary = BOUNDARY;
+    for (const auto& part : parts) {
+        response.body += "--" + BOUNDARY + "\r\nContent-Type: " + part[0] + "\r\n";
+        if (!part[1].empty()) {
+            response.body += "Content-ID: <" + part[1] + ">\r\nContent-Length: " + std::to_string(part[2].size()) +
+                             "\r\n";
+        }
+        response.body += "\r\n" + part[2] + "\r\n";
+    }
+    response.body += "--" + BOUNDARY + "--\r\n";
+    return response;
+}
+
+/**
+ * Build the JSON of a directive, of roughly the size of the directives AVS sends.
+ *
+ * @param name The name of the directive.
+ * @param index A number making the directive unique.
+ * @param url The url of the attachment of the directive.
+ * @return The JSON of the directive.
+ */
+static std::string buildDirective(const std::string& name, int index, const std::string& url) {
+    auto id = std::to_string(index);
+    return "{\"directive\":{\"header\":{\"namespace\":\"SpeechSynthesizer\",\"name\":\"" + name +
+           "\",\"messageId\":\"5f0a3b6e-8a0d-4b7c-9e61-2c4d7f1a" + id + "\",\"dialogRequestId\":\"" +
+           "0d3c4a5b-6e7f-4801-9a2b-3c4d5e6f" + id + "\"},\"payload\":{\"url\":\"" + url +
+           "\",\"format\":\"AUDIO_MPEG\",\"token\":\"amzn1.as-ct.v1.Domain:Application:Knowledge#ACRI#" + id +
+           "\"}}}";
+}
+
+/**
+ * Build the built-in workloads.
+ *
+ * @return The workloads.
+ */
+static std::vector<Workload> buildWorkloads() {
+    const std::string json = "application/json; charset=UTF-8";
+    const std::string octetStream = "application/octet-stream";
+    std::mt19937 random(1);
+    auto mp3 = [&random](size_t size) {
+        // Compressed audio looks random to the parser.
+        std::string data(size, '\0');
+        for (auto& byte : data) {
+            byte = static_cast<char>(random());
+        }
+        return data;
+    };
+
+    Workload directives{"JSON directives", {}};
+    std::vector<std::vector<std::string>> parts;
+    for (int i = 0; i < 200; ++i) {
+        parts.push_back({json, "", buildDirective("SetMute", i, "")});
+    }
+    directives.responses.push_back(buildResponse(parts));
+
+    Workload speak{"Speak + 512 KB MP3", {}};
+    speak.responses.push_back(buildResponse(
+        {{json, "", buildDirective("Speak", 0, "cid:speech-0")}, {octetStream, "speech-0", mp3(512 * 1024)}}));
+
+    Workload speaks{"3 x (Speak + 96 KB MP3)", {}};
+    parts.clear();
+    for (int i = 0; i < 3; ++i) {
+        auto contentId = "speech-" + std::to_string(i);
+        parts.push_back({json, "", buildDirective("Speak", i, "cid:" + contentId)});
+        parts.push_back({octetStream, contentId, mp3(96 * 1024)});
+    }
+    speaks.responses.push_back(buildResponse(parts));
+
+    return {directives, speak, speaks};
+}
+
+/**
+ * Load a workload from a recording made by @c TrafficRecorder.
+ *
+ * @param path The path of the recording.
+ * @param[out] workload The workload, with a response for each stream recorded.
+ * @return Whether the recording could be loaded.
+ */
+static bool loadWorkload(const std::string& path, Workload* workload) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<TrafficRecorder::Record> records;
+    if (!file || !TrafficRecorder::load(file, &records)) {
+        return false;
+    }
+    workload->name = path.substr(path.find_last_of('/') + 1);
+    std::vector<std::pair<unsigned int, size_t>> streams;
+    for (const auto& record : records) {
+        if (TrafficRecorder::RecordType::STREAM_START == record.type) {
+            streams.push_back({record.streamId, workload->responses.size()});
+            workload->responses.push_back({record.data, ""});
+            continue;
+        }
+        for (auto it = streams.rbegin(); it != streams.rend(); ++it) {
+            if (it->first == record.streamId) {
+                workload->responses[it->second].body += record.data;
+                break;
+            }
+        }
+    }
+    return !workload->responses.empty();
+}
+
+/**
+ * Split a response into the chunks libcurl might deliver it in.
+ *
+ * @param response The response.
+ * @param chunkSize The size of the chunks, or @c RANDOM_CHUNK_SIZE for chunks of random sizes.
+ * @return The sizes of the chunks.
+ */
+static std::vector<size_t> splitIntoChunks(const Response& response, size_t chunkSize) {
+    std::mt19937 random(2);
+    std::uniform_int_distribution<size_t> randomSize(1, CURL_MAX_WRITE_SIZE);
+    std::vector<size_t> chunks;
+    for (size_t offset = 0; offset < response.body.size();) {
+        auto size = std::min(
+            RANDOM_CHUNK_SIZE == chunkSize ? randomSize(random) : chunkSize, response.body.size() - offset);
+        chunks.push_back(size);
+        offset += size;
+    }
+    return chunks;
+}
+
+/// The sizes of the attachments of a response, found by a bare @c MultipartReader.
+struct AttachmentSizes {
+    /// Whether the part being parsed is an attachment.
+    bool isAttachment;
+
+    /// The sizes of the attachments.
+    std::vector<size_t> sizes;
+};
+
+/**
+ * Find the sizes of the attachments of a response.
+ *
+ * @param response The response.
+ * @return The sizes of its attachments.
+ */
+static std::vector<size_t> findAttachmentSizes(const Response& response) {
+    AttachmentSizes attachments{false, {}};
+    MultipartReader reader(response.boundary);
+    reader.userData = &attachments;
+    reader.onPartBegin = [](const MultipartHeaders& headers, void* userData) {
+        auto attachments = static_cast<AttachmentSizes*>(userData);
+        attachments->isAttachment = headers["Content-Type"].find("application/octet-stream") != std::string::npos;
+        if (attachments->isAttachment) {
+            attachments->sizes.push_back(0);
+        }
+    };
+    reader.onPartData = [](const char* buffer, size_t size, void* userData) {
+        auto attachments = static_cast<AttachmentSizes*>(userData);
+        if (attachments->isAttachment) {
+            attachments->sizes.back() += size;
+        }
+    };
+    auto body = response.body;
+    size_t start = body.compare(0, 2, "\r\n") ? 0 : 2;
+    reader.feed(body.data() + start, body.size() - start);
+    return attachments.sizes;
+}
+
+/// The measurements of a workload at a chunk size.
+struct Measurement {
+    /// The time spent in @c MimeParser::feed().
+    Clock::duration feedTime;
+
+    /// The time spent in a bare @c MultipartReader.
+    Clock::duration parserTime;
+
+    /// The time spent writing attachments.
+    Clock::duration attachmentTime;
+
+    /// The heap allocations made in @c MimeParser::feed().
+    size_t allocations;
+};
+
+/**
+ * Feed a workload through @c MimeParser, a bare @c MultipartReader and attachment writes, and add up the time each
+ * takes.
+ *
+ * @param workload The workload.
+ * @param chunkSize The size of the chunks, or @c RANDOM_CHUNK_SIZE for chunks of random sizes.
+ * @param iterations The number of times to feed the workload.
+ * @param[out] measurement The measurements.
+ * @return Whether every response was parsed.
+ */
+static bool measure(const Workload& workload, size_t chunkSize, int iterations, Measurement* measurement) {
+    auto attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    attachmentManager->setUnreferencedAttachmentGracePeriod(std::chrono::milliseconds::zero());
+    auto consumer = std::make_shared<CountingConsumer>();
+    MimeParser parser(consumer, attachmentManager);
+    MultipartReader bareReader;
+    *measurement = {Clock::duration::zero(), Clock::duration::zero(), Clock::duration::zero(), 0};
+
+    std::vector<std::vector<size_t>> chunks;
+    std::vector<std::vector<size_t>> attachmentSizes;
+    std::vector<Response> responses = workload.responses;
+    for (const auto& response : responses) {
+        chunks.push_back(splitIntoChunks(response, chunkSize));
+        attachmentSizes.push_back(findAttachmentSizes(response));
+    }
+    std::vector<char> attachmentChunk(CURL_MAX_WRITE_SIZE);
+    int contextId = 0;
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (size_t i = 0; i < responses.size(); ++i) {
+            auto& body = responses[i].body;
+
+            parser.reset();
+            parser.setBoundaryString(responses[i].boundary);
+            parser.setAttachmentContextId("benchmark" + std::to_string(contextId++));
+            auto allocations = g_allocations.load();
+            auto start = Clock::now();
+            char* data = &body[0];
+            for (auto size : chunks[i]) {
+                if (parser.feed(data, size) != MimeParser::DataParsedStatus::OK) {
+                    return false;
+                }
+                data += size;
+            }
+            measurement->feedTime += Clock::now() - start;
+            measurement->allocations += g_allocations.load() - allocations;
+
+            bareReader.reset();
+            bareReader.setBoundary(responses[i].boundary);
+            start = Clock::now();
+            data = &body[0];
+            size_t skip = body.compare(0, 2, "\r\n") ? 0 : 2;
+            for (auto size : chunks[i]) {
+                bareReader.feed(data + skip, size - skip);
+                data += size;
+                skip = 0;
+            }
+            measurement->parserTime += Clock::now() - start;
+
+            size_t pieceSize = RANDOM_CHUNK_SIZE == chunkSize ? CURL_MAX_WRITE_SIZE / 2 : chunkSize;
+            for (auto attachmentSize : attachmentSizes[i]) {
+                auto id = attachmentManager->generateAttachmentId("direct" + std::to_string(contextId++), "speech");
+                start = Clock::now();
+                auto writer = attachmentManager->createWriter(id, attachmentSize);
+                auto status = AttachmentWriter::WriteStatus::OK;
+                for (size_t offset = 0; writer && offset < attachmentSize; offset += pieceSize) {
+                    writer->write(attachmentChunk.data(), std::min(pieceSize, attachmentSize - offset), &status);
+                }
+                writer.reset();
+                measurement->attachmentTime += Clock::now() - start;
+            }
+            attachmentManager->removeExpiredAttachments();
+        }
+    }
+    return true;
+}
+
+/**
+ * Run a workload at every chunk size and print its results.
+ *
+ * @param workload The workload.
+ * @param bytesToFeed Roughly how many bytes to feed at each chunk size.
+ */
+static void run(const Workload& workload, size_t bytesToFeed) {
+    size_t workloadBytes = 0;
+    for (const auto& response : workload.responses) {
+        workloadBytes += response.body.size();
+    }
+    int iterations = static_cast<int>(std::max<size_t>(1, bytesToFeed / std::max<size_t>(1, workloadBytes)));
+    double megabytes = workloadBytes * iterations / BYTES_PER_MB;
+
+    for (auto chunkSize : CHUNK_SIZES) {
+        std::cout << std::left << std::setw(28) << workload.name << std::right << std::setw(8)
+                  << (RANDOM_CHUNK_SIZE == chunkSize ? std::string("random") : std::to_string(chunkSize));
+        Measurement measurement;
+        if (!measure(workload, chunkSize, iterations, &measurement)) {
+            std::cout << "  parse failed" << std::endl;
+            continue;
+        }
+        auto feedSeconds = std::chrono::duration<double>(measurement.feedTime).count();
+        std::cout << std::fixed << std::setprecision(1) << std::setw(10) << megabytes / feedSeconds << std::setw(12)
+                  << measurement.allocations / megabytes << std::setw(10)
+                  << 100.0 * std::chrono::duration<double>(measurement.parserTime).count() / feedSeconds
+                  << std::setw(10)
+                  << 100.0 * std::chrono::duration<double>(measurement.attachmentTime).count() / feedSeconds
+                  << std::endl;
+    }
+}
+
+/**
+ * Run every workload and print a table of results.
+ *
+ * @param isQuick Whether to feed fewer bytes through each workload.
+ * @param recordings The paths of recordings to run as extra workloads.
+ */
+static void runAll(bool isQuick, const std::vector<std::string>& recordings) {
+    auto workloads = buildWorkloads();
+    for (const auto& path : recordings) {
+        Workload workload;
+        if (!loadWorkload(path, &workload)) {
+            std::cerr << "Cannot load the recording " << path << std::endl;
+            continue;
+        }
+        workloads.push_back(workload);
+    }
+
+    std::cout << "Parser and attachment times are percentages of the time spent in MimeParser::feed()." << std::endl;
+    std::cout << std::left << std::setw(28) << "workload" << std::right << std::setw(8) << "chunk" << std::setw(10)
+              << "MB/s" << std::setw(12) << "allocs/MB" << std::setw(10) << "parser%" << std::setw(10) << "attach%"
+              << std::endl;
+    for (const auto& workload : workloads) {
+        run(workload, (isQuick ? 4 : 64) * 1024 * 1024);
+    }
+}
+
+}  // namespace benchmark
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    bool isQuick = false;
+    std::vector<std::string> recordings;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string("--quick") == argv[i]) {
+            isQuick = true;
+        } else {
+            recordings.push_back(argv[i]);
+        }
+    }
+    // Per-part logging would dominate the measurements.
+    alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_SINK_LOGGER().setLevel(
+        alexaClientSDK::avsCommon::utils::logger::Level::WARN);
+    alexaClientSDK::acl::benchmark::runAll(isQuick, recordings);
+    return EXIT_SUCCESS;
+}
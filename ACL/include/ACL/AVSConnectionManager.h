@@ -30,6 +30,7 @@
 #include <AVSCommon/SDKInterfaces/ConnectionStatusObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
+#include <AVSCommon/SDKInterfaces/UserInactivityObserverInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
 
 #include "ACL/Transport/MessageRouterInterface.h"
@@ -63,6 +64,13 @@ namespace acl {
  *
  * Finally, the client may send outgoing messages to AVS via the non-blocking 'send' function.
  *
+ * Battery powered devices may opt into a low-power mode with 'setLowPowerMode'.  The connection is then pinged less
+ * often, and once this object, added as an observer to a @c UserInactivityMonitor, is told that the user has been
+ * inactive for a while, it closes the connection while staying enabled.  It connects again as soon as the user is
+ * active, 'wake' is called (for example on wake word detection), or a message is sent, which is held until the
+ * connection is up.  Directives which AVS would have sent while the connection was closed, such as those of alerts
+ * set from another device, are not received until then.
+ *
  * Credentials to authenticate the client with AVS must be provided by an implementation of the AuthDelegate class.
  *
  * This SDK also provides observer interfaces for classes that may be notified when the connection status
@@ -72,6 +80,7 @@ class AVSConnectionManager
         : public avsCommon::avs::AbstractConnection
         , public avsCommon::sdkInterfaces::MessageSenderInterface
         , public avsCommon::sdkInterfaces::AVSEndpointAssignerInterface
+        , public avsCommon::sdkInterfaces::UserInactivityObserverInterface
         , public MessageRouterObserverInterface
         , public avsCommon::utils::RequiresShutdown {
 public:
@@ -124,6 +133,36 @@ public:
      */
     void reconnect();
 
+    /**
+     * This function lets the client tell the object that the network has become available, for example when a
+     * network interface comes up.  If the object is enabled but not connected, its waiting policy is reset and it
+     * attempts to connect immediately, abandoning an attempt which may be stalled on the network which went away.
+     * Unlike @c reconnect(), an existing connection is kept.
+     */
+    void onNetworkAvailable();
+
+    /**
+     * Enable or disable the low-power mode, in which the connection is kept alive with fewer pings, and closed while
+     * the user is inactive.  Disabling it wakes the connection up if it was closed for inactivity.
+     *
+     * @param enabled Whether the low-power mode is enabled.
+     */
+    void setLowPowerMode(bool enabled);
+
+    /**
+     * Connect again at once if the connection was closed because of user inactivity in low-power mode, for example
+     * when the wake word is detected, so that the connection is ready by the time the user's request is sent.
+     * Otherwise, this function does nothing.
+     */
+    void wake();
+
+    /**
+     * Returns whether the connection is closed because of user inactivity in low-power mode.
+     *
+     * @return Whether the connection is closed because of user inactivity.
+     */
+    bool isDozing();
+
     bool isConnected() const override;
 
     /**
@@ -148,6 +187,12 @@ public:
      */
     void setAVSEndpoint(const std::string& avsEndpoint) override;
 
+    /// @name UserInactivityObserverInterface functions
+    /// @{
+    void onUserInactive() override;
+    void onUserActiveAgain() override;
+    /// @}
+
 private:
     /**
      * AVSConnectionManager constructor.
@@ -173,9 +218,26 @@ private:
 
     void receive(const std::string& contextId, const std::string& message) override;
 
+    /**
+     * Connect again if the connection was closed because of user inactivity.  Called with @c m_lowPowerMutex held.
+     */
+    void wakeLocked();
+
     /// Internal state to indicate if the Connection object is enabled for making an AVS connection.
     std::atomic<bool> m_isEnabled;
 
+    /// Serializes changes to the members below, together with closing or reopening the connection for them.
+    std::mutex m_lowPowerMutex;
+
+    /// Whether the low-power mode is enabled.  Access serialized with @c m_lowPowerMutex.
+    bool m_isLowPowerMode;
+
+    /**
+     * Whether the connection is closed because of user inactivity.  Only changed with @c m_lowPowerMutex held, but
+     * read without it on each message sent.
+     */
+    std::atomic<bool> m_isDozing;
+
     /// Client-provided message listener, which will receive all messages sent from AVS.
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::MessageObserverInterface>> m_messageObservers;
 
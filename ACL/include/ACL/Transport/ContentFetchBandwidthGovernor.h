@@ -0,0 +1,77 @@
+/*
+ * ContentFetchBandwidthGovernor.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_CONTENT_FETCH_BANDWIDTH_GOVERNOR_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_CONTENT_FETCH_BANDWIDTH_GOVERNOR_H_
+
+#include <atomic>
+#include <memory>
+
+#include <curl/curl.h>
+
+#include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Caps the download rate of the transfers of @c LibCurlHttpContentFetcher instances while the user is speaking to
+ * Alexa or waiting for the response, so that background fetches such as playlist entries, audio content and alert
+ * assets do not starve the @c SpeechRecognizer.Recognize upload and its response on slow links.  The cap is lifted
+ * as soon as the dialog moves on.
+ *
+ * Add the governor as an observer of the @c DialogUXStateAggregator, and give it to the @c HTTPContentFetcherFactory
+ * producing the fetchers to throttle.  The cap applies to transfers which are already running as well as to new ones.
+ */
+class ContentFetchBandwidthGovernor : public avsCommon::sdkInterfaces::DialogUXStateObserverInterface {
+public:
+    /**
+     * Create a @c ContentFetchBandwidthGovernor.
+     *
+     * @param dialogMaxRecvSpeed The largest download rate of each transfer during a dialog, in bytes per second.
+     * @return The new @c ContentFetchBandwidthGovernor, or @c nullptr if @c dialogMaxRecvSpeed is not positive.
+     */
+    static std::shared_ptr<ContentFetchBandwidthGovernor> create(curl_off_t dialogMaxRecvSpeed);
+
+    void onDialogUXStateChanged(DialogUXState newState) override;
+
+    /**
+     * Get the current cap on the download rate of each transfer.
+     *
+     * @return The largest download rate in bytes per second, or @c 0 if the rate is not capped.
+     */
+    curl_off_t getMaxRecvSpeed() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param dialogMaxRecvSpeed The largest download rate of each transfer during a dialog, in bytes per second.
+     */
+    ContentFetchBandwidthGovernor(curl_off_t dialogMaxRecvSpeed);
+
+    /// The largest download rate of each transfer during a dialog, in bytes per second.
+    const curl_off_t m_dialogMaxRecvSpeed;
+
+    /// The current cap, in bytes per second, or @c 0 if the rate is not capped.
+    std::atomic<curl_off_t> m_maxRecvSpeed;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_CONTENT_FETCH_BANDWIDTH_GOVERNOR_H_
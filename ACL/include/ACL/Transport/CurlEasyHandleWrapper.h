@@ -20,7 +20,9 @@
 
 #include <chrono>
 #include <curl/curl.h>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace alexaClientSDK {
 namespace acl {
@@ -73,6 +75,17 @@ public:
      */
     bool reset();
 
+    /**
+     * Prepares an allocated easy handle for re-use in another transfer, without the cost of @c reset().  The options
+     * which are the same for every transfer (callbacks, TLS options, keep-alive and HTTP headers added with
+     * @c addHTTPHeader()) stay set.  The POST headers and form are freed, and the transfer type and timeouts are
+     * cleared.  If the handle can't be re-used, it is reset as by @c reset(), which clears all options.
+     *
+     * @param[out] areOptionsKept Whether the options stayed set.  If @c false, they must be set again.
+     * @return Whether the reset was successful
+     */
+    bool resetForReuse(bool* areOptionsKept);
+
     /**
      * Used to get the underlying CURL easy handle. The handle returned
      * may be a nullptr
@@ -115,14 +128,24 @@ public:
 
     /**
      * Adds a POST field to the current multipart form named @c fieldName with a string
-     * value contained in payload
+     * value contained in payload, with the headers added by @c addPostHeader().
      *
      * @param fieldName The POST field name
-     * @param payload The string to send
+     * @param payload The string to send, which may hold binary data
      * @return Whether the addition was successful
      */
     bool setPostContent(const std::string& fieldName, const std::string& payload);
 
+    /**
+     * Adds a POST field like @c setPostContent(), but sends @c payload in place instead of copying it into the form.
+     * The payload is kept alive until the form is freed.
+     *
+     * @param fieldName The POST field name
+     * @param payload The immutable string to send, which may hold binary data
+     * @return Whether the addition was successful
+     */
+    bool setPostContent(const std::string& fieldName, std::shared_ptr<const std::string> payload);
+
     /**
      * Sets a timeout, in seconds, for how long the stream transfer is allowed to take.
      * If not set explicitly, there will be no timeout.
@@ -153,6 +176,24 @@ public:
      */
     bool setConnectionTimeout(const std::chrono::seconds timeoutSeconds);
 
+    /**
+     * Sets how long libcurl waits for a connection attempt to the preferred address family (normally IPv6) before it
+     * races an attempt to the other one.
+     *
+     * @param timeout How long to wait before starting the second attempt.
+     * @returns Whether setting the timeout was successful, or @c true if libcurl is too old to support it.
+     */
+    bool setHappyEyeballsTimeout(const std::chrono::milliseconds timeout);
+
+    /**
+     * Sets the HTTP/2 weight of the stream, which decides its share of the connection's bandwidth relative to the
+     * other streams which are sending or receiving at the same time.
+     *
+     * @param weight The weight, from 1 to 256.  libcurl's default is 16.
+     * @returns Whether setting the weight was successful, or @c true if libcurl is too old to support it.
+     */
+    bool setStreamWeight(long weight);
+
     /**
      * Sets the callback to call when libcurl has response data to consume
      *
@@ -189,6 +230,7 @@ private:
      * <li>m_postHeaders</li>
      * <li>m_post</li>
      * </ul>
+     * and releases @c m_postContents.
      */
     void cleanupResources();
 
@@ -207,6 +249,8 @@ private:
     curl_slist* m_postHeaders;
     /// The associated multipart post
     curl_httppost* m_post;
+    /// The payloads @c m_post points to without having copied them
+    std::vector<std::shared_ptr<const std::string>> m_postContents;
 };
 
 }  // namespace acl
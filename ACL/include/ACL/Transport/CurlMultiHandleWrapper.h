@@ -33,6 +33,8 @@ namespace acl {
  * - centralized and consistent logging when curl_multi operations fail.
  * - simplified signatures for calling code.
  * - (slightly) improved type safety (so far just time values).
+ * - waking a thread blocked in @c wait() from another thread, via a self-pipe whose read end is passed to
+ *   @c curl_multi_wait() as an extra file descriptor.
  */
 class CurlMultiHandleWrapper {
 public:
@@ -84,9 +86,38 @@ public:
      *
      * @param timeout How long to wait for actions to perform.
      * @param[out] countHandlesUpdated The number of handles for which actions are ready to be performed.
+     * @param[out] wasWokenUp If not @c nullptr, whether @c wakeup() was called before the wait returned is assigned
+     *     here.
      * @return @c libcurl code indicating the result of this operation.
      */
-    CURLMcode wait(std::chrono::milliseconds timeout, int* countHandlesUpdated);
+    CURLMcode wait(std::chrono::milliseconds timeout, int* countHandlesUpdated, bool* wasWokenUp = nullptr);
+
+    /**
+     * Block until @c wakeup() is called or the specified timeout expires, without servicing any @c libcurl
+     * @c handles.  This is used in place of a plain sleep when all streams are paused, so that the sleep can
+     * be cut short as soon as there is new work to do.
+     *
+     * @param timeout How long to wait for a call to @c wakeup().
+     * @return Whether @c wakeup() was called before the timeout expired.
+     */
+    bool waitForWakeup(std::chrono::milliseconds timeout);
+
+    /**
+     * Cause a thread blocked in @c wait() or @c waitForWakeup() to return immediately.  If no thread is currently
+     * waiting, the next call to @c wait() or @c waitForWakeup() will return immediately.  This method may be
+     * called from any thread.
+     *
+     * @return Whether the wakeup was signalled.
+     */
+    bool wakeup();
+
+    /**
+     * Return whether this instance supports @c wakeup().  If it does not, callers must fall back to polling
+     * with short timeouts.
+     *
+     * @return Whether this instance supports @c wakeup().
+     */
+    bool isWakeupSupported() const;
 
     /**
      * Receive the next messages about the @c libcurl @c handles added to this @c libcurl @c multi @c handle.
@@ -104,9 +135,24 @@ private:
      */
     CurlMultiHandleWrapper(CURLM* handle);
 
+    /**
+     * Create the self-pipe used to implement @c wakeup().
+     *
+     * @return Whether the self-pipe was created.
+     */
+    bool createWakeupPipe();
+
+    /**
+     * Consume any pending wakeup signals.
+     */
+    void drainWakeupPipe();
+
     /// The wrapped @c libcurl @c handles.
     CURLM* m_handle;
 
+    /// File descriptors of the self-pipe used to implement @c wakeup(), or -1 if @c wakeup() is not supported.
+    int m_wakeupPipe[2];
+
     /// The set of @c libcurl @c handles added to this instance.
     std::unordered_set<CURL*> m_streamHandles;
 };
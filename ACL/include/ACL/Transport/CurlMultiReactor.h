@@ -0,0 +1,233 @@
+/*
+ * CurlMultiReactor.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_CURL_MULTI_REACTOR_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_CURL_MULTI_REACTOR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <curl/curl.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * A single network thread which drives the transfers of many @c libcurl @c multi @c handles, so that the number of
+ * threads stays fixed however many connections there are.
+ *
+ * Each client is a @c multi @c handle.  Its sockets are watched with epoll, as @c libcurl asks through
+ * @c CURLMOPT_SOCKETFUNCTION, and its timeouts are kept as @c libcurl sets them through @c CURLMOPT_TIMERFUNCTION.
+ * When a socket is ready or a timeout expires, the reactor calls @c curl_multi_socket_action() on the handle, and
+ * then the client's callback, which may add and remove transfers, read their results with @c curl_multi_info_read(),
+ * and ask to be called back at a time of its own.  Each client keeps its own @c multi @c handle, and so its own
+ * connections.
+ *
+ * Everything a client does with its @c multi @c handle once added must be done from its callback, on the reactor's
+ * thread.  The callback must return quickly, since it holds up every other client.
+ *
+ * @note This is only supported on Linux.  Elsewhere @c create() fails.
+ */
+class CurlMultiReactor {
+public:
+    /**
+     * The callback of a client.
+     *
+     * @param transfersUpdated Whether any socket of the client was ready since the last call.
+     * @param runningHandles The number of transfers of the client still running, as last reported by @c libcurl.
+     * @return The time at which to be called again if nothing happens before, or @c time_point::max() for never.
+     */
+    using ActivityCallback =
+        std::function<std::chrono::steady_clock::time_point(bool transfersUpdated, int runningHandles)>;
+
+    /**
+     * Create a @c CurlMultiReactor and start its thread.
+     *
+     * @return The @c CurlMultiReactor, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<CurlMultiReactor> create();
+
+    /**
+     * Destructor.  Stops the thread.  All clients must have been removed.
+     */
+    ~CurlMultiReactor();
+
+    /**
+     * Add a client.  Its callback is called as soon as possible, and @c libcurl is given the chance to start the
+     * transfers already added to the handle.
+     *
+     * @param multi The @c multi @c handle of the client, which must not be driven in any other way.
+     * @param callback The callback of the client.
+     * @return Whether the client was added.
+     */
+    bool addClient(CURLM* multi, ActivityCallback callback);
+
+    /**
+     * Remove a client.  Once this returns, the callback will not be called again and @c libcurl no longer reports
+     * to this reactor, so the handle may be cleaned up.  This may be called from the client's own callback.
+     *
+     * @param multi The @c multi @c handle of the client.
+     */
+    void removeClient(CURLM* multi);
+
+    /**
+     * Have the callback of a client called as soon as possible.  This may be called from any thread.
+     *
+     * @param multi The @c multi @c handle of the client.
+     */
+    void wake(CURLM* multi);
+
+private:
+    /// The state of a client.
+    struct Client {
+        /// The @c multi @c handle of the client.
+        CURLM* multi;
+
+        /// The reactor, for the callbacks of @c libcurl.
+        CurlMultiReactor* reactor;
+
+        /// The callback of the client.
+        ActivityCallback callback;
+
+        /// When @c libcurl wants @c curl_multi_socket_action() called for a timeout, or @c time_point::max().
+        std::chrono::steady_clock::time_point curlTimeout;
+
+        /// When the client wants its callback called, or @c time_point::max().
+        std::chrono::steady_clock::time_point deadline;
+
+        /// Whether a socket of the client was ready since the last call of its callback.
+        bool isUpdated;
+
+        /// The number of transfers still running, as last reported by @c libcurl.
+        int runningHandles;
+
+        /// Whether @c wake() was called since the last call of the callback.  Guarded by @c m_mutex.
+        bool isWoken;
+
+        /// Whether the client has been removed.  Guarded by @c m_mutex.
+        bool isRemoved;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param epollFd The epoll instance to watch the sockets with.
+     * @param wakeFd The eventfd to wake the thread with, which is already watched by @c epollFd.
+     */
+    CurlMultiReactor(int epollFd, int wakeFd);
+
+    /**
+     * The @c CURLMOPT_SOCKETFUNCTION of the clients, which watches the sockets @c libcurl asks it to.
+     *
+     * @param easy The @c libcurl @c easy @c handle of the transfer.
+     * @param socket The socket.
+     * @param what What to wait for on the socket, or @c CURL_POLL_REMOVE to stop watching it.
+     * @param client The @c Client.
+     * @param socketData Unused.
+     * @return 0 always.
+     */
+    static int onSocket(CURL* easy, curl_socket_t socket, int what, void* client, void* socketData);
+
+    /**
+     * The @c CURLMOPT_TIMERFUNCTION of the clients, which records when @c libcurl wants to be called for a timeout.
+     *
+     * @param multi The @c multi @c handle.
+     * @param timeoutMs How long until the timeout, or -1 to cancel it.
+     * @param client The @c Client.
+     * @return 0 always.
+     */
+    static int onTimer(CURLM* multi, long timeoutMs, void* client);
+
+    /**
+     * Watch or stop watching a socket, under @c m_mutex.
+     *
+     * @param client The client the socket belongs to.
+     * @param socket The socket.
+     * @param what What to wait for on the socket, or @c CURL_POLL_REMOVE to stop watching it.
+     */
+    void updateSocketLocked(Client* client, curl_socket_t socket, int what);
+
+    /**
+     * Begin to service a client, so that it is not removed meanwhile.
+     *
+     * @param client The client.
+     * @param[out] isWoken Whether @c wake() was called for the client since it was last serviced.
+     * @return Whether the client may be serviced, which it may not once removed.
+     */
+    bool beginService(const std::shared_ptr<Client>& client, bool* isWoken);
+
+    /**
+     * End the service of a client begun with @c beginService().
+     */
+    void endService();
+
+    /**
+     * Call @c curl_multi_socket_action() for a client.
+     *
+     * @param client The client.
+     * @param socket The socket which is ready, or @c CURL_SOCKET_TIMEOUT.
+     * @param events The @c CURL_CSELECT_* flags of the ready socket.
+     */
+    void socketAction(Client* client, curl_socket_t socket, int events);
+
+    /**
+     * Signal the thread to look at the clients again.
+     */
+    void wakeThread();
+
+    /**
+     * The loop of the thread.
+     */
+    void loop();
+
+    /// The epoll instance.
+    const int m_epollFd;
+
+    /// The eventfd which wakes the thread.
+    const int m_wakeFd;
+
+    /// Mutex to guard the members below, and the fields of the clients marked as guarded.
+    std::mutex m_mutex;
+
+    /// Notified when the service of a client ends.
+    std::condition_variable m_serviceEnded;
+
+    /// The clients, by their @c multi @c handles.
+    std::unordered_map<CURLM*, std::shared_ptr<Client>> m_clients;
+
+    /// The client owning each watched socket.
+    std::unordered_map<curl_socket_t, Client*> m_socketOwners;
+
+    /// The client being serviced on the thread, or @c nullptr.
+    Client* m_clientInService;
+
+    /// Whether the thread should exit.
+    bool m_isShuttingDown;
+
+    /// The thread.
+    std::thread m_thread;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_CURL_MULTI_REACTOR_H_
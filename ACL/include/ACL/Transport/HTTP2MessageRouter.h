@@ -23,8 +23,10 @@
 
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 
+#include "ACL/Transport/CurlMultiReactor.h"
 #include "ACL/Transport/MessageRouter.h"
 #include "ACL/Transport/MessageConsumerInterface.h"
+#include "ACL/Transport/NetworkQualityEstimator.h"
 
 namespace alexaClientSDK {
 namespace acl {
@@ -35,16 +37,24 @@ namespace acl {
  */
 class HTTP2MessageRouter : public MessageRouter {
 public:
+    /// The AVS endpoint connected to unless another is given.
+    static const std::string DEFAULT_AVS_ENDPOINT;
+
     /**
      * Constructor.
      *
      * @param authDelegate The AuthDelegate implementation.
      * @param avsEndpoint The URL for the AVS endpoint of this object.
+     * @param networkReactor The reactor to run the network loops of the transports on, or @c nullptr for each
+     * transport to run its own thread.
+     * @param networkQualityEstimator The estimator to feed with the transfers of the transports, or @c nullptr.
      */
     HTTP2MessageRouter(
         std::shared_ptr<avsCommon::sdkInterfaces::AuthDelegateInterface> authDelegate,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
-        const std::string& avsEndpoint = "https://avs-alexa-na.amazon.com");
+        const std::string& avsEndpoint = DEFAULT_AVS_ENDPOINT,
+        std::shared_ptr<CurlMultiReactor> networkReactor = nullptr,
+        std::shared_ptr<NetworkQualityEstimator> networkQualityEstimator = nullptr);
 
     /**
      * Destructor.
@@ -58,6 +68,12 @@ private:
         const std::string& avsEndpoint,
         std::shared_ptr<MessageConsumerInterface> messageConsumerInterface,
         std::shared_ptr<TransportObserverInterface> transportObserverInterface) override;
+
+    /// The reactor to run the network loops of the transports on, or @c nullptr.
+    const std::shared_ptr<CurlMultiReactor> m_networkReactor;
+
+    /// The estimator to feed with the transfers of the transports, or @c nullptr.
+    const std::shared_ptr<NetworkQualityEstimator> m_networkQualityEstimator;
 };
 
 }  // namespace acl
@@ -20,6 +20,8 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -27,6 +29,7 @@
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/AVS/MessageRequest.h>
 #include <AVSCommon/SDKInterfaces/MessageRequestObserverInterface.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
 
 #include "ACL/Transport/CurlEasyHandleWrapper.h"
 #include "ACL/Transport/MimeParser.h"
@@ -57,10 +60,13 @@ public:
      *
      * @param messageConsumer The MessageConsumerInterface which should receive messages from AVS.
      * @param attachmentManager The attachment manager.
+     * @param acceptCompressedResponses Whether to offer AVS every content encoding libcurl can decode, so that the
+     *     responses of this stream may arrive compressed.  They are decoded before they reach the @c MimeParser.
      */
     HTTP2Stream(
         std::shared_ptr<MessageConsumerInterface> messageConsumer,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+        bool acceptCompressedResponses = false);
 
     /**
      * Initializes streams that are supposed to POST the given request.
@@ -70,12 +76,15 @@ public:
      * @param url The request URL
      * @param authToken The LWA token
      * @param request The MessageRequest to post
+     * @param compressMetadata Whether to gzip the metadata part, if it is large enough to benefit.  This is ignored
+     *     unless built with @c EVENT_COMPRESSION.
      * @returns true if setup was successful
      */
     bool initPost(
         const std::string& url,
         const std::string& authToken,
-        std::shared_ptr<avsCommon::avs::MessageRequest> request);
+        std::shared_ptr<avsCommon::avs::MessageRequest> request,
+        bool compressMetadata = false);
 
     /**
      * Initializes streams that are supposed to perform an HTTP GET
@@ -110,18 +119,46 @@ public:
     long getResponseCode();
 
     /**
-     * Notify the current request observer that the transfer is complete with
-     * the appropriate SendCompleteStatus code.
+     * Set the time the request of this stream waited in the transport's queue before the stream was initialized.
+     *
+     * @param queueWait The time the request waited.
+     */
+    void setQueueWait(std::chrono::steady_clock::duration queueWait);
+
+    /**
+     * Get the timing of the transfer this stream performs.  This should be called once the transfer has finished.
+     *
+     * @return The timing of the transfer, measured from when the stream was initialized.
      */
-    void notifyRequestObserver();
+    avsCommon::sdkInterfaces::MessageRequestObserverInterface::TransferTimings getTransferTimings();
+
+    /**
+     * Get the number of bytes of the response received by the transfer this stream performs.
+     *
+     * @return The number of bytes received, or zero if it could not be got.
+     */
+    uint64_t getResponseBytes();
+
+    /**
+     * Notify the current request observer of the timing of the transfer, and that the transfer is complete with
+     * the appropriate SendCompleteStatus code.  The outcome is read from the transfer right away, so the stream may
+     * be released as soon as this returns, even if the observer is notified later on @c executor.
+     *
+     * @param executor The executor to notify the observer on, or @c nullptr to notify it on the calling thread.
+     */
+    void notifyRequestObserver(
+        const std::shared_ptr<avsCommon::utils::threading::Executor>& executor = nullptr);
 
     /**
      * Notify the current request observer that the transfer is complete with
      * the specified status code.
      *
      * @param status The completion status.
+     * @param executor The executor to notify the observer on, or @c nullptr to notify it on the calling thread.
      */
-    void notifyRequestObserver(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status);
+    void notifyRequestObserver(
+        avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status,
+        const std::shared_ptr<avsCommon::utils::threading::Executor>& executor = nullptr);
 
     /**
      * Callback that gets executed when data is received from the server
@@ -164,6 +201,26 @@ public:
      */
     bool setConnectionTimeout(const std::chrono::seconds timeoutSeconds);
 
+    /**
+     * Sets how long the stream should wait for a connection attempt to the preferred address family before it races
+     * an attempt to the other one.
+     *
+     * @param timeout How long to wait before starting the second attempt.
+     * @returns Whether setting the timeout was successful.
+     */
+    bool setHappyEyeballsTimeout(const std::chrono::milliseconds timeout);
+
+    /**
+     * Get the HTTP/2 weight given to the stream of a request of the given priority, so that the streams of the
+     * user's active dialog, such as @c SpeechRecognizer.Recognize and the directives in its response, are given most
+     * of the connection's bandwidth while they compete with other transfers.  Streams performing a GET are given
+     * libcurl's default weight.
+     *
+     * @param priority The priority of the request.
+     * @return The weight of the stream, from 1 to 256.
+     */
+    static long getStreamWeight(avsCommon::avs::MessageRequest::Priority priority);
+
     /**
      * Resume network IO for this stream
      */
@@ -174,6 +231,22 @@ public:
      */
     bool isBlockedOnLocalIO() const;
 
+    /**
+     * Ask the attachment reader of the current request to call a function when it may have more data to send, so that
+     * the stream can be resumed as soon as the data arrives, rather than polled.  The function is removed when the
+     * stream is reset.
+     *
+     * @param callback The function to call, which must not block.
+     * @return Whether the function will be called.
+     */
+    bool setDataAvailableCallback(std::function<void()> callback);
+
+    /**
+     * Return whether this stream is only blocked on local IO until the function set with
+     * @c setDataAvailableCallback() is called, so that it need not be polled.
+     */
+    bool isUnblockedByCallback() const;
+
     /**
      * Set the logical stream ID for this stream.
      *
@@ -205,14 +278,32 @@ public:
      */
     bool hasProgressTimedOut() const;
 
+    /**
+     * Get the time at which the progress timeout is reached unless something is transferred before then.
+     *
+     * @return The time at which the progress timeout is reached, or @c time_point::max() if there is no timeout.
+     */
+    std::chrono::steady_clock::time_point getProgressDeadline() const;
+
 private:
     /**
-     * Configure the associated curl easy handle with options common to GET and POST
+     * Configure the associated curl easy handle with options common to GET and POST.  The options which are the same
+     * for every transfer (including the Authorization header) are only set when the handle has lost them, or when
+     * @c authToken has changed.  This resets @c m_transfer when @c authToken has changed, so it must be called before
+     * any per-transfer options are set.
      *
      * @return Whether the setting was successful or not
      */
     bool setCommonOptions(const std::string& url, const std::string& authToken);
 
+    /**
+     * Set the options which are the same for every transfer on the associated curl easy handle.
+     *
+     * @param authToken The token to send in the Authorization header.
+     * @return Whether the setting was successful or not
+     */
+    bool setOptionsForHandle(const std::string& authToken);
+
     /**
      * The logical id for this particular object instance.  (see note for @c m_streamIdCounter in this class).
      * @note This is NOT the actual HTTP/2 stream id.  Instead, this is an id which this class generates which is
@@ -228,8 +319,12 @@ private:
     std::shared_ptr<avsCommon::avs::MessageRequest> m_currentRequest;
     /// Whether the send operation has completed.
     bool m_hasSendCompleted;
+    /// The dialogRequestId of @c m_currentRequest if it is being traced by @c DialogLatencyTracer, or empty.
+    std::string m_tracedDialogRequestId;
     /// Whether send to network is blocked on local reads (i.e. awaiting new data to send).
     bool m_isNetworkSendBlockedOnLocalRead;
+    /// Whether the attachment reader of @c m_currentRequest calls a function when it has more data to send.
+    bool m_isDataAvailableCallbackSet;
     /// Whether we have received any data
     bool m_hasReceiveStarted;
     /// Whether receive from network is blocked on local writes (i.e. buffer full).
@@ -243,6 +338,19 @@ private:
     std::atomic<std::chrono::steady_clock::rep> m_progressTimeout;
     /// Last time something was transferred.
     std::atomic<std::chrono::steady_clock::rep> m_timeOfLastTransfer;
+    /// When the stream was initialized for the current transfer.
+    std::chrono::steady_clock::time_point m_timeTransferStarted;
+    /// When the attachment of @c m_currentRequest was completely read, or the epoch if it has not been.
+    std::chrono::steady_clock::time_point m_timeSendCompleted;
+    /// The time @c m_currentRequest waited in the transport's queue.
+    std::chrono::steady_clock::duration m_queueWait;
+    /// Whether the responses of this stream may arrive compressed.
+    const bool m_acceptCompressedResponses;
+    /**
+     * The token in the Authorization header set on @c m_transfer, or empty if the options which are the same for
+     * every transfer are not set.
+     */
+    std::string m_authToken;
 };
 
 template <class TickType, class TickPeriod>
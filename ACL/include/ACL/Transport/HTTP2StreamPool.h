@@ -39,10 +39,13 @@ public:
      *
      * @params maxStreams The maximum number of streams that can be active
      * @params attachmentManager The attachment manager.
+     * @params acceptCompressedResponses Whether the responses of the streams may arrive compressed.
+     *     @see HTTP2Stream::HTTP2Stream().
      */
     HTTP2StreamPool(
         const int maxStreams,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+        bool acceptCompressedResponses = false);
 
     /**
      * Grabs an HTTP2Stream from the pool and configures it to be an HTTP GET.
@@ -64,13 +67,15 @@ public:
      * @param authToken The LWA token to supply.
      * @param request The message request.
      * @param messageConsumer The MessageConsumerInterface to pass messages to.
+     * @param compressMetadata Whether to gzip the metadata part of the request.  @see HTTP2Stream::initPost().
      * @return An HTTP2Stream from the stream pool, or @c nullptr if there was an error.
      */
     std::shared_ptr<HTTP2Stream> createPostStream(
         const std::string& url,
         const std::string& authToken,
         std::shared_ptr<avsCommon::avs::MessageRequest> request,
-        std::shared_ptr<MessageConsumerInterface> messageConsumer);
+        std::shared_ptr<MessageConsumerInterface> messageConsumer,
+        bool compressMetadata = false);
 
     /**
      * Returns an HTTP2Stream back into the pool.
@@ -97,6 +102,8 @@ private:
     const int m_maxStreams;
     /// The attachment manager.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> m_attachmentManager;
+    /// Whether the responses of the streams may arrive compressed.
+    const bool m_acceptCompressedResponses;
     /**
      * A static counter to ensure each newly acquired stream across all pools has a different ID.  The notion of a
      * stream ID is needed to provide a per-HTTP/2-stream context for any given attachment received from AVS.  AVS
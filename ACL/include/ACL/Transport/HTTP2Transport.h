@@ -18,29 +18,39 @@
 #ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_HTTP2_TRANSPORT_H_
 #define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_HTTP2_TRANSPORT_H_
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <unordered_set>
 #include <queue>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 
 #include "AVSCommon/SDKInterfaces/AuthDelegateInterface.h"
 #include "AVSCommon/SDKInterfaces/ContextManagerInterface.h"
+#include "AVSCommon/Utils/Threading/CopyOnWriteSet.h"
+#include "AVSCommon/Utils/Threading/Executor.h"
+#include "AVSCommon/Utils/Timing/Clock.h"
 #include "ACL/Transport/CurlMultiHandleWrapper.h"
+#include "ACL/Transport/CurlMultiReactor.h"
 #include "ACL/Transport/HTTP2Stream.h"
 #include "ACL/Transport/HTTP2StreamPool.h"
 #include "ACL/Transport/MessageConsumerInterface.h"
+#include "ACL/Transport/NetworkQualityEstimator.h"
+#include "ACL/Transport/OutboundEventBuffer.h"
 #include "ACL/Transport/PostConnectObject.h"
 #include "ACL/Transport/PostConnectObserverInterface.h"
 #include "ACL/Transport/PostConnectSendMessageInterface.h"
+#include "ACL/Transport/TransferMetrics.h"
 #include "ACL/Transport/TransportInterface.h"
 #include "ACL/Transport/TransportObserverInterface.h"
 
@@ -49,6 +59,27 @@ namespace acl {
 
 /**
  * Class to create and manage an HTTP/2 connection to AVS.
+ *
+ * If @c acl.alternateEndpoints lists further AVS endpoints (separated by commas), connecting races a downchannel to
+ * each of them against the one to @c avsEndpoint, starting them @c acl.connectionAttemptDelayMs apart (or as soon as
+ * all the earlier attempts have failed).  The first downchannel to receive HTTP 200 carries the connection, and the
+ * others are torn down.  The same delay is given to libcurl to race IPv4 against IPv6 for each endpoint.
+ *
+ * While idle, the connection is pinged every @c acl.minPingIntervalSeconds right after connecting.  Each successful
+ * ping doubles the interval, up to @c acl.maxPingIntervalSeconds, and a stalled stream makes a ping due at once and
+ * resets the interval.  An event stream stalls once it has transferred nothing for @c acl.streamProgressTimeoutSeconds
+ * (30 by default).  A ping which takes longer than @c acl.pingTimeoutSeconds closes the connection.  In low-power mode
+ * the interval keeps doubling up to @c acl.lowPowerMaxPingIntervalSeconds instead, which may let AVS close the idle
+ * connection sooner.
+ *
+ * If built with @c EVENT_COMPRESSION, setting @c acl.compressEventMetadata gzips the metadata part of large events,
+ * such as those carrying the context, for endpoints which accept it.  Setting @c acl.acceptCompressedResponses lets
+ * AVS compress the downchannel and the responses to events, which shrinks large directives such as playlists and
+ * display cards on slow links; libcurl decodes them before they are parsed.
+ *
+ * By default each transport runs its network loop on a thread of its own.  Given a @c CurlMultiReactor, it runs it
+ * on the thread of the reactor instead, as a step each time its transfers have activity or something is due, so that
+ * many transports share one thread.  Its methods must then not be called from the reactor's thread.
  */
 class HTTP2Transport
         : public TransportInterface
@@ -64,6 +95,11 @@ public:
      * @param messageConsumer The MessageConsumerInterface to pass messages to.
      * @param attachmentManager The attachment manager that manages the attachments.
      * @param observer The observer to this class.
+     * @param outboundEventBuffer An optional buffer to hold the requests which can not be sent because the
+     *     connection is lost, instead of failing them with @c NOT_CONNECTED.
+     * @param networkReactor An optional reactor to run the network loop on, instead of a thread of its own.
+     * @param networkQualityEstimator An optional estimator to feed with the outcome of the transfers, which is also
+     *     consulted before pinging less often.
      * @return A shared pointer to a HTTP2Transport object.
      */
     static std::shared_ptr<HTTP2Transport> create(
@@ -71,7 +107,10 @@ public:
         const std::string& avsEndpoint,
         std::shared_ptr<MessageConsumerInterface> messageConsumerInterface,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
-        std::shared_ptr<TransportObserverInterface> observer);
+        std::shared_ptr<TransportObserverInterface> observer,
+        std::shared_ptr<OutboundEventBuffer> outboundEventBuffer = nullptr,
+        std::shared_ptr<CurlMultiReactor> networkReactor = nullptr,
+        std::shared_ptr<NetworkQualityEstimator> networkQualityEstimator = nullptr);
 
     /**
      * @inheritDoc
@@ -89,6 +128,33 @@ public:
     void sendPostConnectMessage(std::shared_ptr<avsCommon::avs::MessageRequest> request) override;
     void send(std::shared_ptr<avsCommon::avs::MessageRequest> request) override;
 
+    /**
+     * @inheritDoc
+     * Cuts short the wait before the next attempt to connect, or abandons the attempt in progress, which may be
+     * stalled on the network which went away, and retries at once with a reset backoff.
+     */
+    void onNetworkAvailable() override;
+
+    /**
+     * @inheritDoc
+     * The queued messages are still sent, and the network loop stops once no event stream is left.
+     */
+    void disconnectWhenIdle() override;
+
+    /**
+     * @inheritDoc
+     * Lets successful pings stretch the ping interval up to @c acl.lowPowerMaxPingIntervalSeconds.
+     */
+    void setLowPowerMode(bool enabled) override;
+
+    /**
+     * Get the latencies of the phases of the transfers made by this transport, over all of its connections.  They
+     * are also logged each time a connection ends.
+     *
+     * @return The latencies of the transfers made by this transport.
+     */
+    const TransferMetrics& getTransferMetrics() const;
+
     /**
      * Method to add observers for TranportObserverInterface.
      *
@@ -112,6 +178,9 @@ private:
      * @param messageConsumer The MessageConsumerInterface to pass messages to.
      * @param attachmentManager The attachment manager that manages the attachments.
      * @param observer The observer to this class.
+     * @param outboundEventBuffer The buffer to hold the requests which can not be sent, or @c nullptr.
+     * @param networkReactor The reactor to run the network loop on, or @c nullptr for a thread of its own.
+     * @param networkQualityEstimator The estimator to feed with the outcome of the transfers, or @c nullptr.
      */
     HTTP2Transport(
         std::shared_ptr<avsCommon::sdkInterfaces::AuthDelegateInterface> authDelegate,
@@ -119,7 +188,10 @@ private:
         std::shared_ptr<MessageConsumerInterface> messageConsumerInterface,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
         std::shared_ptr<PostConnectObject> postConnectObject,
-        std::shared_ptr<TransportObserverInterface> observer);
+        std::shared_ptr<TransportObserverInterface> observer,
+        std::shared_ptr<OutboundEventBuffer> outboundEventBuffer,
+        std::shared_ptr<CurlMultiReactor> networkReactor,
+        std::shared_ptr<NetworkQualityEstimator> networkQualityEstimator);
 
     /**
      * Notify registered observers on a transport disconnect.
@@ -150,17 +222,122 @@ private:
     bool setupDownchannelStream(avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason* reason);
 
     /**
-     * Main network loop. Will establish a connection then repeatedly call curl_multi_perform in order to
-     * receive data from the AVS backend.
+     * Create a downchannel stream to an endpoint and add it to @c m_multi.
+     *
+     * @param avsEndpoint The endpoint to connect the downchannel to.
+     * @param authToken The access token to authorize the downchannel with.
+     * @param[out] reason Pointer to receive the reason the operation failed, if it does.
+     * @return The downchannel stream, or @c nullptr if the operation failed.
+     */
+    std::shared_ptr<HTTP2Stream> createDownchannelStream(
+        const std::string& avsEndpoint,
+        const std::string& authToken,
+        avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason* reason);
+
+    /**
+     * Start racing a downchannel to the next of @c m_avsEndpoints against @c m_downchannelStream and those already
+     * started.
+     *
+     * @return Whether a downchannel was started.
+     */
+    bool startNextDownchannelAttempt();
+
+    /**
+     * Make a downchannel which has received HTTP 200 the downchannel of this connection, and tear down the others.
+     *
+     * @param index The index in @c m_downchannelAttempts of the downchannel which won the race, or
+     *     @c m_downchannelAttempts.size() if @c m_downchannelStream won it.
+     */
+    void selectDownchannelAttempt(size_t index);
+
+    /**
+     * Main network loop on @c m_networkThread.  Will repeatedly call curl_multi_perform in order to establish a
+     * connection and then receive data from the AVS backend, taking a step of the network loop after each call, as
+     * @c m_networkReactor would.
      */
     void networkLoop();
 
     /**
-     * Establishes a connection to AVS.
+     * Release everything the network loop used, once it stops.
+     */
+    void finishNetworkLoop();
+
+    /// The phases of the network loop.
+    enum class NetworkLoopState {
+        /// A downchannel is being established.
+        ESTABLISHING,
+        /// Waiting to retry after the downchannel could not be established.
+        WAITING_TO_RETRY,
+        /// Connected, and servicing the streams.
+        RUNNING
+    };
+
+    /**
+     * Take a step of the network loop on @c m_networkReactor.
      *
-     * @return Whether the connection was successful or if we're already connected.
+     * @param transfersUpdated Whether any transfer had activity since the last step.
+     * @param runningHandles The number of transfers still running.
+     * @return The time at which to take the next step if nothing happens before.
      */
-    bool establishConnection();
+    std::chrono::steady_clock::time_point onReactorActivity(bool transfersUpdated, int runningHandles);
+
+    /**
+     * Take a step of the network loop, on @c m_networkThread or @c m_networkReactor, after a call to
+     * curl_multi_perform.
+     *
+     * @param now The current time.
+     * @param transfersUpdated Whether any transfer had activity since the last step.
+     * @param runningHandles The number of transfers still running.
+     * @param isWoken Whether the network loop was woken since the last step.
+     * @return The time at which to take the next step if nothing happens before.
+     */
+    std::chrono::steady_clock::time_point networkLoopStep(
+        std::chrono::steady_clock::time_point now,
+        bool transfersUpdated,
+        int runningHandles,
+        bool isWoken);
+
+    /**
+     * Take a step of establishing a connection.
+     *
+     * @param now The current time.
+     * @param runningHandles The number of transfers still running.
+     * @return The time at which to take the next step if nothing happens before.
+     */
+    std::chrono::steady_clock::time_point establishConnectionStep(
+        std::chrono::steady_clock::time_point now,
+        int runningHandles);
+
+    /**
+     * Wait to retry establishing a connection, or retry at once if the network has become available.
+     *
+     * @param now The current time.
+     * @return The time at which to take the next step if nothing happens before.
+     */
+    std::chrono::steady_clock::time_point scheduleConnectionRetry(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Set up a new downchannel and start establishing a connection again.
+     *
+     * @param now The current time.
+     * @return The time at which to take the next step if nothing happens before.
+     */
+    std::chrono::steady_clock::time_point restartConnection(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Take a step of servicing the streams once connected.
+     *
+     * @param now The current time.
+     * @param transfersUpdated Whether any transfer had activity since the last step.
+     * @param runningHandles The number of transfers still running.
+     * @param isWoken Whether the network loop was woken since the last step.
+     * @return The time at which to take the next step if nothing happens before.
+     */
+    std::chrono::steady_clock::time_point serviceStreamsStep(
+        std::chrono::steady_clock::time_point now,
+        bool transfersUpdated,
+        int runningHandles,
+        bool isWoken);
 
     /**
      * Checks if an active stream is finished and reports the response code the observer.
@@ -168,21 +345,43 @@ private:
     void cleanupFinishedStreams();
 
     /**
-     * Check for streams that have not progressed within their timeout and remove them.
+     * Check for streams that have not progressed within their timeout and remove them.  Only the streams whose entry
+     * in @c m_progressDeadlines is due are checked, so the cost does not grow with the number of active streams.
      */
     void cleanupStalledStreams();
 
     /**
-     * Checks all the currently executing message requests to see if they have HTTP response codes.
+     * Get how long the network loop may wait before the next entry of @c m_progressDeadlines is due, dropping the
+     * entries of streams which have finished.
+     *
+     * @param now The current time.
+     * @return How long the network loop may wait, or @c milliseconds::max() if no event stream is active.
+     */
+    std::chrono::milliseconds getTimeUntilNextProgressDeadline(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Checks whether another message request may be started: fewer than @c m_eventConcurrencyLimit of the currently
+     * executing message requests are still waiting for an HTTP response code, and a stream is available.
      *
-     * @return If all the currently executing message requests have HTTP response codes.
+     * @return Whether another message request may be started.
      */
     bool canProcessOutgoingMessage();
 
     /**
      * Send the next @c MessageRequest if any are queued.
+     *
+     * @return Whether a @c MessageRequest was taken from the queue.
+     */
+    bool processNextOutgoingMessage();
+
+    /**
+     * Adjust @c m_eventConcurrencyLimit after an event stream finishes.  The limit is halved when the server refuses a
+     * stream or throttles an event, and otherwise grows by one per completed event, up to @c m_maxConcurrentEvents.
+     *
+     * @param result The curl result of the transfer.
+     * @param responseCode The HTTP response code of the transfer.
      */
-    void processNextOutgoingMessage();
+    void adaptEventConcurrencyLimit(CURLcode result, long responseCode);
 
     /**
      * Attempts to create a stream that will send a ping to the backend. If a ping stream is in flight, we do not
@@ -195,8 +394,10 @@ private:
     /**
      * Cleans up the ping stream when the ping request is complete, also identifies if there was an error sending
      * the ping.
+     *
+     * @param result The result of the transfer of the ping.
      */
-    void handlePingResponse();
+    void handlePingResponse(CURLcode result);
 
     /**
      * Set whether or not the network thread is stopping. If transitioning to true, this method wakes up the
@@ -222,6 +423,28 @@ private:
      */
     bool isStopping();
 
+    /**
+     * Check whether @c onNetworkAvailable() has been called since the last attempt to connect started, and clear it.
+     *
+     * @return Whether the network has become available.
+     */
+    bool checkAndClearNetworkAvailable();
+
+    /**
+     * Check whether @c onNetworkAvailable() has been called since the last attempt to connect started.
+     *
+     * @return Whether the network has become available.
+     */
+    bool hasNetworkBecomeAvailable();
+
+    /**
+     * Check whether @c disconnectWhenIdle() has been called, and every message handed to this transport since has been
+     * answered.  It must be called from the network loop.
+     *
+     * @return Whether the network loop should stop.
+     */
+    bool isDrained();
+
     /**
      * Get whether or not a viable connection is available (returns @c false if @c m_isStopping to discourage
      * doomed sends).
@@ -254,9 +477,11 @@ private:
     /**
      * De-queue a @c MessageRequest from (the front of) the queue of @c MessageRequest instances to process.
      *
+     * @param[out] queueWait If not @c nullptr, the time the request waited in the queue is assigned here.
      * @return The next @c MessageRequest to process (or @c nullptr).
      */
-    std::shared_ptr<avsCommon::avs::MessageRequest> dequeueRequest();
+    std::shared_ptr<avsCommon::avs::MessageRequest> dequeueRequest(
+        std::chrono::steady_clock::duration* queueWait = nullptr);
 
     /**
      * Clear the queue of @c MessageRequest instances, but first call @c onSendCompleted(NOT_CONNECTED) for any
@@ -265,7 +490,36 @@ private:
     void clearQueuedRequests();
 
     /**
-     * Release the down channel stream.
+     * Notify a request that it is complete, on @c m_requestCallbackExecutor if there is one.
+     *
+     * @param request The request.
+     * @param status The completion status.
+     */
+    void notifyRequestCompleted(
+        std::shared_ptr<avsCommon::avs::MessageRequest> request,
+        avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status);
+
+    /**
+     * Wake the network loop if it is waiting, so that it services the streams right away.  This may be called from
+     * any thread which does not hold @c m_mutex.
+     */
+    void wakeNetworkLoop();
+
+    /**
+     * Wake the network loop if it is waiting, so that it services the streams right away.
+     * @c m_mutex must be locked to call this method.
+     */
+    void wakeNetworkLoopLocked();
+
+    /**
+     * Get whether the network loop is woken as soon as it has something to do, so that it need not poll.
+     *
+     * @return Whether the network loop is woken as soon as it has something to do.
+     */
+    bool isNetworkLoopWakeable() const;
+
+    /**
+     * Release the down channel stream, and any downchannels still racing it.
      *
      * @param removeFromMulti Whether to remove the stream from @c m_multi as part of releasing the stream.
      * @param[out] reason If the operation fails, returns reason value.
@@ -275,6 +529,11 @@ private:
         bool removeFromMulti = true,
         avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason* reason = nullptr);
 
+    /**
+     * Release the downchannels which race @c m_downchannelStream.
+     */
+    void releaseDownchannelAttempts();
+
     /**
      * Release the ping stream.
      *
@@ -315,11 +574,8 @@ private:
      */
     bool isEventStream(std::shared_ptr<HTTP2Stream> stream);
 
-    /// Mutex to protect access to the m_observers variable.
-    std::mutex m_observerMutex;
-
     /// Observers of this class, to be notified on changes in connection and received attachments.
-    std::unordered_set<std::shared_ptr<TransportObserverInterface>> m_observers;
+    avsCommon::utils::threading::CopyOnWriteSet<std::shared_ptr<TransportObserverInterface>> m_observers;
 
     /// Observer of this class, to be passed received messages from AVS.
     std::shared_ptr<MessageConsumerInterface> m_messageConsumer;
@@ -327,9 +583,21 @@ private:
     /// Auth delegate implementation.
     std::shared_ptr<avsCommon::sdkInterfaces::AuthDelegateInterface> m_authDelegate;
 
-    /// The URL of the AVS server we will connect to.
+    /// The URLs of the AVS servers we may connect to, the configured endpoint first.
+    const std::vector<std::string> m_avsEndpoints;
+
+    /// How long to wait for a connection attempt before racing the next one.
+    const std::chrono::milliseconds m_connectionAttemptDelay;
+
+    /// The URL of the AVS server we are connected, or connecting, to.
     std::string m_avsEndpoint;
 
+    /**
+     * The downchannels to the endpoints after the first in @c m_avsEndpoints which race @c m_downchannelStream while
+     * a connection is established, and the endpoints they connect to.  Only accessed by the network thread.
+     */
+    std::vector<std::pair<std::string, std::shared_ptr<HTTP2Stream>>> m_downchannelAttempts;
+
     /// Representation of the downchannel stream.
     std::shared_ptr<HTTP2Stream> m_downchannelStream;
 
@@ -342,9 +610,101 @@ private:
     /// The list of streams that either do not have HTTP response headers, or have outstanding response data.
     std::map<CURL*, std::shared_ptr<HTTP2Stream>> m_activeStreams;
 
-    /// Main thread for this class.
+    /// A time by which an event stream must have made progress, as kept in @c m_progressDeadlines.
+    struct ProgressDeadline {
+        /// When the stream times out, unless it made progress since the entry was added.
+        std::chrono::steady_clock::time_point deadline;
+
+        /// The stream.
+        std::shared_ptr<HTTP2Stream> stream;
+
+        /// The logical ID of the transfer of @c stream, which the stream pool changes each time it reuses it.
+        unsigned int streamId;
+
+        /// Order the entries so that the earliest deadline is on top of @c m_progressDeadlines.
+        bool operator>(const ProgressDeadline& other) const {
+            return deadline > other.deadline;
+        }
+    };
+
+    /**
+     * A min-heap of the progress deadlines of the active event streams.  Transfers only move a deadline later, so an
+     * entry which becomes due is pushed back with the stream's current deadline unless it has really stalled.  The
+     * entries of finished streams are dropped when they reach the top.  Only accessed by the network loop.
+     */
+    std::priority_queue<ProgressDeadline, std::vector<ProgressDeadline>, std::greater<ProgressDeadline>>
+        m_progressDeadlines;
+
+    /// Main thread for this class, unless the network loop runs on @c m_networkReactor.
     std::thread m_networkThread;
 
+    /// The reactor to run the network loop on, or @c nullptr to run it on @c m_networkThread.
+    const std::shared_ptr<CurlMultiReactor> m_networkReactor;
+
+    /// The phase of the network loop.  Only accessed by the network loop.
+    NetworkLoopState m_networkLoopState;
+
+    /// When to race a downchannel to the next endpoint, while establishing a connection.
+    std::chrono::steady_clock::time_point m_timeOfNextAttempt;
+
+    /// The number of retries to establish a connection so far.
+    int m_retryCount;
+
+    /// The last back-off before a retry to establish a connection.
+    std::chrono::milliseconds m_retryBackoff;
+
+    /// When to retry to establish a connection.
+    std::chrono::steady_clock::time_point m_timeOfNextRetry;
+
+    /// When to resume the streams paused while blocked on local IO.
+    std::chrono::steady_clock::time_point m_timeToResumeStreams;
+
+    /// The maximum number of streams, including the downchannel and ping streams, which may be active at once.
+    const int m_maxStreams;
+
+    /// The configured maximum number of event streams which may be waiting for an HTTP response code at once.
+    const int m_maxConcurrentEvents;
+
+    /**
+     * The current maximum number of event streams which may be waiting for an HTTP response code at once, adapted
+     * between 1 and @c m_maxConcurrentEvents by @c adaptEventConcurrencyLimit().  Only accessed by the network loop.
+     */
+    int m_eventConcurrencyLimit;
+
+    /// How long the connection may be idle before a ping, right after connecting or after a stalled stream.
+    const std::chrono::seconds m_minPingInterval;
+
+    /// How long the connection may be idle before a ping, once successful pings have proven it stable.
+    const std::chrono::seconds m_maxPingInterval;
+
+    /// How long the connection may be idle before a ping, once proven stable, in low-power mode.
+    const std::chrono::seconds m_lowPowerMaxPingInterval;
+
+    /// The maximum time a ping should take, in seconds.
+    const long m_pingResponseTimeout;
+
+    /// How long an event stream may go without transferring data before it times out.
+    const std::chrono::seconds m_streamProgressTimeout;
+
+    /**
+     * How long the connection may be idle before a ping, doubled by each successful ping from @c m_minPingInterval
+     * up to @c m_maxPingInterval, or @c m_lowPowerMaxPingInterval in low-power mode.  Only accessed by the network
+     * loop.
+     */
+    std::chrono::seconds m_pingInterval;
+
+    /// When the next ping is due, unless there is activity before then.  Only accessed by the network loop.
+    std::chrono::steady_clock::time_point m_timeOfNextPing;
+
+    /// Whether to gzip the metadata of events.
+    const bool m_isEventMetadataCompressed;
+
+    /**
+     * The executor which the network loop notifies requests of their completion on, so that it does not wait for
+     * their observers, or @c nullptr if it notifies them itself.
+     */
+    std::shared_ptr<avsCommon::utils::threading::Executor> m_requestCallbackExecutor;
+
     /// An abstracted HTTP/2 stream pool to ensure that we efficiently and correctly manage our active streams.
     HTTP2StreamPool m_streamPool;
 
@@ -357,20 +717,65 @@ private:
     /// Keeps track of whether the main network loop is running. Serialized by @c m_mutex.
     bool m_isNetworkThreadRunning;
 
+    /// Whether the network loop on @c m_networkReactor was woken since its last step. Serialized by @c m_mutex.
+    bool m_isReactorWakePending;
+
     /// Keeps track of whether we're connected to AVS. Serialized by @c m_mutex.
     bool m_isConnected;
 
     /// Whether or not the @c networkLoop is stopping. Serialized by @c m_mutex.
     bool m_isStopping;
 
-    /// Queue of @c MessageRequest instances to send. Serialized by @c m_mutex.
-    std::deque<std::shared_ptr<avsCommon::avs::MessageRequest>> m_requestQueue;
+    /// Whether @c onNetworkAvailable() was called while connecting. Access serialized with @c m_mutex.
+    bool m_hasNetworkBecomeAvailable;
+
+    /// Whether @c disconnectWhenIdle() was called since the last @c connect(). Access serialized with @c m_mutex.
+    bool m_isDraining;
+
+    /// Whether the ping interval may stretch up to @c m_lowPowerMaxPingInterval.
+    std::atomic<bool> m_isLowPowerMode;
+
+    /// The number of @c MessageRequest::Priority values, each of which has its own queue.
+    static const size_t NUM_PRIORITIES = static_cast<size_t>(avsCommon::avs::MessageRequest::Priority::LOW) + 1;
+
+    /// A @c MessageRequest waiting to be sent.
+    struct QueuedRequest {
+        /// The request.
+        std::shared_ptr<avsCommon::avs::MessageRequest> request;
+
+        /// When the request was queued.
+        std::chrono::steady_clock::time_point timeQueued;
+    };
+
+    /**
+     * Queues of @c MessageRequest instances to send, indexed by @c MessageRequest::Priority, so that a request is
+     * only dequeued once all higher priority queues are empty. Serialized by @c m_mutex.
+     */
+    std::array<std::deque<QueuedRequest>, NUM_PRIORITIES> m_requestQueues;
+
+    /// The latencies of the transfers made by this transport.
+    TransferMetrics m_transferMetrics;
+
+    /// The estimator fed with the outcome of the transfers made by this transport, or @c nullptr.
+    const std::shared_ptr<NetworkQualityEstimator> m_networkQualityEstimator;
 
     /// Used to wake the main network thread in connection retry back-off situation.
     std::condition_variable m_wakeRetryTrigger;
 
+    /// The clock the connection retry back-off is waited on, which is the default when the transport is created.
+    const std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
+    /// Notified when the network loop on @c m_networkReactor stops.
+    std::condition_variable m_networkLoopStopped;
+
     /// PostConnect object.
     std::shared_ptr<PostConnectObject> m_postConnectObject;
+
+    /// The post-connect message, which is never held by @c m_outboundEventBuffer. Serialized by @c m_mutex.
+    std::shared_ptr<avsCommon::avs::MessageRequest> m_postConnectRequest;
+
+    /// Holds the requests which can not be sent because the connection is lost, or @c nullptr.
+    const std::shared_ptr<OutboundEventBuffer> m_outboundEventBuffer;
 };
 
 }  // namespace acl
@@ -0,0 +1,218 @@
+/*
+ * HTTPContentCache.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_HTTP_CONTENT_CACHE_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_HTTP_CONTENT_CACHE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * A bounded on-disk cache of HTTP responses, keyed by URL, used by @c LibCurlHttpContentFetcher so that content which
+ * is fetched again and again, such as alert assets and playlists, is read from disk instead of downloaded.
+ *
+ * Each entry keeps the body of a successful response together with its content type, its validators (@c ETag and
+ * @c Last-Modified) and the time until which it is fresh according to its @c Cache-Control header.  Fresh entries are
+ * used without contacting the server; stale ones are revalidated with a conditional request.  When the bodies exceed
+ * the size of the cache, the least recently used entries are evicted.
+ *
+ * The entries are kept in a directory of their own, two files each, and are found again when the cache is re-created
+ * on the same directory.  This class is thread-safe.
+ */
+class HTTPContentCache {
+public:
+    /// The description of a cached response.
+    struct Entry {
+        /// The content type of the response.
+        std::string contentType;
+
+        /// The @c ETag of the response, or empty if it had none.
+        std::string eTag;
+
+        /// The @c Last-Modified date of the response, or empty if it had none.
+        std::string lastModified;
+
+        /// The Unix time, in seconds, until which the response may be used without revalidating it.
+        int64_t expiry;
+
+        /// The size of the body of the response, in bytes.
+        size_t size;
+    };
+
+    /**
+     * Create an @c HTTPContentCache.
+     *
+     * @param directory The directory holding the entries.  It is created if it does not exist.
+     * @param maxSize The largest total size of the bodies of the entries, in bytes.
+     * @param maxEntrySize The largest size of the body of an entry, in bytes.  Larger responses are not cached.
+     * @return The new @c HTTPContentCache, or @c nullptr if the directory can not be used or the sizes are invalid.
+     */
+    static std::shared_ptr<HTTPContentCache> create(const std::string& directory, size_t maxSize, size_t maxEntrySize);
+
+    /**
+     * Get the largest size of the body of an entry.
+     *
+     * @return The largest size of the body of an entry, in bytes.
+     */
+    size_t getMaxEntrySize() const;
+
+    /**
+     * Get the total size of the bodies of the entries.
+     *
+     * @return The total size of the bodies of the entries, in bytes.
+     */
+    size_t getSize() const;
+
+    /**
+     * Find the entry of a URL, and mark it as the most recently used.
+     *
+     * @param url The URL.
+     * @param[out] entry The description of the entry.
+     * @return Whether the URL has an entry.
+     */
+    bool lookup(const std::string& url, Entry* entry);
+
+    /**
+     * Read the body of the entry of a URL, and mark it as the most recently used.  An entry whose body can not be read
+     * is removed.
+     *
+     * @param url The URL.
+     * @param[out] entry The description of the entry.
+     * @param[out] body The body of the entry.
+     * @return Whether the URL has an entry and its body was read.
+     */
+    bool read(const std::string& url, Entry* entry, std::string* body);
+
+    /**
+     * Add or replace the entry of a URL, evicting the least recently used entries if the cache becomes too large.
+     *
+     * @param url The URL.
+     * @param entry The description of the entry.  Its @c size is taken from @c body.
+     * @param body The body of the response.
+     * @return Whether the entry was stored.
+     */
+    bool store(const std::string& url, const Entry& entry, const std::string& body);
+
+    /**
+     * Update the time until which the entry of a URL is fresh, after the server confirmed it is still valid.
+     *
+     * @param url The URL.
+     * @param expiry The Unix time, in seconds, until which the entry may be used without revalidating it.
+     * @return Whether the URL has an entry which was updated.
+     */
+    bool refresh(const std::string& url, int64_t expiry);
+
+    /**
+     * Remove the entry of a URL, if it has one.
+     *
+     * @param url The URL.
+     */
+    void remove(const std::string& url);
+
+    /**
+     * Find how long a response may be cached from the value of its @c Cache-Control header.
+     *
+     * @param cacheControl The value of the @c Cache-Control header, or an empty string if the response had none.
+     * @param[out] lifetime How long the response is fresh: the @c max-age, or zero if the response must be
+     * revalidated before each use.
+     * @return Whether the response may be stored at all, which it may not if it is @c no-store.
+     */
+    static bool getFreshnessLifetime(const std::string& cacheControl, std::chrono::seconds* lifetime);
+
+private:
+    /// An entry together with its position in @c m_lru.
+    struct IndexEntry {
+        /// The description of the entry.
+        Entry entry;
+
+        /// The position of the URL of the entry in @c m_lru.
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param directory The directory holding the entries.
+     * @param maxSize The largest total size of the bodies of the entries, in bytes.
+     * @param maxEntrySize The largest size of the body of an entry, in bytes.
+     */
+    HTTPContentCache(const std::string& directory, size_t maxSize, size_t maxEntrySize);
+
+    /**
+     * Load the entries stored in @c m_directory, from the least to the most recently used.
+     */
+    void load();
+
+    /**
+     * Get the path of a file of the entry of a URL.
+     *
+     * @param url The URL.
+     * @param suffix The suffix naming the file.
+     * @return The path of the file.
+     */
+    std::string getPath(const std::string& url, const std::string& suffix) const;
+
+    /**
+     * Write the description of an entry to its file.
+     *
+     * @param url The URL of the entry.
+     * @param entry The description of the entry.
+     * @return Whether the description was written.
+     */
+    bool writeEntry(const std::string& url, const Entry& entry) const;
+
+    /**
+     * Remove an entry and its files.  Called with @c m_mutex held.
+     *
+     * @param url The URL of the entry.
+     */
+    void removeLocked(const std::string& url);
+
+    /// The directory holding the entries.
+    const std::string m_directory;
+
+    /// The largest total size of the bodies of the entries, in bytes.
+    const size_t m_maxSize;
+
+    /// The largest size of the body of an entry, in bytes.
+    const size_t m_maxEntrySize;
+
+    /// Serializes access to the members below, and to the files of the entries.
+    mutable std::mutex m_mutex;
+
+    /// The URLs of the entries, from the most to the least recently used.
+    std::list<std::string> m_lru;
+
+    /// The entries, by URL.
+    std::unordered_map<std::string, IndexEntry> m_index;
+
+    /// The total size of the bodies of the entries, in bytes.
+    size_t m_size;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_HTTP_CONTENT_CACHE_H_
@@ -24,6 +24,10 @@
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
 
+#include "ACL/Transport/ContentFetchBandwidthGovernor.h"
+#include "ACL/Transport/HTTPContentCache.h"
+#include "ACL/Transport/LibCurlHttpContentFetchService.h"
+
 namespace alexaClientSDK {
 namespace acl {
 
@@ -32,7 +36,32 @@ namespace acl {
  */
 class HTTPContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface {
 public:
+    /**
+     * Constructor.
+     *
+     * @param fetchService If not @c nullptr, the fetchers produced run their transfers on this service, sharing its
+     * thread and connections.  Otherwise, each fetcher runs its transfer on a thread of its own.
+     * @param bandwidthGovernor If not @c nullptr, the download rate of the transfers of the fetchers produced is capped
+     * as it decides.
+     * @param cache If not @c nullptr, the fetchers produced read fresh responses from this cache instead of fetching
+     * them, and store cacheable responses in it.
+     */
+    HTTPContentFetcherFactory(
+        std::shared_ptr<LibCurlHttpContentFetchService> fetchService = nullptr,
+        std::shared_ptr<ContentFetchBandwidthGovernor> bandwidthGovernor = nullptr,
+        std::shared_ptr<HTTPContentCache> cache = nullptr);
+
     std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> create(const std::string& url) override;
+
+private:
+    /// The service the fetchers produced run their transfers on, or @c nullptr.
+    std::shared_ptr<LibCurlHttpContentFetchService> m_fetchService;
+
+    /// The governor capping the download rate of the transfers of the fetchers produced, or @c nullptr.
+    std::shared_ptr<ContentFetchBandwidthGovernor> m_bandwidthGovernor;
+
+    /// The cache of responses of the fetchers produced, or @c nullptr.
+    std::shared_ptr<HTTPContentCache> m_cache;
 };
 
 }  // namespace acl
@@ -0,0 +1,142 @@
+/*
+ * LibCurlHttpContentFetchService.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_LIBCURL_HTTP_CONTENT_FETCH_SERVICE_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_LIBCURL_HTTP_CONTENT_FETCH_SERVICE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <curl/curl.h>
+
+#include "ACL/Transport/CurlMultiHandleWrapper.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Runs the transfers of many @c LibCurlHttpContentFetcher instances on a single thread, through one @c libcurl
+ * @c multi @c handle.
+ *
+ * Because all the transfers share the connection cache of the @c multi @c handle, fetches from the same server (such
+ * as the entries of a playlist, or successive HLS segments) reuse an already open connection, or are multiplexed on it
+ * over HTTP/2, instead of each connecting from scratch.  Together with the TLS session and DNS caches shared by
+ * @c libcurlUtils::prepareForTLS(), this removes most of the set-up cost of each fetch, and a fetch no longer needs a
+ * thread of its own.
+ *
+ * Completion callbacks are called on the thread of this service, and must not block.
+ */
+class LibCurlHttpContentFetchService {
+public:
+    /**
+     * Callback called when a transfer finishes.
+     *
+     * @param result The result of the transfer.
+     */
+    using CompletionCallback = std::function<void(CURLcode result)>;
+
+    /**
+     * Create a @c LibCurlHttpContentFetchService and start its thread.
+     *
+     * @return The new @c LibCurlHttpContentFetchService, or @c nullptr if the operation fails.
+     */
+    static std::shared_ptr<LibCurlHttpContentFetchService> create();
+
+    /**
+     * Destructor.  Stops the thread.  Transfers which are still running are abandoned without calling their
+     * @c CompletionCallback.
+     */
+    ~LibCurlHttpContentFetchService();
+
+    /**
+     * Start a transfer.
+     *
+     * @param handle The @c libcurl @c handle of the transfer, with all its options set.
+     * @param callback The callback to call when the transfer finishes, on the thread of this service.
+     * @return Whether the transfer was accepted.
+     */
+    bool addTransfer(CURL* handle, CompletionCallback callback);
+
+    /**
+     * Stop a transfer, if it is still running.  Once this returns, its @c CompletionCallback has returned or will never
+     * be called, and @c handle is no longer used by this service.
+     *
+     * @param handle The @c libcurl @c handle of the transfer.
+     */
+    void removeTransfer(CURL* handle);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param multi The @c libcurl @c multi @c handle to run the transfers with.
+     */
+    LibCurlHttpContentFetchService(std::unique_ptr<CurlMultiHandleWrapper> multi);
+
+    /// The main loop of @c m_thread.
+    void loop();
+
+    /**
+     * Apply the transfers added and removed since the previous call.  Called on @c m_thread with @c m_mutex held.
+     *
+     * @param[out] failed The callbacks of transfers which could not be started, to be called without @c m_mutex held.
+     */
+    void applyPendingChangesLocked(std::deque<CompletionCallback>* failed);
+
+    /**
+     * Remove a transfer from @c m_multi and @c m_transfers.  Called on @c m_thread.
+     *
+     * @param handle The @c libcurl @c handle of the transfer.
+     */
+    void removeActiveTransfer(CURL* handle);
+
+    /// The @c libcurl @c multi @c handle running the transfers.  Only accessed by @c m_thread once it is started.
+    std::unique_ptr<CurlMultiHandleWrapper> m_multi;
+
+    /// The transfers in @c m_multi and their callbacks.  Only accessed by @c m_thread.
+    std::unordered_map<CURL*, CompletionCallback> m_transfers;
+
+    /// Serializes access to @c m_pendingAdds, @c m_pendingRemoves and @c m_isStopping.
+    std::mutex m_mutex;
+
+    /// Notified when @c m_pendingRemoves has been applied.
+    std::condition_variable m_removedTrigger;
+
+    /// Transfers waiting to be added to @c m_multi.
+    std::deque<std::pair<CURL*, CompletionCallback>> m_pendingAdds;
+
+    /// Transfers waiting to be removed from @c m_multi.
+    std::unordered_set<CURL*> m_pendingRemoves;
+
+    /// Whether @c m_thread should exit.
+    bool m_isStopping;
+
+    /// The thread which runs the transfers.
+    std::thread m_thread;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_LIBCURL_HTTP_CONTENT_FETCH_SERVICE_H_
@@ -25,7 +25,10 @@
 
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 
+#include "ACL/Transport/ContentFetchBandwidthGovernor.h"
 #include "ACL/Transport/CurlEasyHandleWrapper.h"
+#include "ACL/Transport/HTTPContentCache.h"
+#include "ACL/Transport/LibCurlHttpContentFetchService.h"
 
 namespace alexaClientSDK {
 namespace acl {
@@ -35,7 +38,20 @@ namespace acl {
  */
 class LibCurlHttpContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
 public:
-    LibCurlHttpContentFetcher(const std::string& url);
+    /**
+     * Constructor.
+     *
+     * @param url The URL to fetch from.
+     * @param fetchService The service to run the transfer on.  If @c nullptr, the transfer runs on a thread of its own.
+     * @param bandwidthGovernor If not @c nullptr, the download rate of the transfer is capped as it decides.
+     * @param cache If not @c nullptr, fresh responses are read from this cache instead of fetched, stale ones are
+     * revalidated, and the bodies of cacheable responses are stored in it.
+     */
+    LibCurlHttpContentFetcher(
+        const std::string& url,
+        std::shared_ptr<LibCurlHttpContentFetchService> fetchService = nullptr,
+        std::shared_ptr<ContentFetchBandwidthGovernor> bandwidthGovernor = nullptr,
+        std::shared_ptr<HTTPContentCache> cache = nullptr);
 
     /**
      * @copydoc
@@ -58,6 +74,58 @@ private:
     /// A no-op callback to not parse HTTP bodies.
     static size_t noopCallback(char* data, size_t size, size_t nmemb, void* userData);
 
+    /**
+     * The progress callback, which applies changes to the cap of @c m_bandwidthGovernor.  It is called on the thread
+     * running the transfer at least once a second, so changing the option of the running transfer here is safe.
+     * See @c CURLOPT_XFERINFOFUNCTION for the parameters.
+     */
+    static int progressCallback(
+        void* userData,
+        curl_off_t downloadTotal,
+        curl_off_t downloaded,
+        curl_off_t uploadTotal,
+        curl_off_t uploaded);
+
+    /**
+     * Set the cap on the download rate of the transfer, if it has changed since it was last set.
+     *
+     * @param maxRecvSpeed The largest download rate in bytes per second, or @c 0 for no cap.
+     * @return Whether setting the cap was successful.
+     */
+    bool applyMaxRecvSpeed(curl_off_t maxRecvSpeed);
+
+    /**
+     * Produce the content of a fresh response from @c m_cache, without a transfer.
+     *
+     * @param fetchOption The option passed to @c getContent().
+     * @param entry The entry of the URL in @c m_cache.
+     * @return The content, or @c nullptr if the body of the entry could not be read.
+     */
+    std::unique_ptr<avsCommon::utils::HTTPContent> getCachedContent(
+        FetchOptions fetchOption,
+        const HTTPContentCache::Entry& entry);
+
+    /**
+     * Write the body of the entry of the URL in @c m_cache to the content, after the server confirmed with a
+     * "304 Not Modified" response that it is still valid, and satisfy the promises made by @c getContent().
+     *
+     * @return Whether the body was written and the promises satisfied.
+     */
+    bool writeRevalidatedContent();
+
+    /**
+     * Store the body of the response in @c m_cache, if the response allows it.
+     */
+    void storeInCache();
+
+    /**
+     * Satisfy the promises made by @c getContent() once the transfer has finished.
+     *
+     * @param fetchOption The option passed to @c getContent().
+     * @param result The result of the transfer.
+     */
+    void onTransferDone(FetchOptions fetchOption, CURLcode result);
+
     /// The URL to fetch from.
     std::string m_url;
 
@@ -99,6 +167,42 @@ private:
      */
     std::thread m_thread;
 
+    /// The service which runs the transfer, or @c nullptr if it runs on @c m_thread.
+    std::shared_ptr<LibCurlHttpContentFetchService> m_fetchService;
+
+    /// The governor capping the download rate of the transfer, or @c nullptr.
+    std::shared_ptr<ContentFetchBandwidthGovernor> m_bandwidthGovernor;
+
+    /// The cap last set on the transfer, in bytes per second, or @c 0 for no cap.  Only accessed by the transfer.
+    curl_off_t m_appliedMaxRecvSpeed;
+
+    /// The cache of responses, or @c nullptr.
+    std::shared_ptr<HTTPContentCache> m_cache;
+
+    /// Whether the request is conditional on the entry of the URL in @c m_cache having changed.
+    bool m_isRevalidating;
+
+    /// Whether the body of the response is being kept in @c m_body to be stored in @c m_cache.
+    bool m_isCachingBody;
+
+    /// The body of the response, kept to be stored in @c m_cache.
+    std::string m_body;
+
+    /// The @c Cache-Control header of the last response, or empty if it had none.
+    std::string m_lastCacheControl;
+
+    /// The @c ETag header of the last response, or empty if it had none.
+    std::string m_lastETag;
+
+    /// The @c Last-Modified header of the last response, or empty if it had none.
+    std::string m_lastModified;
+
+    /// The option passed to @c getContent().
+    FetchOptions m_fetchOption;
+
+    /// Whether the transfer has been given to @c m_fetchService and @c onTransferDone() has not yet returned.
+    std::atomic<bool> m_isTransferInProgress;
+
     /// Flag to indicate that a call to @c getContent() has been made. Subsequent calls will not be accepted.
     std::atomic_flag m_hasObjectBeenUsed;
 };
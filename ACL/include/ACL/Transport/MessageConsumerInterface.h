@@ -19,6 +19,8 @@
 #define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_MESSAGE_CONSUMER_INTERFACE_H_
 
 #include <memory>
+#include <string>
+#include <utility>
 
 namespace alexaClientSDK {
 namespace acl {
@@ -40,6 +42,18 @@ public:
      * @param message The AVS message in string representation.
      */
     virtual void consumeMessage(const std::string& contextId, const std::string& message) = 0;
+
+    /**
+     * Called when a message has been received from AVS, passing ownership of the buffer holding it, so that a
+     * consumer which handles the message on another thread need not copy it.  By default, this is passed on to
+     * @c consumeMessage(const std::string&, const std::string&).
+     *
+     * @param contextId The context id for the current message.
+     * @param message The AVS message in string representation.
+     */
+    virtual void consumeMessage(const std::string& contextId, std::string&& message) {
+        consumeMessage(contextId, static_cast<const std::string&>(message));
+    }
 };
 
 }  // namespace acl
@@ -24,13 +24,16 @@
 #include <vector>
 
 #include "AVSCommon/Utils/Threading/Executor.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
 
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/AVS/MessageRequest.h>
 
 #include "AVSCommon/SDKInterfaces/AuthDelegateInterface.h"
+#include "AVSCommon/Utils/Configuration/ConfigurationNode.h"
 #include "ACL/Transport/MessageRouterInterface.h"
 #include "ACL/Transport/MessageRouterObserverInterface.h"
+#include "ACL/Transport/OutboundEventBuffer.h"
 #include "ACL/Transport/TransportInterface.h"
 #include "ACL/Transport/TransportObserverInterface.h"
 #include "ACL/Transport/MessageConsumerInterface.h"
@@ -41,6 +44,17 @@ namespace acl {
 /**
  * This an abstract base class which specifies the interface to manage an actual connection over some medium to AVS.
  *
+ * If @c acl.outboundEventBuffer.maxAgeMs is configured, messages which can not be sent while the connection is down
+ * are held in an @c OutboundEventBuffer, bounded by that age and by @c acl.outboundEventBuffer.maxBytes, and sent as
+ * soon as the connection is back instead of failing with @c NOT_CONNECTED.  Transports may hold the messages they
+ * had queued when the connection was lost in the buffer returned by @c getOutboundEventBuffer().
+ *
+ * When the endpoint is changed while connected, the switch is made before the old connection is broken: a transport
+ * to the new endpoint connects alongside the active one, which keeps carrying messages until the new one has its
+ * downchannel and has synchronized state.  The new transport then becomes the active one, and the old one disconnects
+ * once its streams in flight have completed.  If the new transport does not connect in time, the old one is
+ * disconnected and the router reconnects to the new endpoint as it would otherwise.
+ *
  * Implementations of this class are required to be thread-safe.
  */
 class MessageRouter
@@ -74,6 +88,10 @@ public:
 
     void setObserver(std::shared_ptr<MessageRouterObserverInterface> observer) override;
 
+    void onNetworkAvailable() override;
+
+    void setLowPowerMode(bool enabled) override;
+
     void onConnected() override;
 
     void onDisconnected(avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason reason) override;
@@ -82,6 +100,12 @@ public:
 
     void consumeMessage(const std::string& contextId, const std::string& message) override;
 
+    /**
+     * @inheritDoc
+     * The message is handed to the observer on the executor, so that parsing it never holds up the transport.
+     */
+    void consumeMessage(const std::string& contextId, std::string&& message) override;
+
     void doShutdown() override;
 
 private:
@@ -138,14 +162,37 @@ private:
      * @param contextId The context id for the current message.
      * @param message The AVS message in string representation.
      */
-    void notifyObserverOnReceive(const std::string& contextId, const std::string& message);
+    void notifyObserverOnReceive(const std::string& contextId, std::shared_ptr<const std::string> message);
 
     /**
      * Creates a new transport, and begins the connection process. The new transport immediately becomes the active
-     * transport. @c m_connectionMutex must be locked to call this method.
+     * transport.  If a transport to a new endpoint is connecting, it becomes the active transport instead.
+     * @c m_connectionMutex must be locked to call this method.
      */
     void createActiveTransportLocked();
 
+    /**
+     * Creates a transport to @c m_avsEndpoint, and begins the connection process alongside the active transport.
+     * @c m_connectionMutex must be locked to call this method.
+     *
+     * @return Whether the transport was created and started to connect.
+     */
+    bool createPendingTransportLocked();
+
+    /**
+     * Makes @c m_pendingTransport the active transport.  If it is connected, the other transports are disconnected
+     * once they are idle.  @c m_connectionMutex must be locked to call this method.
+     */
+    void switchToPendingTransportLocked();
+
+    /**
+     * Called on the executor when a transport to a new endpoint took too long to connect.  If it is still pending,
+     * all the transports are disconnected and a new active transport is created.
+     *
+     * @param transport The transport which was pending when the timer was started.
+     */
+    void onEndpointSwitchTimedOut(std::weak_ptr<TransportInterface> transport);
+
     /**
      * Disconnects all transports. @c m_connectionMutex must be locked to call this method.
      *
@@ -164,6 +211,12 @@ private:
      */
     std::shared_ptr<MessageRouterObserverInterface> getObserver();
 
+    /**
+     * Send the messages held in @c m_outboundEventBuffer on @c m_activeTransport.
+     * @c m_connectionMutex must be locked to call this method.
+     */
+    void sendHeldMessagesLocked();
+
     /**
      * Reset m_activeTransport. First check if m_activeTransport is in m_transports.  If not, issue
      * a warning (because it should be) and queue the safe release of our reference to the transport.
@@ -184,6 +237,15 @@ private:
     /// The current AVS endpoint. Access serialized with @c m_connectionMutex.
     std::string m_avsEndpoint;
 
+    /**
+     * The configuration in effect when this router was constructed.  Transports are created with it, so that they
+     * read the same configuration however later connections are triggered.
+     */
+    const avsCommon::utils::configuration::ConfigurationNode m_configurationRoot;
+
+    /// Holds the messages which can not be sent while the connection is down, or @c nullptr.
+    const std::shared_ptr<OutboundEventBuffer> m_outboundEventBuffer;
+
     /// The AuthDelegateInterface which provides a valid access token.
     std::shared_ptr<avsCommon::sdkInterfaces::AuthDelegateInterface> m_authDelegate;
 
@@ -202,22 +264,45 @@ private:
      */
     bool m_isEnabled;
 
+    /// Whether the transports are in low-power mode. Access serialized with @c m_connectionMutex.
+    bool m_isLowPowerMode;
+
     /// A vector of all transports which are not disconnected. Access serialized with @c m_connectionMutex.
     std::vector<std::shared_ptr<TransportInterface>> m_transports;
 
     /// The current active transport to send messages on. Access serialized with @c m_connectionMutex.
     std::shared_ptr<TransportInterface> m_activeTransport;
 
+    /**
+     * The transport to a new endpoint which is connecting alongside @c m_activeTransport, or @c nullptr.  It is not in
+     * @c m_transports until it becomes the active transport.  Access serialized with @c m_connectionMutex.
+     */
+    std::shared_ptr<TransportInterface> m_pendingTransport;
+
     /// The attachment manager.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> m_attachmentManager;
 
 protected:
+    /**
+     * Get the buffer holding the messages which can not be sent while the connection is down.
+     *
+     * @return The buffer, or @c nullptr if messages are not held.
+     */
+    std::shared_ptr<OutboundEventBuffer> getOutboundEventBuffer() const;
+
     /**
      * Executor to perform asynchronous operations:
      * @li Delivery of connection status notifications.
      * @li completion of send operations delayed by a pending connection state.
      */
     avsCommon::utils::threading::Executor m_executor;
+
+private:
+    /**
+     * Bounds the time @c m_pendingTransport may take to connect.  Its task only submits to @c m_executor, so that it
+     * may be stopped with @c m_connectionMutex held.
+     */
+    avsCommon::utils::timing::Timer m_endpointSwitchTimer;
 };
 
 }  // namespace acl
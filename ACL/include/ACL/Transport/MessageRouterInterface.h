@@ -90,11 +90,31 @@ public:
      * and when messages arrive from AVS.
      */
     virtual void setObserver(std::shared_ptr<MessageRouterObserverInterface> observer) = 0;
+
+    /**
+     * Notification that the network has become available.  If the underlying implementation is enabled but not
+     * connected, it should stop waiting to retry connecting and retry at once.  Otherwise, it should do nothing.
+     */
+    virtual void onNetworkAvailable();
+
+    /**
+     * Set whether the device runs on battery, so that the underlying implementation should keep the connection alive
+     * with as few wake-ups as possible.  The default implementation does nothing.
+     *
+     * @param enabled Whether the low-power mode is enabled.
+     */
+    virtual void setLowPowerMode(bool enabled);
 };
 
 inline MessageRouterInterface::MessageRouterInterface(const std::string& name) : RequiresShutdown(name) {
 }
 
+inline void MessageRouterInterface::onNetworkAvailable() {
+}
+
+inline void MessageRouterInterface::setLowPowerMode(bool enabled) {
+}
+
 }  // namespace acl
 }  // namespace alexaClientSDK
 
@@ -21,6 +21,7 @@
 #ifndef ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_MIME_PARSER_H_
 #define ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_MIME_PARSER_H_
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <iostream>
@@ -180,6 +181,11 @@ private:
     ContentType m_currDataType;
     /// Instance of a multipart MIME reader.
     MultipartReader m_multipartReader;
+    /**
+     * The state of @c m_multipartReader at the start of the current @c feed(), restored if the feed must be re-driven.
+     * Kept as a member so that taking the snapshot reuses its storage rather than allocating on every feed.
+     */
+    MultipartReader m_multipartReaderSnapshot;
     /// The object to report back to when JSON MIME parts are received.
     std::shared_ptr<MessageConsumerInterface> m_messageConsumer;
     /// The attachment manager.
@@ -191,6 +197,10 @@ private:
      * the write quantums are small, or if the message is long.
      */
     std::string m_directiveBeingReceived;
+    /// When the directive being received started to arrive, set only while directive latencies are tracked.
+    std::chrono::steady_clock::time_point m_directiveReceivedAt;
+    /// The dialogRequestId of the last directive received, until data of an attachment after it has been received.
+    std::string m_tracedDialogRequestId;
     /**
      * The attachment id of the attachment currently being processed.  This variable is needed to prevent duplicate
      * creation of @c Attachment objects when data is re-driven.
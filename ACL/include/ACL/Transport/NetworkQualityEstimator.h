@@ -0,0 +1,139 @@
+/*
+ * NetworkQualityEstimator.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_NETWORK_QUALITY_ESTIMATOR_H_
+#define ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_NETWORK_QUALITY_ESTIMATOR_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <AVSCommon/SDKInterfaces/NetworkQualityObserverInterface.h>
+#include <AVSCommon/Utils/Threading/CopyOnWriteSet.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Estimates the quality of the connection to AVS from the transfers of the transports which share it, and tells its
+ * observers when the estimate changes noticeably.
+ *
+ * The round trip time is taken from pings, whose responses the server sends at once.  The throughput is taken from
+ * responses large enough for their download time not to be dominated by the round trip, since uploads are paced by
+ * their attachments.  The loss rate counts the pings and transfers which failed in the network.  Each signal is an
+ * exponentially weighted moving average, so that a single outlier does not swing it.
+ *
+ * This class is thread-safe.
+ */
+class NetworkQualityEstimator {
+public:
+    /// The estimate of the quality of the connection.
+    using NetworkQuality = avsCommon::sdkInterfaces::NetworkQualityObserverInterface::NetworkQuality;
+
+    /// The smallest response to measure the throughput with, in bytes.
+    static const uint64_t MIN_THROUGHPUT_SAMPLE_BYTES;
+
+    /**
+     * Count a finished ping.
+     *
+     * @param succeeded Whether the ping got its response.
+     * @param rtt The time from sending the ping to its response, which is ignored if it did not succeed.
+     */
+    void recordPing(bool succeeded, std::chrono::microseconds rtt);
+
+    /**
+     * Count a finished transfer.
+     *
+     * @param succeeded Whether the transfer completed in the network, whatever the status of its response.
+     * @param responseBytes The number of bytes of the response which were received.
+     * @param responseTime The time from the first byte of the response to its end.
+     */
+    void recordTransfer(bool succeeded, uint64_t responseBytes, std::chrono::microseconds responseTime);
+
+    /**
+     * Get the current estimate.
+     *
+     * @return The current estimate.
+     */
+    NetworkQuality getQuality() const;
+
+    /**
+     * Add an observer of the estimate.
+     *
+     * @param observer The observer to add.
+     */
+    void addObserver(std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface> observer);
+
+    /**
+     * Remove an observer of the estimate.
+     *
+     * @param observer The observer to remove.
+     */
+    void removeObserver(std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface> observer);
+
+private:
+    /**
+     * Get the current estimate.
+     * @note This method must only be called by threads that have acquired @c m_mutex.
+     *
+     * @return The current estimate.
+     */
+    NetworkQuality getQualityLocked() const;
+
+    /**
+     * Check whether the estimate has changed noticeably since it was last published, and if so, note that it is
+     * being published.
+     * @note This method must only be called by threads that have acquired @c m_mutex.
+     *
+     * @param[out] quality The estimate to publish, if it should be.
+     * @return Whether the estimate should be published.
+     */
+    bool shouldPublishLocked(NetworkQuality* quality);
+
+    /**
+     * Tell the observers about an estimate.
+     *
+     * @param quality The estimate.
+     */
+    void publish(const NetworkQuality& quality);
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The smoothed round trip time, in microseconds, or zero if none has been measured.
+    double m_rttUs = 0;
+
+    /// The smoothed throughput, in bytes per second, or zero if none has been measured.
+    double m_throughput = 0;
+
+    /// The smoothed loss rate.
+    double m_lossRate = 0;
+
+    /// The estimate last published.
+    NetworkQuality m_published;
+
+    /// The observers of the estimate.
+    avsCommon::utils::threading::CopyOnWriteSet<
+        std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface>>
+        m_observers;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_NETWORK_QUALITY_ESTIMATOR_H_
@@ -0,0 +1,154 @@
+/*
+ * OutboundEventBuffer.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_OUTBOUND_EVENT_BUFFER_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_OUTBOUND_EVENT_BUFFER_H_
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/Utils/Timing/Timer.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Holds the @c MessageRequests which could not be sent because the connection to AVS was lost, so that they can be
+ * sent once it is back, rather than failing them with @c NOT_CONNECTED and leaving them to be regenerated.
+ *
+ * A request is held for at most a maximum age, after which it is failed with @c NOT_CONNECTED as it would have been
+ * without the buffer.  The JSON content of the held requests is bounded by a maximum number of bytes; a request which
+ * does not fit is refused.
+ */
+class OutboundEventBuffer {
+public:
+    /**
+     * Create an OutboundEventBuffer.
+     *
+     * @param maxAge How long a request may be held.
+     * @param maxBytes The most bytes of JSON content which may be held.
+     * @return A new OutboundEventBuffer, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<OutboundEventBuffer> create(std::chrono::milliseconds maxAge, size_t maxBytes);
+
+    /**
+     * Destructor.  Fails the requests still held with @c NOT_CONNECTED.
+     */
+    ~OutboundEventBuffer();
+
+    /**
+     * Hold a request until it is released.
+     *
+     * @param request The request to hold.
+     * @return Whether the request is held.  If not, the caller should complete it.
+     */
+    bool hold(std::shared_ptr<avsCommon::avs::MessageRequest> request);
+
+    /**
+     * Release the requests which are held, in the order they should be sent: by priority, and in the order they were
+     * held within a priority.  Requests older than the maximum age are failed with @c NOT_CONNECTED instead.
+     *
+     * @return The requests to send.
+     */
+    std::vector<std::shared_ptr<avsCommon::avs::MessageRequest>> release();
+
+    /**
+     * Fail all requests which are held with @c NOT_CONNECTED.
+     */
+    void failAll();
+
+    /**
+     * Get the number of requests which are held.
+     *
+     * @return The number of requests which are held.
+     */
+    size_t size();
+
+    /// @cond
+    OutboundEventBuffer(const OutboundEventBuffer&) = delete;
+    OutboundEventBuffer& operator=(const OutboundEventBuffer&) = delete;
+    /// @endcond
+
+private:
+    /// A request which is held.
+    struct Entry {
+        /// The request.
+        std::shared_ptr<avsCommon::avs::MessageRequest> request;
+
+        /// The size of the JSON content of @c request.
+        size_t bytes;
+
+        /// When @c request was held.
+        std::chrono::steady_clock::time_point holdTime;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param maxAge How long a request may be held.
+     * @param maxBytes The most bytes of JSON content which may be held.
+     */
+    OutboundEventBuffer(std::chrono::milliseconds maxAge, size_t maxBytes);
+
+    /**
+     * Fail the requests which are older than @c m_maxAge with @c NOT_CONNECTED.
+     */
+    void expire();
+
+    /**
+     * Remove the requests which are older than @c m_maxAge.  @c m_mutex must be locked to call this method.
+     *
+     * @param now The current time.
+     * @return The removed requests.
+     */
+    std::vector<std::shared_ptr<avsCommon::avs::MessageRequest>> removeExpiredLocked(
+        std::chrono::steady_clock::time_point now);
+
+    /**
+     * Fail requests with @c NOT_CONNECTED.
+     *
+     * @param requests The requests to fail.
+     */
+    static void fail(const std::vector<std::shared_ptr<avsCommon::avs::MessageRequest>>& requests);
+
+    /// How long a request may be held.
+    const std::chrono::milliseconds m_maxAge;
+
+    /// The most bytes of JSON content which may be held.
+    const size_t m_maxBytes;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The requests which are held, oldest first.
+    std::deque<Entry> m_entries;
+
+    /// The total size of the JSON content of @c m_entries.
+    size_t m_bytes;
+
+    /// Fails the requests which are held too long, even if they are never released.
+    avsCommon::utils::timing::Timer m_expiryTimer;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_OUTBOUND_EVENT_BUFFER_H_
@@ -18,11 +18,11 @@
 #ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_POST_CONNECT_SYNCHRONIZER_H_
 #define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_POST_CONNECT_SYNCHRONIZER_H_
 
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
-#include <unordered_set>
 
 #include "ACL/Transport/PostConnectObject.h"
 #include "ACL/Transport/PostConnectSendMessageInterface.h"
@@ -31,6 +31,8 @@
 #include <AVSCommon/SDKInterfaces/ContextRequesterInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageRequestObserverInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
+#include <AVSCommon/Utils/Threading/CopyOnWriteSet.h>
+#include <AVSCommon/Utils/Timing/Clock.h>
 
 namespace alexaClientSDK {
 namespace acl {
@@ -39,6 +41,11 @@ class HTTP2Transport;
 
 /**
  * Class that posts the StateSynchronizer message to the AVS.
+ *
+ * By default the message carries a context fetched for it, for which every @c StateProviderInterface with the
+ * @c ALWAYS refresh policy is asked for its state.  If @c acl.postConnectCachedContextMaxAgeMs is configured, a context
+ * the @c ContextManager fetched at most that long ago is sent instead, straight from @c doPostConnect(), so that it
+ * goes out together with the downchannel.  If no such context is available, one is fetched as usual.
  */
 class PostConnectSynchronizer
         : public PostConnectObject
@@ -77,6 +84,14 @@ private:
      */
     void postConnectLoop();
 
+    /**
+     * Build the SynchronizeState message and send it to a transport.
+     *
+     * @param jsonContext The context to send.
+     * @param transport The transport to send the message to.
+     */
+    void sendSynchronizeState(const std::string& jsonContext, std::shared_ptr<HTTP2Transport> transport);
+
     /**
      * Thread safe method which returns if the post-connect object.
      * is being stopped.
@@ -110,11 +125,8 @@ private:
     /// Thread which runs the state synchronization operation.
     std::thread m_postConnectThread;
 
-    /// Mutex to protect the m_observers variable.
-    std::mutex m_observerMutex;
-
-    /// Unordered set of registered observers.
-    std::unordered_set<std::shared_ptr<PostConnectObserverInterface>> m_observers;
+    /// Set of registered observers.
+    avsCommon::utils::threading::CopyOnWriteSet<std::shared_ptr<PostConnectObserverInterface>> m_observers;
 
     /// Serializes access to members.
     std::mutex m_mutex;
@@ -122,8 +134,14 @@ private:
     /// Condition variable on which m_postConnectThread waits.
     std::condition_variable m_wakeRetryTrigger;
 
+    /// The clock the retry back-off is waited on, which is the default when the synchronizer is created.
+    const std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
     /// The HTTP2Transport object to which the StateSynchronizer message is sent.
     std::shared_ptr<HTTP2Transport> m_transport;
+
+    /// The oldest cached context which may be sent, or zero to always fetch a context.
+    const std::chrono::milliseconds m_cachedContextMaxAge;
 };
 
 }  // namespace acl
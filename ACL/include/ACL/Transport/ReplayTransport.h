@@ -0,0 +1,166 @@
+/*
+ * ReplayTransport.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_REPLAY_TRANSPORT_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_REPLAY_TRANSPORT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+
+#include "ACL/Transport/MessageConsumerInterface.h"
+#include "ACL/Transport/TrafficRecorder.h"
+#include "ACL/Transport/TransportInterface.h"
+#include "ACL/Transport/TransportObserverInterface.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * A @c TransportInterface which, instead of connecting to AVS, feeds a recording made by @c TrafficRecorder through
+ * @c MimeParser to the @c MessageConsumerInterface, so that the client can be exercised without a network.  Events
+ * sent through it are completed with @c SUCCESS straight away, and the recorded responses are fed on their own
+ * timeline rather than in answer to them.
+ *
+ * To use it in place of @c HTTP2Transport, return it from @c MessageRouter::createTransport().
+ */
+class ReplayTransport : public TransportInterface {
+public:
+    /// How fast a recording is fed.
+    enum class Pace {
+        /// Each record is fed when it was received, relative to the start of the recording.
+        REAL_TIME,
+
+        /// Each record is fed as soon as the one before it has been parsed.
+        AS_FAST_AS_POSSIBLE
+    };
+
+    /**
+     * Create a ReplayTransport.
+     *
+     * @param messageConsumer The MessageConsumerInterface to pass messages to.
+     * @param attachmentManager The attachment manager to create attachments with.
+     * @param records The recording to feed, as returned by @c TrafficRecorder::stop() or @c TrafficRecorder::load().
+     * @param pace How fast to feed the recording.
+     * @param transportObserver An optional observer of the connection.
+     * @return A new ReplayTransport, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<ReplayTransport> create(
+        std::shared_ptr<MessageConsumerInterface> messageConsumer,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+        std::vector<TrafficRecorder::Record> records,
+        Pace pace,
+        std::shared_ptr<TransportObserverInterface> transportObserver = nullptr);
+
+    /**
+     * Destructor.
+     */
+    ~ReplayTransport();
+
+    /// @name TransportInterface methods
+    /// @{
+    bool connect() override;
+    void disconnect() override;
+    bool isConnected() override;
+    void send(std::shared_ptr<avsCommon::avs::MessageRequest> request) override;
+    /// @}
+
+    /**
+     * Wait for the whole recording to be fed.
+     *
+     * @param timeout The longest time to wait.
+     * @return Whether the whole recording was fed.
+     */
+    bool waitUntilReplayed(std::chrono::milliseconds timeout);
+
+protected:
+    void doShutdown() override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param messageConsumer The MessageConsumerInterface to pass messages to.
+     * @param attachmentManager The attachment manager to create attachments with.
+     * @param records The recording to feed.
+     * @param pace How fast to feed the recording.
+     * @param transportObserver An optional observer of the connection.
+     */
+    ReplayTransport(
+        std::shared_ptr<MessageConsumerInterface> messageConsumer,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+        std::vector<TrafficRecorder::Record> records,
+        Pace pace,
+        std::shared_ptr<TransportObserverInterface> transportObserver);
+
+    /**
+     * Feed the recording, on @c m_replayThread.
+     */
+    void replayLoop();
+
+    /**
+     * Wait until @c disconnect() is called or @c deadline passes.
+     *
+     * @param deadline When to stop waiting.
+     * @return Whether @c disconnect() was called.
+     */
+    bool waitForStop(std::chrono::steady_clock::time_point deadline);
+
+    /// The MessageConsumerInterface to pass messages to.
+    std::shared_ptr<MessageConsumerInterface> m_messageConsumer;
+
+    /// The attachment manager to create attachments with.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> m_attachmentManager;
+
+    /// The recording to feed.
+    std::vector<TrafficRecorder::Record> m_records;
+
+    /// How fast to feed the recording.
+    const Pace m_pace;
+
+    /// The observer of the connection, which may be @c nullptr.
+    std::shared_ptr<TransportObserverInterface> m_observer;
+
+    /// Whether the transport is connected.
+    std::atomic<bool> m_isConnected;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when @c m_isStopping or @c m_isReplayed change.
+    std::condition_variable m_wakeTrigger;
+
+    /// Whether @c disconnect() has been called.  A transport which has been disconnected can not connect again.
+    bool m_isStopping;
+
+    /// Whether the whole recording has been fed.
+    bool m_isReplayed;
+
+    /// The thread feeding the recording.
+    std::thread m_replayThread;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_REPLAY_TRANSPORT_H_
@@ -0,0 +1,175 @@
+/*
+ * TrafficRecorder.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_TRAFFIC_RECORDER_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_TRAFFIC_RECORDER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Records the MIME multipart responses received from AVS, on the downchannel and in response to events, so that they
+ * can be fed back through a @c ReplayTransport.  The bytes are recorded as @c HTTP2Stream received them, along with
+ * when they were received, so the replay can keep the original pace.
+ *
+ * Recording is disabled by default, in which case checking whether to record costs a single atomic load.
+ */
+class TrafficRecorder {
+public:
+    /// What a @c Record holds.
+    enum class RecordType {
+        /// A stream started receiving a MIME multipart response.  @c Record::data holds the boundary.
+        STREAM_START,
+
+        /// Bytes of a MIME multipart response.  @c Record::data holds the bytes.
+        DATA
+    };
+
+    /// One thing received by a stream.
+    struct Record {
+        /// What the record holds.
+        RecordType type;
+
+        /// The logical id of the stream.
+        unsigned int streamId;
+
+        /// Whether the stream is the downchannel, rather than the response to an event.
+        bool isDownchannel;
+
+        /// When the record was made, from the start of the recording.
+        std::chrono::microseconds offset;
+
+        /// The boundary or the bytes, depending on @c type.
+        std::string data;
+    };
+
+    /// The default limit on the bytes of data held by a recording.
+    static const size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    /**
+     * Get the process-wide @c TrafficRecorder.
+     *
+     * @return The process-wide @c TrafficRecorder.
+     */
+    static TrafficRecorder& instance();
+
+    /**
+     * Start a new recording, discarding any recording in progress.
+     *
+     * @param maxBytes The most bytes of data to hold.  Records which would take the recording beyond this are dropped.
+     */
+    void start(size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * Stop recording.
+     *
+     * @return The records made since @c start(), in the order they were made.
+     */
+    std::vector<Record> stop();
+
+    /**
+     * Whether a recording is in progress.
+     *
+     * @return Whether what streams receive should be recorded.
+     */
+    bool isRecording() const;
+
+    /**
+     * Record that a stream started receiving a MIME multipart response.
+     *
+     * @param streamId The logical id of the stream.
+     * @param isDownchannel Whether the stream is the downchannel.
+     * @param boundary The MIME boundary of the response.
+     */
+    void recordStreamStart(unsigned int streamId, bool isDownchannel, const std::string& boundary);
+
+    /**
+     * Record bytes of a MIME multipart response.
+     *
+     * @param streamId The logical id of the stream.
+     * @param isDownchannel Whether the stream is the downchannel.
+     * @param data The bytes.
+     * @param length The number of bytes.
+     */
+    void recordData(unsigned int streamId, bool isDownchannel, const char* data, size_t length);
+
+    /**
+     * Write records to a stream, in a form @c load() can read.
+     *
+     * @param records The records to write.
+     * @param stream The stream to write to.
+     * @return Whether the records were written.
+     */
+    static bool save(const std::vector<Record>& records, std::ostream& stream);
+
+    /**
+     * Read records written by @c save().
+     *
+     * @param stream The stream to read from.
+     * @param[out] records The records read.
+     * @return Whether the whole stream was read.
+     */
+    static bool load(std::istream& stream, std::vector<Record>* records);
+
+private:
+    /**
+     * Constructor.
+     */
+    TrafficRecorder();
+
+    /**
+     * Add a record to the recording in progress.
+     *
+     * @param record The record to add.
+     */
+    void add(Record&& record);
+
+    /// Whether a recording is in progress.
+    std::atomic<bool> m_isRecording;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// When the recording started.
+    std::chrono::steady_clock::time_point m_startTime;
+
+    /// The most bytes of data the recording may hold.
+    size_t m_maxBytes;
+
+    /// The bytes of data the recording holds.
+    size_t m_bytes;
+
+    /// The number of records dropped because of @c m_maxBytes.
+    size_t m_droppedRecords;
+
+    /// The records made so far.
+    std::vector<Record> m_records;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_TRAFFIC_RECORDER_H_
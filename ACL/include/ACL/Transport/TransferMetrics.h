@@ -0,0 +1,157 @@
+/*
+ * TransferMetrics.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_TRANSFER_METRICS_H_
+#define ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_TRANSFER_METRICS_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/MessageRequestObserverInterface.h>
+#include <AVSCommon/Utils/Metrics/LatencyHistogram.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Keeps a @c LatencyHistogram of each phase of the transfers of each kind of stream of a transport, so that the
+ * latencies of a connection can be read with @c getSummaries(), or logged with @c dump().
+ */
+class TransferMetrics {
+public:
+    /// The kinds of stream a transport makes.
+    enum class StreamType {
+        /// A stream sending an event.
+        EVENT,
+
+        /// The downchannel stream.
+        DOWNCHANNEL,
+
+        /// A stream sending a ping.
+        PING
+    };
+
+    /// The number of values of @c StreamType.
+    static const size_t NUM_STREAM_TYPES = static_cast<size_t>(StreamType::PING) + 1;
+
+    /// The phases of a transfer, matching the fields of @c TransferTimings.
+    enum class Phase {
+        /// The time the message waited in the transport's queue.
+        QUEUE_WAIT,
+
+        /// The time until the first byte was about to be uploaded.
+        FIRST_UPLOAD_BYTE,
+
+        /// The time until the upload was complete.
+        UPLOAD_COMPLETE,
+
+        /// The time until the first byte of the response was received.
+        FIRST_RESPONSE_BYTE,
+
+        /// The time until the response was complete.
+        RESPONSE_COMPLETE
+    };
+
+    /// The number of values of @c Phase.
+    static const size_t NUM_PHASES = static_cast<size_t>(Phase::RESPONSE_COMPLETE) + 1;
+
+    /// The latencies of a phase of the transfers of a kind of stream.
+    struct Summary {
+        /// The kind of stream.
+        StreamType streamType;
+
+        /// The phase.
+        Phase phase;
+
+        /// The number of transfers which reached the phase.
+        uint64_t count;
+
+        /// The median latency.
+        std::chrono::microseconds p50;
+
+        /// The 90th percentile latency.
+        std::chrono::microseconds p90;
+
+        /// The 99th percentile latency.
+        std::chrono::microseconds p99;
+
+        /// The largest latency.
+        std::chrono::microseconds max;
+    };
+
+    /**
+     * Count the timing of a finished transfer.  Phases which were not reached are not counted.
+     *
+     * @param streamType The kind of stream which made the transfer.
+     * @param timings The timing of the transfer.
+     */
+    void record(
+        StreamType streamType,
+        const avsCommon::sdkInterfaces::MessageRequestObserverInterface::TransferTimings& timings);
+
+    /**
+     * Get the latencies counted so far.
+     *
+     * @return The latencies of each phase reached by the transfers of each kind of stream, ordered by kind of stream
+     * and then by phase.
+     */
+    std::vector<Summary> getSummaries() const;
+
+    /**
+     * Forget the latencies counted so far.
+     */
+    void reset();
+
+    /**
+     * Log the latencies counted so far.
+     */
+    void dump() const;
+
+private:
+    /// Serializes access to @c m_histograms.
+    mutable std::mutex m_mutex;
+
+    /// The histogram of each phase of the transfers of each kind of stream, in microseconds.
+    std::array<std::array<avsCommon::utils::metrics::LatencyHistogram, NUM_PHASES>, NUM_STREAM_TYPES> m_histograms;
+};
+
+/**
+ * Write a @c TransferMetrics::StreamType value to an @c ostream as a string.
+ *
+ * @param stream The stream to write to.
+ * @param streamType The value to write.
+ * @return The stream that was passed in and written to.
+ */
+std::ostream& operator<<(std::ostream& stream, TransferMetrics::StreamType streamType);
+
+/**
+ * Write a @c TransferMetrics::Phase value to an @c ostream as a string.
+ *
+ * @param stream The stream to write to.
+ * @param phase The value to write.
+ * @return The stream that was passed in and written to.
+ */
+std::ostream& operator<<(std::ostream& stream, TransferMetrics::Phase phase);
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXACLIENTSDK_ACL_INCLUDE_ACL_TRANSPORT_TRANSFER_METRICS_H_
@@ -65,11 +65,42 @@ public:
      * @param request The requested message.
      */
     virtual void send(std::shared_ptr<avsCommon::avs::MessageRequest> request) = 0;
+
+    /**
+     * Notification that the network has become available.  If this object is waiting to retry connecting, it should
+     * stop waiting and retry at once.  If it is connected, it should do nothing.
+     */
+    virtual void onNetworkAvailable();
+
+    /**
+     * Disconnect from AVS once the messages already handed to this object have been sent and answered.  It is called
+     * on a transport which another one has replaced, so that its streams in flight are not cut short.  The default
+     * implementation disconnects at once.
+     */
+    virtual void disconnectWhenIdle();
+
+    /**
+     * Set whether the device runs on battery and the connection should wake it up as rarely as possible, at the cost
+     * of noticing a dead connection later.  The default implementation does nothing.
+     *
+     * @param enabled Whether the low-power mode is enabled.
+     */
+    virtual void setLowPowerMode(bool enabled);
 };
 
 inline TransportInterface::TransportInterface() : RequiresShutdown{"TransportInterface"} {
 }
 
+inline void TransportInterface::onNetworkAvailable() {
+}
+
+inline void TransportInterface::disconnectWhenIdle() {
+    disconnect();
+}
+
+inline void TransportInterface::setLowPowerMode(bool enabled) {
+}
+
 }  // namespace acl
 }  // namespace alexaClientSDK
 
@@ -85,6 +85,8 @@ AVSConnectionManager::AVSConnectionManager(
         AbstractConnection{connectionStatusObservers},
         RequiresShutdown{"AVSConnectionManager"},
         m_isEnabled{false},
+        m_isLowPowerMode{false},
+        m_isDozing{false},
         m_messageObservers{messageObservers},
         m_messageRouter{messageRouter} {
 }
@@ -100,11 +102,15 @@ void AVSConnectionManager::doShutdown() {
 }
 
 void AVSConnectionManager::enable() {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
+    m_isDozing = false;
     m_isEnabled = true;
     m_messageRouter->enable();
 }
 
 void AVSConnectionManager::disable() {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
+    m_isDozing = false;
     m_isEnabled = false;
     m_messageRouter->disable();
 }
@@ -114,13 +120,69 @@ bool AVSConnectionManager::isEnabled() {
 }
 
 void AVSConnectionManager::reconnect() {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
     if (m_isEnabled) {
+        m_isDozing = false;
         m_messageRouter->disable();
         m_messageRouter->enable();
     }
 }
 
+void AVSConnectionManager::onNetworkAvailable() {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
+    // A dozing connection stays closed until it is needed.
+    if (m_isEnabled && !m_isDozing) {
+        m_messageRouter->onNetworkAvailable();
+    }
+}
+
+void AVSConnectionManager::setLowPowerMode(bool enabled) {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
+    ACSDK_INFO(LX("setLowPowerMode").d("enabled", enabled));
+    m_isLowPowerMode = enabled;
+    m_messageRouter->setLowPowerMode(enabled);
+    if (!enabled) {
+        wakeLocked();
+    }
+}
+
+void AVSConnectionManager::wake() {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
+    wakeLocked();
+}
+
+bool AVSConnectionManager::isDozing() {
+    return m_isDozing;
+}
+
+void AVSConnectionManager::wakeLocked() {
+    if (m_isDozing) {
+        ACSDK_INFO(LX("wake"));
+        m_isDozing = false;
+        if (m_isEnabled) {
+            m_messageRouter->enable();
+        }
+    }
+}
+
+void AVSConnectionManager::onUserInactive() {
+    std::lock_guard<std::mutex> lock{m_lowPowerMutex};
+    if (m_isLowPowerMode && m_isEnabled && !m_isDozing) {
+        ACSDK_INFO(LX("doze").d("reason", "userInactive"));
+        // Disabling fails the held messages, whose observers may send others, so m_isDozing is only set afterwards.
+        m_messageRouter->disable();
+        m_isDozing = true;
+    }
+}
+
+void AVSConnectionManager::onUserActiveAgain() {
+    wake();
+}
+
 void AVSConnectionManager::sendMessage(std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+    if (m_isDozing) {
+        wake();
+    }
     m_messageRouter->sendMessage(request);
 }
 
@@ -0,0 +1,72 @@
+/*
+ * ContentFetchBandwidthGovernor.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/ContentFetchBandwidthGovernor.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ContentFetchBandwidthGovernor");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<ContentFetchBandwidthGovernor> ContentFetchBandwidthGovernor::create(curl_off_t dialogMaxRecvSpeed) {
+    if (dialogMaxRecvSpeed <= 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidMaxRecvSpeed").d("dialogMaxRecvSpeed", dialogMaxRecvSpeed));
+        return nullptr;
+    }
+    return std::shared_ptr<ContentFetchBandwidthGovernor>(new ContentFetchBandwidthGovernor(dialogMaxRecvSpeed));
+}
+
+ContentFetchBandwidthGovernor::ContentFetchBandwidthGovernor(curl_off_t dialogMaxRecvSpeed) :
+        m_dialogMaxRecvSpeed{dialogMaxRecvSpeed},
+        m_maxRecvSpeed{0} {
+}
+
+void ContentFetchBandwidthGovernor::onDialogUXStateChanged(DialogUXState newState) {
+    curl_off_t maxRecvSpeed = 0;
+    switch (newState) {
+        case DialogUXState::LISTENING:
+        case DialogUXState::THINKING:
+            maxRecvSpeed = m_dialogMaxRecvSpeed;
+            break;
+        case DialogUXState::IDLE:
+        case DialogUXState::SPEAKING:
+        case DialogUXState::FINISHED:
+            break;
+    }
+    if (m_maxRecvSpeed.exchange(maxRecvSpeed) != maxRecvSpeed) {
+        ACSDK_DEBUG(LX("onDialogUXStateChanged")
+                        .d("state", stateToString(newState))
+                        .d("maxRecvSpeed", static_cast<int64_t>(maxRecvSpeed)));
+    }
+}
+
+curl_off_t ContentFetchBandwidthGovernor::getMaxRecvSpeed() const {
+    return m_maxRecvSpeed;
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -98,6 +98,37 @@ bool CurlEasyHandleWrapper::reset() {
     return setDefaultOptions();
 }
 
+bool CurlEasyHandleWrapper::resetForReuse(bool* areOptionsKept) {
+    *areOptionsKept = false;
+    long responseCode = 0;
+    CURLcode ret = curl_easy_getinfo(m_handle, CURLINFO_RESPONSE_CODE, &responseCode);
+    // See reset() for why handles which received an HTTP 204 are not re-used.
+    if (ret != CURLE_OK || HTTP_RESPONSE_SUCCESS_NO_CONTENT == responseCode) {
+        return reset();
+    }
+
+    // Detach the POST form from the handle before freeing it, then return to a GET without timeouts.
+    struct curl_httppost* noPost = nullptr;
+    if (curl_easy_setopt(m_handle, CURLOPT_HTTPPOST, noPost) != CURLE_OK ||
+        curl_easy_setopt(m_handle, CURLOPT_HTTPGET, 1L) != CURLE_OK ||
+        curl_easy_setopt(m_handle, CURLOPT_TIMEOUT, 0L) != CURLE_OK ||
+        curl_easy_setopt(m_handle, CURLOPT_CONNECTTIMEOUT, 0L) != CURLE_OK) {
+        ACSDK_ERROR(LX("resetForReuseFailed").d("reason", "curlFailure").d("method", "curl_easy_setopt"));
+        return reset();
+    }
+    if (m_postHeaders) {
+        curl_slist_free_all(m_postHeaders);
+        m_postHeaders = nullptr;
+    }
+    if (m_post) {
+        curl_formfree(m_post);
+        m_post = nullptr;
+    }
+    m_postContents.clear();
+    *areOptionsKept = true;
+    return true;
+}
+
 CURL* CurlEasyHandleWrapper::getCurlHandle() {
     return m_handle;
 }
@@ -123,7 +154,7 @@ bool CurlEasyHandleWrapper::addHTTPHeader(const std::string& header) {
 
 bool CurlEasyHandleWrapper::addPostHeader(const std::string& header) {
     m_postHeaders = curl_slist_append(m_postHeaders, header.c_str());
-    if (!m_requestHeaders) {
+    if (!m_postHeaders) {
         ACSDK_ERROR(LX("addPostHeaderFailed").d("reason", "curlFailure").d("method", "curl_slist_append"));
         ACSDK_DEBUG(LX("addPostHeaderFailed").d("header", header));
         return false;
@@ -182,7 +213,9 @@ bool CurlEasyHandleWrapper::setPostContent(const std::string& fieldName, const s
         CURLFORM_COPYNAME,
         fieldName.c_str(),
         CURLFORM_COPYCONTENTS,
-        payload.c_str(),
+        payload.data(),
+        CURLFORM_CONTENTSLENGTH,
+        static_cast<long>(payload.size()),
         CURLFORM_CONTENTTYPE,
         JSON_MIME_TYPE.c_str(),
         CURLFORM_CONTENTHEADER,
@@ -201,6 +234,42 @@ bool CurlEasyHandleWrapper::setPostContent(const std::string& fieldName, const s
     return true;
 }
 
+bool CurlEasyHandleWrapper::setPostContent(
+    const std::string& fieldName,
+    std::shared_ptr<const std::string> payload) {
+    if (!payload) {
+        ACSDK_ERROR(LX("setPostContentFailed").d("reason", "nullPayload").d("fieldName", fieldName));
+        return false;
+    }
+    curl_httppost* last = nullptr;
+    CURLFORMcode ret = curl_formadd(
+        &m_post,
+        &last,
+        CURLFORM_COPYNAME,
+        fieldName.c_str(),
+        CURLFORM_PTRCONTENTS,
+        payload->data(),
+        CURLFORM_CONTENTSLENGTH,
+        static_cast<long>(payload->size()),
+        CURLFORM_CONTENTTYPE,
+        JSON_MIME_TYPE.c_str(),
+        CURLFORM_CONTENTHEADER,
+        m_postHeaders,
+        CURLFORM_END);
+    if (ret) {
+        ACSDK_ERROR(LX("setPostContentFailed")
+                        .d("reason", "curlFailure")
+                        .d("method", "curl_formadd")
+                        .d("fieldName", fieldName)
+                        .sensitive("content", *payload)
+                        .d("curlFormCode", ret));
+
+        return false;
+    }
+    m_postContents.push_back(std::move(payload));
+    return true;
+}
+
 bool CurlEasyHandleWrapper::setTransferTimeout(const long timeoutSeconds) {
     CURLcode ret = curl_easy_setopt(m_handle, CURLOPT_TIMEOUT, timeoutSeconds);
     if (ret != CURLE_OK) {
@@ -238,6 +307,40 @@ bool CurlEasyHandleWrapper::setPostStream(const std::string& fieldName, void* us
     return true;
 }
 
+bool CurlEasyHandleWrapper::setHappyEyeballsTimeout(const std::chrono::milliseconds timeout) {
+// CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS was added in libcurl 7.59.0.  Older versions use a fixed 200 ms.
+#if LIBCURL_VERSION_NUM >= 0x073b00
+    CURLcode ret = curl_easy_setopt(m_handle, CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, static_cast<long>(timeout.count()));
+    if (ret != CURLE_OK) {
+        ACSDK_ERROR(LX("setHappyEyeballsTimeoutFailed")
+                        .d("reason", "curlFailure")
+                        .d("method", "curl_easy_setopt")
+                        .d("option", "CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS")
+                        .d("timeout", timeout.count())
+                        .d("error", curl_easy_strerror(ret)));
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool CurlEasyHandleWrapper::setStreamWeight(long weight) {
+// CURLOPT_STREAM_WEIGHT was added in libcurl 7.46.0.  Older versions give every stream the same weight.
+#if LIBCURL_VERSION_NUM >= 0x072e00
+    CURLcode ret = curl_easy_setopt(m_handle, CURLOPT_STREAM_WEIGHT, weight);
+    if (ret != CURLE_OK) {
+        ACSDK_ERROR(LX("setStreamWeightFailed")
+                        .d("reason", "curlFailure")
+                        .d("method", "curl_easy_setopt")
+                        .d("option", "CURLOPT_STREAM_WEIGHT")
+                        .d("weight", weight)
+                        .d("error", curl_easy_strerror(ret)));
+        return false;
+    }
+#endif
+    return true;
+}
+
 bool CurlEasyHandleWrapper::setConnectionTimeout(const std::chrono::seconds timeoutSeconds) {
     CURLcode ret = curl_easy_setopt(m_handle, CURLOPT_CONNECTTIMEOUT, timeoutSeconds.count());
     if (ret != CURLE_OK) {
@@ -340,6 +443,7 @@ void CurlEasyHandleWrapper::cleanupResources() {
         curl_formfree(m_post);
         m_post = nullptr;
     }
+    m_postContents.clear();
 }
 
 bool CurlEasyHandleWrapper::setDefaultOptions() {
@@ -15,6 +15,13 @@
  * permissions and limitations under the License.
  */
 
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 #include "ACL/Transport/CurlMultiHandleWrapper.h"
@@ -34,13 +41,26 @@ static const std::string TAG("CurlMultiHandleWrapper");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// Index of the read end of the wakeup pipe.
+static const int WAKEUP_PIPE_READ = 0;
+
+/// Index of the write end of the wakeup pipe.
+static const int WAKEUP_PIPE_WRITE = 1;
+
+/// Value of a wakeup pipe file descriptor that is not open.
+static const int INVALID_FD = -1;
+
 std::unique_ptr<CurlMultiHandleWrapper> CurlMultiHandleWrapper::create() {
     auto handle = curl_multi_init();
     if (!handle) {
         ACSDK_ERROR(LX("createFailed").d("reason", "curlMultiInitFailed"));
         return nullptr;
     }
-    return std::unique_ptr<CurlMultiHandleWrapper>(new CurlMultiHandleWrapper(handle));
+    std::unique_ptr<CurlMultiHandleWrapper> wrapper(new CurlMultiHandleWrapper(handle));
+    if (!wrapper->createWakeupPipe()) {
+        ACSDK_WARN(LX("wakeupNotSupported").d("reason", "createWakeupPipeFailed"));
+    }
+    return wrapper;
 }
 
 CurlMultiHandleWrapper::~CurlMultiHandleWrapper() {
@@ -60,6 +80,12 @@ CurlMultiHandleWrapper::~CurlMultiHandleWrapper() {
         ACSDK_ERROR(LX("multiHandleLeaked").d("reason", "curlMultiRemoveHandleFailed"));
     }
     m_handle = nullptr;
+    for (auto& fd : m_wakeupPipe) {
+        if (fd != INVALID_FD) {
+            close(fd);
+            fd = INVALID_FD;
+        }
+    }
 }
 
 CURLM* CurlMultiHandleWrapper::getCurlHandle() {
@@ -94,19 +120,104 @@ CURLMcode CurlMultiHandleWrapper::perform(int* runningHandles) {
     return result;
 }
 
-CURLMcode CurlMultiHandleWrapper::wait(std::chrono::milliseconds timeout, int* countHandlesUpdated) {
-    auto result = curl_multi_wait(m_handle, NULL, 0, timeout.count(), countHandlesUpdated);
-    if (result != CURLE_OK) {
+CURLMcode CurlMultiHandleWrapper::wait(std::chrono::milliseconds timeout, int* countHandlesUpdated, bool* wasWokenUp) {
+    if (wasWokenUp) {
+        *wasWokenUp = false;
+    }
+    if (!isWakeupSupported()) {
+        auto result = curl_multi_wait(m_handle, NULL, 0, timeout.count(), countHandlesUpdated);
+        if (result != CURLM_OK) {
+            ACSDK_ERROR(LX("curlMultiWaitFailed").d("error", curl_multi_strerror(result)));
+        }
+        return result;
+    }
+
+    struct curl_waitfd wakeupFd;
+    wakeupFd.fd = m_wakeupPipe[WAKEUP_PIPE_READ];
+    wakeupFd.events = CURL_WAIT_POLLIN;
+    wakeupFd.revents = 0;
+    auto result = curl_multi_wait(m_handle, &wakeupFd, 1, timeout.count(), countHandlesUpdated);
+    if (result != CURLM_OK) {
         ACSDK_ERROR(LX("curlMultiWaitFailed").d("error", curl_multi_strerror(result)));
     }
+    if (wakeupFd.revents) {
+        drainWakeupPipe();
+        if (wasWokenUp) {
+            *wasWokenUp = true;
+        }
+    }
     return result;
 }
 
+bool CurlMultiHandleWrapper::waitForWakeup(std::chrono::milliseconds timeout) {
+    if (!isWakeupSupported()) {
+        return false;
+    }
+    struct pollfd wakeupFd;
+    wakeupFd.fd = m_wakeupPipe[WAKEUP_PIPE_READ];
+    wakeupFd.events = POLLIN;
+    wakeupFd.revents = 0;
+    auto result = poll(&wakeupFd, 1, static_cast<int>(timeout.count()));
+    if (result < 0 && errno != EINTR) {
+        ACSDK_ERROR(LX("waitForWakeupFailed").d("reason", "pollFailed").d("error", strerror(errno)));
+        return false;
+    }
+    if (result > 0 && wakeupFd.revents) {
+        drainWakeupPipe();
+        return true;
+    }
+    return false;
+}
+
+bool CurlMultiHandleWrapper::wakeup() {
+    if (!isWakeupSupported()) {
+        return false;
+    }
+    const char signal = 0;
+    auto result = write(m_wakeupPipe[WAKEUP_PIPE_WRITE], &signal, sizeof(signal));
+    // A full pipe means a wakeup is already pending, which is just as good.
+    if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        ACSDK_ERROR(LX("wakeupFailed").d("reason", "writeFailed").d("error", strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+bool CurlMultiHandleWrapper::isWakeupSupported() const {
+    return m_wakeupPipe[WAKEUP_PIPE_READ] != INVALID_FD;
+}
+
 CURLMsg* CurlMultiHandleWrapper::infoRead(int* messagesInQueue) {
     return curl_multi_info_read(m_handle, messagesInQueue);
 }
 
-CurlMultiHandleWrapper::CurlMultiHandleWrapper(CURLM* handle) : m_handle{handle} {
+CurlMultiHandleWrapper::CurlMultiHandleWrapper(CURLM* handle) : m_handle{handle}, m_wakeupPipe{INVALID_FD, INVALID_FD} {
+}
+
+bool CurlMultiHandleWrapper::createWakeupPipe() {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        ACSDK_ERROR(LX("createWakeupPipeFailed").d("reason", "pipeFailed").d("error", strerror(errno)));
+        return false;
+    }
+    for (auto fd : fds) {
+        int flags = fcntl(fd, F_GETFL);
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            ACSDK_ERROR(LX("createWakeupPipeFailed").d("reason", "setNonBlockingFailed").d("error", strerror(errno)));
+            close(fds[WAKEUP_PIPE_READ]);
+            close(fds[WAKEUP_PIPE_WRITE]);
+            return false;
+        }
+    }
+    m_wakeupPipe[WAKEUP_PIPE_READ] = fds[WAKEUP_PIPE_READ];
+    m_wakeupPipe[WAKEUP_PIPE_WRITE] = fds[WAKEUP_PIPE_WRITE];
+    return true;
+}
+
+void CurlMultiHandleWrapper::drainWakeupPipe() {
+    char buffer[64];
+    while (read(m_wakeupPipe[WAKEUP_PIPE_READ], buffer, sizeof(buffer)) > 0) {
+    }
 }
 
 }  // namespace acl
@@ -0,0 +1,364 @@
+/*
+ * CurlMultiReactor.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
+
+#include "ACL/Transport/CurlMultiReactor.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("CurlMultiReactor");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The most ready sockets to collect from one wait.
+static const int MAX_EVENTS_PER_WAIT = 64;
+
+/// A time which never comes.
+static const std::chrono::steady_clock::time_point NEVER = std::chrono::steady_clock::time_point::max();
+
+std::shared_ptr<CurlMultiReactor> CurlMultiReactor::create() {
+#ifdef __linux__
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "epollCreateFailed").d("error", strerror(errno)));
+        return nullptr;
+    }
+    int wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "eventfdFailed").d("error", strerror(errno)));
+        close(epollFd);
+        return nullptr;
+    }
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) != 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "watchWakeFdFailed").d("error", strerror(errno)));
+        close(wakeFd);
+        close(epollFd);
+        return nullptr;
+    }
+    std::shared_ptr<CurlMultiReactor> reactor(new CurlMultiReactor(epollFd, wakeFd));
+    auto self = reactor.get();
+    reactor->m_thread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::NETWORK, "acl-reactor", [self]() { self->loop(); });
+    return reactor;
+#else
+    ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedPlatform"));
+    return nullptr;
+#endif
+}
+
+CurlMultiReactor::CurlMultiReactor(int epollFd, int wakeFd) :
+        m_epollFd{epollFd},
+        m_wakeFd{wakeFd},
+        m_clientInService{nullptr},
+        m_isShuttingDown{false} {
+}
+
+CurlMultiReactor::~CurlMultiReactor() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    wakeThread();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    for (auto& entry : m_clients) {
+        ACSDK_WARN(LX("clientNotRemoved").d("multi", entry.first));
+        curl_multi_setopt(entry.first, CURLMOPT_SOCKETFUNCTION, nullptr);
+        curl_multi_setopt(entry.first, CURLMOPT_TIMERFUNCTION, nullptr);
+    }
+#ifdef __linux__
+    close(m_wakeFd);
+    close(m_epollFd);
+#endif
+}
+
+bool CurlMultiReactor::addClient(CURLM* multi, ActivityCallback callback) {
+    if (!multi || !callback) {
+        ACSDK_ERROR(LX("addClientFailed").d("reason", multi ? "nullCallback" : "nullMulti"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_clients.count(multi)) {
+        ACSDK_ERROR(LX("addClientFailed").d("reason", "alreadyAdded").d("multi", multi));
+        return false;
+    }
+    auto client = std::make_shared<Client>();
+    client->multi = multi;
+    client->reactor = this;
+    client->callback = std::move(callback);
+    // Give libcurl the chance to start the transfers already added, which it asks for with a timeout.
+    client->curlTimeout = std::chrono::steady_clock::now();
+    client->deadline = NEVER;
+    client->isUpdated = false;
+    client->runningHandles = 0;
+    client->isWoken = true;
+    client->isRemoved = false;
+    if (curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, &CurlMultiReactor::onSocket) != CURLM_OK ||
+        curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, client.get()) != CURLM_OK ||
+        curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, &CurlMultiReactor::onTimer) != CURLM_OK ||
+        curl_multi_setopt(multi, CURLMOPT_TIMERDATA, client.get()) != CURLM_OK) {
+        ACSDK_ERROR(LX("addClientFailed").d("reason", "setCallbacksFailed").d("multi", multi));
+        curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, nullptr);
+        curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, nullptr);
+        return false;
+    }
+    m_clients[multi] = client;
+    wakeThread();
+    return true;
+}
+
+void CurlMultiReactor::removeClient(CURLM* multi) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_clients.find(multi);
+    if (it == m_clients.end()) {
+        return;
+    }
+    auto client = it->second;
+    client->isRemoved = true;
+    m_clients.erase(it);
+    if (std::this_thread::get_id() != m_thread.get_id()) {
+        m_serviceEnded.wait(lock, [this, &client] { return m_clientInService != client.get(); });
+    }
+    for (auto socketIt = m_socketOwners.begin(); socketIt != m_socketOwners.end();) {
+        if (socketIt->second == client.get()) {
+#ifdef __linux__
+            epoll_ctl(m_epollFd, EPOLL_CTL_DEL, socketIt->first, nullptr);
+#endif
+            socketIt = m_socketOwners.erase(socketIt);
+        } else {
+            ++socketIt;
+        }
+    }
+    lock.unlock();
+    // Nothing services the handle any more, so this does not race the thread.
+    curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, nullptr);
+    curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, nullptr);
+}
+
+void CurlMultiReactor::wake(CURLM* multi) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clients.find(multi);
+        if (it == m_clients.end()) {
+            return;
+        }
+        it->second->isWoken = true;
+    }
+    wakeThread();
+}
+
+int CurlMultiReactor::onSocket(CURL*, curl_socket_t socket, int what, void* client, void*) {
+    auto self = static_cast<Client*>(client);
+    std::lock_guard<std::mutex> lock(self->reactor->m_mutex);
+    self->reactor->updateSocketLocked(self, socket, what);
+    return 0;
+}
+
+int CurlMultiReactor::onTimer(CURLM*, long timeoutMs, void* client) {
+    // Only called by libcurl while the thread services the client, so no lock is needed.
+    auto self = static_cast<Client*>(client);
+    self->curlTimeout =
+        timeoutMs < 0 ? NEVER : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    return 0;
+}
+
+void CurlMultiReactor::updateSocketLocked(Client* client, curl_socket_t socket, int what) {
+#ifdef __linux__
+    auto it = m_socketOwners.find(socket);
+    if (CURL_POLL_REMOVE == what) {
+        if (it != m_socketOwners.end()) {
+            // The socket may already be closed, which removes it from the epoll instance by itself.
+            epoll_ctl(m_epollFd, EPOLL_CTL_DEL, socket, nullptr);
+            m_socketOwners.erase(it);
+        }
+        return;
+    }
+    struct epoll_event event = {};
+    event.events = ((what & CURL_POLL_IN) ? EPOLLIN : 0) | ((what & CURL_POLL_OUT) ? EPOLLOUT : 0);
+    event.data.fd = socket;
+    int operation = it != m_socketOwners.end() ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(m_epollFd, operation, socket, &event) != 0) {
+        // A socket closed and reopened with the same number is no longer in the epoll instance.
+        if (EPOLL_CTL_MOD == operation && ENOENT == errno) {
+            operation = EPOLL_CTL_ADD;
+        } else if (EPOLL_CTL_ADD == operation && EEXIST == errno) {
+            operation = EPOLL_CTL_MOD;
+        } else {
+            operation = -1;
+        }
+        if (operation < 0 || epoll_ctl(m_epollFd, operation, socket, &event) != 0) {
+            ACSDK_ERROR(LX("watchSocketFailed").d("socket", socket).d("error", strerror(errno)));
+            return;
+        }
+    }
+    m_socketOwners[socket] = client;
+#endif
+}
+
+bool CurlMultiReactor::beginService(const std::shared_ptr<Client>& client, bool* isWoken) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (client->isRemoved) {
+        return false;
+    }
+    m_clientInService = client.get();
+    if (isWoken) {
+        *isWoken = client->isWoken;
+        client->isWoken = false;
+    }
+    return true;
+}
+
+void CurlMultiReactor::endService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_clientInService = nullptr;
+    }
+    m_serviceEnded.notify_all();
+}
+
+void CurlMultiReactor::socketAction(Client* client, curl_socket_t socket, int events) {
+    auto result = curl_multi_socket_action(client->multi, socket, events, &client->runningHandles);
+    if (result != CURLM_OK) {
+        ACSDK_ERROR(
+            LX("curlMultiSocketActionFailed").d("multi", client->multi).d("error", curl_multi_strerror(result)));
+    }
+}
+
+void CurlMultiReactor::wakeThread() {
+#ifdef __linux__
+    uint64_t one = 1;
+    if (write(m_wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        ACSDK_ERROR(LX("wakeThreadFailed").d("error", strerror(errno)));
+    }
+#endif
+}
+
+void CurlMultiReactor::loop() {
+#ifdef __linux__
+    std::vector<std::shared_ptr<Client>> clients;
+    struct epoll_event events[MAX_EVENTS_PER_WAIT];
+    while (true) {
+        int timeoutMs = -1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_isShuttingDown) {
+                return;
+            }
+            auto now = std::chrono::steady_clock::now();
+            auto next = NEVER;
+            for (const auto& entry : m_clients) {
+                const auto& client = entry.second;
+                next = std::min(next, client->isWoken ? now : std::min(client->curlTimeout, client->deadline));
+            }
+            if (next != NEVER) {
+                // Round up, so that the time has come when the wait ends.
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(next - now);
+                timeoutMs = next <= now ? 0 : static_cast<int>(remaining.count()) + 1;
+            }
+        }
+
+        int count = epoll_wait(m_epollFd, events, MAX_EVENTS_PER_WAIT, timeoutMs);
+        if (count < 0 && errno != EINTR) {
+            ACSDK_ERROR(LX("epollWaitFailed").d("error", strerror(errno)));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == m_wakeFd) {
+                uint64_t value;
+                while (read(m_wakeFd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+            std::shared_ptr<Client> client;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto owner = m_socketOwners.find(fd);
+                if (owner != m_socketOwners.end()) {
+                    auto it = m_clients.find(owner->second->multi);
+                    if (it != m_clients.end()) {
+                        client = it->second;
+                    }
+                }
+            }
+            if (!client || !beginService(client, nullptr)) {
+                continue;
+            }
+            int flags = ((events[i].events & EPOLLIN) ? CURL_CSELECT_IN : 0) |
+                        ((events[i].events & EPOLLOUT) ? CURL_CSELECT_OUT : 0) |
+                        ((events[i].events & (EPOLLERR | EPOLLHUP)) ? CURL_CSELECT_ERR : 0);
+            socketAction(client.get(), fd, flags);
+            client->isUpdated = true;
+            endService();
+        }
+
+        clients.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& entry : m_clients) {
+                clients.push_back(entry.second);
+            }
+        }
+        for (const auto& client : clients) {
+            bool isWoken = false;
+            if (!beginService(client, &isWoken)) {
+                continue;
+            }
+            auto now = std::chrono::steady_clock::now();
+            bool isTimedOut = client->curlTimeout <= now;
+            if (isTimedOut) {
+                client->curlTimeout = NEVER;
+                socketAction(client.get(), CURL_SOCKET_TIMEOUT, 0);
+            }
+            if (isWoken || isTimedOut || client->isUpdated || client->deadline <= now) {
+                bool isUpdated = client->isUpdated;
+                client->isUpdated = false;
+                client->deadline = client->callback(isUpdated, client->runningHandles);
+            }
+            endService();
+        }
+    }
+#endif
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
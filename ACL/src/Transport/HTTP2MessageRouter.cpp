@@ -27,11 +27,17 @@ using namespace alexaClientSDK::avsCommon::utils;
 using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::avs::attachment;
 
+const std::string HTTP2MessageRouter::DEFAULT_AVS_ENDPOINT = "https://avs-alexa-na.amazon.com";
+
 HTTP2MessageRouter::HTTP2MessageRouter(
     std::shared_ptr<AuthDelegateInterface> authDelegate,
     std::shared_ptr<AttachmentManager> attachmentManager,
-    const std::string& avsEndpoint) :
-        MessageRouter(authDelegate, attachmentManager, avsEndpoint) {
+    const std::string& avsEndpoint,
+    std::shared_ptr<CurlMultiReactor> networkReactor,
+    std::shared_ptr<NetworkQualityEstimator> networkQualityEstimator) :
+        MessageRouter(authDelegate, attachmentManager, avsEndpoint),
+        m_networkReactor{networkReactor},
+        m_networkQualityEstimator{networkQualityEstimator} {
 }
 
 HTTP2MessageRouter::~HTTP2MessageRouter() {
@@ -44,7 +50,14 @@ std::shared_ptr<TransportInterface> HTTP2MessageRouter::createTransport(
     std::shared_ptr<MessageConsumerInterface> messageConsumerInterface,
     std::shared_ptr<TransportObserverInterface> transportObserverInterface) {
     return HTTP2Transport::create(
-        authDelegate, avsEndpoint, messageConsumerInterface, attachmentManager, transportObserverInterface);
+        authDelegate,
+        avsEndpoint,
+        messageConsumerInterface,
+        attachmentManager,
+        transportObserverInterface,
+        getOutboundEventBuffer(),
+        m_networkReactor,
+        m_networkQualityEstimator);
 }
 
 }  // namespace acl
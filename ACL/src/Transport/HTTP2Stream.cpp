@@ -14,19 +14,27 @@
  * express or implied. See the License for the specific language governing
  * permissions and limitations under the License.
  */
+#include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Metrics/DialogLatencyTracer.h>
 #include "ACL/Transport/HTTP2Stream.h"
 #include "ACL/Transport/HTTP2Transport.h"
+#include "ACL/Transport/TrafficRecorder.h"
 
-#include <sstream>
 #include <cstdint>
 
+#ifdef EVENT_COMPRESSION
+#include <zlib.h>
+#endif
+
 namespace alexaClientSDK {
 namespace acl {
 
 using namespace alexaClientSDK::avsCommon::utils;
 using namespace avsCommon::avs;
 using namespace avsCommon::avs::attachment;
+using namespace avsCommon::utils::json;
+using avsCommon::utils::metrics::DialogLatencyTracer;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("HTTP2Stream");
@@ -52,8 +60,28 @@ static const std::string ATTACHMENT_FIELD_NAME = "audio";
 static const std::string METADATA_FIELD_NAME = "metadata";
 /// The prefix for a stream contextId.
 static const std::string STREAM_CONTEXT_ID_PREFIX_STRING = "ACL_LOGICAL_HTTP2_STREAM_ID_";
+#ifdef EVENT_COMPRESSION
+/// The header of a POST part which is gzip compressed.
+static const std::string GZIP_CONTENT_ENCODING_HEADER = "Content-Encoding: gzip";
+/// The smallest metadata worth compressing.  Smaller metadata barely shrinks, or even grows by the gzip header.
+static const size_t MIN_COMPRESSED_METADATA_SIZE = 1024;
+/// The windowBits of deflateInit2() to produce a gzip, rather than a zlib, stream with the largest window.
+static const int GZIP_WINDOW_BITS = 15 + 16;
+/// The memLevel of deflateInit2() which zlib uses by default.
+static const int GZIP_MEM_LEVEL = 8;
+#endif
 /// The prefix of request IDs passed back in the header of AVS replies.
 static const std::string X_AMZN_REQUESTID_PREFIX = "x-amzn-requestid:";
+/// The key of the dialogRequestId in the header of an event.
+static const std::string DIALOG_REQUEST_ID_KEY = "dialogRequestId";
+/// The HTTP/2 weight of streams of @c Priority::HIGH requests.  This is the largest weight allowed.
+static const long HIGH_PRIORITY_STREAM_WEIGHT = 256;
+/// The HTTP/2 weight of streams of @c Priority::NORMAL requests and of GET streams.  This is libcurl's default.
+static const long DEFAULT_STREAM_WEIGHT = 16;
+/// The HTTP/2 weight of streams of @c Priority::LOW requests.  This is the smallest weight allowed.
+static const long LOW_PRIORITY_STREAM_WEIGHT = 1;
+/// The least time between logs of a stream being blocked or unblocked, which may happen for each chunk transferred.
+static const std::chrono::seconds BLOCKED_LOG_INTERVAL(1);
 #ifdef DEBUG
 /// Carriage return
 static const char CR = 0x0D;
@@ -68,49 +96,163 @@ static std::chrono::steady_clock::rep getNow() {
     return std::chrono::steady_clock::now().time_since_epoch().count();
 }
 
+#if LIBCURL_VERSION_NUM >= 0x073D00
+/// The time until the first byte was about to be uploaded.
+static const CURLINFO PRETRANSFER_TIME = CURLINFO_PRETRANSFER_TIME_T;
+/// The time until the first byte of the response was received.
+static const CURLINFO STARTTRANSFER_TIME = CURLINFO_STARTTRANSFER_TIME_T;
+/// The time until the transfer was complete.
+static const CURLINFO TOTAL_TIME = CURLINFO_TOTAL_TIME_T;
+
+/**
+ * Get one of the times libcurl measures for a transfer.
+ *
+ * @param handle The curl easy handle of the transfer.
+ * @param info The time to get.
+ * @return The time, or zero if it could not be got.
+ */
+static std::chrono::microseconds getTransferTime(CURL* handle, CURLINFO info) {
+    curl_off_t microseconds = 0;
+    if (curl_easy_getinfo(handle, info, &microseconds) != CURLE_OK) {
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::microseconds(microseconds);
+}
+#else
+/// The time until the first byte was about to be uploaded.
+static const CURLINFO PRETRANSFER_TIME = CURLINFO_PRETRANSFER_TIME;
+/// The time until the first byte of the response was received.
+static const CURLINFO STARTTRANSFER_TIME = CURLINFO_STARTTRANSFER_TIME;
+/// The time until the transfer was complete.
+static const CURLINFO TOTAL_TIME = CURLINFO_TOTAL_TIME;
+
+/**
+ * Get one of the times libcurl measures for a transfer.
+ *
+ * @param handle The curl easy handle of the transfer.
+ * @param info The time to get.
+ * @return The time, or zero if it could not be got.
+ */
+static std::chrono::microseconds getTransferTime(CURL* handle, CURLINFO info) {
+    double seconds = 0;
+    if (curl_easy_getinfo(handle, info, &seconds) != CURLE_OK) {
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>(seconds));
+}
+#endif
+
+#if LIBCURL_VERSION_NUM >= 0x073700
+/**
+ * Get the number of bytes received by a transfer.
+ *
+ * @param handle The curl easy handle of the transfer.
+ * @return The number of bytes, or zero if it could not be got.
+ */
+static uint64_t getDownloadSize(CURL* handle) {
+    curl_off_t bytes = 0;
+    if (curl_easy_getinfo(handle, CURLINFO_SIZE_DOWNLOAD_T, &bytes) != CURLE_OK || bytes < 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(bytes);
+}
+#else
+/**
+ * Get the number of bytes received by a transfer.
+ *
+ * @param handle The curl easy handle of the transfer.
+ * @return The number of bytes, or zero if it could not be got.
+ */
+static uint64_t getDownloadSize(CURL* handle) {
+    double bytes = 0;
+    if (curl_easy_getinfo(handle, CURLINFO_SIZE_DOWNLOAD, &bytes) != CURLE_OK || bytes < 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(bytes);
+}
+#endif
+
 HTTP2Stream::HTTP2Stream(
     std::shared_ptr<MessageConsumerInterface> messageConsumer,
-    std::shared_ptr<AttachmentManager> attachmentManager) :
+    std::shared_ptr<AttachmentManager> attachmentManager,
+    bool acceptCompressedResponses) :
         m_logicalStreamId{0},
         m_parser{messageConsumer, attachmentManager},
         m_hasSendCompleted{false},
         m_isNetworkSendBlockedOnLocalRead{false},
+        m_isDataAvailableCallbackSet{false},
         m_hasReceiveStarted{false},
         m_isNetworkReceiveBlockedOnLocalWrite{false},
         m_progressTimeout{std::chrono::steady_clock::duration::max().count()},
-        m_timeOfLastTransfer{getNow()} {
+        m_timeOfLastTransfer{getNow()},
+        m_timeTransferStarted{std::chrono::steady_clock::now()},
+        m_queueWait{std::chrono::steady_clock::duration::zero()},
+        m_acceptCompressedResponses{acceptCompressedResponses} {
 }
 
 bool HTTP2Stream::reset() {
-    if (!m_transfer.reset()) {
+    bool areOptionsKept = false;
+    if (!m_transfer.resetForReuse(&areOptionsKept)) {
+        m_authToken.clear();
         ACSDK_ERROR(LX("resetFailed").d("reason", "resetHandleFailed"));
         return false;
     }
+    if (!areOptionsKept) {
+        m_authToken.clear();
+    }
     m_parser.reset();
+    if (m_isDataAvailableCallbackSet) {
+        m_isDataAvailableCallbackSet = false;
+        auto attachmentReader = m_currentRequest ? m_currentRequest->getAttachmentReader() : nullptr;
+        if (attachmentReader) {
+            attachmentReader->setDataAvailableCallback(nullptr);
+        }
+    }
     m_currentRequest.reset();
     m_hasSendCompleted = false;
+    m_tracedDialogRequestId.clear();
     m_isNetworkSendBlockedOnLocalRead = false;
     m_hasReceiveStarted = false;
     m_isNetworkReceiveBlockedOnLocalWrite = false;
     m_exceptionBeingProcessed.clear();
     m_progressTimeout = std::chrono::steady_clock::duration::max().count();
     m_timeOfLastTransfer = getNow();
+    m_timeTransferStarted = std::chrono::steady_clock::now();
+    m_timeSendCompleted = std::chrono::steady_clock::time_point();
+    m_queueWait = std::chrono::steady_clock::duration::zero();
     return true;
 }
 
 bool HTTP2Stream::setCommonOptions(const std::string& url, const std::string& authToken) {
-    CURLcode ret;
-    std::ostringstream authHeader;
-    authHeader << AUTHORIZATION_HEADER << authToken;
+    if (authToken != m_authToken) {
+        if (!m_authToken.empty()) {
+            // Start from a clean handle, rather than accumulating Authorization headers.
+            m_authToken.clear();
+            if (!m_transfer.reset()) {
+                ACSDK_ERROR(LX("setCommonOptionsFailed").d("reason", "resetHandleFailed"));
+                return false;
+            }
+        }
+        if (!setOptionsForHandle(authToken)) {
+            return false;
+        }
+        m_authToken = authToken;
+    }
 
     if (!m_transfer.setURL(url)) {
         ACSDK_ERROR(LX("setCommonOptionsFailed").d("reason", "setURLFailed").d("url", url));
         return false;
     }
+    return true;
+}
 
-    if (!m_transfer.addHTTPHeader(authHeader.str())) {
-        ACSDK_ERROR(
-            LX("setCommonOptionsFailed").d("reason", "addHTTPHeaderFailed").sensitive("authHeader", authHeader.str()));
+bool HTTP2Stream::setOptionsForHandle(const std::string& authToken) {
+    CURLcode ret;
+    std::string authHeader = AUTHORIZATION_HEADER + authToken;
+    if (!m_transfer.addHTTPHeader(authHeader)) {
+        ACSDK_ERROR(LX("setCommonOptionsFailed")
+                        .d("reason", "addHTTPHeaderFailed")
+                        .sensitive("authHeader", authHeader));
         return false;
     }
 
@@ -144,6 +286,19 @@ bool HTTP2Stream::setCommonOptions(const std::string& url, const std::string& au
                         .d("error", curl_easy_strerror(ret)));
         return false;
     }
+    if (m_acceptCompressedResponses) {
+        // An empty list offers every encoding libcurl was built to decode, and libcurl decodes the response before
+        // writeCallback() sees it, so the MimeParser is fed plain bytes either way.
+        ret = curl_easy_setopt(m_transfer.getCurlHandle(), CURLOPT_ACCEPT_ENCODING, "");
+        if (ret != CURLE_OK) {
+            ACSDK_ERROR(LX("setCommonOptionsFailed")
+                            .d("reason", "curlFailure")
+                            .d("method", "curl_easy_setopt")
+                            .d("option", "CURLOPT_ACCEPT_ENCODING")
+                            .d("error", curl_easy_strerror(ret)));
+            return false;
+        }
+    }
     return true;
 }
 
@@ -165,24 +320,64 @@ bool HTTP2Stream::initGet(const std::string& url, const std::string& authToken)
         return false;
     }
 
+    if (!setCommonOptions(url, authToken)) {
+        ACSDK_ERROR(LX("initGetFailed").d("reason", "setCommonOptionsFailed"));
+        return false;
+    }
+
     if (!m_transfer.setTransferType(CurlEasyHandleWrapper::TransferType::kGET)) {
         return false;
     }
 
-    if (!setCommonOptions(url, authToken)) {
-        ACSDK_ERROR(LX("initGetFailed").d("reason", "setCommonOptionsFailed"));
+    // A re-used handle keeps the weight of its last POST.
+    if (!m_transfer.setStreamWeight(DEFAULT_STREAM_WEIGHT)) {
+        ACSDK_ERROR(LX("initGetFailed").d("reason", "setStreamWeightFailed"));
         return false;
     }
 
     return true;
 }
 
+#ifdef EVENT_COMPRESSION
+/**
+ * Compress data in the gzip format.
+ *
+ * @param data The data to compress.
+ * @param[out] compressed The compressed data.
+ * @return Whether the operation was successful.
+ */
+static bool gzipCompress(const std::string& data, std::string* compressed) {
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    if (deflateInit2(
+            &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, GZIP_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        ACSDK_ERROR(LX("gzipCompressFailed").d("reason", "deflateInit2Failed"));
+        return false;
+    }
+    compressed->resize(deflateBound(&stream, data.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&(*compressed)[0]);
+    stream.avail_out = static_cast<uInt>(compressed->size());
+    auto result = deflate(&stream, Z_FINISH);
+    compressed->resize(stream.total_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        ACSDK_ERROR(LX("gzipCompressFailed").d("reason", "deflateFailed").d("result", result));
+        return false;
+    }
+    return true;
+}
+#endif
+
 bool HTTP2Stream::initPost(
     const std::string& url,
     const std::string& authToken,
-    std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+    std::shared_ptr<avsCommon::avs::MessageRequest> request,
+    bool compressMetadata) {
     reset();
-    std::string requestPayload = request->getJsonContent();
 
     if (url.empty()) {
         ACSDK_ERROR(LX("initPostFailed").d("reason", "emptyURL"));
@@ -204,7 +399,27 @@ bool HTTP2Stream::initPost(
         return false;
     }
 
-    if (!m_transfer.setPostContent(METADATA_FIELD_NAME, requestPayload)) {
+    if (!setCommonOptions(url, authToken)) {
+        ACSDK_ERROR(LX("initPostFailed").d("reason", "setCommonOptionsFailed"));
+        return false;
+    }
+
+    bool isMetadataSet = false;
+#ifdef EVENT_COMPRESSION
+    std::string compressedMetadata;
+    if (compressMetadata && request->getJsonContent().size() >= MIN_COMPRESSED_METADATA_SIZE &&
+        gzipCompress(request->getJsonContent(), &compressedMetadata) &&
+        compressedMetadata.size() < request->getJsonContent().size()) {
+        if (!m_transfer.addPostHeader(GZIP_CONTENT_ENCODING_HEADER) ||
+            !m_transfer.setPostContent(
+                METADATA_FIELD_NAME, std::make_shared<const std::string>(std::move(compressedMetadata)))) {
+            ACSDK_ERROR(LX("initPostFailed").d("reason", "setCompressedPostContentFailed"));
+            return false;
+        }
+        isMetadataSet = true;
+    }
+#endif
+    if (!isMetadataSet && !m_transfer.setPostContent(METADATA_FIELD_NAME, request->getSharedJsonContent())) {
         ACSDK_ERROR(LX("initPostFailed").d("reason", "setPostContentFailed"));
         return false;
     }
@@ -226,12 +441,16 @@ bool HTTP2Stream::initPost(
         return false;
     }
 
-    if (!setCommonOptions(url, authToken)) {
-        ACSDK_ERROR(LX("initPostFailed").d("reason", "setCommonOptionsFailed"));
+    if (!m_transfer.setStreamWeight(getStreamWeight(request->getPriority()))) {
+        ACSDK_ERROR(LX("initPostFailed").d("reason", "setStreamWeightFailed"));
         return false;
     }
 
     m_currentRequest = request;
+    if (DialogLatencyTracer::instance().isEnabled() && request->getAttachmentReader() &&
+        jsonUtils::scanStringValue(request->getJsonContent(), DIALOG_REQUEST_ID_KEY, &m_tracedDialogRequestId)) {
+        DialogLatencyTracer::instance().mark(m_tracedDialogRequestId, DialogLatencyTracer::Mark::SEND_START);
+    }
     return true;
 }
 
@@ -249,16 +468,26 @@ size_t HTTP2Stream::writeCallback(char* data, size_t size, size_t nmemb, void* u
     if (HTTP2Stream::HTTPResponseCodes::SUCCESS_OK == stream->getResponseCode()) {
         MimeParser::DataParsedStatus status = stream->m_parser.feed(data, numChars);
 
+        // Data which could not all be parsed is delivered again, so it is recorded once it is done with.
+        if (MimeParser::DataParsedStatus::INCOMPLETE != status && TrafficRecorder::instance().isRecording()) {
+            TrafficRecorder::instance().recordData(
+                stream->m_logicalStreamId, !stream->m_currentRequest, data, numChars);
+        }
+
         if (MimeParser::DataParsedStatus::OK == status) {
             if (stream->m_isNetworkReceiveBlockedOnLocalWrite) {
                 stream->m_isNetworkReceiveBlockedOnLocalWrite = false;
-                ACSDK_DEBUG9(LX("writeCallback").d("blocked", false).d("streamId", stream->m_logicalStreamId));
+                ACSDK_DEBUG9_RATE_LIMITED(
+                    BLOCKED_LOG_INTERVAL,
+                    LX("writeCallback").d("blocked", false).d("streamId", stream->m_logicalStreamId));
             }
             return numChars;
         } else if (MimeParser::DataParsedStatus::INCOMPLETE == status) {
             if (!stream->m_isNetworkReceiveBlockedOnLocalWrite) {
                 stream->m_isNetworkReceiveBlockedOnLocalWrite = true;
-                ACSDK_DEBUG9(LX("writeCallback").d("blocked", true).d("streamId", stream->m_logicalStreamId));
+                ACSDK_DEBUG9_RATE_LIMITED(
+                    BLOCKED_LOG_INTERVAL,
+                    LX("writeCallback").d("blocked", true).d("streamId", stream->m_logicalStreamId));
             }
             return CURL_WRITEFUNC_PAUSE;
         } else if (MimeParser::DataParsedStatus::ERROR == status) {
@@ -293,6 +522,8 @@ size_t HTTP2Stream::headerCallback(char* data, size_t size, size_t nmemb, void*
             boundary = header.substr(header.find(BOUNDARY_PREFIX));
             boundary = boundary.substr(BOUNDARY_PREFIX_SIZE, boundary.find(BOUNDARY_DELIMITER) - BOUNDARY_PREFIX_SIZE);
             stream->m_parser.setBoundaryString(boundary);
+            TrafficRecorder::instance().recordStreamStart(
+                stream->m_logicalStreamId, !stream->m_currentRequest, boundary);
         }
     }
     return headerLength;
@@ -312,6 +543,7 @@ size_t HTTP2Stream::readCallback(char* data, size_t size, size_t nmemb, void* us
     // This is ok - it means there's no attachment to send.  Return 0 so libcurl can complete the stream to AVS.
     if (!attachmentReader) {
         stream->m_hasSendCompleted = true;
+        stream->m_timeSendCompleted = std::chrono::steady_clock::now();
         return 0;
     }
 
@@ -330,6 +562,11 @@ size_t HTTP2Stream::readCallback(char* data, size_t size, size_t nmemb, void* us
         // No more data to send - close the stream.
         case AttachmentReader::ReadStatus::CLOSED:
             stream->m_hasSendCompleted = true;
+            stream->m_timeSendCompleted = std::chrono::steady_clock::now();
+            if (!stream->m_tracedDialogRequestId.empty()) {
+                DialogLatencyTracer::instance().mark(
+                    stream->m_tracedDialogRequestId, DialogLatencyTracer::Mark::SEND_END);
+            }
             return 0;
 
         // Handle any attachment read errors.
@@ -343,14 +580,15 @@ size_t HTTP2Stream::readCallback(char* data, size_t size, size_t nmemb, void* us
     if (0 == bytesRead) {
         if (!stream->m_isNetworkSendBlockedOnLocalRead) {
             stream->m_isNetworkSendBlockedOnLocalRead = true;
-            // Too noisy unless you arte debugging blocked reads.
-            // ACSDK_DEBUG9(LX("readCallback").d("blocked", true).d("streamId", stream->m_logicalStreamId));
+            ACSDK_DEBUG9_RATE_LIMITED(
+                BLOCKED_LOG_INTERVAL,
+                LX("readCallback").d("blocked", true).d("streamId", stream->m_logicalStreamId));
         }
         return CURL_READFUNC_PAUSE;
     } else if (stream->m_isNetworkSendBlockedOnLocalRead) {
         stream->m_isNetworkSendBlockedOnLocalRead = false;
-        // Too noisy unless you are debugging blocked reads.
-        // ACSDK_DEBUG9(LX("readCallback").d("blocked", false).d("streamId", stream->m_logicalStreamId));
+        ACSDK_DEBUG9_RATE_LIMITED(
+            BLOCKED_LOG_INTERVAL, LX("readCallback").d("blocked", false).d("streamId", stream->m_logicalStreamId));
     }
 
     return bytesRead;
@@ -374,31 +612,74 @@ CURL* HTTP2Stream::getCurlHandle() {
     return m_transfer.getCurlHandle();
 }
 
-void HTTP2Stream::notifyRequestObserver() {
-    if (m_exceptionBeingProcessed.length() > 0) {
-        m_currentRequest->exceptionReceived(m_exceptionBeingProcessed);
-        m_exceptionBeingProcessed = "";
-    }
+void HTTP2Stream::setQueueWait(std::chrono::steady_clock::duration queueWait) {
+    m_queueWait = queueWait;
+}
+
+avsCommon::sdkInterfaces::MessageRequestObserverInterface::TransferTimings HTTP2Stream::getTransferTimings() {
+    avsCommon::sdkInterfaces::MessageRequestObserverInterface::TransferTimings timings;
+    auto handle = m_transfer.getCurlHandle();
+    timings.queueWait = std::chrono::duration_cast<std::chrono::microseconds>(m_queueWait);
+    timings.firstUploadByte = getTransferTime(handle, PRETRANSFER_TIME);
+    timings.firstResponseByte = getTransferTime(handle, STARTTRANSFER_TIME);
+    timings.responseComplete = getTransferTime(handle, TOTAL_TIME);
+    if (m_timeSendCompleted != std::chrono::steady_clock::time_point()) {
+        timings.uploadComplete =
+            std::chrono::duration_cast<std::chrono::microseconds>(m_timeSendCompleted - m_timeTransferStarted);
+    } else if (!m_currentRequest || !m_currentRequest->getAttachmentReader()) {
+        // Without an attachment, the whole request is handed to libcurl as soon as the upload starts.
+        timings.uploadComplete = timings.firstUploadByte;
+    }
+    return timings;
+}
 
-    long responseCode = getResponseCode();
+uint64_t HTTP2Stream::getResponseBytes() {
+    return getDownloadSize(m_transfer.getCurlHandle());
+}
 
-    switch (responseCode) {
+void HTTP2Stream::notifyRequestObserver(const std::shared_ptr<avsCommon::utils::threading::Executor>& executor) {
+    using Status = avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status;
+
+    Status status;
+    switch (getResponseCode()) {
         case HTTP2Stream::HTTPResponseCodes::NO_RESPONSE_RECEIVED:
-            m_currentRequest->sendCompleted(
-                avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+            status = Status::INTERNAL_ERROR;
             break;
         case HTTP2Stream::HTTPResponseCodes::SUCCESS_OK:
         case HTTP2Stream::HTTPResponseCodes::SUCCESS_NO_CONTENT:
-            m_currentRequest->sendCompleted(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::SUCCESS);
+            status = Status::SUCCESS;
             break;
         default:
-            m_currentRequest->sendCompleted(
-                avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::SERVER_INTERNAL_ERROR);
+            status = Status::SERVER_INTERNAL_ERROR;
+    }
+
+    auto request = m_currentRequest;
+    auto timings = getTransferTimings();
+    std::string exceptionMessage;
+    std::swap(exceptionMessage, m_exceptionBeingProcessed);
+    auto notify = [request, timings, exceptionMessage, status]() {
+        if (!exceptionMessage.empty()) {
+            request->exceptionReceived(exceptionMessage);
+        }
+        request->transferTimingsMeasured(timings);
+        request->sendCompleted(status);
+    };
+    if (executor) {
+        executor->submit(notify);
+    } else {
+        notify();
     }
 }
 
-void HTTP2Stream::notifyRequestObserver(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status) {
-    m_currentRequest->sendCompleted(status);
+void HTTP2Stream::notifyRequestObserver(
+    avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status,
+    const std::shared_ptr<avsCommon::utils::threading::Executor>& executor) {
+    auto request = m_currentRequest;
+    if (executor) {
+        executor->submit([request, status]() { request->sendCompleted(status); });
+    } else {
+        request->sendCompleted(status);
+    }
 }
 
 bool HTTP2Stream::setStreamTimeout(const long timeoutSeconds) {
@@ -412,6 +693,22 @@ bool HTTP2Stream::setConnectionTimeout(const std::chrono::seconds timeoutSeconds
     return m_transfer.setConnectionTimeout(timeoutSeconds);
 }
 
+bool HTTP2Stream::setHappyEyeballsTimeout(const std::chrono::milliseconds timeout) {
+    return m_transfer.setHappyEyeballsTimeout(timeout);
+}
+
+long HTTP2Stream::getStreamWeight(MessageRequest::Priority priority) {
+    switch (priority) {
+        case MessageRequest::Priority::HIGH:
+            return HIGH_PRIORITY_STREAM_WEIGHT;
+        case MessageRequest::Priority::NORMAL:
+            return DEFAULT_STREAM_WEIGHT;
+        case MessageRequest::Priority::LOW:
+            return LOW_PRIORITY_STREAM_WEIGHT;
+    }
+    return DEFAULT_STREAM_WEIGHT;
+}
+
 void HTTP2Stream::resumeNetworkIO() {
     curl_easy_pause(getCurlHandle(), CURLPAUSE_CONT);
 }
@@ -432,6 +729,19 @@ bool HTTP2Stream::isBlockedOnLocalIO() const {
     }
 }
 
+bool HTTP2Stream::setDataAvailableCallback(std::function<void()> callback) {
+    auto attachmentReader = m_currentRequest ? m_currentRequest->getAttachmentReader() : nullptr;
+    if (!attachmentReader) {
+        return false;
+    }
+    m_isDataAvailableCallbackSet = attachmentReader->setDataAvailableCallback(std::move(callback));
+    return m_isDataAvailableCallbackSet;
+}
+
+bool HTTP2Stream::isUnblockedByCallback() const {
+    return m_isDataAvailableCallbackSet && m_isNetworkSendBlockedOnLocalRead && !m_isNetworkReceiveBlockedOnLocalWrite;
+}
+
 void HTTP2Stream::setLogicalStreamId(int logicalStreamId) {
     m_logicalStreamId = logicalStreamId;
     m_parser.setAttachmentContextId(STREAM_CONTEXT_ID_PREFIX_STRING + std::to_string(m_logicalStreamId));
@@ -445,5 +755,15 @@ bool HTTP2Stream::hasProgressTimedOut() const {
     return !isBlockedOnLocalIO() && ((getNow() - m_timeOfLastTransfer) > m_progressTimeout);
 }
 
+std::chrono::steady_clock::time_point HTTP2Stream::getProgressDeadline() const {
+    auto progressTimeout = m_progressTimeout.load();
+    auto timeOfLastTransfer = m_timeOfLastTransfer.load();
+    if (progressTimeout > std::chrono::steady_clock::duration::max().count() - timeOfLastTransfer) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+    return std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(timeOfLastTransfer + progressTimeout));
+}
+
 }  // namespace acl
 }  // namespace alexaClientSDK
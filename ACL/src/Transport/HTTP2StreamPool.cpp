@@ -36,10 +36,12 @@ unsigned int HTTP2StreamPool::m_nextStreamId = 1;
 
 HTTP2StreamPool::HTTP2StreamPool(
     const int maxStreams,
-    std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager) :
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+    bool acceptCompressedResponses) :
         m_numAcquiredStreams{0},
         m_maxStreams{maxStreams},
-        m_attachmentManager{attachmentManager} {
+        m_attachmentManager{attachmentManager},
+        m_acceptCompressedResponses{acceptCompressedResponses} {
 }
 
 std::shared_ptr<HTTP2Stream> HTTP2StreamPool::createGetStream(
@@ -63,7 +65,8 @@ std::shared_ptr<HTTP2Stream> HTTP2StreamPool::createPostStream(
     const std::string& url,
     const std::string& authToken,
     std::shared_ptr<avsCommon::avs::MessageRequest> request,
-    std::shared_ptr<MessageConsumerInterface> messageConsumer) {
+    std::shared_ptr<MessageConsumerInterface> messageConsumer,
+    bool compressMetadata) {
     std::shared_ptr<HTTP2Stream> stream = getStream(messageConsumer);
     if (!request) {
         ACSDK_ERROR(LX("createPostStreamFailed").d("reason", "nullMessageRequest"));
@@ -74,7 +77,7 @@ std::shared_ptr<HTTP2Stream> HTTP2StreamPool::createPostStream(
         request->sendCompleted(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::INTERNAL_ERROR);
         return nullptr;
     }
-    if (!stream->initPost(url, authToken, request)) {
+    if (!stream->initPost(url, authToken, request, compressMetadata)) {
         ACSDK_ERROR(LX("createPostStreamFailed").d("reason", "initPostFailed"));
         request->sendCompleted(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::INTERNAL_ERROR);
         releaseStream(stream);
@@ -96,7 +99,7 @@ std::shared_ptr<HTTP2Stream> HTTP2StreamPool::getStream(std::shared_ptr<MessageC
 
     std::shared_ptr<HTTP2Stream> result;
     if (m_pool.empty()) {
-        result = std::make_shared<HTTP2Stream>(messageConsumer, m_attachmentManager);
+        result = std::make_shared<HTTP2Stream>(messageConsumer, m_attachmentManager, m_acceptCompressedResponses);
     } else {
         result = m_pool.back();
         m_pool.pop_back();
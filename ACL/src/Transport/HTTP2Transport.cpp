@@ -15,11 +15,18 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <random>
+#include <sstream>
 
+#include <curl/curl.h>
+
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
 #include <AVSCommon/Utils/Timing/TimeUtils.h>
 
 #include "ACL/Transport/HTTP2Transport.h"
@@ -44,32 +51,72 @@ static const std::string TAG("HTTP2Transport");
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
 /**
- * The maximum number of streams we can have active at once.  Please see here for more information:
+ * The default maximum number of streams we can have active at once.  Please see here for more information:
  * https://developer.amazon.com/public/solutions/alexa/alexa-voice-service/docs/managing-an-http-2-connection
  */
-const static int MAX_STREAMS = 10;
+const static int DEFAULT_MAX_STREAMS = 10;
+/// The number of streams which are not event streams: the downchannel and the ping.
+const static int NUM_NON_EVENT_STREAMS = 2;
+/// The default maximum number of event streams which may be waiting for an HTTP response code at once.
+const static int DEFAULT_MAX_CONCURRENT_EVENTS = 1;
+/// Configuration key for the ACL settings.
+const static std::string CONFIG_KEY_ACL = "acl";
+/// Configuration key for the maximum number of streams.
+const static std::string CONFIG_KEY_MAX_STREAMS = "maxStreams";
+/// Configuration key for the maximum number of event streams which may be waiting for an HTTP response code at once.
+const static std::string CONFIG_KEY_MAX_CONCURRENT_EVENTS = "maxConcurrentEvents";
+/// Configuration key for further AVS endpoints to race the configured one, separated by commas.
+const static std::string CONFIG_KEY_ALTERNATE_ENDPOINTS = "alternateEndpoints";
+/// Configuration key for how long, in milliseconds, to wait for a connection attempt before racing the next one.
+const static std::string CONFIG_KEY_CONNECTION_ATTEMPT_DELAY = "connectionAttemptDelayMs";
+/// The default delay between connection attempts, the Connection Attempt Delay recommended by RFC 8305.
+const static int DEFAULT_CONNECTION_ATTEMPT_DELAY_MS = 250;
+/// Configuration key for whether to gzip the metadata of events, for endpoints which accept it.
+const static std::string CONFIG_KEY_COMPRESS_EVENT_METADATA = "compressEventMetadata";
+/// Configuration key for whether to let AVS compress the responses on the downchannel and to events.
+const static std::string CONFIG_KEY_ACCEPT_COMPRESSED_RESPONSES = "acceptCompressedResponses";
+/// Configuration key for whether to notify requests of their completion on an executor, rather than the network thread.
+const static std::string CONFIG_KEY_ASYNC_REQUEST_CALLBACKS = "asyncRequestCallbacks";
+/// HTTP response code sent when the server throttles a client.
+const static long HTTP_RESPONSE_TOO_MANY_REQUESTS = 429;
 /// Downchannel URL
 const static std::string AVS_DOWNCHANNEL_URL_PATH_EXTENSION = "/v20160207/directives";
 /// URL to send events to
 const static std::string AVS_EVENT_URL_PATH_EXTENSION = "/v20160207/events";
 /// URL to send pings to
 const static std::string AVS_PING_URL_PATH_EXTENSION = "/ping";
-/// Timeout for curl_multi_wait
+/// Timeout for curl_multi_wait when the network loop can not be woken up, or when a stream is paused.
 const static std::chrono::milliseconds WAIT_FOR_ACTIVITY_TIMEOUT(100);
 /// Timeout for curl_multi_wait while all HTTP/2 streams are blocked.
 const static std::chrono::milliseconds WAIT_FOR_ACTIVITY_WHILE_STREAMS_BLOCKED_TIMEOUT(10);
-/// 1 minute in milliseconds
-const static int MS_PER_MIN = 60000;
-/// Timeout before we send a ping
-const static int PING_TIMEOUT_MS = MS_PER_MIN * 5;
-/// Number of times we timeout waiting for activity before sending a ping
-const static int NUM_TIMEOUTS_BEFORE_PING = (PING_TIMEOUT_MS / WAIT_FOR_ACTIVITY_TIMEOUT.count());
-/// The maximum time a ping should take in seconds
-const static long PING_RESPONSE_TIMEOUT_SEC = 30;
+/// How soon to check again whether a stream which was blocked on local IO, and so could not time out, has stalled.
+const static std::chrono::milliseconds BLOCKED_STREAM_PROGRESS_CHECK_INTERVAL(1000);
+/// The default for how long the connection may be idle before we send a ping, right after connecting.
+const static int DEFAULT_MIN_PING_INTERVAL_SEC = 30;
+/// The default for how long the connection may be idle before we send a ping, once it has proven stable.
+const static int DEFAULT_MAX_PING_INTERVAL_SEC = 5 * 60;
+/// The default for how long the connection may be idle before we send a ping, once stable in low-power mode.
+const static int DEFAULT_LOW_POWER_MAX_PING_INTERVAL_SEC = 20 * 60;
+/// The default for the maximum time a ping should take in seconds
+const static int DEFAULT_PING_RESPONSE_TIMEOUT_SEC = 30;
+/// The loss rate at which the connection is not considered stable enough to ping less often.
+static const double LOSSY_CONNECTION_LOSS_RATE = 0.1;
+/// Configuration key for how long, in seconds, the connection may be idle before a ping, right after connecting.
+const static std::string CONFIG_KEY_MIN_PING_INTERVAL = "minPingIntervalSeconds";
+/// Configuration key for how long, in seconds, the connection may be idle before a ping, once it has proven stable.
+const static std::string CONFIG_KEY_MAX_PING_INTERVAL = "maxPingIntervalSeconds";
+/// Configuration key for how long, in seconds, the connection may be idle before a ping, once stable in low-power mode.
+const static std::string CONFIG_KEY_LOW_POWER_MAX_PING_INTERVAL = "lowPowerMaxPingIntervalSeconds";
+/// Configuration key for the maximum time, in seconds, a ping should take.
+const static std::string CONFIG_KEY_PING_RESPONSE_TIMEOUT = "pingTimeoutSeconds";
 /// Connection timeout
 static const std::chrono::seconds ESTABLISH_CONNECTION_TIMEOUT = std::chrono::seconds{60};
-/// Timeout for transmission of data on a given stream
-static const std::chrono::seconds STREAM_PROGRESS_TIMEOUT = std::chrono::seconds{30};
+/// The default for how long, in seconds, an event stream may go without transferring data before it times out.
+const static int DEFAULT_STREAM_PROGRESS_TIMEOUT_SEC = 30;
+/// Configuration key for how long, in seconds, an event stream may go without transferring data before it times out.
+const static std::string CONFIG_KEY_STREAM_PROGRESS_TIMEOUT = "streamProgressTimeoutSeconds";
+/// A time which never comes, for a step on the reactor which need not be followed by another.
+static const std::chrono::steady_clock::time_point NEVER = std::chrono::steady_clock::time_point::max();
 
 #ifdef ACSDK_OPENSSL_MIN_VER_REQUIRED
 /**
@@ -141,12 +188,105 @@ static void printCurlDiagnostics() {
 #endif
 }
 
+/**
+ * Read an integer setting from the ACL configuration, falling back to a default if it is missing or out of range.
+ *
+ * @param key The configuration key of the setting.
+ * @param defaultValue The value to use if the setting is missing or out of range.
+ * @param minValue The lowest valid value.
+ * @param maxValue The highest valid value.
+ * @return The value of the setting.
+ */
+static int getConfiguredInt(const std::string& key, int defaultValue, int minValue, int maxValue) {
+    int value = defaultValue;
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_ACL].getInt(key, &value, defaultValue);
+    if (value < minValue || value > maxValue) {
+        ACSDK_ERROR(LX("invalidConfiguration").d("key", key).d("value", value).d("default", defaultValue));
+        return defaultValue;
+    }
+    return value;
+}
+
+/**
+ * Get whether to gzip the metadata of events, as configured in @c acl.compressEventMetadata.
+ *
+ * @return Whether to gzip the metadata of events.
+ */
+static bool getIsEventMetadataCompressed() {
+    bool isCompressed = false;
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_ACL].getBool(
+        CONFIG_KEY_COMPRESS_EVENT_METADATA, &isCompressed, false);
+#ifndef EVENT_COMPRESSION
+    if (isCompressed) {
+        ACSDK_WARN(LX("compressEventMetadataIgnored").d("reason", "builtWithoutEventCompression"));
+        isCompressed = false;
+    }
+#endif
+    return isCompressed;
+}
+
+/**
+ * Get whether to let AVS compress its responses, as configured in @c acl.acceptCompressedResponses.
+ *
+ * @return Whether to let AVS compress its responses.
+ */
+static bool getIsResponseCompressionAccepted() {
+    bool isAccepted = false;
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_ACL].getBool(
+        CONFIG_KEY_ACCEPT_COMPRESSED_RESPONSES, &isAccepted, false);
+    if (isAccepted && !(curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_LIBZ)) {
+        ACSDK_WARN(LX("acceptCompressedResponsesIgnored").d("reason", "libcurlBuiltWithoutZlib"));
+        isAccepted = false;
+    }
+    return isAccepted;
+}
+
+/**
+ * Create the executor to notify requests of their completion on, if @c acl.asyncRequestCallbacks is set.  It runs on
+ * the shared @c ThreadPool if one is set with @c Executor::setDefaultThreadPool().
+ *
+ * @return The executor, or @c nullptr if requests are notified on the network thread.
+ */
+static std::shared_ptr<threading::Executor> createRequestCallbackExecutor() {
+    bool isAsync = false;
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_ACL].getBool(
+        CONFIG_KEY_ASYNC_REQUEST_CALLBACKS, &isAsync, false);
+    return isAsync ? std::make_shared<threading::Executor>() : nullptr;
+}
+
+/**
+ * Get the AVS endpoints to race when connecting: the configured endpoint, followed by those configured in
+ * @c acl.alternateEndpoints.
+ *
+ * @param avsEndpoint The configured AVS endpoint.
+ * @return The endpoints to race, without duplicates.
+ */
+static std::vector<std::string> getAVSEndpoints(const std::string& avsEndpoint) {
+    std::vector<std::string> endpoints{avsEndpoint};
+    std::string alternateEndpoints;
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_ACL].getString(
+        CONFIG_KEY_ALTERNATE_ENDPOINTS, &alternateEndpoints);
+    std::istringstream stream(alternateEndpoints);
+    std::string endpoint;
+    while (std::getline(stream, endpoint, ',')) {
+        endpoint.erase(0, endpoint.find_first_not_of(' '));
+        endpoint.erase(endpoint.find_last_not_of(' ') + 1);
+        if (!endpoint.empty() && std::find(endpoints.begin(), endpoints.end(), endpoint) == endpoints.end()) {
+            endpoints.push_back(endpoint);
+        }
+    }
+    return endpoints;
+}
+
 std::shared_ptr<HTTP2Transport> HTTP2Transport::create(
     std::shared_ptr<AuthDelegateInterface> authDelegate,
     const std::string& avsEndpoint,
     std::shared_ptr<MessageConsumerInterface> messageConsumerInterface,
     std::shared_ptr<AttachmentManager> attachmentManager,
-    std::shared_ptr<TransportObserverInterface> observer) {
+    std::shared_ptr<TransportObserverInterface> observer,
+    std::shared_ptr<OutboundEventBuffer> outboundEventBuffer,
+    std::shared_ptr<CurlMultiReactor> networkReactor,
+    std::shared_ptr<NetworkQualityEstimator> networkQualityEstimator) {
     std::shared_ptr<PostConnectObject> postConnectObject = PostConnectObject::create();
 
     if (!postConnectObject) {
@@ -155,7 +295,15 @@ std::shared_ptr<HTTP2Transport> HTTP2Transport::create(
     }
 
     return std::shared_ptr<HTTP2Transport>(new HTTP2Transport(
-        authDelegate, avsEndpoint, messageConsumerInterface, attachmentManager, postConnectObject, observer));
+        authDelegate,
+        avsEndpoint,
+        messageConsumerInterface,
+        attachmentManager,
+        postConnectObject,
+        observer,
+        outboundEventBuffer,
+        networkReactor,
+        networkQualityEstimator));
 }
 
 HTTP2Transport::HTTP2Transport(
@@ -164,16 +312,79 @@ HTTP2Transport::HTTP2Transport(
     std::shared_ptr<MessageConsumerInterface> messageConsumerInterface,
     std::shared_ptr<AttachmentManager> attachmentManager,
     std::shared_ptr<PostConnectObject> postConnectObject,
-    std::shared_ptr<TransportObserverInterface> observer) :
+    std::shared_ptr<TransportObserverInterface> observer,
+    std::shared_ptr<OutboundEventBuffer> outboundEventBuffer,
+    std::shared_ptr<CurlMultiReactor> networkReactor,
+    std::shared_ptr<NetworkQualityEstimator> networkQualityEstimator) :
         m_messageConsumer{messageConsumerInterface},
         m_authDelegate{authDelegate},
+        m_avsEndpoints{getAVSEndpoints(avsEndpoint)},
+        m_connectionAttemptDelay{getConfiguredInt(
+            CONFIG_KEY_CONNECTION_ATTEMPT_DELAY,
+            DEFAULT_CONNECTION_ATTEMPT_DELAY_MS,
+            0,
+            std::numeric_limits<int>::max())},
         m_avsEndpoint{avsEndpoint},
-        m_streamPool{MAX_STREAMS, attachmentManager},
+        m_networkReactor{networkReactor},
+        m_networkLoopState{NetworkLoopState::ESTABLISHING},
+        m_retryCount{0},
+        m_retryBackoff{std::chrono::milliseconds::zero()},
+        m_maxStreams{getConfiguredInt(
+            CONFIG_KEY_MAX_STREAMS,
+            DEFAULT_MAX_STREAMS,
+            NUM_NON_EVENT_STREAMS + 1,
+            std::numeric_limits<int>::max())},
+        m_maxConcurrentEvents{getConfiguredInt(
+            CONFIG_KEY_MAX_CONCURRENT_EVENTS,
+            DEFAULT_MAX_CONCURRENT_EVENTS,
+            1,
+            m_maxStreams - NUM_NON_EVENT_STREAMS)},
+        m_eventConcurrencyLimit{m_maxConcurrentEvents},
+        m_minPingInterval{getConfiguredInt(
+            CONFIG_KEY_MIN_PING_INTERVAL,
+            DEFAULT_MIN_PING_INTERVAL_SEC,
+            1,
+            std::numeric_limits<int>::max())},
+        m_maxPingInterval{std::max(
+            m_minPingInterval,
+            std::chrono::seconds(getConfiguredInt(
+                CONFIG_KEY_MAX_PING_INTERVAL,
+                DEFAULT_MAX_PING_INTERVAL_SEC,
+                1,
+                std::numeric_limits<int>::max())))},
+        m_lowPowerMaxPingInterval{std::max(
+            m_maxPingInterval,
+            std::chrono::seconds(getConfiguredInt(
+                CONFIG_KEY_LOW_POWER_MAX_PING_INTERVAL,
+                DEFAULT_LOW_POWER_MAX_PING_INTERVAL_SEC,
+                1,
+                std::numeric_limits<int>::max())))},
+        m_pingResponseTimeout{getConfiguredInt(
+            CONFIG_KEY_PING_RESPONSE_TIMEOUT,
+            DEFAULT_PING_RESPONSE_TIMEOUT_SEC,
+            1,
+            std::numeric_limits<int>::max())},
+        m_streamProgressTimeout{getConfiguredInt(
+            CONFIG_KEY_STREAM_PROGRESS_TIMEOUT,
+            DEFAULT_STREAM_PROGRESS_TIMEOUT_SEC,
+            1,
+            std::numeric_limits<int>::max())},
+        m_pingInterval{m_minPingInterval},
+        m_isEventMetadataCompressed{getIsEventMetadataCompressed()},
+        m_requestCallbackExecutor{createRequestCallbackExecutor()},
+        m_streamPool{m_maxStreams, attachmentManager, getIsResponseCompressionAccepted()},
         m_disconnectReason{ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR},
         m_isNetworkThreadRunning{false},
+        m_isReactorWakePending{false},
         m_isConnected{false},
         m_isStopping{false},
-        m_postConnectObject{postConnectObject} {
+        m_hasNetworkBecomeAvailable{false},
+        m_isDraining{false},
+        m_isLowPowerMode{false},
+        m_networkQualityEstimator{networkQualityEstimator},
+        m_clock{avsCommon::utils::timing::Clock::getDefault()},
+        m_postConnectObject{postConnectObject},
+        m_outboundEventBuffer{outboundEventBuffer} {
     m_observers.insert(observer);
 
     printCurlDiagnostics();
@@ -216,6 +427,13 @@ bool HTTP2Transport::connect() {
         ACSDK_ERROR(LX("connectFailed").d("reason", "enableHTTP2PipeliningFailed"));
         return false;
     }
+    // AVS requires a single connection.  If the server's SETTINGS_MAX_CONCURRENT_STREAMS is reached, this makes
+    // libcurl hold further streams until one finishes, rather than opening another connection.
+    if (curl_multi_setopt(m_multi->getCurlHandle(), CURLMOPT_MAX_HOST_CONNECTIONS, 1L) != CURLM_OK) {
+        m_multi.reset();
+        ACSDK_ERROR(LX("connectFailed").d("reason", "setMaxHostConnectionsFailed"));
+        return false;
+    }
 
     ConnectionStatusObserverInterface::ChangedReason reason =
         ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
@@ -235,7 +453,29 @@ bool HTTP2Transport::connect() {
 
     m_isNetworkThreadRunning = true;
     m_isStopping = false;
-    m_networkThread = std::thread(&HTTP2Transport::networkLoop, this);
+    m_isDraining = false;
+    m_networkLoopState = NetworkLoopState::ESTABLISHING;
+    m_retryCount = 0;
+    m_retryBackoff = std::chrono::milliseconds::zero();
+    m_timeOfNextAttempt = std::chrono::steady_clock::now() + m_connectionAttemptDelay;
+    if (!m_networkReactor) {
+        m_networkThread = threading::ThreadFactory::createThread(
+            threading::ThreadRole::NETWORK, "acl-network", [this]() { networkLoop(); });
+        return true;
+    }
+
+    m_isReactorWakePending = false;
+    auto callback = [this](bool transfersUpdated, int runningHandles) {
+        return onReactorActivity(transfersUpdated, runningHandles);
+    };
+    if (!m_networkReactor->addClient(m_multi->getCurlHandle(), callback)) {
+        ACSDK_ERROR(LX("connectFailed").d("reason", "addReactorClientFailed"));
+        m_isNetworkThreadRunning = false;
+        setIsStoppingLocked(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
+        releaseDownchannelStream();
+        m_multi.reset();
+        return false;
+    }
     return true;
 }
 
@@ -255,11 +495,15 @@ void HTTP2Transport::disconnect() {
 
     if (localNetworkThread.joinable()) {
         localNetworkThread.join();
+    } else if (m_networkReactor) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_networkLoopStopped.wait(lock, [this] { return !m_isNetworkThreadRunning; });
     }
-    {
-        std::lock_guard<std::mutex> lock(m_observerMutex);
-        m_observers.clear();
+    if (m_requestCallbackExecutor) {
+        // Deliver the completions of the last transfers before the transport is considered disconnected.
+        m_requestCallbackExecutor->waitForSubmittedTasks();
     }
+    m_observers.clear();
 }
 
 bool HTTP2Transport::isConnected() {
@@ -270,15 +514,44 @@ bool HTTP2Transport::isConnected() {
 void HTTP2Transport::send(std::shared_ptr<MessageRequest> request) {
     if (!request) {
         ACSDK_ERROR(LX("sendFailed").d("reason", "nullRequest"));
-    } else if (!enqueueRequest(request, false)) {
+    } else if (!enqueueRequest(request, false) && !(m_outboundEventBuffer && m_outboundEventBuffer->hold(request))) {
         request->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
     }
 }
 
+void HTTP2Transport::onNetworkAvailable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isNetworkThreadRunning || m_isConnected || m_isStopping) {
+        return;
+    }
+    m_hasNetworkBecomeAvailable = true;
+    m_wakeRetryTrigger.notify_one();
+    wakeNetworkLoopLocked();
+}
+
+void HTTP2Transport::disconnectWhenIdle() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isNetworkThreadRunning || m_isStopping) {
+        return;
+    }
+    ACSDK_INFO(LX("disconnectWhenIdle"));
+    m_isDraining = true;
+    wakeNetworkLoopLocked();
+}
+
+void HTTP2Transport::setLowPowerMode(bool enabled) {
+    ACSDK_INFO(LX("setLowPowerMode").d("enabled", enabled));
+    m_isLowPowerMode = enabled;
+}
+
 void HTTP2Transport::sendPostConnectMessage(std::shared_ptr<MessageRequest> request) {
     if (!request) {
         ACSDK_ERROR(LX("sendFailed").d("reason", "nullRequest"));
     }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_postConnectRequest = request;
+    }
     enqueueRequest(request, true);
 }
 
@@ -299,57 +572,98 @@ bool HTTP2Transport::setupDownchannelStream(ConnectionStatusObserverInterface::C
         return false;
     }
 
-    std::string url = m_avsEndpoint + AVS_DOWNCHANNEL_URL_PATH_EXTENSION;
-    m_downchannelStream = m_streamPool.createGetStream(url, authToken, m_messageConsumer);
+    m_avsEndpoint = m_avsEndpoints.front();
+    m_downchannelStream = createDownchannelStream(m_avsEndpoint, authToken, reason);
     if (!m_downchannelStream) {
-        ACSDK_ERROR(LX("setupDownchannelStreamFailed").d("reason", "createGetStreamFailed"));
-        *reason = ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
         return false;
     }
+
+    m_activeStreams.insert(ActiveTransferEntry(m_downchannelStream->getCurlHandle(), m_downchannelStream));
+
+    return true;
+}
+
+std::shared_ptr<HTTP2Stream> HTTP2Transport::createDownchannelStream(
+    const std::string& avsEndpoint,
+    const std::string& authToken,
+    ConnectionStatusObserverInterface::ChangedReason* reason) {
+    std::string url = avsEndpoint + AVS_DOWNCHANNEL_URL_PATH_EXTENSION;
+    auto stream = m_streamPool.createGetStream(url, authToken, m_messageConsumer);
+    if (!stream) {
+        ACSDK_ERROR(LX("createDownchannelStreamFailed").d("reason", "createGetStreamFailed"));
+        *reason = ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
+        return nullptr;
+    }
     // Since the downchannel is the first stream to be established, make sure it times out if
     // a connection can't be established.
-    if (!m_downchannelStream->setConnectionTimeout(ESTABLISH_CONNECTION_TIMEOUT)) {
-        releaseDownchannelStream(false, nullptr);
-        ACSDK_ERROR(LX("setupDownchannelStreamFailed").d("reason", "setConnectionTimeoutFailed"));
+    if (!stream->setConnectionTimeout(ESTABLISH_CONNECTION_TIMEOUT) ||
+        !stream->setHappyEyeballsTimeout(m_connectionAttemptDelay)) {
+        m_streamPool.releaseStream(stream);
+        ACSDK_ERROR(LX("createDownchannelStreamFailed").d("reason", "setConnectionTimeoutFailed"));
         *reason = ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
-        return false;
+        return nullptr;
     }
 
-    auto result = m_multi->addHandle(m_downchannelStream->getCurlHandle());
+    auto result = m_multi->addHandle(stream->getCurlHandle());
     if (result != CURLM_OK) {
-        releaseDownchannelStream(false, nullptr);
-        ACSDK_ERROR(LX("setupDownchannelStreamFailed").d("reason", "addHandleFailed"));
+        m_streamPool.releaseStream(stream);
+        ACSDK_ERROR(LX("createDownchannelStreamFailed").d("reason", "addHandleFailed"));
         *reason = ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
-        return false;
+        return nullptr;
     }
+    return stream;
+}
 
-    m_activeStreams.insert(ActiveTransferEntry(m_downchannelStream->getCurlHandle(), m_downchannelStream));
-
+bool HTTP2Transport::startNextDownchannelAttempt() {
+    auto index = m_downchannelAttempts.size() + 1;
+    if (index >= m_avsEndpoints.size()) {
+        return false;
+    }
+    auto endpoint = m_avsEndpoints[index];
+    std::string authToken = m_authDelegate->getAuthToken();
+    if (authToken.empty()) {
+        ACSDK_ERROR(LX("startNextDownchannelAttemptFailed").d("reason", "getAuthTokenFailed"));
+        return false;
+    }
+    auto reason = ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
+    auto stream = createDownchannelStream(endpoint, authToken, &reason);
+    // Keep the place of a failed attempt, so that the next one is made to the following endpoint.
+    m_downchannelAttempts.push_back(std::make_pair(endpoint, stream));
+    ACSDK_DEBUG(LX("startNextDownchannelAttempt").d("endpoint", endpoint).d("success", stream != nullptr));
     return true;
 }
 
-void HTTP2Transport::networkLoop() {
-    int retryCount = 0;
-    while (!establishConnection() && !isStopping()) {
-        std::chrono::milliseconds retryBackoff = TransportDefines::RETRY_TIMER.calculateTimeToRetry(retryCount);
-        ACSDK_ERROR(LX("networkLoopRetryingToConnect")
-                        .d("reason", "establishConnectionFailed")
-                        .d("retryCount", retryCount)
-                        .d("retryBackoff", retryBackoff.count()));
-        retryCount++;
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_wakeRetryTrigger.wait_for(lock, retryBackoff, [this] { return m_isStopping; });
+void HTTP2Transport::selectDownchannelAttempt(size_t index) {
+    if (index < m_downchannelAttempts.size()) {
+        auto winner = m_downchannelAttempts[index];
+        m_downchannelAttempts[index].second.reset();
+        releaseDownchannelStream();
+        m_avsEndpoint = winner.first;
+        m_downchannelStream = winner.second;
+        m_activeStreams.insert(ActiveTransferEntry(m_downchannelStream->getCurlHandle(), m_downchannelStream));
+    } else {
+        releaseDownchannelAttempts();
     }
+    if (m_avsEndpoints.size() > 1) {
+        ACSDK_INFO(LX("connectionRaceWon").d("endpoint", m_avsEndpoint));
+    }
+}
 
+void HTTP2Transport::networkLoop() {
     /*
-     * Call perform repeatedly to transfer data on active streams. If all the event streams have HTTP2
-     * response codes service the next outgoing message (if any).  While the connection is alive we should have
-     * at least 1 transfer active (the downchannel).
+     * Call perform repeatedly to transfer data on active streams, and take a step of the network loop after each
+     * call.  Between calls, wait for activity on the transfers until the step asks to be taken again.
+     *
+     * If @c m_multi supports @c wakeup(), @c enqueueRequest() and @c setIsStopping() wake this loop as soon as
+     * there is something to do, so we only need to wake up on our own when the step asks to.  Otherwise, fall back
+     * to polling every @c WAIT_FOR_ACTIVITY_TIMEOUT.
      */
-    int numTransfersLeft = 1;
-    int timeouts = 0;
-    while (numTransfersLeft && !isStopping()) {
-        auto result = m_multi->perform(&numTransfersLeft);
+    const bool isEventDriven = m_multi->isWakeupSupported();
+    bool transfersUpdated = false;
+    bool isWoken = false;
+    while (!isStopping()) {
+        int runningHandles = 0;
+        auto result = m_multi->perform(&runningHandles);
         if (CURLM_CALL_MULTI_PERFORM == result) {
             continue;
         } else if (result != CURLM_OK) {
@@ -358,166 +672,283 @@ void HTTP2Transport::networkLoop() {
             break;
         }
 
-        cleanupFinishedStreams();
-        cleanupStalledStreams();
+        auto now = std::chrono::steady_clock::now();
+        auto next = networkLoopStep(now, transfersUpdated, runningHandles, isWoken);
         if (isStopping()) {
             break;
         }
-
-        if (canProcessOutgoingMessage()) {
-            processNextOutgoingMessage();
+        transfersUpdated = false;
+        isWoken = false;
+
+        if (NetworkLoopState::WAITING_TO_RETRY == m_networkLoopState) {
+            // There are no transfers to wait for until the retry, so wait for a stop or for the network instead.
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_clock->waitFor(m_wakeRetryTrigger, lock, next - now, [this] {
+                return m_isStopping || m_hasNetworkBecomeAvailable;
+            });
+            continue;
         }
 
         auto multiWaitTimeout = WAIT_FOR_ACTIVITY_TIMEOUT;
-
-        size_t numberEventStreams = 0;
-        size_t numberBlockedStreams = 0;
-        for (auto entry : m_activeStreams) {
-            auto stream = entry.second;
-            if (isEventStream(stream)) {
-                numberEventStreams++;
-                if (entry.second->isBlockedOnLocalIO()) {
-                    numberBlockedStreams++;
-                }
-            }
+        if (next <= now) {
+            multiWaitTimeout = std::chrono::milliseconds::zero();
+        } else if (next != NEVER) {
+            // Round up, so that the step is due when the wait ends.
+            auto untilNext = std::chrono::duration_cast<std::chrono::milliseconds>(next - now) +
+                             std::chrono::milliseconds(1);
+            multiWaitTimeout = isEventDriven ? untilNext : std::min(multiWaitTimeout, untilNext);
         }
-        bool blockedOnLocalIO = numberBlockedStreams > 0 && (numberBlockedStreams == numberEventStreams);
-
-        auto before = std::chrono::time_point<std::chrono::steady_clock>::max();
-        if (blockedOnLocalIO) {
-            multiWaitTimeout = WAIT_FOR_ACTIVITY_WHILE_STREAMS_BLOCKED_TIMEOUT;
-            before = std::chrono::steady_clock::now();
-        }
-
-        // TODO: ACSDK-69 replace timeout with signal fd
 
         int numTransfersUpdated = 0;
-        result = m_multi->wait(multiWaitTimeout, &numTransfersUpdated);
+        result = m_multi->wait(multiWaitTimeout, &numTransfersUpdated, &isWoken);
         if (result != CURLM_OK) {
             ACSDK_ERROR(
                 LX("networkLoopStopping").d("reason", "multiWaitFailed").d("error", curl_multi_strerror(result)));
             setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
             break;
         }
-
-        // TODO: ACSDK-69 replace this logic with a signal fd
+        transfersUpdated = numTransfersUpdated > 0;
 
         // @note curl_multi_wait will return immediately even if all streams are paused, because HTTP/2 streams
         // are full-duplex - so activity may have occurred on the other side. Therefore, if our intent is
         // to pause ACL to give attachment readers time to catch up with written data, we must perform a local
-        // sleep of our own.
-        if (blockedOnLocalIO) {
-            auto after = std::chrono::steady_clock::now();
-            auto elapsed = after - before;
-            auto remaining = multiWaitTimeout - elapsed;
-
-            // sanity check that remainingMs is valid before performing a sleep.
-            if (remaining.count() > 0 && remaining <= WAIT_FOR_ACTIVITY_WHILE_STREAMS_BLOCKED_TIMEOUT) {
+        // sleep of our own until the paused streams are due to be resumed.  If supported, the sleep is cut short by
+        // a call to @c m_multi->wakeup(), and skipped if the wait above already consumed one.
+        auto remaining = m_timeToResumeStreams - std::chrono::steady_clock::now();
+        if (!isWoken && remaining > std::chrono::steady_clock::duration::zero()) {
+            if (isEventDriven) {
+                isWoken = m_multi->waitForWakeup(std::chrono::duration_cast<std::chrono::milliseconds>(remaining));
+            } else {
                 std::this_thread::sleep_for(remaining);
             }
         }
-
-        // un-pause the streams so that progress may be made in the next invocation of @c m_multi->perform().
-        for (auto stream : m_activeStreams) {
-            stream.second->resumeNetworkIO();
-        }
-
-        /**
-         * If no transfers were updated then @c m_multi->wait() would have waited WAIT_FOR_ACTIVITY_TIMEOUT_MS
-         * milliseconds. Increment a counter every time this happens, when the counter reaches:
-         * MINUTES_TO_MILLISECONDS * 5 / WAIT_FOR_ACTIVITY_TIMEOUT_MS
-         * we have waited 5 minutes with an idle connection. In this case send a ping.
-         * We clear the counter once there is an activity on any transfer.
-         */
-        if (0 == numTransfersUpdated) {
-            timeouts++;
-            if (timeouts >= NUM_TIMEOUTS_BEFORE_PING) {
-                if (!sendPing()) {
-                    ACSDK_ERROR(LX("networkLoopStopping").d("reason", "sendPingFailed"));
-                    setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
-                    break;
-                }
-                timeouts = 0;
-            }
-        } else {
-            timeouts = 0;
-        }
     }
 
+    finishNetworkLoop();
+}
+
+void HTTP2Transport::finishNetworkLoop() {
     // Catch-all. Reaching this point implies stopping.
     setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
 
     releaseAllEventStreams();
     releasePingStream();
     releaseDownchannelStream();
-    m_multi.reset();
+    {
+        // m_multi is accessed under m_mutex by other threads to wake this loop.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_networkReactor) {
+            m_networkReactor->removeClient(m_multi->getCurlHandle());
+        }
+        m_multi.reset();
+    }
     clearQueuedRequests();
     setIsConnectedFalse();
+    m_transferMetrics.dump();
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isNetworkThreadRunning = false;
+    // Notify under the lock, since disconnect() may destroy this as soon as it sees the loop has stopped.
+    m_networkLoopStopped.notify_all();
+}
+
+std::chrono::steady_clock::time_point HTTP2Transport::onReactorActivity(bool transfersUpdated, int runningHandles) {
+    auto now = std::chrono::steady_clock::now();
+    bool isWoken = false;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_isNetworkThreadRunning = false;
+        isWoken = m_isReactorWakePending;
+        m_isReactorWakePending = false;
     }
+    auto next = NEVER;
+    if (!isStopping()) {
+        next = networkLoopStep(now, transfersUpdated, runningHandles, isWoken);
+    }
+    if (isStopping()) {
+        finishNetworkLoop();
+        return NEVER;
+    }
+    return next;
 }
 
-bool HTTP2Transport::establishConnection() {
-    // Set numTransferLeft to 1 because the downchannel stream has been added already.
-    int numTransfersLeft = 1;
+std::chrono::steady_clock::time_point HTTP2Transport::networkLoopStep(
+    std::chrono::steady_clock::time_point now,
+    bool transfersUpdated,
+    int runningHandles,
+    bool isWoken) {
+    switch (m_networkLoopState) {
+        case NetworkLoopState::ESTABLISHING:
+            return establishConnectionStep(now, runningHandles);
+        case NetworkLoopState::WAITING_TO_RETRY:
+            if (checkAndClearNetworkAvailable()) {
+                ACSDK_INFO(LX("networkLoopRetryingToConnect").d("reason", "networkAvailable"));
+                m_retryCount = 0;
+                m_retryBackoff = std::chrono::milliseconds::zero();
+                return restartConnection(now);
+            }
+            return now < m_timeOfNextRetry ? m_timeOfNextRetry : restartConnection(now);
+        case NetworkLoopState::RUNNING:
+            return serviceStreamsStep(now, transfersUpdated, runningHandles, isWoken);
+    }
+    return NEVER;
+}
 
-    /*
-     * Calls curl_multi_perform until down channel stream receives an HTTP2 response code. If the down channel stream
-     * Call perform() to further networking transfers until the down channel stream receives an HTTP2 response
-     * ends before receiving a response code (numTransfersLeft == 0), then there was an error and we must try again.
-     * code indicating success or failure to establish a connection. If the down channel stream ends before
-     * If we're told to shutdown the network loop (isStopping()) then return false since no connection was established.
-     * receiving a response code (numTransfersLeft == 0), then set up a new down channel stream in preparation
-     * for being called again to retry establishing a connection.
-     */
-    while (numTransfersLeft && !isStopping()) {
-        auto result = m_multi->perform(&numTransfersLeft);
-        // curl asked us to call multiperform again immediately
-        if (CURLM_CALL_MULTI_PERFORM == result) {
-            continue;
-        } else if (result != CURLM_OK) {
-            ACSDK_ERROR(LX("establishConnectionFailed").d("reason", "performFailed"));
-            setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
-        }
-        long downchannelResponseCode = m_downchannelStream->getResponseCode();
-        /* if the downchannel response code is > 0 then we have some response from the backend
-         * if its < 0 there was a problem getting the response code from the easy handle
-         * if its == 0 then keep looping since we have not yet received a response
-         */
-        if (downchannelResponseCode > 0) {
-            /*
-             * Only break the loop if we are successful. If we aren't keep looping so that we download
-             * the full error message (for logging purposes) and then return false when we're done
-             */
+std::chrono::steady_clock::time_point HTTP2Transport::establishConnectionStep(
+    std::chrono::steady_clock::time_point now,
+    int runningHandles) {
+    if (!hasNetworkBecomeAvailable()) {
+        for (size_t index = 0; index <= m_downchannelAttempts.size(); ++index) {
+            auto stream = index < m_downchannelAttempts.size() ? m_downchannelAttempts[index].second
+                                                                : m_downchannelStream;
+            if (!stream) {
+                continue;
+            }
+            long downchannelResponseCode = stream->getResponseCode();
             if (HTTP2Stream::HTTPResponseCodes::SUCCESS_OK == downchannelResponseCode) {
-                return true;
+                selectDownchannelAttempt(index);
+                m_networkLoopState = NetworkLoopState::RUNNING;
+                m_pingInterval = m_minPingInterval;
+                m_timeOfNextPing = now + m_pingInterval;
+                m_timeToResumeStreams = now;
+                return now;
+            } else if (downchannelResponseCode < 0) {
+                ACSDK_ERROR(LX("establishConnectionFailed")
+                                .d("reason", "negativeResponseCode")
+                                .d("responseCode", downchannelResponseCode));
+                setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
+                return NEVER;
             }
-        } else if (downchannelResponseCode < 0) {
-            ACSDK_ERROR(LX("establishConnectionFailed")
-                            .d("reason", "negativeResponseCode")
-                            .d("responseCode", downchannelResponseCode));
-            setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
         }
-        // wait for activity on the downchannel stream, kinda like poll()
-        int numTransfersUpdated = 0;
-        result = m_multi->wait(WAIT_FOR_ACTIVITY_TIMEOUT, &numTransfersUpdated);
-        if (result != CURLM_OK) {
-            ACSDK_ERROR(
-                LX("establishConnectionFailed").d("reason", "waitFailed").d("error", curl_multi_strerror(result)));
-            setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
+        if ((!runningHandles || now >= m_timeOfNextAttempt) && startNextDownchannelAttempt()) {
+            // libcurl asks to be called at once for the new stream, which counts it before the next step.
+            m_timeOfNextAttempt = now + m_connectionAttemptDelay;
+            return m_timeOfNextAttempt;
+        }
+        if (runningHandles) {
+            return m_downchannelAttempts.size() + 1 < m_avsEndpoints.size() ? m_timeOfNextAttempt : NEVER;
         }
     }
+    return scheduleConnectionRetry(now);
+}
 
+std::chrono::steady_clock::time_point HTTP2Transport::scheduleConnectionRetry(
+    std::chrono::steady_clock::time_point now) {
+    if (checkAndClearNetworkAvailable()) {
+        ACSDK_INFO(LX("networkLoopRetryingToConnect").d("reason", "networkAvailable"));
+        m_retryCount = 0;
+        m_retryBackoff = std::chrono::milliseconds::zero();
+        return restartConnection(now);
+    }
+    /*
+     * Spread out the retries with decorrelated jitter, so that devices which lost their connection together do not
+     * retry in lockstep.  If the network becomes available, retry at once and start backing off again.
+     */
+    m_retryBackoff = TransportDefines::RETRY_TIMER.calculateDecorrelatedTimeToRetry(m_retryBackoff);
+    ACSDK_ERROR(LX("networkLoopRetryingToConnect")
+                    .d("reason", "establishConnectionFailed")
+                    .d("retryCount", m_retryCount)
+                    .d("retryBackoff", m_retryBackoff.count()));
+    m_retryCount++;
+    m_networkLoopState = NetworkLoopState::WAITING_TO_RETRY;
+    m_timeOfNextRetry = now + m_retryBackoff;
+    return m_timeOfNextRetry;
+}
+
+std::chrono::steady_clock::time_point HTTP2Transport::restartConnection(std::chrono::steady_clock::time_point now) {
     ConnectionStatusObserverInterface::ChangedReason reason =
         ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
     if (!setupDownchannelStream(&reason)) {
         ACSDK_ERROR(LX("establishConnectionFailed").d("reason", "setupDownchannelStreamFailed").d("error", reason));
         setIsStopping(reason);
+        return NEVER;
     }
-    return false;
+    m_networkLoopState = NetworkLoopState::ESTABLISHING;
+    m_timeOfNextAttempt = now + m_connectionAttemptDelay;
+    return m_timeOfNextAttempt;
+}
+
+std::chrono::steady_clock::time_point HTTP2Transport::serviceStreamsStep(
+    std::chrono::steady_clock::time_point now,
+    bool transfersUpdated,
+    int runningHandles,
+    bool isWoken) {
+    if (!runningHandles) {
+        setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
+        return NEVER;
+    }
+
+    /*
+     * Streams paused while blocked on local IO are resumed once they have waited as long as the network loop on its
+     * own thread would have slept, or as soon as it is woken.  Resuming them on every step would spin, since each
+     * resume makes libcurl ask for another step.
+     */
+    if (isWoken || now >= m_timeToResumeStreams) {
+        for (auto stream : m_activeStreams) {
+            stream.second->resumeNetworkIO();
+        }
+    }
+
+    if (transfersUpdated && now < m_timeOfNextPing) {
+        m_timeOfNextPing = now + m_pingInterval;
+    } else if (now >= m_timeOfNextPing) {
+        if (!sendPing()) {
+            ACSDK_ERROR(LX("networkLoopStopping").d("reason", "sendPingFailed"));
+            setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
+            return NEVER;
+        }
+        m_timeOfNextPing = now + m_pingInterval;
+    }
+
+    cleanupFinishedStreams();
+    cleanupStalledStreams();
+    if (isStopping()) {
+        return NEVER;
+    }
+
+    while (canProcessOutgoingMessage() && processNextOutgoingMessage()) {
+    }
+
+    if (isDrained()) {
+        ACSDK_INFO(LX("networkLoopStopping").d("reason", "drained"));
+        setIsStopping(ConnectionStatusObserverInterface::ChangedReason::SERVER_ENDPOINT_CHANGED);
+        return NEVER;
+    }
+
+    size_t numberEventStreams = 0;
+    size_t numberBlockedStreams = 0;
+    bool isAnyStreamBlocked = false;
+    bool areAllBlockedStreamsUnblockedByCallback = true;
+    for (auto entry : m_activeStreams) {
+        auto stream = entry.second;
+        bool isBlocked = stream->isBlockedOnLocalIO();
+        isAnyStreamBlocked = isAnyStreamBlocked || isBlocked;
+        if (isBlocked && !stream->isUnblockedByCallback()) {
+            areAllBlockedStreamsUnblockedByCallback = false;
+        }
+        if (isEventStream(stream)) {
+            numberEventStreams++;
+            if (isBlocked) {
+                numberBlockedStreams++;
+            }
+        }
+    }
+    bool blockedOnLocalIO = numberBlockedStreams > 0 && (numberBlockedStreams == numberEventStreams);
+
+    auto next = m_timeOfNextPing;
+    auto untilProgressDeadline = getTimeUntilNextProgressDeadline(now);
+    if (untilProgressDeadline != std::chrono::milliseconds::max()) {
+        next = std::min(next, now + untilProgressDeadline);
+    }
+    m_timeToResumeStreams = now;
+    if (blockedOnLocalIO) {
+        m_timeToResumeStreams += areAllBlockedStreamsUnblockedByCallback
+                                     ? WAIT_FOR_ACTIVITY_TIMEOUT
+                                     : WAIT_FOR_ACTIVITY_WHILE_STREAMS_BLOCKED_TIMEOUT;
+        next = std::min(next, m_timeToResumeStreams);
+    } else if (isAnyStreamBlocked && !areAllBlockedStreamsUnblockedByCallback) {
+        next = std::min(next, now + WAIT_FOR_ACTIVITY_TIMEOUT);
+    }
+    return next;
 }
 
 void HTTP2Transport::cleanupFinishedStreams() {
@@ -527,6 +958,8 @@ void HTTP2Transport::cleanupFinishedStreams() {
         message = m_multi->infoRead(&messagesLeft);
         if (message && CURLMSG_DONE == message->msg) {
             if (m_downchannelStream->getCurlHandle() == message->easy_handle) {
+                m_transferMetrics.record(
+                    TransferMetrics::StreamType::DOWNCHANNEL, m_downchannelStream->getTransferTimings());
                 if (!isStopping()) {
                     notifyObserversOnServerSideDisconnect();
                 }
@@ -535,13 +968,22 @@ void HTTP2Transport::cleanupFinishedStreams() {
             }
 
             if (m_pingStream && m_pingStream->getCurlHandle() == message->easy_handle) {
-                handlePingResponse();
+                handlePingResponse(message->data.result);
                 continue;
             }
 
             auto it = m_activeStreams.find(message->easy_handle);
             if (it != m_activeStreams.end()) {
-                it->second->notifyRequestObserver();
+                adaptEventConcurrencyLimit(message->data.result, it->second->getResponseCode());
+                auto timings = it->second->getTransferTimings();
+                m_transferMetrics.record(TransferMetrics::StreamType::EVENT, timings);
+                if (m_networkQualityEstimator) {
+                    m_networkQualityEstimator->recordTransfer(
+                        CURLE_OK == message->data.result,
+                        it->second->getResponseBytes(),
+                        timings.responseComplete - timings.firstResponseByte);
+                }
+                it->second->notifyRequestObserver(m_requestCallbackExecutor);
                 ACSDK_DEBUG0(LX("cleanupFinishedStream")
                                  .d("streamId", it->second->getLogicalStreamId())
                                  .d("result", it->second->getResponseCode()));
@@ -555,44 +997,94 @@ void HTTP2Transport::cleanupFinishedStreams() {
 }
 
 void HTTP2Transport::cleanupStalledStreams() {
-    auto it = m_activeStreams.begin();
-    while (it != m_activeStreams.end()) {
-        auto stream = (it++)->second;
-        if (isEventStream(stream) && stream->hasProgressTimedOut()) {
-            ACSDK_INFO(LX("streamProgressTimedOut").d("streamId", stream->getLogicalStreamId()));
-            stream->notifyRequestObserver(MessageRequestObserverInterface::Status::TIMEDOUT);
-            releaseEventStream(stream);
+    if (m_progressDeadlines.empty()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    while (!m_progressDeadlines.empty() && m_progressDeadlines.top().deadline <= now) {
+        auto entry = m_progressDeadlines.top();
+        m_progressDeadlines.pop();
+        auto stream = entry.stream;
+        auto it = m_activeStreams.find(stream->getCurlHandle());
+        if (it == m_activeStreams.end() || it->second != stream || stream->getLogicalStreamId() != entry.streamId) {
+            // The stream has finished since the entry was added.
+            continue;
         }
+        if (stream->isBlockedOnLocalIO()) {
+            // It is waiting for its attachment rather than the network, so it can not time out yet.
+            m_progressDeadlines.push(
+                {std::max(stream->getProgressDeadline(), now + BLOCKED_STREAM_PROGRESS_CHECK_INTERVAL),
+                 stream,
+                 entry.streamId});
+            continue;
+        }
+        auto deadline = stream->getProgressDeadline();
+        if (deadline > now) {
+            // It made progress since the entry was added.
+            m_progressDeadlines.push({deadline, stream, entry.streamId});
+            continue;
+        }
+        ACSDK_INFO(LX("streamProgressTimedOut").d("streamId", stream->getLogicalStreamId()));
+        if (m_networkQualityEstimator) {
+            m_networkQualityEstimator->recordTransfer(false, 0, std::chrono::microseconds::zero());
+        }
+        // The connection may be dead.  Ping right away to find out, and keep pinging often until it proves stable.
+        m_pingInterval = m_minPingInterval;
+        m_timeOfNextPing = now;
+        stream->notifyRequestObserver(MessageRequestObserverInterface::Status::TIMEDOUT, m_requestCallbackExecutor);
+        releaseEventStream(stream);
+    }
+}
+
+std::chrono::milliseconds HTTP2Transport::getTimeUntilNextProgressDeadline(std::chrono::steady_clock::time_point now) {
+    while (!m_progressDeadlines.empty()) {
+        const auto& entry = m_progressDeadlines.top();
+        auto it = m_activeStreams.find(entry.stream->getCurlHandle());
+        if (it != m_activeStreams.end() && it->second == entry.stream &&
+            entry.stream->getLogicalStreamId() == entry.streamId) {
+            // Round up, so that the deadline has passed when the network loop wakes up for it.
+            return std::chrono::duration_cast<std::chrono::milliseconds>(entry.deadline - now) +
+                   std::chrono::milliseconds(1);
+        }
+        m_progressDeadlines.pop();
     }
+    return std::chrono::milliseconds::max();
 }
 
 bool HTTP2Transport::canProcessOutgoingMessage() {
+    // Keep a stream in reserve for the ping.
+    size_t availableStreams = m_maxStreams - (m_pingStream ? 0 : 1);
+    if (m_activeStreams.size() >= availableStreams) {
+        return false;
+    }
+    int numEventsAwaitingResponse = 0;
     for (auto entry : m_activeStreams) {
         auto stream = entry.second;
-        // If we have an event that still hasn't received a response code then we cannot send another outgoing message.
         if (isEventStream(stream) && (stream->getResponseCode() == 0)) {
-            return false;
+            numEventsAwaitingResponse++;
         }
     }
-    // All outstanding streams (if any) have received a response, the next message can now be sent.
-    return true;
+    return numEventsAwaitingResponse < m_eventConcurrencyLimit;
 }
 
-void HTTP2Transport::processNextOutgoingMessage() {
-    auto request = dequeueRequest();
+bool HTTP2Transport::processNextOutgoingMessage() {
+    auto queueWait = std::chrono::steady_clock::duration::zero();
+    auto request = dequeueRequest(&queueWait);
     if (!request) {
-        return;
+        return false;
     }
     auto authToken = m_authDelegate->getAuthToken();
     if (authToken.empty()) {
-        request->sendCompleted(MessageRequestObserverInterface::Status::INVALID_AUTH);
-        return;
+        notifyRequestCompleted(request, MessageRequestObserverInterface::Status::INVALID_AUTH);
+        return true;
     }
     auto url = m_avsEndpoint + AVS_EVENT_URL_PATH_EXTENSION;
-    std::shared_ptr<HTTP2Stream> stream = m_streamPool.createPostStream(url, authToken, request, m_messageConsumer);
+    std::shared_ptr<HTTP2Stream> stream =
+        m_streamPool.createPostStream(url, authToken, request, m_messageConsumer, m_isEventMetadataCompressed);
     // note : if the stream is nullptr, the stream pool already called sendCompleted on the MessageRequest.
     if (stream) {
-        stream->setProgressTimeout(STREAM_PROGRESS_TIMEOUT);
+        stream->setQueueWait(queueWait);
+        stream->setProgressTimeout(m_streamProgressTimeout);
         auto result = m_multi->addHandle(stream->getCurlHandle());
         if (result != CURLM_OK) {
             ACSDK_ERROR(LX("processNextOutgoingMessageFailed")
@@ -600,12 +1092,31 @@ void HTTP2Transport::processNextOutgoingMessage() {
                             .d("error", curl_multi_strerror(result))
                             .d("streamId", stream->getLogicalStreamId()));
             m_streamPool.releaseStream(stream);
-            stream->notifyRequestObserver(MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+            stream->notifyRequestObserver(
+                MessageRequestObserverInterface::Status::INTERNAL_ERROR, m_requestCallbackExecutor);
         } else {
             ACSDK_DEBUG9(LX("insertActiveStream").d("handle", stream->getCurlHandle()));
             m_activeStreams.insert(ActiveTransferEntry(stream->getCurlHandle(), stream));
+            m_progressDeadlines.push({stream->getProgressDeadline(), stream, stream->getLogicalStreamId()});
+            if (isNetworkLoopWakeable()) {
+                // Resume the stream as soon as its attachment has more data, rather than when it is next polled.
+                stream->setDataAvailableCallback([this]() { wakeNetworkLoop(); });
+            }
         }
     }
+    return true;
+}
+
+void HTTP2Transport::adaptEventConcurrencyLimit(CURLcode result, long responseCode) {
+    if (CURLE_HTTP2_STREAM == result || HTTP_RESPONSE_TOO_MANY_REQUESTS == responseCode) {
+        m_eventConcurrencyLimit = std::max(1, m_eventConcurrencyLimit / 2);
+        ACSDK_INFO(LX("eventConcurrencyLimitReduced")
+                       .d("limit", m_eventConcurrencyLimit)
+                       .d("result", curl_easy_strerror(result))
+                       .d("responseCode", responseCode));
+    } else if (CURLE_OK == result && m_eventConcurrencyLimit < m_maxConcurrentEvents) {
+        m_eventConcurrencyLimit++;
+    }
 }
 
 bool HTTP2Transport::sendPing() {
@@ -631,7 +1142,7 @@ bool HTTP2Transport::sendPing() {
         return false;
     }
 
-    if (!m_pingStream->setStreamTimeout(PING_RESPONSE_TIMEOUT_SEC)) {
+    if (!m_pingStream->setStreamTimeout(m_pingResponseTimeout)) {
         releasePingStream(false);
         setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
         return false;
@@ -649,11 +1160,33 @@ bool HTTP2Transport::sendPing() {
     return true;
 }
 
-void HTTP2Transport::handlePingResponse() {
+void HTTP2Transport::handlePingResponse(CURLcode result) {
     ACSDK_DEBUG(LX("handlePingResponse"));
-    if (HTTP2Stream::HTTPResponseCodes::SUCCESS_NO_CONTENT != m_pingStream->getResponseCode()) {
+    auto timings = m_pingStream->getTransferTimings();
+    m_transferMetrics.record(TransferMetrics::StreamType::PING, timings);
+    auto succeeded = HTTP2Stream::HTTPResponseCodes::SUCCESS_NO_CONTENT == m_pingStream->getResponseCode();
+    if (m_networkQualityEstimator) {
+        // The server answers a ping at once, so the wait for its response is the round trip.
+        m_networkQualityEstimator->recordPing(
+            CURLE_OK == result && succeeded, timings.firstResponseByte - timings.firstUploadByte);
+    }
+    if (!succeeded) {
         ACSDK_ERROR(LX("pingFailed").d("responseCode", m_pingStream->getResponseCode()));
         setIsStopping(ConnectionStatusObserverInterface::ChangedReason::SERVER_SIDE_DISCONNECT);
+    } else if (m_networkQualityEstimator &&
+               m_networkQualityEstimator->getQuality().lossRate >= LOSSY_CONNECTION_LOSS_RATE) {
+        // Transfers are still failing, so the connection has not proven stable; keep pinging as often.
+        ACSDK_DEBUG(LX("pingIntervalHeld").d("intervalSec", m_pingInterval.count()));
+    } else {
+        // The connection has proven stable for another interval, so ping less often.
+        auto maxPingInterval = m_isLowPowerMode ? m_lowPowerMaxPingInterval : m_maxPingInterval;
+        auto pingInterval = std::min(maxPingInterval, m_pingInterval * 2);
+        if (pingInterval != m_pingInterval) {
+            // The next ping was scheduled at the old interval when the response arrived, so move it to the new one.
+            m_timeOfNextPing += pingInterval - m_pingInterval;
+            m_pingInterval = pingInterval;
+            ACSDK_DEBUG(LX("pingIntervalChanged").d("intervalSec", m_pingInterval.count()));
+        }
     }
     releasePingStream();
 }
@@ -675,6 +1208,7 @@ void HTTP2Transport::setIsStoppingLocked(ConnectionStatusObserverInterface::Chan
     m_disconnectReason = reason;
     m_isStopping = true;
     m_wakeRetryTrigger.notify_one();
+    wakeNetworkLoopLocked();
 }
 
 bool HTTP2Transport::isStopping() {
@@ -682,6 +1216,38 @@ bool HTTP2Transport::isStopping() {
     return m_isStopping;
 }
 
+bool HTTP2Transport::checkAndClearNetworkAvailable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto result = m_hasNetworkBecomeAvailable;
+    m_hasNetworkBecomeAvailable = false;
+    return result;
+}
+
+bool HTTP2Transport::hasNetworkBecomeAvailable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hasNetworkBecomeAvailable;
+}
+
+bool HTTP2Transport::isDrained() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isDraining) {
+            return false;
+        }
+        for (auto& queue : m_requestQueues) {
+            if (!queue.empty()) {
+                return false;
+            }
+        }
+    }
+    for (auto entry : m_activeStreams) {
+        if (isEventStream(entry.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool HTTP2Transport::isConnectedLocked() const {
     return m_isConnected && !m_isStopping;
 }
@@ -721,7 +1287,9 @@ bool HTTP2Transport::enqueueRequest(std::shared_ptr<MessageRequest> request, boo
     std::lock_guard<std::mutex> lock(m_mutex);
     if (!m_isStopping) {
         if (ignoreConnectState || m_isConnected) {
-            m_requestQueue.push_back(request);
+            m_requestQueues[static_cast<size_t>(request->getPriority())].push_back(
+                {request, std::chrono::steady_clock::now()});
+            wakeNetworkLoopLocked();
             return true;
         } else {
             ACSDK_ERROR(LX("enqueueRequestFailed").d("reason", "isNotConnected"));
@@ -732,22 +1300,72 @@ bool HTTP2Transport::enqueueRequest(std::shared_ptr<MessageRequest> request, boo
     return false;
 }
 
-std::shared_ptr<MessageRequest> HTTP2Transport::dequeueRequest() {
+std::shared_ptr<MessageRequest> HTTP2Transport::dequeueRequest(std::chrono::steady_clock::duration* queueWait) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_isStopping || m_requestQueue.empty()) {
+    if (m_isStopping) {
         return nullptr;
     }
-    auto result = m_requestQueue.front();
-    m_requestQueue.pop_front();
-    return result;
+    for (auto& queue : m_requestQueues) {
+        if (!queue.empty()) {
+            auto result = queue.front();
+            queue.pop_front();
+            if (queueWait) {
+                *queueWait = std::chrono::steady_clock::now() - result.timeQueued;
+            }
+            return result.request;
+        }
+    }
+    return nullptr;
 }
 
 void HTTP2Transport::clearQueuedRequests() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto request : m_requestQueue) {
-        request->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
+    for (auto& queue : m_requestQueues) {
+        for (const auto& queuedRequest : queue) {
+            auto request = queuedRequest.request;
+            // Events are held to be sent on the next connection, but the post-connect message belongs to this one.
+            if (m_outboundEventBuffer && request != m_postConnectRequest && m_outboundEventBuffer->hold(request)) {
+                continue;
+            }
+            notifyRequestCompleted(request, MessageRequestObserverInterface::Status::NOT_CONNECTED);
+        }
+        queue.clear();
     }
-    m_requestQueue.clear();
+}
+
+void HTTP2Transport::notifyRequestCompleted(
+    std::shared_ptr<MessageRequest> request,
+    MessageRequestObserverInterface::Status status) {
+    if (m_requestCallbackExecutor) {
+        m_requestCallbackExecutor->submit([request, status]() { request->sendCompleted(status); });
+    } else {
+        request->sendCompleted(status);
+    }
+}
+
+void HTTP2Transport::wakeNetworkLoop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    wakeNetworkLoopLocked();
+}
+
+void HTTP2Transport::wakeNetworkLoopLocked() {
+    if (!m_multi) {
+        return;
+    }
+    if (m_networkReactor) {
+        m_isReactorWakePending = true;
+        m_networkReactor->wake(m_multi->getCurlHandle());
+    } else {
+        m_multi->wakeup();
+    }
+}
+
+bool HTTP2Transport::isNetworkLoopWakeable() const {
+    return m_networkReactor || (m_multi && m_multi->isWakeupSupported());
+}
+
+const TransferMetrics& HTTP2Transport::getTransferMetrics() const {
+    return m_transferMetrics;
 }
 
 void HTTP2Transport::addObserver(std::shared_ptr<TransportObserverInterface> observer) {
@@ -756,7 +1374,6 @@ void HTTP2Transport::addObserver(std::shared_ptr<TransportObserverInterface> obs
         return;
     }
 
-    std::lock_guard<std::mutex> lock{m_observerMutex};
     m_observers.insert(observer);
 }
 
@@ -766,36 +1383,26 @@ void HTTP2Transport::removeObserver(std::shared_ptr<TransportObserverInterface>
         return;
     }
 
-    std::lock_guard<std::mutex> lock{m_observerMutex};
     m_observers.erase(observer);
 }
 
 void HTTP2Transport::notifyObserversOnServerSideDisconnect() {
-    std::unique_lock<std::mutex> lock{m_observerMutex};
-    auto observers = m_observers;
-    lock.unlock();
-
-    for (auto observer : observers) {
+    auto observers = m_observers.snapshot();
+    for (const auto& observer : *observers) {
         observer->onServerSideDisconnect();
     }
 }
 
 void HTTP2Transport::notifyObserversOnDisconnect(ConnectionStatusObserverInterface::ChangedReason reason) {
-    std::unique_lock<std::mutex> lock{m_observerMutex};
-    auto observers = m_observers;
-    lock.unlock();
-
-    for (auto observer : observers) {
+    auto observers = m_observers.snapshot();
+    for (const auto& observer : *observers) {
         observer->onDisconnected(reason);
     }
 }
 
 void HTTP2Transport::notifyObserversOnConnected() {
-    std::unique_lock<std::mutex> lock{m_observerMutex};
-    auto observers = m_observers;
-    lock.unlock();
-
-    for (auto observer : observers) {
+    auto observers = m_observers.snapshot();
+    for (const auto& observer : *observers) {
         observer->onConnected();
     }
 }
@@ -803,6 +1410,7 @@ void HTTP2Transport::notifyObserversOnConnected() {
 bool HTTP2Transport::releaseDownchannelStream(
     bool removeFromMulti,
     ConnectionStatusObserverInterface::ChangedReason* reason) {
+    releaseDownchannelAttempts();
     if (m_downchannelStream) {
         if (!releaseStream(m_downchannelStream, removeFromMulti, "downchannel")) {
             if (reason) {
@@ -815,6 +1423,15 @@ bool HTTP2Transport::releaseDownchannelStream(
     return true;
 }
 
+void HTTP2Transport::releaseDownchannelAttempts() {
+    for (auto& attempt : m_downchannelAttempts) {
+        if (attempt.second) {
+            releaseStream(attempt.second, true, "downchannelAttempt");
+        }
+    }
+    m_downchannelAttempts.clear();
+}
+
 bool HTTP2Transport::releasePingStream(bool removeFromMulti) {
     if (m_pingStream) {
         if (!releaseStream(m_pingStream, removeFromMulti, "ping")) {
@@ -838,6 +1455,7 @@ void HTTP2Transport::releaseAllEventStreams() {
     for (auto stream : eventStreams) {
         releaseEventStream(stream);
     }
+    m_progressDeadlines = decltype(m_progressDeadlines)();
 }
 
 bool HTTP2Transport::releaseEventStream(std::shared_ptr<HTTP2Stream> stream, bool removeFromMulti) {
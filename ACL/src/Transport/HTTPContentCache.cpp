@@ -0,0 +1,373 @@
+/*
+ * HTTPContentCache.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ACL/Transport/HTTPContentCache.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <AVSCommon/Utils/File/FileUtils.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::utils::file;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("HTTPContentCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The suffix of the file holding the description of an entry.
+static const std::string ENTRY_FILE_SUFFIX = ".entry";
+/// The suffix of the file holding the body of an entry.
+static const std::string BODY_FILE_SUFFIX = ".body";
+/// The suffix of a file being written, which is renamed once it is complete.
+static const std::string TEMPORARY_FILE_SUFFIX = ".tmp";
+/// Permissions for the cache directory.
+static const mode_t DIRECTORY_MODE = 0700;
+
+/// The @c Cache-Control directive forbidding a response from being stored.
+static const std::string NO_STORE_DIRECTIVE = "no-store";
+/// The @c Cache-Control directive requiring a response to be revalidated before each use.
+static const std::string NO_CACHE_DIRECTIVE = "no-cache";
+/// The @c Cache-Control directive giving how long a response is fresh, followed by the number of seconds.
+static const std::string MAX_AGE_DIRECTIVE = "max-age=";
+
+/// The offset basis of the 64 bit FNV-1a hash.
+static const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+/// The prime of the 64 bit FNV-1a hash.
+static const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/**
+ * Hash a URL into the name of the files of its entry.  The hash is stable across runs, unlike @c std::hash, so that
+ * entries are found again after a restart.
+ *
+ * @param url The URL.
+ * @return The hash of the URL, as 16 hexadecimal digits.
+ */
+static std::string hashUrl(const std::string& url) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (unsigned char c : url) {
+        hash = (hash ^ c) * FNV_PRIME;
+    }
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return name;
+}
+
+/**
+ * Remove whitespace from both ends of a string.
+ *
+ * @param value The string.
+ * @return The string without leading or trailing whitespace.
+ */
+static std::string trim(const std::string& value) {
+    auto begin = std::find_if_not(value.begin(), value.end(), [](unsigned char c) { return std::isspace(c); });
+    auto end = std::find_if_not(value.rbegin(), value.rend(), [](unsigned char c) { return std::isspace(c); }).base();
+    return begin < end ? std::string(begin, end) : std::string();
+}
+
+std::shared_ptr<HTTPContentCache> HTTPContentCache::create(
+    const std::string& directory,
+    size_t maxSize,
+    size_t maxEntrySize) {
+    if (directory.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "emptyDirectory"));
+        return nullptr;
+    }
+    if (0 == maxEntrySize || maxEntrySize > maxSize) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidSizes")
+                        .d("maxSize", maxSize)
+                        .d("maxEntrySize", maxEntrySize));
+        return nullptr;
+    }
+    if (mkdir(directory.c_str(), DIRECTORY_MODE) != 0 && errno != EEXIST) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "mkdirFailed").d("directory", directory).d("errno", errno));
+        return nullptr;
+    }
+    auto cache = std::shared_ptr<HTTPContentCache>(new HTTPContentCache(directory, maxSize, maxEntrySize));
+    cache->load();
+    return cache;
+}
+
+HTTPContentCache::HTTPContentCache(const std::string& directory, size_t maxSize, size_t maxEntrySize) :
+        m_directory{directory},
+        m_maxSize{maxSize},
+        m_maxEntrySize{maxEntrySize},
+        m_size{0} {
+}
+
+size_t HTTPContentCache::getMaxEntrySize() const {
+    return m_maxEntrySize;
+}
+
+size_t HTTPContentCache::getSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+void HTTPContentCache::load() {
+    DIR* directory = opendir(m_directory.c_str());
+    if (!directory) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "opendirFailed").d("directory", m_directory));
+        return;
+    }
+    std::vector<std::string> names;
+    while (auto dirEntry = readdir(directory)) {
+        std::string name = dirEntry->d_name;
+        if (name.size() > ENTRY_FILE_SUFFIX.size() &&
+            name.compare(name.size() - ENTRY_FILE_SUFFIX.size(), ENTRY_FILE_SUFFIX.size(), ENTRY_FILE_SUFFIX) == 0) {
+            names.push_back(name.substr(0, name.size() - ENTRY_FILE_SUFFIX.size()));
+        }
+    }
+    closedir(directory);
+
+    // The body of an entry is touched each time it is used, so its modification time orders the entries.
+    using LoadedEntry = std::pair<time_t, std::pair<std::string, Entry>>;
+    std::vector<LoadedEntry> loaded;
+    for (const auto& name : names) {
+        auto entryPath = m_directory + "/" + name + ENTRY_FILE_SUFFIX;
+        auto bodyPath = m_directory + "/" + name + BODY_FILE_SUFFIX;
+        std::ifstream file(entryPath);
+        std::string url;
+        std::string expiry;
+        std::string size;
+        Entry entry;
+        struct stat bodyStat;
+        if (!std::getline(file, url) || !std::getline(file, entry.contentType) || !std::getline(file, entry.eTag) ||
+            !std::getline(file, entry.lastModified) || !std::getline(file, expiry) || !std::getline(file, size) ||
+            hashUrl(url) != name || stat(bodyPath.c_str(), &bodyStat) != 0 ||
+            std::to_string(bodyStat.st_size) != size) {
+            ACSDK_WARN(LX("loadEntryFailed").d("reason", "invalidEntry").d("name", name));
+            removeFile(entryPath);
+            removeFile(bodyPath);
+            continue;
+        }
+        entry.expiry = std::strtoll(expiry.c_str(), nullptr, 10);
+        entry.size = static_cast<size_t>(bodyStat.st_size);
+        loaded.push_back({bodyStat.st_mtime, {url, entry}});
+    }
+    std::sort(loaded.begin(), loaded.end(), [](const LoadedEntry& lhs, const LoadedEntry& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& item : loaded) {
+        const auto& url = item.second.first;
+        m_lru.push_front(url);
+        m_index[url] = {item.second.second, m_lru.begin()};
+        m_size += item.second.second.size;
+    }
+    while (m_size > m_maxSize && !m_lru.empty()) {
+        removeLocked(m_lru.back());
+    }
+    ACSDK_DEBUG(LX("loaded").d("entries", m_index.size()).d("size", m_size));
+}
+
+bool HTTPContentCache::lookup(const std::string& url, Entry* entry) {
+    if (!entry) {
+        ACSDK_ERROR(LX("lookupFailed").d("reason", "nullEntry"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(url);
+    if (it == m_index.end()) {
+        return false;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+    *entry = it->second.entry;
+    return true;
+}
+
+bool HTTPContentCache::read(const std::string& url, Entry* entry, std::string* body) {
+    if (!entry || !body) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullOutput"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(url);
+    if (it == m_index.end()) {
+        return false;
+    }
+    auto bodyPath = getPath(url, BODY_FILE_SUFFIX);
+    std::ifstream file(bodyPath, std::ios::binary);
+    body->resize(it->second.entry.size);
+    if (!file.read(&(*body)[0], body->size())) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "readBodyFailed").sensitive("url", url));
+        body->clear();
+        removeLocked(url);
+        return false;
+    }
+    // Record the use on disk too, so that the order of the entries survives a restart.
+    utimes(bodyPath.c_str(), nullptr);
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+    *entry = it->second.entry;
+    return true;
+}
+
+bool HTTPContentCache::store(const std::string& url, const Entry& entry, const std::string& body) {
+    if (body.size() > m_maxEntrySize) {
+        ACSDK_DEBUG(LX("storeSkipped").d("reason", "entryTooLarge").d("size", body.size()));
+        return false;
+    }
+    Entry stored = entry;
+    stored.size = body.size();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    removeLocked(url);
+    auto bodyPath = getPath(url, BODY_FILE_SUFFIX);
+    auto temporaryPath = bodyPath + TEMPORARY_FILE_SUFFIX;
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(body.data(), body.size()) || !file.flush()) {
+            ACSDK_ERROR(LX("storeFailed").d("reason", "writeBodyFailed").sensitive("url", url));
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), bodyPath.c_str()) != 0 || !writeEntry(url, stored)) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "commitFailed").sensitive("url", url));
+        std::remove(temporaryPath.c_str());
+        std::remove(bodyPath.c_str());
+        return false;
+    }
+
+    m_lru.push_front(url);
+    m_index[url] = {stored, m_lru.begin()};
+    m_size += stored.size;
+    while (m_size > m_maxSize) {
+        removeLocked(m_lru.back());
+    }
+    return true;
+}
+
+bool HTTPContentCache::refresh(const std::string& url, int64_t expiry) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(url);
+    if (it == m_index.end()) {
+        return false;
+    }
+    it->second.entry.expiry = expiry;
+    if (!writeEntry(url, it->second.entry)) {
+        ACSDK_ERROR(LX("refreshFailed").d("reason", "writeEntryFailed").sensitive("url", url));
+        removeLocked(url);
+        return false;
+    }
+    return true;
+}
+
+void HTTPContentCache::remove(const std::string& url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    removeLocked(url);
+}
+
+bool HTTPContentCache::getFreshnessLifetime(const std::string& cacheControl, std::chrono::seconds* lifetime) {
+    if (!lifetime) {
+        ACSDK_ERROR(LX("getFreshnessLifetimeFailed").d("reason", "nullLifetime"));
+        return false;
+    }
+    *lifetime = std::chrono::seconds::zero();
+    bool isNoCache = false;
+    std::istringstream directives(cacheControl);
+    std::string directive;
+    while (std::getline(directives, directive, ',')) {
+        directive = trim(directive);
+        std::transform(directive.begin(), directive.end(), directive.begin(), [](unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        if (directive == NO_STORE_DIRECTIVE) {
+            return false;
+        } else if (directive == NO_CACHE_DIRECTIVE) {
+            isNoCache = true;
+        } else if (directive.compare(0, MAX_AGE_DIRECTIVE.size(), MAX_AGE_DIRECTIVE) == 0) {
+            auto maxAge = std::strtoll(directive.c_str() + MAX_AGE_DIRECTIVE.size(), nullptr, 10);
+            if (maxAge > 0) {
+                *lifetime = std::chrono::seconds(maxAge);
+            }
+        }
+    }
+    if (isNoCache) {
+        *lifetime = std::chrono::seconds::zero();
+    }
+    return true;
+}
+
+std::string HTTPContentCache::getPath(const std::string& url, const std::string& suffix) const {
+    return m_directory + "/" + hashUrl(url) + suffix;
+}
+
+bool HTTPContentCache::writeEntry(const std::string& url, const Entry& entry) const {
+    auto entryPath = getPath(url, ENTRY_FILE_SUFFIX);
+    auto temporaryPath = entryPath + TEMPORARY_FILE_SUFFIX;
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        file << url << '\n'
+             << entry.contentType << '\n'
+             << entry.eTag << '\n'
+             << entry.lastModified << '\n'
+             << entry.expiry << '\n'
+             << entry.size << '\n';
+        if (!file.flush()) {
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), entryPath.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void HTTPContentCache::removeLocked(const std::string& url) {
+    auto it = m_index.find(url);
+    if (it == m_index.end()) {
+        return;
+    }
+    // The paths are built first, as @c url may be the element of @c m_lru being erased.
+    auto entryPath = getPath(url, ENTRY_FILE_SUFFIX);
+    auto bodyPath = getPath(url, BODY_FILE_SUFFIX);
+    m_size -= it->second.entry.size;
+    m_lru.erase(it->second.lruPosition);
+    m_index.erase(it);
+    removeFile(entryPath);
+    removeFile(bodyPath);
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -24,9 +24,19 @@
 namespace alexaClientSDK {
 namespace acl {
 
+HTTPContentFetcherFactory::HTTPContentFetcherFactory(
+    std::shared_ptr<LibCurlHttpContentFetchService> fetchService,
+    std::shared_ptr<ContentFetchBandwidthGovernor> bandwidthGovernor,
+    std::shared_ptr<HTTPContentCache> cache) :
+        m_fetchService{fetchService},
+        m_bandwidthGovernor{bandwidthGovernor},
+        m_cache{cache} {
+}
+
 std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> HTTPContentFetcherFactory::create(
     const std::string& url) {
-    return avsCommon::utils::memory::make_unique<LibCurlHttpContentFetcher>(url);
+    return avsCommon::utils::memory::make_unique<LibCurlHttpContentFetcher>(
+        url, m_fetchService, m_bandwidthGovernor, m_cache);
 }
 
 }  // namespace acl
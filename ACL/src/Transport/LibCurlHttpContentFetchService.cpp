@@ -0,0 +1,179 @@
+/*
+ * LibCurlHttpContentFetchService.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/LibCurlHttpContentFetchService.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("LibCurlHttpContentFetchService");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * How long to wait for network activity when @c CurlMultiHandleWrapper::wakeup() is supported.  libcurl shortens the
+ * wait to service its own timeouts, and @c wakeup() cuts it short when transfers are added or removed.
+ */
+static const std::chrono::milliseconds WAIT_FOR_ACTIVITY_TIMEOUT(1000);
+
+/// How long to wait for network activity when @c CurlMultiHandleWrapper::wakeup() is not supported.
+static const std::chrono::milliseconds POLL_TIMEOUT(10);
+
+std::shared_ptr<LibCurlHttpContentFetchService> LibCurlHttpContentFetchService::create() {
+    auto multi = CurlMultiHandleWrapper::create();
+    if (!multi) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createMultiHandleFailed"));
+        return nullptr;
+    }
+    if (curl_multi_setopt(multi->getCurlHandle(), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX) != CURLM_OK) {
+        ACSDK_WARN(LX("createWarning").d("reason", "enableMultiplexingFailed"));
+    }
+    return std::shared_ptr<LibCurlHttpContentFetchService>(new LibCurlHttpContentFetchService(std::move(multi)));
+}
+
+LibCurlHttpContentFetchService::LibCurlHttpContentFetchService(std::unique_ptr<CurlMultiHandleWrapper> multi) :
+        m_multi{std::move(multi)},
+        m_isStopping{false} {
+    m_thread = std::thread(&LibCurlHttpContentFetchService::loop, this);
+}
+
+LibCurlHttpContentFetchService::~LibCurlHttpContentFetchService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+        m_multi->wakeup();
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool LibCurlHttpContentFetchService::addTransfer(CURL* handle, CompletionCallback callback) {
+    if (!handle || !callback) {
+        ACSDK_ERROR(LX("addTransferFailed").d("reason", handle ? "nullCallback" : "nullHandle"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isStopping) {
+        ACSDK_ERROR(LX("addTransferFailed").d("reason", "isStopping"));
+        return false;
+    }
+    m_pendingAdds.emplace_back(handle, std::move(callback));
+    m_multi->wakeup();
+    return true;
+}
+
+void LibCurlHttpContentFetchService::removeTransfer(CURL* handle) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto it = m_pendingAdds.begin(); it != m_pendingAdds.end(); ++it) {
+        if (it->first == handle) {
+            m_pendingAdds.erase(it);
+            return;
+        }
+    }
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        lock.unlock();
+        removeActiveTransfer(handle);
+        return;
+    }
+    m_pendingRemoves.insert(handle);
+    m_multi->wakeup();
+    m_removedTrigger.wait(lock, [this, handle]() { return !m_pendingRemoves.count(handle); });
+}
+
+void LibCurlHttpContentFetchService::loop() {
+    const auto waitTimeout = m_multi->isWakeupSupported() ? WAIT_FOR_ACTIVITY_TIMEOUT : POLL_TIMEOUT;
+    while (true) {
+        std::deque<CompletionCallback> failed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_isStopping) {
+                m_pendingRemoves.clear();
+                m_removedTrigger.notify_all();
+                break;
+            }
+            applyPendingChangesLocked(&failed);
+        }
+        for (auto& callback : failed) {
+            callback(CURLE_FAILED_INIT);
+        }
+
+        int numTransfersLeft = 0;
+        auto result = m_multi->perform(&numTransfersLeft);
+        while (CURLM_CALL_MULTI_PERFORM == result) {
+            result = m_multi->perform(&numTransfersLeft);
+        }
+        if (result != CURLM_OK) {
+            ACSDK_ERROR(LX("performFailed").d("error", curl_multi_strerror(result)));
+        }
+
+        int numMessages = 0;
+        CURLMsg* message = nullptr;
+        while ((message = m_multi->infoRead(&numMessages)) != nullptr) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+            auto it = m_transfers.find(message->easy_handle);
+            if (it == m_transfers.end()) {
+                ACSDK_ERROR(LX("transferDoneError").d("reason", "unknownHandle"));
+                continue;
+            }
+            auto callback = std::move(it->second);
+            auto transferResult = message->data.result;
+            removeActiveTransfer(message->easy_handle);
+            callback(transferResult);
+        }
+
+        int numHandlesUpdated = 0;
+        m_multi->wait(waitTimeout, &numHandlesUpdated);
+    }
+}
+
+void LibCurlHttpContentFetchService::applyPendingChangesLocked(std::deque<CompletionCallback>* failed) {
+    for (auto handle : m_pendingRemoves) {
+        removeActiveTransfer(handle);
+    }
+    if (!m_pendingRemoves.empty()) {
+        m_pendingRemoves.clear();
+        m_removedTrigger.notify_all();
+    }
+    for (auto& transfer : m_pendingAdds) {
+        if (m_multi->addHandle(transfer.first) == CURLM_OK) {
+            m_transfers.insert(std::move(transfer));
+        } else {
+            failed->push_back(std::move(transfer.second));
+        }
+    }
+    m_pendingAdds.clear();
+}
+
+void LibCurlHttpContentFetchService::removeActiveTransfer(CURL* handle) {
+    if (m_transfers.erase(handle)) {
+        m_multi->removeHandle(handle);
+    }
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
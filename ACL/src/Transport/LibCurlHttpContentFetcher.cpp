@@ -17,9 +17,13 @@
 
 #include "ACL/Transport/LibCurlHttpContentFetcher.h"
 
+#include <algorithm>
+#include <cctype>
+
 #include <ACL/Transport/CurlEasyHandleWrapper.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 #include <AVSCommon/Utils/SDS/InProcessSDS.h>
+#include <AVSCommon/Utils/Timing/TimeUtils.h>
 
 namespace alexaClientSDK {
 namespace acl {
@@ -34,6 +38,66 @@ static const std::string TAG("LibCurlHttpContentFetcher");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+using namespace avsCommon::avs::attachment;
+
+/// The HTTP status code of a successful response.
+static const long HTTP_OK = 200;
+/// The HTTP status code of a response confirming that a cached response is still valid.
+static const long HTTP_NOT_MODIFIED = 304;
+
+/// The name of the HTTP header giving how a response may be cached, in lower case.
+static const std::string CACHE_CONTROL_HEADER = "cache-control";
+/// The name of the HTTP header giving the entity tag of a response, in lower case.
+static const std::string ETAG_HEADER = "etag";
+/// The name of the HTTP header giving when the content of a response was last modified, in lower case.
+static const std::string LAST_MODIFIED_HEADER = "last-modified";
+/// The prefix of the HTTP header making a request conditional on the entity tag of the content having changed.
+static const std::string IF_NONE_MATCH_HEADER_PREFIX = "If-None-Match: ";
+/// The prefix of the HTTP header making a request conditional on the content having been modified.
+static const std::string IF_MODIFIED_SINCE_HEADER_PREFIX = "If-Modified-Since: ";
+
+/**
+ * Get the value of an HTTP header line, if it is the header of the given name.  Header names are not case sensitive.
+ *
+ * @param line The header line, including its line terminator.
+ * @param name The name of the header, in lower case.
+ * @param[out] value The value of the header, without surrounding whitespace.
+ * @return Whether the line is the header of the given name.
+ */
+static bool getHeaderValue(const std::string& line, const std::string& name, std::string* value) {
+    if (line.size() <= name.size() || line[name.size()] != ':' ||
+        !std::equal(name.begin(), name.end(), line.begin(), [](char lhs, char rhs) {
+            return lhs == std::tolower(static_cast<unsigned char>(rhs));
+        })) {
+        return false;
+    }
+    auto begin = line.find_first_not_of(" \t", name.size() + 1);
+    auto end = line.find_last_not_of(" \t\r\n");
+    *value = (begin == std::string::npos || end < begin) ? "" : line.substr(begin, end - begin + 1);
+    return true;
+}
+
+/**
+ * Create the attachment to write the body of a response to, large enough to hold a body of a known size at once.
+ *
+ * @param id The id of the attachment.
+ * @param size The size of the body, or @c 0 if it is not known.
+ * @return The attachment, or @c nullptr if it could not be created.
+ */
+static std::shared_ptr<InProcessAttachment> createContentStream(const std::string& id, size_t size) {
+    if (size <= InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES) {
+        return std::make_shared<InProcessAttachment>(id);
+    }
+    auto buffer = std::make_shared<InProcessAttachment::SDSBufferType>(
+        InProcessAttachment::SDSType::calculateBufferSize(size));
+    auto sds = InProcessAttachment::SDSType::create(buffer);
+    if (!sds) {
+        ACSDK_ERROR(LX("createContentStreamFailed").d("reason", "createSdsFailed").d("size", size));
+        return nullptr;
+    }
+    return std::make_shared<InProcessAttachment>(id, std::move(sds));
+}
+
 size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t nmemb, void* userData) {
     if (!userData) {
         ACSDK_ERROR(LX("headerCallback").d("reason", "nullUserDataPointer"));
@@ -48,6 +112,10 @@ size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t
         iss >> httpVersion >> statusCode;
         LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
         thisObject->m_lastStatusCode = statusCode;
+        // Each response of a redirection starts over.
+        thisObject->m_lastCacheControl.clear();
+        thisObject->m_lastETag.clear();
+        thisObject->m_lastModified.clear();
     } else if (line.find("Content-Type") == 0) {
         // To find lines like: "Content-Type: audio/x-mpegurl; charset=utf-8"
         std::istringstream iss(line);
@@ -57,6 +125,12 @@ size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t
         contentType.pop_back();
         LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
         thisObject->m_lastContentType = contentType;
+    } else {
+        LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
+        if (!getHeaderValue(line, CACHE_CONTROL_HEADER, &thisObject->m_lastCacheControl) &&
+            !getHeaderValue(line, ETAG_HEADER, &thisObject->m_lastETag)) {
+            getHeaderValue(line, LAST_MODIFIED_HEADER, &thisObject->m_lastModified);
+        }
     }
     return size * nmemb;
 }
@@ -71,12 +145,22 @@ size_t LibCurlHttpContentFetcher::bodyCallback(char* data, size_t size, size_t n
         thisObject->m_bodyCallbackBegan = true;
         thisObject->m_statusCodePromise.set_value(thisObject->m_lastStatusCode);
         thisObject->m_contentTypePromise.set_value(thisObject->m_lastContentType);
+        thisObject->m_isCachingBody = thisObject->m_cache && HTTP_OK == thisObject->m_lastStatusCode;
     }
     auto streamWriter = thisObject->m_streamWriter;
     if (streamWriter) {
         avsCommon::avs::attachment::AttachmentWriter::WriteStatus writeStatus =
             avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
         auto numBytesWritten = streamWriter->write(data, size * nmemb, &writeStatus);
+        if (thisObject->m_isCachingBody) {
+            if (thisObject->m_body.size() + numBytesWritten > thisObject->m_cache->getMaxEntrySize()) {
+                // Too large to cache, such as a live stream.
+                thisObject->m_isCachingBody = false;
+                std::string().swap(thisObject->m_body);
+            } else {
+                thisObject->m_body.append(data, numBytesWritten);
+            }
+        }
         return numBytesWritten;
     } else {
         return 0;
@@ -87,17 +171,115 @@ size_t LibCurlHttpContentFetcher::noopCallback(char* data, size_t size, size_t n
     return 0;
 }
 
-LibCurlHttpContentFetcher::LibCurlHttpContentFetcher(const std::string& url) :
+int LibCurlHttpContentFetcher::progressCallback(
+    void* userData,
+    curl_off_t downloadTotal,
+    curl_off_t downloaded,
+    curl_off_t uploadTotal,
+    curl_off_t uploaded) {
+    if (!userData) {
+        ACSDK_ERROR(LX("progressCallback").d("reason", "nullUserDataPointer"));
+        return 0;
+    }
+    auto thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
+    thisObject->applyMaxRecvSpeed(thisObject->m_bandwidthGovernor->getMaxRecvSpeed());
+    // A failure to change the cap is not worth failing the transfer for.
+    return 0;
+}
+
+bool LibCurlHttpContentFetcher::applyMaxRecvSpeed(curl_off_t maxRecvSpeed) {
+    if (maxRecvSpeed == m_appliedMaxRecvSpeed) {
+        return true;
+    }
+    auto curlReturnValue = curl_easy_setopt(m_curlWrapper.getCurlHandle(), CURLOPT_MAX_RECV_SPEED_LARGE, maxRecvSpeed);
+    if (curlReturnValue != CURLE_OK) {
+        ACSDK_ERROR(LX("applyMaxRecvSpeedFailed").d("error", curl_easy_strerror(curlReturnValue)));
+        return false;
+    }
+    m_appliedMaxRecvSpeed = maxRecvSpeed;
+    return true;
+}
+
+LibCurlHttpContentFetcher::LibCurlHttpContentFetcher(
+    const std::string& url,
+    std::shared_ptr<LibCurlHttpContentFetchService> fetchService,
+    std::shared_ptr<ContentFetchBandwidthGovernor> bandwidthGovernor,
+    std::shared_ptr<HTTPContentCache> cache) :
         m_url{url},
         m_bodyCallbackBegan{false},
-        m_lastStatusCode{0} {
+        m_lastStatusCode{0},
+        m_fetchService{fetchService},
+        m_bandwidthGovernor{bandwidthGovernor},
+        m_appliedMaxRecvSpeed{0},
+        m_cache{cache},
+        m_isRevalidating{false},
+        m_isCachingBody{false},
+        m_fetchOption{FetchOptions::CONTENT_TYPE},
+        m_isTransferInProgress{false} {
     m_hasObjectBeenUsed.clear();
 }
 
+void LibCurlHttpContentFetcher::onTransferDone(FetchOptions fetchOption, CURLcode result) {
+    switch (fetchOption) {
+        case FetchOptions::CONTENT_TYPE: {
+            long finalResponseCode = 0;
+            char* contentType = nullptr;
+            if (result != CURLE_OK && result != CURLE_WRITE_ERROR) {
+                ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(result)));
+            }
+            auto curlReturnValue =
+                curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_RESPONSE_CODE, &finalResponseCode);
+            if (curlReturnValue != CURLE_OK) {
+                ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(curlReturnValue)));
+            }
+            ACSDK_DEBUG9(LX("getContent").d("responseCode", finalResponseCode).sensitive("url", m_url));
+            m_statusCodePromise.set_value(finalResponseCode);
+            curlReturnValue = curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_CONTENT_TYPE, &contentType);
+            if (curlReturnValue == CURLE_OK && contentType) {
+                ACSDK_DEBUG9(LX("getContent").d("contentType", contentType).sensitive("url", m_url));
+                m_contentTypePromise.set_value(std::string(contentType));
+            } else {
+                ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(curlReturnValue)));
+                ACSDK_ERROR(LX("getContent").d("contentType", "failedToGetContentType").sensitive("url", m_url));
+                m_contentTypePromise.set_value("");
+            }
+            break;
+        }
+        case FetchOptions::ENTIRE_BODY:
+            if (result != CURLE_OK) {
+                ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(result)));
+            }
+            if (!m_bodyCallbackBegan) {
+                if (CURLE_OK != result || HTTP_NOT_MODIFIED != m_lastStatusCode || !writeRevalidatedContent()) {
+                    m_statusCodePromise.set_value(m_lastStatusCode);
+                    m_contentTypePromise.set_value(m_lastContentType);
+                }
+            } else if (CURLE_OK == result) {
+                storeInCache();
+            }
+            /*
+             * Curl easy perform has finished and all data has been written. Closing writer so that readers know
+             * when they have caught up and read everything.
+             */
+            m_streamWriter->close();
+            break;
+    }
+}
+
 std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getContent(FetchOptions fetchOption) {
     if (m_hasObjectBeenUsed.test_and_set()) {
         return nullptr;
     }
+    HTTPContentCache::Entry cachedEntry;
+    bool isCached = m_cache && m_cache->lookup(m_url, &cachedEntry);
+    int64_t now = 0;
+    if (isCached && avsCommon::utils::timing::getCurrentUnixTime(&now) && now < cachedEntry.expiry) {
+        auto content = getCachedContent(fetchOption, cachedEntry);
+        if (content) {
+            return content;
+        }
+        isCached = m_cache->lookup(m_url, &cachedEntry);
+    }
     if (!m_curlWrapper.setURL(m_url)) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetUrl"));
         return nullptr;
@@ -133,34 +315,14 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlCallback"));
                 return nullptr;
             }
-            m_thread = std::thread([this]() {
-                long finalResponseCode = 0;
-                char* contentType = nullptr;
-                auto curlReturnValue = curl_easy_perform(m_curlWrapper.getCurlHandle());
-                if (curlReturnValue != CURLE_OK && curlReturnValue != CURLE_WRITE_ERROR) {
-                    ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                }
-                curlReturnValue =
-                    curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_RESPONSE_CODE, &finalResponseCode);
-                if (curlReturnValue != CURLE_OK) {
-                    ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                }
-                ACSDK_DEBUG9(LX("getContent").d("responseCode", finalResponseCode).sensitive("url", m_url));
-                m_statusCodePromise.set_value(finalResponseCode);
-                curlReturnValue = curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_CONTENT_TYPE, &contentType);
-                if (curlReturnValue == CURLE_OK && contentType) {
-                    ACSDK_DEBUG9(LX("getContent").d("contentType", contentType).sensitive("url", m_url));
-                    m_contentTypePromise.set_value(std::string(contentType));
-                } else {
-                    ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                    ACSDK_ERROR(LX("getContent").d("contentType", "failedToGetContentType").sensitive("url", m_url));
-                    m_contentTypePromise.set_value("");
-                }
-            });
             break;
         case FetchOptions::ENTIRE_BODY:
             // Using the url as the identifier for the attachment
-            stream = std::make_shared<avsCommon::avs::attachment::InProcessAttachment>(m_url);
+            stream = createContentStream(m_url, isCached ? cachedEntry.size : 0);
+            if (!stream) {
+                ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToCreateStream"));
+                return nullptr;
+            }
             m_streamWriter = stream->createWriter();
             if (!m_streamWriter) {
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToCreateWriter"));
@@ -174,33 +336,147 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlHeaderCallback"));
                 return nullptr;
             }
-            m_thread = std::thread([this]() {
-                auto curlReturnValue = curl_easy_perform(m_curlWrapper.getCurlHandle());
-                if (curlReturnValue != CURLE_OK) {
-                    ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                }
-                if (!m_bodyCallbackBegan) {
-                    m_statusCodePromise.set_value(m_lastStatusCode);
-                    m_contentTypePromise.set_value(m_lastContentType);
-                }
-                /*
-                 * Curl easy perform has finished and all data has been written. Closing writer so that readers know
-                 * when they have caught up and read everything.
-                 */
-                m_streamWriter->close();
-            });
+            // Ask the server to confirm a stale cached response instead of sending it again.
+            if (isCached && !cachedEntry.eTag.empty()) {
+                m_isRevalidating = m_curlWrapper.addHTTPHeader(IF_NONE_MATCH_HEADER_PREFIX + cachedEntry.eTag);
+            } else if (isCached && !cachedEntry.lastModified.empty()) {
+                m_isRevalidating =
+                    m_curlWrapper.addHTTPHeader(IF_MODIFIED_SINCE_HEADER_PREFIX + cachedEntry.lastModified);
+            }
             break;
         default:
             return nullptr;
     }
+    if (m_bandwidthGovernor) {
+        if (!applyMaxRecvSpeed(m_bandwidthGovernor->getMaxRecvSpeed()) ||
+            curl_easy_setopt(m_curlWrapper.getCurlHandle(), CURLOPT_XFERINFOFUNCTION, progressCallback) != CURLE_OK ||
+            curl_easy_setopt(m_curlWrapper.getCurlHandle(), CURLOPT_XFERINFODATA, this) != CURLE_OK ||
+            curl_easy_setopt(m_curlWrapper.getCurlHandle(), CURLOPT_NOPROGRESS, 0L) != CURLE_OK) {
+            ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetBandwidthGovernorCallback"));
+            return nullptr;
+        }
+    }
+    m_fetchOption = fetchOption;
+    if (m_fetchService) {
+        m_isTransferInProgress = true;
+        auto callback = [this, fetchOption](CURLcode result) {
+            onTransferDone(fetchOption, result);
+            m_isTransferInProgress = false;
+        };
+        if (!m_fetchService->addTransfer(m_curlWrapper.getCurlHandle(), callback)) {
+            m_isTransferInProgress = false;
+            ACSDK_ERROR(LX("getContentFailed").d("reason", "addTransferFailed"));
+            return nullptr;
+        }
+    } else {
+        m_thread = std::thread([this, fetchOption]() {
+            onTransferDone(fetchOption, curl_easy_perform(m_curlWrapper.getCurlHandle()));
+        });
+    }
     return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(
         avsCommon::utils::HTTPContent{std::move(httpStatusCodeFuture), std::move(contentTypeFuture), stream});
 }
 
+std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCachedContent(
+    FetchOptions fetchOption,
+    const HTTPContentCache::Entry& entry) {
+    std::shared_ptr<InProcessAttachment> stream = nullptr;
+    std::string contentType = entry.contentType;
+    if (FetchOptions::ENTIRE_BODY == fetchOption) {
+        HTTPContentCache::Entry readEntry;
+        std::string body;
+        if (!m_cache->read(m_url, &readEntry, &body)) {
+            return nullptr;
+        }
+        stream = createContentStream(m_url, body.size());
+        auto writer = stream ? stream->createWriter() : nullptr;
+        if (!writer) {
+            ACSDK_ERROR(LX("getCachedContentFailed").d("reason", "failedToCreateWriter"));
+            return nullptr;
+        }
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        if (!body.empty() && writer->write(body.data(), body.size(), &writeStatus) != body.size()) {
+            ACSDK_ERROR(LX("getCachedContentFailed").d("reason", "writeFailed"));
+            return nullptr;
+        }
+        writer->close();
+        contentType = readEntry.contentType;
+    }
+    ACSDK_DEBUG9(LX("getCachedContent").d("contentType", contentType).sensitive("url", m_url));
+    m_statusCodePromise.set_value(HTTP_OK);
+    m_contentTypePromise.set_value(contentType);
+    return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(avsCommon::utils::HTTPContent{
+        m_statusCodePromise.get_future(), m_contentTypePromise.get_future(), stream});
+}
+
+bool LibCurlHttpContentFetcher::writeRevalidatedContent() {
+    if (!m_isRevalidating) {
+        return false;
+    }
+    HTTPContentCache::Entry entry;
+    std::string body;
+    if (!m_cache->read(m_url, &entry, &body)) {
+        ACSDK_ERROR(LX("writeRevalidatedContentFailed").d("reason", "readFailed").sensitive("url", m_url));
+        return false;
+    }
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    if (!body.empty() && m_streamWriter->write(body.data(), body.size(), &writeStatus) != body.size()) {
+        ACSDK_ERROR(LX("writeRevalidatedContentFailed").d("reason", "writeFailed").sensitive("url", m_url));
+        return false;
+    }
+    std::chrono::seconds lifetime;
+    int64_t now = 0;
+    if (!HTTPContentCache::getFreshnessLifetime(m_lastCacheControl, &lifetime)) {
+        m_cache->remove(m_url);
+    } else if (avsCommon::utils::timing::getCurrentUnixTime(&now)) {
+        m_cache->refresh(m_url, now + lifetime.count());
+    }
+    ACSDK_DEBUG9(LX("writeRevalidatedContent").d("size", body.size()).sensitive("url", m_url));
+    m_statusCodePromise.set_value(HTTP_OK);
+    m_contentTypePromise.set_value(entry.contentType);
+    return true;
+}
+
+void LibCurlHttpContentFetcher::storeInCache() {
+    if (!m_isCachingBody) {
+        return;
+    }
+    std::chrono::seconds lifetime;
+    if (!HTTPContentCache::getFreshnessLifetime(m_lastCacheControl, &lifetime) ||
+        (lifetime.count() == 0 && m_lastETag.empty() && m_lastModified.empty())) {
+        // The response may not be stored, or could never be used without fetching it again.
+        m_cache->remove(m_url);
+        return;
+    }
+    HTTPContentCache::Entry entry;
+    char* contentType = nullptr;
+    if (curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_CONTENT_TYPE, &contentType) == CURLE_OK &&
+        contentType) {
+        entry.contentType = contentType;
+    }
+    entry.eTag = m_lastETag;
+    entry.lastModified = m_lastModified;
+    int64_t now = 0;
+    if (!avsCommon::utils::timing::getCurrentUnixTime(&now)) {
+        return;
+    }
+    entry.expiry = now + lifetime.count();
+    m_cache->store(m_url, entry, m_body);
+    std::string().swap(m_body);
+}
+
 LibCurlHttpContentFetcher::~LibCurlHttpContentFetcher() {
     if (m_thread.joinable()) {
         m_thread.join();
     }
+    if (m_isTransferInProgress) {
+        // Stop the transfer, and if it had not finished, let the holders of the content know it is over.
+        m_fetchService->removeTransfer(m_curlWrapper.getCurlHandle());
+        if (m_isTransferInProgress) {
+            onTransferDone(m_fetchOption, CURLE_ABORTED_BY_CALLBACK);
+            m_isTransferInProgress = false;
+        }
+    }
 }
 
 }  // namespace acl
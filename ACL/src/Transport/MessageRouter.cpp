@@ -42,16 +42,57 @@ static const std::string TAG("MessageRouter");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// Key for the root node of the ACL configuration.
+static const std::string CONFIG_KEY_ACL = "acl";
+
+/// Key for the node of the ACL configuration for the outbound event buffer.
+static const std::string CONFIG_KEY_OUTBOUND_EVENT_BUFFER = "outboundEventBuffer";
+
+/// Key for how long, in milliseconds, a message may be held while the connection is down.
+static const std::string CONFIG_KEY_MAX_AGE = "maxAgeMs";
+
+/// Key for the most bytes of messages which may be held while the connection is down.
+static const std::string CONFIG_KEY_MAX_BYTES = "maxBytes";
+
+/// The most bytes of messages which are held while the connection is down, if not configured.
+static const int DEFAULT_OUTBOUND_EVENT_BUFFER_MAX_BYTES = 1024 * 1024;
+
+/// How long a transport to a new endpoint may take to connect before the old connection is broken to switch to it.
+static const std::chrono::seconds ENDPOINT_SWITCH_TIMEOUT(30);
+
+/**
+ * Create the outbound event buffer, if one is configured.
+ *
+ * @param configurationRoot The root of the configuration.
+ * @return The outbound event buffer, or @c nullptr if messages are not to be held.
+ */
+static std::shared_ptr<OutboundEventBuffer> createOutboundEventBuffer(
+    const configuration::ConfigurationNode& configurationRoot) {
+    auto bufferConfiguration = configurationRoot[CONFIG_KEY_ACL][CONFIG_KEY_OUTBOUND_EVENT_BUFFER];
+    std::chrono::milliseconds maxAge;
+    bufferConfiguration.getDuration<std::chrono::milliseconds>(
+        CONFIG_KEY_MAX_AGE, &maxAge, std::chrono::milliseconds::zero());
+    if (maxAge <= std::chrono::milliseconds::zero()) {
+        return nullptr;
+    }
+    int maxBytes = DEFAULT_OUTBOUND_EVENT_BUFFER_MAX_BYTES;
+    bufferConfiguration.getInt(CONFIG_KEY_MAX_BYTES, &maxBytes, DEFAULT_OUTBOUND_EVENT_BUFFER_MAX_BYTES);
+    return OutboundEventBuffer::create(maxAge, static_cast<size_t>(std::max(maxBytes, 0)));
+}
+
 MessageRouter::MessageRouter(
     std::shared_ptr<AuthDelegateInterface> authDelegate,
     std::shared_ptr<AttachmentManager> attachmentManager,
     const std::string& avsEndpoint) :
         MessageRouterInterface{"MessageRouter"},
         m_avsEndpoint{avsEndpoint},
+        m_configurationRoot{configuration::ConfigurationNode::getRoot()},
+        m_outboundEventBuffer{createOutboundEventBuffer(m_configurationRoot)},
         m_authDelegate{authDelegate},
         m_connectionStatus{ConnectionStatusObserverInterface::Status::DISCONNECTED},
         m_connectionReason{ConnectionStatusObserverInterface::ChangedReason::ACL_CLIENT_REQUEST},
         m_isEnabled{false},
+        m_isLowPowerMode{false},
         m_attachmentManager{attachmentManager} {
 }
 
@@ -73,6 +114,7 @@ void MessageRouter::enable() {
 
 void MessageRouter::doShutdown() {
     disable();
+    m_endpointSwitchTimer.stop();
     m_executor.shutdown();
 }
 
@@ -80,6 +122,11 @@ void MessageRouter::disable() {
     std::unique_lock<std::mutex> lock{m_connectionMutex};
     m_isEnabled = false;
     disconnectAllTransportsLocked(lock, ConnectionStatusObserverInterface::ChangedReason::ACL_CLIENT_REQUEST);
+    lock.unlock();
+    // The connection is not coming back by itself, so the messages held for it are failed.
+    if (m_outboundEventBuffer) {
+        m_outboundEventBuffer->failAll();
+    }
 }
 
 // TODO: ACSDK-421: Revert this to use send().
@@ -91,6 +138,8 @@ void MessageRouter::sendMessage(std::shared_ptr<MessageRequest> request) {
     std::unique_lock<std::mutex> lock{m_connectionMutex};
     if (m_activeTransport) {
         m_activeTransport->send(request);
+    } else if (m_isEnabled && m_outboundEventBuffer && m_outboundEventBuffer->hold(request)) {
+        ACSDK_DEBUG(LX("sendMessage").m("Holding message until the connection is back"));
     } else {
         ACSDK_ERROR(LX("sendFailed").d("reason", "noActiveTransport"));
         request->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
@@ -101,6 +150,10 @@ void MessageRouter::setAVSEndpoint(const std::string& avsEndpoint) {
     std::unique_lock<std::mutex> lock{m_connectionMutex};
     if (avsEndpoint != m_avsEndpoint) {
         m_avsEndpoint = avsEndpoint;
+        // Connect to the new endpoint before leaving the old one, so that the messages in flight are not lost.
+        if (m_isEnabled && m_activeTransport && m_activeTransport->isConnected() && createPendingTransportLocked()) {
+            return;
+        }
         if (m_isEnabled) {
             disconnectAllTransportsLocked(
                 lock, ConnectionStatusObserverInterface::ChangedReason::SERVER_ENDPOINT_CHANGED);
@@ -112,12 +165,45 @@ void MessageRouter::setAVSEndpoint(const std::string& avsEndpoint) {
     }
 }
 
+void MessageRouter::onNetworkAvailable() {
+    std::lock_guard<std::mutex> lock{m_connectionMutex};
+    if (!m_isEnabled) {
+        return;
+    }
+    if (m_activeTransport) {
+        m_activeTransport->onNetworkAvailable();
+    } else {
+        // Creating the last transport failed, and nothing else would retry.
+        setConnectionStatusLocked(
+            ConnectionStatusObserverInterface::Status::PENDING,
+            ConnectionStatusObserverInterface::ChangedReason::ACL_CLIENT_REQUEST);
+        createActiveTransportLocked();
+    }
+}
+
+void MessageRouter::setLowPowerMode(bool enabled) {
+    std::lock_guard<std::mutex> lock{m_connectionMutex};
+    m_isLowPowerMode = enabled;
+    for (auto transport : m_transports) {
+        transport->setLowPowerMode(enabled);
+    }
+    if (m_pendingTransport) {
+        m_pendingTransport->setLowPowerMode(enabled);
+    }
+}
+
 void MessageRouter::onConnected() {
     std::unique_lock<std::mutex> lock{m_connectionMutex};
+    if (m_pendingTransport && m_pendingTransport->isConnected()) {
+        ACSDK_INFO(LX("endpointSwitched"));
+        switchToPendingTransportLocked();
+    }
     if (m_isEnabled) {
         setConnectionStatusLocked(
             ConnectionStatusObserverInterface::Status::CONNECTED,
             ConnectionStatusObserverInterface::ChangedReason::ACL_CLIENT_REQUEST);
+        // Send the messages held while the connection was down, before any sent from now on are queued.
+        sendHeldMessagesLocked();
     }
 }
 
@@ -152,6 +238,9 @@ void MessageRouter::onDisconnected(ConnectionStatusObserverInterface::ChangedRea
             if (!m_activeTransport) {
                 setConnectionStatusLocked(ConnectionStatusObserverInterface::Status::PENDING, reason);
                 createActiveTransportLocked();
+            } else if (m_activeTransport->isConnected()) {
+                // The messages the released transports held are sent on the one which replaced them.
+                sendHeldMessagesLocked();
             }
         } else if (m_transports.empty()) {
             setConnectionStatusLocked(ConnectionStatusObserverInterface::Status::DISCONNECTED, reason);
@@ -174,7 +263,11 @@ void MessageRouter::onServerSideDisconnect() {
 }
 
 void MessageRouter::consumeMessage(const std::string& contextId, const std::string& message) {
-    notifyObserverOnReceive(contextId, message);
+    notifyObserverOnReceive(contextId, std::make_shared<const std::string>(message));
+}
+
+void MessageRouter::consumeMessage(const std::string& contextId, std::string&& message) {
+    notifyObserverOnReceive(contextId, std::make_shared<const std::string>(std::move(message)));
 }
 
 void MessageRouter::setObserver(std::shared_ptr<MessageRouterObserverInterface> observer) {
@@ -205,19 +298,31 @@ void MessageRouter::notifyObserverOnConnectionStatusChanged(
     m_executor.submit(task);
 }
 
-void MessageRouter::notifyObserverOnReceive(const std::string& contextId, const std::string& message) {
+void MessageRouter::notifyObserverOnReceive(
+    const std::string& contextId,
+    std::shared_ptr<const std::string> message) {
+    // The message is shared, rather than copied into the lambda and again as the task is handed to the executor.
     auto task = [this, contextId, message]() {
         auto temp = getObserver();
         if (temp) {
-            temp->receive(contextId, message);
+            temp->receive(contextId, *message);
         }
     };
     m_executor.submit(task);
 }
 
 void MessageRouter::createActiveTransportLocked() {
+    if (m_pendingTransport) {
+        // The transport to the new endpoint is already connecting.
+        switchToPendingTransportLocked();
+        return;
+    }
+    configuration::ConfigurationNode::ScopedRoot scopedRoot(m_configurationRoot);
     auto transport =
         createTransport(m_authDelegate, m_attachmentManager, m_avsEndpoint, shared_from_this(), shared_from_this());
+    if (transport) {
+        transport->setLowPowerMode(m_isLowPowerMode);
+    }
     if (transport && transport->connect()) {
         m_transports.push_back(transport);
         m_activeTransport = transport;
@@ -231,6 +336,66 @@ void MessageRouter::createActiveTransportLocked() {
     }
 }
 
+bool MessageRouter::createPendingTransportLocked() {
+    m_endpointSwitchTimer.stop();
+    if (m_pendingTransport) {
+        safelyReleaseTransport(m_pendingTransport);
+        m_pendingTransport.reset();
+    }
+
+    configuration::ConfigurationNode::ScopedRoot scopedRoot(m_configurationRoot);
+    auto transport =
+        createTransport(m_authDelegate, m_attachmentManager, m_avsEndpoint, shared_from_this(), shared_from_this());
+    if (transport) {
+        transport->setLowPowerMode(m_isLowPowerMode);
+    }
+    if (!transport || !transport->connect()) {
+        ACSDK_ERROR(
+            LX("createPendingTransportFailed").d("reason", transport ? "internalError" : "createTransportFailed"));
+        safelyReleaseTransport(transport);
+        return false;
+    }
+
+    ACSDK_INFO(LX("switchingEndpoint").d("endpoint", m_avsEndpoint));
+    m_pendingTransport = transport;
+    std::weak_ptr<TransportInterface> weakTransport = transport;
+    m_endpointSwitchTimer.start(ENDPOINT_SWITCH_TIMEOUT, [this, weakTransport] {
+        m_executor.submit([this, weakTransport] { onEndpointSwitchTimedOut(weakTransport); });
+    });
+    return true;
+}
+
+void MessageRouter::switchToPendingTransportLocked() {
+    m_endpointSwitchTimer.stop();
+    m_transports.push_back(m_pendingTransport);
+    m_activeTransport = m_pendingTransport;
+    m_pendingTransport.reset();
+    if (m_activeTransport->isConnected()) {
+        for (auto transport : m_transports) {
+            if (transport != m_activeTransport) {
+                transport->disconnectWhenIdle();
+            }
+        }
+    }
+}
+
+void MessageRouter::onEndpointSwitchTimedOut(std::weak_ptr<TransportInterface> transport) {
+    std::unique_lock<std::mutex> lock{m_connectionMutex};
+    if (!m_pendingTransport || m_pendingTransport != transport.lock()) {
+        return;
+    }
+    ACSDK_WARN(LX("endpointSwitchTimedOut").d("endpoint", m_avsEndpoint));
+    safelyReleaseTransport(m_pendingTransport);
+    m_pendingTransport.reset();
+    if (m_isEnabled) {
+        disconnectAllTransportsLocked(lock, ConnectionStatusObserverInterface::ChangedReason::SERVER_ENDPOINT_CHANGED);
+    }
+    // disconnectAllTransportLocked releases the lock temporarily, so re-check m_isEnabled.
+    if (m_isEnabled) {
+        createActiveTransportLocked();
+    }
+}
+
 void MessageRouter::disconnectAllTransportsLocked(
     std::unique_lock<std::mutex>& lock,
     const ConnectionStatusObserverInterface::ChangedReason reason) {
@@ -239,6 +404,11 @@ void MessageRouter::disconnectAllTransportsLocked(
     // Use std::move() to optimize copy. Use clear() otherwise contents of m_transports becomes undefined.
     auto movedTransports = std::move(m_transports);
     m_transports.clear();
+    if (m_pendingTransport) {
+        m_endpointSwitchTimer.stop();
+        movedTransports.push_back(m_pendingTransport);
+        m_pendingTransport.reset();
+    }
 
     setConnectionStatusLocked(ConnectionStatusObserverInterface::Status::DISCONNECTED, reason);
 
@@ -249,6 +419,18 @@ void MessageRouter::disconnectAllTransportsLocked(
     lock.lock();
 }
 
+void MessageRouter::sendHeldMessagesLocked() {
+    if (m_outboundEventBuffer && m_activeTransport) {
+        for (auto& request : m_outboundEventBuffer->release()) {
+            m_activeTransport->send(request);
+        }
+    }
+}
+
+std::shared_ptr<OutboundEventBuffer> MessageRouter::getOutboundEventBuffer() const {
+    return m_outboundEventBuffer;
+}
+
 std::shared_ptr<MessageRouterObserverInterface> MessageRouter::getObserver() {
     std::lock_guard<std::mutex> lock{m_connectionMutex};
     return m_observer;
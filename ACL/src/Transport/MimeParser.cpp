@@ -14,14 +14,20 @@
  * express or implied. See the License for the specific language governing
  * permissions and limitations under the License.
  */
+#include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Metrics/DialogLatencyTracer.h>
+#include <AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h>
+#include <AVSCommon/Utils/String/StringUtils.h>
 #include "ACL/Transport/MimeParser.h"
 #include <sstream>
+#include <utility>
 
 namespace alexaClientSDK {
 namespace acl {
 
 using namespace avsCommon::utils;
+using namespace avsCommon::utils::metrics;
 using namespace avsCommon::avs::attachment;
 
 /// String to identify log entries originating from this file.
@@ -38,6 +44,8 @@ static const std::string TAG("MimeParser");
 static const std::string MIME_CONTENT_TYPE_FIELD_NAME = "Content-Type";
 /// MIME field name for a part's reference id
 static const std::string MIME_CONTENT_ID_FIELD_NAME = "Content-ID";
+/// MIME field name for a part's size in bytes
+static const std::string MIME_CONTENT_LENGTH_FIELD_NAME = "Content-Length";
 /// MIME type for JSON payloads
 static const std::string MIME_JSON_CONTENT_TYPE = "application/json";
 /// MIME type for binary streams
@@ -48,6 +56,8 @@ static const int LEADING_CRLF_CHAR_SIZE = 2;
 static const char CARRIAGE_RETURN_ASCII = 13;
 /// ASCII value of LF
 static const char LINE_FEED_ASCII = 10;
+/// The key of the dialogRequestId in the header of a directive.
+static const std::string DIALOG_REQUEST_ID_KEY = "dialogRequestId";
 
 /**
  *  Sanitize the Content-ID field in MIME header.
@@ -72,6 +82,24 @@ std::string sanitizeContentId(const std::string& mimeContentId) {
     return sanitizedContentId;
 }
 
+/**
+ * Gets the size of a MIME part from its Content-Length field.
+ *
+ * @param headers The headers of the part.
+ * @return The size of the part in bytes, or zero if the part has no valid Content-Length field.
+ */
+static size_t getContentLength(const MultipartHeaders& headers) {
+    if (1 != headers.count(MIME_CONTENT_LENGTH_FIELD_NAME)) {
+        return 0;
+    }
+    int contentLength = 0;
+    if (!string::stringToInt(headers[MIME_CONTENT_LENGTH_FIELD_NAME], &contentLength) || contentLength < 0) {
+        ACSDK_WARN(LX("getContentLengthFailed").d("reason", "invalidContentLength"));
+        return 0;
+    }
+    return static_cast<size_t>(contentLength);
+}
+
 MimeParser::MimeParser(
     std::shared_ptr<MessageConsumerInterface> messageConsumer,
     std::shared_ptr<AttachmentManager> attachmentManager) :
@@ -101,6 +129,10 @@ void MimeParser::partBeginCallback(const MultipartHeaders& headers, void* userDa
     std::string contentType = headers[MIME_CONTENT_TYPE_FIELD_NAME];
     if (contentType.find(MIME_JSON_CONTENT_TYPE) != std::string::npos) {
         parser->m_currDataType = MimeParser::ContentType::JSON;
+        // A part begun again when a feed is re-driven keeps the time it first started to arrive.
+        if (parser->m_directiveBeingReceived.empty() && DirectiveLatencyTracker::instance().isEnabled()) {
+            parser->m_directiveReceivedAt = std::chrono::steady_clock::now();
+        }
     } else if (contentType.find(MIME_OCTET_STREAM_CONTENT_TYPE) != std::string::npos) {
         if (1 == headers.count(MIME_CONTENT_ID_FIELD_NAME)) {
             auto contentId = sanitizeContentId(headers[MIME_CONTENT_ID_FIELD_NAME]);
@@ -108,7 +140,8 @@ void MimeParser::partBeginCallback(const MultipartHeaders& headers, void* userDa
                 parser->m_attachmentManager->generateAttachmentId(parser->m_attachmentContextId, contentId);
 
             if (!parser->m_attachmentWriter && attachmentId != parser->m_attachmentIdBeingReceived) {
-                parser->m_attachmentWriter = parser->m_attachmentManager->createWriter(attachmentId);
+                parser->m_attachmentWriter =
+                    parser->m_attachmentManager->createWriter(attachmentId, getContentLength(headers));
                 if (!parser->m_attachmentWriter) {
                     ACSDK_ERROR(LX("partBeginCallbackFailed")
                                     .d("reason", "createWriterFailed")
@@ -204,6 +237,11 @@ void MimeParser::partDataCallback(const char* buffer, size_t size, void* userDat
             parser->m_dataParsedStatus = parser->writeDataToAttachment(dataProcessingPoint, bytesToProcess);
             if (MimeParser::DataParsedStatus::OK == parser->m_dataParsedStatus) {
                 parser->updateCurrentByteProgress(bytesToProcess);
+                if (!parser->m_tracedDialogRequestId.empty()) {
+                    DialogLatencyTracer::instance().mark(
+                        parser->m_tracedDialogRequestId, DialogLatencyTracer::Mark::FIRST_ATTACHMENT_BYTE);
+                    parser->m_tracedDialogRequestId.clear();
+                }
             }
             break;
         default:
@@ -230,10 +268,20 @@ void MimeParser::partEndCallback(void* userData) {
                 break;
             }
             // Check there's data to send out, because in a re-drive we may skip a directive that's been seen before.
-            if (parser->m_directiveBeingReceived != "") {
+            if (!parser->m_directiveBeingReceived.empty()) {
+                DirectiveLatencyTracker::instance().recordReceived(
+                    parser->m_directiveBeingReceived, parser->m_directiveReceivedAt);
+                if (DialogLatencyTracer::instance().isEnabled() &&
+                    !json::jsonUtils::scanStringValue(
+                        parser->m_directiveBeingReceived, DIALOG_REQUEST_ID_KEY, &parser->m_tracedDialogRequestId)) {
+                    parser->m_tracedDialogRequestId.clear();
+                }
+                // Hand the buffer over rather than copying it, and start the next directive with as much room.
+                auto capacity = parser->m_directiveBeingReceived.capacity();
                 parser->m_messageConsumer->consumeMessage(
-                    parser->m_attachmentContextId, parser->m_directiveBeingReceived);
-                parser->m_directiveBeingReceived = "";
+                    parser->m_attachmentContextId, std::move(parser->m_directiveBeingReceived));
+                parser->m_directiveBeingReceived.clear();
+                parser->m_directiveBeingReceived.reserve(capacity);
             }
             break;
 
@@ -248,6 +296,7 @@ void MimeParser::partEndCallback(void* userData) {
 
 void MimeParser::reset() {
     m_currDataType = ContentType::NONE;
+    m_tracedDialogRequestId.clear();
     m_receivedFirstChunk = false;
     m_multipartReader.reset();
     m_dataParsedStatus = DataParsedStatus::OK;
@@ -286,25 +335,27 @@ void MimeParser::setBoundaryString(const std::string& boundaryString) {
  */
 MimeParser::DataParsedStatus MimeParser::feed(char* data, size_t length) {
     // Capture old state in case the complete parse does not succeed (see function comments).
-    auto oldReader = m_multipartReader;
+    m_multipartReaderSnapshot = m_multipartReader;
     auto oldReceivedFirstChunk = m_receivedFirstChunk;
     auto oldDataType = m_currDataType;
 
     /**
      * Our parser expects no leading CRLF in the data stream. Additionally downchannel streams
      * include this CRLF but event streams do not. So just remove the CRLF in the first chunk of the stream
-     * if it exists.
+     * if it exists.  A CRLF at the start of any later chunk is part of the data.
      */
-    if (!m_receivedFirstChunk) {
+    if (!m_receivedFirstChunk && length > 0) {
         if (length >= LEADING_CRLF_CHAR_SIZE && CARRIAGE_RETURN_ASCII == data[0] && LINE_FEED_ASCII == data[1]) {
             data += LEADING_CRLF_CHAR_SIZE;
             length -= LEADING_CRLF_CHAR_SIZE;
-            m_receivedFirstChunk = true;
         }
+        m_receivedFirstChunk = true;
     }
 
-    // Initialize this before all the feed() callbacks happen (since this persists from previous call).
+    // Initialize these before all the feed() callbacks happen (since they persist from previous call).  A re-drive
+    // replays this data from its start, so progress through it is counted from zero again.
     m_dataParsedStatus = DataParsedStatus::OK;
+    m_currentByteProgress = 0;
 
     m_multipartReader.feed(data, length);
 
@@ -313,7 +364,7 @@ MimeParser::DataParsedStatus MimeParser::feed(char* data, size_t length) {
         resetByteProgressCounters();
     } else {
         // There was a problem parsing the data - we need to reset the previous mime parser state for re-drive.
-        m_multipartReader = oldReader;
+        std::swap(m_multipartReader, m_multipartReaderSnapshot);
         m_receivedFirstChunk = oldReceivedFirstChunk;
         m_currDataType = oldDataType;
     }
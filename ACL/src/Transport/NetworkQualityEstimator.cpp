@@ -0,0 +1,172 @@
+/*
+ * NetworkQualityEstimator.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cmath>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/NetworkQualityEstimator.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("NetworkQualityEstimator");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const uint64_t NetworkQualityEstimator::MIN_THROUGHPUT_SAMPLE_BYTES = 16 * 1024;
+
+/// The weight of a new sample in the round trip time and the throughput.
+static const double SAMPLE_WEIGHT = 0.25;
+
+/// The weight of a new sample in the loss rate, which is lower because each sample is either 0 or 1.
+static const double LOSS_SAMPLE_WEIGHT = 0.1;
+
+/// The relative change in the round trip time or the throughput which is worth publishing.
+static const double MIN_RELATIVE_CHANGE = 0.25;
+
+/// The change in the loss rate which is worth publishing.
+static const double MIN_LOSS_RATE_CHANGE = 0.05;
+
+/**
+ * Add a sample to an exponentially weighted moving average.
+ *
+ * @param average The average, which is zero if there have been no samples.
+ * @param sample The sample.
+ * @param weight The weight of the sample.
+ */
+static void addSample(double* average, double sample, double weight) {
+    *average = 0 == *average ? sample : *average + weight * (sample - *average);
+}
+
+/**
+ * Check whether a signal has changed noticeably.
+ *
+ * @param value The signal now, which is zero if it has not been measured.
+ * @param published The signal when it was published, which is zero if it had not been measured.
+ * @return Whether the change is noticeable.
+ */
+static bool hasChanged(double value, double published) {
+    if (0 == published) {
+        return value != 0;
+    }
+    return std::fabs(value - published) > MIN_RELATIVE_CHANGE * published;
+}
+
+void NetworkQualityEstimator::recordPing(bool succeeded, std::chrono::microseconds rtt) {
+    NetworkQuality quality;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (succeeded && rtt.count() > 0) {
+            addSample(&m_rttUs, static_cast<double>(rtt.count()), SAMPLE_WEIGHT);
+        }
+        m_lossRate += LOSS_SAMPLE_WEIGHT * ((succeeded ? 0 : 1) - m_lossRate);
+        if (!shouldPublishLocked(&quality)) {
+            return;
+        }
+    }
+    publish(quality);
+}
+
+void NetworkQualityEstimator::recordTransfer(
+    bool succeeded,
+    uint64_t responseBytes,
+    std::chrono::microseconds responseTime) {
+    NetworkQuality quality;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (succeeded && responseBytes >= MIN_THROUGHPUT_SAMPLE_BYTES && responseTime.count() > 0) {
+            auto seconds = std::chrono::duration<double>(responseTime).count();
+            addSample(&m_throughput, static_cast<double>(responseBytes) / seconds, SAMPLE_WEIGHT);
+        }
+        m_lossRate += LOSS_SAMPLE_WEIGHT * ((succeeded ? 0 : 1) - m_lossRate);
+        if (!shouldPublishLocked(&quality)) {
+            return;
+        }
+    }
+    publish(quality);
+}
+
+NetworkQualityEstimator::NetworkQuality NetworkQualityEstimator::getQuality() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getQualityLocked();
+}
+
+void NetworkQualityEstimator::addObserver(std::shared_ptr<NetworkQualityObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("addObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    if (!m_observers.insert(observer)) {
+        return;
+    }
+    // An observer added after the connection was measured starts from the current estimate.
+    auto quality = getQuality();
+    if (quality.rtt.count() > 0 || quality.throughputBytesPerSecond > 0 || quality.lossRate > 0) {
+        observer->onNetworkQualityChanged(quality);
+    }
+}
+
+void NetworkQualityEstimator::removeObserver(std::shared_ptr<NetworkQualityObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("removeObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    m_observers.erase(observer);
+}
+
+NetworkQualityEstimator::NetworkQuality NetworkQualityEstimator::getQualityLocked() const {
+    NetworkQuality quality;
+    quality.rtt = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(m_rttUs)));
+    quality.throughputBytesPerSecond = static_cast<uint64_t>(m_throughput);
+    quality.lossRate = m_lossRate;
+    return quality;
+}
+
+bool NetworkQualityEstimator::shouldPublishLocked(NetworkQuality* quality) {
+    *quality = getQualityLocked();
+    if (!hasChanged(quality->rtt.count(), m_published.rtt.count()) &&
+        !hasChanged(quality->throughputBytesPerSecond, m_published.throughputBytesPerSecond) &&
+        std::fabs(quality->lossRate - m_published.lossRate) < MIN_LOSS_RATE_CHANGE) {
+        return false;
+    }
+    m_published = *quality;
+    return true;
+}
+
+void NetworkQualityEstimator::publish(const NetworkQuality& quality) {
+    ACSDK_DEBUG(LX("networkQualityChanged")
+                    .d("rttMs", quality.rtt.count())
+                    .d("throughputBytesPerSecond", quality.throughputBytesPerSecond)
+                    .d("lossRate", quality.lossRate));
+    auto observers = m_observers.snapshot();
+    for (const auto& observer : *observers) {
+        observer->onNetworkQualityChanged(quality);
+    }
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,166 @@
+/*
+ * OutboundEventBuffer.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Timing/TimerService.h>
+
+#include "ACL/Transport/OutboundEventBuffer.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("OutboundEventBuffer");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<OutboundEventBuffer> OutboundEventBuffer::create(std::chrono::milliseconds maxAge, size_t maxBytes) {
+    if (maxAge <= std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nonPositiveMaxAge"));
+        return nullptr;
+    }
+    if (!maxBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxBytes"));
+        return nullptr;
+    }
+    return std::shared_ptr<OutboundEventBuffer>(new OutboundEventBuffer(maxAge, maxBytes));
+}
+
+OutboundEventBuffer::OutboundEventBuffer(std::chrono::milliseconds maxAge, size_t maxBytes) :
+        m_maxAge{maxAge},
+        m_maxBytes{maxBytes},
+        m_bytes{0},
+        m_expiryTimer{timing::TimerService::getInstance()} {
+    m_expiryTimer.start(
+        m_maxAge,
+        timing::Timer::PeriodType::ABSOLUTE,
+        timing::Timer::FOREVER,
+        std::bind(&OutboundEventBuffer::expire, this));
+}
+
+OutboundEventBuffer::~OutboundEventBuffer() {
+    m_expiryTimer.stop();
+    failAll();
+}
+
+bool OutboundEventBuffer::hold(std::shared_ptr<MessageRequest> request) {
+    if (!request) {
+        ACSDK_ERROR(LX("holdFailed").d("reason", "nullRequest"));
+        return false;
+    }
+    auto bytes = request->getJsonContent().size();
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<MessageRequest>> expired;
+    bool held = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        expired = removeExpiredLocked(now);
+        if (m_bytes + bytes <= m_maxBytes) {
+            m_entries.push_back({request, bytes, now});
+            m_bytes += bytes;
+            held = true;
+        }
+    }
+    fail(expired);
+    if (!held) {
+        ACSDK_WARN(LX("holdFailed").d("reason", "maxBytesReached").d("bytes", bytes));
+    }
+    return held;
+}
+
+std::vector<std::shared_ptr<MessageRequest>> OutboundEventBuffer::release() {
+    std::vector<std::shared_ptr<MessageRequest>> expired;
+    std::deque<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        expired = removeExpiredLocked(std::chrono::steady_clock::now());
+        std::swap(entries, m_entries);
+        m_bytes = 0;
+    }
+    fail(expired);
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.request->getPriority() < rhs.request->getPriority();
+    });
+    std::vector<std::shared_ptr<MessageRequest>> requests;
+    requests.reserve(entries.size());
+    for (auto& entry : entries) {
+        requests.push_back(entry.request);
+    }
+    if (!requests.empty()) {
+        ACSDK_DEBUG(LX("release").d("requests", requests.size()).d("expired", expired.size()));
+    }
+    return requests;
+}
+
+void OutboundEventBuffer::failAll() {
+    std::vector<std::shared_ptr<MessageRequest>> requests;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& entry : m_entries) {
+            requests.push_back(entry.request);
+        }
+        m_entries.clear();
+        m_bytes = 0;
+    }
+    fail(requests);
+}
+
+size_t OutboundEventBuffer::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void OutboundEventBuffer::expire() {
+    std::vector<std::shared_ptr<MessageRequest>> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        expired = removeExpiredLocked(std::chrono::steady_clock::now());
+    }
+    fail(expired);
+}
+
+std::vector<std::shared_ptr<MessageRequest>> OutboundEventBuffer::removeExpiredLocked(
+    std::chrono::steady_clock::time_point now) {
+    std::vector<std::shared_ptr<MessageRequest>> expired;
+    while (!m_entries.empty() && now - m_entries.front().holdTime > m_maxAge) {
+        expired.push_back(m_entries.front().request);
+        m_bytes -= m_entries.front().bytes;
+        m_entries.pop_front();
+    }
+    return expired;
+}
+
+void OutboundEventBuffer::fail(const std::vector<std::shared_ptr<MessageRequest>>& requests) {
+    for (auto& request : requests) {
+        request->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
+    }
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
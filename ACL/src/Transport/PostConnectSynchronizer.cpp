@@ -15,16 +15,20 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include "ACL/Transport/HTTP2Transport.h"
 #include "ACL/Transport/TransportDefines.h"
 #include "ACL/Transport/PostConnectSynchronizer.h"
 #include <AVSCommon/AVS/EventBuilder.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 namespace alexaClientSDK {
 namespace acl {
 
 using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("PostConnectSynchronize");
@@ -42,11 +46,31 @@ static const std::string STATE_SYNCHRONIZER_NAMESPACE = "System";
 /// String to identify the AVS name of the event we send.
 static const std::string STATE_SYNCHRONIZER_NAME = "SynchronizeState";
 
+/// Key for the root node of the ACL configuration.
+static const std::string CONFIG_KEY_ACL = "acl";
+
+/// Key for the oldest cached context, in milliseconds, which may be sent in the SynchronizeState message.
+static const std::string CONFIG_KEY_CACHED_CONTEXT_MAX_AGE = "postConnectCachedContextMaxAgeMs";
+
+/**
+ * Read the oldest cached context which may be sent in the SynchronizeState message from the configuration.
+ *
+ * @return The configured age, or zero if cached contexts may not be sent.
+ */
+static std::chrono::milliseconds getConfiguredCachedContextMaxAge() {
+    std::chrono::milliseconds maxAge;
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_ACL].getDuration<std::chrono::milliseconds>(
+        CONFIG_KEY_CACHED_CONTEXT_MAX_AGE, &maxAge, std::chrono::milliseconds::zero());
+    return std::max(maxAge, std::chrono::milliseconds::zero());
+}
+
 PostConnectSynchronizer::PostConnectSynchronizer() :
         m_contextFetchInProgress{false},
         m_isPostConnected{false},
         m_isStopping{false},
-        m_postConnectThreadRunning{false} {
+        m_postConnectThreadRunning{false},
+        m_clock{avsCommon::utils::timing::Clock::getDefault()},
+        m_cachedContextMaxAge{getConfiguredCachedContextMaxAge()} {
 }
 
 void PostConnectSynchronizer::doShutdown() {
@@ -68,10 +92,7 @@ void PostConnectSynchronizer::doShutdown() {
             localPostConnectThread.join();
         }
     }
-    {
-        std::lock_guard<std::mutex> lock{m_observerMutex};
-        m_observers.clear();
-    }
+    m_observers.clear();
 }
 
 bool PostConnectSynchronizer::doPostConnect(std::shared_ptr<HTTP2Transport> transport) {
@@ -80,7 +101,7 @@ bool PostConnectSynchronizer::doPostConnect(std::shared_ptr<HTTP2Transport> tran
         return false;
     }
 
-    std::lock_guard<std::mutex> lock{m_mutex};
+    std::unique_lock<std::mutex> lock{m_mutex};
 
     /*
      * To handle cases where shutdown was invoked before the post-connect object is
@@ -105,10 +126,25 @@ bool PostConnectSynchronizer::doPostConnect(std::shared_ptr<HTTP2Transport> tran
     // disconnected.
     m_transport->addObserver(shared_from_this());
 
+    // A recent enough cached context is sent before the network loop starts, so it need not wait for the states.
+    std::string cachedContext;
+    std::shared_ptr<HTTP2Transport> cachedContextTransport;
+    if (m_cachedContextMaxAge > std::chrono::milliseconds::zero() &&
+        m_contextManager->getCachedContext(m_cachedContextMaxAge, &cachedContext)) {
+        m_contextFetchInProgress = true;
+        std::swap(m_transport, cachedContextTransport);
+    }
+
     m_postConnectThreadRunning = true;
 
     m_postConnectThread = std::thread(&PostConnectSynchronizer::postConnectLoop, this);
 
+    lock.unlock();
+    if (cachedContextTransport) {
+        ACSDK_DEBUG(LX("doPostConnect").m("Send PostConnectMessage with cached context to transport"));
+        sendSynchronizeState(cachedContext, cachedContextTransport);
+    }
+
     return true;
 }
 
@@ -129,7 +165,7 @@ void PostConnectSynchronizer::postConnectLoop() {
         auto retryBackoff = TransportDefines::RETRY_TIMER.calculateTimeToRetry(retryCount);
         retryCount++;
         std::unique_lock<std::mutex> lock(m_mutex);
-        m_wakeRetryTrigger.wait_for(lock, retryBackoff, [this] { return m_isPostConnected || m_isStopping; });
+        m_clock->waitFor(m_wakeRetryTrigger, lock, retryBackoff, [this] { return m_isPostConnected || m_isStopping; });
     }
 
     ACSDK_DEBUG9(LX("Exiting postConnectLoop thread"));
@@ -149,12 +185,6 @@ void PostConnectSynchronizer::onContextAvailable(const std::string& jsonContext)
         return;
     }
 
-    auto msgIdAndJsonEvent = avsCommon::avs::buildJsonEventString(
-        STATE_SYNCHRONIZER_NAMESPACE, STATE_SYNCHRONIZER_NAME, "", "{}", jsonContext);
-
-    auto postConnectMessage = std::make_shared<avsCommon::avs::MessageRequest>(msgIdAndJsonEvent.second);
-    postConnectMessage->addObserver(shared_from_this());
-
     /*
      * If the transport pointer held by the post-connect is still valid - not
      * shutdown yet then we send the message through the transport.
@@ -167,10 +197,21 @@ void PostConnectSynchronizer::onContextAvailable(const std::string& jsonContext)
 
     if (localTransport) {
         ACSDK_DEBUG(LX("onContextAvailable : Send PostConnectMessage to transport"));
-        localTransport->sendPostConnectMessage(postConnectMessage);
+        sendSynchronizeState(jsonContext, localTransport);
     }
 }
 
+void PostConnectSynchronizer::sendSynchronizeState(
+    const std::string& jsonContext,
+    std::shared_ptr<HTTP2Transport> transport) {
+    auto msgIdAndJsonEvent = avsCommon::avs::buildJsonEventString(
+        STATE_SYNCHRONIZER_NAMESPACE, STATE_SYNCHRONIZER_NAME, "", "{}", jsonContext);
+
+    auto postConnectMessage = std::make_shared<avsCommon::avs::MessageRequest>(std::move(msgIdAndJsonEvent.second));
+    postConnectMessage->addObserver(shared_from_this());
+    transport->sendPostConnectMessage(postConnectMessage);
+}
+
 void PostConnectSynchronizer::onContextFailure(const ContextRequestError error) {
     if (isPostConnected() || isStopping()) {
         ACSDK_DEBUG(LX("onContextFailureIgnored")
@@ -215,7 +256,6 @@ void PostConnectSynchronizer::addObserver(std::shared_ptr<PostConnectObserverInt
         return;
     }
 
-    std::lock_guard<std::mutex> lock{m_observerMutex};
     m_observers.insert(observer);
 }
 
@@ -225,16 +265,12 @@ void PostConnectSynchronizer::removeObserver(std::shared_ptr<PostConnectObserver
         return;
     }
 
-    std::lock_guard<std::mutex> lock{m_observerMutex};
     m_observers.erase(observer);
 }
 
 void PostConnectSynchronizer::notifyObservers() {
-    std::unique_lock<std::mutex> lock{m_observerMutex};
-    auto observers = m_observers;
-    lock.unlock();
-
-    for (auto observer : observers) {
+    auto observers = m_observers.snapshot();
+    for (const auto& observer : *observers) {
         observer->onPostConnected();
     }
 }
@@ -0,0 +1,209 @@
+/*
+ * ReplayTransport.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <unordered_map>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/MimeParser.h"
+#include "ACL/Transport/ReplayTransport.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ReplayTransport");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The prefix of the attachment context id of a replayed stream.
+static const std::string REPLAY_CONTEXT_ID_PREFIX_STRING = "ACL_REPLAYED_STREAM_ID_";
+
+/// How long to wait before feeding data again when an attachment could not take all of it.
+static const std::chrono::milliseconds INCOMPLETE_RETRY_INTERVAL(10);
+
+std::shared_ptr<ReplayTransport> ReplayTransport::create(
+    std::shared_ptr<MessageConsumerInterface> messageConsumer,
+    std::shared_ptr<AttachmentManager> attachmentManager,
+    std::vector<TrafficRecorder::Record> records,
+    Pace pace,
+    std::shared_ptr<TransportObserverInterface> transportObserver) {
+    if (!messageConsumer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullMessageConsumer"));
+        return nullptr;
+    }
+    if (!attachmentManager) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullAttachmentManager"));
+        return nullptr;
+    }
+    return std::shared_ptr<ReplayTransport>(
+        new ReplayTransport(messageConsumer, attachmentManager, std::move(records), pace, transportObserver));
+}
+
+ReplayTransport::ReplayTransport(
+    std::shared_ptr<MessageConsumerInterface> messageConsumer,
+    std::shared_ptr<AttachmentManager> attachmentManager,
+    std::vector<TrafficRecorder::Record> records,
+    Pace pace,
+    std::shared_ptr<TransportObserverInterface> transportObserver) :
+        m_messageConsumer{messageConsumer},
+        m_attachmentManager{attachmentManager},
+        m_records{std::move(records)},
+        m_pace{pace},
+        m_observer{transportObserver},
+        m_isConnected{false},
+        m_isStopping{false},
+        m_isReplayed{false} {
+}
+
+ReplayTransport::~ReplayTransport() {
+    disconnect();
+}
+
+void ReplayTransport::doShutdown() {
+    disconnect();
+}
+
+bool ReplayTransport::connect() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isStopping || m_replayThread.joinable()) {
+        return false;
+    }
+    m_replayThread = std::thread(&ReplayTransport::replayLoop, this);
+    return true;
+}
+
+void ReplayTransport::disconnect() {
+    std::thread localReplayThread;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+        std::swap(m_replayThread, localReplayThread);
+    }
+    m_wakeTrigger.notify_all();
+    if (localReplayThread.joinable()) {
+        if (localReplayThread.get_id() == std::this_thread::get_id()) {
+            localReplayThread.detach();
+        } else {
+            localReplayThread.join();
+        }
+    }
+    if (m_isConnected.exchange(false) && m_observer) {
+        m_observer->onDisconnected(ConnectionStatusObserverInterface::ChangedReason::ACL_CLIENT_REQUEST);
+    }
+}
+
+bool ReplayTransport::isConnected() {
+    return m_isConnected;
+}
+
+void ReplayTransport::send(std::shared_ptr<MessageRequest> request) {
+    if (!request) {
+        ACSDK_ERROR(LX("sendFailed").d("reason", "nullRequest"));
+        return;
+    }
+    request->sendCompleted(
+        m_isConnected ? MessageRequestObserverInterface::Status::SUCCESS
+                      : MessageRequestObserverInterface::Status::NOT_CONNECTED);
+}
+
+bool ReplayTransport::waitUntilReplayed(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, timeout, [this] { return m_isReplayed; });
+}
+
+bool ReplayTransport::waitForStop(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_until(lock, deadline, [this] { return m_isStopping; });
+}
+
+void ReplayTransport::replayLoop() {
+    m_isConnected = true;
+    if (m_observer) {
+        m_observer->onConnected();
+    }
+
+    std::unordered_map<unsigned int, std::unique_ptr<MimeParser>> parsers;
+    auto startTime = std::chrono::steady_clock::now();
+    bool isStopping = false;
+    for (auto& record : m_records) {
+        if (Pace::REAL_TIME == m_pace) {
+            isStopping = waitForStop(startTime + record.offset);
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            isStopping = m_isStopping;
+        }
+        if (isStopping) {
+            break;
+        }
+
+        if (TrafficRecorder::RecordType::STREAM_START == record.type) {
+            auto& parser = parsers[record.streamId];
+            if (parser) {
+                parser->reset();
+            } else {
+                parser.reset(new MimeParser(m_messageConsumer, m_attachmentManager));
+            }
+            parser->setAttachmentContextId(REPLAY_CONTEXT_ID_PREFIX_STRING + std::to_string(record.streamId));
+            parser->setBoundaryString(record.data);
+            continue;
+        }
+
+        auto it = parsers.find(record.streamId);
+        if (parsers.end() == it || record.data.empty()) {
+            ACSDK_WARN(LX("replayLoop").d("reason", "dataWithoutStreamStart").d("streamId", record.streamId));
+            continue;
+        }
+        auto status = it->second->feed(&record.data[0], record.data.size());
+        while (MimeParser::DataParsedStatus::INCOMPLETE == status) {
+            if (waitForStop(std::chrono::steady_clock::now() + INCOMPLETE_RETRY_INTERVAL)) {
+                isStopping = true;
+                break;
+            }
+            status = it->second->feed(&record.data[0], record.data.size());
+        }
+        if (isStopping) {
+            break;
+        }
+        if (MimeParser::DataParsedStatus::ERROR == status) {
+            ACSDK_ERROR(LX("replayLoop").d("reason", "parseFailed").d("streamId", record.streamId));
+            parsers.erase(it);
+        }
+    }
+
+    for (auto& parser : parsers) {
+        parser.second->reset();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isReplayed = !isStopping;
+    }
+    m_wakeTrigger.notify_all();
+    ACSDK_DEBUG(LX("replayLoopDone").d("records", m_records.size()).d("stopped", isStopping));
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,165 @@
+/*
+ * TrafficRecorder.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/TrafficRecorder.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("TrafficRecorder");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t TrafficRecorder::DEFAULT_MAX_BYTES;
+
+/// The first line of a saved recording.
+static const std::string SAVED_RECORDING_HEADER = "AVSTrafficRecording 1";
+
+/// The tag of a saved @c RecordType::STREAM_START record.
+static const char STREAM_START_TAG = 'S';
+
+/// The tag of a saved @c RecordType::DATA record.
+static const char DATA_TAG = 'D';
+
+TrafficRecorder& TrafficRecorder::instance() {
+    static TrafficRecorder recorder;
+    return recorder;
+}
+
+TrafficRecorder::TrafficRecorder() : m_isRecording{false}, m_maxBytes{0}, m_bytes{0}, m_droppedRecords{0} {
+}
+
+void TrafficRecorder::start(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+    m_startTime = std::chrono::steady_clock::now();
+    m_maxBytes = maxBytes;
+    m_bytes = 0;
+    m_droppedRecords = 0;
+    m_isRecording = true;
+}
+
+std::vector<TrafficRecorder::Record> TrafficRecorder::stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isRecording = false;
+    if (m_droppedRecords) {
+        ACSDK_WARN(LX("stop").d("reason", "maxBytesReached").d("droppedRecords", m_droppedRecords));
+    }
+    std::vector<Record> records;
+    records.swap(m_records);
+    return records;
+}
+
+bool TrafficRecorder::isRecording() const {
+    return m_isRecording;
+}
+
+void TrafficRecorder::recordStreamStart(unsigned int streamId, bool isDownchannel, const std::string& boundary) {
+    if (!m_isRecording) {
+        return;
+    }
+    add({RecordType::STREAM_START, streamId, isDownchannel, std::chrono::microseconds::zero(), boundary});
+}
+
+void TrafficRecorder::recordData(unsigned int streamId, bool isDownchannel, const char* data, size_t length) {
+    if (!m_isRecording || !data || !length) {
+        return;
+    }
+    add({RecordType::DATA, streamId, isDownchannel, std::chrono::microseconds::zero(), std::string(data, length)});
+}
+
+void TrafficRecorder::add(Record&& record) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isRecording) {
+        return;
+    }
+    if (m_bytes + record.data.size() > m_maxBytes) {
+        ++m_droppedRecords;
+        return;
+    }
+    m_bytes += record.data.size();
+    record.offset = std::chrono::duration_cast<std::chrono::microseconds>(now - m_startTime);
+    m_records.push_back(std::move(record));
+}
+
+bool TrafficRecorder::save(const std::vector<Record>& records, std::ostream& stream) {
+    stream << SAVED_RECORDING_HEADER << '\n';
+    for (const auto& record : records) {
+        stream << (RecordType::STREAM_START == record.type ? STREAM_START_TAG : DATA_TAG) << ' ' << record.streamId
+               << ' ' << (record.isDownchannel ? 1 : 0) << ' ' << record.offset.count() << ' ' << record.data.size()
+               << '\n';
+        stream.write(record.data.data(), record.data.size());
+        stream << '\n';
+    }
+    stream.flush();
+    if (!stream) {
+        ACSDK_ERROR(LX("saveFailed").d("reason", "writeFailed"));
+        return false;
+    }
+    return true;
+}
+
+bool TrafficRecorder::load(std::istream& stream, std::vector<Record>* records) {
+    if (!records) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "nullRecords"));
+        return false;
+    }
+    records->clear();
+    std::string header;
+    if (!std::getline(stream, header) || header != SAVED_RECORDING_HEADER) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "badHeader"));
+        return false;
+    }
+    char tag;
+    while (stream >> tag) {
+        Record record;
+        int isDownchannel = 0;
+        std::chrono::microseconds::rep offset = 0;
+        size_t size = 0;
+        if (!(stream >> record.streamId >> isDownchannel >> offset >> size) || stream.get() != '\n' ||
+            (tag != STREAM_START_TAG && tag != DATA_TAG)) {
+            ACSDK_ERROR(LX("loadFailed").d("reason", "badRecordHeader").d("record", records->size()));
+            return false;
+        }
+        record.type = STREAM_START_TAG == tag ? RecordType::STREAM_START : RecordType::DATA;
+        record.isDownchannel = isDownchannel != 0;
+        record.offset = std::chrono::microseconds(offset);
+        record.data.resize(size);
+        if (size && !stream.read(&record.data[0], size)) {
+            ACSDK_ERROR(LX("loadFailed").d("reason", "truncatedRecord").d("record", records->size()));
+            return false;
+        }
+        if (stream.get() != '\n') {
+            ACSDK_ERROR(LX("loadFailed").d("reason", "badRecordEnd").d("record", records->size()));
+            return false;
+        }
+        records->push_back(std::move(record));
+    }
+    return stream.eof();
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,128 @@
+/*
+ * TransferMetrics.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/TransferMetrics.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::metrics;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("TransferMetrics");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t TransferMetrics::NUM_STREAM_TYPES;
+const size_t TransferMetrics::NUM_PHASES;
+
+void TransferMetrics::record(StreamType streamType, const MessageRequestObserverInterface::TransferTimings& timings) {
+    const std::array<std::chrono::microseconds, NUM_PHASES> phases = {{timings.queueWait,
+                                                                       timings.firstUploadByte,
+                                                                       timings.uploadComplete,
+                                                                       timings.firstResponseByte,
+                                                                       timings.responseComplete}};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& histograms = m_histograms[static_cast<size_t>(streamType)];
+    for (size_t phase = 0; phase < NUM_PHASES; ++phase) {
+        if (phases[phase].count() > 0) {
+            histograms[phase].record(static_cast<uint64_t>(phases[phase].count()));
+        }
+    }
+}
+
+std::vector<TransferMetrics::Summary> TransferMetrics::getSummaries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Summary> summaries;
+    for (size_t streamType = 0; streamType < NUM_STREAM_TYPES; ++streamType) {
+        for (size_t phase = 0; phase < NUM_PHASES; ++phase) {
+            const auto& histogram = m_histograms[streamType][phase];
+            if (0 == histogram.getCount()) {
+                continue;
+            }
+            summaries.push_back({static_cast<StreamType>(streamType),
+                                 static_cast<Phase>(phase),
+                                 histogram.getCount(),
+                                 std::chrono::microseconds(histogram.getValueAtPercentile(50)),
+                                 std::chrono::microseconds(histogram.getValueAtPercentile(90)),
+                                 std::chrono::microseconds(histogram.getValueAtPercentile(99)),
+                                 std::chrono::microseconds(histogram.getMax())});
+        }
+    }
+    return summaries;
+}
+
+void TransferMetrics::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& histograms : m_histograms) {
+        for (auto& histogram : histograms) {
+            histogram.reset();
+        }
+    }
+}
+
+void TransferMetrics::dump() const {
+    for (const auto& summary : getSummaries()) {
+        ACSDK_INFO(LX("transferLatency")
+                       .d("streamType", summary.streamType)
+                       .d("phase", summary.phase)
+                       .d("count", summary.count)
+                       .d("p50Us", summary.p50.count())
+                       .d("p90Us", summary.p90.count())
+                       .d("p99Us", summary.p99.count())
+                       .d("maxUs", summary.max.count()));
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, TransferMetrics::StreamType streamType) {
+    switch (streamType) {
+        case TransferMetrics::StreamType::EVENT:
+            return stream << "EVENT";
+        case TransferMetrics::StreamType::DOWNCHANNEL:
+            return stream << "DOWNCHANNEL";
+        case TransferMetrics::StreamType::PING:
+            return stream << "PING";
+    }
+    return stream << "UNKNOWN";
+}
+
+std::ostream& operator<<(std::ostream& stream, TransferMetrics::Phase phase) {
+    switch (phase) {
+        case TransferMetrics::Phase::QUEUE_WAIT:
+            return stream << "QUEUE_WAIT";
+        case TransferMetrics::Phase::FIRST_UPLOAD_BYTE:
+            return stream << "FIRST_UPLOAD_BYTE";
+        case TransferMetrics::Phase::UPLOAD_COMPLETE:
+            return stream << "UPLOAD_COMPLETE";
+        case TransferMetrics::Phase::FIRST_RESPONSE_BYTE:
+            return stream << "FIRST_RESPONSE_BYTE";
+        case TransferMetrics::Phase::RESPONSE_COMPLETE:
+            return stream << "RESPONSE_COMPLETE";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -66,6 +66,8 @@ public:
     MOCK_METHOD1(sendMessage, void(std::shared_ptr<avsCommon::avs::MessageRequest> request));
     MOCK_METHOD1(setAVSEndpoint, void(const std::string& avsEndpoint));
     MOCK_METHOD1(setObserver, void(std::shared_ptr<MessageRouterObserverInterface> observer));
+    MOCK_METHOD0(onNetworkAvailable, void());
+    MOCK_METHOD1(setLowPowerMode, void(bool enabled));
 };
 
 /// Test harness for @c AVSConnectionManager class
@@ -217,6 +219,73 @@ TEST_F(AVSConnectionManagerTest, setAVSEndpointTest) {
     EXPECT_CALL(*m_messageRouter, setAVSEndpoint(_)).Times(1);
     m_avsConnectionManager->setAVSEndpoint("AVSEndpoint");
 }
+
+/**
+ * Test that onNetworkAvailable is passed to the messageRouter only while enabled, without reconnecting.
+ */
+TEST_F(AVSConnectionManagerTest, onNetworkAvailableTest) {
+    EXPECT_CALL(*m_messageRouter, disable()).Times(1);
+    m_avsConnectionManager->disable();
+    EXPECT_CALL(*m_messageRouter, onNetworkAvailable()).Times(0);
+    m_avsConnectionManager->onNetworkAvailable();
+
+    EXPECT_CALL(*m_messageRouter, enable()).Times(1);
+    m_avsConnectionManager->enable();
+    EXPECT_CALL(*m_messageRouter, disable()).Times(0);
+    EXPECT_CALL(*m_messageRouter, onNetworkAvailable()).Times(1);
+    m_avsConnectionManager->onNetworkAvailable();
+}
+
+/**
+ * Test that user inactivity closes the connection in low-power mode only, and that a message opens it again.
+ */
+TEST_F(AVSConnectionManagerTest, lowPowerModeDozesWhileUserInactive) {
+    EXPECT_CALL(*m_messageRouter, disable()).Times(0);
+    m_avsConnectionManager->onUserInactive();
+    ASSERT_FALSE(m_avsConnectionManager->isDozing());
+
+    EXPECT_CALL(*m_messageRouter, setLowPowerMode(true)).Times(1);
+    m_avsConnectionManager->setLowPowerMode(true);
+    EXPECT_CALL(*m_messageRouter, disable()).Times(1);
+    m_avsConnectionManager->onUserInactive();
+    ASSERT_TRUE(m_avsConnectionManager->isDozing());
+    ASSERT_TRUE(m_avsConnectionManager->isEnabled());
+    EXPECT_CALL(*m_messageRouter, onNetworkAvailable()).Times(0);
+    m_avsConnectionManager->onNetworkAvailable();
+
+    {
+        InSequence s;
+        EXPECT_CALL(*m_messageRouter, enable()).Times(1);
+        EXPECT_CALL(*m_messageRouter, sendMessage(_)).Times(1);
+    }
+    m_avsConnectionManager->sendMessage(std::make_shared<avsCommon::avs::MessageRequest>("Test message", nullptr));
+    ASSERT_FALSE(m_avsConnectionManager->isDozing());
+}
+
+/**
+ * Test that the connection opens again when the user is active, or the low-power mode disabled.
+ */
+TEST_F(AVSConnectionManagerTest, lowPowerModeWakesUp) {
+    m_avsConnectionManager->setLowPowerMode(true);
+    m_avsConnectionManager->onUserInactive();
+    ASSERT_TRUE(m_avsConnectionManager->isDozing());
+    EXPECT_CALL(*m_messageRouter, enable()).Times(1);
+    m_avsConnectionManager->onUserActiveAgain();
+    ASSERT_FALSE(m_avsConnectionManager->isDozing());
+    m_avsConnectionManager->onUserActiveAgain();
+
+    m_avsConnectionManager->onUserInactive();
+    EXPECT_CALL(*m_messageRouter, enable()).Times(1);
+    EXPECT_CALL(*m_messageRouter, setLowPowerMode(false)).Times(1);
+    m_avsConnectionManager->setLowPowerMode(false);
+    ASSERT_FALSE(m_avsConnectionManager->isDozing());
+
+    EXPECT_CALL(*m_messageRouter, disable()).Times(1);
+    m_avsConnectionManager->disable();
+    EXPECT_CALL(*m_messageRouter, enable()).Times(0);
+    m_avsConnectionManager->wake();
+}
+
 }  // namespace test
 }  // namespace acl
 }  // namespace alexaClientSDK
@@ -69,6 +69,17 @@ TestMimeAttachmentPart::TestMimeAttachmentPart(
         m_attachmentManager{attachmentManager} {
 }
 
+TestMimeAttachmentPart::TestMimeAttachmentPart(
+    const std::string& contextId,
+    const std::string contentId,
+    const std::string& attachmentData,
+    std::shared_ptr<AttachmentManager> attachmentManager) :
+        m_contextId{contextId},
+        m_contentId{contentId},
+        m_attachmentData{attachmentData},
+        m_attachmentManager{attachmentManager} {
+}
+
 std::string TestMimeAttachmentPart::toMimeString(const std::string& boundaryString) {
     return MIME_BOUNDARY_DASHES + boundaryString + MIME_NEWLINE + MIME_CONTENT_ID_PREFIX_STRING + m_contentId +
            MIME_NEWLINE + MIME_ATTACHMENT_PREFIX_STRING + MIME_NEWLINE + MIME_NEWLINE + m_attachmentData + MIME_NEWLINE;
@@ -95,6 +95,20 @@ public:
         int dataSize,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager);
 
+    /**
+     * Constructor.
+     *
+     * @param contextId The context id of the simulated Attachment.
+     * @param contentId The content id of the simulated Attachment.
+     * @param attachmentData The attachment data to be tested.
+     * @param attachmentManager An attachment manager with which this class should interact.
+     */
+    TestMimeAttachmentPart(
+        const std::string& contextId,
+        const std::string contentId,
+        const std::string& attachmentData,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager);
+
     std::string toMimeString(const std::string& boundaryString) override;
     virtual bool validateMimeParsing() override;
 
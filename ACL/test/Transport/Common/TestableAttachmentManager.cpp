@@ -49,6 +49,12 @@ bool TestableAttachmentManager::setAttachmentTimeoutMinutes(std::chrono::minutes
 }
 
 std::unique_ptr<AttachmentWriter> TestableAttachmentManager::createWriter(const std::string& attachmentId) {
+    return createWriter(attachmentId, 0);
+}
+
+std::unique_ptr<AttachmentWriter> TestableAttachmentManager::createWriter(
+    const std::string& attachmentId,
+    size_t sizeHint) {
     // First, let's create a dummy SDS.  Otherwise we need to intantiate the writer with nullptr, which is
     // probably not a good idea.
     auto buffSize = SDSType::calculateBufferSize(DUMMY_SDS_BUFFER_SIZE);
@@ -56,7 +62,7 @@ std::unique_ptr<AttachmentWriter> TestableAttachmentManager::createWriter(const
     std::shared_ptr<SDSType> dummySDS = SDSType::create(buff);
 
     // Create the writer we will encapsulate in a TestableAttachmentWriter.
-    auto writer = m_manager->createWriter(attachmentId);
+    auto writer = m_manager->createWriter(attachmentId, sizeHint);
     // Now create the wrapper class.
     std::unique_ptr<AttachmentWriter> testableWriter =
         std::unique_ptr<TestableAttachmentWriter>(new TestableAttachmentWriter(dummySDS, std::move(writer)));
@@ -71,6 +77,14 @@ std::unique_ptr<AttachmentReader> TestableAttachmentManager::createReader(
     return m_manager->createReader(attachmentId, policy);
 }
 
+void TestableAttachmentManager::addAttachmentContextReference(const std::string& contextId) {
+    m_manager->addAttachmentContextReference(contextId);
+}
+
+void TestableAttachmentManager::removeAttachmentContextReference(const std::string& contextId) {
+    m_manager->removeAttachmentContextReference(contextId);
+}
+
 }  // namespace test
 }  // namespace acl
 }  // namespace alexaClientSDK
@@ -42,10 +42,18 @@ public:
     std::unique_ptr<avsCommon::avs::attachment::AttachmentWriter> createWriter(
         const std::string& attachmentId) override;
 
+    std::unique_ptr<avsCommon::avs::attachment::AttachmentWriter> createWriter(
+        const std::string& attachmentId,
+        size_t sizeHint) override;
+
     std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> createReader(
         const std::string& attachmentId,
         avsCommon::avs::attachment::AttachmentReader::Policy policy) override;
 
+    void addAttachmentContextReference(const std::string& contextId) override;
+
+    void removeAttachmentContextReference(const std::string& contextId) override;
+
 private:
     /// The real AttachmentManager that most functionality routes to.
     std::unique_ptr<avsCommon::avs::attachment::AttachmentManager> m_manager;
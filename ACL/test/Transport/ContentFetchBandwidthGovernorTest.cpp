@@ -0,0 +1,107 @@
+/*
+ * ContentFetchBandwidthGovernorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ContentFetchBandwidthGovernorTest.cpp
+
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/ContentFetchBandwidthGovernor.h>
+#include <ACL/Transport/HTTPContentFetcherFactory.h>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// The cap on the download rate during a dialog used by the tests, in bytes per second.
+static const curl_off_t DIALOG_MAX_RECV_SPEED = 1024;
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::seconds LONG_TIMEOUT(10);
+
+/// The content of the file fetched by the tests.
+static const std::string FILE_CONTENT = "#EXTM3U\nhttp://example.com/segment.ts\n";
+
+/**
+ * Verify that a governor can not be created without a cap.
+ */
+TEST(ContentFetchBandwidthGovernorTest, createWithoutCap) {
+    EXPECT_FALSE(ContentFetchBandwidthGovernor::create(0));
+    EXPECT_FALSE(ContentFetchBandwidthGovernor::create(-1));
+}
+
+/**
+ * Verify that the download rate is capped while the user is speaking or waiting for the response, and only then.
+ */
+TEST(ContentFetchBandwidthGovernorTest, capDuringDialog) {
+    auto governor = ContentFetchBandwidthGovernor::create(DIALOG_MAX_RECV_SPEED);
+    ASSERT_TRUE(governor);
+    EXPECT_EQ(governor->getMaxRecvSpeed(), 0);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::LISTENING);
+    EXPECT_EQ(governor->getMaxRecvSpeed(), DIALOG_MAX_RECV_SPEED);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::THINKING);
+    EXPECT_EQ(governor->getMaxRecvSpeed(), DIALOG_MAX_RECV_SPEED);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::SPEAKING);
+    EXPECT_EQ(governor->getMaxRecvSpeed(), 0);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::THINKING);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    EXPECT_EQ(governor->getMaxRecvSpeed(), 0);
+}
+
+/**
+ * Verify that a fetch which starts while the download rate is capped receives its whole content once the cap is
+ * lifted.
+ */
+TEST(ContentFetchBandwidthGovernorTest, fetchWhileCapped) {
+    std::string path = "/tmp/ContentFetchBandwidthGovernorTest." + std::to_string(getpid());
+    std::ofstream(path) << FILE_CONTENT;
+    auto governor = ContentFetchBandwidthGovernor::create(DIALOG_MAX_RECV_SPEED);
+    ASSERT_TRUE(governor);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::LISTENING);
+    HTTPContentFetcherFactory factory(nullptr, governor);
+
+    auto fetcher = factory.create("file://" + path);
+    auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    ASSERT_TRUE(content);
+    governor->onDialogUXStateChanged(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    ASSERT_EQ(content->statusCode.wait_for(LONG_TIMEOUT), std::future_status::ready);
+
+    auto reader = content->dataStream->createReader(AttachmentReader::Policy::BLOCKING);
+    std::string text;
+    char buffer[256];
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (status != AttachmentReader::ReadStatus::CLOSED) {
+        auto count = reader->read(buffer, sizeof(buffer), &status, LONG_TIMEOUT);
+        ASSERT_NE(status, AttachmentReader::ReadStatus::OK_TIMEDOUT);
+        text.append(buffer, count);
+    }
+    EXPECT_EQ(text, FILE_CONTENT);
+    unlink(path.c_str());
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,104 @@
+/*
+ * CurlMultiHandleWrapperTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file CurlMultiHandleWrapperTest.cpp
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/CurlMultiHandleWrapper.h>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::milliseconds LONG_TIMEOUT(10000);
+
+/// A timeout short enough to wait for its expiration in a test.
+static const std::chrono::milliseconds SHORT_TIMEOUT(50);
+
+/// How long to wait before waking a blocked thread.
+static const std::chrono::milliseconds WAKEUP_DELAY(20);
+
+/**
+ * Our GTest class.
+ */
+class CurlMultiHandleWrapperTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /// The instance under test.
+    std::unique_ptr<CurlMultiHandleWrapper> m_multi;
+};
+
+void CurlMultiHandleWrapperTest::SetUp() {
+    m_multi = CurlMultiHandleWrapper::create();
+    ASSERT_TRUE(m_multi);
+    ASSERT_TRUE(m_multi->isWakeupSupported());
+}
+
+/**
+ * Verify that a pending wakeup causes @c wait() to return right away.
+ */
+TEST_F(CurlMultiHandleWrapperTest, wakeupBeforeWait) {
+    ASSERT_TRUE(m_multi->wakeup());
+    int numUpdated = 0;
+    bool wasWokenUp = false;
+    auto before = std::chrono::steady_clock::now();
+    ASSERT_EQ(CURLM_OK, m_multi->wait(LONG_TIMEOUT, &numUpdated, &wasWokenUp));
+    ASSERT_LT(std::chrono::steady_clock::now() - before, LONG_TIMEOUT);
+    ASSERT_TRUE(wasWokenUp);
+    ASSERT_EQ(CURLM_OK, m_multi->wait(SHORT_TIMEOUT, &numUpdated, &wasWokenUp));
+    ASSERT_FALSE(wasWokenUp);
+}
+
+/**
+ * Verify that @c wakeup() from another thread unblocks @c wait().
+ */
+TEST_F(CurlMultiHandleWrapperTest, wakeupDuringWait) {
+    std::thread waker([this] {
+        std::this_thread::sleep_for(WAKEUP_DELAY);
+        m_multi->wakeup();
+    });
+    int numUpdated = 0;
+    auto before = std::chrono::steady_clock::now();
+    auto result = m_multi->wait(LONG_TIMEOUT, &numUpdated);
+    auto elapsed = std::chrono::steady_clock::now() - before;
+    // Join before asserting, so that a failure does not destroy a joinable thread.
+    waker.join();
+    ASSERT_EQ(CURLM_OK, result);
+    ASSERT_LT(elapsed, LONG_TIMEOUT);
+}
+
+/**
+ * Verify that @c waitForWakeup() reports whether it was woken, and that wakeups do not accumulate once consumed.
+ */
+TEST_F(CurlMultiHandleWrapperTest, waitForWakeup) {
+    ASSERT_FALSE(m_multi->waitForWakeup(SHORT_TIMEOUT));
+    m_multi->wakeup();
+    m_multi->wakeup();
+    ASSERT_TRUE(m_multi->waitForWakeup(LONG_TIMEOUT));
+    ASSERT_FALSE(m_multi->waitForWakeup(SHORT_TIMEOUT));
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,192 @@
+/*
+ * CurlMultiReactorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file CurlMultiReactorTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/CurlMultiReactor.h>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::milliseconds LONG_TIMEOUT(10000);
+
+/// A timeout short enough to wait for its expiration in a test.
+static const std::chrono::milliseconds SHORT_TIMEOUT(50);
+
+/// A URL which a transfer reads at once, without the network.
+static const std::string EMPTY_URL = "file:///dev/null";
+
+/// The number of clients to drive at once.
+static const int NUMBER_OF_CLIENTS = 4;
+
+/// A time which never comes.
+static const std::chrono::steady_clock::time_point NEVER = std::chrono::steady_clock::time_point::max();
+
+/**
+ * Our GTest class.
+ */
+class CurlMultiReactorTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Wait until the callbacks have been called a number of times in all.
+     *
+     * @param count The number of calls to wait for.
+     * @return Whether there were that many calls before @c LONG_TIMEOUT.
+     */
+    bool waitForCalls(int count);
+
+    /**
+     * Count a call of a callback.
+     */
+    void countCall();
+
+    /// The instance under test.
+    std::shared_ptr<CurlMultiReactor> m_reactor;
+
+    /// The @c multi @c handles of the clients.
+    std::vector<CURLM*> m_multis;
+
+    /// Mutex to guard the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a callback is called.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of calls of the callbacks.
+    int m_calls;
+};
+
+void CurlMultiReactorTest::SetUp() {
+    m_reactor = CurlMultiReactor::create();
+    ASSERT_TRUE(m_reactor);
+    m_calls = 0;
+}
+
+void CurlMultiReactorTest::TearDown() {
+    for (auto multi : m_multis) {
+        m_reactor->removeClient(multi);
+        curl_multi_cleanup(multi);
+    }
+    m_reactor.reset();
+}
+
+bool CurlMultiReactorTest::waitForCalls(int count) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, LONG_TIMEOUT, [this, count] { return m_calls >= count; });
+}
+
+void CurlMultiReactorTest::countCall() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_calls++;
+    m_wakeTrigger.notify_all();
+}
+
+/**
+ * Verify that the transfers of several clients are driven to completion, each reported to its own callback.
+ */
+TEST_F(CurlMultiReactorTest, transfersComplete) {
+    int completed = 0;
+    for (int i = 0; i < NUMBER_OF_CLIENTS; ++i) {
+        auto multi = curl_multi_init();
+        ASSERT_TRUE(multi);
+        m_multis.push_back(multi);
+        auto easy = curl_easy_init();
+        ASSERT_TRUE(easy);
+        curl_easy_setopt(easy, CURLOPT_URL, EMPTY_URL.c_str());
+        ASSERT_EQ(CURLM_OK, curl_multi_add_handle(multi, easy));
+        auto callback = [this, multi, &completed](bool, int) {
+            int messagesLeft = 0;
+            CURLMsg* message = nullptr;
+            while ((message = curl_multi_info_read(multi, &messagesLeft))) {
+                if (CURLMSG_DONE == message->msg) {
+                    EXPECT_EQ(CURLE_OK, message->data.result);
+                    auto easy = message->easy_handle;
+                    curl_multi_remove_handle(multi, easy);
+                    curl_easy_cleanup(easy);
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    completed++;
+                    m_wakeTrigger.notify_all();
+                }
+            }
+            return NEVER;
+        };
+        ASSERT_TRUE(m_reactor->addClient(multi, callback));
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ASSERT_TRUE(m_wakeTrigger.wait_for(lock, LONG_TIMEOUT, [&completed] { return completed == NUMBER_OF_CLIENTS; }));
+}
+
+/**
+ * Verify that @c wake() has the callback called, and that a client cannot be added twice.
+ */
+TEST_F(CurlMultiReactorTest, wakeCallsCallback) {
+    auto multi = curl_multi_init();
+    ASSERT_TRUE(multi);
+    m_multis.push_back(multi);
+    auto callback = [this](bool, int) {
+        countCall();
+        return NEVER;
+    };
+    ASSERT_TRUE(m_reactor->addClient(multi, callback));
+    ASSERT_FALSE(m_reactor->addClient(multi, callback));
+    ASSERT_TRUE(waitForCalls(1));
+    m_reactor->wake(multi);
+    ASSERT_TRUE(waitForCalls(2));
+}
+
+/**
+ * Verify that the callback is called again at the time it asks for, and never once its client is removed.
+ */
+TEST_F(CurlMultiReactorTest, removeClientStopsCallbacks) {
+    auto multi = curl_multi_init();
+    ASSERT_TRUE(multi);
+    m_multis.push_back(multi);
+    ASSERT_TRUE(m_reactor->addClient(multi, [this](bool, int) {
+        countCall();
+        return std::chrono::steady_clock::now() + SHORT_TIMEOUT / 10;
+    }));
+    ASSERT_TRUE(waitForCalls(3));
+    m_reactor->removeClient(multi);
+    int calls = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        calls = m_calls;
+    }
+    std::this_thread::sleep_for(SHORT_TIMEOUT);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ASSERT_EQ(calls, m_calls);
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <random>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -45,6 +46,8 @@ using namespace alexaClientSDK::avsCommon::avs::initialization;
 static const std::string LIBCURL_TEST_URL = "http://example.com";
 /// A test auth string with which to initialize our test stream object.
 static const std::string LIBCURL_TEST_AUTH_STRING = "test_auth_string";
+/// A second auth string, to test re-initializing a stream after the token changes.
+static const std::string LIBCURL_NEW_AUTH_STRING = "new_auth_string";
 /// The length of the string we will test for the exception message.
 static const int TEST_EXCEPTION_STRING_LENGTH = 200;
 /// The number of iterations the multi-write test will perform.
@@ -190,6 +193,132 @@ TEST_F(HTTP2StreamTest, testReadCallBack) {
     bytesRead = HTTP2Stream::readCallback(m_dataBegin, TEST_EXCEPTION_STRING_LENGTH, NUMBER_OF_STRINGS, nullptr);
     ASSERT_EQ(0, bytesRead);
 }
+
+/**
+ * Verify that a stream can be reset and re-initialized, both with the same auth token (keeping the options set on its
+ * handle) and with a new one (replacing them).
+ */
+TEST_F(HTTP2StreamTest, testReuseAfterReset) {
+    ASSERT_TRUE(m_testableStream->reset());
+    ASSERT_TRUE(m_testableStream->initGet(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING));
+    ASSERT_TRUE(m_testableStream->reset());
+    ASSERT_TRUE(m_testableStream->initPost(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING, m_mockMessageRequest));
+    ASSERT_TRUE(m_testableStream->reset());
+    ASSERT_TRUE(m_testableStream->initPost(LIBCURL_TEST_URL, LIBCURL_NEW_AUTH_STRING, m_mockMessageRequest));
+    ASSERT_NE(m_testableStream->getCurlHandle(), nullptr);
+}
+
+/**
+ * Verify that a stream can be set up to POST large metadata compressed, and small metadata, which is not worth
+ * compressing, when compression is requested.
+ */
+TEST_F(HTTP2StreamTest, testInitPostWithCompressedMetadata) {
+    auto largeRequest = std::make_shared<MockMessageRequest>(std::string(TEST_EXCEPTION_STRING_LENGTH * 100, 'x'));
+    ASSERT_TRUE(m_testableStream->reset());
+    ASSERT_TRUE(m_testableStream->initPost(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING, largeRequest, true));
+    ASSERT_TRUE(m_testableStream->reset());
+    ASSERT_TRUE(m_testableStream->initPost(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING, m_mockMessageRequest, true));
+}
+
+/**
+ * Verify that a stream which accepts compressed responses can be set up for both the downchannel and events, including
+ * after a reset.
+ */
+TEST_F(HTTP2StreamTest, testInitWithCompressedResponses) {
+    auto stream = std::make_shared<HTTP2Stream>(m_testableConsumer, m_attachmentManager, true);
+    ASSERT_TRUE(stream->initGet(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING));
+    ASSERT_TRUE(stream->reset());
+    ASSERT_TRUE(stream->initPost(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING, m_mockMessageRequest));
+}
+
+/**
+ * Verify that streams of requests of a higher priority are given a larger HTTP/2 weight, and that streams of requests
+ * of every priority can be set up, including on a handle re-used from a GET.
+ */
+TEST_F(HTTP2StreamTest, testInitPostWithPriorities) {
+    EXPECT_GT(
+        HTTP2Stream::getStreamWeight(MessageRequest::Priority::HIGH),
+        HTTP2Stream::getStreamWeight(MessageRequest::Priority::NORMAL));
+    EXPECT_GT(
+        HTTP2Stream::getStreamWeight(MessageRequest::Priority::NORMAL),
+        HTTP2Stream::getStreamWeight(MessageRequest::Priority::LOW));
+    for (auto priority :
+         {MessageRequest::Priority::HIGH, MessageRequest::Priority::NORMAL, MessageRequest::Priority::LOW}) {
+        auto request = std::make_shared<MockMessageRequest>("", priority);
+        ASSERT_TRUE(m_testableStream->reset());
+        ASSERT_TRUE(m_testableStream->initPost(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING, request));
+        ASSERT_TRUE(m_testableStream->reset());
+        ASSERT_TRUE(m_testableStream->initGet(LIBCURL_TEST_URL, LIBCURL_TEST_AUTH_STRING));
+    }
+}
+
+/**
+ * Verify that the timing of a transfer includes the time its request was queued, and when its attachment was
+ * completely read.
+ */
+TEST_F(HTTP2StreamTest, testTransferTimings) {
+    static const std::chrono::milliseconds QUEUE_WAIT(7);
+    m_readTestableStream->setQueueWait(QUEUE_WAIT);
+    auto timings = m_readTestableStream->getTransferTimings();
+    EXPECT_EQ(timings.queueWait, QUEUE_WAIT);
+    EXPECT_EQ(timings.uploadComplete, std::chrono::microseconds::zero());
+
+    ASSERT_EQ(
+        HTTP2Stream::readCallback(
+            m_dataBegin, TEST_EXCEPTION_STRING_LENGTH, NUMBER_OF_STRINGS, m_readTestableStream.get()),
+        static_cast<size_t>(TEST_EXCEPTION_STRING_LENGTH));
+    m_writer->close();
+    EXPECT_EQ(
+        HTTP2Stream::readCallback(
+            m_dataBegin, TEST_EXCEPTION_STRING_LENGTH, NUMBER_OF_STRINGS, m_readTestableStream.get()),
+        0u);
+    timings = m_readTestableStream->getTransferTimings();
+    EXPECT_GT(timings.uploadComplete, std::chrono::microseconds::zero());
+
+    ASSERT_TRUE(m_readTestableStream->reset());
+    EXPECT_EQ(m_readTestableStream->getTransferTimings().queueWait, std::chrono::microseconds::zero());
+}
+
+/**
+ * Verify that the progress deadline follows the progress timeout, and is moved later by each transfer.
+ */
+TEST_F(HTTP2StreamTest, testProgressDeadline) {
+    static const std::chrono::seconds PROGRESS_TIMEOUT(30);
+    EXPECT_EQ(m_readTestableStream->getProgressDeadline(), std::chrono::steady_clock::time_point::max());
+
+    auto before = std::chrono::steady_clock::now();
+    m_readTestableStream->setProgressTimeout(PROGRESS_TIMEOUT);
+    auto deadline = m_readTestableStream->getProgressDeadline();
+    EXPECT_LE(deadline, std::chrono::steady_clock::now() + PROGRESS_TIMEOUT);
+    EXPECT_FALSE(m_readTestableStream->hasProgressTimedOut());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    HTTP2Stream::readCallback(m_dataBegin, TEST_EXCEPTION_STRING_LENGTH, NUMBER_OF_STRINGS, m_readTestableStream.get());
+    EXPECT_GT(m_readTestableStream->getProgressDeadline(), deadline);
+    EXPECT_GE(m_readTestableStream->getProgressDeadline(), before + PROGRESS_TIMEOUT);
+}
+
+/**
+ * Verify that a request is notified of its completion on an executor, with the exception read before the stream was
+ * reset for reuse.
+ */
+TEST_F(HTTP2StreamTest, testNotifyRequestObserverOnExecutor) {
+    HTTP2Stream::writeCallback(m_dataBegin, TEST_EXCEPTION_STRING_LENGTH, NUMBER_OF_STRINGS, m_testableStream.get());
+
+    auto callingThread = std::this_thread::get_id();
+    std::thread::id notifiedThread;
+    EXPECT_CALL(*m_mockMessageRequest, exceptionReceived(_)).Times(1);
+    EXPECT_CALL(*m_mockMessageRequest, sendCompleted(_)).WillOnce(InvokeWithoutArgs([&notifiedThread]() {
+        notifiedThread = std::this_thread::get_id();
+    }));
+
+    auto executor = std::make_shared<avsCommon::utils::threading::Executor>();
+    m_testableStream->notifyRequestObserver(executor);
+    ASSERT_TRUE(m_testableStream->reset());
+    executor->waitForSubmittedTasks();
+    EXPECT_NE(notifiedThread, std::thread::id());
+    EXPECT_NE(notifiedThread, callingThread);
+}
 }  // namespace test
 }  // namespace acl
 }  // namespace alexaClientSDK
@@ -0,0 +1,246 @@
+/*
+ * HTTPContentCacheTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file HTTPContentCacheTest.cpp
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/HTTPContentCache.h>
+#include <ACL/Transport/HTTPContentFetcherFactory.h>
+#include <AVSCommon/Utils/Timing/TimeUtils.h>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// The largest total size of the bodies in the caches under test.
+static const size_t MAX_SIZE = 100;
+
+/// The largest size of a body in the caches under test.
+static const size_t MAX_ENTRY_SIZE = 50;
+
+/// A URL to cache.
+static const std::string URL_1 = "https://example.com/alarm.mp3";
+
+/// Another URL to cache.
+static const std::string URL_2 = "https://example.com/timer.mp3";
+
+/// A third URL to cache.
+static const std::string URL_3 = "https://example.com/playlist.m3u";
+
+/// The content type of the cached responses.
+static const std::string CONTENT_TYPE = "audio/mpeg";
+
+/// The entity tag of the cached responses.
+static const std::string ETAG = "\"testETag\"";
+
+/// A URL with no server, whose content can only come from the cache.
+static const std::string UNREACHABLE_URL = "file:///nonexistent/HTTPContentCacheTest/alarm.mp3";
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::seconds LONG_TIMEOUT(10);
+
+/**
+ * Our GTest class.
+ */
+class HTTPContentCacheTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Build the description of an entry.
+     *
+     * @param lifetime How long from now the entry is fresh, in seconds.
+     * @return The description of the entry.
+     */
+    HTTPContentCache::Entry makeEntry(int64_t lifetime);
+
+    /// The directory of the cache under test.
+    std::string m_directory;
+
+    /// The cache under test.
+    std::shared_ptr<HTTPContentCache> m_cache;
+};
+
+void HTTPContentCacheTest::SetUp() {
+    m_directory = "/tmp/HTTPContentCacheTest." + std::to_string(getpid());
+    m_cache = HTTPContentCache::create(m_directory, MAX_SIZE, MAX_ENTRY_SIZE);
+    ASSERT_TRUE(m_cache);
+}
+
+void HTTPContentCacheTest::TearDown() {
+    m_cache.reset();
+    if (DIR* directory = opendir(m_directory.c_str())) {
+        while (auto entry = readdir(directory)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                unlink((m_directory + "/" + name).c_str());
+            }
+        }
+        closedir(directory);
+    }
+    rmdir(m_directory.c_str());
+}
+
+HTTPContentCache::Entry HTTPContentCacheTest::makeEntry(int64_t lifetime) {
+    int64_t now = 0;
+    avsCommon::utils::timing::getCurrentUnixTime(&now);
+    return {CONTENT_TYPE, ETAG, "", now + lifetime, 0};
+}
+
+/**
+ * Verify that a cache can not be created without a directory, or with entries larger than the cache.
+ */
+TEST_F(HTTPContentCacheTest, createWithInvalidParameters) {
+    EXPECT_FALSE(HTTPContentCache::create("", MAX_SIZE, MAX_ENTRY_SIZE));
+    EXPECT_FALSE(HTTPContentCache::create(m_directory, MAX_SIZE, 0));
+    EXPECT_FALSE(HTTPContentCache::create(m_directory, MAX_ENTRY_SIZE, MAX_SIZE));
+}
+
+/**
+ * Verify that a stored entry is found with its description and body, and that it can be refreshed and removed.
+ */
+TEST_F(HTTPContentCacheTest, storeAndRead) {
+    HTTPContentCache::Entry entry;
+    std::string body;
+    EXPECT_FALSE(m_cache->lookup(URL_1, &entry));
+    ASSERT_TRUE(m_cache->store(URL_1, makeEntry(60), "testBody"));
+    EXPECT_EQ(m_cache->getSize(), 8u);
+
+    ASSERT_TRUE(m_cache->read(URL_1, &entry, &body));
+    EXPECT_EQ(body, "testBody");
+    EXPECT_EQ(entry.contentType, CONTENT_TYPE);
+    EXPECT_EQ(entry.eTag, ETAG);
+    EXPECT_EQ(entry.size, 8u);
+
+    ASSERT_TRUE(m_cache->refresh(URL_1, 1234));
+    ASSERT_TRUE(m_cache->lookup(URL_1, &entry));
+    EXPECT_EQ(entry.expiry, 1234);
+
+    m_cache->remove(URL_1);
+    EXPECT_FALSE(m_cache->lookup(URL_1, &entry));
+    EXPECT_FALSE(m_cache->refresh(URL_1, 1234));
+    EXPECT_EQ(m_cache->getSize(), 0u);
+}
+
+/**
+ * Verify that a body larger than an entry may be is not stored.
+ */
+TEST_F(HTTPContentCacheTest, entryTooLarge) {
+    HTTPContentCache::Entry entry;
+    EXPECT_FALSE(m_cache->store(URL_1, makeEntry(60), std::string(MAX_ENTRY_SIZE + 1, 'x')));
+    EXPECT_FALSE(m_cache->lookup(URL_1, &entry));
+}
+
+/**
+ * Verify that the least recently used entries are evicted when the cache becomes too large.
+ */
+TEST_F(HTTPContentCacheTest, evictLeastRecentlyUsed) {
+    HTTPContentCache::Entry entry;
+    ASSERT_TRUE(m_cache->store(URL_1, makeEntry(60), std::string(MAX_ENTRY_SIZE, '1')));
+    ASSERT_TRUE(m_cache->store(URL_2, makeEntry(60), std::string(MAX_ENTRY_SIZE, '2')));
+    ASSERT_TRUE(m_cache->lookup(URL_1, &entry));
+    ASSERT_TRUE(m_cache->store(URL_3, makeEntry(60), std::string(MAX_ENTRY_SIZE, '3')));
+    EXPECT_TRUE(m_cache->lookup(URL_1, &entry));
+    EXPECT_FALSE(m_cache->lookup(URL_2, &entry));
+    EXPECT_TRUE(m_cache->lookup(URL_3, &entry));
+    EXPECT_EQ(m_cache->getSize(), MAX_SIZE);
+}
+
+/**
+ * Verify that the entries are found again by a cache re-created on the same directory.
+ */
+TEST_F(HTTPContentCacheTest, reloadFromDisk) {
+    ASSERT_TRUE(m_cache->store(URL_1, makeEntry(60), "testBody1"));
+    ASSERT_TRUE(m_cache->store(URL_2, makeEntry(60), "testBody2"));
+    m_cache = HTTPContentCache::create(m_directory, MAX_SIZE, MAX_ENTRY_SIZE);
+    ASSERT_TRUE(m_cache);
+    EXPECT_EQ(m_cache->getSize(), 18u);
+    HTTPContentCache::Entry entry;
+    std::string body;
+    ASSERT_TRUE(m_cache->read(URL_2, &entry, &body));
+    EXPECT_EQ(body, "testBody2");
+    EXPECT_EQ(entry.eTag, ETAG);
+}
+
+/**
+ * Verify the freshness lifetime found in @c Cache-Control headers.
+ */
+TEST_F(HTTPContentCacheTest, freshnessLifetime) {
+    std::chrono::seconds lifetime;
+    ASSERT_TRUE(HTTPContentCache::getFreshnessLifetime("", &lifetime));
+    EXPECT_EQ(lifetime.count(), 0);
+    ASSERT_TRUE(HTTPContentCache::getFreshnessLifetime("public, Max-Age=3600", &lifetime));
+    EXPECT_EQ(lifetime.count(), 3600);
+    ASSERT_TRUE(HTTPContentCache::getFreshnessLifetime("max-age=3600, no-cache", &lifetime));
+    EXPECT_EQ(lifetime.count(), 0);
+    EXPECT_FALSE(HTTPContentCache::getFreshnessLifetime("private, no-store", &lifetime));
+}
+
+/**
+ * Verify that a fetcher produces a fresh cached response without fetching it, both its content type and its body.
+ */
+TEST_F(HTTPContentCacheTest, fetchFreshContentFromCache) {
+    ASSERT_TRUE(m_cache->store(UNREACHABLE_URL, makeEntry(60), "cachedBody"));
+    HTTPContentFetcherFactory factory(nullptr, nullptr, m_cache);
+
+    auto content = factory.create(UNREACHABLE_URL)->getContent(HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
+    ASSERT_TRUE(content);
+    ASSERT_EQ(content->statusCode.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(content->statusCode.get(), 200);
+    EXPECT_EQ(content->contentType.get(), CONTENT_TYPE);
+
+    content = factory.create(UNREACHABLE_URL)->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    ASSERT_TRUE(content);
+    EXPECT_EQ(content->statusCode.get(), 200);
+    auto reader = content->dataStream->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    char buffer[256];
+    auto status = AttachmentReader::ReadStatus::OK;
+    auto count = reader->read(buffer, sizeof(buffer), &status);
+    EXPECT_EQ(std::string(buffer, count), "cachedBody");
+    reader->read(buffer, sizeof(buffer), &status);
+    EXPECT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+}
+
+/**
+ * Verify that a fetcher does not use a stale cached response which it can not revalidate.
+ */
+TEST_F(HTTPContentCacheTest, staleContentIsFetched) {
+    ASSERT_TRUE(m_cache->store(UNREACHABLE_URL, makeEntry(-60), "cachedBody"));
+    HTTPContentFetcherFactory factory(nullptr, nullptr, m_cache);
+    auto fetcher = factory.create(UNREACHABLE_URL);
+    auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    ASSERT_TRUE(content);
+    ASSERT_EQ(content->statusCode.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_NE(content->statusCode.get(), 200);
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,138 @@
+/*
+ * LibCurlHttpContentFetchServiceTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file LibCurlHttpContentFetchServiceTest.cpp
+
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/HTTPContentFetcherFactory.h>
+#include <ACL/Transport/LibCurlHttpContentFetchService.h>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::seconds LONG_TIMEOUT(10);
+
+/// The content of the file fetched by the tests.
+static const std::string FILE_CONTENT = "#EXTM3U\nhttp://example.com/segment.ts\n";
+
+/// A URL whose transfer never finishes.
+static const std::string ENDLESS_URL = "file:///dev/zero";
+
+/**
+ * Our GTest class.
+ */
+class LibCurlHttpContentFetchServiceTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Read everything from an attachment until its writer is closed.
+     *
+     * @param stream The attachment.
+     * @return The content of the attachment.
+     */
+    std::string readAll(std::shared_ptr<InProcessAttachment> stream);
+
+    /// The path of the file fetched by the tests.
+    std::string m_path;
+
+    /// The service under test.
+    std::shared_ptr<LibCurlHttpContentFetchService> m_fetchService;
+
+    /// A factory producing fetchers which use @c m_fetchService.
+    std::shared_ptr<HTTPContentFetcherFactory> m_factory;
+};
+
+void LibCurlHttpContentFetchServiceTest::SetUp() {
+    m_path = "/tmp/LibCurlHttpContentFetchServiceTest." + std::to_string(getpid());
+    std::ofstream(m_path) << FILE_CONTENT;
+    m_fetchService = LibCurlHttpContentFetchService::create();
+    ASSERT_TRUE(m_fetchService);
+    m_factory = std::make_shared<HTTPContentFetcherFactory>(m_fetchService);
+}
+
+void LibCurlHttpContentFetchServiceTest::TearDown() {
+    unlink(m_path.c_str());
+}
+
+std::string LibCurlHttpContentFetchServiceTest::readAll(std::shared_ptr<InProcessAttachment> stream) {
+    auto reader = stream->createReader(AttachmentReader::Policy::BLOCKING);
+    std::string result;
+    char buffer[256];
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (status != AttachmentReader::ReadStatus::CLOSED) {
+        auto count = reader->read(buffer, sizeof(buffer), &status);
+        result.append(buffer, count);
+    }
+    return result;
+}
+
+/**
+ * Verify that several fetches run on the service receive their whole content.
+ */
+TEST_F(LibCurlHttpContentFetchServiceTest, fetchesEntireBody) {
+    for (int i = 0; i < 3; ++i) {
+        auto fetcher = m_factory->create("file://" + m_path);
+        auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+        ASSERT_TRUE(content);
+        ASSERT_EQ(content->statusCode.wait_for(LONG_TIMEOUT), std::future_status::ready);
+        auto text = std::async(std::launch::async, [this, &content]() { return readAll(content->dataStream); });
+        ASSERT_EQ(text.wait_for(LONG_TIMEOUT), std::future_status::ready);
+        ASSERT_EQ(text.get(), FILE_CONTENT);
+    }
+}
+
+/**
+ * Verify that destroying a fetcher stops a transfer which has not finished, and closes its content.
+ */
+TEST_F(LibCurlHttpContentFetchServiceTest, destroyStopsTransfer) {
+    auto fetcher = m_factory->create(ENDLESS_URL);
+    auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    ASSERT_TRUE(content);
+    ASSERT_EQ(content->statusCode.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    auto destroyed = std::async(std::launch::async, [&fetcher]() { fetcher.reset(); });
+    ASSERT_EQ(destroyed.wait_for(LONG_TIMEOUT), std::future_status::ready);
+
+    auto reader = content->dataStream->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    char buffer[256];
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (status != AttachmentReader::ReadStatus::CLOSED &&
+           status != AttachmentReader::ReadStatus::OK_WOULDBLOCK) {
+        reader->read(buffer, sizeof(buffer), &status);
+    }
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
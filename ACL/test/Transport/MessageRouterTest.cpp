@@ -23,6 +23,7 @@ namespace acl {
 namespace test {
 
 using namespace alexaClientSDK::avsCommon::sdkInterfaces;
+using namespace alexaClientSDK::avsCommon::utils::configuration;
 
 TEST_F(MessageRouterTest, getConnectionStatusReturnsDisconnectedBeforeConnect) {
     ASSERT_EQ(m_router->getConnectionStatus().first, ConnectionStatusObserverInterface::Status::DISCONNECTED);
@@ -217,9 +218,131 @@ TEST_F(MessageRouterTest, serverSideDisconnectCreatesANewTransport) {
     waitOnMessageRouter(SHORT_TIMEOUT_MS);
 }
 
+/**
+ * This tests that, with an outbound event buffer configured, a message sent while there is no transport is held and
+ * sent once the connection is back.
+ */
+TEST_F(MessageRouterTest, heldMessageIsSentAfterReconnect) {
+    std::stringstream configuration(R"({"acl":{"outboundEventBuffer":{"maxAgeMs":60000}}})");
+    auto configurationRoot = ConfigurationNode::createRoot({&configuration});
+    std::shared_ptr<TestableMessageRouter> router;
+    {
+        ConfigurationNode::ScopedRoot scopedRoot(configurationRoot);
+        router = std::make_shared<TestableMessageRouter>(
+            m_mockAuthDelegate, m_attachmentManager, m_mockTransport, AVS_ENDPOINT);
+    }
+    router->setObserver(m_mockMessageRouterObserver);
+
+    // Connect, then lose the connection and fail to create a new transport.
+    initializeMockTransport(m_mockTransport.get());
+    router->enable();
+    connectMockTransport(m_mockTransport.get());
+    router->onConnected();
+    disconnectMockTransport(m_mockTransport.get());
+    ON_CALL(*m_mockTransport, connect()).WillByDefault(Return(false));
+    router->onDisconnected(ConnectionStatusObserverInterface::ChangedReason::SERVER_SIDE_DISCONNECT);
+
+    auto messageRequest = createMessageRequest();
+    EXPECT_CALL(*m_mockTransport, send(messageRequest)).Times(0);
+    router->sendMessage(messageRequest);
+    Mock::VerifyAndClearExpectations(m_mockTransport.get());
+
+    // Reconnect.  The held message is sent as soon as the transport is connected.
+    EXPECT_CALL(*m_mockTransport, send(messageRequest)).Times(1);
+    initializeMockTransport(m_mockTransport.get());
+    router->enable();
+    connectMockTransport(m_mockTransport.get());
+    router->onConnected();
+
+    router->shutdown();
+}
+
 /**
  * This tests the calling of private method @c receive() for MessageRouterObserver from MessageRouter
  */
+/**
+ * Verify that the active transport is told the network is available only while the router is enabled.
+ */
+/**
+ * Verify that changing the endpoint while connected keeps sending on the old transport until the new one is connected,
+ * then switches to the new one and lets the old one drain, without the observer seeing the connection go down.
+ */
+TEST_F(MessageRouterTest, setAVSEndpointConnectsBeforeDisconnecting) {
+    setupStateToConnected();
+    waitOnMessageRouter(SHORT_TIMEOUT_MS);
+    m_mockMessageRouterObserver->reset();
+
+    auto newTransport = std::make_shared<NiceMock<MockTransport>>();
+    initializeMockTransport(newTransport.get());
+    m_router->setMockTransport(newTransport);
+    EXPECT_CALL(*newTransport, connect()).Times(1);
+    EXPECT_CALL(*m_mockTransport, disconnectWhenIdle()).Times(0);
+    m_router->setAVSEndpoint("NEW_AVS_ENDPOINT");
+
+    auto messageOnOldTransport = createMessageRequest();
+    EXPECT_CALL(*m_mockTransport, send(messageOnOldTransport)).Times(1);
+    m_router->sendMessage(messageOnOldTransport);
+    Mock::VerifyAndClearExpectations(m_mockTransport.get());
+
+    EXPECT_CALL(*m_mockTransport, disconnectWhenIdle()).Times(1);
+    connectMockTransport(newTransport.get());
+    m_router->onConnected();
+    Mock::VerifyAndClearExpectations(m_mockTransport.get());
+
+    auto messageOnNewTransport = createMessageRequest();
+    EXPECT_CALL(*m_mockTransport, send(_)).Times(0);
+    EXPECT_CALL(*newTransport, send(messageOnNewTransport)).Times(1);
+    m_router->sendMessage(messageOnNewTransport);
+
+    // The old transport disconnects once it is idle.
+    disconnectMockTransport(m_mockTransport.get());
+    m_router->onDisconnected(ConnectionStatusObserverInterface::ChangedReason::SERVER_ENDPOINT_CHANGED);
+    waitOnMessageRouter(SHORT_TIMEOUT_MS);
+    ASSERT_FALSE(m_mockMessageRouterObserver->wasNotifiedOfStatusChange());
+    ASSERT_EQ(m_router->getConnectionStatus().first, ConnectionStatusObserverInterface::Status::CONNECTED);
+}
+
+/**
+ * Verify that changing the endpoint while not connected replaces the transport at once.
+ */
+TEST_F(MessageRouterTest, setAVSEndpointReconnectsWhenNotConnected) {
+    setupStateToPending();
+    auto newTransport = std::make_shared<NiceMock<MockTransport>>();
+    initializeMockTransport(newTransport.get());
+    m_router->setMockTransport(newTransport);
+    EXPECT_CALL(*m_mockTransport, doShutdown()).Times(1);
+    EXPECT_CALL(*newTransport, connect()).Times(1);
+    m_router->setAVSEndpoint("NEW_AVS_ENDPOINT");
+    waitOnMessageRouter(SHORT_TIMEOUT_MS);
+    Mock::VerifyAndClearExpectations(m_mockTransport.get());
+}
+
+TEST_F(MessageRouterTest, onNetworkAvailableIsPassedToActiveTransport) {
+    EXPECT_CALL(*m_mockTransport, onNetworkAvailable()).Times(0);
+    m_router->onNetworkAvailable();
+
+    setupStateToPending();
+    EXPECT_CALL(*m_mockTransport, onNetworkAvailable()).Times(1);
+    m_router->onNetworkAvailable();
+}
+
+/**
+ * Verify that the low-power mode is passed to the connected transports, and to those created afterwards.
+ */
+TEST_F(MessageRouterTest, setLowPowerModeIsPassedToTransports) {
+    setupStateToConnected();
+    EXPECT_CALL(*m_mockTransport, setLowPowerMode(true)).Times(1);
+    m_router->setLowPowerMode(true);
+    Mock::VerifyAndClearExpectations(m_mockTransport.get());
+
+    auto newTransport = std::make_shared<NiceMock<MockTransport>>();
+    initializeMockTransport(newTransport.get());
+    m_router->setMockTransport(newTransport);
+    EXPECT_CALL(*newTransport, setLowPowerMode(true)).Times(1);
+    m_router->onServerSideDisconnect();
+    waitOnMessageRouter(SHORT_TIMEOUT_MS);
+}
+
 TEST_F(MessageRouterTest, onReceiveTest) {
     m_mockMessageRouterObserver->reset();
     m_router->consumeMessage(CONTEXT_ID, MESSAGE);
@@ -229,6 +352,19 @@ TEST_F(MessageRouterTest, onReceiveTest) {
     ASSERT_EQ(MESSAGE, m_mockMessageRouterObserver->getLatestMessage());
 }
 
+/**
+ * Verify that a message whose buffer is handed over is received by the observer as it was sent.
+ */
+TEST_F(MessageRouterTest, onReceiveOwnedMessageTest) {
+    m_mockMessageRouterObserver->reset();
+    std::string message = MESSAGE;
+    m_router->consumeMessage(CONTEXT_ID, std::move(message));
+    waitOnMessageRouter(SHORT_TIMEOUT_MS);
+    ASSERT_TRUE(m_mockMessageRouterObserver->wasNotifiedOfReceive());
+    ASSERT_EQ(CONTEXT_ID, m_mockMessageRouterObserver->getAttachmentContextId());
+    ASSERT_EQ(MESSAGE, m_mockMessageRouterObserver->getLatestMessage());
+}
+
 /**
  * This tests the calling of private method @c onConnectionStatusChanged()
  * for MessageRouterObserver from MessageRouter
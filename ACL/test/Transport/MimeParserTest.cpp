@@ -212,6 +212,43 @@ TEST_F(MimeParserTest, testDirectiveAndAttachmentReceivedMultiWrite) {
     validateMimePartsParsedOk();
 }
 
+/**
+ * Test feeding a MIME string to the parser whose attachment data contains CRs, dashes and incomplete boundaries,
+ * which must be delivered as data rather than taken for the end of the part.
+ */
+TEST_F(MimeParserTest, testAttachmentContainingBoundaryPrefixes) {
+    auto partialBoundary = MIME_TEST_BOUNDARY_STRING.substr(0, MIME_TEST_BOUNDARY_STRING.size() / 2);
+    std::string attachmentData = createRandomAlphabetString(TEST_DATA_SIZE) + "\r" +
+                                 createRandomAlphabetString(TEST_DATA_SIZE) + "\r\n--" + partialBoundary + "\r\n" +
+                                 "\r\r\n-" + MIME_TEST_BOUNDARY_STRING + "\r\n--" + MIME_TEST_BOUNDARY_STRING + "x" +
+                                 createRandomAlphabetString(TEST_DATA_SIZE) + "\r";
+    m_mimeParts.push_back(std::make_shared<TestMimeAttachmentPart>(
+        TEST_CONTEXT_ID, TEST_CONTENT_ID_01, attachmentData, m_attachmentManager));
+    m_mimeParts.push_back(std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_testableMessageObserver));
+
+    auto mimeString = constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING);
+    feedParser(mimeString, TEST_MULTI_WRITE_ITERATIONS);
+
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Test feeding a MIME string without a leading CRLF, as event responses are, in chunks where a later chunk starts with
+ * a CRLF.  Only a CRLF at the start of the stream may be dropped.
+ */
+TEST_F(MimeParserTest, testLaterChunkStartingWithCrlf) {
+    m_mimeParts.push_back(std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_testableMessageObserver));
+    m_mimeParts.push_back(std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_testableMessageObserver));
+
+    auto mimeString = constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING);
+    auto split = mimeString.find("\r\n\r\n");
+    ASSERT_NE(split, std::string::npos);
+    ASSERT_EQ(m_parser->feed(&mimeString[0], split), MimeParser::DataParsedStatus::OK);
+    ASSERT_EQ(m_parser->feed(&mimeString[split], mimeString.size() - split), MimeParser::DataParsedStatus::OK);
+
+    validateMimePartsParsedOk();
+}
+
 }  // namespace test
 }  // namespace acl
 }  // namespace alexaClientSDK
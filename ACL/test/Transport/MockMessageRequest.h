@@ -36,8 +36,12 @@ class MockMessageRequest : public avsCommon::avs::MessageRequest {
 public:
     /**
      * Constructor.
+     *
+     * @param jsonContent The message to be sent to AVS.
+     * @param priority The priority with which the message is sent.
      */
-    MockMessageRequest() : avsCommon::avs::MessageRequest{"", nullptr} {
+    MockMessageRequest(const std::string& jsonContent = "", Priority priority = Priority::NORMAL) :
+            avsCommon::avs::MessageRequest{jsonContent, nullptr, priority} {
     }
     MOCK_METHOD1(exceptionReceived, void(const std::string& exceptionMessage));
     MOCK_METHOD1(sendCompleted, void(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status));
@@ -43,6 +43,9 @@ public:
     MOCK_METHOD0(isConnected, bool());
     MOCK_METHOD0(isPendingDisconnected, bool());
     MOCK_METHOD1(send, void(std::shared_ptr<avsCommon::avs::MessageRequest>));
+    MOCK_METHOD0(onNetworkAvailable, void());
+    MOCK_METHOD0(disconnectWhenIdle, void());
+    MOCK_METHOD1(setLowPowerMode, void(bool enabled));
     MOCK_METHOD2(onAttachmentReceived, void(const std::string& contextId, const std::string& message));
 
     const int m_id;
@@ -0,0 +1,132 @@
+/*
+ * NetworkQualityEstimatorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file NetworkQualityEstimatorTest.cpp
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ACL/Transport/NetworkQualityEstimator.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::sdkInterfaces;
+
+/// The round trip time of the pings recorded by the tests.
+static const std::chrono::milliseconds RTT(100);
+
+/// The time taken by the responses recorded by the tests.
+static const std::chrono::seconds RESPONSE_TIME(1);
+
+/// An observer which keeps the estimates it is told about.
+class RecordingObserver : public NetworkQualityObserverInterface {
+public:
+    void onNetworkQualityChanged(const NetworkQuality& quality) override {
+        qualities.push_back(quality);
+    }
+
+    /// The estimates, in the order they were told.
+    std::vector<NetworkQuality> qualities;
+};
+
+/**
+ * Test that nothing is estimated before anything is recorded.
+ */
+TEST(NetworkQualityEstimatorTest, emptyEstimate) {
+    NetworkQualityEstimator estimator;
+    auto quality = estimator.getQuality();
+    EXPECT_EQ(0, quality.rtt.count());
+    EXPECT_EQ(0u, quality.throughputBytesPerSecond);
+    EXPECT_EQ(0, quality.lossRate);
+}
+
+/**
+ * Test that the round trip time is taken from successful pings, and smoothed.
+ */
+TEST(NetworkQualityEstimatorTest, rttFromPings) {
+    NetworkQualityEstimator estimator;
+    estimator.recordPing(true, RTT);
+    EXPECT_EQ(RTT, estimator.getQuality().rtt);
+    estimator.recordPing(false, RTT * 10);
+    EXPECT_EQ(RTT, estimator.getQuality().rtt);
+    estimator.recordPing(true, RTT * 5);
+    EXPECT_EQ(RTT * 2, estimator.getQuality().rtt);
+}
+
+/**
+ * Test that the throughput is only taken from successful responses large enough to measure it.
+ */
+TEST(NetworkQualityEstimatorTest, throughputFromLargeResponses) {
+    NetworkQualityEstimator estimator;
+    auto bytes = NetworkQualityEstimator::MIN_THROUGHPUT_SAMPLE_BYTES;
+    estimator.recordTransfer(true, bytes - 1, RESPONSE_TIME);
+    estimator.recordTransfer(false, bytes * 10, RESPONSE_TIME);
+    EXPECT_EQ(0u, estimator.getQuality().throughputBytesPerSecond);
+    estimator.recordTransfer(true, bytes, RESPONSE_TIME);
+    EXPECT_EQ(bytes, estimator.getQuality().throughputBytesPerSecond);
+}
+
+/**
+ * Test that the loss rate rises with failures and falls with successes.
+ */
+TEST(NetworkQualityEstimatorTest, lossRate) {
+    NetworkQualityEstimator estimator;
+    estimator.recordTransfer(false, 0, std::chrono::microseconds::zero());
+    estimator.recordPing(false, std::chrono::microseconds::zero());
+    auto lossy = estimator.getQuality().lossRate;
+    EXPECT_GT(lossy, 0.1);
+    for (int i = 0; i < 10; ++i) {
+        estimator.recordPing(true, RTT);
+    }
+    EXPECT_LT(estimator.getQuality().lossRate, lossy / 2);
+}
+
+/**
+ * Test that observers are told about noticeable changes only, and that a new observer is told the current estimate.
+ */
+TEST(NetworkQualityEstimatorTest, observersToldOfNoticeableChanges) {
+    NetworkQualityEstimator estimator;
+    auto observer = std::make_shared<RecordingObserver>();
+    estimator.addObserver(observer);
+    EXPECT_TRUE(observer->qualities.empty());
+
+    estimator.recordPing(true, RTT);
+    ASSERT_EQ(1u, observer->qualities.size());
+    EXPECT_EQ(RTT, observer->qualities.back().rtt);
+    estimator.recordPing(true, RTT + std::chrono::milliseconds(1));
+    EXPECT_EQ(1u, observer->qualities.size());
+    estimator.recordPing(true, RTT * 3);
+    ASSERT_EQ(2u, observer->qualities.size());
+    EXPECT_EQ(estimator.getQuality().rtt, observer->qualities.back().rtt);
+
+    auto lateObserver = std::make_shared<RecordingObserver>();
+    estimator.addObserver(lateObserver);
+    ASSERT_EQ(1u, lateObserver->qualities.size());
+    EXPECT_EQ(estimator.getQuality().rtt, lateObserver->qualities.back().rtt);
+
+    estimator.removeObserver(observer);
+    estimator.recordPing(true, RTT * 20);
+    EXPECT_EQ(2u, observer->qualities.size());
+    EXPECT_EQ(2u, lateObserver->qualities.size());
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,133 @@
+/*
+ * OutboundEventBufferTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file OutboundEventBufferTest.cpp
+
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "ACL/Transport/OutboundEventBuffer.h"
+
+#include "MockMessageRequest.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using ::testing::_;
+
+/// A long time for requests to be held, which tests do not reach.
+static const std::chrono::milliseconds LONG_MAX_AGE(std::chrono::hours(1));
+
+/// A short time for requests to be held, which tests wait for.
+static const std::chrono::milliseconds SHORT_MAX_AGE(20);
+
+/// How long to wait for an expired request to be failed.
+static const std::chrono::milliseconds EXPIRY_TIMEOUT(2000);
+
+/// The JSON content of test requests.
+static const std::string TEST_CONTENT = "0123456789";
+
+/// Room for the JSON content of two test requests.
+static const size_t TWO_REQUESTS_BYTES = 2 * TEST_CONTENT.size();
+
+/**
+ * Test that creating a buffer with no age or no bytes fails.
+ */
+TEST(OutboundEventBufferTest, createWithInvalidBounds) {
+    EXPECT_FALSE(OutboundEventBuffer::create(std::chrono::milliseconds::zero(), TWO_REQUESTS_BYTES));
+    EXPECT_FALSE(OutboundEventBuffer::create(LONG_MAX_AGE, 0));
+}
+
+/**
+ * Test that held requests are released by priority, in the order they were held within a priority, and are not
+ * completed by the buffer.
+ */
+TEST(OutboundEventBufferTest, releaseByPriority) {
+    auto buffer = OutboundEventBuffer::create(LONG_MAX_AGE, 4 * TEST_CONTENT.size());
+    ASSERT_TRUE(buffer);
+    auto low = std::make_shared<MockMessageRequest>(TEST_CONTENT, MessageRequest::Priority::LOW);
+    auto normal1 = std::make_shared<MockMessageRequest>(TEST_CONTENT, MessageRequest::Priority::NORMAL);
+    auto high = std::make_shared<MockMessageRequest>(TEST_CONTENT, MessageRequest::Priority::HIGH);
+    auto normal2 = std::make_shared<MockMessageRequest>(TEST_CONTENT, MessageRequest::Priority::NORMAL);
+    for (auto& request : {low, normal1, high, normal2}) {
+        EXPECT_CALL(*request, sendCompleted(_)).Times(0);
+        ASSERT_TRUE(buffer->hold(request));
+    }
+    ASSERT_EQ(buffer->size(), 4u);
+
+    auto released = buffer->release();
+    ASSERT_EQ(released.size(), 4u);
+    EXPECT_EQ(released[0], high);
+    EXPECT_EQ(released[1], normal1);
+    EXPECT_EQ(released[2], normal2);
+    EXPECT_EQ(released[3], low);
+    EXPECT_EQ(buffer->size(), 0u);
+}
+
+/**
+ * Test that a request which does not fit in the bytes left is refused, and that releasing makes room again.
+ */
+TEST(OutboundEventBufferTest, refuseWhenFull) {
+    auto buffer = OutboundEventBuffer::create(LONG_MAX_AGE, TWO_REQUESTS_BYTES);
+    ASSERT_TRUE(buffer);
+    ASSERT_TRUE(buffer->hold(std::make_shared<MockMessageRequest>(TEST_CONTENT)));
+    ASSERT_TRUE(buffer->hold(std::make_shared<MockMessageRequest>(TEST_CONTENT)));
+    ASSERT_FALSE(buffer->hold(std::make_shared<MockMessageRequest>(TEST_CONTENT)));
+    ASSERT_EQ(buffer->release().size(), 2u);
+    ASSERT_TRUE(buffer->hold(std::make_shared<MockMessageRequest>(TEST_CONTENT)));
+    buffer->release();
+}
+
+/**
+ * Test that a request held longer than the maximum age is failed with @c NOT_CONNECTED, even if it is never released.
+ */
+TEST(OutboundEventBufferTest, expiredRequestsAreFailed) {
+    auto buffer = OutboundEventBuffer::create(SHORT_MAX_AGE, TWO_REQUESTS_BYTES);
+    ASSERT_TRUE(buffer);
+    auto request = std::make_shared<MockMessageRequest>(TEST_CONTENT);
+    std::promise<void> failed;
+    EXPECT_CALL(*request, sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED))
+        .WillOnce(::testing::InvokeWithoutArgs([&failed] { failed.set_value(); }));
+    ASSERT_TRUE(buffer->hold(request));
+    ASSERT_EQ(failed.get_future().wait_for(EXPIRY_TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(buffer->size(), 0u);
+    EXPECT_TRUE(buffer->release().empty());
+}
+
+/**
+ * Test that @c failAll() fails every held request with @c NOT_CONNECTED.
+ */
+TEST(OutboundEventBufferTest, failAll) {
+    auto buffer = OutboundEventBuffer::create(LONG_MAX_AGE, TWO_REQUESTS_BYTES);
+    ASSERT_TRUE(buffer);
+    auto request = std::make_shared<MockMessageRequest>(TEST_CONTENT);
+    EXPECT_CALL(*request, sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED)).Times(1);
+    ASSERT_TRUE(buffer->hold(request));
+    buffer->failAll();
+    EXPECT_EQ(buffer->size(), 0u);
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
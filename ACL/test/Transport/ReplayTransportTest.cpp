@@ -0,0 +1,225 @@
+/*
+ * ReplayTransportTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ReplayTransportTest.cpp
+
+#include <memory>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "ACL/Transport/ReplayTransport.h"
+#include "ACL/Transport/TrafficRecorder.h"
+
+#include "Common/MimeUtils.h"
+#include "Common/TestableAttachmentManager.h"
+#include "Common/TestableMessageObserver.h"
+#include "MockMessageRequest.h"
+#include "TestableConsumer.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::sdkInterfaces;
+
+/// The size of the data for directives and attachments.
+static const int TEST_DATA_SIZE = 100;
+/// The number of chunks each MIME string is recorded in.
+static const int TEST_CHUNKS = 5;
+/// The logical id of the recorded downchannel.
+static const unsigned int DOWNCHANNEL_STREAM_ID = 1;
+/// The logical id of the recorded event response.
+static const unsigned int EVENT_STREAM_ID = 3;
+/// The attachment context id @c ReplayTransport uses for @c EVENT_STREAM_ID.
+static const std::string EVENT_STREAM_CONTEXT_ID = "ACL_REPLAYED_STREAM_ID_3";
+/// A test content id.
+static const std::string TEST_CONTENT_ID = "TEST_CONTENT_ID";
+/// A test boundary string.
+static const std::string MIME_TEST_BOUNDARY_STRING = "84109348-943b-4446-85e6-e73eda9fac43";
+/// How long to wait for a replay.
+static const std::chrono::milliseconds REPLAY_TIMEOUT(5000);
+
+class ReplayTransportTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_attachmentManager = std::make_shared<TestableAttachmentManager>();
+        m_messageObserver = std::make_shared<TestableMessageObserver>();
+        m_consumer = std::make_shared<TestableConsumer>();
+        m_consumer->setMessageObserver(m_messageObserver);
+    }
+
+    /**
+     * Record a MIME string received by a stream, split into @c TEST_CHUNKS chunks.
+     *
+     * @param streamId The logical id of the stream.
+     * @param isDownchannel Whether the stream is the downchannel.
+     * @param mimeString The MIME string.
+     */
+    void recordStream(unsigned int streamId, bool isDownchannel, const std::string& mimeString) {
+        auto& recorder = TrafficRecorder::instance();
+        recorder.recordStreamStart(streamId, isDownchannel, MIME_TEST_BOUNDARY_STRING);
+        size_t chunkSize = mimeString.size() / TEST_CHUNKS + 1;
+        for (size_t offset = 0; offset < mimeString.size(); offset += chunkSize) {
+            recorder.recordData(
+                streamId, isDownchannel, mimeString.data() + offset, std::min(chunkSize, mimeString.size() - offset));
+        }
+    }
+
+    /// The AttachmentManager.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> m_attachmentManager;
+    /// The observer of the messages passed to @c m_consumer.
+    std::shared_ptr<TestableMessageObserver> m_messageObserver;
+    /// The consumer of the replayed messages.
+    std::shared_ptr<TestableConsumer> m_consumer;
+};
+
+/**
+ * Test that nothing is recorded unless a recording is in progress, and that records survive being saved and loaded.
+ */
+TEST_F(ReplayTransportTest, recordSaveAndLoad) {
+    auto& recorder = TrafficRecorder::instance();
+    ASSERT_FALSE(recorder.isRecording());
+    recorder.recordStreamStart(DOWNCHANNEL_STREAM_ID, true, MIME_TEST_BOUNDARY_STRING);
+
+    recorder.start();
+    ASSERT_TRUE(recorder.isRecording());
+    std::string binaryData("a\nb\0c\r\n", 7);
+    recorder.recordStreamStart(EVENT_STREAM_ID, false, MIME_TEST_BOUNDARY_STRING);
+    recorder.recordData(EVENT_STREAM_ID, false, binaryData.data(), binaryData.size());
+    auto records = recorder.stop();
+    ASSERT_FALSE(recorder.isRecording());
+    recorder.recordData(EVENT_STREAM_ID, false, binaryData.data(), binaryData.size());
+
+    ASSERT_EQ(records.size(), 2u);
+    std::stringstream stream;
+    ASSERT_TRUE(TrafficRecorder::save(records, stream));
+    std::vector<TrafficRecorder::Record> loaded;
+    ASSERT_TRUE(TrafficRecorder::load(stream, &loaded));
+    ASSERT_EQ(loaded.size(), records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(loaded[i].type, records[i].type);
+        EXPECT_EQ(loaded[i].streamId, EVENT_STREAM_ID);
+        EXPECT_FALSE(loaded[i].isDownchannel);
+        EXPECT_EQ(loaded[i].offset, records[i].offset);
+        EXPECT_EQ(loaded[i].data, records[i].data);
+    }
+    EXPECT_EQ(loaded[1].data, binaryData);
+
+    std::stringstream truncated(stream.str().substr(0, stream.str().size() - 3));
+    ASSERT_FALSE(TrafficRecorder::load(truncated, &loaded));
+}
+
+/**
+ * Test that a recording of interleaved streams is replayed into directives and attachments.
+ */
+TEST_F(ReplayTransportTest, replayRecordedStreams) {
+    std::vector<std::shared_ptr<TestMimePart>> downchannelParts;
+    downchannelParts.push_back(std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_messageObserver));
+    downchannelParts.push_back(std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_messageObserver));
+    std::vector<std::shared_ptr<TestMimePart>> eventParts;
+    eventParts.push_back(std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_messageObserver));
+    eventParts.push_back(std::make_shared<TestMimeAttachmentPart>(
+        EVENT_STREAM_CONTEXT_ID, TEST_CONTENT_ID, TEST_DATA_SIZE, m_attachmentManager));
+
+    TrafficRecorder::instance().start();
+    recordStream(DOWNCHANNEL_STREAM_ID, true, constructTestMimeString(downchannelParts, MIME_TEST_BOUNDARY_STRING));
+    recordStream(EVENT_STREAM_ID, false, constructTestMimeString(eventParts, MIME_TEST_BOUNDARY_STRING));
+    auto records = TrafficRecorder::instance().stop();
+
+    auto transport = ReplayTransport::create(
+        m_consumer, m_attachmentManager, records, ReplayTransport::Pace::AS_FAST_AS_POSSIBLE);
+    ASSERT_TRUE(transport);
+    ASSERT_TRUE(transport->connect());
+    ASSERT_TRUE(transport->waitUntilReplayed(REPLAY_TIMEOUT));
+    ASSERT_TRUE(transport->isConnected());
+    for (auto& part : downchannelParts) {
+        ASSERT_TRUE(part->validateMimeParsing());
+    }
+    for (auto& part : eventParts) {
+        ASSERT_TRUE(part->validateMimeParsing());
+    }
+    transport->shutdown();
+    ASSERT_FALSE(transport->isConnected());
+}
+
+/**
+ * Test that a real time replay keeps the offsets of the recording.
+ */
+TEST_F(ReplayTransportTest, realTimeReplayKeepsOffsets) {
+    auto part = std::make_shared<TestMimeJsonPart>(TEST_DATA_SIZE, m_messageObserver);
+    auto mimeString = constructTestMimeString({part}, MIME_TEST_BOUNDARY_STRING);
+    const std::chrono::milliseconds lastOffset(200);
+    std::vector<TrafficRecorder::Record> records = {
+        {TrafficRecorder::RecordType::STREAM_START,
+         DOWNCHANNEL_STREAM_ID,
+         true,
+         std::chrono::microseconds::zero(),
+         MIME_TEST_BOUNDARY_STRING},
+        {TrafficRecorder::RecordType::DATA, DOWNCHANNEL_STREAM_ID, true, lastOffset, mimeString}};
+
+    auto transport =
+        ReplayTransport::create(m_consumer, m_attachmentManager, records, ReplayTransport::Pace::REAL_TIME);
+    ASSERT_TRUE(transport);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(transport->connect());
+    ASSERT_TRUE(transport->waitUntilReplayed(REPLAY_TIMEOUT));
+    ASSERT_GE(std::chrono::steady_clock::now() - start, lastOffset);
+    ASSERT_TRUE(part->validateMimeParsing());
+    transport->shutdown();
+}
+
+/**
+ * Test that sends complete without a connection to AVS, and that disconnecting stops a replay.
+ */
+TEST_F(ReplayTransportTest, sendAndDisconnect) {
+    std::vector<TrafficRecorder::Record> records = {{TrafficRecorder::RecordType::STREAM_START,
+                                                     DOWNCHANNEL_STREAM_ID,
+                                                     true,
+                                                     std::chrono::microseconds::zero(),
+                                                     MIME_TEST_BOUNDARY_STRING},
+                                                    {TrafficRecorder::RecordType::DATA,
+                                                     DOWNCHANNEL_STREAM_ID,
+                                                     true,
+                                                     std::chrono::hours(1),
+                                                     "unreachable"}};
+    auto transport =
+        ReplayTransport::create(m_consumer, m_attachmentManager, records, ReplayTransport::Pace::REAL_TIME);
+    ASSERT_TRUE(transport);
+
+    auto request = std::make_shared<MockMessageRequest>();
+    EXPECT_CALL(*request, sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED));
+    transport->send(request);
+
+    ASSERT_TRUE(transport->connect());
+    while (!transport->isConnected()) {
+        std::this_thread::yield();
+    }
+    request = std::make_shared<MockMessageRequest>();
+    EXPECT_CALL(*request, sendCompleted(MessageRequestObserverInterface::Status::SUCCESS));
+    transport->send(request);
+
+    transport->disconnect();
+    ASSERT_FALSE(transport->isConnected());
+    ASSERT_FALSE(transport->waitUntilReplayed(std::chrono::milliseconds::zero()));
+    ASSERT_FALSE(transport->connect());
+    transport->shutdown();
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,97 @@
+/*
+ * TransferMetricsTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file TransferMetricsTest.cpp
+
+#include <gtest/gtest.h>
+
+#include "ACL/Transport/TransferMetrics.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::sdkInterfaces;
+
+/**
+ * Make the timing of a transfer in which each phase takes a millisecond longer than the one before.
+ *
+ * @param firstPhase The time of the first phase.
+ * @return The timing of the transfer.
+ */
+static MessageRequestObserverInterface::TransferTimings makeTimings(std::chrono::microseconds firstPhase) {
+    MessageRequestObserverInterface::TransferTimings timings;
+    timings.queueWait = firstPhase;
+    timings.firstUploadByte = firstPhase + std::chrono::milliseconds(1);
+    timings.uploadComplete = firstPhase + std::chrono::milliseconds(2);
+    timings.firstResponseByte = firstPhase + std::chrono::milliseconds(3);
+    timings.responseComplete = firstPhase + std::chrono::milliseconds(4);
+    return timings;
+}
+
+/**
+ * Test that nothing is summarized before any transfer is recorded.
+ */
+TEST(TransferMetricsTest, emptySummaries) {
+    TransferMetrics metrics;
+    EXPECT_TRUE(metrics.getSummaries().empty());
+}
+
+/**
+ * Test that the phases of the transfers of each kind of stream are summarized separately, in order.
+ */
+TEST(TransferMetricsTest, summariesByStreamTypeAndPhase) {
+    TransferMetrics metrics;
+    metrics.record(TransferMetrics::StreamType::PING, makeTimings(std::chrono::microseconds(10)));
+    metrics.record(TransferMetrics::StreamType::EVENT, makeTimings(std::chrono::microseconds(10)));
+    metrics.record(TransferMetrics::StreamType::EVENT, makeTimings(std::chrono::microseconds(20)));
+
+    auto summaries = metrics.getSummaries();
+    ASSERT_EQ(summaries.size(), 2 * TransferMetrics::NUM_PHASES);
+    for (size_t phase = 0; phase < TransferMetrics::NUM_PHASES; ++phase) {
+        const auto& event = summaries[phase];
+        EXPECT_EQ(event.streamType, TransferMetrics::StreamType::EVENT);
+        EXPECT_EQ(event.phase, static_cast<TransferMetrics::Phase>(phase));
+        EXPECT_EQ(event.count, 2u);
+        const auto& ping = summaries[TransferMetrics::NUM_PHASES + phase];
+        EXPECT_EQ(ping.streamType, TransferMetrics::StreamType::PING);
+        EXPECT_EQ(ping.count, 1u);
+    }
+    EXPECT_EQ(summaries[0].max, std::chrono::microseconds(20));
+}
+
+/**
+ * Test that phases which were not reached are not counted, and that resetting forgets what was counted.
+ */
+TEST(TransferMetricsTest, unreachedPhasesAndReset) {
+    TransferMetrics metrics;
+    MessageRequestObserverInterface::TransferTimings timings;
+    timings.firstResponseByte = std::chrono::milliseconds(5);
+    metrics.record(TransferMetrics::StreamType::DOWNCHANNEL, timings);
+
+    auto summaries = metrics.getSummaries();
+    ASSERT_EQ(summaries.size(), 1u);
+    EXPECT_EQ(summaries[0].streamType, TransferMetrics::StreamType::DOWNCHANNEL);
+    EXPECT_EQ(summaries[0].phase, TransferMetrics::Phase::FIRST_RESPONSE_BYTE);
+
+    metrics.reset();
+    EXPECT_TRUE(metrics.getSummaries().empty());
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
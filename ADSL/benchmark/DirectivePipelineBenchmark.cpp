@@ -0,0 +1,348 @@
+/*
+ * DirectivePipelineBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DirectivePipelineBenchmark.cpp
+///
+/// Measures the throughput and per-stage latency of the directive pipeline.  Synthetic directives are passed as JSON
+/// to a @c MessageInterpreter, and go through the @c DirectiveSequencer, @c DirectiveProcessor and
+/// @c DirectiveRouter to handlers which complete them on executors of their own, as capability agents do.  Each
+/// scenario is a mix of handlers, each with a @c BlockingPolicy and a time it takes to handle a directive, and the
+/// directives are spread evenly over the handlers.
+///
+/// Throughput is reported in directives per second.  Per-stage latencies come from @c DirectiveLatencyTracker, and
+/// are measured from the directive being passed to the @c DirectiveSequencer.  At most @c WINDOW directives are in the
+/// pipeline at once, as the downchannel would never deliver an unbounded burst.
+///
+/// Usage: DirectivePipelineBenchmark [--quick]
+
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/SDKInterfaces/DirectiveHandlerInterface.h>
+#include <AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+#include "ADSL/DirectiveSequencer.h"
+#include "ADSL/MessageInterpreter.h"
+
+namespace alexaClientSDK {
+namespace adsl {
+namespace benchmark {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::metrics;
+
+using Clock = std::chrono::steady_clock;
+
+/// The namespace of the synthetic directives.
+static const std::string NAMESPACE = "Benchmark";
+
+/// The dialogRequestId of the synthetic directives.
+static const std::string DIALOG_REQUEST_ID = "BenchmarkDialog";
+
+/// The largest number of directives in the pipeline at once.
+static const int WINDOW = 128;
+
+/// The stages to report, in the order they are reported.
+static const DirectiveLatencyTracker::Stage REPORTED_STAGES[] = {DirectiveLatencyTracker::Stage::ADSL_DEQUEUE,
+                                                                 DirectiveLatencyTracker::Stage::PRE_HANDLE,
+                                                                 DirectiveLatencyTracker::Stage::HANDLE_START,
+                                                                 DirectiveLatencyTracker::Stage::COMPLETED};
+
+/// A handler in a scenario.
+struct HandlerSpec {
+    /// The blocking policy of the handler's directives.
+    BlockingPolicy policy;
+
+    /// How long the handler takes to handle a directive.
+    std::chrono::microseconds handleTime;
+};
+
+/// A mix of handlers to benchmark.
+struct Scenario {
+    /// The name printed for the scenario.
+    std::string name;
+
+    /// The handlers.
+    std::vector<HandlerSpec> handlers;
+
+    /// Whether the @c DirectiveSequencer uses a lane per handler.
+    bool useHandlerLanes;
+};
+
+/**
+ * Counts the directives which have finished, and lets the feeding thread wait until few enough are in the pipeline.
+ */
+class CompletionCounter {
+public:
+    /// Constructor.
+    CompletionCounter() : m_finished{0} {
+    }
+
+    /// Record that a directive has finished.
+    void onFinished() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_finished;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Wait until at least @c count directives have finished.
+     *
+     * @param count The number of directives to wait for.
+     */
+    void waitFor(int count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeTrigger.wait(lock, [this, count]() { return m_finished >= count; });
+    }
+
+private:
+    /// Serializes access to @c m_finished.
+    std::mutex m_mutex;
+
+    /// Notified when a directive finishes.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of directives which have finished.
+    int m_finished;
+};
+
+/**
+ * A handler which completes each directive on its own executor after a fixed handling time.
+ */
+class BenchmarkHandler : public DirectiveHandlerInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param name The name of the directives this handler handles.
+     * @param spec The policy and handling time of the handler.
+     * @param counter The counter to tell when a directive has finished.
+     */
+    BenchmarkHandler(const std::string& name, const HandlerSpec& spec, CompletionCounter* counter) :
+            m_name{name},
+            m_spec(spec),
+            m_counter{counter} {
+    }
+
+    void handleDirectiveImmediately(std::shared_ptr<AVSDirective> directive) override {
+        m_counter->onFinished();
+    }
+
+    void preHandleDirective(
+        std::shared_ptr<AVSDirective> directive,
+        std::unique_ptr<DirectiveHandlerResultInterface> result) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results[directive->getMessageId()] = std::move(result);
+    }
+
+    bool handleDirective(const std::string& messageId) override {
+        std::shared_ptr<DirectiveHandlerResultInterface> result;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_results.find(messageId);
+            if (m_results.end() == it) {
+                return false;
+            }
+            result = std::move(it->second);
+            m_results.erase(it);
+        }
+        m_executor.submit([this, result]() {
+            if (m_spec.handleTime > std::chrono::microseconds::zero()) {
+                std::this_thread::sleep_for(m_spec.handleTime);
+            }
+            result->setCompleted();
+            m_counter->onFinished();
+        });
+        return true;
+    }
+
+    void cancelDirective(const std::string& messageId) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_results.erase(messageId);
+        }
+        m_counter->onFinished();
+    }
+
+    void onDeregistered() override {
+    }
+
+    DirectiveHandlerConfiguration getConfiguration() const override {
+        return {{NamespaceAndName{NAMESPACE, m_name}, m_spec.policy}};
+    }
+
+private:
+    /// The name of the directives this handler handles.
+    const std::string m_name;
+
+    /// The policy and handling time of the handler.
+    const HandlerSpec m_spec;
+
+    /// The counter to tell when a directive has finished.
+    CompletionCounter* m_counter;
+
+    /// Serializes access to @c m_results.
+    std::mutex m_mutex;
+
+    /// The results of the directives which have been pre-handled, by messageId.
+    std::unordered_map<std::string, std::unique_ptr<DirectiveHandlerResultInterface>> m_results;
+
+    /// The executor completing directives.
+    avsCommon::utils::threading::Executor m_executor;
+};
+
+/**
+ * An @c ExceptionEncounteredSenderInterface which reports exceptions on the console.
+ */
+class ExceptionSender : public ExceptionEncounteredSenderInterface {
+public:
+    void sendExceptionEncountered(
+        const std::string& unparsedDirective,
+        ExceptionErrorType error,
+        const std::string& errorDescription) override {
+        std::cerr << "exception encountered: " << errorDescription << std::endl;
+    }
+};
+
+/**
+ * Build the JSON of a synthetic directive.
+ *
+ * @param name The name of the directive.
+ * @param messageId The messageId of the directive.
+ * @return The JSON of the directive.
+ */
+static std::string buildDirective(const std::string& name, const std::string& messageId) {
+    return "{\"directive\":{\"header\":{\"namespace\":\"" + NAMESPACE + "\",\"name\":\"" + name +
+           "\",\"messageId\":\"" + messageId + "\",\"dialogRequestId\":\"" + DIALOG_REQUEST_ID +
+           "\"},\"payload\":{\"url\":\"cid:benchmark\",\"token\":\"" + messageId + "\"}}}";
+}
+
+/**
+ * Run one scenario and print its results.
+ *
+ * @param scenario The scenario to run.
+ * @param numDirectives The number of directives to pass through the pipeline.
+ */
+static void run(const Scenario& scenario, int numDirectives) {
+    CompletionCounter counter;
+    auto exceptionSender = std::make_shared<ExceptionSender>();
+    auto sequencer = DirectiveSequencer::create(exceptionSender, scenario.useHandlerLanes);
+    std::shared_ptr<DirectiveSequencerInterface> sharedSequencer = std::move(sequencer);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < scenario.handlers.size(); ++i) {
+        names.push_back("Directive" + std::to_string(i));
+        sharedSequencer->addDirectiveHandler(
+            std::make_shared<BenchmarkHandler>(names.back(), scenario.handlers[i], &counter));
+    }
+    sharedSequencer->setDialogRequestId(DIALOG_REQUEST_ID);
+    MessageInterpreter interpreter(
+        exceptionSender,
+        sharedSequencer,
+        std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS));
+
+    std::vector<std::string> directives;
+    directives.reserve(numDirectives);
+    for (int i = 0; i < numDirectives; ++i) {
+        directives.push_back(buildDirective(names[i % names.size()], "message" + std::to_string(i)));
+    }
+
+    DirectiveLatencyTracker::instance().reset();
+    DirectiveLatencyTracker::instance().setEnabled(true);
+    auto start = Clock::now();
+    for (int i = 0; i < numDirectives; ++i) {
+        counter.waitFor(i - WINDOW);
+        interpreter.receive("", directives[i]);
+    }
+    counter.waitFor(numDirectives);
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+    DirectiveLatencyTracker::instance().setEnabled(false);
+    sharedSequencer->shutdown();
+
+    std::cout << std::left << std::setw(36) << scenario.name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(0) << numDirectives / elapsed.count();
+    auto summaries = DirectiveLatencyTracker::instance().getSummaries();
+    for (auto stage : REPORTED_STAGES) {
+        std::chrono::microseconds p50{0}, p99{0};
+        for (const auto& summary : summaries) {
+            if (summary.stage == stage) {
+                p50 = summary.p50;
+                p99 = summary.p99;
+            }
+        }
+        std::cout << std::setw(9) << p50.count() << std::setw(9) << p99.count();
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Run every scenario and print a table of results.
+ *
+ * @param isQuick Whether to pass fewer directives through each scenario.
+ */
+static void runAll(bool isQuick) {
+    const int numDirectives = isQuick ? 2000 : 20000;
+    const HandlerSpec fastNonBlocking = {BlockingPolicy::NON_BLOCKING, std::chrono::microseconds::zero()};
+    const HandlerSpec fastBlocking = {BlockingPolicy::BLOCKING, std::chrono::microseconds::zero()};
+    const HandlerSpec slowNonBlocking = {BlockingPolicy::NON_BLOCKING, std::chrono::microseconds(200)};
+    const HandlerSpec slowBlocking = {BlockingPolicy::BLOCKING, std::chrono::microseconds(200)};
+    std::vector<Scenario> scenarios = {
+        {"4 NON_BLOCKING", {fastNonBlocking, fastNonBlocking, fastNonBlocking, fastNonBlocking}, false},
+        {"4 BLOCKING", {fastBlocking, fastBlocking, fastBlocking, fastBlocking}, false},
+        {"1 BLOCKING + 3 NON_BLOCKING", {fastBlocking, fastNonBlocking, fastNonBlocking, fastNonBlocking}, false},
+        {"1 slow BLOCKING + 3 NON_BLOCKING", {slowBlocking, fastNonBlocking, fastNonBlocking, fastNonBlocking}, false},
+        {"1 slow NON_BLOCKING + 3 NON_BLOCKING",
+         {slowNonBlocking, fastNonBlocking, fastNonBlocking, fastNonBlocking},
+         false},
+        {"  ... with handler lanes", {slowNonBlocking, fastNonBlocking, fastNonBlocking, fastNonBlocking}, true}};
+
+    std::cout << "Stage latencies are p50 and p99, in microseconds after ADSL_ENQUEUE." << std::endl;
+    std::cout << std::left << std::setw(36) << "scenario" << std::right << std::setw(12) << "directives/s";
+    for (auto stage : REPORTED_STAGES) {
+        std::cout << std::setw(18) << DirectiveLatencyTracker::stageToString(stage);
+    }
+    std::cout << std::endl;
+    for (const auto& scenario : scenarios) {
+        run(scenario, numDirectives);
+    }
+}
+
+}  // namespace benchmark
+}  // namespace adsl
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    bool isQuick = (argc > 1 && std::string("--quick") == argv[1]);
+    // Per-directive logging would dominate the measurements.
+    alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_SINK_LOGGER().setLevel(
+        alexaClientSDK::avsCommon::utils::logger::Level::WARN);
+    alexaClientSDK::adsl::benchmark::runAll(isQuick);
+    return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 #ifndef ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVE_PROCESSOR_H_
 #define ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVE_PROCESSOR_H_
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <memory>
@@ -25,9 +26,13 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <AVSCommon/AVS/AVSDirective.h>
 #include <AVSCommon/SDKInterfaces/DirectiveHandlerInterface.h>
+#include <AVSCommon/Utils/Threading/AdaptiveSpinWait.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
 
 #include "ADSL/DirectiveRouter.h"
 
@@ -58,6 +63,12 @@ namespace adsl {
  * @c BLOCKING @c AVSDirective indicates that handling has completed or failed. Otherwise handleDirective() is
  * invoked, the @c AVSDirective is popped from the front of the queue, and processing of queued @c AVSDirective's
  * continues.
+ * @par
+ * By default @c handleDirective() is called on the processing thread, so a handler which is slow to return holds up
+ * every directive queued behind it.  A @c DirectiveProcessor created with handler lanes instead calls
+ * @c handleDirective() on a lane (an @c Executor) of the handler's own.  A @c NON_BLOCKING directive is popped as soon
+ * as it has been passed to its lane, so that directives for other handlers run concurrently with it.  A @c BLOCKING
+ * directive still holds up the queue until it is handled, and lanes keep each handler's directives in order.
  */
 class DirectiveProcessor {
 public:
@@ -65,8 +76,10 @@ public:
      * Constructor.
      *
      * @param directiveRouter An object used to route directives to their registered handler.
+     * @param useHandlerLanes Whether to call @c handleDirective() on a lane per handler rather than on the
+     * processing thread.
      */
-    DirectiveProcessor(DirectiveRouter* directiveRouter);
+    DirectiveProcessor(DirectiveRouter* directiveRouter, bool useHandlerLanes = false);
 
     /**
      * Destructor.
@@ -89,6 +102,14 @@ public:
      */
     bool onDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
 
+    /**
+     * Set how long the processing thread, and the lanes which have their own threads, spin for the next directive
+     * before they block.  Spinning is off by default.
+     *
+     * @param maxSpin The longest time to spin for.  Zero disables spinning.
+     */
+    void setMaxSpin(std::chrono::microseconds maxSpin);
+
     /**
      * Shut down the DirectiveProcessor.  This queues all outstanding @c AVSDirectives for cancellation and
      * blocks until the processing of all @c AVSDirectives has completed.
@@ -97,7 +118,7 @@ public:
 
 private:
     /**
-     * Handle used to identify @c DirectiveProcessor instances referenced by @c DirectiveHandlerResult.
+     * Handle used to reach a @c DirectiveProcessor instance from the @c DirectiveHandlerResults it creates.
      *
      * Handles are used instead of a pointers to decouple the lifecycle of @c DirectiveProcessors from the lifecycle
      * of @c DirectiveHandlerInterface instances.  In the case that a DirectiveHandler outlives the
@@ -105,11 +126,25 @@ private:
      * of the @c DirectiveProcessor.  Using a handle instead of a pointer allows delivery of the completion / failure
      * notification to be dropped gracefully if the @c DirectiveProcessor is no longer there to receive it.
      *
-     * @c ProcessorHandle values are mapped to @c DirectiveProcessor instances by the static @c m_handleMap.
-     * The delivery of completion notifications by @c DirectiveHandlerResult and changes to @c m_handleMap
-     * are serialized with the static @c m_handleMapMutex.
+     * Each @c DirectiveProcessor owns its handle, and each @c DirectiveHandlerResult holds a @c std::weak_ptr to it,
+     * so delivering a notification involves no state shared between @c DirectiveProcessors.  The delivery of
+     * notifications and the detaching of the @c DirectiveProcessor from its handle on shutdown are serialized with
+     * the handle's own mutex.
      */
-    using ProcessorHandle = unsigned int;
+    struct ProcessorHandle {
+        /**
+         * Constructor.
+         *
+         * @param processor The @c DirectiveProcessor to forward notifications to.
+         */
+        explicit ProcessorHandle(DirectiveProcessor* processor);
+
+        /// Serializes the delivery of notifications with the detaching of @c processor.
+        std::mutex mutex;
+
+        /// The @c DirectiveProcessor to forward notifications to, or @c nullptr once it has shut down.
+        DirectiveProcessor* processor;
+    };
 
     /**
      * Implementation of @c DirectiveHandlerResultInterface that forwards the completion / failure status
@@ -124,7 +159,7 @@ private:
          * @param directive The @c AVSDirective whose handling result will be specified by this instance.
          */
         DirectiveHandlerResult(
-            ProcessorHandle processorHandle,
+            std::weak_ptr<ProcessorHandle> processorHandle,
             std::shared_ptr<avsCommon::avs::AVSDirective> directive);
 
         void setCompleted() override;
@@ -133,7 +168,7 @@ private:
 
     private:
         /// Handle of the @c DirectiveProcessor to forward notifications to.
-        ProcessorHandle m_processorHandle;
+        std::weak_ptr<ProcessorHandle> m_processorHandle;
 
         /// The @c AVSDirective whose handling result will be specified by this instance.
         std::shared_ptr<avsCommon::avs::AVSDirective> m_directive;
@@ -162,6 +197,22 @@ private:
      */
     void removeDirectiveLocked(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
 
+    /**
+     * Add an @c AVSDirective waiting in @c m_handlingQueue or on a lane to @c m_queuedDirectivesByDialogRequestId.
+     * @note This method must only be called by threads that have acquired @c m_mutex.
+     *
+     * @param directive The @c AVSDirective to index.
+     */
+    void indexDirectiveLocked(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
+    /**
+     * Remove an @c AVSDirective from @c m_queuedDirectivesByDialogRequestId.
+     * @note This method must only be called by threads that have acquired @c m_mutex.
+     *
+     * @param directive The @c AVSDirective to remove from the index.
+     */
+    void unindexDirectiveLocked(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
     /**
      * Thread method for m_processingThread.
      */
@@ -187,6 +238,23 @@ private:
      */
     bool handleDirectiveLocked(std::unique_lock<std::mutex>& lock);
 
+    /**
+     * Get the lane on which the directives of a handler are handled, creating it if needed.
+     * @note This method must only be called by threads that have acquired @c m_mutex.
+     *
+     * @param handler The handler.
+     * @return The lane of the handler.
+     */
+    avsCommon::utils::threading::Executor* getLaneLocked(avsCommon::sdkInterfaces::DirectiveHandlerInterface* handler);
+
+    /**
+     * Handle a @c NON_BLOCKING @c AVSDirective which was passed to a lane, unless it has been canceled since.  Called
+     * on the lane.
+     *
+     * @param directive The @c AVSDirective to handle.
+     */
+    void handleDirectiveOnLane(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
     /**
      * Set the current @c dialogRequestId. This cancels the processing of any @c AVSDirectives with a non-empty
      * dialogRequestId.
@@ -212,8 +280,8 @@ private:
      */
     void queueAllDirectivesForCancellationLocked();
 
-    /// Handle value identifying this instance.
-    int m_handle;
+    /// Handle through which @c DirectiveHandlerResults reach this instance.
+    std::shared_ptr<ProcessorHandle> m_handle;
 
     /// A mutex used to serialize @c DirectiveProcessor operations with operations that occur in the creating context.
     std::mutex m_mutex;
@@ -228,7 +296,7 @@ private:
     std::string m_dialogRequestId;
 
     /// Queue of @c AVSDirectives waiting to be canceled.
-    std::deque<std::shared_ptr<avsCommon::avs::AVSDirective>> m_cancelingQueue;
+    std::vector<std::shared_ptr<avsCommon::avs::AVSDirective>> m_cancelingQueue;
 
     /// The directive (if any) for which a preHandleDirective() call is in progress.
     std::shared_ptr<avsCommon::avs::AVSDirective> m_directiveBeingPreHandled;
@@ -239,6 +307,28 @@ private:
     /// Whether @c handleDirective() has been called for the directive at the @c front() of @c m_handlingQueue.
     bool m_isHandlingDirective;
 
+    /// Whether @c handleDirective() is called on a lane per handler.
+    const bool m_useHandlerLanes;
+
+    /// The lane of each handler which has been given a directive, if @c m_useHandlerLanes.
+    std::unordered_map<
+        avsCommon::sdkInterfaces::DirectiveHandlerInterface*,
+        std::unique_ptr<avsCommon::utils::threading::Executor>>
+        m_lanes;
+
+    /// @c NON_BLOCKING directives which have been passed to a lane and whose @c handleDirective() has not started.
+    std::unordered_set<std::shared_ptr<avsCommon::avs::AVSDirective>> m_directivesOnLanes;
+
+    /**
+     * The directives in @c m_handlingQueue and @c m_directivesOnLanes with a non-empty @c dialogRequestId, by
+     * @c dialogRequestId, so that scrubbing a @c dialogRequestId need not scan the queues for it.
+     */
+    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<avsCommon::avs::AVSDirective>>>
+        m_queuedDirectivesByDialogRequestId;
+
+    /// Spins for work in @c processingLoop() before it waits on @c m_wakeProcessingLoop.
+    avsCommon::utils::threading::AdaptiveSpinWait m_spinWait;
+
     /// Condition variable used to wake @c processingLoop() when it is waiting.
     std::condition_variable m_wakeProcessingLoop;
 
@@ -247,18 +337,6 @@ private:
 
     /// Mutex serializing the body of @ onDirective() to make the method thread-safe.
     std::mutex m_onDirectiveMutex;
-
-    /// Mutex to serialize access to @c m_handleMap;
-    static std::mutex m_handleMapMutex;
-
-    /**
-     * Map from @c ProcessorHandle value to @c DirectiveProcessor instance to allow for gracefully dropping a
-     * completion (or failure) notification forwarded to the @c DirectiveProcessor during or after its destruction.
-     */
-    static std::unordered_map<ProcessorHandle, DirectiveProcessor*> m_handleMap;
-
-    /// Next available @c ProcessorHandle value.
-    static ProcessorHandle m_nextProcessorHandle;
 };
 
 }  // namespace adsl
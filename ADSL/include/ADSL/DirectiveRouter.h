@@ -18,8 +18,11 @@
 #ifndef ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVE_ROUTER_H_
 #define ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVE_ROUTER_H_
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <AVSCommon/AVS/NamespaceAndName.h>
 #include <AVSCommon/AVS/DirectiveHandlerConfiguration.h>
@@ -37,6 +40,9 @@ public:
     /// Constructor.
     DirectiveRouter();
 
+    /// Destructor.
+    ~DirectiveRouter();
+
     /**
      * Add mappings from from handler's @c NamespaceAndName values to @c BlockingPolicy values, gotten through the
      * handler's getConfiguration() method. If a mapping for any of the specified @c NamespaceAndName values already
@@ -57,6 +63,15 @@ public:
      */
     bool removeDirectiveHandler(std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> handler);
 
+    /**
+     * Compile the handlers added so far into an immutable routing table.  Once frozen, directives are routed without
+     * acquiring @c m_mutex or counting references on each call, and handlers can no longer be added or removed.
+     * The handlers are deregistered when the router is shut down.
+     *
+     * @return Whether the routing table was frozen.
+     */
+    bool freeze();
+
     /**
      * Invoke @c handleDirectiveImmediately() on the handler registered for the given @c AVSDirective.
      *
@@ -90,6 +105,14 @@ public:
         std::shared_ptr<avsCommon::avs::AVSDirective> directive,
         avsCommon::avs::BlockingPolicy* policyOut);
 
+    /**
+     * Look up the handler registered for the given @c AVSDirective, and the @c BlockingPolicy it was registered with.
+     *
+     * @param directive The directive to look up.
+     * @return The @c HandlerAndPolicy registered for the directive, which is empty if there is none.
+     */
+    avsCommon::avs::HandlerAndPolicy getHandlerAndPolicy(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
     /**
      * Invoke cancelDirective() on the handler registered for the given @c AVSDirective.
      *
@@ -98,9 +121,54 @@ public:
      */
     bool cancelDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
 
+    /**
+     * Invoke cancelDirective() on the handler registered for each of the given @c AVSDirectives.  The routing
+     * table is looked up once for the whole batch rather than once per directive.
+     *
+     * @param directives The directives to be canceled.
+     * @return The number of directives whose handler was invoked.
+     */
+    size_t cancelDirectives(const std::vector<std::shared_ptr<avsCommon::avs::AVSDirective>>& directives);
+
 private:
     void doShutdown() override;
 
+    /// A perfect-hashed, immutable copy of @c m_configuration.  Defined in the .cpp file.
+    class RoutingTable;
+
+    /**
+     * The lifecycle of instances of this class marks a call which may use the frozen routing table.  While any
+     * instance exists, @c doShutdown() does not deregister the handlers of the frozen routing table.
+     */
+    class FrozenCallScope {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param router The @c DirectiveRouter instance the will make the call.
+         */
+        FrozenCallScope(DirectiveRouter* router);
+
+        /**
+         * Destructor.
+         */
+        ~FrozenCallScope();
+
+        /**
+         * Get the frozen routing table.
+         *
+         * @return The frozen routing table, or @c nullptr if the router is not frozen.
+         */
+        const RoutingTable* getTable() const;
+
+    private:
+        /// The @c DirectiveRouter instance the will make the call.
+        DirectiveRouter* m_router;
+
+        /// The frozen routing table, or @c nullptr.
+        const RoutingTable* m_table;
+    };
+
     /**
      * The lifecycle of instances of this class are used to set-up and tear-down around a call to a
      * @c DirectiveHandlerInterface method.  In particular, while instantiated it increments the reference count of
@@ -113,7 +181,8 @@ private:
         /**
          * Constructor.
          * @note This constructor must only be called by threads that have acquired @c m_mutex.  When this constructor
-         * exits @c m_mutex will be unlocked.
+         * exits @c m_mutex will be unlocked.  If @c lock does not own @c m_mutex, because the handler was found in
+         * the frozen routing table, the scope does nothing.
          *
          * @param lock The @c std::unique_lock to use to release and re-acquire @c m_mutex.
          * @param router The @c DirectiveRouter instance the will make the call.
@@ -151,6 +220,32 @@ private:
      */
     avsCommon::avs::HandlerAndPolicy getHandlerAndPolicyLocked(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
 
+    /**
+     * Look up the @c HandlerAndPolicy value for the specified @c AVSDirective in the frozen routing table if there is
+     * one, or else in @c m_configuration after acquiring @c m_mutex.
+     *
+     * @param frozenScope The scope of the call, giving the frozen routing table.
+     * @param lock A @c std::unique_lock on @c m_mutex which does not own it.  It is locked if there is no frozen
+     * routing table.
+     * @param directive The directive to look up a value for.
+     * @return The corresponding @c HandlerAndPolicy value for the specified directive.
+     */
+    avsCommon::avs::HandlerAndPolicy lookUpHandlerAndPolicy(
+        const FrozenCallScope& frozenScope,
+        std::unique_lock<std::mutex>& lock,
+        std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
+    /**
+     * Invoke cancelDirective() on the handler registered for the given @c AVSDirective, within the scope of a call.
+     *
+     * @param frozenScope The scope of the call, giving the frozen routing table.
+     * @param directive The directive to be canceled.
+     * @return Whether or not the handler was invoked.
+     */
+    bool cancelDirectiveInScope(
+        const FrozenCallScope& frozenScope,
+        std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
     /**
      * Increment the reference count for the specified handler.
      *
@@ -197,6 +292,15 @@ private:
      */
     std::unordered_map<std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface>, int>
         m_handlerReferenceCounts;
+
+    /// The routing table built by @c freeze(), which is kept until destruction so that it may be read without locks.
+    std::unique_ptr<const RoutingTable> m_routingTable;
+
+    /// The published routing table, or @c nullptr if the router is not frozen or has been shut down.
+    std::atomic<const RoutingTable*> m_frozenTable;
+
+    /// The number of @c FrozenCallScope instances in existence.
+    std::atomic<int> m_numFrozenCalls;
 };
 
 }  // namespace adsl
@@ -18,6 +18,7 @@
 #ifndef ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVE_SEQUENCER_H_
 #define ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVE_SEQUENCER_H_
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <memory>
@@ -26,6 +27,7 @@
 
 #include <AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h>
 #include <AVSCommon/SDKInterfaces/DirectiveSequencerInterface.h>
+#include <AVSCommon/Utils/Threading/AdaptiveSpinWait.h>
 
 #include "ADSL/DirectiveProcessor.h"
 #include "ADSL/DirectiveRouter.h"
@@ -43,15 +45,23 @@ public:
      *
      * @param exceptionSender An instance of the @c ExceptionEncounteredSenderInterface used to send
      * ExceptionEncountered messages to AVS for directives that are not handled.
+     * @param useHandlerLanes Whether directives are handled on a lane per handler, so that a handler which is slow to
+     * handle a @c NON_BLOCKING directive does not hold up the directives of other handlers.
+     * @param maxSpin How long the threads which receive and process directives spin for the next one before they
+     * block, which shortens the handoff of each directive at the cost of some CPU.  Zero disables spinning.
      * @return Returns a new DirectiveSequencer, or nullptr if the operation failed.
      */
     static std::unique_ptr<DirectiveSequencerInterface> create(
-        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender);
+        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+        bool useHandlerLanes = false,
+        std::chrono::microseconds maxSpin = std::chrono::microseconds::zero());
 
     bool addDirectiveHandler(std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> handler) override;
 
     bool removeDirectiveHandler(std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> handler) override;
 
+    bool freezeDirectiveHandlers() override;
+
     void setDialogRequestId(const std::string& dialogRequestId) override;
 
     bool onDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive) override;
@@ -62,8 +72,13 @@ private:
      *
      * @param exceptionSender An instance of the @c ExceptionEncounteredSenderInterface used to send
      * ExceptionEncountered messages to AVS for directives that are not handled.
+     * @param useHandlerLanes Whether directives are handled on a lane per handler.
+     * @param maxSpin How long to spin for the next directive before blocking, or zero.
      */
-    DirectiveSequencer(std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender);
+    DirectiveSequencer(
+        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+        bool useHandlerLanes,
+        std::chrono::microseconds maxSpin);
 
     /**
      * @copydoc
@@ -86,6 +101,14 @@ private:
      */
     void receiveDirectiveLocked(std::unique_lock<std::mutex>& lock);
 
+    /**
+     * Hand a directive to @c m_directiveProcessor, or to @c m_directiveRouter if it must be handled immediately, and
+     * send an ExceptionEncountered message if it is not handled.  Called without @c m_mutex held.
+     *
+     * @param directive The directive.
+     */
+    void receiveDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
     /// Serializes access to data members (besides m_directiveRouter and m_directiveProcessor).
     std::mutex m_mutex;
 
@@ -95,6 +118,12 @@ private:
     /// Whether or not the @c DirectiveReceiver is shutting down.
     bool m_isShuttingDown;
 
+    /// Whether a directive is being received, either by @c m_receivingThread or by the thread calling @c onDirective().
+    bool m_isReceiving;
+
+    /// The dialogRequestId last passed to @c setDialogRequestId().
+    std::string m_dialogRequestId;
+
     /// Object used to route directives to their assigned handler.
     DirectiveRouter m_directiveRouter;
 
@@ -104,7 +133,10 @@ private:
     /// Queue of @c AVSDirectives waiting to be received.
     std::deque<std::shared_ptr<avsCommon::avs::AVSDirective>> m_receivingQueue;
 
-    /// Condition variable used to wake m_receivingLoop when waiting.
+    /// Spins for the next directive in @c receivingLoop() before it waits on @c m_wakeReceivingLoop.
+    avsCommon::utils::threading::AdaptiveSpinWait m_spinWait;
+
+    /// Condition variable notified when @c m_receivingQueue or @c m_isReceiving change.
     std::condition_variable m_wakeReceivingLoop;
 
     /// Thread to receive directives.
@@ -0,0 +1,135 @@
+/*
+ * MessageIdFilter.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_MESSAGE_ID_FILTER_H_
+#define ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_MESSAGE_ID_FILTER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <AVSCommon/Utils/Timing/Clock.h>
+
+namespace alexaClientSDK {
+namespace adsl {
+
+/**
+ * Remembers the messageIds of recent directives, so that a directive delivered twice, as can happen after a reconnect
+ * or a retry by the server, is recognized and dropped before it is routed and handled a second time.
+ *
+ * At most @c capacity messageIds are remembered, each for at most @c ttl after it was last seen; the least recently
+ * seen are forgotten first.  A duplicate which arrives after its messageId is forgotten is not recognized.
+ *
+ * This class is thread-safe.
+ */
+class MessageIdFilter {
+public:
+    /// The default number of messageIds remembered.
+    static const size_t DEFAULT_CAPACITY;
+
+    /// The default time a messageId is remembered for.
+    static const std::chrono::seconds DEFAULT_TTL;
+
+    /**
+     * Create a @c MessageIdFilter.
+     *
+     * @param capacity The most messageIds to remember.
+     * @param ttl How long to remember a messageId for.
+     * @param clock The clock to measure @c ttl with.
+     * @return The new @c MessageIdFilter, or @c nullptr if @c capacity or @c ttl is zero, or @c clock is @c nullptr.
+     */
+    static std::shared_ptr<MessageIdFilter> create(
+        size_t capacity = DEFAULT_CAPACITY,
+        std::chrono::milliseconds ttl = DEFAULT_TTL,
+        std::shared_ptr<avsCommon::utils::timing::Clock> clock = avsCommon::utils::timing::Clock::getDefault());
+
+    /**
+     * Check whether a messageId has been seen recently, and remember it if it has not.
+     *
+     * @param messageId The messageId.
+     * @return Whether @c messageId was seen recently.
+     */
+    bool isDuplicate(const std::string& messageId);
+
+    /**
+     * Get the number of duplicates recognized.
+     *
+     * @return The number of calls to @c isDuplicate() which returned @c true.
+     */
+    uint64_t getNumDuplicates() const;
+
+private:
+    /// A messageId, and when it was last seen.
+    struct Entry {
+        /// The messageId.
+        std::string messageId;
+
+        /// When it was last seen.
+        avsCommon::utils::timing::Clock::time_point time;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param capacity The most messageIds to remember.
+     * @param ttl How long to remember a messageId for.
+     * @param clock The clock to measure @c ttl with.
+     */
+    MessageIdFilter(
+        size_t capacity,
+        std::chrono::milliseconds ttl,
+        std::shared_ptr<avsCommon::utils::timing::Clock> clock);
+
+    /**
+     * Forget the messageIds not seen for @c m_ttl, and the least recently seen ones over @c capacity.
+     * @note This method must only be called by threads that have acquired @c m_mutex.
+     *
+     * @param now The current time.
+     * @param capacity The number of messageIds which may be left.
+     */
+    void forgetLocked(avsCommon::utils::timing::Clock::time_point now, size_t capacity);
+
+    /// The most messageIds to remember.
+    const size_t m_capacity;
+
+    /// How long to remember a messageId for.
+    const std::chrono::milliseconds m_ttl;
+
+    /// The clock to measure @c m_ttl with.
+    const std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The messageIds remembered, least recently seen first.
+    std::list<Entry> m_entries;
+
+    /// The entries of @c m_entries, by messageId.
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_messageIds;
+
+    /// The number of duplicates recognized.
+    uint64_t m_numDuplicates;
+};
+
+}  // namespace adsl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_MESSAGE_ID_FILTER_H_
@@ -24,6 +24,8 @@
 #include <AVSCommon/SDKInterfaces/DirectiveSequencerInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageObserverInterface.h>
 
+#include "ADSL/MessageIdFilter.h"
+
 namespace alexaClientSDK {
 namespace adsl {
 
@@ -41,11 +43,14 @@ public:
      * @param directiveSequencerInterface The DirectiveSequencerInterface implementation, which will receive
      *        @c AVSDirectives.
      * @param attachmentManager The @c AttachmentManager which created @c AVSDirectives will use to acquire Attachments.
+     * @param messageIdFilter If not @c nullptr, directives whose messageId it has seen recently are dropped as
+     *        duplicates as soon as their messageId is read, before their payload is extracted or they are routed.
      */
     MessageInterpreter(
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager,
+        std::shared_ptr<MessageIdFilter> messageIdFilter = nullptr);
 
     void receive(const std::string& contextId, const std::string& message) override;
 
@@ -66,6 +71,9 @@ private:
 
     // The attachment manager.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> m_attachmentManager;
+
+    /// The filter of duplicate directives, or @c nullptr if there is none.  It has its own lock.
+    const std::shared_ptr<MessageIdFilter> m_messageIdFilter;
 };
 
 }  // namespace adsl
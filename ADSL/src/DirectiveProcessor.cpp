@@ -18,11 +18,14 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 
 #include <AVSCommon/AVS/ExceptionErrorType.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
+#include <AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
 
 #include "ADSL/DirectiveProcessor.h"
 
@@ -42,19 +45,20 @@ namespace adsl {
 using namespace avsCommon;
 using namespace avsCommon::avs;
 using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::metrics;
+using namespace avsCommon::utils::threading;
 
-std::mutex DirectiveProcessor::m_handleMapMutex;
-DirectiveProcessor::ProcessorHandle DirectiveProcessor::m_nextProcessorHandle = 0;
-std::unordered_map<DirectiveProcessor::ProcessorHandle, DirectiveProcessor*> DirectiveProcessor::m_handleMap;
+DirectiveProcessor::ProcessorHandle::ProcessorHandle(DirectiveProcessor* processor) : processor{processor} {
+}
 
-DirectiveProcessor::DirectiveProcessor(DirectiveRouter* directiveRouter) :
+DirectiveProcessor::DirectiveProcessor(DirectiveRouter* directiveRouter, bool useHandlerLanes) :
+        m_handle{std::make_shared<ProcessorHandle>(this)},
         m_directiveRouter{directiveRouter},
         m_isShuttingDown{false},
-        m_isHandlingDirective{false} {
-    std::lock_guard<std::mutex> lock(m_handleMapMutex);
-    m_handle = ++m_nextProcessorHandle;
-    m_handleMap[m_handle] = this;
-    m_processingThread = std::thread(&DirectiveProcessor::processingLoop, this);
+        m_isHandlingDirective{false},
+        m_useHandlerLanes{useHandlerLanes} {
+    m_processingThread =
+        ThreadFactory::createThread(ThreadRole::DIALOG, "adsl-processor", [this]() { processingLoop(); });
 }
 
 DirectiveProcessor::~DirectiveProcessor() {
@@ -98,6 +102,7 @@ bool DirectiveProcessor::onDirective(std::shared_ptr<AVSDirective> directive) {
         m_directiveBeingPreHandled.reset();
         if (handled) {
             m_handlingQueue.push_back(directive);
+            indexDirectiveLocked(directive);
             m_wakeProcessingLoop.notify_one();
         }
     }
@@ -105,10 +110,18 @@ bool DirectiveProcessor::onDirective(std::shared_ptr<AVSDirective> directive) {
     return handled;
 }
 
+void DirectiveProcessor::setMaxSpin(std::chrono::microseconds maxSpin) {
+    m_spinWait.setMaxSpin(maxSpin);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& lane : m_lanes) {
+        lane.second->setMaxSpin(maxSpin);
+    }
+}
+
 void DirectiveProcessor::shutdown() {
     {
-        std::lock_guard<std::mutex> lock(m_handleMapMutex);
-        m_handleMap.erase(m_handle);
+        std::lock_guard<std::mutex> lock(m_handle->mutex);
+        m_handle->processor = nullptr;
     }
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -119,36 +132,53 @@ void DirectiveProcessor::shutdown() {
     if (m_processingThread.joinable()) {
         m_processingThread.join();
     }
+    // Destroy the lanes without holding m_mutex, since a task finishing on a lane may need it.
+    std::unordered_map<DirectiveHandlerInterface*, std::unique_ptr<Executor>> lanes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(lanes, m_lanes);
+    }
+    lanes.clear();
 }
 
 DirectiveProcessor::DirectiveHandlerResult::DirectiveHandlerResult(
-    DirectiveProcessor::ProcessorHandle processorHandle,
+    std::weak_ptr<DirectiveProcessor::ProcessorHandle> processorHandle,
     std::shared_ptr<AVSDirective> directive) :
         m_processorHandle{processorHandle},
         m_directive{directive} {
 }
 
 void DirectiveProcessor::DirectiveHandlerResult::setCompleted() {
-    std::lock_guard<std::mutex> lock(m_handleMapMutex);
-    auto it = m_handleMap.find(m_processorHandle);
-    if (it == m_handleMap.end()) {
+    auto handle = m_processorHandle.lock();
+    if (!handle) {
+        ACSDK_DEBUG(LX("setCompletedIgnored").d("reason", "directiveSequencerAlreadyDestroyed"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    if (!handle->processor) {
         ACSDK_DEBUG(LX("setCompletedIgnored").d("reason", "directiveSequencerAlreadyShutDown"));
         return;
     }
-    it->second->onHandlingCompleted(m_directive);
+    handle->processor->onHandlingCompleted(m_directive);
 }
 
 void DirectiveProcessor::DirectiveHandlerResult::setFailed(const std::string& description) {
-    std::lock_guard<std::mutex> lock(m_handleMapMutex);
-    auto it = m_handleMap.find(m_processorHandle);
-    if (it == m_handleMap.end()) {
+    auto handle = m_processorHandle.lock();
+    if (!handle) {
+        ACSDK_DEBUG(LX("setFailedIgnored").d("reason", "directiveSequencerAlreadyDestroyed"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    if (!handle->processor) {
         ACSDK_DEBUG(LX("setFailedIgnored").d("reason", "directiveSequencerAlreadyShutDown"));
         return;
     }
-    it->second->onHandlingFailed(m_directive, description);
+    handle->processor->onHandlingFailed(m_directive, description);
 }
 
 void DirectiveProcessor::onHandlingCompleted(std::shared_ptr<AVSDirective> directive) {
+    DirectiveLatencyTracker::instance().record(
+        directive->getMessageId(), directive->getNamespace(), DirectiveLatencyTracker::Stage::COMPLETED);
     std::lock_guard<std::mutex> lock(m_mutex);
     ACSDK_DEBUG(LX("onHandlingCompeted")
                     .d("messageId", directive->getMessageId())
@@ -180,6 +210,9 @@ void DirectiveProcessor::removeDirectiveLocked(std::shared_ptr<AVSDirective> dir
         m_directiveBeingPreHandled.reset();
     }
 
+    m_directivesOnLanes.erase(directive);
+    unindexDirectiveLocked(directive);
+
     if (m_isHandlingDirective && !m_handlingQueue.empty() && matches(m_handlingQueue.front())) {
         m_isHandlingDirective = false;
         m_handlingQueue.pop_front();
@@ -193,6 +226,24 @@ void DirectiveProcessor::removeDirectiveLocked(std::shared_ptr<AVSDirective> dir
     }
 }
 
+void DirectiveProcessor::indexDirectiveLocked(std::shared_ptr<AVSDirective> directive) {
+    auto id = directive->getDialogRequestId();
+    if (!id.empty()) {
+        m_queuedDirectivesByDialogRequestId[id].insert(directive);
+    }
+}
+
+void DirectiveProcessor::unindexDirectiveLocked(std::shared_ptr<AVSDirective> directive) {
+    auto it = m_queuedDirectivesByDialogRequestId.find(directive->getDialogRequestId());
+    if (it == m_queuedDirectivesByDialogRequestId.end()) {
+        return;
+    }
+    it->second.erase(directive);
+    if (it->second.empty()) {
+        m_queuedDirectivesByDialogRequestId.erase(it);
+    }
+}
+
 void DirectiveProcessor::processingLoop() {
     auto wake = [this]() {
         return !m_cancelingQueue.empty() || (!m_handlingQueue.empty() && !m_isHandlingDirective) || m_isShuttingDown;
@@ -200,7 +251,7 @@ void DirectiveProcessor::processingLoop() {
 
     while (true) {
         std::unique_lock<std::mutex> lock(m_mutex);
-        m_wakeProcessingLoop.wait(lock, wake);
+        m_spinWait.wait(lock, m_wakeProcessingLoop, wake);
         if (!processCancelingQueueLocked(lock) && !handleDirectiveLocked(lock) && m_isShuttingDown) {
             break;
         }
@@ -211,11 +262,10 @@ bool DirectiveProcessor::processCancelingQueueLocked(std::unique_lock<std::mutex
     if (m_cancelingQueue.empty()) {
         return false;
     }
-    std::deque<std::shared_ptr<avsCommon::avs::AVSDirective>> temp(std::move(m_cancelingQueue));
+    std::vector<std::shared_ptr<avsCommon::avs::AVSDirective>> temp;
+    std::swap(temp, m_cancelingQueue);
     lock.unlock();
-    for (auto directive : temp) {
-        m_directiveRouter->cancelDirective(directive);
-    }
+    m_directiveRouter->cancelDirectives(temp);
     lock.lock();
     return true;
 }
@@ -229,14 +279,37 @@ bool DirectiveProcessor::handleDirectiveLocked(std::unique_lock<std::mutex>& loc
     }
     auto directive = m_handlingQueue.front();
     m_isHandlingDirective = true;
+    Executor* lane = nullptr;
+    if (m_useHandlerLanes) {
+        auto handlerAndPolicy = m_directiveRouter->getHandlerAndPolicy(directive);
+        if (handlerAndPolicy) {
+            lane = getLaneLocked(handlerAndPolicy.handler.get());
+            if (BlockingPolicy::BLOCKING != handlerAndPolicy.policy) {
+                m_isHandlingDirective = false;
+                m_handlingQueue.pop_front();
+                m_directivesOnLanes.insert(directive);
+                lane->submit([this, directive]() { handleDirectiveOnLane(directive); });
+                return true;
+            }
+        }
+    }
     lock.unlock();
     auto policy = BlockingPolicy::NONE;
-    auto handled = m_directiveRouter->handleDirective(directive, &policy);
+    auto handled = false;
+    if (lane) {
+        // Wait for the lane, so that the directive is handled after those already passed to its handler.
+        auto future = lane->submit(
+            [this, directive, &policy]() { return m_directiveRouter->handleDirective(directive, &policy); });
+        handled = future.valid() && future.get();
+    } else {
+        handled = m_directiveRouter->handleDirective(directive, &policy);
+    }
     lock.lock();
     if (!handled || BlockingPolicy::BLOCKING != policy) {
         m_isHandlingDirective = false;
         if (!m_handlingQueue.empty() && m_handlingQueue.front() == directive) {
             m_handlingQueue.pop_front();
+            unindexDirectiveLocked(directive);
         } else if (!handled) {
             ACSDK_ERROR(LX("handlingDirectiveLockedFailed")
                             .d("expected", directive->getMessageId())
@@ -250,6 +323,31 @@ bool DirectiveProcessor::handleDirectiveLocked(std::unique_lock<std::mutex>& loc
     return true;
 }
 
+Executor* DirectiveProcessor::getLaneLocked(DirectiveHandlerInterface* handler) {
+    auto& lane = m_lanes[handler];
+    if (!lane) {
+        lane = avsCommon::utils::memory::make_unique<Executor>();
+        lane->setMaxSpin(m_spinWait.getMaxSpin());
+    }
+    return lane.get();
+}
+
+void DirectiveProcessor::handleDirectiveOnLane(std::shared_ptr<AVSDirective> directive) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_directivesOnLanes.erase(directive)) {
+            ACSDK_DEBUG(LX("handleDirectiveOnLaneIgnored").d("messageId", directive->getMessageId()));
+            return;
+        }
+        unindexDirectiveLocked(directive);
+    }
+    auto policy = BlockingPolicy::NONE;
+    if (!m_directiveRouter->handleDirective(directive, &policy)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        scrubDialogRequestIdLocked(directive->getDialogRequestId());
+    }
+}
+
 void DirectiveProcessor::setDialogRequestIdLocked(const std::string& dialogRequestId) {
     if (dialogRequestId == m_dialogRequestId) {
         ACSDK_WARN(
@@ -293,18 +391,35 @@ void DirectiveProcessor::scrubDialogRequestIdLocked(const std::string& dialogReq
         }
     }
 
-    // Filter matching directives from m_handlingQueue and put them in m_cancelingQueue.
-    std::deque<std::shared_ptr<AVSDirective>> temp;
-    for (auto directive : m_handlingQueue) {
-        auto id = directive->getDialogRequestId();
-        if (!id.empty() && id == dialogRequestId) {
-            m_cancelingQueue.push_back(directive);
-            changed = true;
-        } else {
-            temp.push_back(directive);
+    // Move matching directives from m_handlingQueue and from the lanes to m_cancelingQueue.  The index tells which
+    // directives match, so the queues are only filtered if they hold any.
+    auto indexIt = m_queuedDirectivesByDialogRequestId.find(dialogRequestId);
+    if (indexIt != m_queuedDirectivesByDialogRequestId.end()) {
+        auto matching = std::move(indexIt->second);
+        m_queuedDirectivesByDialogRequestId.erase(indexIt);
+        changed = true;
+
+        size_t numOnLanes = 0;
+        for (const auto& directive : matching) {
+            numOnLanes += m_directivesOnLanes.count(directive);
+        }
+        if (numOnLanes < matching.size()) {
+            auto isMatching = [&matching](const std::shared_ptr<AVSDirective>& directive) {
+                return matching.count(directive) != 0;
+            };
+            std::copy_if(
+                m_handlingQueue.begin(), m_handlingQueue.end(), std::back_inserter(m_cancelingQueue), isMatching);
+            m_handlingQueue.erase(
+                std::remove_if(m_handlingQueue.begin(), m_handlingQueue.end(), isMatching), m_handlingQueue.end());
+        }
+        if (numOnLanes > 0) {
+            for (const auto& directive : matching) {
+                if (m_directivesOnLanes.erase(directive)) {
+                    m_cancelingQueue.push_back(directive);
+                }
+            }
         }
     }
-    std::swap(temp, m_handlingQueue);
 
     // If the dialogRequestId to scrub is the current value, reset the current value.
     if (dialogRequestId == m_dialogRequestId) {
@@ -323,9 +438,12 @@ void DirectiveProcessor::queueAllDirectivesForCancellationLocked() {
         m_handlingQueue.push_back(m_directiveBeingPreHandled);
         m_directiveBeingPreHandled.reset();
     }
-    if (!m_handlingQueue.empty()) {
+    if (!m_handlingQueue.empty() || !m_directivesOnLanes.empty()) {
         m_cancelingQueue.insert(m_cancelingQueue.end(), m_handlingQueue.begin(), m_handlingQueue.end());
+        m_cancelingQueue.insert(m_cancelingQueue.end(), m_directivesOnLanes.begin(), m_directivesOnLanes.end());
         m_handlingQueue.clear();
+        m_directivesOnLanes.clear();
+        m_queuedDirectivesByDialogRequestId.clear();
         m_wakeProcessingLoop.notify_one();
     }
     m_isHandlingDirective = false;
@@ -15,12 +15,16 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
 #include <iostream>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <vector>
 
+#include <AVSCommon/AVS/NamespaceAndNameInterner.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h>
 
 #include "ADSL/DirectiveRouter.h"
 
@@ -40,8 +44,84 @@ namespace adsl {
 using namespace avsCommon::avs;
 using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::utils;
+using namespace avsCommon::utils::metrics;
 
-DirectiveRouter::DirectiveRouter() : RequiresShutdown{"DirectiveRouter"} {
+/// How long @c doShutdown() sleeps while waiting for calls through the frozen routing table to finish.
+static const std::chrono::milliseconds FROZEN_CALLS_POLL_INTERVAL(1);
+
+/**
+ * An immutable routing table indexed by the interned id of each @c NamespaceAndName (see
+ * @c NamespaceAndNameInterner).  A lookup of a directive whose header carries an id is then a bounds check and an
+ * array access, with no hashing or string comparison.
+ */
+class DirectiveRouter::RoutingTable {
+public:
+    /**
+     * Build a routing table.
+     *
+     * @param configuration The mapping to copy into the table.
+     */
+    RoutingTable(const std::unordered_map<NamespaceAndName, HandlerAndPolicy>& configuration);
+
+    /**
+     * Look up the @c HandlerAndPolicy for a directive.
+     *
+     * @param directive The directive.
+     * @return The @c HandlerAndPolicy, which is empty if no handler was registered for the directive.
+     */
+    HandlerAndPolicy find(std::shared_ptr<AVSDirective> directive) const;
+
+private:
+    /// The value of each id, which is empty for the ids which were not registered.
+    std::vector<HandlerAndPolicy> m_values;
+};
+
+DirectiveRouter::RoutingTable::RoutingTable(
+    const std::unordered_map<NamespaceAndName, HandlerAndPolicy>& configuration) {
+    for (const auto& item : configuration) {
+        auto id = NamespaceAndNameInterner::intern(item.first.nameSpace, item.first.name);
+        if (id >= m_values.size()) {
+            m_values.resize(id + 1);
+        }
+        m_values[id] = item.second;
+    }
+}
+
+HandlerAndPolicy DirectiveRouter::RoutingTable::find(std::shared_ptr<AVSDirective> directive) const {
+    auto id = directive->getNamespaceAndNameId();
+    if (NamespaceAndNameInterner::INVALID_ID == id) {
+        // The directive was parsed before its namespace and name were interned.
+        id = NamespaceAndNameInterner::find(directive->getNamespace(), directive->getName());
+    }
+    if (NamespaceAndNameInterner::INVALID_ID == id || id >= m_values.size()) {
+        return HandlerAndPolicy();
+    }
+    return m_values[id];
+}
+
+DirectiveRouter::DirectiveRouter() :
+        RequiresShutdown{"DirectiveRouter"},
+        m_frozenTable{nullptr},
+        m_numFrozenCalls{0} {
+}
+
+DirectiveRouter::~DirectiveRouter() {
+}
+
+bool DirectiveRouter::freeze() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (isShutdown()) {
+        ACSDK_ERROR(LX("freezeFailed").d("reason", "isShutdown"));
+        return false;
+    }
+    if (m_routingTable) {
+        ACSDK_WARN(LX("freezeIgnored").d("reason", "alreadyFrozen"));
+        return true;
+    }
+    m_routingTable.reset(new RoutingTable(m_configuration));
+    m_frozenTable = m_routingTable.get();
+    ACSDK_INFO(LX("freeze").d("numDirectives", m_configuration.size()));
+    return true;
 }
 
 bool DirectiveRouter::addDirectiveHandler(std::shared_ptr<DirectiveHandlerInterface> handler) {
@@ -52,6 +132,11 @@ bool DirectiveRouter::addDirectiveHandler(std::shared_ptr<DirectiveHandlerInterf
         return false;
     }
 
+    if (m_routingTable) {
+        ACSDK_ERROR(LX("addDirectiveHandlersFailed").d("reason", "isFrozen"));
+        return false;
+    }
+
     if (!handler) {
         ACSDK_ERROR(LX("addDirectiveHandlersFailed").d("reason", "emptyHandler"));
         return false;
@@ -73,6 +158,8 @@ bool DirectiveRouter::addDirectiveHandler(std::shared_ptr<DirectiveHandlerInterf
     }
 
     for (auto item : configuration) {
+        // Intern the key, so that the headers of the directives parsed from now on carry its id.
+        NamespaceAndNameInterner::intern(item.first.nameSpace, item.first.name);
         HandlerAndPolicy handlerAndPolicy(handler, item.second);
         m_configuration[item.first] = handlerAndPolicy;
         incrementHandlerReferenceCountLocked(handler);
@@ -132,6 +219,11 @@ bool DirectiveRouter::removeDirectiveHandlerLocked(std::shared_ptr<DirectiveHand
 bool DirectiveRouter::removeDirectiveHandler(std::shared_ptr<DirectiveHandlerInterface> handler) {
     std::unique_lock<std::mutex> lock(m_mutex);
 
+    if (m_routingTable) {
+        ACSDK_ERROR(LX("removeDirectiveHandlersFailed").d("reason", "isFrozen"));
+        return false;
+    }
+
     if (!removeDirectiveHandlerLocked(handler)) {
         return false;
     }
@@ -144,8 +236,9 @@ bool DirectiveRouter::removeDirectiveHandler(std::shared_ptr<DirectiveHandlerInt
 }
 
 bool DirectiveRouter::handleDirectiveImmediately(std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    auto handlerAndPolicy = getHandlerAndPolicyLocked(directive);
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    FrozenCallScope frozenScope(this);
+    auto handlerAndPolicy = lookUpHandlerAndPolicy(frozenScope, lock, directive);
     if (!handlerAndPolicy) {
         ACSDK_WARN(LX("handleDirectiveImmediatelyFailed")
                        .d("messageId", directive->getMessageId())
@@ -154,6 +247,8 @@ bool DirectiveRouter::handleDirectiveImmediately(std::shared_ptr<avsCommon::avs:
     }
     ACSDK_INFO(LX("handleDirectiveImmediately").d("messageId", directive->getMessageId()).d("action", "calling"));
     HandlerCallScope scope(lock, this, handlerAndPolicy.handler);
+    DirectiveLatencyTracker::instance().record(
+        directive->getMessageId(), directive->getNamespace(), DirectiveLatencyTracker::Stage::HANDLE_START);
     handlerAndPolicy.handler->handleDirectiveImmediately(directive);
     return true;
 }
@@ -161,8 +256,9 @@ bool DirectiveRouter::handleDirectiveImmediately(std::shared_ptr<avsCommon::avs:
 bool DirectiveRouter::preHandleDirective(
     std::shared_ptr<avsCommon::avs::AVSDirective> directive,
     std::unique_ptr<DirectiveHandlerResultInterface> result) {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    auto handlerAndPolicy = getHandlerAndPolicyLocked(directive);
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    FrozenCallScope frozenScope(this);
+    auto handlerAndPolicy = lookUpHandlerAndPolicy(frozenScope, lock, directive);
     if (!handlerAndPolicy) {
         ACSDK_WARN(LX("preHandleDirectiveFailed")
                        .d("messageId", directive->getMessageId())
@@ -171,6 +267,8 @@ bool DirectiveRouter::preHandleDirective(
     }
     ACSDK_INFO(LX("preHandleDirective").d("messageId", directive->getMessageId()).d("action", "calling"));
     HandlerCallScope scope(lock, this, handlerAndPolicy.handler);
+    DirectiveLatencyTracker::instance().record(
+        directive->getMessageId(), directive->getNamespace(), DirectiveLatencyTracker::Stage::PRE_HANDLE);
     handlerAndPolicy.handler->preHandleDirective(directive, std::move(result));
     return true;
 }
@@ -183,8 +281,9 @@ bool DirectiveRouter::handleDirective(
             LX("handleDirectiveFailed").d("messageId", directive->getMessageId()).d("reason", "nullptrPolicyOut"));
         return false;
     }
-    std::unique_lock<std::mutex> lock(m_mutex);
-    auto handlerAndPolicy = getHandlerAndPolicyLocked(directive);
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    FrozenCallScope frozenScope(this);
+    auto handlerAndPolicy = lookUpHandlerAndPolicy(frozenScope, lock, directive);
     if (!handlerAndPolicy) {
         ACSDK_WARN(
             LX("handleDirectiveFailed").d("messageId", directive->getMessageId()).d("reason", "noHandlerRegistered"));
@@ -192,7 +291,9 @@ bool DirectiveRouter::handleDirective(
     }
     ACSDK_INFO(LX("handleDirective").d("messageId", directive->getMessageId()).d("action", "calling"));
     HandlerCallScope scope(lock, this, handlerAndPolicy.handler);
-    auto result = handlerAndPolicy.handler->handleDirective(directive->getMessageId());
+    DirectiveLatencyTracker::instance().record(
+        directive->getMessageId(), directive->getNamespace(), DirectiveLatencyTracker::Stage::HANDLE_START);
+    auto result = handlerAndPolicy.handler->handleDirective(directive);
     if (result) {
         *policyOut = handlerAndPolicy.policy;
     } else {
@@ -204,9 +305,33 @@ bool DirectiveRouter::handleDirective(
     return result;
 }
 
+HandlerAndPolicy DirectiveRouter::getHandlerAndPolicy(std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    FrozenCallScope frozenScope(this);
+    return lookUpHandlerAndPolicy(frozenScope, lock, directive);
+}
+
 bool DirectiveRouter::cancelDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    auto handlerAndPolicy = getHandlerAndPolicyLocked(directive);
+    FrozenCallScope frozenScope(this);
+    return cancelDirectiveInScope(frozenScope, directive);
+}
+
+size_t DirectiveRouter::cancelDirectives(const std::vector<std::shared_ptr<avsCommon::avs::AVSDirective>>& directives) {
+    FrozenCallScope frozenScope(this);
+    size_t count = 0;
+    for (const auto& directive : directives) {
+        if (cancelDirectiveInScope(frozenScope, directive)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool DirectiveRouter::cancelDirectiveInScope(
+    const FrozenCallScope& frozenScope,
+    std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    auto handlerAndPolicy = lookUpHandlerAndPolicy(frozenScope, lock, directive);
     if (!handlerAndPolicy) {
         ACSDK_WARN(
             LX("cancelDirectiveFailed").d("messageId", directive->getMessageId()).d("reason", "noHandlerRegistered"));
@@ -214,11 +339,17 @@ bool DirectiveRouter::cancelDirective(std::shared_ptr<avsCommon::avs::AVSDirecti
     }
     ACSDK_INFO(LX("cancelDirective").d("messageId", directive->getMessageId()).d("action", "calling"));
     HandlerCallScope scope(lock, this, handlerAndPolicy.handler);
-    handlerAndPolicy.handler->cancelDirective(directive->getMessageId());
+    handlerAndPolicy.handler->cancelDirective(directive);
     return true;
 }
 
 void DirectiveRouter::doShutdown() {
+    // Unpublish the frozen routing table, and wait for the calls already using it before deregistering its handlers.
+    m_frozenTable = nullptr;
+    while (m_numFrozenCalls > 0) {
+        std::this_thread::sleep_for(FROZEN_CALLS_POLL_INTERVAL);
+    }
+
     std::vector<std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface>> releasedHandlers;
     std::unique_lock<std::mutex> lock(m_mutex);
 
@@ -251,14 +382,32 @@ DirectiveRouter::HandlerCallScope::HandlerCallScope(
         // http://www.open-std.org/jtc1/sc22/wg21/docs/cwg_defects.html#1288
         m_lock(lock),
         m_router{router},
-        m_handler{handler} {
-    m_router->incrementHandlerReferenceCountLocked(m_handler);
-    m_lock.unlock();
+        m_handler{lock.owns_lock() ? handler : nullptr} {
+    if (m_handler) {
+        m_router->incrementHandlerReferenceCountLocked(m_handler);
+        m_lock.unlock();
+    }
 }
 
 DirectiveRouter::HandlerCallScope::~HandlerCallScope() {
-    m_lock.lock();
-    m_router->decrementHandlerReferenceCountLocked(m_lock, m_handler);
+    if (m_handler) {
+        m_lock.lock();
+        m_router->decrementHandlerReferenceCountLocked(m_lock, m_handler);
+    }
+}
+
+DirectiveRouter::FrozenCallScope::FrozenCallScope(DirectiveRouter* router) : m_router{router} {
+    // Count the call before loading the table, so that doShutdown() either sees the call or this sees nullptr.
+    ++m_router->m_numFrozenCalls;
+    m_table = m_router->m_frozenTable;
+}
+
+DirectiveRouter::FrozenCallScope::~FrozenCallScope() {
+    --m_router->m_numFrozenCalls;
+}
+
+const DirectiveRouter::RoutingTable* DirectiveRouter::FrozenCallScope::getTable() const {
+    return m_table;
 }
 
 HandlerAndPolicy DirectiveRouter::getHandlerAndPolicyLocked(std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
@@ -273,6 +422,22 @@ HandlerAndPolicy DirectiveRouter::getHandlerAndPolicyLocked(std::shared_ptr<avsC
     return it->second;
 }
 
+HandlerAndPolicy DirectiveRouter::lookUpHandlerAndPolicy(
+    const FrozenCallScope& frozenScope,
+    std::unique_lock<std::mutex>& lock,
+    std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
+    auto table = frozenScope.getTable();
+    if (!table) {
+        lock.lock();
+        return getHandlerAndPolicyLocked(directive);
+    }
+    if (!directive) {
+        ACSDK_WARN(LX("lookUpHandlerAndPolicyFailed").d("reason", "nullptrDirective"));
+        return HandlerAndPolicy();
+    }
+    return table->find(directive);
+}
+
 void DirectiveRouter::incrementHandlerReferenceCountLocked(std::shared_ptr<DirectiveHandlerInterface> handler) {
     const auto it = m_handlerReferenceCounts.find(handler);
     if (it != m_handlerReferenceCounts.end()) {
@@ -23,6 +23,8 @@
 #include <AVSCommon/AVS/ExceptionErrorType.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Metrics.h>
+#include <AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
 
 #include "ADSL/DirectiveSequencer.h"
 
@@ -43,14 +45,18 @@ using namespace avsCommon;
 using namespace avsCommon::avs;
 using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::utils;
+using namespace avsCommon::utils::metrics;
 
 std::unique_ptr<DirectiveSequencerInterface> DirectiveSequencer::create(
-    std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender) {
+    std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+    bool useHandlerLanes,
+    std::chrono::microseconds maxSpin) {
     if (!exceptionSender) {
         ACSDK_INFO(LX("createFailed").d("reason", "nullptrExceptionSender"));
         return nullptr;
     }
-    return std::unique_ptr<DirectiveSequencerInterface>(new DirectiveSequencer(exceptionSender));
+    return std::unique_ptr<DirectiveSequencerInterface>(
+        new DirectiveSequencer(exceptionSender, useHandlerLanes, maxSpin));
 }
 
 bool DirectiveSequencer::addDirectiveHandler(std::shared_ptr<DirectiveHandlerInterface> handler) {
@@ -61,7 +67,15 @@ bool DirectiveSequencer::removeDirectiveHandler(std::shared_ptr<DirectiveHandler
     return m_directiveRouter.removeDirectiveHandler(handler);
 }
 
+bool DirectiveSequencer::freezeDirectiveHandlers() {
+    return m_directiveRouter.freeze();
+}
+
 void DirectiveSequencer::setDialogRequestId(const std::string& dialogRequestId) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dialogRequestId = dialogRequestId;
+    }
     m_directiveProcessor->setDialogRequestId(dialogRequestId);
 }
 
@@ -70,7 +84,7 @@ bool DirectiveSequencer::onDirective(std::shared_ptr<AVSDirective> directive) {
         ACSDK_ERROR(LX("onDirectiveFailed").d("action", "ignored").d("reason", "nullptrDirective"));
         return false;
     }
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
     if (m_isShuttingDown) {
         ACSDK_WARN(LX("onDirectiveFailed")
                        .d("directive", directive->getHeaderAsString())
@@ -79,19 +93,39 @@ bool DirectiveSequencer::onDirective(std::shared_ptr<AVSDirective> directive) {
         return false;
     }
     ACSDK_INFO(LX("onDirective").d("directive", directive->getHeaderAsString()));
+    /*
+     * A directive of the current dialog which would be next in line anyway is received on the calling thread, rather
+     * than waking @c m_receivingThread for it.  Other directives are queued, so that they are still received in order.
+     */
+    if (m_receivingQueue.empty() && !m_isReceiving && !directive->getDialogRequestId().empty() &&
+        directive->getDialogRequestId() == m_dialogRequestId) {
+        m_isReceiving = true;
+        lock.unlock();
+        receiveDirective(directive);
+        lock.lock();
+        m_isReceiving = false;
+        m_wakeReceivingLoop.notify_all();
+        return true;
+    }
     m_receivingQueue.push_back(directive);
-    m_wakeReceivingLoop.notify_one();
+    m_wakeReceivingLoop.notify_all();
     return true;
 }
 
 DirectiveSequencer::DirectiveSequencer(
-    std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender) :
+    std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+    bool useHandlerLanes,
+    std::chrono::microseconds maxSpin) :
         DirectiveSequencerInterface{"DirectiveSequencer"},
         m_mutex{},
         m_exceptionSender{exceptionSender},
-        m_isShuttingDown{false} {
-    m_directiveProcessor = std::make_shared<DirectiveProcessor>(&m_directiveRouter);
-    m_receivingThread = std::thread(&DirectiveSequencer::receivingLoop, this);
+        m_isShuttingDown{false},
+        m_isReceiving{false},
+        m_spinWait{maxSpin} {
+    m_directiveProcessor = std::make_shared<DirectiveProcessor>(&m_directiveRouter, useHandlerLanes);
+    m_directiveProcessor->setMaxSpin(maxSpin);
+    m_receivingThread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::DIALOG, "adsl-sequencer", [this]() { receivingLoop(); });
 }
 
 void DirectiveSequencer::doShutdown() {
@@ -99,22 +133,27 @@ void DirectiveSequencer::doShutdown() {
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_isShuttingDown = true;
-        m_wakeReceivingLoop.notify_one();
+        m_wakeReceivingLoop.notify_all();
     }
     if (m_receivingThread.joinable()) {
         m_receivingThread.join();
     }
+    {
+        // Wait for a directive being received on the thread which called @c onDirective().
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeReceivingLoop.wait(lock, [this]() { return !m_isReceiving; });
+    }
     m_directiveProcessor->shutdown();
     m_directiveRouter.shutdown();
     m_exceptionSender.reset();
 }
 
 void DirectiveSequencer::receivingLoop() {
-    auto wake = [this]() { return !m_receivingQueue.empty() || m_isShuttingDown; };
+    auto wake = [this]() { return (!m_receivingQueue.empty() && !m_isReceiving) || m_isShuttingDown; };
 
     std::unique_lock<std::mutex> lock(m_mutex);
     while (true) {
-        m_wakeReceivingLoop.wait(lock, wake);
+        m_spinWait.wait(lock, m_wakeReceivingLoop, wake);
         if (m_isShuttingDown) {
             break;
         }
@@ -128,8 +167,17 @@ void DirectiveSequencer::receiveDirectiveLocked(std::unique_lock<std::mutex>& lo
     }
     auto directive = m_receivingQueue.front();
     m_receivingQueue.pop_front();
+    m_isReceiving = true;
     lock.unlock();
+    receiveDirective(directive);
+    lock.lock();
+    m_isReceiving = false;
+    m_wakeReceivingLoop.notify_all();
+}
 
+void DirectiveSequencer::receiveDirective(std::shared_ptr<AVSDirective> directive) {
+    DirectiveLatencyTracker::instance().record(
+        directive->getMessageId(), directive->getNamespace(), DirectiveLatencyTracker::Stage::ADSL_DEQUEUE);
     if (directive->getName() == "StopCapture" || directive->getName() == "Speak") {
         ACSDK_METRIC_MSG(TAG, directive, Metrics::Location::ADSL_DEQUEUE);
     }
@@ -156,7 +204,6 @@ void DirectiveSequencer::receiveDirectiveLocked(std::unique_lock<std::mutex>& lo
         m_exceptionSender->sendExceptionEncountered(
             directive->getUnparsedDirective(), ExceptionErrorType::UNSUPPORTED_OPERATION, "Unsupported operation");
     }
-    lock.lock();
 }
 
 }  // namespace adsl
@@ -0,0 +1,99 @@
+/*
+ * MessageIdFilter.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <iterator>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ADSL/MessageIdFilter.h"
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MessageIdFilter");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+namespace alexaClientSDK {
+namespace adsl {
+
+using namespace avsCommon::utils::timing;
+
+const size_t MessageIdFilter::DEFAULT_CAPACITY = 256;
+
+const std::chrono::seconds MessageIdFilter::DEFAULT_TTL(10 * 60);
+
+std::shared_ptr<MessageIdFilter> MessageIdFilter::create(
+    size_t capacity,
+    std::chrono::milliseconds ttl,
+    std::shared_ptr<Clock> clock) {
+    if (0 == capacity || ttl <= std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "zeroCapacityOrTtl")
+                        .d("capacity", capacity)
+                        .d("ttlMs", ttl.count()));
+        return nullptr;
+    }
+    if (!clock) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullClock"));
+        return nullptr;
+    }
+    return std::shared_ptr<MessageIdFilter>(new MessageIdFilter(capacity, ttl, std::move(clock)));
+}
+
+MessageIdFilter::MessageIdFilter(size_t capacity, std::chrono::milliseconds ttl, std::shared_ptr<Clock> clock) :
+        m_capacity{capacity},
+        m_ttl{ttl},
+        m_clock{std::move(clock)},
+        m_numDuplicates{0} {
+}
+
+bool MessageIdFilter::isDuplicate(const std::string& messageId) {
+    auto now = m_clock->now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    forgetLocked(now, m_capacity);
+    auto it = m_messageIds.find(messageId);
+    if (it != m_messageIds.end()) {
+        // Seen again, so it is now the most recently seen.
+        it->second->time = now;
+        m_entries.splice(m_entries.end(), m_entries, it->second);
+        ++m_numDuplicates;
+        return true;
+    }
+    forgetLocked(now, m_capacity - 1);
+    m_entries.push_back({messageId, now});
+    m_messageIds[messageId] = std::prev(m_entries.end());
+    return false;
+}
+
+uint64_t MessageIdFilter::getNumDuplicates() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numDuplicates;
+}
+
+void MessageIdFilter::forgetLocked(Clock::time_point now, size_t capacity) {
+    while (!m_entries.empty() && (m_entries.size() > capacity || now - m_entries.front().time >= m_ttl)) {
+        m_messageIds.erase(m_entries.front().messageId);
+        m_entries.pop_front();
+    }
+}
+
+}  // namespace adsl
+}  // namespace alexaClientSDK
@@ -20,8 +20,11 @@
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/AVS/AVSMessageHeader.h>
 #include <AVSCommon/AVS/AVSDirective.h>
+#include <AVSCommon/AVS/DirectiveArena.h>
 #include <rapidjson/document.h>
 #include <AVSCommon/Utils/Metrics.h>
+#include <AVSCommon/Utils/Metrics/DialogLatencyTracer.h>
+#include <AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
 
@@ -34,6 +37,7 @@ using namespace avsCommon::avs::attachment;
 using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::utils::json::jsonUtils;
 using namespace avsCommon::utils;
+using namespace avsCommon::utils::metrics;
 using namespace rapidjson;
 
 /// String to identify log entries originating from this file.
@@ -79,20 +83,26 @@ static void sendExceptionEncounteredHelper(
 MessageInterpreter::MessageInterpreter(
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<DirectiveSequencerInterface> directiveSequencer,
-    std::shared_ptr<AttachmentManagerInterface> attachmentManager) :
+    std::shared_ptr<AttachmentManagerInterface> attachmentManager,
+    std::shared_ptr<MessageIdFilter> messageIdFilter) :
         m_exceptionEncounteredSender{exceptionEncounteredSender},
         m_directiveSequencer{directiveSequencer},
-        m_attachmentManager{attachmentManager} {
+        m_attachmentManager{attachmentManager},
+        m_messageIdFilter{messageIdFilter} {
 }
 
 void MessageInterpreter::receive(const std::string& contextId, const std::string& message) {
-    Document document;
+    // The document and the header are allocated together in one arena, which the directive keeps alive.  The
+    // parsed document is shared with the directive so that handlers need not parse the payload again.
+    auto arena = DirectiveArena::create();
+    auto& document = arena->getDocument();
 
     if (!parseJSON(message, &document)) {
         const std::string error = "Parsing JSON Document failed";
         sendExceptionEncounteredHelper(m_exceptionEncounteredSender, message, error);
         return;
     }
+    arena->updateMemoryAccounting();
 
     // Get iterator to child nodes
     Value::ConstMemberIterator directiveIt;
@@ -107,7 +117,18 @@ void MessageInterpreter::receive(const std::string& contextId, const std::string
         return;
     }
 
-    // Retrieve values
+    // Retrieve values, starting with the messageId so that a duplicate is dropped before any more work is done.
+    std::string avsMessageId;
+    if (!retrieveValue(headerIt->value, JSON_MESSAGE_ID_KEY, &avsMessageId)) {
+        sendParseValueException(JSON_MESSAGE_ID_KEY, message);
+        return;
+    }
+
+    if (m_messageIdFilter && m_messageIdFilter->isDuplicate(avsMessageId)) {
+        ACSDK_WARN(LX("receiveFailed").d("messageId", avsMessageId).d("action", "ignored").d("reason", "duplicate"));
+        return;
+    }
+
     std::string payload;
     if (!retrieveValue(directiveIt->value, JSON_MESSAGE_PAYLOAD_KEY, &payload)) {
         sendParseValueException(JSON_MESSAGE_PAYLOAD_KEY, message);
@@ -126,12 +147,6 @@ void MessageInterpreter::receive(const std::string& contextId, const std::string
         return;
     }
 
-    std::string avsMessageId;
-    if (!retrieveValue(headerIt->value, JSON_MESSAGE_ID_KEY, &avsMessageId)) {
-        sendParseValueException(JSON_MESSAGE_ID_KEY, message);
-        return;
-    }
-
     // This is an optional header field - it's ok if it is not present.
     // Avoid jsonUtils::retrieveValue because it logs a missing value as an ERROR.
     std::string avsDialogRequestId;
@@ -142,9 +157,10 @@ void MessageInterpreter::receive(const std::string& contextId, const std::string
         ACSDK_DEBUG(LX("receive").d("messageId", avsMessageId).m("No dialogRequestId attached to message."));
     }
 
-    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(avsNamespace, avsName, avsMessageId, avsDialogRequestId);
-    std::shared_ptr<AVSDirective> avsDirective =
-        AVSDirective::create(message, avsMessageHeader, payload, m_attachmentManager, contextId);
+    auto avsMessageHeader =
+        arena->createHeader(avsNamespace, std::move(avsName), avsMessageId, std::move(avsDialogRequestId));
+    std::shared_ptr<AVSDirective> avsDirective = AVSDirective::create(
+        message, arena->getSharedDocument(), avsMessageHeader, payload, m_attachmentManager, contextId);
     if (!avsDirective) {
         const std::string errorDescription = "AVSDirective is nullptr, failed to send to DirectiveSequencer";
         ACSDK_ERROR(LX("receiveFailed").d("reason", "createAvsDirectiveFailed"));
@@ -156,6 +172,10 @@ void MessageInterpreter::receive(const std::string& contextId, const std::string
         ACSDK_METRIC_MSG(TAG, avsDirective, Metrics::Location::ADSL_ENQUEUE);
     }
 
+    DirectiveLatencyTracker::instance().record(
+        avsMessageId, avsNamespace, DirectiveLatencyTracker::Stage::ADSL_ENQUEUE);
+    DialogLatencyTracer::instance().mark(
+        avsDirective->getDialogRequestId(), DialogLatencyTracer::Mark::FIRST_DIRECTIVE);
     m_directiveSequencer->onDirective(avsDirective);
 }
 
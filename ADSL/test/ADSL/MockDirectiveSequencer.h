@@ -45,6 +45,8 @@ public:
         removeDirectiveHandler,
         bool(std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> handler));
 
+    MOCK_METHOD0(freezeDirectiveHandlers, bool());
+
     MOCK_METHOD1(setDialogRequestId, void(const std::string& dialogRequestId));
 
     MOCK_METHOD1(onDirective, bool(std::shared_ptr<avsCommon::avs::AVSDirective> directive));
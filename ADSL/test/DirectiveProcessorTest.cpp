@@ -306,6 +306,67 @@ TEST_F(DirectiveProcessorTest, testSetDialogRequestIdCancelsOutstandingDirective
     ASSERT_TRUE(handler2->waitUntilCompleted());
 }
 
+/**
+ * Create a @c DirectiveProcessor with handler lanes, and register a @c NON_BLOCKING handler whose
+ * @c handleDirective() does not return until released, and a second @c NON_BLOCKING handler.  Send an
+ * @c AVSDirective to each.  Expect that the second @c AVSDirective is handled while the first handler is still in
+ * its @c handleDirective() call.
+ */
+TEST_F(DirectiveProcessorTest, testHandlerLanesRunConcurrently) {
+    m_processor = std::make_shared<DirectiveProcessor>(m_router.get(), true);
+
+    DirectiveHandlerConfiguration handler0Config;
+    handler0Config[{NAMESPACE_AND_NAME_0_0}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler0 = MockDirectiveHandler::create(handler0Config);
+
+    DirectiveHandlerConfiguration handler1Config;
+    handler1Config[{NAMESPACE_AND_NAME_0_1}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler1 = MockDirectiveHandler::create(handler1Config);
+
+    ASSERT_TRUE(m_router->addDirectiveHandler(handler0));
+    ASSERT_TRUE(m_router->addDirectiveHandler(handler1));
+
+    std::promise<void> releasePromise;
+    auto releaseFuture = releasePromise.get_future();
+    EXPECT_CALL(*(handler0.get()), handleDirective(MESSAGE_ID_0_0)).WillOnce(Invoke([&releaseFuture](std::string) {
+        releaseFuture.wait();
+        return true;
+    }));
+    EXPECT_CALL(*(handler1.get()), preHandleDirective(m_directive_0_1, _)).Times(1);
+    EXPECT_CALL(*(handler1.get()), handleDirective(MESSAGE_ID_0_1)).Times(1);
+    EXPECT_CALL(*(handler1.get()), cancelDirective(_)).Times(0);
+
+    m_processor->setDialogRequestId(DIALOG_REQUEST_ID_0);
+    ASSERT_TRUE(m_processor->onDirective(m_directive_0_0));
+    ASSERT_TRUE(m_processor->onDirective(m_directive_0_1));
+    ASSERT_TRUE(handler1->waitUntilCompleted());
+    releasePromise.set_value();
+    m_processor->shutdown();
+}
+
+/**
+ * Register a @c NON_BLOCKING handler which keeps the @c DirectiveHandlerResult it is given, and send it an
+ * @c AVSDirective.  Then shut down and destroy the @c DirectiveProcessor.  Expect that completing or failing the
+ * handling of the @c AVSDirective afterwards is ignored.
+ */
+TEST_F(DirectiveProcessorTest, testResultOutlivingProcessorIsIgnored) {
+    DirectiveHandlerConfiguration handler0Config;
+    handler0Config[{NAMESPACE_AND_NAME_0_0}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler0 = MockDirectiveHandler::create(handler0Config);
+    ASSERT_TRUE(m_router->addDirectiveHandler(handler0));
+
+    std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerResultInterface> result;
+    EXPECT_CALL(*(handler0.get()), preHandleDirective(m_directive_0_0, _)).WillOnce(SaveArg<1>(&result));
+
+    m_processor->setDialogRequestId(DIALOG_REQUEST_ID_0);
+    ASSERT_TRUE(m_processor->onDirective(m_directive_0_0));
+    ASSERT_TRUE(result);
+    m_processor->shutdown();
+    result->setCompleted();
+    m_processor.reset();
+    result->setFailed("processorDestroyed");
+}
+
 }  // namespace test
 }  // namespace adsl
 }  // namespace alexaClientSDK
@@ -340,6 +340,73 @@ TEST_F(DirectiveRouterTest, testHandlerMethodsCanRunConcurrently) {
     sleeperThread.join();
 }
 
+/**
+ * Register @c AVSDirectives to be routed to different handlers, then freeze the router.  Expect that the
+ * @c AVSDirectives are still routed to their handlers, that an unregistered @c AVSDirective is not routed, that
+ * handlers can no longer be added or removed, and that the handlers are deregistered on shutdown.
+ */
+TEST_F(DirectiveRouterTest, testFrozenRouting) {
+    DirectiveHandlerConfiguration handler0Config;
+    handler0Config[{NAMESPACE_AND_NAME_0_0}] = BlockingPolicy::BLOCKING;
+    handler0Config[{NAMESPACE_AND_NAME_0_1}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler0 = MockDirectiveHandler::create(handler0Config);
+
+    DirectiveHandlerConfiguration handler1Config;
+    handler1Config[{NAMESPACE_AND_NAME_1_0}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler1 = MockDirectiveHandler::create(handler1Config);
+
+    ASSERT_TRUE(m_router.addDirectiveHandler(handler0));
+    ASSERT_TRUE(m_router.freeze());
+    ASSERT_FALSE(m_router.addDirectiveHandler(handler1));
+    ASSERT_FALSE(m_router.removeDirectiveHandler(handler0));
+
+    EXPECT_CALL(*(handler0.get()), handleDirectiveImmediately(m_directive_0_1)).Times(1);
+    EXPECT_CALL(*(handler0.get()), handleDirective(MESSAGE_ID_0_0)).WillOnce(Return(true));
+    EXPECT_CALL(*(handler0.get()), cancelDirective(MESSAGE_ID_0_0)).Times(1);
+    EXPECT_CALL(*(handler0.get()), onDeregistered()).Times(1);
+    EXPECT_CALL(*(handler1.get()), onDeregistered()).Times(0);
+
+    ASSERT_TRUE(m_router.handleDirectiveImmediately(m_directive_0_1));
+    auto policy = BlockingPolicy::NONE;
+    ASSERT_TRUE(m_router.handleDirective(m_directive_0_0, &policy));
+    ASSERT_EQ(policy, BlockingPolicy::BLOCKING);
+    ASSERT_TRUE(m_router.cancelDirective(m_directive_0_0));
+    ASSERT_FALSE(m_router.handleDirectiveImmediately(m_directive_1_0));
+    ASSERT_EQ(m_router.getHandlerAndPolicy(m_directive_0_1), HandlerAndPolicy(handler0, BlockingPolicy::NON_BLOCKING));
+
+    m_router.shutdown();
+    ASSERT_FALSE(m_router.handleDirectiveImmediately(m_directive_0_1));
+}
+
+/**
+ * Register @c AVSDirectives to be routed to two handlers, then cancel them, and an unregistered @c AVSDirective, in
+ * one batch.  Expect that each registered @c AVSDirective is canceled by its handler, and that the unregistered one
+ * is not counted.
+ */
+TEST_F(DirectiveRouterTest, testCancelDirectivesInBatch) {
+    DirectiveHandlerConfiguration handler0Config;
+    handler0Config[{NAMESPACE_AND_NAME_0_0}] = BlockingPolicy::BLOCKING;
+    handler0Config[{NAMESPACE_AND_NAME_0_1}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler0 = MockDirectiveHandler::create(handler0Config);
+
+    DirectiveHandlerConfiguration handler1Config;
+    handler1Config[{NAMESPACE_AND_NAME_1_0}] = BlockingPolicy::NON_BLOCKING;
+    std::shared_ptr<MockDirectiveHandler> handler1 = MockDirectiveHandler::create(handler1Config);
+
+    ASSERT_TRUE(m_router.addDirectiveHandler(handler0));
+
+    EXPECT_CALL(*(handler0.get()), cancelDirective(MESSAGE_ID_0_0)).Times(1);
+    EXPECT_CALL(*(handler0.get()), cancelDirective(MESSAGE_ID_0_1)).Times(1);
+    EXPECT_CALL(*(handler1.get()), cancelDirective(_)).Times(0);
+
+    ASSERT_EQ(m_router.cancelDirectives({m_directive_0_0, m_directive_1_0, m_directive_0_1}), 2u);
+
+    ASSERT_TRUE(m_router.addDirectiveHandler(handler1));
+    ASSERT_TRUE(m_router.freeze());
+    EXPECT_CALL(*(handler1.get()), cancelDirective(MESSAGE_ID_1_0)).Times(1);
+    ASSERT_EQ(m_router.cancelDirectives({m_directive_1_0}), 1u);
+}
+
 }  // namespace test
 }  // namespace adsl
 }  // namespace alexaClientSDK
@@ -20,6 +20,7 @@
 #include <future>
 #include <string>
 #include <memory>
+#include <thread>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -703,6 +704,58 @@ TEST_F(DirectiveSequencerTest, testAddDirectiveHandlersWhileHandlingDirectives)
     ASSERT_TRUE(handler4->waitUntilCanceling());
 }
 
+/**
+ * Send a directive of the current dialog while the sequencer is idle, then one without a dialogRequestId.  Expect the
+ * first to be pre-handled on the thread which called @c onDirective(), and the second on another thread.
+ */
+TEST_F(DirectiveSequencerTest, testCurrentDialogDirectiveReceivedOnCallingThread) {
+    auto avsMessageHeader0 =
+        std::make_shared<AVSMessageHeader>(NAMESPACE_TEST, NAME_NON_BLOCKING, MESSAGE_ID_0, DIALOG_REQUEST_ID_0);
+    std::shared_ptr<AVSDirective> directive0 = AVSDirective::create(
+        UNPARSED_DIRECTIVE, avsMessageHeader0, PAYLOAD_TEST, m_attachmentManager, TEST_ATTACHMENT_CONTEXT_ID);
+    auto avsMessageHeader1 = std::make_shared<AVSMessageHeader>(NAMESPACE_TEST, NAME_BLOCKING, MESSAGE_ID_1);
+    std::shared_ptr<AVSDirective> directive1 = AVSDirective::create(
+        UNPARSED_DIRECTIVE, avsMessageHeader1, PAYLOAD_TEST, m_attachmentManager, TEST_ATTACHMENT_CONTEXT_ID);
+
+    DirectiveHandlerConfiguration handler0Config;
+    handler0Config[{NAMESPACE_TEST, NAME_NON_BLOCKING}] = BlockingPolicy::NON_BLOCKING;
+    auto handler0 = MockDirectiveHandler::create(handler0Config);
+
+    DirectiveHandlerConfiguration handler1Config;
+    handler1Config[{NAMESPACE_TEST, NAME_BLOCKING}] = BlockingPolicy::BLOCKING;
+    auto handler1 = MockDirectiveHandler::create(handler1Config);
+
+    std::promise<std::thread::id> preHandleThreadId0;
+    std::promise<std::thread::id> preHandleThreadId1;
+    auto recordThread = [](MockDirectiveHandler* handler, std::promise<std::thread::id>* threadId) {
+        return [handler, threadId](
+                   std::shared_ptr<AVSDirective> directive, std::shared_ptr<DirectiveHandlerResultInterface> result) {
+            handler->mockPreHandleDirective(directive, result);
+            threadId->set_value(std::this_thread::get_id());
+        };
+    };
+    EXPECT_CALL(*(handler0.get()), preHandleDirective(directive0, _))
+        .WillOnce(Invoke(recordThread(handler0.get(), &preHandleThreadId0)));
+    EXPECT_CALL(*(handler0.get()), handleDirective(MESSAGE_ID_0)).Times(1);
+    EXPECT_CALL(*(handler1.get()), preHandleDirective(directive1, _))
+        .WillOnce(Invoke(recordThread(handler1.get(), &preHandleThreadId1)));
+    EXPECT_CALL(*(handler1.get()), handleDirective(MESSAGE_ID_1)).Times(1);
+
+    ASSERT_TRUE(m_sequencer->addDirectiveHandler(handler0));
+    ASSERT_TRUE(m_sequencer->addDirectiveHandler(handler1));
+    m_sequencer->setDialogRequestId(DIALOG_REQUEST_ID_0);
+    m_sequencer->onDirective(directive0);
+    auto future0 = preHandleThreadId0.get_future();
+    ASSERT_EQ(future0.wait_for(LONG_HANDLING_TIME_MS), std::future_status::ready);
+    ASSERT_EQ(future0.get(), std::this_thread::get_id());
+
+    m_sequencer->onDirective(directive1);
+    auto future1 = preHandleThreadId1.get_future();
+    ASSERT_EQ(future1.wait_for(LONG_HANDLING_TIME_MS), std::future_status::ready);
+    ASSERT_NE(future1.get(), std::this_thread::get_id());
+    ASSERT_TRUE(handler1->waitUntilHandling());
+}
+
 }  // namespace test
 }  // namespace adsl
 }  // namespace alexaClientSDK
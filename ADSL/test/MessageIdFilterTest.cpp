@@ -0,0 +1,119 @@
+/*
+ * MessageIdFilterTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file MessageIdFilterTest.cpp
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/Timing/VirtualClock.h>
+
+#include "ADSL/MessageIdFilter.h"
+
+namespace alexaClientSDK {
+namespace adsl {
+namespace test {
+
+using namespace avsCommon::utils::timing;
+
+/// The number of messageIds remembered by the filters under test.
+static const size_t CAPACITY = 3;
+
+/// How long the filters under test remember a messageId for.
+static const std::chrono::seconds TTL(60);
+
+/// Test harness for @c MessageIdFilter class.
+class MessageIdFilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_clock = std::make_shared<VirtualClock>();
+        m_filter = MessageIdFilter::create(CAPACITY, TTL, m_clock);
+        ASSERT_TRUE(m_filter);
+    }
+
+    /// The clock measuring the TTL of @c m_filter.
+    std::shared_ptr<VirtualClock> m_clock;
+
+    /// The filter under test.
+    std::shared_ptr<MessageIdFilter> m_filter;
+};
+
+/// Verify that @c create() rejects a zero capacity or TTL and a @c nullptr clock.
+TEST_F(MessageIdFilterTest, createFailures) {
+    ASSERT_FALSE(MessageIdFilter::create(0, TTL, m_clock));
+    ASSERT_FALSE(MessageIdFilter::create(CAPACITY, std::chrono::milliseconds::zero(), m_clock));
+    ASSERT_FALSE(MessageIdFilter::create(CAPACITY, TTL, nullptr));
+    ASSERT_TRUE(MessageIdFilter::create());
+}
+
+/// Verify that a messageId is a duplicate the second time it is seen, and that other messageIds are not.
+TEST_F(MessageIdFilterTest, recognizesDuplicates) {
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    ASSERT_FALSE(m_filter->isDuplicate("b"));
+    ASSERT_TRUE(m_filter->isDuplicate("a"));
+    ASSERT_TRUE(m_filter->isDuplicate("a"));
+    ASSERT_TRUE(m_filter->isDuplicate("b"));
+    ASSERT_EQ(3u, m_filter->getNumDuplicates());
+}
+
+/// Verify that a messageId is forgotten once it has not been seen for the TTL.
+TEST_F(MessageIdFilterTest, forgetsAfterTtl) {
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    m_clock->advance(TTL - std::chrono::seconds(1));
+    ASSERT_FALSE(m_filter->isDuplicate("b"));
+    m_clock->advance(std::chrono::seconds(1));
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    ASSERT_TRUE(m_filter->isDuplicate("b"));
+}
+
+/// Verify that seeing a messageId again keeps it remembered for another TTL.
+TEST_F(MessageIdFilterTest, duplicateRenewsTtl) {
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    m_clock->advance(TTL - std::chrono::seconds(1));
+    ASSERT_TRUE(m_filter->isDuplicate("a"));
+    m_clock->advance(TTL - std::chrono::seconds(1));
+    ASSERT_TRUE(m_filter->isDuplicate("a"));
+}
+
+/// Verify that the oldest messageId is forgotten when more than the capacity are remembered.
+TEST_F(MessageIdFilterTest, forgetsOldestOverCapacity) {
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    ASSERT_FALSE(m_filter->isDuplicate("b"));
+    ASSERT_FALSE(m_filter->isDuplicate("c"));
+    ASSERT_FALSE(m_filter->isDuplicate("d"));
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    ASSERT_TRUE(m_filter->isDuplicate("c"));
+    ASSERT_TRUE(m_filter->isDuplicate("d"));
+}
+
+/// Verify that the least recently seen messageId, rather than the first seen, is forgotten over capacity.
+TEST_F(MessageIdFilterTest, forgetsLeastRecentlySeenOverCapacity) {
+    ASSERT_FALSE(m_filter->isDuplicate("a"));
+    ASSERT_FALSE(m_filter->isDuplicate("b"));
+    ASSERT_FALSE(m_filter->isDuplicate("c"));
+    ASSERT_TRUE(m_filter->isDuplicate("a"));
+    ASSERT_FALSE(m_filter->isDuplicate("d"));
+    ASSERT_TRUE(m_filter->isDuplicate("a"));
+    ASSERT_FALSE(m_filter->isDuplicate("b"));
+}
+
+}  // namespace test
+}  // namespace adsl
+}  // namespace alexaClientSDK
@@ -19,6 +19,7 @@
 
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/SDKInterfaces/MockExceptionEncounteredSender.h>
+#include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <ADSL/DirectiveSequencer.h>
 #include <ADSL/MessageInterpreter.h>
 #include <gmock/gmock.h>
@@ -322,6 +323,46 @@ TEST_F(MessageIntepreterTest, messageIsValidDirective) {
     m_messageInterpreter->receive(TEST_ATTACHMENT_CONTEXT_ID, SPEAK_DIRECTIVE);
 }
 
+/**
+ * Test that a valid directive exposes its payload already parsed, with the same contents as the payload string.
+ */
+TEST_F(MessageIntepreterTest, messageIsValidDirectiveWithParsedPayload) {
+    EXPECT_CALL(*m_mockExceptionEncounteredSender, sendExceptionEncountered(_, _, _)).Times(0);
+    EXPECT_CALL(*m_mockDirectiveSequencer, onDirective(_))
+        .Times(1)
+        .WillOnce(Invoke([](std::shared_ptr<AVSDirective> avsDirective) -> bool {
+            auto payload = avsDirective->getPayloadValue();
+            EXPECT_NE(payload, nullptr);
+            if (payload) {
+                std::string token;
+                EXPECT_TRUE(avsCommon::utils::json::jsonUtils::retrieveValue(*payload, "token", &token));
+                EXPECT_EQ(token, "testToken");
+            }
+            EXPECT_EQ(avsDirective->getPayloadValue(), payload);
+            EXPECT_EQ(avsDirective->getPayload(), PAYLOAD_TEST);
+            return true;
+        }));
+    m_messageInterpreter->receive(TEST_ATTACHMENT_CONTEXT_ID, SPEAK_DIRECTIVE);
+}
+
+/**
+ * Test that with a @c MessageIdFilter, a directive received again is dropped before its payload is extracted: it is
+ * passed to the directive sequencer only once, and a directive without a payload is reported only once.
+ */
+TEST_F(MessageIntepreterTest, duplicateMessageIdIsDropped) {
+    auto messageIdFilter = MessageIdFilter::create();
+    ASSERT_TRUE(messageIdFilter);
+    auto messageInterpreter = std::make_shared<MessageInterpreter>(
+        m_mockExceptionEncounteredSender, m_mockDirectiveSequencer, m_attachmentManager, messageIdFilter);
+    EXPECT_CALL(*m_mockExceptionEncounteredSender, sendExceptionEncountered(_, _, _)).Times(1);
+    EXPECT_CALL(*m_mockDirectiveSequencer, onDirective(_)).Times(1).WillOnce(Return(true));
+    messageInterpreter->receive(TEST_ATTACHMENT_CONTEXT_ID, SPEAK_DIRECTIVE);
+    messageInterpreter->receive(TEST_ATTACHMENT_CONTEXT_ID, SPEAK_DIRECTIVE);
+    messageInterpreter->receive(TEST_ATTACHMENT_CONTEXT_ID, DIRECTIVE_NO_PAYLOAD);
+    messageInterpreter->receive(TEST_ATTACHMENT_CONTEXT_ID, DIRECTIVE_NO_PAYLOAD);
+    ASSERT_EQ(2u, messageIdFilter->getNumDuplicates());
+}
+
 }  // namespace test
 }  // namespace adsl
 }  // namespace alexaClientSDK
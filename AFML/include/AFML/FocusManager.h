@@ -18,8 +18,11 @@
 #ifndef ALEXA_CLIENT_SDK_AFML_INCLUDE_AFML_FOCUS_MANAGER_H_
 #define ALEXA_CLIENT_SDK_AFML_INCLUDE_AFML_FOCUS_MANAGER_H_
 
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -48,6 +51,10 @@ namespace afml {
  * All of these methods will notify the observer of the Channel of focus changes via an asynchronous callback to the
  * ChannelObserverInterface##onFocusChanged() method, at which point the client should make a user observable change
  * based on the focus it receives.
+ *
+ * The exception is an uncontested acquisition: if no Channel is active, no other operation is pending, and the
+ * observer allows it with ChannelObserverInterface##canBeNotifiedOnAcquiringThread(), acquireChannel() grants the
+ * Channel and calls the observer back before it returns, without waiting for the internal thread.
  */
 class FocusManager : public avsCommon::sdkInterfaces::FocusManagerInterface {
 public:
@@ -166,6 +173,28 @@ private:
         std::shared_ptr<Channel> foregroundChannel,
         std::string foregroundChannelActivityId);
 
+    /**
+     * Grants the Channel on the calling thread if the acquisition is uncontested: no Channel is active, no other
+     * operation is pending or running, and the observer can be notified on this thread.
+     *
+     * @param channelToAcquire The Channel to acquire.
+     * @param channelObserver The new observer of the Channel.
+     * @param activityId The id of the new activity on the Channel.
+     * @return Whether the Channel was granted.  If @c false, the acquisition must be submitted to @c m_executor.
+     */
+    bool tryAcquireChannelInline(
+        std::shared_ptr<Channel> channelToAcquire,
+        std::shared_ptr<avsCommon::sdkInterfaces::ChannelObserverInterface> channelObserver,
+        const std::string& activityId);
+
+    /**
+     * Submits an operation to @c m_executor, counting it in @c m_pendingOperations until it has run.
+     *
+     * @param operation The operation to submit.
+     * @param toFront Whether to run the operation before the operations already submitted.
+     */
+    void submitOperation(std::function<void()> operation, bool toFront = false);
+
     /**
      * Finds the channel from the given channel name.
      *
@@ -218,6 +247,15 @@ private:
     /// Set of currently observed Channels ordered by Channel priority.
     std::set<std::shared_ptr<Channel>, ChannelPtrComparator> m_activeChannels;
 
+    /// Serializes the operations which update the Channels, whether on @c m_executor or on an acquiring thread.
+    std::mutex m_operationMutex;
+
+    /// The number of operations submitted to @c m_executor which have not finished running.
+    std::atomic<unsigned int> m_pendingOperations;
+
+    /// The thread which holds @c m_operationMutex while it notifies observers, or a default id if there is none.
+    std::atomic<std::thread::id> m_operationThreadId;
+
     /// An internal executor that performs execution of callable objects passed to it sequentially but asynchronously.
     avsCommon::utils::threading::Executor m_executor;
 
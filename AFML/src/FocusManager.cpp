@@ -35,7 +35,9 @@ static const std::string TAG("FocusManager");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-FocusManager::FocusManager(const std::vector<ChannelConfiguration>& channelConfigurations) {
+FocusManager::FocusManager(const std::vector<ChannelConfiguration>& channelConfigurations) :
+        m_pendingOperations{0},
+        m_operationThreadId{std::thread::id()} {
     for (auto config : channelConfigurations) {
         if (doesChannelNameExist(config.name)) {
             ACSDK_ERROR(LX("createChannelFailed").d("reason", "channelNameExists").d("config", config.toString()));
@@ -62,7 +64,11 @@ bool FocusManager::acquireChannel(
         return false;
     }
 
-    m_executor.submit([this, channelToAcquire, channelObserver, activityId]() {
+    if (tryAcquireChannelInline(channelToAcquire, channelObserver, activityId)) {
+        return true;
+    }
+
+    submitOperation([this, channelToAcquire, channelObserver, activityId]() {
         acquireChannelHelper(channelToAcquire, channelObserver, activityId);
     });
     return true;
@@ -83,7 +89,7 @@ std::future<bool> FocusManager::releaseChannel(
         return returnValue;
     }
 
-    m_executor.submit([this, channelToRelease, channelObserver, releaseChannelSuccess, channelName]() {
+    submitOperation([this, channelToRelease, channelObserver, releaseChannelSuccess, channelName]() {
         releaseChannelHelper(channelToRelease, channelObserver, releaseChannelSuccess, channelName);
     });
 
@@ -102,9 +108,11 @@ void FocusManager::stopForegroundActivity() {
     std::string foregroundChannelActivityId = foregroundChannel->getActivityId();
     lock.unlock();
 
-    m_executor.submitToFront([this, foregroundChannel, foregroundChannelActivityId]() {
-        stopForegroundActivityHelper(foregroundChannel, foregroundChannelActivityId);
-    });
+    submitOperation(
+        [this, foregroundChannel, foregroundChannelActivityId]() {
+            stopForegroundActivityHelper(foregroundChannel, foregroundChannelActivityId);
+        },
+        true);
 }
 
 void FocusManager::acquireChannelHelper(
@@ -170,6 +178,60 @@ void FocusManager::stopForegroundActivityHelper(
     foregroundHighestPriorityActiveChannel();
 }
 
+bool FocusManager::tryAcquireChannelInline(
+    std::shared_ptr<Channel> channelToAcquire,
+    std::shared_ptr<ChannelObserverInterface> channelObserver,
+    const std::string& activityId) {
+    if (!channelObserver || !channelObserver->canBeNotifiedOnAcquiringThread()) {
+        return false;
+    }
+
+    // Holding this keeps m_executor from starting an operation, which would wait until the acquisition is done.  If an
+    // operation is already running, or is queued ahead of this one, the acquisition must be queued behind it.  That
+    // includes an acquisition by an observer being notified by an operation, on a thread which already holds the lock
+    // and so must not try to take it again.
+    if (m_pendingOperations != 0 || m_operationThreadId == std::this_thread::get_id()) {
+        return false;
+    }
+    std::unique_lock<std::mutex> operationLock(m_operationMutex, std::try_to_lock);
+    if (!operationLock.owns_lock() || m_pendingOperations != 0) {
+        return false;
+    }
+
+    // Lock here to update internal state which stopForegroundActivity may concurrently access.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_activeChannels.empty()) {
+        return false;
+    }
+    channelToAcquire->setActivityId(activityId);
+    m_activeChannels.insert(channelToAcquire);
+    lock.unlock();
+
+    ACSDK_DEBUG9(LX("acquiredChannelInline").d("activityId", activityId));
+    // No Channel is active, so this is the only observer to notify.
+    m_operationThreadId = std::this_thread::get_id();
+    channelToAcquire->setObserver(channelObserver);
+    channelToAcquire->setFocus(FocusState::FOREGROUND);
+    m_operationThreadId = std::thread::id();
+    return true;
+}
+
+void FocusManager::submitOperation(std::function<void()> operation, bool toFront) {
+    ++m_pendingOperations;
+    auto task = [this, operation]() {
+        std::lock_guard<std::mutex> operationLock(m_operationMutex);
+        m_operationThreadId = std::this_thread::get_id();
+        operation();
+        m_operationThreadId = std::thread::id();
+        --m_pendingOperations;
+    };
+    if (toFront) {
+        m_executor.submitToFront(task);
+    } else {
+        m_executor.submit(task);
+    }
+}
+
 std::shared_ptr<Channel> FocusManager::getChannel(const std::string& channelName) const {
     auto search = m_allChannels.find(channelName);
     if (search != m_allChannels.end()) {
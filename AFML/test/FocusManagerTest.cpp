@@ -15,6 +15,9 @@
  * permissions and limitations under the License.
  */
 
+#include <functional>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <AVSCommon/AVS/FocusState.h>
@@ -122,6 +125,64 @@ private:
     bool m_focusChangeOccurred;
 };
 
+/// A test observer which can be notified on the thread which acquires the Channel.
+class InlineTestClient : public TestClient {
+public:
+    void onFocusChanged(FocusState focusState) override {
+        m_lastNotifiedThread = std::this_thread::get_id();
+        TestClient::onFocusChanged(focusState);
+    }
+
+    bool canBeNotifiedOnAcquiringThread() const override {
+        return true;
+    }
+
+    /**
+     * Gets the thread of the last ChannelObserverInterface##onFocusChanged() callback.  Only call this after waiting
+     * for the callback.
+     *
+     * @return The id of the thread.
+     */
+    std::thread::id getLastNotifiedThread() const {
+        return m_lastNotifiedThread;
+    }
+
+private:
+    /// The thread of the last callback.
+    std::thread::id m_lastNotifiedThread;
+};
+
+/// A test observer which runs an action, such as acquiring another Channel, from its focus change callback.
+class ReentrantTestClient : public InlineTestClient {
+public:
+    /**
+     * Constructor.
+     *
+     * @param focusState The focus state on which to run the action.
+     * @param action The action to run, once.
+     */
+    ReentrantTestClient(FocusState focusState, std::function<void()> action) :
+            m_actionFocusState{focusState},
+            m_action{action} {
+    }
+
+    void onFocusChanged(FocusState focusState) override {
+        if (focusState == m_actionFocusState && m_action) {
+            auto action = m_action;
+            m_action = nullptr;
+            action();
+        }
+        InlineTestClient::onFocusChanged(focusState);
+    }
+
+private:
+    /// The focus state on which to run @c m_action.
+    FocusState m_actionFocusState;
+
+    /// The action to run, or @c nullptr once it has run.
+    std::function<void()> m_action;
+};
+
 /// Manages testing focus changes
 class FocusChangeManager {
 public:
@@ -195,6 +256,62 @@ TEST_F(FocusManagerTest, acquireInvalidChannelName) {
     ASSERT_FALSE(m_focusManager->acquireChannel(INCORRECT_CHANNEL_NAME, dialogClient, DIALOG_ACTIVITY_ID));
 }
 
+/// Tests that an uncontested acquireChannel by an observer which allows it is granted before acquireChannel returns.
+TEST_F(FocusManagerTest, acquireUncontestedChannelInline) {
+    auto inlineClient = std::make_shared<InlineTestClient>();
+    ASSERT_TRUE(m_focusManager->acquireChannel(DIALOG_CHANNEL_NAME, inlineClient, DIALOG_ACTIVITY_ID));
+    bool focusChanged = false;
+    ASSERT_EQ(FocusState::FOREGROUND, inlineClient->waitForFocusChange(std::chrono::milliseconds(0), &focusChanged));
+    ASSERT_TRUE(focusChanged);
+    ASSERT_EQ(std::this_thread::get_id(), inlineClient->getLastNotifiedThread());
+
+    ASSERT_TRUE(m_focusManager->releaseChannel(DIALOG_CHANNEL_NAME, inlineClient).get());
+    assertFocusChange(inlineClient, FocusState::NONE);
+}
+
+/// Tests that a contested acquireChannel is still granted asynchronously, even if the observer allows it inline.
+TEST_F(FocusManagerTest, acquireContestedChannelAsynchronously) {
+    ASSERT_TRUE(m_focusManager->acquireChannel(CONTENT_CHANNEL_NAME, contentClient, CONTENT_ACTIVITY_ID));
+    assertFocusChange(contentClient, FocusState::FOREGROUND);
+
+    auto inlineClient = std::make_shared<InlineTestClient>();
+    ASSERT_TRUE(m_focusManager->acquireChannel(DIALOG_CHANNEL_NAME, inlineClient, DIALOG_ACTIVITY_ID));
+    assertFocusChange(contentClient, FocusState::BACKGROUND);
+    assertFocusChange(inlineClient, FocusState::FOREGROUND);
+    ASSERT_NE(std::this_thread::get_id(), inlineClient->getLastNotifiedThread());
+}
+
+/**
+ * Tests that an acquireChannel made from a focus change callback, both of an inline acquisition and of an operation on
+ * the executor, is queued rather than granted inline on the thread which is notifying.
+ */
+TEST_F(FocusManagerTest, reentrantAcquireIsQueued) {
+    auto contentInlineClient = std::make_shared<InlineTestClient>();
+    auto alertsInlineClient = std::make_shared<InlineTestClient>();
+    auto focusManager = m_focusManager.get();
+    auto dialogInlineClient = std::make_shared<ReentrantTestClient>(FocusState::FOREGROUND, [=] {
+        focusManager->acquireChannel(CONTENT_CHANNEL_NAME, contentInlineClient, CONTENT_ACTIVITY_ID);
+    });
+    auto alertsAcquiringClient = std::make_shared<ReentrantTestClient>(FocusState::NONE, [=] {
+        focusManager->acquireChannel(ALERTS_CHANNEL_NAME, alertsInlineClient, ALERTS_ACTIVITY_ID);
+    });
+
+    ASSERT_TRUE(m_focusManager->acquireChannel(DIALOG_CHANNEL_NAME, dialogInlineClient, DIALOG_ACTIVITY_ID));
+    assertFocusChange(dialogInlineClient, FocusState::FOREGROUND);
+    ASSERT_EQ(std::this_thread::get_id(), dialogInlineClient->getLastNotifiedThread());
+    assertFocusChange(contentInlineClient, FocusState::BACKGROUND);
+    ASSERT_NE(std::this_thread::get_id(), contentInlineClient->getLastNotifiedThread());
+
+    ASSERT_TRUE(
+        m_focusManager->acquireChannel(DIALOG_CHANNEL_NAME, alertsAcquiringClient, DIFFERENT_DIALOG_ACTIVITY_ID));
+    assertFocusChange(dialogInlineClient, FocusState::NONE);
+    assertFocusChange(alertsAcquiringClient, FocusState::FOREGROUND);
+    ASSERT_TRUE(m_focusManager->releaseChannel(DIALOG_CHANNEL_NAME, alertsAcquiringClient).get());
+    assertFocusChange(alertsAcquiringClient, FocusState::NONE);
+    assertFocusChange(alertsInlineClient, FocusState::FOREGROUND);
+    ASSERT_NE(std::this_thread::get_id(), alertsInlineClient->getLastNotifiedThread());
+}
+
 /// Tests acquireChannel, expecting to get Foreground status since no other Channels are active.
 TEST_F(FocusManagerTest, acquireChannelWithNoOtherChannelsActive) {
     ASSERT_TRUE(m_focusManager->acquireChannel(DIALOG_CHANNEL_NAME, dialogClient, DIALOG_ACTIVITY_ID));
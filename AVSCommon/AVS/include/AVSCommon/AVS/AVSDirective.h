@@ -19,8 +19,11 @@
 #define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AVS_DIRECTIVE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 
+#include <rapidjson/document.h>
+
 #include "Attachment/AttachmentManagerInterface.h"
 #include "AVSMessage.h"
 
@@ -50,6 +53,31 @@ public:
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager,
         const std::string& attachmentContextId);
 
+    /**
+     * Create an AVSDirective object which shares the document that @c unparsedDirective was parsed into, so that
+     * handlers can read the payload through @c getPayloadValue() without parsing it again.
+     *
+     * @param unparsedDirective The unparsed directive JSON string from AVS.
+     * @param parsedDirective The document @c unparsedDirective was parsed into.  It must not be modified afterwards.
+     * @param avsMessageHeader The header fields of the directive.
+     * @param payload The payload of the directive.
+     * @param attachmentManager The attachment manager.
+     * @param attachmentContextId The contextId required to get attachments from the AttachmentManager.
+     * @return The created AVSDirective object or @c nullptr if creation failed.
+     */
+    static std::unique_ptr<AVSDirective> create(
+        const std::string& unparsedDirective,
+        std::shared_ptr<const rapidjson::Document> parsedDirective,
+        std::shared_ptr<AVSMessageHeader> avsMessageHeader,
+        const std::string& payload,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager,
+        const std::string& attachmentContextId);
+
+    /**
+     * Destructor.  Releases the reference this directive holds on its attachments.
+     */
+    ~AVSDirective();
+
     /**
      * Returns a reader for the attachment associated with this directive.
      *
@@ -64,13 +92,23 @@ public:
     /**
      * Returns the underlying unparsed directive.
      */
-    std::string getUnparsedDirective() const;
+    const std::string& getUnparsedDirective() const;
+
+    /**
+     * Returns the parsed payload of this directive.  If the directive was created without a parsed document, the
+     * payload is parsed on the first call and the result is kept for later calls.
+     *
+     * @return The parsed payload, or @c nullptr if the payload is not valid JSON.  The value remains valid for the
+     *     lifetime of this directive.
+     */
+    const rapidjson::Value* getPayloadValue() const;
 
 private:
     /**
      * Constructor.
      *
      * @param unparsedDirective The unparsed directive JSON string from AVS.
+     * @param parsedDirective The document @c unparsedDirective was parsed into, or @c nullptr.
      * @param avsMessageHeader The object representation of an AVS message header.
      * @param payload The payload of an AVS message.
      * @param attachmentManager The attachment manager object.
@@ -78,6 +116,7 @@ private:
      */
     AVSDirective(
         const std::string& unparsedDirective,
+        std::shared_ptr<const rapidjson::Document> parsedDirective,
         std::shared_ptr<AVSMessageHeader> avsMessageHeader,
         const std::string& payload,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager,
@@ -89,6 +128,12 @@ private:
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> m_attachmentManager;
     /// The contextId needed to acquire the right attachment from the attachmentManager.
     std::string m_attachmentContextId;
+    /// The parsed directive shared with the @c MessageInterpreter, or the separately parsed payload.
+    mutable std::shared_ptr<const rapidjson::Document> m_parsedDocument;
+    /// The payload within @c m_parsedDocument, or @c nullptr if it has not been (or could not be) parsed.
+    mutable const rapidjson::Value* m_payloadValue;
+    /// Ensures that a payload without a parsed document is parsed at most once.
+    mutable std::once_flag m_payloadParsedFlag;
 };
 
 }  // namespace avs
@@ -52,35 +52,43 @@ public:
      *
      * @return The namespace.
      */
-    std::string getNamespace() const;
+    const std::string& getNamespace() const;
 
     /**
      * Returns The name of the message, which describes the intent.
      *
      * @return The name.
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
      * Returns The message ID of the message.
      *
      * @return The message ID, a unique ID used to identify a specific message.
      */
-    std::string getMessageId() const;
+    const std::string& getMessageId() const;
 
     /**
      * Returns The dialog request ID of the message.
      *
      * @return The dialog request ID, a unique ID for the messages that are part of the same dialog.
      */
-    std::string getDialogRequestId() const;
+    const std::string& getDialogRequestId() const;
+
+    /**
+     * Returns the interned id of the namespace and name of the message.
+     *
+     * @return The id, or @c NamespaceAndNameInterner::INVALID_ID if the namespace and name had not been interned when
+     * the message was created.
+     */
+    NamespaceAndNameInterner::Id getNamespaceAndNameId() const;
 
     /**
      * Returns the payload of the message.
      *
      * @return The payload.
      */
-    std::string getPayload() const;
+    const std::string& getPayload() const;
 
     /**
      * Return a string representation of this @c AVSMessage's header.
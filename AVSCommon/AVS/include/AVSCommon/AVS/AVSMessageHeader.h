@@ -19,6 +19,9 @@
 #define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AVS_MESSAGE_HEADER_H_
 
 #include <string>
+#include <utility>
+
+#include "AVSCommon/AVS/NamespaceAndNameInterner.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -38,14 +41,15 @@ public:
      * @param avsDialogRequestId The dialog request ID of an AVS message, which is optional.
      */
     AVSMessageHeader(
-        const std::string& avsNamespace,
-        const std::string& avsName,
-        const std::string& avsMessageId,
-        const std::string& avsDialogRequestId = "") :
-            m_namespace{avsNamespace},
-            m_name{avsName},
-            m_messageId{avsMessageId},
-            m_dialogRequestId{avsDialogRequestId} {
+        std::string avsNamespace,
+        std::string avsName,
+        std::string avsMessageId,
+        std::string avsDialogRequestId = "") :
+            m_namespace{std::move(avsNamespace)},
+            m_name{std::move(avsName)},
+            m_messageId{std::move(avsMessageId)},
+            m_dialogRequestId{std::move(avsDialogRequestId)},
+            m_namespaceAndNameId{NamespaceAndNameInterner::find(m_namespace, m_name)} {
     }
 
     /**
@@ -53,28 +57,36 @@ public:
      *
      * @return The namespace.
      */
-    std::string getNamespace() const;
+    const std::string& getNamespace() const;
 
     /**
      * Returns the name in an AVS message, which describes the intent of the message.
      *
      * @return The name.
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
      * Returns the message ID in an AVS message.
      *
      * @return The message ID, a unique ID used to identify a specific message.
      */
-    std::string getMessageId() const;
+    const std::string& getMessageId() const;
 
     /**
      * Returns the dialog request ID in an AVS message.
      *
      * @return The dialog request ID, a unique ID for the messages that are part of the same dialog.
      */
-    std::string getDialogRequestId() const;
+    const std::string& getDialogRequestId() const;
+
+    /**
+     * Returns the interned id of the namespace and name of an AVS message.
+     *
+     * @return The id, or @c NamespaceAndNameInterner::INVALID_ID if the namespace and name had not been interned when
+     * the header was created.
+     */
+    NamespaceAndNameInterner::Id getNamespaceAndNameId() const;
 
     /**
      * Return a string representation of this @c AVSMessage's header.
@@ -92,6 +104,9 @@ private:
     const std::string m_messageId;
     /// A unique ID for the messages that are part of the same dialog.
     const std::string m_dialogRequestId;
+
+    /// The interned id of @c m_namespace and @c m_name.
+    const NamespaceAndNameInterner::Id m_namespaceAndNameId;
 };
 
 }  // namespace avs
@@ -0,0 +1,142 @@
+/*
+ * AsyncRequests.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ASYNC_REQUESTS_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ASYNC_REQUESTS_H_
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "AVSCommon/AVS/MessageRequest.h"
+#include "AVSCommon/SDKInterfaces/ContextManagerInterface.h"
+#include "AVSCommon/SDKInterfaces/ContextRequesterInterface.h"
+#include "AVSCommon/SDKInterfaces/MessageRequestObserverInterface.h"
+#include "AVSCommon/SDKInterfaces/MessageSenderInterface.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/*
+ * Variants of @c MessageSenderInterface::sendMessage() and @c ContextManagerInterface::getContext() which report their
+ * outcome to a continuation or through a @c std::future, so that callers need neither a @c MessageRequest subclass nor
+ * a @c ContextRequesterInterface of their own.
+ *
+ * Continuations are called on the thread which completes the request, so like the observers they replace they should
+ * return quickly.  A continuation may start the next request of a pipeline without blocking any thread.
+ */
+
+/// A continuation called with the outcome of sending a message.
+using SendCompletedCallback = std::function<void(sdkInterfaces::MessageRequestObserverInterface::Status status)>;
+
+/// A continuation called with the context, once it is available.
+using ContextAvailableCallback = std::function<void(const std::string& jsonContext)>;
+
+/// A continuation called with the reason why the context is not available.
+using ContextFailureCallback = std::function<void(sdkInterfaces::ContextRequestError error)>;
+
+/// The outcome of a request for the context made with @c getContextAsync().
+struct ContextResult {
+    /// Whether the context is available.  If it is not, @c error says why.
+    bool isAvailable;
+
+    /// The context, if it is available.
+    std::string jsonContext;
+
+    /// Why the context is not available, if it is not.
+    sdkInterfaces::ContextRequestError error;
+};
+
+/**
+ * Send a message, and call a continuation once it has been sent or has failed.
+ *
+ * @note The continuation is called by @c MessageRequest::sendCompleted(), so it is not called for subclasses which
+ * override that method without calling it.
+ *
+ * @param messageSender The sender of the message.
+ * @param request The message to send.
+ * @param onCompleted The continuation to call with the outcome of sending the message.  If @c messageSender or
+ * @c request is @c nullptr, it is called right away with @c INTERNAL_ERROR.
+ */
+void sendMessageAsync(
+    std::shared_ptr<sdkInterfaces::MessageSenderInterface> messageSender,
+    std::shared_ptr<MessageRequest> request,
+    SendCompletedCallback onCompleted);
+
+/**
+ * Send a message, and get a future for its outcome.
+ *
+ * @see sendMessageAsync(std::shared_ptr<sdkInterfaces::MessageSenderInterface>, std::shared_ptr<MessageRequest>,
+ * SendCompletedCallback)
+ *
+ * @param messageSender The sender of the message.
+ * @param request The message to send.
+ * @return A future for the outcome of sending the message.
+ */
+std::future<sdkInterfaces::MessageRequestObserverInterface::Status> sendMessageAsync(
+    std::shared_ptr<sdkInterfaces::MessageSenderInterface> messageSender,
+    std::shared_ptr<MessageRequest> request);
+
+/**
+ * Request the context, and call one of two continuations once it is available or has failed.
+ *
+ * @param contextManager The @c ContextManager to request the context from.
+ * @param onAvailable The continuation to call with the context.
+ * @param onFailure The continuation to call if the context is not available.  If @c contextManager is @c nullptr, it
+ * is called right away with @c BUILD_CONTEXT_ERROR.
+ */
+void getContextAsync(
+    std::shared_ptr<sdkInterfaces::ContextManagerInterface> contextManager,
+    ContextAvailableCallback onAvailable,
+    ContextFailureCallback onFailure);
+
+/**
+ * Request the context, and get a future for it.
+ *
+ * @param contextManager The @c ContextManager to request the context from.
+ * @return A future for the context, or for the reason it is not available.
+ */
+std::future<ContextResult> getContextAsync(std::shared_ptr<sdkInterfaces::ContextManagerInterface> contextManager);
+
+/**
+ * Request the context, build an event with it, and send the event: the context-build-send pipeline of most events,
+ * without blocking a thread while the context is gathered.
+ *
+ * @param contextManager The @c ContextManager to request the context from.
+ * @param messageSender The sender of the event.
+ * @param nameSpace The namespace of the event.
+ * @param eventName The name of the event.
+ * @param dialogRequestIdValue The @c dialogRequestId of the event, or empty if it has none.
+ * @param jsonPayloadValue The payload of the event.
+ * @return A future for the outcome of sending the event.  It is @c INTERNAL_ERROR if the context is not available or
+ * the event can not be built.
+ */
+std::future<sdkInterfaces::MessageRequestObserverInterface::Status> sendEventWithContextAsync(
+    std::shared_ptr<sdkInterfaces::ContextManagerInterface> contextManager,
+    std::shared_ptr<sdkInterfaces::MessageSenderInterface> messageSender,
+    const std::string& nameSpace,
+    const std::string& eventName,
+    const std::string& dialogRequestIdValue = "",
+    const std::string& jsonPayloadValue = "{}");
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ASYNC_REQUESTS_H_
@@ -84,6 +84,14 @@ public:
      */
     bool hasCreatedWriter();
 
+    /**
+     * Utility function to tell if a reader or writer created for this object may still be in use.  Implementations
+     * which cannot tell report @c true.
+     *
+     * @return Whether a reader or writer created for this object has not been destroyed yet.
+     */
+    virtual bool hasLiveReaderOrWriter() const;
+
 protected:
     /// The id for this attachment object.
     const std::string m_id;
@@ -0,0 +1,193 @@
+/*
+ * AttachmentBufferPool.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_BUFFER_POOL_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
+#include "AVSCommon/Utils/Memory/MemoryBudget.h"
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * A pool of the buffers which back @c InProcessAttachment streams.
+ *
+ * Buffers come in a few size classes.  A buffer is taken from the smallest class which holds the size asked for, or
+ * from the largest class if the size is unknown or larger; the stream is a ring buffer, so a payload larger than its
+ * buffer still streams through it as long as the reader keeps up.  Since attachment writers write all or nothing, the
+ * smallest class must be larger than any single write.  When the last reference to a buffer is dropped, it is kept for
+ * reuse unless its class already holds as many free buffers as allowed.
+ *
+ * Each buffer is reserved from a @c MemoryBudget for as long as it exists, including while it is kept for reuse.  If
+ * the budget cannot grant the size class asked for, the free buffers are released and the reservation is asked for
+ * again, and then the buffer is taken from the largest class which fits what the budget grants.  The smallest class
+ * is the least a request can be shrunk to; if even that is refused, no buffer is returned.
+ *
+ * This class is thread safe, and buffers may outlive the pool.
+ */
+class AttachmentBufferPool : public std::enable_shared_from_this<AttachmentBufferPool> {
+public:
+    /// The default data sizes of the size classes, in bytes.  The largest is the size of an unpooled attachment.
+    static const std::vector<size_t> DEFAULT_SIZE_CLASSES;
+
+    /// The default number of free buffers kept for reuse in each size class.
+    static const size_t DEFAULT_MAX_FREE_BUFFERS_PER_CLASS = 2;
+
+    /**
+     * Creates an @c AttachmentBufferPool.
+     *
+     * @param sizeClasses The data sizes of the size classes, in bytes, in increasing order.
+     * @param maxFreeBuffersPerClass The number of free buffers kept for reuse in each size class.
+     * @param budget The budget the buffers are reserved from, or @c nullptr for @c MemoryBudget::getDefault().
+     * @return A new @c AttachmentBufferPool, or @c nullptr if @c sizeClasses is empty, not increasing, or has a zero.
+     */
+    static std::shared_ptr<AttachmentBufferPool> create(
+        const std::vector<size_t>& sizeClasses = DEFAULT_SIZE_CLASSES,
+        size_t maxFreeBuffersPerClass = DEFAULT_MAX_FREE_BUFFERS_PER_CLASS,
+        std::shared_ptr<utils::memory::MemoryBudget> budget = nullptr);
+
+    /**
+     * Gets a buffer which can be used to create an @c InProcessAttachment::SDSType.
+     *
+     * @param dataSize The number of bytes the attachment is expected to hold, or zero if it is not known.
+     * @param priority The priority of the buffer in the budget.
+     * @return A buffer from the smallest size class which holds @c dataSize bytes, or from the largest size class,
+     * or from a smaller class if the budget is short.  @c nullptr if the budget refuses even the smallest class.
+     */
+    std::shared_ptr<InProcessAttachment::SDSBufferType> acquireBuffer(
+        size_t dataSize = 0,
+        utils::memory::MemoryBudget::Priority priority = utils::memory::MemoryBudget::Priority::NORMAL);
+
+    /**
+     * Gets an @c InProcessAttachment::SDSType backed by a pooled buffer.
+     *
+     * @param dataSize The number of bytes the attachment is expected to hold, or zero if it is not known.
+     * @param priority The priority of the buffer in the budget.
+     * @return A new stream, or @c nullptr if the budget refuses its buffer or it could not be created.
+     */
+    std::unique_ptr<InProcessAttachment::SDSType> createStream(
+        size_t dataSize = 0,
+        utils::memory::MemoryBudget::Priority priority = utils::memory::MemoryBudget::Priority::NORMAL);
+
+    /**
+     * Gets the number of free buffers kept for reuse.
+     *
+     * @return The number of free buffers kept for reuse.
+     */
+    size_t getFreeBufferCount() const;
+
+private:
+    /// A buffer kept for reuse, with the reservation it keeps in the budget.
+    struct FreeBuffer {
+        /// The buffer.
+        std::unique_ptr<InProcessAttachment::SDSBufferType> buffer;
+
+        /// The reservation of the buffer.
+        std::shared_ptr<utils::memory::MemoryBudget::Reservation> reservation;
+    };
+
+    /// The free buffers of one size class.
+    struct SizeClass {
+        /// The size of the buffers of this class, including the stream header.
+        size_t bufferSize;
+
+        /// The free buffers of this class.
+        std::vector<FreeBuffer> freeBuffers;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param sizeClasses The data sizes of the size classes, in bytes, in increasing order.
+     * @param maxFreeBuffersPerClass The number of free buffers kept for reuse in each size class.
+     * @param budget The budget the buffers are reserved from.
+     */
+    AttachmentBufferPool(
+        const std::vector<size_t>& sizeClasses,
+        size_t maxFreeBuffersPerClass,
+        std::shared_ptr<utils::memory::MemoryBudget> budget);
+
+    /**
+     * Takes a free buffer of a size class, if there is one.
+     *
+     * @param index The index of the size class in @c m_sizeClasses.
+     * @return A free buffer, whose @c buffer is @c nullptr if there is none.
+     */
+    FreeBuffer takeFreeBuffer(size_t index);
+
+    /**
+     * Reserves a buffer of a size class from the budget, or of a smaller class if the budget is short.
+     *
+     * @param[in,out] index The index of the size class asked for, and then of the class granted.
+     * @param priority The priority of the buffer in the budget.
+     * @return The reservation, or @c nullptr if the budget refuses even the smallest class.
+     */
+    std::unique_ptr<utils::memory::MemoryBudget::Reservation> reserve(
+        size_t* index,
+        utils::memory::MemoryBudget::Priority priority);
+
+    /**
+     * Frees the buffers kept for reuse, returning their reservations to the budget.
+     *
+     * @return Whether any buffer was freed.
+     */
+    bool releaseFreeBuffers();
+
+    /**
+     * Keeps a buffer whose last reference was dropped for reuse, or frees it if its class is full.
+     *
+     * @param index The index of the size class of the buffer in @c m_sizeClasses.
+     * @param freeBuffer The buffer and its reservation.
+     */
+    void releaseBuffer(size_t index, FreeBuffer freeBuffer);
+
+    /**
+     * Count the free buffers in @c MemoryAccounting.  Called with @c m_mutex held.
+     */
+    void updateFreeMemoryLocked();
+
+    /// The number of free buffers kept for reuse in each size class.
+    const size_t m_maxFreeBuffersPerClass;
+
+    /// The budget the buffers are reserved from.
+    const std::shared_ptr<utils::memory::MemoryBudget> m_budget;
+
+    /// Serializes access to @c m_sizeClasses and @c m_freeMemory.
+    mutable std::mutex m_mutex;
+
+    /// The size classes, in increasing order of size.
+    std::vector<SizeClass> m_sizeClasses;
+
+    /// The free buffers, as counted in @c MemoryAccounting.  The buffers in use are counted by their deleters.
+    utils::metrics::MemoryAccounting::Allocation m_freeMemory;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_BUFFER_POOL_H_
@@ -18,10 +18,13 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_MANAGER_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_MANAGER_H_
 
+#include <array>
 #include <mutex>
 #include <unordered_map>
 
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
 #include "AVSCommon/AVS/Attachment/AttachmentManagerInterface.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -42,12 +45,10 @@ namespace attachment {
  *  @li An AttachmentReader or AttachmentWriter has reference to a shared buffer resource for the actual data.  This
  *    buffer will remain in existence until both the Reader and Writer have been destroyed.
  *  @li Therefore, application code should ensure that Readers and Writers are destroyed when no longer needed.
- *  @li The AttachmentManager will always satisfy a request to create a Reader or Writer - it will not currently
- *    enforce a maximum resource limit.
- *  @li ACSDK-254 will address this by enforcing such limits.  It should also be noted however, that a well
- *    behaving application may not observe much difference - the future implementation will forcibly close
- *    the oldest Attachment to make space for the new one.  For a system reading and writing a small set of attachments
- *    at any given time, the AttachmentManager should not need to step in and take such action.
+ *  @li The buffers of attachments are reserved from @c MemoryBudget::getDefault().  When the budget is short, new
+ *    attachments get smaller buffers, so that their writers wait for their readers sooner, or @c SPILLING
+ *    attachments spill to disk sooner.  When it is exhausted, attachments of a @c LOW or @c NORMAL priority manager
+ *    are refused, and neither a Reader nor a Writer is created for them.
  */
 class AttachmentManager : public AttachmentManagerInterface {
 public:
@@ -70,15 +71,32 @@ public:
      */
     enum class AttachmentType {
         /// This value corresponds to the @c InProcessAttachment class.
-        IN_PROCESS
+        IN_PROCESS,
+        /// This value corresponds to the @c SpillingAttachment class.
+        SPILLING
     };
 
+    /// The default largest number of bytes a @c SpillingAttachment may hold in its temporary file.
+    static const size_t DEFAULT_MAX_SPILL_SIZE_IN_BYTES = 16 * 1024 * 1024;
+
     /**
      * Constructor.
      *
      * @param attachmentType The type of attachments which will be managed.
+     * @param spillDirectory The directory to create the temporary files of @c SPILLING attachments in.
+     * @param maxSpillSize The largest number of bytes the temporary file of a @c SPILLING attachment may hold.
+     * @param priority The priority of the buffers of the attachments in @c MemoryBudget::getDefault().
      */
-    AttachmentManager(AttachmentType attachmentType);
+    AttachmentManager(
+        AttachmentType attachmentType,
+        const std::string& spillDirectory = "",
+        size_t maxSpillSize = DEFAULT_MAX_SPILL_SIZE_IN_BYTES,
+        utils::memory::MemoryBudget::Priority priority = utils::memory::MemoryBudget::Priority::NORMAL);
+
+    /**
+     * Destructor.
+     */
+    ~AttachmentManager();
 
     std::string generateAttachmentId(const std::string& contextId, const std::string& contentId) const override;
 
@@ -86,9 +104,39 @@ public:
 
     std::unique_ptr<AttachmentWriter> createWriter(const std::string& attachmentId) override;
 
+    std::unique_ptr<AttachmentWriter> createWriter(const std::string& attachmentId, size_t sizeHint) override;
+
     std::unique_ptr<AttachmentReader> createReader(const std::string& attachmentId, AttachmentReader::Policy policy)
         override;
 
+    void addAttachmentContextReference(const std::string& contextId) override;
+
+    void removeAttachmentContextReference(const std::string& contextId) override;
+
+    /**
+     * Sets how long an attachment which nothing can use any more is kept, in case the directive which reads it has
+     * not been created yet.
+     *
+     * @param gracePeriod How long, measured from the creation of the attachment.
+     */
+    void setUnreferencedAttachmentGracePeriod(std::chrono::milliseconds gracePeriod);
+
+    /**
+     * Gets the number of attachments being managed, which have not been handed off to both a reader and a writer.
+     *
+     * @return The number of attachments being managed.
+     */
+    size_t getNumberOfAttachments();
+
+    /**
+     * A cleanup function, which will release an @c AttachmentManagementDetails if its lifetime has exceeded the
+     * timeout, or if nothing can use it any more.  An attachment can no longer be used once the reader or writer
+     * created for it has been destroyed and no object referencing its context remains, and it has outlived a short
+     * grace period covering the delivery of its directive.  This is called periodically on a background timer, so
+     * that creating readers and writers does not have to scan the attachments.
+     */
+    void removeExpiredAttachments();
+
 private:
     /**
      * A utility structure to encapsulate an @c Attachment, its creation time, and other appropriate data fields.
@@ -103,34 +151,91 @@ private:
         std::chrono::steady_clock::time_point creationTime;
         /// The Attachment this object is managing.
         std::unique_ptr<Attachment> attachment;
+        /// Whether the memory budget refused the buffer of the attachment, so that it is not asked for again.
+        bool isRejected;
     };
 
+    /**
+     * One stripe of the attachments being managed.  Attachments are spread over the shards by the hash of their id,
+     * so that threads creating readers and writers for different attachments rarely wait on each other.
+     */
+    struct Shard {
+        /// Serializes access to @c attachmentDetailsMap.
+        std::mutex mutex;
+        /// The map of attachment details.
+        std::unordered_map<std::string, AttachmentManagementDetails> attachmentDetailsMap;
+    };
+
+    /// The number of shards.
+    static const size_t NUMBER_OF_SHARDS = 16;
+
+    /**
+     * Gets the shard holding an attachment.
+     *
+     * @param attachmentId The id of the attachment.
+     * @return The shard holding the attachment.
+     */
+    Shard& getShard(const std::string& attachmentId);
+
     /**
      * A utility function to acquire the details object for an attachment being managed.  This function
      * encapsulates logic to set up the object if it does not already exist, before returning it.
      *
-     * @note The class mutex @c m_mutex must be locked before calling this function.
+     * @note The mutex of @c shard must be locked before calling this function.
      *
+     * @param shard The shard holding the attachment.
      * @param attachmentId The attachment id for the attachment detail being requested.
+     * @param sizeHint The number of bytes the attachment is expected to hold, or zero if it is not known.  This is
+     * only used if the attachment is created.
      * @return The attachment detail object.
      */
-    AttachmentManagementDetails& getDetailsLocked(const std::string& attachmentId);
+    AttachmentManagementDetails& getDetailsLocked(Shard& shard, const std::string& attachmentId, size_t sizeHint = 0);
 
     /**
-     * A cleanup function, which will release an @c AttachmentManagementDetails from the map if either both a writer
-     * and reader have been created, or if its lifetime has exceeded the timeout.
-     * @note: @c m_mutex must be acquired before calling this function.
+     * Releases an @c AttachmentManagementDetails from its shard once both a writer and a reader have been created,
+     * as the reader and writer then own the attachment's data.
+     *
+     * @note The mutex of @c shard must be locked before calling this function.
+     *
+     * @param shard The shard holding the attachment.
+     * @param attachmentId The id of the attachment.
+     */
+    void removeIfHandedOffLocked(Shard& shard, const std::string& attachmentId);
+
+    /**
+     * Tells whether the context of an attachment is referenced.
+     *
+     * @param contextReferenceCounts A copy of @c m_contextReferenceCounts.
+     * @param attachmentId The id of the attachment.
+     * @return Whether @c addAttachmentContextReference() has been called more often than
+     * @c removeAttachmentContextReference() for the context of the attachment.
      */
-    void removeExpiredAttachmentsLocked();
+    static bool isContextReferenced(
+        const std::unordered_map<std::string, unsigned int>& contextReferenceCounts,
+        const std::string& attachmentId);
 
     /// The type of attachments that this manager will create.
     AttachmentType m_attachmentType;
+    /// The directory to create the temporary files of @c SPILLING attachments in.
+    const std::string m_spillDirectory;
+    /// The largest number of bytes the temporary file of a @c SPILLING attachment may hold.
+    const size_t m_maxSpillSize;
+    /// The priority of the buffers of the attachments in the memory budget.
+    const utils::memory::MemoryBudget::Priority m_priority;
+    /// The mutex to serialize access to the settings and reference counts below.
+    std::mutex m_mutex;
+    /// How long an attachment which nothing can use any more is kept after its creation.
+    std::chrono::milliseconds m_unreferencedAttachmentGracePeriod;
     /// The timeout in minutes.  Any attachment whose lifetime exceeds this value will be released.
     std::chrono::minutes m_attachmentExpirationMinutes;
-    /// The mutex to ensure the non-static public APIs are thread safe.
-    std::mutex m_mutex;
-    /// The map of attachment details.
-    std::unordered_map<std::string, AttachmentManagementDetails> m_attachmentDetailsMap;
+    /// The number of references to each referenced attachment context.
+    std::unordered_map<std::string, unsigned int> m_contextReferenceCounts;
+    /// The attachments being managed, striped by the hash of their ids.
+    std::array<Shard, NUMBER_OF_SHARDS> m_shards;
+    /// The pool of the buffers of in-process attachments.
+    std::shared_ptr<AttachmentBufferPool> m_bufferPool;
+    /// The timer calling @c removeExpiredAttachments().  This is declared last so that it is stopped first.
+    utils::timing::Timer m_sweepTimer;
 };
 
 }  // namespace attachment
@@ -90,6 +90,19 @@ public:
      */
     virtual std::unique_ptr<AttachmentWriter> createWriter(const std::string& attachmentId) = 0;
 
+    /**
+     * Returns a pointer to an @c AttachmentWriter, for an attachment whose size is expected to be known.  If the
+     * attachment has not been created yet, an implementation may use the size to choose the size of its buffer.
+     * @note Calls to @c createReader and @c createWriter may occur in any order.
+     *
+     * @param attachmentId The id of the @c Attachment.
+     * @param sizeHint The number of bytes the attachment is expected to hold, or zero if it is not known.
+     * @return An @c AttachmentWriter.
+     */
+    virtual std::unique_ptr<AttachmentWriter> createWriter(const std::string& attachmentId, size_t sizeHint) {
+        return createWriter(attachmentId);
+    }
+
     /**
      * Returns a pointer to an @c AttachmentReader.
      * @note Calls to @c createReader and @c createWriter may occur in any order.
@@ -101,6 +114,25 @@ public:
     virtual std::unique_ptr<AttachmentReader> createReader(
         const std::string& attachmentId,
         AttachmentReader::Policy policy) = 0;
+
+    /**
+     * Records that an object which may yet read attachments of a context, such as a directive, has been created.  An
+     * implementation keeps attachments which have not been read yet while their context is referenced, and may release
+     * them promptly once it is not, rather than when their timeout expires.  Each call must be matched by a call to
+     * @c removeAttachmentContextReference().
+     *
+     * @param contextId The contextId passed to @c generateAttachmentId() for the attachments.
+     */
+    virtual void addAttachmentContextReference(const std::string& contextId) {
+    }
+
+    /**
+     * Records that an object counted by @c addAttachmentContextReference() has been destroyed.
+     *
+     * @param contextId The contextId passed to @c addAttachmentContextReference().
+     */
+    virtual void removeAttachmentContextReference(const std::string& contextId) {
+    }
 };
 
 }  // namespace attachment
@@ -20,6 +20,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <functional>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -69,6 +70,14 @@ public:
         AFTER_DRAINING_CURRENT_BUFFER
     };
 
+    /// A buffer to read into, one of several passed to @c readv().
+    struct ReadBuffer {
+        /// Where the data should be copied to.
+        void* data;
+        /// The size of the buffer in bytes.
+        std::size_t numBytes;
+    };
+
     /*
      * Destructor.
      */
@@ -90,6 +99,46 @@ public:
         ReadStatus* readStatus,
         std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) = 0;
 
+    /**
+     * Read into several buffers at once, filling each before the next, as @c readv() does for files.  A consumer can
+     * take everything that is available in one call, rather than in a @c read() per buffer.
+     *
+     * The default implementation calls @c read() for each buffer, for as long as each is filled.
+     *
+     * @param buffers The buffers where data should be copied to.
+     * @param numBuffers The number of buffers.
+     * @param[out] readStatus The out-parameter where the resulting state of the read will be expressed.
+     * @param timeoutMs The timeout for this read call in milliseconds, as for @c read().
+     * @return The number of bytes read as a result of this call, across all of the buffers.
+     */
+    virtual std::size_t readv(
+        const ReadBuffer* buffers,
+        std::size_t numBuffers,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0));
+
+    /**
+     * Read at least a number of bytes, waiting for them to be written rather than returning each time some are
+     * available, so that a consumer is woken once per batch.  Fewer bytes are read if the timeout expires, if the
+     * attachment closes, or if this is a @c NON_BLOCKING reader, which never waits.
+     *
+     * The default implementation calls @c read() until enough bytes are read or the timeout expires.
+     *
+     * @param buf The buffer where data should be copied to.
+     * @param numBytes The size of the buffer in bytes.
+     * @param minBytes The number of bytes to wait for, which is limited to @c numBytes.
+     * @param[out] readStatus The out-parameter where the resulting state of the read will be expressed.  It is @c OK
+     *     if any bytes were read, even if fewer than @c minBytes.
+     * @param timeoutMs The timeout for this read call in milliseconds, as for @c read().
+     * @return The number of bytes read as a result of this call.
+     */
+    virtual std::size_t readAtLeast(
+        void* buf,
+        std::size_t numBytes,
+        std::size_t minBytes,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0));
+
     /**
      * The close function.  An implementation will take care of any resource management when a reader no longer
      * needs to use an attachment.
@@ -97,6 +146,20 @@ public:
      * @param closePoint The point at which the reader should stop reading from the attachment.
      */
     virtual void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) = 0;
+
+    /**
+     * Set a function to call when data may have become available to read, or the attachment may have closed, so that
+     * a @c NON_BLOCKING reader can be read as soon as there is something to read, rather than polled.  The function
+     * may be called on the thread writing the attachment, so it must not block, and must not call back into this
+     * reader.  Readers which can not call such a function return @c false, and must still be polled.
+     *
+     * @param callback The function to call, or an empty function to stop calls.  Once this returns, a function which
+     *     has been replaced is not running and will not be called again.
+     * @return Whether the reader will call @c callback.
+     */
+    virtual bool setDataAvailableCallback(std::function<void()> callback) {
+        return false;
+    }
 };
 
 }  // namespace attachment
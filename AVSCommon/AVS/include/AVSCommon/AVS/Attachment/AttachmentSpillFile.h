@@ -0,0 +1,162 @@
+/*
+ * AttachmentSpillFile.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_SPILL_FILE_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_SPILL_FILE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "AVSCommon/AVS/Attachment/AttachmentReader.h"
+#include "AVSCommon/AVS/Attachment/AttachmentWriter.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * An append-only temporary file which holds the part of an attachment which did not fit in its in-memory buffer.
+ *
+ * The file is created in a directory when spilling starts, and is unlinked at once, so that it is removed when this
+ * object is destroyed, even if the process dies.  One writer appends to the file, while one reader reads it from its
+ * own offset; reads of data which has not been written yet wait for it, as reads of an @c InProcessAttachment do.
+ *
+ * This class is thread safe.
+ */
+class AttachmentSpillFile {
+public:
+    /**
+     * Creates an @c AttachmentSpillFile.  No file is created until @c start() is called.
+     *
+     * @param directory The directory to create the file in.
+     * @param maxSize The largest number of bytes the file may hold.
+     * @return A new @c AttachmentSpillFile, or @c nullptr if @c directory is empty or @c maxSize is zero.
+     */
+    static std::shared_ptr<AttachmentSpillFile> create(const std::string& directory, size_t maxSize);
+
+    /**
+     * Destructor.  Closes and so removes the file.
+     */
+    ~AttachmentSpillFile();
+
+    /**
+     * Creates the file, if it has not been created yet.
+     *
+     * @return Whether the file exists.
+     */
+    bool start();
+
+    /**
+     * Reports whether the file has been created.
+     *
+     * @return Whether @c start() has succeeded.
+     */
+    bool isStarted() const;
+
+    /**
+     * Appends data to the file.  Once the reader has closed, the data is discarded as if it had been written, as an
+     * @c InProcessAttachment without a reader does.
+     *
+     * @param buf The data to append.
+     * @param numBytes The number of bytes of @c buf.
+     * @param[out] writeStatus The result of the write.  @c OK_BUFFER_FULL means that the data would make the file
+     *     larger than its maximum size.
+     * @return The number of bytes written, which is @c numBytes or zero.
+     */
+    size_t write(const void* buf, size_t numBytes, AttachmentWriter::WriteStatus* writeStatus);
+
+    /**
+     * Marks the end of the data, so that the reader gets @c CLOSED once it has read everything.
+     */
+    void closeWriter();
+
+    /**
+     * Reads data from the file.
+     *
+     * @param offset The offset in the file of the first byte to read.
+     * @param buf The buffer to copy the data to.
+     * @param numBytes The size of @c buf in bytes.
+     * @param policy Whether to wait for data which has not been written yet.
+     * @param timeout How long to wait for data if @c policy is @c BLOCKING, or zero to wait forever.
+     * @param[out] readStatus The result of the read.
+     * @return The number of bytes read.
+     */
+    size_t read(
+        size_t offset,
+        void* buf,
+        size_t numBytes,
+        AttachmentReader::Policy policy,
+        std::chrono::milliseconds timeout,
+        AttachmentReader::ReadStatus* readStatus);
+
+    /**
+     * Marks the reader as gone, so that any further data is discarded.
+     */
+    void closeReader();
+
+    /**
+     * Gets the number of bytes written to the file.
+     *
+     * @return The number of bytes written to the file.
+     */
+    size_t getSize() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param directory The directory to create the file in.
+     * @param maxSize The largest number of bytes the file may hold.
+     */
+    AttachmentSpillFile(const std::string& directory, size_t maxSize);
+
+    /// The directory to create the file in.
+    const std::string m_directory;
+
+    /// The largest number of bytes the file may hold.
+    const size_t m_maxSize;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// Notified when data is written, and when the writer or the reader closes.
+    std::condition_variable m_wakeTrigger;
+
+    /// The descriptor of the file, or -1 if it has not been created.
+    int m_fd;
+
+    /// The number of bytes written to the file.
+    size_t m_size;
+
+    /// Whether the writer has closed.
+    bool m_isWriterClosed;
+
+    /// Whether the reader has closed.
+    bool m_isReaderClosed;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_ATTACHMENT_SPILL_FILE_H_
@@ -53,6 +53,8 @@ public:
 
     std::unique_ptr<AttachmentReader> createReader(AttachmentReader::Policy policy) override;
 
+    bool hasLiveReaderOrWriter() const override;
+
 private:
     // The sds from which we will create the reader and writer.
     std::shared_ptr<SDSType> m_sds;
@@ -69,8 +69,36 @@ public:
         ReadStatus* readStatus,
         std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
 
+    /**
+     * @inheritDoc
+     * The data is copied straight out of the underlying @c SharedDataStream into the buffers.
+     */
+    std::size_t readv(
+        const ReadBuffer* buffers,
+        std::size_t numBuffers,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
+
+    /**
+     * @inheritDoc
+     * A @c BLOCKING reader is woken once, when @c minBytes are available, rather than by each write.
+     */
+    std::size_t readAtLeast(
+        void* buf,
+        std::size_t numBytes,
+        std::size_t minBytes,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
+
     void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) override;
 
+    /**
+     * @inheritDoc
+     * The function is called when a @c Writer of the underlying @c SharedDataStream in this process commits data
+     * or closes.
+     */
+    bool setDataAvailableCallback(std::function<void()> callback) override;
+
 private:
     /**
      * Constructor.
@@ -80,6 +108,9 @@ private:
      */
     InProcessAttachmentReader(Policy policy, std::shared_ptr<SDSType> sds);
 
+    /// The underlying @c SharedDataStream, held so that its attachment can tell this object still exists.
+    std::shared_ptr<SDSType> m_sds;
+
     /// The underlying @c SharedDataStream reader.
     std::shared_ptr<SDSTypeReader> m_reader;
 };
@@ -66,6 +66,9 @@ protected:
 
     /// The underlying @c SharedDataStream reader.
     std::shared_ptr<SDSTypeWriter> m_writer;
+
+    /// The underlying @c SharedDataStream, held so that its attachment can tell this object still exists.
+    std::shared_ptr<SDSType> m_sds;
 };
 
 }  // namespace attachment
@@ -0,0 +1,76 @@
+/*
+ * SpillingAttachment.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_H_
+
+#include <memory>
+#include <string>
+
+#include "AVSCommon/AVS/Attachment/Attachment.h"
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
+#include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * A class that represents an AVS attachment held in memory, like an @c InProcessAttachment, until its in-memory
+ * buffer is full, and then in a temporary file.  A reader slower than the writer therefore does not block the writer,
+ * and so does not stall the network stream the attachment arrives on, until the file reaches its maximum size.
+ */
+class SpillingAttachment : public Attachment {
+public:
+    /// Type aliases for convenience.
+    using SDSType = InProcessAttachment::SDSType;
+
+    /**
+     * Constructor.
+     *
+     * @param id The attachment id.
+     * @param spillDirectory The directory to create the temporary file in.
+     * @param maxSpillSize The largest number of bytes the temporary file may hold.
+     * @param sds The in-memory buffer.  If not specified, then this class will create its own.
+     */
+    SpillingAttachment(
+        const std::string& id,
+        const std::string& spillDirectory,
+        size_t maxSpillSize,
+        std::unique_ptr<SDSType> sds = nullptr);
+
+    std::unique_ptr<AttachmentWriter> createWriter() override;
+
+    std::unique_ptr<AttachmentReader> createReader(AttachmentReader::Policy policy) override;
+
+    bool hasLiveReaderOrWriter() const override;
+
+private:
+    /// The in-memory buffer.
+    std::shared_ptr<SDSType> m_sds;
+
+    /// The temporary file the attachment spills into, or @c nullptr if it could not be created.
+    std::shared_ptr<AttachmentSpillFile> m_spillFile;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_H_
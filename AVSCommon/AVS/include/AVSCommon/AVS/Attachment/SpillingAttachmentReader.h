@@ -0,0 +1,108 @@
+/*
+ * SpillingAttachmentReader.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_READER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_READER_H_
+
+#include <memory>
+
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
+#include "AVSCommon/AVS/Attachment/InProcessAttachmentReader.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * A class that reads a @c SpillingAttachment: first its in-memory buffer, and then, once the writer has closed the
+ * buffer to spill, its @c AttachmentSpillFile.
+ *
+ * @note This class is not thread-safe beyond the thread-safety provided by the underlying objects.
+ */
+class SpillingAttachmentReader : public AttachmentReader {
+public:
+    /// Type aliases for convenience.
+    using SDSType = avsCommon::utils::sds::InProcessSDS;
+
+    /**
+     * Create a SpillingAttachmentReader.
+     *
+     * @param policy The @c AttachmentReader::Policy of this object.
+     * @param sds The in-memory buffer of the attachment.
+     * @param spillFile The file the attachment spills into.
+     * @return Returns a new SpillingAttachmentReader, or nullptr if the operation failed.
+     */
+    static std::unique_ptr<SpillingAttachmentReader> create(
+        Policy policy,
+        std::shared_ptr<SDSType> sds,
+        std::shared_ptr<AttachmentSpillFile> spillFile);
+
+    /**
+     * Destructor.
+     */
+    ~SpillingAttachmentReader();
+
+    std::size_t read(
+        void* buf,
+        std::size_t numBytes,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
+
+    void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param policy The @c AttachmentReader::Policy of this object.
+     * @param bufferReader The reader of the in-memory buffer.
+     * @param spillFile The file the attachment spills into.
+     */
+    SpillingAttachmentReader(
+        Policy policy,
+        std::unique_ptr<InProcessAttachmentReader> bufferReader,
+        std::shared_ptr<AttachmentSpillFile> spillFile);
+
+    /// The @c AttachmentReader::Policy of this object.
+    const Policy m_policy;
+
+    /// The reader of the in-memory buffer.
+    std::unique_ptr<InProcessAttachmentReader> m_bufferReader;
+
+    /// The file the attachment spills into.
+    std::shared_ptr<AttachmentSpillFile> m_spillFile;
+
+    /// Whether the in-memory buffer has been read to its end, so that reads go to @c m_spillFile.
+    bool m_isReadingSpillFile;
+
+    /// The offset in @c m_spillFile of the next byte to read.
+    size_t m_spillOffset;
+
+    /// The offset in @c m_spillFile at which reading stops, set by @c close().
+    size_t m_spillLimit;
+
+    /// Whether the reader has been closed immediately.
+    bool m_isClosed;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_READER_H_
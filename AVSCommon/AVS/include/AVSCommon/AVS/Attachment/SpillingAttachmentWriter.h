@@ -0,0 +1,89 @@
+/*
+ * SpillingAttachmentWriter.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_WRITER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_WRITER_H_
+
+#include <memory>
+
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
+#include "AVSCommon/AVS/Attachment/InProcessAttachmentWriter.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * A class that writes a @c SpillingAttachment.  Data goes to the in-memory buffer until a write finds it full; the
+ * buffer is then closed, so that the reader gets to its end, and that write and all later ones go to the
+ * @c AttachmentSpillFile.  A write only reports @c OK_BUFFER_FULL if the spill file cannot be created or is full.
+ *
+ * @note This class is not thread-safe beyond the thread-safety provided by the underlying objects.
+ */
+class SpillingAttachmentWriter : public AttachmentWriter {
+public:
+    /// Type aliases for convenience.
+    using SDSType = avsCommon::utils::sds::InProcessSDS;
+
+    /**
+     * Create a SpillingAttachmentWriter.
+     *
+     * @param sds The in-memory buffer of the attachment.
+     * @param spillFile The file the attachment spills into.
+     * @return Returns a new SpillingAttachmentWriter, or nullptr if the operation failed.
+     */
+    static std::unique_ptr<SpillingAttachmentWriter> create(
+        std::shared_ptr<SDSType> sds,
+        std::shared_ptr<AttachmentSpillFile> spillFile);
+
+    /**
+     * Destructor.
+     */
+    ~SpillingAttachmentWriter();
+
+    std::size_t write(const void* buf, std::size_t numBytes, WriteStatus* writeStatus) override;
+
+    void close() override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param bufferWriter The writer of the in-memory buffer.
+     * @param spillFile The file the attachment spills into.
+     */
+    SpillingAttachmentWriter(
+        std::unique_ptr<InProcessAttachmentWriter> bufferWriter,
+        std::shared_ptr<AttachmentSpillFile> spillFile);
+
+    /// The writer of the in-memory buffer.
+    std::unique_ptr<InProcessAttachmentWriter> m_bufferWriter;
+
+    /// The file the attachment spills into.
+    std::shared_ptr<AttachmentSpillFile> m_spillFile;
+
+    /// Whether writes go to @c m_spillFile.
+    bool m_isSpilling;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_ATTACHMENT_SPILLING_ATTACHMENT_WRITER_H_
@@ -0,0 +1,164 @@
+/*
+ * AudioChannelReader.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AUDIO_CHANNEL_READER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AUDIO_CHANNEL_READER_H_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "AVSCommon/AVS/AudioInputIngester.h"
+#include "AVSCommon/AVS/AudioInputStream.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A view of an @c AudioInputStream::Reader of multi-channel audio, which reads one channel of it, all of its
+ * channels, or their mix, as the 16-bit samples the rest of the SDK uses.
+ *
+ * An array microphone writes interleaved frames of all of its channels to one stream, and each consumer reads the
+ * channel it needs through a view of its own reader: a keyword detector one beam, the @c AudioInputProcessor another,
+ * a voice activity detector the raw first microphone.  The samples are converted straight out of the stream's buffer
+ * by the vector kernels of @c avsCommon::utils::audio, so no stream or buffer is duplicated for a consumer.
+ *
+ * Positions in the stream, as used by the @c seek(), @c tell() and @c close() of the underlying reader, remain in
+ * words of the stream; a frame is @c getWordsPerFrame() words.
+ *
+ * This class is not thread-safe; a view is used by the consumer of its reader.
+ */
+class AudioChannelReader {
+public:
+    /// The value of @c channel which reads all channels, still interleaved.
+    static const int ALL_CHANNELS = -1;
+
+    /// The value of @c channel which reads the mean of the channels of each frame.
+    static const int MIX_CHANNELS = -2;
+
+    /**
+     * Create an @c AudioChannelReader.
+     *
+     * @param reader The reader of the stream.
+     * @param sampleType The type of the samples in the stream, which are in the byte order of the host.
+     * @param numChannels The number of interleaved channels in the stream.
+     * @param channel The index of the channel to read, or @c ALL_CHANNELS, or @c MIX_CHANNELS.
+     * @return The new @c AudioChannelReader, or @c nullptr if the channel does not exist, or the word size of the
+     *     stream is odd, or a frame is not a whole number of words of the stream.
+     */
+    static std::unique_ptr<AudioChannelReader> create(
+        std::shared_ptr<AudioInputStream::Reader> reader,
+        AudioInputIngester::SampleType sampleType,
+        unsigned int numChannels,
+        int channel);
+
+    /**
+     * Consume frames from the stream, and convert them.
+     *
+     * @param buf Where to put the converted samples.  It must hold @c numFrames times @c getOutputChannels() samples.
+     * @param numFrames The maximum number of frames to read.
+     * @param timeout The maximum time to wait for data, as for @c AudioInputStream::Reader::read().
+     * @return The number of frames read, or zero if the stream has closed, or a negative
+     *     @c AudioInputStream::Reader::Error code if no frame could be read.  @c Error::WOULDBLOCK is also returned
+     *     when less than a whole frame is available.
+     */
+    ssize_t read(int16_t* buf, size_t numFrames, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * Get the number of samples each frame is read as.
+     *
+     * @return @c numChannels when reading @c ALL_CHANNELS, and one otherwise.
+     */
+    unsigned int getOutputChannels() const;
+
+    /**
+     * Get the number of words of the stream in a frame.
+     *
+     * @return The number of words of the stream in a frame.
+     */
+    size_t getWordsPerFrame() const;
+
+    /**
+     * Get the underlying reader, to seek it or close it.
+     *
+     * @return The underlying reader.
+     */
+    std::shared_ptr<AudioInputStream::Reader> getReader() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param reader The reader of the stream.
+     * @param sampleType The type of the samples in the stream.
+     * @param numChannels The number of interleaved channels in the stream.
+     * @param channel The index of the channel to read, or @c ALL_CHANNELS, or @c MIX_CHANNELS.
+     * @param wordsPerFrame The number of words of the stream in a frame.
+     */
+    AudioChannelReader(
+        std::shared_ptr<AudioInputStream::Reader> reader,
+        AudioInputIngester::SampleType sampleType,
+        unsigned int numChannels,
+        int channel,
+        size_t wordsPerFrame);
+
+    /**
+     * Convert whole frames.
+     *
+     * @param input The frames, which may be unaligned.
+     * @param numFrames The number of frames.
+     * @param output Where to put the converted samples.
+     */
+    void convert(const uint8_t* input, size_t numFrames, int16_t* output);
+
+    /// The reader of the stream.
+    const std::shared_ptr<AudioInputStream::Reader> m_reader;
+
+    /// The type of the samples in the stream.
+    const AudioInputIngester::SampleType m_sampleType;
+
+    /// The number of interleaved channels in the stream.
+    const unsigned int m_numChannels;
+
+    /// The index of the channel to read, or @c ALL_CHANNELS, or @c MIX_CHANNELS.
+    const int m_channel;
+
+    /// The number of words of the stream in a frame.
+    const size_t m_wordsPerFrame;
+
+    /// The number of bytes in a sample.
+    const size_t m_sampleSize;
+
+    /// A frame which wraps around the end of the stream's buffer, copied together.
+    std::vector<uint8_t> m_wrappedFrame;
+
+    /// 32-bit integer samples copied out of the stream, which may be unaligned in it, before they are narrowed.
+    std::vector<int32_t> m_int32Samples;
+
+    /// Floating point samples copied out of the stream, which may be unaligned in it, before they are narrowed.
+    std::vector<float> m_floatSamples;
+
+    /// Samples of wider types narrowed to 16 bits, before they are mixed.
+    std::vector<int16_t> m_int16Samples;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AUDIO_CHANNEL_READER_H_
@@ -0,0 +1,158 @@
+/*
+ * AudioInputIngester.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AUDIO_INPUT_INGESTER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AUDIO_INPUT_INGESTER_H_
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "AVSCommon/AVS/AudioInputStream.h"
+#include "AVSCommon/Utils/Audio/Decimator.h"
+#include "AVSCommon/Utils/AudioFormat.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * Converts the audio captured by a device to the format the rest of the SDK uses, and writes it to an
+ * @c AudioInputStream.
+ *
+ * The keyword detectors and the Recognize event expect 16-bit little-endian mono LPCM at 16 kHz.  Capture hardware
+ * often delivers more channels, wider samples, or a higher sample rate.  An @c AudioInputIngester mixes the channels
+ * of each frame down to one, converts the samples to 16 bits, and decimates them to 16 kHz, so that every reader of
+ * the stream gets audio it can use.  The conversions use the vector kernels of @c avsCommon::utils::audio.
+ *
+ * This class is not thread-safe; it is meant to be called from the capture thread.
+ */
+class AudioInputIngester {
+public:
+    /// The type of a captured sample.
+    enum class SampleType {
+        /// Signed 16-bit integer.
+        INT16,
+        /// Signed 32-bit integer.
+        INT32,
+        /// 32-bit floating point, in the range [-1.0, 1.0].
+        FLOAT32
+    };
+
+    /// The sample rate of the audio written to the stream.
+    static const unsigned int OUTPUT_SAMPLE_RATE_HZ = 16000;
+
+    /**
+     * Create an @c AudioInputIngester.
+     *
+     * @param stream The stream to write to.  Its word size must be that of a 16-bit sample.
+     * @param sampleType The type of the captured samples, which are in the byte order of the host.
+     * @param sampleRateHz The sample rate of the captured audio.  It must be a multiple of @c OUTPUT_SAMPLE_RATE_HZ.
+     * @param numChannels The number of interleaved channels of the captured audio.
+     * @param policy The policy of the writer of @c stream.
+     * @return The new @c AudioInputIngester, or @c nullptr if the format is not supported or a writer could not be
+     *     created.
+     */
+    static std::unique_ptr<AudioInputIngester> create(
+        std::shared_ptr<AudioInputStream> stream,
+        SampleType sampleType,
+        unsigned int sampleRateHz,
+        unsigned int numChannels,
+        AudioInputStream::Writer::Policy policy = AudioInputStream::Writer::Policy::NONBLOCKABLE);
+
+    /**
+     * Get the format of the audio written to the stream.
+     *
+     * @return The format of the audio written to the stream.
+     */
+    static utils::AudioFormat getOutputFormat();
+
+    /**
+     * Convert captured audio, and write it to the stream.
+     *
+     * @param buf The captured audio, @c numChannels samples of @c sampleType per frame.
+     * @param numFrames The number of frames in @c buf.
+     * @return The number of 16 kHz mono samples written to the stream, or a negative
+     *     @c AudioInputStream::Writer::Error code if nothing could be written.  This is zero if the stream has closed,
+     *     or if @c numFrames is too few to produce a sample after decimation.  Audio which could not be written is
+     *     dropped.
+     */
+    ssize_t write(const void* buf, size_t numFrames);
+
+    /**
+     * Close the writer of the stream.
+     */
+    void close();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param writer The writer of the stream.
+     * @param sampleType The type of the captured samples.
+     * @param numChannels The number of interleaved channels of the captured audio.
+     * @param decimator The decimator to @c OUTPUT_SAMPLE_RATE_HZ, or @c nullptr if the audio is captured at that rate.
+     */
+    AudioInputIngester(
+        std::unique_ptr<AudioInputStream::Writer> writer,
+        SampleType sampleType,
+        unsigned int numChannels,
+        std::unique_ptr<utils::audio::Decimator> decimator);
+
+    /// The writer of the stream.
+    std::unique_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The type of the captured samples.
+    const SampleType m_sampleType;
+
+    /// The number of interleaved channels of the captured audio.
+    const unsigned int m_numChannels;
+
+    /// The decimator to @c OUTPUT_SAMPLE_RATE_HZ, or @c nullptr if the audio is captured at that rate.
+    std::unique_ptr<utils::audio::Decimator> m_decimator;
+
+    /// The captured samples converted to 16 bits, and then mixed down to mono in place.
+    std::vector<int16_t> m_samples;
+
+    /// The decimated samples.
+    std::vector<int16_t> m_output;
+};
+
+/**
+ * Write a @c SampleType value to an @c ostream as a string.
+ *
+ * @param stream The stream to write the value to.
+ * @param sampleType The value to write.
+ * @return The @c ostream that was passed in and written to.
+ */
+inline std::ostream& operator<<(std::ostream& stream, AudioInputIngester::SampleType sampleType) {
+    switch (sampleType) {
+        case AudioInputIngester::SampleType::INT16:
+            return stream << "INT16";
+        case AudioInputIngester::SampleType::INT32:
+            return stream << "INT32";
+        case AudioInputIngester::SampleType::FLOAT32:
+            return stream << "FLOAT32";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_AUDIO_INPUT_INGESTER_H_
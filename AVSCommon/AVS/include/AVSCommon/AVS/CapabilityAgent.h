@@ -18,9 +18,10 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_CAPABILITY_AGENT_H
 #define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_CAPABILITY_AGENT_H
 
-#include <unordered_map>
-#include <string>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "AVSCommon/AVS/NamespaceAndName.h"
 #include "AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h"
@@ -38,7 +39,7 @@ namespace avs {
  * @c CapabilityAgent implements methods which most capability agents will need, namely:
  * @li @c DirectiveHandlerInterface,
  * @li Building the JSON event string given the name, payload and context,
- * @li A map of the message Id to @c AVSDirective and @c DirectiveResultInterface.
+ * @li Tracking the @c AVSDirective and @c DirectiveResultInterface of each directive in flight.
  * Derived capability agents may extend this class. They may have to implement the following interfaces:
  * @li @c ChannelObserverInterface: To use the Activity Focus Manager Library,
  * @li @c StateProviderInterface: To provide state to the @c ContextManager.
@@ -59,11 +60,10 @@ public:
     /*
      * DirectiveHandlerInterface functions.
      *
-     * The following four functions implement the @c DirectiveHandlerInterface. Only the message Id is passed to the
-     * @c handleDirective and @c cancelDirective functions, so we need to maintain a mapping of the message Id to the
-     * @c AVSDirective and @c DirectiveHandlerResultInterface, i.e., @c DirectiveAndResultInterface. The
-     * @c DirectiveHandlerInterface functions call the functions of the same name with the
-     * @c DirectiveAndResultInterface as the argument.
+     * The following functions implement the @c DirectiveHandlerInterface. Only the directive or its message Id is
+     * passed to the @c handleDirective and @c cancelDirective functions, so we need to keep the @c DirectiveInfo of
+     * each pre-handled @c AVSDirective to find it again. The @c DirectiveHandlerInterface functions call the
+     * functions of the same name with the @c DirectiveInfo as the argument.
      */
     void preHandleDirective(
         std::shared_ptr<AVSDirective> directive,
@@ -73,6 +73,10 @@ public:
 
     void cancelDirective(const std::string& messageId) override final;
 
+    bool handleDirective(std::shared_ptr<AVSDirective> directive) override final;
+
+    void cancelDirective(std::shared_ptr<AVSDirective> directive) override final;
+
     void onDeregistered() override;
 
     void onFocusChanged(FocusState newFocus) override;
@@ -95,7 +99,7 @@ protected:
         std::shared_ptr<sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender);
 
     /**
-     * CapabilityAgent maintains a map from messageId to instances of DirectiveInfo so that CapabilityAgents
+     * CapabilityAgent keeps an instance of DirectiveInfo for each directive in flight so that CapabilityAgents
      * can track the processing of an @c AVSDirective.
      */
     class DirectiveInfo {
@@ -129,7 +133,8 @@ protected:
      *
      * @param directive The @c AVSDirective to be processed.
      * @param result The object with which to communicate the outcome of processing the @c AVSDirective.
-     * @return A DirectiveInfo instance with which to track the processing of @c directive.
+     * @return A DirectiveInfo instance with which to track the processing of @c directive.  The default is allocated
+     * from a pool of this @c CapabilityAgent, so a directive allocates nothing for it once the pool has warmed up.
      */
     virtual std::shared_ptr<DirectiveInfo> createDirectiveInfo(
         std::shared_ptr<AVSDirective> directive,
@@ -214,6 +219,13 @@ protected:
     std::shared_ptr<sdkInterfaces::ExceptionEncounteredSenderInterface> m_exceptionEncounteredSender;
 
 private:
+    /// A pool of the blocks in which the default @c DirectiveInfo instances are allocated.
+    class DirectiveInfoPool;
+
+    /// An allocator which takes its blocks from a @c DirectiveInfoPool.
+    template <typename T>
+    class DirectiveInfoAllocator;
+
     /**
      * Find the DirectiveInfo instance (if any) for the specified messsageId.
      *
@@ -222,11 +234,25 @@ private:
      */
     std::shared_ptr<DirectiveInfo> getDirectiveInfo(const std::string& messageId);
 
-    /// Map of message Id to @c DirectiveAndResultInterface.
-    std::unordered_map<std::string, std::shared_ptr<DirectiveInfo>> m_directiveInfoMap;
+    /**
+     * Find the DirectiveInfo instance (if any) for the specified directive, by comparing pointers.
+     *
+     * @param directive The directive to find DirectiveInfo for.
+     * @return The DirectiveInfo instance for @c directive.
+     */
+    std::shared_ptr<DirectiveInfo> getDirectiveInfo(const std::shared_ptr<AVSDirective>& directive);
+
+    /**
+     * The DirectiveInfo of each directive in flight.  An agent only has a few at once, so they are searched in order,
+     * and the vector keeps its capacity as they come and go.
+     */
+    std::vector<std::shared_ptr<DirectiveInfo>> m_directiveInfos;
 
-    /// Mutex to protect message Id to @c DirectiveAndResultInterface mapping.
+    /// Mutex to protect @c m_directiveInfos.
     std::mutex m_mutex;
+
+    /// The pool from which @c createDirectiveInfo() allocates.  The @c DirectiveInfo instances share it.
+    std::shared_ptr<DirectiveInfoPool> m_directiveInfoPool;
 };
 
 }  // namespace avs
@@ -28,7 +28,6 @@
 #include "AVSCommon/SDKInterfaces/SpeechSynthesizerObserver.h"
 
 #include <AVSCommon/Utils/Threading/Executor.h>
-#include <AVSCommon/Utils/Timing/Timer.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -37,6 +36,14 @@ namespace avs {
 /**
  * This class serves as a component to aggregate other observer interfaces into one UX component that notifies
  * observers of AVS dialog specific UX changes based on events that occur within these components.
+ *
+ * By default, observers are notified of every state change as it happens.  In coalescing mode, the first state change
+ * starts a frame of a fixed interval, and observers are only notified of the latest state at the end of the frame, so
+ * that quick sequences such as LISTENING to THINKING to SPEAKING cause one notification instead of several.  A frame
+ * which ends in the state last notified causes no notification.
+ *
+ * The timeouts of this class are delayed tasks of its executor, which wait on the shared @c TimerService rather than
+ * on threads of their own, and run on the executor without another hop.
  */
 class DialogUXStateAggregator
         : public sdkInterfaces::AudioInputProcessorObserverInterface
@@ -49,8 +56,12 @@ public:
      *
      * @param timeoutForThinkingToIdle This timeout will be used to time out from the THINKING state in case no messages
      * arrive from AVS.
+     * @param coalescingInterval The interval over which state changes are coalesced into one notification.  Zero
+     * disables coalescing, so that observers are notified of each state change.
      */
-    DialogUXStateAggregator(std::chrono::milliseconds timeoutForThinkingToIdle = std::chrono::seconds{5});
+    DialogUXStateAggregator(
+        std::chrono::milliseconds timeoutForThinkingToIdle = std::chrono::seconds{5},
+        std::chrono::milliseconds coalescingInterval = std::chrono::milliseconds{0});
 
     /**
      * Adds an observer to be notified of UX state changes.
@@ -83,10 +94,24 @@ public:
 
 private:
     /**
-     * Notifies all observers of the current state. This should only be used within the internal executor.
+     * Notifies all observers of the current state, or schedules the notification in coalescing mode. This should only
+     * be used within the internal executor.
      */
     void notifyObserversOfState();
 
+    /**
+     * Notifies all observers of a state. This should only be used within the internal executor.
+     *
+     * @param state The state to notify the observers of.
+     */
+    void deliverState(sdkInterfaces::DialogUXStateObserverInterface::DialogUXState state);
+
+    /**
+     * Notifies the observers of the latest state at the end of a coalescing frame, unless they already have it. This
+     * should only be used within the internal executor.
+     */
+    void coalescingIntervalElapsed();
+
     /**
      * Sets the internal state to the new state.
      *
@@ -95,12 +120,13 @@ private:
     void setState(sdkInterfaces::DialogUXStateObserverInterface::DialogUXState newState);
 
     /**
-     * Transitions the internal state from THINKING to IDLE.
+     * Transitions the internal state from THINKING to IDLE. This should only be used within the internal executor.
      */
     void transitionFromThinkingTimedOut();
 
     /**
-     * Transitions the internal state after a SPEAKING finishes to IDLE.
+     * Transitions the internal state after a SPEAKING finishes to IDLE. This should only be used within the internal
+     * executor.
      */
     void transitionFromSpeakingFinished();
 
@@ -125,11 +151,23 @@ private:
     /// The timeout to be used for transitioning away from the THINKING state in case no messages are received.
     const std::chrono::milliseconds m_timeoutForThinkingToIdle;
 
-    /// A timer to transition out of the THINKING state.
-    avsCommon::utils::timing::Timer m_thinkingToIdleTimer;
+    /// The delayed task to transition out of the THINKING state.
+    avsCommon::utils::threading::DelayedTaskHandle m_thinkingToIdleTask;
+
+    /// The delayed task to transition out of the SPEAKING state for multiturn situations.
+    avsCommon::utils::threading::DelayedTaskHandle m_multiturnSpeakingToListeningTask;
+
+    /// The interval over which state changes are coalesced, or zero if they are not.
+    const std::chrono::milliseconds m_coalescingInterval;
+
+    /// Whether a coalescing frame has started and not yet ended.
+    bool m_isNotificationPending;
+
+    /// The latest state observers should be notified of in coalescing mode.
+    sdkInterfaces::DialogUXStateObserverInterface::DialogUXState m_stateToNotify;
 
-    /// A timer to transition out of the SPEAKING state for multiturn situations.
-    avsCommon::utils::timing::Timer m_multiturnSpeakingToListeningTimer;
+    /// The state observers were last notified of.
+    sdkInterfaces::DialogUXStateObserverInterface::DialogUXState m_notifiedState;
     /// @}
 
     /**
@@ -0,0 +1,137 @@
+/*
+ * DirectiveArena.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_DIRECTIVE_ARENA_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_DIRECTIVE_ARENA_H_
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <rapidjson/document.h>
+
+#include "AVSCommon/AVS/AVSMessageHeader.h"
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A single allocation holding the objects created while a directive is parsed: the @c rapidjson::Document, whose
+ * values are allocated from a buffer within the arena, and the @c AVSMessageHeader.  Both are handed out through
+ * @c std::shared_ptr which share ownership of the arena, so the arena is released together with the last of them,
+ * normally together with the @c AVSDirective.
+ *
+ * Documents which outgrow the buffer continue in chunks allocated from the heap, as a plain @c rapidjson::Document
+ * would.
+ */
+class DirectiveArena : public std::enable_shared_from_this<DirectiveArena> {
+public:
+    /// The size of the buffer the document is allocated from, enough for the documents of typical directives.
+    static const size_t BUFFER_SIZE = 8 * 1024;
+
+    /**
+     * Create a DirectiveArena.
+     *
+     * @return A new, empty DirectiveArena.
+     */
+    static std::shared_ptr<DirectiveArena> create();
+
+    /**
+     * Destructor.
+     */
+    ~DirectiveArena();
+
+    /**
+     * Get the document to parse the directive into.
+     *
+     * @return The document of this arena.
+     */
+    rapidjson::Document& getDocument();
+
+    /**
+     * Get the document of this arena as a @c std::shared_ptr which shares ownership of the arena.
+     *
+     * @return The document of this arena.
+     */
+    std::shared_ptr<const rapidjson::Document> getSharedDocument();
+
+    /**
+     * Construct the @c AVSMessageHeader of the directive within the arena.  This may be called only once.
+     *
+     * @param avsNamespace The namespace of the directive.
+     * @param avsName The name of the directive.
+     * @param avsMessageId The message ID of the directive.
+     * @param avsDialogRequestId The dialog request ID of the directive.
+     * @return The header, sharing ownership of the arena, or @c nullptr if a header has already been created.
+     */
+    std::shared_ptr<AVSMessageHeader> createHeader(
+        std::string avsNamespace,
+        std::string avsName,
+        std::string avsMessageId,
+        std::string avsDialogRequestId);
+
+    /**
+     * Get the number of bytes the document has allocated from the arena's buffer and from the heap.
+     *
+     * @return The number of bytes the document has allocated.
+     */
+    size_t getDocumentSize() const;
+
+    /**
+     * Count the memory of the arena, including the chunks the document has allocated from the heap, in
+     * @c MemoryAccounting.  Called once the directive has been parsed; the memory is counted until the arena is
+     * released.
+     */
+    void updateMemoryAccounting();
+
+    /// @cond
+    DirectiveArena(const DirectiveArena&) = delete;
+    DirectiveArena& operator=(const DirectiveArena&) = delete;
+    /// @endcond
+
+private:
+    /**
+     * Constructor.
+     */
+    DirectiveArena();
+
+    /// The buffer @c m_allocator allocates from before it turns to the heap.
+    char m_buffer[BUFFER_SIZE];
+
+    /// The allocator of the values of @c m_document.
+    rapidjson::MemoryPoolAllocator<> m_allocator;
+
+    /// The document the directive is parsed into.
+    rapidjson::Document m_document;
+
+    /// The storage of the @c AVSMessageHeader, which is constructed by @c createHeader().
+    std::aligned_storage<sizeof(AVSMessageHeader), alignof(AVSMessageHeader)>::type m_headerStorage;
+
+    /// Whether a header has been constructed in @c m_headerStorage.
+    bool m_hasHeader;
+
+    /// The memory of the arena, as counted in @c MemoryAccounting.
+    utils::metrics::MemoryAccounting::Allocation m_memory;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_DIRECTIVE_ARENA_H_
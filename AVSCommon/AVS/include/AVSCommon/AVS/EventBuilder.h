@@ -45,6 +45,49 @@ const std::pair<std::string, std::string> buildJsonEventString(
     const std::string& jsonPayloadValue = "{}",
     const std::string& jsonContext = "");
 
+/**
+ * A pre-serialized event skeleton for an event which is sent repeatedly.  The namespace and name are serialized once,
+ * when the template is created, and each call to @c build() only writes the message Id, the optional
+ * @c dialogRequestId, the payload and the context into a buffer sized up front, without building a JSON document.
+ *
+ * The events built are equivalent to those of @c buildJsonEventString(): the payload and the context are checked to
+ * be valid JSON, and the members of the context object precede the event.
+ */
+class EventTemplate {
+public:
+    /**
+     * Constructor.
+     *
+     * @param nameSpace The namespace of the event to be included in the header.
+     * @param eventName The name of the event to be included in the header.
+     */
+    EventTemplate(const std::string& nameSpace, const std::string& eventName);
+
+    /**
+     * Builds a JSON event string from this template.
+     *
+     * @param dialogRequestIdValue The value associated with the "dialogRequestId" key.
+     * @param jsonPayloadValue The payload value associated with the "payload" key.
+     * @param jsonContext Optional @c context to be sent with the event message.
+     * @return A pair object consisting of the messageId and the event JSON string if successful,
+     * else a pair of empty strings.
+     */
+    const std::pair<std::string, std::string> build(
+        const std::string& dialogRequestIdValue = "",
+        const std::string& jsonPayloadValue = "{}",
+        const std::string& jsonContext = "") const;
+
+private:
+    /// The namespace of the event.
+    const std::string m_nameSpace;
+
+    /// The name of the event.
+    const std::string m_eventName;
+
+    /// The serialized start of the event, up to the opening quote of the messageId.
+    std::string m_headerPrefix;
+};
+
 }  // namespace avs
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
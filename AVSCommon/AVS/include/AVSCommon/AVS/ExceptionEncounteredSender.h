@@ -18,8 +18,13 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_EXCEPTION_ENCOUNTERED_SENDER_H
 #define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_EXCEPTION_ENCOUNTERED_SENDER_H
 
+#include <chrono>
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <AVSCommon/AVS/ExceptionErrorType.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h>
@@ -31,11 +36,17 @@ namespace avs {
 
 /**
  * Class creates an ExceptionEncountered event and sends to AVS using @c MessageSenderInterface.
+ *
+ * To bound the bandwidth a storm of bad directives can take from user traffic, a sender may be created to suppress
+ * events.  They are then rate limited by a token bucket, and an exception for the same directive (by message ID) and
+ * error type as one sent within the deduplication window is not sent again.  The number of exceptions suppressed for a
+ * directive and error type is appended to the description of the next one which is sent.  Exceptions for directives
+ * without a message ID, such as those which could not be parsed, are only rate limited.
  */
 class ExceptionEncounteredSender : public avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface {
 public:
     /**
-     * Creates a new @c ExceptionEncounteredSender instance.
+     * Creates a new @c ExceptionEncounteredSender instance, which sends an event for every exception.
      *
      * @param messageSender The object to use for sending events.
      * @return A @c std::unique_ptr to the new @c ExceptionEncounteredSender instance.
@@ -43,6 +54,21 @@ public:
     static std::unique_ptr<ExceptionEncounteredSender> create(
         std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
 
+    /**
+     * Creates a new @c ExceptionEncounteredSender instance, which suppresses events.
+     *
+     * @param messageSender The object to use for sending events.
+     * @param burstLimit The number of events which may be sent back to back.
+     * @param refillInterval The interval at which the allowance for another event is regained, up to @c burstLimit.
+     * @param deduplicationWindow How long after an event is sent that the same exception is suppressed.
+     * @return A @c std::unique_ptr to the new @c ExceptionEncounteredSender instance.
+     */
+    static std::unique_ptr<ExceptionEncounteredSender> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        size_t burstLimit,
+        std::chrono::milliseconds refillInterval,
+        std::chrono::milliseconds deduplicationWindow = DEFAULT_DEDUPLICATION_WINDOW);
+
     /**
      * This function asks the @c ExceptionEncounteredSender to send a ExceptionEncountered event to AVS when
      * the client is unable to execute a directive.
@@ -56,16 +82,70 @@ public:
         avs::ExceptionErrorType error,
         const std::string& errorDescription) override;
 
+    /// The default time after an event is sent that the same exception is suppressed.
+    static constexpr std::chrono::milliseconds DEFAULT_DEDUPLICATION_WINDOW{10000};
+
 private:
+    /// The message ID of the directive and the error type which identify the same exception.
+    using ExceptionKey = std::pair<std::string, ExceptionErrorType>;
+
+    /// What is remembered about an exception between events.
+    struct ExceptionRecord {
+        /// When the last event for the exception was sent.
+        std::chrono::steady_clock::time_point lastSentTime;
+
+        /// The number of times the exception has been suppressed since the last event was sent.
+        unsigned int suppressedCount;
+    };
+
     /**
      * Constructor.
      *
      * @param messageSender The object to use for sending events.
+     * @param burstLimit The number of events which may be sent back to back, or 0 to send every event.
+     * @param refillInterval The interval at which the allowance for another event is regained.
+     * @param deduplicationWindow How long after an event is sent that the same exception is suppressed.
      */
-    ExceptionEncounteredSender(std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
+    ExceptionEncounteredSender(
+        std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        size_t burstLimit,
+        std::chrono::milliseconds refillInterval,
+        std::chrono::milliseconds deduplicationWindow);
+
+    /**
+     * Decide whether an event may be sent for an exception, and account for it either way.  This must be called with
+     * @c m_mutex held.
+     *
+     * @param key The key of the exception, whose message ID is empty if the exception is not to be deduplicated.
+     * @param now The current time.
+     * @param[out] suppressedCount The number of times the exception was suppressed since the last event for it.
+     * @return Whether an event may be sent.
+     */
+    bool admitLocked(const ExceptionKey& key, std::chrono::steady_clock::time_point now, unsigned int* suppressedCount);
 
     /// The object to use for sending events.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
+
+    /// The number of events which may be sent back to back, or 0 if events are not suppressed.
+    const size_t m_burstLimit;
+
+    /// The interval at which the allowance for another event is regained.
+    const std::chrono::milliseconds m_refillInterval;
+
+    /// How long after an event is sent that the same exception is suppressed.
+    const std::chrono::milliseconds m_deduplicationWindow;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The number of events which may be sent now.
+    size_t m_tokens;
+
+    /// The time from which the next token is regained.
+    std::chrono::steady_clock::time_point m_lastRefillTime;
+
+    /// The exceptions sent or suppressed recently.
+    std::map<ExceptionKey, ExceptionRecord> m_records;
 };
 
 }  // namespace avs
@@ -0,0 +1,158 @@
+/*
+ * LazyCapabilityAgent.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_LAZY_CAPABILITY_AGENT_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_LAZY_CAPABILITY_AGENT_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AVSCommon/AVS/CapabilityAgent.h"
+#include "AVSCommon/AVS/DirectiveHandlerConfiguration.h"
+#include "AVSCommon/AVS/NamespaceAndName.h"
+#include "AVSCommon/SDKInterfaces/ContextManagerInterface.h"
+#include "AVSCommon/SDKInterfaces/DirectiveHandlerInterface.h"
+#include "AVSCommon/SDKInterfaces/StateProviderInterface.h"
+#include "AVSCommon/Utils/RequiresShutdown.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A stand-in for a @c CapabilityAgent which is only created when it is first needed.
+ *
+ * A @c LazyCapabilityAgent is registered with the @c DirectiveSequencer in place of the @c CapabilityAgent, with the
+ * same configuration.  It creates the @c CapabilityAgent, with the factory it was given, when the first directive for
+ * it arrives or when one of its states is first requested, and then forwards every call to it.  Until then, the
+ * executors, media player references and databases of the @c CapabilityAgent cost nothing.
+ *
+ * The states of the @c CapabilityAgent are reported for it until it is created: either a constant state, for instance
+ * the idle state of an @c AudioPlayer, or, if none is given, the state of the @c CapabilityAgent once created, which
+ * registers itself as the provider of its states.
+ *
+ * A @c CapabilityAgent which must act without being asked, such as one which raises alerts stored on the device,
+ * should not be created lazily.
+ */
+class LazyCapabilityAgent
+        : public sdkInterfaces::DirectiveHandlerInterface
+        , public sdkInterfaces::StateProviderInterface
+        , public utils::RequiresShutdown {
+public:
+    /// The factory of the @c CapabilityAgent.  It returns @c nullptr if the @c CapabilityAgent can not be created.
+    using Factory = std::function<std::shared_ptr<CapabilityAgent>()>;
+
+    /**
+     * Create a @c LazyCapabilityAgent.
+     *
+     * @param name The name of the @c CapabilityAgent, for logging.
+     * @param configuration The configuration of the @c CapabilityAgent, which is registered before it is created.
+     * @param factory The factory of the @c CapabilityAgent.
+     * @param contextManager The @c ContextManager to report the states of the @c CapabilityAgent to.  It may be
+     * @c nullptr if @c states is empty.
+     * @param states The states of the @c CapabilityAgent, each with the state to report until it is created.  An
+     * empty state instead has the @c CapabilityAgent created when the state is first requested.
+     * @return The @c LazyCapabilityAgent, or @c nullptr if the parameters are not valid.
+     */
+    static std::shared_ptr<LazyCapabilityAgent> create(
+        const std::string& name,
+        const DirectiveHandlerConfiguration& configuration,
+        Factory factory,
+        std::shared_ptr<sdkInterfaces::ContextManagerInterface> contextManager = nullptr,
+        const std::unordered_map<NamespaceAndName, std::string>& states = {});
+
+    /**
+     * Get the @c CapabilityAgent, and create it if it has not been created yet.
+     *
+     * @return The @c CapabilityAgent, or @c nullptr if it can not be created or this has been shut down.
+     */
+    std::shared_ptr<CapabilityAgent> getInstance();
+
+    /**
+     * Get the @c CapabilityAgent if it has been created, without creating it.
+     *
+     * @return The @c CapabilityAgent, or @c nullptr if it has not been created.
+     */
+    std::shared_ptr<CapabilityAgent> getCreatedInstance();
+
+    /// @name DirectiveHandlerInterface Functions
+    /// @{
+    void handleDirectiveImmediately(std::shared_ptr<AVSDirective> directive) override;
+    void preHandleDirective(
+        std::shared_ptr<AVSDirective> directive,
+        std::unique_ptr<sdkInterfaces::DirectiveHandlerResultInterface> result) override;
+    bool handleDirective(const std::string& messageId) override;
+    void cancelDirective(const std::string& messageId) override;
+    bool handleDirective(std::shared_ptr<AVSDirective> directive) override;
+    void cancelDirective(std::shared_ptr<AVSDirective> directive) override;
+    void onDeregistered() override;
+    DirectiveHandlerConfiguration getConfiguration() const override;
+    /// @}
+
+    /// @name StateProviderInterface Functions
+    /// @{
+    void provideState(const unsigned int stateRequestToken) override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param name The name of the @c CapabilityAgent, for logging.
+     * @param configuration The configuration of the @c CapabilityAgent.
+     * @param factory The factory of the @c CapabilityAgent.
+     * @param contextManager The @c ContextManager to report the states of the @c CapabilityAgent to.
+     */
+    LazyCapabilityAgent(
+        const std::string& name,
+        const DirectiveHandlerConfiguration& configuration,
+        Factory factory,
+        std::shared_ptr<sdkInterfaces::ContextManagerInterface> contextManager);
+
+    /// @name RequiresShutdown Functions
+    /// @{
+    void doShutdown() override;
+    /// @}
+
+    /// The configuration of the @c CapabilityAgent.
+    const DirectiveHandlerConfiguration m_configuration;
+
+    /// The @c ContextManager to report the states of the @c CapabilityAgent to.
+    const std::shared_ptr<sdkInterfaces::ContextManagerInterface> m_contextManager;
+
+    /// The states of the @c CapabilityAgent whose provider is this, until the @c CapabilityAgent is created.
+    std::vector<NamespaceAndName> m_providedStates;
+
+    /// Serializes the creation of the @c CapabilityAgent, and access to the members below.
+    std::mutex m_mutex;
+
+    /// The factory of the @c CapabilityAgent, or an empty function once it has been called or this is shut down.
+    Factory m_factory;
+
+    /// The @c CapabilityAgent, once created.
+    std::shared_ptr<CapabilityAgent> m_instance;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_LAZY_CAPABILITY_AGENT_H_
@@ -36,15 +36,45 @@ namespace avs {
  */
 class MessageRequest {
 public:
+    /**
+     * The order in which queued requests are sent.  A request is only sent once no request of a higher priority is
+     * queued; requests of the same priority are sent in the order they were queued.
+     */
+    enum class Priority {
+        /// Latency-critical requests that the user is waiting on, such as @c SpeechRecognizer.Recognize.
+        HIGH,
+        /// Most requests.
+        NORMAL,
+        /// Periodic reports which may be delayed, such as @c AudioPlayer progress reports.
+        LOW
+    };
+
     /**
      * Constructor.
-     * @param jsonContent The message to be sent to AVS.
+     * @param jsonContent The message to be sent to AVS.  Pass an rvalue, such as the event just built, to move it into
+     * the request rather than copy it.
+     * @param attachmentReader The attachment data (if present) to be sent to AVS along with the message.
+     * Defaults to @c nullptr.
+     * @param priority The priority with which the message is sent.  Defaults to @c Priority::NORMAL.
+     */
+    MessageRequest(
+        std::string jsonContent,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader = nullptr,
+        Priority priority = Priority::NORMAL);
+
+    /**
+     * Constructor sharing JSON content which is already held elsewhere, for example by a sender which stores its
+     * messages until they are acknowledged, instead of copying it.
+     * @param jsonContent The message to be sent to AVS, which must not be modified while shared.  A @c nullptr is
+     * taken as an empty message.
      * @param attachmentReader The attachment data (if present) to be sent to AVS along with the message.
      * Defaults to @c nullptr.
+     * @param priority The priority with which the message is sent.  Defaults to @c Priority::NORMAL.
      */
     MessageRequest(
-        const std::string& jsonContent,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader = nullptr);
+        std::shared_ptr<const std::string> jsonContent,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader = nullptr,
+        Priority priority = Priority::NORMAL);
 
     /**
      * Destructor.
@@ -52,11 +82,20 @@ public:
     virtual ~MessageRequest();
 
     /**
-     * Retrieves the JSON content to be sent to AVS.
+     * Retrieves the JSON content to be sent to AVS.  The content is never modified, so the reference stays valid as
+     * long as this request.
      *
      * @return The JSON content to be sent to AVS.
      */
-    std::string getJsonContent();
+    const std::string& getJsonContent() const;
+
+    /**
+     * Retrieves the JSON content to be sent to AVS, shared rather than copied, for a consumer which may outlive this
+     * request such as the body of an HTTP transfer.
+     *
+     * @return The JSON content to be sent to AVS.
+     */
+    std::shared_ptr<const std::string> getSharedJsonContent() const;
 
     /**
      * Retrieves the AttachmentReader of the Attachment data to be sent to AVS.
@@ -65,6 +104,13 @@ public:
      */
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> getAttachmentReader();
 
+    /**
+     * Retrieves the priority with which the message is sent.
+     *
+     * @return The priority with which the message is sent.
+     */
+    Priority getPriority() const;
+
     /**
      * This is called once the send request has completed.  The status parameter indicates success or failure.
      * @param status Whether the send request succeeded or failed.
@@ -78,6 +124,15 @@ public:
      */
     virtual void exceptionReceived(const std::string& exceptionMessage);
 
+    /**
+     * This function will be called with the timing of the transfer of this message request, just before
+     * @c sendCompleted() is called for a transfer which finished.
+     *
+     * @param timings The timing of the transfer.
+     */
+    void transferTimingsMeasured(
+        const avsCommon::sdkInterfaces::MessageRequestObserverInterface::TransferTimings& timings);
+
     /**
      * Add observer of MessageRequestObserverInterface.
      *
@@ -115,11 +170,14 @@ protected:
     /// Set of observers of MessageRequestObserverInterface.
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::MessageRequestObserverInterface>> m_observers;
 
-    /// The JSON content to be sent to AVS.
-    std::string m_jsonContent;
+    /// The JSON content to be sent to AVS, shared by the layers it goes through and never modified.
+    const std::shared_ptr<const std::string> m_jsonContent;
 
     /// The AttachmentReader of the Attachment data to be sent to AVS.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_attachmentReader;
+
+    /// The priority with which the message is sent.
+    const Priority m_priority;
 };
 
 }  // namespace avs
@@ -0,0 +1,67 @@
+/*
+ * NamespaceAndNameInterner.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_NAMESPACE_AND_NAME_INTERNER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_NAMESPACE_AND_NAME_INTERNER_H_
+
+#include <cstdint>
+#include <string>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A process-wide table giving each interned namespace and name pair a small integer id, so that messages can be
+ * matched to their handlers by comparing integers.  Ids are allocated densely from zero and never reused, so they
+ * may be used to index arrays.
+ *
+ * Pairs are interned when directive handlers are registered.  Messages received from AVS only look their pair up, so
+ * that unexpected namespaces and names do not grow the table.
+ */
+class NamespaceAndNameInterner {
+public:
+    /// The type of the id of a namespace and name pair.
+    using Id = uint32_t;
+
+    /// The id returned for a pair which has not been interned.
+    static const Id INVALID_ID;
+
+    /**
+     * Get the id of a namespace and name pair, allocating one if the pair has not been interned yet.
+     *
+     * @param nameSpace The namespace.
+     * @param name The name.
+     * @return The id of the pair.
+     */
+    static Id intern(const std::string& nameSpace, const std::string& name);
+
+    /**
+     * Get the id of a namespace and name pair, without allocating one.
+     *
+     * @param nameSpace The namespace.
+     * @param name The name.
+     * @return The id of the pair, or @c INVALID_ID if it has not been interned.
+     */
+    static Id find(const std::string& nameSpace, const std::string& name);
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_AVS_INCLUDE_AVS_COMMON_AVS_NAMESPACE_AND_NAME_INTERNER_H_
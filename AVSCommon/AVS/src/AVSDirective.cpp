@@ -15,6 +15,8 @@
  * permissions and limitations under the License.
  */
 
+#include <rapidjson/error/en.h>
+
 #include "AVSCommon/AVS/AVSDirective.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 
@@ -35,12 +37,27 @@ static const std::string TAG("AvsDirective");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// JSON key to get the directive object of a message.
+static const char JSON_MESSAGE_DIRECTIVE_KEY[] = "directive";
+/// JSON key to get the payload object of a directive.
+static const char JSON_MESSAGE_PAYLOAD_KEY[] = "payload";
+
 std::unique_ptr<AVSDirective> AVSDirective::create(
     const std::string& unparsedDirective,
     std::shared_ptr<AVSMessageHeader> avsMessageHeader,
     const std::string& payload,
     std::shared_ptr<AttachmentManagerInterface> attachmentManager,
     const std::string& attachmentContextId) {
+    return create(unparsedDirective, nullptr, avsMessageHeader, payload, attachmentManager, attachmentContextId);
+}
+
+std::unique_ptr<AVSDirective> AVSDirective::create(
+    const std::string& unparsedDirective,
+    std::shared_ptr<const rapidjson::Document> parsedDirective,
+    std::shared_ptr<AVSMessageHeader> avsMessageHeader,
+    const std::string& payload,
+    std::shared_ptr<AttachmentManagerInterface> attachmentManager,
+    const std::string& attachmentContextId) {
     if (!avsMessageHeader) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullMessageHeader"));
         return nullptr;
@@ -49,8 +66,12 @@ std::unique_ptr<AVSDirective> AVSDirective::create(
         ACSDK_ERROR(LX("createFailed").d("reason", "nullAttachmentManager"));
         return nullptr;
     }
-    return std::unique_ptr<AVSDirective>(
-        new AVSDirective(unparsedDirective, avsMessageHeader, payload, attachmentManager, attachmentContextId));
+    return std::unique_ptr<AVSDirective>(new AVSDirective(
+        unparsedDirective, parsedDirective, avsMessageHeader, payload, attachmentManager, attachmentContextId));
+}
+
+AVSDirective::~AVSDirective() {
+    m_attachmentManager->removeAttachmentContextReference(m_attachmentContextId);
 }
 
 std::unique_ptr<AttachmentReader> AVSDirective::getAttachmentReader(
@@ -62,6 +83,7 @@ std::unique_ptr<AttachmentReader> AVSDirective::getAttachmentReader(
 
 AVSDirective::AVSDirective(
     const std::string& unparsedDirective,
+    std::shared_ptr<const rapidjson::Document> parsedDirective,
     std::shared_ptr<AVSMessageHeader> avsMessageHeader,
     const std::string& payload,
     std::shared_ptr<AttachmentManagerInterface> attachmentManager,
@@ -69,13 +91,49 @@ AVSDirective::AVSDirective(
         AVSMessage{avsMessageHeader, payload},
         m_unparsedDirective{unparsedDirective},
         m_attachmentManager{attachmentManager},
-        m_attachmentContextId{attachmentContextId} {
+        m_attachmentContextId{attachmentContextId},
+        m_payloadValue{nullptr} {
+    // Keep the attachments of this directive until it is gone, however long it waits to be handled.
+    m_attachmentManager->addAttachmentContextReference(m_attachmentContextId);
+    if (!parsedDirective || !parsedDirective->IsObject()) {
+        return;
+    }
+    auto directiveIt = parsedDirective->FindMember(JSON_MESSAGE_DIRECTIVE_KEY);
+    if (directiveIt == parsedDirective->MemberEnd() || !directiveIt->value.IsObject()) {
+        return;
+    }
+    auto payloadIt = directiveIt->value.FindMember(JSON_MESSAGE_PAYLOAD_KEY);
+    if (payloadIt == directiveIt->value.MemberEnd()) {
+        return;
+    }
+    m_parsedDocument = parsedDirective;
+    m_payloadValue = &payloadIt->value;
 }
 
-std::string AVSDirective::getUnparsedDirective() const {
+const std::string& AVSDirective::getUnparsedDirective() const {
     return m_unparsedDirective;
 }
 
+const rapidjson::Value* AVSDirective::getPayloadValue() const {
+    std::call_once(m_payloadParsedFlag, [this] {
+        if (m_payloadValue) {
+            return;
+        }
+        auto document = std::make_shared<rapidjson::Document>();
+        rapidjson::ParseResult result = document->Parse(getPayload());
+        if (!result) {
+            ACSDK_ERROR(LX("getPayloadValueFailed")
+                            .d("reason", rapidjson::GetParseError_En(result.Code()))
+                            .d("offset", result.Offset())
+                            .d("messageId", getMessageId()));
+            return;
+        }
+        m_parsedDocument = document;
+        m_payloadValue = document.get();
+    });
+    return m_payloadValue;
+}
+
 }  // namespace avs
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
@@ -26,23 +26,27 @@ AVSMessage::AVSMessage(std::shared_ptr<AVSMessageHeader> avsMessageHeader, std::
         m_payload{std::move(payload)} {
 }
 
-std::string AVSMessage::getNamespace() const {
+const std::string& AVSMessage::getNamespace() const {
     return m_header->getNamespace();
 }
 
-std::string AVSMessage::getName() const {
+const std::string& AVSMessage::getName() const {
     return m_header->getName();
 }
 
-std::string AVSMessage::getMessageId() const {
+const std::string& AVSMessage::getMessageId() const {
     return m_header->getMessageId();
 }
 
-std::string AVSMessage::getDialogRequestId() const {
+const std::string& AVSMessage::getDialogRequestId() const {
     return m_header->getDialogRequestId();
 }
 
-std::string AVSMessage::getPayload() const {
+NamespaceAndNameInterner::Id AVSMessage::getNamespaceAndNameId() const {
+    return m_header->getNamespaceAndNameId();
+}
+
+const std::string& AVSMessage::getPayload() const {
     return m_payload;
 }
 
@@ -21,22 +21,26 @@ namespace alexaClientSDK {
 namespace avsCommon {
 namespace avs {
 
-std::string AVSMessageHeader::getNamespace() const {
+const std::string& AVSMessageHeader::getNamespace() const {
     return m_namespace;
 }
 
-std::string AVSMessageHeader::getName() const {
+const std::string& AVSMessageHeader::getName() const {
     return m_name;
 }
 
-std::string AVSMessageHeader::getMessageId() const {
+const std::string& AVSMessageHeader::getMessageId() const {
     return m_messageId;
 }
 
-std::string AVSMessageHeader::getDialogRequestId() const {
+const std::string& AVSMessageHeader::getDialogRequestId() const {
     return m_dialogRequestId;
 }
 
+NamespaceAndNameInterner::Id AVSMessageHeader::getNamespaceAndNameId() const {
+    return m_namespaceAndNameId;
+}
+
 std::string AVSMessageHeader::getAsString() const {
     // clang-format off
     return std::string() +
@@ -0,0 +1,203 @@
+/*
+ * AsyncRequests.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/AVS/AsyncRequests.h"
+
+#include <mutex>
+
+#include "AVSCommon/AVS/EventBuilder.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+using namespace sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AsyncRequests");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * An observer of a @c MessageRequest which passes its outcome to a continuation, once.
+ */
+class SendCompletedContinuation : public MessageRequestObserverInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param onCompleted The continuation to call with the outcome of the request.
+     */
+    explicit SendCompletedContinuation(SendCompletedCallback onCompleted) : m_onCompleted{std::move(onCompleted)} {
+    }
+
+    void onSendCompleted(MessageRequestObserverInterface::Status status) override {
+        SendCompletedCallback onCompleted;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::swap(onCompleted, m_onCompleted);
+        }
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    void onExceptionReceived(const std::string& exceptionMessage) override {
+    }
+
+private:
+    /// Serializes access to @c m_onCompleted.
+    std::mutex m_mutex;
+
+    /// The continuation, or an empty function once it has been called.
+    SendCompletedCallback m_onCompleted;
+};
+
+/**
+ * A @c ContextRequesterInterface which passes the context, or the reason it is not available, to continuations.
+ */
+class ContextContinuation : public ContextRequesterInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param onAvailable The continuation to call with the context.
+     * @param onFailure The continuation to call if the context is not available.
+     */
+    ContextContinuation(ContextAvailableCallback onAvailable, ContextFailureCallback onFailure) :
+            m_onAvailable{std::move(onAvailable)},
+            m_onFailure{std::move(onFailure)} {
+    }
+
+    void onContextAvailable(const std::string& jsonContext) override {
+        if (m_onAvailable) {
+            m_onAvailable(jsonContext);
+        }
+    }
+
+    void onContextFailure(const ContextRequestError error) override {
+        if (m_onFailure) {
+            m_onFailure(error);
+        }
+    }
+
+private:
+    /// The continuation to call with the context.
+    const ContextAvailableCallback m_onAvailable;
+
+    /// The continuation to call if the context is not available.
+    const ContextFailureCallback m_onFailure;
+};
+
+void sendMessageAsync(
+    std::shared_ptr<MessageSenderInterface> messageSender,
+    std::shared_ptr<MessageRequest> request,
+    SendCompletedCallback onCompleted) {
+    if (!messageSender || !request) {
+        ACSDK_ERROR(LX("sendMessageAsyncFailed").d("reason", messageSender ? "nullRequest" : "nullMessageSender"));
+        if (onCompleted) {
+            onCompleted(MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+        }
+        return;
+    }
+    if (onCompleted) {
+        request->addObserver(std::make_shared<SendCompletedContinuation>(std::move(onCompleted)));
+    }
+    messageSender->sendMessage(request);
+}
+
+std::future<MessageRequestObserverInterface::Status> sendMessageAsync(
+    std::shared_ptr<MessageSenderInterface> messageSender,
+    std::shared_ptr<MessageRequest> request) {
+    auto promise = std::make_shared<std::promise<MessageRequestObserverInterface::Status>>();
+    auto future = promise->get_future();
+    sendMessageAsync(messageSender, request, [promise](MessageRequestObserverInterface::Status status) {
+        promise->set_value(status);
+    });
+    return future;
+}
+
+void getContextAsync(
+    std::shared_ptr<ContextManagerInterface> contextManager,
+    ContextAvailableCallback onAvailable,
+    ContextFailureCallback onFailure) {
+    if (!contextManager) {
+        ACSDK_ERROR(LX("getContextAsyncFailed").d("reason", "nullContextManager"));
+        if (onFailure) {
+            onFailure(ContextRequestError::BUILD_CONTEXT_ERROR);
+        }
+        return;
+    }
+    contextManager->getContext(std::make_shared<ContextContinuation>(std::move(onAvailable), std::move(onFailure)));
+}
+
+std::future<ContextResult> getContextAsync(std::shared_ptr<ContextManagerInterface> contextManager) {
+    auto promise = std::make_shared<std::promise<ContextResult>>();
+    auto future = promise->get_future();
+    getContextAsync(
+        contextManager,
+        [promise](const std::string& jsonContext) {
+            promise->set_value({true, jsonContext, ContextRequestError::BUILD_CONTEXT_ERROR});
+        },
+        [promise](ContextRequestError error) { promise->set_value({false, "", error}); });
+    return future;
+}
+
+std::future<MessageRequestObserverInterface::Status> sendEventWithContextAsync(
+    std::shared_ptr<ContextManagerInterface> contextManager,
+    std::shared_ptr<MessageSenderInterface> messageSender,
+    const std::string& nameSpace,
+    const std::string& eventName,
+    const std::string& dialogRequestIdValue,
+    const std::string& jsonPayloadValue) {
+    auto promise = std::make_shared<std::promise<MessageRequestObserverInterface::Status>>();
+    auto future = promise->get_future();
+    getContextAsync(
+        contextManager,
+        [=](const std::string& jsonContext) {
+            auto event =
+                buildJsonEventString(nameSpace, eventName, dialogRequestIdValue, jsonPayloadValue, jsonContext);
+            if (event.second.empty()) {
+                ACSDK_ERROR(LX("sendEventWithContextAsyncFailed").d("reason", "buildJsonEventStringFailed"));
+                promise->set_value(MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+                return;
+            }
+            sendMessageAsync(
+                messageSender,
+                std::make_shared<MessageRequest>(std::move(event.second)),
+                [promise](MessageRequestObserverInterface::Status status) { promise->set_value(status); });
+        },
+        [promise, nameSpace, eventName](ContextRequestError error) {
+            ACSDK_ERROR(LX("sendEventWithContextAsyncFailed")
+                            .d("reason", "getContextFailed")
+                            .d("namespace", nameSpace)
+                            .d("name", eventName)
+                            .d("error", error));
+            promise->set_value(MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+        });
+    return future;
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -40,6 +40,10 @@ bool Attachment::hasCreatedWriter() {
     return m_hasCreatedWriter;
 }
 
+bool Attachment::hasLiveReaderOrWriter() const {
+    return true;
+}
+
 }  // namespace attachment
 }  // namespace avs
 }  // namespace avsCommon
@@ -0,0 +1,221 @@
+/*
+ * AttachmentBufferPool.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Memory/Memory.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+using namespace alexaClientSDK::avsCommon::utils::memory;
+using namespace alexaClientSDK::avsCommon::utils::metrics;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AttachmentBufferPool");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const std::vector<size_t> AttachmentBufferPool::DEFAULT_SIZE_CLASSES = {
+    0x10000,
+    0x40000,
+    static_cast<size_t>(InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES)};
+
+std::shared_ptr<AttachmentBufferPool> AttachmentBufferPool::create(
+    const std::vector<size_t>& sizeClasses,
+    size_t maxFreeBuffersPerClass,
+    std::shared_ptr<MemoryBudget> budget) {
+    if (sizeClasses.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noSizeClasses"));
+        return nullptr;
+    }
+    size_t previous = 0;
+    for (auto size : sizeClasses) {
+        if (size <= previous) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "sizeClassesNotIncreasing").d("size", size));
+            return nullptr;
+        }
+        previous = size;
+    }
+    if (!budget) {
+        budget = MemoryBudget::getDefault();
+    }
+    return std::shared_ptr<AttachmentBufferPool>(
+        new AttachmentBufferPool(sizeClasses, maxFreeBuffersPerClass, std::move(budget)));
+}
+
+AttachmentBufferPool::AttachmentBufferPool(
+    const std::vector<size_t>& sizeClasses,
+    size_t maxFreeBuffersPerClass,
+    std::shared_ptr<MemoryBudget> budget) :
+        m_maxFreeBuffersPerClass{maxFreeBuffersPerClass},
+        m_budget{std::move(budget)},
+        m_freeMemory{MemoryAccounting::Category::ATTACHMENTS} {
+    for (auto size : sizeClasses) {
+        SizeClass sizeClass;
+        sizeClass.bufferSize = InProcessAttachment::SDSType::calculateBufferSize(size);
+        m_sizeClasses.push_back(std::move(sizeClass));
+    }
+}
+
+std::shared_ptr<InProcessAttachment::SDSBufferType> AttachmentBufferPool::acquireBuffer(
+    size_t dataSize,
+    MemoryBudget::Priority priority) {
+    size_t index = m_sizeClasses.size() - 1;
+    if (dataSize > 0) {
+        auto bufferSize = InProcessAttachment::SDSType::calculateBufferSize(dataSize);
+        for (size_t i = 0; i < m_sizeClasses.size(); ++i) {
+            if (m_sizeClasses[i].bufferSize >= bufferSize) {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    auto freeBuffer = takeFreeBuffer(index);
+    if (!freeBuffer.buffer) {
+        auto reservation = reserve(&index, priority);
+        if (!reservation) {
+            ACSDK_WARN(LX("acquireBufferFailed")
+                           .d("reason", "budgetExhausted")
+                           .d("dataSize", dataSize)
+                           .d("priority", priority));
+            return nullptr;
+        }
+        // The budget may have granted a smaller class, which may have a free buffer with a reservation of its own.
+        freeBuffer = takeFreeBuffer(index);
+        if (!freeBuffer.buffer) {
+            freeBuffer.buffer = make_unique<InProcessAttachment::SDSBufferType>(m_sizeClasses[index].bufferSize);
+            freeBuffer.reservation = std::move(reservation);
+        }
+    }
+
+    // The buffer is counted until the last of its attachment and the attachment's readers and writers releases it.
+    auto allocation = std::make_shared<MemoryAccounting::Allocation>(
+        MemoryAccounting::Category::ATTACHMENTS, m_sizeClasses[index].bufferSize);
+    auto reservation = freeBuffer.reservation;
+    std::weak_ptr<AttachmentBufferPool> weakPool = shared_from_this();
+    return std::shared_ptr<InProcessAttachment::SDSBufferType>(
+        freeBuffer.buffer.release(),
+        [weakPool, index, allocation, reservation](InProcessAttachment::SDSBufferType* released) {
+            FreeBuffer owned{std::unique_ptr<InProcessAttachment::SDSBufferType>(released), reservation};
+            if (auto pool = weakPool.lock()) {
+                pool->releaseBuffer(index, std::move(owned));
+            }
+        });
+}
+
+std::unique_ptr<InProcessAttachment::SDSType> AttachmentBufferPool::createStream(
+    size_t dataSize,
+    MemoryBudget::Priority priority) {
+    auto buffer = acquireBuffer(dataSize, priority);
+    if (!buffer) {
+        ACSDK_ERROR(LX("createStreamFailed").d("reason", "noBuffer").d("dataSize", dataSize));
+        return nullptr;
+    }
+    auto stream = InProcessAttachment::SDSType::create(buffer);
+    if (!stream) {
+        ACSDK_ERROR(LX("createStreamFailed").d("reason", "createSdsFailed").d("dataSize", dataSize));
+    }
+    return stream;
+}
+
+size_t AttachmentBufferPool::getFreeBufferCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (auto& sizeClass : m_sizeClasses) {
+        count += sizeClass.freeBuffers.size();
+    }
+    return count;
+}
+
+AttachmentBufferPool::FreeBuffer AttachmentBufferPool::takeFreeBuffer(size_t index) {
+    FreeBuffer freeBuffer;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& freeBuffers = m_sizeClasses[index].freeBuffers;
+    if (!freeBuffers.empty()) {
+        freeBuffer = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+        updateFreeMemoryLocked();
+    }
+    return freeBuffer;
+}
+
+std::unique_ptr<MemoryBudget::Reservation> AttachmentBufferPool::reserve(
+    size_t* index,
+    MemoryBudget::Priority priority) {
+    auto preferredBytes = m_sizeClasses[*index].bufferSize;
+    auto minimumBytes = m_sizeClasses.front().bufferSize;
+    auto reservation = m_budget->reserve(preferredBytes, minimumBytes, priority);
+    // The buffers kept for reuse are the first thing to give up when the budget is short.
+    if ((!reservation || reservation->getBytes() < preferredBytes) && releaseFreeBuffers()) {
+        reservation.reset();
+        reservation = m_budget->reserve(preferredBytes, minimumBytes, priority);
+    }
+    if (!reservation) {
+        return nullptr;
+    }
+    while (*index > 0 && m_sizeClasses[*index].bufferSize > reservation->getBytes()) {
+        --*index;
+    }
+    reservation->shrink(m_sizeClasses[*index].bufferSize);
+    return reservation;
+}
+
+bool AttachmentBufferPool::releaseFreeBuffers() {
+    std::vector<FreeBuffer> released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& sizeClass : m_sizeClasses) {
+            for (auto& freeBuffer : sizeClass.freeBuffers) {
+                released.push_back(std::move(freeBuffer));
+            }
+            sizeClass.freeBuffers.clear();
+        }
+        updateFreeMemoryLocked();
+    }
+    return !released.empty();
+}
+
+void AttachmentBufferPool::releaseBuffer(size_t index, FreeBuffer freeBuffer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& freeBuffers = m_sizeClasses[index].freeBuffers;
+    if (freeBuffers.size() < m_maxFreeBuffersPerClass) {
+        freeBuffers.push_back(std::move(freeBuffer));
+        updateFreeMemoryLocked();
+    }
+}
+
+void AttachmentBufferPool::updateFreeMemoryLocked() {
+    uint64_t bytes = 0;
+    for (auto& sizeClass : m_sizeClasses) {
+        bytes += sizeClass.freeBuffers.size() * sizeClass.bufferSize;
+    }
+    m_freeMemory.resize(bytes);
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -15,9 +15,10 @@
  * permissions and limitations under the License.
  */
 
-#include <vector>
+#include <functional>
 
 #include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
+#include "AVSCommon/AVS/Attachment/SpillingAttachment.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 #include "AVSCommon/Utils/Memory/Memory.h"
 
@@ -41,20 +42,47 @@ static const std::string TAG("AttachmentManager");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-// The definition for these two static class members.
+// The definition for these static class members.
 constexpr std::chrono::minutes AttachmentManager::ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT;
 constexpr std::chrono::minutes AttachmentManager::ATTACHMENT_MANAGER_TIMOUT_MINUTES_MINIMUM;
+const size_t AttachmentManager::DEFAULT_MAX_SPILL_SIZE_IN_BYTES;
 
 // Used within generateAttachmentId().
 static const std::string ATTACHMENT_ID_COMBINING_SUBSTRING = ":";
 
+/// How often attachments which have expired or which nothing can use any more are looked for.
+static const std::chrono::seconds SWEEP_INTERVAL(5);
+
+/// How long an attachment nothing uses is kept by default, in case the directive which reads it is not created yet.
+static const std::chrono::seconds DEFAULT_UNREFERENCED_ATTACHMENT_GRACE_PERIOD(10);
+
 AttachmentManager::AttachmentManagementDetails::AttachmentManagementDetails() :
-        creationTime{std::chrono::steady_clock::now()} {
+        creationTime{std::chrono::steady_clock::now()},
+        isRejected{false} {
 }
 
-AttachmentManager::AttachmentManager(AttachmentType attachmentType) :
+AttachmentManager::AttachmentManager(
+    AttachmentType attachmentType,
+    const std::string& spillDirectory,
+    size_t maxSpillSize,
+    MemoryBudget::Priority priority) :
         m_attachmentType{attachmentType},
-        m_attachmentExpirationMinutes{ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT} {
+        m_spillDirectory{spillDirectory},
+        m_maxSpillSize{maxSpillSize},
+        m_priority{priority},
+        m_unreferencedAttachmentGracePeriod{DEFAULT_UNREFERENCED_ATTACHMENT_GRACE_PERIOD},
+        m_attachmentExpirationMinutes{ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT},
+        m_bufferPool{AttachmentBufferPool::create()},
+        m_sweepTimer{utils::timing::TimerService::getInstance()} {
+    m_sweepTimer.start(
+        SWEEP_INTERVAL,
+        utils::timing::Timer::PeriodType::ABSOLUTE,
+        utils::timing::Timer::FOREVER,
+        std::bind(&AttachmentManager::removeExpiredAttachments, this));
+}
+
+AttachmentManager::~AttachmentManager() {
+    m_sweepTimer.stop();
 }
 
 std::string AttachmentManager::generateAttachmentId(const std::string& contextId, const std::string& contentId) const {
@@ -91,17 +119,36 @@ bool AttachmentManager::setAttachmentTimeoutMinutes(std::chrono::minutes minutes
     return true;
 }
 
-AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLocked(const std::string& attachmentId) {
+AttachmentManager::Shard& AttachmentManager::getShard(const std::string& attachmentId) {
+    return m_shards[std::hash<std::string>()(attachmentId) % NUMBER_OF_SHARDS];
+}
+
+AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLocked(
+    Shard& shard,
+    const std::string& attachmentId,
+    size_t sizeHint) {
     // This call ensures the details object exists, whether updated previously, or as a new object.
-    auto& details = m_attachmentDetailsMap[attachmentId];
+    auto& details = shard.attachmentDetailsMap[attachmentId];
 
     // If it's a new object, the inner attachment has not yet been created.  Let's go do that.
-    if (!details.attachment) {
+    if (!details.attachment && !details.isRejected) {
+        auto stream = m_bufferPool->createStream(sizeHint, m_priority);
+        if (!stream) {
+            ACSDK_ERROR(LX("getDetailsLockedError").d("reason", "bufferRefused").d("attachmentId", attachmentId));
+            details.isRejected = true;
+            return details;
+        }
+
         // Lack of default case will allow compiler to generate warnings if a case is unhandled.
         switch (m_attachmentType) {
             // The in-process attachment type.
             case AttachmentType::IN_PROCESS:
-                details.attachment = make_unique<InProcessAttachment>(attachmentId);
+                details.attachment = make_unique<InProcessAttachment>(attachmentId, std::move(stream));
+                break;
+            // The in-process attachment type which spills into a temporary file.
+            case AttachmentType::SPILLING:
+                details.attachment = make_unique<SpillingAttachment>(
+                    attachmentId, m_spillDirectory, m_maxSpillSize, std::move(stream));
                 break;
         }
 
@@ -117,58 +164,132 @@ AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLoc
 }
 
 std::unique_ptr<AttachmentWriter> AttachmentManager::createWriter(const std::string& attachmentId) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    return createWriter(attachmentId, 0);
+}
 
-    auto& details = getDetailsLocked(attachmentId);
+std::unique_ptr<AttachmentWriter> AttachmentManager::createWriter(const std::string& attachmentId, size_t sizeHint) {
+    auto& shard = getShard(attachmentId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto& details = getDetailsLocked(shard, attachmentId, sizeHint);
     if (!details.attachment) {
         ACSDK_ERROR(LX("createWriterFailed").d("reason", "Could not access attachment"));
         return nullptr;
     }
 
     auto writer = details.attachment->createWriter();
-    removeExpiredAttachmentsLocked();
+    removeIfHandedOffLocked(shard, attachmentId);
     return writer;
 }
 
 std::unique_ptr<AttachmentReader> AttachmentManager::createReader(
     const std::string& attachmentId,
     AttachmentReader::Policy policy) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& shard = getShard(attachmentId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
 
-    auto& details = getDetailsLocked(attachmentId);
+    auto& details = getDetailsLocked(shard, attachmentId);
     if (!details.attachment) {
         ACSDK_ERROR(LX("createWriterFailed").d("reason", "Could not access attachment"));
         return nullptr;
     }
 
     auto reader = details.attachment->createReader(policy);
-    removeExpiredAttachmentsLocked();
+    removeIfHandedOffLocked(shard, attachmentId);
     return reader;
 }
 
-void AttachmentManager::removeExpiredAttachmentsLocked() {
-    std::vector<std::string> idsToErase;
-    auto now = std::chrono::steady_clock::now();
+void AttachmentManager::addAttachmentContextReference(const std::string& contextId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_contextReferenceCounts[contextId];
+}
 
-    for (auto& iter : m_attachmentDetailsMap) {
-        auto& details = iter.second;
+void AttachmentManager::removeAttachmentContextReference(const std::string& contextId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_contextReferenceCounts.find(contextId);
+    if (it == m_contextReferenceCounts.end()) {
+        ACSDK_ERROR(LX("removeAttachmentContextReferenceFailed").d("reason", "contextNotReferenced"));
+        return;
+    }
+    if (0 == --it->second) {
+        m_contextReferenceCounts.erase(it);
+    }
+}
 
-        /*
-         * Our criteria for releasing an AttachmentManagementDetails object - either:
-         *  - Both futures have been returned, which means the attachment now has a reader and writer.  Great!
-         *  - Only the reader or writer future was returned, and the attachment has exceeded its lifetime limit.
-         */
+void AttachmentManager::setUnreferencedAttachmentGracePeriod(std::chrono::milliseconds gracePeriod) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_unreferencedAttachmentGracePeriod = gracePeriod;
+}
 
-        auto attachmentLifetime = std::chrono::duration_cast<std::chrono::minutes>(now - details.creationTime);
+size_t AttachmentManager::getNumberOfAttachments() {
+    size_t count = 0;
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.attachmentDetailsMap.size();
+    }
+    return count;
+}
 
-        if ((details.attachment->hasCreatedReader() && details.attachment->hasCreatedWriter()) ||
-            attachmentLifetime > m_attachmentExpirationMinutes) {
-            idsToErase.push_back(iter.first);
+void AttachmentManager::removeIfHandedOffLocked(Shard& shard, const std::string& attachmentId) {
+    auto it = shard.attachmentDetailsMap.find(attachmentId);
+    if (it != shard.attachmentDetailsMap.end() && it->second.attachment &&
+        it->second.attachment->hasCreatedReader() && it->second.attachment->hasCreatedWriter()) {
+        shard.attachmentDetailsMap.erase(it);
+    }
+}
+
+bool AttachmentManager::isContextReferenced(
+    const std::unordered_map<std::string, unsigned int>& contextReferenceCounts,
+    const std::string& attachmentId) {
+    // Attachment ids are made by generateAttachmentId(), so an attachment's id is its contextId or starts with it.
+    for (const auto& iter : contextReferenceCounts) {
+        auto& contextId = iter.first;
+        auto prefix = contextId + ATTACHMENT_ID_COMBINING_SUBSTRING;
+        if (attachmentId == contextId || attachmentId.compare(0, prefix.size(), prefix) == 0) {
+            return true;
         }
     }
+    return false;
+}
+
+void AttachmentManager::removeExpiredAttachments() {
+    std::chrono::minutes expirationMinutes;
+    std::chrono::milliseconds gracePeriod;
+    std::unordered_map<std::string, unsigned int> contextReferenceCounts;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        expirationMinutes = m_attachmentExpirationMinutes;
+        gracePeriod = m_unreferencedAttachmentGracePeriod;
+        contextReferenceCounts = m_contextReferenceCounts;
+    }
 
-    for (auto id : idsToErase) {
-        m_attachmentDetailsMap.erase(id);
+    auto now = std::chrono::steady_clock::now();
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto iter = shard.attachmentDetailsMap.begin(); iter != shard.attachmentDetailsMap.end();) {
+            auto& details = iter->second;
+
+            /*
+             * Our criteria for releasing an AttachmentManagementDetails object - either:
+             *  - The attachment could not be created, other than because the memory budget refused its buffer.
+             *  - Only the reader or writer future was returned, and the attachment has exceeded its lifetime limit.
+             *  - Only the reader or writer future was returned, and it has been destroyed, and no directive which
+             *    might still ask for the other one remains.
+             *  - The memory budget refused its buffer, and no directive which might still ask for it remains.
+             * Attachments with both a reader and a writer are released as soon as the second one is created.
+             */
+
+            auto attachmentLifetime = std::chrono::duration_cast<std::chrono::minutes>(now - details.creationTime);
+            auto& attachment = details.attachment;
+
+            if ((!attachment && !details.isRejected) || attachmentLifetime > expirationMinutes ||
+                (now - details.creationTime > gracePeriod && (!attachment || !attachment->hasLiveReaderOrWriter()) &&
+                 !isContextReferenced(contextReferenceCounts, iter->first))) {
+                iter = shard.attachmentDetailsMap.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
     }
 }
 
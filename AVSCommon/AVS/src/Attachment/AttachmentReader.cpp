@@ -0,0 +1,130 @@
+/*
+ * AttachmentReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "AVSCommon/AVS/Attachment/AttachmentReader.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AttachmentReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * Get the status of a read made of several reads, from the status of the last of them.  Running out of data ends the
+ * read, but only an error spoils the data which was already read.
+ *
+ * @param bytesRead The number of bytes read by all of the reads.
+ * @param status The status of the last read.
+ * @return The status of the whole read.
+ */
+static AttachmentReader::ReadStatus getCombinedStatus(std::size_t bytesRead, AttachmentReader::ReadStatus status) {
+    switch (status) {
+        case AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+        case AttachmentReader::ReadStatus::OK_TIMEDOUT:
+        case AttachmentReader::ReadStatus::CLOSED:
+            return bytesRead > 0 ? AttachmentReader::ReadStatus::OK : status;
+        default:
+            return status;
+    }
+}
+
+std::size_t AttachmentReader::readv(
+    const ReadBuffer* buffers,
+    std::size_t numBuffers,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readvFailed").d("reason", "read status is nullptr"));
+        return 0;
+    }
+    if (!buffers && numBuffers > 0) {
+        ACSDK_ERROR(LX("readvFailed").d("reason", "buffers is nullptr"));
+        *readStatus = ReadStatus::ERROR_INTERNAL;
+        return 0;
+    }
+
+    *readStatus = ReadStatus::OK;
+    std::size_t bytesRead = 0;
+    for (std::size_t i = 0; i < numBuffers; ++i) {
+        if (0 == buffers[i].numBytes) {
+            continue;
+        }
+        auto status = ReadStatus::OK;
+        auto count = read(buffers[i].data, buffers[i].numBytes, &status, timeoutMs);
+        bytesRead += count;
+        if (ReadStatus::OK != status || count < buffers[i].numBytes) {
+            *readStatus = getCombinedStatus(bytesRead, status);
+            break;
+        }
+    }
+    return bytesRead;
+}
+
+std::size_t AttachmentReader::readAtLeast(
+    void* buf,
+    std::size_t numBytes,
+    std::size_t minBytes,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readAtLeastFailed").d("reason", "read status is nullptr"));
+        return 0;
+    }
+
+    minBytes = std::min(std::max(minBytes, static_cast<std::size_t>(1)), numBytes);
+    auto deadline = std::chrono::steady_clock::now() + timeoutMs;
+    auto buf8 = static_cast<uint8_t*>(buf);
+    std::size_t bytesRead = 0;
+    *readStatus = ReadStatus::OK;
+    while (bytesRead < minBytes) {
+        // A zero timeout waits forever, so a timeout which has run out must end the read rather than be passed on.
+        auto timeout = timeoutMs;
+        if (timeoutMs > std::chrono::milliseconds::zero()) {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            timeout = std::chrono::duration_cast<std::chrono::milliseconds>(remaining);
+            if (timeout <= std::chrono::milliseconds::zero()) {
+                *readStatus = getCombinedStatus(bytesRead, ReadStatus::OK_TIMEDOUT);
+                break;
+            }
+        }
+        auto status = ReadStatus::OK;
+        bytesRead += read(buf8 + bytesRead, numBytes - bytesRead, &status, timeout);
+        if (ReadStatus::OK != status) {
+            *readStatus = getCombinedStatus(bytesRead, status);
+            break;
+        }
+    }
+    return bytesRead;
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
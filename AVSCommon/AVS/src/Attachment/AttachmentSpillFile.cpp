@@ -0,0 +1,215 @@
+/*
+ * AttachmentSpillFile.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <vector>
+
+#include <unistd.h>
+
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AttachmentSpillFile");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The template of the name of the file, for @c mkstemp().
+static const std::string FILE_NAME_TEMPLATE = "/acsdkAttachmentXXXXXX";
+
+std::shared_ptr<AttachmentSpillFile> AttachmentSpillFile::create(const std::string& directory, size_t maxSize) {
+    if (directory.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "emptyDirectory"));
+        return nullptr;
+    }
+    if (0 == maxSize) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxSize"));
+        return nullptr;
+    }
+    return std::shared_ptr<AttachmentSpillFile>(new AttachmentSpillFile(directory, maxSize));
+}
+
+AttachmentSpillFile::AttachmentSpillFile(const std::string& directory, size_t maxSize) :
+        m_directory{directory},
+        m_maxSize{maxSize},
+        m_fd{-1},
+        m_size{0},
+        m_isWriterClosed{false},
+        m_isReaderClosed{false} {
+}
+
+AttachmentSpillFile::~AttachmentSpillFile() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool AttachmentSpillFile::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd >= 0) {
+        return true;
+    }
+    auto path = m_directory + FILE_NAME_TEMPLATE;
+    std::vector<char> pathBuffer(path.begin(), path.end());
+    pathBuffer.push_back('\0');
+    int fd = mkstemp(pathBuffer.data());
+    if (fd < 0) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "mkstempFailed").d("directory", m_directory).d("error", errno));
+        return false;
+    }
+    // Unlink the file at once, so that it goes away with the descriptor.
+    if (unlink(pathBuffer.data()) != 0) {
+        ACSDK_WARN(LX("startWarning").d("reason", "unlinkFailed").d("path", pathBuffer.data()).d("error", errno));
+    }
+    ACSDK_DEBUG(LX("started"));
+    m_fd = fd;
+    return true;
+}
+
+bool AttachmentSpillFile::isStarted() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fd >= 0;
+}
+
+size_t AttachmentSpillFile::write(const void* buf, size_t numBytes, AttachmentWriter::WriteStatus* writeStatus) {
+    if (!writeStatus) {
+        ACSDK_ERROR(LX("writeFailed").d("reason", "nullWriteStatus"));
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_fd < 0 || m_isWriterClosed) {
+        *writeStatus = AttachmentWriter::WriteStatus::CLOSED;
+        return 0;
+    }
+    *writeStatus = AttachmentWriter::WriteStatus::OK;
+    if (m_isReaderClosed) {
+        return numBytes;
+    }
+    if (numBytes > m_maxSize - m_size) {
+        *writeStatus = AttachmentWriter::WriteStatus::OK_BUFFER_FULL;
+        return 0;
+    }
+    // Only the writer changes m_size, and the reader does not read past it, so the data can be written unlocked.
+    auto offset = m_size;
+    lock.unlock();
+
+    auto data = static_cast<const char*>(buf);
+    size_t written = 0;
+    while (written < numBytes) {
+        auto result = pwrite(m_fd, data + written, numBytes - written, offset + written);
+        if (result < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            ACSDK_ERROR(LX("writeFailed").d("reason", "pwriteFailed").d("error", errno));
+            *writeStatus = AttachmentWriter::WriteStatus::ERROR_INTERNAL;
+            return 0;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    lock.lock();
+    m_size += numBytes;
+    m_wakeTrigger.notify_all();
+    return numBytes;
+}
+
+void AttachmentSpillFile::closeWriter() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isWriterClosed = true;
+    m_wakeTrigger.notify_all();
+}
+
+size_t AttachmentSpillFile::read(
+    size_t offset,
+    void* buf,
+    size_t numBytes,
+    AttachmentReader::Policy policy,
+    std::chrono::milliseconds timeout,
+    AttachmentReader::ReadStatus* readStatus) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullReadStatus"));
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto canRead = [this, offset]() { return m_size > offset || m_isWriterClosed || m_isReaderClosed; };
+    if (AttachmentReader::Policy::BLOCKING == policy && !canRead()) {
+        if (timeout == std::chrono::milliseconds::zero()) {
+            m_wakeTrigger.wait(lock, canRead);
+        } else if (!m_wakeTrigger.wait_for(lock, timeout, canRead)) {
+            *readStatus = AttachmentReader::ReadStatus::OK_TIMEDOUT;
+            return 0;
+        }
+    }
+    if (m_fd < 0 || m_isReaderClosed || (m_size <= offset && m_isWriterClosed)) {
+        *readStatus = AttachmentReader::ReadStatus::CLOSED;
+        return 0;
+    }
+    if (m_size <= offset) {
+        *readStatus = AttachmentReader::ReadStatus::OK_WOULDBLOCK;
+        return 0;
+    }
+    auto available = std::min(numBytes, m_size - offset);
+    lock.unlock();
+
+    auto data = static_cast<char*>(buf);
+    size_t bytesRead = 0;
+    while (bytesRead < available) {
+        auto result = pread(m_fd, data + bytesRead, available - bytesRead, offset + bytesRead);
+        if (result < 0 && EINTR == errno) {
+            continue;
+        }
+        if (result <= 0) {
+            ACSDK_ERROR(LX("readFailed").d("reason", "preadFailed").d("error", result < 0 ? errno : 0));
+            *readStatus = AttachmentReader::ReadStatus::ERROR_INTERNAL;
+            return bytesRead;
+        }
+        bytesRead += static_cast<size_t>(result);
+    }
+    *readStatus = AttachmentReader::ReadStatus::OK;
+    return bytesRead;
+}
+
+void AttachmentSpillFile::closeReader() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isReaderClosed = true;
+    m_wakeTrigger.notify_all();
+}
+
+size_t AttachmentSpillFile::getSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -17,6 +17,7 @@
 
 #include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
 #include "AVSCommon/Utils/Memory/Memory.h"
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -24,13 +25,18 @@ namespace avs {
 namespace attachment {
 
 using namespace alexaClientSDK::avsCommon::utils::memory;
+using namespace alexaClientSDK::avsCommon::utils::metrics;
 
 InProcessAttachment::InProcessAttachment(const std::string& id, std::unique_ptr<SDSType> sds) :
         Attachment(id),
         m_sds{std::move(sds)} {
     if (!m_sds) {
         auto buffSize = SDSType::calculateBufferSize(SDS_BUFFER_DEFAULT_SIZE_IN_BYTES);
-        auto buff = std::make_shared<SDSBufferType>(buffSize);
+        // The buffer is counted until the last of this attachment and its readers and writers releases it.
+        auto allocation =
+            std::make_shared<MemoryAccounting::Allocation>(MemoryAccounting::Category::ATTACHMENTS, buffSize);
+        auto buff = std::shared_ptr<SDSBufferType>(
+            new SDSBufferType(buffSize), [allocation](SDSBufferType* buffer) { delete buffer; });
         m_sds = SDSType::create(buff);
     }
 }
@@ -65,6 +71,11 @@ std::unique_ptr<AttachmentReader> InProcessAttachment::createReader(AttachmentRe
     return std::move(reader);
 }
 
+bool InProcessAttachment::hasLiveReaderOrWriter() const {
+    // Readers and writers share the stream with this object, so it is only referenced here once they are gone.
+    return m_sds.use_count() > 1;
+}
+
 }  // namespace attachment
 }  // namespace avs
 }  // namespace avsCommon
@@ -15,6 +15,9 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <cstring>
+
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentReader.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 
@@ -55,7 +58,7 @@ std::unique_ptr<InProcessAttachmentReader> InProcessAttachmentReader::create(
     return reader;
 }
 
-InProcessAttachmentReader::InProcessAttachmentReader(Policy policy, std::shared_ptr<SDSType> sds) {
+InProcessAttachmentReader::InProcessAttachmentReader(Policy policy, std::shared_ptr<SDSType> sds) : m_sds{sds} {
     if (!sds) {
         ACSDK_ERROR(LX("ConstructorFailed").d("reason", "SDS parameter is nullptr"));
         return;
@@ -81,6 +84,15 @@ std::size_t InProcessAttachmentReader::read(
     std::size_t numBytes,
     ReadStatus* readStatus,
     std::chrono::milliseconds timeoutMs) {
+    ReadBuffer buffer = {buf, numBytes};
+    return readv(&buffer, 1, readStatus, timeoutMs);
+}
+
+std::size_t InProcessAttachmentReader::readv(
+    const ReadBuffer* buffers,
+    std::size_t numBuffers,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
     if (!readStatus) {
         ACSDK_ERROR(LX("readFailed").d("reason", "read status is nullptr"));
         return 0;
@@ -98,6 +110,22 @@ std::size_t InProcessAttachmentReader::read(
         return 0;
     }
 
+    if (!buffers && numBuffers > 0) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "buffers is nullptr"));
+        *readStatus = ReadStatus::ERROR_INTERNAL;
+        return 0;
+    }
+
+    std::size_t numBytes = 0;
+    for (std::size_t i = 0; i < numBuffers; ++i) {
+        if (!buffers[i].data && buffers[i].numBytes > 0) {
+            ACSDK_ERROR(LX("readFailed").d("reason", "buffer is nullptr"));
+            *readStatus = ReadStatus::ERROR_INTERNAL;
+            return 0;
+        }
+        numBytes += buffers[i].numBytes;
+    }
+
     *readStatus = ReadStatus::OK;
 
     if (0 == numBytes) {
@@ -114,7 +142,30 @@ std::size_t InProcessAttachmentReader::read(
     std::size_t bytesRead = 0;
     auto numWords = numBytes / wordSize;
 
-    auto readResult = m_reader->read(buf, numWords, timeoutMs);
+    // The data is copied from where it lies in the SDS, which may be in two spans if it wraps, into the buffers.
+    SDSTypeReader::Span spans[2];
+    auto readResult = m_reader->peek(numWords, spans, timeoutMs);
+    if (readResult > 0) {
+        std::size_t bufferIndex = 0;
+        std::size_t bufferOffset = 0;
+        for (const auto& span : spans) {
+            auto source = static_cast<const uint8_t*>(span.data);
+            auto bytesLeft = span.nWords * wordSize;
+            while (bytesLeft > 0) {
+                const auto& buffer = buffers[bufferIndex];
+                auto count = std::min(bytesLeft, buffer.numBytes - bufferOffset);
+                std::memcpy(static_cast<uint8_t*>(buffer.data) + bufferOffset, source, count);
+                source += count;
+                bytesLeft -= count;
+                bufferOffset += count;
+                if (buffer.numBytes == bufferOffset) {
+                    ++bufferIndex;
+                    bufferOffset = 0;
+                }
+            }
+        }
+        readResult = m_reader->advance(readResult);
+    }
 
     /*
      * Convert SDS return code accordingly:
@@ -160,6 +211,25 @@ std::size_t InProcessAttachmentReader::read(
     return bytesRead;
 }
 
+std::size_t InProcessAttachmentReader::readAtLeast(
+    void* buf,
+    std::size_t numBytes,
+    std::size_t minBytes,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    // Waking only once the words wanted are available saves a wakeup, and a read, per write.
+    if (m_reader) {
+        auto wordSize = m_reader->getWordSize();
+        m_reader->setWakeupThreshold((std::min(minBytes, numBytes) + wordSize - 1) / wordSize);
+    }
+    ReadBuffer buffer = {buf, numBytes};
+    auto bytesRead = readv(&buffer, 1, readStatus, timeoutMs);
+    if (m_reader) {
+        m_reader->setWakeupThreshold(1);
+    }
+    return bytesRead;
+}
+
 void InProcessAttachmentReader::close(ClosePoint closePoint) {
     if (m_reader) {
         switch (closePoint) {
@@ -173,6 +243,14 @@ void InProcessAttachmentReader::close(ClosePoint closePoint) {
     }
 }
 
+bool InProcessAttachmentReader::setDataAvailableCallback(std::function<void()> callback) {
+    if (!m_reader) {
+        return false;
+    }
+    m_reader->setDataAvailableCallback(std::move(callback));
+    return true;
+}
+
 }  // namespace attachment
 }  // namespace avs
 }  // namespace avsCommon
@@ -46,7 +46,7 @@ std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::create(std
     return writer;
 }
 
-InProcessAttachmentWriter::InProcessAttachmentWriter(std::shared_ptr<SDSType> sds) {
+InProcessAttachmentWriter::InProcessAttachmentWriter(std::shared_ptr<SDSType> sds) : m_sds{sds} {
     if (!sds) {
         ACSDK_ERROR(LX("constructorFailed").d("reason", "SDS parameter is nullptr"));
         return;
@@ -0,0 +1,90 @@
+/*
+ * SpillingAttachment.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/AVS/Attachment/SpillingAttachment.h"
+#include "AVSCommon/AVS/Attachment/SpillingAttachmentReader.h"
+#include "AVSCommon/AVS/Attachment/SpillingAttachmentWriter.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+SpillingAttachment::SpillingAttachment(
+    const std::string& id,
+    const std::string& spillDirectory,
+    size_t maxSpillSize,
+    std::unique_ptr<SDSType> sds) :
+        Attachment(id),
+        m_sds{std::move(sds)},
+        m_spillFile{AttachmentSpillFile::create(spillDirectory, maxSpillSize)} {
+    if (!m_sds) {
+        auto buffSize = SDSType::calculateBufferSize(InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES);
+        auto buff = std::make_shared<InProcessAttachment::SDSBufferType>(buffSize);
+        m_sds = SDSType::create(buff);
+    }
+}
+
+std::unique_ptr<AttachmentWriter> SpillingAttachment::createWriter() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_hasCreatedWriter) {
+        return nullptr;
+    }
+
+    std::unique_ptr<AttachmentWriter> writer;
+    if (m_spillFile) {
+        writer = SpillingAttachmentWriter::create(m_sds, m_spillFile);
+    } else {
+        writer = InProcessAttachmentWriter::create(m_sds);
+    }
+    if (writer) {
+        m_hasCreatedWriter = true;
+    }
+
+    return writer;
+}
+
+std::unique_ptr<AttachmentReader> SpillingAttachment::createReader(AttachmentReader::Policy policy) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_hasCreatedReader) {
+        return nullptr;
+    }
+
+    std::unique_ptr<AttachmentReader> reader;
+    if (m_spillFile) {
+        reader = SpillingAttachmentReader::create(policy, m_sds, m_spillFile);
+    } else {
+        reader = InProcessAttachmentReader::create(policy, m_sds);
+    }
+    if (reader) {
+        m_hasCreatedReader = true;
+    }
+
+    return reader;
+}
+
+bool SpillingAttachment::hasLiveReaderOrWriter() const {
+    // Readers and writers share the stream with this object, so it is only referenced here once they are gone.
+    return m_sds.use_count() > 1;
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,126 @@
+/*
+ * SpillingAttachmentReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "AVSCommon/AVS/Attachment/SpillingAttachmentReader.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SpillingAttachmentReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::unique_ptr<SpillingAttachmentReader> SpillingAttachmentReader::create(
+    Policy policy,
+    std::shared_ptr<SDSType> sds,
+    std::shared_ptr<AttachmentSpillFile> spillFile) {
+    if (!spillFile) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullSpillFile"));
+        return nullptr;
+    }
+    auto bufferReader = InProcessAttachmentReader::create(policy, sds);
+    if (!bufferReader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createBufferReaderFailed"));
+        return nullptr;
+    }
+    return std::unique_ptr<SpillingAttachmentReader>(
+        new SpillingAttachmentReader(policy, std::move(bufferReader), spillFile));
+}
+
+SpillingAttachmentReader::SpillingAttachmentReader(
+    Policy policy,
+    std::unique_ptr<InProcessAttachmentReader> bufferReader,
+    std::shared_ptr<AttachmentSpillFile> spillFile) :
+        m_policy{policy},
+        m_bufferReader{std::move(bufferReader)},
+        m_spillFile{spillFile},
+        m_isReadingSpillFile{false},
+        m_spillOffset{0},
+        m_spillLimit{std::numeric_limits<size_t>::max()},
+        m_isClosed{false} {
+}
+
+SpillingAttachmentReader::~SpillingAttachmentReader() {
+    close(ClosePoint::IMMEDIATELY);
+}
+
+std::size_t SpillingAttachmentReader::read(
+    void* buf,
+    std::size_t numBytes,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "read status is nullptr"));
+        return 0;
+    }
+    if (m_isClosed) {
+        *readStatus = ReadStatus::CLOSED;
+        return 0;
+    }
+
+    if (!m_isReadingSpillFile) {
+        auto bytesRead = m_bufferReader->read(buf, numBytes, readStatus, timeoutMs);
+        // The writer starts the spill file before it closes the buffer, so a closed buffer has no more data after it.
+        if (ReadStatus::CLOSED != *readStatus || !m_spillFile->isStarted()) {
+            return bytesRead;
+        }
+        ACSDK_DEBUG(LX("readingSpillFile"));
+        m_isReadingSpillFile = true;
+    }
+
+    if (m_spillOffset >= m_spillLimit) {
+        *readStatus = ReadStatus::CLOSED;
+        return 0;
+    }
+    auto bytesRead = m_spillFile->read(
+        m_spillOffset, buf, std::min(numBytes, m_spillLimit - m_spillOffset), m_policy, timeoutMs, readStatus);
+    m_spillOffset += bytesRead;
+    return bytesRead;
+}
+
+void SpillingAttachmentReader::close(ClosePoint closePoint) {
+    if (m_isClosed) {
+        return;
+    }
+    m_bufferReader->close(closePoint);
+    switch (closePoint) {
+        case ClosePoint::IMMEDIATELY:
+            m_isClosed = true;
+            m_spillFile->closeReader();
+            return;
+        case ClosePoint::AFTER_DRAINING_CURRENT_BUFFER:
+            m_spillLimit = std::min(m_spillLimit, m_spillFile->getSize());
+            return;
+    }
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,91 @@
+/*
+ * SpillingAttachmentWriter.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/AVS/Attachment/SpillingAttachmentWriter.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SpillingAttachmentWriter");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::unique_ptr<SpillingAttachmentWriter> SpillingAttachmentWriter::create(
+    std::shared_ptr<SDSType> sds,
+    std::shared_ptr<AttachmentSpillFile> spillFile) {
+    if (!spillFile) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullSpillFile"));
+        return nullptr;
+    }
+    auto bufferWriter = InProcessAttachmentWriter::create(sds);
+    if (!bufferWriter) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createBufferWriterFailed"));
+        return nullptr;
+    }
+    return std::unique_ptr<SpillingAttachmentWriter>(new SpillingAttachmentWriter(std::move(bufferWriter), spillFile));
+}
+
+SpillingAttachmentWriter::SpillingAttachmentWriter(
+    std::unique_ptr<InProcessAttachmentWriter> bufferWriter,
+    std::shared_ptr<AttachmentSpillFile> spillFile) :
+        m_bufferWriter{std::move(bufferWriter)},
+        m_spillFile{spillFile},
+        m_isSpilling{false} {
+}
+
+SpillingAttachmentWriter::~SpillingAttachmentWriter() {
+    close();
+}
+
+std::size_t SpillingAttachmentWriter::write(const void* buf, std::size_t numBytes, WriteStatus* writeStatus) {
+    if (!writeStatus) {
+        ACSDK_ERROR(LX("writeFailed").d("reason", "writeStatus is nullptr"));
+        return 0;
+    }
+
+    if (!m_isSpilling) {
+        auto bytesWritten = m_bufferWriter->write(buf, numBytes, writeStatus);
+        if (WriteStatus::OK_BUFFER_FULL != *writeStatus || !m_spillFile->start()) {
+            return bytesWritten;
+        }
+        // The spill file has started, so the reader moves on to it once it reaches the end of the closed buffer.
+        ACSDK_DEBUG(LX("spilling"));
+        m_bufferWriter->close();
+        m_isSpilling = true;
+    }
+
+    return m_spillFile->write(buf, numBytes, writeStatus);
+}
+
+void SpillingAttachmentWriter::close() {
+    m_bufferWriter->close();
+    m_spillFile->closeWriter();
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,241 @@
+/*
+ * AudioChannelReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "AVSCommon/AVS/AudioChannelReader.h"
+#include "AVSCommon/Utils/Audio/SampleConversion.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+using namespace utils::audio;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioChannelReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const int AudioChannelReader::ALL_CHANNELS;
+const int AudioChannelReader::MIX_CHANNELS;
+
+/// The number of frames of wider samples which are copied out of the stream at a time.
+static const size_t CHUNK_FRAMES = 256;
+
+/**
+ * Get the size of a sample of a type.
+ *
+ * @param sampleType The type of the sample.
+ * @return The number of bytes in a sample.
+ */
+static size_t getSampleSize(AudioInputIngester::SampleType sampleType) {
+    switch (sampleType) {
+        case AudioInputIngester::SampleType::INT16:
+            return sizeof(int16_t);
+        case AudioInputIngester::SampleType::INT32:
+            return sizeof(int32_t);
+        case AudioInputIngester::SampleType::FLOAT32:
+            return sizeof(float);
+    }
+    return 0;
+}
+
+std::unique_ptr<AudioChannelReader> AudioChannelReader::create(
+    std::shared_ptr<AudioInputStream::Reader> reader,
+    AudioInputIngester::SampleType sampleType,
+    unsigned int numChannels,
+    int channel) {
+    if (!reader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullReader"));
+        return nullptr;
+    }
+    if (0 == numChannels) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroChannels"));
+        return nullptr;
+    }
+    if (channel != ALL_CHANNELS && channel != MIX_CHANNELS &&
+        (channel < 0 || static_cast<unsigned int>(channel) >= numChannels)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidChannel").d("channel", channel));
+        return nullptr;
+    }
+    // Even word sizes keep 16-bit samples aligned in the buffer.  Wider samples are copied out before they are used.
+    auto wordSize = reader->getWordSize();
+    auto frameSize = numChannels * getSampleSize(sampleType);
+    if (0 == wordSize || wordSize % 2 != 0 || frameSize % wordSize != 0) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedWordSize")
+                        .d("wordSize", wordSize)
+                        .d("frameSize", frameSize));
+        return nullptr;
+    }
+    return std::unique_ptr<AudioChannelReader>(
+        new AudioChannelReader(std::move(reader), sampleType, numChannels, channel, frameSize / wordSize));
+}
+
+AudioChannelReader::AudioChannelReader(
+    std::shared_ptr<AudioInputStream::Reader> reader,
+    AudioInputIngester::SampleType sampleType,
+    unsigned int numChannels,
+    int channel,
+    size_t wordsPerFrame) :
+        m_reader{std::move(reader)},
+        m_sampleType{sampleType},
+        m_numChannels{numChannels},
+        m_channel{channel},
+        m_wordsPerFrame{wordsPerFrame},
+        m_sampleSize{getSampleSize(sampleType)},
+        m_wrappedFrame(numChannels * m_sampleSize) {
+    // A blocking read should not wake for less than a frame.
+    m_reader->setWakeupThreshold(m_wordsPerFrame);
+    size_t numSamples = CHUNK_FRAMES * numChannels;
+    switch (m_sampleType) {
+        case AudioInputIngester::SampleType::INT16:
+            return;
+        case AudioInputIngester::SampleType::INT32:
+            m_int32Samples.resize(numSamples);
+            break;
+        case AudioInputIngester::SampleType::FLOAT32:
+            m_floatSamples.resize(numSamples);
+            break;
+    }
+    if (MIX_CHANNELS == m_channel) {
+        m_int16Samples.resize(numSamples);
+    }
+}
+
+ssize_t AudioChannelReader::read(int16_t* buf, size_t numFrames, std::chrono::milliseconds timeout) {
+    if (!buf) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullBuffer"));
+        return AudioInputStream::Reader::Error::INVALID;
+    }
+    if (0 == numFrames) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "zeroFrames"));
+        return AudioInputStream::Reader::Error::INVALID;
+    }
+
+    AudioInputStream::Reader::Span spans[2];
+    auto numWords = m_reader->peek(numFrames * m_wordsPerFrame, spans, timeout);
+    if (numWords <= 0) {
+        return numWords;
+    }
+    numFrames = numWords / m_wordsPerFrame;
+    if (0 == numFrames) {
+        return AudioInputStream::Reader::Error::WOULDBLOCK;
+    }
+
+    auto wordSize = m_reader->getWordSize();
+    auto frameSize = m_wordsPerFrame * wordSize;
+    auto output = buf;
+
+    // The frames before the wrap, then a frame split by the wrap, if any, then the frames after the wrap.
+    auto first = static_cast<const uint8_t*>(spans[0].data);
+    auto firstFrames = std::min(numFrames, spans[0].nWords / m_wordsPerFrame);
+    convert(first, firstFrames, output);
+    output += firstFrames * getOutputChannels();
+    auto framesLeft = numFrames - firstFrames;
+    if (framesLeft > 0) {
+        auto second = static_cast<const uint8_t*>(spans[1].data);
+        auto splitBytes = spans[0].nWords * wordSize - firstFrames * frameSize;
+        if (splitBytes > 0) {
+            std::memcpy(m_wrappedFrame.data(), first + firstFrames * frameSize, splitBytes);
+            std::memcpy(m_wrappedFrame.data() + splitBytes, second, frameSize - splitBytes);
+            convert(m_wrappedFrame.data(), 1, output);
+            output += getOutputChannels();
+            second += frameSize - splitBytes;
+            --framesLeft;
+        }
+        convert(second, framesLeft, output);
+    }
+
+    auto advanced = m_reader->advance(numFrames * m_wordsPerFrame);
+    if (advanced < 0) {
+        return advanced;
+    }
+    return numFrames;
+}
+
+unsigned int AudioChannelReader::getOutputChannels() const {
+    return ALL_CHANNELS == m_channel ? m_numChannels : 1;
+}
+
+size_t AudioChannelReader::getWordsPerFrame() const {
+    return m_wordsPerFrame;
+}
+
+std::shared_ptr<AudioInputStream::Reader> AudioChannelReader::getReader() const {
+    return m_reader;
+}
+
+void AudioChannelReader::convert(const uint8_t* input, size_t numFrames, int16_t* output) {
+    if (AudioInputIngester::SampleType::INT16 == m_sampleType) {
+        auto samples = reinterpret_cast<const int16_t*>(input);
+        if (ALL_CHANNELS == m_channel) {
+            std::memcpy(output, samples, numFrames * m_numChannels * sizeof(int16_t));
+        } else if (MIX_CHANNELS == m_channel) {
+            downmixToMono(samples, m_numChannels, output, numFrames);
+        } else {
+            extractChannel(samples, m_numChannels, m_channel, output, numFrames);
+        }
+        return;
+    }
+
+    // Wider samples are copied out a chunk at a time, only the selected channel if there is one, then narrowed.
+    auto frameSize = m_numChannels * m_sampleSize;
+    auto wide = AudioInputIngester::SampleType::INT32 == m_sampleType
+                    ? static_cast<void*>(m_int32Samples.data())
+                    : static_cast<void*>(m_floatSamples.data());
+    while (numFrames > 0) {
+        auto chunkFrames = std::min(numFrames, CHUNK_FRAMES);
+        size_t numSamples = chunkFrames * m_numChannels;
+        if (m_channel >= 0) {
+            auto source = input + m_channel * m_sampleSize;
+            auto destination = static_cast<uint8_t*>(wide);
+            for (size_t frame = 0; frame < chunkFrames; ++frame) {
+                std::memcpy(destination + frame * m_sampleSize, source + frame * frameSize, m_sampleSize);
+            }
+            numSamples = chunkFrames;
+        } else {
+            std::memcpy(wide, input, numSamples * m_sampleSize);
+        }
+
+        auto narrow = MIX_CHANNELS == m_channel ? m_int16Samples.data() : output;
+        if (AudioInputIngester::SampleType::INT32 == m_sampleType) {
+            convertInt32ToInt16(m_int32Samples.data(), narrow, numSamples);
+        } else {
+            convertFloatToInt16(m_floatSamples.data(), narrow, numSamples);
+        }
+        if (MIX_CHANNELS == m_channel) {
+            downmixToMono(narrow, m_numChannels, output, chunkFrames);
+        }
+
+        input += chunkFrames * frameSize;
+        output += chunkFrames * getOutputChannels();
+        numFrames -= chunkFrames;
+    }
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,148 @@
+/*
+ * AudioInputIngester.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/AVS/AudioInputIngester.h"
+#include "AVSCommon/Utils/Audio/SampleConversion.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+using namespace utils::audio;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioInputIngester");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const unsigned int AudioInputIngester::OUTPUT_SAMPLE_RATE_HZ;
+
+std::unique_ptr<AudioInputIngester> AudioInputIngester::create(
+    std::shared_ptr<AudioInputStream> stream,
+    SampleType sampleType,
+    unsigned int sampleRateHz,
+    unsigned int numChannels,
+    AudioInputStream::Writer::Policy policy) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (stream->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedWordSize").d("wordSize", stream->getWordSize()));
+        return nullptr;
+    }
+    if (0 == sampleRateHz || sampleRateHz % OUTPUT_SAMPLE_RATE_HZ != 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedSampleRate").d("sampleRateHz", sampleRateHz));
+        return nullptr;
+    }
+    if (0 == numChannels) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroChannels"));
+        return nullptr;
+    }
+    std::unique_ptr<Decimator> decimator;
+    if (sampleRateHz != OUTPUT_SAMPLE_RATE_HZ) {
+        decimator = Decimator::create(sampleRateHz / OUTPUT_SAMPLE_RATE_HZ);
+        if (!decimator) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "createDecimatorFailed"));
+            return nullptr;
+        }
+    }
+    auto writer = stream->createWriter(policy);
+    if (!writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createWriterFailed"));
+        return nullptr;
+    }
+    ACSDK_DEBUG(LX("create").d("sampleType", sampleType).d("sampleRateHz", sampleRateHz).d("numChannels", numChannels));
+    return std::unique_ptr<AudioInputIngester>(
+        new AudioInputIngester(std::move(writer), sampleType, numChannels, std::move(decimator)));
+}
+
+utils::AudioFormat AudioInputIngester::getOutputFormat() {
+    return {utils::AudioFormat::Encoding::LPCM,
+            utils::AudioFormat::Endianness::LITTLE,
+            OUTPUT_SAMPLE_RATE_HZ,
+            sizeof(int16_t) * 8,
+            1};
+}
+
+AudioInputIngester::AudioInputIngester(
+    std::unique_ptr<AudioInputStream::Writer> writer,
+    SampleType sampleType,
+    unsigned int numChannels,
+    std::unique_ptr<Decimator> decimator) :
+        m_writer{std::move(writer)},
+        m_sampleType{sampleType},
+        m_numChannels{numChannels},
+        m_decimator{std::move(decimator)} {
+}
+
+ssize_t AudioInputIngester::write(const void* buf, size_t numFrames) {
+    if (!buf) {
+        ACSDK_ERROR(LX("writeFailed").d("reason", "nullBuffer"));
+        return AudioInputStream::Writer::Error::INVALID;
+    }
+    if (0 == numFrames) {
+        ACSDK_ERROR(LX("writeFailed").d("reason", "zeroFrames"));
+        return AudioInputStream::Writer::Error::INVALID;
+    }
+
+    // Convert the samples to 16 bits, and mix them down to mono.  Mono 16-bit audio is used where it is.
+    auto numSamples = numFrames * m_numChannels;
+    const int16_t* mono = static_cast<const int16_t*>(buf);
+    if (m_sampleType != SampleType::INT16 || m_numChannels > 1) {
+        m_samples.resize(numSamples);
+        switch (m_sampleType) {
+            case SampleType::INT16:
+                downmixToMono(static_cast<const int16_t*>(buf), m_numChannels, m_samples.data(), numFrames);
+                break;
+            case SampleType::INT32:
+                convertInt32ToInt16(static_cast<const int32_t*>(buf), m_samples.data(), numSamples);
+                downmixToMono(m_samples.data(), m_numChannels, m_samples.data(), numFrames);
+                break;
+            case SampleType::FLOAT32:
+                convertFloatToInt16(static_cast<const float*>(buf), m_samples.data(), numSamples);
+                downmixToMono(m_samples.data(), m_numChannels, m_samples.data(), numFrames);
+                break;
+        }
+        mono = m_samples.data();
+    }
+
+    if (!m_decimator) {
+        return m_writer->write(mono, numFrames);
+    }
+    m_output.resize(m_decimator->getOutputSize(numFrames));
+    auto numOutput = m_decimator->process(mono, numFrames, m_output.data());
+    if (0 == numOutput) {
+        // The samples are kept by the decimator until the next call.
+        return 0;
+    }
+    return m_writer->write(m_output.data(), numOutput);
+}
+
+void AudioInputIngester::close() {
+    m_writer->close();
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
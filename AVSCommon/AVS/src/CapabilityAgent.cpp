@@ -42,17 +42,156 @@ static const std::string TAG("CapabilityAgent");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The number of in-flight directives an agent has room for before its vector of them grows.
+static const size_t INITIAL_DIRECTIVE_INFO_CAPACITY = 8;
+
+/// The most released blocks a @c DirectiveInfoPool keeps for reuse.
+static const size_t MAX_FREE_DIRECTIVE_INFO_BLOCKS = 8;
+
+/**
+ * The blocks are all of one size, that of a @c DirectiveInfo together with the control block of its
+ * @c std::shared_ptr.  A released block is kept for the next allocation, up to a limit, rather than freed.
+ */
+class CapabilityAgent::DirectiveInfoPool {
+public:
+    /// Constructor.
+    DirectiveInfoPool() : m_blockSize{0} {
+        m_freeBlocks.reserve(MAX_FREE_DIRECTIVE_INFO_BLOCKS);
+    }
+
+    /// Destructor.  Frees the kept blocks.
+    ~DirectiveInfoPool() {
+        for (auto block : m_freeBlocks) {
+            ::operator delete(block);
+        }
+    }
+
+    /**
+     * Allocate a block, reusing a released one if there is one of the size.
+     *
+     * @param size The size of the block.
+     * @return The block.
+     */
+    void* allocate(size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (0 == m_blockSize) {
+                m_blockSize = size;
+            }
+            if (size == m_blockSize && !m_freeBlocks.empty()) {
+                auto block = m_freeBlocks.back();
+                m_freeBlocks.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    /**
+     * Release a block, keeping it for reuse if there is room.
+     *
+     * @param block The block.
+     * @param size The size of the block.
+     */
+    void deallocate(void* block, size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (size == m_blockSize && m_freeBlocks.size() < MAX_FREE_DIRECTIVE_INFO_BLOCKS) {
+                m_freeBlocks.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+private:
+    /// Mutex to protect the members, since a @c DirectiveInfo may be released on any thread.
+    std::mutex m_mutex;
+
+    /// The size of the blocks kept, that of the first allocation.
+    size_t m_blockSize;
+
+    /// The released blocks kept for reuse.
+    std::vector<void*> m_freeBlocks;
+};
+
+/**
+ * The allocator @c std::allocate_shared rebinds to allocate each @c DirectiveInfo together with its control block.
+ * It holds the pool, so a @c DirectiveInfo which outlives its @c CapabilityAgent is still released to it.
+ */
+template <typename T>
+class CapabilityAgent::DirectiveInfoAllocator {
+public:
+    /// The type of the values allocated.
+    using value_type = T;
+
+    /**
+     * Constructor.
+     *
+     * @param pool The pool to allocate from.
+     */
+    explicit DirectiveInfoAllocator(std::shared_ptr<DirectiveInfoPool> pool) : m_pool{std::move(pool)} {
+    }
+
+    /**
+     * Constructor from an allocator of another type, sharing its pool.
+     *
+     * @param other The other allocator.
+     */
+    template <typename U>
+    DirectiveInfoAllocator(const DirectiveInfoAllocator<U>& other) : m_pool{other.m_pool} {
+    }
+
+    /**
+     * Allocate room for values.
+     *
+     * @param count The number of values.
+     * @return The room for the values.
+     */
+    T* allocate(size_t count) {
+        return static_cast<T*>(m_pool->allocate(count * sizeof(T)));
+    }
+
+    /**
+     * Release room allocated for values.
+     *
+     * @param values The room for the values.
+     * @param count The number of values.
+     */
+    void deallocate(T* values, size_t count) {
+        m_pool->deallocate(values, count * sizeof(T));
+    }
+
+    /// Allocators are equal when they share a pool.
+    template <typename U>
+    bool operator==(const DirectiveInfoAllocator<U>& other) const {
+        return m_pool == other.m_pool;
+    }
+
+    /// Allocators are equal when they share a pool.
+    template <typename U>
+    bool operator!=(const DirectiveInfoAllocator<U>& other) const {
+        return m_pool != other.m_pool;
+    }
+
+    /// The pool to allocate from.
+    std::shared_ptr<DirectiveInfoPool> m_pool;
+};
+
 std::shared_ptr<CapabilityAgent::DirectiveInfo> CapabilityAgent::createDirectiveInfo(
     std::shared_ptr<AVSDirective> directive,
     std::unique_ptr<sdkInterfaces::DirectiveHandlerResultInterface> result) {
-    return std::make_shared<DirectiveInfo>(directive, std::move(result));
+    return std::allocate_shared<DirectiveInfo>(
+        DirectiveInfoAllocator<DirectiveInfo>(m_directiveInfoPool), directive, std::move(result));
 }
 
 CapabilityAgent::CapabilityAgent(
     const std::string& nameSpace,
     std::shared_ptr<sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender) :
         m_namespace{nameSpace},
-        m_exceptionEncounteredSender{exceptionEncounteredSender} {
+        m_exceptionEncounteredSender{exceptionEncounteredSender},
+        m_directiveInfoPool{std::make_shared<DirectiveInfoPool>()} {
+    m_directiveInfos.reserve(INITIAL_DIRECTIVE_INFO_CAPACITY);
 }
 
 CapabilityAgent::DirectiveInfo::DirectiveInfo(
@@ -77,11 +216,11 @@ void CapabilityAgent::preHandleDirective(
         }
         return;
     }
-    ACSDK_DEBUG(LX("addingMessageIdToMap").d("messageId", messageId));
+    ACSDK_DEBUG(LX("addingDirectiveInfo").d("messageId", messageId));
     info = createDirectiveInfo(directive, std::move(result));
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_directiveInfoMap[messageId] = info;
+        m_directiveInfos.push_back(info);
     }
     preHandleDirective(info);
 }
@@ -105,14 +244,42 @@ void CapabilityAgent::cancelDirective(const std::string& messageId) {
     cancelDirective(info);
 }
 
+bool CapabilityAgent::handleDirective(std::shared_ptr<AVSDirective> directive) {
+    auto info = getDirectiveInfo(directive);
+    if (!info) {
+        ACSDK_ERROR(
+            LX("handleDirectiveFailed").d("reason", "directiveNotFound").d("messageId", directive->getMessageId()));
+        return false;
+    }
+    handleDirective(info);
+    return true;
+}
+
+void CapabilityAgent::cancelDirective(std::shared_ptr<AVSDirective> directive) {
+    auto info = getDirectiveInfo(directive);
+    if (!info) {
+        ACSDK_ERROR(
+            LX("cancelDirectiveFailed").d("reason", "directiveNotFound").d("messageId", directive->getMessageId()));
+        return;
+    }
+    cancelDirective(info);
+}
+
 void CapabilityAgent::onDeregistered() {
     // default no op
 }
 
 void CapabilityAgent::removeDirective(const std::string& messageId) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    ACSDK_DEBUG(LX("removingMessageIdFromMap").d("messageId", messageId));
-    m_directiveInfoMap.erase(messageId);
+    ACSDK_DEBUG(LX("removingDirectiveInfo").d("messageId", messageId));
+    for (auto it = m_directiveInfos.begin(); it != m_directiveInfos.end(); ++it) {
+        if ((*it)->directive->getMessageId() == messageId) {
+            // Order does not matter, so fill the hole with the last one rather than shift the rest down.
+            std::swap(*it, m_directiveInfos.back());
+            m_directiveInfos.pop_back();
+            return;
+        }
+    }
 }
 
 void CapabilityAgent::onFocusChanged(FocusState) {
@@ -141,9 +308,21 @@ const std::pair<std::string, std::string> CapabilityAgent::buildJsonEventString(
 
 std::shared_ptr<CapabilityAgent::DirectiveInfo> CapabilityAgent::getDirectiveInfo(const std::string& messageId) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_directiveInfoMap.find(messageId);
-    if (it != m_directiveInfoMap.end()) {
-        return it->second;
+    for (const auto& info : m_directiveInfos) {
+        if (info->directive->getMessageId() == messageId) {
+            return info;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<CapabilityAgent::DirectiveInfo> CapabilityAgent::getDirectiveInfo(
+    const std::shared_ptr<AVSDirective>& directive) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& info : m_directiveInfos) {
+        if (info->directive == directive) {
+            return info;
+        }
     }
     return nullptr;
 }
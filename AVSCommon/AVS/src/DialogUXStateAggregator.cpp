@@ -15,7 +15,10 @@
  * permissions and limitations under the License.
  */
 
+#include <functional>
+
 #include "AVSCommon/AVS/DialogUXStateAggregator.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -38,9 +41,15 @@ static const std::string TAG("DialogUXStateAggregator");
  */
 static const std::chrono::milliseconds SHORT_TIMEOUT{200};
 
-DialogUXStateAggregator::DialogUXStateAggregator(std::chrono::milliseconds timeoutForThinkingToIdle) :
+DialogUXStateAggregator::DialogUXStateAggregator(
+    std::chrono::milliseconds timeoutForThinkingToIdle,
+    std::chrono::milliseconds coalescingInterval) :
         m_currentState{DialogUXStateObserverInterface::DialogUXState::IDLE},
-        m_timeoutForThinkingToIdle{timeoutForThinkingToIdle} {
+        m_timeoutForThinkingToIdle{timeoutForThinkingToIdle},
+        m_coalescingInterval{coalescingInterval},
+        m_isNotificationPending{false},
+        m_stateToNotify{DialogUXStateObserverInterface::DialogUXState::IDLE},
+        m_notifiedState{DialogUXStateObserverInterface::DialogUXState::IDLE} {
 }
 
 void DialogUXStateAggregator::addObserver(std::shared_ptr<DialogUXStateObserverInterface> observer) {
@@ -50,7 +59,8 @@ void DialogUXStateAggregator::addObserver(std::shared_ptr<DialogUXStateObserverI
     }
     m_executor.submit([this, observer]() {
         m_observers.insert(observer);
-        observer->onDialogUXStateChanged(m_currentState);
+        // In coalescing mode the pending state, if any, reaches the new observer at the end of the frame.
+        observer->onDialogUXStateChanged(m_notifiedState);
     });
 }
 
@@ -79,11 +89,10 @@ void DialogUXStateAggregator::onStateChanged(AudioInputProcessorObserverInterfac
                 return;
             case AudioInputProcessorObserverInterface::State::BUSY:
                 setState(DialogUXStateObserverInterface::DialogUXState::THINKING);
-                if (!m_thinkingToIdleTimer
-                         .start(
-                             m_timeoutForThinkingToIdle,
-                             std::bind(&DialogUXStateAggregator::transitionFromThinkingTimedOut, this))
-                         .valid()) {
+                m_thinkingToIdleTask = m_executor.submitAfter(
+                    m_timeoutForThinkingToIdle,
+                    std::bind(&DialogUXStateAggregator::transitionFromThinkingTimedOut, this));
+                if (!m_thinkingToIdleTask.isValid()) {
                     ACSDK_ERROR(LX("failedToStartTimerFromThinkingToIdle"));
                 }
                 return;
@@ -105,10 +114,9 @@ void DialogUXStateAggregator::onStateChanged(SpeechSynthesizerObserver::SpeechSy
 
                 m_currentState = DialogUXStateObserverInterface::DialogUXState::FINISHED;
 
-                if (!m_multiturnSpeakingToListeningTimer
-                         .start(
-                             SHORT_TIMEOUT, std::bind(&DialogUXStateAggregator::transitionFromSpeakingFinished, this))
-                         .valid()) {
+                m_multiturnSpeakingToListeningTask = m_executor.submitAfter(
+                    SHORT_TIMEOUT, std::bind(&DialogUXStateAggregator::transitionFromSpeakingFinished, this));
+                if (!m_multiturnSpeakingToListeningTask.isValid()) {
                     ACSDK_ERROR(LX("failedToStartTimerFromSpeakingFinishedToIdle"));
                 }
                 return;
@@ -125,8 +133,8 @@ void DialogUXStateAggregator::receive(const std::string& contextId, const std::s
              * or we automatically go to idle after the short timeout (i.e. the directive received isn't related to
              * speech, like a setVolume directive).
              */
-            m_thinkingToIdleTimer.stop();
-            m_thinkingToIdleTimer.start(
+            m_thinkingToIdleTask.cancel();
+            m_thinkingToIdleTask = m_executor.submitAfter(
                 SHORT_TIMEOUT, std::bind(&DialogUXStateAggregator::transitionFromThinkingTimedOut, this));
         }
     });
@@ -143,36 +151,59 @@ void DialogUXStateAggregator::onConnectionStatusChanged(
 }
 
 void DialogUXStateAggregator::notifyObserversOfState() {
+    if (m_coalescingInterval <= std::chrono::milliseconds::zero()) {
+        deliverState(m_currentState);
+        return;
+    }
+    m_stateToNotify = m_currentState;
+    if (m_isNotificationPending) {
+        return;
+    }
+    if (!m_executor
+             .submitAfter(m_coalescingInterval, std::bind(&DialogUXStateAggregator::coalescingIntervalElapsed, this))
+             .isValid()) {
+        ACSDK_ERROR(LX("failedToStartCoalescingTimer"));
+        deliverState(m_stateToNotify);
+        return;
+    }
+    m_isNotificationPending = true;
+}
+
+void DialogUXStateAggregator::deliverState(DialogUXStateObserverInterface::DialogUXState state) {
+    m_notifiedState = state;
     for (auto observer : m_observers) {
         if (observer) {
-            observer->onDialogUXStateChanged(m_currentState);
+            observer->onDialogUXStateChanged(state);
         }
     }
 }
 
+void DialogUXStateAggregator::coalescingIntervalElapsed() {
+    m_isNotificationPending = false;
+    if (m_stateToNotify != m_notifiedState) {
+        deliverState(m_stateToNotify);
+    }
+}
+
 void DialogUXStateAggregator::transitionFromThinkingTimedOut() {
-    m_executor.submit([this]() {
-        if (DialogUXStateObserverInterface::DialogUXState::THINKING == m_currentState) {
-            ACSDK_DEBUG(LX("transitionFromThinkingTimedOut"));
-            setState(DialogUXStateObserverInterface::DialogUXState::IDLE);
-        }
-    });
+    if (DialogUXStateObserverInterface::DialogUXState::THINKING == m_currentState) {
+        ACSDK_DEBUG(LX("transitionFromThinkingTimedOut"));
+        setState(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    }
 }
 
 void DialogUXStateAggregator::transitionFromSpeakingFinished() {
-    m_executor.submit([this]() {
-        if (DialogUXStateObserverInterface::DialogUXState::FINISHED == m_currentState) {
-            setState(DialogUXStateObserverInterface::DialogUXState::IDLE);
-        }
-    });
+    if (DialogUXStateObserverInterface::DialogUXState::FINISHED == m_currentState) {
+        setState(DialogUXStateObserverInterface::DialogUXState::IDLE);
+    }
 }
 
 void DialogUXStateAggregator::setState(sdkInterfaces::DialogUXStateObserverInterface::DialogUXState newState) {
     if (newState == m_currentState) {
         return;
     }
-    m_thinkingToIdleTimer.stop();
-    m_multiturnSpeakingToListeningTimer.stop();
+    m_thinkingToIdleTask.cancel();
+    m_multiturnSpeakingToListeningTask.cancel();
     ACSDK_DEBUG(LX("setState").d("from", m_currentState).d("to", newState));
     m_currentState = newState;
     notifyObserversOfState();
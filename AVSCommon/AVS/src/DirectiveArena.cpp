@@ -0,0 +1,93 @@
+/*
+ * DirectiveArena.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <new>
+
+#include "AVSCommon/AVS/DirectiveArena.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DirectiveArena");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t DirectiveArena::BUFFER_SIZE;
+
+std::shared_ptr<DirectiveArena> DirectiveArena::create() {
+    // A single allocation holds the arena and the control block of the shared_ptr.
+    struct EnableMakeShared : public DirectiveArena {};
+    return std::make_shared<EnableMakeShared>();
+}
+
+DirectiveArena::DirectiveArena() :
+        m_allocator{m_buffer, sizeof(m_buffer)},
+        m_document{&m_allocator},
+        m_hasHeader{false},
+        m_memory{utils::metrics::MemoryAccounting::Category::JSON_DOCUMENTS} {
+}
+
+DirectiveArena::~DirectiveArena() {
+    if (m_hasHeader) {
+        reinterpret_cast<AVSMessageHeader*>(&m_headerStorage)->~AVSMessageHeader();
+    }
+}
+
+rapidjson::Document& DirectiveArena::getDocument() {
+    return m_document;
+}
+
+std::shared_ptr<const rapidjson::Document> DirectiveArena::getSharedDocument() {
+    return std::shared_ptr<const rapidjson::Document>(shared_from_this(), &m_document);
+}
+
+std::shared_ptr<AVSMessageHeader> DirectiveArena::createHeader(
+    std::string avsNamespace,
+    std::string avsName,
+    std::string avsMessageId,
+    std::string avsDialogRequestId) {
+    if (m_hasHeader) {
+        ACSDK_ERROR(LX("createHeaderFailed").d("reason", "headerAlreadyCreated"));
+        return nullptr;
+    }
+    auto header = new (&m_headerStorage) AVSMessageHeader(
+        std::move(avsNamespace), std::move(avsName), std::move(avsMessageId), std::move(avsDialogRequestId));
+    m_hasHeader = true;
+    return std::shared_ptr<AVSMessageHeader>(shared_from_this(), header);
+}
+
+size_t DirectiveArena::getDocumentSize() const {
+    return m_allocator.Size();
+}
+
+void DirectiveArena::updateMemoryAccounting() {
+    // The first chunk of the allocator is the buffer within the arena; any capacity beyond it is on the heap.
+    auto capacity = m_allocator.Capacity();
+    m_memory.resize(sizeof(DirectiveArena) + (capacity > BUFFER_SIZE ? capacity - BUFFER_SIZE : 0));
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -18,6 +18,7 @@
 #include "AVSCommon/AVS/EventBuilder.h"
 
 #include <rapidjson/document.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -181,6 +182,153 @@ const std::pair<std::string, std::string> buildJsonEventString(
     return std::make_pair(messageId, eventAndContextBuf.GetString());
 }
 
+/// Whitespace which may surround a JSON value.
+static const char* JSON_WHITESPACE = " \t\n\r";
+
+/**
+ * Serializes a string as a quoted and escaped JSON string.
+ *
+ * @param value The string to serialize.
+ * @return The JSON string.
+ */
+static std::string toJsonString(const std::string& value) {
+    StringBuffer buffer;
+    Writer<StringBuffer> writer(buffer);
+    writer.String(value.c_str(), static_cast<SizeType>(value.length()));
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+/**
+ * A rapidjson SAX handler which accepts any JSON value, and records whether the root value is an object.
+ */
+class RootTypeHandler : public BaseReaderHandler<UTF8<>, RootTypeHandler> {
+public:
+    /// Constructor.
+    RootTypeHandler() : isRootObject{false}, m_depth{0} {
+    }
+
+    /// @name BaseReaderHandler methods
+    /// @{
+    bool Default() {
+        return true;
+    }
+    bool StartObject() {
+        if (0 == m_depth++) {
+            isRootObject = true;
+        }
+        return true;
+    }
+    bool EndObject(SizeType) {
+        --m_depth;
+        return true;
+    }
+    bool StartArray() {
+        ++m_depth;
+        return true;
+    }
+    bool EndArray(SizeType) {
+        --m_depth;
+        return true;
+    }
+    /// @}
+
+    /// Whether the root value is an object.
+    bool isRootObject;
+
+private:
+    /// The nesting depth of the value being parsed.
+    int m_depth;
+};
+
+/**
+ * Checks that a string is valid JSON, without building a document.
+ *
+ * @param json The string to check.
+ * @param[out] isObject Whether the root value is an object.
+ * @return Whether the string is valid JSON.
+ */
+static bool validateJson(const std::string& json, bool* isObject) {
+    RootTypeHandler handler;
+    Reader reader;
+    StringStream stream(json.c_str());
+    if (reader.Parse(stream, handler).IsError()) {
+        return false;
+    }
+    *isObject = handler.isRootObject;
+    return true;
+}
+
+EventTemplate::EventTemplate(const std::string& nameSpace, const std::string& eventName) :
+        m_nameSpace{nameSpace},
+        m_eventName{eventName} {
+    m_headerPrefix = "\"" + EVENT_KEY_STRING + "\":{\"" + HEADER_KEY_STRING + "\":{\"" + NAMESPACE_KEY_STRING +
+                     "\":" + toJsonString(nameSpace) + ",\"" + NAME_KEY_STRING + "\":" + toJsonString(eventName) +
+                     ",\"" + MESSAGE_ID_KEY_STRING + "\":\"";
+}
+
+const std::pair<std::string, std::string> EventTemplate::build(
+    const std::string& dialogRequestIdValue,
+    const std::string& jsonPayloadValue,
+    const std::string& jsonContext) const {
+    const std::pair<std::string, std::string> emptyPair;
+    bool isObject = false;
+
+    // Only the members of the context object are copied, since they precede the event in the same object.
+    size_t contextBegin = 0;
+    size_t contextLength = 0;
+    if (!jsonContext.empty()) {
+        if (!validateJson(jsonContext, &isObject) || !isObject) {
+            ACSDK_DEBUG(LX("buildFailed").d("reason", "parseContextFailed").sensitive("context", jsonContext));
+            return emptyPair;
+        }
+        contextBegin = jsonContext.find('{') + 1;
+        auto contextEnd = jsonContext.find_last_not_of(JSON_WHITESPACE, jsonContext.rfind('}') - 1);
+        contextLength = contextEnd + 1 - contextBegin;
+    }
+
+    if (!jsonPayloadValue.empty() && !validateJson(jsonPayloadValue, &isObject)) {
+        ACSDK_ERROR(LX("buildFailed").d("reason", "errorParsingPayload").sensitive("payload", jsonPayloadValue));
+        return emptyPair;
+    }
+
+    auto messageId = avsCommon::utils::uuidGeneration::generateUUID();
+    ACSDK_DEBUG(LX("build").d("messageId", messageId).d("namespace", m_nameSpace).d("name", m_eventName));
+
+    if (m_eventName == "SpeechStarted" || m_eventName == "SpeechFinished" || m_eventName == "Recognize") {
+        ACSDK_METRIC_IDS(TAG, m_eventName, messageId, dialogRequestIdValue, Metrics::Location::BUILDING_MESSAGE);
+    }
+
+    std::string dialogRequestId;
+    if (!dialogRequestIdValue.empty()) {
+        dialogRequestId = ",\"" + DIALOG_REQUEST_ID_KEY_STRING + "\":" + toJsonString(dialogRequestIdValue);
+    }
+
+    // {<context members>,<header prefix><messageId>"<dialogRequestId>},"payload":<payload>}}
+    std::string json;
+    json.reserve(
+        contextLength + m_headerPrefix.length() + messageId.length() + dialogRequestId.length() +
+        PAYLOAD_KEY_STRING.length() + jsonPayloadValue.length() + 16);
+    json += '{';
+    if (contextLength > 0) {
+        json.append(jsonContext, contextBegin, contextLength);
+        json += ',';
+    }
+    json += m_headerPrefix;
+    json += messageId;
+    json += '"';
+    json += dialogRequestId;
+    json += '}';
+    if (!jsonPayloadValue.empty()) {
+        json += ",\"";
+        json += PAYLOAD_KEY_STRING;
+        json += "\":";
+        json += jsonPayloadValue;
+    }
+    json += "}}";
+
+    return std::make_pair(messageId, json);
+}
+
 }  // namespace avs
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
@@ -15,12 +15,15 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <AVSCommon/AVS/MessageRequest.h>
 #include <AVSCommon/AVS/EventBuilder.h>
 #include <AVSCommon/AVS/ExceptionEncounteredSender.h>
+#include <AVSCommon/Utils/Logger/FlightRecorderLogger.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
@@ -63,19 +66,99 @@ static const char ERROR_TYPE_KEY[] = "type";
 /// JSON key for the ExceptionEncountered event's error message.
 static const char ERROR_MESSAGE_KEY[] = "message";
 
+/// JSON key for the directive in the unparsed directive.
+static const std::string DIRECTIVE_KEY = "directive";
+
+/// JSON key for the header of the unparsed directive.
+static const std::string DIRECTIVE_HEADER_KEY = "header";
+
+/// JSON key for the message ID of the unparsed directive.
+static const std::string DIRECTIVE_MESSAGE_ID_KEY = "messageId";
+
+/// The most exceptions remembered for deduplication at once.
+static const size_t MAX_RECORDS = 64;
+
+constexpr std::chrono::milliseconds ExceptionEncounteredSender::DEFAULT_DEDUPLICATION_WINDOW;
+
+/**
+ * Get the message ID from the header of a directive.
+ *
+ * @param unparsedDirective The JSON of the directive.
+ * @return The message ID, or an empty string if the directive can not be parsed or has none.
+ */
+static std::string getMessageId(const std::string& unparsedDirective) {
+    Document document;
+    if (document.Parse(unparsedDirective.c_str()).HasParseError() || !document.IsObject()) {
+        return "";
+    }
+    auto directive = document.FindMember(DIRECTIVE_KEY.c_str());
+    if (directive == document.MemberEnd() || !directive->value.IsObject()) {
+        return "";
+    }
+    auto header = directive->value.FindMember(DIRECTIVE_HEADER_KEY.c_str());
+    if (header == directive->value.MemberEnd() || !header->value.IsObject()) {
+        return "";
+    }
+    auto messageId = header->value.FindMember(DIRECTIVE_MESSAGE_ID_KEY.c_str());
+    if (messageId == header->value.MemberEnd() || !messageId->value.IsString()) {
+        return "";
+    }
+    return messageId->value.GetString();
+}
+
+std::unique_ptr<ExceptionEncounteredSender> ExceptionEncounteredSender::create(
+    std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender) {
+    if (!messageSender) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullMessageSender"));
+        return nullptr;
+    }
+    return std::unique_ptr<ExceptionEncounteredSender>(new ExceptionEncounteredSender(
+        messageSender, 0, std::chrono::milliseconds::zero(), std::chrono::milliseconds::zero()));
+}
+
 std::unique_ptr<ExceptionEncounteredSender> ExceptionEncounteredSender::create(
-    std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messagesender) {
+    std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messagesender,
+    size_t burstLimit,
+    std::chrono::milliseconds refillInterval,
+    std::chrono::milliseconds deduplicationWindow) {
     if (!messagesender) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullMessageSender"));
         return nullptr;
     }
-    return std::unique_ptr<ExceptionEncounteredSender>(new ExceptionEncounteredSender(messagesender));
+    if (0 == burstLimit) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroBurstLimit"));
+        return nullptr;
+    }
+    if (refillInterval <= std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidRefillInterval"));
+        return nullptr;
+    }
+    return std::unique_ptr<ExceptionEncounteredSender>(
+        new ExceptionEncounteredSender(messagesender, burstLimit, refillInterval, deduplicationWindow));
 }
 
 void ExceptionEncounteredSender::sendExceptionEncountered(
     const std::string& unparsedDirective,
     avs::ExceptionErrorType error,
     const std::string& errorDescription) {
+    unsigned int suppressedCount = 0;
+    if (m_burstLimit > 0) {
+        auto messageId = getMessageId(unparsedDirective);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!admitLocked(ExceptionKey(messageId, error), std::chrono::steady_clock::now(), &suppressedCount)) {
+            ACSDK_DEBUG(LX("sendExceptionEncounteredSuppressed").d("messageId", messageId).d("error", error));
+            return;
+        }
+    }
+
+    // Keep the logs which led up to the exception, in case the sink only records them.
+    utils::logger::FlightRecorderLogger::trigger("ExceptionEncountered");
+
+    std::string description = errorDescription;
+    if (suppressedCount > 0) {
+        description += " (" + std::to_string(suppressedCount) + " similar exceptions suppressed)";
+    }
+
     // Constructing Json for Context
     rapidjson::Document contextDocument(rapidjson::kObjectType);
     rapidjson::Value contextArray(rapidjson::kArrayType);
@@ -93,7 +176,7 @@ void ExceptionEncounteredSender::sendExceptionEncountered(
     std::ostringstream errorStringVal;
     errorStringVal << error;
     errorDataDocument.AddMember(ERROR_TYPE_KEY, errorStringVal.str(), errorDataDocument.GetAllocator());
-    rapidjson::Value messageJson(rapidjson::StringRef(errorDescription));
+    rapidjson::Value messageJson(rapidjson::StringRef(description));
     errorDataDocument.AddMember(ERROR_MESSAGE_KEY, messageJson, errorDataDocument.GetAllocator());
     payloadDataDocument.AddMember(ERROR_KEY, errorDataDocument, payloadDataDocument.GetAllocator());
 
@@ -121,13 +204,71 @@ void ExceptionEncounteredSender::sendExceptionEncountered(
         ACSDK_ERROR(LX("sendExceptionEncounteredFailed").d("reason", "JsonEventEmpty"));
         return;
     }
-    std::shared_ptr<MessageRequest> request = std::make_shared<MessageRequest>(msgIdAndJsonEvent.second);
+    std::shared_ptr<MessageRequest> request = std::make_shared<MessageRequest>(std::move(msgIdAndJsonEvent.second));
     m_messageSender->sendMessage(request);
 }
 
+bool ExceptionEncounteredSender::admitLocked(
+    const ExceptionKey& key,
+    std::chrono::steady_clock::time_point now,
+    unsigned int* suppressedCount) {
+    auto record = key.first.empty() ? m_records.end() : m_records.find(key);
+    if (record != m_records.end() && now - record->second.lastSentTime < m_deduplicationWindow) {
+        ++record->second.suppressedCount;
+        return false;
+    }
+
+    auto refills = (now - m_lastRefillTime) / m_refillInterval;
+    if (refills > 0) {
+        m_lastRefillTime += refills * m_refillInterval;
+        m_tokens = static_cast<size_t>(std::min<decltype(refills)>(m_burstLimit, m_tokens + refills));
+    }
+    if (0 == m_tokens) {
+        if (record != m_records.end()) {
+            ++record->second.suppressedCount;
+        } else if (!key.first.empty() && m_records.size() < MAX_RECORDS) {
+            // Backdated so that the exception is not also deduplicated once a token is available.
+            m_records[key] = {now - m_deduplicationWindow, 1};
+        }
+        return false;
+    }
+    --m_tokens;
+
+    if (record != m_records.end()) {
+        *suppressedCount = record->second.suppressedCount;
+        record->second = {now, 0};
+        return true;
+    }
+    if (key.first.empty()) {
+        return true;
+    }
+    if (m_records.size() >= MAX_RECORDS) {
+        // Forget the exceptions which are no longer deduplicated and have nothing to report.
+        for (auto it = m_records.begin(); it != m_records.end();) {
+            if (0 == it->second.suppressedCount && now - it->second.lastSentTime >= m_deduplicationWindow) {
+                it = m_records.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (m_records.size() < MAX_RECORDS) {
+        m_records[key] = {now, 0};
+    }
+    return true;
+}
+
 ExceptionEncounteredSender::ExceptionEncounteredSender(
-    std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender) :
-        m_messageSender{messageSender} {
+    std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+    size_t burstLimit,
+    std::chrono::milliseconds refillInterval,
+    std::chrono::milliseconds deduplicationWindow) :
+        m_messageSender{messageSender},
+        m_burstLimit{burstLimit},
+        m_refillInterval{refillInterval},
+        m_deduplicationWindow{deduplicationWindow},
+        m_tokens{burstLimit},
+        m_lastRefillTime{std::chrono::steady_clock::now()} {
 }
 
 }  // namespace avs
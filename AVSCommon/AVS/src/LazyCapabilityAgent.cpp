@@ -0,0 +1,198 @@
+/*
+ * LazyCapabilityAgent.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/AVS/LazyCapabilityAgent.h"
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+using namespace sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("LazyCapabilityAgent");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<LazyCapabilityAgent> LazyCapabilityAgent::create(
+    const std::string& name,
+    const DirectiveHandlerConfiguration& configuration,
+    Factory factory,
+    std::shared_ptr<ContextManagerInterface> contextManager,
+    const std::unordered_map<NamespaceAndName, std::string>& states) {
+    if (!factory) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullFactory").d("name", name));
+        return nullptr;
+    }
+    if (!contextManager && !states.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullContextManager").d("name", name));
+        return nullptr;
+    }
+
+    auto lazyCapabilityAgent = std::shared_ptr<LazyCapabilityAgent>(
+        new LazyCapabilityAgent(name, configuration, std::move(factory), contextManager));
+    for (const auto& state : states) {
+        if (state.second.empty()) {
+            contextManager->setStateProvider(state.first, lazyCapabilityAgent);
+            lazyCapabilityAgent->m_providedStates.push_back(state.first);
+        } else if (contextManager->setState(state.first, state.second, StateRefreshPolicy::NEVER) !=
+                   SetStateResult::SUCCESS) {
+            ACSDK_ERROR(LX("createFailed")
+                            .d("reason", "setStateFailed")
+                            .d("name", name)
+                            .d("namespace", state.first.nameSpace)
+                            .d("state", state.first.name));
+            lazyCapabilityAgent->shutdown();
+            return nullptr;
+        }
+    }
+    return lazyCapabilityAgent;
+}
+
+LazyCapabilityAgent::LazyCapabilityAgent(
+    const std::string& name,
+    const DirectiveHandlerConfiguration& configuration,
+    Factory factory,
+    std::shared_ptr<ContextManagerInterface> contextManager) :
+        RequiresShutdown{name},
+        m_configuration{configuration},
+        m_contextManager{contextManager},
+        m_factory{std::move(factory)} {
+}
+
+std::shared_ptr<CapabilityAgent> LazyCapabilityAgent::getInstance() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_instance || !m_factory) {
+        return m_instance;
+    }
+    ACSDK_INFO(LX("creatingCapabilityAgent").d("name", name()));
+    Factory factory;
+    std::swap(factory, m_factory);
+    // The capability agent registers itself as the provider of its states, in place of this.
+    m_instance = factory();
+    if (!m_instance) {
+        ACSDK_ERROR(LX("getInstanceFailed").d("reason", "factoryFailed").d("name", name()));
+    }
+    return m_instance;
+}
+
+std::shared_ptr<CapabilityAgent> LazyCapabilityAgent::getCreatedInstance() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_instance;
+}
+
+void LazyCapabilityAgent::handleDirectiveImmediately(std::shared_ptr<AVSDirective> directive) {
+    auto instance = getInstance();
+    if (!instance) {
+        ACSDK_ERROR(LX("handleDirectiveImmediatelyFailed").d("reason", "noCapabilityAgent").d("name", name()));
+        return;
+    }
+    instance->handleDirectiveImmediately(directive);
+}
+
+void LazyCapabilityAgent::preHandleDirective(
+    std::shared_ptr<AVSDirective> directive,
+    std::unique_ptr<DirectiveHandlerResultInterface> result) {
+    auto instance = getInstance();
+    if (!instance) {
+        ACSDK_ERROR(LX("preHandleDirectiveFailed").d("reason", "noCapabilityAgent").d("name", name()));
+        if (result) {
+            result->setFailed("capabilityAgentNotCreated");
+        }
+        return;
+    }
+    instance->preHandleDirective(directive, std::move(result));
+}
+
+bool LazyCapabilityAgent::handleDirective(const std::string& messageId) {
+    // A directive is pre-handled before it is handled, so the capability agent already exists if it can.
+    auto instance = getCreatedInstance();
+    if (!instance) {
+        ACSDK_ERROR(LX("handleDirectiveFailed").d("reason", "noCapabilityAgent").d("name", name()));
+        return false;
+    }
+    return instance->handleDirective(messageId);
+}
+
+void LazyCapabilityAgent::cancelDirective(const std::string& messageId) {
+    if (auto instance = getCreatedInstance()) {
+        instance->cancelDirective(messageId);
+    }
+}
+
+bool LazyCapabilityAgent::handleDirective(std::shared_ptr<AVSDirective> directive) {
+    auto instance = getCreatedInstance();
+    if (!instance) {
+        ACSDK_ERROR(LX("handleDirectiveFailed").d("reason", "noCapabilityAgent").d("name", name()));
+        return false;
+    }
+    return instance->handleDirective(directive);
+}
+
+void LazyCapabilityAgent::cancelDirective(std::shared_ptr<AVSDirective> directive) {
+    if (auto instance = getCreatedInstance()) {
+        instance->cancelDirective(directive);
+    }
+}
+
+void LazyCapabilityAgent::onDeregistered() {
+    if (auto instance = getCreatedInstance()) {
+        instance->onDeregistered();
+    }
+}
+
+DirectiveHandlerConfiguration LazyCapabilityAgent::getConfiguration() const {
+    return m_configuration;
+}
+
+void LazyCapabilityAgent::provideState(const unsigned int stateRequestToken) {
+    auto instance = getInstance();
+    if (!instance) {
+        ACSDK_ERROR(LX("provideStateFailed").d("reason", "noCapabilityAgent").d("name", name()));
+        return;
+    }
+    instance->provideState(stateRequestToken);
+}
+
+void LazyCapabilityAgent::doShutdown() {
+    std::shared_ptr<CapabilityAgent> instance;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_factory = nullptr;
+        std::swap(instance, m_instance);
+    }
+    if (!instance) {
+        for (const auto& state : m_providedStates) {
+            m_contextManager->setStateProvider(state, nullptr);
+        }
+        return;
+    }
+    if (auto requiresShutdown = std::dynamic_pointer_cast<utils::RequiresShutdown>(instance)) {
+        requiresShutdown->shutdown();
+    }
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
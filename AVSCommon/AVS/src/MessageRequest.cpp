@@ -35,16 +35,31 @@ static const std::string TAG("MessageRequest");
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
 MessageRequest::MessageRequest(
-    const std::string& jsonContent,
-    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader) :
-        m_jsonContent{jsonContent},
-        m_attachmentReader{attachmentReader} {
+    std::string jsonContent,
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+    Priority priority) :
+        m_jsonContent{std::make_shared<const std::string>(std::move(jsonContent))},
+        m_attachmentReader{attachmentReader},
+        m_priority{priority} {
+}
+
+MessageRequest::MessageRequest(
+    std::shared_ptr<const std::string> jsonContent,
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+    Priority priority) :
+        m_jsonContent{jsonContent ? jsonContent : std::make_shared<const std::string>()},
+        m_attachmentReader{attachmentReader},
+        m_priority{priority} {
 }
 
 MessageRequest::~MessageRequest() {
 }
 
-std::string MessageRequest::getJsonContent() {
+const std::string& MessageRequest::getJsonContent() const {
+    return *m_jsonContent;
+}
+
+std::shared_ptr<const std::string> MessageRequest::getSharedJsonContent() const {
     return m_jsonContent;
 }
 
@@ -52,6 +67,10 @@ std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> MessageRequest::ge
     return m_attachmentReader;
 }
 
+MessageRequest::Priority MessageRequest::getPriority() const {
+    return m_priority;
+}
+
 void MessageRequest::sendCompleted(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status) {
     std::unique_lock<std::mutex> lock{m_observerMutex};
     auto observers = m_observers;
@@ -74,6 +93,16 @@ void MessageRequest::exceptionReceived(const std::string& exceptionMessage) {
     }
 }
 
+void MessageRequest::transferTimingsMeasured(const MessageRequestObserverInterface::TransferTimings& timings) {
+    std::unique_lock<std::mutex> lock{m_observerMutex};
+    auto observers = m_observers;
+    lock.unlock();
+
+    for (auto observer : observers) {
+        observer->onTransferTimings(timings);
+    }
+}
+
 void MessageRequest::addObserver(std::shared_ptr<avsCommon::sdkInterfaces::MessageRequestObserverInterface> observer) {
     if (!observer) {
         ACSDK_ERROR(LX("addObserverFailed").d("reason", "nullObserver"));
@@ -0,0 +1,80 @@
+/*
+ * NamespaceAndNameInterner.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include "AVSCommon/AVS/NamespaceAndNameInterner.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+const NamespaceAndNameInterner::Id NamespaceAndNameInterner::INVALID_ID =
+    std::numeric_limits<NamespaceAndNameInterner::Id>::max();
+
+/// The process-wide state of @c NamespaceAndNameInterner.
+struct InternTable {
+    /// Serializes access to the members below.
+    std::mutex mutex;
+
+    /// The next id to allocate.
+    NamespaceAndNameInterner::Id nextId = 0;
+
+    /// The ids of the interned pairs, by namespace and then by name, so that lookups use the caller's strings as keys.
+    std::unordered_map<std::string, std::unordered_map<std::string, NamespaceAndNameInterner::Id>> ids;
+};
+
+/**
+ * Get the process-wide intern table.  It is created on first use, so that it may be used during static
+ * initialization.
+ *
+ * @return The intern table.
+ */
+static InternTable& getTable() {
+    static InternTable table;
+    return table;
+}
+
+NamespaceAndNameInterner::Id NamespaceAndNameInterner::intern(const std::string& nameSpace, const std::string& name) {
+    auto& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto& names = table.ids[nameSpace];
+    auto it = names.find(name);
+    if (it != names.end()) {
+        return it->second;
+    }
+    auto id = table.nextId++;
+    names[name] = id;
+    return id;
+}
+
+NamespaceAndNameInterner::Id NamespaceAndNameInterner::find(const std::string& nameSpace, const std::string& name) {
+    auto& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto names = table.ids.find(nameSpace);
+    if (names == table.ids.end()) {
+        return INVALID_ID;
+    }
+    auto it = names->second.find(name);
+    return it == names->second.end() ? INVALID_ID : it->second;
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,150 @@
+/*
+ * AsyncRequestsTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/AsyncRequests.h>
+#include <AVSCommon/SDKInterfaces/MockContextManager.h>
+#include <AVSCommon/SDKInterfaces/MockMessageSender.h>
+
+using namespace testing;
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace test {
+
+using namespace avs;
+using namespace sdkInterfaces;
+using namespace sdkInterfaces::test;
+
+/// The context provided by the mock @c ContextManager.
+static const std::string CONTEXT = "{\"context\":[]}";
+
+/// How long to wait for a future which should already be ready.
+static const std::chrono::milliseconds SHORT_TIMEOUT(100);
+
+/// Our GTest class.
+class AsyncRequestsTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /// The mock @c MessageSender.
+    std::shared_ptr<MockMessageSender> m_mockMessageSender;
+
+    /// The mock @c ContextManager.
+    std::shared_ptr<MockContextManager> m_mockContextManager;
+};
+
+void AsyncRequestsTest::SetUp() {
+    m_mockMessageSender = std::make_shared<NiceMock<MockMessageSender>>();
+    m_mockContextManager = std::make_shared<NiceMock<MockContextManager>>();
+}
+
+/**
+ * Verify that the future of a message is satisfied with the outcome of sending it.
+ */
+TEST_F(AsyncRequestsTest, sendMessageFuture) {
+    std::shared_ptr<MessageRequest> sentRequest;
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).WillOnce(SaveArg<0>(&sentRequest));
+    auto future = sendMessageAsync(m_mockMessageSender, std::make_shared<MessageRequest>("{}"));
+    ASSERT_TRUE(sentRequest);
+    EXPECT_EQ(future.wait_for(std::chrono::milliseconds::zero()), std::future_status::timeout);
+
+    sentRequest->sendCompleted(MessageRequestObserverInterface::Status::SUCCESS);
+    ASSERT_EQ(future.wait_for(SHORT_TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(future.get(), MessageRequestObserverInterface::Status::SUCCESS);
+}
+
+/**
+ * Verify that a message can not be sent without a sender, and that its continuation is told so.
+ */
+TEST_F(AsyncRequestsTest, sendMessageWithoutSender) {
+    auto status = MessageRequestObserverInterface::Status::PENDING;
+    sendMessageAsync(
+        nullptr, std::make_shared<MessageRequest>("{}"), [&status](MessageRequestObserverInterface::Status result) {
+            status = result;
+        });
+    EXPECT_EQ(status, MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+}
+
+/**
+ * Verify that the future of the context is satisfied with the context, or with why it is not available.
+ */
+TEST_F(AsyncRequestsTest, getContextFuture) {
+    EXPECT_CALL(*m_mockContextManager, getContext(_))
+        .WillOnce(Invoke([](std::shared_ptr<ContextRequesterInterface> requester) {
+            requester->onContextAvailable(CONTEXT);
+        }))
+        .WillOnce(Invoke([](std::shared_ptr<ContextRequesterInterface> requester) {
+            requester->onContextFailure(ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+        }));
+
+    auto result = getContextAsync(m_mockContextManager).get();
+    EXPECT_TRUE(result.isAvailable);
+    EXPECT_EQ(result.jsonContext, CONTEXT);
+
+    result = getContextAsync(m_mockContextManager).get();
+    EXPECT_FALSE(result.isAvailable);
+    EXPECT_EQ(result.error, ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+}
+
+/**
+ * Verify that an event is built with the context it was sent with, and that its future follows the outcome of sending
+ * it.
+ */
+TEST_F(AsyncRequestsTest, sendEventWithContext) {
+    std::shared_ptr<ContextRequesterInterface> requester;
+    std::shared_ptr<MessageRequest> sentRequest;
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(SaveArg<0>(&requester));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).WillOnce(SaveArg<0>(&sentRequest));
+
+    auto future = sendEventWithContextAsync(m_mockContextManager, m_mockMessageSender, "System", "SynchronizeState");
+    ASSERT_TRUE(requester);
+    requester->onContextAvailable(CONTEXT);
+    ASSERT_TRUE(sentRequest);
+    EXPECT_NE(sentRequest->getJsonContent().find("\"context\":[]"), std::string::npos);
+    EXPECT_NE(sentRequest->getJsonContent().find("SynchronizeState"), std::string::npos);
+
+    sentRequest->sendCompleted(MessageRequestObserverInterface::Status::SERVER_INTERNAL_ERROR);
+    ASSERT_EQ(future.wait_for(SHORT_TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(future.get(), MessageRequestObserverInterface::Status::SERVER_INTERNAL_ERROR);
+}
+
+/**
+ * Verify that an event is not sent if the context is not available.
+ */
+TEST_F(AsyncRequestsTest, sendEventWithoutContext) {
+    EXPECT_CALL(*m_mockContextManager, getContext(_))
+        .WillOnce(Invoke([](std::shared_ptr<ContextRequesterInterface> requester) {
+            requester->onContextFailure(ContextRequestError::BUILD_CONTEXT_ERROR);
+        }));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(0);
+
+    auto future = sendEventWithContextAsync(m_mockContextManager, m_mockMessageSender, "System", "SynchronizeState");
+    ASSERT_EQ(future.wait_for(SHORT_TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(future.get(), MessageRequestObserverInterface::Status::INTERNAL_ERROR);
+}
+
+}  // namespace test
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
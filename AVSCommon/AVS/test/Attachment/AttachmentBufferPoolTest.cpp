@@ -0,0 +1,220 @@
+/*
+ * AttachmentBufferPoolTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/Attachment/AttachmentBufferPool.h"
+#include "AVSCommon/AVS/Attachment/AttachmentManager.h"
+#include "AVSCommon/Utils/Memory/MemoryBudget.h"
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
+
+using namespace alexaClientSDK::avsCommon::avs::attachment;
+using namespace alexaClientSDK::avsCommon::utils::memory;
+using namespace alexaClientSDK::avsCommon::utils::metrics;
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// The data sizes of the size classes used by the tests.
+static const std::vector<size_t> TEST_SIZE_CLASSES = {1000, 4000};
+
+/// The number of bytes written at a time by the tests which stream data.
+static const size_t WRITE_SIZE = 1000;
+
+/// Tests that invalid size classes are rejected.
+TEST(AttachmentBufferPoolTest, createWithInvalidSizeClasses) {
+    ASSERT_FALSE(AttachmentBufferPool::create({}));
+    ASSERT_FALSE(AttachmentBufferPool::create({0, 1000}));
+    ASSERT_FALSE(AttachmentBufferPool::create({4000, 1000}));
+    ASSERT_TRUE(AttachmentBufferPool::create(TEST_SIZE_CLASSES));
+}
+
+/// Tests that a buffer comes from the smallest size class which holds the size asked for, or the largest one.
+TEST(AttachmentBufferPoolTest, buffersAreRightSized) {
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES);
+    ASSERT_TRUE(pool);
+    auto smallSize = InProcessAttachment::SDSType::calculateBufferSize(TEST_SIZE_CLASSES[0]);
+    auto largeSize = InProcessAttachment::SDSType::calculateBufferSize(TEST_SIZE_CLASSES[1]);
+
+    ASSERT_EQ(smallSize, pool->acquireBuffer(1)->size());
+    ASSERT_EQ(smallSize, pool->acquireBuffer(TEST_SIZE_CLASSES[0])->size());
+    ASSERT_EQ(largeSize, pool->acquireBuffer(TEST_SIZE_CLASSES[0] + 1)->size());
+    ASSERT_EQ(largeSize, pool->acquireBuffer(TEST_SIZE_CLASSES[1] * 10)->size());
+    ASSERT_EQ(largeSize, pool->acquireBuffer(0)->size());
+}
+
+/// Tests that released buffers are reused, and that no more than the allowed number are kept.
+TEST(AttachmentBufferPoolTest, buffersAreRecycled) {
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES, 1);
+    ASSERT_TRUE(pool);
+
+    auto first = pool->acquireBuffer(1);
+    auto second = pool->acquireBuffer(1);
+    auto firstData = first->data();
+    first.reset();
+    second.reset();
+    ASSERT_EQ(1u, pool->getFreeBufferCount());
+
+    auto reused = pool->acquireBuffer(1);
+    ASSERT_EQ(firstData, reused->data());
+    ASSERT_EQ(0u, pool->getFreeBufferCount());
+}
+
+/// Tests that a buffer may outlive its pool.
+TEST(AttachmentBufferPoolTest, bufferOutlivesPool) {
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES);
+    ASSERT_TRUE(pool);
+    auto buffer = pool->acquireBuffer(1);
+    pool.reset();
+    buffer.reset();
+}
+
+/// Tests that a stream created by the pool carries data, and returns its buffer to the pool once it is destroyed.
+TEST(AttachmentBufferPoolTest, createStream) {
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES);
+    ASSERT_TRUE(pool);
+    auto attachment = std::make_shared<InProcessAttachment>("id", pool->createStream(TEST_SIZE_CLASSES[0]));
+    auto writer = attachment->createWriter();
+    auto reader = attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    char data[] = "payload";
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    ASSERT_EQ(sizeof(data), writer->write(data, sizeof(data), &writeStatus));
+    char received[sizeof(data)] = {};
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(sizeof(data), reader->read(received, sizeof(received), &readStatus));
+    ASSERT_EQ(std::string(data), std::string(received));
+
+    ASSERT_EQ(0u, pool->getFreeBufferCount());
+    attachment.reset();
+    writer.reset();
+    reader.reset();
+    ASSERT_EQ(1u, pool->getFreeBufferCount());
+}
+
+/// Tests that the AttachmentManager still streams an attachment larger than the size hint of its writer.
+TEST(AttachmentBufferPoolTest, managerStreamsAttachmentLargerThanHint) {
+    AttachmentManager manager(AttachmentManager::AttachmentType::IN_PROCESS);
+    auto writer = manager.createWriter("id", 1);
+    auto reader = manager.createReader("id", AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    std::vector<char> data(AttachmentBufferPool::DEFAULT_SIZE_CLASSES[0] * 3, 'x');
+    std::vector<char> received(data.size());
+    size_t written = 0;
+    size_t read = 0;
+    while (read < data.size()) {
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        if (written < data.size()) {
+            written += writer->write(data.data() + written, std::min(WRITE_SIZE, data.size() - written), &writeStatus);
+        }
+        auto readStatus = AttachmentReader::ReadStatus::OK;
+        auto numRead = reader->read(received.data() + read, received.size() - read, &readStatus);
+        ASSERT_NE(AttachmentReader::ReadStatus::CLOSED, readStatus);
+        read += numRead;
+    }
+    ASSERT_EQ(data, received);
+}
+
+/// Tests that a buffer is counted in MemoryAccounting while it is in use, and then while it is kept for reuse.
+TEST(AttachmentBufferPoolTest, buffersAreAccounted) {
+    MemoryAccounting::setEnabled(true);
+    auto getBytes = []() {
+        return MemoryAccounting::getSnapshot()[static_cast<size_t>(MemoryAccounting::Category::ATTACHMENTS)].bytes;
+    };
+    auto before = getBytes();
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES);
+    ASSERT_TRUE(pool);
+    auto buffer = pool->acquireBuffer(TEST_SIZE_CLASSES[0]);
+    ASSERT_EQ(before + buffer->size(), getBytes());
+    buffer.reset();
+    ASSERT_EQ(1u, pool->getFreeBufferCount());
+    ASSERT_LT(before, getBytes());
+    pool.reset();
+    ASSERT_EQ(before, getBytes());
+    MemoryAccounting::setEnabled(false);
+}
+
+/// Tests that buffers are reserved from the budget, and are shrunk or refused when it is short.
+TEST(AttachmentBufferPoolTest, buffersAreBudgeted) {
+    auto smallSize = InProcessAttachment::SDSType::calculateBufferSize(TEST_SIZE_CLASSES[0]);
+    auto largeSize = InProcessAttachment::SDSType::calculateBufferSize(TEST_SIZE_CLASSES[1]);
+    auto budget = MemoryBudget::create(largeSize + smallSize);
+    ASSERT_TRUE(budget);
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES, 0, budget);
+    ASSERT_TRUE(pool);
+
+    auto large = pool->acquireBuffer(TEST_SIZE_CLASSES[1]);
+    ASSERT_EQ(largeSize, large->size());
+    ASSERT_EQ(largeSize, budget->getGauges().reservedBytes);
+    auto shrunk = pool->acquireBuffer(TEST_SIZE_CLASSES[1]);
+    ASSERT_EQ(smallSize, shrunk->size());
+    ASSERT_FALSE(pool->acquireBuffer(TEST_SIZE_CLASSES[0]));
+    ASSERT_FALSE(pool->createStream(TEST_SIZE_CLASSES[0]));
+    ASSERT_TRUE(pool->acquireBuffer(TEST_SIZE_CLASSES[0], MemoryBudget::Priority::HIGH));
+
+    large.reset();
+    shrunk.reset();
+    ASSERT_EQ(0u, budget->getGauges().reservedBytes);
+}
+
+/// Tests that buffers kept for reuse keep their reservations, and are released when the budget is short.
+TEST(AttachmentBufferPoolTest, freeBuffersAreReleasedWhenBudgetIsShort) {
+    auto largeSize = InProcessAttachment::SDSType::calculateBufferSize(TEST_SIZE_CLASSES[1]);
+    auto budget = MemoryBudget::create(largeSize);
+    ASSERT_TRUE(budget);
+    auto pool = AttachmentBufferPool::create(TEST_SIZE_CLASSES, 1, budget);
+    ASSERT_TRUE(pool);
+
+    pool->acquireBuffer(TEST_SIZE_CLASSES[0]).reset();
+    ASSERT_EQ(1u, pool->getFreeBufferCount());
+    ASSERT_LT(0u, budget->getGauges().reservedBytes);
+
+    auto large = pool->acquireBuffer(TEST_SIZE_CLASSES[1]);
+    ASSERT_EQ(largeSize, large->size());
+    ASSERT_EQ(0u, pool->getFreeBufferCount());
+    ASSERT_EQ(largeSize, budget->getGauges().reservedBytes);
+}
+
+/// Tests that the AttachmentManager refuses both ends of an attachment whose buffer the budget refuses.
+TEST(AttachmentBufferPoolTest, managerRefusesAttachmentOverBudget) {
+    auto budget = MemoryBudget::create(1);
+    ASSERT_TRUE(budget);
+    MemoryBudget::setDefault(budget);
+    AttachmentManager manager(
+        AttachmentManager::AttachmentType::IN_PROCESS,
+        "",
+        AttachmentManager::DEFAULT_MAX_SPILL_SIZE_IN_BYTES,
+        MemoryBudget::Priority::LOW);
+    MemoryBudget::setDefault(nullptr);
+
+    ASSERT_FALSE(manager.createWriter("id", 1));
+    ASSERT_FALSE(manager.createReader("id", AttachmentReader::Policy::NON_BLOCKING));
+    ASSERT_EQ(1u, budget->getGauges().rejectedRequests);
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
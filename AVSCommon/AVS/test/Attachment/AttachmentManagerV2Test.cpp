@@ -15,6 +15,9 @@
  * permissions and limitations under the License.
  */
 
+#include <atomic>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -294,6 +297,94 @@ TEST_F(AttachmentManagerTest, testAttachmentWriterAndReaderInOnePass) {
     }
 }
 
+/**
+ * Test that an attachment whose writer is gone is released once no directive may read it, rather than on a timeout.
+ */
+TEST_F(AttachmentManagerTest, testUnreferencedAttachmentIsReleased) {
+    m_manager.setUnreferencedAttachmentGracePeriod(std::chrono::milliseconds::zero());
+    auto writer = m_manager.createWriter(TEST_ATTACHMENT_ID_STRING_ONE);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 1u);
+
+    writer.reset();
+    auto otherWriter = m_manager.createWriter(TEST_ATTACHMENT_ID_STRING_TWO);
+    ASSERT_NE(otherWriter, nullptr);
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 2u);
+    m_manager.removeExpiredAttachments();
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 1u);
+}
+
+/**
+ * Test that an attachment whose writer is gone is kept while its context is referenced, and is released when the
+ * last reference goes.
+ */
+TEST_F(AttachmentManagerTest, testReferencedAttachmentIsKept) {
+    m_manager.setUnreferencedAttachmentGracePeriod(std::chrono::milliseconds::zero());
+    auto attachmentId = m_manager.generateAttachmentId(TEST_CONTEXT_ID_STRING, TEST_CONTENT_ID_STRING);
+    m_manager.addAttachmentContextReference(TEST_CONTEXT_ID_STRING);
+    m_manager.addAttachmentContextReference(TEST_CONTEXT_ID_STRING);
+
+    auto writer = m_manager.createWriter(attachmentId);
+    ASSERT_NE(writer, nullptr);
+    writer.reset();
+    auto otherWriter = m_manager.createWriter(TEST_ATTACHMENT_ID_STRING_ONE);
+    m_manager.removeExpiredAttachments();
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 2u);
+
+    m_manager.removeAttachmentContextReference(TEST_CONTEXT_ID_STRING);
+    m_manager.removeExpiredAttachments();
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 2u);
+    m_manager.removeAttachmentContextReference(TEST_CONTEXT_ID_STRING);
+    m_manager.removeExpiredAttachments();
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 1u);
+}
+
+/**
+ * Test that an attachment is not released while its writer exists, nor before the grace period has passed.
+ */
+TEST_F(AttachmentManagerTest, testAttachmentInUseIsKept) {
+    auto writer = m_manager.createWriter(TEST_ATTACHMENT_ID_STRING_ONE);
+    auto otherWriter = m_manager.createWriter(TEST_ATTACHMENT_ID_STRING_TWO);
+    ASSERT_NE(writer, nullptr);
+    otherWriter.reset();
+    m_manager.removeExpiredAttachments();
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 2u);
+
+    m_manager.setUnreferencedAttachmentGracePeriod(std::chrono::milliseconds::zero());
+    m_manager.removeExpiredAttachments();
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 1u);
+    auto reader = m_manager.createReader(TEST_ATTACHMENT_ID_STRING_ONE, AttachmentReader::Policy::BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 0u);
+}
+
+/**
+ * Test that readers and writers may be created for many attachments from several threads at once.
+ */
+TEST_F(AttachmentManagerTest, testConcurrentCreation) {
+    const int numberOfThreads = 4;
+    const int attachmentsPerThread = 100;
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < numberOfThreads; ++t) {
+        threads.emplace_back([this, t, &failures]() {
+            for (int i = 0; i < attachmentsPerThread; ++i) {
+                auto id = m_manager.generateAttachmentId(std::to_string(t), std::to_string(i));
+                auto writer = m_manager.createWriter(id);
+                auto reader = m_manager.createReader(id, AttachmentReader::Policy::NON_BLOCKING);
+                if (!writer || !reader) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(failures, 0);
+    ASSERT_EQ(m_manager.getNumberOfAttachments(), 0u);
+}
+
 }  // namespace test
 }  // namespace avs
 }  // namespace avsCommon
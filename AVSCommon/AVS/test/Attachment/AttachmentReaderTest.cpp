@@ -15,6 +15,10 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -36,6 +40,58 @@ using namespace alexaClientSDK::avsCommon::utils::sds;
 static const int TEST_SDS_SEEK_POSITION = TEST_SDS_BUFFER_SIZE_IN_BYTES - (TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES + 10);
 /// A test seek position which is bad.
 static const int TEST_SDS_BAD_SEEK_POSITION = TEST_SDS_BUFFER_SIZE_IN_BYTES + 1;
+/// The number of bytes written at a time by the tests which wait for several writes.
+static const int TEST_SMALL_WRITE_AMOUNT_IN_BYTES = 10;
+/// How long a read waits when the data it waits for is expected to be written.
+static const std::chrono::milliseconds LONG_TIMEOUT(5000);
+/// How long a read waits when the data it waits for is not expected to be written.
+static const std::chrono::milliseconds SHORT_TIMEOUT(50);
+
+/**
+ * An @c AttachmentReader which uses the default @c readv() and @c readAtLeast(), and returns a few bytes of its data at
+ * a time from @c read().
+ */
+class TrickleAttachmentReader : public AttachmentReader {
+public:
+    /**
+     * Constructor.
+     *
+     * @param data The data to read.
+     * @param maxBytesPerRead The most bytes a @c read() returns.
+     */
+    TrickleAttachmentReader(const std::vector<uint8_t>& data, size_t maxBytesPerRead) :
+            m_data{data},
+            m_offset{0},
+            m_maxBytesPerRead{maxBytesPerRead},
+            m_numReads{0} {
+    }
+
+    std::size_t read(void* buf, std::size_t numBytes, ReadStatus* readStatus, std::chrono::milliseconds timeoutMs)
+        override {
+        ++m_numReads;
+        if (m_offset == m_data.size()) {
+            *readStatus = ReadStatus::CLOSED;
+            return 0;
+        }
+        auto count = std::min(std::min(numBytes, m_maxBytesPerRead), m_data.size() - m_offset);
+        std::memcpy(buf, m_data.data() + m_offset, count);
+        m_offset += count;
+        *readStatus = ReadStatus::OK;
+        return count;
+    }
+
+    void close(ClosePoint closePoint) override {
+    }
+
+    /// The data to read.
+    std::vector<uint8_t> m_data;
+    /// The position of the next read in @c m_data.
+    size_t m_offset;
+    /// The most bytes a @c read() returns.
+    size_t m_maxBytesPerRead;
+    /// The number of calls to @c read().
+    int m_numReads;
+};
 
 /**
  * A class which helps drive this unit test suite.
@@ -232,6 +288,102 @@ TEST_F(AttachmentReaderTest, testAttachmentReaderMultipleReadsOfUnfinishedData)
     testMultipleReads(true);
 }
 
+/**
+ * Test that a vectored read fills its buffers in order, from data which wraps around the end of the SDS.
+ */
+TEST_F(AttachmentReaderTest, testAttachmentReaderReadvAcrossWrap) {
+    init();
+    ASSERT_EQ(static_cast<ssize_t>(m_testPattern.size()), m_writer->write(m_testPattern.data(), m_testPattern.size()));
+    std::vector<uint8_t> skipped(TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES);
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(skipped.size(), m_reader->read(skipped.data(), skipped.size(), &readStatus));
+    ASSERT_EQ(
+        static_cast<ssize_t>(TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES),
+        m_writer->write(m_testPattern.data(), TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES));
+
+    // An uneven split, with an empty buffer, which is not where the data wraps.
+    std::vector<uint8_t> first(7);
+    std::vector<uint8_t> second(TEST_SDS_BUFFER_SIZE_IN_BYTES - first.size());
+    AttachmentReader::ReadBuffer buffers[] = {
+        {first.data(), first.size()}, {nullptr, 0}, {second.data(), second.size()}};
+    ASSERT_EQ(
+        static_cast<size_t>(TEST_SDS_BUFFER_SIZE_IN_BYTES),
+        m_reader->readv(buffers, sizeof(buffers) / sizeof(buffers[0]), &readStatus));
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK, readStatus);
+
+    std::vector<uint8_t> expected(m_testPattern.begin() + TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES, m_testPattern.end());
+    expected.insert(
+        expected.end(), m_testPattern.begin(), m_testPattern.begin() + TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES);
+    std::vector<uint8_t> result(first);
+    result.insert(result.end(), second.begin(), second.end());
+    ASSERT_EQ(expected, result);
+
+    ASSERT_EQ(0u, m_reader->readv(buffers, sizeof(buffers) / sizeof(buffers[0]), &readStatus));
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK_WOULDBLOCK, readStatus);
+}
+
+/**
+ * Test that a blocking reader waits for the minimum of a read to be written in several pieces, and returns what it
+ * has when the timeout expires.
+ */
+TEST_F(AttachmentReaderTest, testAttachmentReaderReadAtLeast) {
+    m_readerPolicy = AttachmentReader::Policy::BLOCKING;
+    init();
+    static const size_t NUM_WRITES = 5;
+    static const size_t MIN_BYTES = NUM_WRITES * TEST_SMALL_WRITE_AMOUNT_IN_BYTES;
+    std::thread writerThread([this] {
+        for (size_t i = 0; i < NUM_WRITES; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            m_writer->write(
+                m_testPattern.data() + i * TEST_SMALL_WRITE_AMOUNT_IN_BYTES, TEST_SMALL_WRITE_AMOUNT_IN_BYTES);
+        }
+    });
+    std::vector<uint8_t> result(TEST_SDS_BUFFER_SIZE_IN_BYTES);
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    auto bytesRead = m_reader->readAtLeast(result.data(), result.size(), MIN_BYTES, &readStatus, LONG_TIMEOUT);
+    writerThread.join();
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK, readStatus);
+    ASSERT_EQ(MIN_BYTES, bytesRead);
+    ASSERT_TRUE(std::equal(m_testPattern.begin(), m_testPattern.begin() + MIN_BYTES, result.begin()));
+
+    ASSERT_EQ(
+        static_cast<ssize_t>(TEST_SMALL_WRITE_AMOUNT_IN_BYTES),
+        m_writer->write(m_testPattern.data() + MIN_BYTES, TEST_SMALL_WRITE_AMOUNT_IN_BYTES));
+    bytesRead = m_reader->readAtLeast(result.data(), result.size(), MIN_BYTES, &readStatus, SHORT_TIMEOUT);
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK, readStatus);
+    ASSERT_EQ(static_cast<size_t>(TEST_SMALL_WRITE_AMOUNT_IN_BYTES), bytesRead);
+
+    bytesRead = m_reader->readAtLeast(result.data(), result.size(), MIN_BYTES, &readStatus, SHORT_TIMEOUT);
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK_TIMEDOUT, readStatus);
+    ASSERT_EQ(0u, bytesRead);
+}
+
+/**
+ * Test that the default implementations of the bulk reads gather several reads.
+ */
+TEST_F(AttachmentReaderTest, testAttachmentReaderDefaultBulkReads) {
+    static const size_t MAX_BYTES_PER_READ = 16;
+    auto testPattern = createTestPattern(TEST_SDS_BUFFER_SIZE_IN_BYTES);
+    TrickleAttachmentReader reader(testPattern, MAX_BYTES_PER_READ);
+
+    std::vector<uint8_t> result(TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES);
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(result.size(), reader.readAtLeast(result.data(), result.size(), result.size(), &readStatus));
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK, readStatus);
+    ASSERT_TRUE(std::equal(result.begin(), result.end(), testPattern.begin()));
+
+    std::vector<uint8_t> first(MAX_BYTES_PER_READ);
+    std::vector<uint8_t> second(TEST_SDS_BUFFER_SIZE_IN_BYTES);
+    AttachmentReader::ReadBuffer buffers[] = {{first.data(), first.size()}, {second.data(), second.size()}};
+    ASSERT_EQ(MAX_BYTES_PER_READ * 2, reader.readv(buffers, 2, &readStatus));
+    ASSERT_EQ(AttachmentReader::ReadStatus::OK, readStatus);
+    ASSERT_TRUE(std::equal(first.begin(), first.end(), testPattern.begin() + result.size()));
+
+    reader.m_offset = testPattern.size();
+    ASSERT_EQ(0u, reader.readAtLeast(result.data(), result.size(), result.size(), &readStatus));
+    ASSERT_EQ(AttachmentReader::ReadStatus::CLOSED, readStatus);
+}
+
 }  // namespace test
 }  // namespace avs
 }  // namespace avsCommon
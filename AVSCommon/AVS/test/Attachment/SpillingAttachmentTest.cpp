@@ -0,0 +1,176 @@
+/*
+ * SpillingAttachmentTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/Attachment/AttachmentManager.h"
+#include "AVSCommon/AVS/Attachment/SpillingAttachment.h"
+
+using namespace alexaClientSDK::avsCommon::avs::attachment;
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// The number of bytes the in-memory buffer of the attachments under test holds.
+static const size_t TEST_SDS_SIZE = 1000;
+
+/// The number of bytes written at a time.
+static const size_t WRITE_SIZE = 100;
+
+/// The largest number of bytes the temporary file of the attachments under test may hold.
+static const size_t TEST_MAX_SPILL_SIZE = 10 * TEST_SDS_SIZE;
+
+/**
+ * Gets the directory to create temporary files in.
+ *
+ * @return The directory to create temporary files in.
+ */
+static std::string getTestDirectory() {
+    auto directory = std::getenv("TMPDIR");
+    return directory && *directory ? directory : "/tmp";
+}
+
+/// Test harness for @c SpillingAttachment.
+class SpillingAttachmentTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Creates an attachment with a small in-memory buffer.
+     *
+     * @param spillDirectory The directory to spill into.
+     * @return The new attachment.
+     */
+    std::unique_ptr<SpillingAttachment> createAttachment(const std::string& spillDirectory);
+
+    /**
+     * Writes the start of @c m_data to a writer until it is all written or a write does not return @c OK.
+     *
+     * @param writer The writer.
+     * @param size The number of bytes of @c m_data to write.
+     * @return The status of the last write.
+     */
+    AttachmentWriter::WriteStatus writeAll(AttachmentWriter* writer, size_t size);
+
+    /// The data written by the tests.
+    std::vector<char> m_data;
+};
+
+void SpillingAttachmentTest::SetUp() {
+    m_data.resize(TEST_SDS_SIZE * 5);
+    for (size_t i = 0; i < m_data.size(); ++i) {
+        m_data[i] = static_cast<char>(i % 251);
+    }
+}
+
+std::unique_ptr<SpillingAttachment> SpillingAttachmentTest::createAttachment(const std::string& spillDirectory) {
+    auto buffSize = InProcessAttachment::SDSType::calculateBufferSize(TEST_SDS_SIZE);
+    auto buff = std::make_shared<InProcessAttachment::SDSBufferType>(buffSize);
+    return std::unique_ptr<SpillingAttachment>(new SpillingAttachment(
+        "id", spillDirectory, TEST_MAX_SPILL_SIZE, InProcessAttachment::SDSType::create(buff)));
+}
+
+AttachmentWriter::WriteStatus SpillingAttachmentTest::writeAll(AttachmentWriter* writer, size_t size) {
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    size_t written = 0;
+    while (written < size && AttachmentWriter::WriteStatus::OK == writeStatus) {
+        written += writer->write(m_data.data() + written, std::min(WRITE_SIZE, size - written), &writeStatus);
+    }
+    return writeStatus;
+}
+
+/// Tests that a writer without a reader keeping up never finds the attachment full, and that the data is all read.
+TEST_F(SpillingAttachmentTest, writerNeverBlocks) {
+    auto attachment = createAttachment(getTestDirectory());
+    auto writer = attachment->createWriter();
+    auto reader = attachment->createReader(AttachmentReader::Policy::BLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    ASSERT_EQ(AttachmentWriter::WriteStatus::OK, writeAll(writer.get(), m_data.size()));
+    writer->close();
+
+    std::vector<char> received(m_data.size());
+    size_t read = 0;
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    while (AttachmentReader::ReadStatus::OK == readStatus && read < received.size()) {
+        read += reader->read(received.data() + read, received.size() - read, &readStatus);
+    }
+    ASSERT_EQ(m_data, received);
+
+    char extra;
+    ASSERT_EQ(0u, reader->read(&extra, sizeof(extra), &readStatus));
+    ASSERT_EQ(AttachmentReader::ReadStatus::CLOSED, readStatus);
+}
+
+/// Tests that the writer finds the attachment full once the temporary file holds its maximum size.
+TEST_F(SpillingAttachmentTest, spillIsLimited) {
+    auto attachment = createAttachment(getTestDirectory());
+    auto writer = attachment->createWriter();
+    auto reader = attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    m_data.resize(TEST_SDS_SIZE + TEST_MAX_SPILL_SIZE + WRITE_SIZE);
+    ASSERT_EQ(AttachmentWriter::WriteStatus::OK_BUFFER_FULL, writeAll(writer.get(), m_data.size()));
+}
+
+/// Tests that data written after the reader has closed is discarded rather than filling the temporary file.
+TEST_F(SpillingAttachmentTest, dataIsDiscardedOnceReaderCloses) {
+    auto attachment = createAttachment(getTestDirectory());
+    auto writer = attachment->createWriter();
+    auto reader = attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    ASSERT_EQ(AttachmentWriter::WriteStatus::OK, writeAll(writer.get(), TEST_SDS_SIZE * 2));
+    reader.reset();
+    m_data.resize(TEST_MAX_SPILL_SIZE * 2);
+    ASSERT_EQ(AttachmentWriter::WriteStatus::OK, writeAll(writer.get(), m_data.size()));
+}
+
+/// Tests that an attachment which cannot spill behaves as an in-process attachment.
+TEST_F(SpillingAttachmentTest, noSpillDirectory) {
+    auto attachment = createAttachment("");
+    auto writer = attachment->createWriter();
+    ASSERT_TRUE(writer);
+    ASSERT_FALSE(attachment->createWriter());
+    ASSERT_EQ(AttachmentWriter::WriteStatus::OK_BUFFER_FULL, writeAll(writer.get(), m_data.size()));
+}
+
+/// Tests that the AttachmentManager creates attachments which spill.
+TEST_F(SpillingAttachmentTest, managerCreatesSpillingAttachments) {
+    AttachmentManager manager(AttachmentManager::AttachmentType::SPILLING, getTestDirectory(), TEST_MAX_SPILL_SIZE);
+    auto writer = manager.createWriter("id", 1);
+    auto reader = manager.createReader("id", AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    m_data.resize(AttachmentBufferPool::DEFAULT_SIZE_CLASSES[0] + TEST_MAX_SPILL_SIZE / 2);
+    ASSERT_EQ(AttachmentWriter::WriteStatus::OK, writeAll(writer.get(), m_data.size()));
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
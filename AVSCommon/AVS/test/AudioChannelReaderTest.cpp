@@ -0,0 +1,218 @@
+/*
+ * AudioChannelReaderTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AudioChannelReaderTest.cpp
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/AudioChannelReader.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// The number of channels of the streams of the tests.
+static const unsigned int NUM_CHANNELS = 4;
+
+/// The number of 16-bit words in the buffers of the tests, which is not a whole number of frames, so frames wrap.
+static const size_t BUFFER_WORDS = 1001;
+
+/// The number of frames written and read at a time, which does not divide the buffer, so the wrap moves.
+static const size_t CHUNK_FRAMES = 97;
+
+/// The number of times a chunk is written and read, enough to wrap around the buffer several times.
+static const size_t NUM_CHUNKS = 40;
+
+/// The number of readers a stream of the tests allows.
+static const size_t MAX_READERS = NUM_CHANNELS + 2;
+
+/**
+ * Create a stream with 16-bit words.
+ *
+ * @return The stream.
+ */
+static std::shared_ptr<AudioInputStream> createStream() {
+    auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int16_t), MAX_READERS);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    return AudioInputStream::create(buffer, sizeof(int16_t), MAX_READERS);
+}
+
+/**
+ * Create a view of a new reader of a stream.
+ *
+ * @param stream The stream.
+ * @param sampleType The type of the samples in the stream.
+ * @param channel The channel to read.
+ * @return The view.
+ */
+static std::unique_ptr<AudioChannelReader> createView(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioInputIngester::SampleType sampleType,
+    int channel) {
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    return AudioChannelReader::create(reader, sampleType, NUM_CHANNELS, channel);
+}
+
+/**
+ * The sample of a channel in a frame.
+ *
+ * @param frame The index of the frame.
+ * @param channel The index of the channel.
+ * @return The sample.
+ */
+static int16_t sampleOf(size_t frame, unsigned int channel) {
+    return static_cast<int16_t>((frame * 7 + channel * 1000) % 30000 - 15000);
+}
+
+/**
+ * Verify that unsupported channels and word sizes are rejected.
+ */
+TEST(AudioChannelReaderTest, createFailures) {
+    auto stream = createStream();
+    ASSERT_TRUE(stream);
+    ASSERT_FALSE(AudioChannelReader::create(nullptr, AudioInputIngester::SampleType::INT16, NUM_CHANNELS, 0));
+    ASSERT_FALSE(createView(stream, AudioInputIngester::SampleType::INT16, NUM_CHANNELS));
+    ASSERT_FALSE(createView(stream, AudioInputIngester::SampleType::INT16, -3));
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_FALSE(AudioChannelReader::create(reader, AudioInputIngester::SampleType::INT16, 0, 0));
+
+    auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, 8, 1);
+    auto wideStream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), 8, 1);
+    ASSERT_TRUE(wideStream);
+    reader = wideStream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_FALSE(AudioChannelReader::create(reader, AudioInputIngester::SampleType::INT16, 1, 0));
+    ASSERT_TRUE(AudioChannelReader::create(reader, AudioInputIngester::SampleType::INT16, NUM_CHANNELS, 0));
+}
+
+/**
+ * Verify that one stream serves a reader of each channel, and of all channels, as frames wrap around its buffer.
+ */
+TEST(AudioChannelReaderTest, readEachChannelFromOneStream) {
+    auto stream = createStream();
+    ASSERT_TRUE(stream);
+    std::vector<std::unique_ptr<AudioChannelReader>> views;
+    for (unsigned int channel = 0; channel < NUM_CHANNELS; ++channel) {
+        views.push_back(createView(stream, AudioInputIngester::SampleType::INT16, channel));
+        ASSERT_TRUE(views.back());
+    }
+    auto all = createView(stream, AudioInputIngester::SampleType::INT16, AudioChannelReader::ALL_CHANNELS);
+    ASSERT_TRUE(all);
+    ASSERT_EQ(NUM_CHANNELS, all->getOutputChannels());
+    ASSERT_EQ(NUM_CHANNELS, all->getWordsPerFrame());
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+
+    ASSERT_EQ(AudioInputStream::Reader::Error::WOULDBLOCK, views[0]->read(std::vector<int16_t>(1).data(), 1));
+    size_t frame = 0;
+    for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+        std::vector<int16_t> frames;
+        for (size_t i = 0; i < CHUNK_FRAMES; ++i) {
+            for (unsigned int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                frames.push_back(sampleOf(frame + i, channel));
+            }
+        }
+        ASSERT_EQ(static_cast<ssize_t>(frames.size()), writer->write(frames.data(), frames.size()));
+
+        for (unsigned int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            std::vector<int16_t> samples(CHUNK_FRAMES);
+            ASSERT_EQ(static_cast<ssize_t>(CHUNK_FRAMES), views[channel]->read(samples.data(), samples.size()));
+            for (size_t i = 0; i < CHUNK_FRAMES; ++i) {
+                ASSERT_EQ(sampleOf(frame + i, channel), samples[i]) << "frame=" << frame + i << " channel=" << channel;
+            }
+        }
+        std::vector<int16_t> interleaved(frames.size());
+        ASSERT_EQ(static_cast<ssize_t>(CHUNK_FRAMES), all->read(interleaved.data(), CHUNK_FRAMES));
+        ASSERT_EQ(frames, interleaved);
+        frame += CHUNK_FRAMES;
+    }
+}
+
+/**
+ * Verify that one channel of 32-bit samples is narrowed as it is read, as frames wrap around the buffer.
+ */
+TEST(AudioChannelReaderTest, narrowInt32Samples) {
+    auto stream = createStream();
+    ASSERT_TRUE(stream);
+    auto view = createView(stream, AudioInputIngester::SampleType::INT32, 1);
+    ASSERT_TRUE(view);
+    ASSERT_EQ(2 * NUM_CHANNELS, view->getWordsPerFrame());
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+
+    size_t frame = 0;
+    for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+        std::vector<int32_t> frames;
+        for (size_t i = 0; i < CHUNK_FRAMES; ++i) {
+            for (unsigned int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                frames.push_back(static_cast<int32_t>(sampleOf(frame + i, channel)) * 65536);
+            }
+        }
+        auto numWords = frames.size() * sizeof(int32_t) / sizeof(int16_t);
+        ASSERT_EQ(static_cast<ssize_t>(numWords), writer->write(frames.data(), numWords));
+        std::vector<int16_t> samples(CHUNK_FRAMES);
+        ASSERT_EQ(static_cast<ssize_t>(CHUNK_FRAMES), view->read(samples.data(), samples.size()));
+        for (size_t i = 0; i < CHUNK_FRAMES; ++i) {
+            ASSERT_EQ(sampleOf(frame + i, 1), samples[i]) << "frame=" << frame + i;
+        }
+        frame += CHUNK_FRAMES;
+    }
+}
+
+/**
+ * Verify that floating point samples are narrowed and mixed as they are read, as frames wrap around the buffer.
+ */
+TEST(AudioChannelReaderTest, mixFloatSamples) {
+    auto stream = createStream();
+    ASSERT_TRUE(stream);
+    auto view = createView(stream, AudioInputIngester::SampleType::FLOAT32, AudioChannelReader::MIX_CHANNELS);
+    ASSERT_TRUE(view);
+    ASSERT_EQ(1u, view->getOutputChannels());
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_TRUE(writer);
+
+    size_t frame = 0;
+    for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+        std::vector<float> frames;
+        for (size_t i = 0; i < CHUNK_FRAMES; ++i) {
+            for (unsigned int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                frames.push_back(sampleOf(frame + i, channel) / 32768.0f);
+            }
+        }
+        auto numWords = frames.size() * sizeof(float) / sizeof(int16_t);
+        ASSERT_EQ(static_cast<ssize_t>(numWords), writer->write(frames.data(), numWords));
+        std::vector<int16_t> samples(CHUNK_FRAMES);
+        ASSERT_EQ(static_cast<ssize_t>(CHUNK_FRAMES), view->read(samples.data(), samples.size()));
+        for (size_t i = 0; i < CHUNK_FRAMES; ++i) {
+            int32_t sum = 0;
+            for (unsigned int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                sum += sampleOf(frame + i, channel);
+            }
+            ASSERT_NEAR(sum / static_cast<int32_t>(NUM_CHANNELS), samples[i], 1) << "frame=" << frame + i;
+        }
+        frame += CHUNK_FRAMES;
+    }
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,165 @@
+/*
+ * AudioInputIngesterTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AudioInputIngesterTest.cpp
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/AudioInputIngester.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// The number of 16-bit words in the stream's buffer.
+static const size_t BUFFER_WORDS = 16000;
+
+/// The capture rate of the tests which decimate.
+static const unsigned int CAPTURE_RATE_HZ = 48000;
+
+/// The number of frames captured by the tests.
+static const size_t NUM_FRAMES = 480;
+
+/**
+ * Our GTest class.
+ */
+class AudioInputIngesterTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Read all the samples written to @c m_stream.
+     *
+     * @return The samples.
+     */
+    std::vector<int16_t> readAll();
+
+    /// The stream written to.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The reader of @c m_stream.
+    std::unique_ptr<AudioInputStream::Reader> m_reader;
+};
+
+void AudioInputIngesterTest::SetUp() {
+    auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int16_t), 1);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    m_stream = AudioInputStream::create(buffer, sizeof(int16_t), 1);
+    ASSERT_TRUE(m_stream);
+    m_reader = m_stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_TRUE(m_reader);
+}
+
+std::vector<int16_t> AudioInputIngesterTest::readAll() {
+    std::vector<int16_t> samples(BUFFER_WORDS);
+    auto count = m_reader->read(samples.data(), samples.size());
+    samples.resize(count > 0 ? count : 0);
+    return samples;
+}
+
+/**
+ * Verify that unsupported formats and streams are rejected.
+ */
+TEST_F(AudioInputIngesterTest, createFailures) {
+    using SampleType = AudioInputIngester::SampleType;
+    ASSERT_FALSE(AudioInputIngester::create(nullptr, SampleType::INT16, 16000, 1));
+    ASSERT_FALSE(AudioInputIngester::create(m_stream, SampleType::INT16, 44100, 1));
+    ASSERT_FALSE(AudioInputIngester::create(m_stream, SampleType::INT16, 0, 1));
+    ASSERT_FALSE(AudioInputIngester::create(m_stream, SampleType::INT16, 16000, 0));
+
+    auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int32_t), 1);
+    std::shared_ptr<AudioInputStream> wideStream =
+        AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int32_t), 1);
+    ASSERT_FALSE(AudioInputIngester::create(wideStream, SampleType::INT16, 16000, 1));
+
+    // The stream only has room for one writer.
+    auto ingester = AudioInputIngester::create(m_stream, SampleType::INT16, 16000, 1);
+    ASSERT_TRUE(ingester);
+    ASSERT_FALSE(AudioInputIngester::create(m_stream, SampleType::INT16, 16000, 1));
+}
+
+/**
+ * Verify that 16 kHz mono audio is written as it is.
+ */
+TEST_F(AudioInputIngesterTest, passesThroughOutputFormat) {
+    auto ingester = AudioInputIngester::create(m_stream, AudioInputIngester::SampleType::INT16, 16000, 1);
+    ASSERT_TRUE(ingester);
+    std::vector<int16_t> input(NUM_FRAMES);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<int16_t>(i * 37);
+    }
+    ASSERT_EQ(ingester->write(input.data(), input.size()), static_cast<ssize_t>(NUM_FRAMES));
+    ASSERT_EQ(readAll(), input);
+
+    auto format = AudioInputIngester::getOutputFormat();
+    ASSERT_EQ(format.sampleRateHz, 16000u);
+    ASSERT_EQ(format.sampleSizeInBits, 16u);
+    ASSERT_EQ(format.numChannels, 1u);
+}
+
+/**
+ * Verify that 48 kHz stereo 32-bit audio is converted to 16 kHz mono 16-bit audio.
+ */
+TEST_F(AudioInputIngesterTest, convertsInt32Stereo) {
+    auto ingester =
+        AudioInputIngester::create(m_stream, AudioInputIngester::SampleType::INT32, CAPTURE_RATE_HZ, 2);
+    ASSERT_TRUE(ingester);
+
+    // A constant signal, with the left channel twice the right one, comes out as their mean.
+    std::vector<int32_t> input(NUM_FRAMES * 2);
+    for (size_t i = 0; i < NUM_FRAMES; ++i) {
+        input[2 * i] = 8000 << 16;
+        input[2 * i + 1] = 4000 << 16;
+    }
+    ASSERT_EQ(ingester->write(input.data(), NUM_FRAMES), static_cast<ssize_t>(NUM_FRAMES / 3));
+    auto output = readAll();
+    ASSERT_EQ(output.size(), NUM_FRAMES / 3);
+    for (size_t i = utils::audio::Decimator::TAPS_PER_PHASE; i < output.size(); ++i) {
+        ASSERT_NEAR(output[i], 6000, 2) << "i=" << i;
+    }
+}
+
+/**
+ * Verify that 48 kHz float audio is converted, and that frames left over by decimation are used by the next write.
+ */
+TEST_F(AudioInputIngesterTest, convertsFloatInChunks) {
+    auto ingester =
+        AudioInputIngester::create(m_stream, AudioInputIngester::SampleType::FLOAT32, CAPTURE_RATE_HZ, 1);
+    ASSERT_TRUE(ingester);
+    std::vector<float> input(NUM_FRAMES, 0.25f);
+    size_t written = 0;
+    for (size_t offset = 0; offset < NUM_FRAMES; offset += 5) {
+        auto count = ingester->write(input.data() + offset, 5);
+        ASSERT_GE(count, 0);
+        written += count;
+    }
+    ASSERT_EQ(written, NUM_FRAMES / 3);
+    auto output = readAll();
+    ASSERT_EQ(output.size(), written);
+    ASSERT_NEAR(output.back(), 8192, 2);
+
+    ingester->close();
+    ASSERT_EQ(ingester->write(input.data(), NUM_FRAMES), 0);
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
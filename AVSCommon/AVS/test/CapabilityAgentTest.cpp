@@ -477,6 +477,25 @@ TEST_F(CapabilityAgentTest, testCallToHandleDirectiveWithNoPrehandle) {
     ASSERT_FALSE(m_capabilityAgent->CapabilityAgent::handleDirective(MESSAGE_ID_TEST));
 }
 
+/**
+ * Call the @c handleDirective from the @c CapabilityAgent base class with the pre-handled directive itself. Expect
+ * another directive with the same message Id not to be recognized, and the pre-handled one to be handled.
+ */
+TEST_F(CapabilityAgentTest, testCallToHandleDirectiveByDirective) {
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_RECOGNIZER, NAME_STOP_CAPTURE, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, "");
+    std::shared_ptr<AVSDirective> copy =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, "");
+    std::unique_ptr<MockResult> dirHandlerResult(new MockResult);
+    m_capabilityAgent->preHandleDirective(directive, std::move(dirHandlerResult));
+    ASSERT_EQ(MockCapabilityAgent::FunctionCalled::PREHANDLE_DIRECTIVE, m_capabilityAgent->waitForFunctionCalls());
+    ASSERT_FALSE(m_capabilityAgent->CapabilityAgent::handleDirective(copy));
+    ASSERT_TRUE(m_capabilityAgent->CapabilityAgent::handleDirective(directive));
+    ASSERT_EQ(MockCapabilityAgent::FunctionCalled::HANDLE_DIRECTIVE, m_capabilityAgent->waitForFunctionCalls());
+}
+
 /**
  * Call the @c cancelDirective from the @c CapabilityAgent base class with a directive as the argument.
  * Expect the @c cancelDirective with the argument of @c DirectiveAndResultInterface will be called.
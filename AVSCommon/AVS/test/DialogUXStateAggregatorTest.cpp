@@ -348,6 +348,39 @@ TEST_F(DialogUXAggregatorTest, simpleReceiveDoesNothing) {
     assertNoStateChange(m_testObserver);
 }
 
+/// Tests that in coalescing mode, a quick sequence of state changes leads to one notification of the latest state.
+TEST_F(DialogUXAggregatorTest, coalescingDeliversOnlyLatestState) {
+    auto coalescingAggregator = std::make_shared<DialogUXStateAggregator>(
+        std::chrono::seconds(5), std::chrono::milliseconds(100));
+    coalescingAggregator->addObserver(m_anotherTestObserver);
+    assertStateChange(m_anotherTestObserver, DialogUXStateObserverInterface::DialogUXState::IDLE);
+
+    coalescingAggregator->onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING);
+    coalescingAggregator->onStateChanged(AudioInputProcessorObserverInterface::State::BUSY);
+    coalescingAggregator->onStateChanged(sdkInterfaces::SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING);
+
+    assertStateChange(m_anotherTestObserver, DialogUXStateObserverInterface::DialogUXState::SPEAKING);
+    assertNoStateChange(m_anotherTestObserver);
+}
+
+/// Tests that in coalescing mode, state changes which return to the notified state lead to no notification.
+TEST_F(DialogUXAggregatorTest, coalescingSkipsUnchangedState) {
+    auto coalescingAggregator = std::make_shared<DialogUXStateAggregator>(
+        std::chrono::seconds(5), std::chrono::milliseconds(100));
+    coalescingAggregator->addObserver(m_anotherTestObserver);
+    assertStateChange(m_anotherTestObserver, DialogUXStateObserverInterface::DialogUXState::IDLE);
+
+    coalescingAggregator->onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING);
+    coalescingAggregator->onStateChanged(AudioInputProcessorObserverInterface::State::IDLE);
+
+    bool stateChanged = false;
+    m_anotherTestObserver->waitForStateChange(std::chrono::milliseconds(300), &stateChanged);
+    ASSERT_FALSE(stateChanged);
+
+    coalescingAggregator->onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING);
+    assertStateChange(m_anotherTestObserver, DialogUXStateObserverInterface::DialogUXState::LISTENING);
+}
+
 }  // namespace test
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*
+ * DirectiveArenaTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DirectiveArenaTest.cpp
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/DirectiveArena.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// A namespace for testing.
+static const std::string NAMESPACE_TEST("DirectiveArenaTest");
+
+/// A name for testing.
+static const std::string NAME_TEST("Name");
+
+/// A message id for testing.
+static const std::string MESSAGE_ID_TEST("MessageId");
+
+/// A dialog request id for testing.
+static const std::string DIALOG_REQUEST_ID_TEST("DialogRequestId");
+
+/// A small JSON document for testing.
+static const std::string SMALL_JSON_TEST(R"({"directive":{"payload":{"key":"value"}}})");
+
+/**
+ * Verify that the document and header share ownership of the arena, which is released with the last of them.
+ */
+TEST(DirectiveArenaTest, documentAndHeaderKeepArenaAlive) {
+    auto arena = DirectiveArena::create();
+    ASSERT_TRUE(arena);
+    std::weak_ptr<DirectiveArena> weakArena = arena;
+    ASSERT_FALSE(arena->getDocument().Parse(SMALL_JSON_TEST).HasParseError());
+    ASSERT_LE(arena->getDocumentSize(), DirectiveArena::BUFFER_SIZE);
+
+    auto document = arena->getSharedDocument();
+    auto header = arena->createHeader(NAMESPACE_TEST, NAME_TEST, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    ASSERT_TRUE(header);
+    ASSERT_FALSE(arena->createHeader(NAMESPACE_TEST, NAME_TEST, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST));
+    arena.reset();
+
+    ASSERT_FALSE(weakArena.expired());
+    ASSERT_EQ(header->getNamespace(), NAMESPACE_TEST);
+    ASSERT_EQ(header->getName(), NAME_TEST);
+    ASSERT_EQ(header->getMessageId(), MESSAGE_ID_TEST);
+    ASSERT_EQ(header->getDialogRequestId(), DIALOG_REQUEST_ID_TEST);
+    header.reset();
+
+    ASSERT_FALSE(weakArena.expired());
+    ASSERT_EQ(std::string((*document)["directive"]["payload"]["key"].GetString()), "value");
+    document.reset();
+
+    ASSERT_TRUE(weakArena.expired());
+}
+
+/**
+ * Verify that a document larger than the arena's buffer is parsed.
+ */
+TEST(DirectiveArenaTest, documentLargerThanBuffer) {
+    std::string value(DirectiveArena::BUFFER_SIZE, 'x');
+    std::string json = R"({"directive":{"payload":{"key":")" + value + R"("}}})";
+
+    auto arena = DirectiveArena::create();
+    ASSERT_FALSE(arena->getDocument().Parse(json).HasParseError());
+    ASSERT_GT(arena->getDocumentSize(), DirectiveArena::BUFFER_SIZE);
+    ASSERT_EQ(std::string(arena->getDocument()["directive"]["payload"]["key"].GetString()), value);
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,136 @@
+/*
+ * EventBuilderTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file EventBuilderTest.cpp
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "AVSCommon/AVS/EventBuilder.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+using namespace rapidjson;
+
+/// The namespace of the test event.
+static const std::string NAMESPACE_TEST("AudioPlayer");
+
+/// The name of the test event.
+static const std::string NAME_TEST("PlaybackStarted");
+
+/// A dialogRequestId which needs escaping.
+static const std::string DIALOG_REQUEST_ID_TEST("dialog\"Request\\Id");
+
+/// A payload for testing.
+static const std::string PAYLOAD_TEST("{ \"token\": \"abc\", \"offsetInMilliseconds\": 100 }");
+
+/// A context for testing.
+// clang-format off
+static const std::string CONTEXT_TEST =
+        "{"
+            "\"context\":["
+                "{"
+                    "\"header\":{"
+                        "\"namespace\":\"SpeechSynthesizer\","
+                        "\"name\":\"SpeechState\""
+                    "},"
+                    "\"payload\":{"
+                        "\"playerActivity\":\"FINISHED\""
+                    "}"
+                "}"
+            "]"
+        "} ";
+// clang-format on
+
+/**
+ * Parse an event and replace its messageId with a fixed value, so that events can be compared.
+ *
+ * @param json The event.
+ * @param messageId The messageId the event is expected to have.
+ * @param[out] document The parsed event.
+ */
+static void parseEvent(const std::string& json, const std::string& messageId, Document* document) {
+    ASSERT_FALSE(document->Parse(json).HasParseError());
+    auto& header = (*document)["event"]["header"];
+    ASSERT_EQ(messageId, header["messageId"].GetString());
+    header["messageId"].SetString("messageId");
+}
+
+/**
+ * Verify that an @c EventTemplate builds the same event as @c buildJsonEventString.
+ *
+ * @param dialogRequestId The dialogRequestId of the events.
+ * @param payload The payload of the events.
+ * @param context The context of the events.
+ */
+static void testSameAsBuildJsonEventString(
+    const std::string& dialogRequestId,
+    const std::string& payload,
+    const std::string& context) {
+    EventTemplate eventTemplate(NAMESPACE_TEST, NAME_TEST);
+    auto expected = buildJsonEventString(NAMESPACE_TEST, NAME_TEST, dialogRequestId, payload, context);
+    auto actual = eventTemplate.build(dialogRequestId, payload, context);
+    ASSERT_FALSE(expected.first.empty());
+    ASSERT_FALSE(actual.first.empty());
+    ASSERT_NE(expected.first, actual.first);
+
+    Document expectedDocument;
+    Document actualDocument;
+    parseEvent(expected.second, expected.first, &expectedDocument);
+    parseEvent(actual.second, actual.first, &actualDocument);
+    ASSERT_EQ(expectedDocument, actualDocument);
+}
+
+/**
+ * Verify that a template builds the same event as @c buildJsonEventString with every combination of fields.
+ */
+TEST(EventBuilderTest, templateMatchesBuildJsonEventString) {
+    testSameAsBuildJsonEventString("", "{}", "");
+    testSameAsBuildJsonEventString("", "", "");
+    testSameAsBuildJsonEventString(DIALOG_REQUEST_ID_TEST, PAYLOAD_TEST, "");
+    testSameAsBuildJsonEventString("", PAYLOAD_TEST, CONTEXT_TEST);
+    testSameAsBuildJsonEventString(DIALOG_REQUEST_ID_TEST, PAYLOAD_TEST, CONTEXT_TEST);
+    testSameAsBuildJsonEventString("", PAYLOAD_TEST, "{ }");
+}
+
+/**
+ * Verify that a template rejects a payload or a context which is not valid JSON, and a context which is not an object.
+ */
+TEST(EventBuilderTest, templateRejectsInvalidJson) {
+    EventTemplate eventTemplate(NAMESPACE_TEST, NAME_TEST);
+    auto event = eventTemplate.build("", "{\"token\":");
+    ASSERT_TRUE(event.first.empty());
+    ASSERT_TRUE(event.second.empty());
+
+    event = eventTemplate.build("", "{}", "{\"context\":[]");
+    ASSERT_TRUE(event.first.empty());
+    ASSERT_TRUE(event.second.empty());
+
+    event = eventTemplate.build("", "{}", "[]");
+    ASSERT_TRUE(event.first.empty());
+    ASSERT_TRUE(event.second.empty());
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
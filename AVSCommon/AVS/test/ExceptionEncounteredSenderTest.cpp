@@ -15,7 +15,9 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
@@ -76,6 +78,32 @@ static const std::string ERROR_MESSAGE_KEY = "message";
 /// String to send unparsed Directive in @c testExceptionEncounteredSucceeds
 static const std::string UNPARSED_DIRECTIVE_JSON_STRING = "unparsedDirective Json String";
 
+/// A directive for which an exception is reported in the rate limiting tests.
+static const std::string SPEAK_DIRECTIVE_JSON_STRING =
+    R"({"directive":{"header":{"namespace":"SpeechSynthesizer","name":"Speak","messageId":"1"},"payload":{}}})";
+
+/// Another directive for which an exception is reported in the rate limiting tests.
+static const std::string PLAY_DIRECTIVE_JSON_STRING =
+    R"({"directive":{"header":{"namespace":"AudioPlayer","name":"Play","messageId":"2"},"payload":{}}})";
+
+/// A third directive for which an exception is reported in the rate limiting tests.
+static const std::string STOP_DIRECTIVE_JSON_STRING =
+    R"({"directive":{"header":{"namespace":"AudioPlayer","name":"Stop","messageId":"3"},"payload":{}}})";
+
+/// Another Speak directive, whose payload has a @c messageId and whose header has an escaped quote.
+static const std::string OTHER_SPEAK_DIRECTIVE_JSON_STRING =
+    R"({"directive":{"payload":{"messageId":"1"},)"
+    R"("header":{"namespace":"SpeechSynthesizer","name":"Speak","messageId":"4\"1"}}})";
+
+/// A refill interval long enough that no token is regained during a test.
+static const std::chrono::milliseconds LONG_REFILL_INTERVAL = std::chrono::hours(1);
+
+/// A refill interval short enough that the token bucket never limits a test.
+static const std::chrono::milliseconds SHORT_REFILL_INTERVAL{1};
+
+/// A deduplication window which is waited out in the tests.
+static const std::chrono::milliseconds SHORT_DEDUPLICATION_WINDOW{100};
+
 /**
  * Utility class which captures parameters to a ExceptionEncountered event,
  * and provides functions to send and verify the event
@@ -247,6 +275,113 @@ TEST_F(ExceptionEncounteredSenderTest, errorTypeInternalError) {
     ASSERT_TRUE(testExceptionEncounteredSucceeds(
         UNPARSED_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::INTERNAL_ERROR, "An error occurred with the device"));
 }
+
+/**
+ * Verify that a sender created without limits sends every exception, even the same one again.
+ */
+TEST_F(ExceptionEncounteredSenderTest, noExceptionIsSuppressedByDefault) {
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(3);
+    m_exceptionEncounteredSender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    m_exceptionEncounteredSender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    m_exceptionEncounteredSender->sendExceptionEncountered(
+        UNPARSED_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+}
+
+/**
+ * Verify that the same exception reported again within the deduplication window is not sent.
+ */
+TEST_F(ExceptionEncounteredSenderTest, duplicateExceptionIsSuppressed) {
+    auto sender = avs::ExceptionEncounteredSender::create(m_mockMessageSender, 10, SHORT_REFILL_INTERVAL);
+    ASSERT_NE(sender, nullptr);
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(2);
+    sender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::INTERNAL_ERROR, "An error occurred with the device");
+    sender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::INTERNAL_ERROR, "An error occurred with the device");
+}
+
+/**
+ * Verify that exceptions for distinct directives of the same namespace and name are not deduplicated, that the
+ * message ID is taken from the header rather than from the first match anywhere in the directive, and that
+ * exceptions for directives without a message ID are not deduplicated.
+ */
+TEST_F(ExceptionEncounteredSenderTest, distinctDirectivesAreNotSuppressed) {
+    auto sender = avs::ExceptionEncounteredSender::create(m_mockMessageSender, 10, SHORT_REFILL_INTERVAL);
+    ASSERT_NE(sender, nullptr);
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(4);
+    sender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        OTHER_SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        UNPARSED_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        UNPARSED_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+}
+
+/**
+ * Verify that no more than the burst limit of distinct exceptions are sent back to back.
+ */
+TEST_F(ExceptionEncounteredSenderTest, burstLimitIsEnforced) {
+    auto sender =
+        avs::ExceptionEncounteredSender::create(m_mockMessageSender, 2, LONG_REFILL_INTERVAL, std::chrono::seconds(0));
+    ASSERT_NE(sender, nullptr);
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(2);
+    sender->sendExceptionEncountered(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        PLAY_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    sender->sendExceptionEncountered(
+        STOP_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+}
+
+/**
+ * Verify that the number of suppressed exceptions is reported with the next one sent after the deduplication window.
+ */
+TEST_F(ExceptionEncounteredSenderTest, suppressedCountIsReported) {
+    std::shared_ptr<avs::ExceptionEncounteredSender> sender = avs::ExceptionEncounteredSender::create(
+        m_mockMessageSender, 1, SHORT_REFILL_INTERVAL, SHORT_DEDUPLICATION_WINDOW);
+    ASSERT_NE(sender, nullptr);
+    ExceptionEncounteredEvent event(
+        SPEAK_DIRECTIVE_JSON_STRING, avs::ExceptionErrorType::UNSUPPORTED_OPERATION, "Operation not supported");
+    ExceptionEncounteredEvent aggregatedEvent(
+        SPEAK_DIRECTIVE_JSON_STRING,
+        avs::ExceptionErrorType::UNSUPPORTED_OPERATION,
+        "Operation not supported (2 similar exceptions suppressed)");
+    {
+        InSequence sequence;
+        EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+            .WillOnce(Invoke(&event, &ExceptionEncounteredEvent::verifyMessage));
+        EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+            .WillOnce(Invoke(&aggregatedEvent, &ExceptionEncounteredEvent::verifyMessage));
+    }
+    event.send(sender);
+    event.send(sender);
+    event.send(sender);
+    std::this_thread::sleep_for(SHORT_DEDUPLICATION_WINDOW * 2);
+    event.send(sender);
+}
+
+/**
+ * Verify that invalid limits are rejected.
+ */
+TEST_F(ExceptionEncounteredSenderTest, createWithInvalidLimitsFails) {
+    EXPECT_EQ(
+        avs::ExceptionEncounteredSender::create(
+            m_mockMessageSender, 0, LONG_REFILL_INTERVAL, SHORT_DEDUPLICATION_WINDOW),
+        nullptr);
+    EXPECT_EQ(
+        avs::ExceptionEncounteredSender::create(
+            m_mockMessageSender, 1, std::chrono::milliseconds::zero(), SHORT_DEDUPLICATION_WINDOW),
+        nullptr);
+}
+
 }  // namespace test
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*
+ * LazyCapabilityAgentTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/AVS/LazyCapabilityAgent.h>
+#include <AVSCommon/SDKInterfaces/MockContextManager.h>
+#include <AVSCommon/SDKInterfaces/MockDirectiveHandlerResult.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+using namespace testing;
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace test {
+
+using namespace avs;
+using namespace avs::attachment;
+using namespace sdkInterfaces;
+using namespace sdkInterfaces::test;
+
+/// The namespace of the capability agent under test.
+static const std::string NAMESPACE_TEST = "Test";
+
+/// The directive of the capability agent under test.
+static const NamespaceAndName DIRECTIVE_TEST{NAMESPACE_TEST, "Directive"};
+
+/// The state of the capability agent under test.
+static const NamespaceAndName STATE_TEST{NAMESPACE_TEST, "State"};
+
+/// The state reported before the capability agent under test is created.
+static const std::string IDLE_STATE = "{\"idle\":true}";
+
+/// The messageId of the directive sent to the capability agent under test.
+static const std::string MESSAGE_ID_TEST = "MessageId_Test";
+
+/// A token of a request for the state.
+static const unsigned int STATE_REQUEST_TOKEN = 7;
+
+/**
+ * A @c CapabilityAgent which records the calls made to it, and completes the directives it handles.
+ */
+class TestCapabilityAgent : public CapabilityAgent {
+public:
+    /// Constructor.
+    TestCapabilityAgent() : CapabilityAgent{NAMESPACE_TEST, nullptr}, lastStateRequestToken{0} {
+    }
+
+    void handleDirectiveImmediately(std::shared_ptr<AVSDirective> directive) override {
+    }
+
+    void preHandleDirective(std::shared_ptr<DirectiveInfo> info) override {
+        preHandledMessageId = info->directive->getMessageId();
+    }
+
+    void handleDirective(std::shared_ptr<DirectiveInfo> info) override {
+        info->result->setCompleted();
+    }
+
+    void cancelDirective(std::shared_ptr<DirectiveInfo> info) override {
+    }
+
+    DirectiveHandlerConfiguration getConfiguration() const override {
+        return {{DIRECTIVE_TEST, BlockingPolicy::NON_BLOCKING}};
+    }
+
+    void provideState(const unsigned int stateRequestToken) override {
+        lastStateRequestToken = stateRequestToken;
+    }
+
+    /// The messageId of the last directive pre-handled.
+    std::string preHandledMessageId;
+
+    /// The token of the last request for the state.
+    unsigned int lastStateRequestToken;
+};
+
+/// Our GTest class.
+class LazyCapabilityAgentTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Create the @c LazyCapabilityAgent under test.
+     *
+     * @param idleState The state to report until the capability agent is created, or empty to create it when the
+     * state is first requested.
+     * @return The @c LazyCapabilityAgent.
+     */
+    std::shared_ptr<LazyCapabilityAgent> createLazyCapabilityAgent(const std::string& idleState);
+
+    /// The mock @c ContextManager.
+    std::shared_ptr<MockContextManager> m_mockContextManager;
+
+    /// The number of capability agents created.
+    int m_numCreated;
+
+    /// The last capability agent created.
+    std::shared_ptr<TestCapabilityAgent> m_created;
+};
+
+void LazyCapabilityAgentTest::SetUp() {
+    m_mockContextManager = std::make_shared<NiceMock<MockContextManager>>();
+    m_numCreated = 0;
+}
+
+std::shared_ptr<LazyCapabilityAgent> LazyCapabilityAgentTest::createLazyCapabilityAgent(const std::string& idleState) {
+    return LazyCapabilityAgent::create(
+        NAMESPACE_TEST,
+        {{DIRECTIVE_TEST, BlockingPolicy::NON_BLOCKING}},
+        [this]() {
+            ++m_numCreated;
+            m_created = std::make_shared<TestCapabilityAgent>();
+            return m_created;
+        },
+        m_mockContextManager,
+        {{STATE_TEST, idleState}});
+}
+
+/**
+ * Verify that a @c LazyCapabilityAgent can not be created without a factory, or with states but no @c ContextManager.
+ */
+TEST_F(LazyCapabilityAgentTest, createWithInvalidParameters) {
+    EXPECT_FALSE(LazyCapabilityAgent::create(NAMESPACE_TEST, {}, nullptr));
+    EXPECT_FALSE(LazyCapabilityAgent::create(
+        NAMESPACE_TEST, {}, []() { return nullptr; }, nullptr, {{STATE_TEST, IDLE_STATE}}));
+}
+
+/**
+ * Verify that the idle state is reported and the configuration registered without creating the capability agent, and
+ * that it is created by its first directive, which is then handled by it.
+ */
+TEST_F(LazyCapabilityAgentTest, createdByFirstDirective) {
+    EXPECT_CALL(*m_mockContextManager, setState(STATE_TEST, IDLE_STATE, StateRefreshPolicy::NEVER, _))
+        .WillOnce(Return(SetStateResult::SUCCESS));
+    auto lazyCapabilityAgent = createLazyCapabilityAgent(IDLE_STATE);
+    ASSERT_TRUE(lazyCapabilityAgent);
+    EXPECT_EQ(lazyCapabilityAgent->getConfiguration().count(DIRECTIVE_TEST), 1u);
+    EXPECT_EQ(m_numCreated, 0);
+    EXPECT_FALSE(lazyCapabilityAgent->getCreatedInstance());
+    EXPECT_FALSE(lazyCapabilityAgent->handleDirective(MESSAGE_ID_TEST));
+
+    auto avsMessageHeader =
+        std::make_shared<AVSMessageHeader>(DIRECTIVE_TEST.nameSpace, DIRECTIVE_TEST.name, MESSAGE_ID_TEST);
+    auto attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, "{}", attachmentManager, "");
+    auto result = utils::memory::make_unique<MockDirectiveHandlerResult>();
+    EXPECT_CALL(*result, setCompleted()).Times(1);
+    lazyCapabilityAgent->preHandleDirective(directive, std::move(result));
+    ASSERT_EQ(m_numCreated, 1);
+    EXPECT_EQ(m_created->preHandledMessageId, MESSAGE_ID_TEST);
+    EXPECT_TRUE(lazyCapabilityAgent->handleDirective(MESSAGE_ID_TEST));
+    EXPECT_EQ(lazyCapabilityAgent->getInstance(), m_created);
+    EXPECT_EQ(m_numCreated, 1);
+    lazyCapabilityAgent->shutdown();
+}
+
+/**
+ * Verify that without an idle state, the @c LazyCapabilityAgent provides the state, and creates the capability agent
+ * to provide it when it is first requested.
+ */
+TEST_F(LazyCapabilityAgentTest, createdByFirstStateRequest) {
+    std::shared_ptr<StateProviderInterface> stateProvider;
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(STATE_TEST, NotNull())).WillOnce(SaveArg<1>(&stateProvider));
+    auto lazyCapabilityAgent = createLazyCapabilityAgent("");
+    ASSERT_TRUE(lazyCapabilityAgent);
+    EXPECT_EQ(stateProvider, lazyCapabilityAgent);
+    EXPECT_EQ(m_numCreated, 0);
+
+    lazyCapabilityAgent->provideState(STATE_REQUEST_TOKEN);
+    ASSERT_EQ(m_numCreated, 1);
+    EXPECT_EQ(m_created->lastStateRequestToken, STATE_REQUEST_TOKEN);
+
+    // The capability agent provides its states once created, so this does not unregister them.
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(STATE_TEST, IsNull())).Times(0);
+    lazyCapabilityAgent->shutdown();
+}
+
+/**
+ * Verify that shutting down a @c LazyCapabilityAgent before the capability agent is created unregisters it as the
+ * provider of the states, and that the capability agent is then no longer created.
+ */
+TEST_F(LazyCapabilityAgentTest, shutdownBeforeCreated) {
+    auto lazyCapabilityAgent = createLazyCapabilityAgent("");
+    ASSERT_TRUE(lazyCapabilityAgent);
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(STATE_TEST, IsNull())).Times(1);
+    lazyCapabilityAgent->shutdown();
+    EXPECT_FALSE(lazyCapabilityAgent->getInstance());
+    lazyCapabilityAgent->provideState(STATE_REQUEST_TOKEN);
+    EXPECT_EQ(m_numCreated, 0);
+}
+
+}  // namespace test
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,83 @@
+/*
+ * NamespaceAndNameInternerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file NamespaceAndNameInternerTest.cpp
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/AVSMessageHeader.h"
+#include "AVSCommon/AVS/NamespaceAndNameInterner.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+/// A namespace for testing.
+static const std::string NAMESPACE_TEST("NamespaceAndNameInternerTest");
+
+/// A name for testing.
+static const std::string NAME_TEST("Name");
+
+/// Another name for testing.
+static const std::string OTHER_NAME_TEST("OtherName");
+
+/// A name which is never interned.
+static const std::string UNKNOWN_NAME_TEST("UnknownName");
+
+/**
+ * Verify that a pair keeps its id, and that different pairs have different ids.
+ */
+TEST(NamespaceAndNameInternerTest, idsAreStableAndDistinct) {
+    auto id = NamespaceAndNameInterner::intern(NAMESPACE_TEST, NAME_TEST);
+    ASSERT_NE(id, NamespaceAndNameInterner::INVALID_ID);
+    ASSERT_EQ(id, NamespaceAndNameInterner::intern(NAMESPACE_TEST, NAME_TEST));
+    ASSERT_EQ(id, NamespaceAndNameInterner::find(NAMESPACE_TEST, NAME_TEST));
+
+    auto otherId = NamespaceAndNameInterner::intern(NAMESPACE_TEST, OTHER_NAME_TEST);
+    ASSERT_NE(otherId, NamespaceAndNameInterner::INVALID_ID);
+    ASSERT_NE(id, otherId);
+    // Swapping the namespace and name gives a different pair.
+    ASSERT_NE(id, NamespaceAndNameInterner::intern(NAME_TEST, NAMESPACE_TEST));
+}
+
+/**
+ * Verify that looking up a pair which has not been interned does not intern it.
+ */
+TEST(NamespaceAndNameInternerTest, findDoesNotIntern) {
+    ASSERT_EQ(NamespaceAndNameInterner::find(NAMESPACE_TEST, UNKNOWN_NAME_TEST), NamespaceAndNameInterner::INVALID_ID);
+    ASSERT_EQ(NamespaceAndNameInterner::find(NAMESPACE_TEST, UNKNOWN_NAME_TEST), NamespaceAndNameInterner::INVALID_ID);
+}
+
+/**
+ * Verify that a message header carries the id of its namespace and name.
+ */
+TEST(NamespaceAndNameInternerTest, headerCarriesId) {
+    auto id = NamespaceAndNameInterner::intern(NAMESPACE_TEST, NAME_TEST);
+    AVSMessageHeader header(NAMESPACE_TEST, NAME_TEST, "messageId");
+    ASSERT_EQ(header.getNamespaceAndNameId(), id);
+
+    AVSMessageHeader unknownHeader(NAMESPACE_TEST, UNKNOWN_NAME_TEST, "messageId");
+    ASSERT_EQ(unknownHeader.getNamespaceAndNameId(), NamespaceAndNameInterner::INVALID_ID);
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
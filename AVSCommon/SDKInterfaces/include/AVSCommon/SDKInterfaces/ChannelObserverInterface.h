@@ -46,6 +46,18 @@ public:
      * @param newFocus The new Focus of the channel.
      */
     virtual void onFocusChanged(avs::FocusState newFocus) = 0;
+
+    /**
+     * Whether the focus manager may call @c onFocusChanged() on the thread which acquires the Channel, while that call
+     * is in progress, instead of on its own thread.  This lets an uncontested acquisition complete without a thread
+     * hop.  An observer which returns @c true must not block in @c onFocusChanged(), for example on the thread which
+     * acquired the Channel.
+     *
+     * @return Whether @c onFocusChanged() may be called on the acquiring thread.  The default is @c false.
+     */
+    virtual bool canBeNotifiedOnAcquiringThread() const {
+        return false;
+    }
 };
 
 }  // namespace sdkInterfaces
@@ -18,7 +18,9 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_CONTEXT_MANAGER_INTERFACE_H
 #define ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_CONTEXT_MANAGER_INTERFACE_H
 
+#include <chrono>
 #include <memory>
+#include <string>
 
 #include "AVSCommon/SDKInterfaces/ContextRequesterInterface.h"
 #include "AVSCommon/SDKInterfaces/StateProviderInterface.h"
@@ -116,6 +118,19 @@ public:
      * @param contextRequester The context requester asking for context.
      */
     virtual void getContext(std::shared_ptr<ContextRequesterInterface> contextRequester) = 0;
+
+    /**
+     * Build a context from the states the @c ContextManager already has, without requesting updated states from the
+     * @c StateProviderInterfaces, if the states were last updated for a @c getContext request within @c maxAge.
+     * States set since then without a token are included.
+     *
+     * @param maxAge The longest time since the states were last updated for a @c getContext request.
+     * @param[out] jsonContext The context, if the call succeeds.
+     * @return Whether a recent enough context was available.  The default implementation has no cached context.
+     */
+    virtual bool getCachedContext(std::chrono::milliseconds maxAge, std::string* jsonContext) {
+        return false;
+    }
 };
 
 }  // namespace sdkInterfaces
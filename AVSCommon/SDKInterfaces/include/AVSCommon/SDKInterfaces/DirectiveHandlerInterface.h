@@ -111,6 +111,32 @@ public:
      */
     virtual void cancelDirective(const std::string& messageId) = 0;
 
+    /**
+     * Handle a directive previously passed to @c preHandleDirective(), identified by the directive itself rather
+     * than its message ID.  A handler which keeps the directives it has pre-handled can find this one by comparing
+     * pointers, without looking its message ID up.  By default this calls @c handleDirective() with the message ID.
+     *
+     * @note The same notes apply as to @c handleDirective(const std::string&).
+     *
+     * @param directive The directive previously passed to @c preHandleDirective().
+     * @return @c false when @c directive is not recognized, else @c true.
+     */
+    virtual bool handleDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
+        return handleDirective(directive->getMessageId());
+    }
+
+    /**
+     * Cancel a directive previously passed to @c preHandleDirective(), identified by the directive itself rather
+     * than its message ID.  By default this calls @c cancelDirective() with the message ID.
+     *
+     * @note The same notes apply as to @c cancelDirective(const std::string&).
+     *
+     * @param directive The directive previously passed to @c preHandleDirective().
+     */
+    virtual void cancelDirective(std::shared_ptr<avsCommon::avs::AVSDirective> directive) {
+        cancelDirective(directive->getMessageId());
+    }
+
     /**
      * Notification that this handler has been de-registered and will not receive any more calls.
      */
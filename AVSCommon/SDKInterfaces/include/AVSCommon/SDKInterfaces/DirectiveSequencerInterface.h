@@ -82,6 +82,15 @@ public:
      */
     virtual bool removeDirectiveHandler(std::shared_ptr<DirectiveHandlerInterface> handler) = 0;
 
+    /**
+     * Stop accepting changes to the registered handlers, so that directives can be routed to them without locking.
+     * Once frozen, @c addDirectiveHandler() and @c removeDirectiveHandler() fail, and the handlers stay registered
+     * until shutdown.
+     *
+     * @return Whether the handlers were frozen.
+     */
+    virtual bool freezeDirectiveHandlers() = 0;
+
     /**
      * Set the current @c DialogRequestId. This value can be set at any time. Setting this value causes a
      * @c DirectiveSequencer to drop unhandled @c AVSDirectives with different (and non-empty) DialogRequestId
@@ -18,6 +18,9 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_MESSAGE_REQUEST_OBSERVER_INTERFACE_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_MESSAGE_REQUEST_OBSERVER_INTERFACE_H_
 
+#include <chrono>
+#include <string>
+
 namespace alexaClientSDK {
 namespace avsCommon {
 namespace sdkInterfaces {
@@ -68,6 +71,27 @@ public:
         INVALID_AUTH
     };
 
+    /**
+     * The timing of the transfer of a message.  Each phase is measured from when the transfer started, after the
+     * message had waited @c queueWait to be sent.  A phase which was not reached is zero.
+     */
+    struct TransferTimings {
+        /// The time the message waited in the transport's queue before its transfer started.
+        std::chrono::microseconds queueWait{0};
+
+        /// The time until the first byte was about to be uploaded.
+        std::chrono::microseconds firstUploadByte{0};
+
+        /// The time until the upload was complete.
+        std::chrono::microseconds uploadComplete{0};
+
+        /// The time until the first byte of the response was received.
+        std::chrono::microseconds firstResponseByte{0};
+
+        /// The time until the response was complete.
+        std::chrono::microseconds responseComplete{0};
+    };
+
     /*
      * Destructor
      */
@@ -82,6 +106,14 @@ public:
      * Called when an exception is thrown when trying to send a message to AVS.
      */
     virtual void onExceptionReceived(const std::string& exceptionMessage) = 0;
+
+    /**
+     * Called just before @c onSendCompleted() when the transfer of a message to AVS has finished, with its timing.
+     *
+     * @param timings The timing of the transfer.
+     */
+    virtual void onTransferTimings(const TransferTimings& timings) {
+    }
 };
 
 }  // namespace sdkInterfaces
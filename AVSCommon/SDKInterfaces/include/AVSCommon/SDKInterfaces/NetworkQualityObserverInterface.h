@@ -0,0 +1,66 @@
+/*
+ * NetworkQualityObserverInterface.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file NetworkQualityObserverInterface.h
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_NETWORK_QUALITY_OBSERVER_INTERFACE_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_NETWORK_QUALITY_OBSERVER_INTERFACE_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace sdkInterfaces {
+
+/**
+ * An observer of the estimated quality of the connection to AVS, for components whose behavior should depend on it,
+ * such as how much audio to buffer or how large a window of messages to keep in flight.
+ */
+class NetworkQualityObserverInterface {
+public:
+    /// An estimate of the quality of the connection.  A signal which has not been measured yet is zero.
+    struct NetworkQuality {
+        /// The smoothed round trip time.
+        std::chrono::milliseconds rtt{0};
+
+        /// The smoothed rate at which responses are received, in bytes per second.
+        uint64_t throughputBytesPerSecond{0};
+
+        /// The smoothed fraction of transfers which failed in the network, between 0 and 1.
+        double lossRate{0};
+    };
+
+    /**
+     * Destructor.
+     */
+    virtual ~NetworkQualityObserverInterface() = default;
+
+    /**
+     * Called when the estimate of the quality of the connection changes noticeably.  This is called on the network
+     * thread, so any implementation of this should return quickly.
+     *
+     * @param quality The new estimate.
+     */
+    virtual void onNetworkQualityChanged(const NetworkQuality& quality) = 0;
+};
+
+}  // namespace sdkInterfaces
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_NETWORK_QUALITY_OBSERVER_INTERFACE_H_
@@ -0,0 +1,45 @@
+/*
+ * UserInactivityObserverInterface.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_USER_INACTIVITY_OBSERVER_INTERFACE_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_USER_INACTIVITY_OBSERVER_INTERFACE_H_
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace sdkInterfaces {
+
+/**
+ * This interface is used to observe long periods of user inactivity, for example to power down components which are
+ * only needed while the user interacts with the device.
+ */
+class UserInactivityObserverInterface {
+public:
+    /// Destructor.
+    virtual ~UserInactivityObserverInterface() = default;
+
+    /// The function to be called once the user has been inactive for longer than the timeout of the observed monitor.
+    virtual void onUserInactive() = 0;
+
+    /// The function to be called when the user becomes active again after @c onUserInactive() was called.
+    virtual void onUserActiveAgain() = 0;
+};
+
+}  // namespace sdkInterfaces
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_SDK_INTERFACES_INCLUDE_AVS_COMMON_SDK_INTERFACES_USER_INACTIVITY_OBSERVER_INTERFACE_H_
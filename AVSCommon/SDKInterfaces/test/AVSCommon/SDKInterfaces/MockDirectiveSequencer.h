@@ -32,6 +32,7 @@ public:
     MockDirectiveSequencer();
     MOCK_METHOD1(addDirectiveHandler, bool(std::shared_ptr<DirectiveHandlerInterface> handler));
     MOCK_METHOD1(removeDirectiveHandler, bool(std::shared_ptr<DirectiveHandlerInterface> handler));
+    MOCK_METHOD0(freezeDirectiveHandlers, bool());
     MOCK_METHOD1(setDialogRequestId, void(const std::string& dialogRequestId));
     MOCK_METHOD1(onDirective, bool(std::shared_ptr<avsCommon::avs::AVSDirective> directive));
     MOCK_METHOD0(doShutdown, void());
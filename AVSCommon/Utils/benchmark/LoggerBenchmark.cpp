@@ -0,0 +1,267 @@
+/*
+ * LoggerBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file LoggerBenchmark.cpp
+///
+/// Measures the cost of logging to the threads which log.  Entries are logged with @c ACSDK_INFO, through the
+/// @c ModuleLogger of this module, to each sink in turn: the @c ConsoleLogger (with @c std::cout sent to /dev/null),
+/// an @c AsyncLogger writing to /dev/null with each @c OverflowPolicy, and a @c BinaryLogger.  Each sink is run with
+/// the level disabled, and enabled with different numbers of metadata in @c LogEntry::d(), from one thread and from
+/// several at once, which contend for the sink as they would in the SDK.
+///
+/// Each configuration is run twice: untimed, to report the aggregate throughput in entries per second, including the
+/// time for an @c AsyncLogger to drain; and with each call timed, to report the distribution of the latency seen by
+/// the caller.  The caller latency includes the cost of reading the clock.
+///
+/// Usage: LoggerBenchmark [--quick]
+
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AVSCommon/Utils/Logger/AsyncLogger.h"
+#include "AVSCommon/Utils/Logger/BinaryLogger.h"
+#include "AVSCommon/Utils/Logger/ConsoleLogger.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Logger/LoggerSinkManager.h"
+#include "AVSCommon/Utils/Metrics/LatencyHistogram.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("LoggerBenchmark");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The capacity of the @c AsyncLogger, in entries.
+static const size_t ASYNC_CAPACITY = 4096;
+
+/// The path of the file the @c BinaryLogger writes.
+static const std::string BINARY_LOG_PATH = "/tmp/LoggerBenchmark.binlog";
+
+/// The size of the ring of the @c BinaryLogger.
+static const size_t BINARY_RING_SIZE = 16 * 1024 * 1024;
+
+/// The size of the dictionary of the @c BinaryLogger.
+static const size_t BINARY_DICTIONARY_SIZE = 64 * 1024;
+
+/// The numbers of threads to log from.
+static const int THREAD_COUNTS[] = {1, 4};
+
+/// A way of logging to benchmark.
+struct Case {
+    /// The name printed for the case.
+    std::string name;
+
+    /// Whether the level logged at is enabled.
+    bool isEnabled;
+
+    /// The number of metadata in each entry.
+    int metadataCount;
+};
+
+/// The cases to run for each sink, in the order they are reported.
+static const Case CASES[] = {{"disabled", false, 2},
+                             {"0 metadata", true, 0},
+                             {"2 metadata", true, 2},
+                             {"8 metadata", true, 8}};
+
+/**
+ * Log one entry, as the SDK does.
+ *
+ * @param metadataCount The number of metadata in the entry.
+ * @param index A number which changes with each entry.
+ */
+static void logEntry(int metadataCount, int index) {
+    switch (metadataCount) {
+        case 0:
+            ACSDK_INFO(LX("benchmarkEvent"));
+            break;
+        case 2:
+            ACSDK_INFO(LX("benchmarkEvent").d("reason", "benchmark").d("index", index));
+            break;
+        default:
+            ACSDK_INFO(LX("benchmarkEvent")
+                           .d("reason", "benchmark")
+                           .d("index", index)
+                           .d("messageId", "5f0a3b6e-8a0d-4b7c-9e61-2c4d7f1a0b2c")
+                           .d("state", "PLAYING")
+                           .d("offsetInMilliseconds", index * 10)
+                           .d("isActive", true)
+                           .d("name", TAG)
+                           .d("count", index + 1));
+            break;
+    }
+}
+
+/**
+ * Log entries from several threads at once.
+ *
+ * @param threadCount The number of threads.
+ * @param callsPerThread The number of entries each thread logs.
+ * @param metadataCount The number of metadata in each entry.
+ * @param[out] histogram If not null, counts the latency of each call, in nanoseconds.
+ */
+static void logFromThreads(
+    int threadCount,
+    int callsPerThread,
+    int metadataCount,
+    metrics::LatencyHistogram* histogram) {
+    // LatencyHistogram is not thread safe, so each thread keeps its latencies until they are all counted.
+    std::vector<std::vector<uint64_t>> latencies(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        std::vector<uint64_t>* threadLatencies = nullptr;
+        if (histogram) {
+            threadLatencies = &latencies[t];
+            threadLatencies->reserve(callsPerThread);
+        }
+        threads.push_back(std::thread([callsPerThread, metadataCount, threadLatencies]() {
+            for (int i = 0; i < callsPerThread; ++i) {
+                if (!threadLatencies) {
+                    logEntry(metadataCount, i);
+                    continue;
+                }
+                auto start = Clock::now();
+                logEntry(metadataCount, i);
+                threadLatencies->push_back(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& threadLatencies : latencies) {
+        for (auto latency : threadLatencies) {
+            histogram->record(latency);
+        }
+    }
+}
+
+/**
+ * Run every case with a sink and print the results.
+ *
+ * @param name The name printed for the sink.
+ * @param sink The sink.
+ * @param asyncSink The sink, if it is an @c AsyncLogger, to drain before the throughput is measured.
+ * @param callsPerThread The number of entries each thread logs.
+ */
+static void runSink(const std::string& name, Logger& sink, AsyncLogger* asyncSink, int callsPerThread) {
+    LoggerSinkManager::instance().changeSinkLogger(sink);
+    for (const auto& benchmarkCase : CASES) {
+        sink.setLevel(benchmarkCase.isEnabled ? Level::INFO : Level::WARN);
+        for (auto threadCount : THREAD_COUNTS) {
+            auto dropped = asyncSink ? asyncSink->getDroppedCount() : 0;
+            auto start = Clock::now();
+            logFromThreads(threadCount, callsPerThread, benchmarkCase.metadataCount, nullptr);
+            if (asyncSink) {
+                asyncSink->flush();
+            }
+            auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            metrics::LatencyHistogram histogram;
+            logFromThreads(threadCount, callsPerThread, benchmarkCase.metadataCount, &histogram);
+            if (asyncSink) {
+                asyncSink->flush();
+            }
+
+            std::cerr << std::left << std::setw(16) << name << std::setw(12) << benchmarkCase.name << std::right
+                      << std::setw(8) << threadCount << std::setw(14) << std::fixed << std::setprecision(0)
+                      << threadCount * callsPerThread / elapsed << std::setw(9)
+                      << histogram.getValueAtPercentile(50) << std::setw(9) << histogram.getValueAtPercentile(99)
+                      << std::setw(9) << histogram.getValueAtPercentile(99.9) << std::setw(10) << histogram.getMax();
+            if (asyncSink) {
+                std::cerr << std::setw(10) << asyncSink->getDroppedCount() - dropped;
+            }
+            std::cerr << std::endl;
+        }
+    }
+    LoggerSinkManager::instance().changeSinkLogger(ConsoleLogger::instance());
+}
+
+/**
+ * Run every sink and print a table of results.
+ *
+ * @param isQuick Whether to log fewer entries in each configuration.
+ */
+static void runAll(bool isQuick) {
+    const int callsPerThread = isQuick ? 2000 : 50000;
+
+    // The results go to std::cerr, as the ConsoleLogger has std::cout.
+    std::cerr << "Caller latencies are p50, p99, p99.9 and max, in nanoseconds." << std::endl;
+    std::cerr << std::left << std::setw(16) << "sink" << std::setw(12) << "case" << std::right << std::setw(8)
+              << "threads" << std::setw(14) << "entries/s" << std::setw(9) << "p50" << std::setw(9) << "p99"
+              << std::setw(9) << "p99.9" << std::setw(10) << "max" << std::setw(10) << "dropped" << std::endl;
+
+    std::ofstream devNull("/dev/null");
+    auto coutBuffer = std::cout.rdbuf(devNull.rdbuf());
+    runSink("console", ConsoleLogger::instance(), nullptr, callsPerThread);
+    std::cout.rdbuf(coutBuffer);
+
+    int fd = open("/dev/null", O_WRONLY);
+    {
+        AsyncLogger blocking(Level::INFO, fd, ASYNC_CAPACITY, AsyncLogger::OverflowPolicy::BLOCK);
+        runSink("async BLOCK", blocking, &blocking, callsPerThread);
+    }
+    {
+        AsyncLogger dropping(Level::INFO, fd, ASYNC_CAPACITY, AsyncLogger::OverflowPolicy::DROP);
+        runSink("async DROP", dropping, &dropping, callsPerThread);
+    }
+    close(fd);
+
+    auto binary = BinaryLogger::create(Level::INFO, BINARY_LOG_PATH, BINARY_RING_SIZE, BINARY_DICTIONARY_SIZE);
+    if (binary) {
+        runSink("binary", *binary, nullptr, callsPerThread);
+        binary.reset();
+        std::remove(BINARY_LOG_PATH.c_str());
+    } else {
+        std::cerr << "Cannot create the binary log " << BINARY_LOG_PATH << std::endl;
+    }
+}
+
+}  // namespace benchmark
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    bool isQuick = (argc > 1 && std::string("--quick") == argv[1]);
+    alexaClientSDK::avsCommon::utils::logger::benchmark::runAll(isQuick);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,279 @@
+/*
+ * SchedulingBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SchedulingBenchmark.cpp
+///
+/// Measures the cost of the SDK's scheduling primitives, as a baseline for changes to them:
+/// - the round trip of @c Executor::submit(), from the call to the future being ready, for an @c Executor with a
+///   thread of its own and one backed by a @c ThreadPool;
+/// - the throughput of @c TaskQueue with 1 to 8 producers and one consumer;
+/// - the time @c Timer::start() takes, which includes creating a thread unless the @c Timer is backed by a
+///   @c TimerService;
+/// - how late one-shot @c Timers fire, with and without every core kept busy.
+///
+/// Usage: SchedulingBenchmark [--quick]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/Executor.h"
+#include "AVSCommon/Utils/Threading/TaskQueue.h"
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
+#include "AVSCommon/Utils/Timing/TimerService.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace benchmark {
+
+using namespace threading;
+using namespace timing;
+
+using Clock = std::chrono::steady_clock;
+
+/// The number of threads of the @c ThreadPool backing pooled Executors.
+static const size_t POOL_THREADS = 4;
+
+/// The numbers of producers pushing to a @c TaskQueue.
+static const int PRODUCER_COUNTS[] = {1, 2, 4, 8};
+
+/// The longest delay of the timers whose firing is measured.
+static const std::chrono::milliseconds MAX_TIMER_DELAY(50);
+
+/**
+ * Get a percentile of a list of samples.
+ *
+ * @param samples The samples, which are sorted by this function.
+ * @param percentile The percentile (0-100) to return.
+ * @return The sample at @c percentile, or zero if there are no samples.
+ */
+static std::chrono::microseconds percentile(std::vector<Clock::duration>* samples, size_t percentile) {
+    if (samples->empty()) {
+        return std::chrono::microseconds::zero();
+    }
+    std::sort(samples->begin(), samples->end());
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        (*samples)[std::min(samples->size() - 1, samples->size() * percentile / 100)]);
+}
+
+/**
+ * Print a row of latencies.
+ *
+ * @param name The name of the row.
+ * @param samples The latencies.
+ */
+static void printLatencies(const std::string& name, std::vector<Clock::duration>* samples) {
+    auto p50 = percentile(samples, 50);
+    auto p99 = percentile(samples, 99);
+    auto max = percentile(samples, 100);
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << p50.count() << std::setw(10)
+              << p99.count() << std::setw(10) << max.count() << std::endl;
+}
+
+/**
+ * Measure the round trip of @c Executor::submit().
+ *
+ * @param name The name printed for the executor.
+ * @param executor The executor.
+ * @param count The number of tasks to submit.
+ */
+static void runExecutorRoundTrip(const std::string& name, Executor* executor, int count) {
+    std::vector<Clock::duration> samples;
+    samples.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto start = Clock::now();
+        executor->submit([]() {}).wait();
+        samples.push_back(Clock::now() - start);
+    }
+    printLatencies(name, &samples);
+}
+
+/**
+ * Measure the throughput of a @c TaskQueue.
+ *
+ * @param numProducers The number of threads pushing tasks.
+ * @param tasksPerProducer The number of tasks each producer pushes.
+ */
+static void runTaskQueue(int numProducers, int tasksPerProducer) {
+    TaskQueue queue;
+    std::atomic<int> completed{0};
+    const int total = numProducers * tasksPerProducer;
+    auto start = Clock::now();
+    std::thread consumer([&queue, &completed, total]() {
+        while (completed.load(std::memory_order_relaxed) < total) {
+            auto task = queue.pop();
+            if (!task) {
+                return;
+            }
+            (*task)();
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; ++p) {
+        producers.push_back(std::thread([&queue, &completed, tasksPerProducer]() {
+            for (int i = 0; i < tasksPerProducer; ++i) {
+                queue.push([&completed]() { completed.fetch_add(1, std::memory_order_relaxed); });
+            }
+        }));
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << std::left << std::setw(40) << (std::to_string(numProducers) + " producers") << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << total / elapsed << std::endl;
+}
+
+/**
+ * Measure the time @c Timer::start() and @c Timer::stop() take.
+ *
+ * @param name The name printed for the timers.
+ * @param timerService The @c TimerService backing the timers, or @c nullptr for threads of their own.
+ * @param count The number of timers to start.
+ */
+static void runTimerStart(const std::string& name, std::shared_ptr<TimerService> timerService, int count) {
+    std::vector<Clock::duration> startSamples;
+    std::vector<Clock::duration> stopSamples;
+    for (int i = 0; i < count; ++i) {
+        Timer timer(timerService);
+        auto start = Clock::now();
+        timer.start(std::chrono::hours(1), []() {});
+        auto started = Clock::now();
+        timer.stop();
+        stopSamples.push_back(Clock::now() - started);
+        startSamples.push_back(started - start);
+    }
+    printLatencies(name + " start()", &startSamples);
+    printLatencies(name + " stop()", &stopSamples);
+}
+
+/**
+ * Measure how late one-shot timers fire.
+ *
+ * @param name The name printed for the timers.
+ * @param timerService The @c TimerService backing the timers, or @c nullptr for threads of their own.
+ * @param count The number of timers, whose delays are spread evenly up to @c MAX_TIMER_DELAY.
+ * @param isLoaded Whether to keep every core busy while the timers run.
+ */
+static void runTimerAccuracy(
+    const std::string& name,
+    std::shared_ptr<TimerService> timerService,
+    int count,
+    bool isLoaded) {
+    std::atomic<bool> isDone{false};
+    std::vector<std::thread> load;
+    if (isLoaded) {
+        for (unsigned int i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i) {
+            load.push_back(std::thread([&isDone]() {
+                while (!isDone) {
+                }
+            }));
+        }
+    }
+
+    std::mutex mutex;
+    std::vector<Clock::duration> samples;
+    std::vector<std::unique_ptr<Timer>> timers;
+    auto start = Clock::now();
+    for (int i = 0; i < count; ++i) {
+        auto due = start + MAX_TIMER_DELAY * (i + 1) / count;
+        timers.push_back(std::unique_ptr<Timer>(new Timer(timerService)));
+        timers.back()->start(std::max(Clock::duration::zero(), due - Clock::now()), [&mutex, &samples, due]() {
+            auto lateness = Clock::now() - due;
+            std::lock_guard<std::mutex> lock(mutex);
+            samples.push_back(lateness);
+        });
+    }
+    std::this_thread::sleep_for(MAX_TIMER_DELAY * 2);
+    timers.clear();
+    isDone = true;
+    for (auto& thread : load) {
+        thread.join();
+    }
+    printLatencies(name + (isLoaded ? ", loaded" : ", idle"), &samples);
+}
+
+/**
+ * Run every benchmark and print the results.
+ *
+ * @param isQuick Whether to run fewer iterations.
+ */
+static void runAll(bool isQuick) {
+    const int roundTrips = isQuick ? 2000 : 20000;
+    const int tasksPerProducer = isQuick ? 20000 : 200000;
+    const int timerStarts = isQuick ? 200 : 2000;
+    const int timers = isQuick ? 50 : 200;
+    auto header = [](const std::string& title) {
+        std::cout << std::endl
+                  << std::left << std::setw(40) << title << std::right << std::setw(10) << "p50" << std::setw(10)
+                  << "p99" << std::setw(10) << "max" << std::endl;
+    };
+
+    header("Executor::submit() round trip (us)");
+    {
+        Executor ownThread(nullptr);
+        runExecutorRoundTrip("own thread", &ownThread, roundTrips);
+    }
+    {
+        auto threadPool = std::make_shared<ThreadPool>(POOL_THREADS);
+        Executor pooled(threadPool);
+        runExecutorRoundTrip("ThreadPool of " + std::to_string(POOL_THREADS), &pooled, roundTrips);
+        pooled.shutdown();
+        threadPool->shutdown();
+    }
+
+    std::cout << std::endl << std::left << std::setw(40) << "TaskQueue, one consumer" << std::right << std::setw(14)
+              << "tasks/s" << std::endl;
+    for (auto numProducers : PRODUCER_COUNTS) {
+        runTaskQueue(numProducers, tasksPerProducer / numProducers);
+    }
+
+    auto timerService = std::make_shared<TimerService>();
+    header("Timer (us)");
+    runTimerStart("own thread", nullptr, timerStarts);
+    runTimerStart("TimerService", timerService, timerStarts);
+
+    header("Timer lateness (us)");
+    for (auto isLoaded : {false, true}) {
+        runTimerAccuracy("own thread", nullptr, timers, isLoaded);
+        runTimerAccuracy("TimerService", timerService, timers, isLoaded);
+    }
+}
+
+}  // namespace benchmark
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    bool isQuick = (argc > 1 && std::string("--quick") == argv[1]);
+    alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_SINK_LOGGER().setLevel(
+        alexaClientSDK::avsCommon::utils::logger::Level::WARN);
+    alexaClientSDK::avsCommon::utils::benchmark::runAll(isQuick);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,262 @@
+/*
+ * SharedDataStreamBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SharedDataStreamBenchmark.cpp
+///
+/// Measures @c SharedDataStream throughput, reader wake latency and CPU cost.  Each configuration is run twice:
+/// - unpaced, with an @c ALL_OR_NOTHING writer pushing data as fast as the slowest reader consumes it, to report
+///   throughput and CPU time per megabyte;
+/// - paced, with the writer sleeping between chunks (as a microphone would), to report the delay between a chunk
+///   being written and each reader returning it.
+///
+/// Usage: SharedDataStreamBenchmark [--quick]
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+/// Options for a single benchmark run.
+struct Config {
+    /// The word size of the stream.
+    size_t wordSize;
+
+    /// The number of readers attached to the stream.
+    size_t numReaders;
+
+    /// The policy of the readers.
+    InProcessSDS::Reader::Policy readerPolicy;
+
+    /// The number of words the writer writes (and each reader reads) at a time.
+    size_t chunkWords;
+
+    /// The size of the stream's circular buffer, in words.
+    size_t bufferWords;
+};
+
+/// The results of a single benchmark run.
+struct Result {
+    /// The number of bytes written per second of wall time.
+    double bytesPerSecond;
+
+    /// Process CPU time spent per megabyte written.
+    double cpuMsPerMegabyte;
+
+    /// The median delay between writing a chunk and a reader returning it.
+    std::chrono::microseconds p50WakeLatency;
+
+    /// The 99th percentile delay between writing a chunk and a reader returning it.
+    std::chrono::microseconds p99WakeLatency;
+};
+
+/// The period between chunks in the paced run.
+static const std::chrono::microseconds PACED_PERIOD{500};
+
+/// The maximum time a blocking reader waits for data before checking whether the run has ended.
+static const std::chrono::milliseconds READ_TIMEOUT{100};
+
+/// Bytes in a megabyte.
+static const double MEGABYTE = 1024.0 * 1024.0;
+
+/**
+ * Get the CPU time used by this process.
+ *
+ * @return The CPU time used by this process.
+ */
+static std::chrono::nanoseconds processCpuTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
+
+/**
+ * Get a percentile of a list of samples.
+ *
+ * @param samples The samples, which are sorted by this function.
+ * @param percentile The percentile (0-100) to return.
+ * @return The sample at @c percentile, or zero if there are no samples.
+ */
+static std::chrono::microseconds percentile(std::vector<Clock::duration>* samples, size_t percentile) {
+    if (samples->empty()) {
+        return std::chrono::microseconds::zero();
+    }
+    std::sort(samples->begin(), samples->end());
+    size_t index = std::min(samples->size() - 1, samples->size() * percentile / 100);
+    return std::chrono::duration_cast<std::chrono::microseconds>((*samples)[index]);
+}
+
+/**
+ * Read chunks from @c reader until the stream closes.  Each chunk starts with the time it was written, which is used
+ * to record the wake latency when the last word of the chunk has been read.
+ *
+ * @param reader The reader to read from.
+ * @param config The configuration of the run.
+ * @param[out] latencies The wake latency of each chunk.
+ */
+static void readChunks(
+    std::shared_ptr<InProcessSDS::Reader> reader,
+    const Config& config,
+    std::vector<Clock::duration>* latencies) {
+    std::vector<uint8_t> chunk(config.chunkWords * config.wordSize);
+    size_t wordsInChunk = 0;
+    while (true) {
+        ssize_t result = reader->read(
+            chunk.data() + wordsInChunk * config.wordSize, config.chunkWords - wordsInChunk, READ_TIMEOUT);
+        if (0 == result) {
+            return;
+        } else if (InProcessSDS::Reader::Error::WOULDBLOCK == result) {
+            std::this_thread::yield();
+            continue;
+        } else if (result < 0) {
+            if (InProcessSDS::Reader::Error::TIMEDOUT != result) {
+                std::cerr << "read failed: " << result << std::endl;
+                return;
+            }
+            continue;
+        }
+        wordsInChunk += result;
+        if (config.chunkWords == wordsInChunk) {
+            Clock::time_point written;
+            memcpy(&written, chunk.data(), sizeof(written));
+            latencies->push_back(Clock::now() - written);
+            wordsInChunk = 0;
+        }
+    }
+}
+
+/**
+ * Run one configuration.
+ *
+ * @param config The configuration to run.
+ * @param numChunks The number of chunks to write.
+ * @param period The time to wait between chunks, or zero to write as fast as the readers allow.
+ * @return The results of the run.
+ */
+static Result run(const Config& config, size_t numChunks, std::chrono::microseconds period) {
+    auto buffer = std::make_shared<InProcessSDS::Buffer>(
+        InProcessSDS::calculateBufferSize(config.bufferWords, config.wordSize, config.numReaders));
+    auto sds = InProcessSDS::create(buffer, config.wordSize, config.numReaders);
+    auto writer = sds->createWriter(InProcessSDS::Writer::Policy::ALL_OR_NOTHING);
+
+    std::vector<std::vector<Clock::duration>> latencies(config.numReaders);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < config.numReaders; ++i) {
+        std::shared_ptr<InProcessSDS::Reader> reader = sds->createReader(config.readerPolicy);
+        reader->setWakeupThreshold(config.chunkWords);
+        latencies[i].reserve(numChunks);
+        readers.emplace_back(readChunks, reader, std::cref(config), &latencies[i]);
+    }
+
+    std::vector<uint8_t> chunk(config.chunkWords * config.wordSize, 0x5a);
+    auto startCpu = processCpuTime();
+    auto start = Clock::now();
+    for (size_t i = 0; i < numChunks; ++i) {
+        if (period > std::chrono::microseconds::zero()) {
+            std::this_thread::sleep_until(start + period * i);
+        }
+        auto now = Clock::now();
+        memcpy(chunk.data(), &now, sizeof(now));
+        while (InProcessSDS::Writer::Error::WOULDBLOCK == writer->write(chunk.data(), config.chunkWords)) {
+            std::this_thread::yield();
+        }
+    }
+    writer->close();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+    auto cpu = std::chrono::duration<double, std::milli>(processCpuTime() - startCpu);
+
+    double bytes = static_cast<double>(numChunks * chunk.size());
+    std::vector<Clock::duration> allLatencies;
+    for (auto& readerLatencies : latencies) {
+        allLatencies.insert(allLatencies.end(), readerLatencies.begin(), readerLatencies.end());
+    }
+    Result result;
+    result.bytesPerSecond = bytes / elapsed.count();
+    result.cpuMsPerMegabyte = cpu.count() / (bytes / MEGABYTE);
+    result.p50WakeLatency = percentile(&allLatencies, 50);
+    result.p99WakeLatency = percentile(&allLatencies, 99);
+    return result;
+}
+
+/**
+ * Run every configuration and print a table of results.
+ *
+ * @param isQuick Whether to run a reduced set of configurations with fewer chunks.
+ */
+static void runAll(bool isQuick) {
+    std::vector<size_t> wordSizes = isQuick ? std::vector<size_t>{2} : std::vector<size_t>{1, 2, 4, 16};
+    std::vector<size_t> readerCounts = isQuick ? std::vector<size_t>{1, 3} : std::vector<size_t>{1, 2, 3, 8};
+    std::vector<InProcessSDS::Reader::Policy> readerPolicies = {InProcessSDS::Reader::Policy::BLOCKING,
+                                                                InProcessSDS::Reader::Policy::NONBLOCKING};
+    // 160 words is 10ms of 16kHz audio and divides the buffer evenly; 157 words makes most chunks wrap.
+    std::vector<size_t> chunkSizes = {160, 157};
+    const size_t bufferWords = 160 * 16;
+    const size_t unpacedChunks = isQuick ? 2000 : 20000;
+    const size_t pacedChunks = isQuick ? 200 : 2000;
+
+    std::cout << std::setw(8) << "wordSize" << std::setw(8) << "readers" << std::setw(13) << "policy"
+              << std::setw(7) << "chunk" << std::setw(12) << "MB/s" << std::setw(12) << "cpuMs/MB" << std::setw(10)
+              << "p50(us)" << std::setw(10) << "p99(us)" << std::endl;
+    for (auto wordSize : wordSizes) {
+        for (auto numReaders : readerCounts) {
+            for (auto readerPolicy : readerPolicies) {
+                for (auto chunkWords : chunkSizes) {
+                    // Each chunk must be big enough to carry its timestamp.
+                    chunkWords = std::max(chunkWords, (sizeof(Clock::time_point) + wordSize - 1) / wordSize);
+                    Config config = {wordSize, numReaders, readerPolicy, chunkWords, bufferWords};
+                    auto throughput = run(config, unpacedChunks, std::chrono::microseconds::zero());
+                    auto latency = run(config, pacedChunks, PACED_PERIOD);
+                    std::cout << std::setw(8) << wordSize << std::setw(8) << numReaders << std::setw(13)
+                              << (InProcessSDS::Reader::Policy::BLOCKING == readerPolicy ? "BLOCKING" : "NONBLOCKING")
+                              << std::setw(7) << chunkWords << std::setw(12) << std::fixed << std::setprecision(1)
+                              << throughput.bytesPerSecond / MEGABYTE << std::setw(12) << std::setprecision(2)
+                              << throughput.cpuMsPerMegabyte << std::setw(10) << latency.p50WakeLatency.count()
+                              << std::setw(10) << latency.p99WakeLatency.count() << std::endl;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace benchmark
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    bool isQuick = (argc > 1 && std::string("--quick") == argv[1]);
+    alexaClientSDK::avsCommon::utils::sds::benchmark::runAll(isQuick);
+    return EXIT_SUCCESS;
+}
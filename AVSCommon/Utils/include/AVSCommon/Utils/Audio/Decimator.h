@@ -0,0 +1,105 @@
+/*
+ * Decimator.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_AUDIO_DECIMATOR_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_AUDIO_DECIMATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/**
+ * Reduces the sample rate of a stream of signed 16-bit mono samples by an integer factor, such as 48 kHz to 16 kHz.
+ *
+ * The samples are filtered by a windowed-sinc low-pass FIR filter with its cutoff just below the Nyquist frequency of
+ * the output.  As in a polyphase decimator, the filter is only evaluated at the input samples which are kept, so the
+ * cost is one dot product of @c TAPS_PER_PHASE * factor taps per output sample.  The filter is applied with fixed-point
+ * arithmetic, using the vector kernel of @c dotProductInt16().
+ *
+ * The last input samples are kept between calls to @c process(), so a stream may be passed in chunks of any size.
+ * This class is not thread-safe.
+ */
+class Decimator {
+public:
+    /// The number of filter taps for each input sample which is dropped or kept.
+    static const size_t TAPS_PER_PHASE = 32;
+
+    /**
+     * Create a @c Decimator.
+     *
+     * @param factor The number of input samples for each output sample.  It must be at least 1.
+     * @return The new @c Decimator, or @c nullptr if @c factor is invalid.
+     */
+    static std::unique_ptr<Decimator> create(unsigned int factor);
+
+    /**
+     * Get the number of output samples which @c process() produces for a number of input samples.
+     *
+     * @param numSamples The number of input samples.
+     * @return The number of output samples.
+     */
+    size_t getOutputSize(size_t numSamples) const;
+
+    /**
+     * Filter and decimate a chunk of samples.
+     *
+     * @param input The samples.
+     * @param numSamples The number of samples.
+     * @param output Where to put the decimated samples.  It must have room for @c getOutputSize(numSamples)
+     *     samples, and may be @c nullptr if that is zero.
+     * @return The number of samples put in @c output.
+     */
+    size_t process(const int16_t* input, size_t numSamples, int16_t* output);
+
+    /**
+     * Forget the samples which were passed to @c process(), as at the start of a new stream.
+     */
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param factor The number of input samples for each output sample.
+     */
+    Decimator(unsigned int factor);
+
+    /// The number of input samples for each output sample.
+    const unsigned int m_factor;
+
+    /// The Q15 taps of the filter, in reverse order so that they line up with the samples they apply to.
+    std::vector<int16_t> m_taps;
+
+    /// The last input samples, kept for the next call to @c process(), followed by the samples being processed.
+    std::vector<int16_t> m_history;
+
+    /// The number of samples to drop before the next sample which is kept.
+    size_t m_skip;
+};
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_AUDIO_DECIMATOR_H_
@@ -0,0 +1,97 @@
+/*
+ * SampleConversion.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_AUDIO_SAMPLE_CONVERSION_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_AUDIO_SAMPLE_CONVERSION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/**
+ * @file
+ * Kernels which convert audio samples to the 16-bit format used by the rest of the SDK.
+ *
+ * The kernels use SSE2 or NEON when the compiler targets them (@c __SSE2__ or @c __ARM_NEON), and portable code
+ * otherwise.  The input and output buffers may be unaligned, but must not overlap unless stated otherwise.
+ */
+
+/**
+ * Convert signed 32-bit samples to signed 16-bit samples, by keeping their 16 most significant bits.
+ *
+ * @param input The samples to convert.
+ * @param output Where to put the converted samples.  It may be the same buffer as @c input.
+ * @param numSamples The number of samples to convert.
+ */
+void convertInt32ToInt16(const int32_t* input, int16_t* output, size_t numSamples);
+
+/**
+ * Convert floating point samples in the range [-1.0, 1.0] to signed 16-bit samples.  Samples outside of the range are
+ * clipped.
+ *
+ * @param input The samples to convert.
+ * @param output Where to put the converted samples.  It may be the same buffer as @c input.
+ * @param numSamples The number of samples to convert.
+ */
+void convertFloatToInt16(const float* input, int16_t* output, size_t numSamples);
+
+/**
+ * Mix interleaved signed 16-bit samples down to one channel, by taking the mean of the channels of each frame.
+ *
+ * @param input The interleaved samples, @c numChannels per frame.
+ * @param numChannels The number of channels.
+ * @param output Where to put the mixed samples, one per frame.  It may be the same buffer as @c input.
+ * @param numFrames The number of frames to mix.
+ */
+void downmixToMono(const int16_t* input, unsigned int numChannels, int16_t* output, size_t numFrames);
+
+/**
+ * Copy one channel out of interleaved signed 16-bit samples.
+ *
+ * @param input The interleaved samples, @c numChannels per frame.
+ * @param numChannels The number of channels.
+ * @param channel The index of the channel to copy, which must be less than @c numChannels.
+ * @param output Where to put the samples of the channel, one per frame.  It may be the same buffer as @c input.
+ * @param numFrames The number of frames to copy the channel of.
+ */
+void extractChannel(
+    const int16_t* input,
+    unsigned int numChannels,
+    unsigned int channel,
+    int16_t* output,
+    size_t numFrames);
+
+/**
+ * Compute the dot product of two vectors of signed 16-bit values.
+ *
+ * @param a The first vector.
+ * @param b The second vector.
+ * @param length The number of values in each vector.
+ * @return The dot product.  The caller must ensure that it fits in 32 bits.
+ */
+int32_t dotProductInt16(const int16_t* a, const int16_t* b, size_t length);
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_AUDIO_SAMPLE_CONVERSION_H_
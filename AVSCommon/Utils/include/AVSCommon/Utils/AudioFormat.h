@@ -36,7 +36,10 @@ struct AudioFormat {
      */
     enum class Encoding {
         /// Represents LPCM (Linear pulse code modulation) encoding.
-        LPCM
+        LPCM,
+
+        /// Represents Opus encoding.
+        OPUS
     };
 
     /**
@@ -78,6 +81,9 @@ inline std::ostream& operator<<(std::ostream& stream, const AudioFormat::Encodin
         case AudioFormat::Encoding::LPCM:
             stream << "LPCM";
             break;
+        case AudioFormat::Encoding::OPUS:
+            stream << "OPUS";
+            break;
     }
     return stream;
 }
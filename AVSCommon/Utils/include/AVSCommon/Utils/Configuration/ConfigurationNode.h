@@ -67,9 +67,22 @@ namespace configuration {
  *         }
  *     }
  * @endcode
+ *
+ * The merged configuration is an immutable snapshot, published atomically by @c initialize().  Each
+ * @c ConfigurationNode keeps the snapshot it was obtained from alive, so reading from a node never takes a lock, and
+ * stays valid across @c uninitialize() and a later @c initialize() with a new configuration.
+ *
+ * Several clients in one process may each be given a configuration of their own.  @c createRoot() parses a
+ * configuration without publishing it, and a @c ScopedRoot makes @c getRoot() return it on the current thread while
+ * the client is created.
  */
 class ConfigurationNode {
 public:
+    /**
+     * Makes @c getRoot() return a given configuration on the thread which constructs it, until it is destroyed.
+     */
+    class ScopedRoot;
+
     /**
      * Initialize the global configuration.
      *
@@ -90,14 +103,25 @@ public:
     /**
      * Uninitialize the global configuration.
      *
-     * @note Once this method has been called, all existing ConfigurationNode instances will become invalid.
+     * @note Once this method has been called, @c getRoot() returns an empty @c ConfigurationNode.  Existing
+     * @c ConfigurationNode instances keep referring to the configuration they were obtained from.
      */
     static void uninitialize();
 
     /**
-     * Get the root @c ConfigurationNode of the global configuration.
+     * Parse a configuration without making it the global one, so that it can be given to a single client with a
+     * @c ScopedRoot.  The streams are merged as by @c initialize().
      *
-     * @return The root @c ConfigurationNode of the global configuration.
+     * @param jsonStreams Vector of @c istreams containing JSON documents from which to parse configuration parameters.
+     * @return The root @c ConfigurationNode of the configuration, which is empty if parsing failed.
+     */
+    static ConfigurationNode createRoot(const std::vector<std::istream*>& jsonStreams);
+
+    /**
+     * Get the root @c ConfigurationNode of the configuration of the innermost @c ScopedRoot on this thread, or of the
+     * global configuration if there is none.
+     *
+     * @return The root @c ConfigurationNode of the configuration.
      */
     static ConfigurationNode getRoot();
 
@@ -180,8 +204,9 @@ private:
      *
      * @param object @c rapidjson::Value of type @c rapidjson::Type::kObject within the global configuration that this
      * @c ConfigurationNode will represent.
+     * @param document The snapshot of the global configuration containing @c object.
      */
-    ConfigurationNode(const rapidjson::Value* object);
+    ConfigurationNode(const rapidjson::Value* object, std::shared_ptr<const rapidjson::Document> document);
 
     /**
      * Adapt between the public version of @c getString() (which fetches @c std::string) and the @c getValue()
@@ -216,17 +241,57 @@ private:
     /// Object value within the global configuration that this @c ConfigurationNode represents.
     const rapidjson::Value* m_object;
 
+    /// The snapshot of the global configuration containing @c m_object, kept alive for as long as this node.
+    std::shared_ptr<const rapidjson::Document> m_document;
+
     /**
-     * Static mutex to serialize access to static values @c m_document and @c m_root.  This enables enforcing
-     * that @c initialize() is only performed once after startup or the latest call to @c uninitialize().
+     * Static mutex to serialize calls to @c initialize() and @c uninitialize().  This enables enforcing that
+     * @c initialize() is only performed once after startup or the latest call to @c uninitialize().
      */
     static std::mutex m_mutex;
 
-    /// static Document containing the global configuration.
-    static rapidjson::Document m_document;
+    /**
+     * static snapshot of the global configuration, or @c nullptr if it is not initialized.  It is only accessed with
+     * @c std::atomic_load() and @c std::atomic_store(), so that @c getRoot() does not need @c m_mutex.
+     */
+    static std::shared_ptr<const rapidjson::Document> m_snapshot;
+};
+
+/**
+ * Makes @c getRoot() return a given configuration, rather than the global one, on the thread which constructs it,
+ * until it is destroyed.  Scopes may be nested, in which case the innermost one applies.
+ *
+ * @note Only reads from @c getRoot() on the constructing thread are affected.  Components which read their
+ * configuration later, on threads of their own, get the global configuration.
+ */
+class ConfigurationNode::ScopedRoot {
+public:
+    /**
+     * Constructor.
+     *
+     * @param root The configuration @c getRoot() should return on this thread.
+     */
+    explicit ScopedRoot(const ConfigurationNode& root);
+
+    /**
+     * Destructor.  Restores the configuration @c getRoot() returned before this scope.
+     */
+    ~ScopedRoot();
+
+    /// @cond
+    ScopedRoot(const ScopedRoot&) = delete;
+    ScopedRoot& operator=(const ScopedRoot&) = delete;
+    /// @endcond
+
+private:
+    /// The configuration @c getRoot() returns within this scope.
+    const ConfigurationNode m_root;
+
+    /// The scope this one is nested in, or @c nullptr.
+    const ScopedRoot* m_previous;
 
-    /// static instance of @c ConfigurationNode identifying the root object within the global configuration.
-    static ConfigurationNode m_root;
+    /// Allow @c getRoot() to read @c m_root.
+    friend class ConfigurationNode;
 };
 
 template <typename InputType, typename OutputType, typename DefaultType>
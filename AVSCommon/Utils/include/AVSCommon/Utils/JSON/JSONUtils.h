@@ -18,6 +18,8 @@
 #define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_JSON_JSONUTILS_H_
 
 #include <rapidjson/document.h>
+#include <map>
+#include <set>
 #include <string>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
@@ -77,6 +79,40 @@ bool lookupStringValue(const std::string& jsonContent, const std::string& key, s
  */
 bool lookupInt64Value(const std::string& jsonContent, const std::string& key, int64_t* value);
 
+/**
+ * Look up several direct child values of a JSON object string in a single pass, without building a document.  This is
+ * meant for callers which would otherwise call @c lookupStringValue() or @c lookupInt64Value() several times on the
+ * same string, parsing it each time.  Each key is mapped to the output parameter which receives its value.  As with
+ * @c lookupStringValue(), a string value may also be a logical JSON object, which is serialized.
+ *
+ * Parsing stops as soon as every key has been found, so the rest of the string is not validated.
+ *
+ * @param jsonContent The JSON string content.
+ * @param stringValues The keys of the string values to look up, each mapped to the output parameter for its value.
+ * @param int64Values The keys of the int64_t values to look up, each mapped to the output parameter for its value.
+ * @param[out] missingKeys If not @c nullptr, the keys which were not found with a value of their type are assigned
+ * here instead of failing the lookup, so that callers can treat some values as optional.
+ * @return @c true if every key was found with a value of its type, or if @c missingKeys is not @c nullptr and the
+ * JSON was parsed, @c false otherwise.  The values which were found are assigned either way.
+ */
+bool lookupValues(
+    const std::string& jsonContent,
+    const std::map<std::string, std::string*>& stringValues,
+    const std::map<std::string, int64_t*>& int64Values = std::map<std::string, int64_t*>(),
+    std::set<std::string>* missingKeys = nullptr);
+
+/**
+ * Find the first string value with a given key anywhere in a JSON string, without parsing it.  This is meant for
+ * paths which need a single header field of a message before it is parsed, such as latency tracking.  The value is
+ * returned as it appears in the text, so values holding escape sequences are not supported.
+ *
+ * @param jsonContent The JSON string content.
+ * @param key The key of the value.
+ * @param[out] value The output parameter which will be assigned the string value.
+ * @return @c true if a string value was found for the key, @c false otherwise.
+ */
+bool scanStringValue(const std::string& jsonContent, const std::string& key, std::string* value);
+
 /**
  * Invoke a rapidjson parse on a JSON string.
  *
@@ -0,0 +1,154 @@
+/*
+ * PayloadDecoder.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_JSON_PAYLOAD_DECODER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_JSON_PAYLOAD_DECODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+#include "AVSCommon/Utils/JSON/JSONUtils.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace json {
+namespace jsonUtils {
+
+/**
+ * One field of a directive payload schema, naming the key of a direct child of the payload and the member of the
+ * @c Payload struct which receives its value.  Schemas are declared as @c constexpr arrays of these, for example:
+ *
+ * @code
+ * struct SpeakPayload {
+ *     std::string token;
+ *     std::string url;
+ * };
+ *
+ * static constexpr PayloadField<SpeakPayload> SPEAK_SCHEMA[] = {{"token", &SpeakPayload::token},
+ *                                                               {"url", &SpeakPayload::url}};
+ * @endcode
+ *
+ * @tparam Payload The struct the payload is decoded into.
+ */
+template <typename Payload>
+struct PayloadField {
+    /**
+     * Constructor for a string field.  As with @c lookupStringValue(), the value may also be a JSON object, which is
+     * assigned serialized.
+     *
+     * @param key The key of the field.
+     * @param member The member which receives the value.
+     * @param required Whether decoding fails if the field is missing.
+     */
+    constexpr PayloadField(const char* key, std::string Payload::*member, bool required = true) :
+            key{key},
+            stringMember{member},
+            int64Member{nullptr},
+            required{required} {
+    }
+
+    /**
+     * Constructor for an integer field.
+     *
+     * @param key The key of the field.
+     * @param member The member which receives the value.
+     * @param required Whether decoding fails if the field is missing.
+     */
+    constexpr PayloadField(const char* key, int64_t Payload::*member, bool required = true) :
+            key{key},
+            stringMember{nullptr},
+            int64Member{member},
+            required{required} {
+    }
+
+    /// The key of the field.
+    const char* key;
+
+    /// The member which receives a string value, or @c nullptr if the field is an integer.
+    std::string Payload::*stringMember;
+
+    /// The member which receives an integer value, or @c nullptr if the field is a string.
+    int64_t Payload::*int64Member;
+
+    /// Whether decoding fails if the field is missing.
+    bool required;
+};
+
+/**
+ * Decode a directive payload into a struct in a single pass over the JSON, without building a document, and check
+ * that every required field is present with a value of its type.  Optional fields which are missing leave their
+ * members unchanged, so they should be given their defaults before decoding.
+ *
+ * Only the direct children of the payload are decoded.  A nested object may be declared as a string field and
+ * decoded in turn with its own schema.
+ *
+ * @tparam Payload The struct the payload is decoded into.
+ * @tparam N The number of fields in the schema.
+ * @param jsonContent The payload.
+ * @param schema The fields of the payload.
+ * @param[out] payload The struct which receives the values.
+ * @param[out] missingKey If not @c nullptr, the key of the first required field which is missing or has a value of
+ * the wrong type is assigned here when decoding fails for that reason.
+ * @return Whether the payload was parsed and every required field was found.
+ */
+template <typename Payload, size_t N>
+bool decodePayload(
+    const std::string& jsonContent,
+    const PayloadField<Payload> (&schema)[N],
+    Payload* payload,
+    std::string* missingKey = nullptr) {
+    if (!payload) {
+        logger::acsdkError(logger::LogEntry(getTag(), "decodePayloadFailed").d("reason", "nullPayload"));
+        return false;
+    }
+
+    std::map<std::string, std::string*> stringValues;
+    std::map<std::string, int64_t*> int64Values;
+    for (const auto& field : schema) {
+        if (field.stringMember) {
+            stringValues[field.key] = &(payload->*field.stringMember);
+        } else if (field.int64Member) {
+            int64Values[field.key] = &(payload->*field.int64Member);
+        }
+    }
+
+    std::set<std::string> missingKeys;
+    if (!lookupValues(jsonContent, stringValues, int64Values, &missingKeys)) {
+        return false;
+    }
+    for (const auto& field : schema) {
+        if (field.required && missingKeys.count(field.key)) {
+            if (missingKey) {
+                *missingKey = field.key;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace jsonUtils
+}  // namespace json
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_JSON_PAYLOAD_DECODER_H_
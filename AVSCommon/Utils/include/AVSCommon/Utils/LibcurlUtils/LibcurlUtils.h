@@ -28,14 +28,22 @@ namespace libcurlUtils {
 /**
  * Prepare a CURL handle to require TLS based upon global configuration settings.
  *
+ * Every handle prepared by this function uses the same libcurl share handle, so TLS sessions and DNS lookups are
+ * cached for the whole process.  A new connection to a host that has been connected to before (for example, when
+ * @c HTTP2Transport reconnects, or when @c LibCurlHttpContentFetcher fetches from the same host) can then resume the
+ * TLS session instead of performing a full handshake, and skip the DNS lookup.
+ *
  * The 'libCurlUtils' sub-component of the global configuration supports the following options:
  * - CURLOPT_CAPATH If present, specifies a value for the libcurl property CURLOPT_CAPATH.
+ * - CURLOPT_DNS_CACHE_TIMEOUT If present, specifies how many seconds resolved host names are cached for (the
+ *   libcurl default is 60; -1 caches them forever).
  *
  * Here is an example configuration:
  * @code
  * {
  *     "libcurlUtils" : {
- *         "CURLOPT_CAPATH" : "/path/to/directory/with/ca/certificates"
+ *         "CURLOPT_CAPATH" : "/path/to/directory/with/ca/certificates",
+ *         "CURLOPT_DNS_CACHE_TIMEOUT" : 300
  *     }
  *     // Other configuration nodes
  * }
@@ -0,0 +1,225 @@
+/*
+ * AsyncLogger.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_ASYNC_LOGGER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_ASYNC_LOGGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * A @c Logger which writes log lines to a file descriptor from a background thread.
+ *
+ * @c emit() copies the entry into a bounded lock-free ring and returns; it only takes a lock to wake the background
+ * thread when the ring is filling up, or for @c ERROR and @c CRITICAL entries.  The background thread formats entries
+ * in batches with @c formatLogString() and writes each batch with a single @c writev().  When the ring is full,
+ * entries are either dropped (and counted, with a note written once space is available) or the caller waits,
+ * depending on the @c OverflowPolicy.
+ *
+ * An @c AsyncLogger may be installed as the sink with @c LoggerSinkManager::changeSinkLogger(), or selected at build
+ * time with @c -DACSDK_LOG_SINK=AsyncConsole, which uses the instance returned by @c getAsyncConsoleLogger().
+ */
+class AsyncLogger : public Logger {
+public:
+    /// What @c emit() does when the ring is full.
+    enum class OverflowPolicy {
+        /// Drop the entry and count it in @c getDroppedCount().
+        DROP,
+        /// Wait for the background thread to make space.
+        BLOCK
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param level The lowest severity level of logs to be emitted by this Logger.
+     * @param fd The file descriptor to write log lines to.  It is not closed by this @c AsyncLogger.
+     * @param capacity The number of entries the ring can hold.  Rounded up to a power of two.
+     * @param overflowPolicy What @c emit() does when the ring is full.
+     */
+    AsyncLogger(Level level, int fd, size_t capacity, OverflowPolicy overflowPolicy);
+
+    /**
+     * Destructor.  Writes the entries remaining in the ring, then stops the background thread.
+     */
+    ~AsyncLogger();
+
+    void emit(Level level, std::chrono::system_clock::time_point time, const char* threadMoniker, const char* text)
+        override;
+
+    /**
+     * Block until every entry emitted before this call has been written.
+     */
+    void flush();
+
+    /**
+     * Get the number of entries which have been dropped because the ring was full.
+     *
+     * @return The number of entries which have been dropped.
+     */
+    uint64_t getDroppedCount() const;
+
+    /**
+     * Get the number of entries which have been written.
+     *
+     * @return The number of entries which have been written.
+     */
+    uint64_t getWrittenCount() const;
+
+private:
+    /// An entry in the ring.
+    struct Record {
+        /// Position in the ring protocol; see @c tryPush() and @c tryPop().
+        std::atomic<size_t> sequence;
+
+        /// The severity level of the entry.
+        Level level;
+
+        /// The time the entry was emitted.
+        std::chrono::system_clock::time_point time;
+
+        /// Moniker of the thread which emitted the entry.  Kept across uses so its capacity is reused.
+        std::string threadMoniker;
+
+        /// The text of the entry.  Kept across uses so its capacity is reused.
+        std::string text;
+
+        /// The capacity of @c threadMoniker and @c text counted in @c m_memoryBytes.  Only used on @c m_thread.
+        size_t countedCapacity;
+    };
+
+    /**
+     * Try to add an entry to the ring.
+     *
+     * @param level The severity Level of the entry.
+     * @param time The time that the event to log occurred.
+     * @param threadMoniker Moniker of the thread that generated the event.
+     * @param text The text of the entry to log.
+     * @param[out] backlog The number of entries in the ring once this entry was added.
+     * @return Whether the entry was added; @c false if the ring is full.
+     */
+    bool tryPush(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* threadMoniker,
+        const char* text,
+        size_t* backlog);
+
+    /**
+     * Try to take the oldest entry from the ring, formatting it into @c line.  Only called on @c m_thread.
+     *
+     * @param[out] line The formatted log line, with a trailing newline.
+     * @return Whether an entry was taken.
+     */
+    bool tryPop(std::string* line);
+
+    /// Wake the background thread.
+    void wake();
+
+    /// The loop run by @c m_thread.
+    void writeLoop();
+
+    /**
+     * Write the lines in @c m_batch with @c writev().
+     *
+     * @param count The number of lines in @c m_batch to write.
+     */
+    void writeBatch(size_t count);
+
+    /// The file descriptor to write log lines to.
+    const int m_fd;
+
+    /// What @c emit() does when the ring is full.
+    const OverflowPolicy m_overflowPolicy;
+
+    /// The ring of entries.  Its size is a power of two.
+    std::unique_ptr<Record[]> m_ring;
+
+    /// @c m_ring size - 1, to map positions to ring indices.
+    const size_t m_mask;
+
+    /// The position the next entry will be pushed at.
+    std::atomic<size_t> m_pushPosition;
+
+    /// The position of the next entry to pop.  Only modified on @c m_thread.
+    std::atomic<size_t> m_popPosition;
+
+    /// The position of the next entry to be written.  Only modified on @c m_thread.
+    std::atomic<size_t> m_writtenPosition;
+
+    /// The number of entries dropped because the ring was full.
+    std::atomic<uint64_t> m_droppedCount;
+
+    /// Whether the background thread is waiting on @c m_wakeTrigger.
+    std::atomic<bool> m_isSleeping;
+
+    /// Serializes waits on @c m_wakeTrigger and @c m_flushed.
+    std::mutex m_mutex;
+
+    /// Notified to wake the background thread.
+    std::condition_variable m_wakeTrigger;
+
+    /// Notified by the background thread after each batch is written.
+    std::condition_variable m_flushed;
+
+    /// Whether the background thread has been asked to wake up.  Guarded by @c m_mutex.
+    bool m_isWakeRequested;
+
+    /// Whether the destructor has been called.  Guarded by @c m_mutex.
+    bool m_isShuttingDown;
+
+    /// The memory of the ring, including the capacity of its strings.  Only modified on @c m_thread once it started.
+    uint64_t m_memoryBytes;
+
+    /// The memory of the ring, as counted in @c MemoryAccounting.  Only modified on @c m_thread once it started.
+    metrics::MemoryAccounting::Allocation m_memory;
+
+    /// Formatted lines waiting to be written.  Only used on @c m_thread; the strings are reused between batches.
+    std::vector<std::string> m_batch;
+
+    /// The thread which formats and writes entries.
+    std::thread m_thread;
+};
+
+/**
+ * Return the singleton @c AsyncLogger which writes to standard output.  It is configured (like @c ConsoleLogger) from
+ * the "consoleLogger" configuration node, and drops entries when its ring is full.
+ *
+ * @return The singleton @c AsyncLogger which writes to standard output.
+ */
+Logger& getAsyncConsoleLogger();
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_ASYNC_LOGGER_H_
@@ -0,0 +1,225 @@
+/*
+ * BinaryLogger.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_BINARY_LOGGER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_BINARY_LOGGER_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * The header at the start of a binary log file.
+ *
+ * The file is laid out as this header, then a dictionary of @c dictionarySize bytes, then a ring of @c ringSize
+ * bytes.  The dictionary holds the source and event names, each stored once as a @c uint16_t length followed by the
+ * name; names are numbered from 1 in the order they were added.  The ring holds records, each a
+ * @c BinaryLogRecordHeader followed by @c monikerLength bytes of thread moniker and then the rest of the log text.
+ * Records never wrap: when a record does not fit before the end of the ring, the space is skipped (with a record of
+ * level @c PADDING_LEVEL if there is room for its header) and the record is written at the start of the ring,
+ * evicting the oldest records.  All values are in host byte order.
+ *
+ * tools/BinaryLogDecoder/BinaryLogDecoder.py converts a binary log file back to the text format of
+ * @c formatLogString().
+ */
+struct BinaryLogFileHeader {
+    /// @c BinaryLogger::MAGIC.
+    char magic[8];
+
+    /// @c BinaryLogger::VERSION.
+    uint32_t version;
+
+    /// The size of a @c BinaryLogRecordHeader, in bytes.
+    uint32_t recordHeaderSize;
+
+    /// The size of the dictionary, in bytes.
+    uint32_t dictionarySize;
+
+    /// The size of the ring, in bytes.
+    uint32_t ringSize;
+
+    /// The number of dictionary bytes in use.
+    uint32_t dictionaryUsed;
+
+    /// The number of names in the dictionary.
+    uint32_t dictionaryCount;
+
+    /// The wall clock time the file was created, in nanoseconds since the epoch.
+    int64_t wallClockAnchor;
+
+    /// The monotonic clock time the file was created, in nanoseconds, for converting record timestamps.
+    int64_t monotonicAnchor;
+
+    /// Position of the oldest record.  Positions only increase; the offset in the ring is the position % @c ringSize.
+    uint64_t begin;
+
+    /// Position just past the newest record.
+    uint64_t end;
+};
+
+/// The header of each record in the ring of a binary log file.
+struct BinaryLogRecordHeader {
+    /// The length of the record, including this header.
+    uint32_t length;
+
+    /**
+     * Dictionary number of the source of the entry.  Zero if the name could not be added to the dictionary, in which
+     * case the text is the whole text of the entry.
+     */
+    uint32_t sourceId;
+
+    /// Dictionary number of the event of the entry, if @c sourceId is not zero.
+    uint32_t eventId;
+
+    /// The @c Level of the entry, or @c PADDING_LEVEL for space skipped at the end of the ring.
+    uint8_t level;
+
+    /// The length of the thread moniker which follows this header.
+    uint8_t monikerLength;
+
+    /// The monotonic clock time of the entry, in nanoseconds.
+    int64_t timestamp;
+};
+
+/**
+ * A @c Logger which writes compact binary records to a memory-mapped ring file.
+ *
+ * Instead of formatting each entry, @c emit() replaces the source and event names at the start of the entry text
+ * with numbers from a dictionary stored in the file, and stores a monotonic timestamp in place of the formatted wall
+ * clock time.  The rest of the text (the metadata and message) is stored as is.  Records are copied into the mapped
+ * file, so there are no system calls per entry, and the kernel writes dirty pages back in bulk.  Because the file is
+ * mapped shared, the entries logged before a crash are still in the file.
+ *
+ * A @c BinaryLogger may be installed as the sink with @c LoggerSinkManager::changeSinkLogger(), or selected at build
+ * time with @c -DACSDK_LOG_SINK=Binary, which uses the instance returned by @c getBinaryLogger().
+ */
+class BinaryLogger : public Logger {
+public:
+    /// The value of @c BinaryLogFileHeader::magic.
+    static const char MAGIC[8];
+
+    /// The version of the file format.
+    static const uint32_t VERSION = 1;
+
+    /// The value of @c BinaryLogRecordHeader::level for space skipped at the end of the ring.
+    static const uint8_t PADDING_LEVEL = 0xff;
+
+    /**
+     * Create a @c BinaryLogger.  An existing file at @c path is renamed to @c path with ".1" appended, so the log of
+     * the previous run is kept.
+     *
+     * @param level The lowest severity level of logs to be emitted by this Logger.
+     * @param path The path of the file to write.
+     * @param ringSize The size of the ring of records, in bytes.
+     * @param dictionarySize The size of the dictionary of source and event names, in bytes.
+     * @return The new @c BinaryLogger, or @c nullptr if the file could not be created.
+     */
+    static std::unique_ptr<BinaryLogger> create(
+        Level level,
+        const std::string& path,
+        size_t ringSize,
+        size_t dictionarySize);
+
+    /**
+     * Destructor.
+     */
+    ~BinaryLogger();
+
+    /// @note The @c time argument is not used; records are stamped with the monotonic clock.
+    void emit(Level level, std::chrono::system_clock::time_point time, const char* threadMoniker, const char* text)
+        override;
+
+private:
+    /// @c getBinaryLogger() applies the configured log level with @c init().
+    friend Logger& getBinaryLogger();
+
+    /**
+     * Constructor.
+     *
+     * @param level The lowest severity level of logs to be emitted by this Logger.
+     * @param fd The open binary log file.
+     * @param mapping The mapping of the file.
+     * @param mappingSize The size of @c mapping, in bytes.
+     */
+    BinaryLogger(Level level, int fd, uint8_t* mapping, size_t mappingSize);
+
+    /**
+     * Get the dictionary number of a name, adding it to the dictionary if it is new.  Called with @c m_mutex held.
+     *
+     * @param name The name.
+     * @param length The length of @c name.
+     * @return The dictionary number of the name, or zero if the dictionary is full.
+     */
+    uint32_t intern(const char* name, size_t length);
+
+    /**
+     * Get the length of the record at a position in the ring.  Called with @c m_mutex held.
+     *
+     * @param position The position of the record.
+     * @return The number of bytes to advance @c position by to reach the next record.
+     */
+    uint64_t recordLengthAt(uint64_t position) const;
+
+    /// The open binary log file.
+    const int m_fd;
+
+    /// The mapping of the file.
+    uint8_t* const m_mapping;
+
+    /// The size of @c m_mapping, in bytes.
+    const size_t m_mappingSize;
+
+    /// The header at the start of @c m_mapping.
+    BinaryLogFileHeader* const m_header;
+
+    /// The dictionary in @c m_mapping.
+    uint8_t* const m_dictionary;
+
+    /// The ring in @c m_mapping.
+    uint8_t* const m_ring;
+
+    /// Serializes access to the file and @c m_names.
+    std::mutex m_mutex;
+
+    /// The dictionary numbers of the names in the dictionary.
+    std::unordered_map<std::string, uint32_t> m_names;
+};
+
+/**
+ * Return the singleton @c BinaryLogger.  It is configured from the "binaryLogger" configuration node: "logLevel"
+ * (as for other loggers), "path", "ringSize" and "dictionarySize".  If the file can not be created, logs are sent to
+ * the @c ConsoleLogger instead.
+ *
+ * @return The singleton @c BinaryLogger.
+ */
+Logger& getBinaryLogger();
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_BINARY_LOGGER_H_
@@ -26,7 +26,8 @@ namespace utils {
 namespace logger {
 
 /**
- * A very simple (e.g. not asynchronous) @c Logger that logs to console.
+ * A very simple (e.g. not asynchronous) @c Logger that logs to console.  See @c AsyncLogger for an asynchronous
+ * alternative.
  */
 class ConsoleLogger : public Logger {
 public:
@@ -0,0 +1,201 @@
+/*
+ * FlightRecorderLogger.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_FLIGHT_RECORDER_LOGGER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_FLIGHT_RECORDER_LOGGER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * A @c Logger which keeps the most recent entries of every level in an in-memory ring, and passes on only the
+ * entries of an output level and above to another @c Logger, so that detailed logs leading up to a failure are
+ * available without paying for writing them out all the time.
+ *
+ * @c emit() claims a slot of the ring with a single atomic increment and copies the entry into it, truncated to a
+ * fixed size, with no locks and no allocation.  Each slot carries a sequence number, so a dump skips slots which are
+ * being written.  The ring is written out with @c dump(), which is async-signal-safe, or with @c trigger(), which
+ * writes out the entries added since the last trigger.  @c trigger() is called by the SDK on events which usually
+ * follow a failure, such as sending an @c ExceptionEncountered event or an @c ExpectSpeech timeout, and
+ * @c installCrashHandler() dumps the ring when the process receives a fatal signal.
+ *
+ * Entries below @c INFO are only logged by builds with @c ACSDK_DEBUG_LOG_ENABLED.  A @c FlightRecorderLogger may be
+ * installed as the sink with @c LoggerSinkManager::changeSinkLogger(), or selected at build time with
+ * @c -DACSDK_LOG_SINK=FlightRecorder, which uses the instance returned by @c getFlightRecorderLogger().
+ */
+class FlightRecorderLogger : public Logger {
+public:
+    /// The number of bytes of the text of an entry which are kept.
+    static const size_t TEXT_SIZE = 224;
+
+    /// The number of bytes of the thread moniker of an entry which are kept.
+    static const size_t MONIKER_SIZE = 12;
+
+    /**
+     * Create a @c FlightRecorderLogger.
+     *
+     * @param level The lowest severity level of logs to be kept in the ring.
+     * @param capacity The number of entries the ring can hold.  Rounded up to a power of two.
+     * @param output The @c Logger to pass entries on to, or @c nullptr to pass on none.  It must outlive this object.
+     * @param outputLevel The lowest severity level of logs to be passed on to @c output.
+     * @param dumpFd The file descriptor @c trigger() and the crash handler write the ring to.  It is not closed by
+     * this @c FlightRecorderLogger.
+     * @return The new @c FlightRecorderLogger, or @c nullptr if the capacity is zero.
+     */
+    static std::unique_ptr<FlightRecorderLogger> create(
+        Level level,
+        size_t capacity,
+        Logger* output,
+        Level outputLevel,
+        int dumpFd);
+
+    /**
+     * Destructor.  If this is the active recorder, there is no active recorder any more.
+     */
+    ~FlightRecorderLogger();
+
+    void emit(Level level, std::chrono::system_clock::time_point time, const char* threadMoniker, const char* text)
+        override;
+
+    /**
+     * Write the entries in the ring, oldest first, one line each.  This is async-signal-safe.
+     *
+     * @param fd The file descriptor to write to.
+     * @return The number of entries written.
+     */
+    size_t dump(int fd) const;
+
+    /**
+     * Make this the recorder which @c trigger() and the crash handler dump.
+     */
+    void activate();
+
+    /**
+     * Write the entries added to the active recorder since the last trigger to its dump file descriptor, after a
+     * line naming the reason.  Does nothing if there is no active recorder.
+     *
+     * @param reason Why the entries are dumped.
+     */
+    static void trigger(const char* reason);
+
+    /**
+     * Install handlers of @c SIGSEGV, @c SIGBUS, @c SIGILL, @c SIGFPE and @c SIGABRT which dump the active recorder
+     * to its dump file descriptor, and then let the signal take its default action.
+     */
+    static void installCrashHandler();
+
+private:
+    /// @c getFlightRecorderLogger() applies the configured log level with @c init().
+    friend Logger& getFlightRecorderLogger();
+
+    /// A slot of the ring.
+    struct Record {
+        /// 2 * position + 1 while the entry at @c position is written, 2 * position + 2 once it is complete.
+        std::atomic<uint64_t> sequence;
+
+        /// The time of the entry, in milliseconds since the epoch.
+        int64_t timestamp;
+
+        /// The @c Level of the entry.
+        uint8_t level;
+
+        /// The length of @c moniker.
+        uint8_t monikerLength;
+
+        /// The length of @c text.
+        uint16_t textLength;
+
+        /// The start of the thread moniker of the entry.
+        char moniker[MONIKER_SIZE];
+
+        /// The start of the text of the entry.
+        char text[TEXT_SIZE];
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param level The lowest severity level of logs to be kept in the ring.
+     * @param capacity The number of entries the ring can hold, a power of two.
+     * @param output The @c Logger to pass entries on to, or @c nullptr.
+     * @param outputLevel The lowest severity level of logs to be passed on to @c output.
+     * @param dumpFd The file descriptor @c trigger() and the crash handler write the ring to.
+     */
+    FlightRecorderLogger(Level level, size_t capacity, Logger* output, Level outputLevel, int dumpFd);
+
+    /**
+     * Write the complete entries between two positions which are still in the ring, oldest first, one line each.
+     * This is async-signal-safe.
+     *
+     * @param fd The file descriptor to write to.
+     * @param from The position of the first entry to write.
+     * @param to The position after the last entry to write.
+     * @return The number of entries written.
+     */
+    size_t dumpRange(int fd, uint64_t from, uint64_t to) const;
+
+    /**
+     * The handler installed by @c installCrashHandler().
+     *
+     * @param signalNumber The signal received.
+     */
+    static void handleCrashSignal(int signalNumber);
+
+    /// The ring of entries.  Its size is a power of two.
+    std::unique_ptr<Record[]> m_ring;
+
+    /// @c m_ring size - 1, to map positions to ring indices.
+    const uint64_t m_mask;
+
+    /// The position the next entry will be written at.
+    std::atomic<uint64_t> m_nextPosition;
+
+    /// The position of the first entry @c trigger() has not written out yet.
+    std::atomic<uint64_t> m_triggerPosition;
+
+    /// The @c Logger to pass entries on to, or @c nullptr.
+    Logger* const m_output;
+
+    /// The lowest severity level of logs to be passed on to @c m_output.
+    const Level m_outputLevel;
+
+    /// The file descriptor @c trigger() and the crash handler write the ring to.
+    const int m_dumpFd;
+};
+
+/**
+ * Return the singleton instance of @c FlightRecorderLogger, which passes entries of the configured output level
+ * (@c WARN by default) and above on to @c getConsoleLogger(), dumps to @c stderr, and is the active recorder.
+ *
+ * @return The singleton instance of @c FlightRecorderLogger.
+ */
+Logger& getFlightRecorderLogger();
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_FLIGHT_RECORDER_LOGGER_H_
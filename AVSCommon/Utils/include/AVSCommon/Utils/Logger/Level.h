@@ -26,7 +26,8 @@ namespace utils {
 namespace logger {
 
 /**
- * Enum used to specify the severity assigned to a log message.
+ * Enum used to specify the severity assigned to a log message.  Log lines below the @c ACSDK_MIN_LOG_LEVEL build
+ * option are compiled out; the order of these values must match the @c ACSDK_LOG_LEVEL_<LEVEL> values in Logger.h.
  */
 enum class Level {
     /// Most verbose debug log level. Compiled out when ACSDK_DEBUG_LOG_ENABLED is not defined.
@@ -0,0 +1,100 @@
+/*
+ * LogRateLimiter.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_LOG_RATE_LIMITER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_LOG_RATE_LIMITER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * Decides which occurrences of a log line are logged, for log lines in loops which would otherwise flood the log.
+ * Each call site of the @c ACSDK_<LEVEL>_EVERY_N and @c ACSDK_<LEVEL>_RATE_LIMITED macros has its own
+ * @c LogRateLimiter, and the entries it lets through report how many occurrences were suppressed before them.
+ *
+ * Occurrences are only counted once the level of the line is enabled, so a disabled line costs what any other
+ * disabled line does.  This class is lock-free and thread-safe.
+ */
+class LogRateLimiter {
+public:
+    /**
+     * Constructor.
+     */
+    LogRateLimiter();
+
+    /**
+     * Count an occurrence, and decide whether it is one of every @c n, starting with the first.
+     *
+     * @param n How many occurrences there are per occurrence logged.  Zero or one logs every occurrence.
+     * @param[out] suppressed The number of occurrences suppressed since the last one logged, if this one is logged.
+     * @return Whether to log this occurrence.
+     */
+    bool admitEveryN(uint64_t n, uint64_t* suppressed);
+
+    /**
+     * Count an occurrence, and decide whether to log it, which is if none was logged in the last @c interval.
+     *
+     * @param interval The least time between the occurrences logged.
+     * @param[out] suppressed The number of occurrences suppressed since the last one logged, if this one is logged.
+     * @return Whether to log this occurrence.
+     */
+    bool admitAtInterval(std::chrono::milliseconds interval, uint64_t* suppressed);
+
+    /**
+     * Add the number of suppressed occurrences to an entry, if there were any.
+     *
+     * @param entry The entry.
+     * @param suppressed The number of suppressed occurrences.
+     * @return @c entry.
+     */
+    template <typename LogEntryType>
+    static LogEntryType& addSuppressedCount(LogEntryType&& entry, uint64_t suppressed);
+
+private:
+    /// The number of occurrences counted by @c admitEveryN().
+    std::atomic<uint64_t> m_count;
+
+    /// The number of occurrences suppressed by @c admitAtInterval() since the last one logged.
+    std::atomic<uint64_t> m_suppressed;
+
+    /**
+     * The time the last occurrence was logged by @c admitAtInterval(), in nanoseconds of the steady clock, or
+     * @c NEVER_LOGGED.
+     */
+    std::atomic<int64_t> m_lastLoggedTime;
+};
+
+template <typename LogEntryType>
+LogEntryType& LogRateLimiter::addSuppressedCount(LogEntryType&& entry, uint64_t suppressed) {
+    if (suppressed > 0) {
+        entry.d("suppressed", suppressed);
+    }
+    return entry;
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_LOG_RATE_LIMITER_H_
@@ -29,6 +29,7 @@
 #include "AVSCommon/Utils/Logger/Level.h"
 #include "AVSCommon/Utils/Logger/LogEntry.h"
 #include "AVSCommon/Utils/Logger/LogLevelObserverInterface.h"
+#include "AVSCommon/Utils/Logger/LogRateLimiter.h"
 #include "AVSCommon/Utils/Logger/SinkObserverInterface.h"
 
 /**
@@ -325,8 +326,92 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
         }                                                                                             \
     } while (false)
 
-#ifdef ACSDK_DEBUG_LOG_ENABLED
+/**
+ * Common implementation for sending one in every @c n occurrences of a log line to the log, starting with the first.
+ * Each call site counts its own occurrences, and the entries which are sent say how many were suppressed before them.
+ *
+ * @param level The log level to associate with the log line.
+ * @param n How many occurrences there are per occurrence sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_LOG_EVERY_N(level, n, entry)                                                            \
+    do {                                                                                              \
+        auto& loggerInstance = alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_LOGGER_FUNCTION(); \
+        if (loggerInstance.shouldLog(level)) {                                                        \
+            static alexaClientSDK::avsCommon::utils::logger::LogRateLimiter rateLimiter;              \
+            uint64_t suppressedCount = 0;                                                             \
+            if (rateLimiter.admitEveryN(n, &suppressedCount)) {                                       \
+                loggerInstance.log(                                                                   \
+                    level,                                                                            \
+                    alexaClientSDK::avsCommon::utils::logger::LogRateLimiter::addSuppressedCount(     \
+                        entry, suppressedCount));                                                     \
+            }                                                                                         \
+        }                                                                                             \
+    } while (false)
+
+/**
+ * Common implementation for sending at most one occurrence of a log line per @c interval to the log.  Each call site
+ * has its own interval, and the entries which are sent say how many occurrences were suppressed before them.
+ *
+ * @param level The log level to associate with the log line.
+ * @param interval The least time between the occurrences sent to the log, as a @c std::chrono::duration.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_LOG_RATE_LIMITED(level, interval, entry)                                                \
+    do {                                                                                              \
+        auto& loggerInstance = alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_LOGGER_FUNCTION(); \
+        if (loggerInstance.shouldLog(level)) {                                                        \
+            static alexaClientSDK::avsCommon::utils::logger::LogRateLimiter rateLimiter;              \
+            uint64_t suppressedCount = 0;                                                             \
+            auto minimumInterval = std::chrono::duration_cast<std::chrono::milliseconds>(interval);   \
+            if (rateLimiter.admitAtInterval(minimumInterval, &suppressedCount)) {                     \
+                loggerInstance.log(                                                                   \
+                    level,                                                                            \
+                    alexaClientSDK::avsCommon::utils::logger::LogRateLimiter::addSuppressedCount(     \
+                        entry, suppressedCount));                                                     \
+            }                                                                                         \
+        }                                                                                             \
+    } while (false)
 
+/**
+ * Numeric values of the log levels, for comparison with @c ACSDK_MIN_LOG_LEVEL in preprocessor conditionals.  These
+ * must be kept in the same order as the @c Level enum.
+ */
+#define ACSDK_LOG_LEVEL_DEBUG9 0
+#define ACSDK_LOG_LEVEL_DEBUG8 1
+#define ACSDK_LOG_LEVEL_DEBUG7 2
+#define ACSDK_LOG_LEVEL_DEBUG6 3
+#define ACSDK_LOG_LEVEL_DEBUG5 4
+#define ACSDK_LOG_LEVEL_DEBUG4 5
+#define ACSDK_LOG_LEVEL_DEBUG3 6
+#define ACSDK_LOG_LEVEL_DEBUG2 7
+#define ACSDK_LOG_LEVEL_DEBUG1 8
+#define ACSDK_LOG_LEVEL_DEBUG0 9
+#define ACSDK_LOG_LEVEL_INFO 10
+#define ACSDK_LOG_LEVEL_WARN 11
+#define ACSDK_LOG_LEVEL_ERROR 12
+#define ACSDK_LOG_LEVEL_CRITICAL 13
+#define ACSDK_LOG_LEVEL_NONE 14
+
+/*
+ * The lowest severity level of log lines compiled into the build.  @c ACSDK_<LEVEL> macros below this level expand
+ * to nothing, so neither the @c LogEntry nor the values passed to it are ever evaluated.  It is set (as one of the
+ * @c ACSDK_LOG_LEVEL_<LEVEL> values) by the @c ACSDK_MIN_LOG_LEVEL option in build/cmake/Logger.cmake.  Debug levels
+ * are always compiled out when @c ACSDK_DEBUG_LOG_ENABLED is not defined.
+ */
+#ifndef ACSDK_MIN_LOG_LEVEL
+#define ACSDK_MIN_LOG_LEVEL ACSDK_LOG_LEVEL_DEBUG9
+#endif
+
+#if !defined(ACSDK_DEBUG_LOG_ENABLED) && ACSDK_MIN_LOG_LEVEL < ACSDK_LOG_LEVEL_INFO
+/// The lowest severity level of log lines which are compiled in.
+#define ACSDK_COMPILED_LOG_LEVEL ACSDK_LOG_LEVEL_INFO
+#else
+/// The lowest severity level of log lines which are compiled in.
+#define ACSDK_COMPILED_LOG_LEVEL ACSDK_MIN_LOG_LEVEL
+#endif
+
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG9
 /**
  * Send a DEBUG9 severity log line.
  *
@@ -334,7 +419,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG9(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG9, entry)
+#else
+/**
+ * Compile out a DEBUG9 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG9(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG8
 /**
  * Send a DEBUG8 severity log line.
  *
@@ -342,7 +436,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG8(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG8, entry)
+#else
+/**
+ * Compile out a DEBUG8 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG8(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG7
 /**
  * Send a DEBUG7 severity log line.
  *
@@ -350,7 +453,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG7(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG7, entry)
+#else
+/**
+ * Compile out a DEBUG7 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG7(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG6
 /**
  * Send a DEBUG6 severity log line.
  *
@@ -358,7 +470,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG6(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG6, entry)
+#else
+/**
+ * Compile out a DEBUG6 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG6(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG5
 /**
  * Send a DEBUG5 severity log line.
  *
@@ -366,7 +487,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG5(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG5, entry)
+#else
+/**
+ * Compile out a DEBUG5 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG5(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG4
 /**
  * Send a DEBUG4 severity log line.
  *
@@ -374,7 +504,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG4(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG4, entry)
+#else
+/**
+ * Compile out a DEBUG4 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG4(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG3
 /**
  * Send a DEBUG3 severity log line.
  *
@@ -382,7 +521,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG3(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG3, entry)
+#else
+/**
+ * Compile out a DEBUG3 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG3(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG2
 /**
  * Send a DEBUG2 severity log line.
  *
@@ -390,7 +538,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG2(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG2, entry)
+#else
+/**
+ * Compile out a DEBUG2 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG2(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG1
 /**
  * Send a DEBUG1 severity log line.
  *
@@ -398,7 +555,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG1(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG1, entry)
+#else
+/**
+ * Compile out a DEBUG1 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG1(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG0
 /**
  * Send a DEBUG0 severity log line.
  *
@@ -406,7 +572,16 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG0(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG0, entry)
+#else
+/**
+ * Compile out a DEBUG0 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG0(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG0
 /**
  * Send a log line at the default debug level (DEBUG0).
  *
@@ -414,128 +589,261 @@ inline Logger& ACSDK_GET_LOGGER_FUNCTION() {
  * @param entry The text (or builder of the text) for the log entry.
  */
 #define ACSDK_DEBUG(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG0, entry)
+#else
+/**
+ * Compile out a DEBUG0 severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG(entry)
+#endif
 
-#else  // ACSDK_DEBUG_LOG_ENABLED
-
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_INFO
 /**
- * Compile out a DEBUG9 severity log line.
+ * Send a INFO severity log line.
  *
  * @param loggerArg The Logger to send the line to.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG9(entry)
+#define ACSDK_INFO(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::INFO, entry)
+#else
+/**
+ * Compile out a INFO severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_INFO(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_WARN
 /**
- * Compile out a DEBUG8 severity log line.
+ * Send a WARN severity log line.
  *
  * @param loggerArg The Logger to send the line to.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG8(entry)
+#define ACSDK_WARN(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::WARN, entry)
+#else
+/**
+ * Compile out a WARN severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_WARN(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_ERROR
 /**
- * Compile out a DEBUG7 severity log line.
+ * Send a ERROR severity log line.
  *
  * @param loggerArg The Logger to send the line to.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG7(entry)
+#define ACSDK_ERROR(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::ERROR, entry)
+#else
+/**
+ * Compile out a ERROR severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_ERROR(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_CRITICAL
 /**
- * Compile out a DEBUG6 severity log line.
+ * Send a CRITICAL severity log line.
  *
  * @param loggerArg The Logger to send the line to.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG6(entry)
+#define ACSDK_CRITICAL(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::CRITICAL, entry)
+#else
+/**
+ * Compile out a CRITICAL severity log line.
+ *
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_CRITICAL(entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG9
 /**
- * Compile out a DEBUG5 severity log line.
+ * Send one in every @c n occurrences of a DEBUG9 severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param n How many occurrences there are per occurrence sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG5(entry)
+#define ACSDK_DEBUG9_EVERY_N(n, entry) \
+    ACSDK_LOG_EVERY_N(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG9, n, entry)
 
 /**
- * Compile out a DEBUG4 severity log line.
+ * Send at most one occurrence of a DEBUG9 severity log line per @c interval.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param interval The least time between the occurrences sent to the log, as a @c std::chrono::duration.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG4(entry)
+#define ACSDK_DEBUG9_RATE_LIMITED(interval, entry) \
+    ACSDK_LOG_RATE_LIMITED(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG9, interval, entry)
+#else
+/**
+ * Compile out a sampled DEBUG9 severity log line.
+ *
+ * @param n How many occurrences there are per occurrence sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG9_EVERY_N(n, entry)
 
 /**
- * Compile out a DEBUG3 severity log line.
+ * Compile out a rate limited DEBUG9 severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param interval The least time between the occurrences sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG3(entry)
+#define ACSDK_DEBUG9_RATE_LIMITED(interval, entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_DEBUG0
 /**
- * Compile out a DEBUG2 severity log line.
+ * Send one in every @c n occurrences of a DEBUG0 severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param n How many occurrences there are per occurrence sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG2(entry)
+#define ACSDK_DEBUG_EVERY_N(n, entry) \
+    ACSDK_LOG_EVERY_N(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG0, n, entry)
 
 /**
- * Compile out a DEBUG1 severity log line.
+ * Send at most one occurrence of a DEBUG0 severity log line per @c interval.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param interval The least time between the occurrences sent to the log, as a @c std::chrono::duration.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG1(entry)
+#define ACSDK_DEBUG_RATE_LIMITED(interval, entry) \
+    ACSDK_LOG_RATE_LIMITED(alexaClientSDK::avsCommon::utils::logger::Level::DEBUG0, interval, entry)
+#else
+/**
+ * Compile out a sampled DEBUG0 severity log line.
+ *
+ * @param n How many occurrences there are per occurrence sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_DEBUG_EVERY_N(n, entry)
 
 /**
- * Compile out a DEBUG0 severity log line.
+ * Compile out a rate limited DEBUG0 severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param interval The least time between the occurrences sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG0(entry)
+#define ACSDK_DEBUG_RATE_LIMITED(interval, entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_INFO
 /**
- * Compile out a DEBUG severity log line.
+ * Send one in every @c n occurrences of a INFO severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param n How many occurrences there are per occurrence sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_DEBUG(entry)
+#define ACSDK_INFO_EVERY_N(n, entry) \
+    ACSDK_LOG_EVERY_N(alexaClientSDK::avsCommon::utils::logger::Level::INFO, n, entry)
 
-#endif  // ACSDK_DEBUG_LOG_ENABLED
+/**
+ * Send at most one occurrence of a INFO severity log line per @c interval.
+ *
+ * @param interval The least time between the occurrences sent to the log, as a @c std::chrono::duration.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_INFO_RATE_LIMITED(interval, entry) \
+    ACSDK_LOG_RATE_LIMITED(alexaClientSDK::avsCommon::utils::logger::Level::INFO, interval, entry)
+#else
+/**
+ * Compile out a sampled INFO severity log line.
+ *
+ * @param n How many occurrences there are per occurrence sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_INFO_EVERY_N(n, entry)
 
 /**
- * Send a INFO severity log line.
+ * Compile out a rate limited INFO severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param interval The least time between the occurrences sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_INFO(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::INFO, entry)
+#define ACSDK_INFO_RATE_LIMITED(interval, entry)
+#endif
 
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_WARN
 /**
- * Send a WARN severity log line.
+ * Send one in every @c n occurrences of a WARN severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param n How many occurrences there are per occurrence sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_WARN(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::WARN, entry)
+#define ACSDK_WARN_EVERY_N(n, entry) \
+    ACSDK_LOG_EVERY_N(alexaClientSDK::avsCommon::utils::logger::Level::WARN, n, entry)
 
 /**
- * Send a ERROR severity log line.
+ * Send at most one occurrence of a WARN severity log line per @c interval.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param interval The least time between the occurrences sent to the log, as a @c std::chrono::duration.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_ERROR(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::ERROR, entry)
+#define ACSDK_WARN_RATE_LIMITED(interval, entry) \
+    ACSDK_LOG_RATE_LIMITED(alexaClientSDK::avsCommon::utils::logger::Level::WARN, interval, entry)
+#else
 /**
- * Send a CRITICAL severity log line.
+ * Compile out a sampled WARN severity log line.
  *
- * @param loggerArg The Logger to send the line to.
+ * @param n How many occurrences there are per occurrence sent to the log.
  * @param entry The text (or builder of the text) for the log entry.
  */
-#define ACSDK_CRITICAL(entry) ACSDK_LOG(alexaClientSDK::avsCommon::utils::logger::Level::CRITICAL, entry)
+#define ACSDK_WARN_EVERY_N(n, entry)
+
+/**
+ * Compile out a rate limited WARN severity log line.
+ *
+ * @param interval The least time between the occurrences sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_WARN_RATE_LIMITED(interval, entry)
+#endif
+
+#if ACSDK_COMPILED_LOG_LEVEL <= ACSDK_LOG_LEVEL_ERROR
+/**
+ * Send one in every @c n occurrences of a ERROR severity log line.
+ *
+ * @param n How many occurrences there are per occurrence sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_ERROR_EVERY_N(n, entry) \
+    ACSDK_LOG_EVERY_N(alexaClientSDK::avsCommon::utils::logger::Level::ERROR, n, entry)
+
+/**
+ * Send at most one occurrence of a ERROR severity log line per @c interval.
+ *
+ * @param interval The least time between the occurrences sent to the log, as a @c std::chrono::duration.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_ERROR_RATE_LIMITED(interval, entry) \
+    ACSDK_LOG_RATE_LIMITED(alexaClientSDK::avsCommon::utils::logger::Level::ERROR, interval, entry)
+#else
+/**
+ * Compile out a sampled ERROR severity log line.
+ *
+ * @param n How many occurrences there are per occurrence sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_ERROR_EVERY_N(n, entry)
+
+/**
+ * Compile out a rate limited ERROR severity log line.
+ *
+ * @param interval The least time between the occurrences sent to the log.
+ * @param entry The text (or builder of the text) for the log entry.
+ */
+#define ACSDK_ERROR_RATE_LIMITED(interval, entry)
+#endif
 
 #endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_LOGGER_LOGGER_H_
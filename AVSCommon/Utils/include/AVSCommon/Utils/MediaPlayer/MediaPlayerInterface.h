@@ -20,8 +20,11 @@
 
 #include <chrono>
 #include <cstdint>
+#include <fstream>
+#include <functional>
 #include <future>
 #include <memory>
+#include <string>
 
 #include "AVSCommon/AVS/Attachment/AttachmentReader.h"
 #include "MediaPlayerObserverInterface.h"
@@ -48,11 +51,33 @@ enum class MediaPlayerStatus {
 /// Represents offset returned when MediaPlayer is in an invalid state.
 static const std::chrono::milliseconds MEDIA_PLAYER_INVALID_OFFSET{-1};
 
+/**
+ * The format of the audio of a source, when it is known before the source is set.
+ */
+enum class SourceFormat {
+    /// The format is found from the audio itself.
+    UNKNOWN,
+
+    /// MPEG-1 audio, such as the MP3 audio of speech.
+    MPEG
+};
+
 /**
  * A MediaPlayer allows for sourcing, playback control, navigation, and querying the state of media content.
+ *
+ * Each control function has a variant ending in @c Async which returns without waiting for the player, and passes the
+ * status the blocking function would have returned to a callback.  The default implementations of these call the
+ * blocking functions, so a player only overrides them if its operations can take long, such as while a pipeline
+ * changes state.
  */
 class MediaPlayerInterface {
 public:
+    /**
+     * A callback passed the status of an operation requested with one of the @c Async functions.  It may be called on
+     * the thread of the player, so it must not block or call the blocking functions of the player.
+     */
+    using StatusCallback = std::function<void(MediaPlayerStatus)>;
+
     /**
      * Destructor.
      */
@@ -72,6 +97,21 @@ public:
     virtual MediaPlayerStatus setSource(
         std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader) = 0;
 
+    /**
+     * Set the source to play, declaring the format of its audio.  A player may then decode the audio without first
+     * finding its format, so that it starts playing sooner.  By default the format is ignored.
+     *
+     * @param attachmentReader Object with which to read an incoming audio attachment.
+     * @param format The format of the audio of the attachment.
+     *
+     * @return @c SUCCESS if the source was set successfully else @c FAILURE, as with @c setSource(attachmentReader).
+     */
+    virtual MediaPlayerStatus setSource(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        SourceFormat format) {
+        return setSource(std::move(attachmentReader));
+    }
+
     /**
      * Set the source to play. The source should be set before issuing @c play or @c stop.
      *
@@ -99,6 +139,26 @@ public:
      */
     virtual MediaPlayerStatus setSource(std::shared_ptr<std::istream> stream, bool repeat) = 0;
 
+    /**
+     * Set a local file as the source to play. The source should be set before issuing @c play or @c stop.
+     *
+     * A player may map the file rather than read it, so that it is not copied or read again as it repeats.  By
+     * default the file is read through an @c std::ifstream passed to @c setSource(stream, repeat).
+     *
+     * @param path The path of the file.
+     * @param repeat Whether the file should be played in a loop until stopped.
+     *
+     * @return @c SUCCESS if the the source was set successfully else @c FAILURE, including if the file could not be
+     * opened.
+     */
+    virtual MediaPlayerStatus setFileSource(const std::string& path, bool repeat) {
+        auto stream = std::make_shared<std::ifstream>(path, std::ios::binary);
+        if (!stream->good()) {
+            return MediaPlayerStatus::FAILURE;
+        }
+        return setSource(stream, repeat);
+    }
+
     /**
      * Set the offset for playback. A seek will be performed to the offset at the next @c play() command.
      *
@@ -114,6 +174,29 @@ public:
         return MediaPlayerStatus::FAILURE;
     }
 
+    /**
+     * Set the volume of playback.  Unlike @c pause(), this takes effect at once, without a state transition, so that
+     * it can be used to duck audio under another channel.  The volume lasts until changed, across sources.
+     *
+     * @param volume The volume, from 0.0 (silent) to 1.0 (the volume of the source).
+     *
+     * @return @c SUCCESS if the volume was set, and FAILURE for any error or if volume control is not supported.
+     */
+    virtual MediaPlayerStatus setVolume(double volume) {
+        return MediaPlayerStatus::FAILURE;
+    }
+
+    /**
+     * Attenuate the output at once, so that the device stops talking over a user who has barged in, ahead of the
+     * focus change which then stops, pauses or ducks the playback.  Unlike the other functions, this does not wait for
+     * the player, so it may be called on the thread which detected the wake word.  The attenuation lasts until the
+     * volume is set or playback is started or resumed.
+     *
+     * By default this does nothing.
+     */
+    virtual void attenuateForBargeIn() {
+    }
+
     /**
      * Start playing audio. The source should be set before issuing @c play. If @c play is called without
      * setting source, it will return an error. If @c play is called when audio is already playing,
@@ -171,6 +254,101 @@ public:
      */
     virtual std::chrono::milliseconds getOffset() = 0;
 
+    /**
+     * Set the source to play, like @c setSource(), without waiting for it to be set.
+     *
+     * @param attachmentReader Object with which to read an incoming audio attachment.
+     * @param onCompleted The callback to pass the status to once the source is set, or @c nullptr.
+     */
+    virtual void setSourceAsync(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        StatusCallback onCompleted = nullptr) {
+        auto status = setSource(std::move(attachmentReader));
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    /**
+     * Set the source to play, like @c setSource(), without waiting for it to be set.  Unlike the other operations,
+     * setting a url source may complete after operations requested later have started, so @c playAsync() should be
+     * called from @c onCompleted.
+     *
+     * @param url The url to set as the source.
+     * @param onCompleted The callback to pass the status to once the source is set, or @c nullptr.
+     */
+    virtual void setSourceAsync(const std::string& url, StatusCallback onCompleted = nullptr) {
+        auto status = setSource(url);
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    /**
+     * Set the source to play, like @c setSource(), without waiting for it to be set.
+     *
+     * @param stream Object with which to read an incoming audio stream.
+     * @param repeat Whether the audio stream should be played in a loop until stopped.
+     * @param onCompleted The callback to pass the status to once the source is set, or @c nullptr.
+     */
+    virtual void setSourceAsync(
+        std::shared_ptr<std::istream> stream,
+        bool repeat,
+        StatusCallback onCompleted = nullptr) {
+        auto status = setSource(std::move(stream), repeat);
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    /**
+     * Start playing audio, like @c play(), without waiting for the state transition to be requested.
+     *
+     * @param onCompleted The callback to pass the status to, or @c nullptr.
+     */
+    virtual void playAsync(StatusCallback onCompleted = nullptr) {
+        auto status = play();
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    /**
+     * Stop playing audio, like @c stop(), without waiting for the state transition to be requested.
+     *
+     * @param onCompleted The callback to pass the status to, or @c nullptr.
+     */
+    virtual void stopAsync(StatusCallback onCompleted = nullptr) {
+        auto status = stop();
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    /**
+     * Pause playing audio, like @c pause(), without waiting for the state transition to be requested.
+     *
+     * @param onCompleted The callback to pass the status to, or @c nullptr.
+     */
+    virtual void pauseAsync(StatusCallback onCompleted = nullptr) {
+        auto status = pause();
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
+    /**
+     * Resume playing paused audio, like @c resume(), without waiting for the state transition to be requested.
+     *
+     * @param onCompleted The callback to pass the status to, or @c nullptr.
+     */
+    virtual void resumeAsync(StatusCallback onCompleted = nullptr) {
+        auto status = resume();
+        if (onCompleted) {
+            onCompleted(status);
+        }
+    }
+
     /**
      * Sets an observer to be notified when playback state changes.
      *
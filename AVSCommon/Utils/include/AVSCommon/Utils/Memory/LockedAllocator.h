@@ -0,0 +1,271 @@
+/*
+ * LockedAllocator.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_MEMORY_LOCKED_ALLOCATOR_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_MEMORY_LOCKED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace memory {
+
+/**
+ * How the memory of a @c LockedAllocator is obtained.  With none of the options set, it is plain heap memory.
+ *
+ * Memory is faulted in when it is first touched, and may be paged out again under memory pressure.  On the audio
+ * path either costs a page fault at a time a reader or writer cannot afford it, so buffers which must never stall
+ * can be pre-faulted and locked into RAM instead.  Locking is limited by @c RLIMIT_MEMLOCK; when it fails, the memory
+ * is still allocated, a warning is logged and the failure is counted in @c LockedMemoryGauges.
+ */
+struct LockedMemoryOptions {
+    /**
+     * Constructor.
+     *
+     * @param prefault Whether every page is touched when the memory is allocated.
+     * @param lock Whether the memory is locked into RAM.
+     * @param hugePages Whether huge pages are used for the memory, if the system has any free.
+     */
+    LockedMemoryOptions(bool prefault = false, bool lock = false, bool hugePages = false);
+
+    /**
+     * Get whether none of the options are set.
+     *
+     * @return Whether the memory is plain heap memory.
+     */
+    bool isPlain() const;
+
+    /**
+     * Get the options used by a default-constructed @c LockedAllocator.
+     *
+     * @return The options set with @c setDefault(), or plain heap memory if none were set.
+     */
+    static LockedMemoryOptions getDefault();
+
+    /**
+     * Set the options used by @c LockedAllocators constructed after this call without options of their own.
+     *
+     * @param options The options.
+     */
+    static void setDefault(const LockedMemoryOptions& options);
+
+    /// Whether every page is touched when the memory is allocated, so that it is never faulted in later.
+    bool prefault;
+
+    /// Whether the memory is locked into RAM with @c mlock(), so that it is never paged out.
+    bool lock;
+
+    /// Whether huge pages are used for the memory, falling back to transparent huge pages, then normal pages.
+    bool hugePages;
+};
+
+/**
+ * Compare two @c LockedMemoryOptions.
+ *
+ * @param lhs The options on the left.
+ * @param rhs The options on the right.
+ * @return Whether all of the options are the same.
+ */
+bool operator==(const LockedMemoryOptions& lhs, const LockedMemoryOptions& rhs);
+
+/**
+ * Compare two @c LockedMemoryOptions.
+ *
+ * @param lhs The options on the left.
+ * @param rhs The options on the right.
+ * @return Whether any of the options differ.
+ */
+bool operator!=(const LockedMemoryOptions& lhs, const LockedMemoryOptions& rhs);
+
+/// The totals of the memory allocated with options other than plain heap memory.
+struct LockedMemoryGauges {
+    /// The bytes currently mapped, including the rounding up to whole pages.
+    uint64_t mappedBytes;
+
+    /// The bytes currently locked into RAM.
+    uint64_t lockedBytes;
+
+    /// The bytes currently backed by huge pages.
+    uint64_t hugePageBytes;
+
+    /// The number of allocations whose memory could not be locked.
+    uint64_t lockFailures;
+
+    /// The number of allocations which asked for huge pages, and fell back to normal pages.
+    uint64_t hugePageFallbacks;
+};
+
+/**
+ * Allocate memory.
+ *
+ * @param bytes The number of bytes to allocate.
+ * @param options How to obtain the memory.
+ * @return The memory, aligned to at least @c alignof(std::max_align_t).
+ * @throw std::bad_alloc If the memory could not be allocated.
+ */
+void* allocateLockedMemory(size_t bytes, const LockedMemoryOptions& options);
+
+/**
+ * Free memory allocated with @c allocateLockedMemory().
+ *
+ * @param memory The memory.
+ * @param bytes The number of bytes it was allocated with.
+ * @param options The options it was allocated with.
+ */
+void deallocateLockedMemory(void* memory, size_t bytes, const LockedMemoryOptions& options);
+
+/**
+ * Get the totals of the memory allocated with options other than plain heap memory.
+ *
+ * @return The gauges.
+ */
+LockedMemoryGauges getLockedMemoryGauges();
+
+/**
+ * A standard allocator which obtains its memory as described by a @c LockedMemoryOptions.  It is the allocator of the
+ * buffers of @c InProcessSDS, so any stream can be given a locked, pre-faulted buffer:
+ *
+ * @code
+ * LockedMemoryOptions options(true, true);
+ * auto buffer = std::make_shared<InProcessSDS::Buffer>(size, 0, LockedAllocator<uint8_t>(options));
+ * @endcode
+ *
+ * An allocator constructed without options takes those of @c LockedMemoryOptions::getDefault() at that time.
+ *
+ * @tparam T The type of the objects allocated.
+ */
+template <typename T>
+class LockedAllocator {
+public:
+    /// The type of the objects allocated.
+    using value_type = T;
+
+    /// Containers keep the memory of the buffer they are assigned or swapped with, so it is freed the same way.
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    /**
+     * Constructor, with the options of @c LockedMemoryOptions::getDefault().
+     */
+    LockedAllocator();
+
+    /**
+     * Constructor.
+     *
+     * @param options How to obtain the memory.
+     */
+    explicit LockedAllocator(const LockedMemoryOptions& options);
+
+    /**
+     * Constructor, with the options of an allocator of another type.
+     *
+     * @param other The other allocator.
+     */
+    template <typename U>
+    LockedAllocator(const LockedAllocator<U>& other);
+
+    /**
+     * Allocate memory for objects.
+     *
+     * @param n The number of objects.
+     * @return The memory.
+     * @throw std::bad_alloc If the memory could not be allocated.
+     */
+    T* allocate(size_t n);
+
+    /**
+     * Free memory allocated with @c allocate() by an equal allocator.
+     *
+     * @param memory The memory.
+     * @param n The number of objects it was allocated for.
+     */
+    void deallocate(T* memory, size_t n);
+
+    /**
+     * Get the options of this allocator.
+     *
+     * @return How the memory is obtained.
+     */
+    const LockedMemoryOptions& getOptions() const;
+
+private:
+    /// How the memory is obtained.
+    LockedMemoryOptions m_options;
+};
+
+template <typename T>
+LockedAllocator<T>::LockedAllocator() : m_options{LockedMemoryOptions::getDefault()} {
+}
+
+template <typename T>
+LockedAllocator<T>::LockedAllocator(const LockedMemoryOptions& options) : m_options{options} {
+}
+
+template <typename T>
+template <typename U>
+LockedAllocator<T>::LockedAllocator(const LockedAllocator<U>& other) : m_options{other.getOptions()} {
+}
+
+template <typename T>
+T* LockedAllocator<T>::allocate(size_t n) {
+    return static_cast<T*>(allocateLockedMemory(n * sizeof(T), m_options));
+}
+
+template <typename T>
+void LockedAllocator<T>::deallocate(T* memory, size_t n) {
+    deallocateLockedMemory(memory, n * sizeof(T), m_options);
+}
+
+template <typename T>
+const LockedMemoryOptions& LockedAllocator<T>::getOptions() const {
+    return m_options;
+}
+
+/**
+ * Compare two @c LockedAllocators.
+ *
+ * @param lhs The allocator on the left.
+ * @param rhs The allocator on the right.
+ * @return Whether memory allocated by either can be freed by the other.
+ */
+template <typename T, typename U>
+bool operator==(const LockedAllocator<T>& lhs, const LockedAllocator<U>& rhs) {
+    return lhs.getOptions() == rhs.getOptions();
+}
+
+/**
+ * Compare two @c LockedAllocators.
+ *
+ * @param lhs The allocator on the left.
+ * @param rhs The allocator on the right.
+ * @return Whether memory allocated by one cannot be freed by the other.
+ */
+template <typename T, typename U>
+bool operator!=(const LockedAllocator<T>& lhs, const LockedAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_MEMORY_LOCKED_ALLOCATOR_H_
@@ -0,0 +1,239 @@
+/*
+ * MemoryBudget.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_MEMORY_MEMORY_BUDGET_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_MEMORY_MEMORY_BUDGET_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace memory {
+
+/**
+ * A limit on the memory held by the large buffers of the SDK, such as those of attachments and of the audio input
+ * stream, so that a burst of them cannot exhaust the memory of the device.
+ *
+ * A buffer is allocated only once a @c Reservation for it is granted, and the reservation is held for as long as the
+ * buffer exists.  A request names the size it would like, the smallest size it can work with, and its priority:
+ *
+ *  @li If the preferred size fits in what is left of the budget, it is granted.
+ *  @li Otherwise, if the smallest size fits, what is left of the budget is granted, and the buffer is shrunk to it.
+ *      A smaller buffer makes a writer wait for its reader sooner, or makes a spilling attachment spill to disk sooner.
+ *  @li Otherwise a @c HIGH priority request is granted its smallest size over the budget, so that buffers the device
+ *      cannot work without are never refused, and other requests are rejected.
+ *
+ * @c LOW priority requests are limited to a smaller part of the budget, so that they are rejected before the others
+ * have to shrink.  The state of the budget can be read with @c getGauges(), or logged with @c dump().
+ *
+ * Components take the budget from @c getDefault() when they are created, so a budget set with @c setDefault()
+ * applies to those created after it.  The default budget is unlimited, but still keeps its gauges.
+ *
+ * This class is thread-safe.
+ */
+class MemoryBudget : public std::enable_shared_from_this<MemoryBudget> {
+public:
+    /// The priorities of requests.
+    enum class Priority {
+        /// Buffers which may be refused, limited to the low priority part of the budget.
+        LOW,
+
+        /// Buffers which may be shrunk or refused when the budget is exhausted.
+        NORMAL,
+
+        /// Buffers which may be shrunk, but are never refused.
+        HIGH
+    };
+
+    /**
+     * Bytes granted by a @c MemoryBudget.  They are returned to the budget when the reservation is destroyed.  This
+     * class is not thread-safe; a @c Reservation is used by its owner.
+     */
+    class Reservation {
+    public:
+        /**
+         * Destructor.  Returns the bytes to the budget.
+         */
+        ~Reservation();
+
+        /**
+         * Get the number of bytes reserved.
+         *
+         * @return The number of bytes reserved.
+         */
+        uint64_t getBytes() const;
+
+        /**
+         * Return part of the bytes to the budget, such as when a buffer is rounded down to a size it can be created
+         * with.
+         *
+         * @param bytes The number of bytes to keep.  Values larger than @c getBytes() are ignored.
+         */
+        void shrink(uint64_t bytes);
+
+        /// @cond
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+        /// @endcond
+
+    private:
+        /// @c MemoryBudget is a friend so that it can call the constructor.
+        friend class MemoryBudget;
+
+        /**
+         * Constructor.
+         *
+         * @param budget The budget the bytes are reserved from.
+         * @param bytes The number of bytes reserved.
+         */
+        Reservation(std::shared_ptr<MemoryBudget> budget, uint64_t bytes);
+
+        /// The budget the bytes are reserved from.
+        const std::shared_ptr<MemoryBudget> m_budget;
+
+        /// The number of bytes reserved.
+        uint64_t m_bytes;
+    };
+
+    /// The state of a budget.
+    struct Gauges {
+        /// The number of bytes which may be reserved.
+        uint64_t maxBytes;
+
+        /// The number of bytes which may be reserved by @c LOW priority requests.
+        uint64_t lowPriorityMaxBytes;
+
+        /// The number of bytes reserved.
+        uint64_t reservedBytes;
+
+        /// The most bytes reserved since the budget was created or @c resetHighWaterMark() was called.
+        uint64_t highWaterBytes;
+
+        /// The number of reservations held.
+        uint64_t reservations;
+
+        /// The number of requests granted less than their preferred size.
+        uint64_t shrunkRequests;
+
+        /// The number of @c HIGH priority requests granted over the budget.
+        uint64_t overBudgetRequests;
+
+        /// The number of requests rejected.
+        uint64_t rejectedRequests;
+    };
+
+    /// The budget of an unlimited @c MemoryBudget.
+    static const uint64_t UNLIMITED = UINT64_MAX;
+
+    /**
+     * Get the budget components use when none is given to them.
+     *
+     * @return The budget set with @c setDefault(), or an unlimited budget.
+     */
+    static std::shared_ptr<MemoryBudget> getDefault();
+
+    /**
+     * Set the budget components use when none is given to them.  Components which already exist are not affected.
+     *
+     * @param budget The budget to use, or @c nullptr for an unlimited budget.
+     */
+    static void setDefault(std::shared_ptr<MemoryBudget> budget);
+
+    /**
+     * Create a @c MemoryBudget.
+     *
+     * @param maxBytes The number of bytes which may be reserved.
+     * @param lowPriorityMaxBytes The number of bytes which may be reserved by @c LOW priority requests.  It is
+     * limited to @c maxBytes.
+     * @return A new @c MemoryBudget, or @c nullptr if @c maxBytes is zero.
+     */
+    static std::shared_ptr<MemoryBudget> create(uint64_t maxBytes, uint64_t lowPriorityMaxBytes = UNLIMITED);
+
+    /**
+     * Reserve bytes for a buffer.
+     *
+     * @param preferredBytes The size the buffer would like.
+     * @param minimumBytes The smallest size the buffer can work with.  It is limited to @c preferredBytes.
+     * @param priority The priority of the request.
+     * @return A reservation of between @c minimumBytes and @c preferredBytes, or @c nullptr if the request is
+     * rejected.
+     */
+    std::unique_ptr<Reservation> reserve(
+        uint64_t preferredBytes,
+        uint64_t minimumBytes,
+        Priority priority = Priority::NORMAL);
+
+    /**
+     * Get the state of the budget.
+     *
+     * @return The state of the budget.
+     */
+    Gauges getGauges() const;
+
+    /**
+     * Set the high-water mark to the bytes reserved now.
+     */
+    void resetHighWaterMark();
+
+    /**
+     * Log the state of the budget.
+     */
+    void dump() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param maxBytes The number of bytes which may be reserved.
+     * @param lowPriorityMaxBytes The number of bytes which may be reserved by @c LOW priority requests.
+     */
+    MemoryBudget(uint64_t maxBytes, uint64_t lowPriorityMaxBytes);
+
+    /**
+     * Return bytes to the budget.
+     *
+     * @param bytes The number of bytes returned.
+     * @param isLast Whether this ends a reservation.
+     */
+    void release(uint64_t bytes, bool isLast);
+
+    /// Serializes access to @c m_gauges.
+    mutable std::mutex m_mutex;
+
+    /// The state of the budget.
+    Gauges m_gauges;
+};
+
+/**
+ * Write a @c MemoryBudget::Priority value to an @c ostream as a string.
+ *
+ * @param stream The stream to write to.
+ * @param priority The value to write.
+ * @return The stream that was passed in and written to.
+ */
+std::ostream& operator<<(std::ostream& stream, MemoryBudget::Priority priority);
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_MEMORY_MEMORY_BUDGET_H_
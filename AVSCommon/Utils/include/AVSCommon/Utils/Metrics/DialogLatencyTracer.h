@@ -0,0 +1,214 @@
+/*
+ * DialogLatencyTracer.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_DIALOG_LATENCY_TRACER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_DIALOG_LATENCY_TRACER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AVSCommon/Utils/Metrics/LatencyHistogram.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/**
+ * Traces a voice interaction from the end of its wakeword to the end of the speech of the response, across modules.
+ * The dialogRequestId of the Recognize event identifies the trace.  A @c LatencyHistogram is kept for each @c Mark, of
+ * the time from the end of the wakeword.  The histograms can be read with @c getSummaries(), and are logged with those
+ * of @c DirectiveLatencyTracker.
+ *
+ * Tracing is disabled by default, in which case placing a mark costs a single atomic load.
+ */
+class DialogLatencyTracer {
+public:
+    /// The points of a voice interaction, in the order they normally occur.
+    enum class Mark {
+        /// The end of the wakeword in the captured audio, or the start of capture without one.  This starts the trace.
+        KEYWORD_END,
+
+        /// The Recognize event is handed to an HTTP/2 stream.
+        SEND_START,
+
+        /// The first directive of the response is received.
+        FIRST_DIRECTIVE,
+
+        /// The last byte of audio of the Recognize event is sent.
+        SEND_END,
+
+        /// The first byte of an attachment of the response is received.
+        FIRST_ATTACHMENT_BYTE,
+
+        /// The Speak directive of the response reaches the @c SpeechSynthesizer.
+        SPEAK_RECEIVED,
+
+        /// The response starts playing.
+        FIRST_AUDIO,
+
+        /// The speech of the response finishes playing.  This ends the trace.
+        SPEECH_FINISHED
+    };
+
+    /// The number of values of @c Mark.
+    static const size_t NUM_MARKS = static_cast<size_t>(Mark::SPEECH_FINISHED) + 1;
+
+    /// The latencies of a mark.
+    struct Summary {
+        /// The mark.
+        Mark mark;
+
+        /// The number of traces which reached the mark.
+        uint64_t count;
+
+        /// The median latency.
+        std::chrono::microseconds p50;
+
+        /// The 90th percentile latency.
+        std::chrono::microseconds p90;
+
+        /// The 99th percentile latency.
+        std::chrono::microseconds p99;
+
+        /// The largest latency.
+        std::chrono::microseconds max;
+    };
+
+    /**
+     * Get the process-wide @c DialogLatencyTracer.
+     *
+     * @return The process-wide @c DialogLatencyTracer.
+     */
+    static DialogLatencyTracer& instance();
+
+    /**
+     * Enable or disable tracing.  Disabling tracing forgets the traces in progress, but keeps the histograms.
+     *
+     * @param enabled Whether marks should be placed.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Whether tracing is enabled.
+     *
+     * @return Whether marks are placed.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Start a trace, placing its @c Mark::KEYWORD_END.
+     *
+     * @param dialogRequestId The dialogRequestId of the Recognize event.
+     * @param keywordEnd When the end of the wakeword was captured.
+     */
+    void startTrace(const std::string& dialogRequestId, std::chrono::steady_clock::time_point keywordEnd);
+
+    /**
+     * Place a mark in a trace.  Marks for dialogRequestIds with no trace in progress, and marks already placed in the
+     * trace, are ignored.  Placing @c Mark::SPEECH_FINISHED ends the trace.
+     *
+     * @param dialogRequestId The dialogRequestId of the trace.
+     * @param mark The mark.
+     * @param when When the mark was reached.
+     */
+    void mark(
+        const std::string& dialogRequestId,
+        Mark mark,
+        std::chrono::steady_clock::time_point when = std::chrono::steady_clock::now());
+
+    /**
+     * Get the latencies recorded so far.
+     *
+     * @return The latencies of each mark reached, in the order of @c Mark.
+     */
+    std::vector<Summary> getSummaries() const;
+
+    /**
+     * Forget the latencies recorded so far, and the traces in progress.
+     */
+    void reset();
+
+    /**
+     * Log the latencies recorded so far.
+     */
+    void dump() const;
+
+    /**
+     * Translate a @c Mark into a string.
+     *
+     * @param mark The mark.
+     * @return The name of the mark.
+     */
+    static std::string markToString(Mark mark);
+
+private:
+    /// A trace in progress.
+    struct Trace {
+        /// When the end of the wakeword was captured.
+        std::chrono::steady_clock::time_point keywordEnd;
+
+        /// A bit for each mark which has been placed.
+        uint32_t placedMarks;
+    };
+
+    /**
+     * Constructor.
+     */
+    DialogLatencyTracer();
+
+    /// Whether tracing is enabled.
+    std::atomic<bool> m_isEnabled;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The traces in progress, by dialogRequestId.
+    std::unordered_map<std::string, Trace> m_traces;
+
+    /// The dialogRequestIds added to @c m_traces, oldest first, so that traces which never end are forgotten.
+    std::deque<std::string> m_traceOrder;
+
+    /// The latencies of each mark.
+    std::array<LatencyHistogram, NUM_MARKS> m_histograms;
+};
+
+/**
+ * Write a @c DialogLatencyTracer::Mark value to an @c ostream.
+ *
+ * @param stream The stream to write the value to.
+ * @param mark The value to write.
+ * @return The stream that was passed in.
+ */
+inline std::ostream& operator<<(std::ostream& stream, DialogLatencyTracer::Mark mark) {
+    return stream << DialogLatencyTracer::markToString(mark);
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_DIALOG_LATENCY_TRACER_H_
@@ -0,0 +1,250 @@
+/*
+ * DirectiveLatencyTracker.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_DIRECTIVE_LATENCY_TRACKER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_DIRECTIVE_LATENCY_TRACKER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AVSCommon/Utils/Metrics/LatencyHistogram.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/**
+ * Records when each directive reaches each stage of the directive pipeline, and keeps a @c LatencyHistogram per
+ * namespace and stage of the time from the first stage recorded for a directive to each later one.  The histograms
+ * can be read with @c getSummaries(), or logged periodically with @c startPeriodicDump().
+ *
+ * Tracking is disabled by default, in which case recording a stage costs a single atomic load.
+ */
+class DirectiveLatencyTracker {
+public:
+    /// The stages of the directive pipeline, in the order a directive normally goes through them.
+    enum class Stage {
+        /// The MIME part holding the directive starts to arrive from AVS.
+        ACL_RECEIVE,
+
+        /// The MIME part holding the directive has been received.
+        MIME_PART_END,
+
+        /// The directive has been parsed and is passed to the @c DirectiveSequencer.
+        ADSL_ENQUEUE,
+
+        /// The @c DirectiveSequencer passes the directive on for handling.
+        ADSL_DEQUEUE,
+
+        /// The directive is passed to the @c preHandleDirective() of its handler.
+        PRE_HANDLE,
+
+        /// The directive is passed to the @c handleDirective() or @c handleDirectiveImmediately() of its handler.
+        HANDLE_START,
+
+        /// The handler of the directive reports that handling has completed.
+        COMPLETED
+    };
+
+    /// The number of values of @c Stage.
+    static const size_t NUM_STAGES = static_cast<size_t>(Stage::COMPLETED) + 1;
+
+    /// The latencies of a stage for the directives of a namespace.
+    struct Summary {
+        /// The namespace of the directives.
+        std::string nameSpace;
+
+        /// The stage.
+        Stage stage;
+
+        /// The number of directives which reached the stage.
+        uint64_t count;
+
+        /// The median latency.
+        std::chrono::microseconds p50;
+
+        /// The 90th percentile latency.
+        std::chrono::microseconds p90;
+
+        /// The 99th percentile latency.
+        std::chrono::microseconds p99;
+
+        /// The largest latency.
+        std::chrono::microseconds max;
+    };
+
+    /**
+     * Get the process-wide @c DirectiveLatencyTracker.
+     *
+     * @return The process-wide @c DirectiveLatencyTracker.
+     */
+    static DirectiveLatencyTracker& instance();
+
+    /**
+     * Enable or disable tracking.  Disabling tracking forgets the directives in flight, but keeps the histograms.
+     *
+     * @param enabled Whether stages should be recorded.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Whether tracking is enabled.
+     *
+     * @return Whether stages are recorded.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Record that a directive has reached a stage.  Reaching @c Stage::COMPLETED forgets the directive.
+     *
+     * @param messageId The messageId of the directive.
+     * @param nameSpace The namespace of the directive, or empty if it is not known yet.
+     * @param stage The stage reached.
+     * @param when When the stage was reached.
+     */
+    void record(
+        const std::string& messageId,
+        const std::string& nameSpace,
+        Stage stage,
+        std::chrono::steady_clock::time_point when = std::chrono::steady_clock::now());
+
+    /**
+     * Record that the MIME part of a directive, which has not been parsed yet, has been received.  This records
+     * @c Stage::ACL_RECEIVE at @c receivedAt and @c Stage::MIME_PART_END now, using a light scan of the text for the
+     * messageId of the directive.
+     *
+     * @param unparsedDirective The text of the directive.
+     * @param receivedAt When the MIME part started to arrive.
+     */
+    void recordReceived(const std::string& unparsedDirective, std::chrono::steady_clock::time_point receivedAt);
+
+    /**
+     * Get the latencies recorded so far.
+     *
+     * @return The latencies of each stage reached by the directives of each namespace, ordered by namespace and then
+     * by stage.
+     */
+    std::vector<Summary> getSummaries() const;
+
+    /**
+     * Forget the latencies recorded so far, and the directives in flight.
+     */
+    void reset();
+
+    /**
+     * Log the latencies recorded so far.
+     */
+    void dump() const;
+
+    /**
+     * Start logging the latencies recorded so far periodically, along with those of @c DialogLatencyTracer.
+     *
+     * @param interval The time between dumps.
+     * @return Whether the dumps were started.
+     */
+    bool startPeriodicDump(std::chrono::milliseconds interval);
+
+    /**
+     * Stop the dumps started by @c startPeriodicDump().
+     */
+    void stopPeriodicDump();
+
+    /**
+     * Translate a @c Stage into a string.
+     *
+     * @param stage The stage.
+     * @return The name of the stage.
+     */
+    static std::string stageToString(Stage stage);
+
+private:
+    /// The stages recorded for a directive in flight.
+    struct InFlightDirective {
+        /// The namespace of the directive, or empty if it is not known yet.
+        std::string nameSpace;
+
+        /// When each stage was reached.
+        std::array<std::chrono::steady_clock::time_point, NUM_STAGES> times;
+
+        /// A bit for each stage which has been reached.
+        uint32_t recordedStages;
+
+        /// A bit for each stage which has been counted in @c m_histograms.
+        uint32_t reportedStages;
+    };
+
+    /**
+     * Constructor.
+     */
+    DirectiveLatencyTracker();
+
+    /**
+     * Count the latencies of the stages reached by a directive which have not been counted yet, if its namespace is
+     * known.  @c m_mutex must be held.
+     *
+     * @param directive The directive.
+     */
+    void reportLocked(InFlightDirective* directive);
+
+    /// Whether tracking is enabled.
+    std::atomic<bool> m_isEnabled;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The directives in flight, by messageId.
+    std::unordered_map<std::string, InFlightDirective> m_inFlight;
+
+    /// The messageIds added to @c m_inFlight, oldest first, so that directives which never complete are forgotten.
+    std::deque<std::string> m_inFlightOrder;
+
+    /// The latencies of each stage, by namespace.
+    std::map<std::string, std::vector<LatencyHistogram>> m_histograms;
+
+    /// The timer which calls @c dump() periodically, or @c nullptr.
+    std::unique_ptr<timing::Timer> m_dumpTimer;
+};
+
+/**
+ * Write a @c DirectiveLatencyTracker::Stage value to an @c ostream.
+ *
+ * @param stream The stream to write the value to.
+ * @param stage The value to write.
+ * @return The stream that was passed in.
+ */
+inline std::ostream& operator<<(std::ostream& stream, DirectiveLatencyTracker::Stage stage) {
+    return stream << DirectiveLatencyTracker::stageToString(stage);
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_DIRECTIVE_LATENCY_TRACKER_H_
@@ -0,0 +1,118 @@
+/*
+ * LatencyHistogram.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_LATENCY_HISTOGRAM_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_LATENCY_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/**
+ * A histogram of non-negative values with bounded relative error, in the manner of an HDR histogram.  Values below
+ * @c SUB_BUCKET_COUNT are counted exactly.  Each larger power-of-two range is split into @c SUB_BUCKET_COUNT / 2
+ * linear buckets, so a reported value is within about 3% of the recorded one.  Values of @c MAX_VALUE or more are
+ * counted as @c MAX_VALUE.
+ *
+ * Recording a value is a few shifts and an increment, with no allocation.  This class is not thread-safe.
+ */
+class LatencyHistogram {
+public:
+    /// The number of buckets which count values exactly.
+    static const size_t SUB_BUCKET_COUNT = 64;
+
+    /// The largest value which can be recorded.
+    static const uint64_t MAX_VALUE = (static_cast<uint64_t>(1) << 36) - 1;
+
+    /**
+     * Constructor.
+     */
+    LatencyHistogram();
+
+    /**
+     * Count a value.
+     *
+     * @param value The value.
+     */
+    void record(uint64_t value);
+
+    /**
+     * Get the number of values counted.
+     *
+     * @return The number of values counted.
+     */
+    uint64_t getCount() const;
+
+    /**
+     * Get the largest value counted.
+     *
+     * @return The largest value counted, or zero if none have been.
+     */
+    uint64_t getMax() const;
+
+    /**
+     * Get the value below which a given percentage of the counted values fall.
+     *
+     * @param percentile The percentage, from 0 to 100.
+     * @return The largest value equivalent to the bucket holding the percentile, or zero if no values have been
+     * counted.
+     */
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    /**
+     * Forget the values counted.
+     */
+    void reset();
+
+private:
+    /**
+     * Get the index of the bucket counting a value.
+     *
+     * @param value The value, no larger than @c MAX_VALUE.
+     * @return The index of the bucket.
+     */
+    static size_t getBucketIndex(uint64_t value);
+
+    /**
+     * Get the largest value counted by a bucket.
+     *
+     * @param index The index of the bucket.
+     * @return The largest value counted by the bucket.
+     */
+    static uint64_t getHighestEquivalentValue(size_t index);
+
+    /// The number of values counted by each bucket.
+    std::vector<uint64_t> m_counts;
+
+    /// The number of values counted.
+    uint64_t m_totalCount;
+
+    /// The largest value counted.
+    uint64_t m_max;
+};
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_LATENCY_HISTOGRAM_H_
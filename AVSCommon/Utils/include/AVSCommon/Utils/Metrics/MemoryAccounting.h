@@ -0,0 +1,184 @@
+/*
+ * MemoryAccounting.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_MEMORY_ACCOUNTING_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_MEMORY_ACCOUNTING_H_
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/**
+ * Counts the memory held by the largest consumers of the SDK, by category, so that memory budgets can be sized and
+ * leaks, such as attachments which are never released, can be found.  A snapshot of the bytes and allocations held
+ * by each category, and of the most bytes each has held, can be read with @c getSnapshot(), or logged with @c dump().
+ *
+ * Accounting is off until @c setEnabled() turns it on, and costs a relaxed atomic load per hook until then.  Only
+ * memory allocated while accounting is on is counted, so turning it on early gives the most complete picture.
+ *
+ * Components report their memory through an @c Allocation, which follows the lifetime of what it measures, or
+ * through a sampler for memory which is counted by a library, such as SQLite's.  This class is thread-safe.
+ */
+class MemoryAccounting {
+public:
+    /// The categories of memory.
+    enum class Category {
+        /// The buffers of attachments, such as those of the audio of @c Speak directives.
+        ATTACHMENTS,
+
+        /// The JSON documents of directives, and the states kept for the context.
+        JSON_DOCUMENTS,
+
+        /// The buffers handed to the media player.
+        MEDIA_BUFFERS,
+
+        /// The memory of SQLite, mostly its page caches.
+        SQLITE,
+
+        /// The buffers of log entries waiting to be written.
+        LOGGING
+    };
+
+    /// The number of values of @c Category.
+    static const size_t NUM_CATEGORIES = static_cast<size_t>(Category::LOGGING) + 1;
+
+    /// The memory of a category.
+    struct Usage {
+        /// The category.
+        Category category;
+
+        /// The number of bytes held.
+        uint64_t bytes;
+
+        /// The most bytes held since accounting was turned on or @c resetHighWaterMarks() was called.
+        uint64_t highWaterBytes;
+
+        /// The number of allocations held, or zero for a category measured by a sampler.
+        uint64_t allocations;
+    };
+
+    /**
+     * Counts the bytes of an object or buffer of a category for as long as it exists.  Its size may change with
+     * @c resize().  This class is not thread-safe; an @c Allocation is updated by its owner.
+     */
+    class Allocation {
+    public:
+        /**
+         * Constructor.  Counts nothing until @c resize() is called.
+         *
+         * @param category The category of the memory.
+         */
+        explicit Allocation(Category category);
+
+        /**
+         * Constructor.
+         *
+         * @param category The category of the memory.
+         * @param bytes The number of bytes to count.
+         */
+        Allocation(Category category, uint64_t bytes);
+
+        /**
+         * Destructor.  Stops counting the bytes.
+         */
+        ~Allocation();
+
+        /**
+         * Change the number of bytes counted.  The bytes are only counted if accounting is on, or was on when they
+         * were first counted.
+         *
+         * @param bytes The number of bytes to count.
+         */
+        void resize(uint64_t bytes);
+
+        /// @cond
+        Allocation(const Allocation&) = delete;
+        Allocation& operator=(const Allocation&) = delete;
+        /// @endcond
+
+    private:
+        /// The category of the memory.
+        const Category m_category;
+
+        /// The number of bytes counted.
+        uint64_t m_bytes;
+
+        /// Whether this is counted among the allocations of its category.
+        bool m_isCounted;
+    };
+
+    /**
+     * Turn accounting on or off.  Memory which was counted stays counted until it is released.
+     *
+     * @param enabled Whether memory should be counted.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Whether accounting is on.
+     *
+     * @return Whether memory is counted.
+     */
+    static bool isEnabled();
+
+    /**
+     * Measure a category with a function, called by @c getSnapshot(), rather than with @c Allocation objects.
+     *
+     * @param category The category.
+     * @param sampler A function returning the number of bytes held by the category, or @c nullptr to stop sampling.
+     */
+    static void setSampler(Category category, std::function<uint64_t()> sampler);
+
+    /**
+     * Get the memory of each category.
+     *
+     * @return The memory of each category, in the order of @c Category.
+     */
+    static std::vector<Usage> getSnapshot();
+
+    /**
+     * Set the high-water mark of each category to the bytes it holds now.
+     */
+    static void resetHighWaterMarks();
+
+    /**
+     * Log the memory of each category.
+     */
+    static void dump();
+};
+
+/**
+ * Write a @c MemoryAccounting::Category value to an @c ostream as a string.
+ *
+ * @param stream The stream to write to.
+ * @param category The value to write.
+ * @return The stream that was passed in and written to.
+ */
+std::ostream& operator<<(std::ostream& stream, MemoryAccounting::Category category);
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_MEMORY_ACCOUNTING_H_
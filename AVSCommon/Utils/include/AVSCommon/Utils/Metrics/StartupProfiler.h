@@ -0,0 +1,149 @@
+/*
+ * StartupProfiler.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_STARTUP_PROFILER_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_STARTUP_PROFILER_H_
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/**
+ * Records how long each stage of a startup sequence takes, so that the slow ones can be found.  Stages may run on
+ * several threads at once, in which case their durations add up to more than the elapsed time.
+ *
+ * This class is thread-safe.
+ */
+class StartupProfiler {
+public:
+    /// The clock the stages are timed with.
+    using Clock = std::chrono::steady_clock;
+
+    /// A stage which has completed.
+    struct Stage {
+        /// The name of the stage.
+        std::string name;
+        /// When the stage started, relative to the construction of the profiler.
+        std::chrono::milliseconds startOffset;
+        /// How long the stage took.
+        std::chrono::milliseconds duration;
+    };
+
+    /**
+     * Constructor.  The elapsed time is measured from here.
+     *
+     * @param name The name of the startup sequence, used in the log.
+     */
+    StartupProfiler(const std::string& name);
+
+    /**
+     * Run a stage and record how long it takes.
+     *
+     * @tparam Task The type of the stage.
+     * @param name The name of the stage.
+     * @param task The stage.
+     * @return The value returned by @c task.
+     */
+    template <typename Task>
+    auto time(const std::string& name, Task task) -> decltype(task());
+
+    /**
+     * Record a stage which has just completed.
+     *
+     * @param name The name of the stage.
+     * @param start When the stage started.
+     */
+    void record(const std::string& name, Clock::time_point start);
+
+    /**
+     * Get the stages recorded so far.
+     *
+     * @return The stages, in the order in which they completed.
+     */
+    std::vector<Stage> getStages() const;
+
+    /**
+     * Get the time elapsed since construction.
+     *
+     * @return The time elapsed.
+     */
+    std::chrono::milliseconds getElapsed() const;
+
+    /**
+     * Log each stage recorded so far, and the time elapsed.
+     */
+    void log() const;
+
+private:
+    /**
+     * Records a stage when destroyed, so that it is recorded however the stage ends.
+     */
+    class ScopedStage {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param profiler The profiler to record the stage with.
+         * @param name The name of the stage.
+         */
+        ScopedStage(StartupProfiler* profiler, const std::string& name);
+
+        /**
+         * Destructor.
+         */
+        ~ScopedStage();
+
+    private:
+        /// The profiler to record the stage with.
+        StartupProfiler* m_profiler;
+        /// The name of the stage.
+        std::string m_name;
+        /// When the stage started.
+        Clock::time_point m_start;
+    };
+
+    /// The name of the startup sequence.
+    const std::string m_name;
+
+    /// When the profiler was constructed.
+    const Clock::time_point m_start;
+
+    /// Serializes access to @c m_stages.
+    mutable std::mutex m_mutex;
+
+    /// The stages recorded so far.
+    std::vector<Stage> m_stages;
+};
+
+template <typename Task>
+auto StartupProfiler::time(const std::string& name, Task task) -> decltype(task()) {
+    ScopedStage stage(this, name);
+    return task();
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_STARTUP_PROFILER_H_
@@ -0,0 +1,171 @@
+/*
+ * ThreadCpuMonitor.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_THREAD_CPU_MONITOR_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_THREAD_CPU_MONITOR_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AVSCommon/Utils/Threading/ThreadFactory.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/**
+ * Periodically samples the CPU time and context switches of the threads created by @c threading::ThreadFactory, from
+ * @c /proc/self/task, and reports how much each kind of thread used over the last period, so that the
+ * components keeping an idle device busy can be found.  Threads are grouped by role and name.
+ *
+ * Each report is logged, and the last one can be read with @c getLastReport().  Only available on Linux.  This class
+ * is thread-safe.
+ */
+class ThreadCpuMonitor {
+public:
+    /// The counters of a thread.
+    struct ThreadSample {
+        /// The thread.
+        threading::ThreadFactory::ThreadInfo thread;
+
+        /// The CPU time the thread used, in user and system mode.
+        std::chrono::milliseconds cpuTime;
+
+        /// The number of times the thread gave up the CPU, such as to wait.
+        uint64_t voluntaryContextSwitches;
+
+        /// The number of times the thread was preempted.
+        uint64_t involuntaryContextSwitches;
+    };
+
+    /// What the threads of a role and name used over a period.
+    struct Usage {
+        /// The role of the threads.
+        threading::ThreadRole role;
+
+        /// The name of the threads.
+        std::string name;
+
+        /// The number of threads.
+        size_t numThreads;
+
+        /// The CPU time the threads used.
+        std::chrono::milliseconds cpuTime;
+
+        /// The number of times the threads gave up the CPU.
+        uint64_t voluntaryContextSwitches;
+
+        /// The number of times the threads were preempted.
+        uint64_t involuntaryContextSwitches;
+    };
+
+    /**
+     * Create a @c ThreadCpuMonitor, which samples the threads right away and then reports once per period.
+     *
+     * @param period How often to report.
+     * @return The new @c ThreadCpuMonitor, or @c nullptr if the period is not positive or the threads can not be
+     * sampled on this platform.
+     */
+    static std::unique_ptr<ThreadCpuMonitor> create(std::chrono::milliseconds period);
+
+    /**
+     * Destructor.  Stops reporting.
+     */
+    ~ThreadCpuMonitor();
+
+    /**
+     * Get the last report.
+     *
+     * @return What the threads of each role and name used over the last period, or an empty vector if no period has
+     * ended yet.
+     */
+    std::vector<Usage> getLastReport() const;
+
+    /**
+     * Read the counters of the running threads created by @c threading::ThreadFactory.
+     *
+     * @return The counters of the threads which could be read.
+     */
+    static std::vector<ThreadSample> sampleThreads();
+
+    /**
+     * Find what the threads used between two samples, grouped by role and name.  A thread missing from the earlier
+     * sample is counted from zero; one missing from the later sample is not counted.
+     *
+     * @param previous The earlier sample.
+     * @param current The later sample.
+     * @return What the threads of each role and name used, by decreasing CPU time.
+     */
+    static std::vector<Usage> getUsage(
+        const std::vector<ThreadSample>& previous,
+        const std::vector<ThreadSample>& current);
+
+    /**
+     * Parse the CPU time from the contents of a @c /proc/<pid>/task/<tid>/stat file.
+     *
+     * @param stat The contents of the file.
+     * @param[out] ticks The CPU time used in user and system mode, in clock ticks.
+     * @return Whether the contents were parsed.
+     */
+    static bool parseStat(const std::string& stat, uint64_t* ticks);
+
+    /**
+     * Parse the context switches from the contents of a @c /proc/<pid>/task/<tid>/status file.
+     *
+     * @param status The contents of the file.
+     * @param[out] voluntary The number of voluntary context switches.
+     * @param[out] involuntary The number of involuntary context switches.
+     * @return Whether the contents were parsed.
+     */
+    static bool parseStatus(const std::string& status, uint64_t* voluntary, uint64_t* involuntary);
+
+private:
+    /**
+     * Constructor.
+     */
+    ThreadCpuMonitor();
+
+    /**
+     * Sample the threads, and report what they used since the previous sample.
+     */
+    void report();
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The previous sample.
+    std::vector<ThreadSample> m_previous;
+
+    /// The last report.
+    std::vector<Usage> m_lastReport;
+
+    /// Calls @c report() once per period.  Declared last, so that it stops before the members above are destroyed.
+    timing::Timer m_timer;
+};
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_METRICS_THREAD_CPU_MONITOR_H_
@@ -32,7 +32,10 @@ namespace playlistParser {
  */
 enum class PlaylistParseResult {
 
-    /// The playlist has been fully parsed successfully. This indicates that parsing of the playlist has completed.
+    /**
+     * The playlist has been fully parsed successfully. This indicates that parsing of the playlist has completed.  If
+     * the last entry was reported before the end of the playlist was known, the url in this callback will be empty.
+     */
     SUCCESS,
 
     /**
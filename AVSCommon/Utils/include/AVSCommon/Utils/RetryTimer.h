@@ -66,6 +66,17 @@ public:
      */
     std::chrono::milliseconds calculateTimeToRetry(int retryCount);
 
+    /**
+     * Method to return a delay in milliseconds with "decorrelated jitter": a random delay between the first entry of
+     * the retry table and three times the previous delay (or the first entry, for the first retry), capped at the last
+     * entry of the retry table.  Unlike
+     * @c calculateTimeToRetry(), the delays of clients which started retrying together drift apart as they retry.
+     *
+     * @param previousDelay The delay returned for the previous retry, or zero for the first retry.
+     * @return delay in milliseconds.
+     */
+    std::chrono::milliseconds calculateDecorrelatedTimeToRetry(std::chrono::milliseconds previousDelay);
+
 private:
     /// Retry table with retry time in milliseconds.
     int* m_RetryTable;
@@ -18,13 +18,19 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_BUFFER_LAYOUT_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_BUFFER_LAYOUT_H_
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "IndexTimeline.h"
 #include "SharedDataStream.h"
 
 namespace alexaClientSDK {
@@ -34,9 +40,13 @@ namespace sds {
 
 /**
  * This is a nested class inside @c SharedDatastream which defines the layout of a @c Buffer for use with a
- * @c SharedDataStream.  This layout begins with a fixed @c Header structure, followed by two arrays of
- * @c Reader @c Indexes, with the remainder allocated to data.  All four of these sections are aligned on a 64-bit
- * boundary.
+ * @c SharedDataStream.  This layout begins with a fixed @c Header structure, followed by an array of @c Reader enabled
+ * flags and two arrays of @c Reader @c Indexes, with the remainder allocated to data.
+ *
+ * Readers and the writer usually run on different cores, so the fields each of them writes on every read or write are
+ * kept on cache lines of their own: the writer's cursors are padded apart from the rest of the @c Header, and each
+ * @c Reader cursor fills a @c CACHE_LINE_SIZE slot.  The cursor array and the data are aligned to @c CACHE_LINE_SIZE
+ * from the start of the @c Buffer, so they also start on a cache line if the @c Buffer does.
  */
 template <typename T>
 class SharedDataStream<T>::BufferLayout {
@@ -45,7 +55,19 @@ public:
     static const uint32_t MAGIC_NUMBER = 0x53445348;
 
     /// Version of this header layout.
-    static const uint32_t VERSION = 0;
+    static const uint32_t VERSION = 2;
+
+    /// The size of the cache lines which fields written by different threads are kept apart by.
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    /// A @c Reader cursor, padded to fill a cache line so that readers on different cores do not share one.
+    struct PaddedIndex {
+        /// The cursor.
+        AtomicIndex index;
+
+        /// Padding to the end of the cache line.
+        uint8_t padding[CACHE_LINE_SIZE - sizeof(AtomicIndex)];
+    };
 
     /**
      * The constructor only initializes a shared pointer to the provided buffer.  Attaching and/or initializing is
@@ -103,6 +125,14 @@ public:
         /// This field contains the mutex used by @c dataAvailableConditionVariable.
         Mutex dataAvailableMutex;
 
+        /**
+         * This field contains the lowest @c writeStartCursor that a blocked @c Reader is waiting for, or the maximum
+         * @c Index if no @c Reader is waiting.  @c Readers lower it (while holding @c dataAvailableMutex) before they
+         * wait, and a @c Writer only locks @c dataAvailableMutex and notifies @c dataAvailableConditionVariable once
+         * @c writeStartCursor reaches it.
+         */
+        AtomicIndex wakeupCursor;
+
         /**
          * This field contains a mutex used to temporarily hold off @c Readers from seeking backwards in the buffer
          * while a @c Reader is updating @c oldestUnconsumedCursor.  The is necessary to prevent a race condition where
@@ -120,6 +150,9 @@ public:
          */
         Mutex writerEnableMutex;
 
+        /// Keeps the write cursors, which change on every write, off the cache lines of the fields above.
+        uint8_t writeCursorsLeadingPadding[CACHE_LINE_SIZE];
+
         /// This field contains the next location to write to.
         AtomicIndex writeStartCursor;
 
@@ -129,6 +162,9 @@ public:
          */
         AtomicIndex writeEndCursor;
 
+        /// Keeps the write cursors off the cache lines of the fields below, which @c Readers update.
+        uint8_t writeCursorsTrailingPadding[CACHE_LINE_SIZE];
+
         /**
          * This field contains the location of oldest word in the buffer which has not been consumed (read by a
          * @c Reader).  This field is used as a barrier by @c Writers which have a policy not to overwrite readers.
@@ -170,11 +206,12 @@ public:
     /**
      * This function provides access to the array of indices which specify the location each @c Reader will read from.
      *
-     * This array of cursor indices comes next in @c m_buffer after the @c getReaderEnabledArray() listed above.
+     * This array of cursor indices comes next in @c m_buffer after the @c getReaderEnabledArray() listed above.  Each
+     * cursor is padded to a cache line of its own.
      *
-     * @return A pointer to the array of @c maxReaders cursor @c Indexes.
+     * @return A pointer to the array of @c maxReaders padded cursor @c Indexes.
      */
-    AtomicIndex* getReaderCursorArray() const;
+    PaddedIndex* getReaderCursorArray() const;
 
     /**
      * This function provides access to the array of indices which specify the @c Index where each @c Reader
@@ -217,6 +254,30 @@ public:
      */
     uint8_t* getData(Index at = 0) const;
 
+    /**
+     * This function provides access to the timeline of when words were written to the stream.  The timeline is not
+     * kept in the @c Buffer, so it is only shared by the @c Reader and @c Writer objects of this @c BufferLayout.
+     *
+     * @return The timeline of the stream.
+     */
+    IndexTimeline& getTimeline();
+
+    /**
+     * This function sets a function to call each time a @c Writer of this @c BufferLayout commits data or closes, so
+     * that a @c Reader which does not block can be serviced as soon as there is something to read.  Like the
+     * timeline, the functions are not kept in the @c Buffer, so they are only called for @c Writers in this process.
+     *
+     * @param id The id of the @c Reader the function is for.
+     * @param callback The function to call, which must not block, or an empty function to remove the function set
+     *     for @c id.  Once a function has been removed, it is not running and will not be called again.
+     */
+    void setDataAvailableCallback(size_t id, std::function<void()> callback);
+
+    /**
+     * This function calls the functions set with @c setDataAvailableCallback().
+     */
+    void notifyDataAvailableCallbacks();
+
     /**
      * This function initalizes the @c Header and arrays in the @c Buffer managed by this @c BufferLayout.
      * This function must not be called on a @c BufferLayout which is managing a @c Buffer which has already been
@@ -321,6 +382,23 @@ public:
      */
     void updateOldestUnconsumedCursorLocked();
 
+    /**
+     * This function blocks until @c writeStartCursor reaches @c wakeupCursor, or a @c Writer which has written data
+     * closes, or the timeout expires.  The blocked caller is recorded in @c Header::wakeupCursor so that a @c Writer
+     * does not wake it before the data it is waiting for has been written.
+     *
+     * @param wakeupCursor The @c writeStartCursor to wait for.
+     * @param timeout The maximum time to wait.  If this parameter is zero, there is no timeout.
+     * @return @c true if @c wakeupCursor was reached or the @c Writer closed, else @c false.
+     */
+    bool waitForWriter(Index wakeupCursor, std::chrono::milliseconds timeout);
+
+    /**
+     * This function wakes all @c Readers which are blocked in @c waitForWriter(), so that they can check whether the
+     * data they are waiting for has arrived.
+     */
+    void notifyReaders();
+
 private:
     /**
      * This function calculates a 32-bit stable hash of the provided string.  Note that this hash is just used for
@@ -394,7 +472,7 @@ private:
     AtomicBool* m_readerEnabledArray;
 
     /// Precalculated pointer to the @c Reader cursor array.
-    AtomicIndex* m_readerCursorArray;
+    PaddedIndex* m_readerCursorArray;
 
     /// Precalculated pointer to the @c Reader close @c Index array.
     AtomicIndex* m_readerCloseIndexArray;
@@ -404,6 +482,18 @@ private:
 
     /// Precalculated pointer to the circular data.
     uint8_t* m_data;
+
+    /// The timeline of when words were written to the stream.
+    IndexTimeline m_timeline;
+
+    /// Serializes access to @c m_dataAvailableCallbacks, and calls to the functions in it.
+    std::mutex m_dataAvailableCallbacksMutex;
+
+    /// The functions set with @c setDataAvailableCallback(), by @c Reader id.
+    std::map<size_t, std::function<void()>> m_dataAvailableCallbacks;
+
+    /// Whether @c m_dataAvailableCallbacks is not empty, so that a @c Writer need not lock when it is.
+    std::atomic<bool> m_hasDataAvailableCallbacks;
 };
 
 template <typename T>
@@ -416,7 +506,8 @@ SharedDataStream<T>::BufferLayout::BufferLayout(std::shared_ptr<Buffer> buffer)
         m_readerCursorArray{nullptr},
         m_readerCloseIndexArray{nullptr},
         m_dataSize{0},
-        m_data{nullptr} {
+        m_data{nullptr},
+        m_hasDataAvailableCallbacks{false} {
 }
 
 template <typename T>
@@ -435,7 +526,8 @@ typename SharedDataStream<T>::AtomicBool* SharedDataStream<T>::BufferLayout::get
 }
 
 template <typename T>
-typename SharedDataStream<T>::AtomicIndex* SharedDataStream<T>::BufferLayout::getReaderCursorArray() const {
+typename SharedDataStream<T>::BufferLayout::PaddedIndex* SharedDataStream<T>::BufferLayout::getReaderCursorArray()
+    const {
     return m_readerCursorArray;
 }
 
@@ -454,6 +546,33 @@ uint8_t* SharedDataStream<T>::BufferLayout::getData(Index at) const {
     return m_data + (at % getDataSize()) * getHeader()->wordSize;
 }
 
+template <typename T>
+IndexTimeline& SharedDataStream<T>::BufferLayout::getTimeline() {
+    return m_timeline;
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::setDataAvailableCallback(size_t id, std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_dataAvailableCallbacksMutex);
+    if (callback) {
+        m_dataAvailableCallbacks[id] = std::move(callback);
+    } else {
+        m_dataAvailableCallbacks.erase(id);
+    }
+    m_hasDataAvailableCallbacks = !m_dataAvailableCallbacks.empty();
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::notifyDataAvailableCallbacks() {
+    if (!m_hasDataAvailableCallbacks) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_dataAvailableCallbacksMutex);
+    for (const auto& callback : m_dataAvailableCallbacks) {
+        callback.second();
+    }
+}
+
 template <typename T>
 bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders) {
     // Make sure parameters are not too large to store.
@@ -482,7 +601,7 @@ bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders)
     size_t id;
     for (id = 0; id < maxReaders; ++id) {
         new (m_readerEnabledArray + id) AtomicBool;
-        new (m_readerCursorArray + id) AtomicIndex;
+        new (&m_readerCursorArray[id].index) AtomicIndex;
         new (m_readerCloseIndexArray + id) AtomicIndex;
     }
 
@@ -496,12 +615,13 @@ bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders)
     header->writeStartCursor = 0;
     header->writeEndCursor = 0;
     header->oldestUnconsumedCursor = 0;
+    header->wakeupCursor = std::numeric_limits<Index>::max();
     header->referenceCount = 1;
 
     // Reader arrays initialization.
     for (id = 0; id < maxReaders; ++id) {
         m_readerEnabledArray[id] = false;
-        m_readerCursorArray[id] = 0;
+        m_readerCursorArray[id].index = 0;
         m_readerCloseIndexArray[id] = 0;
     }
 
@@ -562,16 +682,19 @@ void SharedDataStream<T>::BufferLayout::detach() {
     }
 
     auto header = getHeader();
-    std::lock_guard<Mutex> lock(header->attachMutex);
+    std::unique_lock<Mutex> lock(header->attachMutex);
     --header->referenceCount;
     if (header->referenceCount > 0) {
         return;
     }
 
+    // Nothing else is attached, and attachMutex is destroyed with the Header below, so it must be released first.
+    lock.unlock();
+
     // Destruction of reader arrays.
     for (size_t id = 0; id < header->maxReaders; ++id) {
         m_readerCloseIndexArray[id].~AtomicIndex();
-        m_readerCursorArray[id].~AtomicIndex();
+        m_readerCursorArray[id].index.~AtomicIndex();
         m_readerEnabledArray[id].~AtomicBool();
     }
 
@@ -596,12 +719,60 @@ void SharedDataStream<T>::BufferLayout::disableReaderLocked(size_t id) {
 
 template <typename T>
 typename SharedDataStream<T>::Index SharedDataStream<T>::BufferLayout::wordsUntilWrap(Index after) const {
-    return alignSizeTo(after, getDataSize()) - after;
+    return getDataSize() - (after % getDataSize());
 }
 
 template <typename T>
 size_t SharedDataStream<T>::BufferLayout::calculateDataOffset(size_t wordSize, size_t maxReaders) {
-    return alignSizeTo(calculateReaderCloseIndexArrayOffset(maxReaders) + (maxReaders * sizeof(AtomicIndex)), wordSize);
+    // The data is aligned to both words and cache lines, so to their least common multiple.
+    size_t divisor = CACHE_LINE_SIZE;
+    size_t remainder = wordSize;
+    while (remainder) {
+        auto next = divisor % remainder;
+        divisor = remainder;
+        remainder = next;
+    }
+    size_t alignment = CACHE_LINE_SIZE / divisor * wordSize;
+    size_t arraysEnd = calculateReaderCloseIndexArrayOffset(maxReaders) + (maxReaders * sizeof(AtomicIndex));
+    return alignSizeTo(arraysEnd, alignment);
+}
+
+template <typename T>
+bool SharedDataStream<T>::BufferLayout::waitForWriter(Index wakeupCursor, std::chrono::milliseconds timeout) {
+    auto header = getHeader();
+    auto isReady = [header, wakeupCursor] {
+        return header->writeStartCursor >= wakeupCursor || (header->writeEndCursor > 0 && !header->isWriterEnabled);
+    };
+    // A Writer resets wakeupCursor when it notifies, so a woken Reader which is still waiting must publish it again.
+    auto isNotified = [header, wakeupCursor, &isReady] { return isReady() || header->wakeupCursor > wakeupCursor; };
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<Mutex> lock(header->dataAvailableMutex);
+    while (!isReady()) {
+        // Publish the cursor we are waiting for, then check again in case a Writer moved past it before seeing it.
+        if (wakeupCursor < header->wakeupCursor) {
+            header->wakeupCursor = wakeupCursor;
+        }
+        if (isReady()) {
+            break;
+        }
+        if (std::chrono::milliseconds::zero() == timeout) {
+            header->dataAvailableConditionVariable.wait(lock, isNotified);
+        } else if (!header->dataAvailableConditionVariable.wait_for(
+                       lock, deadline - std::chrono::steady_clock::now(), isNotified)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::notifyReaders() {
+    auto header = getHeader();
+    {
+        std::lock_guard<Mutex> lock(header->dataAvailableMutex);
+        header->wakeupCursor = std::numeric_limits<Index>::max();
+    }
+    header->dataAvailableConditionVariable.notify_all();
 }
 
 template <typename T>
@@ -632,8 +803,8 @@ void SharedDataStream<T>::BufferLayout::updateOldestUnconsumedCursorLocked() {
         // - if a reader becomes re-enabled, its cursor defaults to writeCursor (which will never be the oldest)
         // - if a reader is created that wants to be at an older index, it gets there by doing a backward seek (which
         //   is locked when this function is called)
-        if (isReaderEnabled(id) && getReaderCursorArray()[id] < oldest) {
-            oldest = getReaderCursorArray()[id];
+        if (isReaderEnabled(id) && getReaderCursorArray()[id].index < oldest) {
+            oldest = getReaderCursorArray()[id].index;
         }
     }
 
@@ -677,19 +848,19 @@ size_t SharedDataStream<T>::BufferLayout::calculateReaderEnabledArrayOffset() {
 
 template <typename T>
 size_t SharedDataStream<T>::BufferLayout::calculateReaderCursorArrayOffset(size_t maxReaders) {
-    return alignSizeTo(calculateReaderEnabledArrayOffset() + (maxReaders * sizeof(AtomicBool)), alignof(AtomicIndex));
+    return alignSizeTo(calculateReaderEnabledArrayOffset() + (maxReaders * sizeof(AtomicBool)), CACHE_LINE_SIZE);
 }
 
 template <typename T>
 size_t SharedDataStream<T>::BufferLayout::calculateReaderCloseIndexArrayOffset(size_t maxReaders) {
-    return calculateReaderCursorArrayOffset(maxReaders) + (maxReaders * sizeof(AtomicIndex));
+    return calculateReaderCursorArrayOffset(maxReaders) + (maxReaders * sizeof(PaddedIndex));
 }
 
 template <typename T>
 void SharedDataStream<T>::BufferLayout::calculateAndCacheConstants(size_t wordSize, size_t maxReaders) {
     auto buffer = reinterpret_cast<uint8_t*>(m_buffer->data());
     m_readerEnabledArray = reinterpret_cast<AtomicBool*>(buffer + calculateReaderEnabledArrayOffset());
-    m_readerCursorArray = reinterpret_cast<AtomicIndex*>(buffer + calculateReaderCursorArrayOffset(maxReaders));
+    m_readerCursorArray = reinterpret_cast<PaddedIndex*>(buffer + calculateReaderCursorArrayOffset(maxReaders));
     m_readerCloseIndexArray = reinterpret_cast<AtomicIndex*>(buffer + calculateReaderCloseIndexArrayOffset(maxReaders));
     m_dataSize = (m_buffer->size() - calculateDataOffset(wordSize, maxReaders)) / wordSize;
     m_data = buffer + calculateDataOffset(wordSize, maxReaders);
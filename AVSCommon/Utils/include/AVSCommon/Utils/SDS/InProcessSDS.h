@@ -24,6 +24,7 @@
 #include <condition_variable>
 #include <string>
 
+#include "AVSCommon/Utils/Memory/LockedAllocator.h"
 #include "SharedDataStream.h"
 
 namespace alexaClientSDK {
@@ -39,8 +40,11 @@ struct InProcessSDSTraits {
     /// C++11 std::atomic is sufficient for in-process atomic variables.
     using AtomicBool = std::atomic<bool>;
 
-    /// A std::vector provides a simple container to hold a buffer for in-process usage.
-    using Buffer = std::vector<uint8_t>;
+    /**
+     * A std::vector provides a simple container to hold a buffer for in-process usage.  Its allocator can give it
+     * memory which is locked and pre-faulted, for streams which must never wait for a page fault.
+     */
+    using Buffer = std::vector<uint8_t, memory::LockedAllocator<uint8_t>>;
 
     /// A std::mutex provides a lock which will work for in-process usage.
     using Mutex = std::mutex;
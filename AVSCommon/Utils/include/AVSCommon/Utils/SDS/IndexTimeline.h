@@ -0,0 +1,137 @@
+/*
+ * IndexTimeline.h
+ *
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_INDEX_TIMELINE_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_INDEX_TIMELINE_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/**
+ * A sparse timeline of the times at which words were written to a @c SharedDataStream, kept as a ring of the most
+ * recent (@c Index, @c std::chrono::steady_clock::time_point) entries, one per write.  Lookups in either direction are
+ * a binary search of the ring, interpolating between the entries either side of the value looked up, and
+ * extrapolating at the rate of the last two entries past the end of the timeline.
+ *
+ * This class is thread-safe.
+ */
+class IndexTimeline {
+public:
+    /// The type of stream indexes, which matches @c SharedDataStream::Index.
+    using Index = uint64_t;
+
+    /// The default number of entries kept, which is about ten seconds of 10ms writes.
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    /**
+     * Constructor.
+     *
+     * @param capacity The number of entries to keep.  Older entries are dropped when it is reached.
+     */
+    explicit IndexTimeline(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Records the time at which a word was written.  Entries which do not advance both the index and the time of the
+     * last entry are ignored, so the timeline stays ordered.
+     *
+     * @param index The index of the word.
+     * @param time The time it was written.
+     */
+    void record(Index index, std::chrono::steady_clock::time_point time);
+
+    /**
+     * Looks up the time at which a word was written.
+     *
+     * @param index The index of the word.
+     * @param[out] time The time at which it was written.
+     * @return @c false if @c index precedes the timeline, or the timeline has a single entry which is not for
+     *     @c index, else @c true.
+     */
+    bool getTime(Index index, std::chrono::steady_clock::time_point* time) const;
+
+    /**
+     * Looks up the word which was being written at a time.
+     *
+     * @param time The time.
+     * @param[out] index The index of the word written at @c time.
+     * @return @c false if @c time precedes the timeline, or the timeline has a single entry which is not at @c time,
+     *     else @c true.
+     */
+    bool getIndex(std::chrono::steady_clock::time_point time, Index* index) const;
+
+    /// Removes all the entries.
+    void clear();
+
+private:
+    /// An entry in the timeline.
+    struct Entry {
+        /// The index of the first word of a write.
+        Index index;
+
+        /// The time of the write.
+        std::chrono::steady_clock::time_point time;
+    };
+
+    /**
+     * Gets an entry by its position in the timeline.  This must be called with @c m_mutex held.
+     *
+     * @param position The position, from zero for the oldest entry.
+     * @return The entry.
+     */
+    const Entry& entryLocked(size_t position) const;
+
+    /**
+     * Finds the pair of entries to interpolate or extrapolate between for a lookup.  This must be called with
+     * @c m_mutex held.
+     *
+     * @param isAtOrBefore Whether an entry is at or before the value looked up.  This must be @c true for a prefix of
+     *     the timeline and @c false for the rest.
+     * @param[out] first The earlier entry.
+     * @param[out] second The later entry, which is the same as @c first if the timeline has a single entry.
+     * @return @c false if the value precedes the timeline, else @c true.
+     */
+    template <typename Predicate>
+    bool findSegmentLocked(Predicate isAtOrBefore, const Entry** first, const Entry** second) const;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The ring of entries.
+    std::vector<Entry> m_entries;
+
+    /// The position in @c m_entries of the oldest entry.
+    size_t m_oldest;
+
+    /// The number of entries in the ring.
+    size_t m_size;
+};
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_INDEX_TIMELINE_H_
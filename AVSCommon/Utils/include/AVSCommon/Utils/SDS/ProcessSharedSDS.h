@@ -0,0 +1,262 @@
+/*
+ * ProcessSharedSDS.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_PROCESS_SHARED_SDS_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_PROCESS_SHARED_SDS_H_
+
+#include <pthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "SharedDataStream.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+// Atomics are placed in memory shared between processes, so they must not rely on a per-process lock.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "ProcessSharedSDS requires lock-free 64-bit atomics");
+static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "ProcessSharedSDS requires lock-free boolean atomics");
+
+/**
+ * Structure for specifying the traits of a SharedDataStream which works between processes.  The @c Buffer is a named
+ * POSIX shared memory object; one process creates it with @c Buffer::create() and passes it to
+ * @c SharedDataStream::create(), and other processes map it with @c Buffer::open() and pass it to
+ * @c SharedDataStream::open().  Writers and readers in any of the processes then access the stream data in place.
+ */
+struct ProcessSharedSDSTraits {
+    /// Lock-free C++11 std::atomic variables are address-free, so they work in memory shared between processes.
+    using AtomicIndex = std::atomic<uint64_t>;
+
+    /// Lock-free C++11 std::atomic variables are address-free, so they work in memory shared between processes.
+    using AtomicBool = std::atomic<bool>;
+
+    class Buffer;
+    class Mutex;
+    class ConditionVariable;
+
+    /// A unique identifier representing this combination of traits.
+    static constexpr const char* traitsName = "alexaClientSDK::avsCommon::utils::sds::ProcessSharedSDSTraits";
+};
+
+/**
+ * A buffer backed by a named POSIX shared memory object (@c shm_open() and @c mmap()).  Each process which maps the
+ * object holds its own @c Buffer instance, and the mapping may be at a different address in each process.
+ */
+class ProcessSharedSDSTraits::Buffer {
+public:
+    /**
+     * Create and map a new shared memory object.  If an object with the same name was left behind by a process which
+     * exited without destroying its @c Buffer, it is replaced.
+     *
+     * @param name The name of the shared memory object; a string starting with '/' and containing no other '/'.
+     * @param size The size (in bytes) of the buffer.
+     * @return The new @c Buffer, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<Buffer> create(const std::string& name, size_t size);
+
+    /**
+     * Map an existing shared memory object.
+     *
+     * @param name The name the shared memory object was created with.
+     * @return The @c Buffer, or @c nullptr if it could not be opened.
+     */
+    static std::shared_ptr<Buffer> open(const std::string& name);
+
+    /**
+     * Destructor.  Unmaps the shared memory.  If this @c Buffer created the shared memory object, its name is also
+     * removed, so no new processes can open it; processes which already have it mapped are unaffected.
+     */
+    ~Buffer();
+
+    /**
+     * Get the buffer size.
+     *
+     * @return The size (in bytes) of the buffer.
+     */
+    size_t size() const;
+
+    /**
+     * Get a pointer to the raw data buffer.
+     *
+     * @return A pointer to the mapped shared memory.
+     */
+    uint8_t* data();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param name The name of the shared memory object.
+     * @param data The mapped shared memory.
+     * @param size The size (in bytes) of the mapped shared memory.
+     * @param isOwner Whether this @c Buffer created the shared memory object, and should remove its name when
+     *     destroyed.
+     */
+    Buffer(const std::string& name, uint8_t* data, size_t size, bool isOwner);
+
+    /// The name of the shared memory object.
+    const std::string m_name;
+
+    /// The mapped shared memory.
+    uint8_t* const m_data;
+
+    /// The size (in bytes) of the mapped shared memory.
+    const size_t m_size;
+
+    /// Whether this @c Buffer created the shared memory object.
+    const bool m_isOwner;
+};
+
+/**
+ * A process-shared, robust mutex.  If a process dies while holding the lock, the next process to lock it recovers
+ * ownership instead of deadlocking.
+ */
+class ProcessSharedSDSTraits::Mutex {
+public:
+    /// Constructor.
+    Mutex();
+
+    /// Destructor.
+    ~Mutex();
+
+    /// Lock the mutex.
+    void lock();
+
+    /// Unlock the mutex.
+    void unlock();
+
+private:
+    /// Deleted copy constructor.
+    Mutex(const Mutex&) = delete;
+
+    /// Deleted assignment operator.
+    Mutex& operator=(const Mutex&) = delete;
+
+    /**
+     * Handle the result of a call which acquired @c m_mutex, marking it consistent again if its previous owner died.
+     *
+     * @param result The value returned by the pthread call.
+     * @param event The event string to log failures with.
+     */
+    void handleLockResult(int result, const std::string& event);
+
+    /// The underlying mutex.
+    pthread_mutex_t m_mutex;
+
+    /// The condition variable waits on the underlying mutex.
+    friend class ProcessSharedSDSTraits::ConditionVariable;
+};
+
+/// A process-shared condition variable which works with @c ProcessSharedSDSTraits::Mutex.
+class ProcessSharedSDSTraits::ConditionVariable {
+public:
+    /// Constructor.
+    ConditionVariable();
+
+    /// Destructor.
+    ~ConditionVariable();
+
+    /// Notify all waiters.
+    void notify_all();
+
+    /// Notify one waiter.
+    void notify_one();
+
+    /**
+     * Wait for a notification.
+     *
+     * @param lock The held lock to release while waiting.
+     */
+    void wait(std::unique_lock<Mutex>& lock);
+
+    /**
+     * Wait for @c pred to be true.
+     *
+     * @param lock The held lock to release while waiting.
+     * @param pred The predicate to wait for.
+     */
+    template <class Predicate>
+    void wait(std::unique_lock<Mutex>& lock, Predicate pred);
+
+    /**
+     * Wait until timeout for @c pred to be true.
+     *
+     * @param lock The held lock to release while waiting.
+     * @param relTime The maximum time to wait.
+     * @param pred The predicate to wait for.
+     * @return The value of @c pred when the wait ended.
+     */
+    template <class Rep, class Period, class Predicate>
+    bool wait_for(std::unique_lock<Mutex>& lock, const std::chrono::duration<Rep, Period>& relTime, Predicate pred);
+
+private:
+    /// Deleted copy constructor.
+    ConditionVariable(const ConditionVariable&) = delete;
+
+    /// Deleted assignment operator.
+    ConditionVariable& operator=(const ConditionVariable&) = delete;
+
+    /**
+     * Wait for a notification, or until @c deadline.
+     *
+     * @param lock The held lock to release while waiting.
+     * @param deadline The time to stop waiting at.
+     * @return @c false if @c deadline was reached, else @c true.
+     */
+    bool waitUntil(std::unique_lock<Mutex>& lock, std::chrono::steady_clock::time_point deadline);
+
+    /// The underlying condition variable.
+    pthread_cond_t m_cond;
+};
+
+template <class Predicate>
+void ProcessSharedSDSTraits::ConditionVariable::wait(std::unique_lock<Mutex>& lock, Predicate pred) {
+    while (!pred()) {
+        wait(lock);
+    }
+}
+
+template <class Rep, class Period, class Predicate>
+bool ProcessSharedSDSTraits::ConditionVariable::wait_for(
+    std::unique_lock<Mutex>& lock,
+    const std::chrono::duration<Rep, Period>& relTime,
+    Predicate pred) {
+    auto deadline = std::chrono::steady_clock::now() + relTime;
+    while (!pred()) {
+        if (!waitUntil(lock, deadline)) {
+            return pred();
+        }
+    }
+    return true;
+}
+
+/// Type alias for a SharedDataStream which works between processes.
+using ProcessSharedSDS = SharedDataStream<ProcessSharedSDSTraits>;
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_PROCESS_SHARED_SDS_H_
@@ -18,14 +18,18 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_READER_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_READER_H_
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <vector>
 #include <mutex>
 #include <limits>
 #include <cstring>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "AVSCommon/Utils/Threading/AdaptiveSpinWait.h"
 #include "SharedDataStream.h"
 
 namespace alexaClientSDK {
@@ -96,6 +100,14 @@ public:
         };
     };
 
+    /// A contiguous span of the stream's circular buffer.
+    struct Span {
+        /// The start of the span.
+        const void* data;
+        /// The number of @c wordSize words in the span.
+        size_t nWords;
+    };
+
     /**
      * Constructs a new @c Reader which consumes data from the provided @c SharedDataStream.  The caller must hold
      * @c Header::readerEnableMutex when constructing new Readers.
@@ -129,6 +141,33 @@ public:
      */
     ssize_t read(void* buf, size_t nWords, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
 
+    /**
+     * This function gives the caller in-place access to data in the stream, without copying it or consuming it.  It
+     * waits for data exactly as @c read() does, then returns up to @c nWords words as two spans, split where the
+     * circular buffer wraps; the second span is empty (`spans[1].nWords == 0`) if the data does not wrap.  The data
+     * is consumed by a following call to @c advance().
+     *
+     * @param nWords The maximum number of @c wordSize words to return.
+     * @param[out] spans An array of two @c Span which is filled in with the available data.
+     * @param timeout The maximum time to wait (if @c policy is @c BLOCKING) for data, as for @c read().
+     * @return The number of @c wordSize words available in @c spans, or zero if the stream has closed, or a negative
+     *     @c Error code if the stream is still open, but no data is available.
+     *
+     * @note A @c NONBLOCKABLE @c Writer may overwrite the data while the caller is using it.  This is detected, and
+     *     reported by @c advance() returning @c Error::OVERRUN, in which case the data should be discarded.
+     */
+    ssize_t peek(size_t nWords, Span* spans, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * This function consumes data previously returned by @c peek().
+     *
+     * @param nWords The number of words to consume, which may be less than the number returned by @c peek().  Any
+     *     remaining words will be returned again by the next @c peek() or @c read().
+     * @return The number of @c wordSize words consumed, or @c Error::OVERRUN if the data was overwritten while it was
+     *     being used, or @c Error::INVALID if @c nWords is more than was returned by @c peek().
+     */
+    ssize_t advance(size_t nWords);
+
     /**
      * This function moves the @c Reader to the specified location in the stream.  If successful, subsequent calls to
      * @c read() will start from the new location.  For this function to succeed, the specified location *must* point
@@ -151,6 +190,37 @@ public:
      */
     Index tell(Reference reference = Reference::ABSOLUTE) const;
 
+    /**
+     * This function looks up the time at which a word was written to the stream, from the timeline the @c Writer
+     * records.  The timeline is kept by this process, so it does not include writes from other processes.
+     *
+     * @param index The absolute @c Index of the word.
+     * @param[out] time The time at which it was written.
+     * @return @c true if the time is known, else @c false.
+     */
+    bool getTimeOfIndex(Index index, std::chrono::steady_clock::time_point* time) const;
+
+    /**
+     * This function looks up the word which was being written to the stream at a time, from the timeline the
+     * @c Writer records.  The timeline is kept by this process, so it does not include writes from other processes.
+     *
+     * @param time The time.
+     * @param[out] index The absolute @c Index of the word which was being written at @c time.
+     * @return @c true if the @c Index is known, else @c false.
+     */
+    bool getIndexAtTime(std::chrono::steady_clock::time_point time, Index* index) const;
+
+    /**
+     * This function sets a function to call each time a @c Writer in this process commits data to the stream or
+     * closes it, so that a @c Reader which does not block can be read as soon as there is data, rather than polled.
+     * The function is called on the @c Writer's thread, so it must not block, and must not call back into this
+     * @c Reader.  It is removed when this @c Reader is destroyed.
+     *
+     * @param callback The function to call, or an empty function to stop calls.  Once this returns, a function
+     *     which has been replaced is not running and will not be called again.
+     */
+    void setDataAvailableCallback(std::function<void()> callback);
+
     /**
      * This function sets the point at which the @c Reader's stream will close.  With the default parameters, this
      * function will close t he stream immediately, without reading any additional data.  To schedule the stream to
@@ -168,6 +238,26 @@ public:
      */
     void close(Index offset = 0, Reference reference = Reference::AFTER_READER);
 
+    /**
+     * This function sets the minimum number of words a @c BLOCKING @c read() or @c peek() waits for before waking up.
+     * By default, blocking reads return as soon as any data is available; a @c Reader which consumes fixed-size
+     * chunks can set this to its chunk size so that it is not woken for every partial write.  A read still returns
+     * early (with the data which is available) if it times out, if the @c Writer closes, or if the @c Reader's close
+     * index is reached, and never waits for more words than were requested.
+     *
+     * @param nWords The minimum number of @c wordSize words to wait for.  Values less than one are treated as one.
+     */
+    void setWakeupThreshold(size_t nWords);
+
+    /**
+     * This function sets how long a @c BLOCKING @c read() or @c peek() spins for data before it blocks, so that a
+     * latency-critical @c Reader such as a keyword detector picks up each write without waiting to be woken.  Spinning
+     * is off by default.
+     *
+     * @param maxSpin The longest time to spin for.  Zero disables spinning.
+     */
+    void setMaxSpin(std::chrono::microseconds maxSpin);
+
     /**
      * This function returns the id assigned to this @c Reader.  If a @c Reader instance is not destroyed cleanly (e.g.
      * a @c Reader from another process that crashes), its id can be passed to @c SharedDataStream::reset() to free up
@@ -215,6 +305,15 @@ private:
 
     /// Pointer to this reader's close index in BufferLayout::getReaderCloseIndexArray().
     AtomicIndex* m_readerCloseIndex;
+
+    /// The number of words returned by the last @c peek() which have not been passed to @c advance().
+    size_t m_peekedWords;
+
+    /// The minimum number of words a @c BLOCKING @c read() or @c peek() waits for.
+    size_t m_wakeupThreshold;
+
+    /// Spins for data in a @c BLOCKING @c read() or @c peek() before it blocks.
+    threading::AdaptiveSpinWait m_spinWait;
 };
 
 template <typename T>
@@ -225,8 +324,10 @@ SharedDataStream<T>::Reader::Reader(Policy policy, std::shared_ptr<BufferLayout>
         m_policy{policy},
         m_bufferLayout{bufferLayout},
         m_id{id},
-        m_readerCursor{&m_bufferLayout->getReaderCursorArray()[m_id]},
-        m_readerCloseIndex{&m_bufferLayout->getReaderCloseIndexArray()[m_id]} {
+        m_readerCursor{&m_bufferLayout->getReaderCursorArray()[m_id].index},
+        m_readerCloseIndex{&m_bufferLayout->getReaderCloseIndexArray()[m_id]},
+        m_peekedWords{0},
+        m_wakeupThreshold{1} {
     // Note - SharedDataStream::createReader() holds readerEnableMutex while calling this function.
     // Read new data only.
     // Note: It is important that new readers start with their cursor at the writer.  This allows
@@ -245,6 +346,7 @@ SharedDataStream<T>::Reader::~Reader() {
     // Note: It is important that deleted readers do not change their cursor.  This allows
     // updateOldestUnconsumedCursor() to be thread-safe without holding readerEnableMutex.  See
     // updateOldestUnconsumedCursor() comments for further explanation.
+    m_bufferLayout->setDataAvailableCallback(m_id, nullptr);
     std::lock_guard<Mutex> lock(m_bufferLayout->getHeader()->readerEnableMutex);
     m_bufferLayout->disableReaderLocked(m_id);
     m_bufferLayout->updateOldestUnconsumedCursor();
@@ -262,6 +364,36 @@ ssize_t SharedDataStream<T>::Reader::read(void* buf, size_t nWords, std::chrono:
         return Error::INVALID;
     }
 
+    Span spans[2];
+    auto available = peek(nWords, spans, timeout);
+    if (available <= 0) {
+        return available;
+    }
+
+    // Copy the two segments.
+    auto buf8 = static_cast<uint8_t*>(buf);
+    memcpy(buf8, spans[0].data, spans[0].nWords * getWordSize());
+    if (spans[1].nWords > 0) {
+        memcpy(buf8 + (spans[0].nWords * getWordSize()), spans[1].data, spans[1].nWords * getWordSize());
+    }
+
+    return advance(available);
+}
+
+template <typename T>
+ssize_t SharedDataStream<T>::Reader::peek(size_t nWords, Span* spans, std::chrono::milliseconds timeout) {
+    if (nullptr == spans) {
+        logger::acsdkError(logger::LogEntry(TAG, "peekFailed").d("reason", "nullSpans"));
+        return Error::INVALID;
+    }
+
+    if (0 == nWords) {
+        logger::acsdkError(logger::LogEntry(TAG, "peekFailed").d("reason", "invalidNumWords").d("numWords", nWords));
+        return Error::INVALID;
+    }
+
+    m_peekedWords = 0;
+
     // Check if closed.
     auto readerCloseIndex = m_readerCloseIndex->load();
     if (*m_readerCursor >= readerCloseIndex) {
@@ -275,31 +407,36 @@ ssize_t SharedDataStream<T>::Reader::read(void* buf, size_t nWords, std::chrono:
     }
 
     // Figure out how much we can actually copy.
-    std::unique_lock<Mutex> lock(header->dataAvailableMutex, std::defer_lock);
-    if (Policy::BLOCKING == m_policy) {
-        lock.lock();
-    }
     size_t wordsAvailable = tell(Reference::BEFORE_WRITER);
     if (0 == wordsAvailable) {
         if (header->writeEndCursor > 0 && !header->isWriterEnabled) {
             return Error::CLOSED;
         } else if (Policy::NONBLOCKING == m_policy) {
             return Error::WOULDBLOCK;
-        } else if (Policy::BLOCKING == m_policy) {
-            if (std::chrono::milliseconds::zero() == timeout) {
-                header->dataAvailableConditionVariable.wait(
-                    lock, [this] { return tell(Reference::BEFORE_WRITER) > 0; });
-            } else {
-                if (!header->dataAvailableConditionVariable.wait_for(
-                        lock, timeout, [this] { return tell(Reference::BEFORE_WRITER) > 0; })) {
+        }
+    }
+    if (Policy::BLOCKING == m_policy) {
+        // Wait until the wakeup threshold (but no more than was asked for, or than is left before our close index) is
+        // available.
+        Index wakeupCursor = *m_readerCursor + std::min(nWords, m_wakeupThreshold);
+        if (wakeupCursor > readerCloseIndex) {
+            wakeupCursor = readerCloseIndex;
+        }
+        if (header->writeStartCursor < wakeupCursor) {
+            auto isReady = [header, wakeupCursor] {
+                return header->writeStartCursor >= wakeupCursor ||
+                       (header->writeEndCursor > 0 && !header->isWriterEnabled);
+            };
+            bool isWoken = m_spinWait.spinUntil(isReady) || m_bufferLayout->waitForWriter(wakeupCursor, timeout);
+            wordsAvailable = tell(Reference::BEFORE_WRITER);
+            if (0 == wordsAvailable) {
+                if (header->writeEndCursor > 0 && !header->isWriterEnabled) {
+                    return Error::CLOSED;
+                } else if (!isWoken) {
                     return Error::TIMEDOUT;
                 }
             }
         }
-        wordsAvailable = tell(Reference::BEFORE_WRITER);
-    }
-    if (Policy::BLOCKING == m_policy) {
-        lock.unlock();
     }
     if (nWords > wordsAvailable) {
         nWords = wordsAvailable;
@@ -317,22 +454,35 @@ ssize_t SharedDataStream<T>::Reader::read(void* buf, size_t nWords, std::chrono:
     }
     size_t afterWrap = nWords - beforeWrap;
 
-    // Copy the two segments.
-    auto buf8 = static_cast<uint8_t*>(buf);
-    memcpy(buf8, m_bufferLayout->getData(*m_readerCursor), beforeWrap * getWordSize());
-    if (afterWrap > 0) {
-        memcpy(
-            buf8 + (beforeWrap * getWordSize()),
-            m_bufferLayout->getData(*m_readerCursor + beforeWrap),
-            afterWrap * getWordSize());
-    }
+    spans[0].data = m_bufferLayout->getData(*m_readerCursor);
+    spans[0].nWords = beforeWrap;
+    spans[1].data = afterWrap > 0 ? m_bufferLayout->getData(*m_readerCursor + beforeWrap) : nullptr;
+    spans[1].nWords = afterWrap;
 
-    // Advance the read cursor.
-    *m_readerCursor += nWords;
+    m_peekedWords = nWords;
+    return nWords;
+}
+
+template <typename T>
+ssize_t SharedDataStream<T>::Reader::advance(size_t nWords) {
+    if (nWords > m_peekedWords) {
+        logger::acsdkError(logger::LogEntry(TAG, "advanceFailed")
+                               .d("reason", "advanceExceedsPeek")
+                               .d("numWords", nWords)
+                               .d("peekedWords", m_peekedWords));
+        return Error::INVALID;
+    }
+    m_peekedWords = 0;
 
     // Final check for overrun (do this before the updateOldestUnconsumedCursor() call below for improved accuracy).
+    // The check is made against the start of the consumed words, since the writer may have lapped any of them while
+    // they were being used in place.
+    auto header = m_bufferLayout->getHeader();
     bool overrun = ((header->writeEndCursor - *m_readerCursor) > m_bufferLayout->getDataSize());
 
+    // Advance the read cursor.
+    *m_readerCursor += nWords;
+
     // Move the unconsumed cursor before returning.
     m_bufferLayout->updateOldestUnconsumedCursor();
 
@@ -417,6 +567,7 @@ bool SharedDataStream<T>::Reader::seek(Index offset, Reference reference) {
     }
 
     *m_readerCursor = absolute;
+    m_peekedWords = 0;
 
     if (backward) {
         m_bufferLayout->updateOldestUnconsumedCursorLocked();
@@ -445,6 +596,21 @@ typename SharedDataStream<T>::Index SharedDataStream<T>::Reader::tell(Reference
     return std::numeric_limits<Index>::max();
 }
 
+template <typename T>
+bool SharedDataStream<T>::Reader::getTimeOfIndex(Index index, std::chrono::steady_clock::time_point* time) const {
+    return m_bufferLayout->getTimeline().getTime(index, time);
+}
+
+template <typename T>
+bool SharedDataStream<T>::Reader::getIndexAtTime(std::chrono::steady_clock::time_point time, Index* index) const {
+    return m_bufferLayout->getTimeline().getIndex(time, index);
+}
+
+template <typename T>
+void SharedDataStream<T>::Reader::setDataAvailableCallback(std::function<void()> callback) {
+    m_bufferLayout->setDataAvailableCallback(m_id, std::move(callback));
+}
+
 template <typename T>
 void SharedDataStream<T>::Reader::close(Index offset, Reference reference) {
     auto writeStartCursor = &m_bufferLayout->getHeader()->writeStartCursor;
@@ -483,6 +649,16 @@ void SharedDataStream<T>::Reader::close(Index offset, Reference reference) {
     *m_readerCloseIndex = absolute;
 }
 
+template <typename T>
+void SharedDataStream<T>::Reader::setWakeupThreshold(size_t nWords) {
+    m_wakeupThreshold = std::max(nWords, static_cast<size_t>(1));
+}
+
+template <typename T>
+void SharedDataStream<T>::Reader::setMaxSpin(std::chrono::microseconds maxSpin) {
+    m_spinWait.setMaxSpin(maxSpin);
+}
+
 template <typename T>
 size_t SharedDataStream<T>::Reader::getId() const {
     return m_id;
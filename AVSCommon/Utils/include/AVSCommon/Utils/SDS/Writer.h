@@ -18,6 +18,7 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_WRITER_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_SDS_WRITER_H_
 
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <vector>
@@ -81,6 +82,14 @@ public:
         };
     };
 
+    /// A contiguous span of the stream's circular buffer.
+    struct Span {
+        /// The start of the span.
+        void* data;
+        /// The number of @c wordSize words in the span.
+        size_t nWords;
+    };
+
     /**
      * Constructs a new @c Writer which produces data for the provided @c SharedDataStream.
      *
@@ -104,6 +113,31 @@ public:
      */
     ssize_t write(const void* buf, size_t nWords);
 
+    /**
+     * This function reserves space at the end of the stream so the caller can produce data in place, without copying
+     * it from a buffer of its own.  The reserved data is not visible to @c Readers until it is passed to @c commit().
+     * The space is returned as two spans, split where the circular buffer wraps; the second span is empty
+     * (`spans[1].nWords == 0`) if the space does not wrap.  Only one reservation may be outstanding at a time, and
+     * @c write() may not be called while one is.
+     *
+     * @param nWords The number of @c wordSize words to reserve.  As with @c write(), a @c NONBLOCKABLE @c Writer
+     *     reserves at most the size of the buffer, and an @c ALL_OR_NOTHING @c Writer reserves all or nothing.
+     * @param[out] spans An array of two @c Span which is filled in with the reserved space.
+     * @return The number of @c wordSize words reserved, or zero if the stream has closed, or a negative @c Error code
+     *     if the stream is still open, but no space could be reserved.
+     */
+    ssize_t reserve(size_t nWords, Span* spans);
+
+    /**
+     * This function makes data which was produced in place after a @c reserve() call visible to @c Readers.  Any
+     * reserved space beyond @c nWords is released.
+     *
+     * @param nWords The number of words at the start of the reservation to commit.  This may be less than the number
+     *     of words reserved; zero cancels the reservation.
+     * @return The number of @c wordSize words committed, or @c Error::INVALID if @c nWords is more than was reserved.
+     */
+    ssize_t commit(size_t nWords);
+
     /**
      * This function reports the current position of the @c Writer in the stream.
      *
@@ -111,9 +145,29 @@ public:
      */
     Index tell() const;
 
+    /**
+     * This function looks up the time at which a word was written to the stream, from the timeline the @c Writer
+     * records.  The timeline is kept by this process, so it does not include writes from other processes.
+     *
+     * @param index The absolute @c Index of the word.
+     * @param[out] time The time at which it was written.
+     * @return @c true if the time is known, else @c false.
+     */
+    bool getTimeOfIndex(Index index, std::chrono::steady_clock::time_point* time) const;
+
+    /**
+     * This function looks up the word which was being written to the stream at a time, from the timeline the
+     * @c Writer records.  The timeline is kept by this process, so it does not include writes from other processes.
+     *
+     * @param time The time.
+     * @param[out] index The absolute @c Index of the word which was being written at @c time.
+     * @return @c true if the @c Index is known, else @c false.
+     */
+    bool getIndexAtTime(std::chrono::steady_clock::time_point time, Index* index) const;
+
     /**
      * This function closes the @c Writer, such that @c Readers will return 0 when they catch up with the @c Writer,
-     * and subsequent calls to @c write() will return 0.
+     * and subsequent calls to @c write() will return 0.  @c Readers which are blocked waiting for data are woken.
      */
     void close();
 
@@ -144,6 +198,9 @@ private:
     /// The @c BufferLayout to use for writing stream data.
     std::shared_ptr<BufferLayout> m_bufferLayout;
 
+    /// The number of words reserved by the outstanding @c reserve() call, or zero if there is none.
+    size_t m_reservedWords;
+
     /**
      * A flag indicating whether this writer has closed.  This flag prevents trying to disable the writer during
      * destruction after previously having closed the writer.  Usage of this flag must be locked by
@@ -159,6 +216,7 @@ template <typename T>
 SharedDataStream<T>::Writer::Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout) :
         m_policy{policy},
         m_bufferLayout{bufferLayout},
+        m_reservedWords{0},
         m_closed{false} {
     // Note - SharedDataStream::createWriter() holds writerEnableMutex while calling this function.
     auto header = m_bufferLayout->getHeader();
@@ -182,9 +240,40 @@ ssize_t SharedDataStream<T>::Writer::write(const void* buf, size_t nWords) {
         return Error::INVALID;
     }
 
+    Span spans[2];
+    auto reserved = reserve(nWords, spans);
+    if (reserved <= 0) {
+        return reserved;
+    }
+
+    // Copy the two segments.
+    auto buf8 = static_cast<const uint8_t*>(buf);
+    memcpy(spans[0].data, buf8, spans[0].nWords * getWordSize());
+    if (spans[1].nWords > 0) {
+        memcpy(spans[1].data, buf8 + spans[0].nWords * getWordSize(), spans[1].nWords * getWordSize());
+    }
+
+    return commit(reserved);
+}
+
+template <typename T>
+ssize_t SharedDataStream<T>::Writer::reserve(size_t nWords, Span* spans) {
+    if (nullptr == spans) {
+        logger::acsdkError(logger::LogEntry(TAG, "reserveFailed").d("reason", "nullSpans"));
+        return Error::INVALID;
+    }
+    if (0 == nWords) {
+        logger::acsdkError(logger::LogEntry(TAG, "reserveFailed").d("reason", "zeroNumWords"));
+        return Error::INVALID;
+    }
+    if (m_reservedWords > 0) {
+        logger::acsdkError(logger::LogEntry(TAG, "reserveFailed").d("reason", "reservationOutstanding"));
+        return Error::INVALID;
+    }
+
     auto header = m_bufferLayout->getHeader();
     if (!header->isWriterEnabled) {
-        logger::acsdkError(logger::LogEntry(TAG, "writeFailed").d("reason", "writerDisabled"));
+        logger::acsdkError(logger::LogEntry(TAG, "reserveFailed").d("reason", "writerDisabled"));
         return Error::CLOSED;
     }
 
@@ -224,34 +313,47 @@ ssize_t SharedDataStream<T>::Writer::write(const void* buf, size_t nWords) {
     }
     size_t afterWrap = nWords - beforeWrap;
 
-    // Copy the two segments.
-    auto buf8 = static_cast<const uint8_t*>(buf);
-    memcpy(m_bufferLayout->getData(header->writeStartCursor), buf8, beforeWrap * getWordSize());
-    if (afterWrap > 0) {
-        memcpy(
-            m_bufferLayout->getData(header->writeStartCursor + beforeWrap),
-            buf8 + beforeWrap * getWordSize(),
-            afterWrap * getWordSize());
+    spans[0].data = m_bufferLayout->getData(header->writeStartCursor);
+    spans[0].nWords = beforeWrap;
+    spans[1].data = afterWrap > 0 ? m_bufferLayout->getData(header->writeStartCursor + beforeWrap) : nullptr;
+    spans[1].nWords = afterWrap;
+
+    m_reservedWords = nWords;
+    return nWords;
+}
+
+template <typename T>
+ssize_t SharedDataStream<T>::Writer::commit(size_t nWords) {
+    if (nWords > m_reservedWords) {
+        logger::acsdkError(logger::LogEntry(TAG, "commitFailed")
+                               .d("reason", "commitExceedsReservation")
+                               .d("numWords", nWords)
+                               .d("reservedWords", m_reservedWords));
+        return Error::INVALID;
     }
 
-    // Advance the write cursor.
-    // Note: To prevent a race condition and ensure that readers which block on dataAvailableConditionVariable don't
-    // miss a notify, we should always lock the dataAvailableConditionVariable mutex while moving writeStartCursor.  As
-    // an optimization, we skip that lock for NONBLOCKABLE writers under the assumption that they will be writing
-    // continuously, so a missed notification is not significant.
-    // Note: As a further optimization, the lock could be omitted if no blocking readers are in use (ACSDK-251).
-    std::unique_lock<Mutex> dataAvailableLock(header->dataAvailableMutex, std::defer_lock);
-    if (Policy::NONBLOCKABLE == m_policy) {
-        dataAvailableLock.lock();
+    auto header = m_bufferLayout->getHeader();
+    if (nWords < m_reservedWords) {
+        // Release the unused part of the reservation.
+        header->writeEndCursor = header->writeStartCursor + nWords;
     }
-    header->writeStartCursor = header->writeEndCursor.load();
-    if (Policy::NONBLOCKABLE == m_policy) {
-        dataAvailableLock.unlock();
+    m_reservedWords = 0;
+    if (0 == nWords) {
+        return 0;
     }
 
-    // Notify the reader(s).
-    // Note: as an optimization, we could skip this if there are no blocking readers (ACSDK-251).
-    header->dataAvailableConditionVariable.notify_all();
+    // Record when the data was written, then advance the write cursor.
+    m_bufferLayout->getTimeline().record(header->writeStartCursor, std::chrono::steady_clock::now());
+    header->writeStartCursor = header->writeEndCursor.load();
+
+    // Notify the reader(s), but only if a blocked reader is waiting for the data just committed.
+    // Note: Readers lower wakeupCursor before checking writeStartCursor, and this writer advances writeStartCursor
+    // before checking wakeupCursor, so (with sequentially consistent atomics) a reader which is about to block is
+    // guaranteed to either see the new data, or be seen here.
+    if (header->writeStartCursor >= header->wakeupCursor) {
+        m_bufferLayout->notifyReaders();
+    }
+    m_bufferLayout->notifyDataAvailableCallbacks();
 
     return nWords;
 }
@@ -261,6 +363,16 @@ typename SharedDataStream<T>::Index SharedDataStream<T>::Writer::tell() const {
     return m_bufferLayout->getHeader()->writeStartCursor;
 }
 
+template <typename T>
+bool SharedDataStream<T>::Writer::getTimeOfIndex(Index index, std::chrono::steady_clock::time_point* time) const {
+    return m_bufferLayout->getTimeline().getTime(index, time);
+}
+
+template <typename T>
+bool SharedDataStream<T>::Writer::getIndexAtTime(std::chrono::steady_clock::time_point time, Index* index) const {
+    return m_bufferLayout->getTimeline().getIndex(time, index);
+}
+
 template <typename T>
 void SharedDataStream<T>::Writer::close() {
     auto header = m_bufferLayout->getHeader();
@@ -270,6 +382,10 @@ void SharedDataStream<T>::Writer::close() {
     }
     if (header->isWriterEnabled) {
         header->isWriterEnabled = false;
+
+        // Wake blocked readers so they can return the data left in the stream, or report that it has closed.
+        m_bufferLayout->notifyReaders();
+        m_bufferLayout->notifyDataAvailableCallbacks();
     }
     m_closed = true;
 }
@@ -0,0 +1,165 @@
+/*
+ * AdaptiveSpinWait.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_ADAPTIVE_SPIN_WAIT_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_ADAPTIVE_SPIN_WAIT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/**
+ * An @c AdaptiveSpinWait lets a thread which is about to block for a handoff from another thread spin for a bounded
+ * time first, so that a handoff which arrives within microseconds does not pay for the futex sleep and wake.  This
+ * trades CPU for latency, so it is off by default and is meant for the few hops on the path of a dialog.
+ *
+ * The time spun adapts between a floor and the configured maximum: it doubles each time a spin ends with the
+ * condition met, and halves each time the spin gives up, so that a waiter whose handoffs rarely arrive quickly spends
+ * little CPU on them.  Spinning is disabled on single core devices, where it can only delay the thread being waited
+ * for.
+ *
+ * Each waiting role should have an @c AdaptiveSpinWait of its own, since the budget learns the timing of one handoff.
+ * Its methods may be called from any thread.
+ */
+class AdaptiveSpinWait {
+public:
+    /**
+     * Constructor.
+     *
+     * @param maxSpin The longest time to spin for before blocking.  Zero disables spinning.
+     */
+    explicit AdaptiveSpinWait(std::chrono::microseconds maxSpin = std::chrono::microseconds::zero());
+
+    /**
+     * Sets the longest time to spin for before blocking, and restarts the adaptation from it.
+     *
+     * @param maxSpin The longest time to spin for.  Zero disables spinning.
+     */
+    void setMaxSpin(std::chrono::microseconds maxSpin);
+
+    /**
+     * Gets the longest time to spin for before blocking.
+     *
+     * @return The longest time to spin for, which is zero if spinning is disabled.
+     */
+    std::chrono::microseconds getMaxSpin() const;
+
+    /**
+     * Spins until a condition is met or the current budget is spent.  With spinning disabled, this checks the
+     * condition once.
+     *
+     * @param predicate The condition, which must be safe to call repeatedly without any lock held by this method.
+     * @return Whether the condition was met.
+     */
+    template <typename Predicate>
+    bool spinUntil(Predicate predicate);
+
+    /**
+     * Waits on a condition variable until a condition is met, spinning first.  While spinning, @c lock is released
+     * and the condition is checked whenever the mutex can be taken without blocking, so that producers are not held
+     * up.
+     *
+     * @param lock A lock on the mutex which guards the condition, which is held on entry and on return.
+     * @param conditionVariable The condition variable notified when the condition may have been met.
+     * @param predicate The condition, which is only called with @c lock held.
+     */
+    template <typename Predicate>
+    void wait(
+        std::unique_lock<std::mutex>& lock,
+        std::condition_variable& conditionVariable,
+        Predicate predicate);
+
+    /**
+     * Hints to the CPU that the calling thread is spinning, where the CPU supports it.
+     */
+    static void cpuRelax();
+
+private:
+    /**
+     * Adapts the budget to the outcome of a spin.
+     *
+     * @param succeeded Whether the spin ended with its condition met.
+     */
+    void onSpinEnded(bool succeeded);
+
+    /// The longest time to spin for, in nanoseconds.
+    std::atomic<int64_t> m_maxSpinNs;
+
+    /// The time the next spin may take, in nanoseconds.
+    std::atomic<int64_t> m_budgetNs;
+};
+
+template <typename Predicate>
+bool AdaptiveSpinWait::spinUntil(Predicate predicate) {
+    std::chrono::nanoseconds budget(m_budgetNs.load(std::memory_order_relaxed));
+    if (budget <= std::chrono::nanoseconds::zero()) {
+        return predicate();
+    }
+    auto start = std::chrono::steady_clock::now();
+    while (!predicate()) {
+        cpuRelax();
+        if (std::chrono::steady_clock::now() - start >= budget) {
+            onSpinEnded(false);
+            return false;
+        }
+    }
+    onSpinEnded(true);
+    return true;
+}
+
+template <typename Predicate>
+void AdaptiveSpinWait::wait(
+    std::unique_lock<std::mutex>& lock,
+    std::condition_variable& conditionVariable,
+    Predicate predicate) {
+    if (predicate()) {
+        return;
+    }
+    if (m_budgetNs.load(std::memory_order_relaxed) > 0) {
+        lock.unlock();
+        // The spin only succeeds with the lock taken again.
+        auto isMetLocked = [&lock, &predicate] {
+            if (!lock.try_lock()) {
+                return false;
+            }
+            if (predicate()) {
+                return true;
+            }
+            lock.unlock();
+            return false;
+        };
+        if (spinUntil(isMetLocked)) {
+            return;
+        }
+        lock.lock();
+    }
+    conditionVariable.wait(lock, predicate);
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_ADAPTIVE_SPIN_WAIT_H_
@@ -0,0 +1,139 @@
+/*
+ * CopyOnWriteSet.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_COPY_ON_WRITE_SET_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_COPY_ON_WRITE_SET_H_
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/**
+ * A set of values, typically observers, which is read far more often than it is changed.
+ *
+ * The values are held in an immutable vector.  Reading the set takes a snapshot, which only loads the current vector
+ * with @c std::atomic_load and so neither allocates nor waits for writers.  The snapshot stays valid, and unchanged,
+ * however the set changes afterwards, so readers may call out to the values without holding any lock.  Changing the
+ * set copies the vector, changes the copy and publishes it, with writers serialized by a mutex of their own.
+ *
+ * @tparam ValueType The type of the values, which must be equality comparable.
+ */
+template <typename ValueType>
+class CopyOnWriteSet {
+public:
+    /// The type of a snapshot of the values.
+    using Snapshot = std::shared_ptr<const std::vector<ValueType>>;
+
+    /**
+     * Constructs an empty set.
+     */
+    CopyOnWriteSet();
+
+    /**
+     * Adds a value to the set.
+     *
+     * @param value The value to add.
+     * @return Whether the value was added, which it is not if the set already holds it.
+     */
+    bool insert(const ValueType& value);
+
+    /**
+     * Removes a value from the set.
+     *
+     * @param value The value to remove.
+     * @return Whether the value was removed, which it is not if the set did not hold it.
+     */
+    bool erase(const ValueType& value);
+
+    /**
+     * Removes all the values from the set.
+     */
+    void clear();
+
+    /**
+     * Gets the values in the set, in the order they were added.
+     *
+     * @return A snapshot of the values, which is never @c nullptr.
+     */
+    Snapshot snapshot() const;
+
+private:
+    /// Serializes the changes to the set.
+    std::mutex m_writeMutex;
+
+    /// The current values, accessed only with @c std::atomic_load and @c std::atomic_store.
+    Snapshot m_values;
+};
+
+template <typename ValueType>
+CopyOnWriteSet<ValueType>::CopyOnWriteSet() : m_values{std::make_shared<const std::vector<ValueType>>()} {
+}
+
+template <typename ValueType>
+bool CopyOnWriteSet<ValueType>::insert(const ValueType& value) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto values = std::atomic_load(&m_values);
+    if (std::find(values->begin(), values->end(), value) != values->end()) {
+        return false;
+    }
+    auto newValues = std::make_shared<std::vector<ValueType>>();
+    newValues->reserve(values->size() + 1);
+    newValues->assign(values->begin(), values->end());
+    newValues->push_back(value);
+    std::atomic_store(&m_values, Snapshot(std::move(newValues)));
+    return true;
+}
+
+template <typename ValueType>
+bool CopyOnWriteSet<ValueType>::erase(const ValueType& value) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto values = std::atomic_load(&m_values);
+    auto it = std::find(values->begin(), values->end(), value);
+    if (it == values->end()) {
+        return false;
+    }
+    auto newValues = std::make_shared<std::vector<ValueType>>();
+    newValues->reserve(values->size() - 1);
+    newValues->insert(newValues->end(), values->begin(), it);
+    newValues->insert(newValues->end(), it + 1, values->end());
+    std::atomic_store(&m_values, Snapshot(std::move(newValues)));
+    return true;
+}
+
+template <typename ValueType>
+void CopyOnWriteSet<ValueType>::clear() {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    std::atomic_store(&m_values, Snapshot(std::make_shared<const std::vector<ValueType>>()));
+}
+
+template <typename ValueType>
+typename CopyOnWriteSet<ValueType>::Snapshot CopyOnWriteSet<ValueType>::snapshot() const {
+    return std::atomic_load(&m_values);
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_COPY_ON_WRITE_SET_H_
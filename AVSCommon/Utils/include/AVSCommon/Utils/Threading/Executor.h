@@ -18,11 +18,16 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_EXECUTOR_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_EXECUTOR_H_
 
+#include <chrono>
+#include <functional>
 #include <future>
+#include <memory>
 #include <utility>
 
 #include "AVSCommon/Utils/Threading/TaskThread.h"
 #include "AVSCommon/Utils/Threading/TaskQueue.h"
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
+#include "AVSCommon/Utils/Timing/TimerService.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -30,15 +35,79 @@ namespace utils {
 namespace threading {
 
 /**
- * An Executor is used to run callable types asynchronously.
+ * A handle to a task submitted with @c Executor::submitAfter() or @c Executor::submitAt(), with which it can be
+ * cancelled.  A default constructed handle, like the handle of a task which could not be submitted, refers to no task.
+ */
+class DelayedTaskHandle {
+public:
+    /**
+     * Constructs a handle which refers to no task.
+     */
+    DelayedTaskHandle() = default;
+
+    /**
+     * Cancels the task, unless it has already started.
+     *
+     * @return Whether the task was cancelled before it started.
+     */
+    bool cancel();
+
+    /**
+     * Checks whether this handle refers to a task.
+     *
+     * @return Whether this handle refers to a task.
+     */
+    bool isValid() const;
+
+private:
+    friend class Executor;
+
+    /// The state of a delayed task, shared by its handles, its timer and the @c Executor.
+    struct State;
+
+    /**
+     * Constructs a handle to a task.
+     *
+     * @param state The state of the task.
+     */
+    explicit DelayedTaskHandle(std::shared_ptr<State> state);
+
+    /// The state of the task, or @c nullptr.
+    std::shared_ptr<State> m_state;
+};
+
+/**
+ * An Executor is used to run callable types asynchronously.  Tasks are run one at a time, in the order they were
+ * submitted, except for tasks submitted with @c submitToFront(), which run first, and tasks submitted with a
+ * @c Priority, which run before or after the others.  By default an Executor runs its tasks on a thread of its own; it
+ * may instead run them on a shared @c ThreadPool, with the same ordering guarantees.
+ *
+ * Tasks may also be submitted to run after a delay.  Their timers run on a @c TimerService, which hands each task to
+ * this Executor's queue when it is due, so a component needs neither a @c Timer nor a thread of its own to schedule
+ * work on its Executor.
  */
 class Executor {
 public:
+    /// The priority of a task.
+    using Priority = TaskQueue::Priority;
+
     /**
-     * Constructs an Executor.
+     * Constructs an Executor which runs its tasks on the @c ThreadPool set with @c setDefaultThreadPool(), or on a
+     * thread of its own if none is set.
      */
     Executor();
 
+    /**
+     * Constructs an Executor which runs its tasks on a @c ThreadPool.  Tasks are still run one at a time and in order,
+     * but not always on the same thread.
+     *
+     * @param threadPool The @c ThreadPool to run tasks on.  If @c nullptr, the Executor uses a thread of its own.
+     * @param timerService The @c TimerService to wait for delayed tasks on, or @c nullptr for the process-wide one.
+     */
+    explicit Executor(
+        std::shared_ptr<ThreadPool> threadPool,
+        std::shared_ptr<timing::TimerService> timerService = nullptr);
+
     /**
      * Destructs an Executor.
      */
@@ -68,7 +137,49 @@ public:
     auto submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
 
     /**
-     * Wait for any previously submitted tasks to complete.
+     * Submits a callable type to be executed on an Executor thread after the tasks of its priority and above which
+     * were submitted before it.  The future must be checked for validity before waiting on it.
+     *
+     * @param priority The priority of the task.
+     * @param task A callable type representing a task.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future for the return value of the task.
+     */
+    template <typename Task, typename... Args>
+    auto submitWithPriority(Priority priority, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
+    /**
+     * Submits a task to be executed on an Executor thread once a delay has passed.  The task is queued with its
+     * priority when it is due, so it may run later if other tasks are queued ahead of it.  Tasks which are still
+     * waiting when the Executor is shut down are cancelled.
+     *
+     * @param delay How long to wait before queueing the task.
+     * @param task The task.
+     * @param priority The priority to queue the task with.
+     * @return A handle with which the task can be cancelled, which refers to no task if it could not be submitted.
+     */
+    DelayedTaskHandle submitAfter(
+        std::chrono::milliseconds delay,
+        std::function<void()> task,
+        Priority priority = Priority::NORMAL);
+
+    /**
+     * Submits a task to be executed on an Executor thread at a time.  The task is queued with its priority when it is
+     * due, so it may run later if other tasks are queued ahead of it.  Tasks which are still waiting when the Executor
+     * is shut down are cancelled.
+     *
+     * @param when When to queue the task, by the clock of the @c TimerService of this Executor.
+     * @param task The task.
+     * @param priority The priority to queue the task with.
+     * @return A handle with which the task can be cancelled, which refers to no task if it could not be submitted.
+     */
+    DelayedTaskHandle submitAt(
+        timing::TimerService::Clock::time_point when,
+        std::function<void()> task,
+        Priority priority = Priority::NORMAL);
+
+    /**
+     * Wait for any previously submitted tasks to complete.  Delayed tasks which are not yet due are not waited for.
      */
     void waitForSubmittedTasks();
 
@@ -78,22 +189,105 @@ public:
     /// Returns whether or not the executor is shutdown.
     bool isShutdown();
 
+    /**
+     * Sets how long the thread of this Executor spins for a task before it blocks, to shorten the handoff to an
+     * Executor on a latency-critical path.  Spinning is off by default.  This has no effect on an Executor which runs
+     * on a @c ThreadPool, whose tasks are handed off by the pool.
+     *
+     * @param maxSpin The longest time to spin for.  Zero disables spinning.
+     */
+    void setMaxSpin(std::chrono::microseconds maxSpin);
+
+    /**
+     * Sets the @c ThreadPool which Executors constructed with the default constructor run their tasks on.  This lets
+     * processes which run many clients share a few threads between all their components.  Executors which already
+     * exist are not affected.
+     *
+     * @note Tasks of Executors which share a pool can delay each other, and a task which blocks waiting on another
+     *     Executor of the same pool can starve it, so the pool should have enough threads for the tasks that block.
+     *
+     * @param threadPool The @c ThreadPool to use, or @c nullptr for Executors to have threads of their own again.
+     */
+    static void setDefaultThreadPool(std::shared_ptr<ThreadPool> threadPool);
+
 private:
+    /// State shared between a @c ThreadPool backed Executor and the jobs it submits to the @c ThreadPool.
+    struct PoolLane;
+
+    /// State shared between an Executor, the timers of its delayed tasks, and their handles.
+    struct DelayedTasks;
+
+    friend class DelayedTaskHandle;
+
+    /**
+     * Ensures that a job to run the next task is scheduled on the @c ThreadPool, if this Executor uses one.
+     */
+    void onTaskSubmitted();
+
+    /**
+     * Ensures that a job to run the next task of a @c PoolLane is scheduled on its @c ThreadPool.
+     *
+     * @param lane The @c PoolLane, or @c nullptr if the Executor has a thread of its own.
+     */
+    static void scheduleNextPooledTask(const std::shared_ptr<PoolLane>& lane);
+
+    /**
+     * Runs the next task from a @c PoolLane's queue, then schedules another job if one was found.
+     *
+     * @param lane The @c PoolLane to run a task for.
+     */
+    static void runNextPooledTask(std::shared_ptr<PoolLane> lane);
+
+    /**
+     * Queues a delayed task which has become due, unless it was cancelled or its Executor was shut down.  Called on
+     * the @c TimerService thread.
+     *
+     * @param delayedTasks The delayed tasks of the Executor.
+     * @param state The state of the task.
+     */
+    static void onDelayedTaskDue(
+        std::shared_ptr<DelayedTasks> delayedTasks,
+        std::shared_ptr<DelayedTaskHandle::State> state);
+
     /// The queue of tasks to execute.
     std::shared_ptr<TaskQueue> m_taskQueue;
 
+    /// The delayed tasks which are waiting for their time.
+    std::shared_ptr<DelayedTasks> m_delayedTasks;
+
+    /// State used to run tasks on a @c ThreadPool, or @c nullptr if this Executor has a thread of its own.
+    std::shared_ptr<PoolLane> m_poolLane;
+
     /// The thread to execute tasks on. The thread must be declared last to be destructed first.
     std::unique_ptr<TaskThread> m_taskThread;
 };
 
 template <typename Task, typename... Args>
 auto Executor::submit(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    return m_taskQueue->push(task, std::forward<Args>(args)...);
+    auto future = m_taskQueue->push(task, std::forward<Args>(args)...);
+    if (future.valid()) {
+        onTaskSubmitted();
+    }
+    return future;
 }
 
 template <typename Task, typename... Args>
 auto Executor::submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    return m_taskQueue->pushToFront(task, std::forward<Args>(args)...);
+    auto future = m_taskQueue->pushToFront(task, std::forward<Args>(args)...);
+    if (future.valid()) {
+        onTaskSubmitted();
+    }
+    return future;
+}
+
+template <typename Task, typename... Args>
+auto Executor::submitWithPriority(Priority priority, Task task, Args&&... args)
+    -> std::future<decltype(task(args...))> {
+    auto future = m_taskQueue->pushWithPriority(priority, task, std::forward<Args>(args)...);
+    if (future.valid()) {
+        onTaskSubmitted();
+    }
+    return future;
 }
 
 }  // namespace threading
@@ -18,30 +18,86 @@
 #ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_TASK_QUEUE_H_
 #define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_TASK_QUEUE_H_
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <utility>
 
+#include "AVSCommon/Utils/Threading/AdaptiveSpinWait.h"
+
 namespace alexaClientSDK {
 namespace avsCommon {
 namespace utils {
 namespace threading {
 
 /**
- * A TaskQueue contains a queue of tasks to run
+ * A TaskQueue contains a queue of tasks to run.
+ *
+ * Any number of threads may push tasks, but only one thread at a time may pop them.  Pushing is lock-free: each task
+ * is stored, together with its bound arguments and the promise for its result, in a single intrusive node which is
+ * linked onto an atomic stack.  The consumer takes whole stacks at a time and only touches the (uncontended) consumer
+ * mutex itself; producers only take that mutex to wake a consumer which is blocked in @c pop().
+ *
+ * Tasks pushed with @c pushToFront() run first, newest first.  The other tasks run in order of their @c Priority, and
+ * in the order they were pushed within a @c Priority.  A steady stream of higher priority tasks starves lower ones.
  */
 class TaskQueue {
 public:
+    /// The priorities of tasks which are not pushed to the front.
+    enum class Priority {
+        /// Runs before @c NORMAL tasks, such as work on which the user is waiting.
+        HIGH,
+
+        /// The priority of tasks pushed with @c push().
+        NORMAL,
+
+        /// Runs once there are no @c HIGH or @c NORMAL tasks, such as housekeeping.
+        LOW
+    };
+
+    /// The number of values of @c Priority.
+    static const size_t NUM_PRIORITIES = static_cast<size_t>(Priority::LOW) + 1;
+
+    /**
+     * A task which has been popped from a @c TaskQueue.
+     */
+    class QueuedTask {
+    public:
+        /**
+         * Destructor.  Destroying a task which has not been run breaks the promise for its result.
+         */
+        virtual ~QueuedTask() = default;
+
+        /**
+         * Runs the task and fulfills the future returned when it was pushed.  Must be called at most once.
+         */
+        virtual void operator()() = 0;
+
+    private:
+        friend class TaskQueue;
+
+        /// The next task in whichever list currently holds this task.
+        QueuedTask* m_next = nullptr;
+    };
+
     /**
      * Constructs an empty TaskQueue.
      */
     TaskQueue();
 
+    /**
+     * Destructor.  Outstanding tasks are dropped.
+     */
+    ~TaskQueue();
+
     /**
      * Pushes a task on the back of the queue. If the queue is shutdown, the task will be dropped, and an invalid
      * future will be returned.
@@ -66,13 +122,41 @@ public:
     template <typename Task, typename... Args>
     auto pushToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
 
+    /**
+     * Pushes a task behind the tasks of its priority and above. If the queue is shutdown, the task will be dropped,
+     * and an invalid future will be returned.
+     *
+     * @param priority The priority of the task.
+     * @param task A task to push.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future to access the return value of the task. If the queue is shutdown, the task will be
+     *     dropped, and an invalid future will be returned.
+     */
+    template <typename Task, typename... Args>
+    auto pushWithPriority(Priority priority, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
     /**
      * Returns and removes the task at the front of the queue. If there are no tasks, this call will block until there
      * is one. A @c nullptr will be returned if there are no more tasks expected.
      *
      * @returns A task which the caller assumes ownership of, or @c nullptr if the TaskQueue expects no more tasks.
      */
-    std::unique_ptr<std::function<void()>> pop();
+    std::unique_ptr<QueuedTask> pop();
+
+    /**
+     * Returns and removes the task at the front of the queue, without blocking.
+     *
+     * @returns A task which the caller assumes ownership of, or @c nullptr if the queue is empty or shutdown.
+     */
+    std::unique_ptr<QueuedTask> tryPop();
+
+    /**
+     * Sets how long @c pop() spins for a task before it blocks, to shorten the handoff from producers on a
+     * latency-critical queue.  Spinning is off by default.
+     *
+     * @param maxSpin The longest time to spin for.  Zero disables spinning.
+     */
+    void setMaxSpin(std::chrono::microseconds maxSpin);
 
     /**
      * Clears the queue of outstanding tasks and refuses any additional tasks to be pushed onto the queue.
@@ -89,123 +173,227 @@ public:
     bool isShutdown();
 
 private:
-    /// The queue type to use for holding tasks.
-    using Queue = std::deque<std::unique_ptr<std::function<void()>>>;
+    /**
+     * A @c QueuedTask which holds a callable of type @c Callable in place, and a promise for its @c Result.
+     */
+    template <typename Result, typename Callable>
+    class QueuedTaskImpl;
 
     /**
      * Pushes a task on the the queue. If the queue is shutdown, the task will be dropped, and an invalid
      * future will be returned.
      *
-     * @param front If @c true, push to the front of the queue, else push to the back.
-     * @param task A task to push to the front or back of the queue.
+     * @param front If @c true, push to the front of the queue, else push behind the tasks of @c priority and above.
+     * @param priority The priority of the task, unless it is pushed to the front.
+     * @param task A task to push.
      * @param args The arguments to call the task with.
      * @returns A @c std::future to access the return value of the task. If the queue is shutdown, the task will be
      *     dropped, and an invalid future will be returned.
      */
     template <typename Task, typename... Args>
-    auto pushTo(bool front, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+    auto pushTo(bool front, Priority priority, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
+    /**
+     * Links a task onto the front stack or the stack of its priority, and wakes the consumer if it is waiting.
+     *
+     * @param front If @c true, push to the front of the queue, else push behind the tasks of @c priority and above.
+     * @param priority The priority of the task, unless it is pushed to the front.
+     * @param task The task to push.  Ownership passes to the queue only if this method returns @c true.
+     * @return Whether the task was pushed.  Tasks are refused once the queue is shutdown.
+     */
+    bool pushQueuedTask(bool front, Priority priority, QueuedTask* task);
+
+    /**
+     * Checks whether any task has been pushed which the consumer has not taken yet.
+     *
+     * @return Whether any of the stacks holds a task.
+     */
+    bool hasPushedTasks() const;
+
+    /**
+     * Removes the next task to run, moving newly pushed tasks into the consumer's lists first.  @c m_consumerMutex
+     * must be held.
+     *
+     * @return The next task, or @c nullptr if the queue is empty.
+     */
+    std::unique_ptr<QueuedTask> takeNextLocked();
+
+    /**
+     * Drops all outstanding tasks.  @c m_consumerMutex must be held.
+     */
+    void clearLocked();
+
+    /**
+     * Reverses a list of tasks linked through @c QueuedTask::m_next.
+     *
+     * @param list The first task in the list.
+     * @return The first task in the reversed list.
+     */
+    static QueuedTask* reverseList(QueuedTask* list);
+
+    /**
+     * Deletes a list of tasks linked through @c QueuedTask::m_next.
+     *
+     * @param list The first task in the list.
+     */
+    static void deleteList(QueuedTask* list);
 
-    /// The queue of tasks
-    Queue m_queue;
+    /// Tasks pushed to the front which the consumer has not taken yet, newest first.
+    std::atomic<QueuedTask*> m_frontStack;
+
+    /// Tasks of each @c Priority which the consumer has not taken yet, newest first.
+    std::array<std::atomic<QueuedTask*>, NUM_PRIORITIES> m_priorityStacks;
+
+    /// Tasks taken from @c m_frontStack, in the order they will run.  Owned by the consumer.
+    QueuedTask* m_frontList;
+
+    /// Tasks taken from each of @c m_priorityStacks, in the order they will run.  Owned by the consumer.
+    std::array<QueuedTask*, NUM_PRIORITIES> m_priorityLists;
+
+    /// Serializes consumers, and @c shutdown(), with each other.
+    std::mutex m_consumerMutex;
 
     /// A condition variable to wait for new tasks to be placed on the queue.
     std::condition_variable m_queueChanged;
 
-    /// A mutex to protect access to the tasks in m_queue.
-    std::mutex m_queueMutex;
+    /// Spins for a task in @c pop() before it waits on @c m_queueChanged.
+    AdaptiveSpinWait m_spinWait;
+
+    /// Whether a consumer is, or is about to be, waiting on @c m_queueChanged.
+    std::atomic_bool m_consumerWaiting;
 
     /// A flag for whether or not the queue is expecting more tasks.
     std::atomic_bool m_shutdown;
 };
 
+template <typename Result, typename Callable>
+class TaskQueue::QueuedTaskImpl : public TaskQueue::QueuedTask {
+public:
+    /**
+     * Constructor.
+     *
+     * @param callable The callable to run.
+     */
+    explicit QueuedTaskImpl(Callable&& callable) : m_hasCallable{true} {
+        new (&m_callableStorage) Callable(std::move(callable));
+    }
+
+    /// Destructor.
+    ~QueuedTaskImpl() override {
+        destroyCallable();
+    }
+
+    /**
+     * Get the future for this task's result.
+     *
+     * @return The future for this task's result.
+     */
+    std::future<Result> getFuture() {
+        return m_promise.get_future();
+    }
+
+    /// @name QueuedTask method.
+    /// @{
+    void operator()() override {
+        invoke(std::is_void<Result>());
+    }
+    /// @}
+
+private:
+    /**
+     * Runs a callable which returns a value.
+     *
+     * The callable (and anything it holds, such as bound @c std::shared_ptr arguments) is destroyed before the promise
+     * is fulfilled, so that a caller waiting on the future knows the task's resources have been released.  A result
+     * which is a reference is passed on as one.
+     */
+    void invoke(std::false_type) {
+        try {
+            Result result = callable()();
+            destroyCallable();
+            m_promise.set_value(std::forward<Result>(result));
+        } catch (...) {
+            destroyCallable();
+            m_promise.set_exception(std::current_exception());
+        }
+    }
+
+    /**
+     * Runs a callable which returns @c void.  The callable is destroyed before the promise is fulfilled.
+     */
+    void invoke(std::true_type) {
+        try {
+            callable()();
+            destroyCallable();
+            m_promise.set_value();
+        } catch (...) {
+            destroyCallable();
+            m_promise.set_exception(std::current_exception());
+        }
+    }
+
+    /// @return The callable held in @c m_callableStorage.
+    Callable& callable() {
+        return *reinterpret_cast<Callable*>(&m_callableStorage);
+    }
+
+    /// Destroys the callable held in @c m_callableStorage, if it has not been destroyed already.
+    void destroyCallable() {
+        if (m_hasCallable) {
+            m_hasCallable = false;
+            callable().~Callable();
+        }
+    }
+
+    /// In-place storage for the callable.
+    typename std::aligned_storage<sizeof(Callable), alignof(Callable)>::type m_callableStorage;
+
+    /// Whether @c m_callableStorage holds a live callable.
+    bool m_hasCallable;
+
+    /// The promise for the callable's result.
+    std::promise<Result> m_promise;
+};
+
 template <typename Task, typename... Args>
 auto TaskQueue::push(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
     bool front = true;
-    return pushTo(!front, std::forward<Task>(task), std::forward<Args>(args)...);
+    return pushTo(!front, Priority::NORMAL, std::forward<Task>(task), std::forward<Args>(args)...);
 }
 
 template <typename Task, typename... Args>
 auto TaskQueue::pushToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
     bool front = true;
-    return pushTo(front, std::forward<Task>(task), std::forward<Args>(args)...);
+    return pushTo(front, Priority::NORMAL, std::forward<Task>(task), std::forward<Args>(args)...);
 }
 
-/**
- * Utility function which waits for a @c std::future to be fulfilled and forward the result to a @c std::promise.
- *
- * @param promise The @c std::promise to fulfill when @c future is fulfilled.
- * @param future The @c std::future on which to wait for a result to forward to @c promise.
- */
-template <typename T>
-inline static void forwardPromise(std::shared_ptr<std::promise<T>> promise, std::future<T>* future) {
-    promise->set_value(future->get());
-}
-
-/**
- * Specialization of @c forwardPromise() for @c void types.
- *
- * @param promise The @c std::promise to fulfill when @c future is fulfilled.
- * @param future The @c std::future on which to wait before fulfilling @c promise.
- */
-template <>
-inline void forwardPromise<void>(std::shared_ptr<std::promise<void>> promise, std::future<void>* future) {
-    future->get();
-    promise->set_value();
+template <typename Task, typename... Args>
+auto TaskQueue::pushWithPriority(Priority priority, Task task, Args&&... args)
+    -> std::future<decltype(task(args...))> {
+    bool front = true;
+    return pushTo(!front, priority, std::forward<Task>(task), std::forward<Args>(args)...);
 }
 
 template <typename Task, typename... Args>
-auto TaskQueue::pushTo(bool front, Task task, Args&&... args) -> std::future<decltype(task(args...))> {
+auto TaskQueue::pushTo(bool front, Priority priority, Task task, Args&&... args)
+    -> std::future<decltype(task(args...))> {
+    using FutureType = decltype(task(args...));
+    if (m_shutdown) {
+        return std::future<FutureType>();
+    }
+
     // Remove arguments from the tasks type by binding the arguments to the task.
     auto boundTask = std::bind(std::forward<Task>(task), std::forward<Args>(args)...);
 
-    /*
-     * Create a std::packaged_task with the correct return type. The decltype only returns the return value of the
-     * boundTask. The following parentheses make it a function call with the boundTask return type. The package task
-     * will then return a future of the correct type.
-     *
-     * Note: A std::packaged_task fulfills its future *during* the call to operator().  If the user of a
-     * std::packaged_task hands it off to another thread to execute, and then waits on the future, they will be able to
-     * retrieve the return value from the task and know that the task has executed, but they do not know exactly when
-     * the task object has been deleted.  This distinction can be significant if the packaged task is holding onto
-     * resources that need to be freed (through a std::shared_ptr for example).  If the user needs to wait for those
-     * resources to be freed they have no way of knowing how long to wait.  The translated_task lambda below is a
-     * workaround for this limitation.  It executes the packaged task, then disposes of it before passing the task's
-     * return value back to the future that the user is waiting on.
-     */
-    using PackagedTaskType = std::packaged_task<decltype(boundTask())()>;
-    auto packaged_task = std::make_shared<PackagedTaskType>(boundTask);
-
-    // Create a promise/future that we will fulfill when we have cleaned up the task.
-    auto cleanupPromise = std::make_shared<std::promise<decltype(task(args...))>>();
-    auto cleanupFuture = cleanupPromise->get_future();
-
-    // Remove the return type from the task by wrapping it in a lambda with no return value.
-    auto translated_task = [packaged_task, cleanupPromise]() mutable {
-        // Execute the task.
-        packaged_task->operator()();
-        // Note the future for the task's result.
-        auto taskFuture = packaged_task->get_future();
-        // Clean up the task.
-        packaged_task.reset();
-        // Forward the task's result to our cleanup promise/future.
-        forwardPromise(cleanupPromise, &taskFuture);
-    };
-
-    // Release our local reference to packaged task so that the only remaining reference is inside the lambda.
-    packaged_task.reset();
-
-    {
-        std::lock_guard<std::mutex> queueLock{m_queueMutex};
-        if (!m_shutdown) {
-            m_queue.emplace(front ? m_queue.begin() : m_queue.end(), new std::function<void()>(translated_task));
-        } else {
-            using FutureType = decltype(task(args...));
-            return std::future<FutureType>();
-        }
+    // The bound task, its promise and the queue link all live in one allocation.
+    using QueuedTaskType = QueuedTaskImpl<FutureType, decltype(boundTask)>;
+    std::unique_ptr<QueuedTaskType> queuedTask(new QueuedTaskType(std::move(boundTask)));
+    auto future = queuedTask->getFuture();
+    if (!pushQueuedTask(front, priority, queuedTask.get())) {
+        return std::future<FutureType>();
     }
-
-    m_queueChanged.notify_all();
-    return cleanupFuture;
+    queuedTask.release();
+    return future;
 }
 
 }  // namespace threading
@@ -0,0 +1,161 @@
+/*
+ * ThreadFactory.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_THREAD_FACTORY_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_THREAD_FACTORY_H_
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// The roles of the threads of the SDK, each of which may be given its own scheduling policy.
+enum class ThreadRole {
+    /// Threads reading audio from the microphone.
+    AUDIO_CAPTURE,
+
+    /// Threads running keyword detection on the captured audio.
+    KEYWORD_DETECTION,
+
+    /// Threads sending and receiving the messages exchanged with AVS.
+    NETWORK,
+
+    /// Threads sequencing and handling directives, and gathering the context of events.
+    DIALOG,
+
+    /// Threads playing media.
+    MEDIA,
+
+    /// Threads doing everything else, such as timers and executors.
+    BACKGROUND
+};
+
+/**
+ * Creates the threads of the SDK with the name, CPU affinity and scheduling policy of their role, so that the threads
+ * on the path of the audio and of the network can be isolated from background work.
+ *
+ * The policy of each role is read from the "threadPolicy" configuration node when a thread is created, for example:
+ *
+ * @code{.json}
+ * "threadPolicy": {
+ *     "audioCapture": {"cpus": "3", "schedFifoPriority": 20},
+ *     "keywordDetection": {"cpus": "3", "schedFifoPriority": 10},
+ *     "network": {"cpus": "2", "nice": -5},
+ *     "background": {"cpus": "0-1", "nice": 5}
+ * }
+ * @endcode
+ *
+ * The other roles are "dialog" and "media".  A role without a policy keeps the default scheduling of the process.
+ * A policy which can not be applied, such as @c SCHED_FIFO without the required privilege, is logged and skipped.
+ * Names, affinity and priorities are only applied on Linux.
+ *
+ * The threads created by this class are listed by @c getRunningThreads() while they run, so that their resource usage
+ * can be attributed to their roles.
+ */
+class ThreadFactory {
+public:
+    /// The scheduling policy of a role.
+    struct Policy {
+        /// The CPUs the threads may run on, or empty for all of them.
+        std::vector<int> cpus;
+
+        /// The @c SCHED_FIFO priority of the threads, or 0 to keep the default scheduling.
+        int schedFifoPriority;
+
+        /// Whether @c nice is set.  It is not used when @c schedFifoPriority is set.
+        bool hasNice;
+
+        /// The nice value of the threads.
+        int nice;
+    };
+
+    /// A running thread created by @c createThread().
+    struct ThreadInfo {
+        /// The id of the thread in the OS.
+        int tid;
+
+        /// The role of the thread.
+        ThreadRole role;
+
+        /// The name of the thread.
+        std::string name;
+    };
+
+    /**
+     * Create a thread, which applies the name and policy of its role before running its function.
+     *
+     * @param role The role of the thread.
+     * @param name The name of the thread, which the OS truncates to 15 characters.
+     * @param function The function the thread runs.
+     * @return The thread.
+     */
+    static std::thread createThread(ThreadRole role, const std::string& name, std::function<void()> function);
+
+    /**
+     * Apply the name and policy of a role to the calling thread, for threads which are not created by this class.
+     *
+     * @param role The role of the thread.
+     * @param name The name of the thread, which the OS truncates to 15 characters.
+     */
+    static void applyToCurrentThread(ThreadRole role, const std::string& name);
+
+    /**
+     * Get the threads created by @c createThread() which are running.  Only available on Linux.
+     *
+     * @return The running threads, in the order in which they started.
+     */
+    static std::vector<ThreadInfo> getRunningThreads();
+
+    /**
+     * Get the policy of a role from the configuration.
+     *
+     * @param role The role.
+     * @return The policy of the role.
+     */
+    static Policy getPolicy(ThreadRole role);
+
+    /**
+     * Parse a list of CPUs, such as "0,2-3".
+     *
+     * @param cpuList The list of CPUs.
+     * @param[out] cpus The CPUs in the list.
+     * @return Whether the list is valid.
+     */
+    static bool parseCpuList(const std::string& cpuList, std::vector<int>* cpus);
+};
+
+/**
+ * Write a @c ThreadRole value to an @c ostream as a string.
+ *
+ * @param stream The stream to write to.
+ * @param role The value to write.
+ * @return The stream that was passed in and written to.
+ */
+std::ostream& operator<<(std::ostream& stream, ThreadRole role);
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_THREAD_FACTORY_H_
@@ -0,0 +1,120 @@
+/*
+ * ThreadPool.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_THREAD_POOL_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/**
+ * A @c ThreadPool runs jobs on a fixed set of worker threads.  Jobs are started in the order they are submitted, but
+ * may run concurrently with each other.  An @c Executor constructed with a @c ThreadPool uses it to run its tasks one
+ * at a time, which preserves the ordering guarantees of a dedicated @c Executor thread while letting many executors
+ * share a few threads.
+ *
+ * @note Because workers are shared, a job which blocks waiting for another job on the same pool can starve the pool.
+ *     Tasks which block for long periods should run on an @c Executor with a thread of its own.
+ */
+class ThreadPool {
+public:
+    /**
+     * Get the process-wide @c ThreadPool.  It has one worker per hardware thread, and at least two.
+     *
+     * @return The process-wide @c ThreadPool.
+     */
+    static std::shared_ptr<ThreadPool> getDefaultThreadPool();
+
+    /**
+     * Constructor.
+     *
+     * @param numThreads The number of worker threads.  Values less than one are treated as one.
+     */
+    explicit ThreadPool(size_t numThreads);
+
+    /**
+     * Destructor.  Waits for running jobs to complete; jobs which have not started are dropped.
+     */
+    ~ThreadPool();
+
+    /**
+     * Submit a job to be run on one of the worker threads.
+     *
+     * @param job The job to run.
+     * @return Whether the job was accepted.  Jobs are refused after @c shutdown().
+     */
+    bool submit(std::function<void()> job);
+
+    /**
+     * Drop jobs which have not been started, refuse new jobs, and wait for the running jobs to complete.  If called
+     * from a worker thread, that worker is detached rather than joined.
+     */
+    void shutdown();
+
+    /**
+     * Get the number of worker threads.
+     *
+     * @return The number of worker threads.
+     */
+    size_t getNumThreads() const;
+
+    /**
+     * Return whether the calling thread is one of this pool's worker threads.
+     *
+     * @return Whether the calling thread is one of this pool's worker threads.
+     */
+    bool isWorkerThread() const;
+
+private:
+    /// The loop run by each worker thread.
+    void workerLoop();
+
+    /// Serializes access to @c m_jobs and @c m_isShutdown.
+    std::mutex m_mutex;
+
+    /// Notified when a job is submitted, and on shutdown.
+    std::condition_variable m_jobAvailable;
+
+    /// Jobs which have not been started yet.
+    std::deque<std::function<void()>> m_jobs;
+
+    /// Whether @c shutdown() has been called.
+    bool m_isShutdown;
+
+    /// The worker threads.  Serialized by @c m_mutex, since @c shutdown() takes them.
+    std::vector<std::thread> m_workers;
+
+    /// The ids of @c m_workers, which are not modified after construction and so may be read without a lock.
+    std::vector<std::thread::id> m_workerIds;
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_THREADING_THREAD_POOL_H_
@@ -0,0 +1,186 @@
+/*
+ * Clock.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_CLOCK_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_CLOCK_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * The source of time for code which waits, so that tests, benchmarks and soak runs can replace real time with a
+ * @c VirtualClock and advance it instantly.
+ *
+ * Code which measures or waits for a time reads it with @c now() and waits with @c waitUntil() or @c waitFor(), in
+ * place of @c std::chrono::steady_clock and the waits of @c std::condition_variable.  Components take the clock from
+ * @c getDefault() when they are constructed, so a clock set with @c setDefault() applies to those constructed
+ * after it.  The default is the real clock.
+ */
+class Clock {
+public:
+    /// The type of durations, which is that of @c std::chrono::steady_clock.
+    using duration = std::chrono::steady_clock::duration;
+
+    /// The type of points in time, which is that of @c std::chrono::steady_clock.
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /**
+     * Get the clock components use when none is given to them.
+     *
+     * @return The clock set with @c setDefault(), or the real clock.
+     */
+    static std::shared_ptr<Clock> getDefault();
+
+    /**
+     * Set the clock components use when none is given to them.  Components which already exist are not affected.
+     *
+     * @param clock The clock to use, or @c nullptr for the real clock.
+     */
+    static void setDefault(std::shared_ptr<Clock> clock);
+
+    /**
+     * Destructor.
+     */
+    virtual ~Clock() = default;
+
+    /**
+     * Get the current time, for measuring and scheduling.
+     *
+     * @return The current time.
+     */
+    virtual time_point now() const = 0;
+
+    /**
+     * Get the current wall clock time.
+     *
+     * @return The number of seconds since the Unix epoch.
+     */
+    virtual int64_t getUnixTime() const = 0;
+
+    /**
+     * Wait on a condition variable until it is notified or a time is reached, as
+     * @c std::condition_variable::wait_until() does.  As with it, the wait may end early for no reason.
+     *
+     * @param condition The condition variable to wait on.
+     * @param lock A lock on the mutex which guards the state @c condition is notified of.
+     * @param deadline The time to wait until.
+     */
+    virtual void waitUntil(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        time_point deadline) = 0;
+
+    /**
+     * Wait on a condition variable until a predicate holds or a time is reached.
+     *
+     * @tparam Predicate The type of the predicate.
+     * @param condition The condition variable to wait on.
+     * @param lock A lock on the mutex which guards the state the predicate reads.
+     * @param deadline The time to wait until.
+     * @param predicate The predicate, which is called with @c lock held.
+     * @return The value of @c predicate once the wait ends.
+     */
+    template <typename Predicate>
+    bool waitUntil(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        time_point deadline,
+        Predicate predicate);
+
+    /**
+     * Wait on a condition variable until a predicate holds or a duration has elapsed.
+     *
+     * @tparam Rep A type for measuring 'ticks' in a generic @c std::chrono::duration.
+     * @tparam Period A type for representing the number of ticks per second in a generic @c std::chrono::duration.
+     * @tparam Predicate The type of the predicate.
+     * @param condition The condition variable to wait on.
+     * @param lock A lock on the mutex which guards the state the predicate reads.
+     * @param timeout How long to wait.
+     * @param predicate The predicate, which is called with @c lock held.
+     * @return The value of @c predicate once the wait ends.
+     */
+    template <typename Rep, typename Period, typename Predicate>
+    bool waitFor(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        const std::chrono::duration<Rep, Period>& timeout,
+        Predicate predicate);
+};
+
+/**
+ * The real clock: @c std::chrono::steady_clock, and @c std::time() for the wall clock.
+ */
+class RealClock : public Clock {
+public:
+    /**
+     * Get the real clock.
+     *
+     * @return The real clock.
+     */
+    static std::shared_ptr<RealClock> getInstance();
+
+    using Clock::waitUntil;
+
+    time_point now() const override;
+    int64_t getUnixTime() const override;
+    void waitUntil(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, time_point deadline)
+        override;
+};
+
+template <typename Predicate>
+bool Clock::waitUntil(
+    std::condition_variable& condition,
+    std::unique_lock<std::mutex>& lock,
+    time_point deadline,
+    Predicate predicate) {
+    while (!predicate()) {
+        if (now() >= deadline) {
+            return predicate();
+        }
+        waitUntil(condition, lock, deadline);
+    }
+    return true;
+}
+
+template <typename Rep, typename Period, typename Predicate>
+bool Clock::waitFor(
+    std::condition_variable& condition,
+    std::unique_lock<std::mutex>& lock,
+    const std::chrono::duration<Rep, Period>& timeout,
+    Predicate predicate) {
+    auto current = now();
+    auto deadline = time_point::max();
+    if (timeout < std::chrono::duration_cast<std::chrono::duration<Rep, Period>>(time_point::max() - current)) {
+        deadline = current + std::chrono::duration_cast<duration>(timeout);
+    }
+    return waitUntil(condition, lock, deadline, predicate);
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_CLOCK_H_
@@ -32,7 +32,7 @@ namespace timing {
  *
  * For completeness, the expected format of the input string is as follows:
  *
- * YYYY-MM-DDTHH:MM:SS+0000
+ * YYYY-MM-DDTHH:MM:SS+hhmm
  *
  * Where (in order of listing) :
  * Y means year
@@ -41,12 +41,16 @@ namespace timing {
  * H means hour
  * M means minute
  * S means second
+ * hhmm means the offset from UTC in hours and minutes, which may also be negative
  *
  * So, for example:
  *
- * 1986-8-8T21:30:00+0000
+ * 1986-08-08T21:30:00+0000
  *
- * means the year 1986, August 8th, 9:30pm.
+ * means the year 1986, August 8th, 9:30pm UTC.
+ *
+ * The string is parsed without allocating and converted without the C library's timezone functions, so this is
+ * cheap and safe to call from any thread.
  *
  * @param timeString The time string, formatted as described above.
  * @param[out] unixTime The converted time into Unix epoch time.
@@ -55,7 +59,7 @@ namespace timing {
 bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTime);
 
 /**
- * Gets the current time in Unix epoch time, as a 64 bit integer.
+ * Gets the current time in Unix epoch time, as a 64 bit integer, from @c Clock::getDefault().
  *
  * @param[out] currentTime The current time in Unix epoch time, as a 64 bit integer.
  * @return Whether the get time was successful.
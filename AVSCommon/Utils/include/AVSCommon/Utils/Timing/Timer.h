@@ -26,6 +26,9 @@
 #include <thread>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "AVSCommon/Utils/Threading/ThreadFactory.h"
+#include "AVSCommon/Utils/Timing/Clock.h"
+#include "AVSCommon/Utils/Timing/TimerService.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -34,6 +37,14 @@ namespace timing {
 
 /**
  * A @c Timer is used to schedule a callable type to run in the future.
+ *
+ * By default each @c Timer calls its task on a thread of its own.  A @c Timer may instead be backed by a
+ * @c TimerService, in which case its task is called on the service's thread, which is shared with other @c Timer
+ * instances.  This saves a thread per @c Timer, at the cost of tasks on the same service delaying each other, so it
+ * should only be used for tasks that return quickly.
+ *
+ * A @c Timer with a thread of its own waits on the @c Clock which is the default when it is constructed, and one
+ * backed by a @c TimerService on the clock of the service.
  */
 class Timer {
 public:
@@ -63,15 +74,33 @@ public:
     };
 
     /**
-     * Contructs a @c Timer.
+     * Contructs a @c Timer which calls its task on the thread of the @c TimerService set with
+     * @c setDefaultTimerService(), or on a thread of its own if none is set.
      */
     Timer();
 
+    /**
+     * Contructs a @c Timer which calls its task on the thread of a @c TimerService.
+     *
+     * @param timerService The @c TimerService to schedule task calls with.  If @c nullptr, this @c Timer calls its
+     *     task on a thread of its own.
+     */
+    explicit Timer(std::shared_ptr<TimerService> timerService);
+
     /**
      * Destructs a @c Timer.
      */
     ~Timer();
 
+    /**
+     * Sets the @c TimerService which Timers constructed with the default constructor are backed by.  This lets
+     * processes which run many clients share one thread between all their timers.  Timers which already exist are
+     * not affected.
+     *
+     * @param timerService The @c TimerService to use, or @c nullptr for Timers to have threads of their own again.
+     */
+    static void setDefaultTimerService(std::shared_ptr<TimerService> timerService);
+
     /**
      * Submits a callable type (function, lambda expression, bind expression, or another function object) to be
      * executed after an initial delay, and then called repeatedly on a fixed time schedule.  A @c Timer instance
@@ -204,6 +233,37 @@ private:
         size_t maxCount,
         std::function<void()> task);
 
+    /**
+     * Schedules the first task call with @c m_timerService.
+     *
+     * @param delay The non-negative time to wait before making the first @c task call.
+     * @param period The non-negative time to wait between subsequent @c task calls.
+     * @param periodType The type of period to use when making subsequent task calls.
+     * @param maxCount The desired number of times to call task.  @c Timer::FOREVER means to call forever until
+     *     @c stop() is called.
+     * @param task A callable type representing a task.
+     */
+    void startOnTimerService(
+        TimerService::Clock::duration delay,
+        TimerService::Clock::duration period,
+        PeriodType periodType,
+        size_t maxCount,
+        std::function<void()> task);
+
+    /**
+     * Schedules the next task call at @c m_nextCallTime with @c m_timerService.
+     * @note This method must be called while @c m_waitMutex is acquired.
+     */
+    void scheduleNextCallLocked();
+
+    /**
+     * Called on the @c m_timerService thread when a task call is due.
+     *
+     * @param generation The value of @c m_generation when the call was scheduled.  If it no longer matches, the
+     *     @c Timer has been stopped since and the call is ignored.
+     */
+    void onTimerServiceCall(uint64_t generation);
+
     /**
      * The tag associated with log entries from this class.
      */
@@ -226,6 +286,46 @@ private:
      * variable.
      */
     bool m_stopping;
+
+    /// The @c TimerService used to call the task, or @c nullptr if the task is called on @c m_thread.
+    const std::shared_ptr<TimerService> m_timerService;
+
+    /// The clock @c m_thread waits on.
+    const std::shared_ptr<Clock> m_clock;
+
+    /**
+     * The members below are only used with @c m_timerService, and are serialized by @c m_waitMutex.
+     */
+
+    /// Incremented by @c stop() to invalidate task calls which have already been scheduled.
+    uint64_t m_generation;
+
+    /// The id of the most recently scheduled task call.
+    TimerService::Id m_scheduledId;
+
+    /// Whether the task is currently being called.
+    bool m_isCallingTask;
+
+    /// The task to call.
+    std::function<void()> m_task;
+
+    /// The time to wait between task calls.
+    TimerService::Clock::duration m_period;
+
+    /// The type of period to use when making subsequent task calls.
+    PeriodType m_periodType;
+
+    /// The desired number of times to call the task.
+    size_t m_maxCount;
+
+    /// The number of task calls made (or skipped) so far.
+    size_t m_count;
+
+    /// The time at which the next task call is scheduled.
+    TimerService::Clock::time_point m_nextCallTime;
+
+    /// Whether we've drifted off schedule (for @c PeriodType::ABSOLUTE), so that the next task call is skipped.
+    bool m_offSchedule;
 };
 
 template <typename Rep, typename Period, typename Task, typename... Args>
@@ -251,11 +351,6 @@ bool Timer::start(
         return false;
     }
 
-    // Join old timer thread (if any).
-    if (m_thread.joinable()) {
-        m_thread.join();
-    }
-
     // Remove arguments from the task's type by binding the arguments to the task.
     using BoundTaskType = decltype(std::bind(std::forward<Task>(task), std::forward<Args>(args)...));
     auto boundTask = std::make_shared<BoundTaskType>(std::bind(std::forward<Task>(task), std::forward<Args>(args)...));
@@ -263,9 +358,26 @@ bool Timer::start(
     // Remove the return type from the task by wrapping it in a lambda with no return value.
     auto translatedTask = [boundTask]() { boundTask->operator()(); };
 
+    if (m_timerService) {
+        startOnTimerService(
+            std::chrono::duration_cast<TimerService::Clock::duration>(delay),
+            std::chrono::duration_cast<TimerService::Clock::duration>(period),
+            periodType,
+            maxCount,
+            translatedTask);
+        return true;
+    }
+
+    // Join old timer thread (if any).
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
     // Kick off the new timer thread.
-    m_thread = std::thread{
-        std::bind(&Timer::callTask<Rep, Period>, this, delay, period, periodType, maxCount, translatedTask)};
+    m_thread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::BACKGROUND,
+        "acsdk-timer",
+        std::bind(&Timer::callTask<Rep, Period>, this, delay, period, periodType, maxCount, translatedTask));
 
     return true;
 }
@@ -290,11 +402,6 @@ auto Timer::start(const std::chrono::duration<Rep, Period>& delay, Task task, Ar
         return std::future<FutureType>();
     }
 
-    // Join old timer thread (if any).
-    if (m_thread.joinable()) {
-        m_thread.join();
-    }
-
     // Remove arguments from the task's type by binding the arguments to the task.
     auto boundTask = std::bind(std::forward<Task>(task), std::forward<Args>(args)...);
 
@@ -309,10 +416,23 @@ auto Timer::start(const std::chrono::duration<Rep, Period>& delay, Task task, Ar
     // Remove the return type from the task by wrapping it in a lambda with no return value.
     auto translatedTask = [packagedTask]() { packagedTask->operator()(); };
 
-    // Kick off the new timer thread.
     static const size_t once = 1;
-    m_thread = std::thread{
-        std::bind(&Timer::callTask<Rep, Period>, this, delay, delay, PeriodType::ABSOLUTE, once, translatedTask)};
+    if (m_timerService) {
+        auto serviceDelay = std::chrono::duration_cast<TimerService::Clock::duration>(delay);
+        startOnTimerService(serviceDelay, serviceDelay, PeriodType::ABSOLUTE, once, translatedTask);
+        return packagedTask->get_future();
+    }
+
+    // Join old timer thread (if any).
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    // Kick off the new timer thread.
+    m_thread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::BACKGROUND,
+        "acsdk-timer",
+        std::bind(&Timer::callTask<Rep, Period>, this, delay, delay, PeriodType::ABSOLUTE, once, translatedTask));
 
     return packagedTask->get_future();
 }
@@ -325,7 +445,7 @@ void Timer::callTask(
     size_t maxCount,
     std::function<void()> task) {
     // Timepoint to measure delay/period against.
-    auto now = std::chrono::steady_clock::now();
+    auto now = m_clock->now();
 
     // Flag indicating whether we've drifted off schedule.
     bool offSchedule = false;
@@ -336,7 +456,11 @@ void Timer::callTask(
             std::unique_lock<std::mutex> lock(m_waitMutex);
 
             // Wait for stop() or a delay/period to elapse.
-            if (m_waitCondition.wait_until(lock, now + waitTime, [this]() { return m_stopping; })) {
+            if (m_clock->waitUntil(
+                    m_waitCondition,
+                    lock,
+                    now + std::chrono::duration_cast<Clock::duration>(waitTime),
+                    [this]() { return m_stopping; })) {
                 m_stopping = false;
                 m_running = false;
                 return;
@@ -354,7 +478,7 @@ void Timer::callTask(
                 }
 
                 // If the task runtime put us off schedule, skip the next task run.
-                if (now + period < std::chrono::steady_clock::now()) {
+                if (now + period < m_clock->now()) {
                     offSchedule = true;
                 } else {
                     offSchedule = false;
@@ -363,7 +487,7 @@ void Timer::callTask(
 
             case PeriodType::RELATIVE:
                 task();
-                now = std::chrono::steady_clock::now();
+                now = m_clock->now();
                 break;
         }
     }
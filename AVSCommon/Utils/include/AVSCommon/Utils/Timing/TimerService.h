@@ -0,0 +1,158 @@
+/*
+ * TimerService.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_TIMER_SERVICE_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_TIMER_SERVICE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * A @c TimerService runs one-shot tasks at scheduled times on a single dedicated thread.  Pending tasks are kept in
+ * an ordered index so that scheduling and cancelling are O(log n), and the thread only wakes when the earliest task is
+ * due or the earliest deadline changes.
+ *
+ * Tasks run sequentially on the service thread, so they should be short (typically they hand work off to an
+ * @c Executor).  A single process-wide instance is available from @c getInstance(), which lets many @c Timer
+ * instances share one thread instead of starting one thread each.
+ *
+ * Due times are read from a @c timing::Clock, so a service on a @c VirtualClock calls its tasks as the clock is
+ * advanced.
+ */
+class TimerService {
+public:
+    /// Identifies a scheduled task.  Zero is never used as an id.
+    using Id = uint64_t;
+
+    /// The clock whose time points tasks are scheduled at.
+    using Clock = std::chrono::steady_clock;
+
+    /// Value returned from @c schedule() when the task could not be scheduled.
+    static const Id INVALID_ID = 0;
+
+    /**
+     * Get the process-wide @c TimerService.
+     *
+     * @return The process-wide @c TimerService.
+     */
+    static std::shared_ptr<TimerService> getInstance();
+
+    /**
+     * Constructor.  The service thread is started lazily, when the first task is scheduled.
+     *
+     * @param clock The clock to read due times from, or @c nullptr for @c timing::Clock::getDefault().
+     */
+    explicit TimerService(std::shared_ptr<timing::Clock> clock = nullptr);
+
+    /**
+     * Destructor.  Pending tasks are dropped without being called.
+     */
+    ~TimerService();
+
+    /**
+     * Schedule a task to be called once at the specified time.
+     *
+     * @param when The time at which to call @c task.  Times in the past cause @c task to be called as soon as possible.
+     * @param task The task to call.
+     * @return An id that may be passed to @c cancel(), or @c INVALID_ID if @c task could not be scheduled.
+     */
+    Id schedule(Clock::time_point when, std::function<void()> task);
+
+    /**
+     * Cancel a scheduled task.  When this method returns, the task is guaranteed not to be started.  If the task is
+     * currently running on the service thread, this method blocks until it completes, unless it is called from the
+     * service thread itself.
+     *
+     * @param id The id of the task to cancel.
+     * @return @c true if the task was removed before it started, else @c false.
+     */
+    bool cancel(Id id);
+
+    /**
+     * Get the current time of the clock of this service, which due times are compared with.
+     *
+     * @return The current time.
+     */
+    Clock::time_point now() const;
+
+    /**
+     * Return whether the calling thread is this service's thread.
+     *
+     * @return Whether the calling thread is this service's thread.
+     */
+    bool isServiceThread() const;
+
+private:
+    /// Key used to order pending tasks by due time, breaking ties in scheduling order.
+    using Key = std::pair<Clock::time_point, Id>;
+
+    /// The loop run by @c m_thread.
+    void serviceLoop();
+
+    /// The clock due times are read from.
+    const std::shared_ptr<timing::Clock> m_clock;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the earliest deadline changes, when a task completes, and on shutdown.
+    std::condition_variable m_wakeTrigger;
+
+    /// Pending tasks, ordered by due time.
+    std::map<Key, std::function<void()>> m_tasks;
+
+    /// Maps the id of each pending task to its due time, for cancellation.
+    std::unordered_map<Id, Clock::time_point> m_dueTimes;
+
+    /// The id to give to the next task that is scheduled.
+    Id m_nextId;
+
+    /// The id of the task currently running on @c m_thread, or @c INVALID_ID.
+    Id m_runningId;
+
+    /// Whether the service is shutting down.
+    bool m_isShuttingDown;
+
+    /// The id of @c m_thread, readable without holding @c m_mutex.
+    std::atomic<std::thread::id> m_threadId;
+
+    /// The thread that calls the scheduled tasks.
+    std::thread m_thread;
+};
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_TIMER_SERVICE_H_
@@ -0,0 +1,92 @@
+/*
+ * VirtualClock.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_VIRTUAL_CLOCK_H_
+#define ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_VIRTUAL_CLOCK_H_
+
+#include <atomic>
+#include <list>
+
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * A @c Clock which only moves when @c advance() is called, so that code which waits for minutes or hours can be run
+ * in an instant.  Both the time from @c now() and the wall clock move together.
+ *
+ * @c advance() wakes every wait which is in progress on the clock, and the waits whose deadlines have passed end.
+ * To do so without losing a wake, it locks the mutex of each wait, so it must not be called while holding a mutex
+ * which code waiting on the clock uses.  Advancing past several periods of a periodic @c Timer in one step has the
+ * effect a stalled real clock would have, so tests should advance in steps no larger than the periods they expect.
+ */
+class VirtualClock : public Clock {
+public:
+    /**
+     * Constructor.  The clock starts at the current real time.
+     */
+    VirtualClock();
+
+    /**
+     * Move the clock forward, and wake every wait in progress.
+     *
+     * @param delta How far to move the clock.  Negative durations are ignored.
+     */
+    void advance(duration delta);
+
+    using Clock::waitUntil;
+
+    time_point now() const override;
+    int64_t getUnixTime() const override;
+    void waitUntil(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, time_point deadline)
+        override;
+
+private:
+    /// A wait in progress.
+    struct Waiter {
+        /// The mutex the wait holds when it is not blocked.
+        std::mutex* mutex;
+
+        /// The condition variable of the wait.
+        std::condition_variable* condition;
+    };
+
+    /// The time since the start of the clock.
+    std::atomic<duration::rep> m_elapsed;
+
+    /// The time the clock started at.
+    const time_point m_start;
+
+    /// The wall clock time the clock started at, in seconds since the Unix epoch.
+    const int64_t m_startUnixTime;
+
+    /// Serializes access to @c m_waiters.
+    std::mutex m_waitersMutex;
+
+    /// The waits in progress.
+    std::list<Waiter*> m_waiters;
+};
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVS_COMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_TIMING_VIRTUAL_CLOCK_H_
@@ -18,6 +18,7 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCCOMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_UUID_GENERATION_UUID_GENERATION_H_
 #define ALEXA_CLIENT_SDK_AVSCCOMMON_UTILS_INCLUDE_AVS_COMMON_UTILS_UUID_GENERATION_UUID_GENERATION_H_
 
+#include <cstddef>
 #include <string>
 
 namespace alexaClientSDK {
@@ -25,6 +26,9 @@ namespace avsCommon {
 namespace utils {
 namespace uuidGeneration {
 
+/// The size of a buffer holding the text of a UUID and its terminating null character.
+constexpr size_t UUID_BUFFER_SIZE = 37;
+
 /**
  * Generates a variant 1, version 4 universally unique identifier (UUID) consisting of 32 hexadecimal digits.
  * The UUID generated is of the format xxxxxxxx-xxxx-Mxxx-Nxxx-xxxxxxxxxxxx where M indicates the version, and the two
@@ -36,6 +40,13 @@ namespace uuidGeneration {
  */
 const std::string generateUUID();
 
+/**
+ * Generates a UUID as @c generateUUID() does, writing its text into a buffer instead of allocating a string.
+ *
+ * @param[out] out The buffer to write the 36 characters of the UUID and a terminating null character to.
+ */
+void generateUUID(char (&out)[UUID_BUFFER_SIZE]);
+
 }  // namespace uuidGeneration
 }  // namespace utils
 }  // namespace avsCommon
@@ -0,0 +1,82 @@
+/*
+ * AdaptiveSpinWait.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include "AVSCommon/Utils/Threading/AdaptiveSpinWait.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// The budget never falls below the maximum divided by this, so that it can grow again when handoffs speed up.
+static const int64_t MIN_BUDGET_DIVISOR = 16;
+
+/**
+ * Checks whether spinning can help on this device.
+ *
+ * @return Whether more than one core is available.
+ */
+static bool isSpinningUseful() {
+    static const bool useful = std::thread::hardware_concurrency() > 1;
+    return useful;
+}
+
+AdaptiveSpinWait::AdaptiveSpinWait(std::chrono::microseconds maxSpin) : m_maxSpinNs{0}, m_budgetNs{0} {
+    setMaxSpin(maxSpin);
+}
+
+void AdaptiveSpinWait::setMaxSpin(std::chrono::microseconds maxSpin) {
+    int64_t maxSpinNs = 0;
+    if (maxSpin > std::chrono::microseconds::zero() && isSpinningUseful()) {
+        maxSpinNs = std::chrono::duration_cast<std::chrono::nanoseconds>(maxSpin).count();
+    }
+    m_maxSpinNs = maxSpinNs;
+    m_budgetNs = maxSpinNs;
+}
+
+std::chrono::microseconds AdaptiveSpinWait::getMaxSpin() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(m_maxSpinNs.load()));
+}
+
+void AdaptiveSpinWait::cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+void AdaptiveSpinWait::onSpinEnded(bool succeeded) {
+    auto maxSpinNs = m_maxSpinNs.load(std::memory_order_relaxed);
+    auto budgetNs = m_budgetNs.load(std::memory_order_relaxed);
+    int64_t newBudgetNs = 0;
+    if (succeeded) {
+        newBudgetNs = std::min(maxSpinNs, budgetNs * 2);
+    } else {
+        newBudgetNs = std::max(maxSpinNs / MIN_BUDGET_DIVISOR, budgetNs / 2);
+    }
+    // A concurrent setMaxSpin() wins; losing an adaptation step is harmless.
+    m_budgetNs.compare_exchange_strong(budgetNs, newBudgetNs);
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
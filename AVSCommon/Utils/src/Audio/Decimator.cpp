@@ -0,0 +1,146 @@
+/*
+ * Decimator.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "AVSCommon/Utils/Audio/Decimator.h"
+#include "AVSCommon/Utils/Audio/SampleConversion.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("Decimator");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t Decimator::TAPS_PER_PHASE;
+
+/// The cutoff frequency of the filter, as a fraction of the Nyquist frequency of the output.
+static const double CUTOFF_RATIO = 0.9;
+
+/// The number of fractional bits of the filter taps.
+static const int TAP_FRACTION_BITS = 15;
+
+/// The smallest 16-bit sample.
+static const int32_t SAMPLE_MIN = std::numeric_limits<int16_t>::min();
+
+/// The largest 16-bit sample.
+static const int32_t SAMPLE_MAX = std::numeric_limits<int16_t>::max();
+
+/// Pi, for the filter design.
+static const double PI = 3.14159265358979323846;
+
+std::unique_ptr<Decimator> Decimator::create(unsigned int factor) {
+    if (0 == factor) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroFactor"));
+        return nullptr;
+    }
+    return std::unique_ptr<Decimator>(new Decimator(factor));
+}
+
+Decimator::Decimator(unsigned int factor) : m_factor{factor}, m_skip{0} {
+    if (1 == m_factor) {
+        return;
+    }
+
+    // Design a Blackman-windowed sinc filter, normalize it to unity gain at DC, and quantize it.
+    size_t numTaps = TAPS_PER_PHASE * m_factor;
+    double cutoff = CUTOFF_RATIO * 0.5 / m_factor;
+    double center = (numTaps - 1) / 2.0;
+    std::vector<double> taps(numTaps);
+    double sum = 0;
+    for (size_t i = 0; i < numTaps; ++i) {
+        double x = i - center;
+        double sinc = 0 == x ? 2 * cutoff : std::sin(2 * PI * cutoff * x) / (PI * x);
+        double phase = 2 * PI * i / (numTaps - 1);
+        double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);
+        taps[i] = sinc * window;
+        sum += taps[i];
+    }
+    int32_t quantizedSum = 0;
+    m_taps.resize(numTaps);
+    for (size_t i = 0; i < numTaps; ++i) {
+        m_taps[i] = static_cast<int16_t>(std::lround(taps[i] / sum * (1 << TAP_FRACTION_BITS)));
+        quantizedSum += m_taps[i];
+    }
+    // Put the rounding error in the middle taps, so that the gain at DC is exactly one.
+    int32_t error = (1 << TAP_FRACTION_BITS) - quantizedSum;
+    m_taps[numTaps / 2] += static_cast<int16_t>(error / 2);
+    m_taps[(numTaps - 1) / 2] += static_cast<int16_t>(error - error / 2);
+    std::reverse(m_taps.begin(), m_taps.end());
+    reset();
+}
+
+size_t Decimator::getOutputSize(size_t numSamples) const {
+    if (numSamples <= m_skip) {
+        return 0;
+    }
+    return (numSamples - m_skip - 1) / m_factor + 1;
+}
+
+size_t Decimator::process(const int16_t* input, size_t numSamples, int16_t* output) {
+    auto numOutput = getOutputSize(numSamples);
+    if (!input || (!output && numOutput > 0)) {
+        ACSDK_ERROR(LX("processFailed").d("reason", "nullBuffer"));
+        return 0;
+    }
+    if (1 == m_factor) {
+        std::copy(input, input + numSamples, output);
+        return numSamples;
+    }
+
+    auto numTaps = m_taps.size();
+    m_history.insert(m_history.end(), input, input + numSamples);
+    // The window of the sample at index j of the input starts at index j of m_history.
+    for (size_t i = 0; i < numOutput; ++i) {
+        auto window = m_history.data() + m_skip + i * m_factor;
+        int32_t sum = dotProductInt16(window, m_taps.data(), numTaps);
+        sum = (sum + (1 << (TAP_FRACTION_BITS - 1))) >> TAP_FRACTION_BITS;
+        output[i] = static_cast<int16_t>(std::min(std::max(sum, SAMPLE_MIN), SAMPLE_MAX));
+    }
+
+    if (numOutput > 0) {
+        m_skip = m_skip + numOutput * m_factor - numSamples;
+    } else {
+        m_skip -= numSamples;
+    }
+    m_history.erase(m_history.begin(), m_history.end() - (numTaps - 1));
+    return numOutput;
+}
+
+void Decimator::reset() {
+    m_skip = 0;
+    if (!m_taps.empty()) {
+        m_history.assign(m_taps.size() - 1, 0);
+    }
+}
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
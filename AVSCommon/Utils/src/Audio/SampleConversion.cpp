@@ -0,0 +1,249 @@
+/*
+ * SampleConversion.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ACSDK_AUDIO_NEON
+#endif
+
+#include "AVSCommon/Utils/Audio/SampleConversion.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/// The factor which scales a floating point sample in [-1.0, 1.0] to the range of a 16-bit sample.
+static const float FLOAT_SCALE = 32768.0f;
+
+/// The smallest 16-bit sample, as a float.
+static const float FLOAT_MIN = -32768.0f;
+
+/// The largest 16-bit sample, as a float.
+static const float FLOAT_MAX = 32767.0f;
+
+/**
+ * Divide a sum of samples by a number of channels, rounding toward zero as the vector code does.
+ *
+ * @param sum The sum.
+ * @param numChannels The number of channels.
+ * @return The mean.
+ */
+static int16_t mean(int32_t sum, unsigned int numChannels) {
+    return static_cast<int16_t>(sum / static_cast<int32_t>(numChannels));
+}
+
+void convertInt32ToInt16(const int32_t* input, int16_t* output, size_t numSamples) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 8 <= numSamples; i += 8) {
+        __m128i low = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), 16);
+        __m128i high = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 4)), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+    }
+#elif defined(ACSDK_AUDIO_NEON)
+    for (; i + 8 <= numSamples; i += 8) {
+        int16x4_t low = vshrn_n_s32(vld1q_s32(input + i), 16);
+        int16x4_t high = vshrn_n_s32(vld1q_s32(input + i + 4), 16);
+        vst1q_s16(output + i, vcombine_s16(low, high));
+    }
+#endif
+    for (; i < numSamples; ++i) {
+        output[i] = static_cast<int16_t>(input[i] >> 16);
+    }
+}
+
+void convertFloatToInt16(const float* input, int16_t* output, size_t numSamples) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 scale = _mm_set1_ps(FLOAT_SCALE);
+    const __m128 minimum = _mm_set1_ps(FLOAT_MIN);
+    const __m128 maximum = _mm_set1_ps(FLOAT_MAX);
+    for (; i + 8 <= numSamples; i += 8) {
+        __m128 low = _mm_mul_ps(_mm_loadu_ps(input + i), scale);
+        __m128 high = _mm_mul_ps(_mm_loadu_ps(input + i + 4), scale);
+        low = _mm_min_ps(_mm_max_ps(low, minimum), maximum);
+        high = _mm_min_ps(_mm_max_ps(high, minimum), maximum);
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high)));
+    }
+#elif defined(ACSDK_AUDIO_NEON)
+    const float32x4_t scale = vdupq_n_f32(FLOAT_SCALE);
+    for (; i + 8 <= numSamples; i += 8) {
+        // vcvtq_s32_f32() saturates, and vqmovn_s32() saturates again to 16 bits, so no clipping is needed.
+        int32x4_t low = vcvtq_s32_f32(vmulq_f32(vld1q_f32(input + i), scale));
+        int32x4_t high = vcvtq_s32_f32(vmulq_f32(vld1q_f32(input + i + 4), scale));
+        vst1q_s16(output + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+#endif
+    for (; i < numSamples; ++i) {
+        float sample = std::min(std::max(input[i] * FLOAT_SCALE, FLOAT_MIN), FLOAT_MAX);
+        output[i] = static_cast<int16_t>(std::lrint(sample));
+    }
+}
+
+void downmixToMono(const int16_t* input, unsigned int numChannels, int16_t* output, size_t numFrames) {
+    if (numChannels <= 1) {
+        if (0 == numChannels || input == output) {
+            return;
+        }
+        std::copy(input, input + numFrames, output);
+        return;
+    }
+
+    size_t i = 0;
+    if (2 == numChannels) {
+#if defined(__SSE2__)
+        const __m128i ones = _mm_set1_epi16(1);
+        for (; i + 8 <= numFrames; i += 8) {
+            // Add the two channels of each frame, then halve the sums, rounding toward zero.
+            __m128i low = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 2 * i)), ones);
+            __m128i high = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 2 * i + 8)), ones);
+            low = _mm_srai_epi32(_mm_add_epi32(low, _mm_srli_epi32(low, 31)), 1);
+            high = _mm_srai_epi32(_mm_add_epi32(high, _mm_srli_epi32(high, 31)), 1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+        }
+#elif defined(ACSDK_AUDIO_NEON)
+        for (; i + 8 <= numFrames; i += 8) {
+            int16x8x2_t channels = vld2q_s16(input + 2 * i);
+            int32x4_t low = vaddl_s16(vget_low_s16(channels.val[0]), vget_low_s16(channels.val[1]));
+            int32x4_t high = vaddl_s16(vget_high_s16(channels.val[0]), vget_high_s16(channels.val[1]));
+            low = vshrq_n_s32(vaddq_s32(low, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(low), 31))), 1);
+            high =
+                vshrq_n_s32(vaddq_s32(high, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(high), 31))), 1);
+            vst1q_s16(output + i, vcombine_s16(vmovn_s32(low), vmovn_s32(high)));
+        }
+#endif
+    }
+    for (; i < numFrames; ++i) {
+        int32_t sum = 0;
+        for (unsigned int channel = 0; channel < numChannels; ++channel) {
+            sum += input[i * numChannels + channel];
+        }
+        output[i] = mean(sum, numChannels);
+    }
+}
+
+void extractChannel(
+    const int16_t* input,
+    unsigned int numChannels,
+    unsigned int channel,
+    int16_t* output,
+    size_t numFrames) {
+    if (channel >= numChannels) {
+        return;
+    }
+    if (1 == numChannels) {
+        if (input != output) {
+            std::copy(input, input + numFrames, output);
+        }
+        return;
+    }
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (2 == numChannels) {
+        for (; i + 8 <= numFrames; i += 8) {
+            // Each 32-bit lane holds a frame; keep the half with the channel, sign extended.
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 2 * i));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 2 * i + 8));
+            if (0 == channel) {
+                low = _mm_slli_epi32(low, 16);
+                high = _mm_slli_epi32(high, 16);
+            }
+            low = _mm_srai_epi32(low, 16);
+            high = _mm_srai_epi32(high, 16);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+        }
+    } else if (4 == numChannels) {
+        const __m128i shift = _mm_cvtsi32_si128(16 * channel);
+        for (; i + 8 <= numFrames; i += 8) {
+            // Each 64-bit lane holds a frame; shift the channel to the bottom of it, then gather the bottom halves.
+            const __m128i* frames = reinterpret_cast<const __m128i*>(input + 4 * i);
+            __m128i parts[4];
+            for (int part = 0; part < 4; ++part) {
+                parts[part] = _mm_shuffle_epi32(
+                    _mm_srl_epi64(_mm_loadu_si128(frames + part), shift), _MM_SHUFFLE(3, 1, 2, 0));
+            }
+            __m128i low = _mm_unpacklo_epi64(parts[0], parts[1]);
+            __m128i high = _mm_unpacklo_epi64(parts[2], parts[3]);
+            low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+            high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+        }
+    }
+#elif defined(ACSDK_AUDIO_NEON)
+    // The structure loads of NEON de-interleave two, three or four channels as they load.
+    if (2 == numChannels) {
+        for (; i + 8 <= numFrames; i += 8) {
+            vst1q_s16(output + i, vld2q_s16(input + 2 * i).val[channel]);
+        }
+    } else if (3 == numChannels) {
+        for (; i + 8 <= numFrames; i += 8) {
+            vst1q_s16(output + i, vld3q_s16(input + 3 * i).val[channel]);
+        }
+    } else if (4 == numChannels) {
+        for (; i + 8 <= numFrames; i += 8) {
+            vst1q_s16(output + i, vld4q_s16(input + 4 * i).val[channel]);
+        }
+    }
+#endif
+    for (; i < numFrames; ++i) {
+        output[i] = input[i * numChannels + channel];
+    }
+}
+
+int32_t dotProductInt16(const int16_t* a, const int16_t* b, size_t length) {
+    size_t i = 0;
+    int32_t result = 0;
+#if defined(__SSE2__)
+    __m128i sums = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8) {
+        sums = _mm_add_epi32(
+            sums,
+            _mm_madd_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+    }
+    sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+    sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+    result = _mm_cvtsi128_si32(sums);
+#elif defined(ACSDK_AUDIO_NEON)
+    int32x4_t sums = vdupq_n_s32(0);
+    for (; i + 8 <= length; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        sums = vmlal_s16(sums, vget_low_s16(va), vget_low_s16(vb));
+        sums = vmlal_s16(sums, vget_high_s16(va), vget_high_s16(vb));
+    }
+    result = vgetq_lane_s32(sums, 0) + vgetq_lane_s32(sums, 1) + vgetq_lane_s32(sums, 2) + vgetq_lane_s32(sums, 3);
+#endif
+    for (; i < length; ++i) {
+        result += static_cast<int32_t>(a[i]) * b[i];
+    }
+    return result;
+}
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,73 @@
+/*
+ * Clock.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <ctime>
+
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * Get the storage of the @c Clock set with @c Clock::setDefault().  It is only accessed with @c std::atomic_load()
+ * and @c std::atomic_store().
+ *
+ * @return The storage of the default @c Clock.
+ */
+static std::shared_ptr<Clock>& defaultClock() {
+    static std::shared_ptr<Clock> clock;
+    return clock;
+}
+
+std::shared_ptr<Clock> Clock::getDefault() {
+    auto clock = std::atomic_load(&defaultClock());
+    if (clock) {
+        return clock;
+    }
+    return RealClock::getInstance();
+}
+
+void Clock::setDefault(std::shared_ptr<Clock> clock) {
+    std::atomic_store(&defaultClock(), clock);
+}
+
+std::shared_ptr<RealClock> RealClock::getInstance() {
+    static std::shared_ptr<RealClock> instance = std::make_shared<RealClock>();
+    return instance;
+}
+
+Clock::time_point RealClock::now() const {
+    return std::chrono::steady_clock::now();
+}
+
+int64_t RealClock::getUnixTime() const {
+    return static_cast<int64_t>(std::time(nullptr));
+}
+
+void RealClock::waitUntil(
+    std::condition_variable& condition,
+    std::unique_lock<std::mutex>& lock,
+    time_point deadline) {
+    condition.wait_until(lock, deadline);
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -40,8 +40,7 @@ static const std::string TAG("ConfigurationNode");
 using namespace rapidjson;
 
 std::mutex ConfigurationNode::m_mutex;
-Document ConfigurationNode::m_document;
-ConfigurationNode ConfigurationNode::m_root;
+std::shared_ptr<const Document> ConfigurationNode::m_snapshot;
 
 /**
  * Render @c rapidjson::Value as a string.
@@ -90,44 +89,88 @@ static void mergeDocument(const std::string& path, Value& out, Value& in, Docume
     }
 }
 
-bool ConfigurationNode::initialize(const std::vector<std::istream*>& jsonStreams) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_root) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "alreadyInitialized"));
-        return false;
-    }
-    m_document.SetObject();
+/**
+ * Parse and merge JSON documents into a new @c rapidjson::Document.
+ *
+ * @param jsonStreams The streams containing the JSON documents, in the order they are to be merged.
+ * @param event The event to log on failure.
+ * @return The merged document, or @c nullptr if parsing failed.
+ */
+static std::shared_ptr<Document> parseDocument(
+    const std::vector<std::istream*>& jsonStreams,
+    const std::string& event) {
+    auto document = std::make_shared<Document>();
+    document->SetObject();
     for (auto jsonStream : jsonStreams) {
         if (!jsonStream) {
-            m_document.SetObject();
-            return false;
+            ACSDK_ERROR(LX(event).d("reason", "nullStream"));
+            return nullptr;
         }
         IStreamWrapper wrapper(*jsonStream);
-        Document overlay(&m_document.GetAllocator());
+        Document overlay(&document->GetAllocator());
         overlay.ParseStream(wrapper);
         if (overlay.HasParseError()) {
-            ACSDK_ERROR(LX("initializeFailed")
+            ACSDK_ERROR(LX(event)
                             .d("reason", "parseFailure")
                             .d("offset", overlay.GetErrorOffset())
                             .d("message", GetParseError_En(overlay.GetParseError())));
-            m_document.SetObject();
-            return false;
+            return nullptr;
         }
-        mergeDocument("root", m_document, overlay, m_document.GetAllocator());
+        mergeDocument("root", *document, overlay, document->GetAllocator());
     }
-    m_root = ConfigurationNode(&m_document);
-    ACSDK_INFO(LX("initializeSuccess").sensitive("configuration", valueToString(m_document)));
+    return document;
+}
+
+/// The innermost @c ConfigurationNode::ScopedRoot on this thread, or @c nullptr.
+static thread_local const ConfigurationNode::ScopedRoot* g_threadScopedRoot = nullptr;
+
+ConfigurationNode::ScopedRoot::ScopedRoot(const ConfigurationNode& root) :
+        m_root{root},
+        m_previous{g_threadScopedRoot} {
+    g_threadScopedRoot = this;
+}
+
+ConfigurationNode::ScopedRoot::~ScopedRoot() {
+    g_threadScopedRoot = m_previous;
+}
+
+bool ConfigurationNode::initialize(const std::vector<std::istream*>& jsonStreams) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::atomic_load(&m_snapshot)) {
+        ACSDK_ERROR(LX("initializeFailed").d("reason", "alreadyInitialized"));
+        return false;
+    }
+    auto document = parseDocument(jsonStreams, "initializeFailed");
+    if (!document) {
+        return false;
+    }
+    ACSDK_INFO(LX("initializeSuccess").sensitive("configuration", valueToString(*document)));
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Document>(document));
     return true;
 }
 
+ConfigurationNode ConfigurationNode::createRoot(const std::vector<std::istream*>& jsonStreams) {
+    std::shared_ptr<const Document> document = parseDocument(jsonStreams, "createRootFailed");
+    if (!document) {
+        return ConfigurationNode();
+    }
+    return ConfigurationNode(document.get(), document);
+}
+
 void ConfigurationNode::uninitialize() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_document.SetObject();
-    m_root = ConfigurationNode();
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Document>());
 }
 
 ConfigurationNode ConfigurationNode::getRoot() {
-    return m_root;
+    if (g_threadScopedRoot) {
+        return g_threadScopedRoot->m_root;
+    }
+    auto snapshot = std::atomic_load(&m_snapshot);
+    if (!snapshot) {
+        return ConfigurationNode();
+    }
+    return ConfigurationNode(snapshot.get(), snapshot);
 }
 
 ConfigurationNode::ConfigurationNode() : m_object{nullptr} {
@@ -188,14 +231,16 @@ ConfigurationNode ConfigurationNode::operator[](const std::string& key) const {
     if (m_object->MemberEnd() == it || !it->value.IsObject()) {
         return ConfigurationNode();
     }
-    return ConfigurationNode(&it->value);
+    return ConfigurationNode(&it->value, m_document);
 }
 
 ConfigurationNode::operator bool() const {
     return m_object;
 }
 
-ConfigurationNode::ConfigurationNode(const rapidjson::Value* object) : m_object{object} {
+ConfigurationNode::ConfigurationNode(const rapidjson::Value* object, std::shared_ptr<const Document> document) :
+        m_object{object},
+        m_document{document} {
 }
 
 }  // namespace configuration
@@ -15,6 +15,12 @@
  * permissions and limitations under the License.
  */
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
 #include "AVSCommon/Utils/Memory/Memory.h"
 #include "AVSCommon/Utils/Threading/Executor.h"
 
@@ -23,10 +29,167 @@ namespace avsCommon {
 namespace utils {
 namespace threading {
 
-Executor::Executor() :
-        m_taskQueue{std::make_shared<TaskQueue>()},
-        m_taskThread{memory::make_unique<TaskThread>(m_taskQueue)} {
-    m_taskThread->start();
+struct Executor::PoolLane {
+    /// Constructor.
+    PoolLane(std::shared_ptr<ThreadPool> pool, std::shared_ptr<TaskQueue> queue) :
+            threadPool{pool},
+            taskQueue{queue},
+            isScheduled{false},
+            isRunning{false} {
+    }
+
+    /// The @c ThreadPool to run tasks on.
+    const std::shared_ptr<ThreadPool> threadPool;
+
+    /// The queue of tasks to run.
+    const std::shared_ptr<TaskQueue> taskQueue;
+
+    /// Serializes access to the members below.
+    std::mutex mutex;
+
+    /// Notified when a task finishes running.
+    std::condition_variable taskFinished;
+
+    /// Whether a job to run the next task has been submitted to @c threadPool.  At most one is submitted at a time.
+    bool isScheduled;
+
+    /// Whether a task is currently running.
+    bool isRunning;
+
+    /// The thread the current task is running on.
+    std::thread::id runningThreadId;
+};
+
+struct Executor::DelayedTasks {
+    /// Constructor.
+    DelayedTasks(
+        std::shared_ptr<timing::TimerService> service,
+        std::shared_ptr<TaskQueue> queue,
+        std::shared_ptr<PoolLane> lane) :
+            timerService{service},
+            taskQueue{queue},
+            poolLane{lane},
+            isShutdown{false} {
+    }
+
+    /// The @c TimerService the tasks wait on.
+    const std::shared_ptr<timing::TimerService> timerService;
+
+    /// The queue to hand the tasks to when they are due.
+    const std::shared_ptr<TaskQueue> taskQueue;
+
+    /// The @c PoolLane of the Executor, or @c nullptr if it has a thread of its own.
+    const std::shared_ptr<PoolLane> poolLane;
+
+    /// Serializes access to the members below, and the queueing of due tasks with the shutdown of the Executor.
+    std::mutex mutex;
+
+    /// The tasks which are waiting on @c timerService.
+    std::unordered_set<std::shared_ptr<DelayedTaskHandle::State>> waiting;
+
+    /// Whether the Executor has been shut down.
+    bool isShutdown;
+};
+
+struct DelayedTaskHandle::State {
+    /// The stages of the life of a delayed task.
+    enum Status {
+        /// The task has not started, and may still be cancelled.
+        PENDING,
+
+        /// The task has started.
+        STARTED,
+
+        /// The task was cancelled.
+        CANCELLED
+    };
+
+    /// Constructor.
+    State(std::function<void()> function, Executor::Priority taskPriority) :
+            task{std::move(function)},
+            priority{taskPriority},
+            status{PENDING},
+            timerId{timing::TimerService::INVALID_ID} {
+    }
+
+    /**
+     * Moves the task from @c PENDING to another stage.
+     *
+     * @param to The stage to move to.
+     * @return Whether the task was @c PENDING.
+     */
+    bool leavePending(Status to) {
+        int expected = PENDING;
+        return status.compare_exchange_strong(expected, to);
+    }
+
+    /// The task, which is released once it has run or been cancelled.
+    std::function<void()> task;
+
+    /// The priority to queue the task with.
+    const Executor::Priority priority;
+
+    /// The stage of the life of the task.
+    std::atomic<int> status;
+
+    /// The id of the timer of the task, which is set before the handle is returned.
+    timing::TimerService::Id timerId;
+
+    /// The delayed tasks of the Executor, which outlive it while a timer or a handle needs them.
+    std::weak_ptr<Executor::DelayedTasks> delayedTasks;
+};
+
+DelayedTaskHandle::DelayedTaskHandle(std::shared_ptr<State> state) : m_state{std::move(state)} {
+}
+
+bool DelayedTaskHandle::cancel() {
+    if (!m_state || !m_state->leavePending(State::CANCELLED)) {
+        return false;
+    }
+    m_state->task = nullptr;
+    auto delayedTasks = m_state->delayedTasks.lock();
+    if (delayedTasks) {
+        {
+            std::lock_guard<std::mutex> lock(delayedTasks->mutex);
+            delayedTasks->waiting.erase(m_state);
+        }
+        delayedTasks->timerService->cancel(m_state->timerId);
+    }
+    return true;
+}
+
+bool DelayedTaskHandle::isValid() const {
+    return m_state != nullptr;
+}
+
+/**
+ * Get the storage of the @c ThreadPool set with @c Executor::setDefaultThreadPool().  It is only accessed with
+ * @c std::atomic_load() and @c std::atomic_store().
+ *
+ * @return The storage of the default @c ThreadPool.
+ */
+static std::shared_ptr<ThreadPool>& defaultThreadPool() {
+    static std::shared_ptr<ThreadPool> threadPool;
+    return threadPool;
+}
+
+void Executor::setDefaultThreadPool(std::shared_ptr<ThreadPool> threadPool) {
+    std::atomic_store(&defaultThreadPool(), threadPool);
+}
+
+Executor::Executor() : Executor(std::atomic_load(&defaultThreadPool())) {
+}
+
+Executor::Executor(std::shared_ptr<ThreadPool> threadPool, std::shared_ptr<timing::TimerService> timerService) :
+        m_taskQueue{std::make_shared<TaskQueue>()} {
+    if (threadPool) {
+        m_poolLane = std::make_shared<PoolLane>(threadPool, m_taskQueue);
+    } else {
+        m_taskThread = memory::make_unique<TaskThread>(m_taskQueue);
+        m_taskThread->start();
+    }
+    m_delayedTasks = std::make_shared<DelayedTasks>(
+        timerService ? timerService : timing::TimerService::getInstance(), m_taskQueue, m_poolLane);
 }
 
 Executor::~Executor() {
@@ -37,19 +200,138 @@ void Executor::waitForSubmittedTasks() {
     std::promise<void> flushedPromise;
     auto flushedFuture = flushedPromise.get_future();
     auto task = [this, &flushedPromise]() { flushedPromise.set_value(); };
-    submit(task);
+    // The lowest priority runs after every task queued before it, whatever their priorities.
+    submitWithPriority(Priority::LOW, task);
     flushedFuture.get();
 }
 
+DelayedTaskHandle Executor::submitAfter(
+    std::chrono::milliseconds delay,
+    std::function<void()> task,
+    Priority priority) {
+    return submitAt(m_delayedTasks->timerService->now() + delay, std::move(task), priority);
+}
+
+DelayedTaskHandle Executor::submitAt(
+    timing::TimerService::Clock::time_point when,
+    std::function<void()> task,
+    Priority priority) {
+    if (!task) {
+        return DelayedTaskHandle();
+    }
+    auto state = std::make_shared<DelayedTaskHandle::State>(std::move(task), priority);
+    state->delayedTasks = m_delayedTasks;
+    std::weak_ptr<DelayedTasks> weakDelayedTasks = m_delayedTasks;
+    // The timer can not queue the task before it is registered, since queueing takes the lock held here.
+    std::lock_guard<std::mutex> lock(m_delayedTasks->mutex);
+    if (m_delayedTasks->isShutdown) {
+        return DelayedTaskHandle();
+    }
+    state->timerId = m_delayedTasks->timerService->schedule(when, [weakDelayedTasks, state] {
+        auto delayedTasks = weakDelayedTasks.lock();
+        if (delayedTasks) {
+            onDelayedTaskDue(delayedTasks, state);
+        }
+    });
+    if (timing::TimerService::INVALID_ID == state->timerId) {
+        return DelayedTaskHandle();
+    }
+    m_delayedTasks->waiting.insert(state);
+    return DelayedTaskHandle(state);
+}
+
+void Executor::onDelayedTaskDue(
+    std::shared_ptr<DelayedTasks> delayedTasks,
+    std::shared_ptr<DelayedTaskHandle::State> state) {
+    std::lock_guard<std::mutex> lock(delayedTasks->mutex);
+    if (0 == delayedTasks->waiting.erase(state)) {
+        // The task was cancelled, or the Executor was shut down.
+        return;
+    }
+    auto future = delayedTasks->taskQueue->pushWithPriority(state->priority, [state] {
+        if (state->leavePending(DelayedTaskHandle::State::STARTED)) {
+            auto task = std::move(state->task);
+            state->task = nullptr;
+            task();
+        }
+    });
+    if (future.valid()) {
+        scheduleNextPooledTask(delayedTasks->poolLane);
+    }
+}
+
 void Executor::shutdown() {
+    std::unordered_set<std::shared_ptr<DelayedTaskHandle::State>> waiting;
+    {
+        std::lock_guard<std::mutex> lock(m_delayedTasks->mutex);
+        m_delayedTasks->isShutdown = true;
+        std::swap(waiting, m_delayedTasks->waiting);
+    }
+    for (auto& state : waiting) {
+        if (state->leavePending(DelayedTaskHandle::State::CANCELLED)) {
+            state->task = nullptr;
+        }
+        m_delayedTasks->timerService->cancel(state->timerId);
+    }
     m_taskQueue->shutdown();
     m_taskThread.reset();
+    if (m_poolLane) {
+        // Wait for a task in progress to complete, unless this is being called from that task.
+        std::unique_lock<std::mutex> lock(m_poolLane->mutex);
+        m_poolLane->taskFinished.wait(lock, [this] {
+            return !m_poolLane->isRunning || m_poolLane->runningThreadId == std::this_thread::get_id();
+        });
+    }
 }
 
 bool Executor::isShutdown() {
     return m_taskQueue->isShutdown();
 }
 
+void Executor::setMaxSpin(std::chrono::microseconds maxSpin) {
+    m_taskQueue->setMaxSpin(maxSpin);
+}
+
+void Executor::onTaskSubmitted() {
+    scheduleNextPooledTask(m_poolLane);
+}
+
+void Executor::scheduleNextPooledTask(const std::shared_ptr<PoolLane>& lane) {
+    if (!lane) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(lane->mutex);
+    if (lane->isScheduled) {
+        return;
+    }
+    lane->isScheduled = lane->threadPool->submit([lane] { runNextPooledTask(lane); });
+}
+
+void Executor::runNextPooledTask(std::shared_ptr<PoolLane> lane) {
+    std::unique_ptr<TaskQueue::QueuedTask> task;
+    {
+        // Popping under the lane's lock guarantees that a task submitted after an empty pop schedules a new job.
+        std::lock_guard<std::mutex> lock(lane->mutex);
+        task = lane->taskQueue->tryPop();
+        if (!task) {
+            lane->isScheduled = false;
+            return;
+        }
+        lane->isRunning = true;
+        lane->runningThreadId = std::this_thread::get_id();
+    }
+
+    task->operator()();
+    task.reset();
+
+    std::lock_guard<std::mutex> lock(lane->mutex);
+    lane->isRunning = false;
+    lane->runningThreadId = std::thread::id();
+    lane->taskFinished.notify_all();
+    // Run the next task in a new job, so that executors sharing the pool take turns.
+    lane->isScheduled = lane->threadPool->submit([lane] { runNextPooledTask(lane); });
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace avsCommon
@@ -17,7 +17,10 @@
 
 #include "AVSCommon/Utils/JSON/JSONUtils.h"
 
+#include <limits>
+
 #include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -153,6 +156,293 @@ bool lookupInt64Value(const std::string& jsonContent, const std::string& key, in
     return retrieveValue(jsonContent, key, value);
 }
 
+/**
+ * A rapidjson SAX handler for @c lookupValues().  It follows the direct children of the root object, assigns the ones
+ * which were asked for, and serializes an object value through a @c Writer while it is being read.  It stops the
+ * parse by returning @c false once every value has been found.
+ */
+class LookupValuesHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, LookupValuesHandler> {
+public:
+    /**
+     * Constructor.
+     *
+     * @param stringValues The keys of the string values to look up, each mapped to its output parameter.
+     * @param int64Values The keys of the int64_t values to look up, each mapped to its output parameter.
+     */
+    LookupValuesHandler(
+        const std::map<std::string, std::string*>& stringValues,
+        const std::map<std::string, int64_t*>& int64Values) :
+            m_stringValues(stringValues),
+            m_int64Values(int64Values),
+            m_depth{0},
+            m_stringValue{nullptr},
+            m_int64Value{nullptr},
+            m_writer{m_buffer} {
+    }
+
+    /// Whether every value has been found.
+    bool isDone() const {
+        return m_stringValues.empty() && m_int64Values.empty();
+    }
+
+    /// The keys of the values which have not been found.
+    std::set<std::string> getMissingKeys() const {
+        std::set<std::string> keys;
+        for (const auto& stringValue : m_stringValues) {
+            keys.insert(stringValue.first);
+        }
+        for (const auto& int64Value : m_int64Values) {
+            keys.insert(int64Value.first);
+        }
+        return keys;
+    }
+
+    /// @name BaseReaderHandler overrides
+    /// @{
+    bool Null() {
+        return isCapturing() ? m_writer.Null() : skipValue();
+    }
+
+    bool Bool(bool b) {
+        return isCapturing() ? m_writer.Bool(b) : skipValue();
+    }
+
+    bool Int(int i) {
+        return isCapturing() ? m_writer.Int(i) : setInt64Value(i);
+    }
+
+    bool Uint(unsigned u) {
+        return isCapturing() ? m_writer.Uint(u) : setInt64Value(u);
+    }
+
+    bool Int64(int64_t i) {
+        return isCapturing() ? m_writer.Int64(i) : setInt64Value(i);
+    }
+
+    bool Uint64(uint64_t u) {
+        if (isCapturing()) {
+            return m_writer.Uint64(u);
+        }
+        if (u > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return skipValue();
+        }
+        return setInt64Value(static_cast<int64_t>(u));
+    }
+
+    bool Double(double d) {
+        return isCapturing() ? m_writer.Double(d) : skipValue();
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool copy) {
+        if (isCapturing()) {
+            return m_writer.String(str, length, copy);
+        }
+        if (1 == m_depth && m_stringValue) {
+            m_stringValue->assign(str, length);
+            return foundValue();
+        }
+        return skipValue();
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+        if (isCapturing()) {
+            return m_writer.Key(str, length, copy);
+        }
+        if (1 == m_depth) {
+            m_key.assign(str, length);
+            auto stringIt = m_stringValues.find(m_key);
+            m_stringValue = m_stringValues.end() == stringIt ? nullptr : stringIt->second;
+            auto int64It = m_int64Values.find(m_key);
+            m_int64Value = m_int64Values.end() == int64It ? nullptr : int64It->second;
+        }
+        return true;
+    }
+
+    bool StartObject() {
+        if (1 == m_depth) {
+            if (m_stringValue) {
+                m_buffer.Clear();
+                m_writer.Reset(m_buffer);
+            } else {
+                skipValue();
+            }
+        }
+        ++m_depth;
+        return isCapturing() ? m_writer.StartObject() : true;
+    }
+
+    bool EndObject(rapidjson::SizeType memberCount) {
+        if (isCapturing()) {
+            if (!m_writer.EndObject(memberCount)) {
+                return false;
+            }
+            if (2 == m_depth) {
+                --m_depth;
+                m_stringValue->assign(m_buffer.GetString(), m_buffer.GetSize());
+                return foundValue();
+            }
+        }
+        --m_depth;
+        return true;
+    }
+
+    bool StartArray() {
+        // Arrays are not supported as values, but may be part of an object value.
+        skipValue();
+        ++m_depth;
+        return isCapturing() ? m_writer.StartArray() : true;
+    }
+
+    bool EndArray(rapidjson::SizeType elementCount) {
+        bool result = isCapturing() ? m_writer.EndArray(elementCount) : true;
+        --m_depth;
+        return result;
+    }
+    /// @}
+
+private:
+    /// Whether an object value which was asked for as a string is being serialized.
+    bool isCapturing() const {
+        return m_depth >= 2 && m_stringValue;
+    }
+
+    /**
+     * Assign an integer value if it was asked for.
+     *
+     * @param value The value.
+     * @return Whether to continue parsing.
+     */
+    bool setInt64Value(int64_t value) {
+        if (1 == m_depth && m_int64Value) {
+            *m_int64Value = value;
+            return foundValue();
+        }
+        return skipValue();
+    }
+
+    /**
+     * Forget the key of a direct child value which was not asked for, or not of the type asked for.
+     *
+     * @return Whether to continue parsing.
+     */
+    bool skipValue() {
+        if (1 == m_depth) {
+            m_stringValue = nullptr;
+            m_int64Value = nullptr;
+        }
+        return true;
+    }
+
+    /**
+     * Record that the value for the current key has been found.  Only the first value for a key is used.
+     *
+     * @return Whether to continue parsing.
+     */
+    bool foundValue() {
+        m_stringValues.erase(m_key);
+        m_int64Values.erase(m_key);
+        m_stringValue = nullptr;
+        m_int64Value = nullptr;
+        return !isDone();
+    }
+
+    /// The string values which have not been found yet.
+    std::map<std::string, std::string*> m_stringValues;
+
+    /// The int64_t values which have not been found yet.
+    std::map<std::string, int64_t*> m_int64Values;
+
+    /// How deeply nested the current value is.  The direct children of the root object are at depth 1.
+    int m_depth;
+
+    /// The key of the current direct child of the root object.
+    std::string m_key;
+
+    /// The output parameter for the current direct child, if it was asked for as a string.
+    std::string* m_stringValue;
+
+    /// The output parameter for the current direct child, if it was asked for as an int64_t.
+    int64_t* m_int64Value;
+
+    /// The buffer an object value is serialized into.
+    rapidjson::StringBuffer m_buffer;
+
+    /// The writer an object value is serialized with.
+    rapidjson::Writer<rapidjson::StringBuffer> m_writer;
+};
+
+bool lookupValues(
+    const std::string& jsonContent,
+    const std::map<std::string, std::string*>& stringValues,
+    const std::map<std::string, int64_t*>& int64Values,
+    std::set<std::string>* missingKeys) {
+    if (missingKeys) {
+        missingKeys->clear();
+    }
+    for (const auto& stringValue : stringValues) {
+        if (!stringValue.second) {
+            ACSDK_ERROR(LX("lookupValuesFailed").d("reason", "nullValue").d("key", stringValue.first));
+            return false;
+        }
+    }
+    for (const auto& int64Value : int64Values) {
+        if (!int64Value.second) {
+            ACSDK_ERROR(LX("lookupValuesFailed").d("reason", "nullValue").d("key", int64Value.first));
+            return false;
+        }
+    }
+
+    LookupValuesHandler handler(stringValues, int64Values);
+    if (handler.isDone()) {
+        return true;
+    }
+
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(jsonContent.c_str());
+    reader.Parse<rapidjson::kParseStopWhenDoneFlag>(stream, handler);
+    if (handler.isDone()) {
+        return true;
+    }
+    if (reader.HasParseError()) {
+        ACSDK_ERROR(LX("lookupValuesFailed")
+                        .d("reason", "parseError")
+                        .d("offset", reader.GetErrorOffset())
+                        .d("error", rapidjson::GetParseError_En(reader.GetParseErrorCode())));
+        return false;
+    }
+    if (missingKeys) {
+        *missingKeys = handler.getMissingKeys();
+        return true;
+    }
+    return false;
+}
+
+bool scanStringValue(const std::string& jsonContent, const std::string& key, std::string* value) {
+    if (!value) {
+        ACSDK_ERROR(LX("scanStringValueFailed").d("reason", "nullValue"));
+        return false;
+    }
+    auto quotedKey = "\"" + key + "\"";
+    auto position = jsonContent.find(quotedKey);
+    if (std::string::npos == position) {
+        return false;
+    }
+    position = jsonContent.find_first_not_of(" \t\r\n", position + quotedKey.size());
+    if (std::string::npos == position || jsonContent[position] != ':') {
+        return false;
+    }
+    position = jsonContent.find_first_not_of(" \t\r\n", position + 1);
+    if (std::string::npos == position || jsonContent[position] != '"') {
+        return false;
+    }
+    auto end = jsonContent.find('"', position + 1);
+    if (std::string::npos == end) {
+        return false;
+    }
+    value->assign(jsonContent, position + 1, end - position - 1);
+    return true;
+}
+
 // Overloads of convertToValue
 
 bool convertToValue(const rapidjson::Value& documentNode, std::string* value) {
@@ -17,6 +17,7 @@
 
 #include <cerrno>
 #include <cstdlib>
+#include <mutex>
 
 #include "AVSCommon/Utils/Configuration/ConfigurationNode.h"
 #include "AVSCommon/Utils/LibcurlUtils/LibcurlUtils.h"
@@ -43,6 +44,9 @@ static const std::string LIBCURLUTILS_CONFIG_KEY = "libcurlUtils";
 /// Key for looking up a configuration value for @c CURLOPT_CAPATH
 static const std::string CAPATH_CONFIG_KEY = "CURLOPT_CAPATH";
 
+/// Key for looking up a configuration value for @c CURLOPT_DNS_CACHE_TIMEOUT
+static const std::string DNS_CACHE_TIMEOUT_CONFIG_KEY = "CURLOPT_DNS_CACHE_TIMEOUT";
+
 /**
  * Set an @c option on a @c libcurl handle to @c value with stringification of @c option name and @c value for logging.
  *
@@ -82,6 +86,78 @@ static bool setopt(
     return true;
 }
 
+/**
+ * A libcurl share handle through which all the handles prepared by @c prepareForTLS() share their TLS session and
+ * DNS caches.  libcurl calls @c lock() and @c unlock() around each access to the shared data, which may be from any
+ * thread.
+ */
+class SharedHandle {
+public:
+    /**
+     * Get the process-wide instance.
+     *
+     * @return The process-wide instance.
+     */
+    static SharedHandle& getInstance();
+
+    /**
+     * Get the libcurl share handle.
+     *
+     * @return The libcurl share handle, or @c nullptr if it could not be created.
+     */
+    CURLSH* get() const;
+
+private:
+    /// Constructor.
+    SharedHandle();
+
+    /// Callback for @c CURLSHOPT_LOCKFUNC.
+    static void lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData);
+
+    /// Callback for @c CURLSHOPT_UNLOCKFUNC.
+    static void unlock(CURL* handle, curl_lock_data data, void* userData);
+
+    /// The libcurl share handle.
+    CURLSH* m_handle;
+
+    /// A mutex for each kind of shared data.
+    std::mutex m_mutexes[CURL_LOCK_DATA_LAST];
+};
+
+SharedHandle& SharedHandle::getInstance() {
+    // Intentionally never destroyed, since easy handles may still be cleaned up during static destruction.
+    static SharedHandle* instance = new SharedHandle();
+    return *instance;
+}
+
+CURLSH* SharedHandle::get() const {
+    return m_handle;
+}
+
+SharedHandle::SharedHandle() : m_handle{curl_share_init()} {
+    if (!m_handle) {
+        ACSDK_ERROR(LX("createSharedHandleFailed").d("reason", "curl_share_initFailed"));
+        return;
+    }
+    if (curl_share_setopt(m_handle, CURLSHOPT_LOCKFUNC, lock) != CURLSHE_OK ||
+        curl_share_setopt(m_handle, CURLSHOPT_UNLOCKFUNC, unlock) != CURLSHE_OK ||
+        curl_share_setopt(m_handle, CURLSHOPT_USERDATA, this) != CURLSHE_OK ||
+        curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION) != CURLSHE_OK ||
+        curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS) != CURLSHE_OK) {
+        ACSDK_ERROR(LX("createSharedHandleFailed").d("reason", "curl_share_setoptFailed"));
+        curl_share_cleanup(m_handle);
+        m_handle = nullptr;
+    }
+}
+
+void SharedHandle::lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData) {
+    static_cast<SharedHandle*>(userData)->m_mutexes[data].lock();
+}
+
+void SharedHandle::unlock(CURL* handle, curl_lock_data data, void* userData) {
+    static_cast<SharedHandle*>(userData)->m_mutexes[data].unlock();
+}
+
 bool prepareForTLS(CURL* handle) {
     if (!handle) {
         ACSDK_ERROR(LX("prepareForTLSFailed").d("reason", "nullHandle"));
@@ -94,8 +170,26 @@ bool prepareForTLS(CURL* handle) {
         return false;
     }
 
+    // Sharing only speeds up later connections, so carry on without it if the share handle is not available.
+    auto sharedHandle = SharedHandle::getInstance().get();
+    if (sharedHandle && !SETOPT(handle, CURLOPT_SHARE, sharedHandle)) {
+        ACSDK_WARN(LX("prepareForTLSWarning").d("reason", "shareFailed"));
+    }
+
+    auto configuration = configuration::ConfigurationNode::getRoot()[LIBCURLUTILS_CONFIG_KEY];
+    int dnsCacheTimeout = 0;
+    if (configuration.getInt(DNS_CACHE_TIMEOUT_CONFIG_KEY, &dnsCacheTimeout) &&
+        !setopt(
+            handle,
+            CURLOPT_DNS_CACHE_TIMEOUT,
+            static_cast<long>(dnsCacheTimeout),
+            "CURLOPT_DNS_CACHE_TIMEOUT",
+            std::to_string(dnsCacheTimeout).c_str())) {
+        return false;
+    }
+
     std::string caPath;
-    if (configuration::ConfigurationNode::getRoot()[LIBCURLUTILS_CONFIG_KEY].getString(CAPATH_CONFIG_KEY, &caPath)) {
+    if (configuration.getString(CAPATH_CONFIG_KEY, &caPath)) {
         return setopt(handle, CURLOPT_CAPATH, caPath.c_str(), "CURLOPT_CAPATH", caPath.c_str());
     }
 
@@ -0,0 +1,285 @@
+/*
+ * LockedAllocator.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Memory/LockedAllocator.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace memory {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("LockedAllocator");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The page size to assume if the system does not report one.
+static const size_t DEFAULT_PAGE_SIZE = 4096;
+
+/// The file which reports the size of huge pages.
+static const std::string MEMINFO_FILE_PATH = "/proc/meminfo";
+
+/// The line of @c MEMINFO_FILE_PATH which reports the size of huge pages, in kB.
+static const std::string HUGE_PAGE_SIZE_KEY = "Hugepagesize:";
+
+/**
+ * The bytes at the start of a mapping which record how it was made.  The memory handed out follows them, so its
+ * alignment is that of the header.
+ */
+struct alignas(64) MappingHeader {
+    /// The number of bytes mapped, which is what is unmapped.
+    size_t mappedBytes;
+
+    /// Whether the mapping is locked into RAM.
+    bool isLocked;
+
+    /// Whether the mapping is backed by huge pages.
+    bool isHugePages;
+};
+
+/**
+ * The lock and storage of the default options and of the gauges.
+ */
+struct LockedMemoryState {
+    /// Serializes access to the members.
+    std::mutex mutex;
+
+    /// The options set with @c LockedMemoryOptions::setDefault().
+    LockedMemoryOptions defaultOptions;
+
+    /// The totals of the memory mapped.
+    LockedMemoryGauges gauges = {};
+};
+
+/**
+ * Get the state shared by all @c LockedAllocators.
+ *
+ * @return The state.
+ */
+static LockedMemoryState& getState() {
+    static LockedMemoryState state;
+    return state;
+}
+
+/**
+ * Get the size of a page.
+ *
+ * @return The number of bytes in a page.
+ */
+static size_t getPageSize() {
+    static const size_t pageSize = [] {
+        long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<size_t>(size) : DEFAULT_PAGE_SIZE;
+    }();
+    return pageSize;
+}
+
+/**
+ * Get the size of a huge page.
+ *
+ * @return The number of bytes in a huge page, or zero if the system does not report it.
+ */
+static size_t getHugePageSize() {
+    static const size_t hugePageSize = [] {
+        std::ifstream meminfo(MEMINFO_FILE_PATH);
+        std::string key;
+        while (meminfo >> key) {
+            if (HUGE_PAGE_SIZE_KEY == key) {
+                size_t kilobytes = 0;
+                meminfo >> kilobytes;
+                return kilobytes * 1024;
+            }
+            meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        return static_cast<size_t>(0);
+    }();
+    return hugePageSize;
+}
+
+/**
+ * Round a size up to a whole number of pages.
+ *
+ * @param bytes The size.
+ * @param pageSize The size of a page.
+ * @return The smallest multiple of @c pageSize which is at least @c bytes.
+ */
+static size_t roundUp(size_t bytes, size_t pageSize) {
+    return (bytes + pageSize - 1) / pageSize * pageSize;
+}
+
+/**
+ * Map anonymous memory.
+ *
+ * @param bytes The number of bytes to map.
+ * @param flags Flags to add to the defaults.
+ * @return The mapping, or @c nullptr if it failed.
+ */
+static void* mapMemory(size_t bytes, int flags) {
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    return MAP_FAILED == memory ? nullptr : memory;
+}
+
+LockedMemoryOptions::LockedMemoryOptions(bool prefault, bool lock, bool hugePages) :
+        prefault{prefault},
+        lock{lock},
+        hugePages{hugePages} {
+}
+
+bool LockedMemoryOptions::isPlain() const {
+    return !prefault && !lock && !hugePages;
+}
+
+LockedMemoryOptions LockedMemoryOptions::getDefault() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.defaultOptions;
+}
+
+void LockedMemoryOptions::setDefault(const LockedMemoryOptions& options) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.defaultOptions = options;
+}
+
+bool operator==(const LockedMemoryOptions& lhs, const LockedMemoryOptions& rhs) {
+    return lhs.prefault == rhs.prefault && lhs.lock == rhs.lock && lhs.hugePages == rhs.hugePages;
+}
+
+bool operator!=(const LockedMemoryOptions& lhs, const LockedMemoryOptions& rhs) {
+    return !(lhs == rhs);
+}
+
+void* allocateLockedMemory(size_t bytes, const LockedMemoryOptions& options) {
+    if (options.isPlain()) {
+        return ::operator new(bytes);
+    }
+
+    MappingHeader header = {};
+    void* mapping = nullptr;
+    int populate = 0;
+#ifdef MAP_POPULATE
+    populate = options.prefault ? MAP_POPULATE : 0;
+#endif
+    if (options.hugePages) {
+#ifdef MAP_HUGETLB
+        auto hugePageSize = getHugePageSize();
+        if (hugePageSize > 0) {
+            header.mappedBytes = roundUp(sizeof(MappingHeader) + bytes, hugePageSize);
+            mapping = mapMemory(header.mappedBytes, MAP_HUGETLB | populate);
+            header.isHugePages = mapping != nullptr;
+        }
+#endif
+        if (!mapping) {
+            ACSDK_WARN(LX("hugePagesUnavailable").d("bytes", bytes).d("error", strerror(errno)));
+        }
+    }
+    if (!mapping) {
+        header.mappedBytes = roundUp(sizeof(MappingHeader) + bytes, getPageSize());
+        // Transparent huge pages must be asked for before the mapping is populated, so it is touched afterwards.
+        mapping = mapMemory(header.mappedBytes, options.hugePages ? 0 : populate);
+        if (!mapping) {
+            ACSDK_ERROR(LX("allocateFailed").d("reason", "mmapFailed").d("bytes", bytes).d("error", strerror(errno)));
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        if (options.hugePages) {
+            // This is a hint; the mapping still works without them.
+            madvise(mapping, header.mappedBytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    if (options.lock) {
+        header.isLocked = 0 == mlock(mapping, header.mappedBytes);
+        if (!header.isLocked) {
+            ACSDK_WARN(LX("lockFailed").d("bytes", header.mappedBytes).d("error", strerror(errno)));
+        }
+    }
+    if (options.prefault) {
+        // Writing a byte of each page gives the page its own frame, where reading would only map the zero page.
+        auto pageSize = header.isHugePages ? getHugePageSize() : getPageSize();
+        auto bytesToTouch = static_cast<volatile uint8_t*>(mapping);
+        for (size_t offset = 0; offset < header.mappedBytes; offset += pageSize) {
+            bytesToTouch[offset] = 0;
+        }
+    }
+    std::memcpy(mapping, &header, sizeof(header));
+
+    auto& state = getState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.gauges.mappedBytes += header.mappedBytes;
+        state.gauges.lockedBytes += header.isLocked ? header.mappedBytes : 0;
+        state.gauges.hugePageBytes += header.isHugePages ? header.mappedBytes : 0;
+        state.gauges.lockFailures += options.lock && !header.isLocked ? 1 : 0;
+        state.gauges.hugePageFallbacks += options.hugePages && !header.isHugePages ? 1 : 0;
+    }
+    return static_cast<uint8_t*>(mapping) + sizeof(MappingHeader);
+}
+
+void deallocateLockedMemory(void* memory, size_t bytes, const LockedMemoryOptions& options) {
+    if (!memory) {
+        return;
+    }
+    if (options.isPlain()) {
+        ::operator delete(memory);
+        return;
+    }
+
+    auto mapping = static_cast<uint8_t*>(memory) - sizeof(MappingHeader);
+    MappingHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    auto& state = getState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.gauges.mappedBytes -= header.mappedBytes;
+        state.gauges.lockedBytes -= header.isLocked ? header.mappedBytes : 0;
+        state.gauges.hugePageBytes -= header.isHugePages ? header.mappedBytes : 0;
+    }
+    // Unmapping also unlocks.
+    if (0 != munmap(mapping, header.mappedBytes)) {
+        ACSDK_ERROR(LX("deallocateFailed").d("reason", "munmapFailed").d("bytes", bytes).d("error", strerror(errno)));
+    }
+}
+
+LockedMemoryGauges getLockedMemoryGauges() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.gauges;
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
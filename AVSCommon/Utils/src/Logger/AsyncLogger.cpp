@@ -0,0 +1,309 @@
+/*
+ * AsyncLogger.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+
+#include "AVSCommon/Utils/Logger/AsyncLogger.h"
+#include "AVSCommon/Utils/Logger/LoggerUtils.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/// Configuration key for the @c getAsyncConsoleLogger() settings, shared with @c ConsoleLogger.
+static const std::string CONFIG_KEY_CONSOLE_LOGGER = "consoleLogger";
+
+/// The number of entries in the @c getAsyncConsoleLogger() ring.
+static const size_t CONSOLE_CAPACITY = 1024;
+
+/// The maximum number of lines written by one @c writev() call.
+static const size_t MAX_BATCH_SIZE = 64;
+
+/// The longest time an entry waits in the ring before it is written.
+static const std::chrono::milliseconds WRITE_INTERVAL{100};
+
+/// The initial capacity of the strings in each ring entry, so typical entries don't allocate.
+static const size_t INITIAL_TEXT_CAPACITY = 256;
+
+/// Thread moniker used for the note about dropped entries.
+static const char* DROPPED_NOTE_MONIKER = "AsyncLogger";
+
+/**
+ * Round @c value up to a power of two.
+ *
+ * @param value The value to round up.
+ * @return The smallest power of two which is at least @c value (and at least 2).
+ */
+static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+AsyncLogger::AsyncLogger(Level level, int fd, size_t capacity, OverflowPolicy overflowPolicy) :
+        Logger(level),
+        m_fd{fd},
+        m_overflowPolicy{overflowPolicy},
+        m_ring{new Record[roundUpToPowerOfTwo(capacity)]},
+        m_mask{roundUpToPowerOfTwo(capacity) - 1},
+        m_pushPosition{0},
+        m_popPosition{0},
+        m_writtenPosition{0},
+        m_droppedCount{0},
+        m_isSleeping{false},
+        m_isWakeRequested{false},
+        m_isShuttingDown{false},
+        m_memoryBytes{sizeof(Record) * (m_mask + 1)},
+        m_memory{metrics::MemoryAccounting::Category::LOGGING},
+        m_batch(MAX_BATCH_SIZE) {
+    for (size_t i = 0; i <= m_mask; ++i) {
+        m_ring[i].sequence = i;
+        m_ring[i].text.reserve(INITIAL_TEXT_CAPACITY);
+        m_ring[i].countedCapacity = m_ring[i].threadMoniker.capacity() + m_ring[i].text.capacity();
+        m_memoryBytes += m_ring[i].countedCapacity;
+    }
+    m_memory.resize(m_memoryBytes);
+    m_thread = std::thread(&AsyncLogger::writeLoop, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeTrigger.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void AsyncLogger::emit(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker,
+    const char* text) {
+    size_t backlog = 0;
+    while (!tryPush(level, time, threadMoniker, text, &backlog)) {
+        if (OverflowPolicy::DROP == m_overflowPolicy) {
+            ++m_droppedCount;
+            return;
+        }
+        wake();
+        std::this_thread::yield();
+    }
+    // The background thread writes at least every WRITE_INTERVAL; only wake it early if the ring is filling up, or
+    // if the entry is severe enough that it should not wait.
+    if (m_isSleeping && (backlog > m_mask / 2 || level >= Level::ERROR)) {
+        wake();
+    }
+}
+
+void AsyncLogger::flush() {
+    size_t target = m_pushPosition;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isWakeRequested = true;
+    m_wakeTrigger.notify_one();
+    m_flushed.wait(lock, [this, target] { return m_writtenPosition >= target || m_isShuttingDown; });
+}
+
+uint64_t AsyncLogger::getDroppedCount() const {
+    return m_droppedCount;
+}
+
+uint64_t AsyncLogger::getWrittenCount() const {
+    return m_writtenPosition;
+}
+
+bool AsyncLogger::tryPush(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker,
+    const char* text,
+    size_t* backlog) {
+    // This is a bounded multi-producer queue: each Record's sequence says which lap of the ring it is ready for.
+    // A Record is free for position p when its sequence is p, and holds the entry for p once its sequence is p + 1.
+    size_t position = m_pushPosition.load(std::memory_order_relaxed);
+    Record* record = nullptr;
+    while (true) {
+        record = &m_ring[position & m_mask];
+        size_t sequence = record->sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (0 == difference) {
+            if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The Record still holds the entry from the previous lap, so the ring is full.
+            return false;
+        } else {
+            position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+    record->level = level;
+    record->time = time;
+    record->threadMoniker.assign(threadMoniker);
+    record->text.assign(text);
+    record->sequence.store(position + 1, std::memory_order_release);
+    *backlog = position + 1 - m_popPosition.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool AsyncLogger::tryPop(std::string* line) {
+    size_t position = m_popPosition.load(std::memory_order_relaxed);
+    Record* record = &m_ring[position & m_mask];
+    if (record->sequence.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+    *line = formatLogString(record->level, record->time, record->threadMoniker.c_str(), record->text.c_str());
+    line->push_back('\n');
+    // Entries longer than any before grow the strings of their Record, which keeps them for the next laps.
+    auto capacity = record->threadMoniker.capacity() + record->text.capacity();
+    if (capacity > record->countedCapacity) {
+        m_memoryBytes += capacity - record->countedCapacity;
+        record->countedCapacity = capacity;
+    }
+    m_memory.resize(m_memoryBytes);
+    // Hand the Record back to the producers for the next lap.
+    record->sequence.store(position + m_mask + 1, std::memory_order_release);
+    m_popPosition.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncLogger::wake() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isWakeRequested = true;
+    }
+    m_wakeTrigger.notify_one();
+}
+
+void AsyncLogger::writeLoop() {
+    uint64_t reportedDroppedCount = 0;
+    while (true) {
+        size_t count = 0;
+        while (count < MAX_BATCH_SIZE && tryPop(&m_batch[count])) {
+            ++count;
+        }
+        if (count > 0) {
+            writeBatch(count);
+            m_writtenPosition.store(m_popPosition);
+        }
+
+        uint64_t droppedCount = m_droppedCount;
+        if (droppedCount != reportedDroppedCount) {
+            m_batch[0] = formatLogString(
+                Level::WARN,
+                std::chrono::system_clock::now(),
+                DROPPED_NOTE_MONIKER,
+                LogEntry("AsyncLogger", "logEntriesDropped").d("count", droppedCount - reportedDroppedCount).c_str());
+            m_batch[0].push_back('\n');
+            writeBatch(1);
+            reportedDroppedCount = droppedCount;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (count > 0) {
+            m_flushed.notify_all();
+        }
+        if (MAX_BATCH_SIZE == count) {
+            // There may be more entries waiting.
+            continue;
+        }
+        if (m_isShuttingDown) {
+            m_flushed.notify_all();
+            return;
+        }
+        m_isSleeping = true;
+        m_wakeTrigger.wait_for(lock, WRITE_INTERVAL, [this] { return m_isWakeRequested || m_isShuttingDown; });
+        m_isSleeping = false;
+        m_isWakeRequested = false;
+    }
+}
+
+void AsyncLogger::writeBatch(size_t count) {
+    struct iovec iov[MAX_BATCH_SIZE];
+    for (size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = const_cast<char*>(m_batch[i].data());
+        iov[i].iov_len = m_batch[i].size();
+    }
+    struct iovec* next = iov;
+    size_t remaining = count;
+    while (remaining > 0) {
+        ssize_t written = writev(m_fd, next, static_cast<int>(remaining));
+        if (written < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            // Nowhere left to report this; drop the rest of the batch.
+            return;
+        }
+        // Skip the fully written lines, and trim the partially written one.
+        auto bytes = static_cast<size_t>(written);
+        while (remaining > 0 && bytes >= next->iov_len) {
+            bytes -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if (remaining > 0) {
+            next->iov_base = static_cast<char*>(next->iov_base) + bytes;
+            next->iov_len -= bytes;
+        }
+    }
+}
+
+/// The @c AsyncLogger returned by @c getAsyncConsoleLogger().
+class AsyncConsoleLogger : public AsyncLogger {
+public:
+    /// Constructor.
+    AsyncConsoleLogger() :
+#ifdef DEBUG
+            AsyncLogger(Level::DEBUG0, STDOUT_FILENO, CONSOLE_CAPACITY, OverflowPolicy::DROP)
+#else
+            AsyncLogger(Level::INFO, STDOUT_FILENO, CONSOLE_CAPACITY, OverflowPolicy::DROP)
+#endif  // DEBUG
+    {
+        init(configuration::ConfigurationNode::getRoot()[CONFIG_KEY_CONSOLE_LOGGER]);
+    }
+};
+
+/// Write out the entries still in the @c getAsyncConsoleLogger() ring when the process exits.
+static void flushAsyncConsoleLogger() {
+    static_cast<AsyncLogger&>(getAsyncConsoleLogger()).flush();
+}
+
+Logger& getAsyncConsoleLogger() {
+    // Intentionally never destroyed, so that entries logged from static destructors still have somewhere to go.
+    static AsyncConsoleLogger* instance = [] {
+        auto logger = new AsyncConsoleLogger();
+        std::atexit(flushAsyncConsoleLogger);
+        return logger;
+    }();
+    return *instance;
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
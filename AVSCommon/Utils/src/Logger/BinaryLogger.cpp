@@ -0,0 +1,272 @@
+/*
+ * BinaryLogger.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "AVSCommon/Utils/Logger/BinaryLogger.h"
+#include "AVSCommon/Utils/Logger/ConsoleLogger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/// Configuration key for the @c getBinaryLogger() settings.
+static const std::string CONFIG_KEY_BINARY_LOGGER = "binaryLogger";
+
+/// Configuration key for the path of the binary log file.
+static const std::string CONFIG_KEY_PATH = "path";
+
+/// Configuration key for the size of the ring of records.
+static const std::string CONFIG_KEY_RING_SIZE = "ringSize";
+
+/// Configuration key for the size of the dictionary.
+static const std::string CONFIG_KEY_DICTIONARY_SIZE = "dictionarySize";
+
+/// The default path of the @c getBinaryLogger() file.
+static const std::string DEFAULT_PATH = "/tmp/acsdkLog.bin";
+
+/// The default size of the @c getBinaryLogger() ring.
+static const int DEFAULT_RING_SIZE = 1024 * 1024;
+
+/// The default size of the @c getBinaryLogger() dictionary.
+static const int DEFAULT_DICTIONARY_SIZE = 64 * 1024;
+
+/// Suffix added to the path of the previous binary log file.
+static const std::string PREVIOUS_FILE_SUFFIX = ".1";
+
+/// Separator between the source, event and the rest of the text of a @c LogEntry.
+static const char SECTION_SEPARATOR = ':';
+
+const char BinaryLogger::MAGIC[8] = {'A', 'C', 'S', 'D', 'K', 'B', 'L', 'G'};
+const uint32_t BinaryLogger::VERSION;
+const uint8_t BinaryLogger::PADDING_LEVEL;
+
+static_assert(sizeof(BinaryLogFileHeader) == 64, "BinaryLogFileHeader layout changed");
+static_assert(sizeof(BinaryLogRecordHeader) == 24, "BinaryLogRecordHeader layout changed");
+
+/**
+ * Get a clock time in nanoseconds.
+ *
+ * @param time The time.
+ * @return @c time in nanoseconds since the clock's epoch.
+ */
+template <typename TimePoint>
+static int64_t toNanoseconds(TimePoint time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::unique_ptr<BinaryLogger> BinaryLogger::create(
+    Level level,
+    const std::string& path,
+    size_t ringSize,
+    size_t dictionarySize) {
+    // Loggers can't log their own failures without recursing, so failures are reported on stderr.
+    if (ringSize < 2 * sizeof(BinaryLogRecordHeader) || ringSize > std::numeric_limits<uint32_t>::max() ||
+        dictionarySize > std::numeric_limits<uint32_t>::max()) {
+        std::fprintf(stderr, "BinaryLogger::create failed: invalid size\n");
+        return nullptr;
+    }
+    if (0 != rename(path.c_str(), (path + PREVIOUS_FILE_SUFFIX).c_str()) && ENOENT != errno) {
+        std::fprintf(stderr, "BinaryLogger::create: could not keep previous log: %s\n", std::strerror(errno));
+    }
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::fprintf(stderr, "BinaryLogger::create failed: open: %s\n", std::strerror(errno));
+        return nullptr;
+    }
+    size_t mappingSize = sizeof(BinaryLogFileHeader) + dictionarySize + ringSize;
+    if (0 != ftruncate(fd, static_cast<off_t>(mappingSize))) {
+        std::fprintf(stderr, "BinaryLogger::create failed: ftruncate: %s\n", std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == mapping) {
+        std::fprintf(stderr, "BinaryLogger::create failed: mmap: %s\n", std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    auto header = static_cast<BinaryLogFileHeader*>(mapping);
+    std::memcpy(header->magic, MAGIC, sizeof(header->magic));
+    header->version = VERSION;
+    header->recordHeaderSize = sizeof(BinaryLogRecordHeader);
+    header->dictionarySize = static_cast<uint32_t>(dictionarySize);
+    header->ringSize = static_cast<uint32_t>(ringSize);
+    header->dictionaryUsed = 0;
+    header->dictionaryCount = 0;
+    header->wallClockAnchor = toNanoseconds(std::chrono::system_clock::now());
+    header->monotonicAnchor = toNanoseconds(std::chrono::steady_clock::now());
+    header->begin = 0;
+    header->end = 0;
+
+    return std::unique_ptr<BinaryLogger>(new BinaryLogger(level, fd, static_cast<uint8_t*>(mapping), mappingSize));
+}
+
+BinaryLogger::BinaryLogger(Level level, int fd, uint8_t* mapping, size_t mappingSize) :
+        Logger(level),
+        m_fd{fd},
+        m_mapping{mapping},
+        m_mappingSize{mappingSize},
+        m_header{reinterpret_cast<BinaryLogFileHeader*>(mapping)},
+        m_dictionary{mapping + sizeof(BinaryLogFileHeader)},
+        m_ring{m_dictionary + m_header->dictionarySize} {
+}
+
+BinaryLogger::~BinaryLogger() {
+    munmap(m_mapping, m_mappingSize);
+    close(m_fd);
+}
+
+void BinaryLogger::emit(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker,
+    const char* text) {
+    BinaryLogRecordHeader record = {};
+    record.level = static_cast<uint8_t>(level);
+    record.timestamp = toNanoseconds(std::chrono::steady_clock::now());
+
+    size_t monikerLength = std::min(std::strlen(threadMoniker), static_cast<size_t>(UINT8_MAX));
+    record.monikerLength = static_cast<uint8_t>(monikerLength);
+
+    const char* source = text;
+    const char* sourceEnd = std::strchr(source, SECTION_SEPARATOR);
+    const char* event = sourceEnd ? sourceEnd + 1 : nullptr;
+    const char* eventEnd = event ? std::strchr(event, SECTION_SEPARATOR) : nullptr;
+    if (event && !eventEnd) {
+        eventEnd = event + std::strlen(event);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    record.sourceId = 0;
+    record.eventId = 0;
+    const char* rest = text;
+    if (event) {
+        record.sourceId = intern(source, sourceEnd - source);
+        record.eventId = record.sourceId ? intern(event, eventEnd - event) : 0;
+        if (record.eventId) {
+            rest = eventEnd;
+        } else {
+            record.sourceId = 0;
+        }
+    }
+
+    // Keep each record to at most half the ring, so that writing one never evicts the record before it.
+    const size_t ringSize = m_header->ringSize;
+    size_t fixedLength = sizeof(record) + monikerLength;
+    if (fixedLength > ringSize / 2) {
+        return;
+    }
+    size_t restLength = std::min(std::strlen(rest), ringSize / 2 - fixedLength);
+    size_t length = fixedLength + restLength;
+    record.length = static_cast<uint32_t>(length);
+
+    uint64_t start = m_header->end;
+    size_t untilWrap = ringSize - start % ringSize;
+    if (untilWrap < length) {
+        start += untilWrap;
+    }
+    uint64_t end = start + length;
+    while (end - m_header->begin > ringSize) {
+        m_header->begin += recordLengthAt(m_header->begin);
+    }
+    if (start != m_header->end && untilWrap >= sizeof(record)) {
+        BinaryLogRecordHeader padding = {};
+        padding.length = static_cast<uint32_t>(untilWrap);
+        padding.level = PADDING_LEVEL;
+        std::memcpy(m_ring + m_header->end % ringSize, &padding, sizeof(padding));
+    }
+
+    uint8_t* out = m_ring + start % ringSize;
+    std::memcpy(out, &record, sizeof(record));
+    std::memcpy(out + sizeof(record), threadMoniker, monikerLength);
+    std::memcpy(out + fixedLength, rest, restLength);
+    m_header->end = end;
+}
+
+uint32_t BinaryLogger::intern(const char* name, size_t length) {
+    std::string key(name, length);
+    auto it = m_names.find(key);
+    if (it != m_names.end()) {
+        return it->second;
+    }
+    uint16_t nameLength = static_cast<uint16_t>(length);
+    if (length > UINT16_MAX || m_header->dictionaryUsed + sizeof(nameLength) + length > m_header->dictionarySize) {
+        return 0;
+    }
+    uint8_t* out = m_dictionary + m_header->dictionaryUsed;
+    std::memcpy(out, &nameLength, sizeof(nameLength));
+    std::memcpy(out + sizeof(nameLength), name, length);
+    m_header->dictionaryUsed += static_cast<uint32_t>(sizeof(nameLength) + length);
+    uint32_t id = ++m_header->dictionaryCount;
+    m_names.insert({std::move(key), id});
+    return id;
+}
+
+uint64_t BinaryLogger::recordLengthAt(uint64_t position) const {
+    size_t untilWrap = m_header->ringSize - position % m_header->ringSize;
+    if (untilWrap < sizeof(BinaryLogRecordHeader)) {
+        return untilWrap;
+    }
+    uint32_t length;
+    std::memcpy(&length, m_ring + position % m_header->ringSize, sizeof(length));
+    return length;
+}
+
+Logger& getBinaryLogger() {
+    static Logger* instance = []() -> Logger* {
+        auto configuration = configuration::ConfigurationNode::getRoot()[CONFIG_KEY_BINARY_LOGGER];
+        std::string path;
+        int ringSize = 0;
+        int dictionarySize = 0;
+        configuration.getString(CONFIG_KEY_PATH, &path, DEFAULT_PATH);
+        configuration.getInt(CONFIG_KEY_RING_SIZE, &ringSize, DEFAULT_RING_SIZE);
+        configuration.getInt(CONFIG_KEY_DICTIONARY_SIZE, &dictionarySize, DEFAULT_DICTIONARY_SIZE);
+#ifdef DEBUG
+        Level level = Level::DEBUG0;
+#else
+        Level level = Level::INFO;
+#endif  // DEBUG
+        if (ringSize <= 0 || dictionarySize < 0) {
+            std::fprintf(stderr, "getBinaryLogger: invalid size, using ConsoleLogger\n");
+            return &getConsoleLogger();
+        }
+        // Intentionally never destroyed, so that entries logged from static destructors still have somewhere to go.
+        auto logger = BinaryLogger::create(level, path, ringSize, dictionarySize).release();
+        if (!logger) {
+            return &getConsoleLogger();
+        }
+        logger->init(configuration);
+        return logger;
+    }();
+    return *instance;
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
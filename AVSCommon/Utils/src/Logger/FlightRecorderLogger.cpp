@@ -0,0 +1,310 @@
+/*
+ * FlightRecorderLogger.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "AVSCommon/Utils/Logger/ConsoleLogger.h"
+#include "AVSCommon/Utils/Logger/FlightRecorderLogger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/// Configuration key for the @c getFlightRecorderLogger() settings.
+static const std::string CONFIG_KEY_FLIGHT_RECORDER_LOGGER = "flightRecorderLogger";
+
+/// Configuration key for the number of entries of the ring.
+static const std::string CONFIG_KEY_CAPACITY = "capacity";
+
+/// Configuration key for the lowest level of the entries passed on to the console.
+static const std::string CONFIG_KEY_OUTPUT_LEVEL = "outputLogLevel";
+
+/// The default number of entries of the @c getFlightRecorderLogger() ring.
+static const int DEFAULT_CAPACITY = 2048;
+
+/// The default lowest level of the entries @c getFlightRecorderLogger() passes on to the console.
+static const std::string DEFAULT_OUTPUT_LEVEL = "WARN";
+
+/// The signals on which @c installCrashHandler() dumps the active recorder.
+static const int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+
+/// The number of digits of the fraction of a second of the time of a dumped entry.
+static const size_t MILLISECOND_DIGITS = 3;
+
+const size_t FlightRecorderLogger::TEXT_SIZE;
+const size_t FlightRecorderLogger::MONIKER_SIZE;
+
+/// The recorder dumped by @c trigger() and the crash handler, or @c nullptr.
+static std::atomic<FlightRecorderLogger*> g_activeRecorder{nullptr};
+
+/**
+ * Round @c value up to a power of two.
+ *
+ * @param value The value to round up.
+ * @return The smallest power of two which is at least @c value.
+ */
+static uint64_t roundUpToPowerOfTwo(uint64_t value) {
+    uint64_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Append a number in decimal to a buffer.  This is async-signal-safe.
+ *
+ * @param buffer Where to write the digits.
+ * @param value The number.
+ * @param minDigits The least number of digits to write, padding with zeros.
+ * @return The number of characters written, at most 20.
+ */
+static size_t appendNumber(char* buffer, uint64_t value, size_t minDigits) {
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0 && count < sizeof(digits));
+    while (count < minDigits && count < sizeof(digits)) {
+        digits[count++] = '0';
+    }
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+/**
+ * Write a whole buffer to a file descriptor.  This is async-signal-safe.
+ *
+ * @param fd The file descriptor.
+ * @param buffer The buffer.
+ * @param size The size of @c buffer.
+ */
+static void writeAll(int fd, const char* buffer, size_t size) {
+    while (size > 0) {
+        auto written = write(fd, buffer, size);
+        if (written <= 0) {
+            return;
+        }
+        buffer += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+/**
+ * Write a line announcing a dump to a file descriptor.  This is async-signal-safe.
+ *
+ * @param fd The file descriptor.
+ * @param reason Why the entries are dumped.
+ */
+static void writeDumpHeader(int fd, const char* reason) {
+    static const char PREFIX[] = "---- flight recorder: ";
+    writeAll(fd, PREFIX, sizeof(PREFIX) - 1);
+    writeAll(fd, reason, std::strlen(reason));
+    writeAll(fd, "\n", 1);
+}
+
+std::unique_ptr<FlightRecorderLogger> FlightRecorderLogger::create(
+    Level level,
+    size_t capacity,
+    Logger* output,
+    Level outputLevel,
+    int dumpFd) {
+    // Loggers can't log their own failures without recursing, so failures are reported on stderr.
+    if (0 == capacity) {
+        std::fprintf(stderr, "FlightRecorderLogger::create failed: zero capacity\n");
+        return nullptr;
+    }
+    return std::unique_ptr<FlightRecorderLogger>(
+        new FlightRecorderLogger(level, roundUpToPowerOfTwo(capacity), output, outputLevel, dumpFd));
+}
+
+FlightRecorderLogger::FlightRecorderLogger(
+    Level level,
+    size_t capacity,
+    Logger* output,
+    Level outputLevel,
+    int dumpFd) :
+        Logger(level),
+        m_ring{new Record[capacity]},
+        m_mask{capacity - 1},
+        m_nextPosition{0},
+        m_triggerPosition{0},
+        m_output{output},
+        m_outputLevel{outputLevel},
+        m_dumpFd{dumpFd} {
+    for (size_t i = 0; i < capacity; ++i) {
+        // No position has this sequence, so the slot is skipped until it is written.
+        m_ring[i].sequence = 0;
+    }
+}
+
+FlightRecorderLogger::~FlightRecorderLogger() {
+    FlightRecorderLogger* self = this;
+    g_activeRecorder.compare_exchange_strong(self, nullptr);
+}
+
+void FlightRecorderLogger::emit(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker,
+    const char* text) {
+    auto position = m_nextPosition.fetch_add(1, std::memory_order_relaxed);
+    auto& record = m_ring[position & m_mask];
+    record.sequence.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    record.level = static_cast<uint8_t>(level);
+    record.monikerLength = static_cast<uint8_t>(strnlen(threadMoniker, MONIKER_SIZE));
+    std::memcpy(record.moniker, threadMoniker, record.monikerLength);
+    record.textLength = static_cast<uint16_t>(strnlen(text, TEXT_SIZE));
+    std::memcpy(record.text, text, record.textLength);
+    record.sequence.store(2 * position + 2, std::memory_order_release);
+
+    if (m_output && level >= m_outputLevel && m_output->shouldLog(level)) {
+        m_output->emit(level, time, threadMoniker, text);
+    }
+}
+
+size_t FlightRecorderLogger::dump(int fd) const {
+    return dumpRange(fd, 0, m_nextPosition.load(std::memory_order_relaxed));
+}
+
+size_t FlightRecorderLogger::dumpRange(int fd, uint64_t from, uint64_t to) const {
+    if (to > m_mask + 1 && from < to - (m_mask + 1)) {
+        from = to - (m_mask + 1);
+    }
+    // Room for the time, the moniker, the level and the text, with their separators.
+    char line[32 + MONIKER_SIZE + TEXT_SIZE];
+    size_t count = 0;
+    for (auto position = from; position < to; ++position) {
+        const auto& record = m_ring[position & m_mask];
+        auto sequence = record.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * position + 2) {
+            // The slot is being written, or has been overwritten by a later entry.
+            continue;
+        }
+        auto timestamp = static_cast<uint64_t>(record.timestamp);
+        auto monikerLength = std::min<size_t>(record.monikerLength, MONIKER_SIZE);
+        auto textLength = std::min<size_t>(record.textLength, TEXT_SIZE);
+        size_t length = appendNumber(line, timestamp / 1000, 1);
+        line[length++] = '.';
+        length += appendNumber(line + length, timestamp % 1000, MILLISECOND_DIGITS);
+        line[length++] = ' ';
+        line[length++] = '[';
+        std::memcpy(line + length, record.moniker, monikerLength);
+        length += monikerLength;
+        line[length++] = ']';
+        line[length++] = ' ';
+        line[length++] = convertLevelToChar(static_cast<Level>(record.level));
+        line[length++] = ' ';
+        std::memcpy(line + length, record.text, textLength);
+        length += textLength;
+        line[length++] = '\n';
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        writeAll(fd, line, length);
+        ++count;
+    }
+    return count;
+}
+
+void FlightRecorderLogger::activate() {
+    g_activeRecorder = this;
+}
+
+void FlightRecorderLogger::trigger(const char* reason) {
+    auto recorder = g_activeRecorder.load();
+    if (!recorder) {
+        return;
+    }
+    auto to = recorder->m_nextPosition.load(std::memory_order_relaxed);
+    auto from = recorder->m_triggerPosition.exchange(to);
+    if (from >= to) {
+        return;
+    }
+    writeDumpHeader(recorder->m_dumpFd, reason);
+    recorder->dumpRange(recorder->m_dumpFd, from, to);
+}
+
+void FlightRecorderLogger::installCrashHandler() {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &FlightRecorderLogger::handleCrashSignal;
+    sigemptyset(&action.sa_mask);
+    // The default action is restored before the handler runs, so raising the signal again ends the process.
+    action.sa_flags = SA_RESETHAND | SA_NODEFER;
+    for (auto signalNumber : CRASH_SIGNALS) {
+        sigaction(signalNumber, &action, nullptr);
+    }
+}
+
+void FlightRecorderLogger::handleCrashSignal(int signalNumber) {
+    auto recorder = g_activeRecorder.load();
+    if (recorder) {
+        writeDumpHeader(recorder->m_dumpFd, "fatal signal");
+        recorder->dump(recorder->m_dumpFd);
+    }
+    raise(signalNumber);
+}
+
+Logger& getFlightRecorderLogger() {
+    static Logger* instance = []() -> Logger* {
+        auto configuration = configuration::ConfigurationNode::getRoot()[CONFIG_KEY_FLIGHT_RECORDER_LOGGER];
+        int capacity = 0;
+        std::string outputLevelName;
+        configuration.getInt(CONFIG_KEY_CAPACITY, &capacity, DEFAULT_CAPACITY);
+        configuration.getString(CONFIG_KEY_OUTPUT_LEVEL, &outputLevelName, DEFAULT_OUTPUT_LEVEL);
+        auto outputLevel = convertNameToLevel(outputLevelName);
+        if (Level::UNKNOWN == outputLevel) {
+            std::fprintf(
+                stderr, "getFlightRecorderLogger: unknown output level, using %s\n", DEFAULT_OUTPUT_LEVEL.c_str());
+            outputLevel = convertNameToLevel(DEFAULT_OUTPUT_LEVEL);
+        }
+        if (capacity <= 0) {
+            std::fprintf(stderr, "getFlightRecorderLogger: invalid capacity, using ConsoleLogger\n");
+            return &getConsoleLogger();
+        }
+        // Intentionally never destroyed, so that entries logged from static destructors still have somewhere to go.
+        auto logger =
+            FlightRecorderLogger::create(Level::DEBUG9, capacity, &getConsoleLogger(), outputLevel, STDERR_FILENO)
+                .release();
+        if (!logger) {
+            return &getConsoleLogger();
+        }
+        logger->init(configuration);
+        logger->activate();
+        FlightRecorderLogger::installCrashHandler();
+        return logger;
+    }();
+    return *instance;
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
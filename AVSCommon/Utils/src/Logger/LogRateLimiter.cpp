@@ -0,0 +1,61 @@
+/*
+ * LogRateLimiter.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <limits>
+
+#include "AVSCommon/Utils/Logger/LogRateLimiter.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/// The value of @c m_lastLoggedTime before @c admitAtInterval() has logged an occurrence.
+static const int64_t NEVER_LOGGED = std::numeric_limits<int64_t>::min();
+
+LogRateLimiter::LogRateLimiter() : m_count{0}, m_suppressed{0}, m_lastLoggedTime{NEVER_LOGGED} {
+}
+
+bool LogRateLimiter::admitEveryN(uint64_t n, uint64_t* suppressed) {
+    auto count = m_count.fetch_add(1, std::memory_order_relaxed);
+    if (n > 1 && 0 != count % n) {
+        return false;
+    }
+    *suppressed = (n > 1 && count > 0) ? n - 1 : 0;
+    return true;
+}
+
+bool LogRateLimiter::admitAtInterval(std::chrono::milliseconds interval, uint64_t* suppressed) {
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count();
+    auto lastLoggedTime = m_lastLoggedTime.load(std::memory_order_relaxed);
+    // Of the threads which find the interval has passed, only the one which updates the time logs.
+    if ((NEVER_LOGGED == lastLoggedTime ||
+         now - lastLoggedTime >= std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count()) &&
+        m_lastLoggedTime.compare_exchange_strong(lastLoggedTime, now, std::memory_order_relaxed)) {
+        *suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -28,6 +28,11 @@ namespace logger {
 /// Configuration key for log level
 static const std::string CONFIG_KEY_LOG_LEVEL = "logLevel";
 
+static_assert(
+    static_cast<int>(Level::DEBUG9) == ACSDK_LOG_LEVEL_DEBUG9 && static_cast<int>(Level::INFO) == ACSDK_LOG_LEVEL_INFO &&
+        static_cast<int>(Level::NONE) == ACSDK_LOG_LEVEL_NONE,
+    "ACSDK_LOG_LEVEL_<LEVEL> values must match the Level enum");
+
 Logger::Logger(Level level) : m_level{level} {
 }
 
@@ -0,0 +1,179 @@
+/*
+ * MemoryBudget.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Memory/MemoryBudget.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace memory {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MemoryBudget");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const uint64_t MemoryBudget::UNLIMITED;
+
+/**
+ * Get the storage of the @c MemoryBudget set with @c MemoryBudget::setDefault().  It is only accessed with
+ * @c std::atomic_load() and @c std::atomic_store().
+ *
+ * @return The storage of the default @c MemoryBudget.
+ */
+static std::shared_ptr<MemoryBudget>& defaultBudget() {
+    static std::shared_ptr<MemoryBudget> budget;
+    return budget;
+}
+
+MemoryBudget::Reservation::Reservation(std::shared_ptr<MemoryBudget> budget, uint64_t bytes) :
+        m_budget{std::move(budget)},
+        m_bytes{bytes} {
+}
+
+MemoryBudget::Reservation::~Reservation() {
+    m_budget->release(m_bytes, true);
+}
+
+uint64_t MemoryBudget::Reservation::getBytes() const {
+    return m_bytes;
+}
+
+void MemoryBudget::Reservation::shrink(uint64_t bytes) {
+    if (bytes >= m_bytes) {
+        return;
+    }
+    m_budget->release(m_bytes - bytes, false);
+    m_bytes = bytes;
+}
+
+std::shared_ptr<MemoryBudget> MemoryBudget::getDefault() {
+    auto budget = std::atomic_load(&defaultBudget());
+    if (budget) {
+        return budget;
+    }
+    static std::shared_ptr<MemoryBudget> unlimited(new MemoryBudget(UNLIMITED, UNLIMITED));
+    return unlimited;
+}
+
+void MemoryBudget::setDefault(std::shared_ptr<MemoryBudget> budget) {
+    std::atomic_store(&defaultBudget(), budget);
+}
+
+std::shared_ptr<MemoryBudget> MemoryBudget::create(uint64_t maxBytes, uint64_t lowPriorityMaxBytes) {
+    if (0 == maxBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxBytes"));
+        return nullptr;
+    }
+    return std::shared_ptr<MemoryBudget>(new MemoryBudget(maxBytes, std::min(maxBytes, lowPriorityMaxBytes)));
+}
+
+MemoryBudget::MemoryBudget(uint64_t maxBytes, uint64_t lowPriorityMaxBytes) : m_gauges() {
+    m_gauges.maxBytes = maxBytes;
+    m_gauges.lowPriorityMaxBytes = lowPriorityMaxBytes;
+}
+
+std::unique_ptr<MemoryBudget::Reservation> MemoryBudget::reserve(
+    uint64_t preferredBytes,
+    uint64_t minimumBytes,
+    Priority priority) {
+    minimumBytes = std::min(minimumBytes, preferredBytes);
+    uint64_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto limit = Priority::LOW == priority ? m_gauges.lowPriorityMaxBytes : m_gauges.maxBytes;
+        auto available = limit > m_gauges.reservedBytes ? limit - m_gauges.reservedBytes : 0;
+        if (preferredBytes <= available) {
+            bytes = preferredBytes;
+        } else if (minimumBytes <= available) {
+            bytes = available;
+            ++m_gauges.shrunkRequests;
+        } else if (Priority::HIGH == priority) {
+            bytes = minimumBytes;
+            ++m_gauges.overBudgetRequests;
+        } else {
+            ++m_gauges.rejectedRequests;
+            ACSDK_WARN(LX("reserveRejected")
+                           .d("preferredBytes", preferredBytes)
+                           .d("minimumBytes", minimumBytes)
+                           .d("priority", priority)
+                           .d("reservedBytes", m_gauges.reservedBytes)
+                           .d("limit", limit));
+            return nullptr;
+        }
+        m_gauges.reservedBytes += bytes;
+        m_gauges.highWaterBytes = std::max(m_gauges.highWaterBytes, m_gauges.reservedBytes);
+        ++m_gauges.reservations;
+    }
+    return std::unique_ptr<Reservation>(new Reservation(shared_from_this(), bytes));
+}
+
+MemoryBudget::Gauges MemoryBudget::getGauges() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_gauges;
+}
+
+void MemoryBudget::resetHighWaterMark() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_gauges.highWaterBytes = m_gauges.reservedBytes;
+}
+
+void MemoryBudget::dump() const {
+    auto gauges = getGauges();
+    ACSDK_INFO(LX("memoryBudget")
+                   .d("maxBytes", gauges.maxBytes)
+                   .d("lowPriorityMaxBytes", gauges.lowPriorityMaxBytes)
+                   .d("reservedBytes", gauges.reservedBytes)
+                   .d("highWaterBytes", gauges.highWaterBytes)
+                   .d("reservations", gauges.reservations)
+                   .d("shrunkRequests", gauges.shrunkRequests)
+                   .d("overBudgetRequests", gauges.overBudgetRequests)
+                   .d("rejectedRequests", gauges.rejectedRequests));
+}
+
+void MemoryBudget::release(uint64_t bytes, bool isLast) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_gauges.reservedBytes -= bytes;
+    if (isLast) {
+        --m_gauges.reservations;
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, MemoryBudget::Priority priority) {
+    switch (priority) {
+        case MemoryBudget::Priority::LOW:
+            return stream << "LOW";
+        case MemoryBudget::Priority::NORMAL:
+            return stream << "NORMAL";
+        case MemoryBudget::Priority::HIGH:
+            return stream << "HIGH";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,176 @@
+/*
+ * DialogLatencyTracer.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Metrics/DialogLatencyTracer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DialogLatencyTracer");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t DialogLatencyTracer::NUM_MARKS;
+
+/// The largest number of traces kept in progress.  Traces which never end are forgotten beyond this.
+static const size_t MAX_TRACES_IN_PROGRESS = 16;
+
+/**
+ * Get the bit representing a mark.
+ *
+ * @param mark The mark.
+ * @return The bit.
+ */
+static uint32_t markBit(DialogLatencyTracer::Mark mark) {
+    return static_cast<uint32_t>(1) << static_cast<size_t>(mark);
+}
+
+DialogLatencyTracer& DialogLatencyTracer::instance() {
+    static DialogLatencyTracer tracer;
+    return tracer;
+}
+
+DialogLatencyTracer::DialogLatencyTracer() : m_isEnabled{false} {
+}
+
+void DialogLatencyTracer::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isEnabled = enabled;
+    if (!enabled) {
+        m_traces.clear();
+        m_traceOrder.clear();
+    }
+}
+
+bool DialogLatencyTracer::isEnabled() const {
+    return m_isEnabled;
+}
+
+void DialogLatencyTracer::startTrace(
+    const std::string& dialogRequestId,
+    std::chrono::steady_clock::time_point keywordEnd) {
+    if (!m_isEnabled || dialogRequestId.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isEnabled || m_traces.count(dialogRequestId)) {
+        return;
+    }
+    if (m_traceOrder.size() >= MAX_TRACES_IN_PROGRESS) {
+        m_traces.erase(m_traceOrder.front());
+        m_traceOrder.pop_front();
+    }
+    m_traces[dialogRequestId] = {keywordEnd, markBit(Mark::KEYWORD_END)};
+    m_traceOrder.push_back(dialogRequestId);
+    m_histograms[static_cast<size_t>(Mark::KEYWORD_END)].record(0);
+}
+
+void DialogLatencyTracer::mark(
+    const std::string& dialogRequestId,
+    Mark mark,
+    std::chrono::steady_clock::time_point when) {
+    if (!m_isEnabled || dialogRequestId.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_traces.find(dialogRequestId);
+    if (m_traces.end() == it || (it->second.placedMarks & markBit(mark))) {
+        return;
+    }
+    it->second.placedMarks |= markBit(mark);
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(when - it->second.keywordEnd);
+    m_histograms[static_cast<size_t>(mark)].record(latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0);
+    if (Mark::SPEECH_FINISHED == mark) {
+        // The dialogRequestId is left in m_traceOrder, and is dropped from it as newer traces start.
+        m_traces.erase(it);
+    }
+}
+
+std::vector<DialogLatencyTracer::Summary> DialogLatencyTracer::getSummaries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Summary> summaries;
+    for (size_t mark = 0; mark < NUM_MARKS; ++mark) {
+        const auto& histogram = m_histograms[mark];
+        if (0 == histogram.getCount()) {
+            continue;
+        }
+        summaries.push_back({static_cast<Mark>(mark),
+                             histogram.getCount(),
+                             std::chrono::microseconds(histogram.getValueAtPercentile(50)),
+                             std::chrono::microseconds(histogram.getValueAtPercentile(90)),
+                             std::chrono::microseconds(histogram.getValueAtPercentile(99)),
+                             std::chrono::microseconds(histogram.getMax())});
+    }
+    return summaries;
+}
+
+void DialogLatencyTracer::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_traces.clear();
+    m_traceOrder.clear();
+    for (auto& histogram : m_histograms) {
+        histogram.reset();
+    }
+}
+
+void DialogLatencyTracer::dump() const {
+    for (const auto& summary : getSummaries()) {
+        ACSDK_INFO(LX("dialogLatency")
+                       .d("mark", summary.mark)
+                       .d("count", summary.count)
+                       .d("p50Us", summary.p50.count())
+                       .d("p90Us", summary.p90.count())
+                       .d("p99Us", summary.p99.count())
+                       .d("maxUs", summary.max.count()));
+    }
+}
+
+std::string DialogLatencyTracer::markToString(Mark mark) {
+    switch (mark) {
+        case Mark::KEYWORD_END:
+            return "KEYWORD_END";
+        case Mark::SEND_START:
+            return "SEND_START";
+        case Mark::FIRST_DIRECTIVE:
+            return "FIRST_DIRECTIVE";
+        case Mark::SEND_END:
+            return "SEND_END";
+        case Mark::FIRST_ATTACHMENT_BYTE:
+            return "FIRST_ATTACHMENT_BYTE";
+        case Mark::SPEAK_RECEIVED:
+            return "SPEAK_RECEIVED";
+        case Mark::FIRST_AUDIO:
+            return "FIRST_AUDIO";
+        case Mark::SPEECH_FINISHED:
+            return "SPEECH_FINISHED";
+    }
+    return "UNKNOWN";
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,254 @@
+/*
+ * DirectiveLatencyTracker.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AVSCommon/Utils/JSON/JSONUtils.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Memory/Memory.h"
+#include "AVSCommon/Utils/Metrics/DialogLatencyTracer.h"
+#include "AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DirectiveLatencyTracker");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t DirectiveLatencyTracker::NUM_STAGES;
+
+/// The largest number of directives kept in flight.  Directives which never complete are forgotten beyond this.
+static const size_t MAX_IN_FLIGHT_DIRECTIVES = 256;
+
+/// The key of the messageId in the header of a directive.
+static const std::string MESSAGE_ID_KEY = "messageId";
+
+/**
+ * Get the bit representing a stage.
+ *
+ * @param stage The stage.
+ * @return The bit.
+ */
+static uint32_t stageBit(DirectiveLatencyTracker::Stage stage) {
+    return static_cast<uint32_t>(1) << static_cast<size_t>(stage);
+}
+
+DirectiveLatencyTracker& DirectiveLatencyTracker::instance() {
+    static DirectiveLatencyTracker tracker;
+    return tracker;
+}
+
+DirectiveLatencyTracker::DirectiveLatencyTracker() : m_isEnabled{false} {
+}
+
+void DirectiveLatencyTracker::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isEnabled = enabled;
+    if (!enabled) {
+        m_inFlight.clear();
+        m_inFlightOrder.clear();
+    }
+}
+
+bool DirectiveLatencyTracker::isEnabled() const {
+    return m_isEnabled;
+}
+
+void DirectiveLatencyTracker::record(
+    const std::string& messageId,
+    const std::string& nameSpace,
+    Stage stage,
+    std::chrono::steady_clock::time_point when) {
+    if (!m_isEnabled || messageId.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isEnabled) {
+        return;
+    }
+    auto it = m_inFlight.find(messageId);
+    if (m_inFlight.end() == it) {
+        if (m_inFlightOrder.size() >= MAX_IN_FLIGHT_DIRECTIVES) {
+            m_inFlight.erase(m_inFlightOrder.front());
+            m_inFlightOrder.pop_front();
+        }
+        it = m_inFlight.insert({messageId, InFlightDirective()}).first;
+        it->second.recordedStages = 0;
+        it->second.reportedStages = 0;
+        m_inFlightOrder.push_back(messageId);
+    }
+    auto& directive = it->second;
+    if (directive.nameSpace.empty()) {
+        directive.nameSpace = nameSpace;
+    }
+    directive.times[static_cast<size_t>(stage)] = when;
+    directive.recordedStages |= stageBit(stage);
+    reportLocked(&directive);
+    if (Stage::COMPLETED == stage) {
+        // The messageId is left in m_inFlightOrder, and is dropped from it as newer directives arrive.
+        m_inFlight.erase(it);
+    }
+}
+
+void DirectiveLatencyTracker::recordReceived(
+    const std::string& unparsedDirective,
+    std::chrono::steady_clock::time_point receivedAt) {
+    if (!m_isEnabled) {
+        return;
+    }
+    std::string messageId;
+    if (!json::jsonUtils::scanStringValue(unparsedDirective, MESSAGE_ID_KEY, &messageId) || messageId.empty()) {
+        ACSDK_DEBUG9(LX("recordReceivedIgnored").d("reason", "messageIdNotFound"));
+        return;
+    }
+    record(messageId, "", Stage::ACL_RECEIVE, receivedAt);
+    record(messageId, "", Stage::MIME_PART_END);
+}
+
+std::vector<DirectiveLatencyTracker::Summary> DirectiveLatencyTracker::getSummaries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Summary> summaries;
+    for (const auto& item : m_histograms) {
+        for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+            const auto& histogram = item.second[stage];
+            if (0 == histogram.getCount()) {
+                continue;
+            }
+            summaries.push_back({item.first,
+                                 static_cast<Stage>(stage),
+                                 histogram.getCount(),
+                                 std::chrono::microseconds(histogram.getValueAtPercentile(50)),
+                                 std::chrono::microseconds(histogram.getValueAtPercentile(90)),
+                                 std::chrono::microseconds(histogram.getValueAtPercentile(99)),
+                                 std::chrono::microseconds(histogram.getMax())});
+        }
+    }
+    return summaries;
+}
+
+void DirectiveLatencyTracker::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inFlight.clear();
+    m_inFlightOrder.clear();
+    m_histograms.clear();
+}
+
+void DirectiveLatencyTracker::dump() const {
+    for (const auto& summary : getSummaries()) {
+        ACSDK_INFO(LX("directiveLatency")
+                       .d("namespace", summary.nameSpace)
+                       .d("stage", summary.stage)
+                       .d("count", summary.count)
+                       .d("p50Us", summary.p50.count())
+                       .d("p90Us", summary.p90.count())
+                       .d("p99Us", summary.p99.count())
+                       .d("maxUs", summary.max.count()));
+    }
+}
+
+bool DirectiveLatencyTracker::startPeriodicDump(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_dumpTimer) {
+        ACSDK_ERROR(LX("startPeriodicDumpFailed").d("reason", "alreadyStarted"));
+        return false;
+    }
+    auto timer = memory::make_unique<timing::Timer>();
+    auto dumpAll = [this]() {
+        dump();
+        DialogLatencyTracer::instance().dump();
+    };
+    if (!timer->start(interval, timing::Timer::PeriodType::ABSOLUTE, timing::Timer::FOREVER, dumpAll)) {
+        ACSDK_ERROR(LX("startPeriodicDumpFailed").d("reason", "startTimerFailed"));
+        return false;
+    }
+    m_dumpTimer = std::move(timer);
+    return true;
+}
+
+void DirectiveLatencyTracker::stopPeriodicDump() {
+    std::unique_ptr<timing::Timer> timer;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(timer, m_dumpTimer);
+    }
+    // Stop the timer without holding m_mutex, since a dump in progress needs it.
+    if (timer) {
+        timer->stop();
+    }
+}
+
+std::string DirectiveLatencyTracker::stageToString(Stage stage) {
+    switch (stage) {
+        case Stage::ACL_RECEIVE:
+            return "ACL_RECEIVE";
+        case Stage::MIME_PART_END:
+            return "MIME_PART_END";
+        case Stage::ADSL_ENQUEUE:
+            return "ADSL_ENQUEUE";
+        case Stage::ADSL_DEQUEUE:
+            return "ADSL_DEQUEUE";
+        case Stage::PRE_HANDLE:
+            return "PRE_HANDLE";
+        case Stage::HANDLE_START:
+            return "HANDLE_START";
+        case Stage::COMPLETED:
+            return "COMPLETED";
+    }
+    return "UNKNOWN";
+}
+
+void DirectiveLatencyTracker::reportLocked(InFlightDirective* directive) {
+    if (directive->nameSpace.empty()) {
+        return;
+    }
+    // Latencies are measured from the earliest stage recorded, which is normally Stage::ACL_RECEIVE.
+    auto start = std::chrono::steady_clock::time_point::max();
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+        if (directive->recordedStages & stageBit(static_cast<Stage>(stage))) {
+            start = std::min(start, directive->times[stage]);
+        }
+    }
+    auto unreported = directive->recordedStages & ~directive->reportedStages;
+    if (!unreported) {
+        return;
+    }
+    auto& histograms = m_histograms[directive->nameSpace];
+    if (histograms.empty()) {
+        histograms.resize(NUM_STAGES);
+    }
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+        if (unreported & stageBit(static_cast<Stage>(stage))) {
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(directive->times[stage] - start);
+            histograms[stage].record(latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0);
+        }
+    }
+    directive->reportedStages = directive->recordedStages;
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,104 @@
+/*
+ * LatencyHistogram.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "AVSCommon/Utils/Metrics/LatencyHistogram.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+const size_t LatencyHistogram::SUB_BUCKET_COUNT;
+const uint64_t LatencyHistogram::MAX_VALUE;
+
+/// The number of linear buckets in each power-of-two range above @c SUB_BUCKET_COUNT.
+static const size_t HALF_SUB_BUCKET_COUNT = LatencyHistogram::SUB_BUCKET_COUNT / 2;
+
+LatencyHistogram::LatencyHistogram() :
+        m_counts(getBucketIndex(MAX_VALUE) + 1, 0),
+        m_totalCount{0},
+        m_max{0} {
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    value = std::min(value, MAX_VALUE);
+    ++m_counts[getBucketIndex(value)];
+    ++m_totalCount;
+    m_max = std::max(m_max, value);
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return m_totalCount;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return m_max;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (0 == m_totalCount) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    auto target = static_cast<uint64_t>(std::ceil(percentile * m_totalCount / 100.0));
+    target = std::max(target, static_cast<uint64_t>(1));
+    uint64_t cumulativeCount = 0;
+    for (size_t index = 0; index < m_counts.size(); ++index) {
+        cumulativeCount += m_counts[index];
+        if (cumulativeCount >= target) {
+            return std::min(getHighestEquivalentValue(index), m_max);
+        }
+    }
+    return m_max;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_totalCount = 0;
+    m_max = 0;
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    // Shift the value into [HALF_SUB_BUCKET_COUNT, SUB_BUCKET_COUNT), which selects the bucket within its range.
+    size_t shift = 1;
+    while ((value >> shift) >= SUB_BUCKET_COUNT) {
+        ++shift;
+    }
+    return SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT +
+           static_cast<size_t>((value >> shift) - HALF_SUB_BUCKET_COUNT);
+}
+
+uint64_t LatencyHistogram::getHighestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    auto offset = index - SUB_BUCKET_COUNT;
+    auto shift = offset / HALF_SUB_BUCKET_COUNT + 1;
+    uint64_t subBucket = offset % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,197 @@
+/*
+ * MemoryAccounting.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MemoryAccounting");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t MemoryAccounting::NUM_CATEGORIES;
+
+/// The counters of a category.
+struct Counters {
+    /// The number of bytes held.
+    std::atomic<uint64_t> bytes{0};
+
+    /// The most bytes held.
+    std::atomic<uint64_t> highWaterBytes{0};
+
+    /// The number of allocations held.
+    std::atomic<uint64_t> allocations{0};
+};
+
+/// The state of the accounting.
+struct Accounts {
+    /// Whether memory is counted.
+    std::atomic<bool> isEnabled{false};
+
+    /// The counters of each category.
+    std::array<Counters, MemoryAccounting::NUM_CATEGORIES> counters;
+
+    /// Serializes access to @c samplers.
+    std::mutex samplerMutex;
+
+    /// The sampler of each category, or empty for a category counted with @c Allocation objects.
+    std::array<std::function<uint64_t()>, MemoryAccounting::NUM_CATEGORIES> samplers;
+};
+
+/**
+ * Get the state of the accounting.  It is never destroyed, so that objects destroyed during exit may still release
+ * their memory.
+ *
+ * @return The state of the accounting.
+ */
+static Accounts& getAccounts() {
+    static auto accounts = new Accounts;
+    return *accounts;
+}
+
+/**
+ * Raise a high-water mark to a number of bytes, if it is lower.
+ *
+ * @param highWaterBytes The high-water mark.
+ * @param bytes The number of bytes.
+ */
+static void raiseHighWaterMark(std::atomic<uint64_t>* highWaterBytes, uint64_t bytes) {
+    auto highWater = highWaterBytes->load(std::memory_order_relaxed);
+    while (highWater < bytes && !highWaterBytes->compare_exchange_weak(highWater, bytes, std::memory_order_relaxed)) {
+    }
+}
+
+MemoryAccounting::Allocation::Allocation(Category category) : m_category{category}, m_bytes{0}, m_isCounted{false} {
+}
+
+MemoryAccounting::Allocation::Allocation(Category category, uint64_t bytes) : Allocation(category) {
+    resize(bytes);
+}
+
+MemoryAccounting::Allocation::~Allocation() {
+    resize(0);
+}
+
+void MemoryAccounting::Allocation::resize(uint64_t bytes) {
+    if (m_isCounted && bytes == m_bytes) {
+        return;
+    }
+    auto& counters = getAccounts().counters[static_cast<size_t>(m_category)];
+    if (!m_isCounted) {
+        if (0 == bytes || !isEnabled()) {
+            return;
+        }
+        m_isCounted = true;
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (bytes >= m_bytes) {
+        auto total = counters.bytes.fetch_add(bytes - m_bytes, std::memory_order_relaxed) + (bytes - m_bytes);
+        raiseHighWaterMark(&counters.highWaterBytes, total);
+    } else {
+        counters.bytes.fetch_sub(m_bytes - bytes, std::memory_order_relaxed);
+    }
+    m_bytes = bytes;
+    if (0 == bytes) {
+        m_isCounted = false;
+        counters.allocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void MemoryAccounting::setEnabled(bool enabled) {
+    getAccounts().isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MemoryAccounting::isEnabled() {
+    return getAccounts().isEnabled.load(std::memory_order_relaxed);
+}
+
+void MemoryAccounting::setSampler(Category category, std::function<uint64_t()> sampler) {
+    auto& accounts = getAccounts();
+    std::lock_guard<std::mutex> lock(accounts.samplerMutex);
+    accounts.samplers[static_cast<size_t>(category)] = std::move(sampler);
+}
+
+std::vector<MemoryAccounting::Usage> MemoryAccounting::getSnapshot() {
+    auto& accounts = getAccounts();
+    std::vector<Usage> snapshot;
+    std::lock_guard<std::mutex> lock(accounts.samplerMutex);
+    for (size_t category = 0; category < NUM_CATEGORIES; ++category) {
+        auto& counters = accounts.counters[category];
+        const auto& sampler = accounts.samplers[category];
+        if (sampler && isEnabled()) {
+            auto bytes = sampler();
+            counters.bytes.store(bytes, std::memory_order_relaxed);
+            raiseHighWaterMark(&counters.highWaterBytes, bytes);
+        }
+        snapshot.push_back({static_cast<Category>(category),
+                            counters.bytes.load(std::memory_order_relaxed),
+                            counters.highWaterBytes.load(std::memory_order_relaxed),
+                            counters.allocations.load(std::memory_order_relaxed)});
+    }
+    return snapshot;
+}
+
+void MemoryAccounting::resetHighWaterMarks() {
+    for (auto& counters : getAccounts().counters) {
+        counters.highWaterBytes.store(counters.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void MemoryAccounting::dump() {
+    for (const auto& usage : getSnapshot()) {
+        ACSDK_INFO(LX("memoryUsage")
+                       .d("category", usage.category)
+                       .d("bytes", usage.bytes)
+                       .d("highWaterBytes", usage.highWaterBytes)
+                       .d("allocations", usage.allocations));
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, MemoryAccounting::Category category) {
+    switch (category) {
+        case MemoryAccounting::Category::ATTACHMENTS:
+            return stream << "ATTACHMENTS";
+        case MemoryAccounting::Category::JSON_DOCUMENTS:
+            return stream << "JSON_DOCUMENTS";
+        case MemoryAccounting::Category::MEDIA_BUFFERS:
+            return stream << "MEDIA_BUFFERS";
+        case MemoryAccounting::Category::SQLITE:
+            return stream << "SQLITE";
+        case MemoryAccounting::Category::LOGGING:
+            return stream << "LOGGING";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,83 @@
+/*
+ * StartupProfiler.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Metrics/StartupProfiler.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("StartupProfiler");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+StartupProfiler::StartupProfiler(const std::string& name) : m_name{name}, m_start{Clock::now()} {
+}
+
+void StartupProfiler::record(const std::string& name, Clock::time_point start) {
+    auto now = Clock::now();
+    Stage stage{name,
+                std::chrono::duration_cast<std::chrono::milliseconds>(start - m_start),
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - start)};
+    ACSDK_DEBUG(LX("stageCompleted").d("startup", m_name).d("stage", name).d("durationMs", stage.duration.count()));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stages.push_back(stage);
+}
+
+std::vector<StartupProfiler::Stage> StartupProfiler::getStages() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stages;
+}
+
+std::chrono::milliseconds StartupProfiler::getElapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_start);
+}
+
+void StartupProfiler::log() const {
+    for (auto& stage : getStages()) {
+        ACSDK_INFO(LX("stage")
+                       .d("startup", m_name)
+                       .d("stage", stage.name)
+                       .d("startMs", stage.startOffset.count())
+                       .d("durationMs", stage.duration.count()));
+    }
+    ACSDK_INFO(LX("elapsed").d("startup", m_name).d("elapsedMs", getElapsed().count()));
+}
+
+StartupProfiler::ScopedStage::ScopedStage(StartupProfiler* profiler, const std::string& name) :
+        m_profiler{profiler},
+        m_name{name},
+        m_start{Clock::now()} {
+}
+
+StartupProfiler::ScopedStage::~ScopedStage() {
+    m_profiler->record(m_name, m_start);
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
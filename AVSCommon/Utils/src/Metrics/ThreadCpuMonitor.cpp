@@ -0,0 +1,245 @@
+/*
+ * ThreadCpuMonitor.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Metrics/ThreadCpuMonitor.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+
+using namespace threading;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ThreadCpuMonitor");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The directory holding a directory per thread of the process.
+static const std::string TASK_DIRECTORY = "/proc/self/task/";
+
+/// The index of the user time among the fields of a stat file which follow the name of the thread.
+static const size_t UTIME_FIELD_INDEX = 11;
+
+/// The label of the number of voluntary context switches in a status file.
+static const std::string VOLUNTARY_CONTEXT_SWITCHES_LABEL = "voluntary_ctxt_switches:";
+
+/// The label of the number of involuntary context switches in a status file.
+static const std::string INVOLUNTARY_CONTEXT_SWITCHES_LABEL = "nonvoluntary_ctxt_switches:";
+
+/**
+ * Read a whole file.
+ *
+ * @param path The path of the file.
+ * @param[out] contents The contents of the file.
+ * @return Whether the file was read.
+ */
+static bool readFile(const std::string& path, std::string* contents) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    *contents = stream.str();
+    return true;
+}
+
+std::unique_ptr<ThreadCpuMonitor> ThreadCpuMonitor::create(std::chrono::milliseconds period) {
+#ifdef __linux__
+    if (period.count() <= 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidPeriod").d("periodMs", period.count()));
+        return nullptr;
+    }
+    std::unique_ptr<ThreadCpuMonitor> monitor(new ThreadCpuMonitor());
+    monitor->m_previous = sampleThreads();
+    auto rawMonitor = monitor.get();
+    if (!monitor->m_timer.start(
+            period, timing::Timer::PeriodType::ABSOLUTE, timing::Timer::FOREVER, [rawMonitor]() {
+                rawMonitor->report();
+            })) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "startTimerFailed"));
+        return nullptr;
+    }
+    return monitor;
+#else
+    ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedPlatform"));
+    return nullptr;
+#endif
+}
+
+ThreadCpuMonitor::ThreadCpuMonitor() {
+}
+
+ThreadCpuMonitor::~ThreadCpuMonitor() {
+    m_timer.stop();
+}
+
+std::vector<ThreadCpuMonitor::Usage> ThreadCpuMonitor::getLastReport() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastReport;
+}
+
+std::vector<ThreadCpuMonitor::ThreadSample> ThreadCpuMonitor::sampleThreads() {
+    std::vector<ThreadSample> samples;
+    auto ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (ticksPerSecond <= 0) {
+        return samples;
+    }
+    for (const auto& thread : ThreadFactory::getRunningThreads()) {
+        auto directory = TASK_DIRECTORY + std::to_string(thread.tid) + "/";
+        std::string stat;
+        std::string status;
+        ThreadSample sample{thread, std::chrono::milliseconds::zero(), 0, 0};
+        uint64_t ticks = 0;
+        // A thread which exited since it was listed has no files any more.
+        if (!readFile(directory + "stat", &stat) || !parseStat(stat, &ticks) ||
+            !readFile(directory + "status", &status) ||
+            !parseStatus(status, &sample.voluntaryContextSwitches, &sample.involuntaryContextSwitches)) {
+            continue;
+        }
+        sample.cpuTime = std::chrono::milliseconds(ticks * 1000 / ticksPerSecond);
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+std::vector<ThreadCpuMonitor::Usage> ThreadCpuMonitor::getUsage(
+    const std::vector<ThreadSample>& previous,
+    const std::vector<ThreadSample>& current) {
+    std::map<int, const ThreadSample*> previousByTid;
+    for (const auto& sample : previous) {
+        previousByTid[sample.thread.tid] = &sample;
+    }
+    std::map<std::pair<ThreadRole, std::string>, Usage> usageByName;
+    for (const auto& sample : current) {
+        auto key = std::make_pair(sample.thread.role, sample.thread.name);
+        auto it = usageByName.find(key);
+        if (it == usageByName.end()) {
+            Usage usage{sample.thread.role, sample.thread.name, 0, std::chrono::milliseconds::zero(), 0, 0};
+            it = usageByName.insert({key, usage}).first;
+        }
+        auto& usage = it->second;
+        ++usage.numThreads;
+        usage.cpuTime += sample.cpuTime;
+        usage.voluntaryContextSwitches += sample.voluntaryContextSwitches;
+        usage.involuntaryContextSwitches += sample.involuntaryContextSwitches;
+        auto previousSample = previousByTid.find(sample.thread.tid);
+        // A thread id may be reused by a thread of another role, which is then counted from zero.
+        if (previousSample != previousByTid.end() && previousSample->second->thread.role == sample.thread.role &&
+            previousSample->second->thread.name == sample.thread.name) {
+            usage.cpuTime -= previousSample->second->cpuTime;
+            usage.voluntaryContextSwitches -= previousSample->second->voluntaryContextSwitches;
+            usage.involuntaryContextSwitches -= previousSample->second->involuntaryContextSwitches;
+        }
+    }
+    std::vector<Usage> usages;
+    for (const auto& entry : usageByName) {
+        usages.push_back(entry.second);
+    }
+    std::stable_sort(usages.begin(), usages.end(), [](const Usage& lhs, const Usage& rhs) {
+        return lhs.cpuTime > rhs.cpuTime;
+    });
+    return usages;
+}
+
+bool ThreadCpuMonitor::parseStat(const std::string& stat, uint64_t* ticks) {
+    if (!ticks) {
+        ACSDK_ERROR(LX("parseStatFailed").d("reason", "nullTicks"));
+        return false;
+    }
+    // The name of the thread is in parentheses, and may itself contain spaces and parentheses.
+    auto endOfName = stat.rfind(')');
+    if (std::string::npos == endOfName) {
+        return false;
+    }
+    std::istringstream fields(stat.substr(endOfName + 1));
+    std::string field;
+    for (size_t i = 0; i < UTIME_FIELD_INDEX; ++i) {
+        if (!(fields >> field)) {
+            return false;
+        }
+    }
+    uint64_t userTicks = 0;
+    uint64_t systemTicks = 0;
+    if (!(fields >> userTicks >> systemTicks)) {
+        return false;
+    }
+    *ticks = userTicks + systemTicks;
+    return true;
+}
+
+bool ThreadCpuMonitor::parseStatus(const std::string& status, uint64_t* voluntary, uint64_t* involuntary) {
+    if (!voluntary || !involuntary) {
+        ACSDK_ERROR(LX("parseStatusFailed").d("reason", "nullCounters"));
+        return false;
+    }
+    bool hasVoluntary = false;
+    bool hasInvoluntary = false;
+    std::istringstream lines(status);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream fields(line);
+        std::string label;
+        fields >> label;
+        if (VOLUNTARY_CONTEXT_SWITCHES_LABEL == label) {
+            hasVoluntary = static_cast<bool>(fields >> *voluntary);
+        } else if (INVOLUNTARY_CONTEXT_SWITCHES_LABEL == label) {
+            hasInvoluntary = static_cast<bool>(fields >> *involuntary);
+        }
+    }
+    return hasVoluntary && hasInvoluntary;
+}
+
+void ThreadCpuMonitor::report() {
+    auto current = sampleThreads();
+    std::vector<Usage> usages;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        usages = getUsage(m_previous, current);
+        m_previous = std::move(current);
+        m_lastReport = usages;
+    }
+    for (const auto& usage : usages) {
+        ACSDK_INFO(LX("threadUsage")
+                       .d("role", usage.role)
+                       .d("name", usage.name)
+                       .d("threads", usage.numThreads)
+                       .d("cpuMs", usage.cpuTime.count())
+                       .d("voluntarySwitches", usage.voluntaryContextSwitches)
+                       .d("involuntarySwitches", usage.involuntaryContextSwitches));
+    }
+}
+
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
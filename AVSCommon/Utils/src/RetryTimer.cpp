@@ -15,6 +15,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <random>
 
@@ -24,6 +25,17 @@ namespace alexaClientSDK {
 namespace avsCommon {
 namespace utils {
 
+/**
+ * Get the random number generator of this thread.  Each is seeded separately, so that clients which start retrying at
+ * the same time do not compute the same delays.
+ *
+ * @return The random number generator of this thread.
+ */
+static std::mt19937& getGenerator() {
+    static thread_local std::mt19937 generator{std::random_device{}()};
+    return generator;
+}
+
 RetryTimer::RetryTimer(int* retryTable, int retrySize) :
         m_RetryTable{retryTable},
         m_RetrySize{retrySize},
@@ -52,14 +64,23 @@ std::chrono::milliseconds RetryTimer::calculateTimeToRetry(int retryCount) {
         retryCount = m_RetrySize - 1;
     }
 
-    std::mt19937 generator(static_cast<unsigned>(std::time(nullptr)));
     std::uniform_int_distribution<int> distribution(
         static_cast<int>(m_RetryTable[retryCount] * m_RetryDecreaseFactor),
         static_cast<int>(m_RetryTable[retryCount] * m_RetryIncreaseFactor));
-    auto delayMs = std::chrono::milliseconds(distribution(generator));
+    auto delayMs = std::chrono::milliseconds(distribution(getGenerator()));
     return delayMs;
 }
 
+std::chrono::milliseconds RetryTimer::calculateDecorrelatedTimeToRetry(std::chrono::milliseconds previousDelay) {
+    int minDelay = m_RetryTable[0];
+    int maxDelay = m_RetryTable[m_RetrySize - 1];
+    // The first retry is treated as following a delay of the first entry of the retry table.
+    auto previous = std::max(previousDelay.count(), static_cast<std::chrono::milliseconds::rep>(minDelay));
+    auto upperBound = std::min(static_cast<std::chrono::milliseconds::rep>(maxDelay), previous * 3);
+    std::uniform_int_distribution<int> distribution(minDelay, std::max(minDelay, static_cast<int>(upperBound)));
+    return std::chrono::milliseconds(distribution(getGenerator()));
+}
+
 }  // namespace utils
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
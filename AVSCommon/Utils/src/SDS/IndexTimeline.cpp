@@ -0,0 +1,133 @@
+/*
+ * IndexTimeline.cpp
+ *
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/SDS/IndexTimeline.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+IndexTimeline::IndexTimeline(size_t capacity) : m_entries(capacity > 0 ? capacity : 1), m_oldest{0}, m_size{0} {
+}
+
+void IndexTimeline::record(Index index, std::chrono::steady_clock::time_point time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_size > 0) {
+        auto& newest = entryLocked(m_size - 1);
+        if (index <= newest.index || time <= newest.time) {
+            return;
+        }
+    }
+    if (m_size < m_entries.size()) {
+        m_entries[(m_oldest + m_size) % m_entries.size()] = {index, time};
+        ++m_size;
+    } else {
+        m_entries[m_oldest] = {index, time};
+        m_oldest = (m_oldest + 1) % m_entries.size();
+    }
+}
+
+bool IndexTimeline::getTime(Index index, std::chrono::steady_clock::time_point* time) const {
+    if (!time) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Entry* first = nullptr;
+    const Entry* second = nullptr;
+    if (!findSegmentLocked([index](const Entry& entry) { return entry.index <= index; }, &first, &second)) {
+        return false;
+    }
+    if (first == second) {
+        if (index != first->index) {
+            return false;
+        }
+        *time = first->time;
+        return true;
+    }
+    double fraction = static_cast<double>(index - first->index) / (second->index - first->index);
+    *time = first->time +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>((second->time - first->time) * fraction);
+    return true;
+}
+
+bool IndexTimeline::getIndex(std::chrono::steady_clock::time_point time, Index* index) const {
+    if (!index) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Entry* first = nullptr;
+    const Entry* second = nullptr;
+    if (!findSegmentLocked([time](const Entry& entry) { return entry.time <= time; }, &first, &second)) {
+        return false;
+    }
+    if (first == second) {
+        if (time != first->time) {
+            return false;
+        }
+        *index = first->index;
+        return true;
+    }
+    double fraction = std::chrono::duration<double>(time - first->time) / (second->time - first->time);
+    *index = first->index + static_cast<Index>(fraction * (second->index - first->index));
+    return true;
+}
+
+void IndexTimeline::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_oldest = 0;
+    m_size = 0;
+}
+
+const IndexTimeline::Entry& IndexTimeline::entryLocked(size_t position) const {
+    return m_entries[(m_oldest + position) % m_entries.size()];
+}
+
+template <typename Predicate>
+bool IndexTimeline::findSegmentLocked(Predicate isAtOrBefore, const Entry** first, const Entry** second) const {
+    // Find the number of entries at or before the value.
+    size_t low = 0;
+    size_t high = m_size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (isAtOrBefore(entryLocked(middle))) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (0 == low) {
+        return false;
+    }
+    if (1 == m_size) {
+        *first = *second = &entryLocked(0);
+    } else if (low < m_size) {
+        *first = &entryLocked(low - 1);
+        *second = &entryLocked(low);
+    } else {
+        // Past the end of the timeline, so extrapolate from the last two entries.
+        *first = &entryLocked(m_size - 2);
+        *second = &entryLocked(m_size - 1);
+    }
+    return true;
+}
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,235 @@
+/*
+ * ProcessSharedSDS.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/SDS/ProcessSharedSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ProcessSharedSDS");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// Permissions for new shared memory objects; only the creating user may map them.
+static const mode_t SHARED_MEMORY_MODE = 0600;
+
+#ifdef __linux__
+/// The clock condition variables time out against; this matches @c std::chrono::steady_clock.
+static const clockid_t CONDITION_CLOCK = CLOCK_MONOTONIC;
+#else
+/// The clock condition variables time out against; this platform cannot select a monotonic clock.
+static const clockid_t CONDITION_CLOCK = CLOCK_REALTIME;
+#endif
+
+std::shared_ptr<ProcessSharedSDSTraits::Buffer> ProcessSharedSDSTraits::Buffer::create(
+    const std::string& name,
+    size_t size) {
+    if (0 == size) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroSize").d("name", name));
+        return nullptr;
+    }
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, SHARED_MEMORY_MODE);
+    if (-1 == fd && EEXIST == errno) {
+        ACSDK_WARN(LX("replacingStaleSharedMemory").d("name", name));
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, SHARED_MEMORY_MODE);
+    }
+    if (-1 == fd) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "shmOpenFailed").d("name", name).d("error", strerror(errno)));
+        return nullptr;
+    }
+    if (-1 == ftruncate(fd, size)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "ftruncateFailed").d("name", name).d("error", strerror(errno)));
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping keeps the shared memory object alive, so the descriptor is not needed after this point.
+    close(fd);
+    if (MAP_FAILED == data) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "mmapFailed").d("name", name).d("error", strerror(errno)));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+    return std::shared_ptr<Buffer>(new Buffer(name, static_cast<uint8_t*>(data), size, true));
+}
+
+std::shared_ptr<ProcessSharedSDSTraits::Buffer> ProcessSharedSDSTraits::Buffer::open(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (-1 == fd) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "shmOpenFailed").d("name", name).d("error", strerror(errno)));
+        return nullptr;
+    }
+    struct stat status;
+    if (-1 == fstat(fd, &status) || status.st_size <= 0) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "invalidSize").d("name", name));
+        close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(status.st_size);
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == data) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "mmapFailed").d("name", name).d("error", strerror(errno)));
+        return nullptr;
+    }
+    return std::shared_ptr<Buffer>(new Buffer(name, static_cast<uint8_t*>(data), size, false));
+}
+
+ProcessSharedSDSTraits::Buffer::Buffer(const std::string& name, uint8_t* data, size_t size, bool isOwner) :
+        m_name{name},
+        m_data{data},
+        m_size{size},
+        m_isOwner{isOwner} {
+}
+
+ProcessSharedSDSTraits::Buffer::~Buffer() {
+    munmap(m_data, m_size);
+    if (m_isOwner) {
+        shm_unlink(m_name.c_str());
+    }
+}
+
+size_t ProcessSharedSDSTraits::Buffer::size() const {
+    return m_size;
+}
+
+uint8_t* ProcessSharedSDSTraits::Buffer::data() {
+    return m_data;
+}
+
+ProcessSharedSDSTraits::Mutex::Mutex() {
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+#endif
+    int result = pthread_mutex_init(&m_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    if (result != 0) {
+        ACSDK_ERROR(LX("mutexInitFailed").d("error", strerror(result)));
+    }
+}
+
+ProcessSharedSDSTraits::Mutex::~Mutex() {
+    pthread_mutex_destroy(&m_mutex);
+}
+
+void ProcessSharedSDSTraits::Mutex::lock() {
+    handleLockResult(pthread_mutex_lock(&m_mutex), "lockFailed");
+}
+
+void ProcessSharedSDSTraits::Mutex::unlock() {
+    int result = pthread_mutex_unlock(&m_mutex);
+    if (result != 0) {
+        ACSDK_ERROR(LX("unlockFailed").d("error", strerror(result)));
+    }
+}
+
+void ProcessSharedSDSTraits::Mutex::handleLockResult(int result, const std::string& event) {
+#ifdef __linux__
+    if (EOWNERDEAD == result) {
+        // The previous owner died while holding the lock.  The SDS only holds its locks across short updates of the
+        // shared header, so take over the lock and carry on; a dead reader's slot can be freed with
+        // SharedDataStream::reset().
+        ACSDK_WARN(LX("recoveringLockFromDeadOwner"));
+        result = pthread_mutex_consistent(&m_mutex);
+    }
+#endif
+    if (result != 0) {
+        ACSDK_ERROR(LX(event).d("error", strerror(result)));
+    }
+}
+
+ProcessSharedSDSTraits::ConditionVariable::ConditionVariable() {
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+    pthread_condattr_setclock(&attributes, CONDITION_CLOCK);
+#endif
+    int result = pthread_cond_init(&m_cond, &attributes);
+    pthread_condattr_destroy(&attributes);
+    if (result != 0) {
+        ACSDK_ERROR(LX("conditionVariableInitFailed").d("error", strerror(result)));
+    }
+}
+
+ProcessSharedSDSTraits::ConditionVariable::~ConditionVariable() {
+    pthread_cond_destroy(&m_cond);
+}
+
+void ProcessSharedSDSTraits::ConditionVariable::notify_all() {
+    pthread_cond_broadcast(&m_cond);
+}
+
+void ProcessSharedSDSTraits::ConditionVariable::notify_one() {
+    pthread_cond_signal(&m_cond);
+}
+
+void ProcessSharedSDSTraits::ConditionVariable::wait(std::unique_lock<Mutex>& lock) {
+    auto mutex = lock.mutex();
+    mutex->handleLockResult(pthread_cond_wait(&m_cond, &mutex->m_mutex), "waitFailed");
+}
+
+bool ProcessSharedSDSTraits::ConditionVariable::waitUntil(
+    std::unique_lock<Mutex>& lock,
+    std::chrono::steady_clock::time_point deadline) {
+    // Convert the deadline to an absolute time on CONDITION_CLOCK.
+    auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+    if (remaining <= std::chrono::nanoseconds::zero()) {
+        return false;
+    }
+    struct timespec absTime;
+    clock_gettime(CONDITION_CLOCK, &absTime);
+    auto nanoseconds = static_cast<int64_t>(absTime.tv_nsec) + remaining.count();
+    absTime.tv_sec += static_cast<time_t>(nanoseconds / std::nano::den);
+    absTime.tv_nsec = static_cast<long>(nanoseconds % std::nano::den);
+
+    auto mutex = lock.mutex();
+    int result = pthread_cond_timedwait(&m_cond, &mutex->m_mutex, &absTime);
+    if (ETIMEDOUT == result) {
+        return false;
+    }
+    mutex->handleLockResult(result, "waitUntilFailed");
+    return true;
+}
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
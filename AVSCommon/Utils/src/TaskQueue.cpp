@@ -22,32 +22,83 @@ namespace avsCommon {
 namespace utils {
 namespace threading {
 
-TaskQueue::TaskQueue() : m_shutdown{false} {
+TaskQueue::QueuedTask* TaskQueue::reverseList(QueuedTask* list) {
+    QueuedTask* reversed = nullptr;
+    while (list) {
+        auto next = list->m_next;
+        list->m_next = reversed;
+        reversed = list;
+        list = next;
+    }
+    return reversed;
 }
 
-std::unique_ptr<std::function<void()>> TaskQueue::pop() {
-    std::unique_lock<std::mutex> queueLock{m_queueMutex};
+void TaskQueue::deleteList(QueuedTask* list) {
+    while (list) {
+        auto next = list->m_next;
+        delete list;
+        list = next;
+    }
+}
 
-    auto shouldNotWait = [this]() { return m_shutdown || !m_queue.empty(); };
+const size_t TaskQueue::NUM_PRIORITIES;
 
-    if (!shouldNotWait()) {
-        m_queueChanged.wait(queueLock, shouldNotWait);
+TaskQueue::TaskQueue() : m_frontStack{nullptr}, m_frontList{nullptr}, m_consumerWaiting{false}, m_shutdown{false} {
+    for (auto& stack : m_priorityStacks) {
+        stack = nullptr;
     }
+    m_priorityLists.fill(nullptr);
+}
 
-    if (!m_queue.empty()) {
-        auto task = std::move(m_queue.front());
+TaskQueue::~TaskQueue() {
+    std::lock_guard<std::mutex> consumerLock{m_consumerMutex};
+    clearLocked();
+}
 
-        m_queue.pop_front();
-        return task;
+std::unique_ptr<TaskQueue::QueuedTask> TaskQueue::pop() {
+    std::unique_lock<std::mutex> consumerLock{m_consumerMutex};
+
+    auto shouldNotWait = [this]() { return m_shutdown || hasPushedTasks(); };
+
+    while (!m_shutdown) {
+        auto task = takeNextLocked();
+        if (task) {
+            return task;
+        }
+        if (m_spinWait.spinUntil(shouldNotWait)) {
+            continue;
+        }
+        /*
+         * Producers check m_consumerWaiting after linking their task, so either this thread sees the new task in
+         * shouldNotWait(), or the producer sees m_consumerWaiting and notifies while holding the consumer mutex.
+         */
+        m_consumerWaiting = true;
+        m_queueChanged.wait(consumerLock, shouldNotWait);
+        m_consumerWaiting = false;
     }
 
+    // Drop anything pushed while shutdown() was in progress.
+    clearLocked();
     return nullptr;
 }
 
+std::unique_ptr<TaskQueue::QueuedTask> TaskQueue::tryPop() {
+    std::lock_guard<std::mutex> consumerLock{m_consumerMutex};
+    if (m_shutdown) {
+        clearLocked();
+        return nullptr;
+    }
+    return takeNextLocked();
+}
+
+void TaskQueue::setMaxSpin(std::chrono::microseconds maxSpin) {
+    m_spinWait.setMaxSpin(maxSpin);
+}
+
 void TaskQueue::shutdown() {
-    std::lock_guard<std::mutex> queueLock{m_queueMutex};
-    m_queue.clear();
     m_shutdown = true;
+    std::lock_guard<std::mutex> consumerLock{m_consumerMutex};
+    clearLocked();
     m_queueChanged.notify_all();
 }
 
@@ -55,6 +106,77 @@ bool TaskQueue::isShutdown() {
     return m_shutdown;
 }
 
+bool TaskQueue::pushQueuedTask(bool front, Priority priority, QueuedTask* task) {
+    if (m_shutdown) {
+        return false;
+    }
+
+    auto& stack = front ? m_frontStack : m_priorityStacks[static_cast<size_t>(priority)];
+    task->m_next = stack.load(std::memory_order_relaxed);
+    while (!stack.compare_exchange_weak(task->m_next, task)) {
+    }
+
+    if (m_consumerWaiting) {
+        // Taking the lock ensures the consumer is either blocked in wait() or has not yet evaluated its predicate.
+        std::lock_guard<std::mutex> consumerLock{m_consumerMutex};
+        m_queueChanged.notify_all();
+    }
+    return true;
+}
+
+std::unique_ptr<TaskQueue::QueuedTask> TaskQueue::takeNextLocked() {
+    if (m_frontStack.load(std::memory_order_relaxed)) {
+        // The newest task pushed to the front runs first, so the stack is already in run order.
+        auto pushedToFront = m_frontStack.exchange(nullptr);
+        auto last = pushedToFront;
+        while (last->m_next) {
+            last = last->m_next;
+        }
+        last->m_next = m_frontList;
+        m_frontList = pushedToFront;
+    }
+
+    QueuedTask** list = &m_frontList;
+    for (size_t priority = 0; !*list && priority < NUM_PRIORITIES; ++priority) {
+        // Tasks already taken are older than those still on the stack, so the stack is only taken once they ran.
+        list = &m_priorityLists[priority];
+        if (!*list && m_priorityStacks[priority].load(std::memory_order_relaxed)) {
+            *list = reverseList(m_priorityStacks[priority].exchange(nullptr));
+        }
+    }
+    if (!*list) {
+        return nullptr;
+    }
+
+    std::unique_ptr<QueuedTask> task(*list);
+    *list = task->m_next;
+    task->m_next = nullptr;
+    return task;
+}
+
+bool TaskQueue::hasPushedTasks() const {
+    if (m_frontStack.load()) {
+        return true;
+    }
+    for (const auto& stack : m_priorityStacks) {
+        if (stack.load()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskQueue::clearLocked() {
+    deleteList(m_frontList);
+    m_frontList = nullptr;
+    deleteList(m_frontStack.exchange(nullptr));
+    for (size_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        deleteList(m_priorityLists[priority]);
+        m_priorityLists[priority] = nullptr;
+        deleteList(m_priorityStacks[priority].exchange(nullptr));
+    }
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace avsCommon
@@ -16,6 +16,7 @@
  */
 
 #include "AVSCommon/Utils/Threading/TaskThread.h"
+#include "AVSCommon/Utils/Threading/ThreadFactory.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -34,7 +35,7 @@ TaskThread::~TaskThread() {
 }
 
 void TaskThread::start() {
-    m_thread = std::thread{std::bind(&TaskThread::processTasksLoop, this)};
+    m_thread = ThreadFactory::createThread(ThreadRole::BACKGROUND, "acsdk-task", [this]() { processTasksLoop(); });
 }
 
 bool TaskThread::isShutdown() {
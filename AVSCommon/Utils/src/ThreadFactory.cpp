@@ -0,0 +1,270 @@
+/*
+ * ThreadFactory.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+#include <sstream>
+
+#include "AVSCommon/Utils/Configuration/ConfigurationNode.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/ThreadFactory.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ThreadFactory");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The configuration node of the policies of the roles.
+static const std::string CONFIG_KEY_THREAD_POLICY = "threadPolicy";
+
+/// Configuration key for the list of CPUs of a role.
+static const std::string CONFIG_KEY_CPUS = "cpus";
+
+/// Configuration key for the @c SCHED_FIFO priority of a role.
+static const std::string CONFIG_KEY_SCHED_FIFO_PRIORITY = "schedFifoPriority";
+
+/// Configuration key for the nice value of a role.
+static const std::string CONFIG_KEY_NICE = "nice";
+
+/// The longest name of a thread, not counting the terminating null.
+static const size_t MAX_NAME_LENGTH = 15;
+
+/**
+ * Get the configuration key of the policy of a role.
+ *
+ * @param role The role.
+ * @return The configuration key of the policy of the role.
+ */
+static std::string getConfigKey(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::AUDIO_CAPTURE:
+            return "audioCapture";
+        case ThreadRole::KEYWORD_DETECTION:
+            return "keywordDetection";
+        case ThreadRole::NETWORK:
+            return "network";
+        case ThreadRole::DIALOG:
+            return "dialog";
+        case ThreadRole::MEDIA:
+            return "media";
+        case ThreadRole::BACKGROUND:
+            return "background";
+    }
+    return "unknown";
+}
+
+/// The threads created by @c ThreadFactory::createThread() which are running.
+struct RunningThreads {
+    /// Serializes access to @c threads.
+    std::mutex mutex;
+
+    /// The running threads, in the order in which they started.
+    std::vector<ThreadFactory::ThreadInfo> threads;
+};
+
+/**
+ * Get the threads created by @c ThreadFactory::createThread() which are running.  They are never destroyed, since
+ * threads may still exit during static destruction.
+ *
+ * @return The running threads.
+ */
+static RunningThreads& getRunningThreadsInstance() {
+    static auto instance = new RunningThreads;
+    return *instance;
+}
+
+/**
+ * Lists the calling thread among the running threads for as long as it exists.
+ */
+class ScopedRunningThread {
+public:
+    /**
+     * Constructor.
+     *
+     * @param role The role of the calling thread.
+     * @param name The name of the calling thread.
+     */
+    ScopedRunningThread(ThreadRole role, const std::string& name) : m_tid{0} {
+#ifdef __linux__
+        m_tid = static_cast<int>(syscall(SYS_gettid));
+        auto& running = getRunningThreadsInstance();
+        std::lock_guard<std::mutex> lock(running.mutex);
+        running.threads.push_back({m_tid, role, name});
+#endif
+    }
+
+    /**
+     * Destructor.
+     */
+    ~ScopedRunningThread() {
+        if (!m_tid) {
+            return;
+        }
+        auto& running = getRunningThreadsInstance();
+        std::lock_guard<std::mutex> lock(running.mutex);
+        running.threads.erase(
+            std::remove_if(
+                running.threads.begin(),
+                running.threads.end(),
+                [this](const ThreadFactory::ThreadInfo& info) { return info.tid == m_tid; }),
+            running.threads.end());
+    }
+
+private:
+    /// The id of the calling thread in the OS, or 0 if it is not listed.
+    int m_tid;
+};
+
+std::thread ThreadFactory::createThread(ThreadRole role, const std::string& name, std::function<void()> function) {
+    return std::thread([role, name, function]() {
+        ScopedRunningThread runningThread(role, name);
+        applyToCurrentThread(role, name);
+        function();
+    });
+}
+
+std::vector<ThreadFactory::ThreadInfo> ThreadFactory::getRunningThreads() {
+    auto& running = getRunningThreadsInstance();
+    std::lock_guard<std::mutex> lock(running.mutex);
+    return running.threads;
+}
+
+void ThreadFactory::applyToCurrentThread(ThreadRole role, const std::string& name) {
+#ifdef __linux__
+    pthread_setname_np(pthread_self(), name.substr(0, MAX_NAME_LENGTH).c_str());
+
+    auto policy = getPolicy(role);
+    if (!policy.cpus.empty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (auto cpu : policy.cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (error) {
+            ACSDK_WARN(LX("setAffinityFailed").d("role", role).d("name", name).d("error", error));
+        }
+    }
+    if (policy.schedFifoPriority > 0) {
+        sched_param parameters;
+        parameters.sched_priority = policy.schedFifoPriority;
+        int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+        if (error) {
+            ACSDK_WARN(LX("setSchedFifoFailed")
+                           .d("role", role)
+                           .d("name", name)
+                           .d("priority", policy.schedFifoPriority)
+                           .d("error", error));
+        }
+    } else if (policy.hasNice) {
+        // On Linux the nice value of a thread is set through its thread id.
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), policy.nice) != 0) {
+            ACSDK_WARN(LX("setNiceFailed").d("role", role).d("name", name).d("nice", policy.nice).d("errno", errno));
+        }
+    }
+#endif
+}
+
+ThreadFactory::Policy ThreadFactory::getPolicy(ThreadRole role) {
+    Policy policy{{}, 0, false, 0};
+    auto config = configuration::ConfigurationNode::getRoot()[CONFIG_KEY_THREAD_POLICY][getConfigKey(role)];
+    if (!config) {
+        return policy;
+    }
+    std::string cpuList;
+    if (config.getString(CONFIG_KEY_CPUS, &cpuList) && !parseCpuList(cpuList, &policy.cpus)) {
+        ACSDK_ERROR(LX("getPolicyFailed").d("reason", "invalidCpus").d("role", role).d("cpus", cpuList));
+        policy.cpus.clear();
+    }
+    config.getInt(CONFIG_KEY_SCHED_FIFO_PRIORITY, &policy.schedFifoPriority, 0);
+    policy.hasNice = config.getInt(CONFIG_KEY_NICE, &policy.nice, 0);
+    return policy;
+}
+
+bool ThreadFactory::parseCpuList(const std::string& cpuList, std::vector<int>* cpus) {
+    if (!cpus) {
+        ACSDK_ERROR(LX("parseCpuListFailed").d("reason", "nullCpus"));
+        return false;
+    }
+    cpus->clear();
+    std::istringstream ranges(cpuList);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        std::istringstream stream(range);
+        int first = -1;
+        int last = -1;
+        char separator = 0;
+        if (!(stream >> first) || first < 0) {
+            return false;
+        }
+        last = first;
+        if (stream >> separator && (separator != '-' || !(stream >> last) || last < first)) {
+            return false;
+        }
+        if (!(stream >> std::ws).eof()) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus->push_back(cpu);
+        }
+    }
+    return !cpus->empty();
+}
+
+std::ostream& operator<<(std::ostream& stream, ThreadRole role) {
+    switch (role) {
+        case ThreadRole::AUDIO_CAPTURE:
+            return stream << "AUDIO_CAPTURE";
+        case ThreadRole::KEYWORD_DETECTION:
+            return stream << "KEYWORD_DETECTION";
+        case ThreadRole::NETWORK:
+            return stream << "NETWORK";
+        case ThreadRole::DIALOG:
+            return stream << "DIALOG";
+        case ThreadRole::MEDIA:
+            return stream << "MEDIA";
+        case ThreadRole::BACKGROUND:
+            return stream << "BACKGROUND";
+    }
+    return stream << "UNKNOWN";
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,123 @@
+/*
+ * ThreadPool.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ThreadPool");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The minimum number of worker threads in the default @c ThreadPool.
+static const size_t MIN_DEFAULT_NUM_THREADS = 2;
+
+std::shared_ptr<ThreadPool> ThreadPool::getDefaultThreadPool() {
+    static std::shared_ptr<ThreadPool> instance = std::make_shared<ThreadPool>(
+        std::max(MIN_DEFAULT_NUM_THREADS, static_cast<size_t>(std::thread::hardware_concurrency())));
+    return instance;
+}
+
+ThreadPool::ThreadPool(size_t numThreads) : m_isShutdown{false} {
+    numThreads = std::max(numThreads, static_cast<size_t>(1));
+    m_workers.reserve(numThreads);
+    m_workerIds.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+        m_workerIds.push_back(m_workers.back().get_id());
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+bool ThreadPool::submit(std::function<void()> job) {
+    if (!job) {
+        ACSDK_ERROR(LX("submitFailed").d("reason", "nullJob"));
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isShutdown) {
+            ACSDK_ERROR(LX("submitFailed").d("reason", "isShutdown"));
+            return false;
+        }
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+    return true;
+}
+
+void ThreadPool::shutdown() {
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShutdown = true;
+        m_jobs.clear();
+        std::swap(workers, m_workers);
+    }
+    m_jobAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            worker.detach();
+        } else if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::getNumThreads() const {
+    return m_workerIds.size();
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return std::find(m_workerIds.begin(), m_workerIds.end(), std::this_thread::get_id()) != m_workerIds.end();
+}
+
+void ThreadPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_jobAvailable.wait(lock, [this] { return m_isShutdown || !m_jobs.empty(); });
+        if (m_isShutdown) {
+            return;
+        }
+        auto job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+        job();
+        job = nullptr;
+        lock.lock();
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -17,12 +17,10 @@
  */
 
 #include <ctime>
-#include <chrono>
-#include <random>
 
+#include "AVSCommon/Utils/Timing/Clock.h"
 #include "AVSCommon/Utils/Timing/TimeUtils.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
-#include "AVSCommon/Utils/String/StringUtils.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -30,7 +28,6 @@ namespace utils {
 namespace timing {
 
 using namespace avsCommon::utils::logger;
-using namespace avsCommon::utils::string;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("TimeUtils");
@@ -42,70 +39,97 @@ static const std::string TAG("TimeUtils");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/// The length of the year element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_YEAR_STRING_LENGTH = 4;
-/// The length of the month element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_MONTH_STRING_LENGTH = 2;
-/// The length of the day element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_DAY_STRING_LENGTH = 2;
-/// The length of the hour element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_HOUR_STRING_LENGTH = 2;
-/// The length of the minute element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_MINUTE_STRING_LENGTH = 2;
-/// The length of the second element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_SECOND_STRING_LENGTH = 2;
-/// The length of the post-fix element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_POSTFIX_STRING_LENGTH = 4;
-/// The dash separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_DASH_SEPARATOR_STRING = "-";
-/// The 'T' separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_T_SEPARATOR_STRING = "T";
-/// The colon separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_COLON_SEPARATOR_STRING = ":";
-/// The plus separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_PLUS_SEPARATOR_STRING = "+";
-
+/// The length of an ISO-8601 formatted string, such as "1986-08-08T21:30:00+0000".
+static const size_t ENCODED_TIME_STRING_EXPECTED_LENGTH = 24;
 /// The offset into an ISO-8601 formatted string where the year begins.
-static const unsigned long ENCODED_TIME_STRING_YEAR_OFFSET = 0;
+static const size_t ENCODED_TIME_STRING_YEAR_OFFSET = 0;
 /// The offset into an ISO-8601 formatted string where the month begins.
-static const unsigned long ENCODED_TIME_STRING_MONTH_OFFSET = ENCODED_TIME_STRING_YEAR_OFFSET +
-                                                              ENCODED_TIME_STRING_YEAR_STRING_LENGTH +
-                                                              ENCODED_TIME_STRING_DASH_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_MONTH_OFFSET = 5;
 /// The offset into an ISO-8601 formatted string where the day begins.
-static const unsigned long ENCODED_TIME_STRING_DAY_OFFSET = ENCODED_TIME_STRING_MONTH_OFFSET +
-                                                            ENCODED_TIME_STRING_MONTH_STRING_LENGTH +
-                                                            ENCODED_TIME_STRING_DASH_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_DAY_OFFSET = 8;
 /// The offset into an ISO-8601 formatted string where the hour begins.
-static const unsigned long ENCODED_TIME_STRING_HOUR_OFFSET = ENCODED_TIME_STRING_DAY_OFFSET +
-                                                             ENCODED_TIME_STRING_DAY_STRING_LENGTH +
-                                                             ENCODED_TIME_STRING_T_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_HOUR_OFFSET = 11;
 /// The offset into an ISO-8601 formatted string where the minute begins.
-static const unsigned long ENCODED_TIME_STRING_MINUTE_OFFSET = ENCODED_TIME_STRING_HOUR_OFFSET +
-                                                               ENCODED_TIME_STRING_HOUR_STRING_LENGTH +
-                                                               ENCODED_TIME_STRING_COLON_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_MINUTE_OFFSET = 14;
 /// The offset into an ISO-8601 formatted string where the second begins.
-static const unsigned long ENCODED_TIME_STRING_SECOND_OFFSET = ENCODED_TIME_STRING_MINUTE_OFFSET +
-                                                               ENCODED_TIME_STRING_MINUTE_STRING_LENGTH +
-                                                               ENCODED_TIME_STRING_COLON_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_SECOND_OFFSET = 17;
+/// The offset into an ISO-8601 formatted string where the sign of the UTC offset is.
+static const size_t ENCODED_TIME_STRING_UTC_OFFSET_SIGN_OFFSET = 19;
+/// The offset into an ISO-8601 formatted string where the hours of the UTC offset begin.
+static const size_t ENCODED_TIME_STRING_UTC_OFFSET_HOUR_OFFSET = 20;
+/// The offset into an ISO-8601 formatted string where the minutes of the UTC offset begin.
+static const size_t ENCODED_TIME_STRING_UTC_OFFSET_MINUTE_OFFSET = 22;
+
+/// The number of seconds in a minute.
+static const int64_t SECONDS_PER_MINUTE = 60;
+/// The number of seconds in an hour.
+static const int64_t SECONDS_PER_HOUR = 60 * SECONDS_PER_MINUTE;
+/// The number of seconds in a day.
+static const int64_t SECONDS_PER_DAY = 24 * SECONDS_PER_HOUR;
 
-/// The total expected length of an ISO-8601 formatted string.
-static const unsigned long ENCODED_TIME_STRING_EXPECTED_LENGTH =
-    ENCODED_TIME_STRING_SECOND_OFFSET + ENCODED_TIME_STRING_SECOND_STRING_LENGTH +
-    ENCODED_TIME_STRING_PLUS_SEPARATOR_STRING.length() + ENCODED_TIME_STRING_POSTFIX_STRING_LENGTH;
+/**
+ * Parse a fixed number of decimal digits.
+ *
+ * @param digits The first digit.
+ * @param count The number of digits.
+ * @param[out] value The value of the digits.
+ * @return Whether all the characters were digits.
+ */
+static bool parseDigits(const char* digits, int count, int* value) {
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            return false;
+        }
+        result = result * 10 + (digits[i] - '0');
+    }
+    *value = result;
+    return true;
+}
 
-bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTime) {
-    // TODO : ACSDK-387 to investigate a simpler and more portable implementation of this logic.
+/**
+ * Count the days from 1970-01-01 to a date in the proleptic Gregorian calendar, without going through the C library,
+ * which would apply the local timezone.  This is Howard Hinnant's days_from_civil() algorithm.
+ *
+ * @param year The year.
+ * @param month The month, from 1 to 12.
+ * @param day The day of the month, from 1.
+ * @return The number of days since 1970-01-01, which is negative for earlier dates.
+ */
+static int64_t daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
 
-    if (!unixTime) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("unixTime parameter was nullptr."));
-        return false;
-    }
+/**
+ * Whether a year is a leap year in the Gregorian calendar.
+ *
+ * @param year The year.
+ * @return Whether the year is a leap year.
+ */
+static bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
 
-    std::time_t rawtime = std::time(0);
-    auto timeInfo = std::localtime(&rawtime);
+/**
+ * Get the number of days in a month.
+ *
+ * @param year The year.
+ * @param month The month, from 1 to 12.
+ * @return The number of days in the month.
+ */
+static int daysInMonth(int year, int month) {
+    static const int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (2 == month && isLeapYear(year)) ? 29 : DAYS_IN_MONTH[month - 1];
+}
 
-    if (!timeInfo) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("localtime returned nullptr."));
+bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTime) {
+    if (!unixTime) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("unixTime parameter was nullptr."));
         return false;
     }
 
@@ -114,72 +138,59 @@ bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTim
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_YEAR_OFFSET, ENCODED_TIME_STRING_YEAR_STRING_LENGTH),
-            &(timeInfo->tm_year))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing year. Input:" + timeString));
+    const char* time = timeString.c_str();
+    if (time[ENCODED_TIME_STRING_MONTH_OFFSET - 1] != '-' || time[ENCODED_TIME_STRING_DAY_OFFSET - 1] != '-' ||
+        time[ENCODED_TIME_STRING_HOUR_OFFSET - 1] != 'T' || time[ENCODED_TIME_STRING_MINUTE_OFFSET - 1] != ':' ||
+        time[ENCODED_TIME_STRING_SECOND_OFFSET - 1] != ':' ||
+        (time[ENCODED_TIME_STRING_UTC_OFFSET_SIGN_OFFSET] != '+' &&
+         time[ENCODED_TIME_STRING_UTC_OFFSET_SIGN_OFFSET] != '-')) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing separators. Input:" + timeString));
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_MONTH_OFFSET, ENCODED_TIME_STRING_MONTH_STRING_LENGTH),
-            &(timeInfo->tm_mon))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing month. Input:" + timeString));
+    int year, month, day, hour, minute, second, offsetHours, offsetMinutes;
+    if (!parseDigits(time + ENCODED_TIME_STRING_YEAR_OFFSET, 4, &year) ||
+        !parseDigits(time + ENCODED_TIME_STRING_MONTH_OFFSET, 2, &month) ||
+        !parseDigits(time + ENCODED_TIME_STRING_DAY_OFFSET, 2, &day) ||
+        !parseDigits(time + ENCODED_TIME_STRING_HOUR_OFFSET, 2, &hour) ||
+        !parseDigits(time + ENCODED_TIME_STRING_MINUTE_OFFSET, 2, &minute) ||
+        !parseDigits(time + ENCODED_TIME_STRING_SECOND_OFFSET, 2, &second) ||
+        !parseDigits(time + ENCODED_TIME_STRING_UTC_OFFSET_HOUR_OFFSET, 2, &offsetHours) ||
+        !parseDigits(time + ENCODED_TIME_STRING_UTC_OFFSET_MINUTE_OFFSET, 2, &offsetMinutes)) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing digits. Input:" + timeString));
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_DAY_OFFSET, ENCODED_TIME_STRING_DAY_STRING_LENGTH),
-            &(timeInfo->tm_mday))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing day. Input:" + timeString));
+    // A second of 60 is allowed for leap seconds, which Unix time folds into the next second.
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hour > 23 || minute > 59 ||
+        second > 60 || offsetHours > 23 || offsetMinutes > 59) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("field out of range. Input:" + timeString));
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_HOUR_OFFSET, ENCODED_TIME_STRING_HOUR_STRING_LENGTH),
-            &(timeInfo->tm_hour))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing hour. Input:" + timeString));
-        return false;
+    int64_t utcOffset = offsetHours * SECONDS_PER_HOUR + offsetMinutes * SECONDS_PER_MINUTE;
+    if ('-' == time[ENCODED_TIME_STRING_UTC_OFFSET_SIGN_OFFSET]) {
+        utcOffset = -utcOffset;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_MINUTE_OFFSET, ENCODED_TIME_STRING_MINUTE_STRING_LENGTH),
-            &(timeInfo->tm_min))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing minute. Input:" + timeString));
-        return false;
-    }
-
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_SECOND_OFFSET, ENCODED_TIME_STRING_SECOND_STRING_LENGTH),
-            &(timeInfo->tm_sec))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing second. Input:" + timeString));
-        return false;
-    }
-
-    // adjust for unix epoch.
-    timeInfo->tm_year -= 1900;
-    timeInfo->tm_mon -= 1;
-
-    *unixTime = static_cast<int64_t>(std::mktime(timeInfo));
+    *unixTime = daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * SECONDS_PER_HOUR +
+                minute * SECONDS_PER_MINUTE + second - utcOffset;
 
     return true;
 }
 
 bool getCurrentUnixTime(int64_t* currentTime) {
-    // TODO : ACSDK-387 to investigate a simpler and more portable implementation of this logic.
-
     if (!currentTime) {
         ACSDK_ERROR(LX("getCurrentUnixTimeFailed").m("currentTime parameter was nullptr."));
         return false;
     }
 
-    std::time_t rawtime = std::time(0);
-    auto timeInfo = std::localtime(&rawtime);
-    if (!timeInfo) {
-        ACSDK_ERROR(LX("getCurrentUnixTimeFailed").m("localtime returned nullptr."));
+    int64_t now = Clock::getDefault()->getUnixTime();
+    if (-1 == now) {
+        ACSDK_ERROR(LX("getCurrentUnixTimeFailed").m("time returned -1."));
         return false;
     }
-    *currentTime = static_cast<int64_t>(std::mktime(timeInfo));
+    *currentTime = now;
 
     return true;
 }
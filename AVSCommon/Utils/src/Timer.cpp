@@ -24,7 +24,36 @@ namespace timing {
 
 const std::string Timer::TAG = "Timer";
 
-Timer::Timer() : m_running(false), m_stopping(false) {
+/**
+ * Get the storage of the @c TimerService set with @c Timer::setDefaultTimerService().  It is only accessed with
+ * @c std::atomic_load() and @c std::atomic_store().
+ *
+ * @return The storage of the default @c TimerService.
+ */
+static std::shared_ptr<TimerService>& defaultTimerService() {
+    static std::shared_ptr<TimerService> timerService;
+    return timerService;
+}
+
+void Timer::setDefaultTimerService(std::shared_ptr<TimerService> timerService) {
+    std::atomic_store(&defaultTimerService(), timerService);
+}
+
+Timer::Timer() : Timer(std::atomic_load(&defaultTimerService())) {
+}
+
+Timer::Timer(std::shared_ptr<TimerService> timerService) :
+        m_running(false),
+        m_stopping(false),
+        m_timerService{timerService},
+        m_clock{Clock::getDefault()},
+        m_generation{0},
+        m_scheduledId{TimerService::INVALID_ID},
+        m_isCallingTask{false},
+        m_periodType{PeriodType::ABSOLUTE},
+        m_maxCount{0},
+        m_count{0},
+        m_offSchedule{false} {
 }
 
 Timer::~Timer() {
@@ -32,6 +61,26 @@ Timer::~Timer() {
 }
 
 void Timer::stop() {
+    if (m_timerService) {
+        TimerService::Id scheduledId = TimerService::INVALID_ID;
+        bool isStoppingFromTask = false;
+        {
+            std::lock_guard<std::mutex> lock(m_waitMutex);
+            ++m_generation;
+            std::swap(scheduledId, m_scheduledId);
+            isStoppingFromTask = m_isCallingTask && m_timerService->isServiceThread();
+        }
+
+        // This blocks until any call which is in progress completes (unless called from the task itself).
+        m_timerService->cancel(scheduledId);
+
+        // If called from inside the task, onTimerServiceCall() deactivates the timer once the task returns.
+        if (!isStoppingFromTask) {
+            m_running = false;
+        }
+        return;
+    }
+
     {
         std::lock_guard<std::mutex> lock(m_waitMutex);
         if (m_running) {
@@ -53,6 +102,77 @@ bool Timer::activate() {
     return !m_running.exchange(true);
 }
 
+void Timer::startOnTimerService(
+    TimerService::Clock::duration delay,
+    TimerService::Clock::duration period,
+    PeriodType periodType,
+    size_t maxCount,
+    std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    m_task = task;
+    m_period = period;
+    m_periodType = periodType;
+    m_maxCount = maxCount;
+    m_count = 0;
+    m_offSchedule = false;
+    m_nextCallTime = m_timerService->now() + delay;
+    scheduleNextCallLocked();
+}
+
+void Timer::scheduleNextCallLocked() {
+    auto generation = m_generation;
+    m_scheduledId = m_timerService->schedule(m_nextCallTime, [this, generation] { onTimerServiceCall(generation); });
+    if (TimerService::INVALID_ID == m_scheduledId) {
+        logger::acsdkError(logger::LogEntry(TAG, "scheduleNextCallFailed").d("reason", "timerServiceScheduleFailed"));
+        m_task = nullptr;
+        m_running = false;
+    }
+}
+
+void Timer::onTimerServiceCall(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(m_waitMutex);
+    if (generation != m_generation) {
+        return;
+    }
+
+    // Skip the call if the task runtime put us off schedule.
+    bool shouldCallTask = PeriodType::RELATIVE == m_periodType || !m_offSchedule;
+    auto task = m_task;
+    m_isCallingTask = true;
+    lock.unlock();
+
+    if (shouldCallTask) {
+        task();
+    }
+
+    lock.lock();
+    m_isCallingTask = false;
+    if (generation != m_generation) {
+        // stop() was called while the task was executing.
+        m_task = nullptr;
+        m_running = false;
+        return;
+    }
+
+    if (m_maxCount != FOREVER && ++m_count >= m_maxCount) {
+        m_task = nullptr;
+        m_running = false;
+        return;
+    }
+
+    auto now = m_timerService->now();
+    switch (m_periodType) {
+        case PeriodType::ABSOLUTE:
+            m_offSchedule = m_nextCallTime + m_period < now;
+            m_nextCallTime += m_period;
+            break;
+        case PeriodType::RELATIVE:
+            m_nextCallTime = now + m_period;
+            break;
+    }
+    scheduleNextCallLocked();
+}
+
 }  // namespace timing
 }  // namespace utils
 }  // namespace avsCommon
@@ -0,0 +1,153 @@
+/*
+ * TimerService.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/ThreadFactory.h"
+#include "AVSCommon/Utils/Timing/TimerService.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("TimerService");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const TimerService::Id TimerService::INVALID_ID;
+
+std::shared_ptr<TimerService> TimerService::getInstance() {
+    static std::shared_ptr<TimerService> instance = std::make_shared<TimerService>();
+    return instance;
+}
+
+TimerService::TimerService(std::shared_ptr<timing::Clock> clock) :
+        m_clock{clock ? clock : timing::Clock::getDefault()},
+        m_nextId{INVALID_ID + 1},
+        m_runningId{INVALID_ID},
+        m_isShuttingDown{false} {
+}
+
+TimerService::~TimerService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+        m_tasks.clear();
+        m_dueTimes.clear();
+    }
+    m_wakeTrigger.notify_all();
+    if (m_thread.joinable()) {
+        if (isServiceThread()) {
+            // The last reference was released by a task running on the service thread.
+            m_thread.detach();
+        } else {
+            m_thread.join();
+        }
+    }
+}
+
+TimerService::Id TimerService::schedule(Clock::time_point when, std::function<void()> task) {
+    if (!task) {
+        ACSDK_ERROR(LX("scheduleFailed").d("reason", "nullTask"));
+        return INVALID_ID;
+    }
+    Id id = INVALID_ID;
+    bool isEarliest = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isShuttingDown) {
+            ACSDK_ERROR(LX("scheduleFailed").d("reason", "isShuttingDown"));
+            return INVALID_ID;
+        }
+        if (!m_thread.joinable()) {
+            m_thread = threading::ThreadFactory::createThread(
+                threading::ThreadRole::BACKGROUND, "timer-service", [this]() { serviceLoop(); });
+            m_threadId = m_thread.get_id();
+        }
+        id = m_nextId++;
+        auto it = m_tasks.emplace(Key(when, id), std::move(task)).first;
+        m_dueTimes[id] = when;
+        isEarliest = (it == m_tasks.begin());
+    }
+    if (isEarliest) {
+        m_wakeTrigger.notify_all();
+    }
+    return id;
+}
+
+bool TimerService::cancel(Id id) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_dueTimes.find(id);
+    if (it != m_dueTimes.end()) {
+        m_tasks.erase(Key(it->second, id));
+        m_dueTimes.erase(it);
+        return true;
+    }
+    if (id != INVALID_ID && m_runningId == id && !isServiceThread()) {
+        m_wakeTrigger.wait(lock, [this, id] { return m_runningId != id; });
+    }
+    return false;
+}
+
+TimerService::Clock::time_point TimerService::now() const {
+    return m_clock->now();
+}
+
+bool TimerService::isServiceThread() const {
+    return std::this_thread::get_id() == m_threadId.load();
+}
+
+void TimerService::serviceLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_isShuttingDown) {
+        if (m_tasks.empty()) {
+            m_wakeTrigger.wait(lock);
+            continue;
+        }
+        auto it = m_tasks.begin();
+        auto when = it->first.first;
+        if (m_clock->now() < when) {
+            m_clock->waitUntil(m_wakeTrigger, lock, when);
+            continue;
+        }
+        auto id = it->first.second;
+        auto task = std::move(it->second);
+        m_tasks.erase(it);
+        m_dueTimes.erase(id);
+        m_runningId = id;
+        lock.unlock();
+
+        task();
+        // Release anything captured by the task before reporting it complete.
+        task = nullptr;
+
+        lock.lock();
+        m_runningId = INVALID_ID;
+        m_wakeTrigger.notify_all();
+    }
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
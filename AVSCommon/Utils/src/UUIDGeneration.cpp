@@ -15,16 +15,12 @@
  * permissions and limitations under the License.
  */
 
-#include <random>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
-#include <mutex>
-#include <climits>
-#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <random>
+#include <thread>
 
-#include "AVSCommon/Utils/Logger/Logger.h"
 #include "AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h"
 
 namespace alexaClientSDK {
@@ -32,121 +28,91 @@ namespace avsCommon {
 namespace utils {
 namespace uuidGeneration {
 
-/// String to identify log entries originating from this file.
-static const std::string TAG("UUIDGeneration");
-
-/**
- * Create a LogEntry using this file's TAG and the specified event string.
- *
- * @param The event string for this @c LogEntry.
- */
-#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
-
-/// The UUID version (Version 4), shifted into the correct position in the byte.
-static const uint8_t UUID_VERSION_VALUE = 4 << 4;
+/// The UUID version (Version 4), in the bits of the version nibble.
+static const uint64_t UUID_VERSION_VALUE = 4;
 
-/// The UUID variant (Variant 1), shifted into the correct position in the byte.
-static const size_t UUID_VARIANT_VALUE = 2 << 6;
+/// The UUID variant (Variant 1), in the two most significant bits of the variant nibble.
+static const uint64_t UUID_VARIANT_VALUE = 2;
 
 /// Separator used between UUID fields.
-static const std::string SEPARATOR("-");
+static const char SEPARATOR = '-';
 
-/// Number of bits in the replacement value.
-static const size_t MAX_NUM_REPLACEMENT_BITS = CHAR_BIT;
+/// The hex digits, indexed by value.
+static const char HEX_DIGITS[] = "0123456789abcdef";
 
-/// Number of bits in a hex digit.
-static const size_t BITS_IN_HEX_DIGIT = 4;
+/// The positions of the separators in the text of a UUID.
+static const size_t SEPARATOR_POSITIONS[] = {8, 13, 18, 23};
 
 /**
- * Randomly generate a string of hex digits. Before the conversion of hex to string,
- * the function allows replacement of the bits of the first two generated hex digits.
- * Replacement happens starting at the most significant, to the least significant bit.
- *
- * @param ibe A random number generator.
- * @param numDigits The number of hex digits [0-9],[a-f] to generate.
- * @param replacementBits The replacement value for up to the first two digits generated.
- * @param numReplacementBits The number of bits of @c replacementBits to use.
+ * Get the random number generator of the calling thread, seeding it on first use.  Each thread has a generator of
+ * its own so that generating a UUID never waits for another thread.
  *
- * @return A hex string of length @c numDigits.
+ * @return The random number generator of the calling thread.
  */
-static const std::string generateHexWithReplacement(
-    std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t>& ibe,
-    unsigned int numDigits,
-    uint8_t replacementBits,
-    unsigned short numReplacementBits) {
-    if (numReplacementBits > MAX_NUM_REPLACEMENT_BITS) {
-        ACSDK_ERROR(LX("generateHexWithReplacementFailed")
-                        .d("reason", "replacingMoreBitsThanProvided")
-                        .d("numReplacementBitsLimit", MAX_NUM_REPLACEMENT_BITS)
-                        .d("numReplacementBits", numReplacementBits));
-        return "";
-    }
-
-    if (numReplacementBits > (numDigits * BITS_IN_HEX_DIGIT)) {
-        ACSDK_ERROR(LX("generateHexWithReplacementFailed")
-                        .d("reason", "replacingMoreBitsThanGenerated")
-                        .d("numDigitsInBits", numDigits * BITS_IN_HEX_DIGIT)
-                        .d("numReplacementBits", numReplacementBits));
-        return "";
-    }
-
-    // Makes assumption that 1 digit = 4 bits.
-    std::vector<uint8_t> bytes(ceil(numDigits / 2.0));
-    std::generate(bytes.begin(), bytes.end(), std::ref(ibe));
-
-    // Replace the specified number of bits from the first byte.
-    bytes.at(0) &= (0xff >> numReplacementBits);
-    replacementBits &= (0xff << (MAX_NUM_REPLACEMENT_BITS - numReplacementBits));
-    bytes.at(0) |= replacementBits;
-
-    std::ostringstream oss;
-    for (const auto& byte : bytes) {
-        oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(byte);
+static std::mt19937_64& getGenerator() {
+    static thread_local bool seeded = false;
+    static thread_local std::mt19937_64 generator;
+    if (!seeded) {
+        std::random_device rd;
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+        std::seed_seq seed{rd(),
+                           rd(),
+                           rd(),
+                           rd(),
+                           static_cast<unsigned int>(now),
+                           static_cast<unsigned int>(static_cast<uint64_t>(now) >> 32),
+                           static_cast<unsigned int>(threadId)};
+        generator.seed(seed);
+        seeded = true;
     }
-
-    std::string bytesText = oss.str();
-    // Remove the last digit for odd numDigits case.
-    bytesText.resize(numDigits);
-
-    return bytesText;
+    return generator;
 }
 
 /**
- * Randomly generate a string of hex digits.
+ * Write the hex digits of a 64-bit word, most significant first.
  *
- * @param ibe A random number generator.
- * @param numDigits The number of hex digits [0-9],[a-f] to generate.
- *
- * @return A hex string of length @c numDigits.
+ * @param word The word to write.
+ * @param[out] out The buffer to write the 16 digits to.
  */
-static const std::string generateHex(
-    std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t>& ibe,
-    unsigned int numDigits) {
-    return generateHexWithReplacement(ibe, numDigits, 0, 0);
+static void writeHex(uint64_t word, char* out) {
+    for (int i = 15; i >= 0; --i) {
+        out[i] = HEX_DIGITS[word & 0xf];
+        word >>= 4;
+    }
 }
 
-const std::string generateUUID() {
-    static bool seeded = false;
-    static std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t> ibe;
-    static std::mutex mutex;
-    std::unique_lock<std::mutex> lock(mutex);
-    if (!seeded) {
-        std::random_device rd;
-        ibe.seed(
-            rd() +
-            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
-                .count());
-        seeded = true;
+void generateUUID(char (&out)[UUID_BUFFER_SIZE]) {
+    auto& generator = getGenerator();
+    uint64_t high = generator();
+    uint64_t low = generator();
+
+    // The version is the 13th digit, and the variant the two most significant bits of the 17th digit.
+    high = (high & ~(uint64_t{0xf} << 12)) | (UUID_VERSION_VALUE << 12);
+    low = (low & ~(uint64_t{0x3} << 62)) | (UUID_VARIANT_VALUE << 62);
+
+    char digits[32];
+    writeHex(high, digits);
+    writeHex(low, digits + 16);
+
+    size_t digit = 0;
+    size_t separator = 0;
+    for (size_t i = 0; i < UUID_BUFFER_SIZE - 1; ++i) {
+        if (separator < sizeof(SEPARATOR_POSITIONS) / sizeof(SEPARATOR_POSITIONS[0]) &&
+            SEPARATOR_POSITIONS[separator] == i) {
+            out[i] = SEPARATOR;
+            ++separator;
+        } else {
+            out[i] = digits[digit++];
+        }
     }
+    out[UUID_BUFFER_SIZE - 1] = '\0';
+}
 
-    std::ostringstream uuidText;
-    uuidText << generateHex(ibe, 8) << SEPARATOR << generateHex(ibe, 4) << SEPARATOR
-             << generateHexWithReplacement(ibe, 4, UUID_VERSION_VALUE, 4) << SEPARATOR
-             << generateHexWithReplacement(ibe, 4, UUID_VARIANT_VALUE, 2) << SEPARATOR << generateHex(ibe, 12);
-
-    lock.unlock();
-
-    return uuidText.str();
+const std::string generateUUID() {
+    char uuid[UUID_BUFFER_SIZE];
+    generateUUID(uuid);
+    return std::string(uuid, UUID_BUFFER_SIZE - 1);
 }
 
 }  // namespace uuidGeneration
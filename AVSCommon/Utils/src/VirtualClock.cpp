@@ -0,0 +1,103 @@
+/*
+ * VirtualClock.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <ctime>
+#include <thread>
+#include <unordered_set>
+
+#include "AVSCommon/Utils/Timing/VirtualClock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+VirtualClock::VirtualClock() :
+        m_elapsed{0},
+        m_start{std::chrono::steady_clock::now()},
+        m_startUnixTime{static_cast<int64_t>(std::time(nullptr))} {
+}
+
+void VirtualClock::advance(duration delta) {
+    if (delta <= duration::zero()) {
+        return;
+    }
+    m_elapsed.fetch_add(delta.count());
+
+    /*
+     * A wait which read the time before it moved still holds its mutex until it blocks, so a wait is only woken once
+     * its mutex can be taken.  The mutex of a wait is only tried, never waited for, as waits lock it before
+     * m_waitersMutex.
+     */
+    std::unordered_set<Waiter*> woken;
+    std::unique_lock<std::mutex> lock(m_waitersMutex);
+    while (true) {
+        bool isPending = false;
+        for (auto waiter : m_waiters) {
+            if (woken.count(waiter)) {
+                continue;
+            }
+            if (!waiter->mutex->try_lock()) {
+                isPending = true;
+                continue;
+            }
+            waiter->condition->notify_all();
+            waiter->mutex->unlock();
+            woken.insert(waiter);
+        }
+        if (!isPending) {
+            return;
+        }
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+}
+
+Clock::time_point VirtualClock::now() const {
+    return m_start + duration(m_elapsed.load());
+}
+
+int64_t VirtualClock::getUnixTime() const {
+    return m_startUnixTime + std::chrono::duration_cast<std::chrono::seconds>(duration(m_elapsed.load())).count();
+}
+
+void VirtualClock::waitUntil(
+    std::condition_variable& condition,
+    std::unique_lock<std::mutex>& lock,
+    time_point deadline) {
+    if (now() >= deadline) {
+        return;
+    }
+    Waiter waiter{lock.mutex(), &condition};
+    std::list<Waiter*>::iterator it;
+    {
+        std::lock_guard<std::mutex> waitersLock(m_waitersMutex);
+        it = m_waiters.insert(m_waiters.end(), &waiter);
+    }
+    // Read the time again, now that advance() is sure to wake this wait.
+    if (now() < deadline) {
+        condition.wait(lock);
+    }
+    std::lock_guard<std::mutex> waitersLock(m_waitersMutex);
+    m_waiters.erase(it);
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,114 @@
+/*
+ * AdaptiveSpinWaitTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Threading/AdaptiveSpinWait.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+namespace test {
+
+/// The longest spin of the waits under test.
+static const std::chrono::microseconds MAX_SPIN(2000);
+
+/// Whether this device has more than one core, without which spinning is disabled.
+static const bool CAN_SPIN = std::thread::hardware_concurrency() > 1;
+
+/// Verify that spinning is off by default, and that a disabled wait checks its condition once.
+TEST(AdaptiveSpinWaitTest, disabledByDefault) {
+    AdaptiveSpinWait spinWait;
+    EXPECT_EQ(std::chrono::microseconds::zero(), spinWait.getMaxSpin());
+    int calls = 0;
+    EXPECT_FALSE(spinWait.spinUntil([&calls] { return ++calls > 1; }));
+    EXPECT_EQ(1, calls);
+    EXPECT_TRUE(spinWait.spinUntil([] { return true; }));
+}
+
+/// Verify that a spin ends as soon as its condition is met by another thread.
+TEST(AdaptiveSpinWaitTest, spinSeesHandoff) {
+    if (!CAN_SPIN) {
+        return;
+    }
+    AdaptiveSpinWait spinWait(std::chrono::seconds(10));
+    std::atomic<bool> ready(false);
+    std::thread producer([&ready] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ready = true;
+    });
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(spinWait.spinUntil([&ready] { return ready.load(); }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    producer.join();
+}
+
+/// Verify that a spin gives up once its budget is spent, and that the budget shrinks after it does.
+TEST(AdaptiveSpinWaitTest, spinGivesUpAndAdapts) {
+    if (!CAN_SPIN) {
+        return;
+    }
+    AdaptiveSpinWait spinWait(MAX_SPIN);
+    EXPECT_EQ(MAX_SPIN, spinWait.getMaxSpin());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(spinWait.spinUntil([] { return false; }));
+    auto firstSpin = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(firstSpin, MAX_SPIN);
+
+    for (int i = 0; i < 8; ++i) {
+        spinWait.spinUntil([] { return false; });
+    }
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(spinWait.spinUntil([] { return false; }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, firstSpin);
+}
+
+/// Verify that wait() returns with the lock held once notified, whether or not it spins.
+TEST(AdaptiveSpinWaitTest, waitOnConditionVariable) {
+    for (auto maxSpin : {std::chrono::microseconds::zero(), MAX_SPIN}) {
+        AdaptiveSpinWait spinWait(maxSpin);
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        bool ready = false;
+        std::thread producer([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            std::lock_guard<std::mutex> lock(mutex);
+            ready = true;
+            conditionVariable.notify_all();
+        });
+        std::unique_lock<std::mutex> lock(mutex);
+        spinWait.wait(lock, conditionVariable, [&ready] { return ready; });
+        EXPECT_TRUE(lock.owns_lock());
+        EXPECT_TRUE(ready);
+        lock.unlock();
+        producer.join();
+    }
+}
+
+}  // namespace test
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
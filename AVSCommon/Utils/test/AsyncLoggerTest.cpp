@@ -0,0 +1,151 @@
+/*
+ * AsyncLoggerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AsyncLoggerTest.cpp
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <future>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Logger/AsyncLogger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+namespace test {
+
+/// The ring capacity used by the tests.
+static const size_t CAPACITY = 8;
+
+/// Thread moniker passed to @c emit().
+static const char* MONIKER = "   1";
+
+/// Test harness for @c AsyncLogger class.  Log lines are written to a pipe, which the tests read back.
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+    /// Create the pipe.
+    void SetUp() override {
+        ASSERT_EQ(pipe(m_pipe), 0);
+    }
+
+    /// Close the pipe.
+    void TearDown() override {
+        close(m_pipe[0]);
+        close(m_pipe[1]);
+    }
+
+    /**
+     * Read everything currently in the pipe.
+     *
+     * @return The text read from the pipe.
+     */
+    std::string drainPipe() {
+        fcntl(m_pipe[0], F_SETFL, O_NONBLOCK);
+        std::string result;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = read(m_pipe[0], buffer, sizeof(buffer))) > 0) {
+            result.append(buffer, count);
+        }
+        return result;
+    }
+
+    /// The read and write ends of the pipe.
+    int m_pipe[2];
+};
+
+/// Verify that entries are written in order, and that @c flush() waits for them.
+TEST_F(AsyncLoggerTest, writesInOrder) {
+    AsyncLogger logger(Level::INFO, m_pipe[1], CAPACITY, AsyncLogger::OverflowPolicy::BLOCK);
+    auto reader = std::async(std::launch::async, [this] {
+        std::string result;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = read(m_pipe[0], buffer, sizeof(buffer))) > 0) {
+            result.append(buffer, count);
+            if (result.find("line99\n") != std::string::npos) {
+                break;
+            }
+        }
+        return result;
+    });
+    for (int i = 0; i < 100; ++i) {
+        logger.emit(Level::INFO, std::chrono::system_clock::now(), MONIKER, ("line" + std::to_string(i)).c_str());
+    }
+    logger.flush();
+    ASSERT_EQ(logger.getWrittenCount(), 100U);
+    ASSERT_EQ(logger.getDroppedCount(), 0U);
+
+    auto text = reader.get();
+    size_t position = 0;
+    for (int i = 0; i < 100; ++i) {
+        auto next = text.find(" I line" + std::to_string(i) + "\n", position);
+        ASSERT_NE(next, std::string::npos);
+        position = next;
+    }
+}
+
+/// Verify that entries below the log level are not written.
+TEST_F(AsyncLoggerTest, filtersByLevel) {
+    AsyncLogger logger(Level::WARN, m_pipe[1], CAPACITY, AsyncLogger::OverflowPolicy::DROP);
+    logger.log(Level::INFO, LogEntry("AsyncLoggerTest", "notWritten"));
+    logger.log(Level::ERROR, LogEntry("AsyncLoggerTest", "written"));
+    logger.flush();
+    auto text = drainPipe();
+    ASSERT_EQ(text.find("notWritten"), std::string::npos);
+    ASSERT_NE(text.find("AsyncLoggerTest:written"), std::string::npos);
+}
+
+/// Verify that entries are dropped and counted when the writer can't keep up, and that the drop is reported.
+TEST_F(AsyncLoggerTest, dropsWhenFull) {
+    AsyncLogger logger(Level::INFO, m_pipe[1], CAPACITY, AsyncLogger::OverflowPolicy::DROP);
+
+    // Nothing reads the pipe, so the background thread blocks once the pipe is full, then the ring fills.
+    std::string longText(1024, 'x');
+    for (int i = 0; i < 10000 && 0 == logger.getDroppedCount(); ++i) {
+        logger.emit(Level::INFO, std::chrono::system_clock::now(), MONIKER, longText.c_str());
+    }
+    ASSERT_GT(logger.getDroppedCount(), 0U);
+
+    auto reader = std::async(std::launch::async, [this] {
+        std::string result;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = read(m_pipe[0], buffer, sizeof(buffer))) > 0) {
+            result.append(buffer, count);
+            if (result.find("logEntriesDropped") != std::string::npos) {
+                break;
+            }
+        }
+        return result;
+    });
+    logger.flush();
+    logger.emit(Level::ERROR, std::chrono::system_clock::now(), MONIKER, "wakeUp");
+    ASSERT_EQ(reader.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_NE(reader.get().find("logEntriesDropped"), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,206 @@
+/*
+ * BinaryLoggerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file BinaryLoggerTest.cpp
+
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Logger/BinaryLogger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+namespace test {
+
+/// The ring size used by most tests.
+static const size_t RING_SIZE = 4096;
+
+/// The dictionary size used by most tests.
+static const size_t DICTIONARY_SIZE = 1024;
+
+/// Thread moniker passed to @c emit().
+static const char* MONIKER = "   1";
+
+/// A decoded record.
+struct DecodedRecord {
+    /// The level of the record.
+    Level level;
+
+    /// The thread moniker of the record.
+    std::string threadMoniker;
+
+    /// The text of the record, with the source and event names restored.
+    std::string text;
+};
+
+/// Test harness for @c BinaryLogger class.
+class BinaryLoggerTest : public ::testing::Test {
+protected:
+    /// Pick a file name which is unique to this process.
+    void SetUp() override {
+        m_path = "/tmp/BinaryLoggerTest." + std::to_string(getpid());
+    }
+
+    /// Remove the files written by the test.
+    void TearDown() override {
+        unlink(m_path.c_str());
+        unlink((m_path + ".1").c_str());
+    }
+
+    /**
+     * Read the file written by the test and decode its records, in the same way as BinaryLogDecoder.py.
+     *
+     * @param[out] header The header of the file.
+     * @return The records in the file, oldest first.
+     */
+    std::vector<DecodedRecord> decode(BinaryLogFileHeader* header) {
+        std::ifstream file(m_path, std::ios::binary);
+        std::vector<char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        std::vector<DecodedRecord> records;
+        if (data.size() < sizeof(*header)) {
+            ADD_FAILURE() << "file too short";
+            return records;
+        }
+        std::memcpy(header, data.data(), sizeof(*header));
+
+        std::vector<std::string> names{""};
+        const char* dictionary = data.data() + sizeof(*header);
+        for (size_t offset = 0; offset < header->dictionaryUsed;) {
+            uint16_t length;
+            std::memcpy(&length, dictionary + offset, sizeof(length));
+            names.emplace_back(dictionary + offset + sizeof(length), length);
+            offset += sizeof(length) + length;
+        }
+
+        const char* ring = dictionary + header->dictionarySize;
+        for (uint64_t position = header->begin; position < header->end;) {
+            size_t offset = position % header->ringSize;
+            size_t untilWrap = header->ringSize - offset;
+            if (untilWrap < sizeof(BinaryLogRecordHeader)) {
+                position += untilWrap;
+                continue;
+            }
+            BinaryLogRecordHeader record;
+            std::memcpy(&record, ring + offset, sizeof(record));
+            if (record.length < sizeof(record) || record.length > untilWrap) {
+                ADD_FAILURE() << "corrupt record at " << position;
+                return records;
+            }
+            position += record.length;
+            if (BinaryLogger::PADDING_LEVEL == record.level) {
+                continue;
+            }
+            const char* body = ring + offset + sizeof(record);
+            DecodedRecord decoded;
+            decoded.level = static_cast<Level>(record.level);
+            decoded.threadMoniker.assign(body, record.monikerLength);
+            if (record.sourceId) {
+                decoded.text = names[record.sourceId] + ":" + names[record.eventId];
+            }
+            decoded.text.append(body + record.monikerLength, record.length - sizeof(record) - record.monikerLength);
+            records.push_back(decoded);
+        }
+        return records;
+    }
+
+    /// The path of the file written by the test.
+    std::string m_path;
+};
+
+/// Verify that entries are written with their source and event names replaced by dictionary numbers.
+TEST_F(BinaryLoggerTest, writesRecords) {
+    auto logger = BinaryLogger::create(Level::INFO, m_path, RING_SIZE, DICTIONARY_SIZE);
+    ASSERT_NE(logger, nullptr);
+    logger->log(Level::INFO, LogEntry("BinaryLoggerTest", "event").d("key", "value"));
+    logger->log(Level::DEBUG0, LogEntry("BinaryLoggerTest", "notWritten"));
+    logger->log(Level::ERROR, LogEntry("BinaryLoggerTest", "event").m("message"));
+    logger->emit(Level::WARN, std::chrono::system_clock::now(), MONIKER, "noSeparators");
+
+    BinaryLogFileHeader header;
+    auto records = decode(&header);
+    ASSERT_EQ(std::memcmp(header.magic, BinaryLogger::MAGIC, sizeof(header.magic)), 0);
+    ASSERT_EQ(header.version, BinaryLogger::VERSION);
+    ASSERT_EQ(header.dictionaryCount, 2U);
+    ASSERT_EQ(records.size(), 3U);
+    ASSERT_EQ(records[0].level, Level::INFO);
+    ASSERT_EQ(records[0].text, "BinaryLoggerTest:event:key=value");
+    ASSERT_EQ(records[1].level, Level::ERROR);
+    ASSERT_EQ(records[1].text, "BinaryLoggerTest:event::message");
+    ASSERT_EQ(records[2].level, Level::WARN);
+    ASSERT_EQ(records[2].threadMoniker, MONIKER);
+    ASSERT_EQ(records[2].text, "noSeparators");
+}
+
+/// Verify that the oldest entries are evicted once the ring is full.
+TEST_F(BinaryLoggerTest, evictsOldestRecords) {
+    const size_t smallRingSize = 256;
+    auto logger = BinaryLogger::create(Level::INFO, m_path, smallRingSize, DICTIONARY_SIZE);
+    ASSERT_NE(logger, nullptr);
+    const int count = 100;
+    for (int i = 0; i < count; ++i) {
+        auto text = "Test:line:" + std::to_string(i);
+        logger->emit(Level::INFO, std::chrono::system_clock::now(), MONIKER, text.c_str());
+    }
+
+    BinaryLogFileHeader header;
+    auto records = decode(&header);
+    ASSERT_GT(header.end, smallRingSize);
+    ASSERT_LE(header.end - header.begin, smallRingSize);
+    ASSERT_GT(records.size(), 1U);
+    ASSERT_LT(records.size(), static_cast<size_t>(count));
+    int first = count - static_cast<int>(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(records[i].text, "Test:line:" + std::to_string(first + i));
+    }
+}
+
+/// Verify that entries are stored whole when the dictionary is full.
+TEST_F(BinaryLoggerTest, storesTextWhenDictionaryFull) {
+    auto logger = BinaryLogger::create(Level::INFO, m_path, RING_SIZE, 0);
+    ASSERT_NE(logger, nullptr);
+    logger->log(Level::INFO, LogEntry("BinaryLoggerTest", "event").d("key", "value"));
+
+    BinaryLogFileHeader header;
+    auto records = decode(&header);
+    ASSERT_EQ(header.dictionaryCount, 0U);
+    ASSERT_EQ(records.size(), 1U);
+    ASSERT_EQ(records[0].text, "BinaryLoggerTest:event:key=value");
+}
+
+/// Verify that the file of the previous run is kept.
+TEST_F(BinaryLoggerTest, keepsPreviousFile) {
+    auto logger = BinaryLogger::create(Level::INFO, m_path, RING_SIZE, DICTIONARY_SIZE);
+    ASSERT_NE(logger, nullptr);
+    logger.reset();
+    logger = BinaryLogger::create(Level::INFO, m_path, RING_SIZE, DICTIONARY_SIZE);
+    ASSERT_NE(logger, nullptr);
+    ASSERT_EQ(access((m_path + ".1").c_str(), F_OK), 0);
+}
+
+}  // namespace test
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
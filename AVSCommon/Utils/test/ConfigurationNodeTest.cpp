@@ -17,6 +17,7 @@
 // @file ConfigurationNodeTest.cpp
 
 #include <sstream>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -201,6 +202,75 @@ TEST_F(ConfigurationNodeTest, testInitializationAndAccess) {
     ASSERT_EQ(string211, NEW_STRING_VALUE2_1_1);
 }
 
+/**
+ * Verify that a @c ConfigurationNode keeps the configuration it was obtained from, across an @c uninitialize() and a
+ * new @c initialize().
+ */
+TEST_F(ConfigurationNodeTest, testNodeOutlivesReinitialization) {
+    ConfigurationNode::uninitialize();
+    std::stringstream firstStream;
+    firstStream << FIRST_JSON;
+    ASSERT_TRUE(ConfigurationNode::initialize({&firstStream}));
+    auto object2 = ConfigurationNode::getRoot()[OBJECT2];
+    ConfigurationNode::uninitialize();
+    ASSERT_FALSE(ConfigurationNode::getRoot());
+
+    std::stringstream thirdStream;
+    thirdStream << THIRD_JSON;
+    ASSERT_TRUE(ConfigurationNode::initialize({&thirdStream}));
+
+    std::string string21;
+    ASSERT_TRUE(object2.getString(STRING2_1, &string21));
+    ASSERT_EQ(string21, "stringValue2.1");
+    ASSERT_TRUE(ConfigurationNode::getRoot()[OBJECT2].getString(STRING2_1, &string21));
+    ASSERT_EQ(string21, NEW_STRING_VALUE2_1);
+    ConfigurationNode::uninitialize();
+}
+
+/**
+ * Verify that a configuration from @c createRoot() is only returned by @c getRoot() within a @c ScopedRoot, on the
+ * thread which constructed it.
+ */
+TEST_F(ConfigurationNodeTest, testScopedRoot) {
+    ConfigurationNode::uninitialize();
+    std::stringstream firstStream;
+    firstStream << FIRST_JSON;
+    ASSERT_TRUE(ConfigurationNode::initialize({&firstStream}));
+
+    std::stringstream badStream;
+    badStream << BAD_JSON;
+    ASSERT_FALSE(ConfigurationNode::createRoot({&badStream}));
+
+    std::stringstream secondStream;
+    secondStream << FIRST_JSON;
+    std::stringstream thirdStream;
+    thirdStream << THIRD_JSON;
+    auto clientRoot = ConfigurationNode::createRoot({&secondStream, &thirdStream});
+    ASSERT_TRUE(clientRoot);
+
+    std::string string21;
+    {
+        ConfigurationNode::ScopedRoot scopedRoot(clientRoot);
+        ASSERT_TRUE(ConfigurationNode::getRoot()[OBJECT2].getString(STRING2_1, &string21));
+        ASSERT_EQ(string21, NEW_STRING_VALUE2_1);
+        {
+            ConfigurationNode::ScopedRoot emptyRoot{ConfigurationNode()};
+            ASSERT_FALSE(ConfigurationNode::getRoot());
+        }
+        ASSERT_TRUE(ConfigurationNode::getRoot()[OBJECT2].getString(STRING2_1, &string21));
+        ASSERT_EQ(string21, NEW_STRING_VALUE2_1);
+
+        std::thread otherThread([&string21]() {
+            ConfigurationNode::getRoot()[OBJECT2].getString(STRING2_1, &string21);
+        });
+        otherThread.join();
+        ASSERT_EQ(string21, "stringValue2.1");
+    }
+    ASSERT_TRUE(ConfigurationNode::getRoot()[OBJECT2].getString(STRING2_1, &string21));
+    ASSERT_EQ(string21, "stringValue2.1");
+    ConfigurationNode::uninitialize();
+}
+
 }  // namespace test
 }  // namespace configuration
 }  // namespace utils
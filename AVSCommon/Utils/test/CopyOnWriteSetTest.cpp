@@ -0,0 +1,102 @@
+/*
+ * CopyOnWriteSetTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file CopyOnWriteSetTest.cpp
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Threading/CopyOnWriteSet.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+namespace test {
+
+/// Verify that values are kept once each, in the order they were added.
+TEST(CopyOnWriteSetTest, insertKeepsOrderAndRejectsDuplicates) {
+    CopyOnWriteSet<int> set;
+    ASSERT_TRUE(set.insert(2));
+    ASSERT_TRUE(set.insert(1));
+    ASSERT_FALSE(set.insert(2));
+    ASSERT_EQ(*set.snapshot(), std::vector<int>({2, 1}));
+}
+
+/// Verify that values can be removed, and that removing a value the set does not hold is reported.
+TEST(CopyOnWriteSetTest, eraseAndClear) {
+    CopyOnWriteSet<int> set;
+    set.insert(1);
+    set.insert(2);
+    set.insert(3);
+    ASSERT_TRUE(set.erase(2));
+    ASSERT_FALSE(set.erase(2));
+    ASSERT_EQ(*set.snapshot(), std::vector<int>({1, 3}));
+    set.clear();
+    ASSERT_TRUE(set.snapshot()->empty());
+}
+
+/// Verify that a snapshot is not changed by later changes to the set.
+TEST(CopyOnWriteSetTest, snapshotIsUnchangedByLaterWrites) {
+    CopyOnWriteSet<int> set;
+    set.insert(1);
+    auto snapshot = set.snapshot();
+    set.insert(2);
+    set.erase(1);
+    ASSERT_EQ(*snapshot, std::vector<int>({1}));
+    ASSERT_EQ(*set.snapshot(), std::vector<int>({2}));
+}
+
+/// Verify that snapshots can be taken while other threads change the set.
+TEST(CopyOnWriteSetTest, concurrentReadersAndWriters) {
+    const int numberOfWriters = 4;
+    const int valuesPerWriter = 200;
+    CopyOnWriteSet<int> set;
+    std::atomic<bool> done{false};
+    std::thread reader([&set, &done]() {
+        while (!done) {
+            auto snapshot = set.snapshot();
+            ASSERT_LE(snapshot->size(), static_cast<size_t>(numberOfWriters * valuesPerWriter));
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int w = 0; w < numberOfWriters; ++w) {
+        writers.emplace_back([&set, w]() {
+            for (int i = 0; i < valuesPerWriter; ++i) {
+                set.insert(w * valuesPerWriter + i);
+            }
+            for (int i = 0; i < valuesPerWriter; i += 2) {
+                set.erase(w * valuesPerWriter + i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+    ASSERT_EQ(set.snapshot()->size(), static_cast<size_t>(numberOfWriters * valuesPerWriter / 2));
+}
+
+}  // namespace test
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,121 @@
+/*
+ * DialogLatencyTracerTest.cpp
+ *
+ * Copyright 2016-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DialogLatencyTracerTest.cpp
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Metrics/DialogLatencyTracer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+namespace test {
+
+
+/// The dialogRequestId of the test trace.
+static const std::string DIALOG_REQUEST_ID_TEST("dialogRequestId-1");
+
+/**
+ * Our GTest class.
+ */
+class DialogLatencyTracerTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Find the summary of a mark.
+     *
+     * @param mark The mark.
+     * @param[out] summary The summary.
+     * @return Whether the summary was found.
+     */
+    bool findSummary(DialogLatencyTracer::Mark mark, DialogLatencyTracer::Summary* summary);
+};
+
+void DialogLatencyTracerTest::SetUp() {
+    DialogLatencyTracer::instance().reset();
+    DialogLatencyTracer::instance().setEnabled(true);
+}
+
+void DialogLatencyTracerTest::TearDown() {
+    DialogLatencyTracer::instance().setEnabled(false);
+    DialogLatencyTracer::instance().reset();
+}
+
+bool DialogLatencyTracerTest::findSummary(DialogLatencyTracer::Mark mark, DialogLatencyTracer::Summary* summary) {
+    for (const auto& item : DialogLatencyTracer::instance().getSummaries()) {
+        if (item.mark == mark) {
+            *summary = item;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Verify that marks are measured from the end of the wakeword, that only the first of each mark counts, and that
+ * the end of the speech ends the trace.
+ */
+TEST_F(DialogLatencyTracerTest, measuresMarksFromKeywordEnd) {
+    auto& tracer = DialogLatencyTracer::instance();
+    auto keywordEnd = std::chrono::steady_clock::now();
+    tracer.startTrace(DIALOG_REQUEST_ID_TEST, keywordEnd);
+    tracer.mark(DIALOG_REQUEST_ID_TEST, DialogLatencyTracer::Mark::SEND_START, keywordEnd + std::chrono::seconds(1));
+    tracer.mark(DIALOG_REQUEST_ID_TEST, DialogLatencyTracer::Mark::SEND_START, keywordEnd + std::chrono::seconds(3));
+    tracer.mark(
+        DIALOG_REQUEST_ID_TEST, DialogLatencyTracer::Mark::SPEECH_FINISHED, keywordEnd + std::chrono::seconds(2));
+    tracer.mark(DIALOG_REQUEST_ID_TEST, DialogLatencyTracer::Mark::SEND_END, keywordEnd + std::chrono::seconds(4));
+
+    DialogLatencyTracer::Summary summary;
+    ASSERT_TRUE(findSummary(DialogLatencyTracer::Mark::KEYWORD_END, &summary));
+    ASSERT_EQ(summary.count, 1u);
+    ASSERT_EQ(summary.max.count(), 0);
+
+    ASSERT_TRUE(findSummary(DialogLatencyTracer::Mark::SEND_START, &summary));
+    ASSERT_EQ(summary.count, 1u);
+    ASSERT_EQ(summary.max, std::chrono::seconds(1));
+
+    ASSERT_TRUE(findSummary(DialogLatencyTracer::Mark::SPEECH_FINISHED, &summary));
+    ASSERT_EQ(summary.max, std::chrono::seconds(2));
+
+    ASSERT_FALSE(findSummary(DialogLatencyTracer::Mark::SEND_END, &summary));
+}
+
+/**
+ * Verify that marks of dialogRequestIds without a trace, and marks placed while tracing is disabled, are ignored.
+ */
+TEST_F(DialogLatencyTracerTest, ignoresUntracedMarks) {
+    auto& tracer = DialogLatencyTracer::instance();
+    tracer.mark(DIALOG_REQUEST_ID_TEST, DialogLatencyTracer::Mark::SPEAK_RECEIVED);
+    tracer.setEnabled(false);
+    tracer.startTrace(DIALOG_REQUEST_ID_TEST, std::chrono::steady_clock::now());
+    tracer.mark(DIALOG_REQUEST_ID_TEST, DialogLatencyTracer::Mark::SPEAK_RECEIVED);
+    ASSERT_TRUE(tracer.getSummaries().empty());
+}
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
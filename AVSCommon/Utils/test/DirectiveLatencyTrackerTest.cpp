@@ -0,0 +1,142 @@
+/*
+ * DirectiveLatencyTrackerTest.cpp
+ *
+ * Copyright 2016-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DirectiveLatencyTrackerTest.cpp
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Metrics/DirectiveLatencyTracker.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+namespace test {
+
+/// The namespace of the test directives.
+static const std::string NAMESPACE_TEST("SpeechSynthesizer");
+
+/// The messageId of the test directive.
+static const std::string MESSAGE_ID_TEST("messageId-1");
+
+/// The text of the test directive, as received from AVS.
+// clang-format off
+static const std::string UNPARSED_DIRECTIVE_TEST =
+        "{"
+            "\"directive\":{"
+                "\"header\":{"
+                    "\"namespace\":\"SpeechSynthesizer\","
+                    "\"name\":\"Speak\","
+                    "\"messageId\" : \"messageId-1\""
+                "},"
+                "\"payload\":{}"
+            "}"
+        "}";
+// clang-format on
+
+/**
+ * Our GTest class.
+ */
+class DirectiveLatencyTrackerTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Find the summary of a stage.
+     *
+     * @param stage The stage.
+     * @param[out] summary The summary.
+     * @return Whether the summary was found.
+     */
+    bool findSummary(DirectiveLatencyTracker::Stage stage, DirectiveLatencyTracker::Summary* summary);
+};
+
+void DirectiveLatencyTrackerTest::SetUp() {
+    DirectiveLatencyTracker::instance().reset();
+    DirectiveLatencyTracker::instance().setEnabled(true);
+}
+
+void DirectiveLatencyTrackerTest::TearDown() {
+    DirectiveLatencyTracker::instance().setEnabled(false);
+    DirectiveLatencyTracker::instance().reset();
+}
+
+bool DirectiveLatencyTrackerTest::findSummary(
+    DirectiveLatencyTracker::Stage stage,
+    DirectiveLatencyTracker::Summary* summary) {
+    for (const auto& item : DirectiveLatencyTracker::instance().getSummaries()) {
+        if (item.nameSpace == NAMESPACE_TEST && item.stage == stage) {
+            *summary = item;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Verify that the latencies of the stages of a directive are measured from the time its MIME part started to arrive,
+ * including the stages recorded before its namespace was known.
+ */
+TEST_F(DirectiveLatencyTrackerTest, measuresStagesFromReceive) {
+    auto& tracker = DirectiveLatencyTracker::instance();
+    auto start = std::chrono::steady_clock::now() - std::chrono::milliseconds(10);
+    tracker.recordReceived(UNPARSED_DIRECTIVE_TEST, start);
+    tracker.record(
+        MESSAGE_ID_TEST, NAMESPACE_TEST, DirectiveLatencyTracker::Stage::ADSL_ENQUEUE, start + std::chrono::seconds(1));
+    tracker.record(
+        MESSAGE_ID_TEST, NAMESPACE_TEST, DirectiveLatencyTracker::Stage::COMPLETED, start + std::chrono::seconds(2));
+
+    DirectiveLatencyTracker::Summary summary;
+    ASSERT_TRUE(findSummary(DirectiveLatencyTracker::Stage::ACL_RECEIVE, &summary));
+    ASSERT_EQ(summary.count, 1u);
+    ASSERT_EQ(summary.max.count(), 0);
+
+    ASSERT_TRUE(findSummary(DirectiveLatencyTracker::Stage::MIME_PART_END, &summary));
+    ASSERT_EQ(summary.count, 1u);
+    ASSERT_GE(summary.max, std::chrono::milliseconds(10));
+
+    ASSERT_TRUE(findSummary(DirectiveLatencyTracker::Stage::ADSL_ENQUEUE, &summary));
+    ASSERT_EQ(summary.max, std::chrono::seconds(1));
+
+    ASSERT_TRUE(findSummary(DirectiveLatencyTracker::Stage::COMPLETED, &summary));
+    ASSERT_EQ(summary.max, std::chrono::seconds(2));
+    ASSERT_EQ(summary.p50, summary.max);
+
+    ASSERT_FALSE(findSummary(DirectiveLatencyTracker::Stage::PRE_HANDLE, &summary));
+}
+
+/**
+ * Verify that nothing is recorded while tracking is disabled.
+ */
+TEST_F(DirectiveLatencyTrackerTest, disabledRecordsNothing) {
+    auto& tracker = DirectiveLatencyTracker::instance();
+    tracker.setEnabled(false);
+    tracker.recordReceived(UNPARSED_DIRECTIVE_TEST, std::chrono::steady_clock::now());
+    tracker.record(MESSAGE_ID_TEST, NAMESPACE_TEST, DirectiveLatencyTracker::Stage::ADSL_ENQUEUE);
+    ASSERT_TRUE(tracker.getSummaries().empty());
+}
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -15,7 +15,11 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
+#include <future>
 #include <list>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "ExecutorTestUtils.h"
@@ -249,6 +253,213 @@ TEST_F(ExecutorTest, shutdown) {
     ASSERT_FALSE(rejected.valid());
 }
 
+/// This test verifies that tasks submitted with a priority run before the queued tasks of lower priorities.
+TEST_F(ExecutorTest, submitWithPriority) {
+    std::atomic<bool> ready(false);
+    std::atomic<bool> blocked(false);
+    std::vector<int> order;
+
+    executor.submit([&] {
+        blocked = true;
+        while (!ready) {
+            std::this_thread::yield();
+        }
+    });
+    while (!blocked) {
+        std::this_thread::yield();
+    }
+
+    executor.submitWithPriority(Executor::Priority::LOW, [&] { order.push_back(1); });
+    executor.submit([&] { order.push_back(2); });
+    executor.submitWithPriority(Executor::Priority::HIGH, [&] { order.push_back(3); });
+    executor.submitToFront([&] { order.push_back(4); });
+    ready = true;
+    executor.waitForSubmittedTasks();
+
+    ASSERT_EQ(order, std::vector<int>({4, 3, 2, 1}));
+}
+
+/// This test verifies that a delayed task runs on the executor once its delay has passed.
+TEST_F(ExecutorTest, submitAfterRunsAfterDelay) {
+    std::promise<std::thread::id> ranOn;
+    auto start = std::chrono::steady_clock::now();
+    auto handle = executor.submitAfter(SHORT_TIMEOUT_MS, [&ranOn] { ranOn.set_value(std::this_thread::get_id()); });
+    ASSERT_TRUE(handle.isValid());
+
+    auto future = ranOn.get_future();
+    ASSERT_EQ(future.wait_for(SHORT_TIMEOUT_MS * 10), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, SHORT_TIMEOUT_MS);
+    EXPECT_EQ(future.get(), executor.submit([] { return std::this_thread::get_id(); }).get());
+    EXPECT_FALSE(handle.cancel());
+}
+
+/// This test verifies that a cancelled delayed task does not run, and can not be cancelled twice.
+TEST_F(ExecutorTest, cancelDelayedTask) {
+    std::atomic<bool> ran(false);
+    auto handle = executor.submitAfter(SHORT_TIMEOUT_MS, [&ran] { ran = true; });
+    auto later = executor.submitAfter(SHORT_TIMEOUT_MS * 2, [] {});
+    EXPECT_TRUE(handle.cancel());
+    EXPECT_FALSE(handle.cancel());
+
+    std::this_thread::sleep_for(SHORT_TIMEOUT_MS * 3);
+    executor.waitForSubmittedTasks();
+    EXPECT_FALSE(ran);
+    EXPECT_FALSE(later.cancel());
+    EXPECT_FALSE(DelayedTaskHandle().cancel());
+}
+
+/// This test verifies that shutdown drops the delayed tasks which have not run, and rejects new ones.
+TEST_F(ExecutorTest, shutdownDropsDelayedTasks) {
+    std::atomic<bool> ran(false);
+    auto handle = executor.submitAfter(SHORT_TIMEOUT_MS, [&ran] { ran = true; });
+    executor.shutdown();
+    EXPECT_FALSE(handle.cancel());
+    EXPECT_FALSE(executor.submitAfter(SHORT_TIMEOUT_MS, [] {}).isValid());
+
+    std::this_thread::sleep_for(SHORT_TIMEOUT_MS * 2);
+    EXPECT_FALSE(ran);
+}
+
+/// Test harness for an @c Executor which runs its tasks on a @c ThreadPool.
+class PooledExecutorTest : public ::testing::Test {
+public:
+    /// Constructor.
+    PooledExecutorTest() : threadPool{std::make_shared<ThreadPool>(POOL_SIZE)}, executor{threadPool} {
+    }
+
+    /// The number of workers in @c threadPool.
+    static const size_t POOL_SIZE = 4;
+
+    /// The pool shared by the executors under test.
+    std::shared_ptr<ThreadPool> threadPool;
+
+    /// The executor under test.
+    Executor executor;
+};
+
+const size_t PooledExecutorTest::POOL_SIZE;
+
+/// This test verifies that tasks run on a pool complete one at a time, in the order they were submitted.
+TEST_F(PooledExecutorTest, runsTasksSeriallyInOrder) {
+    const int numTasks = 100;
+    std::atomic<int> running(0);
+    std::atomic<bool> overlapped(false);
+    std::vector<int> order;
+    for (int i = 0; i < numTasks; ++i) {
+        executor.submit([&, i] {
+            if (++running > 1) {
+                overlapped = true;
+            }
+            order.push_back(i);
+            --running;
+        });
+    }
+    executor.waitForSubmittedTasks();
+    ASSERT_FALSE(overlapped);
+    ASSERT_EQ(order.size(), static_cast<size_t>(numTasks));
+    for (int i = 0; i < numTasks; ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+/// This test verifies that @c submitToFront() behaves the same on a pool as it does on a dedicated thread.
+TEST_F(PooledExecutorTest, submitToFront) {
+    std::atomic<bool> ready(false);
+    std::atomic<bool> blocked(false);
+    std::list<int> order;
+
+    executor.submit([&] {
+        blocked = true;
+        while (!ready) {
+            std::this_thread::yield();
+        }
+    });
+    while (!blocked) {
+        std::this_thread::yield();
+    }
+    executor.submit([&] { order.push_back(1); });
+    executor.submit([&] { order.push_back(2); });
+    executor.submitToFront([&] { order.push_back(3); });
+    ready = true;
+    executor.waitForSubmittedTasks();
+
+    ASSERT_EQ(order.size(), 3U);
+    ASSERT_EQ(order.front(), 3);
+    ASSERT_EQ(order.back(), 2);
+}
+
+/// This test verifies that a blocked executor does not prevent another executor on the same pool from running.
+TEST_F(PooledExecutorTest, executorsShareThePool) {
+    std::atomic<bool> ready(false);
+    std::atomic<bool> blocked(false);
+    Executor other(threadPool);
+
+    executor.submit([&] {
+        blocked = true;
+        while (!ready) {
+            std::this_thread::yield();
+        }
+    });
+    while (!blocked) {
+        std::this_thread::yield();
+    }
+    auto future = other.submit([] {});
+    EXPECT_EQ(future.wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    ready = true;
+    executor.waitForSubmittedTasks();
+}
+
+/// This test verifies that a delayed task of a pooled executor runs on the pool.
+TEST_F(PooledExecutorTest, submitAfterRunsOnThePool) {
+    std::promise<void> ran;
+    executor.submitAfter(SHORT_TIMEOUT_MS, [&ran] { ran.set_value(); });
+    ASSERT_EQ(ran.get_future().wait_for(SHORT_TIMEOUT_MS * 10), std::future_status::ready);
+}
+
+/// This test verifies that shutdown completes the current task and does not accept new tasks.
+TEST_F(PooledExecutorTest, shutdown) {
+    std::atomic<bool> ready(false);
+    std::atomic<bool> blocked(false);
+    std::atomic<bool> finished(false);
+
+    executor.submit([&] {
+        blocked = true;
+        while (!ready) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(SHORT_TIMEOUT_MS);
+        finished = true;
+    });
+    while (!blocked) {
+        std::this_thread::yield();
+    }
+    ready = true;
+
+    executor.shutdown();
+    EXPECT_TRUE(executor.isShutdown());
+    EXPECT_TRUE(finished);
+
+    auto rejected = executor.submit([] {});
+    ASSERT_FALSE(rejected.valid());
+}
+
+/// This test verifies that executors constructed by default run on the default pool, when one is set.
+TEST(DefaultThreadPoolExecutorTest, defaultThreadPool) {
+    auto threadPool = std::make_shared<ThreadPool>(1);
+    std::promise<std::thread::id> workerId;
+    threadPool->submit([&workerId] { workerId.set_value(std::this_thread::get_id()); });
+    auto poolThreadId = workerId.get_future().get();
+
+    Executor::setDefaultThreadPool(threadPool);
+    Executor pooledExecutor;
+    Executor::setDefaultThreadPool(nullptr);
+    Executor ownThreadExecutor;
+
+    auto getThreadId = [] { return std::this_thread::get_id(); };
+    EXPECT_EQ(pooledExecutor.submit(getThreadId).get(), poolThreadId);
+    EXPECT_NE(ownThreadExecutor.submit(getThreadId).get(), poolThreadId);
+}
+
 }  // namespace test
 }  // namespace threading
 }  // namespace utils
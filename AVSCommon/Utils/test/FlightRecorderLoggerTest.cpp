@@ -0,0 +1,188 @@
+/*
+ * FlightRecorderLoggerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file FlightRecorderLoggerTest.cpp
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Logger/FlightRecorderLogger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+namespace test {
+
+/// Thread moniker passed to @c emit().
+static const char* MONIKER = "   1";
+
+/// A @c Logger which keeps the text of the entries it is given.
+class CollectingLogger : public Logger {
+public:
+    /// Constructor.
+    CollectingLogger() : Logger(Level::DEBUG9) {
+    }
+
+    void emit(Level level, std::chrono::system_clock::time_point time, const char* threadMoniker, const char* text)
+        override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_texts.push_back(text);
+    }
+
+    /// Serializes access to @c m_texts.
+    std::mutex m_mutex;
+
+    /// The text of the entries, oldest first.
+    std::vector<std::string> m_texts;
+};
+
+/// Test harness for @c FlightRecorderLogger class.
+class FlightRecorderLoggerTest : public ::testing::Test {
+protected:
+    /// Open the pipe the recorder dumps to.
+    void SetUp() override {
+        ASSERT_EQ(0, pipe(m_pipe));
+        fcntl(m_pipe[0], F_SETFL, O_NONBLOCK);
+    }
+
+    /// Close the pipe.
+    void TearDown() override {
+        close(m_pipe[0]);
+        close(m_pipe[1]);
+    }
+
+    /**
+     * Read the lines dumped so far.
+     *
+     * @return The lines, without their newlines.
+     */
+    std::vector<std::string> readLines() {
+        std::string data;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = read(m_pipe[0], buffer, sizeof(buffer))) > 0) {
+            data.append(buffer, count);
+        }
+        std::vector<std::string> lines;
+        std::istringstream stream(data);
+        std::string line;
+        while (std::getline(stream, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    /**
+     * Log an entry with the current time.
+     *
+     * @param logger The logger.
+     * @param level The level of the entry.
+     * @param text The text of the entry.
+     */
+    void emit(Logger& logger, Level level, const std::string& text) {
+        logger.emit(level, std::chrono::system_clock::now(), MONIKER, text.c_str());
+    }
+
+    /// The read and write ends of the pipe the recorder dumps to.
+    int m_pipe[2];
+};
+
+/// Verify that a recorder can not be created without room for entries.
+TEST_F(FlightRecorderLoggerTest, createWithZeroCapacity) {
+    EXPECT_FALSE(FlightRecorderLogger::create(Level::DEBUG9, 0, nullptr, Level::WARN, m_pipe[1]));
+}
+
+/// Verify that entries of every level are recorded, while only those of the output level are passed on.
+TEST_F(FlightRecorderLoggerTest, recordAllAndPassOnOutputLevel) {
+    CollectingLogger output;
+    auto recorder = FlightRecorderLogger::create(Level::DEBUG9, 16, &output, Level::WARN, m_pipe[1]);
+    ASSERT_TRUE(recorder);
+    emit(*recorder, Level::DEBUG9, "source:debugEvent");
+    emit(*recorder, Level::WARN, "source:warnEvent");
+    emit(*recorder, Level::INFO, "source:infoEvent");
+
+    ASSERT_EQ(1u, output.m_texts.size());
+    EXPECT_EQ("source:warnEvent", output.m_texts[0]);
+
+    EXPECT_EQ(3u, recorder->dump(m_pipe[1]));
+    auto lines = readLines();
+    ASSERT_EQ(3u, lines.size());
+    EXPECT_NE(std::string::npos, lines[0].find("[   1] 9 source:debugEvent"));
+    EXPECT_NE(std::string::npos, lines[1].find("[   1] W source:warnEvent"));
+    EXPECT_NE(std::string::npos, lines[2].find("[   1] I source:infoEvent"));
+}
+
+/// Verify that the newest entries are kept when the ring wraps, and that long entries are truncated.
+TEST_F(FlightRecorderLoggerTest, keepNewestEntries) {
+    auto recorder = FlightRecorderLogger::create(Level::DEBUG9, 4, nullptr, Level::WARN, m_pipe[1]);
+    ASSERT_TRUE(recorder);
+    for (int i = 0; i < 6; ++i) {
+        emit(*recorder, Level::INFO, "source:event" + std::to_string(i));
+    }
+    emit(*recorder, Level::INFO, std::string(FlightRecorderLogger::TEXT_SIZE * 2, 'x'));
+
+    EXPECT_EQ(4u, recorder->dump(m_pipe[1]));
+    auto lines = readLines();
+    ASSERT_EQ(4u, lines.size());
+    EXPECT_NE(std::string::npos, lines[0].find("source:event3"));
+    EXPECT_NE(std::string::npos, lines[2].find("source:event5"));
+    EXPECT_NE(std::string::npos, lines[3].find(std::string(FlightRecorderLogger::TEXT_SIZE, 'x')));
+    EXPECT_EQ(std::string::npos, lines[3].find(std::string(FlightRecorderLogger::TEXT_SIZE + 1, 'x')));
+}
+
+/// Verify that a trigger dumps the entries of the active recorder added since the previous trigger.
+TEST_F(FlightRecorderLoggerTest, triggerDumpsNewEntries) {
+    auto recorder = FlightRecorderLogger::create(Level::DEBUG9, 16, nullptr, Level::WARN, m_pipe[1]);
+    ASSERT_TRUE(recorder);
+    FlightRecorderLogger::trigger("noActiveRecorder");
+    EXPECT_TRUE(readLines().empty());
+
+    recorder->activate();
+    emit(*recorder, Level::DEBUG0, "source:first");
+    FlightRecorderLogger::trigger("testReason");
+    auto lines = readLines();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_NE(std::string::npos, lines[0].find("testReason"));
+    EXPECT_NE(std::string::npos, lines[1].find("source:first"));
+
+    FlightRecorderLogger::trigger("testReason");
+    EXPECT_TRUE(readLines().empty());
+
+    emit(*recorder, Level::DEBUG0, "source:second");
+    FlightRecorderLogger::trigger("testReason");
+    lines = readLines();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_NE(std::string::npos, lines[1].find("source:second"));
+
+    recorder.reset();
+    FlightRecorderLogger::trigger("recorderDestroyed");
+    EXPECT_TRUE(readLines().empty());
+}
+
+}  // namespace test
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,139 @@
+/*
+ * IndexTimelineTest.cpp
+ *
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/SDS/IndexTimeline.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+namespace test {
+
+using Time = std::chrono::steady_clock::time_point;
+
+/// The time of the first entry in the tests.
+static const Time START = Time() + std::chrono::hours(1);
+
+/// One write of 10ms of 16kHz audio.
+static const IndexTimeline::Index WORDS_PER_WRITE = 160;
+
+/// The period of the writes.
+static const std::chrono::milliseconds WRITE_PERIOD{10};
+
+/**
+ * Record a write every @c WRITE_PERIOD of @c WORDS_PER_WRITE words, starting from @c START.
+ *
+ * @param timeline The timeline to record in.
+ * @param numWrites The number of writes to record.
+ */
+static void recordWrites(IndexTimeline* timeline, size_t numWrites) {
+    for (size_t i = 0; i < numWrites; ++i) {
+        timeline->record(i * WORDS_PER_WRITE, START + i * WRITE_PERIOD);
+    }
+}
+
+/**
+ * Verify that indexes map to times, interpolated between writes and extrapolated past the last one.
+ */
+TEST(IndexTimelineTest, getTime) {
+    IndexTimeline timeline;
+    recordWrites(&timeline, 10);
+    Time time;
+    ASSERT_TRUE(timeline.getTime(0, &time));
+    EXPECT_EQ(time, START);
+    ASSERT_TRUE(timeline.getTime(3 * WORDS_PER_WRITE + WORDS_PER_WRITE / 2, &time));
+    EXPECT_EQ(time, START + 3 * WRITE_PERIOD + WRITE_PERIOD / 2);
+    ASSERT_TRUE(timeline.getTime(12 * WORDS_PER_WRITE, &time));
+    EXPECT_EQ(time, START + 12 * WRITE_PERIOD);
+}
+
+/**
+ * Verify that times map to indexes, interpolated between writes and extrapolated past the last one.
+ */
+TEST(IndexTimelineTest, getIndex) {
+    IndexTimeline timeline;
+    recordWrites(&timeline, 10);
+    IndexTimeline::Index index;
+    ASSERT_TRUE(timeline.getIndex(START, &index));
+    EXPECT_EQ(index, 0u);
+    ASSERT_TRUE(timeline.getIndex(START + 5 * WRITE_PERIOD + WRITE_PERIOD / 2, &index));
+    EXPECT_EQ(index, 5 * WORDS_PER_WRITE + WORDS_PER_WRITE / 2);
+    ASSERT_TRUE(timeline.getIndex(START + 20 * WRITE_PERIOD, &index));
+    EXPECT_EQ(index, 20 * WORDS_PER_WRITE);
+}
+
+/**
+ * Verify that lookups before the timeline, or off the only entry of a timeline, fail.
+ */
+TEST(IndexTimelineTest, lookupsOutsideTimeline) {
+    IndexTimeline timeline;
+    Time time;
+    IndexTimeline::Index index;
+    EXPECT_FALSE(timeline.getTime(0, &time));
+    EXPECT_FALSE(timeline.getIndex(START, &index));
+
+    timeline.record(WORDS_PER_WRITE, START);
+    EXPECT_FALSE(timeline.getTime(0, &time));
+    EXPECT_FALSE(timeline.getTime(WORDS_PER_WRITE + 1, &time));
+    ASSERT_TRUE(timeline.getTime(WORDS_PER_WRITE, &time));
+    EXPECT_EQ(time, START);
+    EXPECT_FALSE(timeline.getIndex(START - WRITE_PERIOD, &index));
+    ASSERT_TRUE(timeline.getIndex(START, &index));
+    EXPECT_EQ(index, WORDS_PER_WRITE);
+
+    EXPECT_FALSE(timeline.getTime(WORDS_PER_WRITE, nullptr));
+    EXPECT_FALSE(timeline.getIndex(START, nullptr));
+}
+
+/**
+ * Verify that the oldest entries are dropped once the capacity is reached.
+ */
+TEST(IndexTimelineTest, oldestEntriesDropped) {
+    IndexTimeline timeline(4);
+    recordWrites(&timeline, 10);
+    Time time;
+    EXPECT_FALSE(timeline.getTime(5 * WORDS_PER_WRITE, &time));
+    ASSERT_TRUE(timeline.getTime(6 * WORDS_PER_WRITE, &time));
+    EXPECT_EQ(time, START + 6 * WRITE_PERIOD);
+    ASSERT_TRUE(timeline.getTime(8 * WORDS_PER_WRITE + 1, &time));
+    EXPECT_GT(time, START + 8 * WRITE_PERIOD);
+}
+
+/**
+ * Verify that entries which do not advance the index and the time are ignored, and that clearing removes all entries.
+ */
+TEST(IndexTimelineTest, unorderedEntriesIgnoredAndClear) {
+    IndexTimeline timeline;
+    recordWrites(&timeline, 2);
+    timeline.record(WORDS_PER_WRITE, START + 5 * WRITE_PERIOD);
+    timeline.record(5 * WORDS_PER_WRITE, START);
+    Time time;
+    ASSERT_TRUE(timeline.getTime(2 * WORDS_PER_WRITE, &time));
+    EXPECT_EQ(time, START + 2 * WRITE_PERIOD);
+
+    timeline.clear();
+    EXPECT_FALSE(timeline.getTime(0, &time));
+}
+
+}  // namespace test
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -412,6 +412,69 @@ TEST_F(JSONUtilTest, convertToInt64ValueWithNullOutputParam) {
     ASSERT_FALSE(convertToValue(node, value));
 }
 
+/**
+ * Tests scanStringValue with keys of a directive which has not been parsed.  Expect the values which are strings to
+ * be found.
+ */
+TEST_F(JSONUtilTest, scanStringValueOfDirective) {
+    std::string value;
+    ASSERT_TRUE(scanStringValue(SPEAK_DIRECTIVE, JSON_MESSAGE_ID_STRING, &value));
+    ASSERT_EQ(value, MESSAGE_ID_TEST);
+    ASSERT_TRUE(scanStringValue(SPEAK_DIRECTIVE, JSON_MESSAGE_DIALOG_REQUEST_ID_STRING, &value));
+    ASSERT_EQ(value, DIALOG_REQUEST_ID_TEST);
+    ASSERT_FALSE(scanStringValue(SPEAK_DIRECTIVE, JSON_MESSAGE_PAYLOAD_STRING, &value));
+    ASSERT_FALSE(scanStringValue(SPEAK_DIRECTIVE, MISSING_KEY, &value));
+    ASSERT_FALSE(scanStringValue(SPEAK_DIRECTIVE, JSON_MESSAGE_ID_STRING, nullptr));
+}
+
+/**
+ * Tests lookupValues with the header fields of a directive.  Expect all the values to be found in one call.
+ */
+TEST_F(JSONUtilTest, lookupValuesOfHeader) {
+    std::string directive;
+    ASSERT_TRUE(jsonUtils::lookupStringValue(SPEAK_DIRECTIVE, DIRECTIVE_TEST, &directive));
+    std::string header;
+    std::string payload;
+    ASSERT_TRUE(
+        lookupValues(directive, {{JSON_MESSAGE_HEADER_STRING, &header}, {JSON_MESSAGE_PAYLOAD_STRING, &payload}}));
+    ASSERT_EQ(payload, PAYLOAD_TEST);
+
+    std::string namespaceValue;
+    std::string name;
+    std::string messageId;
+    ASSERT_TRUE(lookupValues(
+        header,
+        {{JSON_MESSAGE_NAMESPACE_STRING, &namespaceValue},
+         {JSON_MESSAGE_NAME_STRING, &name},
+         {JSON_MESSAGE_ID_STRING, &messageId}}));
+    ASSERT_EQ(namespaceValue, NAMESPACE_TEST);
+    ASSERT_EQ(name, NAME_TEST);
+    ASSERT_EQ(messageId, MESSAGE_ID_TEST);
+}
+
+/**
+ * Tests lookupValues with an int64 value.
+ */
+TEST_F(JSONUtilTest, lookupValuesOfInt64) {
+    int64_t value = 0;
+    ASSERT_TRUE(lookupValues(int64Json(AN_INT64_STRING), {}, {{INT64_KEY, &value}}));
+    ASSERT_EQ(value, AN_INT64);
+}
+
+/**
+ * Tests lookupValues with missing keys, values of the wrong type, invalid JSON and a null output parameter.  Expect
+ * each to fail.
+ */
+TEST_F(JSONUtilTest, lookupValuesFailures) {
+    std::string stringValue;
+    int64_t int64Value = 0;
+    ASSERT_FALSE(lookupValues(int64Json(AN_INT64_STRING), {{MISSING_KEY, &stringValue}}, {{INT64_KEY, &int64Value}}));
+    ASSERT_FALSE(lookupValues(int64Json(NOT_AN_INT64), {}, {{INT64_KEY, &int64Value}}));
+    ASSERT_FALSE(lookupValues(int64Json(AN_INT64_STRING), {{INT64_KEY, &stringValue}}));
+    ASSERT_FALSE(lookupValues(INVALID_JSON, {{INT64_KEY, &stringValue}}));
+    ASSERT_FALSE(lookupValues(int64Json(AN_INT64_STRING), {}, {{INT64_KEY, nullptr}}));
+}
+
 }  // namespace test
 }  // namespace json
 }  // namespace utils
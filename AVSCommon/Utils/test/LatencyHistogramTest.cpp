@@ -0,0 +1,93 @@
+/*
+ * LatencyHistogramTest.cpp
+ *
+ * Copyright 2016-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file LatencyHistogramTest.cpp
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Metrics/LatencyHistogram.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+namespace test {
+
+/// The largest relative error of a value reported by the histogram.
+static const double MAX_RELATIVE_ERROR = 1.0 / 32;
+
+/**
+ * Verify that an empty histogram reports zero.
+ */
+TEST(LatencyHistogramTest, emptyHistogram) {
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getCount(), 0u);
+    ASSERT_EQ(histogram.getMax(), 0u);
+    ASSERT_EQ(histogram.getValueAtPercentile(50), 0u);
+}
+
+/**
+ * Verify that small values are counted exactly.
+ */
+TEST(LatencyHistogramTest, smallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10; ++value) {
+        histogram.record(value);
+    }
+    ASSERT_EQ(histogram.getCount(), 10u);
+    ASSERT_EQ(histogram.getMax(), 10u);
+    ASSERT_EQ(histogram.getValueAtPercentile(0), 1u);
+    ASSERT_EQ(histogram.getValueAtPercentile(50), 5u);
+    ASSERT_EQ(histogram.getValueAtPercentile(90), 9u);
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 10u);
+}
+
+/**
+ * Verify that the percentiles of large values are within the expected error.
+ */
+TEST(LatencyHistogramTest, largeValuesAreWithinError) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value * 100);
+    }
+    for (auto percentile : {50.0, 90.0, 99.0}) {
+        double expected = percentile * 100000;
+        double actual = static_cast<double>(histogram.getValueAtPercentile(percentile));
+        ASSERT_GE(actual, expected * (1 - MAX_RELATIVE_ERROR));
+        ASSERT_LE(actual, expected * (1 + MAX_RELATIVE_ERROR));
+    }
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 10000000u);
+}
+
+/**
+ * Verify that values beyond @c MAX_VALUE are clamped, and that @c reset() forgets the values.
+ */
+TEST(LatencyHistogramTest, clampAndReset) {
+    LatencyHistogram histogram;
+    histogram.record(LatencyHistogram::MAX_VALUE + 1000);
+    ASSERT_EQ(histogram.getMax(), LatencyHistogram::MAX_VALUE);
+    ASSERT_EQ(histogram.getValueAtPercentile(50), LatencyHistogram::MAX_VALUE);
+    histogram.reset();
+    ASSERT_EQ(histogram.getCount(), 0u);
+    ASSERT_EQ(histogram.getMax(), 0u);
+}
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
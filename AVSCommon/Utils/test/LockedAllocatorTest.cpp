@@ -0,0 +1,133 @@
+/*
+ * LockedAllocatorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file LockedAllocatorTest.cpp
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Memory/LockedAllocator.h"
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace memory {
+namespace test {
+
+using namespace sds;
+
+/// The number of bytes allocated by the tests, which is not a whole number of pages.
+static const size_t BUFFER_SIZE = 100000;
+
+/**
+ * Fill a buffer, and check that it was zeroed and kept what was written.
+ *
+ * @param options How to obtain the memory of the buffer.
+ */
+static void checkBuffer(const LockedMemoryOptions& options) {
+    std::vector<uint8_t, LockedAllocator<uint8_t>> buffer(BUFFER_SIZE, 0, LockedAllocator<uint8_t>(options));
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(buffer.data()) % alignof(std::max_align_t));
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        ASSERT_EQ(0, buffer[i]);
+        buffer[i] = static_cast<uint8_t>(i);
+    }
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        ASSERT_EQ(static_cast<uint8_t>(i), buffer[i]);
+    }
+}
+
+/// Verify that memory is usable with each of the options.
+TEST(LockedAllocatorTest, allocateWithEachOption) {
+    checkBuffer(LockedMemoryOptions());
+    checkBuffer(LockedMemoryOptions(true));
+    checkBuffer(LockedMemoryOptions(false, true));
+    checkBuffer(LockedMemoryOptions(false, false, true));
+    checkBuffer(LockedMemoryOptions(true, true, true));
+}
+
+/// Verify that mapped memory is counted while it exists, and that locking it either succeeds or is counted as failed.
+TEST(LockedAllocatorTest, gaugesCountMappedMemory) {
+    auto before = getLockedMemoryGauges();
+    {
+        LockedAllocator<uint8_t> allocator(LockedMemoryOptions(true, true));
+        auto memory = allocator.allocate(BUFFER_SIZE);
+        ASSERT_NE(nullptr, memory);
+        auto during = getLockedMemoryGauges();
+        ASSERT_GE(during.mappedBytes, before.mappedBytes + BUFFER_SIZE);
+        auto isLocked = during.lockedBytes > before.lockedBytes;
+        auto isLockFailure = during.lockFailures > before.lockFailures;
+        ASSERT_NE(isLocked, isLockFailure);
+        allocator.deallocate(memory, BUFFER_SIZE);
+    }
+    auto after = getLockedMemoryGauges();
+    ASSERT_EQ(before.mappedBytes, after.mappedBytes);
+    ASSERT_EQ(before.lockedBytes, after.lockedBytes);
+    ASSERT_EQ(before.hugePageBytes, after.hugePageBytes);
+}
+
+/// Verify that allocators are equal when their options are, and that rebinding keeps the options.
+TEST(LockedAllocatorTest, allocatorEquality) {
+    LockedAllocator<uint8_t> plain;
+    LockedAllocator<uint8_t> locked(LockedMemoryOptions(false, true));
+    LockedAllocator<uint64_t> rebound(locked);
+    ASSERT_TRUE(plain != locked);
+    ASSERT_TRUE(locked == rebound);
+    ASSERT_EQ(locked.getOptions(), rebound.getOptions());
+}
+
+/// Verify that allocators constructed without options take the default options at the time.
+TEST(LockedAllocatorTest, defaultOptions) {
+    ASSERT_TRUE(LockedMemoryOptions::getDefault().isPlain());
+    LockedMemoryOptions::setDefault(LockedMemoryOptions(true, true));
+    LockedAllocator<uint8_t> allocator;
+    LockedMemoryOptions::setDefault(LockedMemoryOptions());
+    ASSERT_EQ(LockedMemoryOptions(true, true), allocator.getOptions());
+    ASSERT_TRUE(LockedAllocator<uint8_t>().getOptions().isPlain());
+}
+
+/// Verify that a stream works on a locked, pre-faulted buffer.
+TEST(LockedAllocatorTest, streamOnLockedBuffer) {
+    static const size_t WORD_SIZE = 2;
+    static const size_t NUM_WORDS = BUFFER_SIZE / WORD_SIZE;
+    auto bufferSize = InProcessSDS::calculateBufferSize(NUM_WORDS, WORD_SIZE);
+    LockedAllocator<uint8_t> allocator(LockedMemoryOptions(true, true));
+    auto buffer = std::make_shared<InProcessSDS::Buffer>(bufferSize, 0, allocator);
+    auto stream = InProcessSDS::create(buffer, WORD_SIZE);
+    ASSERT_TRUE(stream);
+    auto writer = stream->createWriter(InProcessSDS::Writer::Policy::NONBLOCKABLE);
+    auto reader = stream->createReader(InProcessSDS::Reader::Policy::NONBLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+
+    std::vector<int16_t> written(NUM_WORDS);
+    for (size_t i = 0; i < written.size(); ++i) {
+        written[i] = static_cast<int16_t>(i);
+    }
+    ASSERT_EQ(static_cast<ssize_t>(NUM_WORDS), writer->write(written.data(), NUM_WORDS));
+    std::vector<int16_t> read(NUM_WORDS);
+    ASSERT_EQ(static_cast<ssize_t>(NUM_WORDS), reader->read(read.data(), NUM_WORDS));
+    ASSERT_EQ(written, read);
+}
+
+}  // namespace test
+}  // namespace memory
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,98 @@
+/*
+ * LogRateLimiterTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file LogRateLimiterTest.cpp
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Logger/LogEntry.h"
+#include "AVSCommon/Utils/Logger/LogRateLimiter.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+namespace test {
+
+/// An interval long enough that it does not pass while a test runs.
+static const std::chrono::milliseconds LONG_INTERVAL(std::chrono::hours(1));
+
+/// An interval short enough to wait for in a test.
+static const std::chrono::milliseconds SHORT_INTERVAL(20);
+
+/**
+ * Verify that one in every @c n occurrences is admitted, starting with the first, with the others counted as
+ * suppressed.
+ */
+TEST(LogRateLimiterTest, admitEveryN) {
+    LogRateLimiter rateLimiter;
+    uint64_t suppressed = 1;
+    EXPECT_TRUE(rateLimiter.admitEveryN(3, &suppressed));
+    EXPECT_EQ(suppressed, 0u);
+    EXPECT_FALSE(rateLimiter.admitEveryN(3, &suppressed));
+    EXPECT_FALSE(rateLimiter.admitEveryN(3, &suppressed));
+    EXPECT_TRUE(rateLimiter.admitEveryN(3, &suppressed));
+    EXPECT_EQ(suppressed, 2u);
+}
+
+/**
+ * Verify that every occurrence is admitted when @c n is zero or one.
+ */
+TEST(LogRateLimiterTest, admitEveryOccurrence) {
+    LogRateLimiter rateLimiter;
+    uint64_t suppressed = 1;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(rateLimiter.admitEveryN(1, &suppressed));
+        EXPECT_EQ(suppressed, 0u);
+        EXPECT_TRUE(rateLimiter.admitEveryN(0, &suppressed));
+        EXPECT_EQ(suppressed, 0u);
+    }
+}
+
+/**
+ * Verify that the first occurrence is admitted, and the others only once the interval has passed, with the number of
+ * occurrences suppressed in between.
+ */
+TEST(LogRateLimiterTest, admitAtInterval) {
+    LogRateLimiter rateLimiter;
+    uint64_t suppressed = 1;
+    EXPECT_TRUE(rateLimiter.admitAtInterval(SHORT_INTERVAL, &suppressed));
+    EXPECT_EQ(suppressed, 0u);
+    EXPECT_FALSE(rateLimiter.admitAtInterval(LONG_INTERVAL, &suppressed));
+    EXPECT_FALSE(rateLimiter.admitAtInterval(LONG_INTERVAL, &suppressed));
+    std::this_thread::sleep_for(SHORT_INTERVAL);
+    EXPECT_TRUE(rateLimiter.admitAtInterval(SHORT_INTERVAL, &suppressed));
+    EXPECT_EQ(suppressed, 2u);
+}
+
+/**
+ * Verify that the suppressed count is added to an entry only when occurrences were suppressed.
+ */
+TEST(LogRateLimiterTest, addSuppressedCount) {
+    LogEntry entry("source", "event");
+    EXPECT_EQ(std::string(LogRateLimiter::addSuppressedCount(entry, 0).c_str()), "source:event");
+    EXPECT_EQ(std::string(LogRateLimiter::addSuppressedCount(entry, 5).c_str()), "source:event:suppressed=5");
+}
+
+}  // namespace test
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
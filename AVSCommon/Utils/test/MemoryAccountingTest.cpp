@@ -0,0 +1,114 @@
+/*
+ * MemoryAccountingTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file MemoryAccountingTest.cpp
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Metrics/MemoryAccounting.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+namespace test {
+
+using Category = MemoryAccounting::Category;
+
+/**
+ * Get the memory of a category.
+ *
+ * @param category The category.
+ * @return The memory of the category.
+ */
+static MemoryAccounting::Usage getUsage(Category category) {
+    return MemoryAccounting::getSnapshot()[static_cast<size_t>(category)];
+}
+
+/// Test harness for @c MemoryAccounting class.
+class MemoryAccountingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        MemoryAccounting::setEnabled(true);
+        MemoryAccounting::resetHighWaterMarks();
+    }
+
+    void TearDown() override {
+        MemoryAccounting::setSampler(Category::SQLITE, nullptr);
+        MemoryAccounting::setEnabled(false);
+    }
+};
+
+/**
+ * Verify that allocations are counted while they exist, and that the high-water mark keeps the most bytes held.
+ */
+TEST_F(MemoryAccountingTest, countAllocations) {
+    auto before = getUsage(Category::MEDIA_BUFFERS);
+    {
+        MemoryAccounting::Allocation first(Category::MEDIA_BUFFERS, 100);
+        MemoryAccounting::Allocation second(Category::MEDIA_BUFFERS);
+        second.resize(50);
+        auto usage = getUsage(Category::MEDIA_BUFFERS);
+        EXPECT_EQ(usage.bytes, before.bytes + 150);
+        EXPECT_EQ(usage.allocations, before.allocations + 2);
+
+        second.resize(10);
+        usage = getUsage(Category::MEDIA_BUFFERS);
+        EXPECT_EQ(usage.bytes, before.bytes + 110);
+        EXPECT_EQ(usage.highWaterBytes, before.bytes + 150);
+    }
+    auto after = getUsage(Category::MEDIA_BUFFERS);
+    EXPECT_EQ(after.bytes, before.bytes);
+    EXPECT_EQ(after.allocations, before.allocations);
+    EXPECT_EQ(after.highWaterBytes, before.bytes + 150);
+
+    MemoryAccounting::resetHighWaterMarks();
+    EXPECT_EQ(getUsage(Category::MEDIA_BUFFERS).highWaterBytes, before.bytes);
+}
+
+/**
+ * Verify that nothing is counted while accounting is off, even once it is turned back on.
+ */
+TEST_F(MemoryAccountingTest, disabled) {
+    auto before = getUsage(Category::MEDIA_BUFFERS);
+    MemoryAccounting::setEnabled(false);
+    MemoryAccounting::Allocation allocation(Category::MEDIA_BUFFERS, 100);
+    EXPECT_EQ(getUsage(Category::MEDIA_BUFFERS).bytes, before.bytes);
+    MemoryAccounting::setEnabled(true);
+    EXPECT_EQ(getUsage(Category::MEDIA_BUFFERS).bytes, before.bytes);
+    allocation.resize(200);
+    EXPECT_EQ(getUsage(Category::MEDIA_BUFFERS).bytes, before.bytes + 200);
+}
+
+/**
+ * Verify that a category measured by a sampler reports the sampled bytes.
+ */
+TEST_F(MemoryAccountingTest, sampler) {
+    uint64_t sampled = 1000;
+    MemoryAccounting::setSampler(Category::SQLITE, [&sampled]() { return sampled; });
+    EXPECT_EQ(getUsage(Category::SQLITE).bytes, 1000u);
+    sampled = 500;
+    auto usage = getUsage(Category::SQLITE);
+    EXPECT_EQ(usage.bytes, 500u);
+    EXPECT_GE(usage.highWaterBytes, 1000u);
+}
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
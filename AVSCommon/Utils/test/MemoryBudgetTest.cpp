@@ -0,0 +1,125 @@
+/*
+ * MemoryBudgetTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file MemoryBudgetTest.cpp
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Memory/MemoryBudget.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace memory {
+namespace test {
+
+/// The size of the budget used by the tests.
+static const uint64_t MAX_BYTES = 1000;
+
+/// The size of the low priority part of the budget used by the tests.
+static const uint64_t LOW_PRIORITY_MAX_BYTES = 400;
+
+/// Test harness for @c MemoryBudget class.
+class MemoryBudgetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_budget = MemoryBudget::create(MAX_BYTES, LOW_PRIORITY_MAX_BYTES);
+        ASSERT_TRUE(m_budget);
+    }
+
+    /// The budget under test.
+    std::shared_ptr<MemoryBudget> m_budget;
+};
+
+/// Verify that a budget of zero bytes is rejected.
+TEST_F(MemoryBudgetTest, createWithZeroMaxBytes) {
+    ASSERT_FALSE(MemoryBudget::create(0));
+}
+
+/// Verify that a reservation is counted while it exists, and that shrinking it returns bytes to the budget.
+TEST_F(MemoryBudgetTest, reservationsAreCounted) {
+    auto reservation = m_budget->reserve(600, 100);
+    ASSERT_TRUE(reservation);
+    ASSERT_EQ(600u, reservation->getBytes());
+    ASSERT_EQ(600u, m_budget->getGauges().reservedBytes);
+    ASSERT_EQ(1u, m_budget->getGauges().reservations);
+
+    reservation->shrink(200);
+    ASSERT_EQ(200u, reservation->getBytes());
+    ASSERT_EQ(200u, m_budget->getGauges().reservedBytes);
+    ASSERT_EQ(600u, m_budget->getGauges().highWaterBytes);
+
+    reservation.reset();
+    auto gauges = m_budget->getGauges();
+    ASSERT_EQ(0u, gauges.reservedBytes);
+    ASSERT_EQ(0u, gauges.reservations);
+    m_budget->resetHighWaterMark();
+    ASSERT_EQ(0u, m_budget->getGauges().highWaterBytes);
+}
+
+/// Verify that a request is shrunk to what is left of the budget, and rejected if even its minimum does not fit.
+TEST_F(MemoryBudgetTest, requestsAreShrunkThenRejected) {
+    auto first = m_budget->reserve(700, 100);
+    ASSERT_TRUE(first);
+    auto second = m_budget->reserve(700, 100);
+    ASSERT_TRUE(second);
+    ASSERT_EQ(300u, second->getBytes());
+    ASSERT_FALSE(m_budget->reserve(700, 100));
+
+    auto gauges = m_budget->getGauges();
+    ASSERT_EQ(MAX_BYTES, gauges.reservedBytes);
+    ASSERT_EQ(1u, gauges.shrunkRequests);
+    ASSERT_EQ(1u, gauges.rejectedRequests);
+}
+
+/// Verify that low priority requests are limited to their part of the budget.
+TEST_F(MemoryBudgetTest, lowPriorityRequestsAreLimited) {
+    auto low = m_budget->reserve(LOW_PRIORITY_MAX_BYTES, LOW_PRIORITY_MAX_BYTES, MemoryBudget::Priority::LOW);
+    ASSERT_TRUE(low);
+    ASSERT_FALSE(m_budget->reserve(1, 1, MemoryBudget::Priority::LOW));
+    ASSERT_TRUE(m_budget->reserve(MAX_BYTES - LOW_PRIORITY_MAX_BYTES, 1, MemoryBudget::Priority::NORMAL));
+}
+
+/// Verify that high priority requests are granted their minimum over the budget.
+TEST_F(MemoryBudgetTest, highPriorityRequestsAreNeverRejected) {
+    auto normal = m_budget->reserve(MAX_BYTES, MAX_BYTES);
+    ASSERT_TRUE(normal);
+    auto high = m_budget->reserve(500, 200, MemoryBudget::Priority::HIGH);
+    ASSERT_TRUE(high);
+    ASSERT_EQ(200u, high->getBytes());
+
+    auto gauges = m_budget->getGauges();
+    ASSERT_EQ(MAX_BYTES + 200, gauges.reservedBytes);
+    ASSERT_EQ(1u, gauges.overBudgetRequests);
+}
+
+/// Verify that the default budget is unlimited until another one is set.
+TEST_F(MemoryBudgetTest, defaultBudget) {
+    auto unlimited = MemoryBudget::getDefault();
+    ASSERT_EQ(MemoryBudget::UNLIMITED, unlimited->getGauges().maxBytes);
+
+    MemoryBudget::setDefault(m_budget);
+    ASSERT_EQ(m_budget, MemoryBudget::getDefault());
+    MemoryBudget::setDefault(nullptr);
+    ASSERT_EQ(unlimited, MemoryBudget::getDefault());
+}
+
+}  // namespace test
+}  // namespace memory
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
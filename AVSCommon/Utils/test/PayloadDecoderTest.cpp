@@ -0,0 +1,112 @@
+/*
+ * PayloadDecoderTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/JSON/PayloadDecoder.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace json {
+namespace test {
+
+using namespace jsonUtils;
+
+/// A payload to decode in tests.
+struct TestPayload {
+    /// A required string.
+    std::string token;
+    /// A required object, decoded as a string.
+    std::string stream;
+    /// A required integer.
+    int64_t offset;
+    /// An optional string.
+    std::string label;
+};
+
+/// The schema of @c TestPayload.
+static constexpr PayloadField<TestPayload> TEST_SCHEMA[] = {{"token", &TestPayload::token},
+                                                            {"stream", &TestPayload::stream},
+                                                            {"offset", &TestPayload::offset},
+                                                            {"label", &TestPayload::label, false}};
+
+/// A payload with all the fields of @c TestPayload.
+static const std::string FULL_PAYLOAD =
+    R"({"token":"testToken","stream":{"url":"cid:test"},"offset":1234,"label":"testLabel","other":[1,2]})";
+
+/// A payload without the optional field of @c TestPayload.
+static const std::string PAYLOAD_WITHOUT_OPTIONAL_FIELD = R"({"token":"testToken","stream":{},"offset":0})";
+
+/// A payload without the required "offset" field of @c TestPayload.
+static const std::string PAYLOAD_WITHOUT_OFFSET = R"({"token":"testToken","stream":{},"label":"testLabel"})";
+
+/// A payload in which the "offset" field of @c TestPayload is a string.
+static const std::string PAYLOAD_WITH_STRING_OFFSET = R"({"token":"testToken","stream":{},"offset":"1234"})";
+
+/**
+ * Verify that all the fields of a payload are decoded.
+ */
+TEST(PayloadDecoderTest, decodeAllFields) {
+    TestPayload payload;
+    ASSERT_TRUE(decodePayload(FULL_PAYLOAD, TEST_SCHEMA, &payload));
+    EXPECT_EQ(payload.token, "testToken");
+    EXPECT_EQ(payload.stream, R"({"url":"cid:test"})");
+    EXPECT_EQ(payload.offset, 1234);
+    EXPECT_EQ(payload.label, "testLabel");
+}
+
+/**
+ * Verify that a missing optional field leaves its member unchanged.
+ */
+TEST(PayloadDecoderTest, decodeWithoutOptionalField) {
+    TestPayload payload;
+    payload.label = "default";
+    ASSERT_TRUE(decodePayload(PAYLOAD_WITHOUT_OPTIONAL_FIELD, TEST_SCHEMA, &payload));
+    EXPECT_EQ(payload.label, "default");
+}
+
+/**
+ * Verify that a missing required field, or one with a value of the wrong type, fails decoding and is reported.
+ */
+TEST(PayloadDecoderTest, decodeWithoutRequiredField) {
+    TestPayload payload;
+    std::string missingKey;
+    ASSERT_FALSE(decodePayload(PAYLOAD_WITHOUT_OFFSET, TEST_SCHEMA, &payload, &missingKey));
+    EXPECT_EQ(missingKey, "offset");
+    missingKey.clear();
+    ASSERT_FALSE(decodePayload(PAYLOAD_WITH_STRING_OFFSET, TEST_SCHEMA, &payload, &missingKey));
+    EXPECT_EQ(missingKey, "offset");
+}
+
+/**
+ * Verify that invalid JSON and a null payload fail decoding without reporting a missing field.
+ */
+TEST(PayloadDecoderTest, decodeFailures) {
+    TestPayload payload;
+    std::string missingKey;
+    ASSERT_FALSE(decodePayload("invalidTestJSON", TEST_SCHEMA, &payload, &missingKey));
+    EXPECT_TRUE(missingKey.empty());
+    ASSERT_FALSE(decodePayload(FULL_PAYLOAD, TEST_SCHEMA, static_cast<TestPayload*>(nullptr), &missingKey));
+    EXPECT_TRUE(missingKey.empty());
+}
+
+}  // namespace test
+}  // namespace json
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
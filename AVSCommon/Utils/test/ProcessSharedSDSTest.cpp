@@ -0,0 +1,162 @@
+/*
+ * ProcessSharedSDSTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ProcessSharedSDSTest.cpp
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/SDS/ProcessSharedSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+namespace test {
+
+/// The word size used by the tests.
+static const size_t WORDSIZE = 2;
+
+/// The number of words in the test streams.
+static const size_t WORDCOUNT = 64;
+
+/// The maximum number of readers in the test streams.
+static const size_t MAXREADERS = 2;
+
+/// Used to limit the amount of time tests will wait for data.
+static const std::chrono::seconds TIMEOUT{5};
+
+/// Test harness for @c ProcessSharedSDS.
+class ProcessSharedSDSTest : public ::testing::Test {
+protected:
+    /// Pick a shared memory name which is unique to this process.
+    void SetUp() override {
+        m_name = "/acsdkProcessSharedSDSTest." + std::to_string(getpid());
+    }
+
+    /// The name of the shared memory object used by the test.
+    std::string m_name;
+};
+
+/// Verify that a stream created in one mapping can be opened and read through another.
+TEST_F(ProcessSharedSDSTest, createAndOpen) {
+    ASSERT_EQ(ProcessSharedSDS::Buffer::open(m_name), nullptr);
+
+    auto buffer = ProcessSharedSDS::Buffer::create(
+        m_name, ProcessSharedSDS::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS));
+    ASSERT_NE(buffer, nullptr);
+    auto sds = ProcessSharedSDS::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+
+    // A second mapping of the same object is at a different address, as it would be in another process.
+    auto otherBuffer = ProcessSharedSDS::Buffer::open(m_name);
+    ASSERT_NE(otherBuffer, nullptr);
+    ASSERT_EQ(otherBuffer->size(), buffer->size());
+    ASSERT_NE(otherBuffer->data(), buffer->data());
+    auto otherSds = ProcessSharedSDS::open(otherBuffer);
+    ASSERT_NE(otherSds, nullptr);
+
+    auto reader = otherSds->createReader(ProcessSharedSDS::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    auto writer = sds->createWriter(ProcessSharedSDS::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+
+    uint16_t writeBuf[WORDCOUNT / 2];
+    for (size_t i = 0; i < WORDCOUNT / 2; ++i) {
+        writeBuf[i] = static_cast<uint16_t>(i);
+    }
+    ASSERT_EQ(writer->write(writeBuf, WORDCOUNT / 2), static_cast<ssize_t>(WORDCOUNT / 2));
+    uint16_t readBuf[WORDCOUNT / 2] = {};
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT / 2), static_cast<ssize_t>(WORDCOUNT / 2));
+    ASSERT_EQ(memcmp(writeBuf, readBuf, sizeof(writeBuf)), 0);
+
+    // The creator removes the name when it is done with the buffer.
+    writer.reset();
+    reader.reset();
+    otherSds.reset();
+    sds.reset();
+    buffer.reset();
+    ASSERT_EQ(ProcessSharedSDS::Buffer::open(m_name), nullptr);
+}
+
+/// Verify that a blocking reader is woken by a writer in another process.
+TEST_F(ProcessSharedSDSTest, crossProcessBlockingRead) {
+    auto buffer = ProcessSharedSDS::Buffer::create(
+        m_name, ProcessSharedSDS::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS));
+    ASSERT_NE(buffer, nullptr);
+    auto sds = ProcessSharedSDS::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto reader = sds->createReader(ProcessSharedSDS::Reader::Policy::BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    reader->setWakeupThreshold(WORDCOUNT);
+
+    pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (0 == child) {
+        // Open the stream by name, as an unrelated process would, and write it one word at a time.
+        auto childBuffer = ProcessSharedSDS::Buffer::open(m_name);
+        auto childSds = childBuffer ? ProcessSharedSDS::open(childBuffer) : nullptr;
+        auto writer = childSds ? childSds->createWriter(ProcessSharedSDS::Writer::Policy::ALL_OR_NOTHING) : nullptr;
+        if (!writer) {
+            _exit(1);
+        }
+        for (uint16_t i = 0; i < WORDCOUNT; ++i) {
+            if (writer->write(&i, 1) != 1) {
+                _exit(2);
+            }
+        }
+        _exit(0);
+    }
+
+    uint16_t readBuf[WORDCOUNT] = {};
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT, TIMEOUT), static_cast<ssize_t>(WORDCOUNT));
+    for (size_t i = 0; i < WORDCOUNT; ++i) {
+        ASSERT_EQ(readBuf[i], i);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+}
+
+/// Verify that a lock held by a process which dies is recovered rather than deadlocking.
+TEST_F(ProcessSharedSDSTest, robustMutexRecovery) {
+    auto buffer = ProcessSharedSDS::Buffer::create(m_name, sizeof(ProcessSharedSDSTraits::Mutex));
+    ASSERT_NE(buffer, nullptr);
+    auto mutex = new (buffer->data()) ProcessSharedSDSTraits::Mutex;
+
+    pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (0 == child) {
+        mutex->lock();
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+
+    mutex->lock();
+    mutex->unlock();
+    mutex->~Mutex();
+}
+
+}  // namespace test
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
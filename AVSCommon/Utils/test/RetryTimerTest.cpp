@@ -0,0 +1,84 @@
+/*
+ * RetryTimerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/RetryTimer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace test {
+
+/// A retry table for testing.
+static int RETRY_TABLE_TEST[] = {100, 1000, 10000};
+
+/// The size of @c RETRY_TABLE_TEST.
+static const int RETRY_TABLE_SIZE_TEST = sizeof(RETRY_TABLE_TEST) / sizeof(RETRY_TABLE_TEST[0]);
+
+/// The number of retries to compute in each test.
+static const int NUM_RETRIES = 100;
+
+/**
+ * Verify that delays with decorrelated jitter stay between the first and last entries of the retry table, and within
+ * three times the previous delay.
+ */
+TEST(RetryTimerTest, decorrelatedTimeToRetryIsBounded) {
+    RetryTimer retryTimer(RETRY_TABLE_TEST, RETRY_TABLE_SIZE_TEST);
+    std::chrono::milliseconds previous = std::chrono::milliseconds::zero();
+    for (int i = 0; i < NUM_RETRIES; ++i) {
+        auto delay = retryTimer.calculateDecorrelatedTimeToRetry(previous);
+        ASSERT_GE(delay.count(), RETRY_TABLE_TEST[0]);
+        ASSERT_LE(delay.count(), RETRY_TABLE_TEST[RETRY_TABLE_SIZE_TEST - 1]);
+        ASSERT_LE(delay, std::max(previous, std::chrono::milliseconds(RETRY_TABLE_TEST[0])) * 3);
+        previous = delay;
+    }
+}
+
+/**
+ * Verify that the first delays of clients which start retrying together are spread out, rather than being the same.
+ */
+TEST(RetryTimerTest, firstDecorrelatedTimesToRetryAreSpread) {
+    RetryTimer retryTimer(RETRY_TABLE_TEST, RETRY_TABLE_SIZE_TEST);
+    std::set<std::chrono::milliseconds::rep> delays;
+    for (int i = 0; i < NUM_RETRIES; ++i) {
+        delays.insert(retryTimer.calculateDecorrelatedTimeToRetry(std::chrono::milliseconds::zero()).count());
+    }
+    ASSERT_GT(delays.size(), 1u);
+}
+
+/**
+ * Verify that the delays computed from the retry table within the same second are spread out, rather than being the
+ * same.
+ */
+TEST(RetryTimerTest, timesToRetryAreSpread) {
+    RetryTimer retryTimer(RETRY_TABLE_TEST, RETRY_TABLE_SIZE_TEST);
+    std::set<std::chrono::milliseconds::rep> delays;
+    for (int i = 0; i < NUM_RETRIES; ++i) {
+        delays.insert(retryTimer.calculateTimeToRetry(1).count());
+    }
+    ASSERT_GT(delays.size(), 1u);
+}
+
+}  // namespace test
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
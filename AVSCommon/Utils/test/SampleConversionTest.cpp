@@ -0,0 +1,263 @@
+/*
+ * SampleConversionTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SampleConversionTest.cpp
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Audio/Decimator.h"
+#include "AVSCommon/Utils/Audio/SampleConversion.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace test {
+
+/// A number of samples which is not a multiple of the vector width, so that the scalar tail is tested too.
+static const size_t NUM_SAMPLES = 1003;
+
+/// The factor to decimate 48 kHz audio to 16 kHz.
+static const unsigned int DECIMATION_FACTOR = 3;
+
+/// Pi, for generating tones.
+static const double PI = 3.14159265358979323846;
+
+/**
+ * Generate a pseudo-random 32-bit value.
+ *
+ * @param state The state of the generator, updated by the call.
+ * @return The value.
+ */
+static int32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+    int32_t value;
+    std::memcpy(&value, state, sizeof(value));
+    return value;
+}
+
+/**
+ * Generate a tone of 48 kHz samples.
+ *
+ * @param frequencyHz The frequency of the tone.
+ * @param amplitude The amplitude of the tone.
+ * @param numSamples The number of samples.
+ * @return The samples.
+ */
+static std::vector<int16_t> generateTone(double frequencyHz, double amplitude, size_t numSamples) {
+    std::vector<int16_t> samples(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] = static_cast<int16_t>(std::lround(amplitude * std::sin(2 * PI * frequencyHz * i / 48000)));
+    }
+    return samples;
+}
+
+/**
+ * Get the largest magnitude of a range of samples.
+ *
+ * @param samples The samples.
+ * @param begin The index of the first sample of the range.
+ * @return The largest magnitude of the samples from @c begin to the end.
+ */
+static int peak(const std::vector<int16_t>& samples, size_t begin) {
+    int result = 0;
+    for (size_t i = begin; i < samples.size(); ++i) {
+        result = std::max(result, std::abs(static_cast<int>(samples[i])));
+    }
+    return result;
+}
+
+/**
+ * Verify that 32-bit samples keep their 16 most significant bits, in place or not.
+ */
+TEST(SampleConversionTest, convertInt32ToInt16) {
+    uint32_t state = 1;
+    std::vector<int32_t> input(NUM_SAMPLES);
+    for (auto& sample : input) {
+        sample = nextRandom(&state);
+    }
+    input[0] = INT32_MIN;
+    input[1] = INT32_MAX;
+
+    std::vector<int16_t> output(NUM_SAMPLES);
+    convertInt32ToInt16(input.data(), output.data(), NUM_SAMPLES);
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+        ASSERT_EQ(output[i], static_cast<int16_t>(input[i] >> 16)) << "i=" << i;
+    }
+
+    auto inPlace = input;
+    convertInt32ToInt16(inPlace.data(), reinterpret_cast<int16_t*>(inPlace.data()), NUM_SAMPLES);
+    ASSERT_EQ(std::memcmp(inPlace.data(), output.data(), NUM_SAMPLES * sizeof(int16_t)), 0);
+}
+
+/**
+ * Verify that floating point samples are scaled, rounded and clipped.
+ */
+TEST(SampleConversionTest, convertFloatToInt16) {
+    std::vector<float> input(NUM_SAMPLES);
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+        input[i] = -1.5f + 3.0f * i / NUM_SAMPLES;
+    }
+    std::vector<int16_t> output(NUM_SAMPLES);
+    convertFloatToInt16(input.data(), output.data(), NUM_SAMPLES);
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+        double expected = std::min(std::max(input[i] * 32768.0, -32768.0), 32767.0);
+        // Vector units may truncate rather than round.
+        ASSERT_NEAR(output[i], expected, 1.0) << "i=" << i;
+    }
+    ASSERT_EQ(output.front(), INT16_MIN);
+    ASSERT_EQ(output.back(), INT16_MAX);
+
+    auto inPlace = input;
+    convertFloatToInt16(inPlace.data(), reinterpret_cast<int16_t*>(inPlace.data()), NUM_SAMPLES);
+    ASSERT_EQ(std::memcmp(inPlace.data(), output.data(), NUM_SAMPLES * sizeof(int16_t)), 0);
+}
+
+/**
+ * Verify that the channels of each frame are averaged, rounding toward zero, for stereo and other channel counts.
+ */
+TEST(SampleConversionTest, downmixToMono) {
+    uint32_t state = 2;
+    for (unsigned int numChannels = 1; numChannels <= 6; ++numChannels) {
+        std::vector<int16_t> input(NUM_SAMPLES * numChannels);
+        for (auto& sample : input) {
+            sample = static_cast<int16_t>(nextRandom(&state) >> 16);
+        }
+        std::vector<int16_t> output(NUM_SAMPLES);
+        downmixToMono(input.data(), numChannels, output.data(), NUM_SAMPLES);
+        for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+            int32_t sum = 0;
+            for (unsigned int channel = 0; channel < numChannels; ++channel) {
+                sum += input[i * numChannels + channel];
+            }
+            ASSERT_EQ(output[i], sum / static_cast<int32_t>(numChannels)) << "channels=" << numChannels << " i=" << i;
+        }
+
+        downmixToMono(input.data(), numChannels, input.data(), NUM_SAMPLES);
+        ASSERT_EQ(std::memcmp(input.data(), output.data(), NUM_SAMPLES * sizeof(int16_t)), 0);
+    }
+}
+
+/**
+ * Verify that each channel can be copied out of interleaved samples, for channel counts with and without vector code.
+ */
+TEST(SampleConversionTest, extractChannel) {
+    uint32_t state = 3;
+    for (unsigned int numChannels = 1; numChannels <= 6; ++numChannels) {
+        std::vector<int16_t> input(NUM_SAMPLES * numChannels);
+        for (auto& sample : input) {
+            sample = static_cast<int16_t>(nextRandom(&state) >> 16);
+        }
+        input[0] = INT16_MIN;
+        input[input.size() - 1] = INT16_MAX;
+        for (unsigned int channel = 0; channel < numChannels; ++channel) {
+            std::vector<int16_t> output(NUM_SAMPLES);
+            extractChannel(input.data(), numChannels, channel, output.data(), NUM_SAMPLES);
+            for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+                ASSERT_EQ(output[i], input[i * numChannels + channel])
+                    << "channels=" << numChannels << " channel=" << channel << " i=" << i;
+            }
+
+            auto inPlace = input;
+            extractChannel(inPlace.data(), numChannels, channel, inPlace.data(), NUM_SAMPLES);
+            ASSERT_EQ(std::memcmp(inPlace.data(), output.data(), NUM_SAMPLES * sizeof(int16_t)), 0);
+        }
+    }
+}
+
+/**
+ * Verify the dot product of vectors of various lengths.
+ */
+TEST(SampleConversionTest, dotProductInt16) {
+    uint32_t state = 3;
+    std::vector<int16_t> a(NUM_SAMPLES);
+    std::vector<int16_t> b(NUM_SAMPLES);
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+        a[i] = static_cast<int16_t>(nextRandom(&state) >> 24);
+        b[i] = static_cast<int16_t>(nextRandom(&state) >> 24);
+    }
+    for (size_t length : {0, 1, 7, 8, 9, 64, 1003}) {
+        int32_t expected = 0;
+        for (size_t i = 0; i < length; ++i) {
+            expected += a[i] * b[i];
+        }
+        ASSERT_EQ(dotProductInt16(a.data(), b.data(), length), expected) << "length=" << length;
+    }
+}
+
+/**
+ * Verify that the decimator keeps a constant signal and a tone in the passband, and attenuates a tone which would
+ * alias.
+ */
+TEST(SampleConversionTest, decimatorFrequencyResponse) {
+    ASSERT_FALSE(Decimator::create(0));
+    auto decimator = Decimator::create(DECIMATION_FACTOR);
+    ASSERT_TRUE(decimator);
+
+    // Skip the output while the filter fills up.
+    size_t settled = Decimator::TAPS_PER_PHASE;
+    std::vector<int16_t> input(4800, 10000);
+    std::vector<int16_t> output(decimator->getOutputSize(input.size()));
+    ASSERT_EQ(decimator->process(input.data(), input.size(), output.data()), 1600u);
+    for (size_t i = settled; i < output.size(); ++i) {
+        ASSERT_NEAR(output[i], 10000, 2) << "i=" << i;
+    }
+
+    decimator->reset();
+    input = generateTone(1000, 10000, 4800);
+    decimator->process(input.data(), input.size(), output.data());
+    ASSERT_NEAR(peak(output, settled), 10000, 200);
+
+    decimator->reset();
+    input = generateTone(12000, 10000, 4800);
+    decimator->process(input.data(), input.size(), output.data());
+    ASSERT_LT(peak(output, settled), 100);
+}
+
+/**
+ * Verify that decimating a stream in chunks of any size gives the same output as decimating it at once.
+ */
+TEST(SampleConversionTest, decimatorChunking) {
+    auto input = generateTone(440, 20000, 4801);
+    auto whole = Decimator::create(DECIMATION_FACTOR);
+    std::vector<int16_t> expected(whole->getOutputSize(input.size()));
+    whole->process(input.data(), input.size(), expected.data());
+
+    auto chunked = Decimator::create(DECIMATION_FACTOR);
+    std::vector<int16_t> output;
+    size_t offset = 0;
+    size_t chunkSize = 1;
+    while (offset < input.size()) {
+        auto count = std::min(chunkSize, input.size() - offset);
+        std::vector<int16_t> chunk(chunked->getOutputSize(count));
+        ASSERT_EQ(chunked->process(input.data() + offset, count, chunk.data()), chunk.size());
+        output.insert(output.end(), chunk.begin(), chunk.end());
+        offset += count;
+        chunkSize = chunkSize % 7 + 1;
+    }
+    ASSERT_EQ(output, expected);
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
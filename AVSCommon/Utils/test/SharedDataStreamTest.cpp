@@ -413,6 +413,18 @@ TEST_F(SharedDataStreamTest, sdsCalculateCreateSize) {
     ASSERT_GT(wordSize, SDK_WORDSIZE_REQUIRED);
 }
 
+/// This tests that the data of a @c SharedDataStream starts on a cache line and on a word.
+TEST_F(SharedDataStreamTest, dataAlignment) {
+    static const size_t CACHE_LINE_SIZE = 64;
+    for (size_t wordSize = 1; wordSize <= 24; ++wordSize) {
+        for (size_t maxReaders = 1; maxReaders <= 8; ++maxReaders) {
+            size_t dataOffset = Sds::calculateBufferSize(1, wordSize, maxReaders) - wordSize;
+            EXPECT_EQ(dataOffset % CACHE_LINE_SIZE, 0u) << "wordSize=" << wordSize << ", maxReaders=" << maxReaders;
+            EXPECT_EQ(dataOffset % wordSize, 0u) << "wordSize=" << wordSize << ", maxReaders=" << maxReaders;
+        }
+    }
+}
+
 /// This tests @c SharedDataStream::open().
 TEST_F(SharedDataStreamTest, sdsOpen) {
     static const size_t WORDSIZE = 2;
@@ -1042,6 +1054,256 @@ TEST_F(SharedDataStreamTest, writerGetWordSize) {
     }
 }
 
+/// This tests @c SharedDataStream::Writer::reserve() and @c SharedDataStream::Writer::commit().
+TEST_F(SharedDataStreamTest, writerReserveCommit) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 4;
+    static const size_t MAXREADERS = 1;
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::ALL_OR_NOTHING);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    // Verify bad parameter handling.
+    Sds::Writer::Span spans[2];
+    ASSERT_EQ(writer->reserve(WORDCOUNT, nullptr), Sds::Writer::Error::INVALID);
+    ASSERT_EQ(writer->reserve(0, spans), Sds::Writer::Error::INVALID);
+    ASSERT_EQ(writer->commit(1), Sds::Writer::Error::INVALID);
+
+    // Verify reserved data is not visible until it is committed.
+    ASSERT_EQ(writer->reserve(3, spans), 3);
+    ASSERT_EQ(spans[0].nWords, 3U);
+    ASSERT_EQ(spans[1].nWords, 0U);
+    ASSERT_EQ(writer->reserve(1, spans), Sds::Writer::Error::INVALID);
+    memset(spans[0].data, 7, 3 * WORDSIZE);
+    uint8_t readBuf[WORDSIZE * WORDCOUNT];
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT), Sds::Reader::Error::WOULDBLOCK);
+
+    // Verify a partial commit publishes only the committed words.
+    ASSERT_EQ(writer->commit(2), 2);
+    ASSERT_EQ(writer->tell(), 2U);
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT), 2);
+    for (size_t i = 0; i < 2 * WORDSIZE; ++i) {
+        ASSERT_EQ(readBuf[i], 7);
+    }
+
+    // Verify a reservation which crosses the end of the buffer is split into two spans.
+    ASSERT_EQ(writer->reserve(3, spans), 3);
+    ASSERT_EQ(spans[0].nWords, 2U);
+    ASSERT_EQ(spans[1].nWords, 1U);
+    auto wrapDistance = static_cast<uint8_t*>(spans[0].data) - static_cast<uint8_t*>(spans[1].data);
+    ASSERT_EQ(wrapDistance, static_cast<ptrdiff_t>(2 * WORDSIZE));
+    memset(spans[0].data, 8, spans[0].nWords * WORDSIZE);
+    memset(spans[1].data, 9, spans[1].nWords * WORDSIZE);
+    ASSERT_EQ(writer->commit(3), 3);
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT), 3);
+    ASSERT_EQ(readBuf[0], 8);
+    ASSERT_EQ(readBuf[2 * WORDSIZE], 9);
+
+    // Verify an all-or-nothing writer can't reserve over unconsumed data, and that commit(0) cancels a
+    // reservation.
+    ASSERT_EQ(writer->reserve(WORDCOUNT + 1, spans), Sds::Writer::Error::WOULDBLOCK);
+    ASSERT_EQ(writer->reserve(WORDCOUNT, spans), static_cast<ssize_t>(WORDCOUNT));
+    ASSERT_EQ(writer->commit(0), 0);
+    ASSERT_EQ(writer->tell(), 5U);
+}
+
+/// This tests @c SharedDataStream::Reader::peek() and @c SharedDataStream::Reader::advance().
+TEST_F(SharedDataStreamTest, readerPeekAdvance) {
+    static const size_t WORDSIZE = 1;
+    static const size_t WORDCOUNT = 4;
+    static const size_t MAXREADERS = 1;
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    // Verify bad parameter handling.
+    Sds::Reader::Span spans[2];
+    ASSERT_EQ(reader->peek(WORDCOUNT, nullptr), Sds::Reader::Error::INVALID);
+    ASSERT_EQ(reader->peek(0, spans), Sds::Reader::Error::INVALID);
+    ASSERT_EQ(reader->peek(WORDCOUNT, spans), Sds::Reader::Error::WOULDBLOCK);
+    ASSERT_EQ(reader->advance(1), Sds::Reader::Error::INVALID);
+
+    // Verify peeked data is returned in place and is not consumed until advance().
+    const uint8_t first[] = {1, 2, 3};
+    ASSERT_EQ(writer->write(first, sizeof(first)), static_cast<ssize_t>(sizeof(first)));
+    ASSERT_EQ(reader->peek(WORDCOUNT, spans), 3);
+    ASSERT_EQ(spans[0].nWords, 3U);
+    ASSERT_EQ(spans[1].nWords, 0U);
+    ASSERT_EQ(static_cast<const uint8_t*>(spans[0].data)[0], 1);
+    ASSERT_EQ(reader->advance(4), Sds::Reader::Error::INVALID);
+    ASSERT_EQ(reader->advance(1), 1);
+    ASSERT_EQ(reader->tell(), 1U);
+
+    // Verify data which wraps is returned as two spans.
+    const uint8_t second[] = {4, 5};
+    ASSERT_EQ(writer->write(second, sizeof(second)), static_cast<ssize_t>(sizeof(second)));
+    ASSERT_EQ(reader->peek(WORDCOUNT, spans), 4);
+    ASSERT_EQ(spans[0].nWords, 3U);
+    ASSERT_EQ(spans[1].nWords, 1U);
+    ASSERT_EQ(static_cast<const uint8_t*>(spans[0].data)[0], 2);
+    ASSERT_EQ(static_cast<const uint8_t*>(spans[1].data)[0], 5);
+
+    // Verify overwriting peeked data is reported by advance().
+    const uint8_t third[] = {6, 7};
+    ASSERT_EQ(writer->write(third, sizeof(third)), static_cast<ssize_t>(sizeof(third)));
+    ASSERT_EQ(reader->advance(4), Sds::Reader::Error::OVERRUN);
+}
+
+/// This tests @c SharedDataStream::Reader::setWakeupThreshold(), and that @c Writer::close() wakes blocked readers.
+TEST_F(SharedDataStreamTest, readerWakeupThreshold) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 8;
+    static const size_t MAXREADERS = 1;
+    static const size_t THRESHOLD = 4;
+    static const std::chrono::milliseconds SHORT_TIMEOUT{10};
+    static const std::chrono::seconds LONG_TIMEOUT{2};
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    std::shared_ptr<Sds::Reader> reader = sds->createReader(Sds::Reader::Policy::BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    reader->setWakeupThreshold(THRESHOLD);
+
+    // Verify a blocked reader is not woken until the threshold is available.
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    uint8_t readBuf[WORDSIZE * WORDCOUNT];
+    auto numRead = std::async([reader, &readBuf]() { return reader->read(readBuf, WORDCOUNT, LONG_TIMEOUT); });
+    ASSERT_EQ(writer->write(writeBuf, THRESHOLD - 1), static_cast<ssize_t>(THRESHOLD - 1));
+    ASSERT_EQ(numRead.wait_for(SHORT_TIMEOUT), std::future_status::timeout);
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    ASSERT_EQ(numRead.get(), static_cast<ssize_t>(THRESHOLD));
+
+    // Verify a read never waits for more than was requested.
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    ASSERT_EQ(reader->read(readBuf, 1, SHORT_TIMEOUT), 1);
+
+    // Verify a read which times out returns the partial data.
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT, SHORT_TIMEOUT), 1);
+
+    // Verify closing the writer wakes a blocked reader with the remaining data, then reports the stream closed.
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    numRead = std::async([reader, &readBuf]() { return reader->read(readBuf, WORDCOUNT, LONG_TIMEOUT); });
+    ASSERT_EQ(numRead.wait_for(SHORT_TIMEOUT), std::future_status::timeout);
+    writer->close();
+    ASSERT_EQ(numRead.get(), 1);
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT, LONG_TIMEOUT), Sds::Reader::Error::CLOSED);
+}
+
+/// This tests that the times of writes can be looked up through a @c Writer and a @c Reader.
+TEST_F(SharedDataStreamTest, indexTimestamps) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 8;
+    static const size_t MAXREADERS = 1;
+    static const std::chrono::milliseconds WRITE_PERIOD{10};
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    // Verify nothing is known before the first write.
+    std::chrono::steady_clock::time_point time;
+    Sds::Index index;
+    EXPECT_FALSE(reader->getTimeOfIndex(0, &time));
+
+    // Write twice, recording when each write happened.
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    auto beforeFirst = std::chrono::steady_clock::now();
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    auto afterFirst = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(WRITE_PERIOD);
+    auto beforeSecond = std::chrono::steady_clock::now();
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    auto afterSecond = std::chrono::steady_clock::now();
+
+    // Verify the first word of each write maps to the time of the write, through either end of the stream.
+    ASSERT_TRUE(reader->getTimeOfIndex(0, &time));
+    EXPECT_GE(time, beforeFirst);
+    EXPECT_LE(time, afterFirst);
+    ASSERT_TRUE(writer->getTimeOfIndex(2, &time));
+    EXPECT_GE(time, beforeSecond);
+    EXPECT_LE(time, afterSecond);
+
+    // Verify the time of a write maps back to its first word.
+    ASSERT_TRUE(reader->getTimeOfIndex(2, &time));
+    ASSERT_TRUE(reader->getIndexAtTime(time, &index));
+    EXPECT_EQ(index, 2u);
+    ASSERT_TRUE(writer->getIndexAtTime(afterFirst, &index));
+    EXPECT_LT(index, 2u);
+    EXPECT_FALSE(writer->getIndexAtTime(beforeFirst - WRITE_PERIOD, &index));
+}
+
+/// This tests that a @c Reader's data available callback is called when a @c Writer commits data and closes.
+TEST_F(SharedDataStreamTest, readerDataAvailableCallback) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 8;
+    static const size_t MAXREADERS = 1;
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    // Verify each commit, and closing the writer, calls the callback.
+    size_t numCalls = 0;
+    reader->setDataAvailableCallback([&numCalls]() { ++numCalls; });
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    EXPECT_EQ(numCalls, 2u);
+
+    // Verify an empty commit does not call the callback.
+    Sds::Writer::Span spans[2];
+    ASSERT_EQ(writer->reserve(2, spans), 2);
+    ASSERT_EQ(writer->commit(0), 0);
+    EXPECT_EQ(numCalls, 2u);
+
+    // Verify a removed callback is not called.
+    reader->setDataAvailableCallback(nullptr);
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    EXPECT_EQ(numCalls, 2u);
+
+    // Verify a callback is called when the writer closes, and not once the reader has been destroyed.
+    reader->setDataAvailableCallback([&numCalls]() { ++numCalls; });
+    writer->close();
+    EXPECT_EQ(numCalls, 3u);
+    reader.reset();
+    writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE, true);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    EXPECT_EQ(numCalls, 3u);
+}
+
 /// This tests a nonblockable, slow @c Writer streaming concurrently to two fast @c Readers (one of each type).
 TEST_F(SharedDataStreamTest, concurrencyNonblockableWriterDualReader) {
     static const size_t WORDSIZE = 2;
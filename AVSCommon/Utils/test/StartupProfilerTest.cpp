@@ -0,0 +1,81 @@
+/*
+ * StartupProfilerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file StartupProfilerTest.cpp
+
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Metrics/StartupProfiler.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+namespace test {
+
+/// How long the stages of the tests take.
+static const std::chrono::milliseconds STAGE_DURATION(50);
+
+/**
+ * Verify that a stage is recorded with its duration, and that its result is passed through.
+ */
+TEST(StartupProfilerTest, timesStage) {
+    StartupProfiler profiler("test");
+    ASSERT_TRUE(profiler.getStages().empty());
+
+    auto result = profiler.time("sleep", []() {
+        std::this_thread::sleep_for(STAGE_DURATION);
+        return 42;
+    });
+    ASSERT_EQ(result, 42);
+
+    auto stages = profiler.getStages();
+    ASSERT_EQ(stages.size(), 1u);
+    ASSERT_EQ(stages[0].name, "sleep");
+    ASSERT_GE(stages[0].duration, STAGE_DURATION);
+    ASSERT_GE(profiler.getElapsed(), stages[0].startOffset + stages[0].duration);
+    profiler.log();
+}
+
+/**
+ * Verify that stages run on several threads at once are all recorded.
+ */
+TEST(StartupProfilerTest, timesConcurrentStages) {
+    StartupProfiler profiler("test");
+    auto stage = [&profiler](const std::string& name) {
+        profiler.time(name, []() { std::this_thread::sleep_for(STAGE_DURATION); });
+    };
+    auto first = std::async(std::launch::async, stage, "first");
+    auto second = std::async(std::launch::async, stage, "second");
+    first.get();
+    second.get();
+
+    auto stages = profiler.getStages();
+    ASSERT_EQ(stages.size(), 2u);
+    for (auto& recorded : stages) {
+        ASSERT_GE(recorded.duration, STAGE_DURATION);
+    }
+}
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -15,6 +15,10 @@
  * permissions and limitations under the License.
  */
 
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "ExecutorTestUtils.h"
@@ -279,6 +283,105 @@ TEST_F(TaskQueueTest, pushFailsToEnqueueANewTaskOnAShutdownQueue) {
     ASSERT_EQ(retrievedTask, nullptr);
 }
 
+TEST_F(TaskQueueTest, pushToFrontRunsNewestFirstAheadOfBack) {
+    auto futureOne = queue.push(TASK, 1);
+    auto futureTwo = queue.pushToFront(TASK, 2);
+    auto futureThree = queue.pushToFront(TASK, 3);
+
+    for (auto future : {&futureThree, &futureTwo, &futureOne}) {
+        auto task = queue.tryPop();
+        ASSERT_NE(task, nullptr);
+        task->operator()();
+        ASSERT_EQ(future->wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    }
+    ASSERT_EQ(queue.tryPop(), nullptr);
+    ASSERT_EQ(futureOne.get(), 1);
+    ASSERT_EQ(futureTwo.get(), 2);
+    ASSERT_EQ(futureThree.get(), 3);
+}
+
+TEST_F(TaskQueueTest, pushWithPriorityRunsHigherPrioritiesFirst) {
+    auto futureLow = queue.pushWithPriority(TaskQueue::Priority::LOW, TASK, 1);
+    auto futureNormal = queue.push(TASK, 2);
+    auto futureHigh = queue.pushWithPriority(TaskQueue::Priority::HIGH, TASK, 3);
+    auto futureFront = queue.pushToFront(TASK, 4);
+    auto futureHighToo = queue.pushWithPriority(TaskQueue::Priority::HIGH, TASK, 5);
+
+    for (auto future : {&futureFront, &futureHigh, &futureHighToo, &futureNormal, &futureLow}) {
+        auto task = queue.tryPop();
+        ASSERT_NE(task, nullptr);
+        task->operator()();
+        ASSERT_EQ(future->wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    }
+    ASSERT_EQ(queue.tryPop(), nullptr);
+    ASSERT_EQ(futureLow.get(), 1);
+    ASSERT_EQ(futureHighToo.get(), 5);
+}
+
+TEST_F(TaskQueueTest, popWithSpinningStillBlocksAndWakes) {
+    queue.setMaxSpin(std::chrono::microseconds(100));
+    testQueueBlocksWhenEmpty();
+}
+
+TEST_F(TaskQueueTest, tryPopReturnsNullOnEmptyQueue) {
+    ASSERT_EQ(queue.tryPop(), nullptr);
+}
+
+TEST_F(TaskQueueTest, exceptionIsForwardedToFuture) {
+    auto future = queue.push([]() -> int { throw std::runtime_error("failed"); });
+    auto task = queue.pop();
+    task->operator()();
+    ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+TEST_F(TaskQueueTest, referenceIsForwardedToFuture) {
+    int value = VALUE;
+    auto future = queue.push([&value]() -> int& { return value; });
+    auto task = queue.pop();
+    task->operator()();
+    ASSERT_EQ(&future.get(), &value);
+}
+
+TEST_F(TaskQueueTest, droppedTaskBreaksItsPromise) {
+    auto future = queue.push(TASK, VALUE);
+    queue.shutdown();
+    ASSERT_EQ(future.wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    ASSERT_THROW(future.get(), std::future_error);
+}
+
+TEST_F(TaskQueueTest, preservesOrderFromEachOfManyProducers) {
+    const int numProducers = 4;
+    const int tasksPerProducer = 1000;
+
+    // Tasks are only run by this thread, so they may record their index without locking.
+    std::vector<int> lastSeen(numProducers, -1);
+    bool inOrder = true;
+    auto record = [&lastSeen, &inOrder](int producer, int index) {
+        inOrder = inOrder && index == lastSeen[producer] + 1;
+        lastSeen[producer] = index;
+    };
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < numProducers; ++producer) {
+        producers.emplace_back([this, producer, record] {
+            for (int i = 0; i < tasksPerProducer; ++i) {
+                queue.push(record, producer, i);
+            }
+        });
+    }
+
+    for (int count = 0; count < numProducers * tasksPerProducer; ++count) {
+        auto task = queue.pop();
+        ASSERT_NE(task, nullptr);
+        task->operator()();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ASSERT_EQ(queue.tryPop(), nullptr);
+    ASSERT_TRUE(inOrder);
+}
+
 }  // namespace test
 }  // namespace threading
 }  // namespace utils
@@ -0,0 +1,142 @@
+/*
+ * ThreadCpuMonitorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ThreadCpuMonitorTest.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Metrics/ThreadCpuMonitor.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace metrics {
+namespace test {
+
+using namespace avsCommon::utils::threading;
+
+/// The contents of a stat file, whose thread name has spaces and parentheses, and which used 12 and 34 ticks.
+static const std::string STAT =
+    "1234 (acsdk (task) 1) S 1 1234 1234 0 -1 4194368 100 0 0 0 12 34 0 0 20 0 1 0 5 0 0 18446744073709551615";
+
+/// The contents of a status file.
+static const std::string STATUS =
+    "Name:\tacsdk-task\nState:\tS (sleeping)\nvoluntary_ctxt_switches:\t56\nnonvoluntary_ctxt_switches:\t7\n";
+
+/**
+ * Build the sample of a thread.
+ *
+ * @param tid The id of the thread.
+ * @param name The name of the thread.
+ * @param cpuMs The CPU time of the thread, in milliseconds.
+ * @param switches The number of voluntary and of involuntary context switches of the thread.
+ * @return The sample.
+ */
+static ThreadCpuMonitor::ThreadSample makeSample(int tid, const std::string& name, int cpuMs, uint64_t switches) {
+    return {{tid, ThreadRole::BACKGROUND, name}, std::chrono::milliseconds(cpuMs), switches, switches};
+}
+
+/**
+ * Verify that the CPU time is read from a stat file, even if the name of the thread has spaces and parentheses.
+ */
+TEST(ThreadCpuMonitorTest, parseStat) {
+    uint64_t ticks = 0;
+    ASSERT_TRUE(ThreadCpuMonitor::parseStat(STAT, &ticks));
+    EXPECT_EQ(ticks, 46u);
+    EXPECT_FALSE(ThreadCpuMonitor::parseStat("1234 (acsdk-task) S 1 2", &ticks));
+    EXPECT_FALSE(ThreadCpuMonitor::parseStat("", &ticks));
+    EXPECT_FALSE(ThreadCpuMonitor::parseStat(STAT, nullptr));
+}
+
+/**
+ * Verify that the context switches are read from a status file.
+ */
+TEST(ThreadCpuMonitorTest, parseStatus) {
+    uint64_t voluntary = 0;
+    uint64_t involuntary = 0;
+    ASSERT_TRUE(ThreadCpuMonitor::parseStatus(STATUS, &voluntary, &involuntary));
+    EXPECT_EQ(voluntary, 56u);
+    EXPECT_EQ(involuntary, 7u);
+    EXPECT_FALSE(ThreadCpuMonitor::parseStatus("Name:\tacsdk-task\n", &voluntary, &involuntary));
+}
+
+/**
+ * Verify that the usage of threads of the same name is summed and sorted, that a new thread is counted from zero, and
+ * that a thread which exited is not counted.
+ */
+TEST(ThreadCpuMonitorTest, getUsage) {
+    std::vector<ThreadCpuMonitor::ThreadSample> previous = {
+        makeSample(1, "acsdk-task", 100, 10), makeSample(2, "acsdk-timer", 10, 1), makeSample(3, "acsdk-task", 5, 1)};
+    std::vector<ThreadCpuMonitor::ThreadSample> current = {
+        makeSample(1, "acsdk-task", 130, 15), makeSample(2, "acsdk-timer", 60, 4), makeSample(4, "acsdk-task", 20, 2)};
+    auto usages = ThreadCpuMonitor::getUsage(previous, current);
+    ASSERT_EQ(usages.size(), 2u);
+    EXPECT_EQ(usages[0].name, "acsdk-task");
+    EXPECT_EQ(usages[0].numThreads, 2u);
+    EXPECT_EQ(usages[0].cpuTime.count(), 50);
+    EXPECT_EQ(usages[0].voluntaryContextSwitches, 7u);
+    EXPECT_EQ(usages[0].involuntaryContextSwitches, 7u);
+    EXPECT_EQ(usages[1].name, "acsdk-timer");
+    EXPECT_EQ(usages[1].numThreads, 1u);
+    EXPECT_EQ(usages[1].cpuTime.count(), 50);
+    EXPECT_EQ(usages[1].voluntaryContextSwitches, 3u);
+}
+
+#ifdef __linux__
+/**
+ * Verify that a thread created by @c ThreadFactory is sampled while it runs, and not after it exits.
+ */
+TEST(ThreadCpuMonitorTest, sampleFactoryThread) {
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future();
+    auto thread = ThreadFactory::createThread(ThreadRole::BACKGROUND, "test-sampled", [&started, &releaseFuture]() {
+        started.set_value();
+        releaseFuture.wait();
+    });
+    started.get_future().wait();
+
+    auto hasThread = [](const std::vector<ThreadCpuMonitor::ThreadSample>& samples) {
+        return std::any_of(samples.begin(), samples.end(), [](const ThreadCpuMonitor::ThreadSample& sample) {
+            return "test-sampled" == sample.thread.name && ThreadRole::BACKGROUND == sample.thread.role;
+        });
+    };
+    EXPECT_TRUE(hasThread(ThreadCpuMonitor::sampleThreads()));
+    release.set_value();
+    thread.join();
+    EXPECT_FALSE(hasThread(ThreadCpuMonitor::sampleThreads()));
+}
+
+/**
+ * Verify that a monitor can not be created with a period which is not positive.
+ */
+TEST(ThreadCpuMonitorTest, createWithInvalidPeriod) {
+    EXPECT_FALSE(ThreadCpuMonitor::create(std::chrono::milliseconds(0)));
+    EXPECT_TRUE(ThreadCpuMonitor::create(std::chrono::milliseconds(100)));
+}
+#endif
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,120 @@
+/*
+ * ThreadFactoryTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ThreadFactoryTest.cpp
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Configuration/ConfigurationNode.h"
+#include "AVSCommon/Utils/Threading/ThreadFactory.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+namespace test {
+
+using namespace avsCommon::utils::configuration;
+
+/// A configuration giving background threads a nice value, which any thread may raise.
+static const std::string CONFIGURATION = R"({
+    "threadPolicy": {
+        "background": {"cpus": "0", "nice": 5},
+        "network": {"cpus": "0-1,x", "schedFifoPriority": 10}
+    }
+})";
+
+/// Test harness for @c ThreadFactory class.
+class ThreadFactoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::istringstream configuration(CONFIGURATION);
+        ASSERT_TRUE(ConfigurationNode::initialize({&configuration}));
+    }
+
+    void TearDown() override {
+        ConfigurationNode::uninitialize();
+    }
+};
+
+/// Verify that lists of CPUs are parsed, and invalid ones rejected.
+TEST_F(ThreadFactoryTest, parseCpuList) {
+    std::vector<int> cpus;
+    ASSERT_TRUE(ThreadFactory::parseCpuList("0,2-4, 7", &cpus));
+    EXPECT_EQ(cpus, std::vector<int>({0, 2, 3, 4, 7}));
+    EXPECT_FALSE(ThreadFactory::parseCpuList("", &cpus));
+    EXPECT_FALSE(ThreadFactory::parseCpuList("3-1", &cpus));
+    EXPECT_FALSE(ThreadFactory::parseCpuList("1-", &cpus));
+    EXPECT_FALSE(ThreadFactory::parseCpuList("-1", &cpus));
+    EXPECT_FALSE(ThreadFactory::parseCpuList("1 2", &cpus));
+}
+
+/// Verify that the policies of the roles are read from the configuration.
+TEST_F(ThreadFactoryTest, getPolicy) {
+    auto policy = ThreadFactory::getPolicy(ThreadRole::BACKGROUND);
+    EXPECT_EQ(policy.cpus, std::vector<int>({0}));
+    EXPECT_EQ(policy.schedFifoPriority, 0);
+    EXPECT_TRUE(policy.hasNice);
+    EXPECT_EQ(policy.nice, 5);
+
+    policy = ThreadFactory::getPolicy(ThreadRole::NETWORK);
+    EXPECT_TRUE(policy.cpus.empty());
+    EXPECT_EQ(policy.schedFifoPriority, 10);
+    EXPECT_FALSE(policy.hasNice);
+
+    policy = ThreadFactory::getPolicy(ThreadRole::AUDIO_CAPTURE);
+    EXPECT_TRUE(policy.cpus.empty());
+    EXPECT_EQ(policy.schedFifoPriority, 0);
+    EXPECT_FALSE(policy.hasNice);
+}
+
+/// Verify that a created thread runs its function with the name and policy of its role.
+TEST_F(ThreadFactoryTest, createThread) {
+    bool hasRun = false;
+    std::string name;
+    int nice = 0;
+    auto thread = ThreadFactory::createThread(ThreadRole::BACKGROUND, "test-background-thread", [&]() {
+        hasRun = true;
+#ifdef __linux__
+        char buffer[16] = {};
+        pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+        name = buffer;
+        nice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+#endif
+    });
+    thread.join();
+    EXPECT_TRUE(hasRun);
+#ifdef __linux__
+    EXPECT_EQ(name, "test-background");
+    EXPECT_GE(nice, 5);
+#endif
+}
+
+}  // namespace test
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,99 @@
+/*
+ * ThreadPoolTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ThreadPoolTest.cpp
+
+#include <atomic>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+namespace test {
+
+/// The number of workers in the pool under test.
+static const size_t NUM_THREADS = 2;
+
+/// Used to limit the amount of time tests will wait for an operation to finish.
+static const auto TIMEOUT = std::chrono::seconds(1);
+
+/// Test harness for @c ThreadPool class.
+class ThreadPoolTest : public ::testing::Test {
+protected:
+    /// Constructor.
+    ThreadPoolTest() : m_pool{NUM_THREADS} {
+    }
+
+    /// The pool under test.
+    ThreadPool m_pool;
+};
+
+/// Verify that submitted jobs are run on worker threads.
+TEST_F(ThreadPoolTest, runsJobsOnWorkers) {
+    ASSERT_EQ(m_pool.getNumThreads(), NUM_THREADS);
+    ASSERT_FALSE(m_pool.isWorkerThread());
+    std::promise<bool> resultPromise;
+    ASSERT_TRUE(m_pool.submit([&] { resultPromise.set_value(m_pool.isWorkerThread()); }));
+    auto resultFuture = resultPromise.get_future();
+    ASSERT_EQ(resultFuture.wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_TRUE(resultFuture.get());
+}
+
+/// Verify that jobs run concurrently on different workers.
+TEST_F(ThreadPoolTest, runsJobsConcurrently) {
+    std::promise<void> firstStarted;
+    std::promise<void> secondStarted;
+    auto secondStartedFuture = secondStarted.get_future().share();
+    ASSERT_TRUE(m_pool.submit([&] {
+        firstStarted.set_value();
+        secondStartedFuture.wait_for(TIMEOUT);
+    }));
+    ASSERT_TRUE(m_pool.submit([&] { secondStarted.set_value(); }));
+    ASSERT_EQ(firstStarted.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_EQ(secondStartedFuture.wait_for(TIMEOUT), std::future_status::ready);
+}
+
+/// Verify that shutdown waits for running jobs and refuses new ones.
+TEST_F(ThreadPoolTest, shutdown) {
+    std::promise<void> startedPromise;
+    std::atomic<bool> isFinished(false);
+    ASSERT_TRUE(m_pool.submit([&] {
+        startedPromise.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        isFinished = true;
+    }));
+    ASSERT_EQ(startedPromise.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    m_pool.shutdown();
+    ASSERT_TRUE(isFinished);
+    ASSERT_FALSE(m_pool.submit([] {}));
+}
+
+/// Verify that a null job is rejected.
+TEST_F(ThreadPoolTest, submitNullJob) {
+    ASSERT_FALSE(m_pool.submit(nullptr));
+}
+
+}  // namespace test
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,87 @@
+/*
+ * TimeUtilsTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <ctime>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Timing/TimeUtils.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/**
+ * Verify that times in UTC are converted to the expected Unix times.
+ */
+TEST(TimeUtilsTest, convertUtcTimes) {
+    int64_t unixTime = 0;
+    ASSERT_TRUE(convert8601TimeStringToUnix("1970-01-01T00:00:00+0000", &unixTime));
+    EXPECT_EQ(unixTime, 0);
+    ASSERT_TRUE(convert8601TimeStringToUnix("1986-08-08T21:30:00+0000", &unixTime));
+    EXPECT_EQ(unixTime, 523920600);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2000-02-29T12:00:00+0000", &unixTime));
+    EXPECT_EQ(unixTime, 951825600);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2038-01-19T03:14:08+0000", &unixTime));
+    EXPECT_EQ(unixTime, 2147483648);
+}
+
+/**
+ * Verify that the offset from UTC is applied.
+ */
+TEST(TimeUtilsTest, convertTimesWithUtcOffset) {
+    int64_t unixTime = 0;
+    ASSERT_TRUE(convert8601TimeStringToUnix("1970-01-01T01:30:00+0130", &unixTime));
+    EXPECT_EQ(unixTime, 0);
+    ASSERT_TRUE(convert8601TimeStringToUnix("1969-12-31T16:00:00-0800", &unixTime));
+    EXPECT_EQ(unixTime, 0);
+}
+
+/**
+ * Verify that malformed strings and dates which do not exist are rejected.
+ */
+TEST(TimeUtilsTest, convertInvalidTimes) {
+    int64_t unixTime = 0;
+    EXPECT_FALSE(convert8601TimeStringToUnix("1986-8-8T21:30:00+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix("1986-08-08 21:30:00+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix("1986-08-08T21:30:0a+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix("1986-13-08T21:30:00+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix("2017-02-29T21:30:00+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix("1986-08-08T24:30:00+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix("1986-08-08T21:30:00+0000", nullptr));
+}
+
+/**
+ * Verify that the current time matches the C library's.
+ */
+TEST(TimeUtilsTest, currentUnixTime) {
+    int64_t before = static_cast<int64_t>(std::time(nullptr));
+    int64_t now = 0;
+    ASSERT_TRUE(getCurrentUnixTime(&now));
+    int64_t after = static_cast<int64_t>(std::time(nullptr));
+    EXPECT_GE(now, before);
+    EXPECT_LE(now, after);
+    EXPECT_FALSE(getCurrentUnixTime(nullptr));
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,114 @@
+/*
+ * TimerServiceTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file TimerServiceTest.cpp
+
+#include <future>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Timing/TimerService.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/// A short delay used to schedule tasks in the near future.
+static const auto SHORT_DELAY = std::chrono::milliseconds(20);
+
+/// Used to limit the amount of time tests will wait for an operation to finish.
+static const auto TIMEOUT = std::chrono::seconds(1);
+
+/// Test harness for @c TimerService class.
+class TimerServiceTest : public ::testing::Test {
+protected:
+    /// The service under test.
+    TimerService m_service;
+};
+
+/// Verify that tasks are called in due time order, regardless of the order in which they were scheduled.
+TEST_F(TimerServiceTest, callsInDueTimeOrder) {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> donePromise;
+    auto now = TimerService::Clock::now();
+    auto record = [&](int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(value);
+    };
+    m_service.schedule(now + SHORT_DELAY * 3, [&] {
+        record(3);
+        donePromise.set_value();
+    });
+    m_service.schedule(now + SHORT_DELAY, [&] { record(1); });
+    m_service.schedule(now + SHORT_DELAY * 2, [&] { record(2); });
+    ASSERT_EQ(donePromise.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(order, std::vector<int>({1, 2, 3}));
+}
+
+/// Verify that a cancelled task is never called.
+TEST_F(TimerServiceTest, cancelBeforeDue) {
+    std::atomic<bool> wasCalled(false);
+    std::promise<void> donePromise;
+    auto now = TimerService::Clock::now();
+    auto id = m_service.schedule(now + SHORT_DELAY, [&] { wasCalled = true; });
+    ASSERT_NE(id, TimerService::INVALID_ID);
+    m_service.schedule(now + SHORT_DELAY * 2, [&] { donePromise.set_value(); });
+    ASSERT_TRUE(m_service.cancel(id));
+    ASSERT_FALSE(m_service.cancel(id));
+    ASSERT_EQ(donePromise.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_FALSE(wasCalled);
+}
+
+/// Verify that cancelling a task which is running blocks until the task completes.
+TEST_F(TimerServiceTest, cancelWhileRunningBlocks) {
+    std::promise<void> startedPromise;
+    std::atomic<bool> isFinished(false);
+    auto id = m_service.schedule(TimerService::Clock::now(), [&] {
+        startedPromise.set_value();
+        std::this_thread::sleep_for(SHORT_DELAY);
+        isFinished = true;
+    });
+    ASSERT_EQ(startedPromise.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_FALSE(m_service.cancel(id));
+    ASSERT_TRUE(isFinished);
+}
+
+/// Verify that tasks run on the service thread.
+TEST_F(TimerServiceTest, isServiceThread) {
+    ASSERT_FALSE(m_service.isServiceThread());
+    std::promise<bool> resultPromise;
+    m_service.schedule(TimerService::Clock::now(), [&] { resultPromise.set_value(m_service.isServiceThread()); });
+    auto resultFuture = resultPromise.get_future();
+    ASSERT_EQ(resultFuture.wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_TRUE(resultFuture.get());
+}
+
+/// Verify that a null task is rejected.
+TEST_F(TimerServiceTest, scheduleNullTask) {
+    ASSERT_EQ(m_service.schedule(TimerService::Clock::now(), nullptr), TimerService::INVALID_ID);
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
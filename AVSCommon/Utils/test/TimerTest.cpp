@@ -439,7 +439,129 @@ TEST_F(TimerTest, deleteDuringTask) {
     verifyTimestamps(t0, SHORT_DELAY, SHORT_DELAY, Timer::PeriodType::ABSOLUTE, SHORT_DELAY);
 }
 
-/// This test verifies that
+/// Test harness for @c Timer instances which are backed by a @c TimerService.
+class TimerServiceBackedTimerTest : public TimerTest {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+};
+
+void TimerServiceBackedTimerTest::SetUp() {
+    m_timer = std::unique_ptr<Timer>(new Timer(std::make_shared<TimerService>()));
+}
+
+/// This test runs a single-shot timer on a @c TimerService and verifies that the task is called once, on time.
+TEST_F(TimerServiceBackedTimerTest, singleShot) {
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_EQ(
+        m_timer->start(SHORT_DELAY, std::bind(&TimerTest::simpleTask, this, NO_DELAY)).wait_for(TIMEOUT),
+        std::future_status::ready);
+    ASSERT_TRUE(waitForInactive());
+    verifyTimestamps(t0, SHORT_DELAY, SHORT_DELAY, Timer::PeriodType::ABSOLUTE, NO_DELAY);
+}
+
+/// This test runs a multi-shot ABSOLUTE timer on a @c TimerService and verifies the number and times of calls.
+TEST_F(TimerServiceBackedTimerTest, multiShotWithDelay) {
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_timer->start(
+        MEDIUM_DELAY,
+        SHORT_DELAY,
+        Timer::PeriodType::ABSOLUTE,
+        ITERATIONS,
+        std::bind(&TimerTest::simpleTask, this, NO_DELAY)));
+    ASSERT_TRUE(m_timer->isActive());
+    verifyTimestamps(t0, MEDIUM_DELAY, SHORT_DELAY, Timer::PeriodType::ABSOLUTE, NO_DELAY, ITERATIONS);
+    ASSERT_TRUE(waitForInactive());
+}
+
+/// This test verifies that a slow task on a @c TimerService backed ABSOLUTE timer skips calls on a consistent period.
+TEST_F(TimerServiceBackedTimerTest, slowTaskGreaterThanPeriod) {
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_timer->start(
+        SHORT_DELAY, Timer::PeriodType::ABSOLUTE, ITERATIONS, std::bind(&TimerTest::simpleTask, this, MEDIUM_DELAY)));
+    ASSERT_TRUE(m_timer->isActive());
+    verifyTimestamps(t0, SHORT_DELAY, SHORT_DELAY, Timer::PeriodType::ABSOLUTE, MEDIUM_DELAY, ITERATIONS);
+}
+
+/// This test verifies that a slow task on a @c TimerService backed RELATIVE timer keeps a consistent idle time.
+TEST_F(TimerServiceBackedTimerTest, endToStartPeriod) {
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_timer->start(
+        SHORT_DELAY, Timer::PeriodType::RELATIVE, ITERATIONS, std::bind(&TimerTest::simpleTask, this, MEDIUM_DELAY)));
+    ASSERT_TRUE(m_timer->isActive());
+    verifyTimestamps(t0, SHORT_DELAY, SHORT_DELAY, Timer::PeriodType::RELATIVE, MEDIUM_DELAY, ITERATIONS);
+}
+
+/// This test verifies that stop() before the task is called leaves a @c TimerService backed timer inactive.
+TEST_F(TimerServiceBackedTimerTest, stopSingleShotBeforeTask) {
+    ASSERT_TRUE(m_timer->start(MEDIUM_DELAY, std::bind(&TimerTest::simpleTask, this, NO_DELAY)).valid());
+    ASSERT_TRUE(m_timer->isActive());
+    m_timer->stop();
+    ASSERT_FALSE(m_timer->isActive());
+    std::this_thread::sleep_for(LONG_DELAY);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ASSERT_TRUE(m_timestamps.empty());
+    }
+}
+
+/// This test verifies that stop() blocks until a task in progress on a @c TimerService completes.
+TEST_F(TimerServiceBackedTimerTest, stopMultiShotDuringTask) {
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_timer->start(
+        SHORT_DELAY, Timer::PeriodType::RELATIVE, Timer::FOREVER, std::bind(&TimerTest::simpleTask, this, SHORT_DELAY)));
+    verifyTimestamps(t0, SHORT_DELAY, SHORT_DELAY, Timer::PeriodType::RELATIVE, SHORT_DELAY);
+    m_timer->stop();
+    ASSERT_FALSE(m_timer->isActive());
+    std::this_thread::sleep_for(LONG_DELAY);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ASSERT_EQ(m_timestamps.size(), 1U);
+}
+
+/// This test verifies that a @c TimerService backed timer may be stopped from inside its own task.
+TEST_F(TimerServiceBackedTimerTest, stopFromTask) {
+    ASSERT_TRUE(m_timer->start(SHORT_DELAY, Timer::PeriodType::ABSOLUTE, Timer::FOREVER, [this] {
+        simpleTask(NO_DELAY);
+        m_timer->stop();
+    }));
+    ASSERT_TRUE(waitForInactive());
+    std::this_thread::sleep_for(LONG_DELAY);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ASSERT_EQ(m_timestamps.size(), 1U);
+}
+
+/// This test verifies that several timers can share one @c TimerService, and that each is called at the expected time.
+TEST_F(TimerServiceBackedTimerTest, sharedService) {
+    auto service = std::make_shared<TimerService>();
+    Timer mediumTimer(service);
+    Timer shortTimer(service);
+    auto t0 = std::chrono::steady_clock::now();
+    auto mediumFuture = mediumTimer.start(MEDIUM_DELAY, [] { return std::chrono::steady_clock::now(); });
+    auto shortFuture = shortTimer.start(SHORT_DELAY, [] { return std::chrono::steady_clock::now(); });
+    ASSERT_EQ(mediumFuture.wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_EQ(shortFuture.wait_for(TIMEOUT), std::future_status::ready);
+    auto mediumElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(mediumFuture.get() - t0);
+    auto shortElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(shortFuture.get() - t0);
+    EXPECT_GE(shortElapsed, SHORT_DELAY);
+    EXPECT_LE(shortElapsed, SHORT_DELAY + ACCURACY);
+    EXPECT_GE(mediumElapsed, MEDIUM_DELAY);
+    EXPECT_LE(mediumElapsed, MEDIUM_DELAY + ACCURACY);
+}
+
+/// This test verifies that timers constructed by default are backed by the default @c TimerService, when one is set.
+TEST_F(TimerServiceBackedTimerTest, defaultTimerService) {
+    auto service = std::make_shared<TimerService>();
+    Timer::setDefaultTimerService(service);
+    Timer serviceTimer;
+    Timer::setDefaultTimerService(nullptr);
+    Timer ownThreadTimer;
+    auto serviceFuture = serviceTimer.start(SHORT_DELAY, [service] { return service->isServiceThread(); });
+    auto ownThreadFuture = ownThreadTimer.start(SHORT_DELAY, [service] { return service->isServiceThread(); });
+    ASSERT_EQ(serviceFuture.wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_EQ(ownThreadFuture.wait_for(TIMEOUT), std::future_status::ready);
+    EXPECT_TRUE(serviceFuture.get());
+    EXPECT_FALSE(ownThreadFuture.get());
+}
 
 }  // namespace test
 }  // namespace timing
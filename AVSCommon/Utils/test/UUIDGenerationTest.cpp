@@ -122,6 +122,21 @@ TEST_F(UUIDGenerationTest, testUUIDHyphens) {
     ASSERT_EQ(HYPHEN, uuid.substr(HYPHEN4_POSITION, 1));
 }
 
+/**
+ * Call the buffer overload of @c generateUUID and check that it writes a null terminated UUID.
+ */
+TEST_F(UUIDGenerationTest, testUUIDIntoBuffer) {
+    char buffer[UUID_BUFFER_SIZE];
+    generateUUID(buffer);
+    std::string uuid(buffer);
+    ASSERT_EQ(UUID_LENGTH, uuid.length());
+    ASSERT_EQ(UUID_VERSION, uuid.substr(UUID_VERSION_OFFSET, 1));
+    ASSERT_EQ(UUID_VARIANT, strtoul(uuid.substr(UUID_VARIANT_OFFSET, 1).c_str(), nullptr, 16) & UUID_VARIANT);
+    ASSERT_EQ(HYPHEN, uuid.substr(HYPHEN1_POSITION, 1));
+    ASSERT_EQ(HYPHEN, uuid.substr(HYPHEN4_POSITION, 1));
+    ASSERT_NE(uuid, generateUUID());
+}
+
 /**
  * Call @c generateUUID multiple times and check the version and variant are set correctly.
  * Check for uniqueness of the UUIDs generated.
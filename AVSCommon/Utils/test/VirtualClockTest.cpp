@@ -0,0 +1,159 @@
+/*
+ * VirtualClockTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file VirtualClockTest.cpp
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Timing/TimeUtils.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
+#include "AVSCommon/Utils/Timing/TimerService.h"
+#include "AVSCommon/Utils/Timing/VirtualClock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/// A delay far longer than any test may take.
+static const auto LONG_DELAY = std::chrono::minutes(60);
+
+/// How long to wait for something which should not happen.
+static const auto SHORT_TIMEOUT = std::chrono::milliseconds(50);
+
+/// Used to limit the amount of time tests will wait for an operation to finish.
+static const auto TIMEOUT = std::chrono::seconds(2);
+
+/// Test harness for @c VirtualClock class.
+class VirtualClockTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_clock = std::make_shared<VirtualClock>();
+    }
+
+    void TearDown() override {
+        Clock::setDefault(nullptr);
+    }
+
+    /// The clock under test.
+    std::shared_ptr<VirtualClock> m_clock;
+};
+
+/// Verify that the clock only moves when advanced, and the wall clock moves with it.
+TEST_F(VirtualClockTest, onlyMovesWhenAdvanced) {
+    auto start = m_clock->now();
+    auto startUnixTime = m_clock->getUnixTime();
+    std::this_thread::sleep_for(SHORT_TIMEOUT);
+    ASSERT_EQ(m_clock->now(), start);
+
+    m_clock->advance(LONG_DELAY);
+    ASSERT_EQ(m_clock->now(), start + LONG_DELAY);
+    ASSERT_EQ(m_clock->getUnixTime(), startUnixTime + std::chrono::seconds(LONG_DELAY).count());
+
+    m_clock->advance(-LONG_DELAY);
+    ASSERT_EQ(m_clock->now(), start + LONG_DELAY);
+}
+
+/// Verify that a wait ends when the clock is advanced past its deadline, and not before.
+TEST_F(VirtualClockTest, waitEndsWhenAdvancedPastDeadline) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    auto deadline = m_clock->now() + LONG_DELAY;
+    auto resultFuture = std::async(std::launch::async, [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        return m_clock->waitUntil(condition, lock, deadline, [] { return false; });
+    });
+    ASSERT_EQ(resultFuture.wait_for(SHORT_TIMEOUT), std::future_status::timeout);
+
+    m_clock->advance(LONG_DELAY / 2);
+    ASSERT_EQ(resultFuture.wait_for(SHORT_TIMEOUT), std::future_status::timeout);
+
+    m_clock->advance(LONG_DELAY / 2);
+    ASSERT_EQ(resultFuture.wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_FALSE(resultFuture.get());
+}
+
+/// Verify that a wait still ends when its predicate becomes true.
+TEST_F(VirtualClockTest, waitEndsWhenNotified) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isDone = false;
+    auto resultFuture = std::async(std::launch::async, [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        return m_clock->waitFor(condition, lock, LONG_DELAY, [&isDone] { return isDone; });
+    });
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isDone = true;
+    }
+    condition.notify_all();
+    ASSERT_EQ(resultFuture.wait_for(TIMEOUT), std::future_status::ready);
+    ASSERT_TRUE(resultFuture.get());
+}
+
+/// Verify that a @c TimerService on the clock calls its tasks as the clock is advanced.
+TEST_F(VirtualClockTest, timerServiceFollowsClock) {
+    auto service = std::make_shared<TimerService>(m_clock);
+    Timer timer(service);
+    std::atomic<int> count{0};
+    ASSERT_TRUE(timer.start(LONG_DELAY, Timer::PeriodType::ABSOLUTE, Timer::FOREVER, [&count] { ++count; }));
+    std::this_thread::sleep_for(SHORT_TIMEOUT);
+    ASSERT_EQ(count, 0);
+
+    for (int i = 1; i <= 3; ++i) {
+        m_clock->advance(LONG_DELAY);
+        auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (count < i && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(count, i);
+    }
+    timer.stop();
+}
+
+/// Verify that a @c Timer with a thread of its own waits on the default clock.
+TEST_F(VirtualClockTest, timerFollowsDefaultClock) {
+    Clock::setDefault(m_clock);
+    Timer timer(nullptr);
+    auto future = timer.start(LONG_DELAY, [] {});
+    ASSERT_EQ(future.wait_for(SHORT_TIMEOUT), std::future_status::timeout);
+
+    m_clock->advance(LONG_DELAY);
+    ASSERT_EQ(future.wait_for(TIMEOUT), std::future_status::ready);
+}
+
+/// Verify that @c getCurrentUnixTime() reads the default clock.
+TEST_F(VirtualClockTest, unixTimeFollowsDefaultClock) {
+    Clock::setDefault(m_clock);
+    int64_t before = 0;
+    ASSERT_TRUE(getCurrentUnixTime(&before));
+    m_clock->advance(LONG_DELAY);
+    int64_t after = 0;
+    ASSERT_TRUE(getCurrentUnixTime(&after));
+    ASSERT_EQ(after - before, std::chrono::seconds(LONG_DELAY).count());
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,581 @@
+/*
+ * DefaultClientSoak.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DefaultClientSoak.cpp
+///
+/// Runs a @c DefaultClient against a local @c MockAVSServer for a long time, to find memory growth and CPU creep
+/// which only show after hours, such as attachments kept by the @c AttachmentManager or entries which are never
+/// removed from a map.  Interactions are started as tap to talk at a steady rate, with silence as the microphone.
+/// The server answers each @c Recognize with @c StopCapture, @c Speak and its attachment, and the @c Speak is played
+/// by the test media player of the integration tests.
+///
+/// Every sample period, the harness prints the RSS, the heap in use, the thread count, the open file descriptor count
+/// and the CPU use of the process.  At the end, it compares the last sample with the first, which is taken once the
+/// client has run for one sample period, and fails if any has grown by more than its threshold, or if no interaction
+/// completed.
+///
+/// Usage: DefaultClientSoak [--minutes N] [--utterances-per-minute N] [--sample-seconds N] [--max-rss-growth-kb N]
+///                          [--max-heap-growth-kb N] [--max-thread-growth N] [--max-fd-growth N]
+///                          [--max-cpu-growth-percent N]
+
+#include <dirent.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AIP/AudioProvider.h>
+#include <Alerts/Storage/SQLiteAlertStorage.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
+#include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
+#include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <Integration/ConnectionStatusObserver.h>
+#include <Integration/MockAVSServer.h>
+#include <Integration/TestMediaPlayer.h>
+#include <Settings/SQLiteSettingStorage.h>
+
+#include "DefaultClient/DefaultClient.h"
+
+namespace alexaClientSDK {
+namespace defaultClient {
+namespace benchmark {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+
+using Clock = std::chrono::steady_clock;
+
+/// The sample rate of the microphone.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The size of each word within the stream.
+static const size_t WORD_SIZE = 2;
+
+/// The maximum number of readers of the stream.
+static const size_t MAX_READERS = 10;
+
+/// The amount of audio kept in the stream.
+static const size_t BUFFER_SIZE_IN_SAMPLES = SAMPLE_RATE_HZ * 15;
+
+/// How often the microphone writes to the stream.
+static const std::chrono::milliseconds WRITE_PERIOD(10);
+
+/// How many bytes of each @c Recognize the server waits for before answering, as if the user spoke for a second.
+static const size_t RECOGNIZE_RESPONSE_AFTER_BYTES = SAMPLE_RATE_HZ * WORD_SIZE;
+
+/// The size of the attachment of each @c Speak, roughly that of a short answer.
+static const size_t SPEECH_SIZE = 24 * 1024;
+
+/// How long to wait for an interaction to end.
+static const std::chrono::seconds INTERACTION_TIMEOUT(15);
+
+/// How long to wait to connect.
+static const std::chrono::seconds CONNECT_TIMEOUT(15);
+
+/// The @c StopCapture the server answers each @c Recognize with.
+static const std::string STOP_CAPTURE_DIRECTIVE =
+    "{\"directive\":{\"header\":{\"namespace\":\"SpeechRecognizer\",\"name\":\"StopCapture\","
+    "\"messageId\":\"stop-${responseId}\",\"dialogRequestId\":\"${dialogRequestId}\"},\"payload\":{}}}";
+
+/// The @c Speak the server answers each @c Recognize with.
+static const std::string SPEAK_DIRECTIVE =
+    "{\"directive\":{\"header\":{\"namespace\":\"SpeechSynthesizer\",\"name\":\"Speak\","
+    "\"messageId\":\"speak-${responseId}\",\"dialogRequestId\":\"${dialogRequestId}\"},"
+    "\"payload\":{\"url\":\"cid:tts-${responseId}\",\"format\":\"AUDIO_MPEG\",\"token\":\"speak-${responseId}\"}}}";
+
+/// The files the configuration points at, relative to the temporary directory.
+static const std::vector<std::string> FILES = {
+    "alerts.db", "settings.db", "certifiedSender.db", "alarm.mp3", "alarmShort.mp3", "timer.mp3", "timerShort.mp3"};
+
+/// How the soak runs, and how much growth fails it.
+struct Options {
+    /// Constructor, with the defaults.
+    Options() :
+            minutes{60},
+            utterancesPerMinute{6},
+            sampleSeconds{60},
+            maxRssGrowthKb{8192},
+            maxHeapGrowthKb{4096},
+            maxThreadGrowth{2},
+            maxFdGrowth{2},
+            maxCpuGrowthPercent{5} {
+    }
+
+    /// How long to run.
+    int minutes;
+
+    /// How many interactions to start each minute.
+    int utterancesPerMinute;
+
+    /// How often to sample the process.
+    int sampleSeconds;
+
+    /// The largest growth of the RSS, in kilobytes.
+    int maxRssGrowthKb;
+
+    /// The largest growth of the heap in use, in kilobytes.
+    int maxHeapGrowthKb;
+
+    /// The largest growth of the thread count, which allows for threads which come and go with each interaction.
+    int maxThreadGrowth;
+
+    /// The largest growth of the open file descriptor count.
+    int maxFdGrowth;
+
+    /// The largest growth of the CPU use over a sample period, in percent of one core.
+    int maxCpuGrowthPercent;
+};
+
+/// A sample of the resources used by the process.
+struct Sample {
+    /// How long the soak had run.
+    std::chrono::seconds elapsed;
+
+    /// The number of interactions which completed.
+    int interactions;
+
+    /// The number of interactions which did not complete.
+    int failures;
+
+    /// The resident set size, in kilobytes.
+    long rssKb;
+
+    /// The heap in use, in kilobytes.
+    long heapKb;
+
+    /// The number of threads.
+    int threads;
+
+    /// The number of open file descriptors.
+    int fds;
+
+    /// The CPU used since the previous sample, in percent of one core.
+    double cpuPercent;
+};
+
+/// An auth delegate with a token which never changes.
+class SoakAuthDelegate : public AuthDelegateInterface {
+public:
+    void addAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+        observer->onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR);
+    }
+
+    void removeAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+    }
+
+    std::string getAuthToken() override {
+        return "token";
+    }
+};
+
+/// An observer which lets the soak wait for each interaction to end.
+class DialogObserver : public DialogUXStateObserverInterface {
+public:
+    /// Constructor.
+    DialogObserver() : m_state{DialogUXState::IDLE}, m_hasStarted{false} {
+    }
+
+    void onDialogUXStateChanged(DialogUXState newState) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_state = newState;
+        if (DialogUXState::IDLE != newState) {
+            m_hasStarted = true;
+        }
+        m_wakeTrigger.notify_all();
+    }
+
+    /// Forget the interactions so far, before starting another.
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasStarted = false;
+    }
+
+    /**
+     * Wait for the interaction started since @c reset() to end.
+     *
+     * @param timeout How long to wait.
+     * @return Whether the interaction ended.
+     */
+    bool waitForEnd(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(
+            lock, timeout, [this]() { return m_hasStarted && DialogUXState::IDLE == m_state; });
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the state changes.
+    std::condition_variable m_wakeTrigger;
+
+    /// The current state.
+    DialogUXState m_state;
+
+    /// Whether the state has left @c IDLE since @c reset().
+    bool m_hasStarted;
+};
+
+/**
+ * Count the entries of a directory, other than "." and "..".
+ *
+ * @param path The path of the directory.
+ * @return The number of entries, or -1 if the directory could not be read.
+ */
+static int countEntries(const std::string& path) {
+    DIR* directory = opendir(path.c_str());
+    if (!directory) {
+        return -1;
+    }
+    int count = 0;
+    while (auto entry = readdir(directory)) {
+        if ('.' != entry->d_name[0]) {
+            ++count;
+        }
+    }
+    closedir(directory);
+    return count;
+}
+
+/**
+ * Get the CPU time used by this process.
+ *
+ * @return The CPU time used by this process.
+ */
+static std::chrono::microseconds processCpuTime() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/**
+ * Get the heap in use.
+ *
+ * @return The bytes allocated with @c malloc() and not yet freed.
+ */
+static long heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return static_cast<long>(mallinfo2().uordblks);
+#else
+    return mallinfo().uordblks;
+#endif
+}
+
+/**
+ * Sample the resources used by the process.
+ *
+ * @param elapsed How long the soak has run.
+ * @param interactions The number of interactions which completed.
+ * @param failures The number of interactions which did not complete.
+ * @param cpuPercent The CPU used since the previous sample, in percent of one core.
+ * @return The sample.
+ */
+static Sample takeSample(std::chrono::seconds elapsed, int interactions, int failures, double cpuPercent) {
+    Sample sample;
+    sample.elapsed = elapsed;
+    sample.interactions = interactions;
+    sample.failures = failures;
+    long pages = 0;
+    long residentPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> residentPages;
+    sample.rssKb = residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+    sample.heapKb = heapInUse() / 1024;
+    sample.threads = countEntries("/proc/self/task");
+    // The directory being read holds a descriptor of its own.
+    sample.fds = countEntries("/proc/self/fd") - 1;
+    sample.cpuPercent = cpuPercent;
+    return sample;
+}
+
+/**
+ * Print a sample as a row of the table.
+ *
+ * @param sample The sample.
+ */
+static void printSample(const Sample& sample) {
+    std::cout << std::setw(8) << sample.elapsed.count() << std::setw(14) << sample.interactions << std::setw(10)
+              << sample.failures << std::setw(10) << sample.rssKb << std::setw(10) << sample.heapKb << std::setw(9)
+              << sample.threads << std::setw(6) << sample.fds << std::setw(8) << std::fixed << std::setprecision(1)
+              << sample.cpuPercent << std::endl;
+}
+
+/**
+ * Check the growth of one resource.
+ *
+ * @param name The name printed for the resource.
+ * @param growth The growth.
+ * @param threshold The largest growth allowed.
+ * @return Whether the growth is within the threshold.
+ */
+static bool checkGrowth(const std::string& name, double growth, double threshold) {
+    bool isWithin = growth <= threshold;
+    std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << growth << " (limit " << threshold << ")" << (isWithin ? "" : "  FAILED")
+              << std::endl;
+    return isWithin;
+}
+
+/**
+ * Parse the command line.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param[out] options The options.
+ * @return Whether the command line was valid.
+ */
+static bool parseOptions(int argc, char** argv, Options* options) {
+    const std::map<std::string, int*> names = {{"--minutes", &options->minutes},
+                                               {"--utterances-per-minute", &options->utterancesPerMinute},
+                                               {"--sample-seconds", &options->sampleSeconds},
+                                               {"--max-rss-growth-kb", &options->maxRssGrowthKb},
+                                               {"--max-heap-growth-kb", &options->maxHeapGrowthKb},
+                                               {"--max-thread-growth", &options->maxThreadGrowth},
+                                               {"--max-fd-growth", &options->maxFdGrowth},
+                                               {"--max-cpu-growth-percent", &options->maxCpuGrowthPercent}};
+    for (int i = 1; i < argc; i += 2) {
+        auto it = names.find(argv[i]);
+        if (names.end() == it || i + 1 >= argc) {
+            return false;
+        }
+        char* end = nullptr;
+        long value = strtol(argv[i + 1], &end, 10);
+        if (*end || value < 0 || value > INT_MAX) {
+            return false;
+        }
+        *it->second = static_cast<int>(value);
+    }
+    return options->minutes > 0 && options->utterancesPerMinute > 0 && options->sampleSeconds > 0;
+}
+
+/**
+ * Run the client for as long as asked, sampling it, and check the growth of each resource.
+ *
+ * @param options How to run.
+ * @param client The connected client.
+ * @param stream The stream the client reads audio from.
+ * @param dialogObserver The observer of the dialog state of the client.
+ * @return Whether the growth of every resource was within its threshold.
+ */
+static bool soak(
+    const Options& options,
+    DefaultClient* client,
+    std::shared_ptr<AudioInputStream> stream,
+    std::shared_ptr<DialogObserver> dialogObserver) {
+    avsCommon::utils::AudioFormat format;
+    format.sampleRateHz = SAMPLE_RATE_HZ;
+    format.sampleSizeInBits = WORD_SIZE * CHAR_BIT;
+    format.numChannels = 1;
+    format.endianness = avsCommon::utils::AudioFormat::Endianness::LITTLE;
+    format.encoding = avsCommon::utils::AudioFormat::Encoding::LPCM;
+    capabilityAgents::aip::AudioProvider tapToTalkAudioProvider(
+        stream, format, capabilityAgents::aip::ASRProfile::NEAR_FIELD, true, true, true);
+
+    // The microphone writes silence at its own pace for the whole soak.
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    std::atomic<bool> isDone{false};
+    std::thread microphone([writer, &isDone]() {
+        const std::vector<int16_t> silence(SAMPLE_RATE_HZ * WRITE_PERIOD.count() / 1000, 0);
+        auto nextWrite = Clock::now();
+        while (!isDone) {
+            std::this_thread::sleep_until(nextWrite);
+            nextWrite += WRITE_PERIOD;
+            writer->write(silence.data(), silence.size());
+        }
+    });
+
+    std::cout << std::setw(8) << "seconds" << std::setw(14) << "interactions" << std::setw(10) << "failures"
+              << std::setw(10) << "rss(kB)" << std::setw(10) << "heap(kB)" << std::setw(9) << "threads"
+              << std::setw(6) << "fds" << std::setw(8) << "cpu%" << std::endl;
+    const auto utterancePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::minutes(1)) /
+                                 options.utterancesPerMinute;
+    const std::chrono::seconds samplePeriod(options.sampleSeconds);
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::minutes(options.minutes);
+    auto nextUtterance = start;
+    auto nextSample = start + samplePeriod;
+    auto lastCpu = processCpuTime();
+    auto lastSampleTime = start;
+    int interactions = 0;
+    int failures = 0;
+    std::vector<Sample> samples;
+    while (Clock::now() < end) {
+        if (Clock::now() >= nextUtterance) {
+            nextUtterance += utterancePeriod;
+            dialogObserver->reset();
+            if (client->notifyOfTapToTalk(tapToTalkAudioProvider).get() &&
+                dialogObserver->waitForEnd(INTERACTION_TIMEOUT)) {
+                ++interactions;
+            } else {
+                ++failures;
+            }
+        }
+        auto now = Clock::now();
+        if (now >= nextSample) {
+            nextSample += samplePeriod;
+            auto cpu = processCpuTime();
+            auto cpuPercent = 100.0 * std::chrono::duration<double>(cpu - lastCpu).count() /
+                              std::chrono::duration<double>(now - lastSampleTime).count();
+            lastCpu = cpu;
+            lastSampleTime = now;
+            samples.push_back(takeSample(
+                std::chrono::duration_cast<std::chrono::seconds>(now - start), interactions, failures, cpuPercent));
+            printSample(samples.back());
+        }
+        std::this_thread::sleep_until(std::min(std::min(nextUtterance, nextSample), end));
+    }
+    isDone = true;
+    microphone.join();
+
+    if (samples.size() < 2) {
+        std::cout << "Too short to compare samples; run for at least two sample periods." << std::endl;
+        return false;
+    }
+    const auto& first = samples.front();
+    const auto& last = samples.back();
+    std::cout << "Growth from " << first.elapsed.count() << " s to " << last.elapsed.count() << " s:" << std::endl;
+    bool isWithin = checkGrowth("rss (kB)", last.rssKb - first.rssKb, options.maxRssGrowthKb);
+    isWithin = checkGrowth("heap (kB)", last.heapKb - first.heapKb, options.maxHeapGrowthKb) && isWithin;
+    isWithin = checkGrowth("threads", last.threads - first.threads, options.maxThreadGrowth) && isWithin;
+    isWithin = checkGrowth("fds", last.fds - first.fds, options.maxFdGrowth) && isWithin;
+    isWithin = checkGrowth("cpu (%)", last.cpuPercent - first.cpuPercent, options.maxCpuGrowthPercent) && isWithin;
+    if (0 == interactions) {
+        std::cout << "No interaction completed." << std::endl;
+        isWithin = false;
+    }
+    return isWithin;
+}
+
+/**
+ * Write the configuration and the files it points at, create and connect the client, and soak it.
+ *
+ * @param options How to run.
+ * @return Whether the soak passed.
+ */
+static bool runAll(const Options& options) {
+    char directoryTemplate[] = "/tmp/DefaultClientSoak.XXXXXX";
+    if (!mkdtemp(directoryTemplate)) {
+        std::cerr << "Cannot create a temporary directory" << std::endl;
+        return false;
+    }
+    std::string directory = directoryTemplate;
+    for (const auto& file : FILES) {
+        if (file.find(".mp3") != std::string::npos) {
+            std::ofstream(directory + "/" + file);
+        }
+    }
+    std::stringstream configuration;
+    configuration << "{\"alertsCapabilityAgent\":{\"databaseFilePath\":\"" << directory << "/alerts.db\","
+                  << "\"alarmSoundFilePath\":\"" << directory << "/alarm.mp3\","
+                  << "\"alarmShortSoundFilePath\":\"" << directory << "/alarmShort.mp3\","
+                  << "\"timerSoundFilePath\":\"" << directory << "/timer.mp3\","
+                  << "\"timerShortSoundFilePath\":\"" << directory << "/timerShort.mp3\"},"
+                  << "\"settings\":{\"databaseFilePath\":\"" << directory << "/settings.db\","
+                  << "\"defaultAVSClientSettings\":{\"locale\":\"en-US\"}},"
+                  << "\"certifiedSender\":{\"databaseFilePath\":\"" << directory << "/certifiedSender.db\"}}";
+
+    bool succeeded = false;
+    if (initialization::AlexaClientSDKInit::initialize({&configuration})) {
+        integration::test::MockAVSServer::Configuration serverConfiguration;
+        serverConfiguration.recognizeResponseAfterBytes = RECOGNIZE_RESPONSE_AFTER_BYTES;
+        serverConfiguration.recognizeResponse.push_back(
+            {std::chrono::milliseconds::zero(), STOP_CAPTURE_DIRECTIVE, "", ""});
+        serverConfiguration.recognizeResponse.push_back(
+            {std::chrono::milliseconds(200), SPEAK_DIRECTIVE, "", ""});
+        serverConfiguration.recognizeResponse.push_back(
+            {std::chrono::milliseconds(10), "", "tts-${responseId}", std::string(SPEECH_SIZE, '\xff')});
+        auto server = integration::test::MockAVSServer::create(serverConfiguration);
+
+        auto connectionObserver = std::make_shared<integration::ConnectionStatusObserver>();
+        auto dialogObserver = std::make_shared<DialogObserver>();
+        std::shared_ptr<DefaultClient> client;
+        if (server) {
+            client = DefaultClient::create(
+                std::make_shared<integration::test::TestMediaPlayer>(),
+                std::make_shared<integration::test::TestMediaPlayer>(),
+                std::make_shared<integration::test::TestMediaPlayer>(),
+                std::make_shared<SoakAuthDelegate>(),
+                std::make_shared<capabilityAgents::alerts::storage::SQLiteAlertStorage>(),
+                std::make_shared<capabilityAgents::settings::SQLiteSettingStorage>(),
+                {dialogObserver},
+                {connectionObserver});
+        }
+        auto buffer = std::make_shared<AudioInputStream::Buffer>(
+            AudioInputStream::calculateBufferSize(BUFFER_SIZE_IN_SAMPLES, WORD_SIZE, MAX_READERS));
+        std::shared_ptr<AudioInputStream> stream = AudioInputStream::create(buffer, WORD_SIZE, MAX_READERS);
+        if (!client || !stream) {
+            std::cerr << "Cannot create the client" << std::endl;
+        } else {
+            client->connect(server->getEndpoint());
+            if (!connectionObserver->waitFor(ConnectionStatusObserverInterface::Status::CONNECTED, CONNECT_TIMEOUT)) {
+                std::cerr << "Cannot connect to the MockAVSServer" << std::endl;
+            } else {
+                succeeded = soak(options, client.get(), stream, dialogObserver);
+            }
+            client->disconnect();
+        }
+        client.reset();
+        server.reset();
+        initialization::AlexaClientSDKInit::uninitialize();
+    }
+
+    for (const auto& file : FILES) {
+        std::remove((directory + "/" + file).c_str());
+    }
+    rmdir(directory.c_str());
+    std::cout << (succeeded ? "PASSED" : "FAILED") << std::endl;
+    return succeeded;
+}
+
+}  // namespace benchmark
+}  // namespace defaultClient
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    alexaClientSDK::defaultClient::benchmark::Options options;
+    if (!alexaClientSDK::defaultClient::benchmark::parseOptions(argc, argv, &options)) {
+        std::cerr << "USAGE: " << argv[0]
+                  << " [--minutes N] [--utterances-per-minute N] [--sample-seconds N] [--max-rss-growth-kb N]"
+                     " [--max-heap-growth-kb N] [--max-thread-growth N] [--max-fd-growth N]"
+                     " [--max-cpu-growth-percent N]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_SINK_LOGGER().setLevel(
+        alexaClientSDK::avsCommon::utils::logger::Level::CRITICAL);
+    return alexaClientSDK::defaultClient::benchmark::runAll(options) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,241 @@
+/*
+ * DefaultClientThreadCount.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DefaultClientThreadCount.cpp
+///
+/// Counts the threads of a fully initialized @c DefaultClient, once created and once connected to a local
+/// @c MockAVSServer, grouped by thread name.  The client is created twice: with every @c Executor and @c Timer on a
+/// thread of its own, and with them on a shared @c ThreadPool and @c TimerService.  Media players are the test
+/// players of the integration tests, so the threads of a real media player are not counted.  Threads which are not
+/// named by the SDK are counted under the name of the process.
+///
+/// Usage: DefaultClientThreadCount
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Alerts/Storage/SQLiteAlertStorage.h>
+#include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
+#include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+#include <AVSCommon/Utils/Threading/ThreadPool.h>
+#include <AVSCommon/Utils/Timing/Timer.h>
+#include <AVSCommon/Utils/Timing/TimerService.h>
+#include <Integration/ConnectionStatusObserver.h>
+#include <Integration/MockAVSServer.h>
+#include <Integration/TestMediaPlayer.h>
+#include <Settings/SQLiteSettingStorage.h>
+
+#include "DefaultClient/DefaultClient.h"
+
+namespace alexaClientSDK {
+namespace defaultClient {
+namespace benchmark {
+
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The number of threads of the shared @c ThreadPool.
+static const size_t POOL_THREADS = 4;
+
+/// The files the configuration points at, relative to the temporary directory.
+static const std::vector<std::string> FILES = {
+    "alerts.db", "settings.db", "certifiedSender.db", "alarm.mp3", "alarmShort.mp3", "timer.mp3", "timerShort.mp3"};
+
+/// An auth delegate with a token which never changes.
+class BenchmarkAuthDelegate : public AuthDelegateInterface {
+public:
+    void addAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+        observer->onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR);
+    }
+
+    void removeAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+    }
+
+    std::string getAuthToken() override {
+        return "token";
+    }
+};
+
+/**
+ * Get the threads of this process, counted by name.
+ *
+ * @param[out] total The number of threads.
+ * @return The number of threads with each name.
+ */
+static std::map<std::string, int> getThreads(int* total) {
+    std::map<std::string, int> threads;
+    *total = 0;
+    DIR* directory = opendir("/proc/self/task");
+    if (!directory) {
+        return threads;
+    }
+    while (auto entry = readdir(directory)) {
+        if ('.' == entry->d_name[0]) {
+            continue;
+        }
+        std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+        std::string name;
+        std::getline(comm, name);
+        ++threads[name];
+        ++*total;
+    }
+    closedir(directory);
+    return threads;
+}
+
+/**
+ * Print the threads added since a baseline, by name.
+ *
+ * @param stage The name of the stage counted.
+ * @param baseline The threads, by name, before the client was created.
+ * @param baselineTotal The number of threads before the client was created.
+ */
+static void printThreads(const std::string& stage, const std::map<std::string, int>& baseline, int baselineTotal) {
+    int total = 0;
+    auto threads = getThreads(&total);
+    std::cout << "  " << stage << ": " << total - baselineTotal << " threads" << std::endl;
+    for (const auto& thread : threads) {
+        auto it = baseline.find(thread.first);
+        int added = thread.second - (baseline.end() == it ? 0 : it->second);
+        if (added > 0) {
+            std::cout << "    " << std::left << std::setw(20) << thread.first << std::right << std::setw(5) << added
+                      << std::endl;
+        }
+    }
+}
+
+/**
+ * Create a client, connect it to a @c MockAVSServer and print its threads.
+ *
+ * @param name The name printed for the configuration.
+ * @param directory The temporary directory the configuration points at.
+ * @return Whether the client could be created and connected.
+ */
+static bool run(const std::string& name, const std::string& directory) {
+    std::cout << name << std::endl;
+    auto server = integration::test::MockAVSServer::create(integration::test::MockAVSServer::Configuration());
+    if (!server) {
+        std::cerr << "Cannot start the MockAVSServer" << std::endl;
+        return false;
+    }
+    int baselineTotal = 0;
+    auto baseline = getThreads(&baselineTotal);
+
+    auto connectionObserver = std::make_shared<integration::ConnectionStatusObserver>();
+    auto client = DefaultClient::create(
+        std::make_shared<integration::test::TestMediaPlayer>(),
+        std::make_shared<integration::test::TestMediaPlayer>(),
+        std::make_shared<integration::test::TestMediaPlayer>(),
+        std::make_shared<BenchmarkAuthDelegate>(),
+        std::make_shared<capabilityAgents::alerts::storage::SQLiteAlertStorage>(),
+        std::make_shared<capabilityAgents::settings::SQLiteSettingStorage>(),
+        {},
+        {connectionObserver});
+    if (!client) {
+        std::cerr << "Cannot create the DefaultClient" << std::endl;
+        return false;
+    }
+    printThreads("created", baseline, baselineTotal);
+
+    client->connect(server->getEndpoint());
+    if (!connectionObserver->waitFor(ConnectionStatusObserverInterface::Status::CONNECTED)) {
+        std::cerr << "Cannot connect to the MockAVSServer" << std::endl;
+        return false;
+    }
+    printThreads("connected", baseline, baselineTotal);
+    client->disconnect();
+    client.reset();
+    for (const auto& file : FILES) {
+        if (file.find(".db") != std::string::npos) {
+            std::remove((directory + "/" + file).c_str());
+        }
+    }
+    return true;
+}
+
+/**
+ * Write the configuration and the files it points at, and run both configurations.
+ *
+ * @return Whether every configuration could be run.
+ */
+static bool runAll() {
+    char directoryTemplate[] = "/tmp/DefaultClientThreadCount.XXXXXX";
+    if (!mkdtemp(directoryTemplate)) {
+        std::cerr << "Cannot create a temporary directory" << std::endl;
+        return false;
+    }
+    std::string directory = directoryTemplate;
+    for (const auto& file : FILES) {
+        if (file.find(".mp3") != std::string::npos) {
+            std::ofstream(directory + "/" + file);
+        }
+    }
+    std::stringstream configuration;
+    configuration << "{\"alertsCapabilityAgent\":{\"databaseFilePath\":\"" << directory << "/alerts.db\","
+                  << "\"alarmSoundFilePath\":\"" << directory << "/alarm.mp3\","
+                  << "\"alarmShortSoundFilePath\":\"" << directory << "/alarmShort.mp3\","
+                  << "\"timerSoundFilePath\":\"" << directory << "/timer.mp3\","
+                  << "\"timerShortSoundFilePath\":\"" << directory << "/timerShort.mp3\"},"
+                  << "\"settings\":{\"databaseFilePath\":\"" << directory << "/settings.db\","
+                  << "\"defaultAVSClientSettings\":{\"locale\":\"en-US\"}},"
+                  << "\"certifiedSender\":{\"databaseFilePath\":\"" << directory << "/certifiedSender.db\"}}";
+
+    bool succeeded = avsCommon::avs::initialization::AlexaClientSDKInit::initialize({&configuration});
+    if (succeeded) {
+        succeeded = run("Own threads", directory);
+        auto threadPool = std::make_shared<threading::ThreadPool>(POOL_THREADS);
+        threading::Executor::setDefaultThreadPool(threadPool);
+        timing::Timer::setDefaultTimerService(std::make_shared<timing::TimerService>());
+        // The threads of the pool are created before the baseline, so they are not counted.
+        auto name = "ThreadPool of " + std::to_string(POOL_THREADS) + " (not counted) and TimerService";
+        succeeded = run(name, directory) && succeeded;
+        threading::Executor::setDefaultThreadPool(nullptr);
+        timing::Timer::setDefaultTimerService(nullptr);
+        threadPool->shutdown();
+        avsCommon::avs::initialization::AlexaClientSDKInit::uninitialize();
+    }
+
+    for (const auto& file : FILES) {
+        std::remove((directory + "/" + file).c_str());
+    }
+    rmdir(directory.c_str());
+    return succeeded;
+}
+
+}  // namespace benchmark
+}  // namespace defaultClient
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_SINK_LOGGER().setLevel(
+        alexaClientSDK::avsCommon::utils::logger::Level::CRITICAL);
+    return alexaClientSDK::defaultClient::benchmark::runAll() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
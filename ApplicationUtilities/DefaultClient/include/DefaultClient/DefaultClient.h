@@ -20,6 +20,7 @@
 
 #include <ACL/AVSConnectionManager.h>
 #include <ACL/Transport/MessageRouter.h>
+#include <ACL/Transport/NetworkQualityEstimator.h>
 #include <ADSL/DirectiveSequencer.h>
 #include <AFML/FocusManager.h>
 #include <AIP/AudioInputProcessor.h>
@@ -29,15 +30,21 @@
 #include <SpeechSynthesizer/SpeechSynthesizer.h>
 #include <AudioPlayer/AudioPlayer.h>
 #include <AVSCommon/AVS/DialogUXStateAggregator.h>
+#include <AVSCommon/AVS/LazyCapabilityAgent.h>
 #include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
 #include <AVSCommon/SDKInterfaces/ConnectionStatusObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+#include <AVSCommon/SDKInterfaces/NetworkQualityObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/PlaybackControllerInterface.h>
 #include <AVSCommon/SDKInterfaces/SingleSettingObserverInterface.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
+#include <CertifiedSender/AppendLogMessageStorage.h>
 #include <CertifiedSender/CertifiedSender.h>
 #include <CertifiedSender/SQLiteMessageStorage.h>
 #include <PlaybackController/PlaybackController.h>
+#include <Settings/CachedSettingStorage.h>
 #include <Settings/SettingsStorageInterface.h>
 #include <Settings/Settings.h>
 #include <Settings/SettingsUpdatedEventSender.h>
@@ -58,6 +65,10 @@ public:
      * Creates and initializes a default AVS SDK client. To connect the client to AVS, users should make a call to
      * connect() after creation.
      *
+     * The time each stage of the initialization takes is logged.  If @c defaultClient.parallelInitialization is set
+     * in the configuration, the stages which do not depend on each other, such as those opening the alerts and
+     * settings databases, run concurrently.
+     *
      * @param speakMediaPlayer The media player to use to play Alexa speech from.
      * @param audioMediaPlayer The media player to use to play Alexa audio content from.
      * @param alertsMediaPlayer The media player to use to play alerts from.
@@ -66,6 +77,12 @@ public:
      * @param alexaDialogStateObservers Observers that can be used to be notified of Alexa dialog related UX state
      * changes.
      * @param connectionObservers Observers that can be used to be notified of connection status changes.
+     * @param contentFetcherFactory An optional factory used to download the assets of alerts ahead of their
+     * scheduled time.
+     * @param configuration An optional configuration of this client, from
+     * @c avsCommon::utils::configuration::ConfigurationNode::createRoot(), which it reads instead of the global
+     * configuration while it is created, and whenever it connects to AVS.  This lets a process run many clients, each
+     * with a configuration of its own.
      * @return A @c std::unique_ptr to a DefaultClient if all went well or @c nullptr otherwise.
      *
      * TODO: ACSDK-384 Remove the requirement of clients having to wait for authorization before making the connect()
@@ -82,7 +99,11 @@ public:
         std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::DialogUXStateObserverInterface>>
             alexaDialogStateObservers,
         std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::ConnectionStatusObserverInterface>>
-            connectionObservers);
+            connectionObservers,
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory =
+            nullptr,
+        avsCommon::utils::configuration::ConfigurationNode configuration =
+            avsCommon::utils::configuration::ConfigurationNode());
 
     /**
      * Connects the client to AVS. Note that users should first wait for the authorization state to be set to REFRESHED
@@ -100,6 +121,13 @@ public:
      */
     void disconnect();
 
+    /**
+     * Tells the client that the network has become available, for example from a netlink or NetworkManager link-up
+     * notification.  If the client is connecting to AVS, it retries at once rather than waiting for its backoff to
+     * expire.  If it is connected or disconnected, this does nothing.
+     */
+    void onNetworkAvailable();
+
     /**
      * Stops the foreground activity if there is one. This acts as a "stop" button that can be used to stop an
      * ongoing activity. This call will block until the foreground activity has stopped all user-observable activities.
@@ -141,6 +169,22 @@ public:
     void removeConnectionObserver(
         std::shared_ptr<avsCommon::sdkInterfaces::ConnectionStatusObserverInterface> observer);
 
+    /**
+     * Adds an observer to be notified of changes in the estimated quality of the connection.
+     *
+     * @param observer The observer to add.
+     */
+    void addNetworkQualityObserver(
+        std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface> observer);
+
+    /**
+     * Removes an observer to be notified of changes in the estimated quality of the connection.
+     *
+     * @param observer The observer to remove.
+     */
+    void removeNetworkQualityObserver(
+        std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface> observer);
+
     /**
      * Adds an observer to a single setting to be notified of that setting change.
      *
@@ -198,6 +242,15 @@ public:
         avsCommon::avs::AudioInputStream::Index endIndex,
         std::string keyword);
 
+    /**
+     * Notifies the client that a wake word is likely to be detected shortly, so that it can start assembling the
+     * context of the interaction ahead of @c notifyOfWakeWord().  This is meant for wake word engines which report
+     * early or partial detections.
+     *
+     * @return A future which indicates when the context has been requested.
+     */
+    std::future<void> notifyOfPossibleWakeWord();
+
     /**
      * Begins a tap to talk initiated Alexa interaction. Note that this can also be used for wake word engines that
      * don't support providing both a begin and end index.
@@ -244,6 +297,8 @@ private:
      * @param alexaDialogStateObservers Observers that can be used to be notified of Alexa dialog related UX state
      * changes.
      * @param connectionObservers Observers that can be used to be notified of connection status changes.
+     * @param contentFetcherFactory An optional factory used to download the assets of alerts ahead of their
+     * scheduled time.
      * @return Whether the SDK was intialized properly.
      */
     bool initialize(
@@ -256,7 +311,8 @@ private:
         std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::DialogUXStateObserverInterface>>
             alexaDialogStateObservers,
         std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::ConnectionStatusObserverInterface>>
-            connectionObservers);
+            connectionObservers,
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory);
 
     /// The directive sequencer.
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> m_directiveSequencer;
@@ -264,6 +320,9 @@ private:
     /// The focus manager.
     std::shared_ptr<afml::FocusManager> m_focusManager;
 
+    /// The estimator of the quality of the connection, fed by the transports of @c m_messageRouter.
+    std::shared_ptr<acl::NetworkQualityEstimator> m_networkQualityEstimator;
+
     /// The message router.
     std::shared_ptr<acl::MessageRouter> m_messageRouter;
 
@@ -279,9 +338,12 @@ private:
     /// The speech synthesizer.
     std::shared_ptr<capabilityAgents::speechSynthesizer::SpeechSynthesizer> m_speechSynthesizer;
 
-    /// The audio player.
+    /// The audio player, unless it is created lazily.
     std::shared_ptr<capabilityAgents::audioPlayer::AudioPlayer> m_audioPlayer;
 
+    /// The stand-in for the audio player, if it is created when first needed.
+    std::shared_ptr<avsCommon::avs::LazyCapabilityAgent> m_lazyAudioPlayer;
+
     /// The alerts capability agent.
     std::shared_ptr<capabilityAgents::alerts::AlertsCapabilityAgent> m_alertsCapabilityAgent;
 
@@ -291,6 +353,9 @@ private:
     /// The playbackController capability agent.
     std::shared_ptr<capabilityAgents::playbackController::PlaybackController> m_playbackController;
 
+    /// The cache in front of the settings storage, which writes the changes of the settings in the background.
+    std::shared_ptr<capabilityAgents::settings::CachedSettingStorage> m_settingsStorage;
+
     /// The settings object.
     std::shared_ptr<capabilityAgents::settings::Settings> m_settings;
 };
@@ -17,13 +17,21 @@
 
 #include "DefaultClient/DefaultClient.h"
 
+#include <algorithm>
+#include <future>
+
 #include <ADSL/MessageInterpreter.h>
 #include <ACL/Transport/HTTP2MessageRouter.h>
 #include <ACL/Transport/PostConnectObject.h>
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/AVS/ExceptionEncounteredSender.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <AVSCommon/Utils/Metrics/StartupProfiler.h>
 #include <Settings/SettingsUpdatedEventSender.h>
 #include <ContextManager/ContextManager.h>
+#ifdef OPUS
+#include <AIP/OpusAudioEncoder.h>
+#endif
 #include <System/EndpointHandler.h>
 #include <System/UserInactivityMonitor.h>
 
@@ -40,6 +48,77 @@ static const std::string TAG("DefaultClient");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The key in our config file to find the root of settings for the default client.
+static const std::string DEFAULT_CLIENT_CONFIGURATION_ROOT_KEY = "defaultClient";
+/// The key in our config file to find whether the independent stages of initialization run concurrently.
+static const std::string PARALLEL_INITIALIZATION_KEY = "parallelInitialization";
+/// The key in our config file to find whether the connection to AVS is kept in low-power mode.
+static const std::string LOW_POWER_MODE_KEY = "lowPowerMode";
+/// The key in our config file to find how long the user is inactive before the connection is closed in low-power mode.
+static const std::string LOW_POWER_INACTIVITY_TIMEOUT_SECONDS_KEY = "lowPowerInactivityTimeoutSeconds";
+/// The default for how long the user is inactive before the connection is closed in low-power mode.
+static const int DEFAULT_LOW_POWER_INACTIVITY_TIMEOUT_SECONDS = 10 * 60;
+/// The key in our config file to find whether capability agents which may go unused are created when first needed.
+static const std::string LAZY_CAPABILITY_AGENTS_KEY = "lazyCapabilityAgents";
+
+/// The key in our config file to find the root of settings for the context manager.
+static const std::string CONTEXT_MANAGER_CONFIGURATION_ROOT_KEY = "contextManager";
+/// The key in our config file to find how long, in milliseconds, updated states may be reused for further requests.
+static const std::string CONTEXT_FRESHNESS_WINDOW_MS_KEY = "freshnessWindowMs";
+/// The key in our config file to find how long, in milliseconds, a state provider has to provide its state.
+static const std::string CONTEXT_PROVIDE_STATE_TIMEOUT_MS_KEY = "provideStateTimeoutMs";
+/// The key in our config file to find the deadlines of individual state providers, by namespace and then name.
+static const std::string CONTEXT_STATE_PROVIDERS_KEY = "stateProviders";
+/// The key in the config of a state provider to find how long, in milliseconds, it has to provide its state.
+static const std::string CONTEXT_STATE_PROVIDER_TIMEOUT_MS_KEY = "timeoutMs";
+/// The key in the config of a state provider to find whether its last state is used if it does not provide it in time.
+static const std::string CONTEXT_STATE_PROVIDER_USE_LAST_STATE_KEY = "useLastStateOnTimeout";
+/// The states which are requested from their providers for a context, and so may be given deadlines of their own.
+static const std::vector<avsCommon::avs::NamespaceAndName> CONTEXT_REQUESTED_STATES = {
+    {"AudioPlayer", "PlaybackState"},
+    {"SpeechSynthesizer", "SpeechState"}};
+
+/// The key in our config file to find the root of settings for the certified sender.
+static const std::string CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY = "certifiedSender";
+/// The key in our config file to find the kind of storage used by the certified sender.
+static const std::string CERTIFIED_SENDER_STORAGE_KEY = "storage";
+/// The value of @c CERTIFIED_SENDER_STORAGE_KEY selecting the SQLite database (the default).
+static const std::string CERTIFIED_SENDER_STORAGE_SQLITE = "sqlite";
+/// The value of @c CERTIFIED_SENDER_STORAGE_KEY selecting the append-only log.
+static const std::string CERTIFIED_SENDER_STORAGE_APPEND_LOG = "appendLog";
+
+/// The key in our config file to find the root of settings for the audio input processor.
+static const std::string AUDIO_INPUT_PROCESSOR_CONFIGURATION_ROOT_KEY = "audioInputProcessor";
+/// The key in our config file to find the silence after speech which ends a Recognize event on the device, or 0.
+static const std::string LOCAL_END_OF_SPEECH_SILENCE_MS_KEY = "localEndOfSpeechSilenceMs";
+/// The key in our config file to find whether the dialog channel is acquired while the context is being fetched.
+static const std::string CONCURRENT_FOCUS_ACQUISITION_KEY = "concurrentFocusAcquisition";
+
+/// The key in our config file to find the root of settings for the dialog UX state aggregator.
+static const std::string DIALOG_UX_STATE_AGGREGATOR_CONFIGURATION_ROOT_KEY = "dialogUXStateAggregator";
+/// The key in our config file to find the interval over which dialog UX state changes are coalesced, or 0.
+static const std::string COALESCING_INTERVAL_MS_KEY = "coalescingIntervalMs";
+
+/// The key in our config file to find the root of settings for attachments.
+static const std::string ATTACHMENT_MANAGER_CONFIGURATION_ROOT_KEY = "attachmentManager";
+/// The key in our config file to find the directory large attachments spill into, or an empty string.
+static const std::string SPILL_DIRECTORY_KEY = "spillDirectory";
+/// The key in our config file to find the largest number of bytes an attachment may spill.
+static const std::string MAX_SPILL_SIZE_BYTES_KEY = "maxSpillSizeBytes";
+
+/// The key in our config file to find the root of settings for the directive sequencer.
+static const std::string DIRECTIVE_SEQUENCER_CONFIGURATION_ROOT_KEY = "directiveSequencer";
+/// The key in our config file to find the number of messageIds remembered to drop duplicate directives (0, which
+/// disables dropping them, by default).
+static const std::string DUPLICATE_FILTER_CAPACITY_KEY = "duplicateFilterCapacity";
+/// The key in our config file to find how long a messageId is remembered to drop duplicate directives.
+static const std::string DUPLICATE_FILTER_TTL_SECONDS_KEY = "duplicateFilterTtlSeconds";
+/// The key in our config file to find how long the directive threads spin for the next directive before blocking.
+static const std::string MAX_SPIN_MICROSECONDS_KEY = "maxSpinMicroseconds";
+
+/// The timeout after which the dialog UX state goes from THINKING to IDLE if no directive arrives.
+static const std::chrono::seconds THINKING_TO_IDLE_TIMEOUT{5};
+
 std::unique_ptr<DefaultClient> DefaultClient::create(
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> speakMediaPlayer,
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> audioMediaPlayer,
@@ -50,8 +129,14 @@ std::unique_ptr<DefaultClient> DefaultClient::create(
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::DialogUXStateObserverInterface>>
         alexaDialogStateObservers,
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::ConnectionStatusObserverInterface>>
-        connectionObservers) {
+        connectionObservers,
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    avsCommon::utils::configuration::ConfigurationNode configuration) {
     std::unique_ptr<DefaultClient> defaultClient(new DefaultClient());
+    std::unique_ptr<avsCommon::utils::configuration::ConfigurationNode::ScopedRoot> scopedRoot;
+    if (configuration) {
+        scopedRoot.reset(new avsCommon::utils::configuration::ConfigurationNode::ScopedRoot(configuration));
+    }
     if (!defaultClient->initialize(
             speakMediaPlayer,
             audioMediaPlayer,
@@ -60,7 +145,8 @@ std::unique_ptr<DefaultClient> DefaultClient::create(
             alertStorage,
             settingsStorage,
             alexaDialogStateObservers,
-            connectionObservers)) {
+            connectionObservers,
+            contentFetcherFactory)) {
         return nullptr;
     }
 
@@ -77,7 +163,8 @@ bool DefaultClient::initialize(
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::DialogUXStateObserverInterface>>
         alexaDialogStateObservers,
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::ConnectionStatusObserverInterface>>
-        connectionObservers) {
+        connectionObservers,
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) {
     if (!speakMediaPlayer) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "nullSpeakMediaPlayer"));
         return false;
@@ -98,7 +185,31 @@ bool DefaultClient::initialize(
         return false;
     }
 
-    m_dialogUXStateAggregator = std::make_shared<avsCommon::avs::DialogUXStateAggregator>();
+    avsCommon::utils::metrics::StartupProfiler profiler("DefaultClient");
+    auto stageStart = avsCommon::utils::metrics::StartupProfiler::Clock::now();
+
+    bool parallelInitialization = false;
+    avsCommon::utils::configuration::ConfigurationNode::getRoot()[DEFAULT_CLIENT_CONFIGURATION_ROOT_KEY].getBool(
+        PARALLEL_INITIALIZATION_KEY, &parallelInitialization, false);
+
+    bool lowPowerMode = false;
+    avsCommon::utils::configuration::ConfigurationNode::getRoot()[DEFAULT_CLIENT_CONFIGURATION_ROOT_KEY].getBool(
+        LOW_POWER_MODE_KEY, &lowPowerMode, false);
+    int lowPowerInactivityTimeoutSeconds = DEFAULT_LOW_POWER_INACTIVITY_TIMEOUT_SECONDS;
+    avsCommon::utils::configuration::ConfigurationNode::getRoot()[DEFAULT_CLIENT_CONFIGURATION_ROOT_KEY].getInt(
+        LOW_POWER_INACTIVITY_TIMEOUT_SECONDS_KEY,
+        &lowPowerInactivityTimeoutSeconds,
+        DEFAULT_LOW_POWER_INACTIVITY_TIMEOUT_SECONDS);
+
+    bool lazyCapabilityAgents = false;
+    avsCommon::utils::configuration::ConfigurationNode::getRoot()[DEFAULT_CLIENT_CONFIGURATION_ROOT_KEY].getBool(
+        LAZY_CAPABILITY_AGENTS_KEY, &lazyCapabilityAgents, false);
+
+    int coalescingIntervalMs = 0;
+    avsCommon::utils::configuration::ConfigurationNode::getRoot()[DIALOG_UX_STATE_AGGREGATOR_CONFIGURATION_ROOT_KEY]
+        .getInt(COALESCING_INTERVAL_MS_KEY, &coalescingIntervalMs, 0);
+    m_dialogUXStateAggregator = std::make_shared<avsCommon::avs::DialogUXStateAggregator>(
+        THINKING_TO_IDLE_TIMEOUT, std::chrono::milliseconds(coalescingIntervalMs));
 
     for (auto observer : alexaDialogStateObservers) {
         m_dialogUXStateAggregator->addObserver(observer);
@@ -116,15 +227,33 @@ bool DefaultClient::initialize(
      * Creating the Attachment Manager - This component deals with managing attachments and allows for readers and
      * writers to be created to handle the attachment.
      */
+    std::string spillDirectory;
+    int maxSpillSizeBytes = 0;
+    auto attachmentManagerConfig =
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[ATTACHMENT_MANAGER_CONFIGURATION_ROOT_KEY];
+    attachmentManagerConfig.getString(SPILL_DIRECTORY_KEY, &spillDirectory, "");
+    attachmentManagerConfig.getInt(
+        MAX_SPILL_SIZE_BYTES_KEY,
+        &maxSpillSizeBytes,
+        avsCommon::avs::attachment::AttachmentManager::DEFAULT_MAX_SPILL_SIZE_IN_BYTES);
+    auto attachmentType = spillDirectory.empty() || maxSpillSizeBytes <= 0
+                              ? avsCommon::avs::attachment::AttachmentManager::AttachmentType::IN_PROCESS
+                              : avsCommon::avs::attachment::AttachmentManager::AttachmentType::SPILLING;
     auto attachmentManager = std::make_shared<avsCommon::avs::attachment::AttachmentManager>(
-        avsCommon::avs::attachment::AttachmentManager::AttachmentType::IN_PROCESS);
+        attachmentType, spillDirectory, static_cast<size_t>(maxSpillSizeBytes));
 
     /*
      * Creating the message router - This component actually maintains the connection to AVS over HTTP2. It is created
      * using the auth delegate, which provides authorization to connect to AVS, and the attachment manager, which helps
      * ACL write attachments received from AVS.
      */
-    m_messageRouter = std::make_shared<acl::HTTP2MessageRouter>(authDelegate, attachmentManager);
+    m_networkQualityEstimator = std::make_shared<acl::NetworkQualityEstimator>();
+    m_messageRouter = std::make_shared<acl::HTTP2MessageRouter>(
+        authDelegate,
+        attachmentManager,
+        acl::HTTP2MessageRouter::DEFAULT_AVS_ENDPOINT,
+        nullptr,
+        m_networkQualityEstimator);
 
     /*
      * Creating the connection manager - This component is the overarching connection manager that glues together all
@@ -136,18 +265,8 @@ bool DefaultClient::initialize(
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateConnectionManager"));
         return false;
     }
-
-    /*
-     * Creating our certified sender - this component guarantees that messages given to it (expected to be JSON
-     * formatted AVS Events) will be sent to AVS.  This nicely decouples strict message sending from components which
-     * require an Event be sent, even in conditions when there is no active AVS connection.
-     */
-    auto messageStorage = std::make_shared<certifiedSender::SQLiteMessageStorage>();
-    m_certifiedSender =
-        certifiedSender::CertifiedSender::create(m_connectionManager, m_connectionManager, messageStorage);
-    if (!m_certifiedSender) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateCertifiedSender"));
-        return false;
+    if (lowPowerMode) {
+        m_connectionManager->setLowPowerMode(true);
     }
 
     /*
@@ -167,7 +286,12 @@ bool DefaultClient::initialize(
      * directives sent from AVS and forwarding them along to the appropriate Capability Agent that deals with
      * directives in that Namespace/Name.
      */
-    m_directiveSequencer = adsl::DirectiveSequencer::create(exceptionSender);
+    auto directiveSequencerConfig =
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[DIRECTIVE_SEQUENCER_CONFIGURATION_ROOT_KEY];
+    int maxSpinMicroseconds = 0;
+    directiveSequencerConfig.getInt(MAX_SPIN_MICROSECONDS_KEY, &maxSpinMicroseconds, 0);
+    m_directiveSequencer = adsl::DirectiveSequencer::create(
+        exceptionSender, false, std::chrono::microseconds(std::max(maxSpinMicroseconds, 0)));
     if (!m_directiveSequencer) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateDirectiveSequencer"));
         return false;
@@ -177,8 +301,18 @@ bool DefaultClient::initialize(
      * Creating the Message Interpreter - This component takes care of converting ACL messages to Directives for the
      * Directive Sequencer to process. This essentially "glues" together the ACL and ADSL.
      */
-    auto messageInterpreter =
-        std::make_shared<adsl::MessageInterpreter>(exceptionSender, m_directiveSequencer, attachmentManager);
+    int duplicateFilterCapacity = 0;
+    int duplicateFilterTtlSeconds = 0;
+    directiveSequencerConfig.getInt(DUPLICATE_FILTER_CAPACITY_KEY, &duplicateFilterCapacity, 0);
+    directiveSequencerConfig.getInt(
+        DUPLICATE_FILTER_TTL_SECONDS_KEY, &duplicateFilterTtlSeconds, adsl::MessageIdFilter::DEFAULT_TTL.count());
+    std::shared_ptr<adsl::MessageIdFilter> messageIdFilter;
+    if (duplicateFilterCapacity > 0 && duplicateFilterTtlSeconds > 0) {
+        messageIdFilter = adsl::MessageIdFilter::create(
+            static_cast<size_t>(duplicateFilterCapacity), std::chrono::seconds(duplicateFilterTtlSeconds));
+    }
+    auto messageInterpreter = std::make_shared<adsl::MessageInterpreter>(
+        exceptionSender, m_directiveSequencer, attachmentManager, messageIdFilter);
 
     m_connectionManager->addMessageObserver(messageInterpreter);
 
@@ -187,125 +321,285 @@ bool DefaultClient::initialize(
      * It is required for each of the capability agents so that they may provide their state just before any event is
      * fired off.
      */
-    auto contextManager = contextManager::ContextManager::create();
+    auto contextManagerConfig =
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[CONTEXT_MANAGER_CONFIGURATION_ROOT_KEY];
+    int contextFreshnessWindowMs = 0;
+    contextManagerConfig.getInt(CONTEXT_FRESHNESS_WINDOW_MS_KEY, &contextFreshnessWindowMs, 0);
+    int provideStateTimeoutMs = 0;
+    if (!contextManagerConfig.getInt(CONTEXT_PROVIDE_STATE_TIMEOUT_MS_KEY, &provideStateTimeoutMs) ||
+        provideStateTimeoutMs <= 0) {
+        provideStateTimeoutMs = contextManager::ContextManager::DEFAULT_PROVIDE_STATE_TIMEOUT.count();
+    }
+    auto contextManager = contextManager::ContextManager::create(
+        std::chrono::milliseconds(std::max(contextFreshnessWindowMs, 0)),
+        std::chrono::milliseconds(provideStateTimeoutMs));
     if (!contextManager) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateContextManager"));
         return false;
     }
-    acl::PostConnectObject::init(contextManager);
-
-    /*
-     * Creating the User Inactivity Monitor - This component is responsibly for updating AVS of user inactivity as
-     * described in the System Interface of AVS.
-     */
-    auto userInactivityMonitor =
-        capabilityAgents::system::UserInactivityMonitor::create(m_connectionManager, exceptionSender);
-    if (!userInactivityMonitor) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateUserInactivityMonitor"));
-        return false;
-    }
-
-    /*
-     * Creating the Audio Input Processor - This component is the Capability Agent that implments the SpeechRecognizer
-     * interface of AVS.
-     */
-    m_audioInputProcessor = capabilityAgents::aip::AudioInputProcessor::create(
-        m_directiveSequencer,
-        m_connectionManager,
-        contextManager,
-        m_focusManager,
-        m_dialogUXStateAggregator,
-        exceptionSender,
-        userInactivityMonitor);
-    if (!m_audioInputProcessor) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioInputProcessor"));
-        return false;
-    }
-
-    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
-
-    /*
-     * Creating the Speech Synthesizer - This component is the Capability Agent that implements the SpeechSynthesizer
-     * interface of AVS.
-     */
-    m_speechSynthesizer = capabilityAgents::speechSynthesizer::SpeechSynthesizer::create(
-        speakMediaPlayer, m_connectionManager, m_focusManager, contextManager, attachmentManager, exceptionSender);
-    if (!m_speechSynthesizer) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSpeechSynthesizer"));
-        return false;
-    }
-
-    m_speechSynthesizer->addObserver(m_dialogUXStateAggregator);
-
-    /*
-     * Creating the Audio Player - This component is the Capability Agent that implements the AudioPlayer
-     * interface of AVS.
-     */
-    m_audioPlayer = capabilityAgents::audioPlayer::AudioPlayer::create(
-        audioMediaPlayer, m_connectionManager, m_focusManager, contextManager, attachmentManager, exceptionSender);
-    if (!m_audioPlayer) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioPlayer"));
-        return false;
-    }
-
-    /*
-     * Creating the Alerts Capability Agent - This component is the Capability Agent that implements the Alerts
-     * interface of AVS.
-     */
-    m_alertsCapabilityAgent = capabilityAgents::alerts::AlertsCapabilityAgent::create(
-        m_connectionManager,
-        m_certifiedSender,
-        m_focusManager,
-        contextManager,
-        exceptionSender,
-        alertStorage,
-        capabilityAgents::alerts::renderer::Renderer::create(alertsMediaPlayer));
-    if (!m_alertsCapabilityAgent) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAlertsCapabilityAgent"));
-        return false;
-    }
-
-    addConnectionObserver(m_alertsCapabilityAgent);
-
-    addConnectionObserver(m_dialogUXStateAggregator);
-
-    /*
-     * Creating the PlaybackController Capability Agent - This component is the Capability Agent that implements the
-     * PlaybackController interface of AVS.
-     */
-    m_playbackController =
-        capabilityAgents::playbackController::PlaybackController::create(contextManager, m_connectionManager);
-    if (!m_playbackController) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreatePlaybackController"));
-        return false;
+    for (const auto& state : CONTEXT_REQUESTED_STATES) {
+        auto stateConfig = contextManagerConfig[CONTEXT_STATE_PROVIDERS_KEY][state.nameSpace][state.name];
+        int timeoutMs = 0;
+        if (!stateConfig.getInt(CONTEXT_STATE_PROVIDER_TIMEOUT_MS_KEY, &timeoutMs) || timeoutMs <= 0) {
+            continue;
+        }
+        bool useLastState = false;
+        stateConfig.getBool(CONTEXT_STATE_PROVIDER_USE_LAST_STATE_KEY, &useLastState, false);
+        contextManager->setProvideStateDeadline(
+            state,
+            std::chrono::milliseconds(timeoutMs),
+            useLastState ? alexaClientSDK::contextManager::ContextManager::TimeoutPolicy::USE_LAST_STATE
+                         : alexaClientSDK::contextManager::ContextManager::TimeoutPolicy::FAIL);
     }
+    acl::PostConnectObject::init(contextManager);
 
-    std::shared_ptr<capabilityAgents::settings::SettingsUpdatedEventSender> settingsUpdatedEventSender =
-        alexaClientSDK::capabilityAgents::settings::SettingsUpdatedEventSender::create(m_connectionManager);
-    if (!settingsUpdatedEventSender) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsObserver"));
-        return false;
-    }
+    profiler.record("core", stageStart);
 
     /*
-     * Creating the Setting object - This component implements the Setting interface of AVS.
+     * The components created by the stages below only depend on the ones created above, and on those of the same
+     * stage.  With parallel initialization, the stages run concurrently, so that opening the message, alerts and
+     * settings databases overlaps with creating the other capability agents.  Otherwise they run one after another.
      */
-    m_settings = capabilityAgents::settings::Settings::create(settingsStorage, {settingsUpdatedEventSender});
-
-    if (!m_settings) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsObject"));
+    std::shared_ptr<capabilityAgents::system::UserInactivityMonitor> userInactivityMonitor;
+    std::shared_ptr<capabilityAgents::system::EndpointHandler> endpointHandler;
+
+    auto alertsStage = [&]() -> bool {
+        /*
+         * Creating our certified sender - this component guarantees that messages given to it (expected to be JSON
+         * formatted AVS Events) will be sent to AVS.  This nicely decouples strict message sending from components
+         * which require an Event be sent, even in conditions when there is no active AVS connection.
+         */
+        std::string storageType;
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY]
+            .getString(CERTIFIED_SENDER_STORAGE_KEY, &storageType, CERTIFIED_SENDER_STORAGE_SQLITE);
+        std::shared_ptr<certifiedSender::MessageStorageInterface> messageStorage;
+        if (CERTIFIED_SENDER_STORAGE_APPEND_LOG == storageType) {
+            messageStorage = std::make_shared<certifiedSender::AppendLogMessageStorage>();
+        } else if (CERTIFIED_SENDER_STORAGE_SQLITE == storageType) {
+            // The shared database, if one is configured, is the one the application gave its storages.
+            messageStorage = std::make_shared<certifiedSender::SQLiteMessageStorage>(
+                storage::sqliteStorage::SQLiteDatabaseService::getFromConfiguration());
+        } else {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unknownCertifiedSenderStorage").d("storage", storageType));
+            return false;
+        }
+        m_certifiedSender =
+            certifiedSender::CertifiedSender::create(m_connectionManager, m_connectionManager, messageStorage);
+        if (!m_certifiedSender) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateCertifiedSender"));
+            return false;
+        }
+
+        /*
+         * Creating the Alerts Capability Agent - This component is the Capability Agent that implements the Alerts
+         * interface of AVS.
+         */
+        m_alertsCapabilityAgent = capabilityAgents::alerts::AlertsCapabilityAgent::create(
+            m_connectionManager,
+            m_certifiedSender,
+            m_focusManager,
+            contextManager,
+            exceptionSender,
+            alertStorage,
+            capabilityAgents::alerts::renderer::Renderer::create(alertsMediaPlayer, contentFetcherFactory));
+        if (!m_alertsCapabilityAgent) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAlertsCapabilityAgent"));
+            return false;
+        }
+
+        addConnectionObserver(m_alertsCapabilityAgent);
+
+        return true;
+    };
+
+    auto settingsStage = [&]() -> bool {
+        std::shared_ptr<capabilityAgents::settings::SettingsUpdatedEventSender> settingsUpdatedEventSender =
+            alexaClientSDK::capabilityAgents::settings::SettingsUpdatedEventSender::create(m_connectionManager);
+        if (!settingsUpdatedEventSender) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsObserver"));
+            return false;
+        }
+
+        /*
+         * Creating the settings cache - This component keeps the settings in memory and writes their changes to the
+         * settings storage in the background, so that the Setting object does not wait for the database.
+         */
+        m_settingsStorage = capabilityAgents::settings::CachedSettingStorage::create(settingsStorage);
+        if (!m_settingsStorage) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsCache"));
+            return false;
+        }
+
+        /*
+         * Creating the Setting object - This component implements the Setting interface of AVS.
+         */
+        m_settings = capabilityAgents::settings::Settings::create(m_settingsStorage, {settingsUpdatedEventSender});
+
+        if (!m_settings) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSettingsObject"));
+            return false;
+        }
+
+        return true;
+    };
+
+    auto capabilityAgentsStage = [&]() -> bool {
+        /*
+         * Creating the User Inactivity Monitor - This component is responsibly for updating AVS of user inactivity as
+         * described in the System Interface of AVS.
+         */
+        userInactivityMonitor = capabilityAgents::system::UserInactivityMonitor::create(
+            m_connectionManager,
+            exceptionSender,
+            std::chrono::hours(1),
+            std::chrono::seconds(lowPowerInactivityTimeoutSeconds));
+        if (!userInactivityMonitor) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateUserInactivityMonitor"));
+            return false;
+        }
+        if (lowPowerMode) {
+            // Close the connection while the user is inactive, and open it again as soon as the user is back.
+            userInactivityMonitor->addObserver(m_connectionManager);
+        }
+
+        /*
+         * Creating the Audio Input Processor - This component is the Capability Agent that implments the
+         * SpeechRecognizer interface of AVS.
+         */
+        std::shared_ptr<capabilityAgents::aip::AudioEncoderInterface> audioEncoder;
+#ifdef OPUS
+        audioEncoder = capabilityAgents::aip::OpusAudioEncoder::create();
+        if (!audioEncoder) {
+            ACSDK_WARN(LX("initialize").d("reason", "unableToCreateOpusAudioEncoder").m("sendingPcmAudio"));
+        }
+#endif
+        auto audioInputProcessorConfig =
+            avsCommon::utils::configuration::ConfigurationNode::getRoot()[AUDIO_INPUT_PROCESSOR_CONFIGURATION_ROOT_KEY];
+        int localEndOfSpeechSilenceMs = 0;
+        audioInputProcessorConfig.getInt(LOCAL_END_OF_SPEECH_SILENCE_MS_KEY, &localEndOfSpeechSilenceMs, 0);
+        bool concurrentFocusAcquisition = false;
+        audioInputProcessorConfig.getBool(CONCURRENT_FOCUS_ACQUISITION_KEY, &concurrentFocusAcquisition, false);
+        auto localEndpointing = capabilityAgents::aip::EndOfSpeechDetector::Config();
+        if (localEndOfSpeechSilenceMs > 0) {
+            localEndpointing = capabilityAgents::aip::EndOfSpeechDetector::getDefaultConfig();
+            localEndpointing.trailingSilence = std::chrono::milliseconds(localEndOfSpeechSilenceMs);
+        }
+        m_audioInputProcessor = capabilityAgents::aip::AudioInputProcessor::create(
+            m_directiveSequencer,
+            m_connectionManager,
+            contextManager,
+            m_focusManager,
+            m_dialogUXStateAggregator,
+            exceptionSender,
+            userInactivityMonitor,
+            capabilityAgents::aip::AudioProvider::null(),
+            audioEncoder,
+            localEndpointing,
+            concurrentFocusAcquisition);
+        if (!m_audioInputProcessor) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioInputProcessor"));
+            return false;
+        }
+
+        m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+        /*
+         * Creating the Speech Synthesizer - This component is the Capability Agent that implements the
+         * SpeechSynthesizer interface of AVS.
+         */
+        m_speechSynthesizer = capabilityAgents::speechSynthesizer::SpeechSynthesizer::create(
+            speakMediaPlayer, m_connectionManager, m_focusManager, contextManager, attachmentManager, exceptionSender);
+        if (!m_speechSynthesizer) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSpeechSynthesizer"));
+            return false;
+        }
+
+        m_speechSynthesizer->addObserver(m_dialogUXStateAggregator);
+
+        /*
+         * Creating the Audio Player - This component is the Capability Agent that implements the AudioPlayer
+         * interface of AVS.  Products which rarely play audio may have it created with the first AudioPlayer
+         * directive instead, and report its idle state until then.
+         */
+        if (lazyCapabilityAgents) {
+            auto connectionManager = m_connectionManager;
+            auto focusManager = m_focusManager;
+            m_lazyAudioPlayer = avsCommon::avs::LazyCapabilityAgent::create(
+                "AudioPlayer",
+                capabilityAgents::audioPlayer::AudioPlayer::getDefaultConfiguration(),
+                [=]() {
+                    return capabilityAgents::audioPlayer::AudioPlayer::create(
+                        audioMediaPlayer,
+                        connectionManager,
+                        focusManager,
+                        contextManager,
+                        attachmentManager,
+                        exceptionSender);
+                },
+                contextManager,
+                capabilityAgents::audioPlayer::AudioPlayer::getIdleStates());
+        } else {
+            m_audioPlayer = capabilityAgents::audioPlayer::AudioPlayer::create(
+                audioMediaPlayer,
+                m_connectionManager,
+                m_focusManager,
+                contextManager,
+                attachmentManager,
+                exceptionSender);
+        }
+        if (!m_audioPlayer && !m_lazyAudioPlayer) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioPlayer"));
+            return false;
+        }
+
+        addConnectionObserver(m_dialogUXStateAggregator);
+
+        /*
+         * Creating the PlaybackController Capability Agent - This component is the Capability Agent that implements
+         * the PlaybackController interface of AVS.
+         */
+        m_playbackController =
+            capabilityAgents::playbackController::PlaybackController::create(contextManager, m_connectionManager);
+        if (!m_playbackController) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreatePlaybackController"));
+            return false;
+        }
+
+        /*
+         * Creating the Endpoint Handler - This component is responsible for handling directives from AVS instructing
+         * the client to change the endpoint to connect to.
+         */
+        endpointHandler = capabilityAgents::system::EndpointHandler::create(m_connectionManager, exceptionSender);
+        if (!endpointHandler) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateEndpointHandler"));
+            return false;
+        }
+
+        return true;
+    };
+
+    // A deferred stage runs on this thread when its result is collected.  A stage on a thread of its own reads the
+    // configuration this thread reads.
+    auto launchPolicy = parallelInitialization ? std::launch::async : std::launch::deferred;
+    auto configurationRoot = avsCommon::utils::configuration::ConfigurationNode::getRoot();
+    auto alertsResult = std::async(launchPolicy, [&]() {
+        avsCommon::utils::configuration::ConfigurationNode::ScopedRoot scopedRoot(configurationRoot);
+        return profiler.time("alerts", alertsStage);
+    });
+    auto settingsResult = std::async(launchPolicy, [&]() {
+        avsCommon::utils::configuration::ConfigurationNode::ScopedRoot scopedRoot(configurationRoot);
+        return profiler.time("settings", settingsStage);
+    });
+    bool stagesSucceeded = profiler.time("capabilityAgents", capabilityAgentsStage);
+
+    // Every stage is waited for, even after a failure, since they refer to the locals of this function.
+    stagesSucceeded = alertsResult.get() && stagesSucceeded;
+    stagesSucceeded = settingsResult.get() && stagesSucceeded;
+    if (!stagesSucceeded) {
         return false;
     }
 
-    /*
-     * Creating the Endpoint Handler - This component is responsible for handling directives from AVS instructing the
-     * client to change the endpoint to connect to.
-     */
-    auto endpointHandler = capabilityAgents::system::EndpointHandler::create(m_connectionManager, exceptionSender);
-    if (!endpointHandler) {
-        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateEndpointHandler"));
-        return false;
-    }
+    stageStart = avsCommon::utils::metrics::StartupProfiler::Clock::now();
 
     /*
      * The following two statements show how to register capability agents to the directive sequencer.
@@ -317,7 +611,11 @@ bool DefaultClient::initialize(
         return false;
     }
 
-    if (!m_directiveSequencer->addDirectiveHandler(m_audioPlayer)) {
+    std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> audioPlayer = m_audioPlayer;
+    if (m_lazyAudioPlayer) {
+        audioPlayer = m_lazyAudioPlayer;
+    }
+    if (!m_directiveSequencer->addDirectiveHandler(audioPlayer)) {
         ACSDK_ERROR(LX("initializeFailed")
                         .d("reason", "unableToRegisterDirectiveHandler")
                         .d("directiveHandler", "AudioPlayer"));
@@ -352,6 +650,15 @@ bool DefaultClient::initialize(
         return false;
     }
 
+    // All of the handlers have been registered, so let directives be routed to them without locking.
+    if (!m_directiveSequencer->freezeDirectiveHandlers()) {
+        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToFreezeDirectiveHandlers"));
+        return false;
+    }
+
+    profiler.record("directiveHandlers", stageStart);
+    profiler.log();
+
     return true;
 }
 
@@ -364,6 +671,10 @@ void DefaultClient::disconnect() {
     m_connectionManager->disable();
 }
 
+void DefaultClient::onNetworkAvailable() {
+    m_connectionManager->onNetworkAvailable();
+}
+
 void DefaultClient::stopForegroundActivity() {
     m_focusManager->stopForegroundActivity();
 }
@@ -388,6 +699,16 @@ void DefaultClient::removeConnectionObserver(
     m_connectionManager->removeConnectionStatusObserver(observer);
 }
 
+void DefaultClient::addNetworkQualityObserver(
+    std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface> observer) {
+    m_networkQualityEstimator->addObserver(observer);
+}
+
+void DefaultClient::removeNetworkQualityObserver(
+    std::shared_ptr<avsCommon::sdkInterfaces::NetworkQualityObserverInterface> observer) {
+    m_networkQualityEstimator->removeObserver(observer);
+}
+
 void DefaultClient::addSettingObserver(
     const std::string& key,
     std::shared_ptr<avsCommon::sdkInterfaces::SingleSettingObserverInterface> observer) {
@@ -417,17 +738,25 @@ std::future<bool> DefaultClient::notifyOfWakeWord(
     avsCommon::avs::AudioInputStream::Index beginIndex,
     avsCommon::avs::AudioInputStream::Index endIndex,
     std::string keyword) {
+    m_connectionManager->wake();
     return m_audioInputProcessor->recognize(
         wakeWordAudioProvider, capabilityAgents::aip::Initiator::WAKEWORD, beginIndex, endIndex, keyword);
 }
 
+std::future<void> DefaultClient::notifyOfPossibleWakeWord() {
+    m_connectionManager->wake();
+    return m_audioInputProcessor->prefetchContext();
+}
+
 std::future<bool> DefaultClient::notifyOfTapToTalk(
     capabilityAgents::aip::AudioProvider tapToTalkAudioProvider,
     avsCommon::avs::AudioInputStream::Index beginIndex) {
+    m_connectionManager->wake();
     return m_audioInputProcessor->recognize(tapToTalkAudioProvider, capabilityAgents::aip::Initiator::TAP, beginIndex);
 }
 
 std::future<bool> DefaultClient::notifyOfHoldToTalkStart(capabilityAgents::aip::AudioProvider holdToTalkAudioProvider) {
+    m_connectionManager->wake();
     return m_audioInputProcessor->recognize(holdToTalkAudioProvider, capabilityAgents::aip::Initiator::PRESS_AND_HOLD);
 }
 
@@ -445,6 +774,9 @@ DefaultClient::~DefaultClient() {
     if (m_audioPlayer) {
         m_audioPlayer->shutdown();
     }
+    if (m_lazyAudioPlayer) {
+        m_lazyAudioPlayer->shutdown();
+    }
     if (m_speechSynthesizer) {
         m_speechSynthesizer->shutdown();
     }
@@ -463,6 +795,9 @@ DefaultClient::~DefaultClient() {
     if (m_certifiedSender) {
         m_certifiedSender->shutdown();
     }
+    if (m_settingsStorage) {
+        m_settingsStorage->shutdown();
+    }
 }
 
 }  // namespace defaultClient
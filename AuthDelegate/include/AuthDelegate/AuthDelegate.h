@@ -24,11 +24,13 @@
 #include <mutex>
 #include <thread>
 #include <string>
-#include <unordered_set>
 
 #include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
+#include <AVSCommon/Utils/Threading/CopyOnWriteSet.h>
+#include <AVSCommon/Utils/Timing/Clock.h>
 
+#include "AuthDelegate/AuthTokenStorageInterface.h"
 #include "AuthDelegate/HttpPostInterface.h"
 
 namespace alexaClientSDK {
@@ -38,6 +40,10 @@ namespace authDelegate {
  * AuthDelegate provides an implementation of the AuthDelegateInterface. It takes a configuration that
  * specifies LWA 'client ID', 'client Secret', and 'refresh token' values and uses those to keep a
  * valid authorization token available.
+ *
+ * If the configuration also specifies a 'databaseFilePath', the most recent authorization token is kept in a
+ * @c AuthTokenStorageInterface, so that a token which is still valid when the device boots is offered to clients at
+ * once, while a fresh one is requested from LWA in the background.
  */
 class AuthDelegate : public avsCommon::sdkInterfaces::AuthDelegateInterface {
 public:
@@ -63,9 +69,13 @@ public:
      *
      * @param httpPost Instance that implement HttpPostInterface. Must not be @c nullptr. The behavior for passing in
      *     @c nullptr is undefined.
+     * @param tokenStorage The storage in which to keep the auth token across reboots.  It is only used if a
+     *     'databaseFilePath' is configured.  If @c nullptr, the auth token is not kept.
      * @return If successful, returns a new AuthDelegate, otherwise @c nullptr.
      */
-    static std::unique_ptr<AuthDelegate> create(std::unique_ptr<HttpPostInterface> httpPost);
+    static std::unique_ptr<AuthDelegate> create(
+        std::unique_ptr<HttpPostInterface> httpPost,
+        std::shared_ptr<AuthTokenStorageInterface> tokenStorage = nullptr);
 
     /**
      * Deleted copy constructor
@@ -95,8 +105,11 @@ private:
      * AuthDelegate constructor.
      *
      * @param httpPost Instance that implement HttpPostInterface. Must not be @c nullptr, or the behavior is undefined.
+     * @param tokenStorage The storage in which to keep the auth token across reboots, or @c nullptr.
      */
-    AuthDelegate(std::unique_ptr<HttpPostInterface> httpPost);
+    AuthDelegate(
+        std::unique_ptr<HttpPostInterface> httpPost,
+        std::shared_ptr<AuthTokenStorageInterface> tokenStorage);
 
     /**
      * init() is used by create() to perform initialization after construction but before returning the
@@ -106,6 +119,21 @@ private:
      */
     bool init();
 
+    /**
+     * Open @c m_tokenStorage and, if it holds an auth token obtained with the configured client ID and refresh token
+     * which has not expired yet, start from it.  It is called by @c init() before @c m_refreshAndNotifyThread starts.
+     *
+     * @param filePath The path of the database file.
+     */
+    void loadStoredAuthToken(const std::string& filePath);
+
+    /**
+     * Keep the current auth token in @c m_tokenStorage, if there is one.
+     *
+     * @param refreshToken The refresh token with which the auth token was obtained.
+     */
+    void storeAuthToken(const std::string& refreshToken);
+
     /// Method run in its own thread to refresh the auth token and notify for auth state changes.
     void refreshAndNotifyThreadFunction();
 
@@ -152,8 +180,9 @@ private:
      */
     void setState(avsCommon::sdkInterfaces::AuthObserverInterface::State newState);
 
-    /// Authorization state change observers. Access is synchronized with @c m_mutex.
-    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::AuthObserverInterface>> m_observers;
+    /// Authorization state change observers.  Changes are made, and notifications sent, while holding @c m_mutex.
+    avsCommon::utils::threading::CopyOnWriteSet<std::shared_ptr<avsCommon::sdkInterfaces::AuthObserverInterface>>
+        m_observers;
 
     /// Current state authorization. Access is synchronized with @c m_mutex.
     avsCommon::sdkInterfaces::AuthObserverInterface::State m_authState;
@@ -200,6 +229,9 @@ private:
     /// Thread for performing token refreshes and observer notifications.
     std::thread m_refreshAndNotifyThread;
 
+    /// The clock refreshes and expirations are timed with, which is the default when the delegate is created.
+    const std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
     /**
      * Time when the current value of @c m_authToken will expire.
      * Access is not synchronized because it is only accessed by @c m_refreshAndNotifyThread.
@@ -229,6 +261,12 @@ private:
      * Access is not synchronized because it is only accessed by @c m_refreshAndNotifyThread.
      */
     std::unique_ptr<HttpPostInterface> m_HttpPost;
+
+    /**
+     * Storage in which the auth token is kept across reboots, or @c nullptr if it is not kept.
+     * Access is not synchronized because it is only accessed by @c init() and then by @c m_refreshAndNotifyThread.
+     */
+    std::shared_ptr<AuthTokenStorageInterface> m_tokenStorage;
 };
 
 }  // namespace authDelegate
@@ -0,0 +1,107 @@
+/*
+ * AuthTokenStorageInterface.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTH_TOKEN_STORAGE_INTERFACE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTH_TOKEN_STORAGE_INTERFACE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/**
+ * An interface for keeping the last auth token received from LWA across restarts, so that a client can connect to
+ * AVS without waiting for a new one.
+ */
+class AuthTokenStorageInterface {
+public:
+    /// An auth token, and what is needed to tell whether it can still be used.
+    struct StoredAuthToken {
+        /// The LWA client ID the token was issued to.
+        std::string clientId;
+        /// The LWA refresh token the token was obtained with.
+        std::string refreshToken;
+        /// The auth token.
+        std::string authToken;
+        /// When the auth token expires, in seconds since the Unix epoch.
+        int64_t expirationTime_Unix;
+    };
+
+    /**
+     * Destructor.
+     */
+    virtual ~AuthTokenStorageInterface() = default;
+
+    /**
+     * Creates a new database with the given filepath.  If the file specified already exists, or if a database is
+     * already being handled by this object, then this function returns false.
+     *
+     * @param filePath The path to the file which will be used to contain the database.
+     * @return Whether the database was created.
+     */
+    virtual bool createDatabase(const std::string& filePath) = 0;
+
+    /**
+     * Open a database with the given filepath.  If this object is already managing an open database, or the file
+     * does not exist, or there is a problem opening the database, this function returns false.
+     *
+     * @param filePath The path to the file which will be used to contain the database.
+     * @return Whether the database was opened.
+     */
+    virtual bool open(const std::string& filePath) = 0;
+
+    /**
+     * Query if this object is currently managing an open database.
+     *
+     * @return Whether a database is open.
+     */
+    virtual bool isOpen() = 0;
+
+    /**
+     * Close the currently open database, if one is open.
+     */
+    virtual void close() = 0;
+
+    /**
+     * Store an auth token, replacing the one stored before, if any.
+     *
+     * @param token The auth token to store.
+     * @return Whether the auth token was stored.
+     */
+    virtual bool store(const StoredAuthToken& token) = 0;
+
+    /**
+     * Load the stored auth token.
+     *
+     * @param[out] token The stored auth token.
+     * @return Whether an auth token is stored and was loaded.
+     */
+    virtual bool load(StoredAuthToken* token) = 0;
+
+    /**
+     * Erase the stored auth token, if any.
+     *
+     * @return Whether the database was cleared.
+     */
+    virtual bool clear() = 0;
+};
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTH_TOKEN_STORAGE_INTERFACE_H_
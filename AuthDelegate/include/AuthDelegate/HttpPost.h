@@ -25,12 +25,21 @@
 #include <mutex>
 #include <string>
 
+#include <ACL/Transport/LibCurlHttpContentFetchService.h>
+
 #include "AuthDelegate/HttpPostInterface.h"
 
 namespace alexaClientSDK {
 namespace authDelegate {
 
-/// LIBCURL based implementation of HttpPostInterface.
+/**
+ * LIBCURL based implementation of HttpPostInterface.
+ *
+ * Every request is made with the same @c libcurl handle, so successive requests to LWA (refreshes and their retries)
+ * reuse the connection while the server keeps it open.  If a @c LibCurlHttpContentFetchService is given, requests
+ * run on its thread and share its connection cache, and @c doPostAsync() does not block the caller.  Only one
+ * request runs at a time.
+ */
 class HttpPost : public HttpPostInterface {
 public:
     /// HttpPost destructor
@@ -54,20 +63,27 @@ public:
     /**
      * Create a new HttpPost instance, passing ownership of the new instance on to the caller.
      *
+     * @param service The service to run the requests on.  If @c nullptr, requests run on the calling thread.
      * @return Retruns an std::unique_ptr to the new HttpPost instance, or @c nullptr of the operation failed.
      */
-    static std::unique_ptr<HttpPost> create();
+    static std::unique_ptr<HttpPost> create(std::shared_ptr<acl::LibCurlHttpContentFetchService> service = nullptr);
 
     long doPost(const std::string& m_url, const std::string& data, std::chrono::seconds timeout, std::string& body)
         override;
 
+    bool doPostAsync(
+        const std::string& url,
+        const std::string& data,
+        std::chrono::seconds timeout,
+        ResponseCallback callback) override;
+
 private:
     /**
      * HttpPost constructor.
      *
-     * @param curl CURL handle with which to make requests.
+     * @param service The service to run the requests on, or @c nullptr.
      */
-    HttpPost();
+    HttpPost(std::shared_ptr<acl::LibCurlHttpContentFetchService> service);
 
     /**
      * init() is used by create() to perform initialization after construction but before returning the
@@ -87,6 +103,29 @@ private:
     template <typename ParamType>
     bool setopt(CURLoption option, ParamType param);
 
+    /**
+     * Set the options of a request on @c m_curl.  This is called with @c m_mutex held.
+     *
+     * @param url The URL to send the POST to.
+     * @param data The POST data to send in the request.  It must stay valid until the request completes.
+     * @param timeout The maximum amount of time (in seconds) to wait for the request to complete.
+     * @param body The string to receive the body of the response.  It must stay valid until the request completes.
+     * @return @c true if the options were set.
+     */
+    bool prepareRequestLocked(
+        const std::string& url,
+        const std::string& data,
+        std::chrono::seconds timeout,
+        std::string* body);
+
+    /**
+     * Get the HTTP response code of the request which has just completed.  This is called with @c m_mutex held.
+     *
+     * @param result The result of the transfer.
+     * @return The response code, or @c HTTP_RESPONSE_CODE_UNDEFINED if the request failed.
+     */
+    long getResponseCodeLocked(CURLcode result);
+
     /**
      * Callback function used to accumulate the body of the HTTP Post response
      * This is called when doPost() is holding @c m_mutex.
@@ -99,14 +138,23 @@ private:
      */
     static size_t staticWriteCallbackLocked(char* ptr, size_t size, size_t nmemb, void* userdata);
 
-    /// Mutex to serialize access to @c m_curl and @c m_response.
+    /// Mutex to serialize access to @c m_curl, @c m_postData, @c m_bodyAccumulator and @c m_isTransferActive.
     std::mutex m_mutex;
 
     /// CURL handle with which to make requests
     CURL* m_curl;
 
+    /// The service the requests run on, or @c nullptr if they run on the calling thread.
+    std::shared_ptr<acl::LibCurlHttpContentFetchService> m_service;
+
+    /// The POST data of the request running on @c m_service.
+    std::string m_postData;
+
     /// String used to accumuate the response body.
     std::string m_bodyAccumulator;
+
+    /// Whether a request is running on @c m_service.
+    bool m_isTransferActive;
 };
 
 }  // namespace authDelegate
@@ -19,6 +19,7 @@
 #define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_HTTP_POST_INTERFACE_H_
 
 #include <chrono>
+#include <functional>
 #include <string>
 
 namespace alexaClientSDK {
@@ -33,6 +34,14 @@ public:
     /// The HTTP response code for successful response.
     static const long HTTP_RESPONSE_CODE_SUCCESS_OK = 200;
 
+    /**
+     * Callback called when a request started by @c doPostAsync() completes.
+     *
+     * @param code A HttpStatus indicating the disposition of the Post request.
+     * @param body The body of the response if there is one.
+     */
+    using ResponseCallback = std::function<void(long code, const std::string& body)>;
+
     /// Virtual destructor to assure proper cleanup of derived types.
     virtual ~HttpPostInterface() = default;
 
@@ -51,8 +60,39 @@ public:
         const std::string& data,
         std::chrono::seconds timeout,
         std::string& body) = 0;
+
+    /**
+     * Start an HTTP Post request, and call @c callback with the response once it completes.  The default
+     * implementation performs the request with @c doPost() and calls @c callback before returning; implementations
+     * which can run requests in the background override it.
+     *
+     * @param url The URL to send the POST to.
+     * @param data The POST data to send in the request.
+     * @param timeout The maximum amount of time (in seconds) to wait for the request to complete.
+     * @param callback The callback to call with the response.  It may be called on another thread.
+     * @return Whether the request was started.  If not, @c callback is not called.
+     */
+    virtual bool doPostAsync(
+        const std::string& url,
+        const std::string& data,
+        std::chrono::seconds timeout,
+        ResponseCallback callback);
 };
 
+inline bool HttpPostInterface::doPostAsync(
+    const std::string& url,
+    const std::string& data,
+    std::chrono::seconds timeout,
+    ResponseCallback callback) {
+    if (!callback) {
+        return false;
+    }
+    std::string body;
+    auto code = doPost(url, data, timeout, body);
+    callback(code, body);
+    return true;
+}
+
 }  // namespace authDelegate
 }  // namespace alexaClientSDK
 
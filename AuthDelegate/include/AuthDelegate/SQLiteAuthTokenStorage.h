@@ -0,0 +1,73 @@
+/*
+ * SQLiteAuthTokenStorage.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_SQLITE_AUTH_TOKEN_STORAGE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_SQLITE_AUTH_TOKEN_STORAGE_H_
+
+#include <sqlite3.h>
+
+#include <SQLiteStorage/SQLiteStatementCache.h>
+
+#include "AuthDelegate/AuthTokenStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/**
+ * An implementation that allows us to store the auth token using SQLite.  The database file is only readable and
+ * writable by its owner, since it holds credentials.
+ *
+ * This class is not thread-safe.
+ */
+class SQLiteAuthTokenStorage : public AuthTokenStorageInterface {
+public:
+    /**
+     * Constructor.
+     */
+    SQLiteAuthTokenStorage();
+
+    /**
+     * Destructor.
+     */
+    ~SQLiteAuthTokenStorage();
+
+    bool createDatabase(const std::string& filePath) override;
+
+    bool open(const std::string& filePath) override;
+
+    bool isOpen() override;
+
+    void close() override;
+
+    bool store(const StoredAuthToken& token) override;
+
+    bool load(StoredAuthToken* token) override;
+
+    bool clear() override;
+
+private:
+    /// The sqlite database handle.
+    sqlite3* m_dbHandle;
+
+    /// The statements run repeatedly on @c m_dbHandle, prepared once per connection.
+    storage::sqliteStorage::SQLiteStatementCache m_statementCache;
+};
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_SQLITE_AUTH_TOKEN_STORAGE_H_
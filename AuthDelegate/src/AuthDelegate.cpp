@@ -26,9 +26,11 @@
 #include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Timing/TimeUtils.h>
 
 #include "AuthDelegate/AuthDelegate.h"
 #include "AuthDelegate/HttpPost.h"
+#include "AuthDelegate/SQLiteAuthTokenStorage.h"
 
 namespace alexaClientSDK {
 namespace authDelegate {
@@ -66,6 +68,9 @@ const char* CONFIG_KEY_REQUEST_TIMEOUT = "requestTimeout";
 /// Name of authTokenRefreshHeadStart value in AuthDelegate's @c ConfigurationNode.
 const char* CONFIG_KEY_AUTH_TOKEN_REFRESH_HEAD_START = "authTokenRefreshHeadStart";
 
+/// Name of databaseFilePath value in AuthDelegate's @c ConfigurationNode.
+const char* CONFIG_KEY_DATABASE_FILE_PATH = "databaseFilePath";
+
 /// Default value for lwaURL.
 static const std::string DEFAULT_LWA_URL = "https://api.amazon.com/auth/o2/token";
 
@@ -96,6 +101,19 @@ static const std::string JSON_KEY_EXPIRES_IN = "expires_in";
 /// This is the property name in the JSON which refers to the error.
 static const std::string JSON_KEY_ERROR = "error";
 
+/**
+ * A response from LWA, filled in by the callback of @c HttpPostInterface::doPostAsync().  Access is synchronized with
+ * @c AuthDelegate::m_mutex.
+ */
+struct LwaResponse {
+    /// Whether the response has been received.
+    bool isReady = false;
+    /// The HTTP response code.
+    long code = HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED;
+    /// The body of the response.
+    std::string body;
+};
+
 /**
  * Lookup table for recoverable errors from LWA error codes
  * (@see https://images-na.ssl-images-amazon.com/images/G/01/lwa/dev/docs/website-developer-guide._TTH_.pdf)
@@ -171,9 +189,12 @@ static AuthObserverInterface::Error getErrorCode(const std::string& error) {
  * Function to convert the number of times we have already retried to the time to perform the next retry.
  *
  * @param retryCount The number of times we have retried
+ * @param now The current time.
  * @return The time that the next retry should be attempted
  */
-static std::chrono::steady_clock::time_point calculateTimeToRetry(int retryCount) {
+static std::chrono::steady_clock::time_point calculateTimeToRetry(
+    int retryCount,
+    std::chrono::steady_clock::time_point now) {
     /**
      * Table of retry backoff values based upon page 77 of
      * @see https://images-na.ssl-images-amazon.com/images/G/01/mwsportal/
@@ -211,32 +232,38 @@ static std::chrono::steady_clock::time_point calculateTimeToRetry(int retryCount
     auto delayMs = std::chrono::milliseconds(distribution(generator));
     ACSDK_DEBUG(LX("calculatedTimeToRetry").d("delayMs", delayMs.count()));
 
-    return std::chrono::steady_clock::now() + delayMs;
+    return now + delayMs;
 }
 
 std::unique_ptr<AuthDelegate> AuthDelegate::create() {
-    return AuthDelegate::create(HttpPost::create());
+    return AuthDelegate::create(HttpPost::create(), std::make_shared<SQLiteAuthTokenStorage>());
 }
 
-std::unique_ptr<AuthDelegate> AuthDelegate::create(std::unique_ptr<HttpPostInterface> httpPost) {
+std::unique_ptr<AuthDelegate> AuthDelegate::create(
+    std::unique_ptr<HttpPostInterface> httpPost,
+    std::shared_ptr<AuthTokenStorageInterface> tokenStorage) {
     if (!avsCommon::avs::initialization::AlexaClientSDKInit::isInitialized()) {
         ACSDK_ERROR(LX("createFailed").d("reason", "sdkNotInitialized"));
         return nullptr;
     }
-    std::unique_ptr<AuthDelegate> instance(new AuthDelegate(std::move(httpPost)));
+    std::unique_ptr<AuthDelegate> instance(new AuthDelegate(std::move(httpPost), tokenStorage));
     if (instance->init()) {
         return instance;
     }
     return nullptr;
 }
 
-AuthDelegate::AuthDelegate(std::unique_ptr<HttpPostInterface> httpPost) :
+AuthDelegate::AuthDelegate(
+    std::unique_ptr<HttpPostInterface> httpPost,
+    std::shared_ptr<AuthTokenStorageInterface> tokenStorage) :
         m_authState{AuthObserverInterface::State::UNINITIALIZED},
         m_authError{AuthObserverInterface::Error::NO_ERROR},
         m_isStopping{false},
+        m_clock{avsCommon::utils::timing::Clock::getDefault()},
         m_expirationTime{std::chrono::time_point<std::chrono::steady_clock>::max()},
         m_retryCount{0},
-        m_HttpPost{std::move(httpPost)} {
+        m_HttpPost{std::move(httpPost)},
+        m_tokenStorage{tokenStorage} {
 }
 
 AuthDelegate::~AuthDelegate() {
@@ -248,6 +275,9 @@ AuthDelegate::~AuthDelegate() {
     if (m_refreshAndNotifyThread.joinable()) {
         m_refreshAndNotifyThread.join();
     }
+    if (m_tokenStorage) {
+        m_tokenStorage->close();
+    }
 }
 
 void AuthDelegate::addAuthObserver(std::shared_ptr<AuthObserverInterface> observer) {
@@ -256,7 +286,7 @@ void AuthDelegate::addAuthObserver(std::shared_ptr<AuthObserverInterface> observ
         return;
     }
 
-    if (!m_observers.insert(observer).second) {
+    if (!m_observers.insert(observer)) {
         return;
     }
 
@@ -311,10 +341,88 @@ bool AuthDelegate::init() {
         return false;
     }
 
+    std::string databaseFilePath;
+    if (m_tokenStorage && configuration.getString(CONFIG_KEY_DATABASE_FILE_PATH, &databaseFilePath) &&
+        !databaseFilePath.empty()) {
+        loadStoredAuthToken(databaseFilePath);
+    } else {
+        m_tokenStorage.reset();
+    }
+
     m_refreshAndNotifyThread = std::thread(&AuthDelegate::refreshAndNotifyThreadFunction, this);
     return true;
 }
 
+void AuthDelegate::loadStoredAuthToken(const std::string& filePath) {
+    if (!m_tokenStorage->open(filePath) && !m_tokenStorage->createDatabase(filePath)) {
+        ACSDK_ERROR(LX("loadStoredAuthTokenFailed").d("reason", "openDatabaseFailed").d("filePath", filePath));
+        m_tokenStorage.reset();
+        return;
+    }
+
+    AuthTokenStorageInterface::StoredAuthToken token;
+    if (!m_tokenStorage->load(&token)) {
+        ACSDK_DEBUG(LX("loadStoredAuthToken").d("reason", "noStoredAuthToken"));
+        return;
+    }
+
+    if (token.clientId != m_clientId || token.refreshToken != m_refreshToken) {
+        ACSDK_INFO(LX("loadStoredAuthToken").d("reason", "credentialsChanged").d("action", "discardStoredAuthToken"));
+        m_tokenStorage->clear();
+        return;
+    }
+
+    int64_t now_Unix = 0;
+    if (!avsCommon::utils::timing::getCurrentUnixTime(&now_Unix)) {
+        ACSDK_ERROR(LX("loadStoredAuthTokenFailed").d("reason", "getCurrentUnixTimeFailed"));
+        return;
+    }
+
+    if (token.authToken.empty() || token.expirationTime_Unix <= now_Unix) {
+        ACSDK_DEBUG(LX("loadStoredAuthToken").d("reason", "storedAuthTokenExpired"));
+        return;
+    }
+
+    auto timeUntilExpired = std::chrono::seconds(token.expirationTime_Unix - now_Unix);
+    ACSDK_DEBUG(LX("loadStoredAuthTokenSucceeded")
+                    .sensitive("authToken", token.authToken)
+                    .d("expiresInSeconds", timeUntilExpired.count()));
+
+    // Start as if the token had just been refreshed.  If it expires within the refresh head start, the refresh
+    // thread requests a new one at once.
+    m_expirationTime = m_clock->now() + timeUntilExpired;
+    m_timeToRefresh = m_expirationTime - m_authTokenRefreshHeadStart;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_authToken = token.authToken;
+    m_authState = AuthObserverInterface::State::REFRESHED;
+}
+
+void AuthDelegate::storeAuthToken(const std::string& refreshToken) {
+    if (!m_tokenStorage) {
+        return;
+    }
+
+    int64_t now_Unix = 0;
+    if (!avsCommon::utils::timing::getCurrentUnixTime(&now_Unix)) {
+        ACSDK_ERROR(LX("storeAuthTokenFailed").d("reason", "getCurrentUnixTimeFailed"));
+        return;
+    }
+
+    AuthTokenStorageInterface::StoredAuthToken token;
+    token.clientId = m_clientId;
+    token.refreshToken = refreshToken;
+    token.expirationTime_Unix =
+        now_Unix +
+        std::chrono::duration_cast<std::chrono::seconds>(m_expirationTime - m_clock->now()).count();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        token.authToken = m_authToken;
+    }
+    if (!m_tokenStorage->store(token)) {
+        ACSDK_ERROR(LX("storeAuthTokenFailed").d("reason", "storeFailed"));
+    }
+}
+
 void AuthDelegate::refreshAndNotifyThreadFunction() {
     std::function<bool()> isStopping = [this] { return m_isStopping; };
 
@@ -326,7 +434,7 @@ void AuthDelegate::refreshAndNotifyThreadFunction() {
         auto nextState = m_authState;
 
         // Wait for an appropriate amount of time.
-        if (m_wakeThreadCond.wait_until(lock, nextActionTime, isStopping)) {
+        if (m_clock->waitUntil(m_wakeThreadCond, lock, nextActionTime, isStopping)) {
             break;
         }
         if (isAboutToExpire) {
@@ -345,7 +453,7 @@ void AuthDelegate::refreshAndNotifyThreadFunction() {
 
 AuthObserverInterface::Error AuthDelegate::refreshAuthToken() {
     // Don't wait for this request so long that we would be late to notify our observer if the token expires.
-    m_requestTime = std::chrono::steady_clock::now();
+    m_requestTime = m_clock->now();
     auto timeout = m_requestTimeout;
     if (AuthObserverInterface::State::REFRESHED == m_authState) {
         auto timeUntilExpired = std::chrono::duration_cast<std::chrono::seconds>(m_expirationTime - m_requestTime);
@@ -354,18 +462,41 @@ AuthObserverInterface::Error AuthDelegate::refreshAuthToken() {
         }
     }
 
+    // handleLwaResponse() replaces m_refreshToken, but the stored auth token is keyed on the one it was obtained with.
+    auto refreshToken = m_refreshToken;
     std::ostringstream postData;
     postData << POST_DATA_UP_TO_CLIENT_ID << m_clientId << POST_DATA_BETWEEN_CLIENT_ID_AND_REFRESH_TOKEN
-             << m_refreshToken << POST_DATA_BETWEEN_REFRESH_TOKEN_AND_CLIENT_SECRET << m_clientSecret;
+             << refreshToken << POST_DATA_BETWEEN_REFRESH_TOKEN_AND_CLIENT_SECRET << m_clientSecret;
 
+    // Wait for the response here rather than in doPost(), so that stopping is not held up by a request in flight.
+    auto response = std::make_shared<LwaResponse>();
+    auto onResponse = [this, response](long code, const std::string& body) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        response->code = code;
+        response->body = body;
+        response->isReady = true;
+        m_wakeThreadCond.notify_all();
+    };
+    bool isResponseReady = false;
+    long code = HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED;
     std::string body;
-    auto code = m_HttpPost->doPost(m_lwaUrl, postData.str(), timeout, body);
-    auto newError = handleLwaResponse(code, body);
+    if (m_HttpPost->doPostAsync(m_lwaUrl, postData.str(), timeout, onResponse)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeThreadCond.wait(lock, [this, response]() { return response->isReady || m_isStopping; });
+        isResponseReady = response->isReady;
+        code = response->code;
+        body.swap(response->body);
+    }
+    auto newError = isResponseReady ? handleLwaResponse(code, body) : AuthObserverInterface::Error::UNKNOWN_ERROR;
 
     if (AuthObserverInterface::Error::NO_ERROR == newError) {
         m_retryCount = 0;
+        storeAuthToken(refreshToken);
     } else {
-        m_timeToRefresh = calculateTimeToRetry(m_retryCount++);
+        if (isUnrecoverable(newError) && m_tokenStorage) {
+            m_tokenStorage->clear();
+        }
+        m_timeToRefresh = calculateTimeToRetry(m_retryCount++, m_clock->now());
     }
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -445,7 +576,7 @@ AuthObserverInterface::Error AuthDelegate::handleLwaResponse(long code, const st
 }
 
 bool AuthDelegate::hasAuthTokenExpired() {
-    return std::chrono::steady_clock::now() >= m_expirationTime;
+    return m_clock->now() >= m_expirationTime;
 }
 
 void AuthDelegate::setState(AuthObserverInterface::State newState) {
@@ -459,7 +590,8 @@ void AuthDelegate::setState(AuthObserverInterface::State newState) {
 
     if (m_authState != newState) {
         m_authState = newState;
-        for (auto observer : m_observers) {
+        auto observers = m_observers.snapshot();
+        for (const auto& observer : *observers) {
             ACSDK_DEBUG(LX("onAuthStateChangeCalled").d("state", (int)m_authState).d("error", (int)m_authError));
             observer->onAuthStateChange(m_authState, m_authError);
         }
@@ -15,6 +15,8 @@
  * permissions and limitations under the License.
  */
 
+#include <future>
+
 #include <AVSCommon/Utils/LibcurlUtils/LibcurlUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
@@ -35,15 +37,18 @@ static const std::string TAG("HttpPost");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-std::unique_ptr<HttpPost> HttpPost::create() {
-    std::unique_ptr<HttpPost> httpPost(new HttpPost());
+std::unique_ptr<HttpPost> HttpPost::create(std::shared_ptr<acl::LibCurlHttpContentFetchService> service) {
+    std::unique_ptr<HttpPost> httpPost(new HttpPost(service));
     if (httpPost->init()) {
         return httpPost;
     }
     return nullptr;
 }
 
-HttpPost::HttpPost() : m_curl{nullptr} {
+HttpPost::HttpPost(std::shared_ptr<acl::LibCurlHttpContentFetchService> service) :
+        m_curl{nullptr},
+        m_service{service},
+        m_isTransferActive{false} {
 }
 
 bool HttpPost::init() {
@@ -58,10 +63,17 @@ bool HttpPost::init() {
     if (!setopt(CURLOPT_WRITEFUNCTION, staticWriteCallbackLocked)) {
         return false;
     }
+    // Refreshes are far apart, so probe the idle connection to keep it (and any NAT mapping) alive in between.
+    if (!setopt(CURLOPT_TCP_KEEPALIVE, 1L)) {
+        return false;
+    }
     return true;
 }
 
 HttpPost::~HttpPost() {
+    if (m_service && m_curl) {
+        m_service->removeTransfer(m_curl);
+    }
     if (m_curl) {
         curl_easy_cleanup(m_curl);
     }
@@ -72,23 +84,97 @@ long HttpPost::doPost(
     const std::string& data,
     std::chrono::seconds timeout,
     std::string& body) {
+    if (m_service) {
+        std::promise<long> codePromise;
+        auto onResponse = [&codePromise, &body](long code, const std::string& responseBody) {
+            body = responseBody;
+            codePromise.set_value(code);
+        };
+        if (!doPostAsync(url, data, timeout, onResponse)) {
+            body.clear();
+            return HTTP_RESPONSE_CODE_UNDEFINED;
+        }
+        return codePromise.get_future().get();
+    }
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     body.clear();
 
-    if (!setopt(CURLOPT_TIMEOUT, static_cast<long>(timeout.count())) || !setopt(CURLOPT_URL, url.c_str()) ||
-        !setopt(CURLOPT_POSTFIELDS, data.c_str()) || !setopt(CURLOPT_WRITEDATA, &body)) {
+    if (!prepareRequestLocked(url, data, timeout, &body)) {
         return HTTP_RESPONSE_CODE_UNDEFINED;
     }
 
     auto result = curl_easy_perform(m_curl);
+    auto responseCode = getResponseCodeLocked(result);
+    if (HTTP_RESPONSE_CODE_UNDEFINED == responseCode) {
+        body.clear();
+    }
+    return responseCode;
+}
 
+bool HttpPost::doPostAsync(
+    const std::string& url,
+    const std::string& data,
+    std::chrono::seconds timeout,
+    ResponseCallback callback) {
+    if (!m_service) {
+        return HttpPostInterface::doPostAsync(url, data, timeout, callback);
+    }
+    if (!callback) {
+        ACSDK_ERROR(LX("doPostAsyncFailed").d("reason", "nullCallback"));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isTransferActive) {
+        ACSDK_ERROR(LX("doPostAsyncFailed").d("reason", "requestAlreadyRunning"));
+        return false;
+    }
+
+    // libcurl does not copy the POST data, so keep it until the request completes.
+    m_postData = data;
+    m_bodyAccumulator.clear();
+    if (!prepareRequestLocked(url, m_postData, timeout, &m_bodyAccumulator)) {
+        return false;
+    }
+
+    // Called on the thread of m_service, which removeTransfer() in the destructor waits for.
+    auto onTransferDone = [this, callback](CURLcode result) {
+        long responseCode = HTTP_RESPONSE_CODE_UNDEFINED;
+        std::string body;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isTransferActive = false;
+            responseCode = getResponseCodeLocked(result);
+            if (HTTP_RESPONSE_CODE_UNDEFINED != responseCode) {
+                body.swap(m_bodyAccumulator);
+            }
+        }
+        callback(responseCode, body);
+    };
+    m_isTransferActive = m_service->addTransfer(m_curl, onTransferDone);
+    if (!m_isTransferActive) {
+        ACSDK_ERROR(LX("doPostAsyncFailed").d("reason", "addTransferFailed"));
+    }
+    return m_isTransferActive;
+}
+
+bool HttpPost::prepareRequestLocked(
+    const std::string& url,
+    const std::string& data,
+    std::chrono::seconds timeout,
+    std::string* body) {
+    return setopt(CURLOPT_TIMEOUT, static_cast<long>(timeout.count())) && setopt(CURLOPT_URL, url.c_str()) &&
+           setopt(CURLOPT_POSTFIELDS, data.c_str()) && setopt(CURLOPT_WRITEDATA, body);
+}
+
+long HttpPost::getResponseCodeLocked(CURLcode result) {
     if (result != CURLE_OK) {
         ACSDK_ERROR(LX("doPostFailed")
-                        .d("reason", "curl_easy_performFailed")
+                        .d("reason", "transferFailed")
                         .d("result", result)
                         .d("error", curl_easy_strerror(result)));
-        body.clear();
         return HTTP_RESPONSE_CODE_UNDEFINED;
     }
 
@@ -100,7 +186,6 @@ long HttpPost::doPost(
                         .d("property", "CURLINFO_RESPONSE_CODE")
                         .d("result", result)
                         .d("error", curl_easy_strerror(result)));
-        body.clear();
         return HTTP_RESPONSE_CODE_UNDEFINED;
     } else {
         ACSDK_DEBUG(LX("doPostSucceeded").d("code", responseCode));
@@ -0,0 +1,235 @@
+/*
+ * SQLiteAuthTokenStorage.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sys/stat.h>
+
+#include <SQLiteStorage/SQLiteStatement.h>
+#include <SQLiteStorage/SQLiteUtils.h>
+#include <AVSCommon/Utils/File/FileUtils.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AuthDelegate/SQLiteAuthTokenStorage.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+using namespace avsCommon::utils::file;
+using namespace alexaClientSDK::storage::sqliteStorage;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SQLiteAuthTokenStorage");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The name of the auth token table.
+static const std::string AUTH_TOKEN_TABLE_NAME = "authToken";
+/// The id of the single row of the auth token table.
+static const int AUTH_TOKEN_ROW_ID = 1;
+/// The SQL string to create the auth token table.
+static const std::string CREATE_AUTH_TOKEN_TABLE_SQL_STRING = "CREATE TABLE " + AUTH_TOKEN_TABLE_NAME + " (" +
+                                                              "id INT PRIMARY KEY NOT NULL," +
+                                                              "client_id TEXT NOT NULL," +
+                                                              "refresh_token TEXT NOT NULL," +
+                                                              "auth_token TEXT NOT NULL," +
+                                                              "expiration_time_unix INT NOT NULL);";
+/// The SQL string to store the auth token.
+static const std::string STORE_AUTH_TOKEN_SQL_STRING =
+    "INSERT OR REPLACE INTO " + AUTH_TOKEN_TABLE_NAME +
+    " (id, client_id, refresh_token, auth_token, expiration_time_unix) VALUES (?, ?, ?, ?, ?);";
+/// The SQL string to load the auth token.
+static const std::string LOAD_AUTH_TOKEN_SQL_STRING = "SELECT client_id, refresh_token, auth_token, "
+                                                      "expiration_time_unix FROM " +
+                                                      AUTH_TOKEN_TABLE_NAME + " WHERE id=?;";
+
+/// The ids of the statements kept in the statement cache.
+enum StatementId {
+    /// The statement running @c STORE_AUTH_TOKEN_SQL_STRING.
+    STORE_AUTH_TOKEN_STATEMENT_ID,
+    /// The statement running @c LOAD_AUTH_TOKEN_SQL_STRING.
+    LOAD_AUTH_TOKEN_STATEMENT_ID
+};
+
+SQLiteAuthTokenStorage::SQLiteAuthTokenStorage() : m_dbHandle{nullptr} {
+}
+
+SQLiteAuthTokenStorage::~SQLiteAuthTokenStorage() {
+    close();
+}
+
+bool SQLiteAuthTokenStorage::createDatabase(const std::string& filePath) {
+    if (m_dbHandle) {
+        ACSDK_ERROR(LX("createDatabaseFailed").d("reason", "DatabaseHandleAlreadyOpen"));
+        return false;
+    }
+
+    if (fileExists(filePath)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").d("reason", "FileAlreadyExists").d("filePath", filePath));
+        return false;
+    }
+
+    m_dbHandle = createSQLiteDatabase(filePath);
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("createDatabaseFailed").d("reason", "SQLiteCreateDatabaseFailed").d("filePath", filePath));
+        return false;
+    }
+
+    if (chmod(filePath.c_str(), S_IRUSR | S_IWUSR) != 0) {
+        ACSDK_WARN(LX("createDatabaseWarning").d("reason", "chmodFailed").d("filePath", filePath));
+    }
+
+    if (!performQuery(m_dbHandle, CREATE_AUTH_TOKEN_TABLE_SQL_STRING)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").d("reason", "PerformQueryFailed"));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::open(const std::string& filePath) {
+    if (m_dbHandle) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "DatabaseHandleAlreadyOpen"));
+        return false;
+    }
+
+    if (!fileExists(filePath)) {
+        ACSDK_DEBUG(LX("openFailed").d("reason", "FileDoesNotExist").d("filePath", filePath));
+        return false;
+    }
+
+    m_dbHandle = openSQLiteDatabase(filePath);
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "openSQLiteDatabaseFailed").d("filePath", filePath));
+        return false;
+    }
+
+    if (!tableExists(m_dbHandle, AUTH_TOKEN_TABLE_NAME)) {
+        ACSDK_ERROR(LX("openFailed").d("reason", "AuthTokenTableDoesNotExist").d("filePath", filePath));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::isOpen() {
+    return (nullptr != m_dbHandle);
+}
+
+void SQLiteAuthTokenStorage::close() {
+    if (m_dbHandle) {
+        m_statementCache.clear();
+        closeSQLiteDatabase(m_dbHandle);
+        m_dbHandle = nullptr;
+    }
+}
+
+bool SQLiteAuthTokenStorage::store(const StoredAuthToken& token) {
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "DatabaseHandleNotOpen"));
+        return false;
+    }
+
+    auto statement = m_statementCache.get(m_dbHandle, STORE_AUTH_TOKEN_STATEMENT_ID, STORE_AUTH_TOKEN_SQL_STRING);
+
+    if (!statement.isValid()) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "SQliteStatementInvalid"));
+        return false;
+    }
+
+    int boundParam = 1;
+    if (!statement->bindIntParameter(boundParam++, AUTH_TOKEN_ROW_ID) ||
+        !statement->bindStringParameter(boundParam++, token.clientId) ||
+        !statement->bindStringParameter(boundParam++, token.refreshToken) ||
+        !statement->bindStringParameter(boundParam++, token.authToken) ||
+        !statement->bindInt64Parameter(boundParam, token.expirationTime_Unix)) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "BindParameterFailed"));
+        return false;
+    }
+
+    if (!statement->step()) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "StepToRowFailed"));
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::load(StoredAuthToken* token) {
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "DatabaseHandleNotOpen"));
+        return false;
+    }
+
+    if (!token) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "tokenNullReference"));
+        return false;
+    }
+
+    auto statement = m_statementCache.get(m_dbHandle, LOAD_AUTH_TOKEN_STATEMENT_ID, LOAD_AUTH_TOKEN_SQL_STRING);
+
+    if (!statement.isValid()) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "SQliteStatementInvalid"));
+        return false;
+    }
+
+    int boundParam = 1;
+    if (!statement->bindIntParameter(boundParam, AUTH_TOKEN_ROW_ID)) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "BindParameterFailed"));
+        return false;
+    }
+
+    if (!statement->step()) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "StepToRowFailed"));
+        return false;
+    }
+
+    if (SQLITE_ROW != statement->getStepResult()) {
+        // no token has been stored.
+        return false;
+    }
+
+    // The columns are in the order of LOAD_AUTH_TOKEN_SQL_STRING.
+    token->clientId = statement->getColumnText(0);
+    token->refreshToken = statement->getColumnText(1);
+    token->authToken = statement->getColumnText(2);
+    token->expirationTime_Unix = statement->getColumnInt64(3);
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::clear() {
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("clearFailed").d("reason", "DatabaseHandleNotOpen"));
+        return false;
+    }
+
+    if (!clearTable(m_dbHandle, AUTH_TOKEN_TABLE_NAME)) {
+        ACSDK_ERROR(LX("clearFailed").d("reason", "SqliteClearTableFailed"));
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
@@ -19,6 +19,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <gmock/gmock.h>
@@ -27,6 +28,7 @@
 #include "AuthDelegate/AuthDelegate.h"
 #include "AuthDelegate/MockHttpPost.h"
 #include "AVSCommon/AVS/Initialization/AlexaClientSDKInit.h"
+#include "AVSCommon/Utils/Timing/TimeUtils.h"
 #include "MockAuthObserver.h"
 
 using namespace alexaClientSDK::authDelegate;
@@ -64,6 +66,137 @@ static const std::string DEFAULT_SDK_CONFIGURATION = R"({
     }
 })";
 
+/// Configuration overlay which keeps the auth token in a database.
+static const std::string DATABASE_SDK_CONFIGURATION = R"({
+    "authDelegate" : {
+        "databaseFilePath" : "authToken.db"
+    }
+})";
+
+/// The client ID of @c DEFAULT_SDK_CONFIGURATION.
+static const std::string CONFIGURED_CLIENT_ID = "invalid clientId";
+
+/// The refresh token of @c DEFAULT_SDK_CONFIGURATION.
+static const std::string CONFIGURED_REFRESH_TOKEN = "invalid refreshToken";
+
+/// An auth token kept by a previous run.
+static const std::string STORED_AUTH_TOKEN = "Atza|stored";
+
+/// The auth token of the responses generated by @c generateValidLwaResponseWithExpiration().
+static const std::string REFRESHED_AUTH_TOKEN = "Atza|IQEBLjAsAhQ3yD47Jkj09BfU_qgNk4";
+
+/// An in-memory @c AuthTokenStorageInterface.
+class FakeAuthTokenStorage : public AuthTokenStorageInterface {
+public:
+    FakeAuthTokenStorage() : m_isOpen{false}, m_hasToken{false} {
+    }
+
+    bool createDatabase(const std::string& filePath) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = true;
+        return true;
+    }
+
+    bool open(const std::string& filePath) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = true;
+        return true;
+    }
+
+    bool isOpen() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_isOpen;
+    }
+
+    void close() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = false;
+    }
+
+    bool store(const StoredAuthToken& token) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_token = token;
+        m_hasToken = true;
+        return true;
+    }
+
+    bool load(StoredAuthToken* token) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_hasToken) {
+            *token = m_token;
+        }
+        return m_hasToken;
+    }
+
+    bool clear() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasToken = false;
+        return true;
+    }
+
+    /**
+     * Keep an auth token which expires after the given time.
+     *
+     * @param clientId The client ID the token was obtained with.
+     * @param expiresIn The time from now after which the token expires.
+     */
+    void storeToken(const std::string& clientId, std::chrono::seconds expiresIn) {
+        int64_t now_Unix = 0;
+        alexaClientSDK::avsCommon::utils::timing::getCurrentUnixTime(&now_Unix);
+        store({clientId, CONFIGURED_REFRESH_TOKEN, STORED_AUTH_TOKEN, now_Unix + expiresIn.count()});
+    }
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+    /// Whether the database is open.
+    bool m_isOpen;
+    /// Whether a token is stored.
+    bool m_hasToken;
+    /// The stored token.
+    AuthTokenStorageInterface::StoredAuthToken m_token;
+};
+
+/// An @c HttpPostInterface whose requests never complete, to stand for a request in flight.
+class UnresponsiveHttpPost : public HttpPostInterface {
+public:
+    UnresponsiveHttpPost() : m_requestCount{0} {
+    }
+
+    long doPost(const std::string& url, const std::string& data, std::chrono::seconds timeout, std::string& body)
+        override {
+        return HTTP_RESPONSE_CODE_UNDEFINED;
+    }
+
+    bool doPostAsync(
+        const std::string& url,
+        const std::string& data,
+        std::chrono::seconds timeout,
+        ResponseCallback callback) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_requestCount;
+        m_requestStarted.notify_all();
+        return true;
+    }
+
+    /**
+     * Wait until a request has been started.
+     *
+     * @return Whether a request was started before @c TIME_OUT_IN_SECONDS.
+     */
+    bool waitForRequest() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_requestStarted.wait_for(lock, TIME_OUT_IN_SECONDS, [this]() { return m_requestCount > 0; });
+    }
+
+private:
+    /// Serializes access to @c m_requestCount.
+    std::mutex m_mutex;
+    /// Notified when a request is started.
+    std::condition_variable m_requestStarted;
+    /// The number of requests started.
+    int m_requestCount;
+};
+
 /// Define test fixture for testing AuthDelegate.
 class AuthDelegateTest : public ::testing::Test {
 protected:
@@ -71,6 +204,7 @@ protected:
     AuthDelegateTest() {
         m_mockHttpPost = std::unique_ptr<MockHttpPost>(new MockHttpPost());
         m_mockAuthObserver = std::make_shared<NiceMock<MockAuthObserver>>();
+        m_tokenStorage = std::make_shared<FakeAuthTokenStorage>();
     }
 
     /// Stub certain mock objects with default actions
@@ -86,6 +220,18 @@ protected:
         AlexaClientSDKInit::uninitialize();
     }
 
+    /**
+     * Configure the SDK to keep the auth token in a database.
+     */
+    void initializeWithDatabase() {
+        AlexaClientSDKInit::uninitialize();
+        std::stringstream configuration;
+        configuration << DEFAULT_SDK_CONFIGURATION;
+        std::stringstream overlay;
+        overlay << DATABASE_SDK_CONFIGURATION;
+        ASSERT_TRUE(AlexaClientSDKInit::initialize({&configuration, &overlay}));
+    }
+
     /**
      * Wait on a condition for the specified duration.
      *
@@ -138,6 +284,9 @@ protected:
     /// Mock object of @c AuthObserverInterface which will be notified on current AuthDelegate status.
     std::shared_ptr<NiceMock<MockAuthObserver>> m_mockAuthObserver;
 
+    /// Storage in which the auth token is kept.
+    std::shared_ptr<FakeAuthTokenStorage> m_tokenStorage;
+
     /// Condition variable used by @c waitFor function.
     std::condition_variable m_cv;
 
@@ -407,3 +556,110 @@ TEST_F(AuthDelegateTest, unrecoverableErrorNotification) {
     authDelegate->addAuthObserver(m_mockAuthObserver);
     ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&errorReceived]() { return errorReceived; }));
 }
+
+/**
+ * Test that an auth token kept by a previous run is offered at once, without waiting for LWA.
+ */
+TEST_F(AuthDelegateTest, useStoredAuthToken) {
+    initializeWithDatabase();
+    m_tokenStorage->storeToken(CONFIGURED_CLIENT_ID, std::chrono::hours(1));
+
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR))
+        .Times(1);
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_tokenStorage);
+    ASSERT_TRUE(authDelegate);
+    ASSERT_EQ(authDelegate->getAuthToken(), STORED_AUTH_TOKEN);
+    authDelegate->addAuthObserver(m_mockAuthObserver);
+}
+
+/**
+ * Test that a stored auth token obtained with other credentials is discarded.
+ */
+TEST_F(AuthDelegateTest, discardStoredAuthTokenForOtherClient) {
+    initializeWithDatabase();
+    m_tokenStorage->storeToken("other clientId", std::chrono::hours(1));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_tokenStorage);
+    ASSERT_TRUE(authDelegate);
+    ASSERT_TRUE(authDelegate->getAuthToken().empty());
+    AuthTokenStorageInterface::StoredAuthToken token;
+    ASSERT_FALSE(m_tokenStorage->load(&token));
+}
+
+/**
+ * Test that a stored auth token which has expired is not used.
+ */
+TEST_F(AuthDelegateTest, ignoreExpiredStoredAuthToken) {
+    initializeWithDatabase();
+    m_tokenStorage->storeToken(CONFIGURED_CLIENT_ID, std::chrono::seconds(-1));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_tokenStorage);
+    ASSERT_TRUE(authDelegate);
+    ASSERT_TRUE(authDelegate->getAuthToken().empty());
+}
+
+/**
+ * Test that the storage is not used unless a database file is configured.
+ */
+TEST_F(AuthDelegateTest, ignoreStorageWithoutDatabaseFilePath) {
+    m_tokenStorage->storeToken(CONFIGURED_CLIENT_ID, std::chrono::hours(1));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_tokenStorage);
+    ASSERT_TRUE(authDelegate);
+    ASSERT_TRUE(authDelegate->getAuthToken().empty());
+    ASSERT_FALSE(m_tokenStorage->isOpen());
+}
+
+/**
+ * Test that a refreshed auth token is kept in the storage, keyed on the credentials it was obtained with.
+ */
+TEST_F(AuthDelegateTest, storeRefreshedAuthToken) {
+    initializeWithDatabase();
+    bool tokenRefreshed = false;
+    const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(60));
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
+        .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)))
+        .WillRepeatedly(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED));
+
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::UNINITIALIZED, AuthObserverInterface::Error::NO_ERROR))
+        .Times(AtMost(1));
+
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR))
+        .WillOnce(InvokeWithoutArgs([this, &tokenRefreshed]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            tokenRefreshed = true;
+            m_cv.notify_all();
+        }));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_tokenStorage);
+    authDelegate->addAuthObserver(m_mockAuthObserver);
+    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
+
+    AuthTokenStorageInterface::StoredAuthToken token;
+    ASSERT_TRUE(m_tokenStorage->load(&token));
+    ASSERT_EQ(token.clientId, CONFIGURED_CLIENT_ID);
+    ASSERT_EQ(token.refreshToken, CONFIGURED_REFRESH_TOKEN);
+    ASSERT_EQ(token.authToken, REFRESHED_AUTH_TOKEN);
+    int64_t now_Unix = 0;
+    ASSERT_TRUE(alexaClientSDK::avsCommon::utils::timing::getCurrentUnixTime(&now_Unix));
+    ASSERT_GT(token.expirationTime_Unix, now_Unix);
+    ASSERT_LE(token.expirationTime_Unix, now_Unix + 60);
+}
+
+/**
+ * Test that destroying the AuthDelegate does not wait for a request to LWA which is still in flight.
+ */
+TEST_F(AuthDelegateTest, destroyWithRequestInFlight) {
+    auto httpPost = new UnresponsiveHttpPost();
+    auto authDelegate = AuthDelegate::create(std::unique_ptr<HttpPostInterface>(httpPost));
+    ASSERT_TRUE(authDelegate);
+    ASSERT_TRUE(httpPost->waitForRequest());
+    authDelegate.reset();
+}
@@ -0,0 +1,96 @@
+/*
+ * SQLiteAuthTokenStorageTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SQLiteAuthTokenStorageTest.cpp
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AuthDelegate/SQLiteAuthTokenStorage.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+namespace test {
+
+/**
+ * Our GTest class.
+ */
+class SQLiteAuthTokenStorageTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /// The path of the database file.
+    std::string m_path;
+};
+
+void SQLiteAuthTokenStorageTest::SetUp() {
+    m_path = "/tmp/SQLiteAuthTokenStorageTest." + std::to_string(getpid()) + ".db";
+    unlink(m_path.c_str());
+}
+
+void SQLiteAuthTokenStorageTest::TearDown() {
+    unlink(m_path.c_str());
+}
+
+/**
+ * Verify that the auth token is kept across a reopen, that storing replaces it, and that it can be cleared.
+ */
+TEST_F(SQLiteAuthTokenStorageTest, storeLoadAndClear) {
+    SQLiteAuthTokenStorage storage;
+    ASSERT_FALSE(storage.open(m_path));
+    ASSERT_TRUE(storage.createDatabase(m_path));
+    ASSERT_TRUE(storage.isOpen());
+
+    AuthTokenStorageInterface::StoredAuthToken token;
+    ASSERT_FALSE(storage.load(&token));
+    ASSERT_TRUE(storage.store({"clientId", "refreshToken", "authToken", 100}));
+    ASSERT_TRUE(storage.store({"clientId", "refreshToken", "newAuthToken", 200}));
+    storage.close();
+    ASSERT_FALSE(storage.isOpen());
+
+    ASSERT_FALSE(storage.createDatabase(m_path));
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_TRUE(storage.load(&token));
+    ASSERT_EQ(token.clientId, "clientId");
+    ASSERT_EQ(token.refreshToken, "refreshToken");
+    ASSERT_EQ(token.authToken, "newAuthToken");
+    ASSERT_EQ(token.expirationTime_Unix, 200);
+
+    ASSERT_TRUE(storage.clear());
+    ASSERT_FALSE(storage.load(&token));
+}
+
+/**
+ * Verify that the database file can only be read and written by its owner.
+ */
+TEST_F(SQLiteAuthTokenStorageTest, databaseIsPrivate) {
+    SQLiteAuthTokenStorage storage;
+    ASSERT_TRUE(storage.createDatabase(m_path));
+    struct stat status;
+    ASSERT_EQ(stat(m_path.c_str(), &status), 0);
+    ASSERT_EQ(status.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO), static_cast<mode_t>(S_IRUSR | S_IWUSR));
+}
+
+}  // namespace test
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
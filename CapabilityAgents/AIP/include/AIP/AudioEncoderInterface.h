@@ -0,0 +1,85 @@
+/*
+ * AudioEncoderInterface.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_AUDIO_ENCODER_INTERFACE_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_AUDIO_ENCODER_INTERFACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An interface to an encoder which compresses the 16 kHz, 16-bit, mono LPCM audio of a @c Recognize event before it
+ * is uploaded.  The encoder consumes the audio in fixed-size frames.
+ *
+ * Implementations need not be thread-safe; an encoder is only used for one @c Recognize event at a time.
+ */
+class AudioEncoderInterface {
+public:
+    /// Destructor.
+    virtual ~AudioEncoderInterface() = default;
+
+    /**
+     * Get the encoding of the audio produced by this encoder.
+     *
+     * @return The encoding of the audio produced by this encoder.
+     */
+    virtual avsCommon::utils::AudioFormat::Encoding getEncoding() const = 0;
+
+    /**
+     * Get the value of the "format" field of the @c Recognize event for the audio produced by this encoder.
+     *
+     * @return The AVS name of the format, such as "OPUS".
+     */
+    virtual std::string getAVSFormatName() const = 0;
+
+    /**
+     * Get the number of samples consumed by each call to @c encode().
+     *
+     * @return The number of samples in a frame.
+     */
+    virtual size_t getFrameSizeInSamples() const = 0;
+
+    /**
+     * Prepare the encoder for a new stream, discarding any state left from the previous one.
+     *
+     * @return Whether the encoder is ready.
+     */
+    virtual bool reset() = 0;
+
+    /**
+     * Encode one frame of audio.
+     *
+     * @param samples The samples of the frame, @c getFrameSizeInSamples() of them.
+     * @param[out] output The encoded frame, which is appended to it.
+     * @return Whether the frame was encoded.
+     */
+    virtual bool encode(const int16_t* samples, std::vector<uint8_t>* output) = 0;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_AUDIO_ENCODER_INTERFACE_H_
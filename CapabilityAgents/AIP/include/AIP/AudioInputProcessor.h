@@ -18,6 +18,7 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_AUDIO_INPUT_PROCESSOR_H_
 #define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_AUDIO_INPUT_PROCESSOR_H_
 
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 
@@ -38,7 +39,9 @@
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
+#include "AudioEncoderInterface.h"
 #include "AudioProvider.h"
+#include "EndOfSpeechDetector.h"
 #include "Initiator.h"
 
 namespace alexaClientSDK {
@@ -83,6 +86,16 @@ public:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c avsCommon::AudioProvider::alwaysReadable).  This parameter is optional and
      *     defaults to an invalid @c avsCommon::AudioProvider.
+     * @param audioEncoder The encoder used to compress the audio of Recognize events before it is sent.  This
+     *     parameter is optional; when it is @c nullptr the audio is sent as PCM.
+     * @param localEndpointing The settings of the @c EndOfSpeechDetector used to end Recognize events on the device
+     *     when the user stops speaking, without waiting for a StopCapture directive.  This parameter is optional; it
+     *     defaults to a disabled @c EndOfSpeechDetector::Config, which leaves ending the capture to AVS.  It is not
+     *     used for the @c CLOSE_TALK profile, where the user ends the capture.
+     * @param concurrentFocusAcquisition Whether to acquire the dialog channel as soon as a Recognize event starts,
+     *     while its context is being fetched, instead of after the context is available.  This shortens the time to the
+     *     start of the upload, but the context may then reflect changes caused by the focus change, such as the
+     *     content channel pausing.  This parameter is optional, and defaults to @c false.
      * @return A @c std::shared_ptr to the new @c AudioInputProcessor instance.
      */
     static std::shared_ptr<AudioInputProcessor> create(
@@ -93,7 +106,10 @@ public:
         std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider = AudioProvider::null());
+        AudioProvider defaultAudioProvider = AudioProvider::null(),
+        std::shared_ptr<AudioEncoderInterface> audioEncoder = nullptr,
+        EndOfSpeechDetector::Config localEndpointing = EndOfSpeechDetector::Config(),
+        bool concurrentFocusAcquisition = false);
 
     /**
      * Adds an observer to be notified of AudioInputProcessor state changes.
@@ -176,6 +192,16 @@ public:
      */
     std::future<void> resetState();
 
+    /**
+     * This function asks the @c AudioInputProcessor to start assembling the context for a Recognize Event which is
+     * expected shortly, such as when a keyword detector reports a likely but not yet confirmed keyword.  If
+     * @c recognize() is called while the context is being assembled, or soon enough after that it has not gone stale,
+     * the Recognize Event is sent with that context instead of waiting for a new one.
+     *
+     * @return A future which indicates when the context has been requested.
+     */
+    std::future<void> prefetchContext();
+
     /// @name StateProviderInterface Functions
     /// @{
     void provideState(unsigned int stateRequestToken) override;
@@ -206,6 +232,7 @@ public:
     /// @name ChannelObserverInterface Functions
     /// @{
     void onFocusChanged(avsCommon::avs::FocusState newFocus) override;
+    bool canBeNotifiedOnAcquiringThread() const override;
     /// @}
 
     /// @name DialogUXStateObserverInterface Functions
@@ -227,6 +254,9 @@ private:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c AudioProvider::alwaysReadable).  This parameter is optional, and ignored if set
      *     to @c AudioProvider::null().
+     * @param audioEncoder The encoder used to compress the audio of Recognize events, or @c nullptr to send PCM.
+     * @param localEndpointing The settings of the @c EndOfSpeechDetector used to end Recognize events on the device.
+     * @param concurrentFocusAcquisition Whether to acquire the dialog channel while the context is being fetched.
      *
      * @note This constructor is private so that users are forced to use the @c create() factory function.  The primary
      *     reason for this is to ensure that a @c std::shared_ptr to the instance exists, which is a requirement for
@@ -239,7 +269,10 @@ private:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider);
+        AudioProvider defaultAudioProvider,
+        std::shared_ptr<AudioEncoderInterface> audioEncoder,
+        EndOfSpeechDetector::Config localEndpointing,
+        bool concurrentFocusAcquisition);
 
     /// @name RequiresShutdown Functions
     /// @{
@@ -337,29 +370,41 @@ private:
     /**
      * This function receives the full system context from @c ContextManager.  Context requests are initiated by
      * @c executeRecognize() calls, and provide the final piece of information needed to assemble a @c MessageRequest.
-     * If focus has already changed to @c FOREGROUND by the time this function is called, this function will send the
-     * @c MessageRequest.  If focus has not changed to @c FOREGROUND, this function will assemble the MessageRequest,
-     * but will defer sending it to @c executeOnFocusChanged().
+     * This function assembles the @c MessageRequest and sends it right away, while the dialog channel is still being
+     * acquired, so that the upload of the audio is not delayed by the focus change.
      *
      * @param jsonContext The full system context to send with the event.
      */
     void executeOnContextAvailable(const std::string jsonContext);
 
+    /**
+     * This function receives a context requested by @c executeRecognize() or @c executePrefetchContext().  If a
+     * Recognize Event is waiting for it, it is passed on to @c executeOnContextAvailable(), otherwise it is kept for
+     * the next Recognize Event.
+     *
+     * @param jsonContext The full system context.
+     */
+    void executeOnContextReceived(const std::string jsonContext);
+
     /**
      * This function is called when a context request fails.  Context requests are initiated by @c executeRecognize()
-     * calls, and failure to complete the context request results in failure to send the recognize event.
+     * calls, and failure to complete the context request results in failure to send the recognize event.  The
+     * failure of a context request from @c executePrefetchContext() which no Recognize Event is waiting for is ignored.
      *
      * @param error The reason the context request failed to complete.
      */
     void executeOnContextFailure(const avsCommon::sdkInterfaces::ContextRequestError error);
 
+    /**
+     * This function requests the context ahead of a Recognize Event, unless a request is already in progress.
+     */
+    void executePrefetchContext();
+
     /**
      * This function is called when the @c FocusManager focus changes.  This might occur when another component
      * acquires focus on the dialog channel, in which case the @c AudioInputProcessor will end any activity and return
      * to @c IDLE. This function is also called after a call to @c executeRecognize() tries to acquire the channel.
-     * If this function changes the focus to @c FOREGROUND in the @c RECOGNIZING state and the @c MessageRequest has
-     * already been generated, this function will send the @c MessageRequest.  If the @c MessageRequest has not been
-     * generated yet, this function will defer sending to @c executeOnContextAvailable().
+     * If the channel is not granted, the Recognize Event which was sent without waiting for it is ended.
      *
      * @param newFocus The focus state to change to.
      */
@@ -387,6 +432,14 @@ private:
      */
     void executeResetState();
 
+    /**
+     * This function is called when the @c EndOfSpeechDetector of a Recognize Event detects the end of speech.  If that
+     * event is still capturing audio, the capture is stopped as a StopCapture directive would stop it.
+     *
+     * @param recognizeId The value of @c m_recognizeCount when the Recognize Event was started.
+     */
+    void executeOnLocalEndOfSpeech(uint64_t recognizeId);
+
     /**
      * This function tells the @c AudioInputProcessor to expect a Recognize event within the specified timeout.  If the
      * previous or default @c AudioProvider is capable of streaming immediately, this function will start the Recognize
@@ -488,6 +541,24 @@ private:
      */
     AudioProvider m_defaultAudioProvider;
 
+    /// The encoder used to compress the audio of Recognize events, or @c nullptr if the audio is sent as PCM.
+    std::shared_ptr<AudioEncoderInterface> m_audioEncoder;
+
+    /// The settings of the @c EndOfSpeechDetector used to end Recognize events on the device.
+    EndOfSpeechDetector::Config m_localEndpointing;
+
+    /// Whether the dialog channel is acquired in @c executeRecognize(), while the context is being fetched.
+    const bool m_concurrentFocusAcquisition;
+
+    /// The number of Recognize events started, which identifies the event a local end of speech belongs to.
+    uint64_t m_recognizeCount;
+
+    /**
+     * This flag is set to @c true when the capture of the current Recognize event was ended on the device, so that the
+     * StopCapture directive which AVS sends later is completed instead of failed.
+     */
+    bool m_isLocallyEndpointed;
+
     /**
      * The last @c AudioProvider used in an @c executeRecognize(); will be used for ExpectSpeech directives
      * if it is capable of streaming on demand (@c AudioProvider::alwaysReadable).
@@ -497,9 +568,10 @@ private:
     /**
      * The attachment reader which is currently being used to stream audio for a Recognize event.  This pointer is
      * valid during the @c RECOGNIZING state, and is retained by @c AudioInputProcessor so that it can close the
-     * stream from @c executeStopCapture().
+     * stream from @c executeStopCapture().  When an encoder is used, it reads the encoded audio, and when local
+     * endpointing is enabled, it ends the audio at the end of speech.
      */
-    std::shared_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> m_reader;
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
 
     /**
      * The payload for a Recognize event.  This string is populated by a call to @c executeRecognize(), and later
@@ -510,9 +582,8 @@ private:
 
     /**
      * The @c MessageRequest for a Recognize event.  This request is created by a call to
-     * @c executeOnContextAvailable(), and either sent immediately (if `m_focusState == afml::FocusState::FOREGROUND`),
-     * or later sent by a call to @c executeOnFocusChanged().  This pointer is only valid during the @c RECOGNIZING
-     * state after a call to @c executeRecognize(), and is reset after it is sent.
+     * @c executeOnContextAvailable(), and sent immediately.  This pointer is only valid during the @c RECOGNIZING state
+     * after a call to @c executeRecognize(), and is reset after it is sent.
      */
     std::shared_ptr<avsCommon::avs::MessageRequest> m_request;
 
@@ -543,6 +614,24 @@ private:
 
     /// This flag indicates whether the initial dialog UX State has been received.
     bool m_initialDialogUXStateReceived;
+
+    /// The number of context requests made to @c ContextManager which have not been answered yet.
+    unsigned int m_numPendingContextRequests;
+
+    /**
+     * This flag is set to @c true when a Recognize Event in the @c RECOGNIZING state is waiting for the answer to a
+     * pending context request.
+     */
+    bool m_isWaitingForContext;
+
+    /// A context received ahead of a Recognize Event, or empty.
+    std::string m_prefetchedContext;
+
+    /// When @c m_prefetchedContext was received.
+    std::chrono::steady_clock::time_point m_prefetchedContextTime;
+
+    /// When the end of the wakeword of the Recognize Event in progress was captured, if it is being traced.
+    std::chrono::steady_clock::time_point m_keywordEndTime;
     /// @}
 
     /**
@@ -0,0 +1,123 @@
+/*
+ * EncodingAttachmentReader.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_ENCODING_ATTACHMENT_READER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_ENCODING_ATTACHMENT_READER_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <AVSCommon/AVS/Attachment/AttachmentReader.h>
+
+#include "AIP/AudioEncoderInterface.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An @c AttachmentReader which reads LPCM audio from another @c AttachmentReader, and returns it encoded with an
+ * @c AudioEncoderInterface.
+ *
+ * Audio is encoded a frame at a time, as soon as a whole frame has been read, so the encoder adds at most one frame of
+ * latency.  When the source reader is closed, the last partial frame is padded with silence and encoded.
+ *
+ * Like the readers it wraps, this class is non-blocking: @c read() returns @c OK_WOULDBLOCK until a frame has been
+ * read and encoded.  @c read() and @c close() may be called from different threads.
+ */
+class EncodingAttachmentReader : public avsCommon::avs::attachment::AttachmentReader {
+public:
+    /**
+     * Create an @c EncodingAttachmentReader.
+     *
+     * @param source The reader of the LPCM audio.
+     * @param encoder The encoder to encode the audio with.  It is reset before it is used.
+     * @return The new @c EncodingAttachmentReader, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<EncodingAttachmentReader> create(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> source,
+        std::shared_ptr<AudioEncoderInterface> encoder);
+
+    std::size_t read(
+        void* buf,
+        std::size_t numBytes,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
+
+    void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param source The reader of the LPCM audio.
+     * @param encoder The encoder to encode the audio with.
+     */
+    EncodingAttachmentReader(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> source,
+        std::shared_ptr<AudioEncoderInterface> encoder);
+
+    /**
+     * Read from @c m_source until a frame is complete or no more audio is available, and encode the frame.  This is
+     * called with @c m_mutex held.
+     *
+     * @param timeoutMs The timeout to pass to @c m_source.
+     * @return The status of the last read from @c m_source.
+     */
+    ReadStatus fillEncodedLocked(std::chrono::milliseconds timeoutMs);
+
+    /**
+     * Encode @c m_frame, padding it with silence if it is not full.  This is called with @c m_mutex held.
+     *
+     * @return Whether the frame was encoded.
+     */
+    bool encodeFrameLocked();
+
+    /// The reader of the LPCM audio.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_source;
+
+    /// The encoder to encode the audio with.
+    std::shared_ptr<AudioEncoderInterface> m_encoder;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The samples of the frame being read.
+    std::vector<int16_t> m_frame;
+
+    /// The number of samples in @c m_frame which have been read.
+    size_t m_frameFill;
+
+    /// Encoded audio which has not been returned by @c read() yet.
+    std::vector<uint8_t> m_encoded;
+
+    /// The offset in @c m_encoded of the first byte which has not been returned yet.
+    size_t m_encodedOffset;
+
+    /// Whether @c m_source has no more audio to return.
+    bool m_isSourceDone;
+
+    /// The status to return once @c m_encoded has been drained after @c m_source is done.
+    ReadStatus m_finalStatus;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_ENCODING_ATTACHMENT_READER_H_
@@ -0,0 +1,139 @@
+/*
+ * EndOfSpeechDetector.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_END_OF_SPEECH_DETECTOR_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_END_OF_SPEECH_DETECTOR_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * Detects the end of an utterance in a stream of 16-bit mono LPCM audio, so that a Recognize event can be ended
+ * without waiting for AVS to send @c StopCapture.
+ *
+ * The audio is measured in 10 ms frames.  A frame is speech if its RMS amplitude is at least
+ * @c Config::minSpeechLevel and at least @c Config::speechToNoiseRatio times the noise floor, which follows the quiet
+ * frames.  The end of speech is detected once there has been at least @c Config::minSpeech of speech, followed by
+ * @c Config::trailingSilence without any.  Audio which never has enough speech, such as a false wake, is left for AVS
+ * to end.
+ *
+ * This class is not thread-safe.
+ */
+class EndOfSpeechDetector {
+public:
+    /// The settings of the detector.  A value-initialized @c Config, whose @c trailingSilence is zero, is disabled.
+    struct Config {
+        /// How long the audio must be silent after speech to end the utterance.  Zero disables the detector.
+        std::chrono::milliseconds trailingSilence;
+
+        /// How much speech must be heard before the end of the utterance can be detected.
+        std::chrono::milliseconds minSpeech;
+
+        /// The smallest RMS amplitude, in 16-bit sample units, which counts as speech.
+        unsigned int minSpeechLevel;
+
+        /// How many times louder than the noise floor the RMS amplitude of speech is.
+        unsigned int speechToNoiseRatio;
+    };
+
+    /// @return The default settings, which are enabled.
+    static Config getDefaultConfig();
+
+    /**
+     * Creates an @c EndOfSpeechDetector.
+     *
+     * @param config The settings of the detector.
+     * @param sampleRateHz The sample rate of the audio.
+     * @return A new @c EndOfSpeechDetector, or @c nullptr if the settings are invalid or disabled.
+     */
+    static std::unique_ptr<EndOfSpeechDetector> create(const Config& config, unsigned int sampleRateHz);
+
+    /**
+     * Measures more of the audio.
+     *
+     * @param samples The audio.
+     * @param numSamples The number of samples in @c samples.
+     * @param[out] numSamplesMeasured If not @c nullptr, set to the number of samples of @c samples measured before the
+     *     end of speech was detected, which is @c numSamples if it was not, and zero if it was detected before.
+     * @return Whether the end of speech has been detected, in this audio or before.
+     */
+    bool process(const int16_t* samples, size_t numSamples, size_t* numSamplesMeasured = nullptr);
+
+    /// @return Whether the end of speech has been detected.
+    bool hasDetectedEndOfSpeech() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param config The settings of the detector.
+     * @param sampleRateHz The sample rate of the audio.
+     */
+    EndOfSpeechDetector(const Config& config, unsigned int sampleRateHz);
+
+    /**
+     * Classifies a whole frame, and updates the state of the detector.
+     *
+     * @param energy The mean square of the samples of the frame.
+     */
+    void processFrame(uint64_t energy);
+
+    /// The number of samples in a frame.
+    const size_t m_frameSize;
+
+    /// The number of samples of speech needed before the end of speech can be detected.
+    const size_t m_minSpeechSamples;
+
+    /// The number of samples of silence after speech which end the utterance.
+    const size_t m_trailingSilenceSamples;
+
+    /// The square of @c Config::minSpeechLevel.
+    const uint64_t m_minSpeechEnergy;
+
+    /// The square of @c Config::speechToNoiseRatio.
+    const uint64_t m_speechToNoiseEnergyRatio;
+
+    /// The estimated mean square of the background noise.
+    uint64_t m_noiseFloor;
+
+    /// The sum of the squares of the samples of the frame being measured.
+    uint64_t m_frameEnergy;
+
+    /// The number of samples of the frame being measured.
+    size_t m_frameFill;
+
+    /// The number of samples of speech heard.
+    size_t m_speechSamples;
+
+    /// The number of samples of silence since the last speech.
+    size_t m_silenceSamples;
+
+    /// Whether the end of speech has been detected.
+    bool m_hasDetectedEndOfSpeech;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_END_OF_SPEECH_DETECTOR_H_
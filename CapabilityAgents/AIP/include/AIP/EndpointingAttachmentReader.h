@@ -0,0 +1,115 @@
+/*
+ * EndpointingAttachmentReader.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_ENDPOINTING_ATTACHMENT_READER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_ENDPOINTING_ATTACHMENT_READER_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <AVSCommon/AVS/Attachment/AttachmentReader.h>
+
+#include "AIP/EndOfSpeechDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An @c AttachmentReader which passes LPCM audio through from another @c AttachmentReader, and ends the attachment
+ * once an @c EndOfSpeechDetector detects the end of speech in it.
+ *
+ * The audio up to the frame in which the end of speech is detected is returned, and later reads return @c CLOSED, so
+ * the audio after the trailing silence is not uploaded.  The callback is called once, on the thread which
+ * is reading, when the end of speech is detected; it should not block.
+ *
+ * @c read() and @c close() may be called from different threads.
+ */
+class EndpointingAttachmentReader : public avsCommon::avs::attachment::AttachmentReader {
+public:
+    /**
+     * Create an @c EndpointingAttachmentReader.
+     *
+     * @param source The reader of the LPCM audio.
+     * @param detector The detector to measure the audio with.
+     * @param onEndOfSpeech The function to call when the end of speech is detected.
+     * @return The new @c EndpointingAttachmentReader, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<EndpointingAttachmentReader> create(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> source,
+        std::unique_ptr<EndOfSpeechDetector> detector,
+        std::function<void()> onEndOfSpeech);
+
+    std::size_t read(
+        void* buf,
+        std::size_t numBytes,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
+
+    void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param source The reader of the LPCM audio.
+     * @param detector The detector to measure the audio with.
+     * @param onEndOfSpeech The function to call when the end of speech is detected.
+     */
+    EndpointingAttachmentReader(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> source,
+        std::unique_ptr<EndOfSpeechDetector> detector,
+        std::function<void()> onEndOfSpeech);
+
+    /**
+     * Pass audio which has been read to @c m_detector.  This is called with @c m_mutex held.
+     *
+     * @param bytes The audio.
+     * @param numBytes The number of bytes in @c bytes.
+     * @param[out] numBytesMeasured Set to the number of bytes of @c bytes up to the end of speech, or @c numBytes.
+     * @return Whether the end of speech has been detected.
+     */
+    bool detectLocked(const uint8_t* bytes, size_t numBytes, size_t* numBytesMeasured);
+
+    /// The reader of the LPCM audio.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_source;
+
+    /// The function to call when the end of speech is detected.
+    std::function<void()> m_onEndOfSpeech;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The detector to measure the audio with.
+    std::unique_ptr<EndOfSpeechDetector> m_detector;
+
+    /// The first byte of a sample which was split between two reads.
+    uint8_t m_partialSample[sizeof(int16_t)];
+
+    /// Whether @c m_partialSample holds a byte.
+    bool m_hasPartialSample;
+
+    /// Whether the end of speech has been detected, so that @c read() returns @c CLOSED.
+    bool m_isEndOfSpeech;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_ENDPOINTING_ATTACHMENT_READER_H_
@@ -0,0 +1,76 @@
+/*
+ * OpusAudioEncoder.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_OPUS_AUDIO_ENCODER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_OPUS_AUDIO_ENCODER_H_
+
+#include <memory>
+
+#include <opus.h>
+
+#include "AIP/AudioEncoderInterface.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An @c AudioEncoderInterface which encodes 16 kHz mono LPCM into the constant bitrate Opus stream AVS accepts as the
+ * "OPUS" format: 20 ms frames at 32 kbps, each one 80 bytes, sent back to back.  It cuts the upload of a
+ * @c Recognize event from 256 kbps to 32 kbps.
+ *
+ * This class is only built when the SDK is configured with @c -DOPUS=ON.
+ */
+class OpusAudioEncoder : public AudioEncoderInterface {
+public:
+    /**
+     * Create an @c OpusAudioEncoder.
+     *
+     * @return The new @c OpusAudioEncoder, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<OpusAudioEncoder> create();
+
+    /// Destructor.
+    ~OpusAudioEncoder();
+
+    avsCommon::utils::AudioFormat::Encoding getEncoding() const override;
+
+    std::string getAVSFormatName() const override;
+
+    size_t getFrameSizeInSamples() const override;
+
+    bool reset() override;
+
+    bool encode(const int16_t* samples, std::vector<uint8_t>* output) override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param encoder The libopus encoder to encode with.
+     */
+    OpusAudioEncoder(::OpusEncoder* encoder);
+
+    /// The libopus encoder to encode with.
+    ::OpusEncoder* m_encoder;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AIP_INCLUDE_AIP_OPUS_AUDIO_ENCODER_H_
@@ -15,16 +15,21 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include <AVSCommon/AVS/FocusState.h>
 #include <AVSCommon/AVS/MessageRequest.h>
-#include <AVSCommon/Utils/JSON/JSONUtils.h>
+#include <AVSCommon/Utils/JSON/PayloadDecoder.h>
+#include <AVSCommon/Utils/Logger/FlightRecorderLogger.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
 #include <AVSCommon/Utils/Metrics.h>
+#include <AVSCommon/Utils/Metrics/DialogLatencyTracer.h>
 
 #include "AIP/AudioInputProcessor.h"
+#include "AIP/EncodingAttachmentReader.h"
+#include "AIP/EndpointingAttachmentReader.h"
 
 namespace alexaClientSDK {
 namespace capabilityAgents {
@@ -60,6 +65,77 @@ static const avsCommon::avs::NamespaceAndName EXPECT_SPEECH{NAMESPACE, "ExpectSp
 /// The SpeechRecognizer context state signature.
 static const avsCommon::avs::NamespaceAndName RECOGNIZER_STATE{NAMESPACE, "RecognizerState"};
 
+/// The AVS name of the format of audio which is sent without encoding.
+static const std::string PCM_FORMAT_NAME = "AUDIO_L16_RATE_16000_CHANNELS_1";
+
+/// The key of the timeout in the payload of an ExpectSpeech directive.
+static const char KEY_TIMEOUT_IN_MILLISECONDS[] = "timeoutInMilliseconds";
+
+/// The properties of an ExpectSpeech directive's payload.
+struct ExpectSpeechPayload {
+    /// How long to wait for the user to start speaking, in milliseconds.
+    int64_t timeoutInMilliseconds;
+};
+
+/// The schema of an ExpectSpeech directive's payload.
+static constexpr avsCommon::utils::json::jsonUtils::PayloadField<ExpectSpeechPayload> EXPECT_SPEECH_PAYLOAD_SCHEMA[] = {
+    {KEY_TIMEOUT_IN_MILLISECONDS, &ExpectSpeechPayload::timeoutInMilliseconds}};
+
+/**
+ * How long a context received ahead of a Recognize Event remains usable.  This bounds how stale the states of the
+ * other components (such as playback offsets) sent with a Recognize Event can be.
+ */
+static const std::chrono::milliseconds PREFETCHED_CONTEXT_VALIDITY(500);
+
+/// The most audio from before the wakeword which is sent for cloud-based wakeword verification.
+static const std::chrono::milliseconds MAX_PREROLL(500);
+
+/**
+ * How much of the oldest audio in the stream is not used as preroll, since the writer may overwrite it before the
+ * upload reads it.
+ */
+static const std::chrono::milliseconds PREROLL_OVERRUN_MARGIN(250);
+
+/**
+ * Work out how much preroll to send before the wakeword for cloud-based wakeword verification.  This is up to
+ * @c MAX_PREROLL, trimmed to the audio before @c begin which the stream still holds.
+ *
+ * @param provider The @c AudioProvider to stream audio from.
+ * @param begin The @c Index in @c provider.stream where the wakeword begins.
+ * @return The number of samples of preroll.
+ */
+static avsCommon::avs::AudioInputStream::Index getPreroll(
+    const AudioProvider& provider,
+    avsCommon::avs::AudioInputStream::Index begin) {
+    avsCommon::avs::AudioInputStream::Index preroll =
+        provider.format.sampleRateHz * MAX_PREROLL.count() / std::milli::den;
+    preroll = std::min(preroll, begin);
+
+    // The oldest audio in the stream is about to be overwritten, so leave a margin for the writer to advance in before
+    // the upload reads the preroll.
+    static const bool startWithNewData = true;
+    auto reader =
+        provider.stream->createReader(avsCommon::avs::AudioInputStream::Reader::Policy::NONBLOCKING, startWithNewData);
+    if (!reader) {
+        ACSDK_WARN(LX("getPreroll").d("reason", "createReaderFailed"));
+        return preroll;
+    }
+    avsCommon::avs::AudioInputStream::Index margin =
+        provider.format.sampleRateHz * PREROLL_OVERRUN_MARGIN.count() / std::milli::den;
+    avsCommon::avs::AudioInputStream::Index dataSize = provider.stream->getDataSize();
+    avsCommon::avs::AudioInputStream::Index writerIndex = reader->tell();
+    avsCommon::avs::AudioInputStream::Index oldest = 0;
+    if (writerIndex + margin > dataSize) {
+        oldest = writerIndex + margin - dataSize;
+    }
+    if (begin < oldest + preroll) {
+        auto trimmed = begin > oldest ? begin - oldest : 0;
+        ACSDK_DEBUG(LX("getPreroll").d("reason", "trimmedToStream").d("preroll", preroll).d("trimmed", trimmed));
+        preroll = trimmed;
+    }
+    return preroll;
+}
+
 std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
@@ -68,7 +144,10 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) {
+    AudioProvider defaultAudioProvider,
+    std::shared_ptr<AudioEncoderInterface> audioEncoder,
+    EndOfSpeechDetector::Config localEndpointing,
+    bool concurrentFocusAcquisition) {
     if (!directiveSequencer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullDirectiveSequencer"));
         return nullptr;
@@ -99,7 +178,10 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
         focusManager,
         exceptionEncounteredSender,
         userActivityNotifier,
-        defaultAudioProvider));
+        defaultAudioProvider,
+        audioEncoder,
+        localEndpointing,
+        concurrentFocusAcquisition));
 
     if (aip) {
         contextManager->setStateProvider(RECOGNIZER_STATE, aip);
@@ -154,7 +236,27 @@ std::future<bool> AudioInputProcessor::recognize(
         }
         begin = reader->tell();
     }
-    return m_executor.submit([this, audioProvider, initiator, begin, keywordEnd, keyword]() {
+
+    // Work out when the end of the wakeword was captured from how far the writer has got past it.  Without a
+    // wakeword, the trace starts from the start of capture, which is now.
+    std::chrono::steady_clock::time_point keywordEndTime;
+    if (metrics::DialogLatencyTracer::instance().isEnabled() && Initiator::WAKEWORD != initiator) {
+        keywordEndTime = std::chrono::steady_clock::now();
+    } else if (
+        metrics::DialogLatencyTracer::instance().isEnabled() && audioProvider.stream && INVALID_INDEX != keywordEnd &&
+        audioProvider.format.sampleRateHz > 0) {
+        static const bool startWithNewData = true;
+        auto reader = audioProvider.stream->createReader(
+            avsCommon::avs::AudioInputStream::Reader::Policy::NONBLOCKING, startWithNewData);
+        if (reader && reader->tell() >= keywordEnd) {
+            auto samplesSinceKeywordEnd = reader->tell() - keywordEnd;
+            keywordEndTime = std::chrono::steady_clock::now() -
+                             std::chrono::microseconds(samplesSinceKeywordEnd * std::micro::den /
+                                                       audioProvider.format.sampleRateHz);
+        }
+    }
+    return m_executor.submit([this, audioProvider, initiator, begin, keywordEnd, keyword, keywordEndTime]() {
+        m_keywordEndTime = keywordEndTime;
         return executeRecognize(audioProvider, initiator, begin, keywordEnd, keyword);
     });
 }
@@ -171,8 +273,12 @@ void AudioInputProcessor::provideState(unsigned int stateRequestToken) {
     m_executor.submit([this, stateRequestToken]() { executeProvideState(true, stateRequestToken); });
 }
 
+std::future<void> AudioInputProcessor::prefetchContext() {
+    return m_executor.submit([this]() { executePrefetchContext(); });
+}
+
 void AudioInputProcessor::onContextAvailable(const std::string& jsonContext) {
-    m_executor.submit([this, jsonContext]() { executeOnContextAvailable(jsonContext); });
+    m_executor.submit([this, jsonContext]() { executeOnContextReceived(jsonContext); });
 }
 
 void AudioInputProcessor::onContextFailure(const avsCommon::sdkInterfaces::ContextRequestError error) {
@@ -226,6 +332,11 @@ void AudioInputProcessor::onFocusChanged(avsCommon::avs::FocusState newFocus) {
     m_executor.submit([this, newFocus]() { executeOnFocusChanged(newFocus); });
 }
 
+bool AudioInputProcessor::canBeNotifiedOnAcquiringThread() const {
+    // onFocusChanged() only queues the change on m_executor, so it never blocks the acquiring thread.
+    return true;
+}
+
 void AudioInputProcessor::onDialogUXStateChanged(
     avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState newState) {
     m_executor.submit([this, newState]() { executeOnDialogUXStateChanged(newState); });
@@ -238,7 +349,10 @@ AudioInputProcessor::AudioInputProcessor(
     std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) :
+    AudioProvider defaultAudioProvider,
+    std::shared_ptr<AudioEncoderInterface> audioEncoder,
+    EndOfSpeechDetector::Config localEndpointing,
+    bool concurrentFocusAcquisition) :
         CapabilityAgent{NAMESPACE, exceptionEncounteredSender},
         RequiresShutdown{"AudioInputProcessor"},
         m_directiveSequencer{directiveSequencer},
@@ -247,11 +361,18 @@ AudioInputProcessor::AudioInputProcessor(
         m_focusManager{focusManager},
         m_userActivityNotifier{userActivityNotifier},
         m_defaultAudioProvider{defaultAudioProvider},
+        m_audioEncoder{audioEncoder},
+        m_localEndpointing(localEndpointing),
+        m_concurrentFocusAcquisition{concurrentFocusAcquisition},
+        m_recognizeCount{0},
+        m_isLocallyEndpointed{false},
         m_lastAudioProvider{AudioProvider::null()},
         m_state{ObserverInterface::State::IDLE},
         m_focusState{avsCommon::avs::FocusState::NONE},
         m_preparingToSend{false},
-        m_initialDialogUXStateReceived{false} {
+        m_initialDialogUXStateReceived{false},
+        m_numPendingContextRequests{0},
+        m_isWaitingForContext{false} {
 }
 
 void AudioInputProcessor::doShutdown() {
@@ -277,11 +398,9 @@ void AudioInputProcessor::handleStopCaptureDirective(std::shared_ptr<DirectiveIn
 }
 
 void AudioInputProcessor::handleExpectSpeechDirective(std::shared_ptr<DirectiveInfo> info) {
-    int64_t timeout;
-    bool found = avsCommon::utils::json::jsonUtils::lookupInt64Value(
-        info->directive->getPayload(), "timeoutInMilliseconds", &timeout);
-
-    if (!found) {
+    ExpectSpeechPayload payload;
+    if (!avsCommon::utils::json::jsonUtils::decodePayload(
+            info->directive->getPayload(), EXPECT_SPEECH_PAYLOAD_SCHEMA, &payload)) {
         static const char* errorMessage = "missing/invalid timeoutInMilliseconds";
         m_exceptionEncounteredSender->sendExceptionEncountered(
             info->directive->getUnparsedDirective(),
@@ -292,7 +411,7 @@ void AudioInputProcessor::handleExpectSpeechDirective(std::shared_ptr<DirectiveI
         }
         ACSDK_ERROR(LX("handleExpectSpeechDirectiveFailed")
                         .d("reason", "missingJsonField")
-                        .d("field", "timeoutInMilliseconds"));
+                        .d("field", KEY_TIMEOUT_IN_MILLISECONDS));
         return;
     }
 
@@ -302,6 +421,7 @@ void AudioInputProcessor::handleExpectSpeechDirective(std::shared_ptr<DirectiveI
      */
     std::string initiator = "";
 
+    int64_t timeout = payload.timeoutInMilliseconds;
     m_executor.submit([this, timeout, initiator, info]() {
         executeExpectSpeech(std::chrono::milliseconds{timeout}, initiator, info);
     });
@@ -319,13 +439,15 @@ bool AudioInputProcessor::executeRecognize(
         return false;
     }
 
-    // 500ms preroll.
-    avsCommon::avs::AudioInputStream::Index preroll = provider.format.sampleRateHz / 2;
-
     // Check if we have everything we need to enable false wakeword detection.
-    // TODO: Consider relaxing the hard requirement for a full 500ms preroll - ACSDK-276.
     bool falseWakewordDetection =
-        Initiator::WAKEWORD == initiator && begin != INVALID_INDEX && begin >= preroll && end != INVALID_INDEX;
+        Initiator::WAKEWORD == initiator && begin != INVALID_INDEX && end != INVALID_INDEX && end >= begin;
+
+    // Back off by up to 500ms of preroll, as much of it as the stream still holds.
+    avsCommon::avs::AudioInputStream::Index preroll = 0;
+    if (falseWakewordDetection) {
+        preroll = getPreroll(provider, begin);
+    }
 
     // If we will be enabling false wakeword detection, add preroll and build the initiator payload.
     std::ostringstream initiatorPayloadJson;
@@ -421,11 +543,12 @@ bool AudioInputProcessor::executeRecognize(
     }
 
     // Assemble the event payload.
+    std::string format = m_audioEncoder ? m_audioEncoder->getAVSFormatName() : PCM_FORMAT_NAME;
     std::ostringstream payload;
     // clang-format off
     payload << R"({)"
                    R"("profile":")" << provider.profile << R"(",)"
-                   R"("format":"AUDIO_L16_RATE_16000_CHANNELS_1")";
+                   R"("format":")" << format << R"(")";
     if (!initiatorJson.empty()) {
         payload << "," << initiatorJson;
     }
@@ -446,6 +569,34 @@ bool AudioInputProcessor::executeRecognize(
         ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to create attachment reader"));
         return false;
     }
+    // AVS does not send StopCapture for CLOSE_TALK, where the user ends the capture, so it is not endpointed here.
+    ++m_recognizeCount;
+    m_isLocallyEndpointed = false;
+    if (ASRProfile::CLOSE_TALK != provider.profile) {
+        auto detector = EndOfSpeechDetector::create(m_localEndpointing, provider.format.sampleRateHz);
+        if (detector) {
+            std::weak_ptr<AudioInputProcessor> weakThis = shared_from_this();
+            auto recognizeId = m_recognizeCount;
+            auto onEndOfSpeech = [weakThis, recognizeId]() {
+                if (auto aip = weakThis.lock()) {
+                    aip->m_executor.submit([aip, recognizeId]() { aip->executeOnLocalEndOfSpeech(recognizeId); });
+                }
+            };
+            auto endpointingReader = EndpointingAttachmentReader::create(m_reader, std::move(detector), onEndOfSpeech);
+            if (!endpointingReader) {
+                ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to create endpointing attachment reader"));
+                return false;
+            }
+            m_reader = endpointingReader;
+        }
+    }
+    if (m_audioEncoder) {
+        m_reader = EncodingAttachmentReader::create(m_reader, m_audioEncoder);
+        if (!m_reader) {
+            ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to create encoding attachment reader"));
+            return false;
+        }
+    }
 
     // Code below this point changes the state of AIP.  Formally update state now, and don't error out without calling
     // executeResetState() after this point.
@@ -454,8 +605,34 @@ bool AudioInputProcessor::executeRecognize(
     // Note that we're preparing to send a Recognize event.
     m_preparingToSend = true;
 
-    //  Start assembling the context; we'll service the callback after assembling our Recognize event.
-    m_contextManager->getContext(shared_from_this());
+    // In the concurrent mode, acquire the channel while the context is being fetched, rather than after it arrives.
+    if (m_concurrentFocusAcquisition && m_focusState != avsCommon::avs::FocusState::FOREGROUND) {
+        if (!m_focusManager->acquireChannel(CHANNEL_NAME, shared_from_this(), ACTIVITY_ID)) {
+            ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Unable to acquire channel"));
+            executeResetState();
+            return false;
+        }
+    }
+
+    /*
+     * Use a context prefetched recently enough, as long as it holds the current wakeword.  Otherwise, start
+     * assembling the context, unless a request is already in progress; we'll service the callback after assembling
+     * our Recognize event.
+     */
+    std::string prefetchedContext;
+    if (!m_prefetchedContext.empty() &&
+        std::chrono::steady_clock::now() - m_prefetchedContextTime <= PREFETCHED_CONTEXT_VALIDITY &&
+        (keyword.empty() || keyword == m_wakeword)) {
+        ACSDK_DEBUG(LX("executeRecognize").m("usingPrefetchedContext"));
+        prefetchedContext.swap(m_prefetchedContext);
+    } else {
+        m_prefetchedContext.clear();
+        m_isWaitingForContext = true;
+        if (0 == m_numPendingContextRequests) {
+            ++m_numPendingContextRequests;
+            m_contextManager->getContext(shared_from_this());
+        }
+    }
 
     // Stop the ExpectSpeech timer so we don't get a timeout.
     m_expectingSpeechTimer.stop();
@@ -475,9 +652,27 @@ bool AudioInputProcessor::executeRecognize(
     // We can't assemble the MessageRequest until we receive the context.
     m_request.reset();
 
+    if (!prefetchedContext.empty()) {
+        executeOnContextAvailable(prefetchedContext);
+    }
+
     return true;
 }
 
+void AudioInputProcessor::executeOnContextReceived(const std::string jsonContext) {
+    if (m_numPendingContextRequests > 0) {
+        --m_numPendingContextRequests;
+    }
+    if (!m_isWaitingForContext) {
+        ACSDK_DEBUG(LX("executeOnContextReceived").m("keptForNextRecognize"));
+        m_prefetchedContext = jsonContext;
+        m_prefetchedContextTime = std::chrono::steady_clock::now();
+        return;
+    }
+    m_isWaitingForContext = false;
+    executeOnContextAvailable(jsonContext);
+}
+
 void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContext) {
     ACSDK_DEBUG(LX("executeOnContextAvailable").d("jsonContext", jsonContext));
 
@@ -501,8 +696,9 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
         return;
     }
 
-    // Start acquiring the channel right away; we'll service the callback after assembling our Recognize event.
-    if (m_focusState != avsCommon::avs::FocusState::FOREGROUND) {
+    // Start acquiring the channel right away, unless executeRecognize() already has; the Recognize event does not
+    // wait for it.
+    if (!m_concurrentFocusAcquisition && m_focusState != avsCommon::avs::FocusState::FOREGROUND) {
         if (!m_focusManager->acquireChannel(CHANNEL_NAME, shared_from_this(), ACTIVITY_ID)) {
             ACSDK_ERROR(LX("executeOnContextAvailableFailed").d("reason", "Unable to acquire channel"));
             executeResetState();
@@ -510,24 +706,45 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
         }
     }
 
-    // Assemble the MessageRequest.  It will be sent by executeOnFocusChanged when we acquire the channel.
+    // Assemble the MessageRequest.
     auto dialogRequestId = avsCommon::utils::uuidGeneration::generateUUID();
     m_directiveSequencer->setDialogRequestId(dialogRequestId);
+    if (m_keywordEndTime != std::chrono::steady_clock::time_point()) {
+        metrics::DialogLatencyTracer::instance().startTrace(dialogRequestId, m_keywordEndTime);
+        m_keywordEndTime = std::chrono::steady_clock::time_point();
+    }
     auto msgIdAndJsonEvent = buildJsonEventString("Recognize", dialogRequestId, m_payload, jsonContext);
-    m_request = std::make_shared<avsCommon::avs::MessageRequest>(msgIdAndJsonEvent.second, m_reader);
+    m_request = std::make_shared<avsCommon::avs::MessageRequest>(
+        std::move(msgIdAndJsonEvent.second), m_reader, avsCommon::avs::MessageRequest::Priority::HIGH);
     m_request->addObserver(shared_from_this());
 
-    // If we already have focus, there won't be a callback to send the message, so send it now.
-    if (avsCommon::avs::FocusState::FOREGROUND == m_focusState) {
-        sendRequestNow();
-    }
+    /*
+     * Send it while the channel is being acquired, so that the upload starts as soon as the context is available.  The
+     * reader has been buffering the audio since executeRecognize(), so none of it is lost.  If the channel is denied,
+     * executeOnFocusChanged() resets the state, which closes the reader and ends the event.
+     */
+    sendRequestNow();
 }
 
 void AudioInputProcessor::executeOnContextFailure(const avsCommon::sdkInterfaces::ContextRequestError error) {
     ACSDK_ERROR(LX("executeOnContextFailure").d("error", error));
+    if (m_numPendingContextRequests > 0) {
+        --m_numPendingContextRequests;
+    }
+    if (!m_isWaitingForContext) {
+        return;
+    }
     executeResetState();
 }
 
+void AudioInputProcessor::executePrefetchContext() {
+    if (m_numPendingContextRequests > 0) {
+        return;
+    }
+    ++m_numPendingContextRequests;
+    m_contextManager->getContext(shared_from_this());
+}
+
 void AudioInputProcessor::executeOnFocusChanged(avsCommon::avs::FocusState newFocus) {
     ACSDK_DEBUG(LX("executeOnFocusChanged").d("newFocus", newFocus));
 
@@ -541,20 +758,21 @@ void AudioInputProcessor::executeOnFocusChanged(avsCommon::avs::FocusState newFo
         return;
     }
 
-    // We're not losing the channel (m_focusState == avsCommon::avs::FocusState::FOREGROUND).  For all
-    // states except RECOGNIZING, there's nothing more to do here.
-    if (m_state != ObserverInterface::State::RECOGNIZING) {
-        return;
-    }
-
-    // For a focus change to FOREGROUND in the Recognizing state, we may have a message queued up to send.  If we do,
-    // we can safely send it now.
-    if (m_request) {
-        sendRequestNow();
-    }
+    // We're not losing the channel (m_focusState == avsCommon::avs::FocusState::FOREGROUND), and the Recognize event
+    // is sent without waiting for it, so there's nothing more to do here.
 }
 
 bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_ptr<DirectiveInfo> info) {
+    if (m_isLocallyEndpointed && m_state != ObserverInterface::State::RECOGNIZING && info) {
+        // The capture was already ended on the device, so this is the StopCapture AVS sends for the same utterance.
+        ACSDK_DEBUG(LX("executeStopCapture").m("alreadyEndpointedLocally"));
+        m_isLocallyEndpointed = false;
+        if (info->result) {
+            info->result->setCompleted();
+        }
+        removeDirective(info);
+        return true;
+    }
     if (m_state != ObserverInterface::State::RECOGNIZING) {
         static const char* errorMessage = "StopCapture only allowed in RECOGNIZING state.";
         if (info) {
@@ -610,6 +828,9 @@ void AudioInputProcessor::executeResetState() {
     m_request.reset();
     m_preparingToSend = false;
     m_deferredStopCapture = nullptr;
+    m_isLocallyEndpointed = false;
+    m_isWaitingForContext = false;
+    m_keywordEndTime = std::chrono::steady_clock::time_point();
     if (m_focusState != avsCommon::avs::FocusState::NONE) {
         m_focusManager->releaseChannel(CHANNEL_NAME, shared_from_this());
     }
@@ -617,6 +838,17 @@ void AudioInputProcessor::executeResetState() {
     setState(ObserverInterface::State::IDLE);
 }
 
+void AudioInputProcessor::executeOnLocalEndOfSpeech(uint64_t recognizeId) {
+    if (recognizeId != m_recognizeCount || m_state != ObserverInterface::State::RECOGNIZING) {
+        ACSDK_DEBUG(LX("executeOnLocalEndOfSpeechIgnored").d("reason", "recognizeEnded"));
+        return;
+    }
+    ACSDK_DEBUG(LX("executeOnLocalEndOfSpeech").m("stoppingCapture"));
+    if (executeStopCapture()) {
+        m_isLocallyEndpointed = true;
+    }
+}
+
 bool AudioInputProcessor::executeExpectSpeech(
     std::chrono::milliseconds timeout,
     std::string initiator,
@@ -664,11 +896,13 @@ bool AudioInputProcessor::executeExpectSpeechTimedOut() {
     }
 
     auto msgIdAndJsonEvent = buildJsonEventString("ExpectSpeechTimedOut");
-    auto request = std::make_shared<avsCommon::avs::MessageRequest>(msgIdAndJsonEvent.second, m_reader);
+    auto request = std::make_shared<avsCommon::avs::MessageRequest>(
+        std::move(msgIdAndJsonEvent.second), m_reader, avsCommon::avs::MessageRequest::Priority::HIGH);
     request->addObserver(shared_from_this());
     m_messageSender->sendMessage(request);
     setState(ObserverInterface::State::IDLE);
     ACSDK_ERROR(LX("executeExpectSpeechFailed").d("reason", "Timed Out"));
+    avsCommon::utils::logger::FlightRecorderLogger::trigger("ExpectSpeechTimedOut");
     return true;
 }
 
@@ -0,0 +1,182 @@
+/*
+ * EncodingAttachmentReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/EncodingAttachmentReader.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::avs::attachment;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("EncodingAttachmentReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<EncodingAttachmentReader> EncodingAttachmentReader::create(
+    std::shared_ptr<AttachmentReader> source,
+    std::shared_ptr<AudioEncoderInterface> encoder) {
+    if (!source) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullSource"));
+        return nullptr;
+    }
+    if (!encoder) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullEncoder"));
+        return nullptr;
+    }
+    if (0 == encoder->getFrameSizeInSamples()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroFrameSize"));
+        return nullptr;
+    }
+    if (!encoder->reset()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "encoderResetFailed"));
+        return nullptr;
+    }
+    return std::shared_ptr<EncodingAttachmentReader>(new EncodingAttachmentReader(source, encoder));
+}
+
+EncodingAttachmentReader::EncodingAttachmentReader(
+    std::shared_ptr<AttachmentReader> source,
+    std::shared_ptr<AudioEncoderInterface> encoder) :
+        m_source{source},
+        m_encoder{encoder},
+        m_frame(encoder->getFrameSizeInSamples()),
+        m_frameFill{0},
+        m_encodedOffset{0},
+        m_isSourceDone{false},
+        m_finalStatus{ReadStatus::CLOSED} {
+}
+
+std::size_t EncodingAttachmentReader::read(
+    void* buf,
+    std::size_t numBytes,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullReadStatus"));
+        return 0;
+    }
+    if (!buf) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullBuf"));
+        *readStatus = ReadStatus::ERROR_INTERNAL;
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t bytesRead = 0;
+    auto status = ReadStatus::OK;
+    while (bytesRead < numBytes) {
+        if (m_encodedOffset < m_encoded.size()) {
+            auto count = std::min(numBytes - bytesRead, m_encoded.size() - m_encodedOffset);
+            std::memcpy(static_cast<uint8_t*>(buf) + bytesRead, m_encoded.data() + m_encodedOffset, count);
+            bytesRead += count;
+            m_encodedOffset += count;
+            continue;
+        }
+        m_encoded.clear();
+        m_encodedOffset = 0;
+        if (m_isSourceDone) {
+            status = m_finalStatus;
+            break;
+        }
+        status = fillEncodedLocked(timeoutMs);
+        if (m_encoded.empty() && !m_isSourceDone) {
+            break;
+        }
+    }
+
+    // Callers discard the data returned with a CLOSED or error status, so report those on the next call.
+    if (bytesRead == numBytes) {
+        *readStatus = ReadStatus::OK;
+    } else if (bytesRead > 0) {
+        *readStatus = ReadStatus::OK_WOULDBLOCK;
+    } else {
+        *readStatus = status;
+    }
+    return bytesRead;
+}
+
+void EncodingAttachmentReader::close(ClosePoint closePoint) {
+    if (ClosePoint::IMMEDIATELY == closePoint) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_encoded.clear();
+        m_encodedOffset = 0;
+        m_frameFill = 0;
+        m_isSourceDone = true;
+        m_finalStatus = ReadStatus::CLOSED;
+    }
+    m_source->close(closePoint);
+}
+
+AttachmentReader::ReadStatus EncodingAttachmentReader::fillEncodedLocked(std::chrono::milliseconds timeoutMs) {
+    auto status = ReadStatus::OK;
+    auto wantedBytes = (m_frame.size() - m_frameFill) * sizeof(int16_t);
+    auto bytesRead = m_source->read(m_frame.data() + m_frameFill, wantedBytes, &status, timeoutMs);
+    m_frameFill += bytesRead / sizeof(int16_t);
+
+    switch (status) {
+        case ReadStatus::OK:
+        case ReadStatus::OK_WOULDBLOCK:
+        case ReadStatus::OK_TIMEDOUT:
+            if (m_frameFill == m_frame.size() && !encodeFrameLocked()) {
+                m_isSourceDone = true;
+                m_finalStatus = ReadStatus::ERROR_INTERNAL;
+                return m_finalStatus;
+            }
+            return status;
+        case ReadStatus::CLOSED:
+            m_isSourceDone = true;
+            m_finalStatus = ReadStatus::CLOSED;
+            if (m_frameFill > 0 && !encodeFrameLocked()) {
+                m_finalStatus = ReadStatus::ERROR_INTERNAL;
+            }
+            return m_finalStatus;
+        case ReadStatus::ERROR_OVERRUN:
+        case ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+        case ReadStatus::ERROR_INTERNAL:
+            break;
+    }
+    ACSDK_ERROR(LX("fillEncodedFailed").d("reason", "sourceReadFailed"));
+    m_isSourceDone = true;
+    m_finalStatus = status;
+    return m_finalStatus;
+}
+
+bool EncodingAttachmentReader::encodeFrameLocked() {
+    std::fill(m_frame.begin() + m_frameFill, m_frame.end(), 0);
+    m_frameFill = 0;
+    if (!m_encoder->encode(m_frame.data(), &m_encoded)) {
+        ACSDK_ERROR(LX("encodeFrameFailed").d("reason", "encodeFailed"));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,159 @@
+/*
+ * EndOfSpeechDetector.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/EndOfSpeechDetector.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("EndOfSpeechDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of milliseconds per second.
+static const size_t MILLISECONDS_PER_SECOND = 1000;
+
+/// The duration of a frame.
+static const std::chrono::milliseconds FRAME_DURATION = std::chrono::milliseconds(10);
+
+/// The noise floor moves this fraction of the way toward the energy of each quiet frame which is louder than it.
+static const uint64_t NOISE_FLOOR_RISE_DIVISOR = 16;
+
+/// The default silence after speech which ends the utterance.
+static const std::chrono::milliseconds DEFAULT_TRAILING_SILENCE = std::chrono::milliseconds(800);
+
+/// The default amount of speech needed before the end of the utterance can be detected.
+static const std::chrono::milliseconds DEFAULT_MIN_SPEECH = std::chrono::milliseconds(300);
+
+/// The default smallest RMS amplitude of speech, about -40 dBFS.
+static const unsigned int DEFAULT_MIN_SPEECH_LEVEL = 300;
+
+/// The default ratio of the RMS amplitude of speech to that of the noise floor, about 10 dB.
+static const unsigned int DEFAULT_SPEECH_TO_NOISE_RATIO = 3;
+
+/**
+ * Gets the number of samples in a duration of audio.
+ *
+ * @param sampleRateHz The sample rate of the audio.
+ * @param duration The duration.
+ * @return The number of samples.
+ */
+static size_t toSamples(unsigned int sampleRateHz, std::chrono::milliseconds duration) {
+    return static_cast<size_t>(sampleRateHz) * duration.count() / MILLISECONDS_PER_SECOND;
+}
+
+EndOfSpeechDetector::Config EndOfSpeechDetector::getDefaultConfig() {
+    return {DEFAULT_TRAILING_SILENCE, DEFAULT_MIN_SPEECH, DEFAULT_MIN_SPEECH_LEVEL, DEFAULT_SPEECH_TO_NOISE_RATIO};
+}
+
+std::unique_ptr<EndOfSpeechDetector> EndOfSpeechDetector::create(const Config& config, unsigned int sampleRateHz) {
+    if (config.trailingSilence <= std::chrono::milliseconds::zero()) {
+        ACSDK_DEBUG(LX("createFailed").d("reason", "disabled"));
+        return nullptr;
+    }
+    if (config.minSpeech.count() < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "negativeMinSpeech"));
+        return nullptr;
+    }
+    if (0 == toSamples(sampleRateHz, FRAME_DURATION)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "sampleRateTooLow").d("sampleRateHz", sampleRateHz));
+        return nullptr;
+    }
+    if (0 == config.speechToNoiseRatio) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroSpeechToNoiseRatio"));
+        return nullptr;
+    }
+    return std::unique_ptr<EndOfSpeechDetector>(new EndOfSpeechDetector(config, sampleRateHz));
+}
+
+EndOfSpeechDetector::EndOfSpeechDetector(const Config& config, unsigned int sampleRateHz) :
+        m_frameSize{toSamples(sampleRateHz, FRAME_DURATION)},
+        m_minSpeechSamples{toSamples(sampleRateHz, config.minSpeech)},
+        m_trailingSilenceSamples{toSamples(sampleRateHz, config.trailingSilence)},
+        m_minSpeechEnergy{static_cast<uint64_t>(config.minSpeechLevel) * config.minSpeechLevel},
+        m_speechToNoiseEnergyRatio{static_cast<uint64_t>(config.speechToNoiseRatio) * config.speechToNoiseRatio},
+        // Start with a noise floor just under speech, so that speech at the start of the audio, such as the wakeword,
+        // is not taken for noise.
+        m_noiseFloor{m_minSpeechEnergy / m_speechToNoiseEnergyRatio},
+        m_frameEnergy{0},
+        m_frameFill{0},
+        m_speechSamples{0},
+        m_silenceSamples{0},
+        m_hasDetectedEndOfSpeech{false} {
+}
+
+bool EndOfSpeechDetector::process(const int16_t* samples, size_t numSamples, size_t* numSamplesMeasured) {
+    size_t i = 0;
+    if (samples) {
+        for (; i < numSamples && !m_hasDetectedEndOfSpeech; ++i) {
+            m_frameEnergy += static_cast<int32_t>(samples[i]) * samples[i];
+            if (++m_frameFill == m_frameSize) {
+                processFrame(m_frameEnergy / m_frameSize);
+                m_frameEnergy = 0;
+                m_frameFill = 0;
+            }
+        }
+    }
+    if (numSamplesMeasured) {
+        *numSamplesMeasured = i;
+    }
+    return m_hasDetectedEndOfSpeech;
+}
+
+bool EndOfSpeechDetector::hasDetectedEndOfSpeech() const {
+    return m_hasDetectedEndOfSpeech;
+}
+
+void EndOfSpeechDetector::processFrame(uint64_t energy) {
+    uint64_t threshold = std::max(m_minSpeechEnergy, m_noiseFloor * m_speechToNoiseEnergyRatio);
+    if (energy >= threshold) {
+        m_speechSamples += m_frameSize;
+        m_silenceSamples = 0;
+        return;
+    }
+
+    // Follow quiet frames down at once, and up slowly, so that short noises do not raise the floor much.
+    if (energy < m_noiseFloor) {
+        m_noiseFloor = energy;
+    } else {
+        m_noiseFloor += (energy - m_noiseFloor) / NOISE_FLOOR_RISE_DIVISOR;
+    }
+
+    if (m_speechSamples < m_minSpeechSamples || 0 == m_speechSamples) {
+        return;
+    }
+    m_silenceSamples += m_frameSize;
+    if (m_silenceSamples >= m_trailingSilenceSamples) {
+        ACSDK_DEBUG(LX("endOfSpeechDetected").d("speechSamples", m_speechSamples));
+        m_hasDetectedEndOfSpeech = true;
+    }
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
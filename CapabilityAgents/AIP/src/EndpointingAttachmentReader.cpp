@@ -0,0 +1,153 @@
+/*
+ * EndpointingAttachmentReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/EndpointingAttachmentReader.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::avs::attachment;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("EndpointingAttachmentReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<EndpointingAttachmentReader> EndpointingAttachmentReader::create(
+    std::shared_ptr<AttachmentReader> source,
+    std::unique_ptr<EndOfSpeechDetector> detector,
+    std::function<void()> onEndOfSpeech) {
+    if (!source) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullSource"));
+        return nullptr;
+    }
+    if (!detector) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullDetector"));
+        return nullptr;
+    }
+    if (!onEndOfSpeech) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullCallback"));
+        return nullptr;
+    }
+    return std::shared_ptr<EndpointingAttachmentReader>(
+        new EndpointingAttachmentReader(source, std::move(detector), onEndOfSpeech));
+}
+
+EndpointingAttachmentReader::EndpointingAttachmentReader(
+    std::shared_ptr<AttachmentReader> source,
+    std::unique_ptr<EndOfSpeechDetector> detector,
+    std::function<void()> onEndOfSpeech) :
+        m_source{source},
+        m_onEndOfSpeech{onEndOfSpeech},
+        m_detector{std::move(detector)},
+        m_partialSample{0, 0},
+        m_hasPartialSample{false},
+        m_isEndOfSpeech{false} {
+}
+
+std::size_t EndpointingAttachmentReader::read(
+    void* buf,
+    std::size_t numBytes,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullReadStatus"));
+        return 0;
+    }
+    if (!buf) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "nullBuf"));
+        *readStatus = ReadStatus::ERROR_INTERNAL;
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_isEndOfSpeech) {
+        *readStatus = ReadStatus::CLOSED;
+        return 0;
+    }
+    auto bytesRead = m_source->read(buf, numBytes, readStatus, timeoutMs);
+    if (0 == bytesRead || !detectLocked(static_cast<const uint8_t*>(buf), bytesRead, &bytesRead)) {
+        return bytesRead;
+    }
+    m_isEndOfSpeech = true;
+    lock.unlock();
+
+    // Return the audio up to the end of speech; the next read reports the end of the attachment.
+    *readStatus = bytesRead > 0 ? ReadStatus::OK_WOULDBLOCK : ReadStatus::CLOSED;
+    ACSDK_DEBUG(LX("read").m("endOfSpeech"));
+    m_onEndOfSpeech();
+    return bytesRead;
+}
+
+void EndpointingAttachmentReader::close(ClosePoint closePoint) {
+    m_source->close(closePoint);
+}
+
+bool EndpointingAttachmentReader::detectLocked(const uint8_t* bytes, size_t numBytes, size_t* numBytesMeasured) {
+    // Samples are assembled byte by byte, so that a sample split between reads is measured once it is whole.
+    std::vector<int16_t> samples;
+    samples.reserve(numBytes / sizeof(int16_t) + 1);
+    size_t offset = 0;
+    bool hadPartialSample = m_hasPartialSample;
+    if (m_hasPartialSample) {
+        m_partialSample[1] = bytes[0];
+        int16_t sample;
+        std::memcpy(&sample, m_partialSample, sizeof(sample));
+        samples.push_back(sample);
+        m_hasPartialSample = false;
+        offset = 1;
+    }
+    for (; offset + sizeof(int16_t) <= numBytes; offset += sizeof(int16_t)) {
+        int16_t sample;
+        std::memcpy(&sample, bytes + offset, sizeof(sample));
+        samples.push_back(sample);
+    }
+    if (offset < numBytes) {
+        m_partialSample[0] = bytes[offset];
+        m_hasPartialSample = true;
+    }
+    size_t numSamplesMeasured = 0;
+    if (!m_detector->process(samples.data(), samples.size(), &numSamplesMeasured)) {
+        *numBytesMeasured = numBytes;
+        return false;
+    }
+
+    // The first sample is the one split between reads, which starts with a byte returned by the previous read.
+    if (0 == numSamplesMeasured) {
+        *numBytesMeasured = 0;
+    } else if (hadPartialSample) {
+        *numBytesMeasured = 1 + (numSamplesMeasured - 1) * sizeof(int16_t);
+    } else {
+        *numBytesMeasured = numSamplesMeasured * sizeof(int16_t);
+    }
+    return true;
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
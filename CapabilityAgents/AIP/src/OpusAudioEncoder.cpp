@@ -0,0 +1,123 @@
+/*
+ * OpusAudioEncoder.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/OpusAudioEncoder.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("OpusAudioEncoder");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The sample rate of the audio AVS accepts.
+static const opus_int32 SAMPLE_RATE_HZ = 16000;
+
+/// The number of channels of the audio AVS accepts.
+static const int NUM_CHANNELS = 1;
+
+/// The bitrate of the "OPUS" format.
+static const opus_int32 BITRATE_BPS = 32000;
+
+/// The number of samples in a 20 ms frame.
+static const size_t FRAME_SIZE_IN_SAMPLES = SAMPLE_RATE_HZ / 50;
+
+/// The size of an encoded frame at @c BITRATE_BPS.
+static const size_t ENCODED_FRAME_SIZE = BITRATE_BPS / 8 / 50;
+
+/// The name of the format in the @c Recognize event.
+static const std::string AVS_FORMAT_NAME = "OPUS";
+
+std::unique_ptr<OpusAudioEncoder> OpusAudioEncoder::create() {
+    int error = OPUS_OK;
+    auto encoder = opus_encoder_create(SAMPLE_RATE_HZ, NUM_CHANNELS, OPUS_APPLICATION_VOIP, &error);
+    if (!encoder || error != OPUS_OK) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "opus_encoder_createFailed").d("error", opus_strerror(error)));
+        return nullptr;
+    }
+    std::unique_ptr<OpusAudioEncoder> instance(new OpusAudioEncoder(encoder));
+    if (opus_encoder_ctl(encoder, OPUS_SET_BITRATE(BITRATE_BPS)) != OPUS_OK ||
+        opus_encoder_ctl(encoder, OPUS_SET_VBR(0)) != OPUS_OK) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "setConstantBitrateFailed"));
+        return nullptr;
+    }
+    return instance;
+}
+
+OpusAudioEncoder::OpusAudioEncoder(::OpusEncoder* encoder) : m_encoder{encoder} {
+}
+
+OpusAudioEncoder::~OpusAudioEncoder() {
+    opus_encoder_destroy(m_encoder);
+}
+
+AudioFormat::Encoding OpusAudioEncoder::getEncoding() const {
+    return AudioFormat::Encoding::OPUS;
+}
+
+std::string OpusAudioEncoder::getAVSFormatName() const {
+    return AVS_FORMAT_NAME;
+}
+
+size_t OpusAudioEncoder::getFrameSizeInSamples() const {
+    return FRAME_SIZE_IN_SAMPLES;
+}
+
+bool OpusAudioEncoder::reset() {
+    if (opus_encoder_ctl(m_encoder, OPUS_RESET_STATE) != OPUS_OK) {
+        ACSDK_ERROR(LX("resetFailed").d("reason", "opus_encoder_ctlFailed"));
+        return false;
+    }
+    return true;
+}
+
+bool OpusAudioEncoder::encode(const int16_t* samples, std::vector<uint8_t>* output) {
+    if (!samples || !output) {
+        ACSDK_ERROR(LX("encodeFailed").d("reason", "nullArgument"));
+        return false;
+    }
+    auto offset = output->size();
+    output->resize(offset + ENCODED_FRAME_SIZE);
+    auto length = opus_encode(
+        m_encoder,
+        samples,
+        static_cast<int>(FRAME_SIZE_IN_SAMPLES),
+        output->data() + offset,
+        static_cast<opus_int32>(ENCODED_FRAME_SIZE));
+    if (length < 0) {
+        ACSDK_ERROR(LX("encodeFailed").d("reason", "opus_encodeFailed").d("error", opus_strerror(length)));
+        output->resize(offset);
+        return false;
+    }
+    output->resize(offset + length);
+    return true;
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -126,6 +126,10 @@ static const std::string STATE_WAKEWORD_KEY = "wakeword";
 /// JSON key for the context section of a message.
 static const std::string MESSAGE_CONTEXT_KEY = "context";
 
+/// A context returned to @c AudioInputProcessor::prefetchContext(), holding the state of a made-up component.
+static const std::string PREFETCHED_CONTEXT =
+    R"({"context":[{"header":{"namespace":"Test","name":"PrefetchedState"},"payload":{}}]})";
+
 /// JSON key for the event section of a message.
 static const std::string MESSAGE_EVENT_KEY = "event";
 
@@ -1390,6 +1394,67 @@ TEST_F(AudioInputProcessorTest, recognizeWakewordWithGoodBeginAndEnd) {
     EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
 }
 
+/**
+ * This function verifies that @c AudioInputProcessor::recognize() sends a partial preroll when there is less than
+ * 500ms of audio before the wakeword.
+ */
+TEST_F(AudioInputProcessorTest, recognizeWakewordWithShortPreroll) {
+    avsCommon::avs::AudioInputStream::Index begin = PREROLL_WORDS / 4;
+    avsCommon::avs::AudioInputStream::Index end = begin + WAKEWORD_WORDS;
+    EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
+}
+
+/**
+ * This function verifies that the preroll is trimmed to the audio which the stream still holds, instead of starting
+ * the upload from audio which has been overwritten.
+ */
+TEST_F(AudioInputProcessorTest, recognizeWakewordTrimsPrerollToStream) {
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    std::shared_ptr<avsCommon::avs::MessageRequest> request;
+
+    // Wrap the stream, so that only the newest audio is still held.
+    std::vector<Sample> audio(SDS_WORDS + WAKEWORD_WORDS);
+    std::iota(audio.begin(), audio.end(), 0);
+    ASSERT_EQ(m_writer->write(audio.data(), WAKEWORD_WORDS), static_cast<ssize_t>(WAKEWORD_WORDS));
+    ASSERT_EQ(m_writer->write(audio.data() + WAKEWORD_WORDS, SDS_WORDS), static_cast<ssize_t>(SDS_WORDS));
+    avsCommon::avs::AudioInputStream::Index margin = SAMPLE_RATE_HZ / 4;
+    avsCommon::avs::AudioInputStream::Index oldest = audio.size() + margin - m_audioProvider->stream->getDataSize();
+    avsCommon::avs::AudioInputStream::Index preroll = PREROLL_WORDS / 4;
+    avsCommon::avs::AudioInputStream::Index begin = oldest + preroll;
+    avsCommon::avs::AudioInputStream::Index end = begin + WAKEWORD_WORDS;
+
+    EXPECT_CALL(*m_mockContextManager, setState(RECOGNIZER_STATE, _, _, _)).Times(AtLeast(0));
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onContextAvailable(PREFETCHED_CONTEXT);
+    }));
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(2);
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillOnce(Invoke([&](std::shared_ptr<avsCommon::avs::MessageRequest> sent) {
+            std::lock_guard<std::mutex> lock(mutex);
+            request = sent;
+            conditionVariable.notify_all();
+        }));
+    RecognizeEvent recognize(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT);
+    ASSERT_TRUE(recognize.send(m_audioInputProcessor).get());
+
+    // The request is sent without waiting for the channel.
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&request] { return request != nullptr; }));
+
+    std::ostringstream indices;
+    indices << R"("startIndexInSamples":)" << preroll << R"(,"endIndexInSamples":)" << preroll + end - begin;
+    EXPECT_NE(request->getJsonContent().find(indices.str()), std::string::npos);
+
+    Sample first = 0;
+    auto status = avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(request->getAttachmentReader()->read(&first, sizeof(first), &status), sizeof(first));
+    EXPECT_EQ(first, static_cast<Sample>(oldest));
+}
+
 /// This function verifies that @c AudioInputProcessor::recognize() works with @c ASRProfile::CLOSE_TALK.
 TEST_F(AudioInputProcessorTest, recognizeCloseTalk) {
     auto audioProvider = *m_audioProvider;
@@ -1598,6 +1663,193 @@ TEST_F(AudioInputProcessorTest, contextFailureBuildContextError) {
     ASSERT_TRUE(testContextFailure(avsCommon::sdkInterfaces::ContextRequestError::BUILD_CONTEXT_ERROR));
 }
 
+/**
+ * This function verifies that a context fetched with @c AudioInputProcessor::prefetchContext() is sent with the next
+ * Recognize Event, without requesting the context again.
+ */
+TEST_F(AudioInputProcessorTest, recognizeWithPrefetchedContext) {
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bool done = false;
+
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onContextAvailable(PREFETCHED_CONTEXT);
+    }));
+    m_audioInputProcessor->prefetchContext().wait();
+    // Wait for the context to be received, which is queued behind the request.
+    m_audioInputProcessor->resetState().wait();
+
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(2);
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+        return true;
+    }));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillOnce(Invoke([&](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            EXPECT_NE(request->getJsonContent().find("PrefetchedState"), std::string::npos);
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            conditionVariable.notify_one();
+        }));
+    RecognizeEvent recognize(*m_audioProvider, Initiator::TAP);
+    ASSERT_TRUE(recognize.send(m_audioInputProcessor).get());
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&done] { return done; }));
+}
+
+/**
+ * This function verifies that local endpointing ends the audio of a Recognize Event at the end of speech, and that
+ * the StopCapture directive which follows it is completed.
+ */
+TEST_F(AudioInputProcessorTest, localEndOfSpeechStopsCapture) {
+    EndOfSpeechDetector::Config localEndpointing = {
+        std::chrono::milliseconds(100), std::chrono::milliseconds(50), 300, 3};
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        nullptr,
+        localEndpointing);
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader;
+    bool isBusy = false;
+
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onContextAvailable(PREFETCHED_CONTEXT);
+    }));
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(2);
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+        return true;
+    }));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillOnce(Invoke([&](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            std::lock_guard<std::mutex> lock(mutex);
+            reader = request->getAttachmentReader();
+            conditionVariable.notify_all();
+        }));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::BUSY))
+        .WillOnce(InvokeWithoutArgs([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            isBusy = true;
+            conditionVariable.notify_all();
+        }));
+    RecognizeEvent recognize(*m_audioProvider, Initiator::TAP);
+    ASSERT_TRUE(recognize.send(m_audioInputProcessor).get());
+
+    // Write 200 ms of speech followed by 200 ms of silence.
+    std::vector<Sample> audio(SAMPLE_RATE_HZ * 2 / 5, 0);
+    for (size_t i = 0; i < audio.size() / 2; ++i) {
+        audio[i] = static_cast<Sample>((i % 2) ? 3000 : -3000);
+    }
+    ASSERT_EQ(m_writer->write(audio.data(), audio.size()), static_cast<ssize_t>(audio.size()));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&reader] { return reader != nullptr; }));
+    lock.unlock();
+
+    // The audio ends after the trailing silence, before the end of what was written.
+    std::vector<Sample> buffer(audio.size());
+    size_t samplesRead = 0;
+    auto status = avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
+    while (status != avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED) {
+        auto bytesRead = reader->read(
+            buffer.data() + samplesRead, (buffer.size() - samplesRead) * sizeof(Sample), &status, TEST_TIMEOUT);
+        samplesRead += bytesRead / sizeof(Sample);
+        ASSERT_LT(samplesRead, buffer.size());
+    }
+    ASSERT_EQ(samplesRead, audio.size() * 3 / 4);
+
+    lock.lock();
+    ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&isBusy] { return isBusy; }));
+    lock.unlock();
+
+    // The StopCapture AVS sends for the same utterance is completed.
+    auto avsDirective = createAVSDirective(STOP_CAPTURE, WITH_DIALOG_REQUEST_ID);
+    auto result = avsCommon::utils::memory::make_unique<avsCommon::sdkInterfaces::test::MockDirectiveHandlerResult>();
+    bool isCompleted = false;
+    EXPECT_CALL(*result, setCompleted()).WillOnce(InvokeWithoutArgs([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        isCompleted = true;
+        conditionVariable.notify_all();
+    }));
+    EXPECT_CALL(*result, setFailed(_)).Times(0);
+    EXPECT_CALL(*m_mockFocusManager, releaseChannel(CHANNEL_NAME, _)).Times(AtLeast(0));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::IDLE)).Times(AtLeast(0));
+    std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> directiveHandler = m_audioInputProcessor;
+    directiveHandler->preHandleDirective(avsDirective, std::move(result));
+    EXPECT_TRUE(directiveHandler->handleDirective(avsDirective->getMessageId()));
+    lock.lock();
+    ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&isCompleted] { return isCompleted; }));
+}
+
+/**
+ * This function verifies that in the concurrent focus acquisition mode, the channel is acquired while the context is
+ * being fetched, and that the Recognize Event is sent once the context arrives.
+ */
+TEST_F(AudioInputProcessorTest, concurrentFocusAcquisition) {
+    static const bool concurrentFocusAcquisition = true;
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        nullptr,
+        EndOfSpeechDetector::Config(),
+        concurrentFocusAcquisition);
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bool sent = false;
+
+    // The context is only provided once the channel has been requested.
+    InSequence sequence;
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive());
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onContextAvailable(PREFETCHED_CONTEXT);
+    }));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).WillOnce(InvokeWithoutArgs([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        sent = true;
+        conditionVariable.notify_all();
+    }));
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive());
+    RecognizeEvent recognize(*m_audioProvider, Initiator::TAP);
+    ASSERT_TRUE(recognize.send(m_audioInputProcessor).get());
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(conditionVariable.wait_for(lock, TEST_TIMEOUT, [&sent] { return sent; }));
+}
+
 /// This function verifies that StopCapture directives fail in @c State::IDLE.
 TEST_F(AudioInputProcessorTest, preHandleAndHandleDirectiveStopCaptureWhenIdle) {
     ASSERT_TRUE(testStopCaptureDirectiveFails(WITH_DIALOG_REQUEST_ID));
@@ -0,0 +1,232 @@
+/*
+ * EncodingAttachmentReaderTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file EncodingAttachmentReaderTest.cpp
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AIP/EncodingAttachmentReader.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using avsCommon::avs::attachment::AttachmentReader;
+
+/// The number of samples in a frame of the fake encoder.
+static const size_t FRAME_SIZE = 4;
+
+/// A buffer size larger than any output of the tests.
+static const size_t BUFFER_SIZE = 64;
+
+/**
+ * An encoder which encodes each frame as one byte: the sum of its samples.
+ */
+class FakeAudioEncoder : public AudioEncoderInterface {
+public:
+    FakeAudioEncoder() : m_resets{0} {
+    }
+
+    avsCommon::utils::AudioFormat::Encoding getEncoding() const override {
+        return avsCommon::utils::AudioFormat::Encoding::OPUS;
+    }
+
+    std::string getAVSFormatName() const override {
+        return "FAKE";
+    }
+
+    size_t getFrameSizeInSamples() const override {
+        return FRAME_SIZE;
+    }
+
+    bool reset() override {
+        ++m_resets;
+        return true;
+    }
+
+    bool encode(const int16_t* samples, std::vector<uint8_t>* output) override {
+        int sum = 0;
+        for (size_t i = 0; i < FRAME_SIZE; ++i) {
+            sum += samples[i];
+        }
+        output->push_back(static_cast<uint8_t>(sum));
+        return true;
+    }
+
+    /// The number of calls to @c reset().
+    int m_resets;
+};
+
+/**
+ * A non-blocking reader of samples which the test writes.
+ */
+class FakeSourceReader : public AttachmentReader {
+public:
+    FakeSourceReader() : m_isClosed{false} {
+    }
+
+    size_t read(void* buf, size_t numBytes, ReadStatus* readStatus, std::chrono::milliseconds timeoutMs) override {
+        auto count = std::min(numBytes, m_data.size());
+        if (0 == count) {
+            *readStatus = m_isClosed ? ReadStatus::CLOSED : ReadStatus::OK_WOULDBLOCK;
+            return 0;
+        }
+        std::memcpy(buf, m_data.data(), count);
+        m_data.erase(m_data.begin(), m_data.begin() + count);
+        *readStatus = count == numBytes ? ReadStatus::OK : ReadStatus::OK_WOULDBLOCK;
+        return count;
+    }
+
+    void close(ClosePoint closePoint) override {
+        if (ClosePoint::IMMEDIATELY == closePoint) {
+            m_data.clear();
+        }
+        m_isClosed = true;
+    }
+
+    /**
+     * Make samples available to @c read().
+     *
+     * @param samples The samples to add.
+     */
+    void write(const std::vector<int16_t>& samples) {
+        auto bytes = reinterpret_cast<const uint8_t*>(samples.data());
+        m_data.insert(m_data.end(), bytes, bytes + samples.size() * sizeof(int16_t));
+    }
+
+    /// The bytes not read yet.
+    std::vector<uint8_t> m_data;
+    /// Whether the writer has closed.
+    bool m_isClosed;
+};
+
+/**
+ * Our GTest class.
+ */
+class EncodingAttachmentReaderTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Read from @c m_reader.
+     *
+     * @param status Where to put the status of the read.
+     * @return The bytes read.
+     */
+    std::vector<uint8_t> read(AttachmentReader::ReadStatus* status);
+
+    /// The reader of the LPCM audio.
+    std::shared_ptr<FakeSourceReader> m_source;
+    /// The encoder.
+    std::shared_ptr<FakeAudioEncoder> m_encoder;
+    /// The reader under test.
+    std::shared_ptr<EncodingAttachmentReader> m_reader;
+};
+
+void EncodingAttachmentReaderTest::SetUp() {
+    m_source = std::make_shared<FakeSourceReader>();
+    m_encoder = std::make_shared<FakeAudioEncoder>();
+    m_reader = EncodingAttachmentReader::create(m_source, m_encoder);
+    ASSERT_TRUE(m_reader);
+}
+
+std::vector<uint8_t> EncodingAttachmentReaderTest::read(AttachmentReader::ReadStatus* status) {
+    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    buffer.resize(m_reader->read(buffer.data(), buffer.size(), status));
+    return buffer;
+}
+
+/**
+ * Verify that creating the reader without a source or an encoder fails, and that the encoder is reset.
+ */
+TEST_F(EncodingAttachmentReaderTest, create) {
+    ASSERT_FALSE(EncodingAttachmentReader::create(nullptr, m_encoder));
+    ASSERT_FALSE(EncodingAttachmentReader::create(m_source, nullptr));
+    ASSERT_EQ(m_encoder->m_resets, 1);
+}
+
+/**
+ * Verify that only whole frames are encoded while the source is open, and that the rest is read once it is.
+ */
+TEST_F(EncodingAttachmentReaderTest, encodesWholeFrames) {
+    auto status = AttachmentReader::ReadStatus::OK;
+    ASSERT_TRUE(read(&status).empty());
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::OK_WOULDBLOCK);
+
+    m_source->write({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    ASSERT_EQ(read(&status), std::vector<uint8_t>({10, 26}));
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::OK_WOULDBLOCK);
+    ASSERT_TRUE(m_source->m_data.empty());
+
+    m_source->write({11, 12});
+    ASSERT_EQ(read(&status), std::vector<uint8_t>({42}));
+
+    // A buffer smaller than the encoded audio is filled, and the rest is kept for the next read.
+    m_source->write({1, 1, 1, 1, 2, 2, 2, 2});
+    uint8_t byte = 0;
+    ASSERT_EQ(m_reader->read(&byte, 1, &status), 1u);
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::OK);
+    ASSERT_EQ(byte, 4);
+    ASSERT_EQ(read(&status), std::vector<uint8_t>({8}));
+}
+
+/**
+ * Verify that the last partial frame is padded and returned when the source closes, followed by @c CLOSED.
+ */
+TEST_F(EncodingAttachmentReaderTest, padsLastFrame) {
+    m_source->write({1, 2, 3, 4, 5, 6});
+    m_source->close(AttachmentReader::ClosePoint::AFTER_DRAINING_CURRENT_BUFFER);
+
+    // The source reports that it is closed on the read after the last samples, so this takes more than one read.
+    std::vector<uint8_t> encoded;
+    auto status = AttachmentReader::ReadStatus::OK;
+    for (int i = 0; i < 3; ++i) {
+        auto bytes = read(&status);
+        encoded.insert(encoded.end(), bytes.begin(), bytes.end());
+        if (AttachmentReader::ReadStatus::CLOSED == status) {
+            ASSERT_TRUE(bytes.empty());
+            break;
+        }
+    }
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+    ASSERT_EQ(encoded, std::vector<uint8_t>({10, 11}));
+}
+
+/**
+ * Verify that closing immediately drops the audio which has not been returned.
+ */
+TEST_F(EncodingAttachmentReaderTest, closeImmediately) {
+    m_source->write({1, 2, 3, 4, 5, 6});
+    uint8_t byte = 0;
+    auto status = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(m_reader->read(&byte, 1, &status), 1u);
+
+    m_reader->close(AttachmentReader::ClosePoint::IMMEDIATELY);
+    ASSERT_TRUE(m_source->m_isClosed);
+    ASSERT_TRUE(read(&status).empty());
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,306 @@
+/*
+ * EndpointingAttachmentReaderTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file EndpointingAttachmentReaderTest.cpp
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AIP/EndOfSpeechDetector.h"
+#include "AIP/EndpointingAttachmentReader.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using avsCommon::avs::attachment::AttachmentReader;
+
+/// The sample rate of the audio in the tests.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of samples in a millisecond of the audio.
+static const size_t SAMPLES_PER_MS = SAMPLE_RATE_HZ / 1000;
+
+/// The amplitude of the speech in the tests.
+static const int16_t SPEECH_AMPLITUDE = 3000;
+
+/// The settings of the detectors in the tests.
+static const EndOfSpeechDetector::Config TEST_CONFIG = {std::chrono::milliseconds(100),
+                                                        std::chrono::milliseconds(50),
+                                                        300,
+                                                        3};
+
+/// A buffer size larger than any output of the tests.
+static const size_t BUFFER_SIZE = 8192;
+
+/**
+ * Make a square wave.
+ *
+ * @param amplitude The amplitude of the wave; zero makes silence.
+ * @param durationMs The duration of the wave in milliseconds.
+ * @return The samples of the wave.
+ */
+static std::vector<int16_t> makeAudio(int16_t amplitude, size_t durationMs) {
+    std::vector<int16_t> samples(durationMs * SAMPLES_PER_MS);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = (i % 2) ? amplitude : -amplitude;
+    }
+    return samples;
+}
+
+/**
+ * Pass audio to a detector in pieces of a given size.
+ *
+ * @param detector The detector.
+ * @param samples The audio.
+ * @param pieceSize The number of samples to pass at a time.
+ * @return Whether the end of speech was detected.
+ */
+static bool processInPieces(EndOfSpeechDetector* detector, const std::vector<int16_t>& samples, size_t pieceSize) {
+    bool detected = false;
+    for (size_t offset = 0; offset < samples.size(); offset += pieceSize) {
+        detected = detector->process(samples.data() + offset, std::min(pieceSize, samples.size() - offset));
+    }
+    return detected;
+}
+
+/**
+ * A non-blocking reader of samples which the test writes.
+ */
+class FakeSourceReader : public AttachmentReader {
+public:
+    FakeSourceReader() : m_isClosed{false} {
+    }
+
+    size_t read(void* buf, size_t numBytes, ReadStatus* readStatus, std::chrono::milliseconds timeoutMs) override {
+        auto count = std::min(numBytes, m_data.size());
+        if (0 == count) {
+            *readStatus = m_isClosed ? ReadStatus::CLOSED : ReadStatus::OK_WOULDBLOCK;
+            return 0;
+        }
+        std::memcpy(buf, m_data.data(), count);
+        m_data.erase(m_data.begin(), m_data.begin() + count);
+        *readStatus = count == numBytes ? ReadStatus::OK : ReadStatus::OK_WOULDBLOCK;
+        return count;
+    }
+
+    void close(ClosePoint closePoint) override {
+        if (ClosePoint::IMMEDIATELY == closePoint) {
+            m_data.clear();
+        }
+        m_isClosed = true;
+    }
+
+    /**
+     * Make samples available to @c read().
+     *
+     * @param samples The samples to add.
+     */
+    void write(const std::vector<int16_t>& samples) {
+        auto bytes = reinterpret_cast<const uint8_t*>(samples.data());
+        m_data.insert(m_data.end(), bytes, bytes + samples.size() * sizeof(int16_t));
+    }
+
+    /// The bytes not read yet.
+    std::vector<uint8_t> m_data;
+    /// Whether the writer has closed.
+    bool m_isClosed;
+};
+
+/**
+ * Our GTest class.
+ */
+class EndpointingAttachmentReaderTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Read from @c m_reader.
+     *
+     * @param status Where to put the status of the read.
+     * @param numBytes The number of bytes to ask for.
+     * @return The number of bytes read.
+     */
+    size_t read(AttachmentReader::ReadStatus* status, size_t numBytes = BUFFER_SIZE);
+
+    /// The reader of the LPCM audio.
+    std::shared_ptr<FakeSourceReader> m_source;
+    /// The number of times the end of speech was reported.
+    int m_endOfSpeechCount;
+    /// The reader under test.
+    std::shared_ptr<EndpointingAttachmentReader> m_reader;
+};
+
+void EndpointingAttachmentReaderTest::SetUp() {
+    m_source = std::make_shared<FakeSourceReader>();
+    m_endOfSpeechCount = 0;
+    m_reader = EndpointingAttachmentReader::create(
+        m_source, EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ), [this]() { ++m_endOfSpeechCount; });
+    ASSERT_TRUE(m_reader);
+}
+
+size_t EndpointingAttachmentReaderTest::read(AttachmentReader::ReadStatus* status, size_t numBytes) {
+    std::vector<uint8_t> buffer(numBytes);
+    return m_reader->read(buffer.data(), buffer.size(), status);
+}
+
+/**
+ * Verify that a disabled or invalid configuration does not create a detector.
+ */
+TEST(EndOfSpeechDetectorTest, create) {
+    ASSERT_FALSE(EndOfSpeechDetector::create(EndOfSpeechDetector::Config(), SAMPLE_RATE_HZ));
+    ASSERT_FALSE(EndOfSpeechDetector::create(TEST_CONFIG, 50));
+    auto config = TEST_CONFIG;
+    config.speechToNoiseRatio = 0;
+    ASSERT_FALSE(EndOfSpeechDetector::create(config, SAMPLE_RATE_HZ));
+    ASSERT_TRUE(EndOfSpeechDetector::create(EndOfSpeechDetector::getDefaultConfig(), SAMPLE_RATE_HZ));
+}
+
+/**
+ * Verify that the end of speech is detected once the trailing silence is complete, however the audio is split.
+ */
+TEST(EndOfSpeechDetectorTest, detectsTrailingSilence) {
+    for (size_t pieceSize : {1u, 7u, 160u, 1000u}) {
+        auto detector = EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ);
+        ASSERT_TRUE(detector);
+        ASSERT_FALSE(processInPieces(detector.get(), makeAudio(SPEECH_AMPLITUDE, 200), pieceSize));
+        ASSERT_FALSE(processInPieces(detector.get(), makeAudio(0, 90), pieceSize));
+        ASSERT_FALSE(detector->hasDetectedEndOfSpeech());
+        ASSERT_TRUE(processInPieces(detector.get(), makeAudio(0, 10), pieceSize));
+
+        // The detection is sticky.
+        ASSERT_TRUE(processInPieces(detector.get(), makeAudio(SPEECH_AMPLITUDE, 100), pieceSize));
+    }
+}
+
+/**
+ * Verify that a pause shorter than the trailing silence does not end the speech.
+ */
+TEST(EndOfSpeechDetectorTest, pauseDoesNotEndSpeech) {
+    auto detector = EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ);
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(SPEECH_AMPLITUDE, 200), 160));
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(0, 80), 160));
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(SPEECH_AMPLITUDE, 50), 160));
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(0, 80), 160));
+    ASSERT_TRUE(processInPieces(detector.get(), makeAudio(0, 20), 160));
+}
+
+/**
+ * Verify that silence, or too little speech, never ends the utterance, so that AVS ends it.
+ */
+TEST(EndOfSpeechDetectorTest, needsMinimumSpeech) {
+    auto detector = EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ);
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(0, 1000), 160));
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(SPEECH_AMPLITUDE, 30), 160));
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(0, 1000), 160));
+}
+
+/**
+ * Verify that the speech threshold rises with the background noise.
+ */
+TEST(EndOfSpeechDetectorTest, followsNoiseFloor) {
+    auto detector = EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ);
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(290, 2000), 160));
+
+    // Sound louder than the minimum level, but not enough louder than the noise, is not speech.
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(600, 200), 160));
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(290, 200), 160));
+    ASSERT_FALSE(detector->hasDetectedEndOfSpeech());
+
+    ASSERT_FALSE(processInPieces(detector.get(), makeAudio(SPEECH_AMPLITUDE, 200), 160));
+    ASSERT_TRUE(processInPieces(detector.get(), makeAudio(290, 100), 160));
+}
+
+/**
+ * Verify that creating the reader without a source, a detector or a callback fails.
+ */
+TEST_F(EndpointingAttachmentReaderTest, create) {
+    auto callback = []() {};
+    ASSERT_FALSE(EndpointingAttachmentReader::create(
+        nullptr, EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ), callback));
+    ASSERT_FALSE(EndpointingAttachmentReader::create(m_source, nullptr, callback));
+    ASSERT_FALSE(EndpointingAttachmentReader::create(
+        m_source, EndOfSpeechDetector::create(TEST_CONFIG, SAMPLE_RATE_HZ), nullptr));
+}
+
+/**
+ * Verify that the audio is passed through until the end of speech, and that the attachment ends there.
+ */
+TEST_F(EndpointingAttachmentReaderTest, endsAtEndOfSpeech) {
+    m_source->write(makeAudio(SPEECH_AMPLITUDE, 200));
+    auto status = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(read(&status), 200 * SAMPLES_PER_MS * sizeof(int16_t));
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::OK_WOULDBLOCK);
+    ASSERT_EQ(read(&status), 0u);
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::OK_WOULDBLOCK);
+
+    // The read which completes the trailing silence returns the audio up to it, and reports the end of speech.
+    m_source->write(makeAudio(0, 150));
+    ASSERT_EQ(read(&status), 100 * SAMPLES_PER_MS * sizeof(int16_t));
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::OK_WOULDBLOCK);
+    ASSERT_EQ(m_endOfSpeechCount, 1);
+
+    // The audio after the trailing silence is not returned.
+    m_source->write(makeAudio(0, 100));
+    ASSERT_EQ(read(&status), 0u);
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+    ASSERT_EQ(m_endOfSpeechCount, 1);
+    ASSERT_FALSE(m_source->m_data.empty());
+}
+
+/**
+ * Verify that samples split between reads are measured.
+ */
+TEST_F(EndpointingAttachmentReaderTest, oddSizedReads) {
+    m_source->write(makeAudio(SPEECH_AMPLITUDE, 200));
+    m_source->write(makeAudio(0, 100));
+    auto status = AttachmentReader::ReadStatus::OK;
+    size_t total = 0;
+    while (0 == m_endOfSpeechCount) {
+        auto bytesRead = read(&status, 333);
+        ASSERT_GT(bytesRead, 0u);
+        total += bytesRead;
+    }
+    ASSERT_EQ(total, 300 * SAMPLES_PER_MS * sizeof(int16_t));
+    ASSERT_EQ(read(&status), 0u);
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+}
+
+/**
+ * Verify that audio without an end of speech is passed through until the source closes, and that @c close() is
+ * passed to the source.
+ */
+TEST_F(EndpointingAttachmentReaderTest, passesThroughUntilClosed) {
+    m_source->write(makeAudio(SPEECH_AMPLITUDE, 100));
+    m_reader->close(AttachmentReader::ClosePoint::AFTER_DRAINING_CURRENT_BUFFER);
+    ASSERT_TRUE(m_source->m_isClosed);
+
+    auto status = AttachmentReader::ReadStatus::OK;
+    ASSERT_EQ(read(&status), 100 * SAMPLES_PER_MS * sizeof(int16_t));
+    ASSERT_EQ(read(&status), 0u);
+    ASSERT_EQ(status, AttachmentReader::ReadStatus::CLOSED);
+    ASSERT_EQ(m_endOfSpeechCount, 0);
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -23,7 +23,9 @@
 
 #include <AVSCommon/AVS/FocusState.h>
 
+#include <list>
 #include <set>
+#include <unordered_map>
 
 namespace alexaClientSDK {
 namespace capabilityAgents {
@@ -32,6 +34,10 @@ namespace alerts {
 /**
  * This class handles the management of AVS alerts.  This is essentially a time-ordered queue, where a timer is
  * set for the alert which must activate soonest.  As alerts are added or removed, this timer must be reset.
+ *
+ * By default every stored alert is kept in memory.  With a scheduling horizon, only the alerts due within the horizon
+ * are loaded from storage, and later ones are paged in as time advances.  The alerts beyond the horizon are then read
+ * from storage when they are needed, which is when context is collected and when one of them is deleted.
  */
 class AlertScheduler : public AlertObserverInterface {
 public:
@@ -67,9 +73,17 @@ public:
      *
      * @param storageFilePath The file we will expect to use for our database.
      * @param observer An observer which we will notify of all alert state changes.
+     * @param assetPrefetchWindow How long before its scheduled time the renderer is asked to prefetch the assets of
+     *     the next alert.  Zero disables prefetching.
+     * @param schedulingHorizon How far ahead of the current time alerts are kept in memory.  Zero keeps all of them.
+     *     A non-zero horizon should be well over twice @c assetPrefetchWindow, since it is paged in every half horizon.
      * @return Whether initialization was successful.
      */
-    bool initialize(const std::string& storageFilePath, std::shared_ptr<AlertObserverInterface> observer);
+    bool initialize(
+        const std::string& storageFilePath,
+        std::shared_ptr<AlertObserverInterface> observer,
+        std::chrono::seconds assetPrefetchWindow = std::chrono::seconds::zero(),
+        std::chrono::seconds schedulingHorizon = std::chrono::seconds::zero());
 
     /**
      * Schedule an alert for rendering.
@@ -97,6 +111,16 @@ public:
      */
     bool deleteAlert(const std::string& alertToken);
 
+    /**
+     * Delete several alerts from the schedule.  The alerts are erased from storage together, and the timer for the
+     * next alert is set once for all of them.
+     *
+     * @param alertTokens The AVS tokens identifying the alerts.
+     * @return Whether we successfully deleted all the alerts.  The alerts which were found are deleted even if some
+     * were not.
+     */
+    bool deleteAlerts(const std::list<std::string>& alertTokens);
+
     /**
      * Utility function to determine if an alert is currently active.
      *
@@ -182,6 +206,56 @@ private:
      */
     void onAlertReady(const std::string& alertToken);
 
+    /**
+     * Utility function to be called when the assets of an alert should be prefetched.
+     *
+     * @param alertToken The AVS token of the alert whose assets should be prefetched.
+     */
+    void onAssetPrefetchReady(const std::string& alertToken);
+
+    /**
+     * A handler function which will be called by our internal executor to prefetch the assets of an alert, if it is
+     * still the next one scheduled.
+     *
+     * @param alertToken The AVS token of the alert whose assets should be prefetched.
+     */
+    void executePrefetchAssets(const std::string& alertToken);
+
+    /**
+     * Utility function to ask the renderer to prefetch the assets of an alert.  This function requires @c m_mutex be
+     * locked.
+     *
+     * @param alert The alert whose assets should be prefetched.
+     */
+    void prefetchAssetsLocked(std::shared_ptr<Alert> alert);
+
+    /**
+     * Utility function to be called when the alerts which have come within the scheduling horizon should be loaded.
+     */
+    void onPageInReady();
+
+    /**
+     * A handler function which will be called by our internal executor to load the alerts which have come within the
+     * scheduling horizon.
+     */
+    void executePageInAlerts();
+
+    /**
+     * Utility function to load the alerts in storage which are scheduled beyond @c m_loadedUntil_Unix.  This function
+     * requires @c m_mutex be locked.
+     *
+     * @return The alerts which are not in memory.
+     */
+    std::vector<std::shared_ptr<Alert>> loadDeferredAlertsLocked();
+
+    /**
+     * Utility function to prepare an alert loaded from storage for scheduling, and add it to @c m_scheduledAlerts.
+     * This function requires @c m_mutex be locked.
+     *
+     * @param alert The alert to be scheduled.
+     */
+    void addLoadedAlertLocked(std::shared_ptr<Alert> alert);
+
     /**
      * Utility function to query if a given alert is active.  This function requires @c m_mutex be locked.
      *
@@ -198,6 +272,20 @@ private:
      */
     std::shared_ptr<Alert> getAlertLocked(const std::string& token) const;
 
+    /**
+     * A utility function to add an alert to the scheduled alerts.  This function requires @c m_mutex be locked.
+     *
+     * @param alert The alert to add.
+     */
+    void insertScheduledAlertLocked(std::shared_ptr<Alert> alert);
+
+    /**
+     * A utility function to remove an alert from the scheduled alerts.  This function requires @c m_mutex be locked.
+     *
+     * @param alert The alert to remove.
+     */
+    void eraseScheduledAlertLocked(std::shared_ptr<Alert> alert);
+
     /**
      * A utility function to deactivate the currently active alert.  This function requires @c m_mutex be locked.
      *
@@ -221,6 +309,15 @@ private:
 
     /// The maximum time-limit in seconds for which an alert will be valid beyond its scheduled time.
     std::chrono::seconds m_alertPastDueTimeLimit;
+    /// How long before its scheduled time the assets of the next alert are prefetched, or zero.
+    std::chrono::seconds m_assetPrefetchWindow;
+    /// How far ahead of the current time alerts are kept in memory, or zero to keep all of them.
+    std::chrono::seconds m_schedulingHorizon;
+    /**
+     * The time, in seconds since the Unix epoch, up to which stored alerts have been loaded into
+     * @c m_scheduledAlerts.  Alerts scheduled later may still be in memory, if they were scheduled or snoozed since.
+     */
+    int64_t m_loadedUntil_Unix;
     /// The current focus state for the Alerts channel.
     avsCommon::avs::FocusState m_focusState;
 
@@ -228,10 +325,18 @@ private:
     std::shared_ptr<Alert> m_activeAlert;
     /// All alerts which are scheduled to occur, ordered ascending by time.
     std::set<std::shared_ptr<Alert>, alerts::TimeComparator> m_scheduledAlerts;
+    /// The alerts in @c m_scheduledAlerts, keyed by token.
+    std::unordered_map<std::string, std::shared_ptr<Alert>> m_scheduledAlertsByToken;
 
     /// The timer for the next alert to go off, if one is not already active.
     avsCommon::utils::timing::Timer m_scheduledAlertTimer;
 
+    /// The timer for prefetching the assets of the next alert.
+    avsCommon::utils::timing::Timer m_assetPrefetchTimer;
+
+    /// The timer for loading the alerts which come within the scheduling horizon.
+    avsCommon::utils::timing::Timer m_pageInTimer;
+
     /**
      * The @c Executor which queues up operations from asynchronous API calls.
      *
@@ -21,6 +21,7 @@
 #include "Alerts/AlertObserverInterface.h"
 #include "Alerts/Alert.h"
 #include "Alerts/AlertScheduler.h"
+#include "Alerts/AlertsContext.h"
 
 #include <AVSCommon/AVS/CapabilityAgent.h>
 #include <AVSCommon/AVS/MessageRequest.h>
@@ -36,6 +37,7 @@
 #include <CertifiedSender/CertifiedSender.h>
 
 #include <chrono>
+#include <list>
 #include <set>
 #include <unordered_set>
 
@@ -265,7 +267,7 @@ private:
      */
     bool handleSetAlert(
         const std::shared_ptr<avsCommon::avs::AVSDirective>& directive,
-        const rapidjson::Document& payload,
+        const rapidjson::Value& payload,
         std::string* alertToken);
 
     /**
@@ -279,9 +281,23 @@ private:
      */
     bool handleDeleteAlert(
         const std::shared_ptr<avsCommon::avs::AVSDirective>& directive,
-        const rapidjson::Document& payload,
+        const rapidjson::Value& payload,
         std::string* alertToken);
 
+    /**
+     * A helper function to handle the DeleteAlerts directive.
+     *
+     * @param directive The AVS Directive.
+     * @param payload The payload containing the alert tokens.
+     * @param[out] alertTokens The AVS alert tokens, required for us to notify AVS whether the DeleteAlerts failed or
+     * succeeded.
+     * @return Whether the DeleteAlerts processing was successful.
+     */
+    bool handleDeleteAlerts(
+        const std::shared_ptr<avsCommon::avs::AVSDirective>& directive,
+        const rapidjson::Value& payload,
+        std::list<std::string>* alertTokens);
+
     /**
      * Utility function to send an Event to AVS.  All current Events per AVS documentation are with respect to
      * a single Alert, so the parameter is the given Alert token.  If isCertified is set to true, then the Event
@@ -294,6 +310,14 @@ private:
      */
     void sendEvent(const std::string& eventName, const std::string& alertToken, bool isCertified = false);
 
+    /**
+     * Utility function to send a certified Event to AVS with respect to several Alerts.
+     *
+     * @param eventName The name of the Event to be sent.
+     * @param alertTokens The tokens of the Alerts being sent to AVS within the Event.
+     */
+    void sendBulkEvent(const std::string& eventName, const std::list<std::string>& alertTokens);
+
     /**
      * A utility function to simplify calling the ExceptionEncounteredSender.
      *
@@ -352,6 +376,9 @@ private:
     /// Our helper object that takes care of managing alert persistence and rendering.
     AlertScheduler m_alertScheduler;
 
+    /// The AlertsState context, patched as the alerts managed by @c m_alertScheduler change.
+    AlertsContext m_alertsContext;
+
     /// @}
 
     /**
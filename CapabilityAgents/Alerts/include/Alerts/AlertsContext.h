@@ -0,0 +1,128 @@
+/*
+ * AlertsContext.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_ALERTS_CONTEXT_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_ALERTS_CONTEXT_H_
+
+#include "Alerts/AlertScheduler.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+
+/**
+ * The AlertsState context, kept serialized.  Each alert is serialized once, when it is set, and the context string is
+ * assembled from these fragments when it is next requested, so that a change to one alert does not re-serialize all
+ * the others.
+ *
+ * The owner patches this object as alerts are set, deleted, activated and stopped, and resets it from
+ * @c AlertScheduler::getContextInfo() when the alerts are loaded.
+ */
+class AlertsContext {
+public:
+    /**
+     * Constructor.  The context is initially empty.
+     */
+    AlertsContext();
+
+    /**
+     * Replace all the alerts in the context.
+     *
+     * @param alertsContextInfo The alerts which are scheduled and active.
+     */
+    void reset(const AlertScheduler::AlertsContextInfo& alertsContextInfo);
+
+    /**
+     * Add an alert to the context, or update it if it is already there.
+     *
+     * @param info The alert to add or update.
+     */
+    void setAlert(const Alert::ContextInfo& info);
+
+    /**
+     * Remove an alert from the context.  If the alert is active, it is no longer.
+     *
+     * @param token The AVS token identifying the alert.
+     */
+    void removeAlert(const std::string& token);
+
+    /**
+     * Mark an alert which is in the context as active, in place of the alert which was.
+     *
+     * @param token The AVS token identifying the alert.
+     */
+    void setActiveAlert(const std::string& token);
+
+    /**
+     * Mark no alert as active.
+     */
+    void clearActiveAlert();
+
+    /**
+     * Remove all the alerts from the context.
+     */
+    void clear();
+
+    /**
+     * Whether an alert is in the context.
+     *
+     * @param token The AVS token identifying the alert.
+     * @return Whether the alert is in the context.
+     */
+    bool hasAlert(const std::string& token);
+
+    /**
+     * Get the AlertsState context.
+     *
+     * @return The context as a JSON string.
+     */
+    std::string toJsonString();
+
+private:
+    /**
+     * Serialize an alert.
+     *
+     * @param info The alert to serialize.
+     * @return The alert as a JSON object.
+     */
+    static std::string serializeAlert(const Alert::ContextInfo& info);
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The serialized alerts, keyed by token.
+    std::map<std::string, std::string> m_alerts;
+
+    /// The token of the active alert, or empty if no alert is active.
+    std::string m_activeAlertToken;
+
+    /// The serialized context, which is valid if @c m_isContextValid.
+    std::string m_context;
+
+    /// Whether @c m_context reflects the alerts.
+    bool m_isContextValid;
+};
+
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_ALERTS_CONTEXT_H_
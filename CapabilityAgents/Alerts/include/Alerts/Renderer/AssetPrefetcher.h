@@ -0,0 +1,150 @@
+/*
+ * AssetPrefetcher.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_RENDERER_ASSET_PREFETCHER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_RENDERER_ASSET_PREFETCHER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace renderer {
+
+/**
+ * Downloads the assets of the next alert ahead of its scheduled time, so that the alert can start without waiting
+ * for the network.
+ *
+ * Only the assets of one alert are held at a time: each call to @c prefetch() forgets the assets which are not part
+ * of the new set.  The assets are downloaded one at a time, in order, on a thread of this class.  An asset which
+ * would take the cache over @c maxBytes is abandoned and left to be streamed from the network when the alert fires.
+ *
+ * This class is thread-safe.
+ */
+class AssetPrefetcher {
+public:
+    /**
+     * Create an @c AssetPrefetcher.
+     *
+     * @param contentFetcherFactory The factory used to create the fetchers which download the assets.
+     * @param maxBytes The maximum number of bytes to hold.
+     * @return The new @c AssetPrefetcher, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<AssetPrefetcher> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        size_t maxBytes);
+
+    /**
+     * Destructor.  Stops any download in progress.
+     */
+    ~AssetPrefetcher();
+
+    /**
+     * Download the assets of the next alert, replacing the assets held for a previous one.
+     *
+     * @param urls The URLs of the assets, in the order they will be played.
+     */
+    void prefetch(const std::vector<std::string>& urls);
+
+    /**
+     * Get a stream over the content of a downloaded asset.
+     *
+     * @param url The URL of the asset.
+     * @return A stream over the content of the asset, or @c nullptr if it has not been downloaded.
+     */
+    std::unique_ptr<std::istream> open(const std::string& url);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param contentFetcherFactory The factory used to create the fetchers which download the assets.
+     * @param maxBytes The maximum number of bytes to hold.
+     */
+    AssetPrefetcher(
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        size_t maxBytes);
+
+    /// The main loop of @c m_thread.
+    void downloadLoop();
+
+    /**
+     * Download an asset.  Called on @c m_thread without @c m_mutex held.
+     *
+     * @param url The URL of the asset.
+     * @return The content of the asset, or @c nullptr if the download failed, was cancelled or went over budget.
+     */
+    std::shared_ptr<const std::string> download(const std::string& url);
+
+    /**
+     * Whether the download in progress should stop.
+     *
+     * @param numBytes The number of bytes downloaded so far.
+     * @return Whether the download should stop.
+     */
+    bool shouldStopDownload(size_t numBytes);
+
+    /// The factory used to create the fetchers which download the assets.
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> m_contentFetcherFactory;
+
+    /// The maximum number of bytes to hold.
+    const size_t m_maxBytes;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when there may be something for @c m_thread to do.
+    std::condition_variable m_wakeTrigger;
+
+    /// The URLs passed to @c prefetch() which have not been downloaded yet.
+    std::deque<std::string> m_pendingUrls;
+
+    /// The downloaded assets, keyed by URL.
+    std::unordered_map<std::string, std::shared_ptr<const std::string>> m_assets;
+
+    /// The total size of @c m_assets, in bytes.
+    size_t m_cachedBytes;
+
+    /// The URL being downloaded, or empty.
+    std::string m_downloadingUrl;
+
+    /// Whether the download of @c m_downloadingUrl has been cancelled.
+    bool m_isDownloadCancelled;
+
+    /// Whether @c m_thread should exit.
+    bool m_isShuttingDown;
+
+    /// The thread which downloads the assets.
+    std::thread m_thread;
+};
+
+}  // namespace renderer
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_RENDERER_ASSET_PREFETCHER_H_
@@ -18,9 +18,11 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_RENDERER_RENDERER_H_
 #define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_ALERTS_INCLUDE_ALERTS_RENDERER_RENDERER_H_
 
+#include "Alerts/Renderer/AssetPrefetcher.h"
 #include "Alerts/Renderer/RendererInterface.h"
 #include "Alerts/Renderer/RendererObserverInterface.h"
 
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerObserverInterface.h>
@@ -45,10 +47,14 @@ public:
      * Creates a @c Renderer.
      *
      * @param mediaPlayer the @c MediaPlayerInterface that the @c Renderer object will interact with.
+     * @param contentFetcherFactory An optional factory used to download urls passed to @c prefetch().  If it is
+     *     @c nullptr, urls are always streamed by the @c MediaPlayer when they are rendered.
      * @return The @c Renderer object.
      */
     static std::shared_ptr<Renderer> create(
-        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> mediaPlayer);
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> mediaPlayer,
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory =
+            nullptr);
 
     void setObserver(RendererObserverInterface* observer) override;
 
@@ -60,6 +66,8 @@ public:
 
     void stop() override;
 
+    void prefetch(const std::vector<std::string>& urls) override;
+
     void onPlaybackStarted() override;
 
     void onPlaybackFinished() override;
@@ -71,8 +79,11 @@ private:
      * Constructor.
      *
      * @param mediaPlayer The @c MediaPlayerInterface, which will render audio for an alert.
+     * @param assetPrefetcher The @c AssetPrefetcher holding the downloaded urls, or @c nullptr.
      */
-    Renderer(std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> mediaPlayer);
+    Renderer(
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> mediaPlayer,
+        std::unique_ptr<AssetPrefetcher> assetPrefetcher);
 
     /**
      * @name Executor Thread Functions
@@ -126,6 +137,13 @@ private:
      */
     void executeOnPlaybackError(const avsCommon::utils::mediaPlayer::ErrorType& type, const std::string& error);
 
+    /**
+     * Set a url as the source of the @c MediaPlayer, from its prefetched content if it has been downloaded.
+     *
+     * @param url The url to render.
+     */
+    void executeSetUrlSource(const std::string& url);
+
     /// @}
 
     /**
@@ -167,6 +185,9 @@ private:
 
     /// @}
 
+    /// Holds the urls downloaded ahead of an alert, or @c nullptr if none are.  This class is thread-safe.
+    std::unique_ptr<AssetPrefetcher> m_assetPrefetcher;
+
     /**
      * The @c Executor which queues up operations from asynchronous API calls.
      *
@@ -75,6 +75,15 @@ public:
      * Stop rendering.
      */
     virtual void stop() = 0;
+
+    /**
+     * Download the urls of an alert which is about to fire, so that @c start() does not have to wait for the network
+     * to render them.  Renderers which do not cache urls may ignore this.
+     *
+     * @param urls The urls which will be passed to @c start().
+     */
+    virtual void prefetch(const std::vector<std::string>& urls) {
+    }
 };
 
 }  // namespace renderer
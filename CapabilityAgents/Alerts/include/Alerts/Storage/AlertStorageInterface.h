@@ -97,6 +97,35 @@ public:
      */
     virtual bool load(std::vector<std::shared_ptr<Alert>>* alertContainer) = 0;
 
+    /**
+     * Loads the alerts in the database which are scheduled after one time, and no later than another.  This lets a
+     * caller keep only the alerts due soon in memory.  The default implementation filters the result of @c load().
+     *
+     * @param afterUnix The time, in seconds since the Unix epoch, after which the alerts are scheduled.
+     * @param untilUnix The time, in seconds since the Unix epoch, at or before which the alerts are scheduled.
+     * @param[out] alertContainer The container where alerts should be stored.
+     * @return Whether the @c Alerts were successfully loaded.
+     */
+    virtual bool loadScheduledBetween(
+        int64_t afterUnix,
+        int64_t untilUnix,
+        std::vector<std::shared_ptr<Alert>>* alertContainer) {
+        if (!alertContainer) {
+            return false;
+        }
+        std::vector<std::shared_ptr<Alert>> alerts;
+        if (!load(&alerts)) {
+            return false;
+        }
+        for (auto& alert : alerts) {
+            auto scheduledTime = alert->getScheduledTime_Unix();
+            if (scheduledTime > afterUnix && scheduledTime <= untilUnix) {
+                alertContainer->push_back(alert);
+            }
+        }
+        return true;
+    }
+
     /**
      * Updates a database record of the @c Alert parameter.
      * The fields which are updated by this operation are the state and scheduled times of the alert.
@@ -20,8 +20,13 @@
 
 #include "Alerts/Storage/AlertStorageInterface.h"
 
+#include <memory>
+
 #include <sqlite3.h>
 
+#include <SQLiteStorage/SQLiteDatabaseService.h>
+#include <SQLiteStorage/SQLiteStatementCache.h>
+
 namespace alexaClientSDK {
 namespace capabilityAgents {
 namespace alerts {
@@ -30,6 +35,9 @@ namespace storage {
 /**
  * An implementation that allows us to store alerts using SQLite.
  *
+ * The alerts may instead be kept in a shared @c SQLiteDatabaseService, in which case each call runs on its storage
+ * thread and the file paths given to @c createDatabase() and @c open() are not used.
+ *
  * TODO: ACSDK-390 Investigate adding an abstraction layer between this class and the AlertStorageInterface,
  * where the middle layer is expressed purely in SQL.
  */
@@ -40,6 +48,14 @@ public:
      */
     SQLiteAlertStorage();
 
+    /**
+     * Constructor for a storage keeping its alerts in a shared database.
+     *
+     * @param database The shared database, or @c nullptr to keep them in a database file of their own.
+     */
+    explicit SQLiteAlertStorage(
+        std::shared_ptr<alexaClientSDK::storage::sqliteStorage::SQLiteDatabaseService> database);
+
     bool createDatabase(const std::string& filePath) override;
 
     bool open(const std::string& filePath) override;
@@ -54,6 +70,11 @@ public:
 
     bool load(std::vector<std::shared_ptr<Alert>>* alertContainer) override;
 
+    bool loadScheduledBetween(
+        int64_t afterUnix,
+        int64_t untilUnix,
+        std::vector<std::shared_ptr<Alert>>* alertContainer) override;
+
     bool modify(std::shared_ptr<Alert> alert) override;
 
     bool erase(std::shared_ptr<Alert> alert) override;
@@ -65,6 +86,15 @@ public:
     void printStats(StatLevel level) override;
 
 private:
+    /**
+     * Brings the alerts tables up to the current schema version, which is recorded in the database.  A database which
+     * has recorded the current version costs a single lookup; otherwise the migration and the indexes are applied in
+     * one transaction, and the version is recorded in it.
+     *
+     * @return Whether the tables are up to date.
+     */
+    bool upgradeSchema();
+
     /**
      * Utility function to migrate an existing V1 Alerts database file to the V2 format.
      *
@@ -88,8 +118,24 @@ private:
      */
     bool loadHelper(int dbVersion, std::vector<std::shared_ptr<Alert>>* alertContainer);
 
+    /**
+     * Start using the shared database, creating the alerts tables if asked to, and migrating or indexing them if they
+     * are out of date.  Called on the storage thread.
+     *
+     * @param dbHandle The connection to the shared database.
+     * @param createTables Whether to create the alerts tables if they do not exist.
+     * @return Whether the alerts tables exist in the shared database and are up to date.
+     */
+    bool useSharedDatabase(sqlite3* dbHandle, bool createTables);
+
+    /// The shared database keeping the alerts, or @c nullptr if they are kept in a database of their own.
+    std::shared_ptr<alexaClientSDK::storage::sqliteStorage::SQLiteDatabaseService> m_database;
+
     /// The sqlite database handle.
     sqlite3* m_dbHandle;
+
+    /// The statements run repeatedly on @c m_dbHandle, prepared once per connection.
+    alexaClientSDK::storage::sqliteStorage::SQLiteStatementCache m_statementCache;
 };
 
 }  // namespace storage
@@ -17,6 +17,9 @@
 
 #include "Alerts/AlertScheduler.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Timing/TimeUtils.h>
 
@@ -45,6 +48,9 @@ AlertScheduler::AlertScheduler(
         m_alertStorage{alertStorage},
         m_alertRenderer{alertRenderer},
         m_alertPastDueTimeLimit{alertPastDueTimeLimit},
+        m_assetPrefetchWindow{std::chrono::seconds::zero()},
+        m_schedulingHorizon{std::chrono::seconds::zero()},
+        m_loadedUntil_Unix{std::numeric_limits<int64_t>::max()},
         m_focusState{avsCommon::avs::FocusState::NONE} {
 }
 
@@ -52,13 +58,19 @@ void AlertScheduler::onAlertStateChange(const std::string& alertToken, State sta
     m_executor.submit([this, alertToken, state, reason]() { executeOnAlertStateChange(alertToken, state, reason); });
 }
 
-bool AlertScheduler::initialize(const std::string& storageFilePath, std::shared_ptr<AlertObserverInterface> observer) {
+bool AlertScheduler::initialize(
+    const std::string& storageFilePath,
+    std::shared_ptr<AlertObserverInterface> observer,
+    std::chrono::seconds assetPrefetchWindow,
+    std::chrono::seconds schedulingHorizon) {
     if (!observer) {
         ACSDK_ERROR(LX("initializeFailed").m("observer was nullptr."));
         return false;
     }
 
     m_observer = observer;
+    m_assetPrefetchWindow = std::max(assetPrefetchWindow, std::chrono::seconds::zero());
+    m_schedulingHorizon = std::max(schedulingHorizon, std::chrono::seconds::zero());
 
     if (!m_alertStorage->open(storageFilePath)) {
         ACSDK_INFO(LX("initialize").m("storage file does not exist.  Creating."));
@@ -77,7 +89,12 @@ bool AlertScheduler::initialize(const std::string& storageFilePath, std::shared_
     std::vector<std::shared_ptr<Alert>> alerts;
 
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_alertStorage->load(&alerts);
+    if (m_schedulingHorizon > std::chrono::seconds::zero()) {
+        m_loadedUntil_Unix = unixEpochNow + m_schedulingHorizon.count();
+        m_alertStorage->loadScheduledBetween(std::numeric_limits<int64_t>::min(), m_loadedUntil_Unix, &alerts);
+    } else {
+        m_alertStorage->load(&alerts);
+    }
 
     for (auto& alert : alerts) {
         if (alert->isPastDue(unixEpochNow, m_alertPastDueTimeLimit)) {
@@ -89,21 +106,24 @@ bool AlertScheduler::initialize(const std::string& storageFilePath, std::shared_
 
             m_alertStorage->erase(alert);
         } else {
-            // if it was active when the system last powered down, then re-init the state to set
-            if (Alert::State::ACTIVE == alert->getState()) {
-                alert->reset();
-                m_alertStorage->modify(alert);
-            }
-
-            alert->setRenderer(m_alertRenderer);
-            alert->setObserver(this);
-
-            m_scheduledAlerts.insert(alert);
+            addLoadedAlertLocked(alert);
         }
     }
 
     lock.unlock();
 
+    if (m_schedulingHorizon > std::chrono::seconds::zero()) {
+        auto period = std::max(m_schedulingHorizon / 2, std::chrono::seconds(1));
+        if (!m_pageInTimer.start(
+                period,
+                avsCommon::utils::timing::Timer::PeriodType::ABSOLUTE,
+                avsCommon::utils::timing::Timer::FOREVER,
+                std::bind(&AlertScheduler::onPageInReady, this))) {
+            ACSDK_ERROR(LX("initializeFailed").d("reason", "startPageInTimerFailed"));
+            return false;
+        }
+    }
+
     setTimerForNextAlert();
     return true;
 }
@@ -117,7 +137,9 @@ bool AlertScheduler::scheduleAlert(std::shared_ptr<Alert> alert) {
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    if (getAlertLocked(alert->getToken())) {
+    bool isDeferred = m_loadedUntil_Unix != std::numeric_limits<int64_t>::max() &&
+                      m_alertStorage->alertExists(alert->getToken());
+    if (getAlertLocked(alert->getToken()) || isDeferred) {
         // This is the best default behavior.  If we send SetAlertFailed for a duplicate Alert,
         // then AVS will follow up with a DeleteAlert Directive - just to ensure the client does not
         // have a bad version of the Alert hanging around.  We already have the Alert, so let's return true,
@@ -138,7 +160,7 @@ bool AlertScheduler::scheduleAlert(std::shared_ptr<Alert> alert) {
     }
     alert->setRenderer(m_alertRenderer);
     alert->setObserver(this);
-    m_scheduledAlerts.insert(alert);
+    insertScheduledAlertLocked(alert);
 
     if (!m_activeAlert) {
         setTimerForNextAlertLocked();
@@ -170,6 +192,15 @@ bool AlertScheduler::deleteAlert(const std::string& alertToken) {
 
     auto alert = getAlertLocked(alertToken);
 
+    if (!alert) {
+        for (auto& deferredAlert : loadDeferredAlertsLocked()) {
+            if (deferredAlert->getToken() == alertToken) {
+                alert = deferredAlert;
+                break;
+            }
+        }
+    }
+
     if (!alert) {
         ACSDK_ERROR(LX("handleDeleteAlertFailed").m("could not find alert in map").d("token", alertToken));
         return false;
@@ -179,12 +210,70 @@ bool AlertScheduler::deleteAlert(const std::string& alertToken) {
         ACSDK_ERROR(LX("handleDeleteAlertFailed").m("Could not erase alert from database").d("token", alertToken));
     }
 
-    m_scheduledAlerts.erase(alert);
+    eraseScheduledAlertLocked(alert);
     setTimerForNextAlertLocked();
 
     return true;
 }
 
+bool AlertScheduler::deleteAlerts(const std::list<std::string>& alertTokens) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    bool deletedAll = true;
+    bool deferredAlertsLoaded = false;
+    std::unordered_map<std::string, std::shared_ptr<Alert>> deferredAlerts;
+    std::vector<std::shared_ptr<Alert>> alertsToErase;
+    std::vector<int> alertDbIdsToErase;
+
+    for (const auto& alertToken : alertTokens) {
+        if (m_activeAlert && m_activeAlert->getToken() == alertToken) {
+            deactivateActiveAlertHelperLocked(Alert::StopReason::AVS_STOP);
+            continue;
+        }
+
+        auto alert = getAlertLocked(alertToken);
+
+        if (!alert) {
+            if (!deferredAlertsLoaded) {
+                for (auto& deferredAlert : loadDeferredAlertsLocked()) {
+                    deferredAlerts[deferredAlert->getToken()] = deferredAlert;
+                }
+                deferredAlertsLoaded = true;
+            }
+            auto it = deferredAlerts.find(alertToken);
+            if (it != deferredAlerts.end()) {
+                alert = it->second;
+                deferredAlerts.erase(it);
+            }
+        }
+
+        if (!alert) {
+            ACSDK_ERROR(LX("deleteAlertsFailed").m("could not find alert in map").d("token", alertToken));
+            deletedAll = false;
+            continue;
+        }
+
+        alertsToErase.push_back(alert);
+        alertDbIdsToErase.push_back(alert->getId());
+    }
+
+    if (alertsToErase.empty()) {
+        return deletedAll;
+    }
+
+    if (!m_alertStorage->erase(alertDbIdsToErase)) {
+        ACSDK_ERROR(
+            LX("deleteAlertsFailed").m("Could not erase alerts from database").d("count", alertsToErase.size()));
+    }
+
+    for (auto& alert : alertsToErase) {
+        eraseScheduledAlertLocked(alert);
+    }
+    setTimerForNextAlertLocked();
+
+    return deletedAll;
+}
+
 bool AlertScheduler::isAlertActive(std::shared_ptr<Alert> alert) {
     std::lock_guard<std::mutex> lock(m_mutex);
     return isAlertActiveLocked(alert);
@@ -250,6 +339,9 @@ AlertScheduler::AlertsContextInfo AlertScheduler::getContextInfo() {
     for (const auto& alert : m_scheduledAlerts) {
         alertContexts.scheduledAlerts.push_back(alert->getContextInfo());
     }
+    for (const auto& alert : loadDeferredAlertsLocked()) {
+        alertContexts.scheduledAlerts.push_back(alert->getContextInfo());
+    }
 
     if (m_activeAlert) {
         alertContexts.scheduledAlerts.push_back(m_activeAlert->getContextInfo());
@@ -272,8 +364,12 @@ void AlertScheduler::clearData() {
     if (m_scheduledAlertTimer.isActive()) {
         m_scheduledAlertTimer.stop();
     }
+    if (m_assetPrefetchTimer.isActive()) {
+        m_assetPrefetchTimer.stop();
+    }
 
     m_scheduledAlerts.clear();
+    m_scheduledAlertsByToken.clear();
 
     m_alertStorage->clearDatabase();
 }
@@ -283,6 +379,8 @@ void AlertScheduler::shutdown() {
     // also internally thread safe, so the mutex is not required to invoke these calls.
     m_executor.shutdown();
     m_scheduledAlertTimer.stop();
+    m_assetPrefetchTimer.stop();
+    m_pageInTimer.stop();
 
     m_observer.reset();
 
@@ -291,6 +389,7 @@ void AlertScheduler::shutdown() {
     m_alertRenderer.reset();
     m_activeAlert.reset();
     m_scheduledAlerts.clear();
+    m_scheduledAlertsByToken.clear();
 }
 
 void AlertScheduler::executeOnAlertStateChange(std::string alertToken, State state, std::string reason) {
@@ -332,7 +431,7 @@ void AlertScheduler::executeOnAlertStateChange(std::string alertToken, State sta
 
         case State::SNOOZED:
             m_alertStorage->modify(m_activeAlert);
-            m_scheduledAlerts.insert(m_activeAlert);
+            insertScheduledAlertLocked(m_activeAlert);
             m_activeAlert.reset();
             m_alertRenderer->setObserver(nullptr);
 
@@ -369,7 +468,7 @@ void AlertScheduler::executeOnAlertStateChange(std::string alertToken, State sta
             } else {
                 auto alert = getAlertLocked(alertToken);
                 if (alert) {
-                    m_scheduledAlerts.erase(alert);
+                    eraseScheduledAlertLocked(alert);
                     setTimerForNextAlertLocked();
                 }
             }
@@ -415,6 +514,9 @@ void AlertScheduler::setTimerForNextAlertLocked() {
     if (m_scheduledAlertTimer.isActive()) {
         m_scheduledAlertTimer.stop();
     }
+    if (m_assetPrefetchTimer.isActive()) {
+        m_assetPrefetchTimer.stop();
+    }
 
     int64_t timeNow;
     if (!getCurrentUnixTime(&timeNow)) {
@@ -428,6 +530,18 @@ void AlertScheduler::setTimerForNextAlertLocked() {
         secondsToWait = std::chrono::seconds::zero();
     }
 
+    if (m_assetPrefetchWindow > std::chrono::seconds::zero()) {
+        if (secondsToWait <= m_assetPrefetchWindow) {
+            prefetchAssetsLocked(alert);
+        } else if (!m_assetPrefetchTimer
+                        .start(
+                            secondsToWait - m_assetPrefetchWindow,
+                            std::bind(&AlertScheduler::onAssetPrefetchReady, this, alert->getToken()))
+                        .valid()) {
+            ACSDK_ERROR(LX("executeScheduleNextAlertForRenderingFailed").d("reason", "startPrefetchTimerFailed"));
+        }
+    }
+
     if (secondsToWait == std::chrono::seconds::zero()) {
         auto token = alert->getToken();
         m_executor.submit([this, token]() { executeNotifyObserver(token, AlertObserverInterface::State::READY, ""); });
@@ -446,6 +560,119 @@ void AlertScheduler::onAlertReady(const std::string& alertToken) {
         [this, alertToken]() { executeNotifyObserver(alertToken, AlertObserverInterface::State::READY, ""); });
 }
 
+void AlertScheduler::onAssetPrefetchReady(const std::string& alertToken) {
+    m_executor.submit([this, alertToken]() { executePrefetchAssets(alertToken); });
+}
+
+void AlertScheduler::executePrefetchAssets(const std::string& alertToken) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_activeAlert || m_scheduledAlerts.empty() || (*m_scheduledAlerts.begin())->getToken() != alertToken) {
+        ACSDK_DEBUG9(LX("executePrefetchAssets").d("reason", "alertNoLongerNext"));
+        return;
+    }
+    prefetchAssetsLocked(*m_scheduledAlerts.begin());
+}
+
+void AlertScheduler::prefetchAssetsLocked(std::shared_ptr<Alert> alert) {
+    if (!m_alertRenderer) {
+        return;
+    }
+
+    auto assetConfiguration = alert->getAssetConfiguration();
+    std::vector<std::string> urls;
+    for (auto& item : assetConfiguration.assetPlayOrderItems) {
+        urls.push_back(assetConfiguration.assets[item].url);
+    }
+    if (!assetConfiguration.backgroundAssetId.empty()) {
+        urls.push_back(assetConfiguration.assets[assetConfiguration.backgroundAssetId].url);
+    }
+    if (urls.empty()) {
+        return;
+    }
+
+    ACSDK_DEBUG1(LX("prefetchAssets").d("token", alert->getToken()).d("urls", urls.size()));
+    m_alertRenderer->prefetch(urls);
+}
+
+void AlertScheduler::onPageInReady() {
+    m_executor.submit([this]() { executePageInAlerts(); });
+}
+
+void AlertScheduler::executePageInAlerts() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_alertStorage) {
+        return;
+    }
+
+    int64_t unixEpochNow = 0;
+    if (!getCurrentUnixTime(&unixEpochNow)) {
+        ACSDK_ERROR(LX("executePageInAlertsFailed").d("reason", "could not get current unix time."));
+        return;
+    }
+
+    int64_t loadUntil_Unix = unixEpochNow + m_schedulingHorizon.count();
+    if (loadUntil_Unix <= m_loadedUntil_Unix) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<Alert>> alerts;
+    if (!m_alertStorage->loadScheduledBetween(m_loadedUntil_Unix, loadUntil_Unix, &alerts)) {
+        ACSDK_ERROR(LX("executePageInAlertsFailed").d("reason", "could not load alerts from storage."));
+        return;
+    }
+    m_loadedUntil_Unix = loadUntil_Unix;
+
+    auto nextAlert = m_scheduledAlerts.empty() ? nullptr : *m_scheduledAlerts.begin();
+    for (auto& alert : alerts) {
+        // an alert scheduled or snoozed since the last page-in is already in memory.
+        if (getAlertLocked(alert->getToken()) || (m_activeAlert && m_activeAlert->getToken() == alert->getToken())) {
+            continue;
+        }
+        addLoadedAlertLocked(alert);
+    }
+
+    ACSDK_DEBUG9(LX("executePageInAlerts").d("loaded", alerts.size()).d("scheduled", m_scheduledAlerts.size()));
+
+    if (!m_activeAlert && !m_scheduledAlerts.empty() && *m_scheduledAlerts.begin() != nextAlert) {
+        setTimerForNextAlertLocked();
+    }
+}
+
+std::vector<std::shared_ptr<Alert>> AlertScheduler::loadDeferredAlertsLocked() {
+    std::vector<std::shared_ptr<Alert>> deferredAlerts;
+    if (!m_alertStorage || std::numeric_limits<int64_t>::max() == m_loadedUntil_Unix) {
+        return deferredAlerts;
+    }
+
+    std::vector<std::shared_ptr<Alert>> alerts;
+    if (!m_alertStorage->loadScheduledBetween(m_loadedUntil_Unix, std::numeric_limits<int64_t>::max(), &alerts)) {
+        ACSDK_ERROR(LX("loadDeferredAlertsFailed").d("reason", "could not load alerts from storage."));
+        return deferredAlerts;
+    }
+
+    for (auto& alert : alerts) {
+        if (!getAlertLocked(alert->getToken()) &&
+            !(m_activeAlert && m_activeAlert->getToken() == alert->getToken())) {
+            deferredAlerts.push_back(alert);
+        }
+    }
+
+    return deferredAlerts;
+}
+
+void AlertScheduler::addLoadedAlertLocked(std::shared_ptr<Alert> alert) {
+    // if it was active when the system last powered down, then re-init the state to set
+    if (Alert::State::ACTIVE == alert->getState()) {
+        alert->reset();
+        m_alertStorage->modify(alert);
+    }
+
+    alert->setRenderer(m_alertRenderer);
+    alert->setObserver(this);
+
+    insertScheduledAlertLocked(alert);
+}
+
 void AlertScheduler::activateNextAlertLocked() {
     if (m_activeAlert) {
         ACSDK_ERROR(LX("activateNextAlertLockedFailed").d("reason", "An alert is already active."));
@@ -457,7 +684,7 @@ void AlertScheduler::activateNextAlertLocked() {
     }
 
     m_activeAlert = *(m_scheduledAlerts.begin());
-    m_scheduledAlerts.erase(m_scheduledAlerts.begin());
+    eraseScheduledAlertLocked(m_activeAlert);
 
     m_activeAlert->setFocusState(m_focusState);
     m_activeAlert->activate();
@@ -477,15 +704,24 @@ bool AlertScheduler::isAlertActiveLocked(std::shared_ptr<Alert> alert) const {
 }
 
 std::shared_ptr<Alert> AlertScheduler::getAlertLocked(const std::string& token) const {
-    for (auto& alert : m_scheduledAlerts) {
-        if (token == alert->getToken()) {
-            return alert;
-        }
+    auto it = m_scheduledAlertsByToken.find(token);
+    if (it != m_scheduledAlertsByToken.end()) {
+        return it->second;
     }
 
     return nullptr;
 }
 
+void AlertScheduler::insertScheduledAlertLocked(std::shared_ptr<Alert> alert) {
+    m_scheduledAlerts.insert(alert);
+    m_scheduledAlertsByToken[alert->getToken()] = alert;
+}
+
+void AlertScheduler::eraseScheduledAlertLocked(std::shared_ptr<Alert> alert) {
+    m_scheduledAlerts.erase(alert);
+    m_scheduledAlertsByToken.erase(alert->getToken());
+}
+
 }  // namespace alerts
 }  // namespace capabilityAgents
 }  // namespace alexaClientSDK
@@ -52,6 +52,8 @@ static const std::string KEY_TYPE = "type";
 static const std::string DIRECTIVE_NAME_SET_ALERT = "SetAlert";
 /// The value of the DeleteAlert Directive.
 static const std::string DIRECTIVE_NAME_DELETE_ALERT = "DeleteAlert";
+/// The value of the DeleteAlerts Directive.
+static const std::string DIRECTIVE_NAME_DELETE_ALERTS = "DeleteAlerts";
 
 /// The key in our config file to find the root of settings for this Capability Agent.
 static const std::string ALERTS_CAPABILITY_AGENT_CONFIGURATION_ROOT_KEY = "alertsCapabilityAgent";
@@ -65,6 +67,10 @@ static const std::string ALERTS_CAPABILITY_AGENT_ALARM_SHORT_AUDIO_FILE_PATH_KEY
 static const std::string ALERTS_CAPABILITY_AGENT_TIMER_AUDIO_FILE_PATH_KEY = "timerSoundFilePath";
 /// The key in our config file to find the timer short sound file path.
 static const std::string ALERTS_CAPABILITY_AGENT_TIMER_SHORT_AUDIO_FILE_PATH_KEY = "timerShortSoundFilePath";
+/// The key in our config file to find how many seconds before its scheduled time an alert's assets are prefetched.
+static const std::string ALERTS_CAPABILITY_AGENT_ASSET_PREFETCH_WINDOW_KEY = "assetPrefetchWindowSeconds";
+/// The key in our config file to find how many seconds ahead alerts are kept in memory.  Zero keeps all of them.
+static const std::string ALERTS_CAPABILITY_AGENT_SCHEDULING_HORIZON_KEY = "schedulingHorizonSeconds";
 
 /// The value of the SetAlertSucceeded Event name.
 static const std::string SET_ALERT_SUCCEEDED_EVENT_NAME = "SetAlertSucceeded";
@@ -74,6 +80,10 @@ static const std::string SET_ALERT_FAILED_EVENT_NAME = "SetAlertFailed";
 static const std::string DELETE_ALERT_SUCCEEDED_EVENT_NAME = "DeleteAlertSucceeded";
 /// The value of the DeleteAlertFailed Event name.
 static const std::string DELETE_ALERT_FAILED_EVENT_NAME = "DeleteAlertFailed";
+/// The value of the DeleteAlertsSucceeded Event name.
+static const std::string DELETE_ALERTS_SUCCEEDED_EVENT_NAME = "DeleteAlertsSucceeded";
+/// The value of the DeleteAlertsFailed Event name.
+static const std::string DELETE_ALERTS_FAILED_EVENT_NAME = "DeleteAlertsFailed";
 /// The value of the AlertStarted Event name.
 static const std::string ALERT_STARTED_EVENT_NAME = "AlertStarted";
 /// The value of the AlertStopped Event name.
@@ -87,20 +97,12 @@ static const std::string ALERT_ENTERED_BACKGROUND_EVENT_NAME = "AlertEnteredBack
 static const std::string EVENT_PAYLOAD_TOKEN_KEY = "token";
 /// The value of Token text in an Directive we may receive.
 static const std::string DIRECTIVE_PAYLOAD_TOKEN_KEY = "token";
+/// The value of Tokens text in an Event we may send, or a Directive we may receive.
+static const std::string PAYLOAD_TOKENS_KEY = "tokens";
 
 static const std::string AVS_CONTEXT_HEADER_NAMESPACE_VALUE_KEY = "Alerts";
 /// The value of the Alerts Context Names.
 static const std::string AVS_CONTEXT_HEADER_NAME_VALUE_KEY = "AlertsState";
-/// The value of the Alerts Context allAlerts node.
-static const std::string AVS_CONTEXT_ALL_ALERTS_TOKEN_KEY = "allAlerts";
-/// The value of the Alerts Context activeAlerts node.
-static const std::string AVS_CONTEXT_ACTIVE_ALERTS_TOKEN_KEY = "activeAlerts";
-/// The value of the Alerts Context token key.
-static const std::string AVS_CONTEXT_ALERT_TOKEN_KEY = "token";
-/// The value of the Alerts Context type key.
-static const std::string AVS_CONTEXT_ALERT_TYPE_KEY = "type";
-/// The value of the Alerts Context scheduled time key.
-static const std::string AVS_CONTEXT_ALERT_SCHEDULED_TIME_KEY = "scheduledTime";
 /// The value of Token text in an Event we may send.
 
 /// An empty dialogRequestId.
@@ -112,6 +114,8 @@ static const std::string NAMESPACE = "Alerts";
 static const avsCommon::avs::NamespaceAndName SET_ALERT{NAMESPACE, "SetAlert"};
 /// The DeleteAlert directive signature.
 static const avsCommon::avs::NamespaceAndName DELETE_ALERT{NAMESPACE, "DeleteAlert"};
+/// The DeleteAlerts directive signature.
+static const avsCommon::avs::NamespaceAndName DELETE_ALERTS{NAMESPACE, "DeleteAlerts"};
 /// The activityId string used with @c FocusManager by @c AlertsCapabilityAgent.
 static const std::string ACTIVITY_ID = "Alerts.AlertStarted";
 
@@ -125,59 +129,6 @@ static const std::string TAG("AlertsCapabilityAgent");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/**
- * Utility function to construct a rapidjson array of alert details, representing all the alerts currently managed.
- *
- * @param alertsInfo All the alerts being managed by this Capability Agent.
- * @param allocator The rapidjson allocator, required for the results of this function to be mergable with other
- * rapidjson::Value objects.
- * @return The rapidjson::Value representing the array.
- */
-static rapidjson::Value buildAllAlertsContext(
-    const std::vector<Alert::ContextInfo>& alertsInfo,
-    Document::AllocatorType& allocator) {
-    rapidjson::Value alertArray(rapidjson::kArrayType);
-
-    for (const auto& info : alertsInfo) {
-        rapidjson::Value alertJson;
-        alertJson.SetObject();
-        alertJson.AddMember(StringRef(AVS_CONTEXT_ALERT_TOKEN_KEY), info.token, allocator);
-        alertJson.AddMember(StringRef(AVS_CONTEXT_ALERT_TYPE_KEY), info.type, allocator);
-        alertJson.AddMember(StringRef(AVS_CONTEXT_ALERT_SCHEDULED_TIME_KEY), info.scheduledTime_ISO_8601, allocator);
-
-        alertArray.PushBack(alertJson, allocator);
-    }
-
-    return alertArray;
-}
-
-/**
- * Utility function to construct a rapidjson array of alert details, representing all the currently active alerts.
- *
- * @param alertsInfo The currently active alert, which may be nullptr if no alert is active.
- * @param allocator The rapidjson allocator, required for the results of this function to be mergable with other
- * rapidjson::Value objects.
- * @return The rapidjson::Value representing the array.
- */
-static rapidjson::Value buildActiveAlertsContext(
-    const std::vector<Alert::ContextInfo>& alertsInfo,
-    Document::AllocatorType& allocator) {
-    rapidjson::Value alertArray(rapidjson::kArrayType);
-
-    if (!alertsInfo.empty()) {
-        auto& info = alertsInfo[0];
-        rapidjson::Value alertJson;
-        alertJson.SetObject();
-        alertJson.AddMember(StringRef(AVS_CONTEXT_ALERT_TOKEN_KEY), info.token, allocator);
-        alertJson.AddMember(StringRef(AVS_CONTEXT_ALERT_TYPE_KEY), info.type, allocator);
-        alertJson.AddMember(StringRef(AVS_CONTEXT_ALERT_SCHEDULED_TIME_KEY), info.scheduledTime_ISO_8601, allocator);
-
-        alertArray.PushBack(alertJson, allocator);
-    }
-
-    return alertArray;
-}
-
 std::shared_ptr<AlertsCapabilityAgent> AlertsCapabilityAgent::create(
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
     std::shared_ptr<certifiedSender::CertifiedSender> certifiedMessageSender,
@@ -207,6 +158,7 @@ avsCommon::avs::DirectiveHandlerConfiguration AlertsCapabilityAgent::getConfigur
     avsCommon::avs::DirectiveHandlerConfiguration configuration;
     configuration[SET_ALERT] = avsCommon::avs::BlockingPolicy::NON_BLOCKING;
     configuration[DELETE_ALERT] = avsCommon::avs::BlockingPolicy::NON_BLOCKING;
+    configuration[DELETE_ALERTS] = avsCommon::avs::BlockingPolicy::NON_BLOCKING;
     return configuration;
 }
 
@@ -324,6 +276,7 @@ bool AlertsCapabilityAgent::initialize() {
         return false;
     }
 
+    m_alertsContext.reset(m_alertScheduler.getContextInfo());
     updateContextManager();
 
     return true;
@@ -403,12 +356,22 @@ bool AlertsCapabilityAgent::initializeAlerts(const ConfigurationNode& configurat
         return false;
     }
 
-    return m_alertScheduler.initialize(storageFilePath, shared_from_this());
+    int assetPrefetchWindowSeconds = 0;
+    configurationRoot.getInt(ALERTS_CAPABILITY_AGENT_ASSET_PREFETCH_WINDOW_KEY, &assetPrefetchWindowSeconds, 0);
+
+    int schedulingHorizonSeconds = 0;
+    configurationRoot.getInt(ALERTS_CAPABILITY_AGENT_SCHEDULING_HORIZON_KEY, &schedulingHorizonSeconds, 0);
+
+    return m_alertScheduler.initialize(
+        storageFilePath,
+        shared_from_this(),
+        std::chrono::seconds(assetPrefetchWindowSeconds),
+        std::chrono::seconds(schedulingHorizonSeconds));
 }
 
 bool AlertsCapabilityAgent::handleSetAlert(
     const std::shared_ptr<avsCommon::avs::AVSDirective>& directive,
-    const rapidjson::Document& payload,
+    const rapidjson::Value& payload,
     std::string* alertToken) {
     std::string alertType;
     if (!retrieveValue(payload, KEY_TYPE, &alertType)) {
@@ -447,13 +410,22 @@ bool AlertsCapabilityAgent::handleSetAlert(
     *alertToken = parsedAlert->getToken();
 
     if (m_alertScheduler.isAlertActive(parsedAlert)) {
-        return m_alertScheduler.snoozeAlert(parsedAlert->getToken(), parsedAlert->getScheduledTime_ISO_8601());
+        if (!m_alertScheduler.snoozeAlert(parsedAlert->getToken(), parsedAlert->getScheduledTime_ISO_8601())) {
+            return false;
+        }
+        // The context is updated when the alert reports that it is snoozed.
+        m_alertsContext.setAlert(parsedAlert->getContextInfo());
+        return true;
     }
 
     if (!m_alertScheduler.scheduleAlert(parsedAlert)) {
         return false;
     }
 
+    // A duplicate SetAlert succeeds, but leaves the alert which is already scheduled as it was.
+    if (!m_alertsContext.hasAlert(*alertToken)) {
+        m_alertsContext.setAlert(parsedAlert->getContextInfo());
+    }
     updateContextManager();
 
     return true;
@@ -461,7 +433,7 @@ bool AlertsCapabilityAgent::handleSetAlert(
 
 bool AlertsCapabilityAgent::handleDeleteAlert(
     const std::shared_ptr<avsCommon::avs::AVSDirective>& directive,
-    const rapidjson::Document& payload,
+    const rapidjson::Value& payload,
     std::string* alertToken) {
     if (!retrieveValue(payload, DIRECTIVE_PAYLOAD_TOKEN_KEY, alertToken)) {
         ACSDK_ERROR(LX("handleDeleteAlertFailed").m("Could not find token in the payload."));
@@ -472,11 +444,43 @@ bool AlertsCapabilityAgent::handleDeleteAlert(
         return false;
     }
 
+    m_alertsContext.removeAlert(*alertToken);
     updateContextManager();
 
     return true;
 }
 
+bool AlertsCapabilityAgent::handleDeleteAlerts(
+    const std::shared_ptr<avsCommon::avs::AVSDirective>& directive,
+    const rapidjson::Value& payload,
+    std::list<std::string>* alertTokens) {
+    rapidjson::Value::ConstMemberIterator tokensIt = payload.FindMember(PAYLOAD_TOKENS_KEY);
+    if (payload.MemberEnd() == tokensIt || !tokensIt->value.IsArray()) {
+        ACSDK_ERROR(LX("handleDeleteAlertsFailed").m("Could not find tokens in the payload."));
+        sendProcessingDirectiveException(directive, "Missing required property.");
+        return false;
+    }
+
+    for (const auto& tokenValue : tokensIt->value.GetArray()) {
+        std::string token;
+        if (!convertToValue(tokenValue, &token)) {
+            ACSDK_ERROR(LX("handleDeleteAlertsFailed").m("Token is not a string."));
+            sendProcessingDirectiveException(directive, "Invalid value.");
+            return false;
+        }
+        alertTokens->push_back(token);
+    }
+
+    bool deletedAll = m_alertScheduler.deleteAlerts(*alertTokens);
+
+    for (const auto& token : *alertTokens) {
+        m_alertsContext.removeAlert(token);
+    }
+    updateContextManager();
+
+    return deletedAll;
+}
+
 void AlertsCapabilityAgent::sendEvent(const std::string& eventName, const std::string& alertToken, bool isCertified) {
     rapidjson::Document payload(kObjectType);
     rapidjson::Document::AllocatorType& alloc = payload.GetAllocator();
@@ -499,12 +503,33 @@ void AlertsCapabilityAgent::sendEvent(const std::string& eventName, const std::s
             ACSDK_WARN(
                 LX("sendEvent").m("Not connected to AVS.  Not sending Event.").d("event details", jsonEventString));
         } else {
-            auto request = std::make_shared<MessageRequest>(jsonEventString);
+            auto request = std::make_shared<MessageRequest>(std::move(jsonEventString));
             m_messageSender->sendMessage(request);
         }
     }
 }
 
+void AlertsCapabilityAgent::sendBulkEvent(const std::string& eventName, const std::list<std::string>& alertTokens) {
+    rapidjson::Document payload(kObjectType);
+    rapidjson::Document::AllocatorType& alloc = payload.GetAllocator();
+
+    rapidjson::Value tokens(kArrayType);
+    for (const auto& token : alertTokens) {
+        tokens.PushBack(rapidjson::Value(token, alloc), alloc);
+    }
+    payload.AddMember(StringRef(PAYLOAD_TOKENS_KEY), tokens, alloc);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    if (!payload.Accept(writer)) {
+        ACSDK_ERROR(LX("sendBulkEventFailed").m("Could not construct payload."));
+        return;
+    }
+
+    m_certifiedSender->sendJSONMessage(
+        buildJsonEventString(eventName, EMPTY_DIALOG_REQUEST_ID, buffer.GetString()).second);
+}
+
 void AlertsCapabilityAgent::sendProcessingDirectiveException(
     const std::shared_ptr<AVSDirective>& directive,
     const std::string& errorMessage) {
@@ -531,10 +556,9 @@ void AlertsCapabilityAgent::executeHandleDirectiveImmediately(std::shared_ptr<Di
     ACSDK_DEBUG1(LX("executeHandleDirectiveImmediately"));
     auto& directive = info->directive;
 
-    rapidjson::Document payload;
-    payload.Parse(directive->getPayload());
+    auto payload = directive->getPayloadValue();
 
-    if (payload.HasParseError()) {
+    if (!payload) {
         std::string errorMessage = "Unable to parse payload";
         ACSDK_ERROR(LX("executeHandleDirectiveImmediatelyFailed").m(errorMessage));
         sendProcessingDirectiveException(directive, errorMessage);
@@ -545,23 +569,32 @@ void AlertsCapabilityAgent::executeHandleDirectiveImmediately(std::shared_ptr<Di
     std::string alertToken;
 
     if (DIRECTIVE_NAME_SET_ALERT == directiveName) {
-        if (handleSetAlert(directive, payload, &alertToken)) {
+        if (handleSetAlert(directive, *payload, &alertToken)) {
             sendEvent(SET_ALERT_SUCCEEDED_EVENT_NAME, alertToken, true);
         } else {
             sendEvent(SET_ALERT_FAILED_EVENT_NAME, alertToken, true);
         }
     } else if (DIRECTIVE_NAME_DELETE_ALERT == directiveName) {
-        if (handleDeleteAlert(directive, payload, &alertToken)) {
+        if (handleDeleteAlert(directive, *payload, &alertToken)) {
             sendEvent(DELETE_ALERT_SUCCEEDED_EVENT_NAME, alertToken, true);
         } else {
             sendEvent(DELETE_ALERT_FAILED_EVENT_NAME, alertToken, true);
         }
+    } else if (DIRECTIVE_NAME_DELETE_ALERTS == directiveName) {
+        std::list<std::string> alertTokens;
+        if (handleDeleteAlerts(directive, *payload, &alertTokens)) {
+            sendBulkEvent(DELETE_ALERTS_SUCCEEDED_EVENT_NAME, alertTokens);
+        } else {
+            sendBulkEvent(DELETE_ALERTS_FAILED_EVENT_NAME, alertTokens);
+        }
     }
 }
 
 void AlertsCapabilityAgent::executeOnDeregistered() {
     ACSDK_DEBUG1(LX("executeOnDeregistered"));
     m_alertScheduler.clearData();
+    m_alertsContext.clear();
+    updateContextManager();
 }
 
 void AlertsCapabilityAgent::executeOnConnectionStatusChanged(const Status status, const ChangedReason reason) {
@@ -586,33 +619,42 @@ void AlertsCapabilityAgent::executeOnAlertStateChange(
 
         case AlertObserverInterface::State::STARTED:
             sendEvent(ALERT_STARTED_EVENT_NAME, alertToken, true);
+            m_alertsContext.setActiveAlert(alertToken);
             updateContextManager();
             break;
 
         case AlertObserverInterface::State::SNOOZED:
             releaseChannel();
+            m_alertsContext.clearActiveAlert();
             updateContextManager();
             break;
 
         case AlertObserverInterface::State::STOPPED:
             sendEvent(ALERT_STOPPED_EVENT_NAME, alertToken, true);
             releaseChannel();
+            m_alertsContext.removeAlert(alertToken);
             updateContextManager();
             break;
 
         case AlertObserverInterface::State::COMPLETED:
             sendEvent(ALERT_STOPPED_EVENT_NAME, alertToken, true);
             releaseChannel();
+            m_alertsContext.removeAlert(alertToken);
             updateContextManager();
             break;
 
         case AlertObserverInterface::State::ERROR:
             releaseChannel();
+            m_alertsContext.removeAlert(alertToken);
             updateContextManager();
             break;
 
         case AlertObserverInterface::State::PAST_DUE:
             sendEvent(ALERT_STOPPED_EVENT_NAME, alertToken, true);
+            if (m_alertsContext.hasAlert(alertToken)) {
+                m_alertsContext.removeAlert(alertToken);
+                updateContextManager();
+            }
             break;
 
         case AlertObserverInterface::State::FOCUS_ENTERED_FOREGROUND:
@@ -650,6 +692,8 @@ void AlertsCapabilityAgent::executeNotifyObservers(
 void AlertsCapabilityAgent::executeRemoveAllAlerts() {
     ACSDK_DEBUG1(LX("executeRemoveAllAlerts"));
     m_alertScheduler.clearData();
+    m_alertsContext.clear();
+    updateContextManager();
 }
 
 void AlertsCapabilityAgent::executeOnLocalStop() {
@@ -672,24 +716,7 @@ void AlertsCapabilityAgent::updateContextManager() {
 }
 
 std::string AlertsCapabilityAgent::getContextString() {
-    rapidjson::Document state(kObjectType);
-    rapidjson::Document::AllocatorType& alloc = state.GetAllocator();
-
-    auto alertsContextInfo = m_alertScheduler.getContextInfo();
-    auto allAlertsJsonValue = buildAllAlertsContext(alertsContextInfo.scheduledAlerts, alloc);
-    auto activeAlertsJsonValue = buildActiveAlertsContext(alertsContextInfo.activeAlerts, alloc);
-
-    state.AddMember(StringRef(AVS_CONTEXT_ALL_ALERTS_TOKEN_KEY), allAlertsJsonValue, alloc);
-    state.AddMember(StringRef(AVS_CONTEXT_ACTIVE_ALERTS_TOKEN_KEY), activeAlertsJsonValue, alloc);
-
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    if (!state.Accept(writer)) {
-        ACSDK_ERROR(LX("getContextStringFailed").d("reason", "writerRefusedJsonObject"));
-        return "";
-    }
-
-    return buffer.GetString();
+    return m_alertsContext.toJsonString();
 }
 
 }  // namespace alerts
@@ -0,0 +1,139 @@
+/*
+ * AlertsContext.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "Alerts/AlertsContext.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+
+/// The key in our context for all alerts.
+static const std::string AVS_CONTEXT_ALL_ALERTS_TOKEN_KEY = "allAlerts";
+/// The key in our context for active alerts.
+static const std::string AVS_CONTEXT_ACTIVE_ALERTS_TOKEN_KEY = "activeAlerts";
+/// The key in our context for an alert's token.
+static const std::string AVS_CONTEXT_ALERT_TOKEN_KEY = "token";
+/// The key in our context for an alert's type.
+static const std::string AVS_CONTEXT_ALERT_TYPE_KEY = "type";
+/// The key in our context for an alert's scheduled time.
+static const std::string AVS_CONTEXT_ALERT_SCHEDULED_TIME_KEY = "scheduledTime";
+
+AlertsContext::AlertsContext() : m_isContextValid{false} {
+}
+
+void AlertsContext::reset(const AlertScheduler::AlertsContextInfo& alertsContextInfo) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_alerts.clear();
+    for (const auto& info : alertsContextInfo.scheduledAlerts) {
+        m_alerts[info.token] = serializeAlert(info);
+    }
+    m_activeAlertToken.clear();
+    if (!alertsContextInfo.activeAlerts.empty()) {
+        auto& info = alertsContextInfo.activeAlerts[0];
+        m_alerts[info.token] = serializeAlert(info);
+        m_activeAlertToken = info.token;
+    }
+    m_isContextValid = false;
+}
+
+void AlertsContext::setAlert(const Alert::ContextInfo& info) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_alerts[info.token] = serializeAlert(info);
+    m_isContextValid = false;
+}
+
+void AlertsContext::removeAlert(const std::string& token) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_alerts.erase(token);
+    if (m_activeAlertToken == token) {
+        m_activeAlertToken.clear();
+    }
+    m_isContextValid = false;
+}
+
+void AlertsContext::setActiveAlert(const std::string& token) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_activeAlertToken = token;
+    m_isContextValid = false;
+}
+
+void AlertsContext::clearActiveAlert() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_activeAlertToken.clear();
+    m_isContextValid = false;
+}
+
+void AlertsContext::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_alerts.clear();
+    m_activeAlertToken.clear();
+    m_isContextValid = false;
+}
+
+bool AlertsContext::hasAlert(const std::string& token) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_alerts.find(token) != m_alerts.end();
+}
+
+std::string AlertsContext::toJsonString() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isContextValid) {
+        return m_context;
+    }
+
+    // Clearing keeps the capacity of the previous context, so this usually does not allocate.
+    m_context.clear();
+    m_context += "{\"" + AVS_CONTEXT_ALL_ALERTS_TOKEN_KEY + "\":[";
+    bool isFirst = true;
+    for (const auto& alert : m_alerts) {
+        if (!isFirst) {
+            m_context += ',';
+        }
+        m_context += alert.second;
+        isFirst = false;
+    }
+    m_context += "],\"" + AVS_CONTEXT_ACTIVE_ALERTS_TOKEN_KEY + "\":[";
+    auto activeAlert = m_alerts.find(m_activeAlertToken);
+    if (!m_activeAlertToken.empty() && activeAlert != m_alerts.end()) {
+        m_context += activeAlert->second;
+    }
+    m_context += "]}";
+
+    m_isContextValid = true;
+    return m_context;
+}
+
+std::string AlertsContext::serializeAlert(const Alert::ContextInfo& info) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key(AVS_CONTEXT_ALERT_TOKEN_KEY.c_str());
+    writer.String(info.token.c_str(), info.token.size());
+    writer.Key(AVS_CONTEXT_ALERT_TYPE_KEY.c_str());
+    writer.String(info.type.c_str(), info.type.size());
+    writer.Key(AVS_CONTEXT_ALERT_SCHEDULED_TIME_KEY.c_str());
+    writer.String(info.scheduledTime_ISO_8601.c_str(), info.scheduledTime_ISO_8601.size());
+    writer.EndObject();
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,217 @@
+/*
+ * AssetPrefetcher.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "Alerts/Renderer/AssetPrefetcher.h"
+
+#include <chrono>
+#include <sstream>
+#include <unordered_set>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace renderer {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AssetPrefetcher");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// How long to block waiting for data before checking whether the download should stop.
+static const std::chrono::milliseconds READ_TIMEOUT(100);
+
+/// The number of bytes to read at once.
+static const size_t READ_CHUNK_SIZE = 16 * 1024;
+
+std::unique_ptr<AssetPrefetcher> AssetPrefetcher::create(
+    std::shared_ptr<HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    size_t maxBytes) {
+    if (!contentFetcherFactory) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullContentFetcherFactory"));
+        return nullptr;
+    }
+    if (0 == maxBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroBudget"));
+        return nullptr;
+    }
+    return std::unique_ptr<AssetPrefetcher>(new AssetPrefetcher(contentFetcherFactory, maxBytes));
+}
+
+AssetPrefetcher::AssetPrefetcher(
+    std::shared_ptr<HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    size_t maxBytes) :
+        m_contentFetcherFactory{contentFetcherFactory},
+        m_maxBytes{maxBytes},
+        m_cachedBytes{0},
+        m_isDownloadCancelled{false},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&AssetPrefetcher::downloadLoop, this);
+}
+
+AssetPrefetcher::~AssetPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeTrigger.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void AssetPrefetcher::prefetch(const std::vector<std::string>& urls) {
+    std::unordered_set<std::string> wanted(urls.begin(), urls.end());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Forget the assets of the previous alert which this one does not use.
+    for (auto it = m_assets.begin(); it != m_assets.end();) {
+        if (wanted.count(it->first)) {
+            ++it;
+        } else {
+            m_cachedBytes -= it->second->size();
+            it = m_assets.erase(it);
+        }
+    }
+    if (!m_downloadingUrl.empty() && !wanted.count(m_downloadingUrl)) {
+        m_isDownloadCancelled = true;
+    }
+
+    m_pendingUrls.clear();
+    std::unordered_set<std::string> queued;
+    for (const auto& url : urls) {
+        if (url.empty() || m_assets.count(url) || !queued.insert(url).second) {
+            continue;
+        }
+        if (url == m_downloadingUrl && !m_isDownloadCancelled) {
+            continue;
+        }
+        m_pendingUrls.push_back(url);
+    }
+    ACSDK_DEBUG9(LX("prefetch").d("urls", urls.size()).d("pending", m_pendingUrls.size()));
+    m_wakeTrigger.notify_all();
+}
+
+std::unique_ptr<std::istream> AssetPrefetcher::open(const std::string& url) {
+    std::shared_ptr<const std::string> asset;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_assets.find(url);
+        if (it == m_assets.end()) {
+            ACSDK_DEBUG9(LX("openMiss").sensitive("url", url));
+            return nullptr;
+        }
+        asset = it->second;
+    }
+    ACSDK_DEBUG9(LX("openHit").d("size", asset->size()).sensitive("url", url));
+    return avsCommon::utils::memory::make_unique<std::istringstream>(*asset);
+}
+
+void AssetPrefetcher::downloadLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeTrigger.wait(lock, [this]() { return m_isShuttingDown || !m_pendingUrls.empty(); });
+        if (m_isShuttingDown) {
+            return;
+        }
+        m_downloadingUrl = m_pendingUrls.front();
+        m_pendingUrls.pop_front();
+        m_isDownloadCancelled = false;
+        auto url = m_downloadingUrl;
+        lock.unlock();
+
+        auto data = download(url);
+
+        lock.lock();
+        if (data && !m_isDownloadCancelled && m_cachedBytes + data->size() <= m_maxBytes) {
+            m_cachedBytes += data->size();
+            m_assets[url] = data;
+            ACSDK_DEBUG(LX("assetPrefetched").d("size", data->size()).sensitive("url", url));
+        }
+        m_downloadingUrl.clear();
+    }
+}
+
+std::shared_ptr<const std::string> AssetPrefetcher::download(const std::string& url) {
+    auto fetcher = m_contentFetcherFactory->create(url);
+    if (!fetcher) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "nullFetcher").sensitive("url", url));
+        return nullptr;
+    }
+    auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    if (!content || !content->dataStream) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "getContentFailed").sensitive("url", url));
+        return nullptr;
+    }
+    auto reader = content->dataStream->createReader(AttachmentReader::Policy::BLOCKING);
+    if (!reader) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "createReaderFailed").sensitive("url", url));
+        return nullptr;
+    }
+
+    auto data = std::make_shared<std::string>();
+    char buffer[READ_CHUNK_SIZE];
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (status != AttachmentReader::ReadStatus::CLOSED) {
+        if (shouldStopDownload(data->size())) {
+            ACSDK_DEBUG(LX("downloadAbandoned").d("size", data->size()).sensitive("url", url));
+            return nullptr;
+        }
+        auto count = reader->read(buffer, sizeof(buffer), &status, READ_TIMEOUT);
+        data->append(buffer, count);
+        switch (status) {
+            case AttachmentReader::ReadStatus::OK:
+            case AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+            case AttachmentReader::ReadStatus::OK_TIMEDOUT:
+            case AttachmentReader::ReadStatus::CLOSED:
+                break;
+            case AttachmentReader::ReadStatus::ERROR_OVERRUN:
+            case AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case AttachmentReader::ReadStatus::ERROR_INTERNAL:
+                ACSDK_ERROR(LX("downloadFailed").d("reason", "readFailed").sensitive("url", url));
+                return nullptr;
+        }
+    }
+    // The status code is known once the body has started, and the body has ended, so this does not block.
+    auto statusCode = content->statusCode.get();
+    if (statusCode != 200) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "unexpectedStatusCode").d("statusCode", statusCode));
+        return nullptr;
+    }
+    data->shrink_to_fit();
+    return data;
+}
+
+bool AssetPrefetcher::shouldStopDownload(size_t numBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isShuttingDown || m_isDownloadCancelled || m_cachedBytes + numBytes > m_maxBytes;
+}
+
+}  // namespace renderer
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
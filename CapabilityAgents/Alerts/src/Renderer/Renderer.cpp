@@ -20,13 +20,12 @@
 //#include "Alerts/Storage/AlertStorageInterface.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 
-#include <fstream>
-
 namespace alexaClientSDK {
 namespace capabilityAgents {
 namespace alerts {
 namespace renderer {
 
+using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::utils::logger;
 using namespace avsCommon::utils::mediaPlayer;
 
@@ -40,13 +39,27 @@ static const std::string TAG("Renderer");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-std::shared_ptr<Renderer> Renderer::create(std::shared_ptr<MediaPlayerInterface> mediaPlayer) {
+/// The maximum number of bytes of prefetched urls to hold.
+static const size_t MAX_PREFETCHED_BYTES = 4 * 1024 * 1024;
+
+std::shared_ptr<Renderer> Renderer::create(
+    std::shared_ptr<MediaPlayerInterface> mediaPlayer,
+    std::shared_ptr<HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) {
     if (!mediaPlayer) {
         ACSDK_ERROR(LX("createFailed").m("mediaPlayer parameter was nullptr."));
         return nullptr;
     }
 
-    auto renderer = std::shared_ptr<Renderer>(new Renderer{mediaPlayer});
+    std::unique_ptr<AssetPrefetcher> assetPrefetcher;
+    if (contentFetcherFactory) {
+        assetPrefetcher = AssetPrefetcher::create(contentFetcherFactory, MAX_PREFETCHED_BYTES);
+        if (!assetPrefetcher) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "createAssetPrefetcherFailed"));
+            return nullptr;
+        }
+    }
+
+    auto renderer = std::shared_ptr<Renderer>(new Renderer{mediaPlayer, std::move(assetPrefetcher)});
     mediaPlayer->setObserver(renderer);
     return renderer;
 }
@@ -84,6 +97,12 @@ void Renderer::stop() {
     m_executor.submit([this]() { executeStop(); });
 }
 
+void Renderer::prefetch(const std::vector<std::string>& urls) {
+    if (m_assetPrefetcher) {
+        m_assetPrefetcher->prefetch(urls);
+    }
+}
+
 void Renderer::onPlaybackStarted() {
     m_executor.submit([this]() { executeOnPlaybackStarted(); });
 }
@@ -96,14 +115,17 @@ void Renderer::onPlaybackError(const avsCommon::utils::mediaPlayer::ErrorType& t
     m_executor.submit([this, type, error]() { executeOnPlaybackError(type, error); });
 }
 
-Renderer::Renderer(std::shared_ptr<MediaPlayerInterface> mediaPlayer) :
+Renderer::Renderer(
+    std::shared_ptr<MediaPlayerInterface> mediaPlayer,
+    std::unique_ptr<AssetPrefetcher> assetPrefetcher) :
         m_mediaPlayer{mediaPlayer},
         m_observer{nullptr},
         m_nextUrlIndexToRender{0},
         m_loopCount{0},
         m_loopPause{std::chrono::milliseconds{0}},
         m_isRendering{false},
-        m_isStopping{false} {
+        m_isStopping{false},
+        m_assetPrefetcher{std::move(assetPrefetcher)} {
 }
 
 void Renderer::executeSetObserver(RendererObserverInterface* observer) {
@@ -135,27 +157,26 @@ void Renderer::executeStart(
     // TODO : ACSDK-389 to update the local audio to being streams rather than file paths.
 
     if (urls.empty()) {
-        std::unique_ptr<std::ifstream> is(new std::ifstream(m_localAudioFilePath, std::ios::binary));
-        if (is->fail()) {
+        ACSDK_DEBUG9(LX("executeStart").d("setSource", m_localAudioFilePath));
+        if (MediaPlayerStatus::FAILURE == m_mediaPlayer->setFileSource(m_localAudioFilePath, true)) {
             ACSDK_ERROR(LX("executeStartFailed").d("fileName", m_localAudioFilePath).m("could not open file."));
             return;
         }
-        ACSDK_DEBUG9(LX("executeStart").d("setSource", m_localAudioFilePath));
-        m_mediaPlayer->setSource(std::move(is), true);
     } else {
         m_nextUrlIndexToRender = 0;
         ACSDK_DEBUG9(LX("executeStart").d("setSource", m_nextUrlIndexToRender));
-        m_mediaPlayer->setSource(m_urls[m_nextUrlIndexToRender++]);
+        executeSetUrlSource(m_urls[m_nextUrlIndexToRender++]);
     }
 
-    m_mediaPlayer->play();
+    // The outcome is reported to this as an observer of the media player, so the executor does not wait for it.
+    m_mediaPlayer->playAsync();
 }
 
 void Renderer::executeStop() {
     ACSDK_DEBUG1(LX("executeStop"));
     m_isStopping = true;
     if (m_isRendering) {
-        m_mediaPlayer->stop();
+        m_mediaPlayer->stopAsync();
     } else if (m_observer) {
         m_observer->onRendererStateChange(RendererObserverInterface::State::STOPPED);
     }
@@ -186,8 +207,8 @@ void Renderer::executeOnPlaybackFinished() {
         // play the next url in the list
         if (m_nextUrlIndexToRender < static_cast<int>(m_urls.size())) {
             ACSDK_DEBUG9(LX("executeonPlaybackFinished").d("setSource", m_nextUrlIndexToRender));
-            m_mediaPlayer->setSource(m_urls[m_nextUrlIndexToRender++]);
-            m_mediaPlayer->play();
+            executeSetUrlSource(m_urls[m_nextUrlIndexToRender++]);
+            m_mediaPlayer->playAsync();
 
             return;
         }
@@ -209,6 +230,17 @@ void Renderer::executeOnPlaybackError(const avsCommon::utils::mediaPlayer::Error
     }
 }
 
+void Renderer::executeSetUrlSource(const std::string& url) {
+    if (m_assetPrefetcher) {
+        auto is = m_assetPrefetcher->open(url);
+        if (is) {
+            m_mediaPlayer->setSource(std::move(is), false);
+            return;
+        }
+    }
+    m_mediaPlayer->setSource(url);
+}
+
 }  // namespace renderer
 }  // namespace alerts
 }  // namespace capabilityAgents
@@ -29,6 +29,7 @@
 #include <AVSCommon/Utils/String/StringUtils.h>
 
 #include <fstream>
+#include <limits>
 #include <set>
 
 namespace alexaClientSDK {
@@ -94,6 +95,14 @@ static const int ALERTS_DATABASE_VERSION_ONE = 1;
 /// A symbolic name for version two of our database.
 static const int ALERTS_DATABASE_VERSION_TWO = 2;
 
+/// The name under which the schema version of the alerts tables is recorded in the database.
+static const std::string ALERTS_SCHEMA_COMPONENT_NAME = "alerts";
+/**
+ * The schema version of the alerts tables: version two of the alerts table, the asset tables, and their indexes.
+ * Databases which have not recorded a version are brought up to date on open, and then record it.
+ */
+static const int ALERTS_SCHEMA_VERSION = 3;
+
 /// The name of the alerts table.
 static const std::string ALERTS_TABLE_NAME = "alerts";
 
@@ -133,6 +142,106 @@ static const std::string CREATE_ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_SQL_STRING =
         "asset_play_order_position INT NOT NULL," +
         "asset_play_order_token TEXT NOT NULL);";
 
+/// The SQL strings to create the indexes of the tables, which the lookups by token and by alert id rely on.
+static const std::vector<std::string> CREATE_INDEXES_SQL_STRINGS = {
+        "CREATE INDEX IF NOT EXISTS alerts_v2_token_index ON " + ALERTS_V2_TABLE_NAME + " (token);",
+        "CREATE INDEX IF NOT EXISTS alerts_v2_scheduled_time_index ON " + ALERTS_V2_TABLE_NAME +
+                " (scheduled_time_unix);",
+        "CREATE INDEX IF NOT EXISTS alertAssets_alert_id_index ON " + ALERT_ASSETS_TABLE_NAME + " (alert_id);",
+        "CREATE INDEX IF NOT EXISTS alertAssetPlayOrderItems_alert_id_index ON " +
+                ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " (alert_id);"};
+
+/// The SQL string to count the alerts with a database id.
+static const std::string ALERT_EXISTS_BY_ID_SQL_STRING =
+        "SELECT COUNT(*) FROM " + ALERTS_V2_TABLE_NAME + " WHERE id=?;";
+/// The SQL string to count the alerts with a token.
+static const std::string ALERT_EXISTS_SQL_STRING =
+        "SELECT COUNT(*) FROM " + ALERTS_V2_TABLE_NAME + " WHERE token=?;";
+/// The SQL string to store an alert.
+static const std::string STORE_ALERT_SQL_STRING = "INSERT INTO " + ALERTS_V2_TABLE_NAME + " (" +
+        "id, token, type, state, " +
+        "scheduled_time_unix, scheduled_time_iso_8601, asset_loop_count, " +
+        "asset_loop_pause_milliseconds, background_asset" +
+        ") VALUES (" +
+        "?, ?, ?, ?, " +
+        "?, ?, ?," +
+        "?, ?" +
+        ");";
+/// The SQL string to store an asset of an alert.
+static const std::string STORE_ALERT_ASSET_SQL_STRING = "INSERT INTO " + ALERT_ASSETS_TABLE_NAME + " (" +
+        "id, alert_id, avs_id, url" +
+        ") VALUES (" +
+        "?, ?, ?, ?" +
+        ");";
+/// The SQL string to store an asset play order item of an alert.
+static const std::string STORE_ALERT_ASSET_PLAY_ORDER_ITEM_SQL_STRING =
+        "INSERT INTO " + ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " (" +
+        "id, alert_id, asset_play_order_position, asset_play_order_token" +
+        ") VALUES (" +
+        "?, ?, ?, ?" +
+        ");";
+/// The SQL string to modify an alert.
+static const std::string MODIFY_ALERT_SQL_STRING = "UPDATE " + ALERTS_V2_TABLE_NAME + " SET " +
+        "state=?, scheduled_time_unix=?, scheduled_time_iso_8601=? " +
+        "WHERE id=?;";
+/// The SQL string to erase an alert.
+static const std::string ERASE_ALERT_SQL_STRING = "DELETE FROM " + ALERTS_V2_TABLE_NAME + " WHERE id=?;";
+/// The SQL string to erase the assets of an alert.
+static const std::string ERASE_ALERT_ASSETS_SQL_STRING =
+        "DELETE FROM " + ALERT_ASSETS_TABLE_NAME + " WHERE alert_id=?;";
+/// The SQL string to erase the asset play order items of an alert.
+static const std::string ERASE_ALERT_ASSET_PLAY_ORDER_ITEMS_SQL_STRING =
+        "DELETE FROM " + ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " WHERE alert_id=?;";
+
+/**
+ * The SQL string to load the alerts scheduled within a range of times, along with their assets and asset play order
+ * items, in one query.  Each alert yields a row per asset and per play order item, or a single row with a kind of
+ * zero if it has neither.  The rows of an alert are adjacent, and ordered by kind, then by position.
+ */
+static const std::string LOAD_ALERTS_SQL_STRING = std::string("SELECT ") +
+        "a.id, a.token, a.type, a.state, a.scheduled_time_unix, a.scheduled_time_iso_8601, a.asset_loop_count, " +
+        "a.asset_loop_pause_milliseconds, a.background_asset, " +
+        "COALESCE(c.kind, 0), COALESCE(c.position, 0), COALESCE(c.name, ''), COALESCE(c.url, '') " +
+        "FROM " + ALERTS_V2_TABLE_NAME + " a LEFT JOIN (" +
+        "SELECT alert_id, 1 AS kind, id AS position, avs_id AS name, url FROM " + ALERT_ASSETS_TABLE_NAME +
+        " UNION ALL " +
+        "SELECT alert_id, 2 AS kind, asset_play_order_position AS position, asset_play_order_token AS name, " +
+        "'' AS url FROM " + ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME +
+        ") c ON c.alert_id = a.id " +
+        "WHERE a.scheduled_time_unix > ? AND a.scheduled_time_unix <= ? " +
+        "ORDER BY a.scheduled_time_unix, a.id, c.kind, c.position;";
+
+/// The kind of the rows of @c LOAD_ALERTS_SQL_STRING for an alert without assets or asset play order items.
+static const int LOAD_ALERTS_ROW_KIND_NONE = 0;
+/// The kind of the rows of @c LOAD_ALERTS_SQL_STRING which carry an asset.
+static const int LOAD_ALERTS_ROW_KIND_ASSET = 1;
+/// The kind of the rows of @c LOAD_ALERTS_SQL_STRING which carry an asset play order item.
+static const int LOAD_ALERTS_ROW_KIND_PLAY_ORDER_ITEM = 2;
+
+/// The ids of the statements kept in the statement cache.
+enum StatementId {
+    /// The statement running @c ALERT_EXISTS_BY_ID_SQL_STRING.
+    ALERT_EXISTS_BY_ID_STATEMENT_ID,
+    /// The statement running @c ALERT_EXISTS_SQL_STRING.
+    ALERT_EXISTS_STATEMENT_ID,
+    /// The statement running @c STORE_ALERT_SQL_STRING.
+    STORE_ALERT_STATEMENT_ID,
+    /// The statement running @c STORE_ALERT_ASSET_SQL_STRING.
+    STORE_ALERT_ASSET_STATEMENT_ID,
+    /// The statement running @c STORE_ALERT_ASSET_PLAY_ORDER_ITEM_SQL_STRING.
+    STORE_ALERT_ASSET_PLAY_ORDER_ITEM_STATEMENT_ID,
+    /// The statement running @c MODIFY_ALERT_SQL_STRING.
+    MODIFY_ALERT_STATEMENT_ID,
+    /// The statement running @c ERASE_ALERT_SQL_STRING.
+    ERASE_ALERT_STATEMENT_ID,
+    /// The statement running @c ERASE_ALERT_ASSETS_SQL_STRING.
+    ERASE_ALERT_ASSETS_STATEMENT_ID,
+    /// The statement running @c ERASE_ALERT_ASSET_PLAY_ORDER_ITEMS_SQL_STRING.
+    ERASE_ALERT_ASSET_PLAY_ORDER_ITEMS_STATEMENT_ID,
+    /// The statement running @c LOAD_ALERTS_SQL_STRING.
+    LOAD_ALERTS_STATEMENT_ID
+};
+
 struct AssetOrderItem {
     int index;
     std::string name;
@@ -263,32 +372,31 @@ static bool dbFieldToAlertState(int dbState, Alert::State* state) {
  * A utility function to query if an alert exists in the database, given its database id.
  *
  * @param dbHandle The database handle.
+ * @param statementCache The cache of the statements run on @c dbHandle.
  * @param alertId The database id of the alert.
  * @return Whether the alert was successfully found in the database.
  */
-static bool alertExistsByAlertId(sqlite3* dbHandle, int alertId) {
-    const std::string sqlString = "SELECT COUNT(*) FROM " + ALERTS_V2_TABLE_NAME + " WHERE id=?;";
-
-    SQLiteStatement statement(dbHandle, sqlString);
+static bool alertExistsByAlertId(sqlite3* dbHandle, SQLiteStatementCache* statementCache, int alertId) {
+    auto statement = statementCache->get(dbHandle, ALERT_EXISTS_BY_ID_STATEMENT_ID, ALERT_EXISTS_BY_ID_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("alertExistsByAlertIdFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("alertExistsByAlertIdFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam, alertId)) {
+    if (!statement->bindIntParameter(boundParam, alertId)) {
         ACSDK_ERROR(LX("alertExistsByAlertIdFailed").m("Could not bind a parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("alertExistsByAlertIdFailed").m("Could not step to next row."));
         return false;
     }
 
     const int RESULT_COLUMN_POSITION = 0;
-    std::string rowValue = statement.getColumnText(RESULT_COLUMN_POSITION);
+    std::string rowValue = statement->getColumnText(RESULT_COLUMN_POSITION);
 
     int countValue = 0;
     if (!stringToInt(rowValue.c_str(), &countValue)) {
@@ -302,6 +410,11 @@ static bool alertExistsByAlertId(sqlite3* dbHandle, int alertId) {
 SQLiteAlertStorage::SQLiteAlertStorage() : m_dbHandle{nullptr} {
 }
 
+SQLiteAlertStorage::SQLiteAlertStorage(std::shared_ptr<SQLiteDatabaseService> database) :
+        m_database{database},
+        m_dbHandle{nullptr} {
+}
+
 /**
  * Utility function to create the Alerts table within the database.
  *
@@ -347,12 +460,33 @@ static bool createAlertAssetPlayOrderItemsTable(sqlite3* dbHandle) {
     return true;
 }
 
+/**
+ * Utility function to create the indexes of the tables within the database, if they do not exist yet.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @return Whether the indexes were successfully created.
+ */
+static bool createIndexes(sqlite3* dbHandle) {
+    for (auto& sqlString : CREATE_INDEXES_SQL_STRINGS) {
+        if (!performQuery(dbHandle, sqlString)) {
+            ACSDK_ERROR(LX("createIndexesFailed").m("Index could not be created.").d("sql", sqlString));
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool SQLiteAlertStorage::createDatabase(const std::string & filePath) {
     if (m_dbHandle) {
         ACSDK_ERROR(LX("createDatabaseFailed").m("Database handle is already open."));
         return false;
     }
 
+    if (m_database) {
+        return m_database->run([this](sqlite3* dbHandle) { return useSharedDatabase(dbHandle, true); });
+    }
+
     if (fileExists(filePath)) {
         ACSDK_ERROR(LX("createDatabaseFailed").m("File specified already exists.").d("file path", filePath));
         return false;
@@ -382,6 +516,53 @@ bool SQLiteAlertStorage::createDatabase(const std::string & filePath) {
         return false;
     }
 
+    if (!createIndexes(m_dbHandle)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Indexes could not be created."));
+        close();
+        return false;
+    }
+
+    if (!setSchemaVersion(m_dbHandle, ALERTS_SCHEMA_COMPONENT_NAME, ALERTS_SCHEMA_VERSION)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Schema version could not be recorded."));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAlertStorage::upgradeSchema() {
+    int version = 0;
+    if (!getSchemaVersion(m_dbHandle, ALERTS_SCHEMA_COMPONENT_NAME, &version)) {
+        ACSDK_ERROR(LX("upgradeSchemaFailed").m("Schema version could not be read."));
+        return false;
+    }
+
+    // The good case - the tables are already up to date, which costs a single lookup.
+    if (ALERTS_SCHEMA_VERSION == version) {
+        return true;
+    }
+    if (version > ALERTS_SCHEMA_VERSION) {
+        ACSDK_WARN(LX("upgradeSchema").m("Tables are newer than this code.").d("version", version));
+        return true;
+    }
+
+    ACSDK_INFO(LX("upgradeSchema").d("from", version).d("to", ALERTS_SCHEMA_VERSION));
+    // The whole upgrade is one transaction, so that it is written to the disk once and is retried if interrupted.
+    if (!beginTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("upgradeSchemaFailed").m("Transaction could not be started."));
+        return false;
+    }
+    if (!migrateAlertsDbFromV1ToV2() || !createIndexes(m_dbHandle) ||
+        !setSchemaVersion(m_dbHandle, ALERTS_SCHEMA_COMPONENT_NAME, ALERTS_SCHEMA_VERSION)) {
+        ACSDK_ERROR(LX("upgradeSchemaFailed").d("from", version));
+        rollbackTransaction(m_dbHandle);
+        return false;
+    }
+    if (!commitTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("upgradeSchemaFailed").m("Transaction could not be committed."));
+        return false;
+    }
     return true;
 }
 
@@ -421,8 +602,28 @@ bool SQLiteAlertStorage::migrateAlertsDbFromV1ToV2() {
             return false;
         }
 
-        for (auto &alert : alertContainer) {
-            if (!store(alert)) {
+        // V1 alerts have no assets, and the V2 table is new, so each alert is a single insert keeping its id.
+        auto statement = m_statementCache.get(m_dbHandle, STORE_ALERT_STATEMENT_ID, STORE_ALERT_SQL_STRING);
+        if (!statement.isValid()) {
+            ACSDK_ERROR(LX("migrateAlertsDbFromV1ToV2Failed").m("Could not create statement."));
+            return false;
+        }
+        for (auto& alert : alertContainer) {
+            int alertType = ALERT_EVENT_TYPE_ALARM;
+            int alertState = ALERT_STATE_SET;
+            int boundParam = 1;
+            if (!alertTypeToDbField(alert->getTypeName(), &alertType) ||
+                !alertStateToDbField(alert->m_state, &alertState) ||
+                !statement->bindIntParameter(boundParam++, alert->m_dbId) ||
+                !statement->bindStringParameter(boundParam++, alert->m_token) ||
+                !statement->bindIntParameter(boundParam++, alertType) ||
+                !statement->bindIntParameter(boundParam++, alertState) ||
+                !statement->bindInt64Parameter(boundParam++, alert->getScheduledTime_Unix()) ||
+                !statement->bindStringParameter(boundParam++, alert->getScheduledTime_ISO_8601()) ||
+                !statement->bindIntParameter(boundParam++, alert->getLoopCount()) ||
+                !statement->bindIntParameter(boundParam++, alert->getLoopPause().count()) ||
+                !statement->bindStringParameter(boundParam, alert->getBackgroundAssetId()) || !statement->step() ||
+                !statement->reset()) {
                 ACSDK_ERROR(LX("migrateAlertsDbFromV1ToV2Failed").m("Could not migrate alert to V2 database."));
                 alert->printDiagnostic();
                 return false;
@@ -444,6 +645,10 @@ bool SQLiteAlertStorage::open(const std::string & filePath) {
         return false;
     }
 
+    if (m_database) {
+        return m_database->run([this](sqlite3* dbHandle) { return useSharedDatabase(dbHandle, false); });
+    }
+
     if (!fileExists(filePath)) {
         ACSDK_ERROR(LX("openFailed").m("File specified does not exist.").d("file path", filePath));
         return false;
@@ -455,8 +660,8 @@ bool SQLiteAlertStorage::open(const std::string & filePath) {
         return false;
     }
 
-    if (!migrateAlertsDbFromV1ToV2()) {
-        ACSDK_ERROR(LX("openFailed").m("Could not migrate database file from V1 to V2."));
+    if (!upgradeSchema()) {
+        ACSDK_ERROR(LX("openFailed").m("Could not bring the database file up to date."));
         close();
         return false;
     }
@@ -469,35 +674,71 @@ bool SQLiteAlertStorage::isOpen() {
 }
 
 void SQLiteAlertStorage::close() {
+    if (m_database && !m_database->isStorageThread()) {
+        m_database->run([this](sqlite3*) {
+            close();
+            return true;
+        });
+        return;
+    }
     if (m_dbHandle) {
-        closeSQLiteDatabase(m_dbHandle);
+        m_statementCache.clear();
+        // The connection to a shared database is kept open for the other storages using it.
+        if (!m_database) {
+            closeSQLiteDatabase(m_dbHandle);
+        }
         m_dbHandle = nullptr;
     }
 }
 
-bool SQLiteAlertStorage::alertExists(const std::string & token) {
-    const std::string sqlString = "SELECT COUNT(*) FROM " + ALERTS_V2_TABLE_NAME + " WHERE token=?;";
+bool SQLiteAlertStorage::useSharedDatabase(sqlite3* dbHandle, bool createTables) {
+    if (!tableExists(dbHandle, ALERTS_V2_TABLE_NAME) && !tableExists(dbHandle, ALERTS_TABLE_NAME)) {
+        if (!createTables) {
+            ACSDK_ERROR(LX("openFailed").m("Alerts table does not exist in the shared database."));
+            return false;
+        }
+        if (!createAlertsTable(dbHandle) || !createAlertAssetsTable(dbHandle) ||
+            !createAlertAssetPlayOrderItemsTable(dbHandle)) {
+            ACSDK_ERROR(LX("createDatabaseFailed").m("Tables could not be created."));
+            return false;
+        }
+    }
 
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    m_dbHandle = dbHandle;
+    if (!upgradeSchema()) {
+        ACSDK_ERROR(LX("openFailed").m("Could not bring the alerts tables of the shared database up to date."));
+        m_statementCache.clear();
+        m_dbHandle = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAlertStorage::alertExists(const std::string & token) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return alertExists(token); });
+    }
+    auto statement = m_statementCache.get(m_dbHandle, ALERT_EXISTS_STATEMENT_ID, ALERT_EXISTS_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("alertExistsFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("alertExistsFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindStringParameter(boundParam, token)) {
+    if (!statement->bindStringParameter(boundParam, token)) {
         ACSDK_ERROR(LX("alertExistsFailed").m("Could not bind a parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("alertExistsFailed").m("Could not step to next row."));
         return false;
     }
 
     const int RESULT_COLUMN_POSITION = 0;
-    std::string rowValue = statement.getColumnText(RESULT_COLUMN_POSITION);
+    std::string rowValue = statement->getColumnText(RESULT_COLUMN_POSITION);
 
     int countValue = 0;
     if (!stringToInt(rowValue.c_str(), &countValue)) {
@@ -508,17 +749,15 @@ bool SQLiteAlertStorage::alertExists(const std::string & token) {
     return countValue > 0;
 }
 
-static bool storeAlertAssets(sqlite3* dbHandle, int alertId, const Alert::AssetConfiguration & assetConfiguration) {
+static bool storeAlertAssets(
+        sqlite3* dbHandle,
+        SQLiteStatementCache* statementCache,
+        int alertId,
+        const Alert::AssetConfiguration & assetConfiguration) {
     if(assetConfiguration.assets.empty()) {
         return true;
     }
 
-    const std::string sqlString = "INSERT INTO " + ALERT_ASSETS_TABLE_NAME + " (" +
-                            "id, alert_id, avs_id, url" +
-                            ") VALUES (" +
-                            "?, ?, ?, ?" +
-                            ");";
-
     int id = 0;
     if (!getTableMaxIntValue(dbHandle, ALERT_ASSETS_TABLE_NAME, DATABASE_COLUMN_ID_NAME, &id)) {
         ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Cannot generate asset id."));
@@ -526,10 +765,10 @@ static bool storeAlertAssets(sqlite3* dbHandle, int alertId, const Alert::AssetC
     }
     id++;
 
-    SQLiteStatement statement(dbHandle, sqlString);
+    auto statement = statementCache->get(dbHandle, STORE_ALERT_ASSET_STATEMENT_ID, STORE_ALERT_ASSET_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Could not create statement->"));
         return false;
     }
 
@@ -538,21 +777,21 @@ static bool storeAlertAssets(sqlite3* dbHandle, int alertId, const Alert::AssetC
         auto & asset = assetIter.second;
 
         int boundParam = 1;
-        if (!statement.bindIntParameter(boundParam++, id) ||
-            !statement.bindIntParameter(boundParam++, alertId) ||
-            !statement.bindStringParameter(boundParam++, asset.id) ||
-            !statement.bindStringParameter(boundParam, asset.url)) {
+        if (!statement->bindIntParameter(boundParam++, id) ||
+            !statement->bindIntParameter(boundParam++, alertId) ||
+            !statement->bindStringParameter(boundParam++, asset.id) ||
+            !statement->bindStringParameter(boundParam, asset.url)) {
             ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Could not bind a parameter."));
             return false;
         }
 
-        if (!statement.step()) {
+        if (!statement->step()) {
             ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Could not step to next row."));
             return false;
         }
 
-        if (!statement.reset()) {
-            ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Could not reset the statement."));
+        if (!statement->reset()) {
+            ACSDK_ERROR(LX("storeAlertAssetsFailed").m("Could not reset the statement->"));
             return false;
         }
 
@@ -563,17 +802,14 @@ static bool storeAlertAssets(sqlite3* dbHandle, int alertId, const Alert::AssetC
 }
 
 static bool storeAlertAssetPlayOrderItems(
-        sqlite3* dbHandle, int alertId, const Alert::AssetConfiguration & assetConfiguration) {
+        sqlite3* dbHandle,
+        SQLiteStatementCache* statementCache,
+        int alertId,
+        const Alert::AssetConfiguration & assetConfiguration) {
     if (assetConfiguration.assetPlayOrderItems.empty()) {
         return true;
     }
 
-    const std::string sqlString = "INSERT INTO " + ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " (" +
-                            "id, alert_id, asset_play_order_position, asset_play_order_token" +
-                            ") VALUES (" +
-                            "?, ?, ?, ?" +
-                            ");";
-
     int id = 0;
     if (!getTableMaxIntValue(dbHandle, ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME, DATABASE_COLUMN_ID_NAME, &id)) {
         ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Cannot generate asset id."));
@@ -581,10 +817,11 @@ static bool storeAlertAssetPlayOrderItems(
     }
     id++;
 
-    SQLiteStatement statement(dbHandle, sqlString);
+    auto statement = statementCache->get(
+            dbHandle, STORE_ALERT_ASSET_PLAY_ORDER_ITEM_STATEMENT_ID, STORE_ALERT_ASSET_PLAY_ORDER_ITEM_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Could not create statement->"));
         return false;
     }
 
@@ -593,21 +830,21 @@ static bool storeAlertAssetPlayOrderItems(
     for (auto & assetId : assetConfiguration.assetPlayOrderItems) {
 
         int boundParam = 1;
-        if (!statement.bindIntParameter(boundParam++, id) ||
-            !statement.bindIntParameter(boundParam++, alertId) ||
-            !statement.bindIntParameter(boundParam++, itemIndex) ||
-            !statement.bindStringParameter(boundParam, assetId)) {
+        if (!statement->bindIntParameter(boundParam++, id) ||
+            !statement->bindIntParameter(boundParam++, alertId) ||
+            !statement->bindIntParameter(boundParam++, itemIndex) ||
+            !statement->bindStringParameter(boundParam, assetId)) {
             ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Could not bind a parameter."));
             return false;
         }
 
-        if (!statement.step()) {
+        if (!statement->step()) {
             ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Could not step to next row."));
             return false;
         }
 
-        if (!statement.reset()) {
-            ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Could not reset the statement."));
+        if (!statement->reset()) {
+            ACSDK_ERROR(LX("storeAlertAssetPlayOrderItemsFailed").m("Could not reset the statement->"));
             return false;
         }
 
@@ -619,6 +856,9 @@ static bool storeAlertAssetPlayOrderItems(
 }
 
 bool SQLiteAlertStorage::store(std::shared_ptr<Alert> alert) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return store(alert); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("storeFailed").m("Database handle is not open."));
         return false;
@@ -634,16 +874,6 @@ bool SQLiteAlertStorage::store(std::shared_ptr<Alert> alert) {
         return false;
     }
 
-    const std::string sqlString = "INSERT INTO " + ALERTS_V2_TABLE_NAME + " (" +
-                            "id, token, type, state, " +
-                            "scheduled_time_unix, scheduled_time_iso_8601, asset_loop_count, " +
-                            "asset_loop_pause_milliseconds, background_asset"
-                            ") VALUES (" +
-                            "?, ?, ?, ?, " +
-                            "?, ?, ?," +
-                            "?, ?" +
-                            ");";
-
     int id = 0;
     if (!getTableMaxIntValue(m_dbHandle, ALERTS_V2_TABLE_NAME, DATABASE_COLUMN_ID_NAME, &id)) {
         ACSDK_ERROR(LX("storeFailed").m("Cannot generate alert id."));
@@ -663,28 +893,28 @@ bool SQLiteAlertStorage::store(std::shared_ptr<Alert> alert) {
         return false;
     }
 
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    auto statement = m_statementCache.get(m_dbHandle, STORE_ALERT_STATEMENT_ID, STORE_ALERT_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("storeFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("storeFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam++, id) ||
-        !statement.bindStringParameter(boundParam++, alert->m_token) ||
-        !statement.bindIntParameter(boundParam++, alertType) ||
-        !statement.bindIntParameter(boundParam++, alertState) ||
-        !statement.bindInt64Parameter(boundParam++, alert->getScheduledTime_Unix()) ||
-        !statement.bindStringParameter(boundParam++, alert->getScheduledTime_ISO_8601()) ||
-        !statement.bindIntParameter(boundParam++, alert->getLoopCount()) ||
-        !statement.bindIntParameter(boundParam++, alert->getLoopPause().count()) ||
-        !statement.bindStringParameter(boundParam, alert->getBackgroundAssetId())) {
+    if (!statement->bindIntParameter(boundParam++, id) ||
+        !statement->bindStringParameter(boundParam++, alert->m_token) ||
+        !statement->bindIntParameter(boundParam++, alertType) ||
+        !statement->bindIntParameter(boundParam++, alertState) ||
+        !statement->bindInt64Parameter(boundParam++, alert->getScheduledTime_Unix()) ||
+        !statement->bindStringParameter(boundParam++, alert->getScheduledTime_ISO_8601()) ||
+        !statement->bindIntParameter(boundParam++, alert->getLoopCount()) ||
+        !statement->bindIntParameter(boundParam++, alert->getLoopPause().count()) ||
+        !statement->bindStringParameter(boundParam, alert->getBackgroundAssetId())) {
         ACSDK_ERROR(LX("storeFailed").m("Could not bind parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("storeFailed").m("Could not perform step."));
         return false;
     }
@@ -692,14 +922,13 @@ bool SQLiteAlertStorage::store(std::shared_ptr<Alert> alert) {
     // capture the generated database id in the alert object.
     alert->m_dbId = id;
 
-    statement.finalize();
 
-    if (!storeAlertAssets(m_dbHandle, id, alert->m_assetConfiguration)) {
+    if (!storeAlertAssets(m_dbHandle, &m_statementCache, id, alert->m_assetConfiguration)) {
         ACSDK_ERROR(LX("storeFailed").m("Could not store alertAssets."));
         return false;
     }
 
-    if (!storeAlertAssetPlayOrderItems(m_dbHandle, id, alert->m_assetConfiguration)) {
+    if (!storeAlertAssetPlayOrderItems(m_dbHandle, &m_statementCache, id, alert->m_assetConfiguration)) {
         ACSDK_ERROR(LX("storeFailed").m("Could not store alertAssetPlayOrderItems."));
         return false;
     }
@@ -717,35 +946,21 @@ static bool loadAlertAssets(sqlite3* dbHandle, std::map<int, std::vector<Alert::
         return false;
     }
 
-    int alertId = 0;
-    std::string avsId;
-    std::string url;
-
-    if (!statement.step()) {
-        ACSDK_ERROR(LX("loadAlertAssetsFailed").m("Could not perform step."));
+    int alertIdColumn = statement.getColumnIndex("alert_id");
+    int avsIdColumn = statement.getColumnIndex("avs_id");
+    int urlColumn = statement.getColumnIndex("url");
+    if (alertIdColumn < 0 || avsIdColumn < 0 || urlColumn < 0) {
+        ACSDK_ERROR(LX("loadAlertAssetsFailed").m("Could not find columns."));
         return false;
     }
 
-    while (SQLITE_ROW == statement.getStepResult()) {
-
-        int numberColumns = statement.getColumnCount();
-
-        for (int i = 0; i < numberColumns; i++) {
-
-            std::string columnName = statement.getColumnName(i);
-
-            if ("alert_id" == columnName) {
-                alertId = statement.getColumnInt(i);
-            } else if ("avs_id" == columnName) {
-                avsId = statement.getColumnText(i);
-            } else if ("url" == columnName) {
-                url = statement.getColumnText(i);
-            }
-        }
-
-        (*alertAssetsMap)[alertId].push_back(Alert::Asset(avsId, url));
-
-        statement.step();
+    if (!statement.forEachRow([&](const SQLiteStatement& row) {
+            (*alertAssetsMap)[row.getColumnInt(alertIdColumn)].push_back(Alert::Asset(
+                row.getColumnTextView(avsIdColumn).toString(), row.getColumnTextView(urlColumn).toString()));
+            return true;
+        })) {
+        ACSDK_ERROR(LX("loadAlertAssetsFailed").m("Could not perform step."));
+        return false;
     }
 
     return true;
@@ -762,35 +977,21 @@ static bool loadAlertAssetPlayOrderItems(
         return false;
     }
 
-    int alertId = 0;
-    int playOrderPosition = 0;
-    std::string playOrderToken;
-
-    if (!statement.step()) {
-        ACSDK_ERROR(LX("loadAlertAssetPlayOrderItemsFailed").m("Could not perform step."));
+    int alertIdColumn = statement.getColumnIndex("alert_id");
+    int positionColumn = statement.getColumnIndex("asset_play_order_position");
+    int tokenColumn = statement.getColumnIndex("asset_play_order_token");
+    if (alertIdColumn < 0 || positionColumn < 0 || tokenColumn < 0) {
+        ACSDK_ERROR(LX("loadAlertAssetPlayOrderItemsFailed").m("Could not find columns."));
         return false;
     }
 
-    while (SQLITE_ROW == statement.getStepResult()) {
-
-        int numberColumns = statement.getColumnCount();
-
-        for (int i = 0; i < numberColumns; i++) {
-
-            std::string columnName = statement.getColumnName(i);
-
-            if ("alert_id" == columnName) {
-                alertId = statement.getColumnInt(i);
-            } else if ("asset_play_order_position" == columnName) {
-                playOrderPosition = statement.getColumnInt(i);
-            } else if ("asset_play_order_token" == columnName) {
-                playOrderToken = statement.getColumnText(i);
-            }
-        }
-
-        (*alertAssetOrderItemsMap)[alertId].insert(AssetOrderItem{playOrderPosition, playOrderToken});
-
-        statement.step();
+    if (!statement.forEachRow([&](const SQLiteStatement& row) {
+            (*alertAssetOrderItemsMap)[row.getColumnInt(alertIdColumn)].insert(
+                AssetOrderItem{row.getColumnInt(positionColumn), row.getColumnTextView(tokenColumn).toString()});
+            return true;
+        })) {
+        ACSDK_ERROR(LX("loadAlertAssetPlayOrderItemsFailed").m("Could not perform step."));
+        return false;
     }
 
     return true;
@@ -826,50 +1027,24 @@ bool SQLiteAlertStorage::loadHelper(int dbVersion, std::vector<std::shared_ptr<A
         return false;
     }
 
-    // local values which we will use to capture what we read from the database.
-    int id = 0;
-    std::string token;
-    int type = 0;
-    int state = 0;
-    int64_t scheduledTime_Unix = 0;
-    std::string scheduledTime_ISO_8601;
-    int loopCount = 0;
-    int loopPauseInMilliseconds = 0;
-    std::string backgroundAssetId;
-
-    if (!statement.step()) {
-        ACSDK_ERROR(LX("loadHelperFailed").m("Could not perform step."));
+    // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.  The version one
+    // table has no asset columns, whose indexes are then -1.
+    int idColumn = statement.getColumnIndex("id");
+    int tokenColumn = statement.getColumnIndex("token");
+    int typeColumn = statement.getColumnIndex("type");
+    int stateColumn = statement.getColumnIndex("state");
+    int scheduledTimeISO8601Column = statement.getColumnIndex("scheduled_time_iso_8601");
+    int loopCountColumn = statement.getColumnIndex("asset_loop_count");
+    int loopPauseColumn = statement.getColumnIndex("asset_loop_pause_milliseconds");
+    int backgroundAssetColumn = statement.getColumnIndex("background_asset");
+    if (idColumn < 0 || tokenColumn < 0 || typeColumn < 0 || stateColumn < 0 || scheduledTimeISO8601Column < 0) {
+        ACSDK_ERROR(LX("loadHelperFailed").m("Could not find columns."));
         return false;
     }
 
-    while (SQLITE_ROW == statement.getStepResult()) {
-        int numberColumns = statement.getColumnCount();
-
-        // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.
-        for (int i = 0; i < numberColumns; i++) {
-            std::string columnName = statement.getColumnName(i);
-
-            if ("id" == columnName) {
-                id = statement.getColumnInt(i);
-            } else if ("token" == columnName) {
-                token = statement.getColumnText(i);
-            } else if ("type" == columnName) {
-                type = statement.getColumnInt(i);
-            } else if ("state" == columnName) {
-                state = statement.getColumnInt(i);
-            } else if ("scheduled_time_unix" == columnName) {
-                scheduledTime_Unix = statement.getColumnInt64(i);
-            } else if ("scheduled_time_iso_8601" == columnName) {
-                scheduledTime_ISO_8601 = statement.getColumnText(i);
-            } else if ("asset_loop_count" == columnName) {
-                loopCount = statement.getColumnInt(i);
-            } else if ("asset_loop_pause_milliseconds" == columnName) {
-                loopPauseInMilliseconds = statement.getColumnInt(i);
-            } else if ("background_asset" == columnName) {
-                backgroundAssetId = statement.getColumnText(i);
-            }
-        }
-
+    bool rowFailed = false;
+    bool visitedAllRows = statement.forEachRow([&](const SQLiteStatement& row) {
+        int type = row.getColumnInt(typeColumn);
         std::shared_ptr<Alert> alert;
         if (ALERT_EVENT_TYPE_ALARM == type) {
             alert = std::make_shared<Alarm>();
@@ -881,29 +1056,44 @@ bool SQLiteAlertStorage::loadHelper(int dbVersion, std::vector<std::shared_ptr<A
             ACSDK_ERROR(LX("loadHelperFailed")
                     .m("Could not instantiate an alert object.")
                     .d("type read from database", type));
+            rowFailed = true;
             return false;
         }
 
-        alert->m_dbId = id;
-        alert->m_token = token;
-        alert->setTime_ISO_8601(scheduledTime_ISO_8601);
-        alert->setLoopCount(loopCount);
-        alert->setLoopPause(std::chrono::milliseconds{loopPauseInMilliseconds});
-        alert->setBackgroundAssetId(backgroundAssetId);
+        alert->m_dbId = row.getColumnInt(idColumn);
+        alert->m_token = row.getColumnTextView(tokenColumn).toString();
+        alert->setTime_ISO_8601(row.getColumnTextView(scheduledTimeISO8601Column).toString());
+        if (loopCountColumn >= 0) {
+            alert->setLoopCount(row.getColumnInt(loopCountColumn));
+        }
+        if (loopPauseColumn >= 0) {
+            alert->setLoopPause(std::chrono::milliseconds{row.getColumnInt(loopPauseColumn)});
+        }
+        if (backgroundAssetColumn >= 0) {
+            alert->setBackgroundAssetId(row.getColumnTextView(backgroundAssetColumn).toString());
+        }
 
-        if (!dbFieldToAlertState(state, &(alert->m_state))) {
+        if (!dbFieldToAlertState(row.getColumnInt(stateColumn), &(alert->m_state))) {
             ACSDK_ERROR(LX("loadHelperFailed")
                     .m("Could not convert alert state."));
+            rowFailed = true;
             return false;
         }
 
         alertContainer->push_back(alert);
-
-        statement.step();
-    }
+        return true;
+    });
 
     statement.finalize();
 
+    if (rowFailed) {
+        return false;
+    }
+    if (!visitedAllRows) {
+        ACSDK_ERROR(LX("loadHelperFailed").m("Could not perform step."));
+        return false;
+    }
+
     std::map<int, std::vector<Alert::Asset>> alertAssetsMap;
     if (!loadAlertAssets(m_dbHandle, &alertAssetsMap)) {
         ACSDK_ERROR(LX("loadHelperFailed").m("Could not load alert assets."));
@@ -933,10 +1123,113 @@ bool SQLiteAlertStorage::loadHelper(int dbVersion, std::vector<std::shared_ptr<A
 }
 
 bool SQLiteAlertStorage::load(std::vector<std::shared_ptr<Alert>>* alertContainer) {
-    return loadHelper(ALERTS_DATABASE_VERSION_TWO, alertContainer);
+    return loadScheduledBetween(
+        std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), alertContainer);
+}
+
+bool SQLiteAlertStorage::loadScheduledBetween(
+    int64_t afterUnix,
+    int64_t untilUnix,
+    std::vector<std::shared_ptr<Alert>>* alertContainer) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return loadScheduledBetween(afterUnix, untilUnix, alertContainer); });
+    }
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("loadScheduledBetweenFailed").m("Database handle is not open."));
+        return false;
+    }
+
+    if (!alertContainer) {
+        ACSDK_ERROR(LX("loadScheduledBetweenFailed").m("Alert container parameter is nullptr."));
+        return false;
+    }
+
+    auto statement = m_statementCache.get(m_dbHandle, LOAD_ALERTS_STATEMENT_ID, LOAD_ALERTS_SQL_STRING);
+
+    if (!statement.isValid()) {
+        ACSDK_ERROR(LX("loadScheduledBetweenFailed").m("Could not create statement."));
+        return false;
+    }
+
+    int boundParam = 1;
+    if (!statement->bindInt64Parameter(boundParam++, afterUnix) ||
+        !statement->bindInt64Parameter(boundParam, untilUnix)) {
+        ACSDK_ERROR(LX("loadScheduledBetweenFailed").m("Could not bind a parameter."));
+        return false;
+    }
+
+    if (!statement->step()) {
+        ACSDK_ERROR(LX("loadScheduledBetweenFailed").m("Could not perform step."));
+        return false;
+    }
+
+    // The columns are read by position, since the query names them.
+    enum Column {
+        ID, TOKEN, TYPE, STATE, SCHEDULED_TIME_UNIX, SCHEDULED_TIME_ISO_8601, LOOP_COUNT, LOOP_PAUSE_MILLISECONDS,
+        BACKGROUND_ASSET, KIND, POSITION, NAME, URL
+    };
+
+    std::shared_ptr<Alert> alert;
+    std::vector<std::shared_ptr<Alert>> alerts;
+
+    while (SQLITE_ROW == statement->getStepResult()) {
+        int id = statement->getColumnInt(ID);
+
+        // the first row of an alert
+        if (!alert || alert->m_dbId != id) {
+            int type = statement->getColumnInt(TYPE);
+            if (ALERT_EVENT_TYPE_ALARM == type) {
+                alert = std::make_shared<Alarm>();
+            } else if (ALERT_EVENT_TYPE_TIMER == type) {
+                alert = std::make_shared<Timer>();
+            } else if (ALERT_EVENT_TYPE_REMINDER == type) {
+                alert = std::make_shared<Reminder>();
+            } else {
+                ACSDK_ERROR(LX("loadScheduledBetweenFailed")
+                        .m("Could not instantiate an alert object.")
+                        .d("type read from database", type));
+                return false;
+            }
+
+            alert->m_dbId = id;
+            alert->m_token = statement->getColumnText(TOKEN);
+            alert->setTime_ISO_8601(statement->getColumnText(SCHEDULED_TIME_ISO_8601));
+            alert->setLoopCount(statement->getColumnInt(LOOP_COUNT));
+            alert->setLoopPause(std::chrono::milliseconds{statement->getColumnInt(LOOP_PAUSE_MILLISECONDS)});
+            alert->setBackgroundAssetId(statement->getColumnText(BACKGROUND_ASSET));
+
+            if (!dbFieldToAlertState(statement->getColumnInt(STATE), &(alert->m_state))) {
+                ACSDK_ERROR(LX("loadScheduledBetweenFailed").m("Could not convert alert state."));
+                return false;
+            }
+
+            alerts.push_back(alert);
+        }
+
+        int kind = statement->getColumnInt(KIND);
+        if (LOAD_ALERTS_ROW_KIND_ASSET == kind) {
+            Alert::Asset asset(statement->getColumnText(NAME), statement->getColumnText(URL));
+            alert->m_assetConfiguration.assets[asset.id] = asset;
+        } else if (LOAD_ALERTS_ROW_KIND_PLAY_ORDER_ITEM == kind) {
+            // the play order items arrive ordered by position
+            alert->m_assetConfiguration.assetPlayOrderItems.push_back(statement->getColumnText(NAME));
+        } else if (LOAD_ALERTS_ROW_KIND_NONE != kind) {
+            ACSDK_ERROR(LX("loadScheduledBetweenFailed").d("unexpected row kind", kind));
+            return false;
+        }
+
+        statement->step();
+    }
+
+    alertContainer->insert(alertContainer->end(), alerts.begin(), alerts.end());
+
+    return true;
 }
 
 bool SQLiteAlertStorage::modify(std::shared_ptr<Alert> alert) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return modify(alert); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("modifyFailed").m("Database handle is not open."));
         return false;
@@ -952,33 +1245,29 @@ bool SQLiteAlertStorage::modify(std::shared_ptr<Alert> alert) {
         return false;
     }
 
-    const std::string sqlString = "UPDATE " + ALERTS_V2_TABLE_NAME + " SET " +
-                            "state=?, scheduled_time_unix=?, scheduled_time_iso_8601=? " +
-                            "WHERE id=?;";
-
     int alertState = ALERT_STATE_SET;
     if (!alertStateToDbField(alert->m_state, &alertState)) {
         ACSDK_ERROR(LX("modifyFailed").m("Cannot convert state."));
         return false;
     }
 
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    auto statement = m_statementCache.get(m_dbHandle, MODIFY_ALERT_STATEMENT_ID, MODIFY_ALERT_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("modifyFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("modifyFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam++, alertState) ||
-        !statement.bindInt64Parameter(boundParam++, alert->getScheduledTime_Unix()) ||
-        !statement.bindStringParameter(boundParam++, alert->getScheduledTime_ISO_8601()) ||
-        !statement.bindIntParameter(boundParam++, alert->m_dbId)) {
+    if (!statement->bindIntParameter(boundParam++, alertState) ||
+        !statement->bindInt64Parameter(boundParam++, alert->getScheduledTime_Unix()) ||
+        !statement->bindStringParameter(boundParam++, alert->getScheduledTime_ISO_8601()) ||
+        !statement->bindIntParameter(boundParam++, alert->m_dbId)) {
         ACSDK_ERROR(LX("modifyFailed").m("Could not bind a parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("modifyFailed").m("Could not perform step."));
         return false;
     }
@@ -991,26 +1280,25 @@ bool SQLiteAlertStorage::modify(std::shared_ptr<Alert> alert) {
  * This function will clean up records in the alerts table.
  *
  * @param dbHandle The database handle.
+ * @param statementCache The cache of the statements run on @c dbHandle.
  * @param alertId The alert id of the alert to be deleted.
  * @return Whether the delete operation was successful.
  */
-static bool eraseAlert(sqlite3* dbHandle, int alertId) {
-    const std::string sqlString = "DELETE FROM " + ALERTS_V2_TABLE_NAME + " WHERE id=?;";
-
-    SQLiteStatement statement(dbHandle, sqlString);
+static bool eraseAlert(sqlite3* dbHandle, SQLiteStatementCache* statementCache, int alertId) {
+    auto statement = statementCache->get(dbHandle, ERASE_ALERT_STATEMENT_ID, ERASE_ALERT_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam, alertId)) {
+    if (!statement->bindIntParameter(boundParam, alertId)) {
         ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not bind a parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not perform step."));
         return false;
     }
@@ -1023,26 +1311,25 @@ static bool eraseAlert(sqlite3* dbHandle, int alertId) {
  * This function will clean up records in the alertAssets table.
  *
  * @param dbHandle The database handle.
+ * @param statementCache The cache of the statements run on @c dbHandle.
  * @param alertId The alert id of the alert to be deleted.
  * @return Whether the delete operation was successful.
  */
-static bool eraseAlertAssets(sqlite3* dbHandle, int alertId) {
-    const std::string sqlString = "DELETE FROM " + ALERT_ASSETS_TABLE_NAME + " WHERE alert_id=?;";
-
-    SQLiteStatement statement(dbHandle, sqlString);
+static bool eraseAlertAssets(sqlite3* dbHandle, SQLiteStatementCache* statementCache, int alertId) {
+    auto statement = statementCache->get(dbHandle, ERASE_ALERT_ASSETS_STATEMENT_ID, ERASE_ALERT_ASSETS_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("eraseAlertAssetsFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("eraseAlertAssetsFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam, alertId)) {
+    if (!statement->bindIntParameter(boundParam, alertId)) {
         ACSDK_ERROR(LX("eraseAlertAssetsFailed").m("Could not bind a parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("eraseAlertAssetsFailed").m("Could not perform step."));
         return false;
     }
@@ -1055,26 +1342,29 @@ static bool eraseAlertAssets(sqlite3* dbHandle, int alertId) {
  * This function will clean up records in the alertAssetPlayOrderItems table.
  *
  * @param dbHandle The database handle.
+ * @param statementCache The cache of the statements run on @c dbHandle.
  * @param alertId The alert id of the alert to be deleted.
  * @return Whether the delete operation was successful.
  */
-static bool eraseAlertAssetPlayOrderItems(sqlite3* dbHandle, int alertId) {
-    const std::string sqlString = "DELETE FROM " + ALERT_ASSET_PLAY_ORDER_ITEMS_TABLE_NAME + " WHERE alert_id=?;";
-
-    SQLiteStatement statement(dbHandle, sqlString);
+static bool eraseAlertAssetPlayOrderItems(
+        sqlite3* dbHandle,
+        SQLiteStatementCache* statementCache,
+        int alertId) {
+    auto statement = statementCache->get(
+            dbHandle, ERASE_ALERT_ASSET_PLAY_ORDER_ITEMS_STATEMENT_ID, ERASE_ALERT_ASSET_PLAY_ORDER_ITEMS_SQL_STRING);
 
     if (!statement.isValid()) {
-        ACSDK_ERROR(LX("eraseAlertAssetPlayOrderItemsFailed").m("Could not create statement."));
+        ACSDK_ERROR(LX("eraseAlertAssetPlayOrderItemsFailed").m("Could not create statement->"));
         return false;
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam, alertId)) {
+    if (!statement->bindIntParameter(boundParam, alertId)) {
         ACSDK_ERROR(LX("eraseAlertAssetPlayOrderItemsFailed").m("Could not bind a parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("eraseAlertAssetPlayOrderItemsFailed").m("Could not perform step."));
         return false;
     }
@@ -1087,26 +1377,27 @@ static bool eraseAlertAssetPlayOrderItems(sqlite3* dbHandle, int alertId) {
  * all tables which are associated with the alert.
  *
  * @param dbHandle The database handle.
+ * @param statementCache The cache of the statements run on @c dbHandle.
  * @param alertId The alert id of the alert to be deleted.
  * @return Whether the delete operation was successful.
  */
-static bool eraseAlertByAlertId(sqlite3* dbHandle, int alertId) {
+static bool eraseAlertByAlertId(sqlite3* dbHandle, SQLiteStatementCache* statementCache, int alertId) {
     if (!dbHandle) {
         ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("dbHandle is nullptr."));
         return false;
     }
 
-    if (!eraseAlert(dbHandle, alertId)) {
+    if (!eraseAlert(dbHandle, statementCache, alertId)) {
         ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not erase alert table items."));
         return false;
     }
 
-    if (!eraseAlertAssets(dbHandle, alertId)) {
+    if (!eraseAlertAssets(dbHandle, statementCache, alertId)) {
         ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not erase alertAsset table items."));
         return false;
     }
 
-    if (!eraseAlertAssetPlayOrderItems(dbHandle, alertId)) {
+    if (!eraseAlertAssetPlayOrderItems(dbHandle, statementCache, alertId)) {
         ACSDK_ERROR(LX("eraseAlertByAlertIdFailed").m("Could not erase alertAssetPlayOrderItems table items."));
         return false;
     }
@@ -1115,6 +1406,9 @@ static bool eraseAlertByAlertId(sqlite3* dbHandle, int alertId) {
 }
 
 bool SQLiteAlertStorage::erase(std::shared_ptr<Alert> alert) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return erase(alert); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("eraseFailed").m("Database handle is not open."));
         return false;
@@ -1130,31 +1424,50 @@ bool SQLiteAlertStorage::erase(std::shared_ptr<Alert> alert) {
         return false;
     }
 
-    return eraseAlertByAlertId(m_dbHandle, alert->m_dbId);
+    return eraseAlertByAlertId(m_dbHandle, &m_statementCache, alert->m_dbId);
 }
 
 bool SQLiteAlertStorage::erase(const std::vector<int>& alertDbIds) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return erase(alertDbIds); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("eraseFailed").m("Database handle is not open."));
         return false;
     }
 
+    // Erase the alerts in one transaction, so that they are written to the disk once rather than once per alert.
+    if (!beginTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("eraseFailed").m("Could not begin transaction."));
+        return false;
+    }
+
     for (auto id : alertDbIds) {
-        if (!alertExistsByAlertId(m_dbHandle, id)) {
+        if (!alertExistsByAlertId(m_dbHandle, &m_statementCache, id)) {
             ACSDK_ERROR(LX("eraseFailed").m("Cannot erase an alert - does not exist in db.").d("id", id));
+            rollbackTransaction(m_dbHandle);
             return false;
         }
 
-        if (!eraseAlertByAlertId(m_dbHandle, id)) {
+        if (!eraseAlertByAlertId(m_dbHandle, &m_statementCache, id)) {
             ACSDK_ERROR(LX("eraseFailed").m("Cannot erase an alert.").d("id", id));
+            rollbackTransaction(m_dbHandle);
             return false;
         }
     }
 
+    if (!commitTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("eraseFailed").m("Could not commit transaction."));
+        return false;
+    }
+
     return true;
 }
 
 bool SQLiteAlertStorage::clearDatabase() {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([this](sqlite3*) { return clearDatabase(); });
+    }
     if (!clearTable(m_dbHandle, ALERTS_V2_TABLE_NAME)) {
         ACSDK_ERROR(LX("clearDatabaseFailed").m("could not clear alerts table."));
         return false;
@@ -1191,6 +1504,7 @@ static void printOneLineSummary(sqlite3* dbHandle) {
  * Utility diagnostic function to print the details of all the alerts stored in the database.
  *
  * @param dbHandle The database handle.
+ * @param statementCache The cache of the statements run on @c dbHandle.
  * @param shouldPrintEverything If @c true, then all details of an alert will be printed.  If @c false, then
  * summary information will be printed instead.
  */
@@ -1206,6 +1520,13 @@ static void printAlertsSummary(
 }
 
 void SQLiteAlertStorage::printStats(StatLevel level) {
+    if (m_database && !m_database->isStorageThread()) {
+        m_database->run([this, level](sqlite3*) {
+            printStats(level);
+            return true;
+        });
+        return;
+    }
     std::vector<std::shared_ptr<Alert>> alerts;
     load(&alerts);
     switch (level) {
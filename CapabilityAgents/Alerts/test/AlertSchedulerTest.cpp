@@ -0,0 +1,356 @@
+/*
+ * AlertSchedulerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include <AVSCommon/Utils/Timing/TimeUtils.h>
+
+#include "Alerts/Alarm.h"
+#include "Alerts/AlertScheduler.h"
+#include "Alerts/Storage/SQLiteAlertStorage.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace test {
+
+using namespace avsCommon::utils::timing;
+
+/// The tokens of the alerts used by the tests.
+static const std::string TOKEN_1 = "token-1";
+static const std::string TOKEN_2 = "token-2";
+static const std::string TOKEN_3 = "token-3";
+
+/// A token which no alert has.
+static const std::string UNKNOWN_TOKEN = "unknown-token";
+
+/// How long after its scheduled time an alert is still rendered.
+static const std::chrono::seconds PAST_DUE_TIME_LIMIT(30 * 60);
+
+/// A scheduling horizon of a day.
+static const std::chrono::seconds DAY_HORIZON(24 * 60 * 60);
+
+/// How long to wait for an alert to become ready.
+static const std::chrono::seconds TIMEOUT(10);
+
+/**
+ * Format a time as the ISO-8601 strings AVS sends.
+ *
+ * @param unixTime The time, in seconds since the Unix epoch.
+ * @return The time in ISO-8601 format.
+ */
+static std::string toIso8601(int64_t unixTime) {
+    std::time_t time = static_cast<std::time_t>(unixTime);
+    std::tm utcTime;
+    gmtime_r(&time, &utcTime);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S+0000", &utcTime);
+    return buffer;
+}
+
+/**
+ * Create an alarm.
+ *
+ * @param token The token of the alarm.
+ * @param secondsFromNow How long from now the alarm is scheduled.
+ * @return The alarm, or @c nullptr if it could not be parsed.
+ */
+static std::shared_ptr<Alert> createAlarm(const std::string& token, int64_t secondsFromNow) {
+    int64_t now = 0;
+    if (!getCurrentUnixTime(&now)) {
+        return nullptr;
+    }
+    rapidjson::Document payload(rapidjson::kObjectType);
+    auto& allocator = payload.GetAllocator();
+    payload.AddMember("token", rapidjson::Value(token.c_str(), allocator), allocator);
+    payload.AddMember(
+        "scheduledTime", rapidjson::Value(toIso8601(now + secondsFromNow).c_str(), allocator), allocator);
+    auto alarm = std::make_shared<Alarm>();
+    std::string errorMessage;
+    if (alarm->parseFromJson(payload, &errorMessage) != Alert::ParseFromJsonStatus::OK) {
+        return nullptr;
+    }
+    return alarm;
+}
+
+/// A @c SQLiteAlertStorage which records how the alerts are loaded and erased.
+class RecordingAlertStorage : public storage::SQLiteAlertStorage {
+public:
+    bool load(std::vector<std::shared_ptr<Alert>>* alertContainer) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_numLoads;
+        }
+        return SQLiteAlertStorage::load(alertContainer);
+    }
+
+    bool loadScheduledBetween(int64_t afterUnix, int64_t untilUnix, std::vector<std::shared_ptr<Alert>>* alertContainer)
+        override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lastLoadUntil = untilUnix;
+        }
+        return SQLiteAlertStorage::loadScheduledBetween(afterUnix, untilUnix, alertContainer);
+    }
+
+    bool erase(std::shared_ptr<Alert> alert) override {
+        return SQLiteAlertStorage::erase(alert);
+    }
+
+    bool erase(const std::vector<int>& alertDbIds) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bulkErases.push_back(alertDbIds.size());
+        }
+        return SQLiteAlertStorage::erase(alertDbIds);
+    }
+
+    /// @return The number of calls to @c load().
+    int getNumLoads() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_numLoads;
+    }
+
+    /// @return The end of the range of the last call to @c loadScheduledBetween(), or the minimum if there was none.
+    int64_t getLastLoadUntil() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lastLoadUntil;
+    }
+
+    /// @return The number of alerts erased by each call to @c erase() with several ids.
+    std::vector<size_t> getBulkErases() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bulkErases;
+    }
+
+    /// @return The tokens of the stored alerts.
+    std::set<std::string> getStoredTokens() {
+        std::vector<std::shared_ptr<Alert>> alerts;
+        SQLiteAlertStorage::load(&alerts);
+        std::set<std::string> tokens;
+        for (auto& alert : alerts) {
+            tokens.insert(alert->getToken());
+        }
+        return tokens;
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The number of calls to @c load().
+    int m_numLoads = 0;
+
+    /// The end of the range of the last call to @c loadScheduledBetween().
+    int64_t m_lastLoadUntil = std::numeric_limits<int64_t>::min();
+
+    /// The number of alerts erased by each call to @c erase() with several ids.
+    std::vector<size_t> m_bulkErases;
+};
+
+/// A renderer which renders nothing.
+class StubRenderer : public renderer::RendererInterface {
+public:
+    void setObserver(renderer::RendererObserverInterface* observer) override {
+    }
+
+    void start(
+        const std::string& localAudioFilePath,
+        const std::vector<std::string>& urls,
+        int loopCount,
+        std::chrono::milliseconds loopPause) override {
+    }
+
+    void stop() override {
+    }
+};
+
+/// An observer which records the alerts which become ready.
+class TestAlertObserver : public AlertObserverInterface {
+public:
+    void onAlertStateChange(const std::string& alertToken, State state, const std::string& reason) override {
+        if (State::READY == state) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_readyTokens.insert(alertToken);
+            m_wakeTrigger.notify_all();
+        }
+    }
+
+    /**
+     * Wait for an alert to become ready.
+     *
+     * @param token The token of the alert.
+     * @return Whether the alert became ready before the timeout.
+     */
+    bool waitForReady(const std::string& token) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, token] { return m_readyTokens.count(token) > 0; });
+    }
+
+private:
+    /// Serializes access to @c m_readyTokens.
+    std::mutex m_mutex;
+
+    /// Notified when an alert becomes ready.
+    std::condition_variable m_wakeTrigger;
+
+    /// The tokens of the alerts which became ready.
+    std::set<std::string> m_readyTokens;
+};
+
+class AlertSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        static int databaseCount = 0;
+        m_databasePath = "/tmp/AlertSchedulerTest-" + std::to_string(getpid()) + "-" +
+                         std::to_string(databaseCount++) + ".db";
+        std::remove(m_databasePath.c_str());
+        m_storage = std::make_shared<RecordingAlertStorage>();
+        m_observer = std::make_shared<TestAlertObserver>();
+        m_scheduler =
+            std::make_shared<AlertScheduler>(m_storage, std::make_shared<StubRenderer>(), PAST_DUE_TIME_LIMIT);
+    }
+
+    void TearDown() override {
+        m_scheduler->shutdown();
+        m_storage->close();
+        std::remove(m_databasePath.c_str());
+    }
+
+    /**
+     * Store alerts in the database before the scheduler opens it, as if they were set before a restart.
+     *
+     * @param alerts The alerts to store.
+     */
+    void storeBeforeInitialize(const std::vector<std::shared_ptr<Alert>>& alerts) {
+        ASSERT_TRUE(m_storage->createDatabase(m_databasePath));
+        for (auto& alert : alerts) {
+            ASSERT_TRUE(alert);
+            ASSERT_TRUE(m_storage->store(alert));
+        }
+        m_storage->close();
+    }
+
+    /**
+     * Get the tokens of the alerts the scheduler reports in context.
+     *
+     * @return The tokens of the scheduled alerts.
+     */
+    std::set<std::string> getContextTokens() {
+        std::set<std::string> tokens;
+        for (auto& info : m_scheduler->getContextInfo().scheduledAlerts) {
+            tokens.insert(info.token);
+        }
+        return tokens;
+    }
+
+    /// The path of the database.
+    std::string m_databasePath;
+
+    /// The storage of the scheduler.
+    std::shared_ptr<RecordingAlertStorage> m_storage;
+
+    /// The observer of the scheduler.
+    std::shared_ptr<TestAlertObserver> m_observer;
+
+    /// The scheduler under test.
+    std::shared_ptr<AlertScheduler> m_scheduler;
+};
+
+/**
+ * Verify that with a scheduling horizon only the alerts due within it are loaded, while the later ones are still
+ * reported in context, recognized as duplicates and deleted.
+ */
+TEST_F(AlertSchedulerTest, loadsOnlyAlertsWithinHorizon) {
+    storeBeforeInitialize({createAlarm(TOKEN_1, 60 * 60), createAlarm(TOKEN_2, 10 * DAY_HORIZON.count())});
+    int64_t now = 0;
+    ASSERT_TRUE(getCurrentUnixTime(&now));
+    ASSERT_TRUE(m_scheduler->initialize(m_databasePath, m_observer, std::chrono::seconds::zero(), DAY_HORIZON));
+    EXPECT_EQ(m_storage->getNumLoads(), 0);
+    EXPECT_GE(m_storage->getLastLoadUntil(), now + DAY_HORIZON.count());
+    EXPECT_LT(m_storage->getLastLoadUntil(), now + 2 * DAY_HORIZON.count());
+
+    EXPECT_EQ(getContextTokens(), (std::set<std::string>{TOKEN_1, TOKEN_2}));
+    EXPECT_TRUE(m_scheduler->scheduleAlert(createAlarm(TOKEN_2, 10 * DAY_HORIZON.count())));
+    EXPECT_EQ(m_storage->getStoredTokens(), (std::set<std::string>{TOKEN_1, TOKEN_2}));
+
+    EXPECT_TRUE(m_scheduler->deleteAlert(TOKEN_2));
+    EXPECT_EQ(m_storage->getStoredTokens(), std::set<std::string>{TOKEN_1});
+    EXPECT_EQ(getContextTokens(), std::set<std::string>{TOKEN_1});
+}
+
+/**
+ * Verify that an alert beyond the scheduling horizon is paged in as time advances, and becomes ready when it is due.
+ */
+TEST_F(AlertSchedulerTest, pagesInAlertsAsTimeAdvances) {
+    storeBeforeInitialize({createAlarm(TOKEN_1, 4)});
+    ASSERT_TRUE(m_scheduler->initialize(
+        m_databasePath, m_observer, std::chrono::seconds::zero(), std::chrono::seconds(2)));
+    EXPECT_TRUE(m_observer->waitForReady(TOKEN_1));
+}
+
+/**
+ * Verify that several alerts are deleted with one erase from storage, that the alerts which were found are deleted
+ * even when one was not, and that the others are kept.
+ */
+TEST_F(AlertSchedulerTest, deletesAlertsInBulk) {
+    ASSERT_TRUE(m_scheduler->initialize(m_databasePath, m_observer));
+    for (auto& token : {TOKEN_1, TOKEN_2, TOKEN_3}) {
+        ASSERT_TRUE(m_scheduler->scheduleAlert(createAlarm(token, 60 * 60)));
+    }
+
+    EXPECT_FALSE(m_scheduler->deleteAlerts({TOKEN_1, UNKNOWN_TOKEN, TOKEN_3}));
+    EXPECT_EQ(m_storage->getBulkErases(), std::vector<size_t>{2});
+    EXPECT_EQ(m_storage->getStoredTokens(), std::set<std::string>{TOKEN_2});
+    EXPECT_EQ(getContextTokens(), std::set<std::string>{TOKEN_2});
+
+    EXPECT_TRUE(m_scheduler->deleteAlerts({TOKEN_2}));
+    EXPECT_TRUE(m_storage->getStoredTokens().empty());
+    EXPECT_TRUE(getContextTokens().empty());
+}
+
+/**
+ * Verify that a bulk delete finds the alerts beyond the scheduling horizon as well as those in memory.
+ */
+TEST_F(AlertSchedulerTest, deletesDeferredAlertsInBulk) {
+    storeBeforeInitialize({createAlarm(TOKEN_1, 60 * 60), createAlarm(TOKEN_2, 10 * DAY_HORIZON.count())});
+    ASSERT_TRUE(m_scheduler->initialize(m_databasePath, m_observer, std::chrono::seconds::zero(), DAY_HORIZON));
+    ASSERT_TRUE(m_scheduler->scheduleAlert(createAlarm(TOKEN_3, 60 * 60)));
+
+    EXPECT_TRUE(m_scheduler->deleteAlerts({TOKEN_2, TOKEN_1}));
+    EXPECT_EQ(m_storage->getBulkErases(), std::vector<size_t>{2});
+    EXPECT_EQ(m_storage->getStoredTokens(), std::set<std::string>{TOKEN_3});
+    EXPECT_EQ(getContextTokens(), std::set<std::string>{TOKEN_3});
+}
+
+}  // namespace test
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
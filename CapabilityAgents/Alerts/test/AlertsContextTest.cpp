@@ -0,0 +1,247 @@
+/*
+ * AlertsContextTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "Alerts/AlertsContext.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace test {
+
+using namespace rapidjson;
+
+/// The key in the context for all alerts.
+static const std::string ALL_ALERTS_KEY = "allAlerts";
+/// The key in the context for active alerts.
+static const std::string ACTIVE_ALERTS_KEY = "activeAlerts";
+/// The key in the context for an alert's token.
+static const std::string TOKEN_KEY = "token";
+/// The key in the context for an alert's type.
+static const std::string TYPE_KEY = "type";
+/// The key in the context for an alert's scheduled time.
+static const std::string SCHEDULED_TIME_KEY = "scheduledTime";
+
+/// An alarm.
+static const Alert::ContextInfo ALARM("alarm-token", "ALARM", "2017-08-01T10:00:00+0000");
+/// A timer.
+static const Alert::ContextInfo TIMER("timer-token", "TIMER", "2017-08-01T09:00:00+0000");
+/// A reminder, whose token needs escaping.
+static const Alert::ContextInfo REMINDER("reminder \"token\"\\", "REMINDER", "2017-08-01T11:00:00+0000");
+
+/**
+ * Build an alert the way the AlertsState context was built before it was kept serialized.
+ *
+ * @param info The alert.
+ * @param allocator The allocator of the document.
+ * @return The alert as a JSON object.
+ */
+static Value buildAlert(const Alert::ContextInfo& info, Document::AllocatorType& allocator) {
+    Value alertJson(kObjectType);
+    alertJson.AddMember(StringRef(TOKEN_KEY), info.token, allocator);
+    alertJson.AddMember(StringRef(TYPE_KEY), info.type, allocator);
+    alertJson.AddMember(StringRef(SCHEDULED_TIME_KEY), info.scheduledTime_ISO_8601, allocator);
+    return alertJson;
+}
+
+/**
+ * Rebuild the whole AlertsState context from the alerts, as @c AlertScheduler::getContextInfo() reports them.
+ *
+ * @param alertsContextInfo The alerts which are scheduled and active.
+ * @return The context as a JSON string.
+ */
+static std::string rebuildContext(const AlertScheduler::AlertsContextInfo& alertsContextInfo) {
+    Document state(kObjectType);
+    auto& allocator = state.GetAllocator();
+    Value allAlerts(kArrayType);
+    for (const auto& info : alertsContextInfo.scheduledAlerts) {
+        allAlerts.PushBack(buildAlert(info, allocator), allocator);
+    }
+    Value activeAlerts(kArrayType);
+    if (!alertsContextInfo.activeAlerts.empty()) {
+        activeAlerts.PushBack(buildAlert(alertsContextInfo.activeAlerts[0], allocator), allocator);
+    }
+    state.AddMember(StringRef(ALL_ALERTS_KEY), allAlerts, allocator);
+    state.AddMember(StringRef(ACTIVE_ALERTS_KEY), activeAlerts, allocator);
+    StringBuffer buffer;
+    Writer<StringBuffer> writer(buffer);
+    state.Accept(writer);
+    return buffer.GetString();
+}
+
+/**
+ * Put a context in a canonical form, in which all the alerts are ordered by token.  AVS does not depend on the order.
+ *
+ * @param context The context as a JSON string.
+ * @return The canonical context as a JSON string, or an empty string if it is not valid.
+ */
+static std::string normalize(const std::string& context) {
+    Document document;
+    if (document.Parse(context.c_str()).HasParseError() || !document.IsObject() ||
+        !document.HasMember(ALL_ALERTS_KEY.c_str()) || !document[ALL_ALERTS_KEY.c_str()].IsArray()) {
+        return "";
+    }
+    auto& allAlerts = document[ALL_ALERTS_KEY.c_str()];
+    std::vector<Value*> alerts;
+    for (auto& alert : allAlerts.GetArray()) {
+        alerts.push_back(&alert);
+    }
+    std::sort(alerts.begin(), alerts.end(), [](const Value* lhs, const Value* rhs) {
+        return std::string((*lhs)[TOKEN_KEY.c_str()].GetString()) < (*rhs)[TOKEN_KEY.c_str()].GetString();
+    });
+    Value sortedAlerts(kArrayType);
+    for (auto alert : alerts) {
+        Value copy(*alert, document.GetAllocator());
+        sortedAlerts.PushBack(copy, document.GetAllocator());
+    }
+    allAlerts = sortedAlerts;
+    StringBuffer buffer;
+    Writer<StringBuffer> writer(buffer);
+    document.Accept(writer);
+    return buffer.GetString();
+}
+
+class AlertsContextTest : public ::testing::Test {
+protected:
+    /// Add or update an alert in both @c m_context and the alerts it is checked against.
+    void setAlert(const Alert::ContextInfo& info) {
+        m_alerts.erase(info.token);
+        m_alerts.insert({info.token, info});
+        m_context.setAlert(info);
+    }
+
+    /// Remove an alert from both @c m_context and the alerts it is checked against.
+    void removeAlert(const std::string& token) {
+        m_alerts.erase(token);
+        if (m_activeToken == token) {
+            m_activeToken.clear();
+        }
+        m_context.removeAlert(token);
+    }
+
+    /// Make an alert active in both @c m_context and the alerts it is checked against.
+    void setActiveAlert(const std::string& token) {
+        m_activeToken = token;
+        m_context.setActiveAlert(token);
+    }
+
+    /// Make no alert active in both @c m_context and the alerts it is checked against.
+    void clearActiveAlert() {
+        m_activeToken.clear();
+        m_context.clearActiveAlert();
+    }
+
+    /// @return The alerts, as @c AlertScheduler::getContextInfo() would report them.
+    AlertScheduler::AlertsContextInfo getContextInfo() {
+        AlertScheduler::AlertsContextInfo alertsContextInfo;
+        for (const auto& alert : m_alerts) {
+            alertsContextInfo.scheduledAlerts.push_back(alert.second);
+            if (alert.first == m_activeToken) {
+                alertsContextInfo.activeAlerts.push_back(alert.second);
+            }
+        }
+        return alertsContextInfo;
+    }
+
+    /// Check that @c m_context matches a rebuild of the whole context from the same alerts.
+    void expectMatchesRebuild() {
+        auto context = m_context.toJsonString();
+        ASSERT_FALSE(normalize(context).empty()) << context;
+        EXPECT_EQ(normalize(rebuildContext(getContextInfo())), normalize(context));
+    }
+
+    /// The context under test.
+    AlertsContext m_context;
+
+    /// The alerts which should be in @c m_context, keyed by token.
+    std::map<std::string, Alert::ContextInfo> m_alerts;
+
+    /// The token of the alert which should be active, or empty.
+    std::string m_activeToken;
+};
+
+/// Verify that an empty context matches a rebuild.
+TEST_F(AlertsContextTest, empty) {
+    expectMatchesRebuild();
+}
+
+/// Verify that the context matches a rebuild as alerts are added, updated and deleted.
+TEST_F(AlertsContextTest, addAndDeleteAlerts) {
+    setAlert(ALARM);
+    expectMatchesRebuild();
+    setAlert(TIMER);
+    setAlert(REMINDER);
+    expectMatchesRebuild();
+    setAlert(Alert::ContextInfo(ALARM.token, ALARM.type, "2017-08-02T10:00:00+0000"));
+    expectMatchesRebuild();
+    removeAlert(TIMER.token);
+    expectMatchesRebuild();
+    removeAlert(TIMER.token);
+    removeAlert(ALARM.token);
+    removeAlert(REMINDER.token);
+    expectMatchesRebuild();
+}
+
+/// Verify that the context matches a rebuild as alerts become active and inactive.
+TEST_F(AlertsContextTest, activeAndInactiveAlerts) {
+    setAlert(ALARM);
+    setAlert(TIMER);
+    setActiveAlert(TIMER.token);
+    expectMatchesRebuild();
+    clearActiveAlert();
+    expectMatchesRebuild();
+    setActiveAlert(ALARM.token);
+    expectMatchesRebuild();
+    setActiveAlert(TIMER.token);
+    expectMatchesRebuild();
+    removeAlert(TIMER.token);
+    expectMatchesRebuild();
+}
+
+/// Verify that a context reset from the scheduler matches a rebuild, and keeps matching as it is patched.
+TEST_F(AlertsContextTest, resetThenPatch) {
+    setAlert(REMINDER);
+    m_alerts.clear();
+    m_alerts.insert({ALARM.token, ALARM});
+    m_alerts.insert({TIMER.token, TIMER});
+    m_activeToken = ALARM.token;
+    m_context.reset(getContextInfo());
+    EXPECT_FALSE(m_context.hasAlert(REMINDER.token));
+    EXPECT_TRUE(m_context.hasAlert(ALARM.token));
+    expectMatchesRebuild();
+    removeAlert(ALARM.token);
+    setAlert(REMINDER);
+    expectMatchesRebuild();
+    m_alerts.clear();
+    m_activeToken.clear();
+    m_context.clear();
+    expectMatchesRebuild();
+}
+
+}  // namespace test
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
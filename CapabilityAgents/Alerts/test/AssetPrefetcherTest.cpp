@@ -0,0 +1,249 @@
+/*
+ * AssetPrefetcherTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/Attachment/InProcessAttachment.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+#include "Alerts/Renderer/AssetPrefetcher.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace renderer {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The URLs of the assets used by the tests.
+static const std::string URL_1 = "http://example.com/1.mp3";
+static const std::string URL_2 = "http://example.com/2.mp3";
+static const std::string URL_3 = "http://example.com/3.mp3";
+
+/// The byte budget of most tests.
+static const size_t MAX_BYTES = 1024;
+
+/// How long to wait for the prefetcher to download an asset.
+static const std::chrono::seconds TIMEOUT(5);
+
+/// How long to wait when an asset is expected not to be downloaded.
+static const std::chrono::milliseconds SHORT_TIMEOUT(200);
+
+/// How often to check whether an asset has been downloaded.
+static const std::chrono::milliseconds POLL_INTERVAL(10);
+
+/// A content fetcher which returns its content at once.
+class MockContentFetcher : public HTTPContentFetcherInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param content The content to return.
+     * @param statusCode The HTTP status code to return.
+     */
+    MockContentFetcher(const std::string& content, long statusCode) : m_content{content}, m_statusCode{statusCode} {
+    }
+
+    std::unique_ptr<HTTPContent> getContent(FetchOptions fetchOption) override {
+        std::promise<long> statusPromise;
+        statusPromise.set_value(m_statusCode);
+        std::promise<std::string> contentTypePromise;
+        contentTypePromise.set_value("audio/mpeg");
+        auto stream = std::make_shared<InProcessAttachment>(m_content);
+        auto writer = stream->createWriter();
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        writer->write(m_content.data(), m_content.size(), &writeStatus);
+        writer->close();
+        return memory::make_unique<HTTPContent>(
+            HTTPContent{statusPromise.get_future(), contentTypePromise.get_future(), stream});
+    }
+
+private:
+    /// The content to return.
+    std::string m_content;
+
+    /// The HTTP status code to return.
+    long m_statusCode;
+};
+
+/// A factory of @c MockContentFetcher, returning the content of each URL from a map, and counting the fetches.
+class MockContentFetcherFactory : public HTTPContentFetcherInterfaceFactoryInterface {
+public:
+    std::unique_ptr<HTTPContentFetcherInterface> create(const std::string& url) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_numFetches[url];
+        auto statusCode = m_statusCodes.count(url) ? m_statusCodes[url] : 200;
+        return memory::make_unique<MockContentFetcher>(m_contents[url], statusCode);
+    }
+
+    /**
+     * Get the number of times a URL has been fetched.
+     *
+     * @param url The URL.
+     * @return The number of fetches of @c url.
+     */
+    int getNumFetches(const std::string& url) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_numFetches[url];
+    }
+
+    /// The content of each URL.  Set up before the fetches start.
+    std::unordered_map<std::string, std::string> m_contents;
+
+    /// The HTTP status code of each URL which does not return 200.  Set up before the fetches start.
+    std::unordered_map<std::string, long> m_statusCodes;
+
+private:
+    /// Serializes access to @c m_numFetches and the maps above.
+    std::mutex m_mutex;
+
+    /// The number of fetches of each URL.
+    std::unordered_map<std::string, int> m_numFetches;
+};
+
+/**
+ * Wait for an asset to be downloaded, and read it.
+ *
+ * @param prefetcher The prefetcher.
+ * @param url The URL of the asset.
+ * @param timeout How long to wait.
+ * @param[out] content The content of the asset.
+ * @return Whether the asset was downloaded before the timeout.
+ */
+static bool waitForAsset(
+    AssetPrefetcher* prefetcher,
+    const std::string& url,
+    std::chrono::milliseconds timeout,
+    std::string* content) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto stream = prefetcher->open(url);
+        if (stream) {
+            content->assign(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+            return true;
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+}
+
+class AssetPrefetcherTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_factory = std::make_shared<MockContentFetcherFactory>();
+        m_factory->m_contents[URL_1] = "one";
+        m_factory->m_contents[URL_2] = "two";
+        m_factory->m_contents[URL_3] = "three";
+    }
+
+    /// The factory of the fetchers used by the prefetcher.
+    std::shared_ptr<MockContentFetcherFactory> m_factory;
+};
+
+/**
+ * Verify that invalid parameters are rejected.
+ */
+TEST_F(AssetPrefetcherTest, createFailures) {
+    EXPECT_FALSE(AssetPrefetcher::create(nullptr, MAX_BYTES));
+    EXPECT_FALSE(AssetPrefetcher::create(m_factory, 0));
+}
+
+/**
+ * Verify that the assets of an alert are downloaded, and that an asset which was not prefetched is not held.
+ */
+TEST_F(AssetPrefetcherTest, prefetchesAssets) {
+    auto prefetcher = AssetPrefetcher::create(m_factory, MAX_BYTES);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch({URL_1, URL_2, URL_1});
+
+    std::string content;
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_1, TIMEOUT, &content));
+    EXPECT_EQ(content, "one");
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_2, TIMEOUT, &content));
+    EXPECT_EQ(content, "two");
+    EXPECT_FALSE(prefetcher->open(URL_3));
+    EXPECT_EQ(m_factory->getNumFetches(URL_1), 1);
+}
+
+/**
+ * Verify that prefetching the assets of the next alert forgets the assets the previous one does not share, and keeps
+ * those it does without downloading them again.
+ */
+TEST_F(AssetPrefetcherTest, replacesAssetsOfPreviousAlert) {
+    auto prefetcher = AssetPrefetcher::create(m_factory, MAX_BYTES);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch({URL_1, URL_2});
+    std::string content;
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_1, TIMEOUT, &content));
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_2, TIMEOUT, &content));
+
+    prefetcher->prefetch({URL_2, URL_3});
+    EXPECT_FALSE(prefetcher->open(URL_1));
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_3, TIMEOUT, &content));
+    EXPECT_EQ(content, "three");
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_2, TIMEOUT, &content));
+    EXPECT_EQ(content, "two");
+    EXPECT_EQ(m_factory->getNumFetches(URL_2), 1);
+}
+
+/**
+ * Verify that an asset which would take the cache over budget is left to be streamed, while the others are held.
+ */
+TEST_F(AssetPrefetcherTest, abandonsAssetsOverBudget) {
+    m_factory->m_contents[URL_1] = std::string(MAX_BYTES + 1, 'x');
+    auto prefetcher = AssetPrefetcher::create(m_factory, MAX_BYTES);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch({URL_1, URL_2});
+
+    std::string content;
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_2, TIMEOUT, &content));
+    EXPECT_FALSE(prefetcher->open(URL_1));
+}
+
+/**
+ * Verify that an asset whose download fails is not held.
+ */
+TEST_F(AssetPrefetcherTest, skipsFailedDownloads) {
+    m_factory->m_statusCodes[URL_1] = 404;
+    auto prefetcher = AssetPrefetcher::create(m_factory, MAX_BYTES);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch({URL_1, URL_2});
+
+    std::string content;
+    ASSERT_TRUE(waitForAsset(prefetcher.get(), URL_2, TIMEOUT, &content));
+    EXPECT_FALSE(waitForAsset(prefetcher.get(), URL_1, SHORT_TIMEOUT, &content));
+    EXPECT_EQ(m_factory->getNumFetches(URL_1), 1);
+}
+
+}  // namespace test
+}  // namespace renderer
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
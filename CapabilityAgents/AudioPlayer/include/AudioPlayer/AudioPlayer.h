@@ -19,8 +19,11 @@
 #define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_AUDIO_PLAYER_INCLUDE_AUDIO_PLAYER_AUDIO_PLAYER_H_
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <AVSCommon/AVS/CapabilityAgent.h>
+#include <AVSCommon/AVS/EventBuilder.h>
 #include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
 #include <AVSCommon/SDKInterfaces/FocusManagerInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
@@ -61,6 +64,8 @@ public:
      * @param contextManager The AVS Context manager used to generate system context for events.
      * @param attachmentManager The instance of the @c AttachmentManagerInterface to use to read the attachment.
      * @param exceptionSender The object to use for sending AVS Exception messages.
+     * @param nextMediaPlayer An optional second @c MediaPlayerInterface, on which the next queued @c AudioItem is
+     *     loaded while the current one plays, so that it can start as soon as the current one finishes.
      * @return A @c std::shared_ptr to the new @c AudioPlayer instance.
      */
     static std::shared_ptr<AudioPlayer> create(
@@ -69,7 +74,23 @@ public:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager,
-        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender);
+        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> nextMediaPlayer = nullptr);
+
+    /**
+     * Get the configuration of every @c AudioPlayer, so that one can be registered before it is created.
+     *
+     * @return The @c DirectiveHandlerConfiguration of an @c AudioPlayer.
+     */
+    static avsCommon::avs::DirectiveHandlerConfiguration getDefaultConfiguration();
+
+    /**
+     * Get the states of an @c AudioPlayer which has not played anything yet, so that they can be reported before it
+     * is created.
+     *
+     * @return The idle states, by @c NamespaceAndName.
+     */
+    static std::unordered_map<avsCommon::avs::NamespaceAndName, std::string> getIdleStates();
 
     /// @name StateProviderInterface Functions
     /// @{
@@ -112,6 +133,7 @@ private:
      * @param contextManager The AVS Context manager used to generate system context for events.
      * @param attachmentManager The instance of the @c AttachmentManagerInterface to use to read the attachment.
      * @param exceptionSender The object to use for sending AVS Exception messages.
+     * @param nextMediaPlayer The @c MediaPlayerInterface to load the next queued @c AudioItem on, or @c nullptr.
      * @return A @c std::shared_ptr to the new @c AudioPlayer instance.
      */
     AudioPlayer(
@@ -120,7 +142,8 @@ private:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
         std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> attachmentManager,
-        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender);
+        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> nextMediaPlayer);
 
     /// @name RequiresShutdown Functions
     /// @{
@@ -128,13 +151,13 @@ private:
     /// @}
 
     /**
-     * This function deserializes a @c Directive's payload into a @c rapidjson::Document.
+     * This function gets a @c Directive's parsed payload, reporting a failure if the payload is not valid JSON.
      *
-     * @param info The @c DirectiveInfo to read the payload string from.
-     * @param[out] document The @c rapidjson::Document to parse the payload into.
-     * @return @c true if parsing was successful, else @c false.
+     * @param info The @c DirectiveInfo to read the payload from.
+     * @param[out] payload The parsed payload, which remains valid for the lifetime of @c info->directive.
+     * @return @c true if the payload was parsed successfully, else @c false.
      */
-    bool parseDirectivePayload(std::shared_ptr<DirectiveInfo> info, rapidjson::Document* document);
+    bool parseDirectivePayload(std::shared_ptr<DirectiveInfo> info, const rapidjson::Value** payload);
 
     /**
      * This function handles a @c PLAY directive.
@@ -227,13 +250,67 @@ private:
      * This function executes a parsed @c PLAY directive.
      *
      * @param playBehavior Specifies how @c audioItem should be queued/played.
-     * @param audioItem The new @c AudioItem to play.
+     * @param audioItem The new @c AudioItem to play.  It is moved into the queue.
+     * @param messageId The message id of the directive, which matches it with its prefetch, if any.
      */
-    void executePlay(PlayBehavior playBehavior, const AudioItem& audioItem);
+    void executePlay(PlayBehavior playBehavior, AudioItem audioItem, const std::string& messageId);
 
     /// This fuction plays the next @c AudioItem in the queue.
     void playNextItem();
 
+    /**
+     * This function loads the @c AudioItem at the front of the queue on @c m_nextMediaPlayer, so that @c playNextItem
+     * can start it without waiting for its source to be set up.  It does nothing if there is no
+     * @c m_nextMediaPlayer, if the queue is empty, or if the item is already loaded.
+     */
+    void preloadNextItem();
+
+    /// This function stops @c m_nextMediaPlayer and forgets the item loaded on it, if any.
+    void cancelPreload();
+
+    /**
+     * This function drops the @c AudioItem at the front of the queue if it is an attachment whose preload was torn
+     * down.  The source on @c m_nextMediaPlayer closed the attachment reader it shared with the item, and an attachment
+     * only ever has one reader, so the item can no longer be played.
+     *
+     * @param error The message of the @c PlaybackFailed event sent for the item, or empty to drop it silently.
+     */
+    void dropPreloadedAttachment(const std::string& error);
+
+    /**
+     * This function starts connecting to and buffering the URL of a @c PLAY directive on @c m_nextMediaPlayer while
+     * the directive waits to be handled, so that playback can start as soon as focus is granted.  It does nothing if
+     * there is no @c m_nextMediaPlayer, if it is already in use, or if the item will not be the next one played.
+     *
+     * @param messageId The message id of the directive.
+     * @param playBehavior The play behavior of the directive.
+     * @param url The URL of the @c AudioItem.
+     * @param offset The offset to start playback at.
+     */
+    void executePrefetch(
+        const std::string& messageId,
+        PlayBehavior playBehavior,
+        const std::string& url,
+        std::chrono::milliseconds offset);
+
+    /// This function stops @c m_nextMediaPlayer and forgets the prefetch on it, if any.
+    void cancelPrefetch();
+
+    /**
+     * This function drops every @c AudioItem in the queue.  The preload is cancelled first, then the queue is swapped
+     * out in one step and the attachment readers of the dropped items are closed together, so that their attachments
+     * are released at once.
+     */
+    void clearQueue();
+
+    /**
+     * This function sends the progress reports which are due at the current offset in the stream, and sets
+     * @c m_progressTimer for when the next one is due.  The timer is re-armed from the offset reported by
+     * @c MediaPlayer each time it fires, so reports follow the position in the stream rather than the wall clock.  It
+     * does nothing unless playing; pausing and buffer underruns stop the timer.
+     */
+    void scheduleProgressReports();
+
     /**
      * This function executes a parsed @c STOP directive.
      *
@@ -241,6 +318,17 @@ private:
      */
     void executeStop(bool releaseFocus = true);
 
+    /**
+     * This function lowers the volume of @c m_mediaPlayer to @c m_duckingVolume, so that it can keep playing under
+     * another channel.
+     *
+     * @return @c true if the volume was lowered, or @c false if the player must be paused instead.
+     */
+    bool duck();
+
+    /// This function restores the volume of @c m_mediaPlayer after @c duck().
+    void unduck();
+
     /**
      * This function executes a parsed @c CLEAR_QUEUE directive.
      *
@@ -276,9 +364,12 @@ private:
      * Most of the @c AudioPlayer events use the same payload, and only vary in their event name.  This utility
      * function constructs and sends these generic @c AudioPlayer events.
      *
-     * @param name The name of the event to send.
+     * @param eventTemplate The template of the event to send.
+     * @param priority The priority with which the event is sent.
      */
-    void sendEventWithTokenAndOffset(const std::string& eventName);
+    void sendEventWithTokenAndOffset(
+        const avsCommon::avs::EventTemplate& eventTemplate,
+        avsCommon::avs::MessageRequest::Priority priority = avsCommon::avs::MessageRequest::Priority::NORMAL);
 
     /// Send a @c PlaybackStarted event.
     void sendPlaybackStartedEvent();
@@ -345,6 +436,12 @@ private:
     /// MediaPlayerInterface instance to send audio attachments to.
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_mediaPlayer;
 
+    /**
+     * MediaPlayerInterface instance to load the next queued @c AudioItem on, or @c nullptr.  The two players swap
+     * roles whenever a loaded item starts playing.  Only @c m_mediaPlayer has this object as its observer.
+     */
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_nextMediaPlayer;
+
     /// The object to use for sending events.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
 
@@ -406,17 +503,48 @@ private:
     /// The queue of @c AudioItems to play.
     std::deque<AudioItem> m_audioItems;
 
+    /// Whether the item at the front of @c m_audioItems has been loaded on @c m_nextMediaPlayer.
+    bool m_isNextItemPreloaded;
+
+    /// Whether URL items are buffered on @c m_nextMediaPlayer while their @c PLAY directives wait to be handled.
+    bool m_isPrefetchEnabled;
+
+    /**
+     * The message id of the @c PLAY directive whose item is being buffered on @c m_nextMediaPlayer before it is
+     * handled, or empty if there is none.  This is only accessed from the executor thread.
+     */
+    std::string m_prefetchMessageId;
+
+    /// Whether playback is ducked rather than paused when the content channel goes to the background.
+    bool m_isDuckingEnabled;
+
+    /// The volume to play at while ducked, from 0.0 to 1.0.
+    double m_duckingVolume;
+
+    /// Whether @c m_mediaPlayer is currently ducked.
+    bool m_isDucked;
+
     /// The token of the currently (or most recently) playing @c AudioItem.
     std::string m_token;
 
     /// When in the @c BUFFER_UNDERRUN state, this records the time at which the state was entered.
     std::chrono::steady_clock::time_point m_bufferUnderrunTimestamp;
 
-    /// This timer is used to send @c ProgressReportDelayElapsed events.
-    avsCommon::utils::timing::Timer m_delayTimer;
+    /**
+     * This timer is used to send @c ProgressReportDelayElapsed and @c ProgressReportIntervalElapsed events.  Its task
+     * only submits work to @c m_executor, so it runs on the shared @c TimerService thread rather than a thread of its
+     * own.
+     */
+    avsCommon::utils::timing::Timer m_progressTimer;
+
+    /// The offset in the stream at which to send @c ProgressReportDelayElapsed, or @c max() if it is not to be sent.
+    std::chrono::milliseconds m_progressReportDelay;
+
+    /// The interval between @c ProgressReportIntervalElapsed events, or @c max() if they are not to be sent.
+    std::chrono::milliseconds m_progressReportInterval;
 
-    /// This timer is used to send @c ProgressReportIntervalElapsed events.
-    avsCommon::utils::timing::Timer m_intervalTimer;
+    /// The offset in the stream at which to send the next @c ProgressReportIntervalElapsed, or @c max() if none.
+    std::chrono::milliseconds m_nextProgressReportInterval;
 
     /**
      * This keeps track of the current offset in the audio stream.  Reading the offset from @c MediaPlayer is
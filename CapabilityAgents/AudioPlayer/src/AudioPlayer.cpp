@@ -19,10 +19,12 @@
 
 #include "AudioPlayer/AudioPlayer.h"
 
+#include <algorithm>
+
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
-#include <rapidjson/error/en.h>
 
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/Utils/Timing/TimeUtils.h>
 
@@ -69,6 +71,19 @@ static const NamespaceAndName CLEAR_QUEUE{NAMESPACE, "ClearQueue"};
 /// The @c AudioPlayer context state signature.
 static const NamespaceAndName STATE{NAMESPACE, "PlaybackState"};
 
+/// The @c AudioPlayer events which carry the token and offset of the current stream.
+/// @{
+static const EventTemplate PLAYBACK_STARTED{NAMESPACE, "PlaybackStarted"};
+static const EventTemplate PLAYBACK_NEARLY_FINISHED{NAMESPACE, "PlaybackNearlyFinished"};
+static const EventTemplate PROGRESS_REPORT_DELAY_ELAPSED{NAMESPACE, "ProgressReportDelayElapsed"};
+static const EventTemplate PROGRESS_REPORT_INTERVAL_ELAPSED{NAMESPACE, "ProgressReportIntervalElapsed"};
+static const EventTemplate PLAYBACK_STUTTER_STARTED{NAMESPACE, "PlaybackStutterStarted"};
+static const EventTemplate PLAYBACK_FINISHED{NAMESPACE, "PlaybackFinished"};
+static const EventTemplate PLAYBACK_STOPPED{NAMESPACE, "PlaybackStopped"};
+static const EventTemplate PLAYBACK_PAUSED{NAMESPACE, "PlaybackPaused"};
+static const EventTemplate PLAYBACK_RESUMED{NAMESPACE, "PlaybackResumed"};
+/// @}
+
 /// Prefix for content ID prefix in the url property of the directive payload.
 static const std::string CID_PREFIX{"cid:"};
 
@@ -84,6 +99,24 @@ static const char ACTIVITY_KEY[] = "playerActivity";
 /// The stutter key used in @c AudioPlayer events.
 static const char STUTTER_DURATION_KEY[] = "stutterDurationInMilliseconds";
 
+/// Key for the @c AudioPlayer settings in the configuration.
+static const std::string CONFIG_KEY_AUDIO_PLAYER = "audioPlayer";
+
+/**
+ * Key under "audioPlayer" for the volume, in percent, to play at while another channel has focus.  When it is not
+ * set, playback is paused instead.
+ */
+static const std::string CONFIG_KEY_DUCKING_VOLUME_PERCENT = "duckingVolumePercent";
+
+/**
+ * Key under "audioPlayer" for whether to start buffering the URL of a @c REPLACE_ALL or @c ENQUEUE @c Play directive
+ * on the second media player while the directive waits to be handled.  Defaults to false.
+ */
+static const std::string CONFIG_KEY_PREFETCH_ON_PRE_HANDLE = "prefetchOnPreHandle";
+
+/// The volume of @c MediaPlayerInterface when not ducked.
+static const double FULL_VOLUME = 1.0;
+
 /// The duration to wait for a state change in @c onFocusChanged before failing.
 static const std::chrono::seconds TIMEOUT{2};
 
@@ -93,7 +126,8 @@ std::shared_ptr<AudioPlayer> AudioPlayer::create(
     std::shared_ptr<FocusManagerInterface> focusManager,
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<AttachmentManagerInterface> attachmentManager,
-    std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender) {
+    std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
+    std::shared_ptr<MediaPlayerInterface> nextMediaPlayer) {
     if (nullptr == mediaPlayer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullMediaPlayer"));
         return nullptr;
@@ -112,10 +146,13 @@ std::shared_ptr<AudioPlayer> AudioPlayer::create(
     } else if (nullptr == exceptionSender) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullExceptionSender"));
         return nullptr;
+    } else if (mediaPlayer == nextMediaPlayer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nextMediaPlayerNotDistinct"));
+        return nullptr;
     }
 
-    auto audioPlayer = std::shared_ptr<AudioPlayer>(
-        new AudioPlayer(mediaPlayer, messageSender, focusManager, contextManager, attachmentManager, exceptionSender));
+    auto audioPlayer = std::shared_ptr<AudioPlayer>(new AudioPlayer(
+        mediaPlayer, messageSender, focusManager, contextManager, attachmentManager, exceptionSender, nextMediaPlayer));
     mediaPlayer->setObserver(audioPlayer);
     contextManager->setStateProvider(STATE, audioPlayer);
     return audioPlayer;
@@ -131,6 +168,40 @@ void AudioPlayer::handleDirectiveImmediately(std::shared_ptr<AVSDirective> direc
 
 void AudioPlayer::preHandleDirective(std::shared_ptr<DirectiveInfo> info) {
     // TODO: Move as much processing up here as possilble (ACSDK415).
+    if (!m_isPrefetchEnabled || !info || !info->directive || info->directive->getName() != PLAY.name) {
+        return;
+    }
+
+    // Malformed payloads are left for handlePlayDirective() to report.
+    const rapidjson::Value* payload = info->directive->getPayloadValue();
+    if (!payload) {
+        return;
+    }
+    PlayBehavior playBehavior;
+    if (!jsonUtils::retrieveValue(*payload, "playBehavior", &playBehavior)) {
+        playBehavior = PlayBehavior::ENQUEUE;
+    }
+    if (PlayBehavior::REPLACE_ENQUEUED == playBehavior) {
+        // The item goes behind the one playing, which preloadNextItem() already handles.
+        return;
+    }
+    rapidjson::Value::ConstMemberIterator audioItemJson;
+    rapidjson::Value::ConstMemberIterator stream;
+    std::string url;
+    if (!jsonUtils::findNode(*payload, "audioItem", &audioItemJson) ||
+        !jsonUtils::findNode(audioItemJson->value, "stream", &stream) ||
+        !jsonUtils::retrieveValue(stream->value, "url", &url) || url.compare(0, CID_PREFIX.size(), CID_PREFIX) == 0) {
+        // Attachments arrive with the directive, so there is nothing to connect to ahead of time.
+        return;
+    }
+    int64_t milliseconds = 0;
+    jsonUtils::retrieveValue(stream->value, "offsetInMilliseconds", &milliseconds);
+    std::chrono::milliseconds offset(milliseconds);
+
+    auto messageId = info->directive->getMessageId();
+    m_executor.submit([this, messageId, playBehavior, url, offset] {
+        executePrefetch(messageId, playBehavior, url, offset);
+    });
 }
 
 void AudioPlayer::handleDirective(std::shared_ptr<DirectiveInfo> info) {
@@ -159,15 +230,27 @@ void AudioPlayer::handleDirective(std::shared_ptr<DirectiveInfo> info) {
 }
 
 void AudioPlayer::cancelDirective(std::shared_ptr<DirectiveInfo> info) {
+    if (info && info->directive) {
+        auto messageId = info->directive->getMessageId();
+        m_executor.submit([this, messageId] {
+            if (messageId == m_prefetchMessageId) {
+                cancelPrefetch();
+            }
+        });
+    }
     removeDirective(info);
 }
 
 void AudioPlayer::onDeregistered() {
     executeStop();
-    m_audioItems.clear();
+    clearQueue();
 }
 
 DirectiveHandlerConfiguration AudioPlayer::getConfiguration() const {
+    return getDefaultConfiguration();
+}
+
+DirectiveHandlerConfiguration AudioPlayer::getDefaultConfiguration() {
     DirectiveHandlerConfiguration configuration;
     configuration[PLAY] = BlockingPolicy::NON_BLOCKING;
     configuration[STOP] = BlockingPolicy::NON_BLOCKING;
@@ -175,6 +258,21 @@ DirectiveHandlerConfiguration AudioPlayer::getConfiguration() const {
     return configuration;
 }
 
+std::unordered_map<NamespaceAndName, std::string> AudioPlayer::getIdleStates() {
+    rapidjson::Document state(rapidjson::kObjectType);
+    state.AddMember(TOKEN_KEY, "", state.GetAllocator());
+    state.AddMember(OFFSET_KEY, 0, state.GetAllocator());
+    state.AddMember(ACTIVITY_KEY, playerActivityToString(PlayerActivity::IDLE), state.GetAllocator());
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    if (!state.Accept(writer)) {
+        ACSDK_ERROR(LX("getIdleStatesFailed").d("reason", "writerRefusedJsonObject"));
+        return {};
+    }
+    return {{STATE, buffer.GetString()}};
+}
+
 void AudioPlayer::onFocusChanged(FocusState newFocus) {
     ACSDK_DEBUG9(LX("onFocusChanged").d("newFocus", newFocus));
     auto result = m_executor.submit([this, newFocus] { executeOnFocusChanged(newFocus); });
@@ -240,10 +338,12 @@ AudioPlayer::AudioPlayer(
     std::shared_ptr<FocusManagerInterface> focusManager,
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<AttachmentManagerInterface> attachmentManager,
-    std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender) :
+    std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
+    std::shared_ptr<MediaPlayerInterface> nextMediaPlayer) :
         CapabilityAgent{NAMESPACE, exceptionSender},
         RequiresShutdown{"AudioPlayer"},
         m_mediaPlayer{mediaPlayer},
+        m_nextMediaPlayer{nextMediaPlayer},
         m_messageSender{messageSender},
         m_focusManager{focusManager},
         m_contextManager{contextManager},
@@ -255,7 +355,32 @@ AudioPlayer::AudioPlayer(
         m_currentActivity{PlayerActivity::IDLE},
         m_starting{false},
         m_focus{FocusState::NONE},
+        m_isNextItemPreloaded{false},
+        m_isPrefetchEnabled{false},
+        m_isDuckingEnabled{false},
+        m_duckingVolume{FULL_VOLUME},
+        m_isDucked{false},
+        m_progressTimer{timing::TimerService::getInstance()},
+        m_progressReportDelay{std::chrono::milliseconds::max()},
+        m_progressReportInterval{std::chrono::milliseconds::max()},
+        m_nextProgressReportInterval{std::chrono::milliseconds::max()},
         m_offset{std::chrono::milliseconds{std::chrono::milliseconds::zero()}} {
+    int duckingVolumePercent = 0;
+    if (configuration::ConfigurationNode::getRoot()[CONFIG_KEY_AUDIO_PLAYER].getInt(
+            CONFIG_KEY_DUCKING_VOLUME_PERCENT, &duckingVolumePercent)) {
+        if (duckingVolumePercent < 0 || duckingVolumePercent > 100) {
+            ACSDK_ERROR(LX("duckingDisabled").d("reason", "volumeOutOfRange").d("percent", duckingVolumePercent));
+        } else {
+            m_isDuckingEnabled = true;
+            m_duckingVolume = duckingVolumePercent / 100.0;
+        }
+    }
+    configuration::ConfigurationNode::getRoot()[CONFIG_KEY_AUDIO_PLAYER].getBool(
+        CONFIG_KEY_PREFETCH_ON_PRE_HANDLE, &m_isPrefetchEnabled, false);
+    if (m_isPrefetchEnabled && !m_nextMediaPlayer) {
+        ACSDK_WARN(LX("prefetchDisabled").d("reason", "noNextMediaPlayer"));
+        m_isPrefetchEnabled = false;
+    }
 }
 
 void AudioPlayer::doShutdown() {
@@ -263,6 +388,9 @@ void AudioPlayer::doShutdown() {
     executeStop();
     m_mediaPlayer->setObserver(nullptr);
     m_mediaPlayer.reset();
+    cancelPreload();
+    cancelPrefetch();
+    m_nextMediaPlayer.reset();
     m_messageSender.reset();
     m_focusManager.reset();
     m_contextManager->setStateProvider(STATE, nullptr);
@@ -271,15 +399,14 @@ void AudioPlayer::doShutdown() {
     m_audioItems.clear();
 }
 
-bool AudioPlayer::parseDirectivePayload(std::shared_ptr<DirectiveInfo> info, rapidjson::Document* document) {
-    rapidjson::ParseResult result = document->Parse(info->directive->getPayload());
-    if (result) {
+bool AudioPlayer::parseDirectivePayload(std::shared_ptr<DirectiveInfo> info, const rapidjson::Value** payload) {
+    *payload = info->directive->getPayloadValue();
+    if (*payload) {
         return true;
     }
 
     ACSDK_ERROR(LX("parseDirectivePayloadFailed")
-                    .d("reason", rapidjson::GetParseError_En(result.Code()))
-                    .d("offset", result.Offset())
+                    .d("reason", "invalidPayload")
                     .d("messageId", info->directive->getMessageId()));
     m_executor.submit([this, info] {
         sendExceptionEncounteredAndReportFailed(
@@ -290,18 +417,18 @@ bool AudioPlayer::parseDirectivePayload(std::shared_ptr<DirectiveInfo> info, rap
 
 void AudioPlayer::handlePlayDirective(std::shared_ptr<DirectiveInfo> info) {
     ACSDK_DEBUG9(LX("handlePlayDirective"));
-    rapidjson::Document payload;
+    const rapidjson::Value* payload = nullptr;
     if (!parseDirectivePayload(info, &payload)) {
         return;
     }
 
     PlayBehavior playBehavior;
-    if (!jsonUtils::retrieveValue(payload, "playBehavior", &playBehavior)) {
+    if (!jsonUtils::retrieveValue(*payload, "playBehavior", &playBehavior)) {
         playBehavior = PlayBehavior::ENQUEUE;
     }
 
     rapidjson::Value::ConstMemberIterator audioItemJson;
-    if (!jsonUtils::findNode(payload, "audioItem", &audioItemJson)) {
+    if (!jsonUtils::findNode(*payload, "audioItem", &audioItemJson)) {
         ACSDK_ERROR(LX("handlePlayDirectiveFailed")
                         .d("reason", "missingAudioItem")
                         .d("messageId", info->directive->getMessageId()));
@@ -405,8 +532,9 @@ void AudioPlayer::handlePlayDirective(std::shared_ptr<DirectiveInfo> info) {
         audioItem.stream.expectedPreviousToken = "";
     }
 
-    m_executor.submit([this, info, playBehavior, audioItem] {
-        executePlay(playBehavior, audioItem);
+    auto messageId = info->directive->getMessageId();
+    m_executor.submit([this, info, playBehavior, audioItem, messageId]() mutable {
+        executePlay(playBehavior, std::move(audioItem), messageId);
 
         // Note: Unlike SpeechSynthesizer, AudioPlayer directives are instructing the client to start/stop/queue
         //     content, so directive handling is considered to be complete when we have queued the content for
@@ -425,13 +553,13 @@ void AudioPlayer::handleStopDirective(std::shared_ptr<DirectiveInfo> info) {
 
 void AudioPlayer::handleClearQueueDirective(std::shared_ptr<DirectiveInfo> info) {
     ACSDK_DEBUG9(LX("handleClearQueue"));
-    rapidjson::Document payload;
+    const rapidjson::Value* payload = nullptr;
     if (!parseDirectivePayload(info, &payload)) {
         return;
     }
 
     ClearBehavior clearBehavior;
-    if (!jsonUtils::retrieveValue(payload, "clearBehavior", &clearBehavior)) {
+    if (!jsonUtils::retrieveValue(*payload, "clearBehavior", &clearBehavior)) {
         clearBehavior = ClearBehavior::CLEAR_ENQUEUED;
     }
 
@@ -493,6 +621,10 @@ void AudioPlayer::executeOnFocusChanged(FocusState newFocus) {
 
     switch (newFocus) {
         case FocusState::FOREGROUND:
+            if (m_isDucked) {
+                ACSDK_DEBUG9(LX("executeOnFocusChanged").d("action", "unduckMediaPlayer"));
+                unduck();
+            }
             if (m_starting) {
                 std::unique_lock<std::mutex> lock(m_playbackMutex);
                 m_playbackStarted = false;
@@ -524,6 +656,10 @@ void AudioPlayer::executeOnFocusChanged(FocusState newFocus) {
             break;
         case FocusState::BACKGROUND:
             if (PlayerActivity::PLAYING == m_currentActivity) {
+                if (m_isDuckingEnabled && duck()) {
+                    // Keep playing, under the channel which took the foreground.
+                    break;
+                }
                 std::unique_lock<std::mutex> lock(m_playbackMutex);
                 m_playbackPaused = false;
                 ACSDK_DEBUG9(LX("executeOnFocusChanged").d("action", "pauseMediaPlayer"));
@@ -556,7 +692,7 @@ void AudioPlayer::executeOnFocusChanged(FocusState newFocus) {
                     break;
             }
 
-            m_audioItems.clear();
+            clearQueue();
 
             std::unique_lock<std::mutex> lock(m_playbackMutex);
             m_playbackFinished = false;
@@ -584,6 +720,10 @@ void AudioPlayer::executeOnPlaybackStarted() {
 
     // TODO: Once MediaPlayer can notify of nearly finished, send there instead (ACSDK-417).
     sendPlaybackNearlyFinishedEvent();
+
+    scheduleProgressReports();
+
+    preloadNextItem();
 }
 
 void AudioPlayer::executeOnPlaybackFinished() {
@@ -615,6 +755,7 @@ void AudioPlayer::executeOnPlaybackPaused() {
     // TODO: AVS recommends sending this after a recognize event to reduce latency (ACSDK-371).
     sendPlaybackPausedEvent();
     changeActivity(PlayerActivity::PAUSED);
+    m_progressTimer.stop();
 }
 
 void AudioPlayer::executeOnPlaybackResumed() {
@@ -626,6 +767,7 @@ void AudioPlayer::executeOnPlaybackResumed() {
 
     sendPlaybackResumedEvent();
     changeActivity(PlayerActivity::PLAYING);
+    scheduleProgressReports();
 }
 
 void AudioPlayer::executeOnBufferUnderrun() {
@@ -637,15 +779,17 @@ void AudioPlayer::executeOnBufferUnderrun() {
     m_bufferUnderrunTimestamp = std::chrono::steady_clock::now();
     sendPlaybackStutterStartedEvent();
     changeActivity(PlayerActivity::BUFFER_UNDERRUN);
+    m_progressTimer.stop();
 }
 
 void AudioPlayer::executeOnBufferRefilled() {
     ACSDK_DEBUG9(LX("executeOnBufferRefilled"));
     sendPlaybackStutterFinishedEvent();
     changeActivity(PlayerActivity::PLAYING);
+    scheduleProgressReports();
 }
 
-void AudioPlayer::executePlay(PlayBehavior playBehavior, const AudioItem& audioItem) {
+void AudioPlayer::executePlay(PlayBehavior playBehavior, AudioItem audioItem, const std::string& messageId) {
     ACSDK_DEBUG9(LX("executePlay").d("playBehavior", playBehavior));
 
     switch (playBehavior) {
@@ -653,7 +797,7 @@ void AudioPlayer::executePlay(PlayBehavior playBehavior, const AudioItem& audioI
             executeStop(false);
         // FALL-THROUGH
         case PlayBehavior::REPLACE_ENQUEUED:
-            m_audioItems.clear();
+            clearQueue();
         // FALL-THROUGH
         case PlayBehavior::ENQUEUE:
             // Per AVS docs, drop/ignore AudioItems that specify an expectedPreviousToken which does not match the
@@ -665,19 +809,36 @@ void AudioPlayer::executePlay(PlayBehavior playBehavior, const AudioItem& audioI
                                    .d("reason", "unexpectedPreviousToken")
                                    .d("previous", previousToken)
                                    .d("expected", audioItem.stream.expectedPreviousToken));
+                    if (messageId == m_prefetchMessageId) {
+                        cancelPrefetch();
+                    }
                     return;
                 }
             }
-            m_audioItems.push_back(audioItem);
+            m_audioItems.push_back(std::move(audioItem));
             break;
     }
 
+    if (!messageId.empty() && messageId == m_prefetchMessageId) {
+        if (1 == m_audioItems.size() && !m_isNextItemPreloaded) {
+            // The item is next, and its source is already set up, so it plays the way a preloaded item does.
+            ACSDK_DEBUG9(LX("executePlay").d("prefetch", "used"));
+            m_prefetchMessageId.clear();
+            m_isNextItemPreloaded = true;
+        } else {
+            cancelPrefetch();
+        }
+    }
+
     if (m_audioItems.empty()) {
         ACSDK_ERROR(LX("executePlayFailed").d("reason", "unhandledPlayBehavior").d("playBehavior", playBehavior));
         return;
     }
 
     if (m_starting || PlayerActivity::PLAYING == m_currentActivity) {
+        if (PlayerActivity::PLAYING == m_currentActivity) {
+            preloadNextItem();
+        }
         return;
     }
 
@@ -704,11 +865,22 @@ void AudioPlayer::playNextItem() {
         return;
     }
 
-    auto item = m_audioItems.front();
+    auto item = std::move(m_audioItems.front());
     m_audioItems.pop_front();
     m_token = item.stream.token;
 
-    if (item.stream.reader) {
+    bool wasPreloaded = m_isNextItemPreloaded;
+    if (wasPreloaded) {
+        // The item is already set up on the other player, so swap the players' roles and start it directly.
+        m_isNextItemPreloaded = false;
+        m_mediaPlayer->setObserver(nullptr);
+        std::swap(m_mediaPlayer, m_nextMediaPlayer);
+        m_mediaPlayer->setObserver(shared_from_this());
+        if (m_isDucked) {
+            m_nextMediaPlayer->setVolume(FULL_VOLUME);
+            m_mediaPlayer->setVolume(m_duckingVolume);
+        }
+    } else if (item.stream.reader) {
         if (m_mediaPlayer->setSource(std::move(item.stream.reader)) == MediaPlayerStatus::FAILURE) {
             sendPlaybackFailedEvent(
                 m_token, ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, "failed to set attachment media source");
@@ -723,7 +895,8 @@ void AudioPlayer::playNextItem() {
     }
 
     ACSDK_DEBUG9(LX("playNextItem").d("item.stream.offset", item.stream.offset.count()));
-    if (item.stream.offset.count() && m_mediaPlayer->setOffset(item.stream.offset) == MediaPlayerStatus::FAILURE) {
+    if (!wasPreloaded && item.stream.offset.count() &&
+        m_mediaPlayer->setOffset(item.stream.offset) == MediaPlayerStatus::FAILURE) {
         sendPlaybackFailedEvent(m_token, ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, "failed to set stream offset");
         ACSDK_ERROR(LX("playNextItemFailed").d("reason", "setOffsetFailed"));
         return;
@@ -733,18 +906,161 @@ void AudioPlayer::playNextItem() {
         executeOnPlaybackError(ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, "playFailed");
         return;
     }
-    if (std::chrono::milliseconds::max() != item.stream.progressReport.delay) {
-        m_delayTimer.start(item.stream.progressReport.delay - item.stream.offset, [this] {
-            m_executor.submit([this] { sendProgressReportDelayElapsedEvent(); });
-        });
+
+    // The progress reports are scheduled from the offset in the stream once playback has started.
+    m_progressTimer.stop();
+    m_progressReportDelay = item.stream.progressReport.delay > item.stream.offset
+                                ? item.stream.progressReport.delay
+                                : std::chrono::milliseconds::max();
+    m_progressReportInterval = item.stream.progressReport.interval;
+    m_nextProgressReportInterval = std::chrono::milliseconds::max();
+    if (std::chrono::milliseconds::max() != m_progressReportInterval &&
+        m_progressReportInterval > std::chrono::milliseconds::zero()) {
+        m_nextProgressReportInterval = (item.stream.offset / m_progressReportInterval + 1) * m_progressReportInterval;
+    }
+}
+
+void AudioPlayer::scheduleProgressReports() {
+    m_progressTimer.stop();
+    if (PlayerActivity::PLAYING != m_currentActivity) {
+        return;
     }
-    if (std::chrono::milliseconds::max() != item.stream.progressReport.interval) {
-        m_intervalTimer.start(
-            item.stream.progressReport.interval - item.stream.offset,
-            item.stream.progressReport.interval,
-            timing::Timer::PeriodType::ABSOLUTE,
-            timing::Timer::FOREVER,
-            [this] { m_executor.submit([this] { sendProgressReportIntervalElapsedEvent(); }); });
+
+    auto offset = getOffset();
+    if (offset >= m_progressReportDelay) {
+        sendProgressReportDelayElapsedEvent();
+        m_progressReportDelay = std::chrono::milliseconds::max();
+    }
+    if (offset >= m_nextProgressReportInterval) {
+        sendProgressReportIntervalElapsedEvent();
+        m_nextProgressReportInterval = (offset / m_progressReportInterval + 1) * m_progressReportInterval;
+    }
+
+    auto nextReport = std::min(m_progressReportDelay, m_nextProgressReportInterval);
+    if (std::chrono::milliseconds::max() == nextReport) {
+        return;
+    }
+    m_progressTimer.start(nextReport - offset, [this] { m_executor.submit([this] { scheduleProgressReports(); }); });
+}
+
+void AudioPlayer::preloadNextItem() {
+    if (!m_nextMediaPlayer || m_isNextItemPreloaded || m_audioItems.empty()) {
+        return;
+    }
+    // An item which is already queued takes the second player over from one which might still be cancelled.
+    cancelPrefetch();
+
+    // The reader is shared rather than moved, since the item stays in the queue until it is played.  Tearing the
+    // preload down closes it, so dropPreloadedAttachment() then drops the item too.
+    auto& item = m_audioItems.front();
+    ACSDK_DEBUG9(LX("preloadNextItem").d("token", item.stream.token));
+    auto status = item.stream.reader ? m_nextMediaPlayer->setSource(item.stream.reader)
+                                     : m_nextMediaPlayer->setSource(item.stream.url);
+    if (MediaPlayerStatus::FAILURE == status) {
+        // Not fatal for a URL; playNextItem() will set the source up on m_mediaPlayer as usual.
+        ACSDK_WARN(LX("preloadNextItemFailed").d("reason", "setSourceFailed"));
+        dropPreloadedAttachment("failed to set attachment media source");
+        return;
+    }
+    if (item.stream.offset.count() &&
+        m_nextMediaPlayer->setOffset(item.stream.offset) == MediaPlayerStatus::FAILURE) {
+        ACSDK_WARN(LX("preloadNextItemFailed").d("reason", "setOffsetFailed"));
+        m_nextMediaPlayer->stop();
+        dropPreloadedAttachment("failed to set stream offset");
+        return;
+    }
+    m_isNextItemPreloaded = true;
+}
+
+void AudioPlayer::cancelPreload() {
+    if (!m_isNextItemPreloaded) {
+        return;
+    }
+    ACSDK_DEBUG9(LX("cancelPreload"));
+    m_isNextItemPreloaded = false;
+    m_nextMediaPlayer->stop();
+    dropPreloadedAttachment("");
+}
+
+void AudioPlayer::dropPreloadedAttachment(const std::string& error) {
+    if (m_audioItems.empty() || !m_audioItems.front().stream.reader) {
+        return;
+    }
+    auto token = m_audioItems.front().stream.token;
+    m_audioItems.pop_front();
+    ACSDK_WARN(LX("dropPreloadedAttachment").d("token", token).d("reason", "readerClosed"));
+    if (!error.empty()) {
+        // The same failure playNextItem() would have reported, had it set the item up itself.
+        sendPlaybackFailedEvent(token, ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, error);
+    }
+}
+
+void AudioPlayer::executePrefetch(
+    const std::string& messageId,
+    PlayBehavior playBehavior,
+    const std::string& url,
+    std::chrono::milliseconds offset) {
+    if (!m_nextMediaPlayer || m_isNextItemPreloaded || !m_prefetchMessageId.empty()) {
+        return;
+    }
+    if (PlayBehavior::ENQUEUE == playBehavior && !m_audioItems.empty()) {
+        // Other items play first, and the next of them is preloaded instead.
+        return;
+    }
+
+    ACSDK_DEBUG9(LX("executePrefetch").d("messageId", messageId).d("playBehavior", playBehavior));
+    if (m_nextMediaPlayer->setSource(url) == MediaPlayerStatus::FAILURE) {
+        // Not fatal; the source is set up again when the directive is handled.
+        ACSDK_WARN(LX("executePrefetchFailed").d("reason", "setSourceFailed"));
+        return;
+    }
+    if (offset.count() && m_nextMediaPlayer->setOffset(offset) == MediaPlayerStatus::FAILURE) {
+        ACSDK_WARN(LX("executePrefetchFailed").d("reason", "setOffsetFailed"));
+        m_nextMediaPlayer->stop();
+        return;
+    }
+    m_prefetchMessageId = messageId;
+}
+
+void AudioPlayer::cancelPrefetch() {
+    if (m_prefetchMessageId.empty()) {
+        return;
+    }
+    ACSDK_DEBUG9(LX("cancelPrefetch").d("messageId", m_prefetchMessageId));
+    m_prefetchMessageId.clear();
+    m_nextMediaPlayer->stop();
+}
+
+void AudioPlayer::clearQueue() {
+    cancelPreload();
+    if (m_audioItems.empty()) {
+        return;
+    }
+
+    std::deque<AudioItem> droppedItems;
+    std::swap(droppedItems, m_audioItems);
+    for (auto& item : droppedItems) {
+        if (item.stream.reader) {
+            item.stream.reader->close();
+        }
+    }
+    ACSDK_DEBUG9(LX("clearQueue").d("dropped", droppedItems.size()));
+}
+
+bool AudioPlayer::duck() {
+    ACSDK_DEBUG9(LX("executeOnFocusChanged").d("action", "duckMediaPlayer").d("volume", m_duckingVolume));
+    if (m_mediaPlayer->setVolume(m_duckingVolume) == MediaPlayerStatus::FAILURE) {
+        ACSDK_WARN(LX("duckFailed").d("reason", "setVolumeFailed").d("fallback", "pause"));
+        return false;
+    }
+    m_isDucked = true;
+    return true;
+}
+
+void AudioPlayer::unduck() {
+    m_isDucked = false;
+    if (m_mediaPlayer->setVolume(FULL_VOLUME) == MediaPlayerStatus::FAILURE) {
+        ACSDK_ERROR(LX("unduckFailed").d("reason", "setVolumeFailed"));
     }
 }
 
@@ -771,8 +1087,10 @@ void AudioPlayer::executeStop(bool releaseFocus) {
     }
 
     m_starting = false;
-    m_delayTimer.stop();
-    m_intervalTimer.stop();
+    m_progressTimer.stop();
+    if (m_isDucked) {
+        unduck();
+    }
     if (releaseFocus && m_focus != avsCommon::avs::FocusState::NONE) {
         m_focusManager->releaseChannel(CHANNEL_NAME, shared_from_this());
     }
@@ -789,7 +1107,7 @@ void AudioPlayer::executeClearQueue(ClearBehavior clearBehavior) {
             executeStop();
         // FALL-THROUGH
         case ClearBehavior::CLEAR_ENQUEUED:
-            m_audioItems.clear();
+            clearQueue();
             break;
     }
     sendPlaybackQueueClearedEvent();
@@ -820,7 +1138,7 @@ void AudioPlayer::sendExceptionEncounteredAndReportFailed(
     removeDirective(info);
 }
 
-void AudioPlayer::sendEventWithTokenAndOffset(const std::string& eventName) {
+void AudioPlayer::sendEventWithTokenAndOffset(const EventTemplate& eventTemplate, MessageRequest::Priority priority) {
     rapidjson::Document payload(rapidjson::kObjectType);
     payload.AddMember(TOKEN_KEY, m_token, payload.GetAllocator());
     payload.AddMember(
@@ -833,29 +1151,29 @@ void AudioPlayer::sendEventWithTokenAndOffset(const std::string& eventName) {
         return;
     }
 
-    auto event = buildJsonEventString(eventName, "", buffer.GetString());
-    auto request = std::make_shared<MessageRequest>(event.second);
+    auto event = eventTemplate.build("", buffer.GetString());
+    auto request = std::make_shared<MessageRequest>(std::move(event.second), nullptr, priority);
     m_messageSender->sendMessage(request);
 }
 
 void AudioPlayer::sendPlaybackStartedEvent() {
-    sendEventWithTokenAndOffset("PlaybackStarted");
+    sendEventWithTokenAndOffset(PLAYBACK_STARTED);
 }
 
 void AudioPlayer::sendPlaybackNearlyFinishedEvent() {
-    sendEventWithTokenAndOffset("PlaybackNearlyFinished");
+    sendEventWithTokenAndOffset(PLAYBACK_NEARLY_FINISHED);
 }
 
 void AudioPlayer::sendProgressReportDelayElapsedEvent() {
-    sendEventWithTokenAndOffset("ProgressReportDelayElapsed");
+    sendEventWithTokenAndOffset(PROGRESS_REPORT_DELAY_ELAPSED, MessageRequest::Priority::LOW);
 }
 
 void AudioPlayer::sendProgressReportIntervalElapsedEvent() {
-    sendEventWithTokenAndOffset("ProgressReportIntervalElapsed");
+    sendEventWithTokenAndOffset(PROGRESS_REPORT_INTERVAL_ELAPSED, MessageRequest::Priority::LOW);
 }
 
 void AudioPlayer::sendPlaybackStutterStartedEvent() {
-    sendEventWithTokenAndOffset("PlaybackStutterStarted");
+    sendEventWithTokenAndOffset(PLAYBACK_STUTTER_STARTED);
 }
 
 void AudioPlayer::sendPlaybackStutterFinishedEvent() {
@@ -877,12 +1195,12 @@ void AudioPlayer::sendPlaybackStutterFinishedEvent() {
     }
 
     auto event = buildJsonEventString("PlaybackStutterFinished", "", buffer.GetString());
-    auto request = std::make_shared<MessageRequest>(event.second);
+    auto request = std::make_shared<MessageRequest>(std::move(event.second));
     m_messageSender->sendMessage(request);
 }
 
 void AudioPlayer::sendPlaybackFinishedEvent() {
-    sendEventWithTokenAndOffset("PlaybackFinished");
+    sendEventWithTokenAndOffset(PLAYBACK_FINISHED);
 }
 
 void AudioPlayer::sendPlaybackFailedEvent(
@@ -914,25 +1232,25 @@ void AudioPlayer::sendPlaybackFailedEvent(
     }
 
     auto event = buildJsonEventString("PlaybackFailed", "", buffer.GetString());
-    auto request = std::make_shared<MessageRequest>(event.second);
+    auto request = std::make_shared<MessageRequest>(std::move(event.second));
     m_messageSender->sendMessage(request);
 }
 
 void AudioPlayer::sendPlaybackStoppedEvent() {
-    sendEventWithTokenAndOffset("PlaybackStopped");
+    sendEventWithTokenAndOffset(PLAYBACK_STOPPED);
 }
 
 void AudioPlayer::sendPlaybackPausedEvent() {
-    sendEventWithTokenAndOffset("PlaybackPaused");
+    sendEventWithTokenAndOffset(PLAYBACK_PAUSED);
 }
 
 void AudioPlayer::sendPlaybackResumedEvent() {
-    sendEventWithTokenAndOffset("PlaybackResumed");
+    sendEventWithTokenAndOffset(PLAYBACK_RESUMED);
 }
 
 void AudioPlayer::sendPlaybackQueueClearedEvent() {
     auto event = buildJsonEventString("PlaybackQueueCleared");
-    auto request = std::make_shared<MessageRequest>(event.second);
+    auto request = std::make_shared<MessageRequest>(std::move(event.second));
     m_messageSender->sendMessage(request);
 }
 
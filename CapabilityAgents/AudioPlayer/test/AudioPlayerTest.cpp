@@ -21,6 +21,7 @@
 #include <future>
 #include <memory>
 #include <map>
+#include <sstream>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -30,6 +31,7 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/SDKInterfaces/MockExceptionEncounteredSender.h>
 #include <AVSCommon/AVS/Attachment/AttachmentManagerInterface.h>
@@ -112,9 +114,15 @@ static const std::string FORMAT_TEST("AUDIO_MPEG");
 /// URL for testing.
 static const std::string URL_TEST("cid:Test");
 
+/// A URL which is not an attachment, for testing.
+static const std::string HTTP_URL_TEST("https://example.com/test.mp3");
+
 /// ENQUEUE playBehavior.
 static const std::string NAME_ENQUEUE("ENQUEUE");
 
+/// REPLACE_ALL playBehavior.
+static const std::string NAME_REPLACE_ALL("REPLACE_ALL");
+
 /// CLEAR_ALL clearBehavior.
 static const std::string NAME_CLEAR_ALL("CLEAR_ALL");
 
@@ -165,6 +173,32 @@ static const std::string ENQUEUE_PAYLOAD_TEST =
         "}";
 // clang-format on
 
+/// A REPLACE_ALL payload with a URL which is not an attachment, for testing.
+// clang-format off
+static const std::string REPLACE_ALL_URL_PAYLOAD_TEST =
+        "{"
+            "\"playBehavior\":\"" + NAME_REPLACE_ALL + "\","
+            "\"audioItem\": {"
+                "\"audioItemId\":\"" + AUDIO_ITEM_ID + "\","
+                "\"stream\": {"
+                    "\"url\":\"" + HTTP_URL_TEST + "\","
+                    "\"streamFormat\":\"" + FORMAT_TEST + "\","
+                    "\"offsetInMilliseconds\":" + std::to_string(OFFSET_IN_MILLISECONDS_TEST) + ","
+                    "\"token\":\"" + TOKEN_TEST + "\""
+                "}"
+            "}"
+        "}";
+// clang-format on
+
+/// A configuration which prefetches URL items while their directives wait to be handled.
+static const std::string PREFETCH_CONFIG_TEST = "{\"audioPlayer\":{\"prefetchOnPreHandle\":true}}";
+
+/// A configuration which ducks to 25% volume in the background.
+static const std::string DUCKING_CONFIG_TEST = "{\"audioPlayer\":{\"duckingVolumePercent\":25}}";
+
+/// The volume which @c DUCKING_CONFIG_TEST ducks to.
+static const double DUCKING_VOLUME_TEST = 0.25;
+
 /// Empty payload for testing.
 static const std::string EMPTY_PAYLOAD_TEST = "{}";
 
@@ -291,6 +325,7 @@ public:
     MOCK_METHOD0(getOffset, std::chrono::milliseconds());
     MOCK_METHOD0(getOffsetInMilliseconds, int64_t());
     MOCK_METHOD1(setOffset, MediaPlayerStatus(std::chrono::milliseconds offset));
+    MOCK_METHOD1(setVolume, MediaPlayerStatus(double volume));
 
     /**
      * This is a mock method which will signal to @c waitForPlay to send the play started notification to the observer.
@@ -466,6 +501,7 @@ std::shared_ptr<NiceMock<MockMediaPlayer>> MockMediaPlayer::create() {
     ON_CALL(*result.get(), stop()).WillByDefault(Invoke(result.get(), &MockMediaPlayer::mockStop));
     ON_CALL(*result.get(), pause()).WillByDefault(Invoke(result.get(), &MockMediaPlayer::mockPause));
     ON_CALL(*result.get(), resume()).WillByDefault(Invoke(result.get(), &MockMediaPlayer::mockResume));
+    ON_CALL(*result.get(), setVolume(_)).WillByDefault(Return(MediaPlayerStatus::FAILURE));
     return result;
 }
 
@@ -1258,6 +1294,80 @@ TEST_F(AudioPlayerTest, testOnBufferRefilled) {
     ASSERT_TRUE(result);
 }
 
+/**
+ * Test that the progress reports are sent once the offset reported by the @c MediaPlayer reaches them.
+ */
+
+TEST_F(AudioPlayerTest, testProgressReportsSentAtMediaOffset) {
+    m_expectedMessages.insert({PROGRESS_REPORT_DELAY_ELAPSED_NAME, false});
+    m_expectedMessages.insert({PROGRESS_REPORT_INTERVAL_ELAPSED_NAME, false});
+
+    ON_CALL(*(m_mockMediaPlayer.get()), getOffset())
+        .WillByDefault(Return(std::chrono::milliseconds(PROGRESS_REPORT_DELAY)));
+
+    EXPECT_CALL(*(m_mockMessageSender.get()), sendMessage(_))
+        .Times(AtLeast(1))
+        .WillRepeatedly(Invoke([this](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            if (!m_mockMediaPlayer->m_stop) {
+                std::lock_guard<std::mutex> lock(messageMutex);
+                verifyMessage(request, &m_expectedMessages);
+                messageSentTrigger.notify_one();
+            }
+        }));
+
+    sendPlayDirective();
+
+    std::unique_lock<std::mutex> lock(messageMutex);
+
+    bool result;
+
+    result = messageSentTrigger.wait_for(lock, WAIT_TIMEOUT, [this] {
+        for (auto messageStatus : m_expectedMessages) {
+            if (!messageStatus.second) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    ASSERT_TRUE(result);
+}
+
+/**
+ * Test that no progress report is sent while the offset reported by the @c MediaPlayer does not reach it, however
+ * long playback lasts.
+ */
+
+TEST_F(AudioPlayerTest, testProgressReportsNotSentBeforeMediaOffset) {
+    m_expectedMessages.insert({PLAYBACK_STARTED_NAME, false});
+    m_expectedMessages.insert({PROGRESS_REPORT_DELAY_ELAPSED_NAME, false});
+    m_expectedMessages.insert({PROGRESS_REPORT_INTERVAL_ELAPSED_NAME, false});
+
+    ON_CALL(*(m_mockMediaPlayer.get()), getOffset())
+        .WillByDefault(Return(std::chrono::milliseconds(OFFSET_IN_MILLISECONDS_TEST)));
+
+    EXPECT_CALL(*(m_mockMessageSender.get()), sendMessage(_))
+        .Times(AtLeast(1))
+        .WillRepeatedly(Invoke([this](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            if (!m_mockMediaPlayer->m_stop) {
+                std::lock_guard<std::mutex> lock(messageMutex);
+                verifyMessage(request, &m_expectedMessages);
+                messageSentTrigger.notify_one();
+            }
+        }));
+
+    sendPlayDirective();
+
+    std::unique_lock<std::mutex> lock(messageMutex);
+    ASSERT_TRUE(messageSentTrigger.wait_for(
+        lock, WAIT_TIMEOUT, [this] { return m_expectedMessages[PLAYBACK_STARTED_NAME]; }));
+
+    ASSERT_FALSE(messageSentTrigger.wait_for(lock, std::chrono::milliseconds(PROGRESS_REPORT_DELAY * 3), [this] {
+        return m_expectedMessages[PROGRESS_REPORT_DELAY_ELAPSED_NAME] ||
+               m_expectedMessages[PROGRESS_REPORT_INTERVAL_ELAPSED_NAME];
+    }));
+}
+
 /**
  * Test @c cancelDirective
  * Expect the @c handleDirective call to the cancelled directive returns false
@@ -1271,6 +1381,225 @@ TEST_F(AudioPlayerTest, testCancelDirective) {
     ASSERT_FALSE(m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST));
 }
 
+/**
+ * Test that with a ducking volume configured, losing the foreground lowers the volume instead of pausing, and
+ * regaining it restores the volume.
+ */
+
+TEST_F(AudioPlayerTest, testDuckedInsteadOfPausedInBackground) {
+    std::stringstream config(DUCKING_CONFIG_TEST);
+    ASSERT_TRUE(configuration::ConfigurationNode::initialize({&config}));
+    m_audioPlayer->shutdown();
+    m_audioPlayer = AudioPlayer::create(
+        m_mockMediaPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender);
+    configuration::ConfigurationNode::uninitialize();
+    ASSERT_TRUE(m_audioPlayer);
+
+    sendPlayDirective();
+    ASSERT_TRUE(m_mockMediaPlayer->waitUntilPlaybackStarted());
+
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), pause()).Times(0);
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), setVolume(DUCKING_VOLUME_TEST))
+        .WillOnce(Return(MediaPlayerStatus::SUCCESS));
+    m_audioPlayer->onFocusChanged(FocusState::BACKGROUND);
+
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), setVolume(1.0)).WillOnce(Return(MediaPlayerStatus::SUCCESS));
+    m_audioPlayer->onFocusChanged(FocusState::FOREGROUND);
+}
+
+/**
+ * Test that an enqueued item is loaded on the second media player while the first one plays, and that the second
+ * player then plays it without its source being set up again.
+ */
+
+TEST_F(AudioPlayerTest, testNextItemPreloadedOnSecondMediaPlayer) {
+    m_audioPlayer->shutdown();
+    auto nextMediaPlayer = MockMediaPlayer::create();
+    m_audioPlayer = AudioPlayer::create(
+        m_mockMediaPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender,
+        nextMediaPlayer);
+    ASSERT_TRUE(m_audioPlayer);
+
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), setSource(Matcher<std::shared_ptr<AttachmentReader>>(_))).Times(1);
+    sendPlayDirective();
+    ASSERT_TRUE(m_mockMediaPlayer->waitUntilPlaybackStarted());
+
+    std::promise<void> preloadedPromise;
+    auto preloadedFuture = preloadedPromise.get_future();
+    EXPECT_CALL(*(nextMediaPlayer.get()), setSource(Matcher<std::shared_ptr<AttachmentReader>>(_)))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([&preloadedPromise] {
+            preloadedPromise.set_value();
+            return MediaPlayerStatus::SUCCESS;
+        }));
+    EXPECT_CALL(*(nextMediaPlayer.get()), play()).Times(1);
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST_2);
+    std::shared_ptr<AVSDirective> playDirective =
+        AVSDirective::create("", avsMessageHeader, ENQUEUE_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    m_audioPlayer->CapabilityAgent::preHandleDirective(
+        playDirective, std::unique_ptr<DirectiveHandlerResultInterface>(new MockDirectiveHandlerResult));
+    m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+    ASSERT_EQ(std::future_status::ready, preloadedFuture.wait_for(WAIT_TIMEOUT));
+
+    // The first item finishing starts the preloaded one on the second player.
+    m_audioPlayer->onPlaybackFinished();
+    ASSERT_TRUE(nextMediaPlayer->waitUntilPlaybackStarted());
+}
+
+/**
+ * Test that an enqueued attachment item whose preload fails to set the offset is dropped once the second media player
+ * has closed its reader, and that playing on reports it as failed instead of setting the closed reader up again.
+ */
+
+TEST_F(AudioPlayerTest, testAttachmentDroppedWhenPreloadOffsetFails) {
+    m_audioPlayer->shutdown();
+    auto nextMediaPlayer = MockMediaPlayer::create();
+    m_audioPlayer = AudioPlayer::create(
+        m_mockMediaPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender,
+        nextMediaPlayer);
+    ASSERT_TRUE(m_audioPlayer);
+
+    m_expectedMessages.insert({PLAYBACK_FAILED_NAME, false});
+    EXPECT_CALL(*(m_mockMessageSender.get()), sendMessage(_))
+        .WillRepeatedly(Invoke([this](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            std::lock_guard<std::mutex> lock(messageMutex);
+            verifyMessage(request, &m_expectedMessages);
+            messageSentTrigger.notify_one();
+        }));
+
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), setSource(Matcher<std::shared_ptr<AttachmentReader>>(_))).Times(1);
+    sendPlayDirective();
+    ASSERT_TRUE(m_mockMediaPlayer->waitUntilPlaybackStarted());
+
+    std::promise<void> offsetFailedPromise;
+    auto offsetFailedFuture = offsetFailedPromise.get_future();
+    EXPECT_CALL(*(nextMediaPlayer.get()), setSource(Matcher<std::shared_ptr<AttachmentReader>>(_)))
+        .WillOnce(Return(MediaPlayerStatus::SUCCESS));
+    EXPECT_CALL(*(nextMediaPlayer.get()), setOffset(std::chrono::milliseconds(OFFSET_IN_MILLISECONDS_TEST)))
+        .WillOnce(InvokeWithoutArgs([&offsetFailedPromise] {
+            offsetFailedPromise.set_value();
+            return MediaPlayerStatus::FAILURE;
+        }));
+    EXPECT_CALL(*(nextMediaPlayer.get()), play()).Times(0);
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST_2);
+    std::shared_ptr<AVSDirective> playDirective =
+        AVSDirective::create("", avsMessageHeader, ENQUEUE_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    m_audioPlayer->CapabilityAgent::preHandleDirective(
+        playDirective, std::unique_ptr<DirectiveHandlerResultInterface>(new MockDirectiveHandlerResult));
+    m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+    ASSERT_EQ(std::future_status::ready, offsetFailedFuture.wait_for(WAIT_TIMEOUT));
+    ASSERT_TRUE(nextMediaPlayer->waitUntilPlaybackFinished());
+
+    // The first item finishing would play the second; its reader is closed, so the queue must be empty instead.
+    EXPECT_CALL(*(m_mockFocusManager.get()), releaseChannel(CHANNEL_NAME, _))
+        .Times(AtLeast(1))
+        .WillRepeatedly(InvokeWithoutArgs(this, &AudioPlayerTest::wakeOnReleaseChannel));
+    m_audioPlayer->onPlaybackFinished();
+
+    std::unique_lock<std::mutex> lock(messageMutex);
+    EXPECT_TRUE(messageSentTrigger.wait_for(
+        lock, WAIT_TIMEOUT, [this] { return m_expectedMessages[PLAYBACK_FAILED_NAME]; }));
+}
+
+/**
+ * Test that with prefetching configured, the URL of a REPLACE_ALL item is set up on the second media player during
+ * pre-handling, and that the second player then plays it once focus is granted.
+ */
+
+TEST_F(AudioPlayerTest, testUrlPrefetchedOnPreHandle) {
+    std::stringstream config(PREFETCH_CONFIG_TEST);
+    ASSERT_TRUE(configuration::ConfigurationNode::initialize({&config}));
+    m_audioPlayer->shutdown();
+    auto nextMediaPlayer = MockMediaPlayer::create();
+    m_audioPlayer = AudioPlayer::create(
+        m_mockMediaPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender,
+        nextMediaPlayer);
+    configuration::ConfigurationNode::uninitialize();
+    ASSERT_TRUE(m_audioPlayer);
+
+    std::promise<void> prefetchedPromise;
+    auto prefetchedFuture = prefetchedPromise.get_future();
+    EXPECT_CALL(*(nextMediaPlayer.get()), setSource(HTTP_URL_TEST))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([&prefetchedPromise] {
+            prefetchedPromise.set_value();
+            return MediaPlayerStatus::SUCCESS;
+        }));
+    EXPECT_CALL(*(nextMediaPlayer.get()), setOffset(std::chrono::milliseconds(OFFSET_IN_MILLISECONDS_TEST)))
+        .WillOnce(Return(MediaPlayerStatus::SUCCESS));
+    EXPECT_CALL(*(nextMediaPlayer.get()), play()).Times(1);
+    EXPECT_CALL(*(m_mockMediaPlayer.get()), setSource(Matcher<const std::string&>(_))).Times(0);
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST);
+    std::shared_ptr<AVSDirective> playDirective =
+        AVSDirective::create("", avsMessageHeader, REPLACE_ALL_URL_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+    m_audioPlayer->CapabilityAgent::preHandleDirective(playDirective, std::move(m_mockDirectiveHandlerResult));
+    ASSERT_EQ(std::future_status::ready, prefetchedFuture.wait_for(WAIT_TIMEOUT));
+
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &AudioPlayerTest::wakeOnAcquireChannel));
+    m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST);
+    ASSERT_EQ(std::future_status::ready, m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_audioPlayer->onFocusChanged(FocusState::FOREGROUND);
+    ASSERT_TRUE(nextMediaPlayer->waitUntilPlaybackStarted());
+}
+
+/**
+ * Test that cancelling a directive whose URL was prefetched stops the second media player.
+ */
+
+TEST_F(AudioPlayerTest, testPrefetchCancelledWithDirective) {
+    std::stringstream config(PREFETCH_CONFIG_TEST);
+    ASSERT_TRUE(configuration::ConfigurationNode::initialize({&config}));
+    m_audioPlayer->shutdown();
+    auto nextMediaPlayer = MockMediaPlayer::create();
+    m_audioPlayer = AudioPlayer::create(
+        m_mockMediaPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender,
+        nextMediaPlayer);
+    configuration::ConfigurationNode::uninitialize();
+    ASSERT_TRUE(m_audioPlayer);
+
+    EXPECT_CALL(*(nextMediaPlayer.get()), setSource(HTTP_URL_TEST)).WillOnce(Return(MediaPlayerStatus::SUCCESS));
+    EXPECT_CALL(*(nextMediaPlayer.get()), setOffset(_)).WillOnce(Return(MediaPlayerStatus::SUCCESS));
+    EXPECT_CALL(*(nextMediaPlayer.get()), play()).Times(0);
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST);
+    std::shared_ptr<AVSDirective> playDirective =
+        AVSDirective::create("", avsMessageHeader, REPLACE_ALL_URL_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+    m_audioPlayer->CapabilityAgent::preHandleDirective(playDirective, std::move(m_mockDirectiveHandlerResult));
+
+    m_audioPlayer->CapabilityAgent::cancelDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(nextMediaPlayer->waitUntilPlaybackFinished());
+    ASSERT_FALSE(m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST));
+}
+
 }  // namespace test
 }  // namespace audioPlayer
 }  // namespace capabilityAgents
@@ -115,7 +115,8 @@ private:
      * Process the Button pressed.
      *
      * This function is intended to be called by the interfaces in @c PlaybackControllerInterface to signal a Button is
-     * pressed.
+     * pressed.  A 'Play' or 'Pause' pressed again while the previous press of it is still waiting for context is
+     * dropped, and all the buttons waiting when the context arrives are sent with that context.
      *
      * @param The @c Button pressed.
      */
@@ -44,7 +44,7 @@ public:
      */
     PlaybackMessageRequest(
         PlaybackController::Button button,
-        const std::string& jsonContent,
+        std::string jsonContent,
         std::shared_ptr<PlaybackController> playbackController);
 
     /// @name MessageRequest functions.
@@ -106,6 +106,25 @@ static std::ostream& operator<<(std::ostream& stream, const PlaybackController::
     return stream;
 }
 
+/**
+ * Whether pressing a @c Button again before the first press has been sent has no further effect, so that the presses
+ * can be sent as one event.  This holds for 'Play' and 'Pause', but each 'Next' or 'Previous' moves one more item.
+ *
+ * @param button The @c Button pressed.
+ * @return Whether repeated presses of @c button can be coalesced.
+ */
+static bool canCoalesce(PlaybackController::Button button) {
+    switch (button) {
+        case PlaybackController::Button::PLAY:
+        case PlaybackController::Button::PAUSE:
+            return true;
+        case PlaybackController::Button::NEXT:
+        case PlaybackController::Button::PREVIOUS:
+            return false;
+    }
+    return false;
+}
+
 std::shared_ptr<PlaybackController> PlaybackController::create(
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<MessageSenderInterface> messageSender) {
@@ -133,6 +152,9 @@ void PlaybackController::buttonPressed(Button button) {
         if (m_buttons.empty()) {
             ACSDK_DEBUG9(LX("buttonPressedExecutor").m("Queue is empty, call getContext()."));
             m_contextManager->getContext(shared_from_this());
+        } else if (m_buttons.back() == button && canCoalesce(button)) {
+            ACSDK_DEBUG9(LX("buttonPressedExecutor").d("reason", "coalesced").d("Button", button));
+            return;
         }
         m_buttons.push(button);
     };
@@ -179,17 +201,16 @@ void PlaybackController::onContextAvailable(const std::string& jsonContext) {
             return;
         }
 
-        auto button = m_buttons.front();
-        m_buttons.pop();
-
-        auto msgIdAndJsonEvent =
-            buildJsonEventString(PLAYBACK_CONTROLLER_NAMESPACE, buttonToMessageName(button), "", "{}", jsonContext);
-        m_messageSender->sendMessage(
-            std::make_shared<PlaybackMessageRequest>(button, msgIdAndJsonEvent.second, shared_from_this()));
+        // Every button pressed while the context was being fetched is sent with it, rather than fetching it again.
+        ACSDK_DEBUG9(LX("onContextAvailableExecutor").d("buttons", m_buttons.size()));
+        while (!m_buttons.empty()) {
+            auto button = m_buttons.front();
+            m_buttons.pop();
 
-        if (!m_buttons.empty()) {
-            ACSDK_DEBUG9(LX("onContextAvailableExecutor").m("Queue is not empty, call getContext()."));
-            m_contextManager->getContext(shared_from_this());
+            auto msgIdAndJsonEvent = buildJsonEventString(
+                PLAYBACK_CONTROLLER_NAMESPACE, buttonToMessageName(button), "", "{}", jsonContext);
+            m_messageSender->sendMessage(std::make_shared<PlaybackMessageRequest>(
+                button, std::move(msgIdAndJsonEvent.second), shared_from_this()));
         }
     };
 
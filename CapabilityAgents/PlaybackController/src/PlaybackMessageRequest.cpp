@@ -26,9 +26,9 @@ using namespace avsCommon::sdkInterfaces;
 
 PlaybackMessageRequest::PlaybackMessageRequest(
     PlaybackController::Button button,
-    const std::string& jsonContent,
+    std::string jsonContent,
     std::shared_ptr<PlaybackController> playbackController) :
-        MessageRequest(jsonContent),
+        MessageRequest(std::move(jsonContent)),
         m_playbackController{playbackController},
         m_button{button} {
 }
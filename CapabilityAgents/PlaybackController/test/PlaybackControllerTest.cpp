@@ -17,7 +17,9 @@
 
 /// @file PlaybackControllerTest
 #include <chrono>
+#include <future>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
@@ -389,6 +391,43 @@ TEST_F(PlaybackControllerTest, sendMessageException) {
     m_messageTrigger.wait_for(exitLock, TEST_RESULT_WAIT_PERIOD);
 }
 
+/**
+ * This case tests that buttons pressed while the context is being fetched are all sent with that context, and that a
+ * repeated 'Play' is sent once while each 'Next' is sent.
+ */
+TEST_F(PlaybackControllerTest, buttonsPressedDuringGetContextShareContext) {
+    std::unique_lock<std::mutex> exitLock(m_mutex);
+
+    m_playbackController = PlaybackController::create(m_mockContextManager, m_mockMessageSender);
+    ASSERT_NE(nullptr, m_playbackController);
+
+    EXPECT_CALL(*m_mockContextManager, getContext(_))
+        .WillOnce(Invoke([this](std::shared_ptr<ContextRequesterInterface> contextRequester) {
+            checkGetContextAndReleaseTrigger(contextRequester);
+        }));
+    m_playbackController->playButtonPressed();
+    m_playbackController->playButtonPressed();
+    m_playbackController->nextButtonPressed();
+    m_playbackController->nextButtonPressed();
+    m_contextTrigger.wait_for(exitLock, TEST_RESULT_WAIT_PERIOD);
+
+    std::vector<std::string> names;
+    std::promise<void> sentPromise;
+    std::future<void> sentFuture = sentPromise.get_future();
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .Times(3)
+        .WillRepeatedly(Invoke([&](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            names.push_back(checkMessageRequest(request));
+            request->sendCompleted(m_messageStatus);
+            if (3 == names.size()) {
+                sentPromise.set_value();
+            }
+        }));
+    m_playbackController->onContextAvailable(MOCK_CONTEXT);
+    ASSERT_EQ(std::future_status::ready, sentFuture.wait_for(TEST_RESULT_WAIT_PERIOD));
+    EXPECT_EQ(names, std::vector<std::string>({PLAYBACK_PLAY_NAME, PLAYBACK_NEXT_NAME, PLAYBACK_NEXT_NAME}));
+}
+
 }  // namespace test
 }  // namespace playbackController
 }  // namespace capabilityAgents
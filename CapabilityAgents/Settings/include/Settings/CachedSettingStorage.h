@@ -0,0 +1,172 @@
+/*
+ * CachedSettingStorage.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_CACHED_SETTING_STORAGE_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_CACHED_SETTING_STORAGE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include <AVSCommon/Utils/RequiresShutdown.h>
+
+#include "Settings/SettingsStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace settings {
+
+/**
+ * A @c SettingsStorageInterface which keeps the settings in memory, and writes the changes to another storage behind
+ * the caller's back.
+ *
+ * The settings are loaded from the other storage when the database is opened, after which reads are served from
+ * memory.  Changes are written out together, the flush delay after the first of them, so that repeated changes to a
+ * setting within that time only reach the other storage once, and the modified settings are written with a single
+ * @c modifyAll().  Changes not written yet are written by @c flush(),
+ * @c close() and @c shutdown(), after which each change is written at once.  A change which cannot be written is
+ * retried at the next flush.
+ *
+ * This class is thread-safe.
+ */
+class CachedSettingStorage
+        : public SettingsStorageInterface
+        , public avsCommon::utils::RequiresShutdown {
+public:
+    /// The default time to wait for further changes before writing them out.
+    static const std::chrono::milliseconds DEFAULT_FLUSH_DELAY;
+
+    /**
+     * Creates a new @c CachedSettingStorage.
+     *
+     * @param storage The storage to write the settings to.
+     * @param flushDelay The time to wait for further changes before writing them out.
+     * @return The new @c CachedSettingStorage, or @c nullptr if @c storage is @c nullptr.
+     */
+    static std::shared_ptr<CachedSettingStorage> create(
+        std::shared_ptr<SettingsStorageInterface> storage,
+        std::chrono::milliseconds flushDelay = DEFAULT_FLUSH_DELAY);
+
+    /**
+     * Destructor.
+     */
+    ~CachedSettingStorage();
+
+    bool createDatabase(const std::string& filePath) override;
+
+    bool open(const std::string& filePath) override;
+
+    bool isOpen() override;
+
+    void close() override;
+
+    bool settingExists(const std::string& key) override;
+
+    bool store(const std::string& key, const std::string& value) override;
+
+    bool load(std::unordered_map<std::string, std::string>* mapOfSettings) override;
+
+    bool modify(const std::string& key, const std::string& value) override;
+
+    bool modifyAll(const std::unordered_map<std::string, std::string>& settings) override;
+
+    bool erase(const std::string& key) override;
+
+    bool clearDatabase() override;
+
+    /**
+     * Write the changes which have not been written yet to the other storage.
+     *
+     * @return Whether all the changes were written.
+     */
+    bool flush();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param storage The storage to write the settings to.
+     * @param flushDelay The time to wait for further changes before writing them out.
+     */
+    CachedSettingStorage(std::shared_ptr<SettingsStorageInterface> storage, std::chrono::milliseconds flushDelay);
+
+    void doShutdown() override;
+
+    /**
+     * Fill the cache from the other storage.  It must be called with @c m_storageMutex held.
+     *
+     * @return Whether the settings were loaded.
+     */
+    bool loadFromStorageLocked();
+
+    /**
+     * Record that a setting has changed, and schedule it to be written.  It must be called with @c m_mutex held.
+     *
+     * @param key The name of the setting.
+     * @return Whether the change should be written at once, since the flush thread has stopped.
+     */
+    bool markDirtyLocked(const std::string& key);
+
+    /**
+     * Stop @c m_thread, if it is running.
+     */
+    void stopFlushThread();
+
+    /// The main loop of @c m_thread.
+    void flushLoop();
+
+    /// The storage the settings are written to.
+    std::shared_ptr<SettingsStorageInterface> m_storage;
+
+    /// The time to wait for further changes before writing them out.
+    const std::chrono::milliseconds m_flushDelay;
+
+    /// Serializes access to @c m_storage.  When both are held, it is locked before @c m_mutex.
+    std::mutex m_storageMutex;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a setting has changed, or when @c m_thread should exit.
+    std::condition_variable m_wakeTrigger;
+
+    /// Whether a database is open.
+    bool m_isOpen;
+
+    /// The current settings, by name.
+    std::unordered_map<std::string, std::string> m_settings;
+
+    /// The names of the settings which are in the other storage.
+    std::unordered_set<std::string> m_persistedKeys;
+
+    /// The names of the settings which have changed since they were last written.
+    std::unordered_set<std::string> m_dirtyKeys;
+
+    /// Whether @c m_thread should exit.
+    bool m_isShuttingDown;
+
+    /// The thread which writes the changes out.
+    std::thread m_thread;
+};
+
+}  // namespace settings
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_CACHED_SETTING_STORAGE_H_
@@ -18,8 +18,13 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_SQLITE_SETTING_STORAGE_H_
 #define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_SQLITE_SETTING_STORAGE_H_
 
+#include <memory>
+
 #include <sqlite3.h>
 
+#include <SQLiteStorage/SQLiteDatabaseService.h>
+#include <SQLiteStorage/SQLiteStatementCache.h>
+
 #include "Settings/SettingsStorageInterface.h"
 
 namespace alexaClientSDK {
@@ -29,6 +34,9 @@ namespace settings {
 /**
  * An implementation that allows us to store settings using SQLite.
  *
+ * The settings may instead be kept in a shared @c SQLiteDatabaseService, in which case each call runs on its storage
+ * thread and the file paths given to @c createDatabase() and @c open() are not used.
+ *
  * This class is not thread-safe.
  */
 class SQLiteSettingStorage : public SettingsStorageInterface {
@@ -38,6 +46,13 @@ public:
      */
     SQLiteSettingStorage();
 
+    /**
+     * Constructor for a storage keeping its settings in a shared database.
+     *
+     * @param database The shared database, or @c nullptr to keep them in a database file of their own.
+     */
+    explicit SQLiteSettingStorage(std::shared_ptr<storage::sqliteStorage::SQLiteDatabaseService> database);
+
     bool createDatabase(const std::string& filePath) override;
 
     bool open(const std::string& filePath) override;
@@ -54,6 +69,11 @@ public:
 
     bool modify(const std::string& key, const std::string& value) override;
 
+    /**
+     * Modifies the settings in a single transaction, so that the changes reach the disk in one write.
+     */
+    bool modifyAll(const std::unordered_map<std::string, std::string>& settings) override;
+
     bool erase(const std::string& key) override;
 
     bool clearDatabase() override;
@@ -61,8 +81,23 @@ public:
     ~SQLiteSettingStorage();
 
 private:
+    /**
+     * Start using the shared database, creating the settings table if asked to.  Called on the storage thread.
+     *
+     * @param dbHandle The connection to the shared database.
+     * @param createTable Whether to create the settings table if it does not exist.
+     * @return Whether the settings table exists in the shared database.
+     */
+    bool useSharedDatabase(sqlite3* dbHandle, bool createTable);
+
+    /// The shared database keeping the settings, or @c nullptr if they are kept in a database of their own.
+    std::shared_ptr<storage::sqliteStorage::SQLiteDatabaseService> m_database;
+
     /// The sqlite database handle.
     sqlite3* m_dbHandle;
+
+    /// The statements run repeatedly on @c m_dbHandle, prepared once per connection.
+    storage::sqliteStorage::SQLiteStatementCache m_statementCache;
 };
 
 }  // namespace settings
@@ -18,6 +18,9 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_SETTINGS_H_
 #define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SETTINGS_INCLUDE_SETTINGS_SETTINGS_H_
 
+#include <chrono>
+#include <future>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +29,7 @@
 #include <AVSCommon/SDKInterfaces/SingleSettingObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
+#include <AVSCommon/Utils/Timing/Timer.h>
 #include "Settings/SettingsStorageInterface.h"
 
 namespace alexaClientSDK {
@@ -36,21 +40,37 @@ namespace settings {
  * This class implements Settings Interface to manage Alexa Settings on the product.
  *
  * This class writes the Setting change to database and notifies the observers of the setting.
+ *
+ * Changes made within the event batching window of the first of them are applied together: they are written to the
+ * database with a single @c SettingsStorageInterface::modifyAll(), and the global observers, such as the
+ * @c SettingsUpdatedEventSender, are notified once with all of them.
+ *
  * @see https://developer.amazon.com/public/solutions/alexa/alexa-voice-service/reference/settings
  */
 class Settings {
 public:
+    /// The default time to wait for further setting changes before applying them together.
+    static const std::chrono::milliseconds DEFAULT_EVENT_BATCHING_WINDOW;
+
     /**
      * Creates a new @c Settings instance.
      * @param settingsStorage An interface to store, load, modify and delete Settings.
      * @param globalSettingsObserver A set of SettingsGlobalObserver which are notified when all the settings are
      * changed.
+     * @param eventBatchingWindow The time to wait for further setting changes before applying them together.  With
+     * zero, each change is applied at once.
      * @return An instance of Settings if construction is successful or nullptr if construction fails.
      */
     static std::shared_ptr<Settings> create(
         std::shared_ptr<SettingsStorageInterface> settingsStorage,
         std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::GlobalSettingsObserverInterface>>
-            globalSettingsObserver);
+            globalSettingsObserver,
+        std::chrono::milliseconds eventBatchingWindow = DEFAULT_EVENT_BATCHING_WINDOW);
+
+    /**
+     * Destructor.  The changes which have not been applied yet are applied.
+     */
+    ~Settings();
 
     /**
      * Add an observer for a single setting mapped to the setting key.
@@ -86,11 +106,11 @@ public:
 
     /**
      * Function called by the application when a Setting is changed. It calls @c executeChangeSetting via
-     * the executor.
+     * the executor.  The change is applied together with the other changes of its batching window.
      *
      * @param key The name of the setting which is changed.
      * @param value The new value of the setting.
-     * @return A future which is @c true if the setting is changed successfully else @c false.
+     * @return A future which is @c true once the setting is changed successfully, or @c false if it could not be.
      */
     std::future<bool> changeSetting(const std::string& key, const std::string& value);
 
@@ -124,17 +144,31 @@ private:
     Settings(
         std::shared_ptr<SettingsStorageInterface> settingsStorage,
         std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::GlobalSettingsObserverInterface>>
-            globalSettingsObserver);
+            globalSettingsObserver,
+        std::chrono::milliseconds eventBatchingWindow);
 
     /**
-     * Function which implements the setting change. The function writes to the database and notifies the
-     * observers of the setting.
+     * Function which queues the setting change, and starts the batching window if it is the first pending change.
      *
      * @param key The name of the setting which is changed.
      * @param value The new value of the setting.
-     * @return A boolean which is @c true if the setting is changed successfully else @c false.
+     * @param result The promise to set once the change is applied, with whether it was.
+     */
+    void executeChangeSetting(
+        const std::string& key,
+        const std::string& value,
+        std::shared_ptr<std::promise<bool>> result);
+
+    /**
+     * Function which applies the pending setting changes. The function writes them to the database and notifies the
+     * observers of the settings.
+     */
+    void executeApplyPendingChanges();
+
+    /**
+     * Function which notifies the global observers with the entire map of settings.
      */
-    bool executeChangeSetting(const std::string& key, const std::string& value);
+    void notifyGlobalSettingsObservers();
 
     /// The SettingsStorage object.
     std::shared_ptr<SettingsStorageInterface> m_settingsStorage;
@@ -143,8 +177,16 @@ private:
         m_globalSettingsObserver;
     /// The map of <key, SettingElements> pairs of the settings.
     std::unordered_map<std::string, SettingElements> m_mapOfSettingsAttributes;
+    /// The time to wait for further setting changes before applying them together.
+    const std::chrono::milliseconds m_eventBatchingWindow;
+    /// The setting changes which have not been applied yet, by setting name.
+    std::unordered_map<std::string, std::string> m_pendingChanges;
+    /// The promises to set once @c m_pendingChanges are applied.
+    std::vector<std::shared_ptr<std::promise<bool>>> m_pendingResults;
     /// Executor that queues up the calls when a setting is changed.
     avsCommon::utils::threading::Executor m_executor;
+    /// The timer which ends the batching window.  It is declared after @c m_executor, into which it submits.
+    avsCommon::utils::timing::Timer m_batchingTimer;
 
     /**
      * Variable which indicates whether to send the default Settings to AVS or not.
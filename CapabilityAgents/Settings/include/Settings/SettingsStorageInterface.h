@@ -107,6 +107,16 @@ public:
      */
     virtual bool modify(const std::string& key, const std::string& value) = 0;
 
+    /**
+     * Updates the database records of several Settings together, so that either all of them are modified or none is.
+     *
+     * The default implementation modifies the settings one after the other, and stops at the first failure.
+     *
+     * @param settings The values to which the settings have to be set, by name.
+     * @return Whether all the settings were successfully modified.
+     */
+    virtual bool modifyAll(const std::unordered_map<std::string, std::string>& settings);
+
     /**
      * Erases a single setting from the database.
      *
@@ -124,6 +134,15 @@ public:
     virtual bool clearDatabase() = 0;
 };
 
+inline bool SettingsStorageInterface::modifyAll(const std::unordered_map<std::string, std::string>& settings) {
+    for (auto& setting : settings) {
+        if (!modify(setting.first, setting.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace settings
 }  // namespace capabilityAgents
 }  // namespace alexaClientSDK
@@ -0,0 +1,324 @@
+/*
+ * CachedSettingStorage.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "Settings/CachedSettingStorage.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace settings {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG{"CachedSettingStorage"};
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const std::chrono::milliseconds CachedSettingStorage::DEFAULT_FLUSH_DELAY(1000);
+
+std::shared_ptr<CachedSettingStorage> CachedSettingStorage::create(
+    std::shared_ptr<SettingsStorageInterface> storage,
+    std::chrono::milliseconds flushDelay) {
+    if (!storage) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "storageNullReference").d("return", "nullptr"));
+        return nullptr;
+    }
+    return std::shared_ptr<CachedSettingStorage>(new CachedSettingStorage(storage, flushDelay));
+}
+
+CachedSettingStorage::CachedSettingStorage(
+    std::shared_ptr<SettingsStorageInterface> storage,
+    std::chrono::milliseconds flushDelay) :
+        RequiresShutdown{"CachedSettingStorage"},
+        m_storage{storage},
+        m_flushDelay{flushDelay},
+        m_isOpen{false},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&CachedSettingStorage::flushLoop, this);
+}
+
+CachedSettingStorage::~CachedSettingStorage() {
+    stopFlushThread();
+}
+
+bool CachedSettingStorage::createDatabase(const std::string& filePath) {
+    std::lock_guard<std::mutex> storageLock(m_storageMutex);
+    if (!m_storage->createDatabase(filePath)) {
+        return false;
+    }
+    return loadFromStorageLocked();
+}
+
+bool CachedSettingStorage::open(const std::string& filePath) {
+    std::lock_guard<std::mutex> storageLock(m_storageMutex);
+    if (!m_storage->open(filePath)) {
+        return false;
+    }
+    return loadFromStorageLocked();
+}
+
+bool CachedSettingStorage::isOpen() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isOpen;
+}
+
+void CachedSettingStorage::close() {
+    flush();
+    std::lock_guard<std::mutex> storageLock(m_storageMutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_storage->close();
+    m_isOpen = false;
+    m_settings.clear();
+    m_persistedKeys.clear();
+    m_dirtyKeys.clear();
+}
+
+bool CachedSettingStorage::settingExists(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_settings.count(key) > 0;
+}
+
+bool CachedSettingStorage::store(const std::string& key, const std::string& value) {
+    bool writeNow = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isOpen) {
+            ACSDK_ERROR(LX("storeFailed").d("reason", "DatabaseNotOpen"));
+            return false;
+        }
+        if (value.empty()) {
+            ACSDK_ERROR(LX("storeFailed").d("reason", "SettingValueisEmpty"));
+            return false;
+        }
+        if (!m_settings.insert({key, value}).second) {
+            ACSDK_ERROR(LX("storeFailed").d("reason", "SettingAlreadyExists").d("key", key));
+            return false;
+        }
+        writeNow = markDirtyLocked(key);
+    }
+    return !writeNow || flush();
+}
+
+bool CachedSettingStorage::load(std::unordered_map<std::string, std::string>* mapOfSettings) {
+    if (!mapOfSettings) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "mapOfSettingsNullReference"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isOpen) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "DatabaseNotOpen"));
+        return false;
+    }
+    mapOfSettings->insert(m_settings.begin(), m_settings.end());
+    return true;
+}
+
+bool CachedSettingStorage::modify(const std::string& key, const std::string& value) {
+    bool writeNow = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (value.empty()) {
+            ACSDK_ERROR(LX("modifyFailed").d("reason", "SettingValueisEmpty"));
+            return false;
+        }
+        auto it = m_settings.find(key);
+        if (it == m_settings.end()) {
+            ACSDK_ERROR(LX("modifyFailed").d("reason", "SettingDoesNotExistInDatabase").d("key", key));
+            return false;
+        }
+        if (it->second == value) {
+            return true;
+        }
+        it->second = value;
+        writeNow = markDirtyLocked(key);
+    }
+    return !writeNow || flush();
+}
+
+bool CachedSettingStorage::modifyAll(const std::unordered_map<std::string, std::string>& settings) {
+    bool writeNow = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& setting : settings) {
+            if (setting.second.empty()) {
+                ACSDK_ERROR(LX("modifyAllFailed").d("reason", "SettingValueisEmpty").d("key", setting.first));
+                return false;
+            }
+            if (m_settings.find(setting.first) == m_settings.end()) {
+                ACSDK_ERROR(LX("modifyAllFailed").d("reason", "SettingDoesNotExistInDatabase").d("key", setting.first));
+                return false;
+            }
+        }
+        for (auto& setting : settings) {
+            auto& value = m_settings[setting.first];
+            if (value != setting.second) {
+                value = setting.second;
+                writeNow = markDirtyLocked(setting.first);
+            }
+        }
+    }
+    return !writeNow || flush();
+}
+
+bool CachedSettingStorage::erase(const std::string& key) {
+    bool writeNow = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_settings.erase(key)) {
+            ACSDK_ERROR(LX("eraseFailed").d("reason", "SettingDoesNotExistInDatabase").d("key", key));
+            return false;
+        }
+        writeNow = markDirtyLocked(key);
+    }
+    return !writeNow || flush();
+}
+
+bool CachedSettingStorage::clearDatabase() {
+    std::lock_guard<std::mutex> storageLock(m_storageMutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_storage->clearDatabase()) {
+        return false;
+    }
+    m_settings.clear();
+    m_persistedKeys.clear();
+    m_dirtyKeys.clear();
+    return true;
+}
+
+bool CachedSettingStorage::flush() {
+    std::lock_guard<std::mutex> storageLock(m_storageMutex);
+
+    /// A change to write out.
+    struct Change {
+        /// The name of the setting.
+        std::string key;
+        /// Whether the setting exists.
+        bool exists;
+        /// The value of the setting, if it exists.
+        std::string value;
+        /// Whether the setting is in @c m_storage.
+        bool persisted;
+    };
+    std::vector<Change> changes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& key : m_dirtyKeys) {
+            auto it = m_settings.find(key);
+            bool exists = it != m_settings.end();
+            changes.push_back({key, exists, exists ? it->second : "", m_persistedKeys.count(key) > 0});
+        }
+        m_dirtyKeys.clear();
+    }
+
+    // Write without holding m_mutex, so that the cache keeps serving callers.  m_storageMutex keeps the writes of
+    // successive flushes in order.  The modified settings are written together, in one transaction if the storage
+    // supports it.
+    std::unordered_map<std::string, std::string> modified;
+    for (auto& change : changes) {
+        if (change.exists && change.persisted) {
+            modified[change.key] = change.value;
+        }
+    }
+    bool modifiedWritten = modified.empty() || m_storage->modifyAll(modified);
+
+    bool flushed = true;
+    for (auto& change : changes) {
+        bool written = true;
+        if (change.exists) {
+            written = change.persisted ? modifiedWritten : m_storage->store(change.key, change.value);
+        } else if (change.persisted) {
+            written = m_storage->erase(change.key);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!written) {
+            ACSDK_ERROR(LX("flushFailed").d("reason", "writeFailed").d("key", change.key));
+            m_dirtyKeys.insert(change.key);
+            flushed = false;
+        } else if (change.exists) {
+            m_persistedKeys.insert(change.key);
+        } else {
+            m_persistedKeys.erase(change.key);
+        }
+    }
+    return flushed;
+}
+
+void CachedSettingStorage::doShutdown() {
+    stopFlushThread();
+    flush();
+}
+
+bool CachedSettingStorage::loadFromStorageLocked() {
+    std::unordered_map<std::string, std::string> settings;
+    if (!m_storage->load(&settings)) {
+        ACSDK_ERROR(LX("loadFromStorageFailed").d("reason", "databaseReadFailed"));
+        m_storage->close();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isOpen = true;
+    m_settings = settings;
+    m_persistedKeys.clear();
+    for (auto& setting : m_settings) {
+        m_persistedKeys.insert(setting.first);
+    }
+    m_dirtyKeys.clear();
+    return true;
+}
+
+bool CachedSettingStorage::markDirtyLocked(const std::string& key) {
+    m_dirtyKeys.insert(key);
+    m_wakeTrigger.notify_all();
+    return m_isShuttingDown;
+}
+
+void CachedSettingStorage::stopFlushThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeTrigger.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CachedSettingStorage::flushLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeTrigger.wait(lock, [this]() { return m_isShuttingDown || !m_dirtyKeys.empty(); });
+        // Let further changes gather before writing them out.
+        m_wakeTrigger.wait_for(lock, m_flushDelay, [this]() { return m_isShuttingDown; });
+        if (m_isShuttingDown) {
+            return;
+        }
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+}  // namespace settings
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -50,10 +50,39 @@ static const std::string SETTING_VALUE = "value";
 static const std::string CREATE_SETTINGS_TABLE_SQL_STRING = std::string("CREATE TABLE ") + SETTINGS_TABLE_NAME + " (" +
                                                             SETTING_KEY + " TEXT PRIMARY KEY NOT NULL," +
                                                             SETTING_VALUE + " TEXT NOT NULL);";
+/// The SQL string to count the settings with a key.
+static const std::string SETTING_EXISTS_SQL_STRING =
+    "SELECT COUNT(*) FROM " + SETTINGS_TABLE_NAME + " WHERE " + SETTING_KEY + "=?;";
+/// The SQL string to store a setting.
+static const std::string STORE_SETTING_SQL_STRING =
+    "INSERT INTO " + SETTINGS_TABLE_NAME + " (" + SETTING_KEY + ", " + SETTING_VALUE + ") VALUES (?, ?);";
+/// The SQL string to modify a setting.
+static const std::string MODIFY_SETTING_SQL_STRING =
+    "UPDATE " + SETTINGS_TABLE_NAME + " SET " + SETTING_VALUE + "=? WHERE " + SETTING_KEY + "=?;";
+/// The SQL string to erase a setting.
+static const std::string ERASE_SETTING_SQL_STRING =
+    "DELETE FROM " + SETTINGS_TABLE_NAME + " WHERE " + SETTING_KEY + "=?;";
+
+/// The ids of the statements kept in the statement cache.
+enum StatementId {
+    /// The statement running @c SETTING_EXISTS_SQL_STRING.
+    SETTING_EXISTS_STATEMENT_ID,
+    /// The statement running @c STORE_SETTING_SQL_STRING.
+    STORE_SETTING_STATEMENT_ID,
+    /// The statement running @c MODIFY_SETTING_SQL_STRING.
+    MODIFY_SETTING_STATEMENT_ID,
+    /// The statement running @c ERASE_SETTING_SQL_STRING.
+    ERASE_SETTING_STATEMENT_ID
+};
 
 SQLiteSettingStorage::SQLiteSettingStorage() : m_dbHandle{nullptr} {
 }
 
+SQLiteSettingStorage::SQLiteSettingStorage(std::shared_ptr<SQLiteDatabaseService> database) :
+        m_database{database},
+        m_dbHandle{nullptr} {
+}
+
 /**
  * A small utility function to help determine if a file exists.
  *
@@ -71,6 +100,10 @@ bool SQLiteSettingStorage::createDatabase(const std::string& filePath) {
         return false;
     }
 
+    if (m_database) {
+        return m_database->run([this](sqlite3* dbHandle) { return useSharedDatabase(dbHandle, true); });
+    }
+
     if (fileExists(filePath)) {
         ACSDK_ERROR(LX("createDatabaseFailed").d("reason", "FileAlreadyExists").d("FilePath", filePath));
         return false;
@@ -97,6 +130,10 @@ bool SQLiteSettingStorage::open(const std::string& filePath) {
         return false;
     }
 
+    if (m_database) {
+        return m_database->run([this](sqlite3* dbHandle) { return useSharedDatabase(dbHandle, false); });
+    }
+
     if (!fileExists(filePath)) {
         ACSDK_ERROR(LX("openFailed").d("reason", "FileAlreadyExists").d("FilePath", filePath));
         return false;
@@ -115,16 +152,28 @@ bool SQLiteSettingStorage::isOpen() {
 }
 
 void SQLiteSettingStorage::close() {
+    if (m_database && !m_database->isStorageThread()) {
+        m_database->run([this](sqlite3*) {
+            close();
+            return true;
+        });
+        return;
+    }
     if (m_dbHandle) {
-        closeSQLiteDatabase(m_dbHandle);
+        m_statementCache.clear();
+        // The connection to a shared database is kept open for the other storages using it.
+        if (!m_database) {
+            closeSQLiteDatabase(m_dbHandle);
+        }
         m_dbHandle = nullptr;
     }
 }
 
 bool SQLiteSettingStorage::settingExists(const std::string& key) {
-    std::string sqlString = "SELECT COUNT(*) FROM " + SETTINGS_TABLE_NAME + " WHERE " + SETTING_KEY + "=?;";
-
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return settingExists(key); });
+    }
+    auto statement = m_statementCache.get(m_dbHandle, SETTING_EXISTS_STATEMENT_ID, SETTING_EXISTS_SQL_STRING);
 
     if (!statement.isValid()) {
         ACSDK_ERROR(LX("settingExistsFailed").d("reason", "SQliteStatementInvalid"));
@@ -132,18 +181,18 @@ bool SQLiteSettingStorage::settingExists(const std::string& key) {
     }
 
     int boundParam = 1;
-    if (!statement.bindStringParameter(boundParam, key)) {
+    if (!statement->bindStringParameter(boundParam, key)) {
         ACSDK_ERROR(LX("settingExistsFailed").d("reason", "BindParameterFailed"));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("settingExistsFailed").d("reason", "StepToRowFailed"));
         return false;
     }
 
     const int RESULT_COLUMN_POSITION = 0;
-    std::string rowValue = statement.getColumnText(RESULT_COLUMN_POSITION);
+    std::string rowValue = statement->getColumnText(RESULT_COLUMN_POSITION);
 
     int countValue = 0;
     if (!stringToInt(rowValue.c_str(), &countValue)) {
@@ -151,11 +200,13 @@ bool SQLiteSettingStorage::settingExists(const std::string& key) {
         return false;
     }
 
-    statement.finalize();
     return countValue > 0;
 }
 
 bool SQLiteSettingStorage::store(const std::string& key, const std::string& value) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return store(key, value); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("storeFailed").d("reason", "DatabaseHandleNotOpen"));
         return false;
@@ -171,10 +222,7 @@ bool SQLiteSettingStorage::store(const std::string& key, const std::string& valu
         return false;
     }
 
-    std::string sqlString = std::string("INSERT INTO " + SETTINGS_TABLE_NAME + " (") + SETTING_KEY + ", " +
-                            SETTING_VALUE + ") VALUES (" + "?, ?" + ");";
-
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    auto statement = m_statementCache.get(m_dbHandle, STORE_SETTING_STATEMENT_ID, STORE_SETTING_SQL_STRING);
 
     if (!statement.isValid()) {
         ACSDK_ERROR(LX("storeFailed").d("reason", "SQliteStatementInvalid"));
@@ -182,21 +230,23 @@ bool SQLiteSettingStorage::store(const std::string& key, const std::string& valu
     }
 
     int boundParam = 1;
-    if (!statement.bindStringParameter(boundParam++, key) || !statement.bindStringParameter(boundParam, value)) {
+    if (!statement->bindStringParameter(boundParam++, key) || !statement->bindStringParameter(boundParam, value)) {
         ACSDK_ERROR(LX("storeFailed").d("reason", "BindParameterFailed"));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("storeFailed").d("reason", "StepToRowFailed"));
         return false;
     }
 
-    statement.finalize();
     return true;
 }
 
 bool SQLiteSettingStorage::load(std::unordered_map<std::string, std::string>* mapOfSettings) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return load(mapOfSettings); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("loadFailed").d("reason", "DatabaseHandleNotOpen"));
         return false;
@@ -211,38 +261,33 @@ bool SQLiteSettingStorage::load(std::unordered_map<std::string, std::string>* ma
         return false;
     }
 
-    std::string key;
-    std::string value;
-
-    if (!statement.step()) {
-        ACSDK_ERROR(LX("loadFailed").d("reason", "StepToRowFailed"));
+    // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.
+    int keyColumn = statement.getColumnIndex(SETTING_KEY);
+    int valueColumn = statement.getColumnIndex(SETTING_VALUE);
+    if (keyColumn < 0 || valueColumn < 0) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "ColumnsNotFound"));
         return false;
     }
 
-    while (SQLITE_ROW == statement.getStepResult()) {
-        int numberColumns = statement.getColumnCount();
+    bool visitedAllRows = statement.forEachRow([&](const SQLiteStatement& row) {
+        mapOfSettings->insert(
+            make_pair(row.getColumnTextView(keyColumn).toString(), row.getColumnTextView(valueColumn).toString()));
+        return true;
+    });
 
-        // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.
-        for (int i = 0; i < numberColumns; i++) {
-            std::string columnName = statement.getColumnName(i);
-
-            if (SETTING_KEY == columnName) {
-                key = statement.getColumnText(i);
-            } else if (SETTING_VALUE == columnName) {
-                value = statement.getColumnText(i);
-            }
-        }
-
-        mapOfSettings->insert(make_pair(key, value));
+    statement.finalize();
 
-        statement.step();
+    if (!visitedAllRows) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "StepToRowFailed"));
+        return false;
     }
-
-    statement.finalize();
     return true;
 }
 
 bool SQLiteSettingStorage::modify(const std::string& key, const std::string& value) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return modify(key, value); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("modifyFailed").d("reason", "DatabaseHandleNotOpen"));
         return false;
@@ -258,10 +303,7 @@ bool SQLiteSettingStorage::modify(const std::string& key, const std::string& val
         return false;
     }
 
-    std::string sqlString =
-        std::string("UPDATE " + SETTINGS_TABLE_NAME + " SET ") + "value=?" + "WHERE " + SETTING_KEY + "=?;";
-
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    auto statement = m_statementCache.get(m_dbHandle, MODIFY_SETTING_STATEMENT_ID, MODIFY_SETTING_SQL_STRING);
 
     if (!statement.isValid()) {
         ACSDK_ERROR(LX("modifyFailed").d("reason", "SQliteStatementInvalid"));
@@ -269,21 +311,53 @@ bool SQLiteSettingStorage::modify(const std::string& key, const std::string& val
     }
 
     int boundParam = 1;
-    if (!statement.bindStringParameter(boundParam++, value) || !statement.bindStringParameter(boundParam, key)) {
+    if (!statement->bindStringParameter(boundParam++, value) || !statement->bindStringParameter(boundParam, key)) {
         ACSDK_ERROR(LX("modifyFailed").d("reason", "BindParameterFailed"));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("modifyFailed").d("reason", "StepToRowFailed"));
         return false;
     }
 
-    statement.finalize();
+    return true;
+}
+
+bool SQLiteSettingStorage::modifyAll(const std::unordered_map<std::string, std::string>& settings) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return modifyAll(settings); });
+    }
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("modifyAllFailed").d("reason", "DatabaseHandleNotOpen"));
+        return false;
+    }
+
+    if (!beginTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("modifyAllFailed").d("reason", "BeginTransactionFailed"));
+        return false;
+    }
+
+    for (auto& setting : settings) {
+        if (!modify(setting.first, setting.second)) {
+            ACSDK_ERROR(LX("modifyAllFailed").d("reason", "ModifyFailed").d("key", setting.first));
+            rollbackTransaction(m_dbHandle);
+            return false;
+        }
+    }
+
+    if (!commitTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("modifyAllFailed").d("reason", "CommitTransactionFailed"));
+        return false;
+    }
+
     return true;
 }
 
 bool SQLiteSettingStorage::erase(const std::string& key) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return erase(key); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("eraseFailed").d("reason", "DatabaseHandleNotOpen"));
         return false;
@@ -299,9 +373,7 @@ bool SQLiteSettingStorage::erase(const std::string& key) {
         return false;
     }
 
-    std::string sqlString = "DELETE FROM " + SETTINGS_TABLE_NAME + " WHERE " + SETTING_KEY + "=?;";
-
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    auto statement = m_statementCache.get(m_dbHandle, ERASE_SETTING_STATEMENT_ID, ERASE_SETTING_SQL_STRING);
 
     if (!statement.isValid()) {
         ACSDK_ERROR(LX("eraseFailed").d("reason", "SQliteStatementInvalid"));
@@ -309,21 +381,23 @@ bool SQLiteSettingStorage::erase(const std::string& key) {
     }
 
     int boundParam = 1;
-    if (!statement.bindStringParameter(boundParam, key)) {
+    if (!statement->bindStringParameter(boundParam, key)) {
         ACSDK_ERROR(LX("eraseFailed").d("reason", "BindParameterFailed"));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("eraseFailed").d("reason", "StepToRowFailed"));
         return false;
     }
 
-    statement.finalize();
     return true;
 }
 
 bool SQLiteSettingStorage::clearDatabase() {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([this](sqlite3*) { return clearDatabase(); });
+    }
     if (!clearTable(m_dbHandle, SETTINGS_TABLE_NAME)) {
         ACSDK_ERROR(LX("clearDatabaseFailed").d("reason", "SqliteClearTableFailed"));
         return false;
@@ -331,6 +405,21 @@ bool SQLiteSettingStorage::clearDatabase() {
     return true;
 }
 
+bool SQLiteSettingStorage::useSharedDatabase(sqlite3* dbHandle, bool createTable) {
+    if (!tableExists(dbHandle, SETTINGS_TABLE_NAME)) {
+        if (!createTable) {
+            ACSDK_ERROR(LX("openFailed").d("reason", "TableDoesNotExistInSharedDatabase"));
+            return false;
+        }
+        if (!performQuery(dbHandle, CREATE_SETTINGS_TABLE_SQL_STRING)) {
+            ACSDK_ERROR(LX("createDatabaseFailed").d("reason", "PerformQueryFailed"));
+            return false;
+        }
+    }
+    m_dbHandle = dbHandle;
+    return true;
+}
+
 SQLiteSettingStorage::~SQLiteSettingStorage() {
     close();
 }
@@ -45,9 +45,12 @@ static const std::string SETTINGS_DEFAULT_SETTINGS_ROOT_KEY = "defaultAVSClientS
 /// The acceptable setting keys to find in our config file.
 static const std::unordered_set<std::string> SETTINGS_ACCEPTED_KEYS = {"locale"};
 
+const std::chrono::milliseconds Settings::DEFAULT_EVENT_BATCHING_WINDOW{500};
+
 std::shared_ptr<Settings> Settings::create(
     std::shared_ptr<SettingsStorageInterface> settingsStorage,
-    std::unordered_set<std::shared_ptr<GlobalSettingsObserverInterface>> globalSettingsObserver) {
+    std::unordered_set<std::shared_ptr<GlobalSettingsObserverInterface>> globalSettingsObserver,
+    std::chrono::milliseconds eventBatchingWindow) {
     if (!settingsStorage) {
         ACSDK_ERROR(LX("createFailed").d("reason", "settingsStorageNullReference").d("return", "nullptr"));
         return nullptr;
@@ -65,7 +68,13 @@ std::shared_ptr<Settings> Settings::create(
         }
     }
 
-    auto settingsObject = std::shared_ptr<Settings>(new Settings(settingsStorage, globalSettingsObserver));
+    if (eventBatchingWindow.count() < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "negativeEventBatchingWindow").d("return", "nullptr"));
+        return nullptr;
+    }
+
+    auto settingsObject =
+        std::shared_ptr<Settings>(new Settings(settingsStorage, globalSettingsObserver, eventBatchingWindow));
 
     if (!settingsObject->initialize()) {
         ACSDK_ERROR(LX("createFailed").d("reason", "Initialization error."));
@@ -149,28 +158,77 @@ void Settings::removeSingleSettingObserver(
 }
 
 std::future<bool> Settings::changeSetting(const std::string& key, const std::string& value) {
-    return m_executor.submit([this, key, value] { return executeChangeSetting(key, value); });
+    auto result = std::make_shared<std::promise<bool>>();
+    auto future = result->get_future();
+    m_executor.submit([this, key, value, result] { executeChangeSetting(key, value, result); });
+    return future;
 }
 
-bool Settings::executeChangeSetting(const std::string& key, const std::string& value) {
-    if (!m_settingsStorage->modify(key, value)) {
-        ACSDK_ERROR(LX("executeSettingChangedFailed").d("reason", "databaseUpdateFailed"));
-        return false;
+void Settings::executeChangeSetting(
+    const std::string& key,
+    const std::string& value,
+    std::shared_ptr<std::promise<bool>> result) {
+    // Reject a change which cannot be written here, so that it does not fail the other changes of its batch.
+    if (value.empty() || !m_settingsStorage->settingExists(key)) {
+        ACSDK_ERROR(LX("executeSettingChangedFailed").d("reason", "invalidSetting").d("key", key));
+        result->set_value(false);
+        return;
     }
 
-    // Store the setting in the map @c m_mapOfSettingsAttributes.
-    auto search = m_mapOfSettingsAttributes.find(key);
-    if (search != m_mapOfSettingsAttributes.end()) {
-        search->second.valueOfSetting = value;
+    bool isFirstChange = m_pendingChanges.empty();
+    m_pendingChanges[key] = value;
+    m_pendingResults.push_back(result);
+    if (!isFirstChange) {
+        return;
+    }
+
+    if (m_eventBatchingWindow.count() == 0) {
+        executeApplyPendingChanges();
+        return;
     }
 
-    // Notify the observers of the single settting with value of setting.
-    if (search != m_mapOfSettingsAttributes.end()) {
-        for (auto observer : search->second.singleSettingObservers) {
-            observer->onSettingChanged(key, value);
+    // The timer may still be returning from its previous call.
+    m_batchingTimer.stop();
+    m_batchingTimer.start(
+        m_eventBatchingWindow, [this] { m_executor.submit([this] { executeApplyPendingChanges(); }); });
+}
+
+void Settings::executeApplyPendingChanges() {
+    if (m_pendingChanges.empty()) {
+        return;
+    }
+
+    std::unordered_map<std::string, std::string> changes;
+    std::vector<std::shared_ptr<std::promise<bool>>> results;
+    std::swap(changes, m_pendingChanges);
+    std::swap(results, m_pendingResults);
+
+    bool applied = m_settingsStorage->modifyAll(changes);
+    if (applied) {
+        for (auto& change : changes) {
+            // Store the setting in the map @c m_mapOfSettingsAttributes.
+            auto search = m_mapOfSettingsAttributes.find(change.first);
+            if (search == m_mapOfSettingsAttributes.end()) {
+                continue;
+            }
+            search->second.valueOfSetting = change.second;
+
+            // Notify the observers of the single settting with value of setting.
+            for (auto observer : search->second.singleSettingObservers) {
+                observer->onSettingChanged(change.first, change.second);
+            }
         }
+        notifyGlobalSettingsObservers();
+    } else {
+        ACSDK_ERROR(LX("executeApplyPendingChangesFailed").d("reason", "databaseUpdateFailed"));
     }
 
+    for (auto& result : results) {
+        result->set_value(applied);
+    }
+}
+
+void Settings::notifyGlobalSettingsObservers() {
     std::unordered_map<std::string, std::string> mapOfSettings;
 
     for (auto& it : m_mapOfSettingsAttributes) {
@@ -181,7 +239,6 @@ bool Settings::executeChangeSetting(const std::string& key, const std::string& v
     for (auto observer : m_globalSettingsObserver) {
         observer->onSettingChanged(mapOfSettings);
     }
-    return true;
 }
 
 bool Settings::initialize() {
@@ -251,11 +308,18 @@ bool Settings::initialize() {
 
 Settings::Settings(
     std::shared_ptr<SettingsStorageInterface> settingsStorage,
-    std::unordered_set<std::shared_ptr<GlobalSettingsObserverInterface>> globalSettingsObserver) :
+    std::unordered_set<std::shared_ptr<GlobalSettingsObserverInterface>> globalSettingsObserver,
+    std::chrono::milliseconds eventBatchingWindow) :
         m_settingsStorage{settingsStorage},
         m_globalSettingsObserver{globalSettingsObserver},
+        m_eventBatchingWindow{eventBatchingWindow},
         m_sendDefaultSettings{false} {
 }
+
+Settings::~Settings() {
+    m_batchingTimer.stop();
+    m_executor.submit([this] { executeApplyPendingChanges(); }).wait();
+}
 }  // namespace settings
 }  // namespace capabilityAgents
 }  // namespace alexaClientSDK
@@ -106,7 +106,7 @@ void SettingsUpdatedEventSender::onSettingChanged(const std::unordered_map<std::
         return;
     }
 
-    std::shared_ptr<MessageRequest> request = std::make_shared<MessageRequest>(msgIdAndJsonEvent.second);
+    std::shared_ptr<MessageRequest> request = std::make_shared<MessageRequest>(std::move(msgIdAndJsonEvent.second));
     m_messageSender->sendMessage(request);
 }
 
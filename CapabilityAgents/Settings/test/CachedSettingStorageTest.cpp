@@ -0,0 +1,297 @@
+/*
+ * CachedSettingStorageTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file CachedSettingStorageTest.cpp
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Settings/CachedSettingStorage.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace settings {
+namespace test {
+
+/// The path given to the storage; the fake storage does not use it.
+static const std::string DATABASE_PATH = "settings.db";
+
+/// The name of the setting used by the tests.
+static const std::string LOCALE_KEY = "locale";
+
+/// A flush delay long enough that the tests flush explicitly.
+static const std::chrono::hours LONG_FLUSH_DELAY(1);
+
+/// A flush delay short enough for the tests to wait for.
+static const std::chrono::milliseconds SHORT_FLUSH_DELAY(20);
+
+/// How long to wait for the storage to flush by itself.
+static const std::chrono::milliseconds FLUSH_TIMEOUT(500);
+
+/// An in-memory @c SettingsStorageInterface which counts the calls made to it.
+class FakeSettingStorage : public SettingsStorageInterface {
+public:
+    FakeSettingStorage() : m_isOpen{false}, m_loads{0}, m_writes{0}, m_failWrites{false} {
+    }
+
+    bool createDatabase(const std::string& filePath) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = true;
+        return true;
+    }
+
+    bool open(const std::string& filePath) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = true;
+        return true;
+    }
+
+    bool isOpen() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_isOpen;
+    }
+
+    void close() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = false;
+    }
+
+    bool settingExists(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_settings.count(key) > 0;
+    }
+
+    bool store(const std::string& key, const std::string& value) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_writes;
+        return !m_failWrites && m_settings.insert({key, value}).second;
+    }
+
+    bool load(std::unordered_map<std::string, std::string>* mapOfSettings) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_loads;
+        *mapOfSettings = m_settings;
+        return true;
+    }
+
+    bool modify(const std::string& key, const std::string& value) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_writes;
+        if (m_failWrites || !m_settings.count(key)) {
+            return false;
+        }
+        m_settings[key] = value;
+        return true;
+    }
+
+    bool modifyAll(const std::unordered_map<std::string, std::string>& settings) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_writes;
+        if (m_failWrites) {
+            return false;
+        }
+        for (auto& setting : settings) {
+            if (!m_settings.count(setting.first)) {
+                return false;
+            }
+        }
+        for (auto& setting : settings) {
+            m_settings[setting.first] = setting.second;
+        }
+        return true;
+    }
+
+    bool erase(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_writes;
+        return !m_failWrites && m_settings.erase(key) > 0;
+    }
+
+    bool clearDatabase() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_settings.clear();
+        return true;
+    }
+
+    /**
+     * Get the value of a setting.
+     *
+     * @param key The name of the setting.
+     * @return The value of the setting, or empty if it is not stored.
+     */
+    std::string get(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_settings.find(key);
+        return it == m_settings.end() ? "" : it->second;
+    }
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+    /// Whether the database is open.
+    bool m_isOpen;
+    /// The stored settings.
+    std::unordered_map<std::string, std::string> m_settings;
+    /// The number of calls to @c load().
+    int m_loads;
+    /// The number of calls to @c store(), @c modify(), @c modifyAll() and @c erase().
+    int m_writes;
+    /// Whether writes should fail.
+    bool m_failWrites;
+};
+
+/**
+ * Our GTest class.
+ */
+class CachedSettingStorageTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Wait until the fake storage holds a setting with a value.
+     *
+     * @param key The name of the setting.
+     * @param value The expected value.
+     * @return Whether the value was written before @c FLUSH_TIMEOUT.
+     */
+    bool waitForValue(const std::string& key, const std::string& value);
+
+    /// The storage behind the cache.
+    std::shared_ptr<FakeSettingStorage> m_storage;
+};
+
+void CachedSettingStorageTest::SetUp() {
+    m_storage = std::make_shared<FakeSettingStorage>();
+}
+
+bool CachedSettingStorageTest::waitForValue(const std::string& key, const std::string& value) {
+    auto deadline = std::chrono::steady_clock::now() + FLUSH_TIMEOUT;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (m_storage->get(key) == value) {
+            return true;
+        }
+        std::this_thread::sleep_for(SHORT_FLUSH_DELAY);
+    }
+    return false;
+}
+
+/**
+ * Verify that reads are served from memory once the settings have been loaded.
+ */
+TEST_F(CachedSettingStorageTest, readsFromMemory) {
+    m_storage->m_settings[LOCALE_KEY] = "en-US";
+    auto cache = CachedSettingStorage::create(m_storage, LONG_FLUSH_DELAY);
+    ASSERT_TRUE(cache);
+    ASSERT_TRUE(cache->open(DATABASE_PATH));
+    ASSERT_TRUE(cache->isOpen());
+    ASSERT_EQ(m_storage->m_loads, 1);
+
+    ASSERT_TRUE(cache->settingExists(LOCALE_KEY));
+    ASSERT_TRUE(cache->modify(LOCALE_KEY, "en-GB"));
+    std::unordered_map<std::string, std::string> settings;
+    ASSERT_TRUE(cache->load(&settings));
+    ASSERT_EQ(settings[LOCALE_KEY], "en-GB");
+    ASSERT_EQ(m_storage->m_loads, 1);
+    ASSERT_EQ(m_storage->get(LOCALE_KEY), "en-US");
+    cache->shutdown();
+}
+
+/**
+ * Verify that repeated changes to a setting are written once, with the last value.
+ */
+TEST_F(CachedSettingStorageTest, coalescesChanges) {
+    auto cache = CachedSettingStorage::create(m_storage, LONG_FLUSH_DELAY);
+    ASSERT_TRUE(cache->createDatabase(DATABASE_PATH));
+    ASSERT_TRUE(cache->store(LOCALE_KEY, "en-US"));
+    ASSERT_FALSE(cache->store(LOCALE_KEY, "en-US"));
+    ASSERT_TRUE(cache->modify(LOCALE_KEY, "en-GB"));
+    ASSERT_TRUE(cache->modify(LOCALE_KEY, "de-DE"));
+    ASSERT_TRUE(cache->flush());
+    ASSERT_EQ(m_storage->m_writes, 1);
+    ASSERT_EQ(m_storage->get(LOCALE_KEY), "de-DE");
+
+    // a setting stored and erased before a flush never reaches the storage
+    ASSERT_TRUE(cache->store("other", "value"));
+    ASSERT_TRUE(cache->erase("other"));
+    ASSERT_TRUE(cache->flush());
+    ASSERT_EQ(m_storage->m_writes, 1);
+    cache->shutdown();
+}
+
+/**
+ * Verify that the modified settings are written together, and that a batch with an unknown setting changes nothing.
+ */
+TEST_F(CachedSettingStorageTest, writesModifiedSettingsTogether) {
+    m_storage->m_settings[LOCALE_KEY] = "en-US";
+    m_storage->m_settings["wakeword"] = "Alexa";
+    auto cache = CachedSettingStorage::create(m_storage, LONG_FLUSH_DELAY);
+    ASSERT_TRUE(cache->open(DATABASE_PATH));
+    ASSERT_FALSE(cache->modifyAll({{LOCALE_KEY, "en-GB"}, {"unknown", "value"}}));
+    ASSERT_TRUE(cache->modifyAll({{LOCALE_KEY, "en-GB"}}));
+    ASSERT_TRUE(cache->modify("wakeword", "Computer"));
+    ASSERT_TRUE(cache->flush());
+    ASSERT_EQ(m_storage->m_writes, 1);
+    ASSERT_EQ(m_storage->get(LOCALE_KEY), "en-GB");
+    ASSERT_EQ(m_storage->get("wakeword"), "Computer");
+    cache->shutdown();
+}
+
+/**
+ * Verify that changes are written by themselves once the flush delay has elapsed.
+ */
+TEST_F(CachedSettingStorageTest, flushesAfterDelay) {
+    auto cache = CachedSettingStorage::create(m_storage, SHORT_FLUSH_DELAY);
+    ASSERT_TRUE(cache->createDatabase(DATABASE_PATH));
+    ASSERT_TRUE(cache->store(LOCALE_KEY, "en-US"));
+    ASSERT_TRUE(waitForValue(LOCALE_KEY, "en-US"));
+    ASSERT_TRUE(cache->modify(LOCALE_KEY, "en-GB"));
+    ASSERT_TRUE(waitForValue(LOCALE_KEY, "en-GB"));
+    cache->shutdown();
+}
+
+/**
+ * Verify that a change which could not be written is retried, and that shutting down writes the pending changes and
+ * makes later changes write through.
+ */
+TEST_F(CachedSettingStorageTest, retriesAndFlushesOnShutdown) {
+    auto cache = CachedSettingStorage::create(m_storage, LONG_FLUSH_DELAY);
+    ASSERT_TRUE(cache->createDatabase(DATABASE_PATH));
+    ASSERT_TRUE(cache->store(LOCALE_KEY, "en-US"));
+    m_storage->m_failWrites = true;
+    ASSERT_FALSE(cache->flush());
+    m_storage->m_failWrites = false;
+
+    cache->shutdown();
+    ASSERT_EQ(m_storage->get(LOCALE_KEY), "en-US");
+    ASSERT_TRUE(cache->modify(LOCALE_KEY, "en-GB"));
+    ASSERT_EQ(m_storage->get(LOCALE_KEY), "en-GB");
+}
+
+/**
+ * Verify that creating the cache without a storage fails.
+ */
+TEST_F(CachedSettingStorageTest, createWithoutStorage) {
+    ASSERT_FALSE(CachedSettingStorage::create(nullptr));
+}
+
+}  // namespace test
+}  // namespace settings
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
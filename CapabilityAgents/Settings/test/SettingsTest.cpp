@@ -80,6 +80,12 @@ static const std::string SETTINGS_KEY = "key";
 /// JSON value for the settings array's value.
 static const std::string SETTINGS_VALUE = "value";
 
+/// The event batching window of the @c Settings under test, short enough for a change to be sent within a second.
+static const std::chrono::milliseconds TEST_EVENT_BATCHING_WINDOW(100);
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::seconds LONG_TIMEOUT(5);
+
 /// JSON text for settings config values for initialization of settings Object.
 // clang-format off
 static const std::string SETTINGS_CONFIG_JSON =
@@ -220,7 +226,7 @@ void SettingsTest::SetUp() {
     m_settingsEventSender = SettingsUpdatedEventSender::create(m_mockMessageSender);
     ASSERT_NE(m_settingsEventSender, nullptr);
     m_storage = std::make_shared<SQLiteSettingStorage>();
-    m_settingsObject = Settings::create(m_storage, {m_settingsEventSender});
+    m_settingsObject = Settings::create(m_storage, {m_settingsEventSender}, TEST_EVENT_BATCHING_WINDOW);
     ASSERT_NE(m_settingsObject, nullptr);
     ASSERT_TRUE(m_storage->load(&m_mapOfSettings));
 }
@@ -262,6 +268,47 @@ TEST_F(SettingsTest, createTest) {
         m_settingsObject->create(m_storage, std::unordered_set<std::shared_ptr<GlobalSettingsObserverInterface>>()));
     ASSERT_EQ(nullptr, m_settingsObject->create(nullptr, {m_settingsEventSender}));
     ASSERT_EQ(nullptr, m_settingsObject->create(m_storage, {nullptr}));
+    ASSERT_EQ(nullptr, m_settingsObject->create(m_storage, {m_settingsEventSender}, std::chrono::milliseconds(-1)));
+}
+
+/**
+ * Test to verify that the changes made within the batching window are sent in a single SettingsUpdated event, with
+ * the last value of each setting, and that each change is reported as successful.
+ */
+TEST_F(SettingsTest, changesInBatchingWindowAreSentTogether) {
+    std::shared_ptr<MockSingleSettingObserver> localeObserver = std::make_shared<MockSingleSettingObserver>();
+    m_settingsObject->addSingleSettingObserver("locale", localeObserver);
+    EXPECT_CALL(*localeObserver, onSettingChanged("locale", "de-DE")).Times(1);
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .Times(1)
+        .WillOnce(Invoke([this](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            m_mapOfSettings["locale"] = "de-DE";
+            SettingsVerifyTest(m_mapOfSettings).verifyMessage(request);
+        }));
+
+    auto first = m_settingsObject->changeSetting("locale", "en-US");
+    auto second = m_settingsObject->changeSetting("locale", "de-DE");
+    ASSERT_EQ(first.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    ASSERT_EQ(second.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_TRUE(first.get());
+    EXPECT_TRUE(second.get());
+
+    std::unordered_map<std::string, std::string> storedSettings;
+    ASSERT_TRUE(m_storage->load(&storedSettings));
+    EXPECT_EQ(storedSettings["locale"], "de-DE");
+}
+
+/**
+ * Test to verify that an invalid change fails on its own, without holding up or failing the valid ones.
+ */
+TEST_F(SettingsTest, invalidChangeFailsAlone) {
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(1);
+    auto invalid = m_settingsObject->changeSetting("wakeword", "Alexa");
+    auto valid = m_settingsObject->changeSetting("locale", "en-US");
+    ASSERT_EQ(invalid.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_FALSE(invalid.get());
+    ASSERT_EQ(valid.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_TRUE(valid.get());
 }
 
 /**
@@ -387,6 +434,24 @@ TEST_F(SettingsTest, modifyDatabaseTest) {
     ASSERT_TRUE(m_storage->clearDatabase());
     ASSERT_FALSE(m_storage->settingExists("locale"));
 }
+
+/**
+ * Test to check that the modifyAll function of SQLiteSettingStorage class modifies either all the settings or none.
+ */
+TEST_F(SettingsTest, modifyAllDatabaseTest) {
+    ASSERT_TRUE(m_storage->store("wakeword", "Alexa"));
+    ASSERT_FALSE(m_storage->modifyAll({{"wakeword", "Computer"}, {"local", "en-US"}}));
+    std::unordered_map<std::string, std::string> loadedSettings;
+    ASSERT_TRUE(m_storage->load(&loadedSettings));
+    EXPECT_EQ(loadedSettings["wakeword"], "Alexa");
+
+    ASSERT_TRUE(m_storage->modifyAll({{"wakeword", "Computer"}, {"locale", "en-US"}}));
+    loadedSettings.clear();
+    ASSERT_TRUE(m_storage->load(&loadedSettings));
+    EXPECT_EQ(loadedSettings["wakeword"], "Computer");
+    EXPECT_EQ(loadedSettings["locale"], "en-US");
+}
+
 /**
  * Test to check the erase function of SQLiteSettingStorage class.
  */
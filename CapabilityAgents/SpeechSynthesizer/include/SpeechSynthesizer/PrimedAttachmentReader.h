@@ -0,0 +1,108 @@
+/*
+ * PrimedAttachmentReader.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SPEECH_SYNTHESIZER_INCLUDE_SPEECH_SYNTHESIZER_PRIMED_ATTACHMENT_READER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SPEECH_SYNTHESIZER_INCLUDE_SPEECH_SYNTHESIZER_PRIMED_ATTACHMENT_READER_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AVSCommon/AVS/Attachment/AttachmentReader.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace speechSynthesizer {
+
+/**
+ * An @c AttachmentReader through which a Speak's audio is set as the source of the player before it is known to be
+ * the next Speak to play.  An attachment only ever has one reader, and a player closes the reader of a source it
+ * replaces, so this reader keeps the attachment open until the Speak is committed to play from it, and keeps a copy
+ * of what it has read until then.  If another Speak plays first, @c release() hands the attachment on to a reader
+ * which reads that copy again before going on with the attachment.
+ */
+class PrimedAttachmentReader : public avsCommon::avs::attachment::AttachmentReader {
+public:
+    /**
+     * Create a @c PrimedAttachmentReader.
+     *
+     * @param reader The reader of the attachment.
+     * @return The @c PrimedAttachmentReader, or @c nullptr if @c reader is @c nullptr.
+     */
+    static std::shared_ptr<PrimedAttachmentReader> create(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader);
+
+    std::size_t read(
+        void* buf,
+        std::size_t numBytes,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
+
+    /**
+     * @inheritDoc
+     * The attachment is only closed once the Speak has been committed to play from this reader.
+     */
+    void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) override;
+
+    bool setDataAvailableCallback(std::function<void()> callback) override;
+
+    /// Commit the Speak to play from this reader, which then forgets its copy and closes the attachment when closed.
+    void commit();
+
+    /**
+     * Hand the attachment on to a reader which reads everything this one has read again, and then the rest of the
+     * attachment.  This reader reads nothing more.  Call this once the source which read this reader has been
+     * replaced, so that nothing it reads is lost.
+     *
+     * @return The reader to play the Speak from.
+     */
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> release();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param reader The reader of the attachment.
+     * @param replayBytes The bytes to read before the rest of the attachment, if the reader is not priming.
+     * @param isPriming Whether this reader keeps a copy of what it reads, and leaves the attachment open when closed.
+     */
+    PrimedAttachmentReader(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+        std::string replayBytes,
+        bool isPriming);
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The reader of the attachment, or @c nullptr once it has been released.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
+
+    /// The bytes read so far while priming, or the bytes left to read again otherwise.
+    std::string m_bytes;
+
+    /// How many of @c m_bytes have been read again.
+    std::size_t m_replayOffset;
+
+    /// Whether this reader is priming, rather than committed to play its Speak.
+    bool m_isPriming;
+};
+
+}  // namespace speechSynthesizer
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITY_AGENTS_SPEECH_SYNTHESIZER_INCLUDE_SPEECH_SYNTHESIZER_PRIMED_ATTACHMENT_READER_H_
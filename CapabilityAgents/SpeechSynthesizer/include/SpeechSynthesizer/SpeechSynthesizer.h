@@ -21,7 +21,6 @@
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_set>
 #include <deque>
 
 #include <AVSCommon/AVS/AVSDirective.h>
@@ -36,8 +35,11 @@
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerObserverInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
+#include <AVSCommon/Utils/Threading/CopyOnWriteSet.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
+#include "SpeechSynthesizer/PrimedAttachmentReader.h"
+
 namespace alexaClientSDK {
 namespace capabilityAgents {
 namespace speechSynthesizer {
@@ -146,7 +148,7 @@ private:
         std::string token;
 
         /// The @c AttachmentReader from which to read speech audio.
-        std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader;
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader;
 
         /// A flag to indicate if an event needs to be sent to AVS on playback finished.
         bool sendPlaybackFinishedMessage;
@@ -287,6 +289,15 @@ private:
      */
     static std::string buildPayload(std::string& token);
 
+    /**
+     * Set a pre-handled Speak directive's audio as the source of the player ahead of handling, if nothing else is
+     * using the player, so that handling it only has to start playback.  The audio is read through a
+     * @c PrimedAttachmentReader, so that the Speak can still play if another one is played before it.
+     *
+     * @param speakInfo The @c SpeakDirectiveInfo of the pre-handled directive.
+     */
+    void primeSource(std::shared_ptr<SpeakDirectiveInfo> speakInfo);
+
     /**
      * Start playing Speak directive audio.
      */
@@ -407,6 +418,15 @@ private:
      */
     void removeSpeakDirectiveInfo(const std::string& messageId);
 
+    /**
+     * Checks whether a Speak directive other than the current one has been pre-handled for a dialog, and so is
+     * expected to be handled next.
+     *
+     * @param dialogRequestId The dialogRequestId of the dialog.
+     * @return @c true if such a directive is waiting to be handled, else @c false.
+     */
+    bool hasPendingSpeakInDialog(const std::string& dialogRequestId);
+
     /// MediaPlayerInterface instance to send audio attachments to
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_speechPlayer;
 
@@ -423,7 +443,7 @@ private:
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManagerInterface> m_attachmentManager;
 
     /// The set of @c SpeechSynthesizerObserver instances to notify of state changes.
-    std::unordered_set<std::shared_ptr<SpeechSynthesizerObserver>> m_observers;
+    avsCommon::utils::threading::CopyOnWriteSet<std::shared_ptr<SpeechSynthesizerObserver>> m_observers;
 
     /**
      * The current state of the @c SpeechSynthesizer. @c m_mutex must be acquired before reading or writing the
@@ -443,6 +463,26 @@ private:
     /// @c SpeakDirectiveInfo instance for the @c AVSDirective currently being handled.
     std::shared_ptr<SpeakDirectiveInfo> m_currentInfo;
 
+    /**
+     * Whether the @c FOREGROUND focus was kept after a Speak finished, because the next Speak of the same dialog had
+     * already been pre-handled.  That Speak then starts playing as soon as it is handled, without releasing and
+     * re-acquiring the channel.  This is only accessed from the executor thread, and by @c doShutdown() once the
+     * executor has been shut down.
+     */
+    bool m_isHoldingFocusForNextSpeak;
+
+    /// The dialogRequestId of the dialog @c m_isHoldingFocusForNextSpeak holds the focus for.
+    std::string m_heldFocusDialogRequestId;
+
+    /**
+     * The pre-handled Speak directive whose audio is already set as the source of the player, if any.  This is only
+     * accessed from the executor thread.
+     */
+    std::shared_ptr<SpeakDirectiveInfo> m_primedInfo;
+
+    /// The reader the player reads @c m_primedInfo's audio through.  This is only accessed from the executor thread.
+    std::shared_ptr<PrimedAttachmentReader> m_primedReader;
+
     /// Mutex to serialize access to m_currentState, m_desiredState, and m_waitOnStateChange.
     std::mutex m_mutex;
 
@@ -0,0 +1,135 @@
+/*
+ * PrimedAttachmentReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "SpeechSynthesizer/PrimedAttachmentReader.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace speechSynthesizer {
+
+using namespace avsCommon::avs::attachment;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PrimedAttachmentReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<PrimedAttachmentReader> PrimedAttachmentReader::create(std::shared_ptr<AttachmentReader> reader) {
+    if (!reader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullptrReader"));
+        return nullptr;
+    }
+    return std::shared_ptr<PrimedAttachmentReader>(new PrimedAttachmentReader(std::move(reader), "", true));
+}
+
+PrimedAttachmentReader::PrimedAttachmentReader(
+    std::shared_ptr<AttachmentReader> reader,
+    std::string replayBytes,
+    bool isPriming) :
+        m_reader{std::move(reader)},
+        m_bytes{std::move(replayBytes)},
+        m_replayOffset{0},
+        m_isPriming{isPriming} {
+}
+
+std::size_t PrimedAttachmentReader::read(
+    void* buf,
+    std::size_t numBytes,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    if (!readStatus) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "read status is nullptr"));
+        return 0;
+    }
+    std::shared_ptr<AttachmentReader> reader;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_reader) {
+            *readStatus = ReadStatus::CLOSED;
+            return 0;
+        }
+        if (!m_isPriming && m_replayOffset < m_bytes.size()) {
+            auto count = std::min(numBytes, m_bytes.size() - m_replayOffset);
+            std::memcpy(buf, m_bytes.data() + m_replayOffset, count);
+            m_replayOffset += count;
+            if (m_bytes.size() == m_replayOffset) {
+                std::string().swap(m_bytes);
+                m_replayOffset = 0;
+            }
+            *readStatus = ReadStatus::OK;
+            return count;
+        }
+        reader = m_reader;
+    }
+    // A blocking read may wait for the writer, so it is not made under the lock.
+    auto count = reader->read(buf, numBytes, readStatus, timeoutMs);
+    if (count > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isPriming) {
+            m_bytes.append(static_cast<const char*>(buf), count);
+        }
+    }
+    return count;
+}
+
+void PrimedAttachmentReader::close(ClosePoint closePoint) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isPriming && m_reader) {
+        m_reader->close(closePoint);
+    }
+}
+
+bool PrimedAttachmentReader::setDataAvailableCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_reader && m_reader->setDataAvailableCallback(std::move(callback));
+}
+
+void PrimedAttachmentReader::commit() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isPriming = false;
+    std::string().swap(m_bytes);
+}
+
+std::shared_ptr<AttachmentReader> PrimedAttachmentReader::release() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_reader) {
+        ACSDK_ERROR(LX("releaseFailed").d("reason", "alreadyReleased"));
+        return nullptr;
+    }
+    ACSDK_DEBUG9(LX("release").d("replayBytes", m_bytes.size()));
+    // The source which registered a callback through this reader is gone.
+    m_reader->setDataAvailableCallback(std::function<void()>());
+    std::shared_ptr<AttachmentReader> released(
+        new PrimedAttachmentReader(std::move(m_reader), std::move(m_bytes), false));
+    m_reader.reset();
+    std::string().swap(m_bytes);
+    return released;
+}
+
+}  // namespace speechSynthesizer
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -19,8 +19,11 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <AVSCommon/AVS/EventBuilder.h>
+#include <AVSCommon/Utils/JSON/PayloadDecoder.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Metrics.h>
+#include <AVSCommon/Utils/Metrics/DialogLatencyTracer.h>
 
 #include "SpeechSynthesizer/SpeechSynthesizer.h"
 
@@ -61,11 +64,11 @@ static const std::string CHANNEL_NAME = FocusManagerInterface::DIALOG_CHANNEL_NA
 /// The activity Id used with the @c FocusManager by @c SpeechSynthesizer.
 static const std::string FOCUS_MANAGER_ACTIVITY_ID{"SpeechSynthesizer.Speak"};
 
-/// The name of the event to send to the AVS server once audio starting playing.
-static std::string SPEECH_STARTED_EVENT_NAME{"SpeechStarted"};
+/// The event to send to the AVS server once audio starting playing.
+static const EventTemplate SPEECH_STARTED{NAMESPACE, "SpeechStarted"};
 
-/// The name of the event to send to the AVS server once audio finishes playing.
-static std::string SPEECH_FINISHED_EVENT_NAME{"SpeechFinished"};
+/// The event to send to the AVS server once audio finishes playing.
+static const EventTemplate SPEECH_FINISHED{NAMESPACE, "SpeechFinished"};
 
 /// The key used to look up the "url" property in the directive payload.
 static const char KEY_URL[] = "url";
@@ -79,9 +82,28 @@ static const char KEY_FORMAT[] = "format";
 /// The expected format value in the directive payload.
 static const std::string FORMAT{"AUDIO_MPEG"};
 
+/// The format of the audio of speech for the media player, which follows from only accepting @c FORMAT.
+static const SourceFormat SPEECH_SOURCE_FORMAT = SourceFormat::MPEG;
+
 /// Prefix for content ID prefix in the url property of the directive payload.
 static const std::string CID_PREFIX{"cid:"};
 
+/// The properties of a Speak directive's payload.
+struct SpeakPayload {
+    /// The token of the speech.
+    std::string token;
+    /// The format of the speech.
+    std::string format;
+    /// The URL of the speech's attachment.
+    std::string url;
+};
+
+/// The schema of a Speak directive's payload.
+static constexpr json::jsonUtils::PayloadField<SpeakPayload> SPEAK_PAYLOAD_SCHEMA[] = {
+    {KEY_TOKEN, &SpeakPayload::token},
+    {KEY_FORMAT, &SpeakPayload::format},
+    {KEY_URL, &SpeakPayload::url}};
+
 /// The key for the "offsetInMilliseconds" property in the event context.
 static const char KEY_OFFSET_IN_MILLISECONDS[] = "offsetInMilliseconds";
 
@@ -142,12 +164,14 @@ avsCommon::avs::DirectiveHandlerConfiguration SpeechSynthesizer::getConfiguratio
 
 void SpeechSynthesizer::addObserver(std::shared_ptr<SpeechSynthesizerObserver> observer) {
     ACSDK_DEBUG9(LX("addObserver").d("observer", observer.get()));
-    m_executor.submit([this, observer]() { m_observers.insert(observer); });
+    m_observers.insert(observer);
 }
 
 void SpeechSynthesizer::removeObserver(std::shared_ptr<SpeechSynthesizerObserver> observer) {
     ACSDK_DEBUG9(LX("removeObserver").d("observer", observer.get()));
-    m_executor.submit([this, observer]() { m_observers.erase(observer); }).wait();
+    m_observers.erase(observer);
+    // Wait for any notification already on its way to the observer.
+    m_executor.submit([]() {}).wait();
 }
 
 void SpeechSynthesizer::onDeregistered() {
@@ -163,6 +187,8 @@ void SpeechSynthesizer::handleDirectiveImmediately(std::shared_ptr<avsCommon::av
 
 void SpeechSynthesizer::preHandleDirective(std::shared_ptr<DirectiveInfo> info) {
     ACSDK_DEBUG9(LX("preHandleDirective").d("messageId", info->directive->getMessageId()));
+    metrics::DialogLatencyTracer::instance().mark(
+        info->directive->getDialogRequestId(), metrics::DialogLatencyTracer::Mark::SPEAK_RECEIVED);
     m_executor.submit([this, info]() { executePreHandle(info); });
 }
 
@@ -268,22 +294,26 @@ SpeechSynthesizer::SpeechSynthesizer(
         m_attachmentManager{attachmentManager},
         m_currentState{SpeechSynthesizerObserver::SpeechSynthesizerState::FINISHED},
         m_desiredState{SpeechSynthesizerObserver::SpeechSynthesizerState::FINISHED},
-        m_currentFocus{FocusState::NONE} {
+        m_currentFocus{FocusState::NONE},
+        m_isHoldingFocusForNextSpeak{false} {
 }
 
 void SpeechSynthesizer::doShutdown() {
     ACSDK_DEBUG9(LX("doShutdown"));
     m_speechPlayer->setObserver(nullptr);
+    bool hasReleasedFocus = false;
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        if (SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING == m_currentState ||
-            SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING == m_desiredState) {
+        // While the focus is held between Speaks, the desired state stays PLAYING with no current Speak.
+        if (m_currentInfo && (SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING == m_currentState ||
+                              SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING == m_desiredState)) {
             m_desiredState = SpeechSynthesizerObserver::SpeechSynthesizerState::FINISHED;
             m_currentInfo->sendPlaybackFinishedMessage = false;
             stopPlaying();
             m_currentState = SpeechSynthesizerObserver::SpeechSynthesizerState::FINISHED;
             lock.unlock();
             releaseForegroundFocus();
+            hasReleasedFocus = true;
         }
     }
     {
@@ -297,6 +327,15 @@ void SpeechSynthesizer::doShutdown() {
         }
     }
     m_executor.shutdown();
+    // The focus is held and handed on between Speaks on the executor, so it is only checked once that has stopped.
+    if (m_isHoldingFocusForNextSpeak) {
+        m_isHoldingFocusForNextSpeak = false;
+        if (!hasReleasedFocus) {
+            releaseForegroundFocus();
+        }
+    }
+    m_primedInfo.reset();
+    m_primedReader.reset();
     m_speechPlayer.reset();
     m_waitOnStateChange.notify_one();
     m_messageSender.reset();
@@ -333,8 +372,14 @@ void SpeechSynthesizer::executePreHandleAfterValidation(std::shared_ptr<SpeakDir
         return;
     }
 
-    Document payload;
-    if (payload.Parse(speakInfo->directive->getPayload()).HasParseError()) {
+    SpeakPayload payload;
+    std::string missingKey;
+    if (!json::jsonUtils::decodePayload(
+            speakInfo->directive->getPayload(), SPEAK_PAYLOAD_SCHEMA, &payload, &missingKey)) {
+        if (!missingKey.empty()) {
+            sendExceptionEncounteredAndReportMissingProperty(speakInfo, missingKey);
+            return;
+        }
         const std::string message("unableToParsePayload" + speakInfo->directive->getMessageId());
         ACSDK_ERROR(
             LX("executePreHandleFailed").d("reason", message).d("messageId", speakInfo->directive->getMessageId()));
@@ -342,36 +387,20 @@ void SpeechSynthesizer::executePreHandleAfterValidation(std::shared_ptr<SpeakDir
             speakInfo, avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED, message);
         return;
     }
+    speakInfo->token = payload.token;
 
-    Value::ConstMemberIterator it = payload.FindMember(KEY_TOKEN);
-    if (payload.MemberEnd() == it) {
-        sendExceptionEncounteredAndReportMissingProperty(speakInfo, KEY_TOKEN);
-        return;
-    }
-    speakInfo->token = it->value.GetString();
-
-    it = payload.FindMember(KEY_FORMAT);
-    if (payload.MemberEnd() == it) {
-        sendExceptionEncounteredAndReportMissingProperty(speakInfo, KEY_FORMAT);
-        return;
-    }
-    std::string format = it->value.GetString();
-    if (format != FORMAT) {
-        const std::string message("unknownFormat " + speakInfo->directive->getMessageId() + " format " + format);
+    if (payload.format != FORMAT) {
+        const std::string message(
+            "unknownFormat " + speakInfo->directive->getMessageId() + " format " + payload.format);
         ACSDK_ERROR(LX("executePreHandleFailed")
                         .d("reason", "unknownFormat")
                         .d("messageId", speakInfo->directive->getMessageId())
-                        .d("format", format));
+                        .d("format", payload.format));
         sendExceptionEncounteredAndReportFailed(
             speakInfo, avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED, message);
     }
 
-    it = payload.FindMember(KEY_URL);
-    if (payload.MemberEnd() == it) {
-        sendExceptionEncounteredAndReportMissingProperty(speakInfo, KEY_URL);
-        return;
-    }
-    std::string urlValue = it->value.GetString();
+    const std::string& urlValue = payload.url;
     auto contentIdPosition = urlValue.find(CID_PREFIX);
     if (contentIdPosition != 0) {
         const std::string message("expectedCIDUrlPrefixNotFound");
@@ -394,11 +423,35 @@ void SpeechSynthesizer::executePreHandleAfterValidation(std::shared_ptr<SpeakDir
         ACSDK_ERROR(LX("executePreHandleFailed")
                         .d("reason", "prehandleCalledTwiceOnSameDirective")
                         .d("messageId", speakInfo->directive->getMessageId()));
+        return;
     }
+    primeSource(speakInfo);
 }
 
 void SpeechSynthesizer::executeHandleAfterValidation(std::shared_ptr<SpeakDirectiveInfo> speakInfo) {
     m_currentInfo = speakInfo;
+    if (m_isHoldingFocusForNextSpeak) {
+        m_isHoldingFocusForNextSpeak = false;
+        bool isForeground = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            isForeground = FocusState::FOREGROUND == m_currentFocus;
+            if (isForeground) {
+                m_desiredState = SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING;
+            }
+        }
+        if (isForeground) {
+            ACSDK_DEBUG9(LX("executeHandleAfterValidation")
+                             .d("reason", "focusHeld")
+                             .d("messageId", m_currentInfo->directive->getMessageId()));
+            m_currentInfo->sendPlaybackFinishedMessage = true;
+            m_currentInfo->sendCompletedMessage = true;
+            startPlaying();
+            return;
+        }
+        // The focus was lost while it was held, so start over with a fresh acquisition.
+        releaseForegroundFocus();
+    }
     if (!m_focusManager->acquireChannel(CHANNEL_NAME, shared_from_this(), FOCUS_MANAGER_ACTIVITY_ID)) {
         static const std::string message =
             std::string("Could not acquire ") + CHANNEL_NAME + " for " + FOCUS_MANAGER_ACTIVITY_ID;
@@ -449,6 +502,16 @@ void SpeechSynthesizer::executeCancel(std::shared_ptr<DirectiveInfo> info) {
             }
         }
         removeDirective(speakInfo->directive->getMessageId());
+        if (m_primedInfo == speakInfo) {
+            // The player keeps the source until it is replaced by the next Speak.  The primed reader leaves the
+            // attachment open then, and it is closed as the last reference to it goes.
+            m_primedInfo.reset();
+            m_primedReader.reset();
+        }
+        if (m_isHoldingFocusForNextSpeak && !hasPendingSpeakInDialog(m_heldFocusDialogRequestId)) {
+            m_isHoldingFocusForNextSpeak = false;
+            releaseForegroundFocus();
+        }
         return;
     }
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -521,15 +584,17 @@ void SpeechSynthesizer::executePlaybackStarted() {
         setCurrentStateLocked(SpeechSynthesizerObserver::SpeechSynthesizerState::PLAYING);
     }
     m_waitOnStateChange.notify_one();
+    metrics::DialogLatencyTracer::instance().mark(
+        m_currentInfo->directive->getDialogRequestId(), metrics::DialogLatencyTracer::Mark::FIRST_AUDIO);
     auto payload = buildPayload(m_currentInfo->token);
     if (payload.empty()) {
         ACSDK_ERROR(
             LX("executePlaybackStartedFailed").d("reason", "buildPayloadFailed").d("token", m_currentInfo->token));
         return;
     }
-    auto msgIdAndJsonEvent = buildJsonEventString(SPEECH_STARTED_EVENT_NAME, "", payload);
+    auto msgIdAndJsonEvent = SPEECH_STARTED.build("", payload);
 
-    auto request = std::make_shared<MessageRequest>(msgIdAndJsonEvent.second);
+    auto request = std::make_shared<MessageRequest>(std::move(msgIdAndJsonEvent.second));
     m_messageSender->sendMessage(request);
 }
 
@@ -539,12 +604,27 @@ void SpeechSynthesizer::executePlaybackFinished() {
         ACSDK_ERROR(LX("executePlaybackFinishedIgnored").d("reason", "nullptrDirectiveInfo"));
         return;
     }
+    metrics::DialogLatencyTracer::instance().mark(
+        m_currentInfo->directive->getDialogRequestId(), metrics::DialogLatencyTracer::Mark::SPEECH_FINISHED);
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         setCurrentStateLocked(SpeechSynthesizerObserver::SpeechSynthesizerState::FINISHED);
     }
     m_waitOnStateChange.notify_one();
-    releaseForegroundFocus();
+    // Keep the focus for the next Speak of the same dialog if it has already arrived, so that it starts playing
+    // without a gap.
+    auto dialogRequestId = m_currentInfo->directive->getDialogRequestId();
+    bool isForeground = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        isForeground = FocusState::FOREGROUND == m_currentFocus;
+    }
+    if (m_currentInfo->sendPlaybackFinishedMessage && isForeground && hasPendingSpeakInDialog(dialogRequestId)) {
+        m_isHoldingFocusForNextSpeak = true;
+        m_heldFocusDialogRequestId = dialogRequestId;
+    } else {
+        releaseForegroundFocus();
+    }
     if (m_currentInfo->sendPlaybackFinishedMessage) {
         auto payload = buildPayload(m_currentInfo->token);
         if (payload.empty()) {
@@ -552,9 +632,9 @@ void SpeechSynthesizer::executePlaybackFinished() {
                             .d("reason", "buildPayloadFailed")
                             .d("messageId", m_currentInfo->directive->getMessageId()));
         } else {
-            auto msgIdAndJsonEvent = buildJsonEventString(SPEECH_FINISHED_EVENT_NAME, "", payload);
+            auto msgIdAndJsonEvent = SPEECH_FINISHED.build("", payload);
 
-            auto request = std::make_shared<MessageRequest>(msgIdAndJsonEvent.second);
+            auto request = std::make_shared<MessageRequest>(std::move(msgIdAndJsonEvent.second));
             m_messageSender->sendMessage(request);
         }
     }
@@ -622,9 +702,47 @@ std::string SpeechSynthesizer::buildPayload(std::string& token) {
     return buffer.GetString();
 }
 
+void SpeechSynthesizer::primeSource(std::shared_ptr<SpeakDirectiveInfo> speakInfo) {
+    if (m_currentInfo || m_primedInfo || !speakInfo->attachmentReader) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (SpeechSynthesizerObserver::SpeechSynthesizerState::FINISHED != m_currentState) {
+            return;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_speakInfoQueueMutex);
+        if (!m_speakInfoQueue.empty()) {
+            return;
+        }
+    }
+    auto primedReader = PrimedAttachmentReader::create(speakInfo->attachmentReader);
+    if (MediaPlayerStatus::FAILURE == m_speechPlayer->setSource(primedReader, SPEECH_SOURCE_FORMAT)) {
+        // The failed source has left the attachment open, so the Speak is set up as usual when it is handled.
+        ACSDK_WARN(LX("primeSourceFailed").d("messageId", speakInfo->directive->getMessageId()));
+        return;
+    }
+    ACSDK_DEBUG9(LX("primeSource").d("messageId", speakInfo->directive->getMessageId()));
+    m_primedInfo = speakInfo;
+    m_primedReader = primedReader;
+}
+
 void SpeechSynthesizer::startPlaying() {
     ACSDK_DEBUG9(LX("startPlaying"));
-    m_speechPlayer->setSource(std::move(m_currentInfo->attachmentReader));
+    if (m_primedInfo == m_currentInfo) {
+        m_primedReader->commit();
+    } else {
+        m_speechPlayer->setSource(std::move(m_currentInfo->attachmentReader), SPEECH_SOURCE_FORMAT);
+        if (m_primedInfo) {
+            // The replaced source left the attachment open, and the primed Speak reads what it had read again.
+            ACSDK_DEBUG9(LX("startPlaying").d("releasedPrime", m_primedInfo->directive->getMessageId()));
+            m_primedInfo->attachmentReader = m_primedReader->release();
+        }
+    }
+    m_primedInfo.reset();
+    m_primedReader.reset();
     auto mediaPlayerStatus = m_speechPlayer->play();
     switch (mediaPlayerStatus) {
         case MediaPlayerStatus::SUCCESS:
@@ -654,7 +772,8 @@ void SpeechSynthesizer::setCurrentStateLocked(SpeechSynthesizerObserver::SpeechS
     executeProvideState(m_currentState, 0);
     // Don't allow any slow observers to block our caller.
     m_executor.submit([this]() {
-        for (auto observer : m_observers) {
+        auto observers = m_observers.snapshot();
+        for (const auto& observer : *observers) {
             observer->onStateChanged(m_currentState);
         }
     });
@@ -776,6 +895,19 @@ void SpeechSynthesizer::removeSpeakDirectiveInfo(const std::string& messageId) {
     m_speakDirectiveInfoMap.erase(messageId);
 }
 
+bool SpeechSynthesizer::hasPendingSpeakInDialog(const std::string& dialogRequestId) {
+    if (dialogRequestId.empty()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_speakDirectiveInfoMutex);
+    for (const auto& entry : m_speakDirectiveInfoMap) {
+        if (entry.second != m_currentInfo && entry.second->directive->getDialogRequestId() == dialogRequestId) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void SpeechSynthesizer::addToDirectiveQueue(std::shared_ptr<SpeakDirectiveInfo> speakInfo) {
     std::lock_guard<std::mutex> lock(m_speakInfoQueueMutex);
     if (m_speakInfoQueue.empty()) {
@@ -18,6 +18,7 @@
 #include <chrono>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -92,6 +93,15 @@ static const std::string CONTEXT_ID_TEST("ContextId_Test");
 /// Context ID for testing
 static const std::string CONTEXT_ID_TEST_2("ContextId_Test_2");
 
+/// The content id of @c URL_TEST.
+static const std::string CONTENT_ID_TEST("Test");
+
+/// The audio of a Speak, for testing.
+static const std::string AUDIO_TEST("Speak audio for testing");
+
+/// How many bytes of its audio the source of a Speak reads ahead, when it is set before the Speak plays.
+static const size_t PRIMED_BYTES_TEST = 8;
+
 /// A payload for testing
 // clang-format off
 static const std::string PAYLOAD_TEST =
@@ -516,7 +526,9 @@ void SpeechSynthesizerTest::SetUp() {
 }
 
 void SpeechSynthesizerTest::TearDown() {
-    m_speechSynthesizer->shutdown();
+    if (!m_speechSynthesizer->isShutdown()) {
+        m_speechSynthesizer->shutdown();
+    }
 }
 
 SetStateResult SpeechSynthesizerTest::wakeOnSetState() {
@@ -834,6 +846,212 @@ TEST_F(SpeechSynthesizerTest, testBargeInWhilePlaying) {
     ASSERT_TRUE(std::future_status::ready == m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
 }
 
+/**
+ * Testing back-to-back Speak directives of the same dialog.
+ * Pre-handle two Speak directives, then handle the first.  Once it finishes playing, handle the second.  Expect the
+ * focus to be acquired and released only once, and the second Speak to start playing without waiting for a focus
+ * change.
+ */
+TEST_F(SpeechSynthesizerTest, testConsecutiveSpeaksKeepFocus) {
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+    auto avsMessageHeader2 = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST_2, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive2 =
+        AVSDirective::create("", avsMessageHeader2, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    std::unique_ptr<MockDirectiveHandlerResult> mockDirHandlerResult2(new MockDirectiveHandlerResult);
+
+    std::promise<void> secondPlayPromise;
+    std::future<void> secondPlayFuture = secondPlayPromise.get_future();
+    int playCount = 0;
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnAcquireChannel));
+    EXPECT_CALL(
+        *(m_mockSpeechPlayer.get()), setSource(A<std::shared_ptr<avsCommon::avs::attachment::AttachmentReader>>()))
+        .Times(2);
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), play()).Times(2).WillRepeatedly(InvokeWithoutArgs([&]() {
+        m_speechSynthesizer->onPlaybackStarted();
+        if (2 == ++playCount) {
+            secondPlayPromise.set_value();
+        }
+        return MediaPlayerStatus::SUCCESS;
+    }));
+    EXPECT_CALL(*(m_mockDirHandlerResult.get()), setCompleted())
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnSetCompleted));
+    EXPECT_CALL(*(m_mockFocusManager.get()), releaseChannel(CHANNEL_NAME, _))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnReleaseChannel));
+
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive, std::move(m_mockDirHandlerResult));
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive2, std::move(mockDirHandlerResult2));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(std::future_status::ready == m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onFocusChanged(FocusState::FOREGROUND);
+    m_speechSynthesizer->onPlaybackFinished();
+    ASSERT_TRUE(std::future_status::ready == m_wakeSetCompletedFuture.wait_for(WAIT_TIMEOUT));
+    ASSERT_FALSE(std::future_status::ready == m_wakeReleaseChannelFuture.wait_for(std::chrono::milliseconds::zero()));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+    ASSERT_TRUE(std::future_status::ready == secondPlayFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onPlaybackFinished();
+    ASSERT_TRUE(std::future_status::ready == m_wakeReleaseChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onFocusChanged(FocusState::NONE);
+}
+
+/**
+ * Testing shutdown while the focus is held between Speaks of the same dialog.
+ * Pre-handle two Speak directives, then handle the first and let it finish, so that the focus is kept for the second.
+ * Shut down before the second is handled, and expect the held focus to be released exactly once.
+ */
+TEST_F(SpeechSynthesizerTest, testShutdownWhileHoldingFocus) {
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+    auto avsMessageHeader2 = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST_2, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive2 =
+        AVSDirective::create("", avsMessageHeader2, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    std::unique_ptr<MockDirectiveHandlerResult> mockDirHandlerResult2(new MockDirectiveHandlerResult);
+
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnAcquireChannel));
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), play()).Times(1).WillOnce(InvokeWithoutArgs([this]() {
+        m_speechSynthesizer->onPlaybackStarted();
+        return MediaPlayerStatus::SUCCESS;
+    }));
+    EXPECT_CALL(*(m_mockDirHandlerResult.get()), setCompleted())
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnSetCompleted));
+    EXPECT_CALL(*(m_mockFocusManager.get()), releaseChannel(CHANNEL_NAME, _))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnReleaseChannel));
+
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive, std::move(m_mockDirHandlerResult));
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive2, std::move(mockDirHandlerResult2));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(std::future_status::ready == m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onFocusChanged(FocusState::FOREGROUND);
+    m_speechSynthesizer->onPlaybackFinished();
+    ASSERT_TRUE(std::future_status::ready == m_wakeSetCompletedFuture.wait_for(WAIT_TIMEOUT));
+    ASSERT_FALSE(std::future_status::ready == m_wakeReleaseChannelFuture.wait_for(std::chrono::milliseconds::zero()));
+
+    m_speechSynthesizer->shutdown();
+    ASSERT_TRUE(std::future_status::ready == m_wakeReleaseChannelFuture.wait_for(std::chrono::milliseconds::zero()));
+}
+
+/**
+ * Testing that a Speak whose audio was set as the source during pre-handling still plays all of it after another
+ * Speak is played first.  Pre-handle Speak A, whose source reads some of its audio ahead, then pre-handle Speak B and
+ * play it, which replaces and closes A's source.  Then play A, and expect its source to read the whole audio.
+ */
+TEST_F(SpeechSynthesizerTest, testPrimedSpeakPlaysAfterAnother) {
+    auto writer =
+        m_attachmentManager->createWriter(m_attachmentManager->generateAttachmentId(CONTEXT_ID_TEST, CONTENT_ID_TEST));
+    ASSERT_TRUE(writer);
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    ASSERT_EQ(AUDIO_TEST.size(), writer->write(AUDIO_TEST.data(), AUDIO_TEST.size(), &writeStatus));
+    writer->close();
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+    std::unique_ptr<MockDirectiveHandlerResult> mockDirHandlerResult(new MockDirectiveHandlerResult);
+    auto avsMessageHeader2 = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST_2, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive2 =
+        AVSDirective::create("", avsMessageHeader2, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+
+    std::vector<std::shared_ptr<AttachmentReader>> sources;
+    std::promise<void> thirdSourcePromise;
+    std::future<void> thirdSourceFuture = thirdSourcePromise.get_future();
+    EXPECT_CALL(
+        *(m_mockSpeechPlayer.get()), setSource(A<std::shared_ptr<avsCommon::avs::attachment::AttachmentReader>>()))
+        .Times(3)
+        .WillRepeatedly(Invoke([&](std::shared_ptr<AttachmentReader> reader) {
+            // A player closes the reader of the source it replaces.
+            if (!sources.empty()) {
+                sources.back()->close();
+            }
+            sources.push_back(reader);
+            if (1 == sources.size()) {
+                char buf[PRIMED_BYTES_TEST];
+                auto readStatus = AttachmentReader::ReadStatus::OK;
+                reader->read(buf, sizeof(buf), &readStatus);
+            } else if (3 == sources.size()) {
+                thirdSourcePromise.set_value();
+            }
+            return MediaPlayerStatus::SUCCESS;
+        }));
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnAcquireChannel));
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), play()).Times(2).WillRepeatedly(InvokeWithoutArgs([this]() {
+        m_speechSynthesizer->onPlaybackStarted();
+        return MediaPlayerStatus::SUCCESS;
+    }));
+    EXPECT_CALL(*(m_mockDirHandlerResult.get()), setCompleted())
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnSetCompleted));
+
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive, std::move(mockDirHandlerResult));
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive2, std::move(m_mockDirHandlerResult));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+    ASSERT_TRUE(std::future_status::ready == m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onFocusChanged(FocusState::FOREGROUND);
+    m_speechSynthesizer->onPlaybackFinished();
+    ASSERT_TRUE(std::future_status::ready == m_wakeSetCompletedFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(std::future_status::ready == thirdSourceFuture.wait_for(WAIT_TIMEOUT));
+
+    std::string audio;
+    char buf[PRIMED_BYTES_TEST];
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    while (AttachmentReader::ReadStatus::OK == readStatus) {
+        auto count = sources.back()->read(buf, sizeof(buf), &readStatus);
+        audio.append(buf, count);
+    }
+    EXPECT_EQ(AUDIO_TEST, audio);
+}
+
+/**
+ * Testing that the audio of a Speak directive is set as the source of the player when it is pre-handled.
+ * Call preHandle with a valid SPEAK directive and expect @c setSource to be called before handleDirective.  Then handle
+ * it and expect audio to play without the source being set again.
+ */
+TEST_F(SpeechSynthesizerTest, testSourceSetDuringPreHandle) {
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+
+    std::promise<void> setSourcePromise;
+    std::future<void> setSourceFuture = setSourcePromise.get_future();
+    EXPECT_CALL(
+        *(m_mockSpeechPlayer.get()), setSource(A<std::shared_ptr<avsCommon::avs::attachment::AttachmentReader>>()))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([&setSourcePromise]() {
+            setSourcePromise.set_value();
+            return MediaPlayerStatus::SUCCESS;
+        }));
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnAcquireChannel));
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), play()).Times(1);
+
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive, std::move(m_mockDirHandlerResult));
+    ASSERT_TRUE(std::future_status::ready == setSourceFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(std::future_status::ready == m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onFocusChanged(FocusState::FOREGROUND);
+    ASSERT_TRUE(m_mockSpeechPlayer->waitUntilPlaybackStarted());
+}
+
 }  // namespace test
 }  // namespace speechSynthesizer
 }  // namespace capabilityAgents
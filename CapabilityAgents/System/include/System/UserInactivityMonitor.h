@@ -21,13 +21,17 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 
 #include <AVSCommon/AVS/CapabilityAgent.h>
+#include <AVSCommon/Utils/Timing/Clock.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h>
 #include <AVSCommon/SDKInterfaces/UserActivityNotifierInterface.h>
+#include <AVSCommon/SDKInterfaces/UserInactivityObserverInterface.h>
 
 namespace alexaClientSDK {
 namespace capabilityAgents {
@@ -44,12 +48,30 @@ public:
      * @param messageSender The @c MessageSenderInterface for sending events.
      * @param exceptionEncounteredSender The interface that sends exceptions.
      * @param sendPeriod The period of send events in seconds.
+     * @param inactivityTimeout How long the user must be inactive before the observers are notified.
      * @return @c nullptr if the inputs are not defined, else a new instance of @c UserInactivityMonitor.
      */
     static std::shared_ptr<UserInactivityMonitor> create(
         std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-        const std::chrono::milliseconds& sendPeriod = std::chrono::hours(1));
+        const std::chrono::milliseconds& sendPeriod = std::chrono::hours(1),
+        const std::chrono::milliseconds& inactivityTimeout = std::chrono::minutes(10));
+
+    /**
+     * Add an observer to be notified once the user has been inactive for longer than the inactivity timeout, and
+     * again when the user becomes active.  Inactivity is only checked once per timeout, so that an idle device is not
+     * woken up more often, and is noticed up to twice the timeout after the last activity.
+     *
+     * @param observer The observer to add.
+     */
+    void addObserver(std::shared_ptr<avsCommon::sdkInterfaces::UserInactivityObserverInterface> observer);
+
+    /**
+     * Remove an observer.
+     *
+     * @param observer The observer to remove.
+     */
+    void removeObserver(std::shared_ptr<avsCommon::sdkInterfaces::UserInactivityObserverInterface> observer);
 
     /// @name DirectiveHandlerInterface and CapabilityAgent Functions
     /// @{
@@ -71,11 +93,13 @@ private:
      * @param messageSender The @c MessageSenderInterface for sending events.
      * @param exceptionEncounteredSender The interface that sends exceptions.
      * @param sendPeriod The period of send events in seconds.
+     * @param inactivityTimeout How long the user must be inactive before the observers are notified.
      */
     UserInactivityMonitor(
         std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-        const std::chrono::milliseconds& sendPeriod);
+        const std::chrono::milliseconds& sendPeriod,
+        const std::chrono::milliseconds& inactivityTimeout);
 
     /**
      *
@@ -93,23 +117,52 @@ private:
     /// Send inactivity report by comparing to the last time active. We will register this function with the timer.
     void sendInactivityReport();
 
+    /**
+     * Get how long the user has been inactive.
+     *
+     * @return The time since the user was last active.
+     */
+    std::chrono::steady_clock::duration getInactiveTime() const;
+
+    /// Notify the observers if the user has just been inactive for longer than @c m_inactivityTimeout.
+    void checkInactivity();
+
+    /**
+     * Get a copy of the observers, so that they are notified without holding @c m_observerMutex.
+     *
+     * @return The observers.
+     */
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::UserInactivityObserverInterface>> getObservers();
+
     /// The @c MessageSender interface to send inactivity event.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
 
+    /// The clock the inactive time is measured with, which is the default when the monitor is created.
+    const std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
     /**
-     * Time point to keep user inactivity. Access synchronized by @c m_timeMutex, and blocks tracked by @c
-     * m_recentUpdateBlocked.
+     * The last time the user was active, as a count of @c m_clock ticks since its epoch.  This is
+     * updated on every directive and interaction, so it is an atomic rather than guarded by a mutex.
      */
-    std::chrono::time_point<std::chrono::steady_clock> m_lastTimeActive;
+    std::atomic<std::chrono::steady_clock::rep> m_lastTimeActive;
+
+    /// How long the user must be inactive before the observers are notified.
+    const std::chrono::milliseconds m_inactivityTimeout;
 
-    /// Time point synchronizer mutex.
-    std::mutex m_timeMutex;
+    /// Whether the observers have been told the user is inactive, and not yet that the user is active again.
+    std::atomic<bool> m_isInactive;
 
-    /// Flag for notifiying that @c onUserActive was not able to update @c m_lastTimeActive.
-    std::atomic_bool m_recentUpdateBlocked;
+    /// Serializes access to @c m_observers.
+    std::mutex m_observerMutex;
+
+    /// The observers of user inactivity.
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::UserInactivityObserverInterface>> m_observers;
 
     /// Timer for sending events every hour.
     avsCommon::utils::timing::Timer m_eventTimer;
+
+    /// Timer checking for inactivity once per @c m_inactivityTimeout, started when the first observer is added.
+    avsCommon::utils::timing::Timer m_inactivityTimer;
 };
 
 }  // namespace system
@@ -20,7 +20,7 @@
 #include <string>
 #include <rapidjson/document.h>
 
-#include <AVSCommon/Utils/JSON/JSONUtils.h>
+#include <AVSCommon/Utils/JSON/PayloadDecoder.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 namespace alexaClientSDK {
@@ -49,7 +49,17 @@ static const std::string ENDPOINTING_NAMESPACE = "System";
 static const std::string ENDPOINTING_NAME = "SetEndpoint";
 
 /// This string holds the key for the endpoint in the payload.
-static const std::string ENDPOINT_PAYLOAD_KEY = "endpoint";
+static const char ENDPOINT_PAYLOAD_KEY[] = "endpoint";
+
+/// The properties of a SetEndpoint directive's payload.
+struct SetEndpointPayload {
+    /// The URL of the new endpoint.
+    std::string endpoint;
+};
+
+/// The schema of a SetEndpoint directive's payload.
+static constexpr jsonUtils::PayloadField<SetEndpointPayload> SET_ENDPOINT_PAYLOAD_SCHEMA[] = {
+    {ENDPOINT_PAYLOAD_KEY, &SetEndpointPayload::endpoint}};
 
 void EndpointHandler::removeDirectiveGracefully(
     std::shared_ptr<avsCommon::avs::CapabilityAgent::DirectiveInfo> info,
@@ -107,12 +117,12 @@ void EndpointHandler::handleDirective(std::shared_ptr<avsCommon::avs::Capability
         ACSDK_ERROR(LX("handleDirectiveFailed").d("reason", "nullDirectiveInDirectiveInfo"));
         return;
     }
-    std::string newEndpoint;
-    if (!jsonUtils::lookupStringValue(info->directive->getPayload(), ENDPOINT_PAYLOAD_KEY, &newEndpoint)) {
+    SetEndpointPayload payload;
+    if (!jsonUtils::decodePayload(info->directive->getPayload(), SET_ENDPOINT_PAYLOAD_SCHEMA, &payload)) {
         ACSDK_ERROR(LX("handleDirectiveFailed").d("reason", "payloadMissingEndpointKey"));
         removeDirectiveGracefully(info, true, "payloadMissingEndpointKey");
     } else {
-        m_avsEndpointAssigner->setAVSEndpoint(newEndpoint);
+        m_avsEndpointAssigner->setAVSEndpoint(payload.endpoint);
         removeDirectiveGracefully(info);
     }
 }
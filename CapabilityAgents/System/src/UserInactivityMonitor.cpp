@@ -18,12 +18,8 @@
 #include "System/UserInactivityMonitor.h"
 
 #include <functional>
-#include <rapidjson/document.h>
-#include <rapidjson/pointer.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
 
-#include <AVSCommon/Utils/JSON/JSONUtils.h>
+#include <AVSCommon/AVS/EventBuilder.h>
 
 namespace alexaClientSDK {
 namespace capabilityAgents {
@@ -32,8 +28,6 @@ namespace system {
 using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::avs;
 using namespace avsCommon::utils::timing;
-using namespace avsCommon::utils::json;
-using namespace rapidjson;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("UserInactivityMonitor");
@@ -51,8 +45,14 @@ static const std::string USER_INACTIVITY_MONITOR_NAMESPACE = "System";
 /// String to identify the AVS name of the event we send.
 static const std::string INACTIVITY_EVENT_NAME = "UserInactivityReport";
 
-/// String to identify the key of the payload associated to the inactivity.
-static const std::string INACTIVITY_EVENT_PAYLOAD_KEY = "inactiveTimeInSeconds";
+/// The start of the event payload, up to the inactive time.
+static const std::string INACTIVITY_EVENT_PAYLOAD_PREFIX = "{\"inactiveTimeInSeconds\":";
+
+/// The end of the event payload, after the inactive time.
+static const std::string INACTIVITY_EVENT_PAYLOAD_SUFFIX = "}";
+
+/// The pre-serialized skeleton of the event we send.
+static const EventTemplate INACTIVITY_EVENT{USER_INACTIVITY_MONITOR_NAMESPACE, INACTIVITY_EVENT_NAME};
 
 /// String to identify the AVS name of the directive we receive.
 static const std::string RESET_DIRECTIVE_NAME = "ResetUserInactivity";
@@ -78,7 +78,8 @@ void UserInactivityMonitor::removeDirectiveGracefully(
 std::shared_ptr<UserInactivityMonitor> UserInactivityMonitor::create(
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-    const std::chrono::milliseconds& sendPeriod) {
+    const std::chrono::milliseconds& sendPeriod,
+    const std::chrono::milliseconds& inactivityTimeout) {
     if (!messageSender) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullMessageSender"));
         return nullptr;
@@ -87,17 +88,25 @@ std::shared_ptr<UserInactivityMonitor> UserInactivityMonitor::create(
         ACSDK_ERROR(LX("createFailed").d("reason", "nullExceptionEncounteredSender"));
         return nullptr;
     }
+    if (inactivityTimeout <= std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidInactivityTimeout"));
+        return nullptr;
+    }
     return std::shared_ptr<UserInactivityMonitor>(
-        new UserInactivityMonitor(messageSender, exceptionEncounteredSender, sendPeriod));
+        new UserInactivityMonitor(messageSender, exceptionEncounteredSender, sendPeriod, inactivityTimeout));
 }
 
 UserInactivityMonitor::UserInactivityMonitor(
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-    const std::chrono::milliseconds& sendPeriod) :
+    const std::chrono::milliseconds& sendPeriod,
+    const std::chrono::milliseconds& inactivityTimeout) :
         CapabilityAgent(USER_INACTIVITY_MONITOR_NAMESPACE, exceptionEncounteredSender),
         m_messageSender{messageSender},
-        m_lastTimeActive{std::chrono::steady_clock::now()} {
+        m_clock{avsCommon::utils::timing::Clock::getDefault()},
+        m_lastTimeActive{m_clock->now().time_since_epoch().count()},
+        m_inactivityTimeout{inactivityTimeout},
+        m_isInactive{false} {
     m_eventTimer.start(
         sendPeriod,
         Timer::PeriodType::ABSOLUTE,
@@ -105,30 +114,62 @@ UserInactivityMonitor::UserInactivityMonitor(
         std::bind(&UserInactivityMonitor::sendInactivityReport, this));
 }
 
-void UserInactivityMonitor::sendInactivityReport() {
-    std::chrono::time_point<std::chrono::steady_clock> lastTimeActive;
-    m_recentUpdateBlocked = false;
-    {
-        std::lock_guard<std::mutex> timeLock(m_timeMutex);
-        lastTimeActive = m_lastTimeActive;
+void UserInactivityMonitor::addObserver(std::shared_ptr<UserInactivityObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("addObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_observerMutex);
+    m_observers.insert(observer);
+    if (!m_inactivityTimer.isActive()) {
+        m_inactivityTimer.start(
+            m_inactivityTimeout,
+            Timer::PeriodType::ABSOLUTE,
+            Timer::FOREVER,
+            std::bind(&UserInactivityMonitor::checkInactivity, this));
+    }
+}
+
+void UserInactivityMonitor::removeObserver(std::shared_ptr<UserInactivityObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("removeObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_observerMutex);
+    m_observers.erase(observer);
+}
+
+std::chrono::steady_clock::duration UserInactivityMonitor::getInactiveTime() const {
+    std::chrono::steady_clock::time_point lastTimeActive{
+        std::chrono::steady_clock::duration{m_lastTimeActive.load(std::memory_order_relaxed)}};
+    return m_clock->now() - lastTimeActive;
+}
+
+void UserInactivityMonitor::checkInactivity() {
+    if (m_isInactive || getInactiveTime() < m_inactivityTimeout || m_isInactive.exchange(true)) {
+        return;
+    }
+    // The user may have become active while this was checked, in which case nobody would tell the observers.
+    if (getInactiveTime() < m_inactivityTimeout) {
+        m_isInactive = false;
+        return;
     }
-    if (m_recentUpdateBlocked) {
-        std::lock_guard<std::mutex> timeLock(m_timeMutex);
-        m_lastTimeActive = std::chrono::steady_clock::now();
-        lastTimeActive = m_lastTimeActive;
+    ACSDK_INFO(LX("userInactive").d("timeoutMs", m_inactivityTimeout.count()));
+    for (auto observer : getObservers()) {
+        observer->onUserInactive();
     }
+}
+
+std::unordered_set<std::shared_ptr<UserInactivityObserverInterface>> UserInactivityMonitor::getObservers() {
+    std::lock_guard<std::mutex> lock(m_observerMutex);
+    return m_observers;
+}
 
-    Document inactivityPayload(kObjectType);
-    SizeType payloadKeySize = INACTIVITY_EVENT_PAYLOAD_KEY.length();
-    const Pointer::Token payloadKey[] = {{INACTIVITY_EVENT_PAYLOAD_KEY.c_str(), payloadKeySize, kPointerInvalidIndex}};
-    auto inactiveTime =
-        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - lastTimeActive);
-    Pointer(payloadKey, 1).Set(inactivityPayload, inactiveTime.count());
-    std::string inactivityPayloadString;
-    jsonUtils::convertToValue(inactivityPayload, &inactivityPayloadString);
-
-    auto inactivityEvent = buildJsonEventString(INACTIVITY_EVENT_NAME, "", inactivityPayloadString);
-    m_messageSender->sendMessage(std::make_shared<MessageRequest>(inactivityEvent.second));
+void UserInactivityMonitor::sendInactivityReport() {
+    auto inactiveTime = std::chrono::duration_cast<std::chrono::seconds>(getInactiveTime());
+    auto inactivityEvent = INACTIVITY_EVENT.build(
+        "", INACTIVITY_EVENT_PAYLOAD_PREFIX + std::to_string(inactiveTime.count()) + INACTIVITY_EVENT_PAYLOAD_SUFFIX);
+    m_messageSender->sendMessage(std::make_shared<MessageRequest>(std::move(inactivityEvent.second)));
 }
 
 DirectiveHandlerConfiguration UserInactivityMonitor::getConfiguration() const {
@@ -158,11 +199,13 @@ void UserInactivityMonitor::cancelDirective(std::shared_ptr<CapabilityAgent::Dir
 }
 
 void UserInactivityMonitor::onUserActive() {
-    std::unique_lock<std::mutex> timeLock(m_timeMutex, std::defer_lock);
-    if (timeLock.try_lock()) {
-        m_lastTimeActive = std::chrono::steady_clock::now();
-    } else {
-        m_recentUpdateBlocked = true;
+    m_lastTimeActive.store(m_clock->now().time_since_epoch().count(), std::memory_order_relaxed);
+    // This is called on every interaction, so the flag is only written when the observers were told of inactivity.
+    if (m_isInactive.load(std::memory_order_relaxed) && m_isInactive.exchange(false)) {
+        ACSDK_INFO(LX("userActiveAgain"));
+        for (auto observer : getObservers()) {
+            observer->onUserActiveAgain();
+        }
     }
 }
 
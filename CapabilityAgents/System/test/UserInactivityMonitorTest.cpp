@@ -17,6 +17,9 @@
 
 /// @file UserInactivityMonitorTest.cpp
 
+#include <future>
+
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
@@ -56,6 +59,16 @@ static const std::string USER_INACTIVITY_MESSAGE_ID = "ABC123DEF";
 static const std::string USER_INACTIVITY_PAYLOAD_KEY = "inactiveTimeInSeconds";
 static const std::chrono::milliseconds USER_INACTIVITY_REPORT_PERIOD{20};
 
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::seconds LONG_TIMEOUT{5};
+
+/// Mock class that implements @c UserInactivityObserverInterface.
+class MockUserInactivityObserver : public UserInactivityObserverInterface {
+public:
+    MOCK_METHOD0(onUserInactive, void());
+    MOCK_METHOD0(onUserActiveAgain, void());
+};
+
 /// This is the condition variable to be used to control the exit of the test case.
 std::condition_variable exitTrigger;
 
@@ -215,6 +228,34 @@ TEST_F(UserInactivityMonitorTest, sendMultipleReportsWithReset) {
     directiveSequencer->shutdown();
 }
 
+/**
+ * This case tests if the observers are told once when the user becomes inactive, and once when the user is back.
+ */
+TEST_F(UserInactivityMonitorTest, notifyObserversOfInactivity) {
+    ASSERT_EQ(
+        nullptr,
+        UserInactivityMonitor::create(
+            m_mockMessageSender,
+            m_mockExceptionEncounteredSender,
+            std::chrono::hours(1),
+            std::chrono::milliseconds::zero()));
+    auto userInactivityMonitor = UserInactivityMonitor::create(
+        m_mockMessageSender, m_mockExceptionEncounteredSender, std::chrono::hours(1), USER_INACTIVITY_REPORT_PERIOD);
+    ASSERT_NE(nullptr, userInactivityMonitor);
+
+    auto observer = std::make_shared<StrictMock<MockUserInactivityObserver>>();
+    std::promise<void> inactive;
+    EXPECT_CALL(*observer, onUserInactive()).WillOnce(InvokeWithoutArgs([&inactive] { inactive.set_value(); }));
+    userInactivityMonitor->addObserver(observer);
+    ASSERT_EQ(inactive.get_future().wait_for(LONG_TIMEOUT), std::future_status::ready);
+
+    // Only the first activity after the inactivity is reported.
+    EXPECT_CALL(*observer, onUserActiveAgain()).Times(1);
+    userInactivityMonitor->onUserActive();
+    userInactivityMonitor->onUserActive();
+    userInactivityMonitor->removeObserver(observer);
+}
+
 }  // namespace test
 }  // namespace system
 }  // namespace capabilityAgents
@@ -0,0 +1,215 @@
+/*
+ * AppendLogMessageStorage.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CERTIFIED_SENDER_INCLUDE_CERTIFIED_SENDER_APPEND_LOG_MESSAGE_STORAGE_H_
+#define ALEXA_CLIENT_SDK_CERTIFIED_SENDER_INCLUDE_CERTIFIED_SENDER_APPEND_LOG_MESSAGE_STORAGE_H_
+
+#include "CertifiedSender/MessageStorageInterface.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+
+/**
+ * An implementation of @c MessageStorageInterface which appends the messages to a log, suited to a queue which is
+ * written at its tail and erased from its head.
+ *
+ * The database is a directory of segment files, each of which is memory-mapped.  Stored messages and erasures are
+ * appended to the last segment as records framed with their length and a CRC, and a new segment is started when the
+ * last one is full.  A segment is deleted once all of the messages stored in it have been erased, as long as it is
+ * the oldest one.  When the database is opened, the records are replayed up to the first one which is incomplete or
+ * fails its CRC in each segment, which are the ones a power failure interrupted.
+ *
+ * Each change is synced to the disk before @c store() or @c erase() returns, unless it is made in a transaction, in
+ * which case the changes are synced by @c commitTransaction().
+ *
+ * This class is not thread-safe.
+ */
+class AppendLogMessageStorage : public MessageStorageInterface {
+public:
+    /// The default size of a segment file, in bytes.
+    static const size_t DEFAULT_SEGMENT_SIZE;
+
+    /**
+     * Constructor.
+     *
+     * @param segmentSize The size of a segment file, in bytes.  A message too large for a segment of this size gets
+     * a segment of its own.
+     */
+    AppendLogMessageStorage(size_t segmentSize = DEFAULT_SEGMENT_SIZE);
+
+    /**
+     * Destructor.
+     */
+    ~AppendLogMessageStorage();
+
+    bool createDatabase(const std::string& filePath) override;
+
+    bool open(const std::string& filePath) override;
+
+    bool isOpen() override;
+
+    void close() override;
+
+    bool store(const std::string& message, int* id) override;
+
+    bool load(std::queue<StoredMessage>* messageContainer) override;
+
+    bool erase(int messageId) override;
+
+    bool clearDatabase() override;
+
+    bool beginTransaction() override;
+
+    bool commitTransaction() override;
+
+private:
+    /// A memory-mapped segment file.
+    struct Segment {
+        /// The position of the segment in the log, which also names its file.
+        uint64_t sequence;
+
+        /// The file descriptor of the segment file.
+        int fd;
+
+        /// The mapping of the segment file.
+        uint8_t* data;
+
+        /// The size of the segment file, in bytes.
+        size_t size;
+
+        /// The offset at which the next record will be written.
+        size_t writeOffset;
+
+        /// The offset up to which the records have been synced to the disk.
+        size_t syncedOffset;
+
+        /// The number of messages stored in the segment which have not been erased.
+        size_t liveMessages;
+    };
+
+    /// Where a stored message is.
+    struct Location {
+        /// The sequence of the segment holding the record of the message.
+        uint64_t sequence;
+
+        /// The offset of the record in the segment.
+        size_t offset;
+    };
+
+    /**
+     * Get the path of the file of a segment.
+     *
+     * @param sequence The sequence of the segment.
+     * @return The path of the file.
+     */
+    std::string segmentPath(uint64_t sequence) const;
+
+    /**
+     * Map an existing segment file, and replay its records.
+     *
+     * @param sequence The sequence of the segment.
+     * @return Whether the segment was mapped.
+     */
+    bool openSegment(uint64_t sequence);
+
+    /**
+     * Create a segment file after the last one, and map it.
+     *
+     * @param size The size of the segment file, in bytes.
+     * @return Whether the segment was created.
+     */
+    bool createSegment(size_t size);
+
+    /**
+     * Unmap a segment and close its file.
+     *
+     * @param segment The segment.
+     */
+    static void unmapSegment(Segment* segment);
+
+    /**
+     * Replay the records of a segment into @c m_index, and find where the next record will be written.
+     *
+     * @param segment The segment.
+     */
+    void replaySegment(Segment* segment);
+
+    /**
+     * Find a segment by its sequence.
+     *
+     * @param sequence The sequence of the segment.
+     * @return The segment, or @c nullptr if it has been deleted.
+     */
+    Segment* findSegment(uint64_t sequence);
+
+    /**
+     * Append a record to the last segment, starting a new one if it is full.
+     *
+     * @param type The type of the record.
+     * @param id The id of the message the record refers to.
+     * @param payload The payload of the record.
+     * @param[out] location Where the record was written.  May be @c nullptr.
+     * @return Whether the record was appended.
+     */
+    bool append(uint32_t type, int id, const std::string& payload, Location* location);
+
+    /**
+     * Sync the records written since the last sync to the disk, unless a transaction is open.
+     *
+     * @return Whether the records were synced.
+     */
+    bool syncIfNotInTransaction();
+
+    /**
+     * Sync the records written since the last sync to the disk.
+     *
+     * @return Whether the records were synced.
+     */
+    bool sync();
+
+    /**
+     * Delete the oldest segments while all of their messages have been erased.
+     */
+    void deleteAcknowledgedSegments();
+
+    /// The size of a new segment file, in bytes.
+    const size_t m_segmentSize;
+
+    /// The directory holding the segment files, or empty if no database is open.
+    std::string m_directory;
+
+    /// The segments of the log, oldest first.
+    std::deque<Segment> m_segments;
+
+    /// The messages which have not been erased, by id.
+    std::map<int, Location> m_index;
+
+    /// The id of the next message stored.
+    int m_nextId;
+
+    /// Whether a transaction started by @c beginTransaction() is open.
+    bool m_isInTransaction;
+};
+
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CERTIFIED_SENDER_INCLUDE_CERTIFIED_SENDER_APPEND_LOG_MESSAGE_STORAGE_H_
@@ -26,9 +26,12 @@
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
+#include <AVSCommon/Utils/Timing/Timer.h>
 
+#include <chrono>
+#include <deque>
 #include <memory>
-#include <queue>
+#include <vector>
 
 namespace alexaClientSDK {
 namespace certifiedSender {
@@ -46,7 +49,19 @@ static const int CERTIFIED_SENDER_QUEUE_SIZE_HARD_LIMIT = 50;
  * To avoid excessive memory usage, the maximum number of messages stored in this way is configurable via the
  * settings 'queueSizeWarnLimit' and 'queueSizeHardLimit', under the configuration root 'certifiedSender'.
  *
- * Similarly, the file path for the database storage is configured under the setting 'databaseFilePath'.
+ * Similarly, the file path for the database storage is configured under the setting 'databaseFilePath'.  For an
+ * @c AppendLogMessageStorage, this is the path of a directory.
+ *
+ * By default, each message is written to the disk on its own.  The setting 'writeBatchWindowMilliseconds' groups the
+ * writes made within that many milliseconds after the first one into a single transaction of the storage.  The
+ * future of a message sent in a batch is only satisfied once the batch has been committed, and such a message is
+ * not sent to AVS before then.  The removal of sent messages is batched the same way, so a message whose removal is
+ * lost on power failure is sent again on the next run.
+ *
+ * By default, a message is only sent once the previous one has been acknowledged by AVS.  The setting
+ * 'maxInFlightMessages' lets that many messages be sent before the first of them is acknowledged.  Acknowledgements
+ * are still handled in order: when a message is not acknowledged, it is sent again once the messages sent after it
+ * have completed, followed by all of those messages, so some messages may reach AVS more than once.
  *
  * This class maintains the ordering of messages passed to it.  For example, if @c sendJSONMessage is invoked with
  * messages A then B then C, then this class guarantees that the messages will be sent to AVS in the same order -
@@ -96,10 +111,10 @@ private:
         /**
          * Constructor.
          *
-         * @param jsonContent The JSON text to be sent to AVS.
+         * @param jsonContent The JSON text to be sent to AVS, shared with the caller which stored it.
          * @param dbId The database id associated with this @c MessageRequest.
          */
-        CertifiedMessageRequest(const std::string& jsonContent, int dbId);
+        CertifiedMessageRequest(std::shared_ptr<const std::string> jsonContent, int dbId);
 
         void exceptionReceived(const std::string& exceptionMessage) override;
 
@@ -113,6 +128,11 @@ private:
          */
         avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status waitForCompletion();
 
+        /**
+         * Forget the outcome of a previous send, so that @c waitForCompletion() waits for the next one.
+         */
+        void resetCompletion();
+
         /**
          * Utility function to return the database id associated with this @c MessageRequest.
          *
@@ -164,9 +184,29 @@ private:
      * The actual handling of the sendJSONMessage call by our internal executor.
      *
      * @param jsonMessage The message to be sent to AVS.
-     * @return Whether the message was successfully persisted.
+     * @param result The promise to satisfy with whether the message was successfully persisted.
      */
-    bool executeSendJSONMessage(std::string jsonMessage);
+    void executeSendJSONMessage(
+        std::shared_ptr<const std::string> jsonMessage,
+        std::shared_ptr<std::promise<bool>> result);
+
+    /**
+     * Make sure a batch of writes is open, when batching is enabled.  It must be called with @c m_mutex held.
+     *
+     * @return Whether the following write belongs to a batch, rather than being written by itself.
+     */
+    bool joinBatchLocked();
+
+    /**
+     * Commit the open batch of writes, if any, and release the messages it stored.  It must be called with
+     * @c m_mutex held.
+     */
+    void commitBatchLocked();
+
+    /**
+     * Commit the open batch of writes, once its window has elapsed.
+     */
+    void onBatchWindowElapsed();
 
     void doShutdown() override;
 
@@ -180,6 +220,24 @@ private:
     /// The maximum possible size of the queue.
     int m_queueSizeHardLimit;
 
+    /// The maximum number of messages sent to AVS which have not completed yet.
+    int m_maxInFlightMessages;
+
+    /// How long after its first write a batch of writes is committed, or zero to write each change by itself.
+    std::chrono::milliseconds m_writeBatchWindow;
+
+    /// Whether a batch of writes is open on @c m_storage.
+    bool m_isBatchOpen;
+
+    /// The messages stored in the open batch, which are queued for sending once it is committed.
+    std::vector<std::shared_ptr<CertifiedMessageRequest>> m_batchedMessages;
+
+    /// The promises of the messages in @c m_batchedMessages, satisfied once the batch is committed.
+    std::vector<std::shared_ptr<std::promise<bool>>> m_batchedResults;
+
+    /// The timer which commits the open batch of writes.
+    avsCommon::utils::timing::Timer m_batchCommitTimer;
+
     /// The thread that will actually handle the sending of messages.
     std::thread m_workerThread;
     /// A control so we may disable the worker thread on shutdown.
@@ -192,8 +250,8 @@ private:
     /// A variable to capture if we are currently connected to AVS.
     bool m_isConnected;
 
-    /// Our queue of requests that should be sent.
-    std::queue<std::shared_ptr<CertifiedMessageRequest>> m_messagesToSend;
+    /// Our queue of requests that should be sent.  Its first entries are the ones in flight, in sending order.
+    std::deque<std::shared_ptr<CertifiedMessageRequest>> m_messagesToSend;
 
     /// The entity which actually sends the messages to AVS.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
@@ -130,6 +130,26 @@ public:
      * @return Whether the database was successfully cleared.
      */
     virtual bool clearDatabase() = 0;
+
+    /**
+     * Group the following calls to @c store() and @c erase() until @c commitTransaction(), so that they reach the
+     * disk together.  Until then, the changes may be lost on power failure.  Implementations which write each change
+     * at once may ignore this.
+     *
+     * @return Whether the transaction was started.
+     */
+    virtual bool beginTransaction() {
+        return true;
+    }
+
+    /**
+     * Write the changes made since @c beginTransaction() to the disk.  If this fails, they may be lost.
+     *
+     * @return Whether the changes were written.
+     */
+    virtual bool commitTransaction() {
+        return true;
+    }
 };
 
 }  // namespace certifiedSender
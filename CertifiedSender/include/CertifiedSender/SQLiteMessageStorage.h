@@ -20,14 +20,28 @@
 
 #include "CertifiedSender/MessageStorageInterface.h"
 
+#include <memory>
+
 #include <sqlite3.h>
 
+#include <SQLiteStorage/SQLiteDatabaseService.h>
+#include <SQLiteStorage/SQLiteStatementCache.h>
+
 namespace alexaClientSDK {
 namespace certifiedSender {
 
 /**
  * An implementation that allows us to store messages using SQLite.
  *
+ * The journaling of the database may be tuned with the settings 'enableWriteAheadLog' (a boolean) and 'synchronous'
+ * (one of "OFF", "NORMAL", "FULL" or "EXTRA"), under the configuration root 'certifiedSender'.  By default, SQLite
+ * uses a rollback journal and waits for each commit to reach the disk.
+ *
+ * The messages may instead be kept in a shared @c SQLiteDatabaseService, in which case each call runs on its storage
+ * thread, the file paths given to @c createDatabase() and @c open() are not used, and the journaling is that of the
+ * shared database.  @c beginTransaction() and @c commitTransaction() then have no effect, since the shared database
+ * already commits together the changes made at the same time.
+ *
  * This class is not thread-safe.
  */
 class SQLiteMessageStorage : public MessageStorageInterface {
@@ -37,6 +51,13 @@ public:
      */
     SQLiteMessageStorage();
 
+    /**
+     * Constructor for a storage keeping its messages in a shared database.
+     *
+     * @param database The shared database, or @c nullptr to keep them in a database file of their own.
+     */
+    explicit SQLiteMessageStorage(std::shared_ptr<storage::sqliteStorage::SQLiteDatabaseService> database);
+
     ~SQLiteMessageStorage();
 
     bool createDatabase(const std::string& filePath) override;
@@ -55,6 +76,10 @@ public:
 
     bool clearDatabase() override;
 
+    bool beginTransaction() override;
+
+    bool commitTransaction() override;
+
 protected:
     /**
      * A non-virtual function that may be called to clean up resources managed by this class.
@@ -62,8 +87,32 @@ protected:
     void doClose();
 
 private:
+    /**
+     * Apply the journaling settings from the configuration to @c m_dbHandle.  Failing to apply them is not fatal,
+     * since the database still works with the SQLite defaults.
+     */
+    void configureJournal();
+
+    /**
+     * Start using the shared database, creating the messages table if asked to.  Called on the storage thread.
+     *
+     * @param dbHandle The connection to the shared database.
+     * @param createTable Whether to create the messages table if it does not exist.
+     * @return Whether the messages table exists in the shared database.
+     */
+    bool useSharedDatabase(sqlite3* dbHandle, bool createTable);
+
+    /// The shared database keeping the messages, or @c nullptr if they are kept in a database of their own.
+    std::shared_ptr<storage::sqliteStorage::SQLiteDatabaseService> m_database;
+
     /// The sqlite database handle.
     sqlite3* m_dbHandle;
+
+    /// The statements run repeatedly on @c m_dbHandle, prepared once per connection.
+    storage::sqliteStorage::SQLiteStatementCache m_statementCache;
+
+    /// Whether a transaction started by @c beginTransaction() is open.
+    bool m_isInTransaction;
 };
 
 }  // namespace certifiedSender
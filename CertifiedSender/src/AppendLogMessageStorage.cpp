@@ -0,0 +1,527 @@
+/*
+ * AppendLogMessageStorage.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "CertifiedSender/AppendLogMessageStorage.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <AVSCommon/Utils/File/FileUtils.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+
+using namespace avsCommon::utils::file;
+using namespace avsCommon::utils::logger;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AppendLogMessageStorage");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const size_t AppendLogMessageStorage::DEFAULT_SEGMENT_SIZE = 1024 * 1024;
+
+/// The prefix of the name of a segment file.
+static const std::string SEGMENT_FILE_PREFIX = "segment-";
+/// The suffix of the name of a segment file.
+static const std::string SEGMENT_FILE_SUFFIX = ".log";
+/// Permissions for the database directory; only the creating user may read the messages.
+static const mode_t DIRECTORY_MODE = 0700;
+/// Permissions for new segment files.
+static const mode_t SEGMENT_FILE_MODE = 0600;
+
+/// The type of the zeroed space after the last record of a segment.
+static const uint32_t RECORD_TYPE_END = 0;
+/// The type of a record storing a message.
+static const uint32_t RECORD_TYPE_MESSAGE = 1;
+/// The type of a record erasing a message.
+static const uint32_t RECORD_TYPE_ERASE = 2;
+
+/**
+ * The header of a record, followed by its payload.  The CRC covers the type, the id and the payload, so that a
+ * record which was only partly written before a power failure is detected.
+ */
+struct RecordHeader {
+    /// The type of the record.
+    uint32_t type;
+    /// The id of the message the record refers to.
+    int32_t id;
+    /// The size of the payload, in bytes.
+    uint32_t length;
+    /// The CRC-32 of the record.
+    uint32_t crc;
+};
+
+/**
+ * Compute the CRC-32 (as used by zlib) of a buffer, continuing from a previous result.
+ *
+ * @param crc The CRC of the data before the buffer, or 0.
+ * @param data The buffer.
+ * @param size The size of the buffer, in bytes.
+ * @return The CRC of the data up to the end of the buffer.
+ */
+static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    static const std::vector<uint32_t> table = []() {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < entries.size(); ++i) {
+            uint32_t entry = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                entry = (entry & 1) ? (0xEDB88320 ^ (entry >> 1)) : (entry >> 1);
+            }
+            entries[i] = entry;
+        }
+        return entries;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * Compute the CRC of a record.
+ *
+ * @param header The header of the record.  Its @c crc is ignored.
+ * @param payload The payload of the record.
+ * @return The CRC of the record.
+ */
+static uint32_t recordCrc(const RecordHeader& header, const uint8_t* payload) {
+    uint32_t crc = crc32(0, reinterpret_cast<const uint8_t*>(&header.type), sizeof(header.type));
+    crc = crc32(crc, reinterpret_cast<const uint8_t*>(&header.id), sizeof(header.id));
+    return crc32(crc, payload, header.length);
+}
+
+AppendLogMessageStorage::AppendLogMessageStorage(size_t segmentSize) :
+        m_segmentSize{std::max(segmentSize, sizeof(RecordHeader))},
+        m_nextId{1},
+        m_isInTransaction{false} {
+}
+
+AppendLogMessageStorage::~AppendLogMessageStorage() {
+    close();
+}
+
+bool AppendLogMessageStorage::createDatabase(const std::string& filePath) {
+    if (isOpen()) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Database already open."));
+        return false;
+    }
+
+    if (fileExists(filePath)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("File specified already exists.").d("file path", filePath));
+        return false;
+    }
+
+    if (mkdir(filePath.c_str(), DIRECTORY_MODE) != 0) {
+        ACSDK_ERROR(LX("createDatabaseFailed").d("file path", filePath).d("error", strerror(errno)));
+        return false;
+    }
+
+    m_directory = filePath;
+    m_nextId = 1;
+    return true;
+}
+
+bool AppendLogMessageStorage::open(const std::string& filePath) {
+    if (isOpen()) {
+        ACSDK_ERROR(LX("openFailed").m("Database already open."));
+        return false;
+    }
+
+    DIR* directory = opendir(filePath.c_str());
+    if (!directory) {
+        ACSDK_ERROR(LX("openFailed").m("Database could not be opened.").d("file path", filePath));
+        return false;
+    }
+
+    // Segment files are only deleted from the head of the log, so the ones left are replayed in order.
+    std::vector<uint64_t> sequences;
+    while (auto entry = readdir(directory)) {
+        std::string name = entry->d_name;
+        unsigned long long sequence = 0;
+        if (name.compare(0, SEGMENT_FILE_PREFIX.size(), SEGMENT_FILE_PREFIX) == 0 &&
+            name.size() > SEGMENT_FILE_SUFFIX.size() &&
+            name.compare(name.size() - SEGMENT_FILE_SUFFIX.size(), SEGMENT_FILE_SUFFIX.size(), SEGMENT_FILE_SUFFIX) ==
+                0 &&
+            sscanf(name.c_str() + SEGMENT_FILE_PREFIX.size(), "%llu", &sequence) == 1) {
+            sequences.push_back(sequence);
+        }
+    }
+    closedir(directory);
+    std::sort(sequences.begin(), sequences.end());
+
+    m_directory = filePath;
+    m_nextId = 1;
+    for (auto sequence : sequences) {
+        if (!openSegment(sequence)) {
+            close();
+            return false;
+        }
+    }
+    deleteAcknowledgedSegments();
+
+    ACSDK_DEBUG(LX("opened").d("segments", m_segments.size()).d("messages", m_index.size()));
+    return true;
+}
+
+bool AppendLogMessageStorage::isOpen() {
+    return !m_directory.empty();
+}
+
+void AppendLogMessageStorage::close() {
+    if (!isOpen()) {
+        return;
+    }
+    m_isInTransaction = false;
+    sync();
+    for (auto& segment : m_segments) {
+        unmapSegment(&segment);
+    }
+    m_segments.clear();
+    m_index.clear();
+    m_directory.clear();
+}
+
+bool AppendLogMessageStorage::store(const std::string& message, int* id) {
+    if (!id) {
+        ACSDK_ERROR(LX("storeFailed").m("id parameter was nullptr."));
+        return false;
+    }
+
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("storeFailed").m("Database is not open."));
+        return false;
+    }
+
+    Location location;
+    int messageId = m_nextId;
+    if (!append(RECORD_TYPE_MESSAGE, messageId, message, &location)) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not append message."));
+        return false;
+    }
+    ++m_nextId;
+    m_index[messageId] = location;
+    ++findSegment(location.sequence)->liveMessages;
+
+    if (!syncIfNotInTransaction()) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not sync message."));
+        return false;
+    }
+
+    *id = messageId;
+    return true;
+}
+
+bool AppendLogMessageStorage::load(std::queue<StoredMessage>* messageContainer) {
+    if (!messageContainer) {
+        ACSDK_ERROR(LX("loadFailed").m("Alert container parameter is nullptr."));
+        return false;
+    }
+
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("loadFailed").m("Database is not open."));
+        return false;
+    }
+
+    for (auto& entry : m_index) {
+        auto segment = findSegment(entry.second.sequence);
+        RecordHeader header;
+        memcpy(&header, segment->data + entry.second.offset, sizeof(header));
+        auto payload = reinterpret_cast<const char*>(segment->data + entry.second.offset + sizeof(header));
+        messageContainer->push(StoredMessage(entry.first, std::string(payload, header.length)));
+    }
+
+    return true;
+}
+
+bool AppendLogMessageStorage::erase(int messageId) {
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("eraseFailed").m("Database is not open."));
+        return false;
+    }
+
+    auto entry = m_index.find(messageId);
+    if (entry == m_index.end()) {
+        ACSDK_ERROR(LX("eraseFailed").m("No such message.").d("id", messageId));
+        return false;
+    }
+
+    if (!append(RECORD_TYPE_ERASE, messageId, "", nullptr)) {
+        ACSDK_ERROR(LX("eraseFailed").m("Could not append erasure."));
+        return false;
+    }
+    --findSegment(entry->second.sequence)->liveMessages;
+    m_index.erase(entry);
+
+    if (!syncIfNotInTransaction()) {
+        ACSDK_ERROR(LX("eraseFailed").m("Could not sync erasure."));
+        return false;
+    }
+
+    deleteAcknowledgedSegments();
+    return true;
+}
+
+bool AppendLogMessageStorage::clearDatabase() {
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("clearDatabaseFailed").m("Database is not open."));
+        return false;
+    }
+
+    bool cleared = true;
+    for (auto& segment : m_segments) {
+        unmapSegment(&segment);
+        if (!removeFile(segmentPath(segment.sequence))) {
+            ACSDK_ERROR(LX("clearDatabaseFailed").m("Could not delete segment.").d("sequence", segment.sequence));
+            cleared = false;
+        }
+    }
+    m_segments.clear();
+    m_index.clear();
+    return cleared;
+}
+
+bool AppendLogMessageStorage::beginTransaction() {
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("beginTransactionFailed").m("Database is not open."));
+        return false;
+    }
+    if (m_isInTransaction) {
+        ACSDK_ERROR(LX("beginTransactionFailed").m("A transaction is already open."));
+        return false;
+    }
+    m_isInTransaction = true;
+    return true;
+}
+
+bool AppendLogMessageStorage::commitTransaction() {
+    if (!m_isInTransaction) {
+        ACSDK_ERROR(LX("commitTransactionFailed").m("No transaction is open."));
+        return false;
+    }
+    m_isInTransaction = false;
+    if (!sync()) {
+        ACSDK_ERROR(LX("commitTransactionFailed").m("Could not sync transaction."));
+        return false;
+    }
+    return true;
+}
+
+std::string AppendLogMessageStorage::segmentPath(uint64_t sequence) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%010llu", static_cast<unsigned long long>(sequence));
+    return m_directory + "/" + SEGMENT_FILE_PREFIX + name + SEGMENT_FILE_SUFFIX;
+}
+
+bool AppendLogMessageStorage::openSegment(uint64_t sequence) {
+    auto path = segmentPath(sequence);
+    Segment segment{sequence, -1, nullptr, 0, 0, 0, 0};
+    segment.fd = ::open(path.c_str(), O_RDWR);
+    if (segment.fd < 0) {
+        ACSDK_ERROR(LX("openSegmentFailed").d("path", path).d("error", strerror(errno)));
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(segment.fd, &status) != 0 || status.st_size <= 0) {
+        ACSDK_ERROR(LX("openSegmentFailed").d("reason", "emptyOrUnreadable").d("path", path));
+        ::close(segment.fd);
+        return false;
+    }
+    segment.size = static_cast<size_t>(status.st_size);
+
+    void* data = mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+    if (MAP_FAILED == data) {
+        ACSDK_ERROR(LX("openSegmentFailed").d("path", path).d("error", strerror(errno)));
+        ::close(segment.fd);
+        return false;
+    }
+    segment.data = static_cast<uint8_t*>(data);
+
+    m_segments.push_back(segment);
+    replaySegment(&m_segments.back());
+    return true;
+}
+
+bool AppendLogMessageStorage::createSegment(size_t size) {
+    uint64_t sequence = m_segments.empty() ? 0 : m_segments.back().sequence + 1;
+    auto path = segmentPath(sequence);
+    Segment segment{sequence, -1, nullptr, size, 0, 0, 0};
+    segment.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, SEGMENT_FILE_MODE);
+    if (segment.fd < 0) {
+        ACSDK_ERROR(LX("createSegmentFailed").d("path", path).d("error", strerror(errno)));
+        return false;
+    }
+
+    // Reserve the space up front, since running out of disk while writing to the mapping would raise SIGBUS.
+#ifdef __linux__
+    int result = posix_fallocate(segment.fd, 0, size);
+#else
+    int result = ftruncate(segment.fd, size) == 0 ? 0 : errno;
+#endif
+    void* data = MAP_FAILED;
+    if (0 == result) {
+        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        result = MAP_FAILED == data ? errno : 0;
+    }
+    if (result != 0) {
+        ACSDK_ERROR(LX("createSegmentFailed").d("path", path).d("error", strerror(result)));
+        ::close(segment.fd);
+        removeFile(path);
+        return false;
+    }
+    segment.data = static_cast<uint8_t*>(data);
+
+    m_segments.push_back(segment);
+    return true;
+}
+
+void AppendLogMessageStorage::unmapSegment(Segment* segment) {
+    if (segment->data) {
+        munmap(segment->data, segment->size);
+        segment->data = nullptr;
+    }
+    if (segment->fd >= 0) {
+        ::close(segment->fd);
+        segment->fd = -1;
+    }
+}
+
+void AppendLogMessageStorage::replaySegment(Segment* segment) {
+    size_t offset = 0;
+    while (offset + sizeof(RecordHeader) <= segment->size) {
+        RecordHeader header;
+        memcpy(&header, segment->data + offset, sizeof(header));
+        if (RECORD_TYPE_END == header.type) {
+            break;
+        }
+        const uint8_t* payload = segment->data + offset + sizeof(header);
+        if ((header.type != RECORD_TYPE_MESSAGE && header.type != RECORD_TYPE_ERASE) ||
+            header.length > segment->size - offset - sizeof(header) || recordCrc(header, payload) != header.crc) {
+            // A record interrupted by a power failure.  Clear the rest of the segment so it is not mistaken for
+            // records once new ones are written over it.
+            ACSDK_WARN(LX("replaySegment").m("Discarding torn record.").d("sequence", segment->sequence));
+            memset(segment->data + offset, 0, segment->size - offset);
+            break;
+        }
+
+        if (RECORD_TYPE_MESSAGE == header.type) {
+            m_index[header.id] = {segment->sequence, offset};
+            ++segment->liveMessages;
+        } else {
+            // The message was stored at or before this record, so its segment, if not deleted, is still mapped.
+            auto entry = m_index.find(header.id);
+            if (entry != m_index.end()) {
+                --findSegment(entry->second.sequence)->liveMessages;
+                m_index.erase(entry);
+            }
+        }
+        m_nextId = std::max(m_nextId, header.id + 1);
+        offset += sizeof(header) + header.length;
+    }
+    segment->writeOffset = offset;
+    segment->syncedOffset = offset;
+}
+
+AppendLogMessageStorage::Segment* AppendLogMessageStorage::findSegment(uint64_t sequence) {
+    for (auto& segment : m_segments) {
+        if (segment.sequence == sequence) {
+            return &segment;
+        }
+    }
+    return nullptr;
+}
+
+bool AppendLogMessageStorage::append(uint32_t type, int id, const std::string& payload, Location* location) {
+    size_t recordSize = sizeof(RecordHeader) + payload.size();
+    if (m_segments.empty() || m_segments.back().size - m_segments.back().writeOffset < recordSize) {
+        if (!createSegment(std::max(m_segmentSize, recordSize))) {
+            return false;
+        }
+    }
+
+    auto& segment = m_segments.back();
+    RecordHeader header;
+    header.type = type;
+    header.id = id;
+    header.length = static_cast<uint32_t>(payload.size());
+    header.crc = recordCrc(header, reinterpret_cast<const uint8_t*>(payload.data()));
+    memcpy(segment.data + segment.writeOffset + sizeof(header), payload.data(), payload.size());
+    memcpy(segment.data + segment.writeOffset, &header, sizeof(header));
+
+    if (location) {
+        *location = {segment.sequence, segment.writeOffset};
+    }
+    segment.writeOffset += recordSize;
+    return true;
+}
+
+bool AppendLogMessageStorage::syncIfNotInTransaction() {
+    return m_isInTransaction || sync();
+}
+
+bool AppendLogMessageStorage::sync() {
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    bool synced = true;
+    for (auto& segment : m_segments) {
+        if (segment.syncedOffset == segment.writeOffset) {
+            continue;
+        }
+        size_t start = segment.syncedOffset / pageSize * pageSize;
+        if (msync(segment.data + start, segment.writeOffset - start, MS_SYNC) != 0) {
+            ACSDK_ERROR(LX("syncFailed").d("sequence", segment.sequence).d("error", strerror(errno)));
+            synced = false;
+            continue;
+        }
+        segment.syncedOffset = segment.writeOffset;
+    }
+    return synced;
+}
+
+void AppendLogMessageStorage::deleteAcknowledgedSegments() {
+    while (!m_segments.empty() && 0 == m_segments.front().liveMessages) {
+        auto& segment = m_segments.front();
+        // Keep the last segment until it is full, rather than recreating one for each message of a drained queue.
+        if (m_segments.size() == 1 && segment.size - segment.writeOffset >= sizeof(RecordHeader)) {
+            return;
+        }
+        unmapSegment(&segment);
+        if (!removeFile(segmentPath(segment.sequence))) {
+            ACSDK_ERROR(LX("deleteSegmentFailed").d("sequence", segment.sequence));
+        }
+        m_segments.pop_front();
+    }
+}
+
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
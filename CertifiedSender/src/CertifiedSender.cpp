@@ -34,6 +34,12 @@ using namespace avsCommon::utils::configuration;
 static const std::string CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY = "certifiedSender";
 /// The key in our config file to find the database file path.
 static const std::string CERTIFIED_SENDER_DB_FILE_PATH_KEY = "databaseFilePath";
+/// The key in our config file to find the window within which writes are batched together.
+static const std::string CERTIFIED_SENDER_WRITE_BATCH_WINDOW_KEY = "writeBatchWindowMilliseconds";
+/// The key in our config file to find the maximum number of messages in flight.
+static const std::string CERTIFIED_SENDER_MAX_IN_FLIGHT_MESSAGES_KEY = "maxInFlightMessages";
+/// The default maximum number of messages in flight, which sends each message once the previous one is acknowledged.
+static const int DEFAULT_MAX_IN_FLIGHT_MESSAGES = 1;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("CertifiedSender");
@@ -45,8 +51,10 @@ static const std::string TAG("CertifiedSender");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-CertifiedSender::CertifiedMessageRequest::CertifiedMessageRequest(const std::string& jsonContent, int dbId) :
-        MessageRequest{jsonContent},
+CertifiedSender::CertifiedMessageRequest::CertifiedMessageRequest(
+    std::shared_ptr<const std::string> jsonContent,
+    int dbId) :
+        MessageRequest{std::move(jsonContent)},
         m_responseReceived{false},
         m_dbId{dbId} {
 }
@@ -75,6 +83,11 @@ MessageRequestObserverInterface::Status CertifiedSender::CertifiedMessageRequest
     return m_sendMessageStatus;
 }
 
+void CertifiedSender::CertifiedMessageRequest::resetCompletion() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_responseReceived = false;
+}
+
 int CertifiedSender::CertifiedMessageRequest::getDbId() {
     return m_dbId;
 }
@@ -104,6 +117,9 @@ CertifiedSender::CertifiedSender(
         RequiresShutdown("CertifiedSender"),
         m_queueSizeWarnLimit{queueSizeWarnLimit},
         m_queueSizeHardLimit{queueSizeHardLimit},
+        m_maxInFlightMessages{DEFAULT_MAX_IN_FLIGHT_MESSAGES},
+        m_writeBatchWindow{0},
+        m_isBatchOpen{false},
         m_isShuttingDown{false},
         m_isConnected{false},
         m_messageSender{messageSender},
@@ -121,6 +137,12 @@ CertifiedSender::~CertifiedSender() {
     if (m_workerThread.joinable()) {
         m_workerThread.join();
     }
+
+    // Write out the last batch once nothing else can add to it.
+    m_executor.shutdown();
+    m_batchCommitTimer.stop();
+    lock.lock();
+    commitBatchLocked();
 }
 
 bool CertifiedSender::init() {
@@ -140,6 +162,23 @@ bool CertifiedSender::init() {
         return false;
     }
 
+    int writeBatchWindowMilliseconds = 0;
+    configurationRoot.getInt(CERTIFIED_SENDER_WRITE_BATCH_WINDOW_KEY, &writeBatchWindowMilliseconds, 0);
+    if (writeBatchWindowMilliseconds < 0) {
+        ACSDK_ERROR(LX("initFailed")
+                        .d("writeBatchWindowMilliseconds", writeBatchWindowMilliseconds)
+                        .m("Batch window is invalid."));
+        return false;
+    }
+    m_writeBatchWindow = std::chrono::milliseconds(writeBatchWindowMilliseconds);
+
+    configurationRoot.getInt(
+        CERTIFIED_SENDER_MAX_IN_FLIGHT_MESSAGES_KEY, &m_maxInFlightMessages, DEFAULT_MAX_IN_FLIGHT_MESSAGES);
+    if (m_maxInFlightMessages <= 0) {
+        ACSDK_ERROR(LX("initFailed").d("maxInFlightMessages", m_maxInFlightMessages).m("Window size is invalid."));
+        return false;
+    }
+
     if (!m_storage->open(dbFilePath)) {
         ACSDK_INFO(LX("init : Database file does not exist.  Creating."));
         if (!m_storage->createDatabase(dbFilePath)) {
@@ -154,12 +193,15 @@ bool CertifiedSender::init() {
 }
 
 void CertifiedSender::mainloop() {
+    // The messages sent which have not been acknowledged yet, oldest first.
+    std::deque<std::shared_ptr<CertifiedMessageRequest>> inFlight;
+
     while (true) {
         std::unique_lock<std::mutex> lock(m_mutex);
 
-        if ((!m_isConnected || m_messagesToSend.empty()) && !m_isShuttingDown) {
-            m_workerThreadCV.wait(
-                lock, [this]() { return ((m_isConnected && !m_messagesToSend.empty()) || m_isShuttingDown); });
+        auto canSend = [this, &inFlight]() { return m_isConnected && m_messagesToSend.size() > inFlight.size(); };
+        if (inFlight.empty() && !canSend() && !m_isShuttingDown) {
+            m_workerThreadCV.wait(lock, [this, &canSend]() { return canSend() || m_isShuttingDown; });
         }
 
         if (m_isShuttingDown) {
@@ -167,23 +209,45 @@ void CertifiedSender::mainloop() {
             return;
         }
 
-        auto message = m_messagesToSend.front();
+        // Fill the window with the messages following the ones in flight.
+        std::vector<std::shared_ptr<CertifiedMessageRequest>> toSend;
+        while (canSend() && static_cast<int>(inFlight.size()) < m_maxInFlightMessages) {
+            auto message = m_messagesToSend[inFlight.size()];
+            inFlight.push_back(message);
+            toSend.push_back(message);
+        }
 
         lock.unlock();
 
-        // We have a message to send - send it!
-        m_messageSender->sendMessage(message);
+        // We have messages to send - send them!
+        for (auto& message : toSend) {
+            message->resetCompletion();
+            m_messageSender->sendMessage(message);
+        }
 
+        auto message = inFlight.front();
+        inFlight.pop_front();
         auto status = message->waitForCompletion();
 
         if (MessageRequest::isServerStatus(status)) {
             lock.lock();
 
+            bool isBatched = joinBatchLocked();
             if (!m_storage->erase(message->getDbId())) {
                 ACSDK_ERROR(LX("mainloop : could not erase message from storage."));
             }
 
-            m_messagesToSend.pop();
+            m_messagesToSend.pop_front();
+
+            if (!isBatched) {
+                commitBatchLocked();
+            }
+        } else {
+            // Send this message again, followed by the ones sent after it, so that AVS receives them in order.
+            for (auto& later : inFlight) {
+                later->waitForCompletion();
+            }
+            inFlight.clear();
         }
     }
 }
@@ -197,36 +261,96 @@ void CertifiedSender::onConnectionStatusChanged(
 }
 
 std::future<bool> CertifiedSender::sendJSONMessage(const std::string& jsonMessage) {
-    return m_executor.submit([this, jsonMessage]() { return executeSendJSONMessage(jsonMessage); });
+    auto result = std::make_shared<std::promise<bool>>();
+    auto future = result->get_future();
+    auto content = std::make_shared<const std::string>(jsonMessage);
+    m_executor.submit([this, content, result]() { executeSendJSONMessage(content, result); });
+    return future;
 }
 
-bool CertifiedSender::executeSendJSONMessage(std::string jsonMessage) {
+void CertifiedSender::executeSendJSONMessage(
+    std::shared_ptr<const std::string> jsonMessage,
+    std::shared_ptr<std::promise<bool>> result) {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    int queueSize = static_cast<int>(m_messagesToSend.size());
+    int queueSize = static_cast<int>(m_messagesToSend.size() + m_batchedMessages.size());
 
     if (queueSize >= m_queueSizeHardLimit) {
         ACSDK_ERROR(LX("executeSendJSONMessage").m("Queue size is at max limit.  Cannot add message to send."));
-        return false;
+        result->set_value(false);
+        return;
     }
 
     if (queueSize >= m_queueSizeWarnLimit) {
         ACSDK_WARN(LX("executeSendJSONMessage").m("Warning : queue size has exceeded the warn limit."));
     }
 
+    bool isBatched = joinBatchLocked();
     int messageId = 0;
-    if (!m_storage->store(jsonMessage, &messageId)) {
+    if (!m_storage->store(*jsonMessage, &messageId)) {
         ACSDK_ERROR(LX("executeSendJSONMessage").m("Could not store message."));
-        return false;
+        result->set_value(false);
+        if (!isBatched) {
+            commitBatchLocked();
+        }
+        return;
     }
 
-    m_messagesToSend.push(std::make_shared<CertifiedMessageRequest>(jsonMessage, messageId));
+    m_batchedMessages.push_back(std::make_shared<CertifiedMessageRequest>(std::move(jsonMessage), messageId));
+    m_batchedResults.push_back(result);
+    if (!isBatched) {
+        commitBatchLocked();
+    }
+}
 
-    lock.unlock();
+bool CertifiedSender::joinBatchLocked() {
+    if (m_isBatchOpen) {
+        return true;
+    }
+    if (m_writeBatchWindow == std::chrono::milliseconds::zero() || m_isShuttingDown) {
+        return false;
+    }
+    if (!m_storage->beginTransaction()) {
+        ACSDK_ERROR(LX("joinBatchFailed").m("Could not begin transaction.  Writing by itself."));
+        return false;
+    }
+    m_isBatchOpen = true;
+    if (!m_batchCommitTimer.start(m_writeBatchWindow, [this]() { onBatchWindowElapsed(); }).valid()) {
+        // The timer is still finishing the previous commit.  Commit this write by itself.
+        ACSDK_WARN(LX("joinBatch").m("Could not start the batch timer.  Writing by itself."));
+        return false;
+    }
+    return true;
+}
 
-    m_workerThreadCV.notify_one();
+void CertifiedSender::commitBatchLocked() {
+    bool committed = true;
+    if (m_isBatchOpen) {
+        m_isBatchOpen = false;
+        committed = m_storage->commitTransaction();
+        if (!committed) {
+            ACSDK_ERROR(LX("commitBatchFailed").d("messages", m_batchedMessages.size()));
+        }
+    }
+    if (committed) {
+        for (auto& message : m_batchedMessages) {
+            m_messagesToSend.push_back(message);
+        }
+    }
+    for (auto& result : m_batchedResults) {
+        result->set_value(committed);
+    }
+    bool hasNewMessages = committed && !m_batchedMessages.empty();
+    m_batchedMessages.clear();
+    m_batchedResults.clear();
+    if (hasNewMessages) {
+        m_workerThreadCV.notify_one();
+    }
+}
 
-    return true;
+void CertifiedSender::onBatchWindowElapsed() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    commitBatchLocked();
 }
 
 void CertifiedSender::doShutdown() {
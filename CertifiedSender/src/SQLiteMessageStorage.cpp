@@ -21,6 +21,7 @@
 #include <SQLiteStorage/SQLiteUtils.h>
 #include <SQLiteStorage/SQLiteStatement.h>
 
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/File/FileUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 
@@ -29,6 +30,7 @@
 namespace alexaClientSDK {
 namespace certifiedSender {
 
+using namespace avsCommon::utils::configuration;
 using namespace avsCommon::utils::file;
 using namespace avsCommon::utils::logger;
 using namespace alexaClientSDK::storage::sqliteStorage;
@@ -43,6 +45,13 @@ static const std::string TAG("SQLiteMessageStorage");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The key in our config file to find the root of settings for this storage.
+static const std::string CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY = "certifiedSender";
+/// The key in our config file to find whether the database uses write-ahead logging.
+static const std::string ENABLE_WRITE_AHEAD_LOG_KEY = "enableWriteAheadLog";
+/// The key in our config file to find the synchronous level of the database.
+static const std::string SYNCHRONOUS_KEY = "synchronous";
+
 /// The name of the alerts table.
 static const std::string MESSAGES_TABLE_NAME = "messages";
 /// The name of the 'id' field we will use as the primary key in our tables.
@@ -53,8 +62,28 @@ static const std::string DATABASE_COLUMN_MESSAGE_TEXT_NAME = "message_text";
 static const std::string CREATE_MESSAGES_TABLE_SQL_STRING = std::string("CREATE TABLE ") + MESSAGES_TABLE_NAME + " (" +
                                                             DATABASE_COLUMN_ID_NAME + " INT PRIMARY KEY NOT NULL," +
                                                             DATABASE_COLUMN_MESSAGE_TEXT_NAME + " TEXT NOT NULL);";
+/// The SQL string to store a message.
+static const std::string STORE_MESSAGE_SQL_STRING = std::string("INSERT INTO " + MESSAGES_TABLE_NAME + " (") +
+                                                    DATABASE_COLUMN_ID_NAME + ", " + DATABASE_COLUMN_MESSAGE_TEXT_NAME +
+                                                    ") VALUES (?, ?);";
+/// The SQL string to erase a message.
+static const std::string ERASE_MESSAGE_SQL_STRING = "DELETE FROM " + MESSAGES_TABLE_NAME + " WHERE id=?;";
+
+/// The ids of the statements kept in the statement cache.
+enum StatementId {
+    /// The statement running @c STORE_MESSAGE_SQL_STRING.
+    STORE_MESSAGE_STATEMENT_ID,
+    /// The statement running @c ERASE_MESSAGE_SQL_STRING.
+    ERASE_MESSAGE_STATEMENT_ID
+};
+
+SQLiteMessageStorage::SQLiteMessageStorage() : m_dbHandle{nullptr}, m_isInTransaction{false} {
+}
 
-SQLiteMessageStorage::SQLiteMessageStorage() : m_dbHandle{nullptr} {
+SQLiteMessageStorage::SQLiteMessageStorage(std::shared_ptr<SQLiteDatabaseService> database) :
+        m_database{database},
+        m_dbHandle{nullptr},
+        m_isInTransaction{false} {
 }
 
 SQLiteMessageStorage::~SQLiteMessageStorage() {
@@ -67,6 +96,10 @@ bool SQLiteMessageStorage::createDatabase(const std::string& filePath) {
         return false;
     }
 
+    if (m_database) {
+        return m_database->run([this](sqlite3* dbHandle) { return useSharedDatabase(dbHandle, true); });
+    }
+
     if (fileExists(filePath)) {
         ACSDK_ERROR(LX("createDatabaseFailed").m("File specified already exists.").d("file path", filePath));
         return false;
@@ -84,6 +117,8 @@ bool SQLiteMessageStorage::createDatabase(const std::string& filePath) {
         return false;
     }
 
+    configureJournal();
+
     return true;
 }
 
@@ -93,6 +128,10 @@ bool SQLiteMessageStorage::open(const std::string& filePath) {
         return false;
     }
 
+    if (m_database) {
+        return m_database->run([this](sqlite3* dbHandle) { return useSharedDatabase(dbHandle, false); });
+    }
+
     if (!fileExists(filePath)) {
         ACSDK_ERROR(LX("openFailed").m("File specified does not exist.").d("file path", filePath));
         return false;
@@ -104,6 +143,8 @@ bool SQLiteMessageStorage::open(const std::string& filePath) {
         return false;
     }
 
+    configureJournal();
+
     return true;
 }
 
@@ -116,8 +157,20 @@ void SQLiteMessageStorage::close() {
 }
 
 void SQLiteMessageStorage::doClose() {
+    if (m_database && !m_database->isStorageThread()) {
+        m_database->run([this](sqlite3*) {
+            doClose();
+            return true;
+        });
+        return;
+    }
     if (isOpen()) {
-        if (!closeSQLiteDatabase(m_dbHandle)) {
+        if (m_isInTransaction) {
+            commitTransaction();
+        }
+        m_statementCache.clear();
+        // The connection to a shared database is kept open for the other storages using it.
+        if (!m_database && !closeSQLiteDatabase(m_dbHandle)) {
             ACSDK_ERROR(LX("closeFailed").m("Could not close the database."));
         }
         m_dbHandle = nullptr;
@@ -125,6 +178,9 @@ void SQLiteMessageStorage::doClose() {
 }
 
 bool SQLiteMessageStorage::store(const std::string& message, int* id) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return store(message, id); });
+    }
     if (!id) {
         ACSDK_ERROR(LX("storeFailed").m("id parameter was nullptr."));
         return false;
@@ -134,9 +190,6 @@ bool SQLiteMessageStorage::store(const std::string& message, int* id) {
         return false;
     }
 
-    std::string sqlString = std::string("INSERT INTO " + MESSAGES_TABLE_NAME + " (") + DATABASE_COLUMN_ID_NAME + ", " +
-                            DATABASE_COLUMN_MESSAGE_TEXT_NAME + ") VALUES (" + "?, ?" + ");";
-
     int nextId = 0;
     if (!getTableMaxIntValue(m_dbHandle, MESSAGES_TABLE_NAME, DATABASE_COLUMN_ID_NAME, &nextId)) {
         ACSDK_ERROR(LX("storeFailed").m("Cannot generate message id."));
@@ -149,7 +202,7 @@ bool SQLiteMessageStorage::store(const std::string& message, int* id) {
         return false;
     }
 
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    auto statement = m_statementCache.get(m_dbHandle, STORE_MESSAGE_STATEMENT_ID, STORE_MESSAGE_SQL_STRING);
 
     if (!statement.isValid()) {
         ACSDK_ERROR(LX("storeFailed").m("Could not create statement."));
@@ -157,12 +210,12 @@ bool SQLiteMessageStorage::store(const std::string& message, int* id) {
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam++, nextId) || !statement.bindStringParameter(boundParam, message)) {
+    if (!statement->bindIntParameter(boundParam++, nextId) || !statement->bindStringParameter(boundParam, message)) {
         ACSDK_ERROR(LX("storeFailed").m("Could not bind parameter."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("storeFailed").m("Could not perform step."));
         return false;
     }
@@ -173,6 +226,9 @@ bool SQLiteMessageStorage::store(const std::string& message, int* id) {
 }
 
 bool SQLiteMessageStorage::load(std::queue<StoredMessage>* messageContainer) {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return load(messageContainer); });
+    }
     if (!m_dbHandle) {
         ACSDK_ERROR(LX("loadFailed").m("Database handle is not open."));
         return false;
@@ -192,45 +248,39 @@ bool SQLiteMessageStorage::load(std::queue<StoredMessage>* messageContainer) {
         return false;
     }
 
-    // local values which we will use to capture what we read from the database.
-    int id = 0;
-    std::string message;
-
-    if (!statement.step()) {
-        ACSDK_ERROR(LX("loadFailed").m("Could not perform step."));
+    // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.
+    int idColumn = statement.getColumnIndex(DATABASE_COLUMN_ID_NAME);
+    int messageColumn = statement.getColumnIndex(DATABASE_COLUMN_MESSAGE_TEXT_NAME);
+    if (idColumn < 0 || messageColumn < 0) {
+        ACSDK_ERROR(LX("loadFailed").m("Could not find columns."));
         return false;
     }
 
-    while (SQLITE_ROW == statement.getStepResult()) {
-        int numberColumns = statement.getColumnCount();
-
-        // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.
-        for (int i = 0; i < numberColumns; i++) {
-            std::string columnName = statement.getColumnName(i);
-
-            if (DATABASE_COLUMN_ID_NAME == columnName) {
-                id = statement.getColumnInt(i);
-            } else if (DATABASE_COLUMN_MESSAGE_TEXT_NAME == columnName) {
-                message = statement.getColumnText(i);
-            }
-        }
-
-        StoredMessage storedMessage(id, message);
+    // The message is copied once, straight from SQLite into the queue.
+    bool visitedAllRows = statement.forEachRow([&](const SQLiteStatement& row) {
+        messageContainer->emplace();
+        auto& storedMessage = messageContainer->back();
+        storedMessage.id = row.getColumnInt(idColumn);
+        auto message = row.getColumnTextView(messageColumn);
+        storedMessage.message.assign(message.data(), message.size());
+        return true;
+    });
 
-        messageContainer->push(storedMessage);
+    statement.finalize();
 
-        statement.step();
+    if (!visitedAllRows) {
+        ACSDK_ERROR(LX("loadFailed").m("Could not perform step."));
+        return false;
     }
 
-    statement.finalize();
-
     return true;
 }
 
 bool SQLiteMessageStorage::erase(int messageId) {
-    std::string sqlString = "DELETE FROM " + MESSAGES_TABLE_NAME + " WHERE id=?;";
-
-    SQLiteStatement statement(m_dbHandle, sqlString);
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([&](sqlite3*) { return erase(messageId); });
+    }
+    auto statement = m_statementCache.get(m_dbHandle, ERASE_MESSAGE_STATEMENT_ID, ERASE_MESSAGE_SQL_STRING);
 
     if (!statement.isValid()) {
         ACSDK_ERROR(LX("eraseFailed").m("Could not create statement."));
@@ -238,12 +288,12 @@ bool SQLiteMessageStorage::erase(int messageId) {
     }
 
     int boundParam = 1;
-    if (!statement.bindIntParameter(boundParam, messageId)) {
+    if (!statement->bindIntParameter(boundParam, messageId)) {
         ACSDK_ERROR(LX("eraseFailed").m("Could not bind messageId."));
         return false;
     }
 
-    if (!statement.step()) {
+    if (!statement->step()) {
         ACSDK_ERROR(LX("eraseFailed").m("Could not perform step."));
         return false;
     }
@@ -252,6 +302,9 @@ bool SQLiteMessageStorage::erase(int messageId) {
 }
 
 bool SQLiteMessageStorage::clearDatabase() {
+    if (m_database && !m_database->isStorageThread()) {
+        return m_database->run([this](sqlite3*) { return clearDatabase(); });
+    }
     if (!clearTable(m_dbHandle, MESSAGES_TABLE_NAME)) {
         ACSDK_ERROR(LX("clearDatabaseFailed").m("could not clear messages table."));
         return false;
@@ -260,5 +313,73 @@ bool SQLiteMessageStorage::clearDatabase() {
     return true;
 }
 
+bool SQLiteMessageStorage::beginTransaction() {
+    if (!m_dbHandle) {
+        ACSDK_ERROR(LX("beginTransactionFailed").m("Database handle is not open."));
+        return false;
+    }
+    if (m_database) {
+        // The shared database already commits the messages stored at the same time together.
+        return true;
+    }
+    if (m_isInTransaction) {
+        ACSDK_ERROR(LX("beginTransactionFailed").m("A transaction is already open."));
+        return false;
+    }
+    if (!storage::sqliteStorage::beginTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("beginTransactionFailed").m("Could not begin transaction."));
+        return false;
+    }
+    m_isInTransaction = true;
+    return true;
+}
+
+bool SQLiteMessageStorage::commitTransaction() {
+    if (m_database) {
+        return true;
+    }
+    if (!m_isInTransaction) {
+        ACSDK_ERROR(LX("commitTransactionFailed").m("No transaction is open."));
+        return false;
+    }
+    m_isInTransaction = false;
+    if (!storage::sqliteStorage::commitTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("commitTransactionFailed").m("Could not commit transaction."));
+        return false;
+    }
+    return true;
+}
+
+bool SQLiteMessageStorage::useSharedDatabase(sqlite3* dbHandle, bool createTable) {
+    if (!tableExists(dbHandle, MESSAGES_TABLE_NAME)) {
+        if (!createTable) {
+            ACSDK_ERROR(LX("openFailed").m("Table does not exist in the shared database."));
+            return false;
+        }
+        if (!performQuery(dbHandle, CREATE_MESSAGES_TABLE_SQL_STRING)) {
+            ACSDK_ERROR(LX("createDatabaseFailed").m("Table could not be created."));
+            return false;
+        }
+    }
+    m_dbHandle = dbHandle;
+    return true;
+}
+
+void SQLiteMessageStorage::configureJournal() {
+    auto configurationRoot = ConfigurationNode::getRoot()[CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY];
+
+    bool enableWriteAheadLog = false;
+    configurationRoot.getBool(ENABLE_WRITE_AHEAD_LOG_KEY, &enableWriteAheadLog, false);
+    if (enableWriteAheadLog && !storage::sqliteStorage::enableWriteAheadLog(m_dbHandle)) {
+        ACSDK_WARN(LX("configureJournal").m("Could not enable write-ahead logging."));
+    }
+
+    std::string synchronous;
+    configurationRoot.getString(SYNCHRONOUS_KEY, &synchronous);
+    if (!synchronous.empty() && !setSynchronous(m_dbHandle, synchronous)) {
+        ACSDK_WARN(LX("configureJournal").m("Could not set synchronous level.").d("level", synchronous));
+    }
+}
+
 }  // namespace certifiedSender
 }  // namespace alexaClientSDK
\ No newline at end of file
@@ -0,0 +1,236 @@
+/*
+ * AppendLogMessageStorageTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AppendLogMessageStorageTest.cpp
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CertifiedSender/AppendLogMessageStorage.h>
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+namespace test {
+
+/// A test message text.
+static const std::string TEST_MESSAGE_ONE = "test_message_one";
+/// A test message text.
+static const std::string TEST_MESSAGE_TWO = "test_message_two";
+/// A test message text.
+static const std::string TEST_MESSAGE_THREE = "test_message_three";
+
+/// A segment size which holds a single test message.
+static const size_t SMALL_SEGMENT_SIZE = 48;
+
+/**
+ * Our GTest class.
+ */
+class AppendLogMessageStorageTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * List the segment files of the database.
+     *
+     * @return The names of the segment files, sorted.
+     */
+    std::vector<std::string> listSegments();
+
+    /**
+     * Load the messages of the database.
+     *
+     * @param storage The storage to load from.
+     * @return The texts of the messages, in order.
+     */
+    std::vector<std::string> loadMessages(AppendLogMessageStorage* storage);
+
+    /// The directory of the database.
+    std::string m_path;
+};
+
+void AppendLogMessageStorageTest::SetUp() {
+    m_path = "/tmp/AppendLogMessageStorageTest." + std::to_string(getpid());
+}
+
+void AppendLogMessageStorageTest::TearDown() {
+    for (auto& name : listSegments()) {
+        unlink((m_path + "/" + name).c_str());
+    }
+    rmdir(m_path.c_str());
+}
+
+std::vector<std::string> AppendLogMessageStorageTest::listSegments() {
+    std::vector<std::string> names;
+    DIR* directory = opendir(m_path.c_str());
+    if (!directory) {
+        return names;
+    }
+    while (auto entry = readdir(directory)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            names.push_back(name);
+        }
+    }
+    closedir(directory);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::vector<std::string> AppendLogMessageStorageTest::loadMessages(AppendLogMessageStorage* storage) {
+    std::queue<MessageStorageInterface::StoredMessage> dbMessages;
+    std::vector<std::string> texts;
+    EXPECT_TRUE(storage->load(&dbMessages));
+    while (!dbMessages.empty()) {
+        texts.push_back(dbMessages.front().message);
+        dbMessages.pop();
+    }
+    return texts;
+}
+
+/**
+ * Verify that messages and their erasure are kept across a reopen, in order.
+ */
+TEST_F(AppendLogMessageStorageTest, storeEraseAndReopen) {
+    AppendLogMessageStorage storage;
+    ASSERT_FALSE(storage.open(m_path));
+    ASSERT_TRUE(storage.createDatabase(m_path));
+    ASSERT_TRUE(storage.isOpen());
+
+    int id1 = 0;
+    int id2 = 0;
+    int id3 = 0;
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_ONE, &id1));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_TWO, &id2));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_THREE, &id3));
+    ASSERT_LT(id1, id2);
+    ASSERT_LT(id2, id3);
+    ASSERT_TRUE(storage.erase(id2));
+    ASSERT_FALSE(storage.erase(id2));
+    storage.close();
+
+    ASSERT_FALSE(storage.createDatabase(m_path));
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_EQ(loadMessages(&storage), std::vector<std::string>({TEST_MESSAGE_ONE, TEST_MESSAGE_THREE}));
+
+    // ids are not reused after a reopen
+    int id4 = 0;
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_TWO, &id4));
+    ASSERT_GT(id4, id3);
+}
+
+/**
+ * Verify that segments are deleted from the head of the log once all of their messages have been erased.
+ */
+TEST_F(AppendLogMessageStorageTest, deletesAcknowledgedSegments) {
+    AppendLogMessageStorage storage(SMALL_SEGMENT_SIZE);
+    ASSERT_TRUE(storage.createDatabase(m_path));
+
+    int id1 = 0;
+    int id2 = 0;
+    int id3 = 0;
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_ONE, &id1));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_TWO, &id2));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_THREE, &id3));
+    ASSERT_EQ(listSegments().size(), 3u);
+
+    // erasing from the middle deletes nothing, since segments are only deleted from the head
+    ASSERT_TRUE(storage.erase(id2));
+    ASSERT_EQ(listSegments().size(), 4u);
+    ASSERT_TRUE(storage.erase(id1));
+    ASSERT_EQ(listSegments().size(), 2u);
+    ASSERT_TRUE(storage.erase(id3));
+    ASSERT_LE(listSegments().size(), 1u);
+    ASSERT_TRUE(loadMessages(&storage).empty());
+
+    storage.close();
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_TRUE(loadMessages(&storage).empty());
+}
+
+/**
+ * Verify that a record damaged by a power failure is discarded with the records after it, and that new records are
+ * written in its place.
+ */
+TEST_F(AppendLogMessageStorageTest, discardsTornRecord) {
+    AppendLogMessageStorage storage;
+    ASSERT_TRUE(storage.createDatabase(m_path));
+    int id = 0;
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_ONE, &id));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_TWO, &id));
+    storage.close();
+
+    // Flip the last byte of the second message.
+    auto segments = listSegments();
+    ASSERT_EQ(segments.size(), 1u);
+    std::fstream file(m_path + "/" + segments.front(), std::ios::in | std::ios::out | std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto position = content.rfind(TEST_MESSAGE_TWO);
+    ASSERT_NE(position, std::string::npos);
+    file.seekp(position + TEST_MESSAGE_TWO.size() - 1);
+    file.put('X');
+    file.close();
+
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_EQ(loadMessages(&storage), std::vector<std::string>({TEST_MESSAGE_ONE}));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_THREE, &id));
+    storage.close();
+
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_EQ(loadMessages(&storage), std::vector<std::string>({TEST_MESSAGE_ONE, TEST_MESSAGE_THREE}));
+}
+
+/**
+ * Verify that the changes made in a transaction are kept once it is committed, and that clearing the database
+ * erases everything.
+ */
+TEST_F(AppendLogMessageStorageTest, transactionAndClear) {
+    AppendLogMessageStorage storage;
+    ASSERT_TRUE(storage.createDatabase(m_path));
+    ASSERT_FALSE(storage.commitTransaction());
+    ASSERT_TRUE(storage.beginTransaction());
+    ASSERT_FALSE(storage.beginTransaction());
+    int id = 0;
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_ONE, &id));
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_TWO, &id));
+    ASSERT_TRUE(storage.commitTransaction());
+    storage.close();
+
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_EQ(loadMessages(&storage), std::vector<std::string>({TEST_MESSAGE_ONE, TEST_MESSAGE_TWO}));
+    ASSERT_TRUE(storage.clearDatabase());
+    ASSERT_TRUE(loadMessages(&storage).empty());
+    ASSERT_TRUE(storage.store(TEST_MESSAGE_THREE, &id));
+    storage.close();
+
+    ASSERT_TRUE(storage.open(m_path));
+    ASSERT_EQ(loadMessages(&storage), std::vector<std::string>({TEST_MESSAGE_THREE}));
+}
+
+}  // namespace test
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
@@ -19,6 +19,7 @@
 #include <gmock/gmock.h>
 
 #include <CertifiedSender/SQLiteMessageStorage.h>
+#include <SQLiteStorage/SQLiteDatabaseService.h>
 
 #include <AVSCommon/Utils/File/FileUtils.h>
 
@@ -221,6 +222,62 @@ TEST_F(MessageStorageTest, testDatabaseClear) {
     ASSERT_EQ(static_cast<int>(dbMessages.size()), 0);
 }
 
+/**
+ * Test that the changes made in a transaction are kept once it is committed, and that transactions do not nest.
+ */
+TEST_F(MessageStorageTest, testDatabaseTransaction) {
+    createDatabase();
+    ASSERT_TRUE(m_storage->isOpen());
+
+    ASSERT_FALSE(m_storage->commitTransaction());
+    ASSERT_TRUE(m_storage->beginTransaction());
+    ASSERT_FALSE(m_storage->beginTransaction());
+
+    int dbId = 0;
+    ASSERT_TRUE(m_storage->store(TEST_MESSAGE_ONE, &dbId));
+    ASSERT_TRUE(m_storage->store(TEST_MESSAGE_TWO, &dbId));
+    ASSERT_TRUE(m_storage->erase(1));
+    ASSERT_TRUE(m_storage->commitTransaction());
+
+    // reopen the database, to check that the changes reached the file
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(g_dbTestFilePath));
+
+    std::queue<MessageStorageInterface::StoredMessage> dbMessages;
+    ASSERT_TRUE(m_storage->load(&dbMessages));
+    ASSERT_EQ(static_cast<int>(dbMessages.size()), 1);
+    ASSERT_EQ(dbMessages.front().message, TEST_MESSAGE_TWO);
+}
+
+/**
+ * Test that messages kept in a shared database are found again by another storage using it, and that transactions are
+ * left to the shared database.
+ */
+TEST_F(MessageStorageTest, testSharedDatabase) {
+    auto database = storage::sqliteStorage::SQLiteDatabaseService::create(g_dbTestFilePath);
+    ASSERT_TRUE(database);
+    auto sharedStorage = std::make_shared<SQLiteMessageStorage>(database);
+    ASSERT_FALSE(sharedStorage->open(g_dbTestFilePath));
+    ASSERT_TRUE(sharedStorage->createDatabase(g_dbTestFilePath));
+    ASSERT_TRUE(sharedStorage->isOpen());
+
+    ASSERT_TRUE(sharedStorage->beginTransaction());
+    int dbId = 0;
+    ASSERT_TRUE(sharedStorage->store(TEST_MESSAGE_ONE, &dbId));
+    ASSERT_TRUE(sharedStorage->store(TEST_MESSAGE_TWO, &dbId));
+    ASSERT_TRUE(sharedStorage->erase(1));
+    ASSERT_TRUE(sharedStorage->commitTransaction());
+    sharedStorage->close();
+    ASSERT_FALSE(sharedStorage->isOpen());
+
+    auto otherStorage = std::make_shared<SQLiteMessageStorage>(database);
+    ASSERT_TRUE(otherStorage->open(g_dbTestFilePath));
+    std::queue<MessageStorageInterface::StoredMessage> dbMessages;
+    ASSERT_TRUE(otherStorage->load(&dbMessages));
+    ASSERT_EQ(static_cast<int>(dbMessages.size()), 1);
+    ASSERT_EQ(dbMessages.front().message, TEST_MESSAGE_TWO);
+}
+
 }  // namespace test
 }  // namespace certifiedSender
 }  // namespace alexaClientSDK
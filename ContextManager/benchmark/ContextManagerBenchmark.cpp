@@ -0,0 +1,320 @@
+/*
+ * ContextManagerBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ContextManagerBenchmark.cpp
+///
+/// Measures how the time to get the context scales with the number of state providers and of concurrent requesters.
+/// Each scenario registers synthetic state providers with the @c ContextManager: a quarter of them set their state
+/// once with @c StateRefreshPolicy::NEVER, and the others are asked for it on each @c getContext() and answer with
+/// @c StateRefreshPolicy::ALWAYS from an executor of their own, after a delay, as capability agents do.  Requesters
+/// then call @c getContext() concurrently, each waiting for its context before asking again.
+///
+/// For each scenario, the benchmark reports the p50 and p99 time from @c getContext() to @c onContextAvailable(), the
+/// throughput in contexts per second, and the process CPU time per context.
+///
+/// Usage: ContextManagerBenchmark [--quick]
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/ContextRequesterInterface.h>
+#include <AVSCommon/SDKInterfaces/StateProviderInterface.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+#include "ContextManager/ContextManager.h"
+
+namespace alexaClientSDK {
+namespace contextManager {
+namespace benchmark {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+
+using Clock = std::chrono::steady_clock;
+
+/// A state of roughly the size capability agents set.
+static const std::string STATE =
+    "{\"token\":\"amzn1.as-ct.v1.Domain:Application:Knowledge#ACRI#5f0a3b6e-8a0d-4b7c-9e61-2c4d7f1a0b2c\","
+    "\"offsetInMilliseconds\":0,\"playerActivity\":\"FINISHED\"}";
+
+/// A mix of state providers and requesters to benchmark.
+struct Scenario {
+    /// The number of state providers.
+    int numProviders;
+
+    /// The number of requesters calling @c getContext() concurrently.
+    int numRequesters;
+
+    /// The longest delay before a provider answers; the delays are spread evenly up to it.
+    std::chrono::microseconds maxProvideDelay;
+
+    /// The freshness window of the @c ContextManager.
+    std::chrono::milliseconds freshnessWindow;
+};
+
+/**
+ * A state provider which answers each request from its own executor, after a fixed delay.
+ */
+class BenchmarkStateProvider : public StateProviderInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param name The namespace and name of the state.
+     * @param delay How long the provider takes to answer.
+     * @param contextManager The @c ContextManager to answer, which must outlive the requests it makes.
+     */
+    BenchmarkStateProvider(
+        const NamespaceAndName& name,
+        std::chrono::microseconds delay,
+        ContextManager* contextManager) :
+            m_name(name),
+            m_delay{delay},
+            m_contextManager{contextManager} {
+    }
+
+    void provideState(const unsigned int stateRequestToken) override {
+        m_executor.submit([this, stateRequestToken]() {
+            if (m_delay > std::chrono::microseconds::zero()) {
+                std::this_thread::sleep_for(m_delay);
+            }
+            m_contextManager->setState(m_name, STATE, StateRefreshPolicy::ALWAYS, stateRequestToken);
+        });
+    }
+
+    /// Wait for the answers in progress, so that none reaches the @c ContextManager once it is gone.
+    void shutdown() {
+        m_executor.waitForSubmittedTasks();
+        m_executor.shutdown();
+    }
+
+private:
+    /// The namespace and name of the state.
+    const NamespaceAndName m_name;
+
+    /// How long the provider takes to answer.
+    const std::chrono::microseconds m_delay;
+
+    /// The @c ContextManager to answer.
+    ContextManager* m_contextManager;
+
+    /// The executor answering requests.
+    avsCommon::utils::threading::Executor m_executor;
+};
+
+/**
+ * A requester which lets its thread wait for each context.
+ */
+class BenchmarkRequester : public ContextRequesterInterface {
+public:
+    /// Constructor.
+    BenchmarkRequester() : m_isDone{false}, m_failures{0} {
+    }
+
+    void onContextAvailable(const std::string& jsonContext) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isDone = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    void onContextFailure(const ContextRequestError error) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_failures;
+        m_isDone = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Get the context and wait for it.
+     *
+     * @param contextManager The @c ContextManager to ask.
+     * @param self This requester.
+     * @return How long the context took.
+     */
+    Clock::duration getContext(ContextManager* contextManager, std::shared_ptr<BenchmarkRequester> self) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isDone = false;
+        lock.unlock();
+        auto start = Clock::now();
+        contextManager->getContext(self);
+        lock.lock();
+        m_wakeTrigger.wait(lock, [this]() { return m_isDone; });
+        return Clock::now() - start;
+    }
+
+    /// The number of requests which failed.
+    int getFailures() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_failures;
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the context is available.
+    std::condition_variable m_wakeTrigger;
+
+    /// Whether the current request is done.
+    bool m_isDone;
+
+    /// The number of requests which failed.
+    int m_failures;
+};
+
+/**
+ * Get the CPU time used by this process.
+ *
+ * @return The CPU time used by this process.
+ */
+static std::chrono::nanoseconds processCpuTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
+
+/**
+ * Get a percentile of a list of samples.
+ *
+ * @param samples The samples, which must be sorted.
+ * @param percentile The percentile (0-100) to return.
+ * @return The sample at @c percentile, or zero if there are no samples.
+ */
+static std::chrono::microseconds percentile(const std::vector<Clock::duration>& samples, size_t percentile) {
+    if (samples.empty()) {
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        samples[std::min(samples.size() - 1, samples.size() * percentile / 100)]);
+}
+
+/**
+ * Run one scenario and print its results.
+ *
+ * @param scenario The scenario to run.
+ * @param requestsPerRequester The number of contexts each requester gets.
+ */
+static void run(const Scenario& scenario, int requestsPerRequester) {
+    auto contextManager = ContextManager::create(scenario.freshnessWindow);
+    std::vector<std::shared_ptr<BenchmarkStateProvider>> providers;
+    for (int i = 0; i < scenario.numProviders; ++i) {
+        NamespaceAndName name{"Benchmark", "State" + std::to_string(i)};
+        if (0 == i % 4) {
+            contextManager->setState(name, STATE, StateRefreshPolicy::NEVER);
+            continue;
+        }
+        auto delay = scenario.maxProvideDelay * (i % 4) / 3;
+        providers.push_back(std::make_shared<BenchmarkStateProvider>(name, delay, contextManager.get()));
+        contextManager->setStateProvider(name, providers.back());
+        contextManager->setState(name, STATE, StateRefreshPolicy::ALWAYS);
+    }
+
+    std::vector<std::shared_ptr<BenchmarkRequester>> requesters;
+    std::vector<std::vector<Clock::duration>> latencies(scenario.numRequesters);
+    std::vector<std::thread> threads;
+    auto cpuStart = processCpuTime();
+    auto start = Clock::now();
+    for (int r = 0; r < scenario.numRequesters; ++r) {
+        requesters.push_back(std::make_shared<BenchmarkRequester>());
+        auto requester = requesters.back();
+        auto requesterLatencies = &latencies[r];
+        auto manager = contextManager.get();
+        threads.push_back(std::thread([requester, requesterLatencies, manager, requestsPerRequester]() {
+            for (int i = 0; i < requestsPerRequester; ++i) {
+                requesterLatencies->push_back(requester->getContext(manager, requester));
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    auto cpu = std::chrono::duration<double, std::micro>(processCpuTime() - cpuStart).count();
+
+    std::vector<Clock::duration> allLatencies;
+    int failures = 0;
+    for (int r = 0; r < scenario.numRequesters; ++r) {
+        allLatencies.insert(allLatencies.end(), latencies[r].begin(), latencies[r].end());
+        failures += requesters[r]->getFailures();
+    }
+    std::sort(allLatencies.begin(), allLatencies.end());
+    for (auto& provider : providers) {
+        provider->shutdown();
+    }
+    contextManager.reset();
+
+    int numRequests = scenario.numRequesters * requestsPerRequester;
+    std::cout << std::setw(10) << scenario.numProviders << std::setw(11) << scenario.numRequesters << std::setw(10)
+              << scenario.maxProvideDelay.count() << std::setw(11) << scenario.freshnessWindow.count() << std::setw(10)
+              << percentile(allLatencies, 50).count() << std::setw(10) << percentile(allLatencies, 99).count()
+              << std::setw(12) << std::fixed << std::setprecision(0) << numRequests / elapsed << std::setw(11)
+              << std::setprecision(1) << cpu / numRequests << std::setw(10) << failures << std::endl;
+}
+
+/**
+ * Run every scenario and print a table of results.
+ *
+ * @param isQuick Whether to get fewer contexts in each scenario.
+ */
+static void runAll(bool isQuick) {
+    const int requestsPerRequester = isQuick ? 50 : 500;
+    const std::chrono::microseconds noDelay = std::chrono::microseconds::zero();
+    const std::chrono::microseconds delay = std::chrono::microseconds(2000);
+    const std::chrono::milliseconds noWindow = std::chrono::milliseconds::zero();
+    const std::chrono::milliseconds window = std::chrono::milliseconds(100);
+    std::vector<Scenario> scenarios = {{4, 1, noDelay, noWindow},
+                                       {16, 1, noDelay, noWindow},
+                                       {64, 1, noDelay, noWindow},
+                                       {16, 4, noDelay, noWindow},
+                                       {16, 16, noDelay, noWindow},
+                                       {16, 1, delay, noWindow},
+                                       {16, 16, delay, noWindow},
+                                       {64, 16, delay, noWindow},
+                                       {64, 16, delay, window}};
+
+    std::cout << "Latencies are from getContext() to onContextAvailable(), in microseconds." << std::endl;
+    std::cout << std::setw(10) << "providers" << std::setw(11) << "requesters" << std::setw(10) << "delay(us)"
+              << std::setw(11) << "fresh(ms)" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(12)
+              << "contexts/s" << std::setw(11) << "cpu(us)" << std::setw(10) << "failures" << std::endl;
+    for (const auto& scenario : scenarios) {
+        run(scenario, requestsPerRequester);
+    }
+}
+
+}  // namespace benchmark
+}  // namespace contextManager
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    bool isQuick = (argc > 1 && std::string("--quick") == argv[1]);
+    // Per-request logging would dominate the measurements.
+    alexaClientSDK::avsCommon::utils::logger::ACSDK_GET_SINK_LOGGER().setLevel(
+        alexaClientSDK::avsCommon::utils::logger::Level::WARN);
+    alexaClientSDK::contextManager::benchmark::runAll(isQuick);
+    return EXIT_SUCCESS;
+}
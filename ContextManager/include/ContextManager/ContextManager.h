@@ -27,15 +27,12 @@
 #include <unordered_map>
 #include <condition_variable>
 
-#include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
-
 #include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
 #include <AVSCommon/SDKInterfaces/ContextRequesterInterface.h>
 #include <AVSCommon/SDKInterfaces/StateProviderInterface.h>
 #include <AVSCommon/AVS/StateRefreshPolicy.h>
 #include <AVSCommon/AVS/NamespaceAndName.h>
+#include <AVSCommon/Utils/Metrics/MemoryAccounting.h>
 
 namespace alexaClientSDK {
 namespace contextManager {
@@ -46,12 +43,50 @@ namespace contextManager {
  */
 class ContextManager : public avsCommon::sdkInterfaces::ContextManagerInterface {
 public:
+    /// What to do when a @c StateProviderInterface does not provide its state before its deadline.
+    enum class TimeoutPolicy {
+        /// Fail the context requests with @c ContextRequestError::STATE_PROVIDER_TIMEDOUT.
+        FAIL,
+        /**
+         * Build the context with the last state the @c StateProviderInterface provided, if it has provided one, and
+         * otherwise fail the context requests.
+         */
+        USE_LAST_STATE
+    };
+
+    /// The default time a @c StateProviderInterface has to respond to a @c provideState request.
+    static const std::chrono::milliseconds DEFAULT_PROVIDE_STATE_TIMEOUT;
+
     /**
      * Create a new @c ContextManager instance.
      *
+     * Requests for the context are coalesced: all the requesters queued while the states are being requested from the
+     * @c StateProviderInterfaces are sent the same context.  Requests made within @c freshnessWindow of the last time
+     * the states were updated are sent a context built from those states, without requesting them again.
+     *
+     * @param freshnessWindow How long after the states were updated they may be reused for further requests.  Zero
+     * requests them again for every request made after the context was sent.
+     * @param provideStateTimeout How long a @c StateProviderInterface has to respond to a @c provideState request,
+     * unless it is given a deadline of its own with @c setProvideStateDeadline().
      * @return Returns a new @c ContextManager.
      */
-    static std::shared_ptr<ContextManager> create();
+    static std::shared_ptr<ContextManager> create(
+        std::chrono::milliseconds freshnessWindow = std::chrono::milliseconds::zero(),
+        std::chrono::milliseconds provideStateTimeout = DEFAULT_PROVIDE_STATE_TIMEOUT);
+
+    /**
+     * Sets the deadline of a @c StateProviderInterface for responding to @c provideState requests, and what to do
+     * when it misses it.  A context request then takes no longer than the longest deadline of the providers it is
+     * waiting for, and a late provider whose policy is @c TimeoutPolicy::USE_LAST_STATE no longer fails it.
+     *
+     * @param stateProviderName The name of the @c StateProviderInterface, which need not be registered yet.
+     * @param timeout How long the @c StateProviderInterface has to respond to a @c provideState request.
+     * @param policy What to do when the @c StateProviderInterface does not respond in time.
+     */
+    void setProvideStateDeadline(
+        const avsCommon::avs::NamespaceAndName& stateProviderName,
+        std::chrono::milliseconds timeout,
+        TimeoutPolicy policy);
 
     /// Destructor.
     ~ContextManager() override;
@@ -68,6 +103,8 @@ public:
 
     void getContext(std::shared_ptr<avsCommon::sdkInterfaces::ContextRequesterInterface> contextRequester) override;
 
+    bool getCachedContext(std::chrono::milliseconds maxAge, std::string* jsonContext) override;
+
 private:
     /**
      * This class has all the information about a @c StateProviderInterface needed by the contextManager.
@@ -79,9 +116,18 @@ private:
         /// The state of the @c StateProviderInterface.
         std::string jsonState;
 
+        /**
+         * The header and payload of the state, serialized as a JSON object when the state is set so that building the
+         * context only has to join them.  This is empty if the state could not be serialized.
+         */
+        std::string serializedState;
+
         /// RefreshPolicy for the state of a @c StateProviderInterface.
         avsCommon::avs::StateRefreshPolicy refreshPolicy;
 
+        /// The memory of @c jsonState and @c serializedState, as counted in @c MemoryAccounting.
+        avsCommon::utils::metrics::MemoryAccounting::Allocation memory;
+
         /**
          * Constructor.
          *
@@ -95,8 +141,22 @@ private:
             avsCommon::avs::StateRefreshPolicy initRefreshPolicy = avsCommon::avs::StateRefreshPolicy::ALWAYS);
     };
 
-    /// Constructor.
-    ContextManager();
+    /// The deadline of a @c StateProviderInterface for responding to @c provideState requests.
+    struct ProvideStateDeadline {
+        /// How long the @c StateProviderInterface has to respond.
+        std::chrono::milliseconds timeout;
+
+        /// What to do when the @c StateProviderInterface does not respond in time.
+        TimeoutPolicy policy;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param freshnessWindow How long after the states were updated they may be reused for further requests.
+     * @param provideStateTimeout How long a @c StateProviderInterface without a deadline of its own has to respond.
+     */
+    ContextManager(std::chrono::milliseconds freshnessWindow, std::chrono::milliseconds provideStateTimeout);
 
     /**
      * Initialize a new instance of @c ContextManager.
@@ -123,10 +183,34 @@ private:
      */
     void requestStatesLocked(std::unique_lock<std::mutex>& stateProviderLock);
 
+    /**
+     * Gets the deadline of a @c StateProviderInterface.  The @c m_stateProviderMutex needs to be acquired before this
+     * function is called.
+     *
+     * @param stateProviderName The name of the @c StateProviderInterface.
+     * @return Its deadline, or the default one if it was not given one.
+     */
+    ProvideStateDeadline getProvideStateDeadlineLocked(const avsCommon::avs::NamespaceAndName& stateProviderName);
+
+    /**
+     * Waits for the @c StateProviderInterfaces in @c m_pendingOnStateProviders to set their states, each until its
+     * deadline.  The providers which miss their deadline with @c TimeoutPolicy::USE_LAST_STATE keep their last state.
+     *
+     * @param stateProviderLock The lock acquired on the @c m_stateProviderMutex.
+     * @param requestTime When the states were requested.
+     * @param[out] usedLastStates Set to @c true if the last state of a late provider was kept.
+     * @return @c true if the context can be built, or @c false if a provider missed its deadline and it can not.
+     */
+    bool waitForStatesLocked(
+        std::unique_lock<std::mutex>& stateProviderLock,
+        std::chrono::steady_clock::time_point requestTime,
+        bool* usedLastStates);
+
     /**
      * Sends the context to all @c ContextRequesterInterfaces in the queue. It sends failure to all the
      * @c ContextRequesterInterfaces if an error was encountered while updating the states or building the context.
-     * It removes the @c ContextRequesterInterface from the queue after sending context or failure.
+     * It removes the @c ContextRequesterInterface from the queue after sending context or failure.  Requesters queued
+     * while the states were being requested are sent the same context, so that concurrent requests share one round.
      *
      * @param context The context JSON string. This is an empty string if a failure needs to be reported.
      * @param contextRequestError The error to send to the context requesters. If the context is not an empty string,
@@ -144,33 +228,29 @@ private:
     void updateStatesLoop();
 
     /**
-     * Builds the context header.
+     * Serializes a JSON state object. The state includes the header and the payload.  The header is written directly
+     * and the payload, once checked to be valid JSON, is spliced in as it is, without building a document.
      *
      * @param namespaceAndName Namespace and name of the state provider.
-     * @param allocator The rapidjson allocator to use to build the JSON header.
-     * @return Header as a JSON object if successful else empty value.
+     * @param jsonPayloadValue The payload value associated with the "payload" key.
+     * @return The serialized state if successful else an empty string.
      */
-    rapidjson::Value buildHeader(
+    std::string serializeState(
         const avsCommon::avs::NamespaceAndName& namespaceAndName,
-        rapidjson::Document::AllocatorType& allocator);
+        const std::string& jsonPayloadValue);
 
     /**
-     * Builds a JSON state object. The state includes the header and the payload.
+     * Builds the context by joining the states serialized for each of the @c stateProviderInterfaces.  The
+     * @c m_stateProviderMutex needs to be acquired before this function is called.
      *
-     * @param namespaceAndName Namespace and name of the state provider.
-     * @param jsonPayloadValue The payload value associated with the "payload" key.
-     * @param allocator The rapidjson allocator to use to build the JSON header.
-     * @return A state object if successful else empty value.
+     * @param[out] context The context JSON string.
+     * @return Whether the context was built.
      */
-    rapidjson::Value buildState(
-        const avsCommon::avs::NamespaceAndName& namespaceAndName,
-        const std::string jsonPayloadValue,
-        rapidjson::Document::AllocatorType& allocator);
+    bool buildContextLocked(std::string* context);
 
     /**
-     * Builds the context states from a map of state provider namespace and name to state information provided by each
-     * of the @c stateProviderInterfaces and sends the context by calling @c onContextAvailable for each of the context
-     * requesters.
+     * Builds the context from the states serialized for each of the @c stateProviderInterfaces and sends the context
+     * by calling @c onContextAvailable for each of the context requesters.
      */
     void sendContextToRequesters();
 
@@ -180,6 +260,12 @@ private:
      */
     std::unordered_map<avsCommon::avs::NamespaceAndName, std::shared_ptr<StateInfo>> m_namespaceNameToStateInfo;
 
+    /**
+     * The deadlines given to @c StateProviderInterfaces with @c setProvideStateDeadline().  @c m_stateProviderMutex
+     * must be acquired before accessing the map.
+     */
+    std::unordered_map<avsCommon::avs::NamespaceAndName, ProvideStateDeadline> m_provideStateDeadlines;
+
     /// Queue of contextRequesters. @c m_contextRequesterMutex must be acquired before accessing the queue.
     std::queue<std::shared_ptr<avsCommon::sdkInterfaces::ContextRequesterInterface>> m_contextRequesterQueue;
 
@@ -217,6 +303,24 @@ private:
      */
     unsigned int m_stateRequestToken;
 
+    /**
+     * Whether the states have been updated for a @c getContext request.  The @c m_stateProviderMutex must be acquired
+     * before this value is modified or read.
+     */
+    bool m_hasUpdatedStates;
+
+    /**
+     * When the states were last updated for a @c getContext request.  The @c m_stateProviderMutex must be acquired
+     * before this value is modified or read.
+     */
+    std::chrono::steady_clock::time_point m_statesUpdateTime;
+
+    /// How long after the states were updated they may be reused for further requests.
+    const std::chrono::milliseconds m_freshnessWindow;
+
+    /// How long a @c StateProviderInterface without a deadline of its own has to respond to @c provideState.
+    const std::chrono::milliseconds m_provideStateTimeout;
+
     /*
      * Whether the contextManager is shutting down. The @c m_contextRequesterMutex is acquired before this value is
      * modified or read.
@@ -15,15 +15,16 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <string>
 
+#include <rapidjson/reader.h>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
 
 #include "ContextManager/ContextManager.h"
 
-/// A state provider is expected to respond to a @c provideState request within this timeout period.
-static const std::chrono::seconds PROVIDE_STATE_DEFAULT_TIMEOUT = std::chrono::seconds(2);
-
 namespace alexaClientSDK {
 namespace contextManager {
 
@@ -58,12 +59,27 @@ static const std::string PAYLOAD_JSON_KEY = "payload";
 /// The context json key.
 static const std::string CONTEXT_JSON_KEY = "context";
 
-std::shared_ptr<ContextManager> ContextManager::create() {
-    std::shared_ptr<ContextManager> contextManager(new ContextManager());
+/// The size of the keys and punctuation of a serialized state, to size its buffer up front.
+static const size_t STATE_FRAGMENTS_SIZE = 64;
+
+const std::chrono::milliseconds ContextManager::DEFAULT_PROVIDE_STATE_TIMEOUT = std::chrono::seconds(2);
+
+std::shared_ptr<ContextManager> ContextManager::create(
+    std::chrono::milliseconds freshnessWindow,
+    std::chrono::milliseconds provideStateTimeout) {
+    std::shared_ptr<ContextManager> contextManager(new ContextManager(freshnessWindow, provideStateTimeout));
     contextManager->init();
     return contextManager;
 }
 
+void ContextManager::setProvideStateDeadline(
+    const NamespaceAndName& stateProviderName,
+    std::chrono::milliseconds timeout,
+    TimeoutPolicy policy) {
+    std::lock_guard<std::mutex> stateProviderLock(m_stateProviderMutex);
+    m_provideStateDeadlines[stateProviderName] = {timeout, policy};
+}
+
 ContextManager::~ContextManager() {
     std::unique_lock<std::mutex> lock(m_contextRequesterMutex);
     m_shutdown = true;
@@ -144,20 +160,41 @@ void ContextManager::getContext(std::shared_ptr<ContextRequesterInterface> conte
     }
 }
 
+bool ContextManager::getCachedContext(std::chrono::milliseconds maxAge, std::string* jsonContext) {
+    if (!jsonContext) {
+        ACSDK_ERROR(LX("getCachedContextFailed").d("reason", "nullJsonContext"));
+        return false;
+    }
+    std::lock_guard<std::mutex> stateProviderLock(m_stateProviderMutex);
+    if (!m_hasUpdatedStates || std::chrono::steady_clock::now() - m_statesUpdateTime > maxAge) {
+        return false;
+    }
+    return buildContextLocked(jsonContext);
+}
+
 ContextManager::StateInfo::StateInfo(
     std::shared_ptr<avsCommon::sdkInterfaces::StateProviderInterface> initStateProvider,
     std::string initJsonState,
     avsCommon::avs::StateRefreshPolicy initRefreshPolicy) :
         stateProvider{initStateProvider},
         jsonState{initJsonState},
-        refreshPolicy{initRefreshPolicy} {
+        refreshPolicy{initRefreshPolicy},
+        memory{avsCommon::utils::metrics::MemoryAccounting::Category::JSON_DOCUMENTS} {
 }
 
-ContextManager::ContextManager() : m_stateRequestToken{0}, m_shutdown{false} {
+ContextManager::ContextManager(
+    std::chrono::milliseconds freshnessWindow,
+    std::chrono::milliseconds provideStateTimeout) :
+        m_stateRequestToken{0},
+        m_hasUpdatedStates{false},
+        m_freshnessWindow{freshnessWindow},
+        m_provideStateTimeout{provideStateTimeout},
+        m_shutdown{false} {
 }
 
 void ContextManager::init() {
-    m_updateStatesThread = std::thread(&ContextManager::updateStatesLoop, this);
+    m_updateStatesThread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::DIALOG, "context-manager", [this]() { updateStatesLoop(); });
 }
 
 SetStateResult ContextManager::updateStateLocked(
@@ -173,7 +210,8 @@ SetStateResult ContextManager::updateStateLocked(
                             .d("name", stateProviderName.name));
             return SetStateResult::STATE_PROVIDER_NOT_REGISTERED;
         }
-        m_namespaceNameToStateInfo[stateProviderName] = std::make_shared<StateInfo>(nullptr, jsonState, refreshPolicy);
+        auto stateInfo = std::make_shared<StateInfo>(nullptr, jsonState, refreshPolicy);
+        stateInfoMappingIt = m_namespaceNameToStateInfo.insert({stateProviderName, stateInfo}).first;
     } else {
         stateInfoMappingIt->second->jsonState = jsonState;
         stateInfoMappingIt->second->refreshPolicy = refreshPolicy;
@@ -183,6 +221,9 @@ SetStateResult ContextManager::updateStateLocked(
                         .d("namespace", stateProviderName.nameSpace)
                         .d("name", stateProviderName.name));
     }
+    auto& stateInfo = stateInfoMappingIt->second;
+    stateInfo->serializedState = serializeState(stateProviderName, jsonState);
+    stateInfo->memory.resize(stateInfo->jsonState.capacity() + stateInfo->serializedState.capacity());
     return SetStateResult::SUCCESS;
 }
 
@@ -208,6 +249,60 @@ void ContextManager::requestStatesLocked(std::unique_lock<std::mutex>& stateProv
     }
 }
 
+ContextManager::ProvideStateDeadline ContextManager::getProvideStateDeadlineLocked(
+    const NamespaceAndName& stateProviderName) {
+    auto it = m_provideStateDeadlines.find(stateProviderName);
+    if (m_provideStateDeadlines.end() == it) {
+        return {m_provideStateTimeout, TimeoutPolicy::FAIL};
+    }
+    return it->second;
+}
+
+bool ContextManager::waitForStatesLocked(
+    std::unique_lock<std::mutex>& stateProviderLock,
+    std::chrono::steady_clock::time_point requestTime,
+    bool* usedLastStates) {
+    while (!m_pendingOnStateProviders.empty()) {
+        // Wait until the earliest deadline of the providers still pending, then deal with those which missed theirs.
+        auto nextDeadline = std::chrono::steady_clock::time_point::max();
+        for (const auto& stateProviderName : m_pendingOnStateProviders) {
+            nextDeadline =
+                std::min(nextDeadline, requestTime + getProvideStateDeadlineLocked(stateProviderName).timeout);
+        }
+        if (m_setStateCompleteNotifier.wait_until(
+                stateProviderLock, nextDeadline, [this]() { return m_pendingOnStateProviders.empty(); })) {
+            return true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = m_pendingOnStateProviders.begin(); it != m_pendingOnStateProviders.end();) {
+            auto deadline = getProvideStateDeadlineLocked(*it);
+            if (now < requestTime + deadline.timeout) {
+                ++it;
+                continue;
+            }
+            auto stateInfoIt = m_namespaceNameToStateInfo.find(*it);
+            bool hasLastState =
+                stateInfoIt != m_namespaceNameToStateInfo.end() && !stateInfoIt->second->serializedState.empty();
+            if (TimeoutPolicy::USE_LAST_STATE != deadline.policy || !hasLastState) {
+                ACSDK_ERROR(LX("updateStatesLoopFailed")
+                                .d("reason", "stateProviderTimedOut")
+                                .d("namespace", it->nameSpace)
+                                .d("name", it->name));
+                // The states are requested again with a new token for the next request.
+                m_pendingOnStateProviders.clear();
+                return false;
+            }
+            ACSDK_WARN(LX("stateProviderTimedOut")
+                           .d("action", "usingLastState")
+                           .d("namespace", it->nameSpace)
+                           .d("name", it->name));
+            *usedLastStates = true;
+            it = m_pendingOnStateProviders.erase(it);
+        }
+    }
+    return true;
+}
+
 void ContextManager::sendContextAndClearQueue(
     const std::string& context,
     const ContextRequestError& contextRequestError) {
@@ -236,17 +331,27 @@ void ContextManager::updateStatesLoop() {
         }
 
         std::unique_lock<std::mutex> stateProviderLock(m_stateProviderMutex);
+        if (m_hasUpdatedStates && m_freshnessWindow > std::chrono::milliseconds::zero() &&
+            std::chrono::steady_clock::now() - m_statesUpdateTime <= m_freshnessWindow) {
+            // The states were updated for a request moments ago, so they are fresh enough for these requests too.
+            stateProviderLock.unlock();
+            ACSDK_DEBUG9(LX("updateStatesLoop").d("action", "reusingFreshStates"));
+            sendContextToRequesters();
+            continue;
+        }
+        auto requestTime = std::chrono::steady_clock::now();
         requestStatesLocked(stateProviderLock);
 
-        if (!m_pendingOnStateProviders.empty()) {
-            if (!m_setStateCompleteNotifier.wait_for(stateProviderLock, PROVIDE_STATE_DEFAULT_TIMEOUT, [this]() {
-                    return m_pendingOnStateProviders.empty();
-                })) {
-                stateProviderLock.unlock();
-                ACSDK_ERROR(LX("updateStatesLoopFailed").d("reason", "stateProviderTimedOut"));
-                sendContextAndClearQueue("", ContextRequestError::STATE_PROVIDER_TIMEDOUT);
-                continue;
-            }
+        bool usedLastStates = false;
+        if (!waitForStatesLocked(stateProviderLock, requestTime, &usedLastStates)) {
+            stateProviderLock.unlock();
+            sendContextAndClearQueue("", ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+            continue;
+        }
+        // A context with a provider's last state is sent as it is, but not reused as fresh for further requests.
+        if (!usedLastStates) {
+            m_hasUpdatedStates = true;
+            m_statesUpdateTime = std::chrono::steady_clock::now();
         }
         stateProviderLock.unlock();
 
@@ -254,76 +359,112 @@ void ContextManager::updateStatesLoop() {
     }
 }
 
-Value ContextManager::buildHeader(const NamespaceAndName& namespaceAndName, Document::AllocatorType& allocator) {
-    Value header(kObjectType);
-
-    header.AddMember(StringRef(NAMESPACE_JSON_KEY), namespaceAndName.nameSpace, allocator);
-    header.AddMember(StringRef(NAME_JSON_KEY), namespaceAndName.name, allocator);
-
-    return header;
+/**
+ * Appends a string to a buffer as a quoted and escaped JSON string.
+ *
+ * @param value The string to append.
+ * @param[out] out The buffer to append to.
+ */
+static void appendJsonString(const std::string& value, std::string* out) {
+    static const char* HEX_DIGITS = "0123456789abcdef";
+    *out += '"';
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"':
+                *out += "\\\"";
+                break;
+            case '\\':
+                *out += "\\\\";
+                break;
+            case '\n':
+                *out += "\\n";
+                break;
+            case '\r':
+                *out += "\\r";
+                break;
+            case '\t':
+                *out += "\\t";
+                break;
+            default:
+                if (c < 0x20) {
+                    *out += "\\u00";
+                    *out += HEX_DIGITS[c >> 4];
+                    *out += HEX_DIGITS[c & 0xf];
+                } else {
+                    *out += static_cast<char>(c);
+                }
+        }
+    }
+    *out += '"';
 }
 
-Value ContextManager::buildState(
+std::string ContextManager::serializeState(
     const NamespaceAndName& namespaceAndName,
-    const std::string jsonPayloadValue,
-    Document::AllocatorType& allocator) {
-    Document payload;
-    Value state(kObjectType);
-    Value header = buildHeader(namespaceAndName, allocator);
-
-    // If the header is an empty object or during parsing the payload, an error occurs, return an empty event value.
-    if (header.ObjectEmpty()) {
-        ACSDK_ERROR(LX("buildStateFailed").d("reason", "emptyHeader"));
-        return state;
+    const std::string& jsonPayloadValue) {
+    // The payload is spliced in as it is, so check that it is valid JSON, without building a document.
+    BaseReaderHandler<> handler;
+    Reader reader;
+    StringStream stream(jsonPayloadValue.c_str());
+    if (reader.Parse(stream, handler).IsError()) {
+        ACSDK_ERROR(LX("serializeStateFailed").d("reason", "parseError").d("payload", jsonPayloadValue));
+        return "";
     }
 
-    if (payload.Parse(jsonPayloadValue).HasParseError()) {
-        ACSDK_ERROR(LX("buildStateFailed").d("reason", "parseError").d("payload", jsonPayloadValue));
-        return state;
-    }
-
-    state.AddMember(StringRef(HEADER_JSON_KEY), header, allocator);
-    state.AddMember(StringRef(PAYLOAD_JSON_KEY), Value(payload, allocator), allocator);
-
+    std::string state;
+    state.reserve(
+        STATE_FRAGMENTS_SIZE + namespaceAndName.nameSpace.size() + namespaceAndName.name.size() +
+        jsonPayloadValue.size());
+    state += "{\"" + HEADER_JSON_KEY + "\":{\"" + NAMESPACE_JSON_KEY + "\":";
+    appendJsonString(namespaceAndName.nameSpace, &state);
+    state += ",\"" + NAME_JSON_KEY + "\":";
+    appendJsonString(namespaceAndName.name, &state);
+    state += "},\"" + PAYLOAD_JSON_KEY + "\":";
+    state += jsonPayloadValue;
+    state += '}';
     return state;
 }
 
-void ContextManager::sendContextToRequesters() {
-    bool errorBuildingContext = false;
-    Document jsonContext;
-    StringBuffer jsonContextBuf;
-
-    jsonContext.SetObject();
-    Value statesArray(kArrayType);
-    Document::AllocatorType& allocator = jsonContext.GetAllocator();
-
-    std::unique_lock<std::mutex> stateProviderLock(m_stateProviderMutex);
+bool ContextManager::buildContextLocked(std::string* context) {
+    /*
+     * The states were serialized as they were set, so the context is built by joining them, the same as serializing
+     * {"context":[state,...]} would.
+     */
+    size_t size = CONTEXT_JSON_KEY.size() + 7;
+    for (const auto& entry : m_namespaceNameToStateInfo) {
+        size += entry.second->serializedState.size() + 1;
+    }
+    context->clear();
+    context->reserve(size);
+    *context += "{\"" + CONTEXT_JSON_KEY + "\":[";
     for (auto it = m_namespaceNameToStateInfo.begin(); it != m_namespaceNameToStateInfo.end(); ++it) {
         auto& stateInfo = it->second;
-        Value jsonState = buildState(it->first, stateInfo->jsonState, allocator);
-        if (jsonState.ObjectEmpty()) {
-            ACSDK_ERROR(LX("buildContextFailed").d("reason", "buildStateFailed"));
-            errorBuildingContext = true;
-            break;
+        if (stateInfo->serializedState.empty()) {
+            ACSDK_ERROR(LX("buildContextFailed")
+                            .d("reason", "buildStateFailed")
+                            .d("namespace", it->first.nameSpace)
+                            .d("name", it->first.name));
+            return false;
         }
-        statesArray.PushBack(Value(jsonState, allocator).Move(), allocator);
-    }
-    stateProviderLock.unlock();
-
-    if (!errorBuildingContext) {
-        jsonContext.AddMember(StringRef(CONTEXT_JSON_KEY), statesArray, allocator);
-        Writer<StringBuffer> writer(jsonContextBuf);
-        if (!jsonContext.Accept(writer)) {
-            ACSDK_ERROR(LX("buildContextFailed").d("reason", "convertingJsonToStringFailed"));
-            errorBuildingContext = true;
+        if (it != m_namespaceNameToStateInfo.begin()) {
+            *context += ',';
         }
+        *context += stateInfo->serializedState;
     }
+    *context += "]}";
+    return true;
+}
+
+void ContextManager::sendContextToRequesters() {
+    std::string context;
+    std::unique_lock<std::mutex> stateProviderLock(m_stateProviderMutex);
+    bool built = buildContextLocked(&context);
+    stateProviderLock.unlock();
 
-    if (errorBuildingContext) {
+    if (!built) {
         sendContextAndClearQueue("", ContextRequestError::BUILD_CONTEXT_ERROR);
     } else {
-        ACSDK_DEBUG(LX("buildContextSuccessful").d("context", jsonContextBuf.GetString()));
-        sendContextAndClearQueue(jsonContextBuf.GetString());
+        ACSDK_DEBUG(LX("buildContextSuccessful").d("context", context));
+        sendContextAndClearQueue(context);
     }
 }
 
@@ -115,6 +115,9 @@ static const std::chrono::milliseconds DEFAULT_TIMEOUT = std::chrono::millisecon
 /// Timeout for the @c ContextRequester to get the failure.
 static const std::chrono::milliseconds FAILURE_TIMEOUT = std::chrono::milliseconds(110);
 
+/// A deadline for providing the state which @c TIMEOUT_SLEEP_TIME misses.
+static const std::chrono::milliseconds SHORT_DEADLINE = std::chrono::milliseconds(20);
+
 /// Namespace for SpeechSynthesizer.
 static const std::string NAMESPACE_SPEECH_SYNTHESIZER("SpeechSynthesizer");
 
@@ -512,6 +515,23 @@ TEST_F(ContextManagerTest, testGetContext) {
     ASSERT_EQ(CONTEXT_TEST, m_contextRequester->getContextString());
 }
 
+/**
+ * Set the states with a @c StateRefreshPolicy @c NEVER for @c StateProviderInterfaces that are registered with the
+ * @c ContextManager. Request for context by calling @c getContext. Expect that the context built from the states as
+ * they were set is returned within the timeout period, without the states being requested.
+ */
+TEST_F(ContextManagerTest, testGetContextWithoutRefresh) {
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(SPEECH_SYNTHESIZER, SPEECH_SYNTHESIZER_PAYLOAD_FINISHED, StateRefreshPolicy::NEVER));
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(AUDIO_PLAYER, AUDIO_PLAYER_PAYLOAD, StateRefreshPolicy::NEVER));
+    m_contextManager->getContext(m_contextRequester);
+    ASSERT_TRUE(m_contextRequester->waitForContext(DEFAULT_TIMEOUT));
+    ASSERT_EQ(CONTEXT_TEST, m_contextRequester->getContextString());
+}
+
 /**
  * Set the states with a @c StateRefreshPolicy @c ALWAYS for @c StateProviderInterfaces that are registered with the
  * @c ContextManager. Request for context by calling @c getContext by multiple requesters. Expect that the context is
@@ -646,6 +666,126 @@ TEST_F(ContextManagerTest, testIncorrectToken) {
             m_speechSynthesizer->getCurrentstateRequestToken() + 1));
 }
 
+/**
+ * Request a cached context before and after the states were updated for a @c getContext request.  Expect that no
+ * cached context is available before, that the cached context matches the one sent to the requester after, and that
+ * it is no longer available once it is older than the given age.
+ */
+TEST_F(ContextManagerTest, testGetCachedContext) {
+    std::string cachedContext;
+    ASSERT_FALSE(m_contextManager->getCachedContext(std::chrono::hours(1), &cachedContext));
+    ASSERT_FALSE(m_contextManager->getCachedContext(std::chrono::hours(1), nullptr));
+
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(SPEECH_SYNTHESIZER, SPEECH_SYNTHESIZER_PAYLOAD_FINISHED, StateRefreshPolicy::NEVER));
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(AUDIO_PLAYER, AUDIO_PLAYER_PAYLOAD, StateRefreshPolicy::NEVER));
+    m_contextManager->getContext(m_contextRequester);
+    ASSERT_TRUE(m_contextRequester->waitForContext(DEFAULT_TIMEOUT));
+
+    ASSERT_TRUE(m_contextManager->getCachedContext(std::chrono::hours(1), &cachedContext));
+    ASSERT_EQ(CONTEXT_TEST, cachedContext);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_FALSE(m_contextManager->getCachedContext(std::chrono::milliseconds(1), &cachedContext));
+}
+
+/**
+ * Set a state whose payload is not valid JSON.  Expect that building the context fails, and that it succeeds again
+ * once the state is valid.
+ */
+TEST_F(ContextManagerTest, testGetContextWithInvalidState) {
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(SPEECH_SYNTHESIZER, "{\"playerActivity\":", StateRefreshPolicy::NEVER));
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(AUDIO_PLAYER, AUDIO_PLAYER_PAYLOAD, StateRefreshPolicy::NEVER));
+    m_contextManager->getContext(m_contextRequester);
+    ASSERT_TRUE(m_contextRequester->waitForFailure(DEFAULT_TIMEOUT));
+    EXPECT_TRUE(m_contextRequester->getContextString().empty());
+
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(SPEECH_SYNTHESIZER, SPEECH_SYNTHESIZER_PAYLOAD_FINISHED, StateRefreshPolicy::NEVER));
+    m_contextRequester2 = MockContextRequester::create(m_contextManager);
+    m_contextManager->getContext(m_contextRequester2);
+    ASSERT_TRUE(m_contextRequester2->waitForContext(DEFAULT_TIMEOUT));
+    ASSERT_EQ(CONTEXT_TEST, m_contextRequester2->getContextString());
+}
+
+/**
+ * Request the context twice from a @c ContextManager with a freshness window, with states set with a
+ * @c StateRefreshPolicy @c ALWAYS.  Expect that the states are requested for the first request only, and that the
+ * second request is sent the same context.
+ */
+TEST_F(ContextManagerTest, testGetContextWithinFreshnessWindow) {
+    auto contextManager = ContextManager::create(std::chrono::hours(1));
+    auto speechSynthesizer = MockStateProvider::create(
+        contextManager,
+        SPEECH_SYNTHESIZER,
+        SPEECH_SYNTHESIZER_PAYLOAD_PLAYING,
+        StateRefreshPolicy::ALWAYS,
+        DEFAULT_SLEEP_TIME);
+    contextManager->setStateProvider(SPEECH_SYNTHESIZER, speechSynthesizer);
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        contextManager->setState(SPEECH_SYNTHESIZER, SPEECH_SYNTHESIZER_PAYLOAD_PLAYING, StateRefreshPolicy::ALWAYS));
+
+    auto contextRequester = MockContextRequester::create(contextManager);
+    contextManager->getContext(contextRequester);
+    ASSERT_TRUE(contextRequester->waitForContext(DEFAULT_TIMEOUT));
+    auto context = contextRequester->getContextString();
+    auto token = speechSynthesizer->getCurrentstateRequestToken();
+    EXPECT_NE(token, 0u);
+
+    auto contextRequester2 = MockContextRequester::create(contextManager);
+    contextManager->getContext(contextRequester2);
+    ASSERT_TRUE(contextRequester2->waitForContext(DEFAULT_TIMEOUT));
+    EXPECT_EQ(context, contextRequester2->getContextString());
+    EXPECT_EQ(token, speechSynthesizer->getCurrentstateRequestToken());
+}
+
+/**
+ * Register a @c StateProviderInterface which responds slowly to @c provideState requests, with a deadline it misses
+ * and the policy to use its last state.  Expect that the context is sent with its last state before it responds.
+ */
+TEST_F(ContextManagerTest, testProvideStateDeadlineUsesLastState) {
+    m_alerts = MockStateProvider::create(
+        m_contextManager, ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::ALWAYS, TIMEOUT_SLEEP_TIME);
+    m_contextManager->setStateProvider(ALERTS, m_alerts);
+    m_contextManager->setProvideStateDeadline(ALERTS, SHORT_DEADLINE, ContextManager::TimeoutPolicy::USE_LAST_STATE);
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(SPEECH_SYNTHESIZER, SPEECH_SYNTHESIZER_PAYLOAD_FINISHED, StateRefreshPolicy::NEVER));
+    ASSERT_EQ(
+        SetStateResult::SUCCESS,
+        m_contextManager->setState(AUDIO_PLAYER, AUDIO_PLAYER_PAYLOAD, StateRefreshPolicy::NEVER));
+    ASSERT_EQ(SetStateResult::SUCCESS, m_contextManager->setState(ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::ALWAYS));
+
+    m_contextManager->getContext(m_contextRequester);
+    ASSERT_TRUE(m_contextRequester->waitForContext(DEFAULT_TIMEOUT));
+    EXPECT_NE(m_contextRequester->getContextString().find(NAME_ALERTS_STATE), std::string::npos);
+}
+
+/**
+ * Register a @c StateProviderInterface which responds slowly to @c provideState requests, with a deadline it misses
+ * and the policy to use its last state, but without a last state.  Expect that the context request fails at the
+ * deadline rather than after the default timeout.
+ */
+TEST_F(ContextManagerTest, testProvideStateDeadlineWithoutLastState) {
+    m_alerts = MockStateProvider::create(
+        m_contextManager, ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::ALWAYS, TIMEOUT_SLEEP_TIME);
+    m_contextManager->setStateProvider(ALERTS, m_alerts);
+    m_contextManager->setProvideStateDeadline(ALERTS, SHORT_DEADLINE, ContextManager::TimeoutPolicy::USE_LAST_STATE);
+
+    m_contextManager->getContext(m_contextRequester);
+    ASSERT_TRUE(m_contextRequester->waitForFailure(DEFAULT_TIMEOUT));
+    EXPECT_TRUE(m_contextRequester->getContextString().empty());
+}
+
 }  // namespace test
 }  // namespace contextManager
 }  // namespace alexaClientSDK
@@ -0,0 +1,149 @@
+/*
+ * main.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <signal.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "Integration/MockAVSServer.h"
+
+using namespace alexaClientSDK::integration::test;
+
+/**
+ * Read a whole file.
+ *
+ * @param path The path of the file.
+ * @param[out] contents The contents of the file.
+ * @return Whether the file could be read.
+ */
+static bool readFile(const std::string& path, std::string* contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    *contents = stream.str();
+    return true;
+}
+
+/**
+ * Load a scenario, which configures the server.  A scenario looks like this, where every key is optional:
+ *
+ * @code{.json}
+ * {
+ *     "eventResponseDelayMs": 0,
+ *     "recognizeResponseAfterBytes": 32000,
+ *     "recognizeResponse": [
+ *         { "delayMs": 0, "directive": { "directive": { "header": { "namespace": "SpeechRecognizer", ... } } } },
+ *         { "delayMs": 150, "contentId": "tts-${responseId}", "attachmentFile": "/path/to/speech.mp3" }
+ *     ]
+ * }
+ * @endcode
+ *
+ * @param path The path of the scenario.
+ * @param[out] configuration The configuration of the server.
+ * @return Whether the scenario was valid.
+ */
+static bool loadScenario(const std::string& path, MockAVSServer::Configuration* configuration) {
+    std::string text;
+    rapidjson::Document document;
+    if (!readFile(path, &text) || document.Parse(text.c_str()).HasParseError() || !document.IsObject()) {
+        std::cerr << "Cannot read the scenario " << path << std::endl;
+        return false;
+    }
+    if (document.HasMember("eventResponseDelayMs") && document["eventResponseDelayMs"].IsInt()) {
+        configuration->eventResponseDelay = std::chrono::milliseconds(document["eventResponseDelayMs"].GetInt());
+    }
+    if (document.HasMember("recognizeResponseAfterBytes") && document["recognizeResponseAfterBytes"].IsInt()) {
+        configuration->recognizeResponseAfterBytes = document["recognizeResponseAfterBytes"].GetInt();
+    }
+    if (!document.HasMember("recognizeResponse")) {
+        return true;
+    }
+    const auto& parts = document["recognizeResponse"];
+    if (!parts.IsArray()) {
+        std::cerr << "recognizeResponse must be an array" << std::endl;
+        return false;
+    }
+    for (const auto& value : parts.GetArray()) {
+        MockAVSServer::Part part;
+        part.delay = std::chrono::milliseconds(
+            value.HasMember("delayMs") && value["delayMs"].IsInt() ? value["delayMs"].GetInt() : 0);
+        if (value.HasMember("directive")) {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            value["directive"].Accept(writer);
+            part.directive = buffer.GetString();
+        } else if (
+            value.HasMember("contentId") && value["contentId"].IsString() && value.HasMember("attachmentFile") &&
+            value["attachmentFile"].IsString()) {
+            part.contentId = value["contentId"].GetString();
+            if (!readFile(value["attachmentFile"].GetString(), &part.attachment)) {
+                std::cerr << "Cannot read the attachment " << value["attachmentFile"].GetString() << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "Each part of recognizeResponse needs a directive, or a contentId and attachmentFile"
+                      << std::endl;
+            return false;
+        }
+        configuration->recognizeResponse.push_back(part);
+    }
+    return true;
+}
+
+/**
+ * Serve as AVS on the loopback interface until interrupted.  Point the SDK at the server by setting its AVS endpoint
+ * to the URL printed on start, and the @c lwaUrl of @c authDelegate to that URL followed by @c /auth/o2/token.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "USAGE: " << argv[0] << " <port> [path_to_scenario.json]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    MockAVSServer::Configuration configuration;
+    if (argc >= 3 && !loadScenario(argv[2], &configuration)) {
+        return EXIT_FAILURE;
+    }
+
+    // Block the signals which stop the server before its thread starts, so that only sigwait() sees them.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto server = MockAVSServer::create(configuration, std::atoi(argv[1]));
+    if (!server) {
+        std::cerr << "Cannot listen on port " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Serving as AVS at " << server->getEndpoint() << std::endl;
+
+    int signal = 0;
+    sigwait(&signals, &signal);
+    return EXIT_SUCCESS;
+}
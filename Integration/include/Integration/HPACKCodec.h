@@ -0,0 +1,146 @@
+/*
+ * HPACKCodec.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_INTEGRATION_INCLUDE_INTEGRATION_HPACK_CODEC_H_
+#define ALEXA_CLIENT_SDK_INTEGRATION_INCLUDE_INTEGRATION_HPACK_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace integration {
+namespace test {
+
+/**
+ * The header compression of HTTP/2 (RFC 7541), as much of it as a server needs.  Header blocks of the peer are decoded
+ * in full, including its dynamic table and Huffman coded strings.  Header blocks to the peer are encoded as plain
+ * literals which are never indexed, so that the peer's decoder needs no state from us.
+ *
+ * One codec decodes the header blocks of one connection, in the order they arrive.
+ */
+class HPACKCodec {
+public:
+    /// A header field, as its name and value.
+    using Header = std::pair<std::string, std::string>;
+
+    /**
+     * Constructor.
+     */
+    HPACKCodec();
+
+    /**
+     * Decode a complete header block, updating the dynamic table.
+     *
+     * @param data The header block.
+     * @param size The size of the header block.
+     * @param[out] headers The header fields of the block, in order.
+     * @return Whether the block was valid.  If not, the connection is unusable.
+     */
+    bool decode(const uint8_t* data, size_t size, std::vector<Header>* headers);
+
+    /**
+     * Encode a header block.
+     *
+     * @param headers The header fields to encode, in order.
+     * @return The header block.
+     */
+    static std::string encode(const std::vector<Header>& headers);
+
+private:
+    /**
+     * Decode an integer with a prefix of some bits.
+     *
+     * @param prefixBits The number of bits of the prefix, in the first byte.
+     * @param data The header block.
+     * @param size The size of the header block.
+     * @param[in,out] offset Where the integer begins, advanced past it.
+     * @param[out] value The integer.
+     * @return Whether the integer was valid.
+     */
+    static bool decodeInteger(int prefixBits, const uint8_t* data, size_t size, size_t* offset, size_t* value);
+
+    /**
+     * Decode a string literal.
+     *
+     * @param data The header block.
+     * @param size The size of the header block.
+     * @param[in,out] offset Where the string begins, advanced past it.
+     * @param[out] value The string.
+     * @return Whether the string was valid.
+     */
+    static bool decodeString(const uint8_t* data, size_t size, size_t* offset, std::string* value);
+
+    /**
+     * Decode a Huffman coded string.
+     *
+     * @param data The coded string.
+     * @param size The size of the coded string.
+     * @param[out] value The string.
+     * @return Whether the coding was valid.
+     */
+    static bool decodeHuffman(const uint8_t* data, size_t size, std::string* value);
+
+    /**
+     * Append an integer with a prefix of some bits.
+     *
+     * @param prefixBits The number of bits of the prefix.
+     * @param flags The bits of the first byte above the prefix.
+     * @param value The integer.
+     * @param[out] out The string to append to.
+     */
+    static void encodeInteger(int prefixBits, uint8_t flags, size_t value, std::string* out);
+
+    /**
+     * Look up a header field in the static and dynamic tables.
+     *
+     * @param index The index of the field, from 1.
+     * @param[out] header The header field.
+     * @return Whether there is a field at @c index.
+     */
+    bool lookUp(size_t index, Header* header) const;
+
+    /**
+     * Add a header field to the dynamic table, evicting the oldest as needed.
+     *
+     * @param header The header field.
+     */
+    void add(const Header& header);
+
+    /**
+     * Evict the oldest fields of the dynamic table until it fits its maximum size.
+     */
+    void evict();
+
+    /// The dynamic table, newest first.
+    std::deque<Header> m_dynamicTable;
+
+    /// The size of the dynamic table, as RFC 7541 counts it.
+    size_t m_dynamicTableSize;
+
+    /// The maximum size of the dynamic table, as last set by the peer.
+    size_t m_maxDynamicTableSize;
+};
+
+}  // namespace test
+}  // namespace integration
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_INTEGRATION_INCLUDE_INTEGRATION_HPACK_CODEC_H_
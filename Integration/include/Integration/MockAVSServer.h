@@ -0,0 +1,491 @@
+/*
+ * MockAVSServer.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_INTEGRATION_INCLUDE_INTEGRATION_MOCK_AVS_SERVER_H_
+#define ALEXA_CLIENT_SDK_INTEGRATION_INCLUDE_INTEGRATION_MOCK_AVS_SERVER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Integration/HPACKCodec.h"
+
+namespace alexaClientSDK {
+namespace integration {
+namespace test {
+
+/**
+ * A local stand-in for AVS, so that the SDK can be run and measured repeatably without a network or credentials.
+ *
+ * The server speaks cleartext HTTP/2 on the loopback interface, which libcurl reaches for an @c http:// endpoint by
+ * upgrading from HTTP/1.1.  Clients which start with HTTP/2 at once are served too.  It serves:
+ * - the downchannel, on which @c sendDirective() pushes directives,
+ * - pings, whose times it records,
+ * - events, which it records and answers with 204, except for @c Recognize events, which it answers with a canned
+ *   sequence of directives and attachments, each after a delay of its own, and which it can be told to stop
+ *   answering,
+ * - and, over HTTP/1.1, Login With Amazon token requests, with a token which never changes, so that
+ *   @c AuthDelegate can be pointed at the server too.
+ *
+ * A canned response is sent once the @c Recognize event has ended, or once a number of bytes of it have arrived,
+ * as AVS answers while the user is still speaking.  In directives and content IDs, @c ${dialogRequestId} is replaced
+ * with the dialog request ID of the event, and @c ${responseId} with a number unique to the response.
+ *
+ * All the work is done on a single thread.  The server is for tests and benchmarks, and so trusts its peers.
+ *
+ * @note This is only supported on POSIX platforms.
+ */
+class MockAVSServer {
+public:
+    /// One part of a canned response, either a directive or an attachment.
+    struct Part {
+        /// How long to wait after the previous part, or after the response has started, before sending this part.
+        std::chrono::milliseconds delay;
+
+        /// The JSON of a directive, or empty for an attachment.
+        std::string directive;
+
+        /// The content ID of an attachment, without angle brackets.
+        std::string contentId;
+
+        /// The data of an attachment.
+        std::string attachment;
+    };
+
+    /// How the server behaves.
+    struct Configuration {
+        /**
+         * Constructor, for a server which answers every event at once with 204.
+         */
+        Configuration();
+
+        /// How long to wait before answering an event.
+        std::chrono::milliseconds eventResponseDelay;
+
+        /// The response to @c Recognize events, or empty to answer them with 204.
+        std::vector<Part> recognizeResponse;
+
+        /// How many bytes of a @c Recognize event to wait for before answering it, or 0 to wait for its end.
+        size_t recognizeResponseAfterBytes;
+    };
+
+    /**
+     * Create a server and start serving.
+     *
+     * @param configuration How the server behaves.
+     * @param port The port to listen on, or 0 for any free port.
+     * @return The server, or @c nullptr if it could not listen.
+     */
+    static std::unique_ptr<MockAVSServer> create(const Configuration& configuration, int port = 0);
+
+    /**
+     * Destructor.  Stops serving and closes all connections.
+     */
+    ~MockAVSServer();
+
+    /**
+     * @return The port the server listens on.
+     */
+    int getPort() const;
+
+    /**
+     * @return The URL for the SDK to use as its AVS endpoint.
+     */
+    std::string getEndpoint() const;
+
+    /**
+     * Send a directive on every open downchannel.
+     *
+     * @param directive The JSON of the directive.
+     * @return The number of downchannels the directive was sent on.
+     */
+    size_t sendDirective(const std::string& directive);
+
+    /**
+     * Wait until a downchannel is open.
+     *
+     * @param timeout How long to wait.
+     * @return Whether a downchannel is open.
+     */
+    bool waitForDownchannel(std::chrono::milliseconds timeout);
+
+    /**
+     * Wait until a number of events has been received in all.
+     *
+     * @param count The number of events to wait for.
+     * @param timeout How long to wait.
+     * @return Whether that many events have been received.
+     */
+    bool waitForEvents(size_t count, std::chrono::milliseconds timeout);
+
+    /**
+     * @return The JSON of each event received so far, in the order they were received.
+     */
+    std::vector<std::string> getEvents();
+
+    /**
+     * Set whether to answer events.  Events which arrive while they are not answered are still recorded, but their
+     * streams are left open without a response, as if the connection had stalled.
+     *
+     * @param isAnsweringEvents Whether to answer events.
+     */
+    void setIsAnsweringEvents(bool isAnsweringEvents);
+
+    /**
+     * Wait until a number of pings has been received in all.
+     *
+     * @param count The number of pings to wait for.
+     * @param timeout How long to wait.
+     * @return Whether that many pings have been received.
+     */
+    bool waitForPings(size_t count, std::chrono::milliseconds timeout);
+
+    /**
+     * @return When each ping received so far arrived, in order.
+     */
+    std::vector<std::chrono::steady_clock::time_point> getPingTimes();
+
+private:
+    /// A stream of an HTTP/2 connection.
+    struct Stream {
+        /// Constructor.
+        Stream();
+
+        /// The method of the request.
+        std::string method;
+
+        /// The path of the request.
+        std::string path;
+
+        /// The start of the body of the request, enough to hold the JSON of an event.
+        std::string body;
+
+        /// The number of bytes of the body received.
+        size_t bodySize;
+
+        /// Whether the request has ended.
+        bool isRequestEnded;
+
+        /// Whether the response has been scheduled.
+        bool isResponseScheduled;
+
+        /// Whether the response has ended.
+        bool isResponseEnded;
+
+        /// Whether this is a downchannel.
+        bool isDownchannel;
+
+        /// How many bytes we may send on the stream, as the peer allows.
+        int64_t sendWindow;
+
+        /// Data of the response waiting for the peer to allow it.
+        std::string pendingData;
+
+        /// Whether the response ends after @c pendingData.
+        bool isPendingEnd;
+    };
+
+    /// A connection.
+    struct Connection {
+        /// Constructor.
+        Connection(int fd);
+
+        /// The socket.
+        int fd;
+
+        /// Whether the connection speaks HTTP/2, which is known once its first bytes have arrived.
+        bool isHTTP2;
+
+        /// Whether the protocol of the connection is known.
+        bool isProtocolKnown;
+
+        /// Whether the connection has been upgraded to HTTP/2 and the preface of the client has not yet arrived.
+        bool isPrefaceExpected;
+
+        /// Whether to close the connection once @c output has been written.
+        bool isClosing;
+
+        /// Bytes received and not yet processed.
+        std::string input;
+
+        /// Bytes waiting to be written.
+        std::string output;
+
+        /// The header decoder of the connection.
+        HPACKCodec codec;
+
+        /// The streams of the connection, by ID.
+        std::map<uint32_t, Stream> streams;
+
+        /// The stream whose header block is being continued, or 0.
+        uint32_t continuedStreamId;
+
+        /// The header block being continued.
+        std::string continuedHeaderBlock;
+
+        /// Whether the stream whose header block is being continued has ended its request.
+        bool isContinuedEndStream;
+
+        /// How many bytes we may send on the connection, as the peer allows.
+        int64_t sendWindow;
+
+        /// The window the peer gives each new stream.
+        int64_t peerInitialWindow;
+
+        /// The largest frame the peer accepts.
+        size_t peerMaxFrameSize;
+    };
+
+    /// Something to send at a scheduled time.
+    struct Action {
+        /// The ID of the connection.
+        uint64_t connectionId;
+
+        /// The ID of the stream.
+        uint32_t streamId;
+
+        /// The status to send in the response headers, or 0 to send data.
+        int status;
+
+        /// The data to send.
+        std::string data;
+
+        /// Whether the response ends with this action.
+        bool isEnd;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param configuration How the server behaves.
+     * @param listenFd The listening socket.
+     * @param port The port of the listening socket.
+     * @param wakeFds The pipe which wakes the thread.
+     */
+    MockAVSServer(const Configuration& configuration, int listenFd, int port, const int wakeFds[2]);
+
+    /**
+     * The loop of the thread.
+     */
+    void loop();
+
+    /**
+     * Wake the thread, so that it sees new actions.
+     */
+    void wake();
+
+    /**
+     * Accept new connections.
+     */
+    void acceptConnections();
+
+    /**
+     * Read what has arrived on a connection and process it.
+     *
+     * @param connectionId The ID of the connection.
+     * @param connection The connection.
+     * @return Whether the connection remains open.
+     */
+    bool readConnection(uint64_t connectionId, Connection* connection);
+
+    /**
+     * Start speaking HTTP/2 on a connection.
+     *
+     * @param connection The connection.
+     */
+    static void startHTTP2(Connection* connection);
+
+    /**
+     * Process the HTTP/1.1 request of a connection, which can only be a token request or a request to upgrade to
+     * HTTP/2.  Only a body of known length is supported.
+     *
+     * @param connectionId The ID of the connection.
+     * @param connection The connection.
+     * @return Whether the connection now speaks HTTP/2.
+     */
+    bool processHTTP1(uint64_t connectionId, Connection* connection);
+
+    /**
+     * Process the complete HTTP/2 frames received on a connection.
+     *
+     * @param connectionId The ID of the connection.
+     * @param connection The connection.
+     * @return Whether the connection is still valid.
+     */
+    bool processFrames(uint64_t connectionId, Connection* connection);
+
+    /**
+     * Process a complete header block, which begins a request.
+     *
+     * @param connectionId The ID of the connection.
+     * @param connection The connection.
+     * @param streamId The ID of the stream.
+     * @param headerBlock The header block.
+     * @param isEndStream Whether the request has no body.
+     * @return Whether the header block was valid.
+     */
+    bool processHeaders(
+        uint64_t connectionId,
+        Connection* connection,
+        uint32_t streamId,
+        const std::string& headerBlock,
+        bool isEndStream);
+
+    /**
+     * Begin a request, and schedule the response unless it depends on the body.
+     *
+     * @param connectionId The ID of the connection.
+     * @param connection The connection.
+     * @param streamId The ID of the stream of the request.
+     * @param method The method of the request.
+     * @param path The path of the request.
+     * @return The stream of the request.
+     */
+    Stream* beginRequest(
+        uint64_t connectionId,
+        Connection* connection,
+        uint32_t streamId,
+        const std::string& method,
+        const std::string& path);
+
+    /**
+     * Process a part of the body of a request.
+     *
+     * @param connectionId The ID of the connection.
+     * @param stream The stream of the request.
+     * @param streamId The ID of the stream.
+     * @param data The part of the body.
+     * @param isEndStream Whether the request ends with this part.
+     */
+    void processData(
+        uint64_t connectionId,
+        Stream* stream,
+        uint32_t streamId,
+        const std::string& data,
+        bool isEndStream);
+
+    /**
+     * Record an event and schedule its response.
+     *
+     * @param connectionId The ID of the connection.
+     * @param stream The stream of the event.
+     * @param streamId The ID of the stream.
+     */
+    void respondToEvent(uint64_t connectionId, Stream* stream, uint32_t streamId);
+
+    /**
+     * Schedule an action.
+     *
+     * @param time When to perform the action.
+     * @param action The action.
+     */
+    void schedule(std::chrono::steady_clock::time_point time, const Action& action);
+
+    /**
+     * Perform the actions which are due.
+     */
+    void performDueActions();
+
+    /**
+     * Send as much of the pending data of a stream as the peer allows.
+     *
+     * @param connection The connection.
+     * @param streamId The ID of the stream.
+     */
+    void flushStream(Connection* connection, uint32_t streamId);
+
+    /**
+     * Append a frame to the output of a connection.
+     *
+     * @param connection The connection.
+     * @param type The type of the frame.
+     * @param flags The flags of the frame.
+     * @param streamId The ID of the stream, or 0 for the connection.
+     * @param payload The payload of the frame.
+     */
+    static void writeFrame(
+        Connection* connection,
+        uint8_t type,
+        uint8_t flags,
+        uint32_t streamId,
+        const std::string& payload);
+
+    /**
+     * Write as much of the output of a connection as the socket takes.
+     *
+     * @param connection The connection.
+     * @return Whether the connection remains open.
+     */
+    static bool writeConnection(Connection* connection);
+
+    /// How the server behaves.
+    const Configuration m_configuration;
+
+    /// The listening socket.
+    const int m_listenFd;
+
+    /// The port of the listening socket.
+    const int m_port;
+
+    /// The pipe which wakes the thread, as its read and write ends.
+    int m_wakeFds[2];
+
+    /// Mutex to guard the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a downchannel opens, or an event or a ping is received.
+    std::condition_variable m_wakeTrigger;
+
+    /// Whether the thread should exit.
+    bool m_isShuttingDown;
+
+    /// The connections, by ID.
+    std::map<uint64_t, Connection> m_connections;
+
+    /// The ID of the next connection.
+    uint64_t m_nextConnectionId;
+
+    /// The actions to perform, by time.  Actions at the same time are performed in the order they were scheduled.
+    std::multimap<std::chrono::steady_clock::time_point, Action> m_actions;
+
+    /// Whether to answer events.
+    bool m_isAnsweringEvents;
+
+    /// The JSON of the events received.
+    std::vector<std::string> m_events;
+
+    /// When each ping was received.
+    std::vector<std::chrono::steady_clock::time_point> m_pingTimes;
+
+    /// The number of responses to @c Recognize so far.
+    int m_responseCount;
+
+    /// The thread.
+    std::thread m_thread;
+};
+
+}  // namespace test
+}  // namespace integration
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_INTEGRATION_INCLUDE_INTEGRATION_MOCK_AVS_SERVER_H_
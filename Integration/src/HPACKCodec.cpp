@@ -0,0 +1,347 @@
+/*
+ * HPACKCodec.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <unordered_map>
+
+#include "Integration/HPACKCodec.h"
+
+namespace alexaClientSDK {
+namespace integration {
+namespace test {
+
+/// The static table of RFC 7541, Appendix A, from index 1.
+static const HPACKCodec::Header STATIC_TABLE[] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+/// The Huffman code of each octet, from RFC 7541, Appendix B.
+static const uint32_t HUFFMAN_CODES[256] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7,
+    0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec,
+    0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb,
+    0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa,
+    0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc,
+    0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26,
+    0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7,
+    0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc,
+    0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9,
+    0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3,
+    0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef,
+    0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec,
+    0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef,
+    0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec,
+    0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed,
+    0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5,
+    0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3,
+    0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea,
+    0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee,
+};
+/// The length in bits of the Huffman code of each octet.
+static const uint8_t HUFFMAN_CODE_LENGTHS[256] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+};
+
+/// The number of entries of the static table.
+static const size_t STATIC_TABLE_SIZE = sizeof(STATIC_TABLE) / sizeof(STATIC_TABLE[0]);
+
+/// The default maximum size of the dynamic table, before the peer changes it.
+static const size_t DEFAULT_MAX_DYNAMIC_TABLE_SIZE = 4096;
+
+/// The size counted for each entry of the dynamic table besides its name and value.
+static const size_t ENTRY_OVERHEAD = 32;
+
+/// The longest Huffman code, in bits.
+static const int MAX_HUFFMAN_CODE_LENGTH = 30;
+
+/**
+ * Get a map from each Huffman code to its octet.  The key is the code, with its length in bits in the upper half.
+ *
+ * @return The map.
+ */
+static const std::unordered_map<uint64_t, uint8_t>& getHuffmanDecodingMap() {
+    static const std::unordered_map<uint64_t, uint8_t> map = [] {
+        std::unordered_map<uint64_t, uint8_t> result;
+        for (int octet = 0; octet < 256; ++octet) {
+            uint64_t key = (static_cast<uint64_t>(HUFFMAN_CODE_LENGTHS[octet]) << 32) | HUFFMAN_CODES[octet];
+            result[key] = static_cast<uint8_t>(octet);
+        }
+        return result;
+    }();
+    return map;
+}
+
+HPACKCodec::HPACKCodec() : m_dynamicTableSize{0}, m_maxDynamicTableSize{DEFAULT_MAX_DYNAMIC_TABLE_SIZE} {
+}
+
+bool HPACKCodec::decode(const uint8_t* data, size_t size, std::vector<Header>* headers) {
+    size_t offset = 0;
+    while (offset < size) {
+        uint8_t first = data[offset];
+        size_t index = 0;
+        Header header;
+        if (first & 0x80) {
+            // Indexed header field.
+            if (!decodeInteger(7, data, size, &offset, &index) || !lookUp(index, &header)) {
+                return false;
+            }
+            headers->push_back(header);
+            continue;
+        }
+        if ((first & 0xe0) == 0x20) {
+            // Dynamic table size update.
+            if (!decodeInteger(5, data, size, &offset, &index) || index > DEFAULT_MAX_DYNAMIC_TABLE_SIZE) {
+                return false;
+            }
+            m_maxDynamicTableSize = index;
+            evict();
+            continue;
+        }
+        // A literal header field, with incremental indexing or not.
+        bool isIndexed = (first & 0xc0) == 0x40;
+        if (!decodeInteger(isIndexed ? 6 : 4, data, size, &offset, &index)) {
+            return false;
+        }
+        if (index) {
+            if (!lookUp(index, &header)) {
+                return false;
+            }
+        } else if (!decodeString(data, size, &offset, &header.first)) {
+            return false;
+        }
+        if (!decodeString(data, size, &offset, &header.second)) {
+            return false;
+        }
+        if (isIndexed) {
+            add(header);
+        }
+        headers->push_back(header);
+    }
+    return true;
+}
+
+std::string HPACKCodec::encode(const std::vector<Header>& headers) {
+    std::string out;
+    for (const auto& header : headers) {
+        // A literal header field never indexed, with a literal name.
+        out.push_back(0x10);
+        encodeInteger(7, 0, header.first.size(), &out);
+        out += header.first;
+        encodeInteger(7, 0, header.second.size(), &out);
+        out += header.second;
+    }
+    return out;
+}
+
+bool HPACKCodec::decodeInteger(int prefixBits, const uint8_t* data, size_t size, size_t* offset, size_t* value) {
+    if (*offset >= size) {
+        return false;
+    }
+    size_t mask = (1u << prefixBits) - 1;
+    *value = data[(*offset)++] & mask;
+    if (*value < mask) {
+        return true;
+    }
+    for (int shift = 0; shift <= 28; shift += 7) {
+        if (*offset >= size) {
+            return false;
+        }
+        uint8_t byte = data[(*offset)++];
+        *value += static_cast<size_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HPACKCodec::decodeString(const uint8_t* data, size_t size, size_t* offset, std::string* value) {
+    if (*offset >= size) {
+        return false;
+    }
+    bool isHuffman = data[*offset] & 0x80;
+    size_t length = 0;
+    if (!decodeInteger(7, data, size, offset, &length) || length > size - *offset) {
+        return false;
+    }
+    const uint8_t* string = data + *offset;
+    *offset += length;
+    if (isHuffman) {
+        return decodeHuffman(string, length, value);
+    }
+    value->assign(reinterpret_cast<const char*>(string), length);
+    return true;
+}
+
+bool HPACKCodec::decodeHuffman(const uint8_t* data, size_t size, std::string* value) {
+    const auto& map = getHuffmanDecodingMap();
+    value->clear();
+    uint32_t code = 0;
+    int length = 0;
+    for (size_t i = 0; i < size; ++i) {
+        for (int bit = 7; bit >= 0; --bit) {
+            code = (code << 1) | ((data[i] >> bit) & 1);
+            if (++length > MAX_HUFFMAN_CODE_LENGTH) {
+                return false;
+            }
+            auto it = map.find((static_cast<uint64_t>(length) << 32) | code);
+            if (it != map.end()) {
+                value->push_back(static_cast<char>(it->second));
+                code = 0;
+                length = 0;
+            }
+        }
+    }
+    // What is left must be padding: fewer than 8 bits, all ones, as the start of the code for end of string.
+    return length < 8 && code == (1u << length) - 1;
+}
+
+void HPACKCodec::encodeInteger(int prefixBits, uint8_t flags, size_t value, std::string* out) {
+    size_t mask = (1u << prefixBits) - 1;
+    if (value < mask) {
+        out->push_back(static_cast<char>(flags | value));
+        return;
+    }
+    out->push_back(static_cast<char>(flags | mask));
+    value -= mask;
+    while (value >= 0x80) {
+        out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<char>(value));
+}
+
+bool HPACKCodec::lookUp(size_t index, Header* header) const {
+    if (index == 0) {
+        return false;
+    }
+    if (index <= STATIC_TABLE_SIZE) {
+        *header = STATIC_TABLE[index - 1];
+        return true;
+    }
+    index -= STATIC_TABLE_SIZE + 1;
+    if (index >= m_dynamicTable.size()) {
+        return false;
+    }
+    *header = m_dynamicTable[index];
+    return true;
+}
+
+void HPACKCodec::add(const Header& header) {
+    m_dynamicTable.push_front(header);
+    m_dynamicTableSize += header.first.size() + header.second.size() + ENTRY_OVERHEAD;
+    // An entry larger than the table empties it, and is not kept itself.
+    evict();
+}
+
+void HPACKCodec::evict() {
+    while (m_dynamicTableSize > m_maxDynamicTableSize && !m_dynamicTable.empty()) {
+        const auto& oldest = m_dynamicTable.back();
+        m_dynamicTableSize -= oldest.first.size() + oldest.second.size() + ENTRY_OVERHEAD;
+        m_dynamicTable.pop_back();
+    }
+}
+
+}  // namespace test
+}  // namespace integration
+}  // namespace alexaClientSDK
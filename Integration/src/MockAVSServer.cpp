@@ -0,0 +1,926 @@
+/*
+ * MockAVSServer.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "Integration/MockAVSServer.h"
+
+namespace alexaClientSDK {
+namespace integration {
+namespace test {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MockAVSServer");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The first bytes a client sends on an HTTP/2 connection.
+static const std::string CONNECTION_PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+/// What a request to upgrade to HTTP/2 has among its headers, once lower cased.
+static const std::string UPGRADE_HEADER = "\r\nupgrade: h2c";
+
+/// The response which accepts an upgrade to HTTP/2.
+static const std::string SWITCHING_PROTOCOLS_RESPONSE =
+    "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n";
+
+/// The size of the header of an HTTP/2 frame.
+static const size_t FRAME_HEADER_SIZE = 9;
+
+/// @name HTTP/2 frame types.
+/// @{
+static const uint8_t FRAME_DATA = 0x0;
+static const uint8_t FRAME_HEADERS = 0x1;
+static const uint8_t FRAME_RST_STREAM = 0x3;
+static const uint8_t FRAME_SETTINGS = 0x4;
+static const uint8_t FRAME_PING = 0x6;
+static const uint8_t FRAME_GOAWAY = 0x7;
+static const uint8_t FRAME_WINDOW_UPDATE = 0x8;
+static const uint8_t FRAME_CONTINUATION = 0x9;
+/// @}
+
+/// @name HTTP/2 frame flags.
+/// @{
+static const uint8_t FLAG_END_STREAM = 0x1;
+static const uint8_t FLAG_ACK = 0x1;
+static const uint8_t FLAG_END_HEADERS = 0x4;
+static const uint8_t FLAG_PADDED = 0x8;
+static const uint8_t FLAG_PRIORITY = 0x20;
+/// @}
+
+/// @name HTTP/2 settings.
+/// @{
+static const uint16_t SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+static const uint16_t SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+static const uint16_t SETTINGS_MAX_FRAME_SIZE = 0x5;
+/// @}
+
+/// The flow control window of a new connection or stream, before the peer changes it.
+static const int64_t DEFAULT_WINDOW = 65535;
+
+/// The largest frame the peer accepts, before it changes it.
+static const size_t DEFAULT_MAX_FRAME_SIZE = 16384;
+
+/// The number of concurrent streams the server allows.
+static const uint32_t MAX_CONCURRENT_STREAMS = 100;
+
+/// How much of the body of a request to keep.  The JSON of an event comes first, so this is plenty.
+static const size_t MAX_BODY_KEPT = 64 * 1024;
+
+/// The size of the buffer to read from sockets with.
+static const size_t READ_BUFFER_SIZE = 16 * 1024;
+
+/// The MIME boundary of responses.
+static const std::string BOUNDARY = "mock-avs-boundary";
+
+/// The content type of multipart responses.
+static const std::string MULTIPART_CONTENT_TYPE =
+    "multipart/related; boundary=" + BOUNDARY + "; type=\"application/json\"";
+
+/// The headers of a MIME part holding JSON.
+static const std::string JSON_PART_HEADERS = "Content-Type: application/json; charset=UTF-8\r\n\r\n";
+
+/// The suffix of the path of the downchannel.
+static const std::string DIRECTIVES_PATH_SUFFIX = "/directives";
+
+/// The suffix of the path to send events to.
+static const std::string EVENTS_PATH_SUFFIX = "/events";
+
+/// The path of pings.
+static const std::string PING_PATH = "/ping";
+
+/// The path of Login With Amazon token requests.
+static const std::string TOKEN_PATH = "/auth/o2/token";
+
+/// The response to a token request.
+static const std::string TOKEN_RESPONSE =
+    "{\"access_token\":\"Atza|mock\",\"refresh_token\":\"Atzr|mock\",\"token_type\":\"bearer\",\"expires_in\":3600}";
+
+/// What the name of a @c Recognize event looks like in its JSON.
+static const std::string RECOGNIZE_NAME = "\"name\":\"Recognize\"";
+
+/// What the start of the dialog request ID of an event looks like in its JSON.
+static const std::string DIALOG_REQUEST_ID_PREFIX = "\"dialogRequestId\":\"";
+
+/// The placeholder for the dialog request ID of the event in canned responses.
+static const std::string DIALOG_REQUEST_ID_PLACEHOLDER = "${dialogRequestId}";
+
+/// The placeholder for the number of the response in canned responses.
+static const std::string RESPONSE_ID_PLACEHOLDER = "${responseId}";
+
+/**
+ * Replace every occurrence of a placeholder in a string.
+ *
+ * @param text The string.
+ * @param placeholder The placeholder.
+ * @param value What to replace it with.
+ * @return The string with the placeholder replaced.
+ */
+static std::string replaceAll(std::string text, const std::string& placeholder, const std::string& value) {
+    for (auto position = text.find(placeholder); position != std::string::npos;
+         position = text.find(placeholder, position + value.size())) {
+        text.replace(position, placeholder.size(), value);
+    }
+    return text;
+}
+
+/**
+ * Check whether a string ends with a suffix.
+ *
+ * @param text The string.
+ * @param suffix The suffix.
+ * @return Whether @c text ends with @c suffix.
+ */
+static bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && 0 == text.compare(text.size() - suffix.size(), suffix.size(), suffix);
+}
+
+/**
+ * Read a big-endian number from a string.
+ *
+ * @param data The string.
+ * @param offset Where the number begins.
+ * @param size The size of the number in bytes.
+ * @return The number.
+ */
+static uint32_t readNumber(const std::string& data, size_t offset, size_t size) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value = (value << 8) | static_cast<uint8_t>(data[offset + i]);
+    }
+    return value;
+}
+
+/**
+ * Append a big-endian number to a string.
+ *
+ * @param value The number.
+ * @param size The size of the number in bytes.
+ * @param[out] out The string to append to.
+ */
+static void writeNumber(uint32_t value, size_t size, std::string* out) {
+    for (size_t i = size; i > 0; --i) {
+        out->push_back(static_cast<char>((value >> (8 * (i - 1))) & 0xff));
+    }
+}
+
+/**
+ * Make a socket non-blocking.
+ *
+ * @param fd The socket.
+ * @return Whether it succeeded.
+ */
+static bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+MockAVSServer::Configuration::Configuration() :
+        eventResponseDelay{std::chrono::milliseconds::zero()},
+        recognizeResponseAfterBytes{0} {
+}
+
+MockAVSServer::Stream::Stream() :
+        bodySize{0},
+        isRequestEnded{false},
+        isResponseScheduled{false},
+        isResponseEnded{false},
+        isDownchannel{false},
+        sendWindow{DEFAULT_WINDOW},
+        isPendingEnd{false} {
+}
+
+MockAVSServer::Connection::Connection(int fd) :
+        fd{fd},
+        isHTTP2{false},
+        isProtocolKnown{false},
+        isPrefaceExpected{false},
+        isClosing{false},
+        continuedStreamId{0},
+        isContinuedEndStream{false},
+        sendWindow{DEFAULT_WINDOW},
+        peerInitialWindow{DEFAULT_WINDOW},
+        peerMaxFrameSize{DEFAULT_MAX_FRAME_SIZE} {
+}
+
+std::unique_ptr<MockAVSServer> MockAVSServer::create(const Configuration& configuration, int port) {
+    int listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "socketFailed").d("error", strerror(errno)));
+        return nullptr;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    socklen_t addressSize = sizeof(address);
+    int wakeFds[2] = {-1, -1};
+    if (bind(listenFd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0 ||
+        getsockname(listenFd, reinterpret_cast<struct sockaddr*>(&address), &addressSize) != 0 ||
+        !setNonBlocking(listenFd) || pipe(wakeFds) != 0 || !setNonBlocking(wakeFds[0]) ||
+        !setNonBlocking(wakeFds[1])) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "listenFailed").d("port", port).d("error", strerror(errno)));
+        close(listenFd);
+        if (wakeFds[0] >= 0) {
+            close(wakeFds[0]);
+            close(wakeFds[1]);
+        }
+        return nullptr;
+    }
+    return std::unique_ptr<MockAVSServer>(
+        new MockAVSServer(configuration, listenFd, ntohs(address.sin_port), wakeFds));
+}
+
+MockAVSServer::MockAVSServer(const Configuration& configuration, int listenFd, int port, const int wakeFds[2]) :
+        m_configuration(configuration),
+        m_listenFd{listenFd},
+        m_port{port},
+        m_isShuttingDown{false},
+        m_nextConnectionId{1},
+        m_isAnsweringEvents{true},
+        m_responseCount{0} {
+    m_wakeFds[0] = wakeFds[0];
+    m_wakeFds[1] = wakeFds[1];
+    m_thread = std::thread(&MockAVSServer::loop, this);
+}
+
+MockAVSServer::~MockAVSServer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    wake();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    for (auto& entry : m_connections) {
+        close(entry.second.fd);
+    }
+    close(m_listenFd);
+    close(m_wakeFds[0]);
+    close(m_wakeFds[1]);
+}
+
+int MockAVSServer::getPort() const {
+    return m_port;
+}
+
+std::string MockAVSServer::getEndpoint() const {
+    return "http://127.0.0.1:" + std::to_string(m_port);
+}
+
+size_t MockAVSServer::sendDirective(const std::string& directive) {
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& connection : m_connections) {
+            for (const auto& stream : connection.second.streams) {
+                if (stream.second.isDownchannel && !stream.second.isResponseEnded) {
+                    std::string part = JSON_PART_HEADERS + directive + "\r\n--" + BOUNDARY + "\r\n";
+                    schedule(now, {connection.first, stream.first, 0, part, false});
+                    count++;
+                }
+            }
+        }
+    }
+    wake();
+    return count;
+}
+
+bool MockAVSServer::waitForDownchannel(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, timeout, [this] {
+        for (const auto& connection : m_connections) {
+            for (const auto& stream : connection.second.streams) {
+                if (stream.second.isDownchannel) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    });
+}
+
+bool MockAVSServer::waitForEvents(size_t count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, timeout, [this, count] { return m_events.size() >= count; });
+}
+
+std::vector<std::string> MockAVSServer::getEvents() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events;
+}
+
+void MockAVSServer::setIsAnsweringEvents(bool isAnsweringEvents) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isAnsweringEvents = isAnsweringEvents;
+}
+
+bool MockAVSServer::waitForPings(size_t count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, timeout, [this, count] { return m_pingTimes.size() >= count; });
+}
+
+std::vector<std::chrono::steady_clock::time_point> MockAVSServer::getPingTimes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pingTimes;
+}
+
+void MockAVSServer::loop() {
+    std::vector<struct pollfd> pollFds;
+    std::vector<uint64_t> connectionIds;
+    while (true) {
+        int timeoutMs = -1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_isShuttingDown) {
+                return;
+            }
+            performDueActions();
+            for (auto it = m_connections.begin(); it != m_connections.end();) {
+                auto& connection = it->second;
+                if (!writeConnection(&connection) || (connection.isClosing && connection.output.empty())) {
+                    close(connection.fd);
+                    it = m_connections.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            pollFds.clear();
+            connectionIds.clear();
+            pollFds.push_back({m_listenFd, POLLIN, 0});
+            pollFds.push_back({m_wakeFds[0], POLLIN, 0});
+            for (const auto& entry : m_connections) {
+                short events = POLLIN | (entry.second.output.empty() ? 0 : POLLOUT);
+                pollFds.push_back({entry.second.fd, events, 0});
+                connectionIds.push_back(entry.first);
+            }
+            if (!m_actions.empty()) {
+                auto untilNext = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    m_actions.begin()->first - std::chrono::steady_clock::now());
+                // Round up, so that the first action is due when the wait ends.
+                timeoutMs = std::max(0, static_cast<int>(untilNext.count()) + 1);
+            }
+        }
+
+        if (poll(pollFds.data(), pollFds.size(), timeoutMs) < 0 && errno != EINTR) {
+            ACSDK_ERROR(LX("pollFailed").d("error", strerror(errno)));
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (pollFds[1].revents & POLLIN) {
+            char buffer[64];
+            while (read(m_wakeFds[0], buffer, sizeof(buffer)) > 0) {
+            }
+        }
+        if (pollFds[0].revents & POLLIN) {
+            acceptConnections();
+        }
+        for (size_t i = 0; i < connectionIds.size(); ++i) {
+            if (!(pollFds[i + 2].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            auto it = m_connections.find(connectionIds[i]);
+            if (it != m_connections.end() && !readConnection(it->first, &it->second)) {
+                close(it->second.fd);
+                m_connections.erase(it);
+            }
+        }
+    }
+}
+
+void MockAVSServer::wake() {
+    char byte = 0;
+    if (write(m_wakeFds[1], &byte, 1) < 0 && errno != EAGAIN) {
+        ACSDK_ERROR(LX("wakeFailed").d("error", strerror(errno)));
+    }
+}
+
+void MockAVSServer::acceptConnections() {
+    while (true) {
+        int fd = accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                ACSDK_ERROR(LX("acceptFailed").d("error", strerror(errno)));
+            }
+            return;
+        }
+        if (!setNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+        m_connections.insert(std::make_pair(m_nextConnectionId++, Connection(fd)));
+    }
+}
+
+bool MockAVSServer::readConnection(uint64_t connectionId, Connection* connection) {
+    char buffer[READ_BUFFER_SIZE];
+    while (true) {
+        auto count = recv(connection->fd, buffer, sizeof(buffer), 0);
+        if (count > 0) {
+            connection->input.append(buffer, count);
+        } else if (0 == count) {
+            return false;
+        } else if (EAGAIN == errno || EWOULDBLOCK == errno) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    if (!connection->isProtocolKnown) {
+        auto size = std::min(connection->input.size(), CONNECTION_PREFACE.size());
+        if (0 == connection->input.compare(0, size, CONNECTION_PREFACE, 0, size)) {
+            if (size < CONNECTION_PREFACE.size()) {
+                return true;
+            }
+            connection->input.erase(0, CONNECTION_PREFACE.size());
+            startHTTP2(connection);
+        }
+        connection->isProtocolKnown = true;
+    }
+
+    if (!connection->isHTTP2 && !processHTTP1(connectionId, connection)) {
+        return true;
+    }
+
+    // After an upgrade, the client still begins HTTP/2 with its preface.
+    if (connection->isPrefaceExpected) {
+        auto size = std::min(connection->input.size(), CONNECTION_PREFACE.size());
+        if (0 != connection->input.compare(0, size, CONNECTION_PREFACE, 0, size)) {
+            ACSDK_ERROR(LX("readConnectionFailed").d("reason", "invalidPreface"));
+            return false;
+        }
+        if (size < CONNECTION_PREFACE.size()) {
+            return true;
+        }
+        connection->input.erase(0, CONNECTION_PREFACE.size());
+        connection->isPrefaceExpected = false;
+    }
+    return processFrames(connectionId, connection);
+}
+
+void MockAVSServer::startHTTP2(Connection* connection) {
+    connection->isHTTP2 = true;
+    std::string settings;
+    writeNumber(SETTINGS_MAX_CONCURRENT_STREAMS, 2, &settings);
+    writeNumber(MAX_CONCURRENT_STREAMS, 4, &settings);
+    writeFrame(connection, FRAME_SETTINGS, 0, 0, settings);
+}
+
+bool MockAVSServer::processHTTP1(uint64_t connectionId, Connection* connection) {
+    auto headersEnd = connection->input.find("\r\n\r\n");
+    if (connection->isClosing || std::string::npos == headersEnd) {
+        return false;
+    }
+    std::string head = connection->input.substr(0, headersEnd);
+    std::transform(head.begin(), head.end(), head.begin(), ::tolower);
+    size_t contentLength = 0;
+    auto lengthPosition = head.find("\r\ncontent-length:");
+    if (lengthPosition != std::string::npos) {
+        contentLength = std::strtoul(head.c_str() + lengthPosition + strlen("\r\ncontent-length:"), nullptr, 10);
+    }
+    if (connection->input.size() < headersEnd + 4 + contentLength) {
+        return false;
+    }
+    auto requestLineEnd = head.find("\r\n");
+    if (head.find(UPGRADE_HEADER) != std::string::npos) {
+        // The request becomes stream 1 of the upgraded connection, already ended by the client.
+        std::istringstream requestLine(connection->input.substr(0, requestLineEnd));
+        std::string method;
+        std::string path;
+        requestLine >> method >> path;
+        std::string body = connection->input.substr(headersEnd + 4, contentLength);
+        connection->input.erase(0, headersEnd + 4 + contentLength);
+        connection->output += SWITCHING_PROTOCOLS_RESPONSE;
+        startHTTP2(connection);
+        connection->isPrefaceExpected = true;
+        processData(connectionId, beginRequest(connectionId, connection, 1, method, path), 1, body, true);
+        return true;
+    }
+    bool isTokenRequest = 0 == head.compare(0, 5, "post ") &&
+                          head.find(TOKEN_PATH) < (std::string::npos == requestLineEnd ? head.size() : requestLineEnd);
+    if (isTokenRequest) {
+        connection->output += "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                              std::to_string(TOKEN_RESPONSE.size()) + "\r\nConnection: close\r\n\r\n" + TOKEN_RESPONSE;
+    } else {
+        connection->output += "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+    connection->isClosing = true;
+    return false;
+}
+
+bool MockAVSServer::processFrames(uint64_t connectionId, Connection* connection) {
+    while (connection->input.size() >= FRAME_HEADER_SIZE) {
+        const std::string& input = connection->input;
+        size_t length = readNumber(input, 0, 3);
+        if (input.size() < FRAME_HEADER_SIZE + length) {
+            break;
+        }
+        uint8_t type = input[3];
+        uint8_t flags = input[4];
+        uint32_t streamId = readNumber(input, 5, 4) & 0x7fffffff;
+        std::string payload = input.substr(FRAME_HEADER_SIZE, length);
+        connection->input.erase(0, FRAME_HEADER_SIZE + length);
+
+        if (connection->continuedStreamId && type != FRAME_CONTINUATION) {
+            ACSDK_ERROR(LX("processFramesFailed").d("reason", "headerBlockInterrupted"));
+            return false;
+        }
+
+        // Strip the padding of the frame types which may have it.
+        if ((FRAME_DATA == type || FRAME_HEADERS == type) && (flags & FLAG_PADDED)) {
+            size_t padding = payload.empty() ? 0 : static_cast<uint8_t>(payload[0]);
+            if (payload.empty() || padding + 1 > payload.size()) {
+                ACSDK_ERROR(LX("processFramesFailed").d("reason", "invalidPadding"));
+                return false;
+            }
+            payload = payload.substr(1, payload.size() - 1 - padding);
+        }
+
+        switch (type) {
+            case FRAME_DATA: {
+                if (length > 0) {
+                    std::string increment;
+                    writeNumber(length, 4, &increment);
+                    writeFrame(connection, FRAME_WINDOW_UPDATE, 0, 0, increment);
+                }
+                auto it = connection->streams.find(streamId);
+                if (it == connection->streams.end() || it->second.isRequestEnded) {
+                    break;
+                }
+                bool isEndStream = flags & FLAG_END_STREAM;
+                if (length > 0 && !isEndStream) {
+                    std::string increment;
+                    writeNumber(length, 4, &increment);
+                    writeFrame(connection, FRAME_WINDOW_UPDATE, 0, streamId, increment);
+                }
+                processData(connectionId, &it->second, streamId, payload, isEndStream);
+                if (it->second.isRequestEnded && it->second.isResponseEnded) {
+                    connection->streams.erase(it);
+                }
+                break;
+            }
+            case FRAME_HEADERS:
+                if (flags & FLAG_PRIORITY) {
+                    if (payload.size() < 5) {
+                        return false;
+                    }
+                    payload.erase(0, 5);
+                }
+                if (flags & FLAG_END_HEADERS) {
+                    if (!processHeaders(connectionId, connection, streamId, payload, flags & FLAG_END_STREAM)) {
+                        return false;
+                    }
+                } else {
+                    connection->continuedStreamId = streamId;
+                    connection->continuedHeaderBlock = payload;
+                    connection->isContinuedEndStream = flags & FLAG_END_STREAM;
+                }
+                break;
+            case FRAME_CONTINUATION:
+                if (streamId != connection->continuedStreamId) {
+                    ACSDK_ERROR(LX("processFramesFailed").d("reason", "unexpectedContinuation"));
+                    return false;
+                }
+                connection->continuedHeaderBlock += payload;
+                if (flags & FLAG_END_HEADERS) {
+                    connection->continuedStreamId = 0;
+                    if (!processHeaders(
+                            connectionId,
+                            connection,
+                            streamId,
+                            connection->continuedHeaderBlock,
+                            connection->isContinuedEndStream)) {
+                        return false;
+                    }
+                }
+                break;
+            case FRAME_RST_STREAM:
+                connection->streams.erase(streamId);
+                break;
+            case FRAME_SETTINGS:
+                if (flags & FLAG_ACK) {
+                    break;
+                }
+                for (size_t offset = 0; offset + 6 <= payload.size(); offset += 6) {
+                    auto identifier = readNumber(payload, offset, 2);
+                    auto value = readNumber(payload, offset + 2, 4);
+                    if (SETTINGS_INITIAL_WINDOW_SIZE == identifier) {
+                        for (auto& stream : connection->streams) {
+                            stream.second.sendWindow += static_cast<int64_t>(value) - connection->peerInitialWindow;
+                        }
+                        connection->peerInitialWindow = value;
+                    } else if (SETTINGS_MAX_FRAME_SIZE == identifier) {
+                        connection->peerMaxFrameSize = value;
+                    }
+                }
+                writeFrame(connection, FRAME_SETTINGS, FLAG_ACK, 0, "");
+                break;
+            case FRAME_PING:
+                if (!(flags & FLAG_ACK)) {
+                    writeFrame(connection, FRAME_PING, FLAG_ACK, 0, payload);
+                }
+                break;
+            case FRAME_GOAWAY:
+                connection->isClosing = true;
+                break;
+            case FRAME_WINDOW_UPDATE:
+                if (payload.size() != 4) {
+                    return false;
+                }
+                if (0 == streamId) {
+                    connection->sendWindow += readNumber(payload, 0, 4) & 0x7fffffff;
+                } else {
+                    auto it = connection->streams.find(streamId);
+                    if (it != connection->streams.end()) {
+                        it->second.sendWindow += readNumber(payload, 0, 4) & 0x7fffffff;
+                    }
+                }
+                break;
+            default:
+                // Priorities and extensions do not matter to a server which answers everything as soon as it can.
+                break;
+        }
+
+        if (FRAME_SETTINGS == type || FRAME_WINDOW_UPDATE == type) {
+            std::vector<uint32_t> streamIds;
+            for (const auto& stream : connection->streams) {
+                streamIds.push_back(stream.first);
+            }
+            for (auto id : streamIds) {
+                flushStream(connection, id);
+            }
+        }
+    }
+    return true;
+}
+
+bool MockAVSServer::processHeaders(
+    uint64_t connectionId,
+    Connection* connection,
+    uint32_t streamId,
+    const std::string& headerBlock,
+    bool isEndStream) {
+    std::vector<HPACKCodec::Header> headers;
+    if (!connection->codec.decode(
+            reinterpret_cast<const uint8_t*>(headerBlock.data()), headerBlock.size(), &headers)) {
+        ACSDK_ERROR(LX("processHeadersFailed").d("reason", "invalidHeaderBlock").d("streamId", streamId));
+        return false;
+    }
+    if (connection->streams.count(streamId)) {
+        // Trailers, which carry nothing the server needs.
+        if (isEndStream) {
+            auto& stream = connection->streams[streamId];
+            processData(connectionId, &stream, streamId, "", true);
+        }
+        return true;
+    }
+
+    std::string method;
+    std::string path;
+    for (const auto& header : headers) {
+        if (":method" == header.first) {
+            method = header.second;
+        } else if (":path" == header.first) {
+            path = header.second;
+        }
+    }
+    auto stream = beginRequest(connectionId, connection, streamId, method, path);
+    if (isEndStream) {
+        processData(connectionId, stream, streamId, "", true);
+    }
+    return true;
+}
+
+MockAVSServer::Stream* MockAVSServer::beginRequest(
+    uint64_t connectionId,
+    Connection* connection,
+    uint32_t streamId,
+    const std::string& method,
+    const std::string& path) {
+    auto& stream = connection->streams[streamId] = Stream();
+    stream.method = method;
+    stream.path = path;
+    stream.sendWindow = connection->peerInitialWindow;
+    auto now = std::chrono::steady_clock::now();
+    if ("GET" == method && endsWith(path, DIRECTIVES_PATH_SUFFIX)) {
+        stream.isDownchannel = true;
+        stream.isResponseScheduled = true;
+        schedule(now, {connectionId, streamId, 200, "", false});
+        schedule(now, {connectionId, streamId, 0, "--" + BOUNDARY + "\r\n", false});
+        m_wakeTrigger.notify_all();
+    } else if ("GET" == method && PING_PATH == path) {
+        stream.isResponseScheduled = true;
+        schedule(now, {connectionId, streamId, 204, "", true});
+        m_pingTimes.push_back(now);
+        m_wakeTrigger.notify_all();
+    } else if (!("POST" == method && endsWith(path, EVENTS_PATH_SUFFIX))) {
+        stream.isResponseScheduled = true;
+        schedule(now, {connectionId, streamId, 404, "", true});
+    }
+    return &stream;
+}
+
+void MockAVSServer::processData(
+    uint64_t connectionId,
+    Stream* stream,
+    uint32_t streamId,
+    const std::string& data,
+    bool isEndStream) {
+    if (stream->body.size() < MAX_BODY_KEPT) {
+        stream->body.append(data, 0, MAX_BODY_KEPT - stream->body.size());
+    }
+    stream->bodySize += data.size();
+    stream->isRequestEnded = stream->isRequestEnded || isEndStream;
+    if (stream->isResponseScheduled) {
+        return;
+    }
+    bool isEnoughOfRecognize = m_configuration.recognizeResponseAfterBytes > 0 &&
+                               stream->bodySize >= m_configuration.recognizeResponseAfterBytes &&
+                               stream->body.find(RECOGNIZE_NAME) != std::string::npos;
+    if (stream->isRequestEnded || isEnoughOfRecognize) {
+        respondToEvent(connectionId, stream, streamId);
+    }
+}
+
+void MockAVSServer::respondToEvent(uint64_t connectionId, Stream* stream, uint32_t streamId) {
+    stream->isResponseScheduled = true;
+
+    // The JSON of the event is the first part of the body.
+    auto jsonStart = stream->body.find('{');
+    auto jsonEnd = stream->body.find("\r\n--", jsonStart);
+    std::string event = std::string::npos == jsonStart ? "" : stream->body.substr(jsonStart, jsonEnd - jsonStart);
+    m_events.push_back(event);
+    m_wakeTrigger.notify_all();
+    if (!m_isAnsweringEvents) {
+        return;
+    }
+
+    auto time = std::chrono::steady_clock::now() + m_configuration.eventResponseDelay;
+    const auto& parts = m_configuration.recognizeResponse;
+    if (parts.empty() || std::string::npos == event.find(RECOGNIZE_NAME)) {
+        schedule(time, {connectionId, streamId, 204, "", true});
+        return;
+    }
+
+    std::string dialogRequestId;
+    auto idStart = event.find(DIALOG_REQUEST_ID_PREFIX);
+    if (idStart != std::string::npos) {
+        idStart += DIALOG_REQUEST_ID_PREFIX.size();
+        dialogRequestId = event.substr(idStart, event.find('"', idStart) - idStart);
+    }
+    auto responseId = std::to_string(++m_responseCount);
+
+    schedule(time, {connectionId, streamId, 200, "", false});
+    schedule(time, {connectionId, streamId, 0, "--" + BOUNDARY + "\r\n", false});
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const auto& part = parts[i];
+        std::string data;
+        if (!part.directive.empty()) {
+            data = JSON_PART_HEADERS + replaceAll(
+                                           replaceAll(part.directive, DIALOG_REQUEST_ID_PLACEHOLDER, dialogRequestId),
+                                           RESPONSE_ID_PLACEHOLDER,
+                                           responseId);
+        } else {
+            data = "Content-Type: application/octet-stream\r\nContent-ID: <" +
+                   replaceAll(part.contentId, RESPONSE_ID_PLACEHOLDER, responseId) + ">\r\n\r\n" + part.attachment;
+        }
+        bool isLast = i + 1 == parts.size();
+        data += "\r\n--" + BOUNDARY + (isLast ? "--\r\n" : "\r\n");
+        time += part.delay;
+        schedule(time, {connectionId, streamId, 0, data, isLast});
+    }
+}
+
+void MockAVSServer::schedule(std::chrono::steady_clock::time_point time, const Action& action) {
+    m_actions.insert(std::make_pair(time, action));
+}
+
+void MockAVSServer::performDueActions() {
+    auto now = std::chrono::steady_clock::now();
+    while (!m_actions.empty() && m_actions.begin()->first <= now) {
+        Action action = std::move(m_actions.begin()->second);
+        m_actions.erase(m_actions.begin());
+        auto connection = m_connections.find(action.connectionId);
+        if (connection == m_connections.end()) {
+            continue;
+        }
+        auto stream = connection->second.streams.find(action.streamId);
+        if (stream == connection->second.streams.end() || stream->second.isResponseEnded) {
+            continue;
+        }
+        if (action.status) {
+            std::vector<HPACKCodec::Header> headers{{":status", std::to_string(action.status)}};
+            if (200 == action.status) {
+                headers.push_back({"content-type", MULTIPART_CONTENT_TYPE});
+            }
+            uint8_t flags = FLAG_END_HEADERS | (action.isEnd ? FLAG_END_STREAM : 0);
+            writeFrame(&connection->second, FRAME_HEADERS, flags, action.streamId, HPACKCodec::encode(headers));
+            if (action.isEnd) {
+                stream->second.isResponseEnded = true;
+                if (stream->second.isRequestEnded) {
+                    connection->second.streams.erase(stream);
+                }
+            }
+        } else {
+            stream->second.pendingData += action.data;
+            stream->second.isPendingEnd = action.isEnd;
+            flushStream(&connection->second, action.streamId);
+        }
+    }
+}
+
+void MockAVSServer::flushStream(Connection* connection, uint32_t streamId) {
+    auto it = connection->streams.find(streamId);
+    if (it == connection->streams.end()) {
+        return;
+    }
+    auto& stream = it->second;
+    while (!stream.pendingData.empty() && connection->sendWindow > 0 && stream.sendWindow > 0) {
+        size_t size = std::min(
+            {stream.pendingData.size(),
+             static_cast<size_t>(connection->sendWindow),
+             static_cast<size_t>(stream.sendWindow),
+             connection->peerMaxFrameSize});
+        bool isEnd = stream.isPendingEnd && size == stream.pendingData.size();
+        writeFrame(connection, FRAME_DATA, isEnd ? FLAG_END_STREAM : 0, streamId, stream.pendingData.substr(0, size));
+        stream.pendingData.erase(0, size);
+        connection->sendWindow -= size;
+        stream.sendWindow -= size;
+        stream.isResponseEnded = isEnd;
+    }
+    if (stream.pendingData.empty() && stream.isPendingEnd && !stream.isResponseEnded) {
+        writeFrame(connection, FRAME_DATA, FLAG_END_STREAM, streamId, "");
+        stream.isResponseEnded = true;
+    }
+    if (stream.isResponseEnded && stream.isRequestEnded) {
+        connection->streams.erase(it);
+    }
+}
+
+void MockAVSServer::writeFrame(
+    Connection* connection,
+    uint8_t type,
+    uint8_t flags,
+    uint32_t streamId,
+    const std::string& payload) {
+    writeNumber(payload.size(), 3, &connection->output);
+    connection->output.push_back(static_cast<char>(type));
+    connection->output.push_back(static_cast<char>(flags));
+    writeNumber(streamId, 4, &connection->output);
+    connection->output += payload;
+}
+
+bool MockAVSServer::writeConnection(Connection* connection) {
+    while (!connection->output.empty()) {
+        auto count = send(connection->fd, connection->output.data(), connection->output.size(), MSG_NOSIGNAL);
+        if (count > 0) {
+            connection->output.erase(0, count);
+        } else if (count < 0 && (EAGAIN == errno || EWOULDBLOCK == errno)) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace test
+}  // namespace integration
+}  // namespace alexaClientSDK
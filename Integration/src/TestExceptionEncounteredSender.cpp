@@ -70,11 +70,13 @@ std::shared_ptr<avsCommon::avs::AVSDirective> TestExceptionEncounteredSender::pa
     std::string dialogRequestId;
 
     if (!jsonUtils::lookupStringValue(rawJSON, JSON_MESSAGE_DIRECTIVE_KEY, &directiveJSON) ||
-        !jsonUtils::lookupStringValue(directiveJSON, JSON_MESSAGE_HEADER_KEY, &headerJSON) ||
-        !jsonUtils::lookupStringValue(directiveJSON, JSON_MESSAGE_PAYLOAD_KEY, &payloadJSON) ||
-        !jsonUtils::lookupStringValue(headerJSON, JSON_MESSAGE_NAMESPACE_KEY, &nameSpace) ||
-        !jsonUtils::lookupStringValue(headerJSON, JSON_MESSAGE_NAME_KEY, &name) ||
-        !jsonUtils::lookupStringValue(headerJSON, JSON_MESSAGE_MESSAGE_ID_KEY, &messageId)) {
+        !jsonUtils::lookupValues(
+            directiveJSON, {{JSON_MESSAGE_HEADER_KEY, &headerJSON}, {JSON_MESSAGE_PAYLOAD_KEY, &payloadJSON}}) ||
+        !jsonUtils::lookupValues(
+            headerJSON,
+            {{JSON_MESSAGE_NAMESPACE_KEY, &nameSpace},
+             {JSON_MESSAGE_NAME_KEY, &name},
+             {JSON_MESSAGE_MESSAGE_ID_KEY, &messageId}})) {
         return nullptr;
     }
 
@@ -364,7 +364,7 @@ protected:
 #endif
         m_alertRenderer = renderer::Renderer::create(m_rendererMediaPlayer);
 
-        m_alertStorage = std::make_shared<storage::SQLiteAlertStorage>();
+        m_alertStorage = std::make_shared<capabilityAgents::alerts::storage::SQLiteAlertStorage>();
 
         m_alertObserver = std::make_shared<TestAlertObserver>();
 
@@ -523,7 +523,7 @@ protected:
     std::shared_ptr<SpeechSynthesizer> m_speechSynthesizer;
     std::shared_ptr<AlertsCapabilityAgent> m_alertsAgent;
     std::shared_ptr<TestSpeechSynthesizerObserver> m_speechSynthesizerObserver;
-    std::shared_ptr<storage::SQLiteAlertStorage> m_alertStorage;
+    std::shared_ptr<capabilityAgents::alerts::storage::SQLiteAlertStorage> m_alertStorage;
     std::shared_ptr<renderer::RendererInterface> m_alertRenderer;
     std::shared_ptr<TestAlertObserver> m_alertObserver;
     std::shared_ptr<holdToTalkButton> m_holdToTalkButton;
@@ -0,0 +1,410 @@
+/*
+ * HTTP2TransportTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file HTTP2TransportTest.cpp
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/CurlMultiReactor.h>
+#include <ACL/Transport/HTTP2Transport.h>
+#include <ACL/Transport/MessageConsumerInterface.h>
+#include <ACL/Transport/PostConnectObject.h>
+#include <ACL/Transport/TransportObserverInterface.h>
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
+#include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+
+#include "Integration/MockAVSServer.h"
+
+namespace alexaClientSDK {
+namespace integration {
+namespace test {
+
+using namespace acl;
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::configuration;
+
+/// How long to wait for something which should happen.
+static const std::chrono::milliseconds TIMEOUT(10000);
+
+/// How long to wait for pings, which come seconds apart.
+static const std::chrono::milliseconds PING_TIMEOUT(20000);
+
+/// An event to send once connected.
+static const std::string EVENT =
+    "{\"event\":{\"header\":{\"namespace\":\"System\",\"name\":\"UserInactivityReport\",\"messageId\":\"event-1\"},"
+    "\"payload\":{\"inactiveTimeInSeconds\":0}}}";
+
+/// An auth delegate with a token which never changes.
+class TestAuthDelegate : public AuthDelegateInterface {
+public:
+    void addAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+        observer->onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR);
+    }
+
+    void removeAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+    }
+
+    std::string getAuthToken() override {
+        return "token";
+    }
+};
+
+/// A context manager whose context is always empty.
+class TestContextManager : public ContextManagerInterface {
+public:
+    ~TestContextManager() {
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void setStateProvider(const NamespaceAndName&, std::shared_ptr<StateProviderInterface>) override {
+    }
+
+    SetStateResult setState(const NamespaceAndName&, const std::string&, const StateRefreshPolicy&, const unsigned int)
+        override {
+        return SetStateResult::SUCCESS;
+    }
+
+    void getContext(std::shared_ptr<ContextRequesterInterface> contextRequester) override {
+        // The requester may hold a lock while asking, so answer from another thread.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(std::thread([contextRequester] { contextRequester->onContextAvailable("{}"); }));
+    }
+
+private:
+    /// Mutex to guard @c m_threads.
+    std::mutex m_mutex;
+
+    /// The threads answering requests.
+    std::vector<std::thread> m_threads;
+};
+
+/// A consumer and observer which records what the transport reports.
+class TestTransportListener
+        : public MessageConsumerInterface
+        , public TransportObserverInterface {
+public:
+    TestTransportListener() : m_isConnected{false} {
+    }
+
+    void consumeMessage(const std::string& contextId, const std::string& message) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.push_back(std::make_pair(contextId, message));
+        m_wakeTrigger.notify_all();
+    }
+
+    void onConnected() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isConnected = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    void onDisconnected(ConnectionStatusObserverInterface::ChangedReason reason) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isConnected = false;
+        m_wakeTrigger.notify_all();
+    }
+
+    void onServerSideDisconnect() override {
+    }
+
+    bool waitForConnected() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this] { return m_isConnected; });
+    }
+
+    /**
+     * Wait for a message which contains some text.
+     *
+     * @param text The text.
+     * @param[out] contextId The attachment context ID of the message.
+     * @return Whether such a message arrived.
+     */
+    bool waitForMessage(const std::string& text, std::string* contextId = nullptr) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, &text, contextId] {
+            for (const auto& message : m_messages) {
+                if (message.second.find(text) != std::string::npos) {
+                    if (contextId) {
+                        *contextId = message.first;
+                    }
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wakeTrigger;
+    bool m_isConnected;
+    std::vector<std::pair<std::string, std::string>> m_messages;
+};
+
+/**
+ * Open a socket on the loopback interface which accepts TCP connections but never answers them, so that a connection
+ * to it stays established forever.
+ *
+ * @param[out] endpoint The endpoint of the socket.
+ * @return The socket, or -1 on failure.
+ */
+static int openSilentSocket(std::string* endpoint) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 4) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(fd);
+        return -1;
+    }
+    *endpoint = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+    return fd;
+}
+
+/**
+ * Find an endpoint on the loopback interface which refuses connections.
+ *
+ * @return The endpoint, or an empty string on failure.
+ */
+static std::string findRefusingEndpoint() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return "";
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    std::string endpoint;
+    // A port which was bound but never listened on refuses connections once it is closed.
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+        endpoint = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+    }
+    close(fd);
+    return endpoint;
+}
+
+/**
+ * Our GTest class, run with the transport on its own thread and on a reactor.
+ */
+class HTTP2TransportTest : public ::testing::TestWithParam<bool> {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Configure ACL and create a transport.
+     *
+     * @param avsEndpoint The endpoint the transport is created with.
+     * @param aclConfiguration The members of the @c acl configuration node, as JSON.
+     * @return Whether the transport was created.
+     */
+    bool createTransport(const std::string& avsEndpoint, const std::string& aclConfiguration);
+
+    /// A server which answers the transport.
+    std::unique_ptr<MockAVSServer> m_server;
+
+    /// A socket which never answers, or -1.
+    int m_silentSocket;
+
+    /// The attachment manager of the transport.
+    std::shared_ptr<AttachmentManager> m_attachmentManager;
+
+    /// What the transport reports.
+    std::shared_ptr<TestTransportListener> m_listener;
+
+    /// The reactor, if the transport runs on one.
+    std::shared_ptr<CurlMultiReactor> m_reactor;
+
+    /// The transport under test.
+    std::shared_ptr<HTTP2Transport> m_transport;
+};
+
+void HTTP2TransportTest::SetUp() {
+    m_silentSocket = -1;
+    m_server = MockAVSServer::create(MockAVSServer::Configuration());
+    ASSERT_TRUE(m_server);
+
+    PostConnectObject::init(std::make_shared<TestContextManager>());
+    m_attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    m_listener = std::make_shared<TestTransportListener>();
+    if (GetParam()) {
+        m_reactor = CurlMultiReactor::create();
+        ASSERT_TRUE(m_reactor);
+    }
+}
+
+void HTTP2TransportTest::TearDown() {
+    if (m_transport) {
+        m_transport->shutdown();
+    }
+    ConfigurationNode::uninitialize();
+    PostConnectObject::init(nullptr);
+    m_reactor.reset();
+    m_server.reset();
+    if (m_silentSocket >= 0) {
+        close(m_silentSocket);
+    }
+}
+
+bool HTTP2TransportTest::createTransport(const std::string& avsEndpoint, const std::string& aclConfiguration) {
+    std::stringstream configuration("{\"acl\":{" + aclConfiguration + "}}");
+    if (!ConfigurationNode::initialize({&configuration})) {
+        return false;
+    }
+    m_transport = HTTP2Transport::create(
+        std::make_shared<TestAuthDelegate>(),
+        avsEndpoint,
+        m_listener,
+        m_attachmentManager,
+        m_listener,
+        nullptr,
+        m_reactor);
+    return m_transport != nullptr;
+}
+
+/**
+ * Verify that when the configured endpoint accepts the connection but never answers, the transport changes to an
+ * alternate endpoint while the connection is still being established, and sends its events there.
+ */
+TEST_P(HTTP2TransportTest, changesEndpointWhileConfiguredOneStalls) {
+    std::string silentEndpoint;
+    m_silentSocket = openSilentSocket(&silentEndpoint);
+    ASSERT_LE(0, m_silentSocket);
+    ASSERT_TRUE(createTransport(
+        silentEndpoint,
+        "\"alternateEndpoints\":\"" + m_server->getEndpoint() + "\",\"connectionAttemptDelayMs\":100"));
+
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(m_listener->waitForConnected());
+    ASSERT_TRUE(m_server->waitForDownchannel(TIMEOUT));
+    ASSERT_TRUE(m_server->waitForEvents(1, TIMEOUT));
+    ASSERT_NE(std::string::npos, m_server->getEvents()[0].find("SynchronizeState"));
+
+    m_transport->send(std::make_shared<MessageRequest>(EVENT));
+    ASSERT_TRUE(m_server->waitForEvents(2, TIMEOUT));
+    ASSERT_NE(std::string::npos, m_server->getEvents()[1].find("UserInactivityReport"));
+}
+
+/**
+ * Verify that when the configured endpoint refuses the connection, the transport tries the alternate endpoint at once
+ * rather than after the connection attempt delay, which is longer than the test waits.
+ */
+TEST_P(HTTP2TransportTest, changesEndpointAtOnceWhenConfiguredOneRefuses) {
+    auto refusingEndpoint = findRefusingEndpoint();
+    ASSERT_FALSE(refusingEndpoint.empty());
+    ASSERT_TRUE(createTransport(
+        refusingEndpoint,
+        "\"alternateEndpoints\":\"" + m_server->getEndpoint() + "\",\"connectionAttemptDelayMs\":60000"));
+
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(m_listener->waitForConnected());
+    ASSERT_TRUE(m_server->waitForEvents(1, TIMEOUT));
+    ASSERT_NE(std::string::npos, m_server->getEvents()[0].find("SynchronizeState"));
+}
+
+/**
+ * Verify that when the configured endpoint answers, the transport stays on it and leaves the alternate alone.
+ */
+TEST_P(HTTP2TransportTest, staysOnConfiguredEndpointWhenItAnswers) {
+    auto alternateServer = MockAVSServer::create(MockAVSServer::Configuration());
+    ASSERT_TRUE(alternateServer);
+    ASSERT_TRUE(createTransport(
+        m_server->getEndpoint(),
+        "\"alternateEndpoints\":\"" + alternateServer->getEndpoint() + "\",\"connectionAttemptDelayMs\":60000"));
+
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(m_listener->waitForConnected());
+    ASSERT_TRUE(m_server->waitForEvents(1, TIMEOUT));
+    ASSERT_FALSE(alternateServer->waitForDownchannel(std::chrono::milliseconds(200)));
+    m_transport->shutdown();
+    m_transport.reset();
+}
+
+/**
+ * Verify that each successful ping doubles the time until the next one, up to the maximum interval.
+ */
+TEST_P(HTTP2TransportTest, pingIntervalBacksOff) {
+    ASSERT_TRUE(createTransport(m_server->getEndpoint(), "\"minPingIntervalSeconds\":1,\"maxPingIntervalSeconds\":4"));
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(m_listener->waitForConnected());
+
+    ASSERT_TRUE(m_server->waitForPings(4, PING_TIMEOUT));
+    auto pingTimes = m_server->getPingTimes();
+    EXPECT_GE(pingTimes[1] - pingTimes[0], std::chrono::milliseconds(1900));
+    EXPECT_LT(pingTimes[1] - pingTimes[0], std::chrono::milliseconds(3000));
+    EXPECT_GE(pingTimes[2] - pingTimes[1], std::chrono::milliseconds(3900));
+    EXPECT_LT(pingTimes[2] - pingTimes[1], std::chrono::milliseconds(5000));
+    EXPECT_GE(pingTimes[3] - pingTimes[2], std::chrono::milliseconds(3900));
+    EXPECT_LT(pingTimes[3] - pingTimes[2], std::chrono::milliseconds(5000));
+}
+
+/**
+ * Verify that a stalled event stream makes a ping due at once, and resets the interval to the minimum.
+ */
+TEST_P(HTTP2TransportTest, pingIntervalResetsWhenStreamStalls) {
+    ASSERT_TRUE(createTransport(
+        m_server->getEndpoint(),
+        "\"minPingIntervalSeconds\":1,\"maxPingIntervalSeconds\":8,\"streamProgressTimeoutSeconds\":1"));
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(m_listener->waitForConnected());
+    ASSERT_TRUE(m_server->waitForPings(2, PING_TIMEOUT));
+
+    // The interval is now 4 seconds, and the event keeps the connection from being idle for another 4.
+    m_server->setIsAnsweringEvents(false);
+    auto timeOfStall = std::chrono::steady_clock::now();
+    m_transport->send(std::make_shared<MessageRequest>(EVENT));
+
+    ASSERT_TRUE(m_server->waitForPings(4, PING_TIMEOUT));
+    auto pingTimes = m_server->getPingTimes();
+    EXPECT_LT(pingTimes[2] - timeOfStall, std::chrono::milliseconds(3000));
+    EXPECT_LT(pingTimes[3] - pingTimes[2], std::chrono::milliseconds(3000));
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadAndReactor, HTTP2TransportTest, ::testing::Bool());
+
+}  // namespace test
+}  // namespace integration
+}  // namespace alexaClientSDK
@@ -0,0 +1,279 @@
+/*
+ * MockAVSServerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file MockAVSServerTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/CurlMultiReactor.h>
+#include <ACL/Transport/HTTP2Transport.h>
+#include <ACL/Transport/MessageConsumerInterface.h>
+#include <ACL/Transport/PostConnectObject.h>
+#include <ACL/Transport/TransportObserverInterface.h>
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
+#include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
+
+#include "Integration/MockAVSServer.h"
+
+namespace alexaClientSDK {
+namespace integration {
+namespace test {
+
+using namespace acl;
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// How long to wait for something which should happen.
+static const std::chrono::milliseconds TIMEOUT(10000);
+
+/// A directive to push on the downchannel.
+static const std::string DOWNCHANNEL_DIRECTIVE =
+    "{\"directive\":{\"header\":{\"namespace\":\"Speaker\",\"name\":\"SetMute\",\"messageId\":\"mute-1\"},"
+    "\"payload\":{\"mute\":true}}}";
+
+/// A @c Recognize event without audio.
+static const std::string RECOGNIZE_EVENT =
+    "{\"event\":{\"header\":{\"namespace\":\"SpeechRecognizer\",\"name\":\"Recognize\",\"messageId\":\"event-1\","
+    "\"dialogRequestId\":\"dialog-1\"},\"payload\":{}}}";
+
+/// The directive in the response to @c Recognize, as configured.
+static const std::string SPEAK_DIRECTIVE =
+    "{\"directive\":{\"header\":{\"namespace\":\"SpeechSynthesizer\",\"name\":\"Speak\","
+    "\"messageId\":\"speak-${responseId}\",\"dialogRequestId\":\"${dialogRequestId}\"},"
+    "\"payload\":{\"url\":\"cid:tts-${responseId}\",\"format\":\"AUDIO_MPEG\",\"token\":\"t\"}}}";
+
+/// The attachment in the response to @c Recognize.
+static const std::string SPEECH = "not really an mp3, but the transport does not mind";
+
+/// An auth delegate with a token which never changes.
+class TestAuthDelegate : public AuthDelegateInterface {
+public:
+    void addAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+        observer->onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR);
+    }
+
+    void removeAuthObserver(std::shared_ptr<AuthObserverInterface> observer) override {
+    }
+
+    std::string getAuthToken() override {
+        return "token";
+    }
+};
+
+/// A context manager whose context is always empty.
+class TestContextManager : public ContextManagerInterface {
+public:
+    ~TestContextManager() {
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void setStateProvider(const NamespaceAndName&, std::shared_ptr<StateProviderInterface>) override {
+    }
+
+    SetStateResult setState(const NamespaceAndName&, const std::string&, const StateRefreshPolicy&, const unsigned int)
+        override {
+        return SetStateResult::SUCCESS;
+    }
+
+    void getContext(std::shared_ptr<ContextRequesterInterface> contextRequester) override {
+        // The requester may hold a lock while asking, so answer from another thread.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(std::thread([contextRequester] { contextRequester->onContextAvailable("{}"); }));
+    }
+
+private:
+    /// Mutex to guard @c m_threads.
+    std::mutex m_mutex;
+
+    /// The threads answering requests.
+    std::vector<std::thread> m_threads;
+};
+
+/// A consumer and observer which records what the transport reports.
+class TestTransportListener
+        : public MessageConsumerInterface
+        , public TransportObserverInterface {
+public:
+    TestTransportListener() : m_isConnected{false} {
+    }
+
+    void consumeMessage(const std::string& contextId, const std::string& message) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.push_back(std::make_pair(contextId, message));
+        m_wakeTrigger.notify_all();
+    }
+
+    void onConnected() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isConnected = true;
+        m_wakeTrigger.notify_all();
+    }
+
+    void onDisconnected(ConnectionStatusObserverInterface::ChangedReason reason) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isConnected = false;
+        m_wakeTrigger.notify_all();
+    }
+
+    void onServerSideDisconnect() override {
+    }
+
+    bool waitForConnected() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this] { return m_isConnected; });
+    }
+
+    /**
+     * Wait for a message which contains some text.
+     *
+     * @param text The text.
+     * @param[out] contextId The attachment context ID of the message.
+     * @return Whether such a message arrived.
+     */
+    bool waitForMessage(const std::string& text, std::string* contextId = nullptr) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, &text, contextId] {
+            for (const auto& message : m_messages) {
+                if (message.second.find(text) != std::string::npos) {
+                    if (contextId) {
+                        *contextId = message.first;
+                    }
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wakeTrigger;
+    bool m_isConnected;
+    std::vector<std::pair<std::string, std::string>> m_messages;
+};
+
+/**
+ * Our GTest class, run with the transport on its own thread and on a reactor.
+ */
+class MockAVSServerTest : public ::testing::TestWithParam<bool> {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /// The server under test.
+    std::unique_ptr<MockAVSServer> m_server;
+
+    /// The attachment manager of the transport.
+    std::shared_ptr<AttachmentManager> m_attachmentManager;
+
+    /// What the transport reports.
+    std::shared_ptr<TestTransportListener> m_listener;
+
+    /// The reactor, if the transport runs on one.
+    std::shared_ptr<CurlMultiReactor> m_reactor;
+
+    /// A transport connected to the server.
+    std::shared_ptr<HTTP2Transport> m_transport;
+};
+
+void MockAVSServerTest::SetUp() {
+    MockAVSServer::Configuration configuration;
+    configuration.recognizeResponse.push_back({std::chrono::milliseconds::zero(), SPEAK_DIRECTIVE, "", ""});
+    configuration.recognizeResponse.push_back({std::chrono::milliseconds(10), "", "tts-${responseId}", SPEECH});
+    m_server = MockAVSServer::create(configuration);
+    ASSERT_TRUE(m_server);
+
+    PostConnectObject::init(std::make_shared<TestContextManager>());
+    m_attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    m_listener = std::make_shared<TestTransportListener>();
+    if (GetParam()) {
+        m_reactor = CurlMultiReactor::create();
+        ASSERT_TRUE(m_reactor);
+    }
+    m_transport = HTTP2Transport::create(
+        std::make_shared<TestAuthDelegate>(),
+        m_server->getEndpoint(),
+        m_listener,
+        m_attachmentManager,
+        m_listener,
+        nullptr,
+        m_reactor);
+    ASSERT_TRUE(m_transport);
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(m_listener->waitForConnected());
+}
+
+void MockAVSServerTest::TearDown() {
+    if (m_transport) {
+        m_transport->shutdown();
+    }
+    PostConnectObject::init(nullptr);
+    m_reactor.reset();
+    m_server.reset();
+}
+
+/**
+ * Verify that a transport connects, synchronizes its state and receives directives pushed on the downchannel.
+ */
+TEST_P(MockAVSServerTest, connectAndReceiveDirective) {
+    ASSERT_TRUE(m_server->waitForDownchannel(TIMEOUT));
+    ASSERT_TRUE(m_server->waitForEvents(1, TIMEOUT));
+    ASSERT_NE(std::string::npos, m_server->getEvents()[0].find("SynchronizeState"));
+    ASSERT_EQ(1u, m_server->sendDirective(DOWNCHANNEL_DIRECTIVE));
+    ASSERT_TRUE(m_listener->waitForMessage("SetMute"));
+}
+
+/**
+ * Verify that a @c Recognize event is answered with the canned directive and attachment.
+ */
+TEST_P(MockAVSServerTest, recognizeGetsCannedResponse) {
+    m_transport->send(std::make_shared<MessageRequest>(RECOGNIZE_EVENT));
+    std::string contextId;
+    ASSERT_TRUE(m_listener->waitForMessage("\"dialogRequestId\":\"dialog-1\"", &contextId));
+    ASSERT_TRUE(m_server->waitForEvents(2, TIMEOUT));
+
+    auto reader = m_attachmentManager->createReader(
+        m_attachmentManager->generateAttachmentId(contextId, "tts-1"), AttachmentReader::Policy::BLOCKING);
+    ASSERT_TRUE(reader);
+    std::vector<char> buffer(SPEECH.size() + 1);
+    auto status = AttachmentReader::ReadStatus::OK;
+    size_t size = 0;
+    while (size < buffer.size() && status == AttachmentReader::ReadStatus::OK) {
+        size += reader->read(buffer.data() + size, buffer.size() - size, &status, TIMEOUT);
+    }
+    ASSERT_EQ(SPEECH, std::string(buffer.data(), size));
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadAndReactor, MockAVSServerTest, ::testing::Bool());
+
+}  // namespace test
+}  // namespace integration
+}  // namespace alexaClientSDK
@@ -72,6 +72,16 @@ public:
      * lead to less delay but more CPU usage. Additionally, larger amounts of data fed into the engine per iteration
      * might lead longer delays before receiving keyword detection events. This has been defaulted to 20 milliseconds
      * as it is a good trade off between CPU usage and recognition delay.
+     * @param maxMsToPushPerIteration The most data in milliseconds to push to Kitt.ai at a time when the detector has
+     * fallen behind the writer, for instance after a scheduling delay. Each read then takes up to this much of the
+     * backlog, so that the detector catches up in larger chunks rather than being overrun and dropping audio. If this
+     * is not more than @c msToPushPerIteration, which is the default, the detector always pushes
+     * @c msToPushPerIteration.
+     * @param initializeAsynchronously Whether to load the resource and model files on the detection thread rather
+     * than before returning.  The stream reader is still created before returning, so the audio written while the
+     * files load is buffered in the stream and processed once they have loaded, and no keyword is missed unless the
+     * stream overruns.  Files which fail to load, or an @c audioFormat the engine does not support, are then reported
+     * to the @c keyWordDetectorStateObservers as an @c ERROR.
      * @return A new @c KittAiKeyWordDetector, or @c nullptr if the operation failed.
      * @see https://github.com/Kitt-AI/snowboy for more information regarding @c audioGain and @c applyFrontEnd.
      */
@@ -85,13 +95,49 @@ public:
         const std::vector<KittAiConfiguration> kittAiConfigurations,
         float audioGain,
         bool applyFrontEnd,
-        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20));
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20),
+        std::chrono::milliseconds maxMsToPushPerIteration = std::chrono::milliseconds(0),
+        bool initializeAsynchronously = false);
+
+    /**
+     * Creates a @c KittAiKeyWordDetector which does not read the stream itself, for use with a
+     * @c KeywordDetectorHub.  The audio is passed to the engine by @c processAudio().
+     *
+     * @param stream The stream of audio data, which keyword detections are reported against. This should be formatted
+     * in LPCM encoded with 16 bits per sample and have a sample rate of 16 kHz. Additionally, the data should be in
+     * little endian format.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @param resourceFilePath The path to the resource file.
+     * @param kittAiConfigurations A vector of @c KittAiConfiguration objects that will be used to initialize the
+     * engine and keywords.
+     * @param audioGain This controls whether to increase (>1) or decrease (<1) input volume.
+     * @param applyFrontEnd Whether to apply frontend audio processing.
+     * @return A new @c KittAiKeyWordDetector, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<KittAiKeyWordDetector> createEngine(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        const std::string& resourceFilePath,
+        const std::vector<KittAiConfiguration> kittAiConfigurations,
+        float audioGain,
+        bool applyFrontEnd);
 
     /**
      * Destructor.
      */
     ~KittAiKeyWordDetector() override;
 
+protected:
+    bool doProcessAudio(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex) override;
+
 private:
     /**
      * Constructor.
@@ -110,6 +156,11 @@ private:
      * lead to less delay but more CPU usage. Additionally, larger amounts of data fed into the engine per iteration
      * might lead longer delays before receiving keyword detection events. This has been defaulted to 20 milliseconds
      * as it is a good trade off between CPU usage and recognition delay.
+     * @param maxMsToPushPerIteration The most data in milliseconds to push to Kitt.ai at a time when the detector has
+     * fallen behind the writer, for instance after a scheduling delay. Each read then takes up to this much of the
+     * backlog, so that the detector catches up in larger chunks rather than being overrun and dropping audio. If this
+     * is not more than @c msToPushPerIteration, which is the default, the detector always pushes
+     * @c msToPushPerIteration.
      * @see https://github.com/Kitt-AI/snowboy for more information regarding @c audioGain and @c applyFrontEnd.
      */
     KittAiKeyWordDetector(
@@ -122,16 +173,33 @@ private:
         const std::vector<KittAiConfiguration> kittAiConfigurations,
         float audioGain,
         bool applyFrontEnd,
-        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20));
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20),
+        std::chrono::milliseconds maxMsToPushPerIteration = std::chrono::milliseconds(0));
 
     /**
-     * Initializes the stream reader and kicks off a thread to read data from the stream. This function should only be
-     * called once with each new @c KittAiKeyWordDetector.
+     * Initializes the stream reader, sets up the Kitt.ai engine, and kicks off a thread to read data from the stream.
+     * This function should only be called once with each new @c KittAiKeyWordDetector.
      *
      * @param audioFormat The format of the audio data located within the stream.
+     * @param startDetectionThread Whether to read the stream with a thread of its own, rather than be given the audio
+     * by @c processAudio().
+     * @param initializeAsynchronously Whether to set up the Kitt.ai engine on the detection thread, before it starts
+     * reading the stream.  This is ignored if @c startDetectionThread is @c false.
      * @return @c true if the engine was initialized properly and @c false otherwise.
      */
-    bool init(avsCommon::utils::AudioFormat audioFormat);
+    bool init(
+        avsCommon::utils::AudioFormat audioFormat,
+        bool startDetectionThread,
+        bool initializeAsynchronously = false);
+
+    /**
+     * Creates the Kitt.ai engine, which loads the resource and model files, and checks that it supports the format of
+     * the audio data.
+     *
+     * @param audioFormat The format of the audio data located within the stream.
+     * @return @c true if the engine was set up properly and @c false otherwise.
+     */
+    bool initEngine(avsCommon::utils::AudioFormat audioFormat);
 
     /**
      * Checks to see if an @c avsCommon::utils::AudioFormat is compatible with Kitt.ai.
@@ -171,6 +239,27 @@ private:
      * sampling rate of the audio data passed in.
      */
     const size_t m_maxSamplesPerPush;
+
+    /**
+     * The max number of samples to push into the underlying engine per iteration when the detector has fallen behind.
+     * This is at least @c m_maxSamplesPerPush.
+     */
+    const size_t m_maxSamplesPerCatchUp;
+
+    /// The path to the resource file the engine is created with.
+    const std::string m_resourceFilePath;
+
+    /// The paths to the model files the engine is created with, separated by commas.
+    std::string m_modelPaths;
+
+    /// The sensitivities of the models, in the same order and separated by commas.
+    std::string m_sensitivities;
+
+    /// The gain the engine applies to the audio data.
+    const float m_audioGain;
+
+    /// Whether the engine applies frontend audio processing.
+    const bool m_applyFrontEnd;
 };
 
 }  // namespace kwd
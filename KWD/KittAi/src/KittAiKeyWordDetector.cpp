@@ -14,11 +14,14 @@
  * express or implied. See the License for the specific language governing
  * permissions and limitations under the License.
  */
+#include <algorithm>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
 
 #include "KittAi/KittAiKeyWordDetector.h"
 
@@ -74,7 +77,9 @@ std::unique_ptr<KittAiKeyWordDetector> KittAiKeyWordDetector::create(
     const std::vector<KittAiConfiguration> kittAiConfigurations,
     float audioGain,
     bool applyFrontEnd,
-    std::chrono::milliseconds msToPushPerIteration) {
+    std::chrono::milliseconds msToPushPerIteration,
+    std::chrono::milliseconds maxMsToPushPerIteration,
+    bool initializeAsynchronously) {
     if (!stream) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
         return nullptr;
@@ -93,14 +98,48 @@ std::unique_ptr<KittAiKeyWordDetector> KittAiKeyWordDetector::create(
         kittAiConfigurations,
         audioGain,
         applyFrontEnd,
-        msToPushPerIteration));
-    if (!detector->init(audioFormat)) {
+        msToPushPerIteration,
+        maxMsToPushPerIteration));
+    if (!detector->init(audioFormat, true, initializeAsynchronously)) {
         ACSDK_ERROR(LX("createFailed").d("reason", "initDetectorFailed"));
         return nullptr;
     }
     return detector;
 }
 
+std::unique_ptr<KittAiKeyWordDetector> KittAiKeyWordDetector::createEngine(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioFormat audioFormat,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    const std::string& resourceFilePath,
+    const std::vector<KittAiConfiguration> kittAiConfigurations,
+    float audioGain,
+    bool applyFrontEnd) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createEngineFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createEngineFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    std::unique_ptr<KittAiKeyWordDetector> detector(new KittAiKeyWordDetector(
+        stream,
+        audioFormat,
+        keyWordObservers,
+        keyWordDetectorStateObservers,
+        resourceFilePath,
+        kittAiConfigurations,
+        audioGain,
+        applyFrontEnd));
+    if (!detector->init(audioFormat, false)) {
+        ACSDK_ERROR(LX("createEngineFailed").d("reason", "initDetectorFailed"));
+        return nullptr;
+    }
+    return detector;
+}
+
 KittAiKeyWordDetector::~KittAiKeyWordDetector() {
     m_isShuttingDown = true;
     if (m_detectionThread.joinable()) {
@@ -117,10 +156,17 @@ KittAiKeyWordDetector::KittAiKeyWordDetector(
     const std::vector<KittAiConfiguration> kittAiConfigurations,
     float audioGain,
     bool applyFrontEnd,
-    std::chrono::milliseconds msToPushPerIteration) :
+    std::chrono::milliseconds msToPushPerIteration,
+    std::chrono::milliseconds maxMsToPushPerIteration) :
         AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
         m_stream{stream},
-        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()} {
+        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()},
+        m_maxSamplesPerCatchUp{std::max(
+            m_maxSamplesPerPush,
+            static_cast<size_t>((audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * maxMsToPushPerIteration.count()))},
+        m_resourceFilePath{resourceFilePath},
+        m_audioGain{audioGain},
+        m_applyFrontEnd{applyFrontEnd} {
     std::stringstream sensitivities;
     std::stringstream modelPaths;
     for (unsigned int i = 0; i < kittAiConfigurations.size(); ++i) {
@@ -132,26 +178,57 @@ KittAiKeyWordDetector::KittAiKeyWordDetector(
             sensitivities << KITT_DELIMITER;
         }
     }
-    m_kittAiEngine = avsCommon::utils::memory::make_unique<snowboy::SnowboyDetect>(resourceFilePath, modelPaths.str());
-    m_kittAiEngine->SetSensitivity(sensitivities.str());
-    m_kittAiEngine->SetAudioGain(audioGain);
-    m_kittAiEngine->ApplyFrontend(applyFrontEnd);
+    m_modelPaths = modelPaths.str();
+    m_sensitivities = sensitivities.str();
 }
 
-bool KittAiKeyWordDetector::init(avsCommon::utils::AudioFormat audioFormat) {
-    if (!isAudioFormatCompatibleWithKittAi(audioFormat)) {
-        return false;
+bool KittAiKeyWordDetector::init(
+    avsCommon::utils::AudioFormat audioFormat,
+    bool startDetectionThread,
+    bool initializeAsynchronously) {
+    m_isShuttingDown = false;
+    if (startDetectionThread) {
+        m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+        if (!m_streamReader) {
+            ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+            return false;
+        }
     }
-    m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
-    if (!m_streamReader) {
-        ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+
+    if (startDetectionThread && initializeAsynchronously) {
+        // The reader already exists, so the stream holds the audio written while the engine loads its files.
+        m_detectionThread = threading::ThreadFactory::createThread(
+            threading::ThreadRole::KEYWORD_DETECTION, "kwd-kittai", [this, audioFormat]() {
+                if (!initEngine(audioFormat)) {
+                    notifyKeyWordDetectorStateObservers(
+                        KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+                    m_streamReader->close();
+                    return;
+                }
+                detectionLoop();
+            });
+        return true;
+    }
+
+    if (!initEngine(audioFormat)) {
         return false;
     }
-    m_isShuttingDown = false;
-    m_detectionThread = std::thread(&KittAiKeyWordDetector::detectionLoop, this);
+    if (startDetectionThread) {
+        m_detectionThread = threading::ThreadFactory::createThread(
+            threading::ThreadRole::KEYWORD_DETECTION, "kwd-kittai", [this]() { detectionLoop(); });
+    }
     return true;
 }
 
+bool KittAiKeyWordDetector::initEngine(avsCommon::utils::AudioFormat audioFormat) {
+    // Snowboy only loads its resource and model files by name, so they can not be mapped into memory here.
+    m_kittAiEngine = avsCommon::utils::memory::make_unique<snowboy::SnowboyDetect>(m_resourceFilePath, m_modelPaths);
+    m_kittAiEngine->SetSensitivity(m_sensitivities);
+    m_kittAiEngine->SetAudioGain(m_audioGain);
+    m_kittAiEngine->ApplyFrontend(m_applyFrontEnd);
+    return isAudioFormatCompatibleWithKittAi(audioFormat);
+}
+
 bool KittAiKeyWordDetector::isAudioFormatCompatibleWithKittAi(avsCommon::utils::AudioFormat audioFormat) {
     if (audioFormat.numChannels != static_cast<unsigned int>(m_kittAiEngine->NumChannels())) {
         ACSDK_ERROR(LX("isAudioFormatCompatibleWithKittAiFailed")
@@ -193,61 +270,61 @@ bool KittAiKeyWordDetector::isAudioFormatCompatibleWithKittAi(avsCommon::utils::
 
 void KittAiKeyWordDetector::detectionLoop() {
     notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
-    int16_t audioDataToPush[m_maxSamplesPerPush];
+    std::vector<int16_t> audioDataToPush(m_maxSamplesPerCatchUp);
     ssize_t wordsRead;
     while (!m_isShuttingDown) {
         bool didErrorOccur;
+        size_t wordsToRead = getReadSize(*m_streamReader, m_maxSamplesPerPush, m_maxSamplesPerCatchUp);
         wordsRead = readFromStream(
-            m_streamReader, m_stream, audioDataToPush, m_maxSamplesPerPush, TIMEOUT_FOR_READ_CALLS, &didErrorOccur);
+            m_streamReader, m_stream, audioDataToPush.data(), wordsToRead, TIMEOUT_FOR_READ_CALLS, &didErrorOccur);
         if (didErrorOccur) {
             break;
         } else if (wordsRead > 0) {
             // Words were successfully read.
-            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
-            int detectionResult = m_kittAiEngine->RunDetection(audioDataToPush, wordsRead);
-            if (detectionResult > 0) {
-                // > 0 indicates a keyword was found
-                if (m_detectionResultsToKeyWords.find(detectionResult) == m_detectionResultsToKeyWords.end()) {
-                    ACSDK_ERROR(LX("detectionLoopFailed").d("reason", "retrievingDetectedKeyWordFailed"));
-                    notifyKeyWordDetectorStateObservers(
-                        KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
-                    break;
-                } else {
-                    notifyKeyWordObservers(
-                        m_stream,
-                        m_detectionResultsToKeyWords[detectionResult],
-                        KeyWordObserverInterface::UNSPECIFIED_INDEX,
-                        m_streamReader->tell());
-                }
-            } else {
-                switch (detectionResult) {
-                    case KITT_AI_ERROR_DETECTION_RESULT:
-                        ACSDK_ERROR(LX("detectionLoopFailed").d("reason", "kittAiEngineError"));
-                        notifyKeyWordDetectorStateObservers(
-                            KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
-                        didErrorOccur = true;
-                        break;
-                    case KITT_AI_SILENCE_DETECTION_RESULT:
-                        break;
-                    case KITT_AI_NO_DETECTION_RESULT:
-                        break;
-                    default:
-                        ACSDK_ERROR(LX("detectionLoopEnded")
-                                        .d("reason", "unexpectedDetectionResult")
-                                        .d("detectionResult", detectionResult));
-                        notifyKeyWordDetectorStateObservers(
-                            KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
-                        didErrorOccur = true;
-                        break;
-                }
-                if (didErrorOccur) {
-                    break;
-                }
+            if (!processAudio(audioDataToPush.data(), wordsRead, m_streamReader->tell() - wordsRead)) {
+                break;
             }
         }
     }
     m_streamReader->close();
 }
 
+bool KittAiKeyWordDetector::doProcessAudio(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex) {
+    notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    int detectionResult = m_kittAiEngine->RunDetection(samples, numSamples);
+    if (detectionResult > 0) {
+        // > 0 indicates a keyword was found
+        if (m_detectionResultsToKeyWords.find(detectionResult) == m_detectionResultsToKeyWords.end()) {
+            ACSDK_ERROR(LX("doProcessAudioFailed").d("reason", "retrievingDetectedKeyWordFailed"));
+            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+            return false;
+        }
+        notifyKeyWordObservers(
+            m_stream,
+            m_detectionResultsToKeyWords[detectionResult],
+            KeyWordObserverInterface::UNSPECIFIED_INDEX,
+            beginIndex + numSamples);
+        return true;
+    }
+    switch (detectionResult) {
+        case KITT_AI_ERROR_DETECTION_RESULT:
+            ACSDK_ERROR(LX("doProcessAudioFailed").d("reason", "kittAiEngineError"));
+            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+            return false;
+        case KITT_AI_SILENCE_DETECTION_RESULT:
+        case KITT_AI_NO_DETECTION_RESULT:
+            return true;
+        default:
+            ACSDK_ERROR(LX("doProcessAudioFailed")
+                            .d("reason", "unexpectedDetectionResult")
+                            .d("detectionResult", detectionResult));
+            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+            return false;
+    }
+}
+
 }  // namespace kwd
 }  // namespace alexaClientSDK
@@ -564,6 +564,48 @@ TEST_F(KittAiKeyWordTest, getStreamClosedState) {
     ASSERT_EQ(stateReceived, KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED);
 }
 
+/**
+ * Tests that the detector initialized asynchronously detects the keywords in the alexa_stop_alexa_joke.wav file when
+ * the audio is written while the resource and model files are still loading.
+ */
+TEST_F(KittAiKeyWordTest, getExpectedNumberOfDetectionsWhenInitializingAsynchronously) {
+    auto alexaStopAlexaJokeBuffer = std::make_shared<avsCommon::avs::AudioInputStream::Buffer>(500000);
+    auto alexaStopAlexaJokeSds = avsCommon::avs::AudioInputStream::create(alexaStopAlexaJokeBuffer, 2, 1);
+    std::shared_ptr<AudioInputStream> alexaStopAlexaJokeAudioBuffer = std::move(alexaStopAlexaJokeSds);
+
+    std::unique_ptr<AudioInputStream::Writer> alexaStopAlexaJokeAudioBufferWriter =
+        alexaStopAlexaJokeAudioBuffer->createWriter(avsCommon::avs::AudioInputStream::Writer::Policy::NONBLOCKABLE);
+
+    std::string audioFilePath = inputsDirPath + ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE;
+    bool error;
+    std::vector<int16_t> audioData = readAudioFromFile(audioFilePath, &error);
+    ASSERT_FALSE(error);
+
+    auto detector = KittAiKeyWordDetector::create(
+        alexaStopAlexaJokeAudioBuffer,
+        compatibleAudioFormat,
+        {keyWordObserver1},
+        std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>>(),
+        inputsDirPath + RESOURCE_FILE,
+        {config},
+        KITTAI_AUDIO_GAIN,
+        KITTAI_APPLY_FRONTEND_PROCESSING,
+        std::chrono::milliseconds(20),
+        std::chrono::milliseconds(0),
+        true);
+    ASSERT_TRUE(detector);
+
+    alexaStopAlexaJokeAudioBufferWriter->write(audioData.data(), audioData.size());
+
+    auto detections =
+        keyWordObserver1->waitForNDetections(NUM_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE, DEFAULT_TIMEOUT);
+    ASSERT_EQ(detections.size(), NUM_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE);
+
+    for (auto index : END_INDICES_OF_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE) {
+        ASSERT_TRUE(isResultPresent(detections, index, MODEL_KEYWORD));
+    }
+}
+
 }  // namespace test
 }  // namespace kwd
 }  // namespace alexaClientSDK
@@ -54,6 +54,15 @@ public:
      * might lead longer delays before receiving keyword detection events. This has been defaulted to 10 milliseconds
      * as it is a good trade off between CPU usage and recognition delay. Additionally, this was the amount used by
      * Sensory in example code.
+     * @param maxMsToPushPerIteration The most data in milliseconds to push to Sensory at a time when the detector has
+     * fallen behind the writer, for instance after a scheduling delay. Each read then takes up to this much of the
+     * backlog, so that the detector catches up in larger chunks rather than being overrun and dropping audio. If this
+     * is not more than @c msToPushPerIteration, which is the default, the detector always pushes
+     * @c msToPushPerIteration.
+     * @param initializeAsynchronously Whether to load the model on the detection thread rather than before returning.
+     * The stream reader is still created before returning, so the audio written while the model loads is buffered in
+     * the stream and processed once it has loaded, and no keyword is missed unless the stream overruns.  A model
+     * which fails to load is then reported to the @c keyWordDetectorStateObservers as an @c ERROR.
      * @return A new @c SensoryKeywordDetector, or @c nullptr if the operation failed.
      */
     static std::unique_ptr<SensoryKeywordDetector> create(
@@ -62,13 +71,42 @@ public:
         std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
         std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
         const std::string& modelFilePath,
-        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(10));
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(10),
+        std::chrono::milliseconds maxMsToPushPerIteration = std::chrono::milliseconds(0),
+        bool initializeAsynchronously = false);
+
+    /**
+     * Creates a @c SensoryKeywordDetector which does not read the stream itself, for use with a
+     * @c KeywordDetectorHub.  The audio is passed to the engine by @c processAudio().
+     *
+     * @param stream The stream of audio data, which keyword detections are reported against. This should be formatted
+     * in LPCM encoded with 16 bits per sample and have a sample rate of 16 kHz. Additionally, the data should be in
+     * little endian format.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @param modelFilePath The path to the model file.
+     * @return A new @c SensoryKeywordDetector, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<SensoryKeywordDetector> createEngine(
+        std::shared_ptr<AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+        const std::string& modelFilePath);
 
     /**
      * Destructor.
      */
     ~SensoryKeywordDetector() override;
 
+protected:
+    /**
+     * Runs the engine on a chunk of audio.  A gap between chunks, such as after an overrun, restarts the session so
+     * that the indices of later detections are counted from the new chunk.
+     */
+    bool doProcessAudio(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) override;
+
 private:
     /**
      * Constructor.
@@ -83,22 +121,49 @@ private:
      * might lead longer delays before receiving keyword detection events. This has been defaulted to 10 milliseconds
      * as it is a good trade off between CPU usage and recognition delay. Additionally, this was the amount used by
      * Sensory in example code.
+     * @param maxMsToPushPerIteration The most data in milliseconds to push to Sensory at a time when the detector has
+     * fallen behind the writer, for instance after a scheduling delay. Each read then takes up to this much of the
+     * backlog, so that the detector catches up in larger chunks rather than being overrun and dropping audio. If this
+     * is not more than @c msToPushPerIteration, which is the default, the detector always pushes
+     * @c msToPushPerIteration.
      */
     SensoryKeywordDetector(
         std::shared_ptr<AudioInputStream> stream,
         std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
         std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
         avsCommon::utils::AudioFormat audioFormat,
-        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(10));
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(10),
+        std::chrono::milliseconds maxMsToPushPerIteration = std::chrono::milliseconds(0));
 
     /**
      * Initializes the stream reader, sets up the Sensory engine, and kicks off a thread to begin processing data from
      * the stream. This function should only be called once with each new @c SensoryKeywordDetector.
      *
      * @param modelFilePath The path to the model file.
+     * @param startDetectionThread Whether to read the stream with a thread of its own, rather than be given the audio
+     * by @c processAudio().
+     * @param initializeAsynchronously Whether to set up the Sensory engine on the detection thread, before it starts
+     * reading the stream.  This is ignored if @c startDetectionThread is @c false.
      * @return @c true if the engine was initialized properly and @c false otherwise.
      */
-    bool init(const std::string& modelFilePath);
+    bool init(const std::string& modelFilePath, bool startDetectionThread, bool initializeAsynchronously = false);
+
+    /**
+     * Sets up the Sensory engine and loads the model into it.
+     *
+     * @param modelFilePath The path to the model file.
+     * @return @c true if the engine was set up properly and @c false otherwise.
+     */
+    bool initEngine(const std::string& modelFilePath);
+
+    /**
+     * Maps the model file into memory, so that Sensory loads it without copying it through a file stream, and the
+     * pages of a model shared by several processes are only held in memory once.
+     *
+     * @param modelFilePath The path to the model file.
+     * @return @c true if the model file was mapped into @c m_modelData and @c false otherwise.
+     */
+    bool mapModelFile(const std::string& modelFilePath);
 
     /**
      * Sets up the runtime settings for a @c SnsrSession. This includes setting the callback handler and setting the
@@ -109,6 +174,13 @@ private:
      */
     bool setUpRuntimeSettings(SnsrSession* session);
 
+    /**
+     * Replaces @c m_session with a duplicate, so that Sensory starts counting samples from 0 again.
+     *
+     * @return @c true if the session was replaced and @c false otherwise.
+     */
+    bool restartSession();
+
     /// The main function that reads data and feeds it into the engine.
     void detectionLoop();
 
@@ -137,17 +209,35 @@ private:
      */
     avsCommon::avs::AudioInputStream::Index m_beginIndexOfStreamReader;
 
+    /// Whether any audio has been passed to the engine yet.
+    bool m_hasProcessedAudio;
+
+    /// The index in the stream just past the last chunk passed to the engine.
+    avsCommon::avs::AudioInputStream::Index m_nextIndexToProcess;
+
     /// Internal thread that reads audio from the buffer and feeds it to the Sensory engine.
     std::thread m_detectionThread;
 
     /// The Sensory handle.
     SnsrSession m_session;
 
+    /// The model file mapped into memory, or @c nullptr if it was read from the file instead.
+    void* m_modelData;
+
+    /// The size of @c m_modelData in bytes.
+    size_t m_modelSize;
+
     /**
      * The max number of samples to push into the underlying engine per iteration. This will be determined based on the
      * sampling rate of the audio data passed in.
      */
     const size_t m_maxSamplesPerPush;
+
+    /**
+     * The max number of samples to push into the underlying engine per iteration when the detector has fallen behind.
+     * This is at least @c m_maxSamplesPerPush.
+     */
+    const size_t m_maxSamplesPerCatchUp;
 };
 
 }  // namespace kwd
@@ -15,9 +15,19 @@
  * permissions and limitations under the License.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
 
 #include "Sensory/SensoryKeywordDetector.h"
 
@@ -171,7 +181,9 @@ std::unique_ptr<SensoryKeywordDetector> SensoryKeywordDetector::create(
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
         keyWordDetectorStateObservers,
     const std::string& modelFilePath,
-    std::chrono::milliseconds msToPushPerIteration) {
+    std::chrono::milliseconds msToPushPerIteration,
+    std::chrono::milliseconds maxMsToPushPerIteration,
+    bool initializeAsynchronously) {
     if (!stream) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
         return nullptr;
@@ -187,20 +199,55 @@ std::unique_ptr<SensoryKeywordDetector> SensoryKeywordDetector::create(
         return nullptr;
     }
     std::unique_ptr<SensoryKeywordDetector> detector(new SensoryKeywordDetector(
-        stream, keyWordObservers, keyWordDetectorStateObservers, audioFormat, msToPushPerIteration));
-    if (!detector->init(modelFilePath)) {
+        stream,
+        keyWordObservers,
+        keyWordDetectorStateObservers,
+        audioFormat,
+        msToPushPerIteration,
+        maxMsToPushPerIteration));
+    if (!detector->init(modelFilePath, true, initializeAsynchronously)) {
         ACSDK_ERROR(LX("createFailed").d("reason", "initDetectorFailed"));
         return nullptr;
     }
     return detector;
 }
 
+std::unique_ptr<SensoryKeywordDetector> SensoryKeywordDetector::createEngine(
+    std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+    avsCommon::utils::AudioFormat audioFormat,
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+        keyWordDetectorStateObservers,
+    const std::string& modelFilePath) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createEngineFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createEngineFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    if (!isAudioFormatCompatibleWithSensory(audioFormat)) {
+        return nullptr;
+    }
+    std::unique_ptr<SensoryKeywordDetector> detector(
+        new SensoryKeywordDetector(stream, keyWordObservers, keyWordDetectorStateObservers, audioFormat));
+    if (!detector->init(modelFilePath, false)) {
+        ACSDK_ERROR(LX("createEngineFailed").d("reason", "initDetectorFailed"));
+        return nullptr;
+    }
+    return detector;
+}
+
 SensoryKeywordDetector::~SensoryKeywordDetector() {
     m_isShuttingDown = true;
     if (m_detectionThread.joinable()) {
         m_detectionThread.join();
     }
     snsrRelease(m_session);
+    if (m_modelData) {
+        munmap(m_modelData, m_modelSize);
+    }
 }
 
 SensoryKeywordDetector::SensoryKeywordDetector(
@@ -208,20 +255,61 @@ SensoryKeywordDetector::SensoryKeywordDetector(
     std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
     std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
     avsCommon::utils::AudioFormat audioFormat,
-    std::chrono::milliseconds msToPushPerIteration) :
+    std::chrono::milliseconds msToPushPerIteration,
+    std::chrono::milliseconds maxMsToPushPerIteration) :
         AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
         m_stream{stream},
+        m_beginIndexOfStreamReader{0},
+        m_hasProcessedAudio{false},
+        m_nextIndexToProcess{0},
         m_session{nullptr},
-        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()} {
+        m_modelData{nullptr},
+        m_modelSize{0},
+        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()},
+        m_maxSamplesPerCatchUp{std::max(
+            m_maxSamplesPerPush,
+            static_cast<size_t>((audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * maxMsToPushPerIteration.count()))} {
 }
 
-bool SensoryKeywordDetector::init(const std::string& modelFilePath) {
-    m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
-    if (!m_streamReader) {
-        ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+bool SensoryKeywordDetector::init(
+    const std::string& modelFilePath,
+    bool startDetectionThread,
+    bool initializeAsynchronously) {
+    if (startDetectionThread) {
+        m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+        if (!m_streamReader) {
+            ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+            return false;
+        }
+    }
+
+    m_isShuttingDown = false;
+    if (startDetectionThread && initializeAsynchronously) {
+        // The reader already exists, so the stream holds the audio written while the model loads.
+        m_detectionThread = avsCommon::utils::threading::ThreadFactory::createThread(
+            avsCommon::utils::threading::ThreadRole::KEYWORD_DETECTION, "kwd-sensory", [this, modelFilePath]() {
+                if (!initEngine(modelFilePath)) {
+                    notifyKeyWordDetectorStateObservers(
+                        KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+                    m_streamReader->close();
+                    return;
+                }
+                detectionLoop();
+            });
+        return true;
+    }
+
+    if (!initEngine(modelFilePath)) {
         return false;
     }
+    if (startDetectionThread) {
+        m_detectionThread = avsCommon::utils::threading::ThreadFactory::createThread(
+            avsCommon::utils::threading::ThreadRole::KEYWORD_DETECTION, "kwd-sensory", [this]() { detectionLoop(); });
+    }
+    return true;
+}
 
+bool SensoryKeywordDetector::initEngine(const std::string& modelFilePath) {
     // Allocate the Sensory library handle
     SnsrRC result = snsrNew(&m_session);
     if (result != SNSR_RC_OK) {
@@ -250,7 +338,11 @@ bool SensoryKeywordDetector::init(const std::string& modelFilePath) {
         ACSDK_INFO(LX("Sensory library license does not expire for at least 60 more days."));
     }
 
-    result = snsrLoad(m_session, snsrStreamFromFileName(modelFilePath.c_str(), "r"));
+    // The model is read from the file if it can not be mapped.
+    auto modelStream = mapModelFile(modelFilePath)
+                           ? snsrStreamFromMemory(m_modelData, m_modelSize, SNSR_ST_MODE_READ)
+                           : snsrStreamFromFileName(modelFilePath.c_str(), "r");
+    result = snsrLoad(m_session, modelStream);
     if (result != SNSR_RC_OK) {
         ACSDK_ERROR(
             LX("initFailed").d("reason", "loadingSensoryModelFailed").d("error", getSensoryDetails(m_session, result)));
@@ -266,12 +358,30 @@ bool SensoryKeywordDetector::init(const std::string& modelFilePath) {
         return false;
     }
 
-    if (!setUpRuntimeSettings(&m_session)) {
+    return setUpRuntimeSettings(&m_session);
+}
+
+bool SensoryKeywordDetector::mapModelFile(const std::string& modelFilePath) {
+    int fd = ::open(modelFilePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ACSDK_WARN(LX("mapModelFileFailed").d("reason", "openFailed").d("error", strerror(errno)));
         return false;
     }
-
-    m_isShuttingDown = false;
-    m_detectionThread = std::thread(&SensoryKeywordDetector::detectionLoop, this);
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        ACSDK_WARN(LX("mapModelFileFailed").d("reason", "fstatFailed"));
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping does not need the file descriptor once it is made.
+    close(fd);
+    if (MAP_FAILED == data) {
+        ACSDK_WARN(LX("mapModelFileFailed").d("reason", "mmapFailed").d("error", strerror(errno)));
+        return false;
+    }
+    m_modelData = data;
+    m_modelSize = status.st_size;
     return true;
 }
 
@@ -307,80 +417,102 @@ bool SensoryKeywordDetector::setUpRuntimeSettings(SnsrSession* session) {
     return true;
 }
 
+bool SensoryKeywordDetector::restartSession() {
+    SnsrSession newSession{nullptr};
+    /*
+     * This duplicated SnsrSession will have all the same configurations as m_session but none of the runtime
+     * settings. Thus, we will need to setup some of the runtime settings again. The reason for creating a new
+     * session is so that on overrun conditions, Sensory can start counting from 0 again.
+     */
+    SnsrRC result = snsrDup(m_session, &newSession);
+    if (result != SNSR_RC_OK) {
+        ACSDK_ERROR(LX("restartSessionFailed")
+                        .d("reason", "sessionDuplicationFailed")
+                        .d("error", getSensoryDetails(newSession, result)));
+        return false;
+    }
+
+    if (!setUpRuntimeSettings(&newSession)) {
+        return false;
+    }
+
+    m_session = newSession;
+    return true;
+}
+
 void SensoryKeywordDetector::detectionLoop() {
-    m_beginIndexOfStreamReader = m_streamReader->tell();
     notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
-    int16_t audioDataToPush[m_maxSamplesPerPush];
+    std::vector<int16_t> audioDataToPush(m_maxSamplesPerCatchUp);
     ssize_t wordsRead;
-    SnsrRC result;
     while (!m_isShuttingDown) {
         bool didErrorOccur = false;
+        size_t wordsToRead = getReadSize(*m_streamReader, m_maxSamplesPerPush, m_maxSamplesPerCatchUp);
         wordsRead = readFromStream(
-            m_streamReader, m_stream, audioDataToPush, m_maxSamplesPerPush, TIMEOUT_FOR_READ_CALLS, &didErrorOccur);
+            m_streamReader, m_stream, audioDataToPush.data(), wordsToRead, TIMEOUT_FOR_READ_CALLS, &didErrorOccur);
         if (didErrorOccur) {
             /*
              * Note that this does not include the overrun condition, which the base class handles by instructing the
-             * reader to seek to BEFORE_WRITER.
+             * reader to seek to BEFORE_WRITER.  The gap this leaves is handled by doProcessAudio().
              */
             break;
-        } else if (wordsRead == AudioInputStream::Reader::Error::OVERRUN) {
-            /*
-             * Updating reference point of Reader so that new indices that get emitted to keyWordObservers can be
-             * relative to it.
-             */
-            m_beginIndexOfStreamReader = m_streamReader->tell();
-            SnsrSession newSession{nullptr};
-            /*
-             * This duplicated SnsrSession will have all the same configurations as m_session but none of the runtime
-             * settings. Thus, we will need to setup some of the runtime settings again. The reason for creating a new
-             * session is so that on overrun conditions, Sensory can start counting from 0 again.
-             */
-            result = snsrDup(m_session, &newSession);
-            if (result != SNSR_RC_OK) {
-                ACSDK_ERROR(LX("detectionLoopFailed")
-                                .d("reason", "sessionDuplicationFailed")
-                                .d("error", getSensoryDetails(newSession, result)));
-                break;
-            }
-
-            if (!setUpRuntimeSettings(&newSession)) {
-                break;
-            }
-
-            m_session = newSession;
         } else if (wordsRead > 0) {
             // Words were successfully read.
-            snsrSetStream(
-                m_session,
-                SNSR_SOURCE_AUDIO_PCM,
-                snsrStreamFromMemory(audioDataToPush, wordsRead * sizeof(*audioDataToPush), SNSR_ST_MODE_READ));
-            result = snsrRun(m_session);
-            switch (result) {
-                case SNSR_RC_STREAM_END:
-                    // Reached end of buffer without any keyword detections
-                    break;
-                case SNSR_RC_OK:
-                    break;
-                default:
-                    // A different return from the callback function that indicates some sort of error
-                    ACSDK_ERROR(LX("detectionLoopFailed")
-                                    .d("reason", "unexpectedReturn")
-                                    .d("error", getSensoryDetails(m_session, result)));
-
-                    notifyKeyWordDetectorStateObservers(
-                        KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
-                    didErrorOccur = true;
-                    break;
-            }
-            if (didErrorOccur) {
+            if (!processAudio(audioDataToPush.data(), wordsRead, m_streamReader->tell() - wordsRead)) {
                 break;
             }
         }
-        // Reset return code for next round
-        snsrClearRC(m_session);
     }
     m_streamReader->close();
 }
 
+bool SensoryKeywordDetector::doProcessAudio(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex) {
+    if (m_hasProcessedAudio && beginIndex != m_nextIndexToProcess) {
+        ACSDK_INFO(LX("doProcessAudio")
+                       .d("event", "audioSkipped")
+                       .d("skippedSamples", beginIndex - m_nextIndexToProcess));
+        if (!restartSession()) {
+            return false;
+        }
+    }
+    if (!m_hasProcessedAudio || beginIndex != m_nextIndexToProcess) {
+        /*
+         * Updating reference point of the engine so that new indices that get emitted to keyWordObservers can be
+         * relative to it.
+         */
+        m_beginIndexOfStreamReader = beginIndex;
+        m_hasProcessedAudio = true;
+    }
+    m_nextIndexToProcess = beginIndex + numSamples;
+
+    snsrSetStream(
+        m_session,
+        SNSR_SOURCE_AUDIO_PCM,
+        snsrStreamFromMemory(const_cast<int16_t*>(samples), numSamples * sizeof(*samples), SNSR_ST_MODE_READ));
+    SnsrRC result = snsrRun(m_session);
+    bool succeeded = true;
+    switch (result) {
+        case SNSR_RC_STREAM_END:
+            // Reached end of buffer without any keyword detections
+            break;
+        case SNSR_RC_OK:
+            break;
+        default:
+            // A different return from the callback function that indicates some sort of error
+            ACSDK_ERROR(LX("doProcessAudioFailed")
+                            .d("reason", "unexpectedReturn")
+                            .d("error", getSensoryDetails(m_session, result)));
+
+            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+            succeeded = false;
+            break;
+    }
+    // Reset return code for next round
+    snsrClearRC(m_session);
+    return succeeded;
+}
+
 }  // namespace kwd
 }  // namespace alexaClientSDK
@@ -561,6 +561,71 @@ TEST_F(SensoryKeywordTest, getExpectedNumberOfDetectionsInAlexaStopAlexaJokeAudi
     }
 }
 
+/**
+ * Tests that the detector initialized asynchronously detects the keywords in the alexa_stop_alexa_joke.wav file when
+ * the audio is written while the model is still loading.
+ */
+TEST_F(SensoryKeywordTest, getExpectedNumberOfDetectionsWhenInitializingAsynchronously) {
+    auto alexaStopAlexaJokeBuffer = std::make_shared<avsCommon::avs::AudioInputStream::Buffer>(500000);
+    auto alexaStopAlexaJokeSds = avsCommon::avs::AudioInputStream::create(alexaStopAlexaJokeBuffer, 2, 1);
+    std::shared_ptr<AudioInputStream> alexaStopAlexaJokeAudioBuffer = std::move(alexaStopAlexaJokeSds);
+
+    std::unique_ptr<AudioInputStream::Writer> alexaStopAlexaJokeAudioBufferWriter =
+        alexaStopAlexaJokeAudioBuffer->createWriter(avsCommon::avs::AudioInputStream::Writer::Policy::NONBLOCKABLE);
+
+    std::string audioFilePath = inputsDirPath + ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE;
+    bool error;
+    std::vector<int16_t> audioData = readAudioFromFile(audioFilePath, &error);
+    ASSERT_FALSE(error);
+
+    auto detector = SensoryKeywordDetector::create(
+        alexaStopAlexaJokeAudioBuffer,
+        compatibleAudioFormat,
+        {keyWordObserver1},
+        {stateObserver},
+        modelFilePath,
+        std::chrono::milliseconds(10),
+        std::chrono::milliseconds(0),
+        true);
+    ASSERT_TRUE(detector);
+
+    alexaStopAlexaJokeAudioBufferWriter->write(audioData.data(), audioData.size());
+
+    auto detections =
+        keyWordObserver1->waitForNDetections(NUM_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE, DEFAULT_TIMEOUT);
+    ASSERT_EQ(detections.size(), NUM_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE);
+
+    for (unsigned int i = 0; i < END_INDICES_OF_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE.size(); ++i) {
+        ASSERT_TRUE(isResultPresent(
+            detections,
+            BEGIN_INDICES_OF_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE.at(i),
+            END_INDICES_OF_ALEXAS_IN_ALEXA_STOP_ALEXA_JOKE_AUDIO_FILE.at(i),
+            KEYWORD));
+    }
+}
+
+/// Tests that the detector state changes to ERROR when a detector initialized asynchronously can not load its model.
+TEST_F(SensoryKeywordTest, getErrorStateWhenInitializingAsynchronouslyWithMissingModel) {
+    auto buffer = std::make_shared<avsCommon::avs::AudioInputStream::Buffer>(500000);
+    std::shared_ptr<AudioInputStream> sds = avsCommon::avs::AudioInputStream::create(buffer, 2, 1);
+
+    auto detector = SensoryKeywordDetector::create(
+        sds,
+        compatibleAudioFormat,
+        {keyWordObserver1},
+        {stateObserver},
+        inputsDirPath + "/missing.snsr",
+        std::chrono::milliseconds(10),
+        std::chrono::milliseconds(0),
+        true);
+    ASSERT_TRUE(detector);
+    bool stateChanged = false;
+    KeyWordDetectorStateObserverInterface::KeyWordDetectorState stateReceived =
+        stateObserver->waitForStateChange(DEFAULT_TIMEOUT, &stateChanged);
+    ASSERT_TRUE(stateChanged);
+    ASSERT_EQ(stateReceived, KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+}
+
 }  // namespace test
 }  // namespace kwd
 }  // namespace alexaClientSDK
@@ -18,19 +18,49 @@
 #ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_ABSTRACT_KEY_WORD_DETECTOR_H_
 #define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_ABSTRACT_KEY_WORD_DETECTOR_H_
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include <AVSCommon/Utils/AudioFormat.h>
 #include <AVSCommon/AVS/AudioInputStream.h>
 #include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
 
+#include "KWD/VoiceActivityGate.h"
+
 namespace alexaClientSDK {
 namespace kwd {
 
+class KeywordDetectorHub;
+class MultiBeamKeywordDetector;
+
 class AbstractKeywordDetector {
 public:
+    /// The processing time a detector has used.
+    struct CpuUsage {
+        /// The CPU time spent in @c processAudio().
+        std::chrono::nanoseconds cpuTime;
+
+        /// The number of samples passed to @c processAudio().  Divided by the sample rate, this is the duration of
+        /// audio which took @c cpuTime to process.
+        uint64_t numSamples;
+    };
+
+    /// How well a detector which reads the stream itself keeps up with the writer.
+    struct ReadStats {
+        /// The number of samples which were waiting to be read before the last read.
+        uint64_t backlog;
+
+        /// The largest number of samples which were waiting to be read before a read.
+        uint64_t maxBacklog;
+
+        /// The number of times the writer overran the reader, which drops audio.
+        uint64_t numOverruns;
+    };
+
     /**
      * Adds the specified observer to the list of observers to notify of key word detection events.
      *
@@ -61,6 +91,52 @@ public:
     void removeKeyWordDetectorStateObserver(
         std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface> keyWordDetectorStateObserver);
 
+    /**
+     * Runs the engine on a chunk of audio, and accounts for the CPU time it takes.  Detectors which read the stream
+     * themselves call this for each chunk they read; a @c KeywordDetectorHub calls it for detectors which were created
+     * to share its reader.
+     *
+     * @param samples The audio, in the format the detector was created for.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The index in the stream of the first sample of @c samples.  A gap from the end of the previous
+     *     chunk means that audio was lost, for instance to an overrun.
+     * @return @c false if the engine failed and should not be given any more audio, and @c true otherwise.
+     */
+    bool processAudio(const int16_t* samples, size_t numSamples, avsCommon::avs::AudioInputStream::Index beginIndex);
+
+    /**
+     * Gets the processing time the detector has used so far.  This may be called from any thread.
+     *
+     * @return The processing time used by @c processAudio().
+     */
+    CpuUsage getCpuUsage() const;
+
+    /**
+     * Gets the read statistics of the detector.  This may be called from any thread.
+     *
+     * @return The read statistics, which stay at zero for a detector which does not read the stream itself.
+     */
+    ReadStats getReadStats() const;
+
+    /**
+     * Gets the confidence of the last keyword detected, which a @c MultiBeamKeywordDetector uses to choose between
+     * the beams which heard the same keyword.  This is called from the keyword observers, while the detection is
+     * being notified.
+     *
+     * @return The confidence, from 0.0 to 1.0, or a negative value if the engine does not report one.  The default
+     * implementation does not report one.
+     */
+    virtual double getDetectionConfidence() const;
+
+    /**
+     * Puts a voice activity gate in front of the engine, so that @c processAudio() only runs the engine while the gate
+     * is open.  When the gate opens, the engine is first given the pre-roll the gate kept, so it can catch up on the
+     * start of a keyword.  Chunks dropped by the gate leave a gap in the indices passed to @c doProcessAudio().
+     *
+     * @param gate The gate, or @c nullptr to run the engine on all of the audio.
+     */
+    void setVoiceActivityGate(std::unique_ptr<VoiceActivityGate> gate);
+
     /**
      * Destructor.
      */
@@ -121,6 +197,21 @@ protected:
         std::chrono::milliseconds timeout,
         bool* errorOccurred);
 
+    /**
+     * Chooses how many words to read next, and records the backlog for @c getReadStats().  The read size follows the
+     * backlog between @c minWords and @c maxWords, so that a detector which has fallen behind catches up in larger
+     * chunks rather than letting the writer overrun it.
+     *
+     * @param reader The stream reader.
+     * @param minWords The number of words to read when the detector is keeping up.
+     * @param maxWords The most words to read at once.  If this is not more than @c minWords, @c minWords are read.
+     * @return The number of words to read.
+     */
+    size_t getReadSize(
+        const avsCommon::avs::AudioInputStream::Reader& reader,
+        size_t minWords,
+        size_t maxWords);
+
     /**
      * Checks to see if the @c audioFormat matches the platform endianness.
      *
@@ -129,7 +220,20 @@ protected:
      */
     static bool isByteswappingRequired(avsCommon::utils::AudioFormat audioFormat);
 
+    /**
+     * Runs the engine on a chunk of audio.  This is called by @c processAudio(), which has the same parameters and
+     * return value.  The default implementation fails, for detectors which can only read the stream themselves.
+     */
+    virtual bool doProcessAudio(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex);
+
 private:
+    /// The hub and the multi-beam detector notify the state observers of the detectors they read for.
+    friend class KeywordDetectorHub;
+    friend class MultiBeamKeywordDetector;
+
     /**
      * The observers to notify on key word detections. This should be locked with m_keyWordObserversMutex prior to
      * usage.
@@ -154,6 +258,30 @@ private:
      * multiple times.
      */
     avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState m_detectorState;
+
+    /// The CPU time spent in @c processAudio(), in nanoseconds.
+    std::atomic<int64_t> m_cpuTimeNs;
+
+    /// The number of samples passed to @c processAudio().
+    std::atomic<uint64_t> m_numSamplesProcessed;
+
+    /// The number of samples which were waiting to be read before the last read.
+    std::atomic<uint64_t> m_backlog;
+
+    /// The largest number of samples which were waiting to be read before a read.
+    std::atomic<uint64_t> m_maxBacklog;
+
+    /// The number of times the writer overran the reader.
+    std::atomic<uint64_t> m_numOverruns;
+
+    /// Serializes access to @c m_voiceActivityGate, which is used by @c processAudio().
+    std::mutex m_voiceActivityGateMutex;
+
+    /// The gate in front of the engine, or @c nullptr if the engine runs on all of the audio.
+    std::unique_ptr<VoiceActivityGate> m_voiceActivityGate;
+
+    /// The buffer the pre-roll of @c m_voiceActivityGate is taken into.
+    std::vector<int16_t> m_preRoll;
 };
 
 }  // namespace kwd
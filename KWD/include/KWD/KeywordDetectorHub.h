@@ -0,0 +1,203 @@
+/*
+ * KeywordDetectorHub.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORD_DETECTOR_HUB_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORD_DETECTOR_HUB_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * Reads an @c AudioInputStream once for several keyword detectors.
+ *
+ * Each detector which reads the stream itself has its own reader, thread and buffer, so running several engines
+ * duplicates the reads and the wakeups.  The hub instead reads each chunk once, and passes the same buffer to every
+ * detector with @c AbstractKeywordDetector::processAudio(), in parallel.  The reader thread runs the first detector,
+ * and each other detector has a worker thread; the next chunk is read once all of the detectors are done with the
+ * current one.  The detectors must have been created to share a reader, and are given audio until they fail or the
+ * stream closes.
+ *
+ * The CPU time each detector uses is reported by @c AbstractKeywordDetector::getCpuUsage().
+ */
+class KeywordDetectorHub {
+public:
+    /**
+     * Creates a @c KeywordDetectorHub, and starts reading the stream.
+     *
+     * @param stream The stream of audio data.  This should be formatted in LPCM encoded with 16 bits per sample.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param detectors The detectors to pass the audio to.
+     * @param msToPushPerIteration The amount of audio in milliseconds to read and pass to the detectors at a time.
+     * @param maxMsToPushPerIteration The most audio in milliseconds to read at a time when the detectors have fallen
+     * behind.  Each read takes up to this much of the backlog, so that the detectors catch up instead of being overrun.
+     * If this is not more than @c msToPushPerIteration, the read size is fixed.
+     * @param maxSpin How long the reader spins for the next chunk before it blocks, which shortens the handoff from
+     * the microphone writer at the cost of some CPU.  Zero disables spinning.
+     * @return A new @c KeywordDetectorHub, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<KeywordDetectorHub> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::vector<std::shared_ptr<AbstractKeywordDetector>> detectors,
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20),
+        std::chrono::milliseconds maxMsToPushPerIteration = std::chrono::milliseconds(0),
+        std::chrono::microseconds maxSpin = std::chrono::microseconds::zero());
+
+    /**
+     * Destructor.  Stops reading the stream.
+     */
+    ~KeywordDetectorHub();
+
+    /**
+     * Gets the read statistics of the hub.  This may be called from any thread.
+     *
+     * @return The read statistics.
+     */
+    AbstractKeywordDetector::ReadStats getReadStats() const;
+
+private:
+    /// A detector and whether it is still given audio.
+    struct Engine {
+        /// The detector.
+        std::shared_ptr<AbstractKeywordDetector> detector;
+
+        /// Whether the detector is still given audio.  Only the thread which runs the detector accesses this.
+        bool isActive;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param stream The stream of audio data.
+     * @param reader The reader of @c stream.
+     * @param detectors The detectors to pass the audio to.
+     * @param samplesPerPush The number of samples to read at a time.
+     * @param maxSamplesPerPush The most samples to read at a time when the detectors have fallen behind.
+     */
+    KeywordDetectorHub(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        std::vector<std::shared_ptr<AbstractKeywordDetector>> detectors,
+        size_t samplesPerPush,
+        size_t maxSamplesPerPush);
+
+    /**
+     * Notifies the state observers of all of the detectors.
+     *
+     * @param state The state of the detectors.
+     */
+    void notifyStateObservers(
+        avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState state);
+
+    /**
+     * Reads the next chunk into @c m_chunk, and handles the errors as @c AbstractKeywordDetector::readFromStream()
+     * does.
+     *
+     * @param[out] errorOccurred Whether the stream closed or failed.
+     * @return The number of words read.
+     */
+    ssize_t readChunk(bool* errorOccurred);
+
+    /**
+     * Passes the current chunk to a detector, unless it has failed.
+     *
+     * @param index The index of the detector in @c m_engines.
+     */
+    void runEngine(size_t index);
+
+    /// The main function of @c m_readerThread, which reads the stream and runs the first detector.
+    void readLoop();
+
+    /**
+     * The main function of a thread in @c m_workerThreads.
+     *
+     * @param index The index of the detector the thread runs in @c m_engines.
+     */
+    void workerLoop(size_t index);
+
+    /// The stream of audio data.
+    const std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// The reader of @c m_stream.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_reader;
+
+    /// The detectors to pass the audio to.
+    std::vector<Engine> m_engines;
+
+    /// The number of samples to read at a time.
+    const size_t m_samplesPerPush;
+
+    /// The chunk being processed, with room for the largest read.  It is only written while no detector is running.
+    std::vector<int16_t> m_chunk;
+
+    /// The number of samples in @c m_chunk.
+    size_t m_chunkSize;
+
+    /// The index in @c m_stream of the first sample of @c m_chunk.
+    avsCommon::avs::AudioInputStream::Index m_chunkBeginIndex;
+
+    /// The number of samples which were waiting to be read before the last read.
+    std::atomic<uint64_t> m_backlog;
+
+    /// The largest number of samples which were waiting to be read before a read.
+    std::atomic<uint64_t> m_maxBacklog;
+
+    /// The number of times the writer overran the reader.
+    std::atomic<uint64_t> m_numOverruns;
+
+    /// Whether the threads should exit.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a new chunk is ready, or when the worker threads should exit.
+    std::condition_variable m_chunkReady;
+
+    /// Notified when the worker threads are done with the current chunk.
+    std::condition_variable m_chunkDone;
+
+    /// The number of chunks read so far.
+    uint64_t m_chunkCount;
+
+    /// The number of worker threads which have not finished processing the current chunk.
+    size_t m_pendingWorkers;
+
+    /// The thread which reads the stream.
+    std::thread m_readerThread;
+
+    /// The threads which run the detectors after the first one.
+    std::vector<std::thread> m_workerThreads;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORD_DETECTOR_HUB_H_
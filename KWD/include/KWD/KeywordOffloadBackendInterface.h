@@ -0,0 +1,100 @@
+/*
+ * KeywordOffloadBackendInterface.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORD_OFFLOAD_BACKEND_INTERFACE_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORD_OFFLOAD_BACKEND_INTERFACE_H_
+
+#include <memory>
+#include <string>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * An interface to a keyword engine which runs off the application processor, such as on a low-power DSP or NPU, and
+ * which wakes the host only when it detects a keyword.
+ *
+ * The host does not read the microphone audio while the offloaded engine listens.  Instead, on a detection the backend
+ * writes the audio the offloaded engine has buffered, which must cover the keyword, into the stream it was started
+ * with, and then reports the keyword with its indices in that stream.  The backend keeps writing the audio after the
+ * keyword to the stream for as long as the host reads it, for instance during a recognition.
+ */
+class KeywordOffloadBackendInterface {
+public:
+    /**
+     * The interface the backend reports to.  Its functions may be called from any thread, including an interrupt or
+     * IPC thread of the backend, and must not be called after @c stop() returns.
+     */
+    class ObserverInterface {
+    public:
+        /**
+         * Called when the offloaded engine detects a keyword, once the audio of the keyword has been written to the
+         * stream.
+         *
+         * @param keyword The keyword detected.
+         * @param beginIndex The index in the stream of the start of the keyword, or
+         * @c KeyWordObserverInterface::UNSPECIFIED_INDEX if it is not known.
+         * @param endIndex The index in the stream of the end of the keyword, or
+         * @c KeyWordObserverInterface::UNSPECIFIED_INDEX if it is not known.
+         */
+        virtual void onKeyWordDetected(
+            std::string keyword,
+            avsCommon::avs::AudioInputStream::Index beginIndex,
+            avsCommon::avs::AudioInputStream::Index endIndex) = 0;
+
+        /**
+         * Called when the offloaded engine stops listening for a reason other than @c stop(), such as a firmware
+         * crash.  No detections are reported after this.
+         */
+        virtual void onBackendFailed() = 0;
+
+        /**
+         * Destructor.
+         */
+        virtual ~ObserverInterface() = default;
+    };
+
+    /**
+     * Loads the model on the offloaded engine if needed, and starts it listening.  The host may go idle once this
+     * returns.
+     *
+     * @param stream The stream to write the buffered audio of each detection to.
+     * @param observer The observer to report to until @c stop() is called.
+     * @return @c true if the engine is listening, and @c false otherwise.
+     */
+    virtual bool start(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::shared_ptr<ObserverInterface> observer) = 0;
+
+    /**
+     * Stops the offloaded engine listening.  Once this returns, the observer given to @c start() is not called again.
+     * This is also called after @c start() fails, and must then undo whatever @c start() did.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Destructor.
+     */
+    virtual ~KeywordOffloadBackendInterface() = default;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORD_OFFLOAD_BACKEND_INTERFACE_H_
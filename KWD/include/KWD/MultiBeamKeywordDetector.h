@@ -0,0 +1,279 @@
+/*
+ * MultiBeamKeywordDetector.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_MULTI_BEAM_KEYWORD_DETECTOR_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_MULTI_BEAM_KEYWORD_DETECTOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * Runs a keyword detection engine on each of the beams a beamformer makes of the microphone audio, and reports each
+ * keyword once, against the beam which heard it best.
+ *
+ * A detector per beam which reads its stream itself needs a thread per beam, and reports the keyword once for each
+ * beam which heard it.  Instead, this reads a chunk of each beam on one thread, and then runs the engines on the
+ * beams on that thread and a shared pool of worker threads, so the number of threads does not grow with the number of
+ * beams.  The next chunks are read once all of the engines are done with the current ones.  The engines must have been
+ * created to share a reader, each for the stream of its beam, and are given audio until they fail or their stream
+ * closes.
+ *
+ * When an engine detects a keyword, the detections of the other beams are collected for a short window, since beams
+ * can fire a chunk or two apart.  The observers are then notified once, with the stream and the indices of the beam
+ * with the highest confidence, so that the recognition streams the best beam.  The confidence of a beam is the one its
+ * engine reports with @c AbstractKeywordDetector::getDetectionConfidence(), or for engines which do not report one, the
+ * energy of the audio of the beam up to the detection, which is highest for the beam pointing at the talker.
+ */
+class MultiBeamKeywordDetector {
+public:
+    /// A beam and the engine which runs on it.
+    struct Beam {
+        /// The stream of the beam.  This should be formatted in LPCM encoded with 16 bits per sample.
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream;
+
+        /// The engine, created to share a reader and to report its detections against @c stream.
+        std::shared_ptr<AbstractKeywordDetector> detector;
+    };
+
+    /**
+     * Creates a @c MultiBeamKeywordDetector, and starts reading the beams.
+     *
+     * @param beams The beams, which must all have the format @c audioFormat and be written in step.
+     * @param audioFormat The format of the audio data located within the streams.
+     * @param keyWordObservers The observers to notify of the keywords detected.
+     * @param numWorkerThreads The number of threads besides the reader thread to run the engines on.  Zero uses a
+     * thread per additional core, up to one less than the number of beams.
+     * @param msToPushPerIteration The amount of audio in milliseconds to read from each beam and pass to its engine at
+     * a time.
+     * @param decisionWindow How long after the first detection of a keyword the detections of other beams are still
+     * collected for it.
+     * @return A new @c MultiBeamKeywordDetector, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<MultiBeamKeywordDetector> create(
+        std::vector<Beam> beams,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        size_t numWorkerThreads = 0,
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20),
+        std::chrono::milliseconds decisionWindow = std::chrono::milliseconds(100));
+
+    /**
+     * Destructor.  Stops reading the beams.
+     */
+    ~MultiBeamKeywordDetector();
+
+    /**
+     * Adds an observer to notify of the keywords detected.
+     *
+     * @param keyWordObserver The observer to add.
+     */
+    void addKeyWordObserver(std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface> keyWordObserver);
+
+    /**
+     * Removes an observer of the keywords detected.
+     *
+     * @param keyWordObserver The observer to remove.
+     */
+    void removeKeyWordObserver(std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface> keyWordObserver);
+
+private:
+    /// Passes the detections of the engine of one beam to the @c MultiBeamKeywordDetector.
+    class BeamObserver;
+
+    /// A detection of a keyword on one beam.
+    struct Detection {
+        /// The index of the beam in @c m_beams.
+        size_t beamIndex;
+
+        /// The keyword detected.
+        std::string keyword;
+
+        /// The begin index of the keyword in the stream of the beam, which may be unspecified.
+        avsCommon::avs::AudioInputStream::Index beginIndex;
+
+        /// The end index of the keyword in the stream of the beam, which may be unspecified.
+        avsCommon::avs::AudioInputStream::Index endIndex;
+
+        /// The confidence of the detection, which is only compared with those of the other beams.
+        double confidence;
+    };
+
+    /// A beam and the state of the engine running on it.
+    struct BeamState {
+        /// The beam.
+        Beam beam;
+
+        /// The reader of the stream of the beam.
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader;
+
+        /// The observer of the engine, which is removed from it when the @c MultiBeamKeywordDetector is destroyed.
+        std::shared_ptr<BeamObserver> observer;
+
+        /// The chunk being processed.  It is only written while no engine is running.
+        std::vector<int16_t> chunk;
+
+        /// The number of samples in @c chunk, which is zero if no audio was read for the current chunk.
+        size_t chunkSize;
+
+        /// The index in the stream of the first sample of @c chunk.
+        avsCommon::avs::AudioInputStream::Index chunkBeginIndex;
+
+        /// The mean squared sample of each of the last chunks, as a ring.
+        std::vector<double> chunkEnergies;
+
+        /// The position in @c chunkEnergies of the next chunk.
+        size_t nextChunkEnergy;
+
+        /// Whether the engine is still given audio.
+        bool isActive;
+
+        /// The detections the engine made in the current chunk.  Only the thread running the engine writes this.
+        std::vector<Detection> detections;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param beams The beams and their readers.
+     * @param keyWordObservers The observers to notify of the keywords detected.
+     * @param numWorkerThreads The number of threads besides the reader thread to run the engines on.
+     * @param samplesPerPush The number of samples to read from each beam at a time.
+     * @param decisionChunks The number of chunks after the first detection of a keyword during which the detections
+     * of other beams are still collected for it.
+     * @param energyChunks The number of chunks the energy of a beam is measured over.
+     */
+    MultiBeamKeywordDetector(
+        std::vector<BeamState> beams,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        size_t numWorkerThreads,
+        size_t samplesPerPush,
+        size_t decisionChunks,
+        size_t energyChunks);
+
+    /**
+     * Records a detection by the engine of a beam.  This is called while the engine processes the current chunk.
+     *
+     * @param beamIndex The index of the beam in @c m_beams.
+     * @param keyword The keyword detected.
+     * @param beginIndex The begin index of the keyword in the stream of the beam.
+     * @param endIndex The end index of the keyword in the stream of the beam.
+     */
+    void onBeamDetection(
+        size_t beamIndex,
+        const std::string& keyword,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex);
+
+    /**
+     * Reads the next chunk of a beam, and handles the errors as @c AbstractKeywordDetector::readFromStream() does.
+     *
+     * @param beamState The beam.
+     * @return @c false if the stream of the beam closed or failed, and @c true otherwise.
+     */
+    bool readChunk(BeamState* beamState);
+
+    /**
+     * Passes the current chunk of a beam to its engine, unless it has failed.
+     *
+     * @param beamIndex The index of the beam in @c m_beams.
+     */
+    void runEngine(size_t beamIndex);
+
+    /// Runs the engines of the beams which have not been taken by another thread for the current chunk.
+    void runEngines();
+
+    /**
+     * Collects the detections of the current chunk, and notifies the observers of the best one once the decision
+     * window has passed.
+     */
+    void decide();
+
+    /// The main function of @c m_readerThread, which reads the beams and runs engines.
+    void readLoop();
+
+    /// The main function of a thread in @c m_workerThreads.
+    void workerLoop();
+
+    /// The beams.
+    std::vector<BeamState> m_beams;
+
+    /// The number of samples to read from each beam at a time.
+    const size_t m_samplesPerPush;
+
+    /// The number of chunks after the first detection of a keyword during which the detections of other beams count.
+    const size_t m_decisionChunks;
+
+    /// The detections of the keyword being decided.  Only the reader thread accesses this.
+    std::vector<Detection> m_candidates;
+
+    /// The number of chunks left before the keyword being decided is notified.  Only the reader thread accesses this.
+    size_t m_decisionChunksLeft;
+
+    /// Serializes access to @c m_keyWordObservers.
+    std::mutex m_keyWordObserversMutex;
+
+    /// The observers to notify of the keywords detected.
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> m_keyWordObservers;
+
+    /// The index in @c m_beams of the next beam for a thread to run the engine of, for the current chunk.
+    std::atomic<size_t> m_nextBeam;
+
+    /// Whether the threads should exit.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when new chunks are ready, or when the worker threads should exit.
+    std::condition_variable m_chunkReady;
+
+    /// Notified when the worker threads are done with the current chunks.
+    std::condition_variable m_chunkDone;
+
+    /// The number of rounds of chunks read so far.
+    uint64_t m_chunkCount;
+
+    /// The number of worker threads which have not finished with the current chunks.
+    size_t m_pendingWorkers;
+
+    /// The thread which reads the beams.
+    std::thread m_readerThread;
+
+    /// The threads which run the engines alongside the reader thread.
+    std::vector<std::thread> m_workerThreads;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_MULTI_BEAM_KEYWORD_DETECTOR_H_
@@ -0,0 +1,124 @@
+/*
+ * OffloadedKeywordDetector.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_OFFLOADED_KEYWORD_DETECTOR_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_OFFLOADED_KEYWORD_DETECTOR_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+#include "KWD/KeywordOffloadBackendInterface.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A keyword detector whose engine runs off the application processor, behind a @c KeywordOffloadBackendInterface.
+ *
+ * Unlike the other detectors, this one has no thread and never reads the stream, so the application processor can
+ * stay idle between utterances.  The detections of the backend are passed on to the keyword observers against the
+ * stream, as any other detector's are, so the rest of the SDK does not need to know where the engine runs.  The state
+ * observers are told @c ACTIVE while the backend listens, and @c ERROR if it fails.
+ */
+class OffloadedKeywordDetector : public AbstractKeywordDetector {
+public:
+    /**
+     * Creates an @c OffloadedKeywordDetector, and starts the backend.
+     *
+     * @param stream The stream the backend writes the audio of its detections to.
+     * @param backend The backend which runs the engine.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @return A new @c OffloadedKeywordDetector, or @c nullptr if the backend could not be started.
+     */
+    static std::unique_ptr<OffloadedKeywordDetector> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::shared_ptr<KeywordOffloadBackendInterface> backend,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers);
+
+    /**
+     * Destructor.  Stops the backend.
+     */
+    ~OffloadedKeywordDetector() override;
+
+private:
+    /// Passes the reports of the backend to the @c OffloadedKeywordDetector.
+    class BackendObserver;
+
+    /**
+     * Constructor.
+     *
+     * @param stream The stream the backend writes the audio of its detections to.
+     * @param backend The backend which runs the engine.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     */
+    OffloadedKeywordDetector(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::shared_ptr<KeywordOffloadBackendInterface> backend,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers);
+
+    /**
+     * Starts the backend.
+     *
+     * @return @c true if the backend is listening, and @c false otherwise.
+     */
+    bool init();
+
+    /**
+     * Passes a detection of the backend on to the keyword observers.
+     *
+     * @param keyword The keyword detected.
+     * @param beginIndex The index in @c m_stream of the start of the keyword.
+     * @param endIndex The index in @c m_stream of the end of the keyword.
+     */
+    void onBackendDetection(
+        const std::string& keyword,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex);
+
+    /// Tells the state observers that the backend has failed.
+    void onBackendFailed();
+
+    /// The stream the backend writes the audio of its detections to.
+    std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// The backend which runs the engine.
+    std::shared_ptr<KeywordOffloadBackendInterface> m_backend;
+
+    /// The observer registered with @c m_backend.
+    std::shared_ptr<BackendObserver> m_backendObserver;
+
+    /// Serializes the notifications of the state observers, which the backend may trigger from any thread.
+    std::mutex m_stateMutex;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_OFFLOADED_KEYWORD_DETECTOR_H_
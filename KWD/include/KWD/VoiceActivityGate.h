@@ -0,0 +1,152 @@
+/*
+ * VoiceActivityGate.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_VOICE_ACTIVITY_GATE_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_VOICE_ACTIVITY_GATE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A cheap energy detector which decides whether a chunk of audio is worth passing to a keyword engine.
+ *
+ * The gate opens when the RMS amplitude of a chunk reaches @c Config::openThreshold, and closes again once the
+ * amplitude has stayed below the lower @c Config::closeThreshold for @c Config::hangover, so that the pauses between
+ * syllables do not close it.  While it is closed, the last @c Config::preRoll of audio is kept, so that the engine can
+ * catch up on the start of a keyword which was too quiet to open the gate.
+ *
+ * This class is not thread-safe.
+ */
+class VoiceActivityGate {
+public:
+    /// The settings of the gate.
+    struct Config {
+        /// The RMS amplitude of a chunk, in 16-bit sample units, at which the gate opens.
+        unsigned int openThreshold;
+
+        /// The RMS amplitude below which audio counts as quiet while the gate is open.  It should not exceed
+        /// @c openThreshold.
+        unsigned int closeThreshold;
+
+        /// How long the audio must stay quiet before the gate closes.
+        std::chrono::milliseconds hangover;
+
+        /// How much audio from before the gate opened is passed to the engine.
+        std::chrono::milliseconds preRoll;
+    };
+
+    /// @return The default settings, which suit a close-talk microphone with a quiet background.
+    static Config getDefaultConfig();
+
+    /**
+     * Creates a @c VoiceActivityGate.
+     *
+     * @param sampleRateHz The sample rate of the audio.
+     * @param config The settings of the gate.
+     * @return A new @c VoiceActivityGate, or @c nullptr if the settings are invalid.
+     */
+    static std::unique_ptr<VoiceActivityGate> create(unsigned int sampleRateHz, Config config = getDefaultConfig());
+
+    /**
+     * Measures a chunk of audio, and updates the state of the gate.  If the gate is closed after the chunk, the chunk
+     * is kept for the pre-roll.
+     *
+     * @param samples The audio.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The index in the stream of the first sample of @c samples.
+     * @return @c true if the chunk should be passed to the engine, and @c false otherwise.
+     */
+    bool process(const int16_t* samples, size_t numSamples, avsCommon::avs::AudioInputStream::Index beginIndex);
+
+    /**
+     * Takes the pre-roll kept from before the gate opened.  After @c process() opens the gate, this returns the audio
+     * which immediately precedes the chunk that opened it; otherwise it returns nothing.
+     *
+     * @param[out] samples The pre-roll.  It is empty if there is none.
+     * @param[out] beginIndex The index in the stream of the first sample of the pre-roll.
+     */
+    void takePreRoll(std::vector<int16_t>* samples, avsCommon::avs::AudioInputStream::Index* beginIndex);
+
+    /// @return Whether the gate is open.
+    bool isOpen() const;
+
+    /**
+     * Closes the gate and forgets the pre-roll.
+     */
+    void reset();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param config The settings of the gate.
+     * @param hangoverSamples The number of quiet samples after which the gate closes.
+     * @param preRollSamples The number of samples of pre-roll to keep.
+     */
+    VoiceActivityGate(Config config, size_t hangoverSamples, size_t preRollSamples);
+
+    /**
+     * Appends a chunk to the pre-roll, forgetting the oldest samples if it is full.
+     *
+     * @param samples The audio.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The index in the stream of the first sample of @c samples.
+     */
+    void keepPreRoll(const int16_t* samples, size_t numSamples, avsCommon::avs::AudioInputStream::Index beginIndex);
+
+    /// The square of @c Config::openThreshold, to compare with the mean square of a chunk.
+    const uint64_t m_openEnergy;
+
+    /// The square of @c Config::closeThreshold.
+    const uint64_t m_closeEnergy;
+
+    /// The number of quiet samples after which the gate closes.
+    const size_t m_hangoverSamples;
+
+    /// Whether the gate is open.
+    bool m_isOpen;
+
+    /// The number of consecutive quiet samples since the gate opened or the audio was last loud.
+    size_t m_quietSamples;
+
+    /// A ring of the last samples seen while the gate was closed.
+    std::vector<int16_t> m_preRoll;
+
+    /// The position in @c m_preRoll at which the next sample is written.
+    size_t m_preRollWritePosition;
+
+    /// The number of samples in @c m_preRoll.
+    size_t m_preRollSize;
+
+    /// The index in the stream just past the last sample in @c m_preRoll.
+    avsCommon::avs::AudioInputStream::Index m_preRollEndIndex;
+
+    /// Whether the pre-roll may be taken, because the last call to @c process() opened the gate.
+    bool m_isPreRollReady;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_VOICE_ACTIVITY_GATE_H_
@@ -15,6 +15,9 @@
  * permissions and limitations under the License.
  */
 
+#include <time.h>
+#include <algorithm>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 #include "KWD/AbstractKeywordDetector.h"
@@ -36,6 +39,22 @@ static const std::string TAG("AbstractKeywordDetector");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The least time between logs of timed out reads, which repeat for as long as no audio is written to the stream.
+static const std::chrono::seconds READ_TIMEOUT_LOG_INTERVAL(10);
+
+/**
+ * Gets the CPU time used by the calling thread.
+ *
+ * @return The CPU time used by the calling thread, or zero if it is not available.
+ */
+static std::chrono::nanoseconds getThreadCpuTime() {
+    struct timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return std::chrono::nanoseconds::zero();
+    }
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
 void AbstractKeywordDetector::addKeyWordObserver(std::shared_ptr<KeyWordObserverInterface> keyWordObserver) {
     std::lock_guard<std::mutex> lock(m_keyWordObserversMutex);
     m_keyWordObservers.insert(keyWordObserver);
@@ -63,7 +82,65 @@ AbstractKeywordDetector::AbstractKeywordDetector(
     std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers) :
         m_keyWordObservers{keyWordObservers},
         m_keyWordDetectorStateObservers{keyWordDetectorStateObservers},
-        m_detectorState{KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED} {
+        m_detectorState{KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED},
+        m_cpuTimeNs{0},
+        m_numSamplesProcessed{0},
+        m_backlog{0},
+        m_maxBacklog{0},
+        m_numOverruns{0} {
+}
+
+bool AbstractKeywordDetector::processAudio(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex) {
+    if (!samples || 0 == numSamples) {
+        ACSDK_ERROR(LX("processAudioFailed").d("reason", "noSamples"));
+        return true;
+    }
+    auto start = getThreadCpuTime();
+    bool result = true;
+    {
+        std::lock_guard<std::mutex> lock(m_voiceActivityGateMutex);
+        if (!m_voiceActivityGate) {
+            result = doProcessAudio(samples, numSamples, beginIndex);
+        } else if (m_voiceActivityGate->process(samples, numSamples, beginIndex)) {
+            AudioInputStream::Index preRollBeginIndex = 0;
+            m_voiceActivityGate->takePreRoll(&m_preRoll, &preRollBeginIndex);
+            if (!m_preRoll.empty()) {
+                result = doProcessAudio(m_preRoll.data(), m_preRoll.size(), preRollBeginIndex);
+            }
+            result = result && doProcessAudio(samples, numSamples, beginIndex);
+        }
+    }
+    m_cpuTimeNs += (getThreadCpuTime() - start).count();
+    m_numSamplesProcessed += numSamples;
+    return result;
+}
+
+AbstractKeywordDetector::ReadStats AbstractKeywordDetector::getReadStats() const {
+    return {m_backlog.load(), m_maxBacklog.load(), m_numOverruns.load()};
+}
+
+double AbstractKeywordDetector::getDetectionConfidence() const {
+    return -1.0;
+}
+
+void AbstractKeywordDetector::setVoiceActivityGate(std::unique_ptr<VoiceActivityGate> gate) {
+    std::lock_guard<std::mutex> lock(m_voiceActivityGateMutex);
+    m_voiceActivityGate = std::move(gate);
+}
+
+AbstractKeywordDetector::CpuUsage AbstractKeywordDetector::getCpuUsage() const {
+    return {std::chrono::nanoseconds(m_cpuTimeNs.load()), m_numSamplesProcessed.load()};
+}
+
+bool AbstractKeywordDetector::doProcessAudio(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex) {
+    ACSDK_ERROR(LX("doProcessAudioFailed").d("reason", "unsupported"));
+    return false;
 }
 
 void AbstractKeywordDetector::notifyKeyWordObservers(
@@ -110,6 +187,7 @@ ssize_t AbstractKeywordDetector::readFromStream(
     } else if (wordsRead < 0) {
         switch (wordsRead) {
             case AudioInputStream::Reader::Error::OVERRUN:
+                ++m_numOverruns;
                 ACSDK_ERROR(LX("readFromStreamFailed")
                                 .d("reason", "streamOverrun")
                                 .d("numWordsOverrun",
@@ -119,7 +197,8 @@ ssize_t AbstractKeywordDetector::readFromStream(
                 reader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
                 break;
             case AudioInputStream::Reader::Error::TIMEDOUT:
-                ACSDK_INFO(LX("readFromStreamFailed").d("reason", "readerTimeOut"));
+                ACSDK_INFO_RATE_LIMITED(
+                    READ_TIMEOUT_LOG_INTERVAL, LX("readFromStreamFailed").d("reason", "readerTimeOut"));
                 break;
             default:
                 // We should never get this since we are using a Blocking Reader.
@@ -138,6 +217,21 @@ ssize_t AbstractKeywordDetector::readFromStream(
     return wordsRead;
 }
 
+size_t AbstractKeywordDetector::getReadSize(
+    const AudioInputStream::Reader& reader,
+    size_t minWords,
+    size_t maxWords) {
+    uint64_t backlog = reader.tell(AudioInputStream::Reader::Reference::BEFORE_WRITER);
+    m_backlog = backlog;
+    if (backlog > m_maxBacklog) {
+        m_maxBacklog = backlog;
+    }
+    if (maxWords <= minWords) {
+        return minWords;
+    }
+    return static_cast<size_t>(std::min<uint64_t>(std::max<uint64_t>(backlog, minWords), maxWords));
+}
+
 bool AbstractKeywordDetector::isByteswappingRequired(avsCommon::utils::AudioFormat audioFormat) {
     bool isPlatformLittleEndian = false;
     int num = 1;
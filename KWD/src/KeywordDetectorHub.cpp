@@ -0,0 +1,265 @@
+/*
+ * KeywordDetectorHub.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
+
+#include "KWD/KeywordDetectorHub.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("KeywordDetectorHub");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of hertz per kilohertz.
+static const size_t HERTZ_PER_KILOHERTZ = 1000;
+
+/// The sample size the detectors take.
+static const unsigned int COMPATIBLE_SAMPLE_SIZE_IN_BITS = 16;
+
+/// The timeout to use for read calls to the SharedDataStream.
+static const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds(1000);
+
+std::unique_ptr<KeywordDetectorHub> KeywordDetectorHub::create(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioFormat audioFormat,
+    std::vector<std::shared_ptr<AbstractKeywordDetector>> detectors,
+    std::chrono::milliseconds msToPushPerIteration,
+    std::chrono::milliseconds maxMsToPushPerIteration,
+    std::chrono::microseconds maxSpin) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (detectors.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noDetectors"));
+        return nullptr;
+    }
+    for (auto& detector : detectors) {
+        if (!detector) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "nullDetector"));
+            return nullptr;
+        }
+    }
+    if (AbstractKeywordDetector::isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    if (audioFormat.encoding != AudioFormat::Encoding::LPCM ||
+        audioFormat.sampleSizeInBits != COMPATIBLE_SAMPLE_SIZE_IN_BITS) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "incompatibleFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits));
+        return nullptr;
+    }
+    size_t samplesPerPush = (audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count();
+    if (0 == samplesPerPush) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroSamplesPerPush"));
+        return nullptr;
+    }
+    std::shared_ptr<AudioInputStream::Reader> reader = stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!reader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createStreamReaderFailed"));
+        return nullptr;
+    }
+    reader->setMaxSpin(maxSpin);
+    size_t maxSamplesPerPush = std::max(
+        samplesPerPush, (audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * maxMsToPushPerIteration.count());
+    return std::unique_ptr<KeywordDetectorHub>(
+        new KeywordDetectorHub(stream, reader, detectors, samplesPerPush, maxSamplesPerPush));
+}
+
+KeywordDetectorHub::KeywordDetectorHub(
+    std::shared_ptr<AudioInputStream> stream,
+    std::shared_ptr<AudioInputStream::Reader> reader,
+    std::vector<std::shared_ptr<AbstractKeywordDetector>> detectors,
+    size_t samplesPerPush,
+    size_t maxSamplesPerPush) :
+        m_stream{stream},
+        m_reader{reader},
+        m_samplesPerPush{samplesPerPush},
+        m_chunk(maxSamplesPerPush),
+        m_chunkSize{0},
+        m_chunkBeginIndex{0},
+        m_backlog{0},
+        m_maxBacklog{0},
+        m_numOverruns{0},
+        m_isShuttingDown{false},
+        m_chunkCount{0},
+        m_pendingWorkers{0} {
+    for (auto& detector : detectors) {
+        m_engines.push_back({detector, true});
+    }
+    for (size_t i = 1; i < m_engines.size(); ++i) {
+        m_workerThreads.emplace_back(&KeywordDetectorHub::workerLoop, this, i);
+    }
+    m_readerThread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::KEYWORD_DETECTION, "kwd-hub", [this]() { readLoop(); });
+}
+
+KeywordDetectorHub::~KeywordDetectorHub() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_chunkReady.notify_all();
+    if (m_readerThread.joinable()) {
+        m_readerThread.join();
+    }
+    for (auto& thread : m_workerThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+AbstractKeywordDetector::ReadStats KeywordDetectorHub::getReadStats() const {
+    return {m_backlog.load(), m_maxBacklog.load(), m_numOverruns.load()};
+}
+
+void KeywordDetectorHub::notifyStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState state) {
+    for (auto& engine : m_engines) {
+        engine.detector->notifyKeyWordDetectorStateObservers(state);
+    }
+}
+
+ssize_t KeywordDetectorHub::readChunk(bool* errorOccurred) {
+    *errorOccurred = false;
+    // Take up to a whole chunk of the backlog, as AbstractKeywordDetector::getReadSize() does.
+    uint64_t backlog = m_reader->tell(AudioInputStream::Reader::Reference::BEFORE_WRITER);
+    m_backlog = backlog;
+    if (backlog > m_maxBacklog) {
+        m_maxBacklog = backlog;
+    }
+    auto wordsToRead =
+        static_cast<size_t>(std::min<uint64_t>(std::max<uint64_t>(backlog, m_samplesPerPush), m_chunk.size()));
+    ssize_t wordsRead = m_reader->read(m_chunk.data(), wordsToRead, TIMEOUT_FOR_READ_CALLS);
+    if (0 == wordsRead) {
+        ACSDK_DEBUG(LX("readChunk").d("event", "streamClosed"));
+        notifyStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED);
+        *errorOccurred = true;
+    } else if (wordsRead < 0) {
+        switch (wordsRead) {
+            case AudioInputStream::Reader::Error::OVERRUN:
+                ++m_numOverruns;
+                ACSDK_ERROR(LX("readChunkFailed").d("reason", "streamOverrun"));
+                m_reader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+                break;
+            case AudioInputStream::Reader::Error::TIMEDOUT:
+                ACSDK_INFO(LX("readChunkFailed").d("reason", "readerTimeOut"));
+                break;
+            default:
+                ACSDK_ERROR(LX("readChunkFailed").d("reason", "unexpectedError").d("error", wordsRead));
+                notifyStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+                *errorOccurred = true;
+                break;
+        }
+    }
+    return wordsRead;
+}
+
+void KeywordDetectorHub::runEngine(size_t index) {
+    auto& engine = m_engines[index];
+    if (!engine.isActive) {
+        return;
+    }
+    if (!engine.detector->processAudio(m_chunk.data(), m_chunkSize, m_chunkBeginIndex)) {
+        ACSDK_ERROR(LX("runEngineFailed").d("reason", "detectorFailed").d("index", index));
+        engine.isActive = false;
+    }
+}
+
+void KeywordDetectorHub::readLoop() {
+    notifyStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    while (!m_isShuttingDown) {
+        bool errorOccurred = false;
+        ssize_t wordsRead = readChunk(&errorOccurred);
+        if (errorOccurred) {
+            break;
+        }
+        if (wordsRead <= 0) {
+            continue;
+        }
+        m_chunkSize = wordsRead;
+        m_chunkBeginIndex = m_reader->tell() - wordsRead;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_chunkCount;
+            m_pendingWorkers = m_workerThreads.size();
+        }
+        m_chunkReady.notify_all();
+        runEngine(0);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_chunkDone.wait(lock, [this]() { return 0 == m_pendingWorkers; });
+
+        bool isAnyActive = false;
+        for (auto& engine : m_engines) {
+            isAnyActive = isAnyActive || engine.isActive;
+        }
+        if (!isAnyActive) {
+            ACSDK_ERROR(LX("readLoopEnded").d("reason", "allDetectorsFailed"));
+            break;
+        }
+    }
+    m_reader->close();
+
+    // Let the worker threads exit, in case the loop ended before the destructor was called.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_chunkReady.notify_all();
+}
+
+void KeywordDetectorHub::workerLoop(size_t index) {
+    uint64_t chunksProcessed = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_chunkReady.wait(
+            lock, [this, chunksProcessed]() { return m_isShuttingDown || m_chunkCount != chunksProcessed; });
+        // A chunk which was read before the shutdown is still processed, since the reader thread waits for it.
+        if (m_chunkCount == chunksProcessed) {
+            return;
+        }
+        chunksProcessed = m_chunkCount;
+        lock.unlock();
+        runEngine(index);
+        lock.lock();
+        if (0 == --m_pendingWorkers) {
+            m_chunkDone.notify_all();
+        }
+    }
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,390 @@
+/*
+ * MultiBeamKeywordDetector.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <numeric>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
+
+#include "KWD/MultiBeamKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MultiBeamKeywordDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of hertz per kilohertz.
+static const size_t HERTZ_PER_KILOHERTZ = 1000;
+
+/// The sample size the engines take.
+static const unsigned int COMPATIBLE_SAMPLE_SIZE_IN_BITS = 16;
+
+/// The timeout to use for read calls to the SharedDataStream.
+static const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds(1000);
+
+/// The duration of the audio the energy of a beam is measured over, which is about the length of a keyword.
+static const std::chrono::milliseconds ENERGY_WINDOW = std::chrono::milliseconds(800);
+
+class MultiBeamKeywordDetector::BeamObserver : public KeyWordObserverInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param detector The @c MultiBeamKeywordDetector to pass the detections to.
+     * @param beamIndex The index of the beam whose engine this observes.
+     */
+    BeamObserver(MultiBeamKeywordDetector* detector, size_t beamIndex) : m_detector{detector}, m_beamIndex{beamIndex} {
+    }
+
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        m_detector->onBeamDetection(m_beamIndex, keyword, beginIndex, endIndex);
+    }
+
+private:
+    /// The @c MultiBeamKeywordDetector to pass the detections to.
+    MultiBeamKeywordDetector* m_detector;
+
+    /// The index of the beam whose engine this observes.
+    size_t m_beamIndex;
+};
+
+std::unique_ptr<MultiBeamKeywordDetector> MultiBeamKeywordDetector::create(
+    std::vector<Beam> beams,
+    AudioFormat audioFormat,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    size_t numWorkerThreads,
+    std::chrono::milliseconds msToPushPerIteration,
+    std::chrono::milliseconds decisionWindow) {
+    if (beams.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noBeams"));
+        return nullptr;
+    }
+    if (AbstractKeywordDetector::isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    if (audioFormat.encoding != AudioFormat::Encoding::LPCM ||
+        audioFormat.sampleSizeInBits != COMPATIBLE_SAMPLE_SIZE_IN_BITS) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "incompatibleFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits));
+        return nullptr;
+    }
+    size_t samplesPerPush = (audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count();
+    if (0 == samplesPerPush) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroSamplesPerPush"));
+        return nullptr;
+    }
+
+    std::vector<BeamState> beamStates;
+    for (auto& beam : beams) {
+        if (!beam.stream || !beam.detector) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "invalidBeam").d("index", beamStates.size()));
+            return nullptr;
+        }
+        std::shared_ptr<AudioInputStream::Reader> reader =
+            beam.stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+        if (!reader) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "createStreamReaderFailed").d("index", beamStates.size()));
+            return nullptr;
+        }
+        BeamState beamState;
+        beamState.beam = beam;
+        beamState.reader = reader;
+        beamStates.push_back(std::move(beamState));
+    }
+
+    if (0 == numWorkerThreads) {
+        size_t numCores = std::max(1u, std::thread::hardware_concurrency());
+        numWorkerThreads = std::min(numCores, beams.size()) - 1;
+    }
+    // More workers than beams besides the one the reader thread takes would have nothing to do.
+    numWorkerThreads = std::min(numWorkerThreads, beams.size() - 1);
+    size_t decisionChunks = (decisionWindow.count() + msToPushPerIteration.count() - 1) / msToPushPerIteration.count();
+    size_t energyChunks = std::max<size_t>(1, ENERGY_WINDOW.count() / msToPushPerIteration.count());
+
+    return std::unique_ptr<MultiBeamKeywordDetector>(new MultiBeamKeywordDetector(
+        std::move(beamStates), keyWordObservers, numWorkerThreads, samplesPerPush, decisionChunks, energyChunks));
+}
+
+MultiBeamKeywordDetector::MultiBeamKeywordDetector(
+    std::vector<BeamState> beams,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    size_t numWorkerThreads,
+    size_t samplesPerPush,
+    size_t decisionChunks,
+    size_t energyChunks) :
+        m_beams(std::move(beams)),
+        m_samplesPerPush{samplesPerPush},
+        m_decisionChunks{decisionChunks},
+        m_decisionChunksLeft{0},
+        m_keyWordObservers{keyWordObservers},
+        m_nextBeam{0},
+        m_isShuttingDown{false},
+        m_chunkCount{0},
+        m_pendingWorkers{0} {
+    for (size_t i = 0; i < m_beams.size(); ++i) {
+        auto& beamState = m_beams[i];
+        beamState.chunk.resize(samplesPerPush);
+        beamState.chunkSize = 0;
+        beamState.chunkBeginIndex = 0;
+        beamState.chunkEnergies.assign(energyChunks, 0.0);
+        beamState.nextChunkEnergy = 0;
+        beamState.isActive = true;
+        beamState.observer = std::make_shared<BeamObserver>(this, i);
+        beamState.beam.detector->addKeyWordObserver(beamState.observer);
+    }
+    for (size_t i = 0; i < numWorkerThreads; ++i) {
+        m_workerThreads.emplace_back(&MultiBeamKeywordDetector::workerLoop, this);
+    }
+    m_readerThread = threading::ThreadFactory::createThread(
+        threading::ThreadRole::KEYWORD_DETECTION, "kwd-beams", [this]() { readLoop(); });
+}
+
+MultiBeamKeywordDetector::~MultiBeamKeywordDetector() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_chunkReady.notify_all();
+    if (m_readerThread.joinable()) {
+        m_readerThread.join();
+    }
+    for (auto& thread : m_workerThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    for (auto& beamState : m_beams) {
+        beamState.beam.detector->removeKeyWordObserver(beamState.observer);
+    }
+}
+
+void MultiBeamKeywordDetector::addKeyWordObserver(std::shared_ptr<KeyWordObserverInterface> keyWordObserver) {
+    std::lock_guard<std::mutex> lock(m_keyWordObserversMutex);
+    m_keyWordObservers.insert(keyWordObserver);
+}
+
+void MultiBeamKeywordDetector::removeKeyWordObserver(std::shared_ptr<KeyWordObserverInterface> keyWordObserver) {
+    std::lock_guard<std::mutex> lock(m_keyWordObserversMutex);
+    m_keyWordObservers.erase(keyWordObserver);
+}
+
+void MultiBeamKeywordDetector::onBeamDetection(
+    size_t beamIndex,
+    const std::string& keyword,
+    AudioInputStream::Index beginIndex,
+    AudioInputStream::Index endIndex) {
+    auto& beamState = m_beams[beamIndex];
+    double confidence = beamState.beam.detector->getDetectionConfidence();
+    if (confidence < 0) {
+        // The engine does not say how sure it is, so prefer the beam which is loudest over the keyword.
+        confidence = std::accumulate(beamState.chunkEnergies.begin(), beamState.chunkEnergies.end(), 0.0);
+    }
+    ACSDK_DEBUG5(LX("onBeamDetection").d("beam", beamIndex).d("keyword", keyword).d("confidence", confidence));
+    beamState.detections.push_back({beamIndex, keyword, beginIndex, endIndex, confidence});
+}
+
+bool MultiBeamKeywordDetector::readChunk(BeamState* beamState) {
+    beamState->chunkSize = 0;
+    ssize_t wordsRead = beamState->reader->read(beamState->chunk.data(), m_samplesPerPush, TIMEOUT_FOR_READ_CALLS);
+    if (0 == wordsRead) {
+        ACSDK_DEBUG(LX("readChunk").d("event", "streamClosed"));
+        beamState->beam.detector->notifyKeyWordDetectorStateObservers(
+            KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED);
+        return false;
+    }
+    if (wordsRead < 0) {
+        switch (wordsRead) {
+            case AudioInputStream::Reader::Error::OVERRUN:
+                ACSDK_ERROR(LX("readChunkFailed").d("reason", "streamOverrun"));
+                beamState->reader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+                return true;
+            case AudioInputStream::Reader::Error::TIMEDOUT:
+                ACSDK_INFO(LX("readChunkFailed").d("reason", "readerTimeOut"));
+                return true;
+            default:
+                ACSDK_ERROR(LX("readChunkFailed").d("reason", "unexpectedError").d("error", wordsRead));
+                beamState->beam.detector->notifyKeyWordDetectorStateObservers(
+                    KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+                return false;
+        }
+    }
+    beamState->chunkSize = wordsRead;
+    beamState->chunkBeginIndex = beamState->reader->tell() - wordsRead;
+    return true;
+}
+
+void MultiBeamKeywordDetector::runEngine(size_t beamIndex) {
+    auto& beamState = m_beams[beamIndex];
+    if (!beamState.isActive || 0 == beamState.chunkSize) {
+        return;
+    }
+    double sumOfSquares = 0;
+    for (size_t i = 0; i < beamState.chunkSize; ++i) {
+        double sample = beamState.chunk[i];
+        sumOfSquares += sample * sample;
+    }
+    beamState.chunkEnergies[beamState.nextChunkEnergy] = sumOfSquares / beamState.chunkSize;
+    beamState.nextChunkEnergy = (beamState.nextChunkEnergy + 1) % beamState.chunkEnergies.size();
+
+    if (!beamState.beam.detector->processAudio(
+            beamState.chunk.data(), beamState.chunkSize, beamState.chunkBeginIndex)) {
+        ACSDK_ERROR(LX("runEngineFailed").d("reason", "detectorFailed").d("beam", beamIndex));
+        beamState.isActive = false;
+    }
+}
+
+void MultiBeamKeywordDetector::runEngines() {
+    size_t beamIndex;
+    while ((beamIndex = m_nextBeam++) < m_beams.size()) {
+        runEngine(beamIndex);
+    }
+}
+
+void MultiBeamKeywordDetector::decide() {
+    for (auto& beamState : m_beams) {
+        if (beamState.detections.empty()) {
+            continue;
+        }
+        if (m_candidates.empty()) {
+            m_decisionChunksLeft = m_decisionChunks;
+        }
+        m_candidates.insert(m_candidates.end(), beamState.detections.begin(), beamState.detections.end());
+        beamState.detections.clear();
+    }
+    if (m_candidates.empty()) {
+        return;
+    }
+    if (m_decisionChunksLeft > 0) {
+        --m_decisionChunksLeft;
+        return;
+    }
+
+    auto best = std::max_element(
+        m_candidates.begin(), m_candidates.end(), [](const Detection& lhs, const Detection& rhs) {
+            return lhs.confidence < rhs.confidence;
+        });
+    auto detection = *best;
+    ACSDK_DEBUG(LX("keyWordDetected")
+                    .d("beam", detection.beamIndex)
+                    .d("keyword", detection.keyword)
+                    .d("confidence", detection.confidence)
+                    .d("candidates", m_candidates.size()));
+    m_candidates.clear();
+
+    std::unique_lock<std::mutex> lock(m_keyWordObserversMutex);
+    auto observers = m_keyWordObservers;
+    lock.unlock();
+    for (auto& observer : observers) {
+        observer->onKeyWordDetected(
+            m_beams[detection.beamIndex].beam.stream, detection.keyword, detection.beginIndex, detection.endIndex);
+    }
+}
+
+void MultiBeamKeywordDetector::readLoop() {
+    for (auto& beamState : m_beams) {
+        beamState.beam.detector->notifyKeyWordDetectorStateObservers(
+            KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    }
+    while (!m_isShuttingDown) {
+        // The beams are written in step, so reading them in turn takes about the same span of audio from each.
+        bool isAnyActive = false;
+        for (auto& beamState : m_beams) {
+            // Each read can block for a while, so stop between them rather than only between chunks.
+            if (m_isShuttingDown) {
+                break;
+            }
+            if (beamState.isActive && !readChunk(&beamState)) {
+                beamState.isActive = false;
+            }
+            isAnyActive = isAnyActive || beamState.isActive;
+        }
+        if (m_isShuttingDown) {
+            break;
+        }
+        if (!isAnyActive) {
+            ACSDK_ERROR(LX("readLoopEnded").d("reason", "allBeamsEnded"));
+            break;
+        }
+
+        m_nextBeam = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_chunkCount;
+            m_pendingWorkers = m_workerThreads.size();
+        }
+        m_chunkReady.notify_all();
+        runEngines();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_chunkDone.wait(lock, [this]() { return 0 == m_pendingWorkers; });
+        }
+        decide();
+    }
+    for (auto& beamState : m_beams) {
+        beamState.reader->close();
+    }
+
+    // Let the worker threads exit, in case the loop ended before the destructor was called.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_chunkReady.notify_all();
+}
+
+void MultiBeamKeywordDetector::workerLoop() {
+    uint64_t chunksProcessed = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_chunkReady.wait(
+            lock, [this, chunksProcessed]() { return m_isShuttingDown || m_chunkCount != chunksProcessed; });
+        // Chunks which were read before the shutdown are still processed, since the reader thread waits for them.
+        if (m_chunkCount == chunksProcessed) {
+            return;
+        }
+        chunksProcessed = m_chunkCount;
+        lock.unlock();
+        runEngines();
+        lock.lock();
+        if (0 == --m_pendingWorkers) {
+            m_chunkDone.notify_all();
+        }
+    }
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,133 @@
+/*
+ * OffloadedKeywordDetector.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWD/OffloadedKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("OffloadedKeywordDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+class OffloadedKeywordDetector::BackendObserver : public KeywordOffloadBackendInterface::ObserverInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param detector The @c OffloadedKeywordDetector to pass the reports to.
+     */
+    BackendObserver(OffloadedKeywordDetector* detector) : m_detector{detector} {
+    }
+
+    void onKeyWordDetected(std::string keyword, AudioInputStream::Index beginIndex, AudioInputStream::Index endIndex)
+        override {
+        m_detector->onBackendDetection(keyword, beginIndex, endIndex);
+    }
+
+    void onBackendFailed() override {
+        m_detector->onBackendFailed();
+    }
+
+private:
+    /// The @c OffloadedKeywordDetector to pass the reports to.  The backend stops calling this before it is destroyed.
+    OffloadedKeywordDetector* m_detector;
+};
+
+std::unique_ptr<OffloadedKeywordDetector> OffloadedKeywordDetector::create(
+    std::shared_ptr<AudioInputStream> stream,
+    std::shared_ptr<KeywordOffloadBackendInterface> backend,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (!backend) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullBackend"));
+        return nullptr;
+    }
+    std::unique_ptr<OffloadedKeywordDetector> detector(
+        new OffloadedKeywordDetector(stream, backend, keyWordObservers, keyWordDetectorStateObservers));
+    if (!detector->init()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initDetectorFailed"));
+        return nullptr;
+    }
+    return detector;
+}
+
+OffloadedKeywordDetector::~OffloadedKeywordDetector() {
+    m_backend->stop();
+}
+
+OffloadedKeywordDetector::OffloadedKeywordDetector(
+    std::shared_ptr<AudioInputStream> stream,
+    std::shared_ptr<KeywordOffloadBackendInterface> backend,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers) :
+        AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
+        m_stream{stream},
+        m_backend{backend} {
+}
+
+bool OffloadedKeywordDetector::init() {
+    m_backendObserver = std::make_shared<BackendObserver>(this);
+    if (!m_backend->start(m_stream, m_backendObserver)) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "startBackendFailed"));
+        // The destructor stops the backend anyway, so it does not matter whether it started partway.
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    return true;
+}
+
+void OffloadedKeywordDetector::onBackendDetection(
+    const std::string& keyword,
+    AudioInputStream::Index beginIndex,
+    AudioInputStream::Index endIndex) {
+    if (beginIndex != KeyWordObserverInterface::UNSPECIFIED_INDEX &&
+        endIndex != KeyWordObserverInterface::UNSPECIFIED_INDEX && beginIndex > endIndex) {
+        ACSDK_ERROR(LX("onBackendDetectionFailed")
+                        .d("reason", "invalidIndices")
+                        .d("beginIndex", beginIndex)
+                        .d("endIndex", endIndex));
+        return;
+    }
+    ACSDK_DEBUG(LX("onBackendDetection").d("keyword", keyword).d("beginIndex", beginIndex).d("endIndex", endIndex));
+    notifyKeyWordObservers(m_stream, keyword, beginIndex, endIndex);
+}
+
+void OffloadedKeywordDetector::onBackendFailed() {
+    ACSDK_ERROR(LX("onBackendFailed"));
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
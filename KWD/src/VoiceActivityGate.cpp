@@ -0,0 +1,196 @@
+/*
+ * VoiceActivityGate.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWD/VoiceActivityGate.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("VoiceActivityGate");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of milliseconds per second.
+static const size_t MILLISECONDS_PER_SECOND = 1000;
+
+/// The default RMS amplitude at which the gate opens, about -36 dBFS.
+static const unsigned int DEFAULT_OPEN_THRESHOLD = 500;
+
+/// The default RMS amplitude below which audio counts as quiet, about -40 dBFS.
+static const unsigned int DEFAULT_CLOSE_THRESHOLD = 300;
+
+/// The default time the audio must stay quiet before the gate closes.
+static const std::chrono::milliseconds DEFAULT_HANGOVER = std::chrono::milliseconds(1000);
+
+/// The default amount of audio from before the gate opened to pass to the engine.
+static const std::chrono::milliseconds DEFAULT_PRE_ROLL = std::chrono::milliseconds(500);
+
+/**
+ * Gets the number of samples in a duration of audio.
+ *
+ * @param sampleRateHz The sample rate of the audio.
+ * @param duration The duration.
+ * @return The number of samples.
+ */
+static size_t toSamples(unsigned int sampleRateHz, std::chrono::milliseconds duration) {
+    return static_cast<size_t>(sampleRateHz) * duration.count() / MILLISECONDS_PER_SECOND;
+}
+
+VoiceActivityGate::Config VoiceActivityGate::getDefaultConfig() {
+    return {DEFAULT_OPEN_THRESHOLD, DEFAULT_CLOSE_THRESHOLD, DEFAULT_HANGOVER, DEFAULT_PRE_ROLL};
+}
+
+std::unique_ptr<VoiceActivityGate> VoiceActivityGate::create(unsigned int sampleRateHz, Config config) {
+    if (0 == sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroSampleRate"));
+        return nullptr;
+    }
+    if (config.closeThreshold > config.openThreshold) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "closeThresholdAboveOpenThreshold")
+                        .d("openThreshold", config.openThreshold)
+                        .d("closeThreshold", config.closeThreshold));
+        return nullptr;
+    }
+    if (config.hangover.count() < 0 || config.preRoll.count() < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "negativeDuration"));
+        return nullptr;
+    }
+    return std::unique_ptr<VoiceActivityGate>(new VoiceActivityGate(
+        config, toSamples(sampleRateHz, config.hangover), toSamples(sampleRateHz, config.preRoll)));
+}
+
+VoiceActivityGate::VoiceActivityGate(Config config, size_t hangoverSamples, size_t preRollSamples) :
+        m_openEnergy{static_cast<uint64_t>(config.openThreshold) * config.openThreshold},
+        m_closeEnergy{static_cast<uint64_t>(config.closeThreshold) * config.closeThreshold},
+        m_hangoverSamples{hangoverSamples},
+        m_isOpen{false},
+        m_quietSamples{0},
+        m_preRoll(preRollSamples),
+        m_preRollWritePosition{0},
+        m_preRollSize{0},
+        m_preRollEndIndex{0},
+        m_isPreRollReady{false} {
+}
+
+bool VoiceActivityGate::process(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) {
+    m_isPreRollReady = false;
+    if (!samples || 0 == numSamples) {
+        return m_isOpen;
+    }
+    uint64_t energy = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        energy += static_cast<int32_t>(samples[i]) * samples[i];
+    }
+    energy /= numSamples;
+
+    if (!m_isOpen) {
+        if (energy >= m_openEnergy) {
+            ACSDK_DEBUG9(LX("process").d("event", "opened").d("beginIndex", beginIndex));
+            m_isOpen = true;
+            m_quietSamples = 0;
+            // The pre-roll is only useful if it leads straight into this chunk.
+            m_isPreRollReady = m_preRollSize > 0 && m_preRollEndIndex == beginIndex;
+            if (!m_isPreRollReady) {
+                m_preRollSize = 0;
+            }
+            return true;
+        }
+        keepPreRoll(samples, numSamples, beginIndex);
+        return false;
+    }
+
+    if (energy >= m_closeEnergy) {
+        m_quietSamples = 0;
+    } else {
+        m_quietSamples += numSamples;
+        if (m_quietSamples >= m_hangoverSamples) {
+            ACSDK_DEBUG9(LX("process").d("event", "closed").d("beginIndex", beginIndex));
+            m_isOpen = false;
+            m_preRollSize = 0;
+            // The chunk which closes the gate is still passed on, so it is not kept for the pre-roll.
+            m_preRollEndIndex = beginIndex + numSamples;
+        }
+    }
+    return true;
+}
+
+void VoiceActivityGate::takePreRoll(std::vector<int16_t>* samples, AudioInputStream::Index* beginIndex) {
+    samples->clear();
+    if (!m_isPreRollReady) {
+        return;
+    }
+    m_isPreRollReady = false;
+    samples->resize(m_preRollSize);
+    // The oldest sample is m_preRollSize before the write position, wrapping around the ring.
+    size_t start = (m_preRollWritePosition + m_preRoll.size() - m_preRollSize) % m_preRoll.size();
+    size_t firstPart = std::min(m_preRollSize, m_preRoll.size() - start);
+    std::memcpy(samples->data(), m_preRoll.data() + start, firstPart * sizeof(int16_t));
+    std::memcpy(samples->data() + firstPart, m_preRoll.data(), (m_preRollSize - firstPart) * sizeof(int16_t));
+    *beginIndex = m_preRollEndIndex - m_preRollSize;
+    m_preRollSize = 0;
+}
+
+bool VoiceActivityGate::isOpen() const {
+    return m_isOpen;
+}
+
+void VoiceActivityGate::reset() {
+    m_isOpen = false;
+    m_quietSamples = 0;
+    m_preRollSize = 0;
+    m_isPreRollReady = false;
+}
+
+void VoiceActivityGate::keepPreRoll(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) {
+    size_t capacity = m_preRoll.size();
+    if (0 == capacity) {
+        return;
+    }
+    if (m_preRollEndIndex != beginIndex) {
+        // Audio was skipped, so the samples kept no longer lead into the next chunk.
+        m_preRollSize = 0;
+    }
+    m_preRollEndIndex = beginIndex + numSamples;
+    if (numSamples >= capacity) {
+        std::memcpy(m_preRoll.data(), samples + numSamples - capacity, capacity * sizeof(int16_t));
+        m_preRollWritePosition = 0;
+        m_preRollSize = capacity;
+        return;
+    }
+    size_t firstPart = std::min(numSamples, capacity - m_preRollWritePosition);
+    std::memcpy(m_preRoll.data() + m_preRollWritePosition, samples, firstPart * sizeof(int16_t));
+    std::memcpy(m_preRoll.data(), samples + firstPart, (numSamples - firstPart) * sizeof(int16_t));
+    m_preRollWritePosition = (m_preRollWritePosition + numSamples) % capacity;
+    m_preRollSize = std::min(capacity, m_preRollSize + numSamples);
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
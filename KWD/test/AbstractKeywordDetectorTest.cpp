@@ -19,6 +19,7 @@
 #include <gmock/gmock.h>
 
 #include <unordered_set>
+#include <vector>
 
 #include <AVSCommon/Utils/AudioFormat.h>
 #include <AVSCommon/AVS/AudioInputStream.h>
@@ -75,6 +76,9 @@ public:
         avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState state) {
         notifyKeyWordDetectorStateObservers(state);
     };
+
+    using AbstractKeywordDetector::getReadSize;
+    using AbstractKeywordDetector::readFromStream;
 };
 
 class AbstractKeyWordDetectorTest : public ::testing::Test {
@@ -172,6 +176,46 @@ TEST_F(AbstractKeyWordDetectorTest, testObserversDontGetNotifiedOfSameStateTwice
         avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
 }
 
+/**
+ * Verify that the read size follows the backlog within its limits, and that the backlog and overruns are counted.
+ */
+TEST_F(AbstractKeyWordDetectorTest, testReadSizeFollowsBacklog) {
+    static const size_t BUFFER_WORDS = 1000;
+    auto bufferSize = avsCommon::avs::AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int16_t), 1);
+    std::shared_ptr<avsCommon::avs::AudioInputStream> stream = avsCommon::avs::AudioInputStream::create(
+        std::make_shared<avsCommon::avs::AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+    ASSERT_TRUE(stream);
+    auto writer = stream->createWriter(avsCommon::avs::AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader =
+        stream->createReader(avsCommon::avs::AudioInputStream::Reader::Policy::BLOCKING);
+    ASSERT_TRUE(writer && reader);
+
+    std::vector<int16_t> samples(BUFFER_WORDS);
+    EXPECT_EQ(detector->getReadSize(*reader, 160, 640), 160u);
+    writer->write(samples.data(), 400);
+    EXPECT_EQ(detector->getReadSize(*reader, 160, 640), 400u);
+    EXPECT_EQ(detector->getReadSize(*reader, 160, 0), 160u);
+    writer->write(samples.data(), 400);
+    EXPECT_EQ(detector->getReadSize(*reader, 160, 640), 640u);
+    EXPECT_EQ(detector->getReadStats().backlog, 800u);
+    EXPECT_EQ(detector->getReadStats().maxBacklog, 800u);
+
+    ASSERT_EQ(reader->read(samples.data(), 800), 800);
+    EXPECT_EQ(detector->getReadSize(*reader, 160, 640), 160u);
+    EXPECT_EQ(detector->getReadStats().backlog, 0u);
+    EXPECT_EQ(detector->getReadStats().maxBacklog, 800u);
+
+    // Writing more than the buffer holds overruns the reader.
+    writer->write(samples.data(), BUFFER_WORDS);
+    writer->write(samples.data(), BUFFER_WORDS);
+    bool errorOccurred = true;
+    EXPECT_EQ(
+        detector->readFromStream(reader, stream, samples.data(), 160, std::chrono::milliseconds(0), &errorOccurred),
+        avsCommon::avs::AudioInputStream::Reader::Error::OVERRUN);
+    EXPECT_FALSE(errorOccurred);
+    EXPECT_EQ(detector->getReadStats().numOverruns, 1u);
+}
+
 }  // namespace test
 }  // namespace kwd
 }  // namespace alexaClientSDK
@@ -0,0 +1,346 @@
+/*
+ * KeywordDetectorHubTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+
+#include "KWD/KeywordDetectorHub.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The number of 16-bit words in the stream's buffer.
+static const size_t BUFFER_WORDS = 16000;
+
+/// The number of samples written by the tests, which is not a multiple of the chunk size.
+static const size_t NUM_SAMPLES = 1000;
+
+/// The amount of audio to pass to the detectors at a time, which is 320 samples at 16 kHz.
+static const std::chrono::milliseconds MS_PER_PUSH = std::chrono::milliseconds(20);
+
+/// How long to wait for the detectors to be given the audio.
+static const std::chrono::seconds TIMEOUT = std::chrono::seconds(5);
+
+/// A test observer that records the last state it was notified of.
+class TestStateObserver : public KeyWordDetectorStateObserverInterface {
+public:
+    void onStateChanged(KeyWordDetectorState keyWordDetectorState) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_state = keyWordDetectorState;
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits for a state.
+     *
+     * @param state The state to wait for.
+     * @return @c true if the observer was notified of the state before the timeout and @c false otherwise.
+     */
+    bool waitForState(KeyWordDetectorState state) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, state]() { return m_state == state; });
+    }
+
+private:
+    /// Serializes access to @c m_state.
+    std::mutex m_mutex;
+
+    /// Notified when @c m_state changes.
+    std::condition_variable m_wakeTrigger;
+
+    /// The last state notified.
+    KeyWordDetectorState m_state = KeyWordDetectorState::STREAM_CLOSED;
+};
+
+/// A detector which records the audio it is given, and fails after a number of chunks.
+class FakeDetector : public AbstractKeywordDetector {
+public:
+    /**
+     * Constructor.
+     *
+     * @param chunksBeforeFailure The number of chunks to accept before failing, or zero to never fail.
+     */
+    FakeDetector(size_t chunksBeforeFailure = 0) :
+            AbstractKeywordDetector(
+                std::unordered_set<std::shared_ptr<KeyWordObserverInterface>>(),
+                {std::make_shared<TestStateObserver>()}),
+            m_chunksBeforeFailure{chunksBeforeFailure},
+            m_numChunks{0},
+            m_nextIndex{0} {
+    }
+
+    /**
+     * Waits for a number of samples to have been given to the detector.
+     *
+     * @param numSamples The number of samples.
+     * @return @c true if the samples were given before the timeout and @c false otherwise.
+     */
+    bool waitForSamples(size_t numSamples) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, numSamples]() { return m_samples.size() >= numSamples; });
+    }
+
+    /// @return The samples given to the detector.
+    std::vector<int16_t> getSamples() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_samples;
+    }
+
+    /// @return The sizes of the chunks accepted by the detector.
+    std::vector<size_t> getChunkSizes() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_chunkSizes;
+    }
+
+    /// @return Whether every chunk began where the previous one ended.
+    bool areIndicesContiguous() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_areIndicesContiguous;
+    }
+
+protected:
+    bool doProcessAudio(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_areIndicesContiguous = m_areIndicesContiguous && beginIndex == m_nextIndex;
+        m_nextIndex = beginIndex + numSamples;
+        if (m_chunksBeforeFailure && ++m_numChunks > m_chunksBeforeFailure) {
+            return false;
+        }
+        m_samples.insert(m_samples.end(), samples, samples + numSamples);
+        m_chunkSizes.push_back(numSamples);
+        m_wakeTrigger.notify_all();
+        return true;
+    }
+
+private:
+    /// The number of chunks to accept before failing, or zero to never fail.
+    const size_t m_chunksBeforeFailure;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when samples are given to the detector.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of chunks given to the detector.
+    size_t m_numChunks;
+
+    /// The samples given to the detector.
+    std::vector<int16_t> m_samples;
+
+    /// The sizes of the chunks accepted by the detector.
+    std::vector<size_t> m_chunkSizes;
+
+    /// The index expected for the next chunk.
+    AudioInputStream::Index m_nextIndex;
+
+    /// Whether every chunk began where the previous one ended.
+    bool m_areIndicesContiguous = true;
+};
+
+/// A detector which stalls on its first chunk until it is resumed, as if it had been descheduled.
+class StallingDetector : public FakeDetector {
+public:
+    /**
+     * Waits for the detector to stall.
+     *
+     * @return @c true if the detector stalled before the timeout and @c false otherwise.
+     */
+    bool waitForStall() {
+        std::unique_lock<std::mutex> lock(m_stallMutex);
+        return m_stallTrigger.wait_for(lock, TIMEOUT, [this]() { return m_isStalled; });
+    }
+
+    /// Lets the detector process its first chunk.
+    void resume() {
+        std::lock_guard<std::mutex> lock(m_stallMutex);
+        m_isResumed = true;
+        m_stallTrigger.notify_all();
+    }
+
+protected:
+    bool doProcessAudio(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) override {
+        {
+            std::unique_lock<std::mutex> lock(m_stallMutex);
+            m_isStalled = true;
+            m_stallTrigger.notify_all();
+            m_stallTrigger.wait_for(lock, TIMEOUT, [this]() { return m_isResumed; });
+        }
+        return FakeDetector::doProcessAudio(samples, numSamples, beginIndex);
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_stallMutex;
+
+    /// Notified when the detector stalls or is resumed.
+    std::condition_variable m_stallTrigger;
+
+    /// Whether the detector has stalled.
+    bool m_isStalled = false;
+
+    /// Whether the detector has been resumed.
+    bool m_isResumed = false;
+};
+
+class KeywordDetectorHubTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int16_t), 1);
+        m_stream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+        ASSERT_TRUE(m_stream);
+        m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+        ASSERT_TRUE(m_writer);
+        m_format = {AudioFormat::Encoding::LPCM, AudioFormat::Endianness::LITTLE, 16000, 16, 1};
+        for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+            m_samples.push_back(static_cast<int16_t>(i * 7));
+        }
+    }
+
+    /// The stream the hub reads.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The writer of @c m_stream.
+    std::unique_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The format of @c m_stream.
+    AudioFormat m_format;
+
+    /// The samples written by the tests.
+    std::vector<int16_t> m_samples;
+};
+
+/**
+ * Verify that the hub rejects invalid arguments.
+ */
+TEST_F(KeywordDetectorHubTest, createFailures) {
+    auto detector = std::make_shared<FakeDetector>();
+    EXPECT_FALSE(KeywordDetectorHub::create(nullptr, m_format, {detector}));
+    EXPECT_FALSE(KeywordDetectorHub::create(m_stream, m_format, {}));
+    EXPECT_FALSE(KeywordDetectorHub::create(m_stream, m_format, {detector, nullptr}));
+    auto format = m_format;
+    format.sampleSizeInBits = 32;
+    EXPECT_FALSE(KeywordDetectorHub::create(m_stream, format, {detector}));
+    format = m_format;
+    format.encoding = AudioFormat::Encoding::OPUS;
+    EXPECT_FALSE(KeywordDetectorHub::create(m_stream, format, {detector}));
+    EXPECT_FALSE(KeywordDetectorHub::create(m_stream, m_format, {detector}, std::chrono::milliseconds(0)));
+}
+
+/**
+ * Verify that every detector is given all of the audio once, with the indices it has in the stream.
+ */
+TEST_F(KeywordDetectorHubTest, sharesAudioAmongDetectors) {
+    std::vector<std::shared_ptr<FakeDetector>> detectors;
+    for (int i = 0; i < 3; ++i) {
+        detectors.push_back(std::make_shared<FakeDetector>());
+    }
+    auto hub = KeywordDetectorHub::create(m_stream, m_format, {detectors.begin(), detectors.end()}, MS_PER_PUSH);
+    ASSERT_TRUE(hub);
+    ASSERT_EQ(m_writer->write(m_samples.data(), m_samples.size()), static_cast<ssize_t>(NUM_SAMPLES));
+    for (auto& detector : detectors) {
+        ASSERT_TRUE(detector->waitForSamples(NUM_SAMPLES));
+    }
+    EXPECT_EQ(hub->getReadStats().numOverruns, 0u);
+    hub.reset();
+    for (auto& detector : detectors) {
+        EXPECT_EQ(detector->getSamples(), m_samples);
+        EXPECT_TRUE(detector->areIndicesContiguous());
+        EXPECT_EQ(detector->getCpuUsage().numSamples, NUM_SAMPLES);
+    }
+}
+
+/**
+ * Verify that a hub with a catch-up limit reads the backlog in larger chunks after the detectors fall behind.
+ */
+TEST_F(KeywordDetectorHubTest, catchesUpOnBacklog) {
+    auto detector = std::make_shared<StallingDetector>();
+    auto hub = KeywordDetectorHub::create(m_stream, m_format, {detector}, MS_PER_PUSH, std::chrono::milliseconds(100));
+    ASSERT_TRUE(hub);
+    ASSERT_EQ(m_writer->write(m_samples.data(), 1), 1);
+    ASSERT_TRUE(detector->waitForStall());
+    // While the detector is stalled on the first sample, a backlog builds up.
+    ASSERT_EQ(m_writer->write(m_samples.data() + 1, NUM_SAMPLES - 1), static_cast<ssize_t>(NUM_SAMPLES - 1));
+    detector->resume();
+    ASSERT_TRUE(detector->waitForSamples(NUM_SAMPLES));
+    EXPECT_EQ(hub->getReadStats().maxBacklog, NUM_SAMPLES - 1);
+    hub.reset();
+    EXPECT_EQ(detector->getSamples(), m_samples);
+    EXPECT_EQ(detector->getChunkSizes(), std::vector<size_t>({1, NUM_SAMPLES - 1}));
+}
+
+/**
+ * Verify that a detector which fails is not given more audio, while the others still are.
+ */
+TEST_F(KeywordDetectorHubTest, failedDetectorIsDropped) {
+    auto failing = std::make_shared<FakeDetector>(1);
+    auto working = std::make_shared<FakeDetector>();
+    auto hub = KeywordDetectorHub::create(m_stream, m_format, {failing, working}, MS_PER_PUSH);
+    ASSERT_TRUE(hub);
+    ASSERT_EQ(m_writer->write(m_samples.data(), m_samples.size()), static_cast<ssize_t>(NUM_SAMPLES));
+    ASSERT_TRUE(working->waitForSamples(NUM_SAMPLES));
+    hub.reset();
+    EXPECT_EQ(working->getSamples(), m_samples);
+    size_t samplesPerPush = m_format.sampleRateHz / 1000 * MS_PER_PUSH.count();
+    EXPECT_EQ(failing->getSamples().size(), samplesPerPush);
+    // The chunk it failed on was processed, but no more.
+    EXPECT_EQ(failing->getCpuUsage().numSamples, 2 * samplesPerPush);
+}
+
+/**
+ * Verify that the state observers of the detectors are notified when the stream closes.
+ */
+TEST_F(KeywordDetectorHubTest, streamClosedIsNotified) {
+    auto detector = std::make_shared<FakeDetector>();
+    auto observer = std::make_shared<TestStateObserver>();
+    detector->addKeyWordDetectorStateObserver(observer);
+    auto hub = KeywordDetectorHub::create(m_stream, m_format, {detector}, MS_PER_PUSH);
+    ASSERT_TRUE(hub);
+    ASSERT_TRUE(observer->waitForState(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE));
+    m_writer->write(m_samples.data(), m_samples.size());
+    m_writer->close();
+    EXPECT_TRUE(observer->waitForState(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED));
+    EXPECT_EQ(detector->getSamples(), m_samples);
+}
+
+/**
+ * Verify that a detector which can only read the stream itself refuses audio passed to it, and that the audio is
+ * still accounted for.
+ */
+TEST_F(KeywordDetectorHubTest, defaultDetectorRefusesAudio) {
+    class StandaloneDetector : public AbstractKeywordDetector {};
+    StandaloneDetector detector;
+    EXPECT_FALSE(detector.processAudio(m_samples.data(), m_samples.size(), 0));
+    EXPECT_EQ(detector.getCpuUsage().numSamples, NUM_SAMPLES);
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,281 @@
+/*
+ * MultiBeamKeywordDetectorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+
+#include "KWD/MultiBeamKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The number of 16-bit words in the buffer of each beam.
+static const size_t BUFFER_WORDS = 16000;
+
+/// The number of samples written to each beam by the tests, which is ten chunks.
+static const size_t NUM_SAMPLES = 3200;
+
+/// The index of the sample at which the fake engines detect the keyword.
+static const AudioInputStream::Index KEYWORD_END_INDEX = 640;
+
+/// The amount of audio to pass to the engines at a time, which is 320 samples at 16 kHz.
+static const std::chrono::milliseconds MS_PER_PUSH = std::chrono::milliseconds(20);
+
+/// The decision window used by the tests, which ends well before the audio written does.
+static const std::chrono::milliseconds DECISION_WINDOW = std::chrono::milliseconds(60);
+
+/// The keyword the fake engines detect.
+static const std::string KEYWORD = "ALEXA";
+
+/// How long to wait for the engines to be given the audio.
+static const std::chrono::seconds TIMEOUT = std::chrono::seconds(5);
+
+/// An engine which detects the keyword when it is given the sample at @c KEYWORD_END_INDEX.
+class FakeBeamDetector : public AbstractKeywordDetector {
+public:
+    /**
+     * Constructor.
+     *
+     * @param stream The stream of the beam, which detections are reported against.
+     * @param confidence The confidence to report, or a negative value to report none.
+     */
+    FakeBeamDetector(std::shared_ptr<AudioInputStream> stream, double confidence = -1.0) :
+            m_stream{stream},
+            m_confidence{confidence} {
+    }
+
+    double getDetectionConfidence() const override {
+        return m_confidence;
+    }
+
+    /**
+     * Waits for a number of samples to have been given to the engine.
+     *
+     * @param numSamples The number of samples.
+     * @return @c true if the samples were given before the timeout and @c false otherwise.
+     */
+    bool waitForSamples(size_t numSamples) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this, numSamples]() { return m_numSamples >= numSamples; });
+    }
+
+protected:
+    bool doProcessAudio(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) override {
+        if (beginIndex < KEYWORD_END_INDEX && KEYWORD_END_INDEX <= beginIndex + numSamples) {
+            notifyKeyWordObservers(m_stream, KEYWORD, KeyWordObserverInterface::UNSPECIFIED_INDEX, KEYWORD_END_INDEX);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_numSamples += numSamples;
+        m_wakeTrigger.notify_all();
+        return true;
+    }
+
+private:
+    /// The stream of the beam.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The confidence to report.
+    double m_confidence;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when samples are given to the engine.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of samples given to the engine.
+    size_t m_numSamples = 0;
+};
+
+/// An observer which records the detections it is notified of.
+class TestKeyWordObserver : public KeyWordObserverInterface {
+public:
+    /// A detection.
+    struct Detection {
+        /// The stream the keyword was detected in.
+        std::shared_ptr<AudioInputStream> stream;
+
+        /// The keyword.
+        std::string keyword;
+
+        /// The end index of the keyword.
+        AudioInputStream::Index endIndex;
+    };
+
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_detections.push_back({stream, keyword, endIndex});
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Waits for a detection.
+     *
+     * @return @c true if a detection was notified before the timeout and @c false otherwise.
+     */
+    bool waitForDetection() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeTrigger.wait_for(lock, TIMEOUT, [this]() { return !m_detections.empty(); });
+    }
+
+    /// @return The detections notified.
+    std::vector<Detection> getDetections() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_detections;
+    }
+
+private:
+    /// Serializes access to @c m_detections.
+    std::mutex m_mutex;
+
+    /// Notified when a detection is notified.
+    std::condition_variable m_wakeTrigger;
+
+    /// The detections notified.
+    std::vector<Detection> m_detections;
+};
+
+class MultiBeamKeywordDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_format = {AudioFormat::Encoding::LPCM, AudioFormat::Endianness::LITTLE, 16000, 16, 1};
+        m_observer = std::make_shared<TestKeyWordObserver>();
+    }
+
+    /**
+     * Adds a beam.
+     *
+     * @param amplitude The amplitude of the audio the beam is written with.
+     * @param confidence The confidence the engine of the beam reports, or a negative value to report none.
+     */
+    void addBeam(int16_t amplitude, double confidence = -1.0) {
+        auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int16_t), 1);
+        std::shared_ptr<AudioInputStream> stream =
+            AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+        ASSERT_TRUE(stream);
+        m_writers.push_back(stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE));
+        m_amplitudes.push_back(amplitude);
+        m_detectors.push_back(std::make_shared<FakeBeamDetector>(stream, confidence));
+        m_beams.push_back({stream, m_detectors.back()});
+    }
+
+    /// Writes @c NUM_SAMPLES to each beam, alternating in sign with the amplitude of the beam.
+    void writeBeams() {
+        for (size_t i = 0; i < m_writers.size(); ++i) {
+            std::vector<int16_t> samples(NUM_SAMPLES);
+            for (size_t j = 0; j < NUM_SAMPLES; ++j) {
+                samples[j] = j % 2 ? m_amplitudes[i] : -m_amplitudes[i];
+            }
+            ASSERT_EQ(m_writers[i]->write(samples.data(), samples.size()), static_cast<ssize_t>(NUM_SAMPLES));
+        }
+    }
+
+    /// The format of the beams.
+    AudioFormat m_format;
+
+    /// The beams.
+    std::vector<MultiBeamKeywordDetector::Beam> m_beams;
+
+    /// The engines of @c m_beams.
+    std::vector<std::shared_ptr<FakeBeamDetector>> m_detectors;
+
+    /// The writers of the streams of @c m_beams.
+    std::vector<std::unique_ptr<AudioInputStream::Writer>> m_writers;
+
+    /// The amplitudes the beams are written with.
+    std::vector<int16_t> m_amplitudes;
+
+    /// The observer of the @c MultiBeamKeywordDetector.
+    std::shared_ptr<TestKeyWordObserver> m_observer;
+};
+
+/**
+ * Verify that invalid arguments are rejected.
+ */
+TEST_F(MultiBeamKeywordDetectorTest, createFailures) {
+    addBeam(1);
+    EXPECT_FALSE(MultiBeamKeywordDetector::create({}, m_format, {m_observer}));
+    EXPECT_FALSE(MultiBeamKeywordDetector::create({{nullptr, m_detectors[0]}}, m_format, {m_observer}));
+    EXPECT_FALSE(MultiBeamKeywordDetector::create({{m_beams[0].stream, nullptr}}, m_format, {m_observer}));
+    auto format = m_format;
+    format.sampleSizeInBits = 32;
+    EXPECT_FALSE(MultiBeamKeywordDetector::create(m_beams, format, {m_observer}));
+    EXPECT_FALSE(MultiBeamKeywordDetector::create(m_beams, m_format, {m_observer}, 0, std::chrono::milliseconds(0)));
+}
+
+/**
+ * Verify that a keyword heard by every beam is notified once, against the loudest beam, and that every engine is
+ * given all of its audio with fewer worker threads than beams.
+ */
+TEST_F(MultiBeamKeywordDetectorTest, notifiesLoudestBeamOnce) {
+    addBeam(100);
+    addBeam(3000);
+    addBeam(1000);
+    addBeam(10);
+    auto detector = MultiBeamKeywordDetector::create(m_beams, m_format, {m_observer}, 1, MS_PER_PUSH, DECISION_WINDOW);
+    ASSERT_TRUE(detector);
+    writeBeams();
+    for (auto& engine : m_detectors) {
+        ASSERT_TRUE(engine->waitForSamples(NUM_SAMPLES));
+    }
+    ASSERT_TRUE(m_observer->waitForDetection());
+    detector.reset();
+
+    auto detections = m_observer->getDetections();
+    ASSERT_EQ(detections.size(), 1u);
+    EXPECT_EQ(detections[0].stream, m_beams[1].stream);
+    EXPECT_EQ(detections[0].keyword, KEYWORD);
+    EXPECT_EQ(detections[0].endIndex, KEYWORD_END_INDEX);
+}
+
+/**
+ * Verify that the confidence an engine reports is preferred to the energy of its beam.
+ */
+TEST_F(MultiBeamKeywordDetectorTest, prefersReportedConfidence) {
+    addBeam(3000, 0.2);
+    addBeam(100, 0.9);
+    addBeam(1000, 0.5);
+    auto detector = MultiBeamKeywordDetector::create(m_beams, m_format, {m_observer}, 0, MS_PER_PUSH, DECISION_WINDOW);
+    ASSERT_TRUE(detector);
+    writeBeams();
+    ASSERT_TRUE(m_observer->waitForDetection());
+    detector.reset();
+
+    auto detections = m_observer->getDetections();
+    ASSERT_EQ(detections.size(), 1u);
+    EXPECT_EQ(detections[0].stream, m_beams[1].stream);
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,173 @@
+/*
+ * OffloadedKeywordDetectorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+
+#include "KWD/OffloadedKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+using ::testing::SaveArg;
+
+/// The number of 16-bit words in the buffer of the stream.
+static const size_t BUFFER_WORDS = 16000;
+
+/// The keyword the backend detects.
+static const std::string KEYWORD = "ALEXA";
+
+/// A mock backend.
+class MockBackend : public KeywordOffloadBackendInterface {
+public:
+    MOCK_METHOD2(
+        start,
+        bool(std::shared_ptr<AudioInputStream> stream, std::shared_ptr<ObserverInterface> observer));
+    MOCK_METHOD0(stop, void());
+};
+
+/// A mock keyword observer.
+class MockKeyWordObserver : public KeyWordObserverInterface {
+public:
+    MOCK_METHOD4(
+        onKeyWordDetected,
+        void(
+            std::shared_ptr<AudioInputStream> stream,
+            std::string keyword,
+            AudioInputStream::Index beginIndex,
+            AudioInputStream::Index endIndex));
+};
+
+/// A mock state observer.
+class MockStateObserver : public KeyWordDetectorStateObserverInterface {
+public:
+    MOCK_METHOD1(
+        onStateChanged,
+        void(KeyWordDetectorStateObserverInterface::KeyWordDetectorState keyWordDetectorState));
+};
+
+class OffloadedKeywordDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto bufferSize = AudioInputStream::calculateBufferSize(BUFFER_WORDS, sizeof(int16_t), 1);
+        m_stream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+        ASSERT_TRUE(m_stream);
+        m_backend = std::make_shared<MockBackend>();
+        m_keyWordObserver = std::make_shared<MockKeyWordObserver>();
+        m_stateObserver = std::make_shared<MockStateObserver>();
+    }
+
+    /**
+     * Creates a detector whose backend starts, and keeps the observer it registers with the backend.
+     *
+     * @return The detector.
+     */
+    std::unique_ptr<OffloadedKeywordDetector> createDetector() {
+        EXPECT_CALL(*m_backend, start(m_stream, _)).WillOnce(DoAll(SaveArg<1>(&m_backendObserver), Return(true)));
+        EXPECT_CALL(
+            *m_stateObserver, onStateChanged(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE));
+        return OffloadedKeywordDetector::create(m_stream, m_backend, {m_keyWordObserver}, {m_stateObserver});
+    }
+
+    /// The stream the backend writes to.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The backend.
+    std::shared_ptr<MockBackend> m_backend;
+
+    /// The observer the detector registered with @c m_backend.
+    std::shared_ptr<KeywordOffloadBackendInterface::ObserverInterface> m_backendObserver;
+
+    /// The keyword observer of the detector.
+    std::shared_ptr<MockKeyWordObserver> m_keyWordObserver;
+
+    /// The state observer of the detector.
+    std::shared_ptr<MockStateObserver> m_stateObserver;
+};
+
+/**
+ * Verify that invalid arguments are rejected, and that a backend which fails to start is stopped again.
+ */
+TEST_F(OffloadedKeywordDetectorTest, createFailures) {
+    EXPECT_FALSE(OffloadedKeywordDetector::create(nullptr, m_backend, {m_keyWordObserver}, {m_stateObserver}));
+    EXPECT_FALSE(OffloadedKeywordDetector::create(m_stream, nullptr, {m_keyWordObserver}, {m_stateObserver}));
+
+    EXPECT_CALL(*m_backend, start(m_stream, _)).WillOnce(Return(false));
+    EXPECT_CALL(*m_backend, stop());
+    EXPECT_CALL(*m_stateObserver, onStateChanged(_)).Times(0);
+    EXPECT_FALSE(OffloadedKeywordDetector::create(m_stream, m_backend, {m_keyWordObserver}, {m_stateObserver}));
+}
+
+/**
+ * Verify that the detections of the backend reach the keyword observers against the stream, and that the backend is
+ * stopped when the detector is destroyed.
+ */
+TEST_F(OffloadedKeywordDetectorTest, passesDetectionsOn) {
+    auto detector = createDetector();
+    ASSERT_TRUE(detector);
+    ASSERT_TRUE(m_backendObserver);
+
+    EXPECT_CALL(*m_keyWordObserver, onKeyWordDetected(m_stream, KEYWORD, 100, 8100));
+    m_backendObserver->onKeyWordDetected(KEYWORD, 100, 8100);
+    EXPECT_CALL(
+        *m_keyWordObserver,
+        onKeyWordDetected(m_stream, KEYWORD, KeyWordObserverInterface::UNSPECIFIED_INDEX, 8100));
+    m_backendObserver->onKeyWordDetected(KEYWORD, KeyWordObserverInterface::UNSPECIFIED_INDEX, 8100);
+
+    EXPECT_CALL(*m_backend, stop());
+    detector.reset();
+}
+
+/**
+ * Verify that a detection whose keyword ends before it begins is dropped.
+ */
+TEST_F(OffloadedKeywordDetectorTest, dropsInvalidDetections) {
+    auto detector = createDetector();
+    ASSERT_TRUE(detector);
+    ASSERT_TRUE(m_backendObserver);
+
+    EXPECT_CALL(*m_keyWordObserver, onKeyWordDetected(_, _, _, _)).Times(0);
+    m_backendObserver->onKeyWordDetected(KEYWORD, 8100, 100);
+    EXPECT_CALL(*m_backend, stop());
+}
+
+/**
+ * Verify that a failure of the backend is reported to the state observers.
+ */
+TEST_F(OffloadedKeywordDetectorTest, reportsBackendFailure) {
+    auto detector = createDetector();
+    ASSERT_TRUE(detector);
+    ASSERT_TRUE(m_backendObserver);
+
+    EXPECT_CALL(*m_stateObserver, onStateChanged(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR));
+    m_backendObserver->onBackendFailed();
+    EXPECT_CALL(*m_backend, stop());
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
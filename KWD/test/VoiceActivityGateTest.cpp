@@ -0,0 +1,213 @@
+/*
+ * VoiceActivityGateTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "KWD/AbstractKeywordDetector.h"
+#include "KWD/VoiceActivityGate.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+
+/// The sample rate of the tests.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of samples in a 10 ms chunk.
+static const size_t CHUNK_SAMPLES = 160;
+
+/// The settings of the gate: open at 1000, quiet below 500, close after 30 ms and keep 25 ms of pre-roll.
+static const VoiceActivityGate::Config CONFIG = {1000,
+                                                 500,
+                                                 std::chrono::milliseconds(30),
+                                                 std::chrono::milliseconds(25)};
+
+/**
+ * Makes a chunk with a constant amplitude of alternating sign, whose RMS amplitude is that amplitude.
+ *
+ * @param amplitude The amplitude.
+ * @param numSamples The number of samples.
+ * @return The chunk.
+ */
+static std::vector<int16_t> makeChunk(int16_t amplitude, size_t numSamples = CHUNK_SAMPLES) {
+    std::vector<int16_t> chunk(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        chunk[i] = i % 2 ? amplitude : -amplitude;
+    }
+    return chunk;
+}
+
+/// A detector which records the chunks it is given.
+class RecordingDetector : public AbstractKeywordDetector {
+public:
+    /// The index and size of each chunk given to the engine.
+    std::vector<std::pair<AudioInputStream::Index, size_t>> chunks;
+
+protected:
+    bool doProcessAudio(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) override {
+        chunks.push_back({beginIndex, numSamples});
+        return true;
+    }
+};
+
+/**
+ * Verify that invalid settings are rejected.
+ */
+TEST(VoiceActivityGateTest, createFailures) {
+    EXPECT_FALSE(VoiceActivityGate::create(0, CONFIG));
+    auto config = CONFIG;
+    config.closeThreshold = config.openThreshold + 1;
+    EXPECT_FALSE(VoiceActivityGate::create(SAMPLE_RATE_HZ, config));
+    config = CONFIG;
+    config.preRoll = std::chrono::milliseconds(-1);
+    EXPECT_FALSE(VoiceActivityGate::create(SAMPLE_RATE_HZ, config));
+    EXPECT_TRUE(VoiceActivityGate::create(SAMPLE_RATE_HZ));
+}
+
+/**
+ * Verify that the gate opens on loud audio, stays open through less than the hangover of quiet audio, and closes
+ * after it.
+ */
+TEST(VoiceActivityGateTest, hysteresisAndHangover) {
+    auto gate = VoiceActivityGate::create(SAMPLE_RATE_HZ, CONFIG);
+    ASSERT_TRUE(gate);
+    AudioInputStream::Index index = 0;
+    auto process = [&](int16_t amplitude) {
+        auto chunk = makeChunk(amplitude);
+        bool result = gate->process(chunk.data(), chunk.size(), index);
+        index += chunk.size();
+        return result;
+    };
+
+    EXPECT_FALSE(process(900));
+    EXPECT_FALSE(gate->isOpen());
+    EXPECT_TRUE(process(1000));
+    EXPECT_TRUE(gate->isOpen());
+
+    // Between the thresholds is not quiet.
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(process(700));
+    }
+    EXPECT_TRUE(gate->isOpen());
+
+    // Loud audio restarts the hangover.
+    EXPECT_TRUE(process(100));
+    EXPECT_TRUE(process(100));
+    EXPECT_TRUE(process(2000));
+    EXPECT_TRUE(process(100));
+    EXPECT_TRUE(process(100));
+    EXPECT_TRUE(gate->isOpen());
+
+    // The chunk which ends the hangover is still passed on.
+    EXPECT_TRUE(process(100));
+    EXPECT_FALSE(gate->isOpen());
+    EXPECT_FALSE(process(100));
+
+    gate->reset();
+    EXPECT_FALSE(gate->isOpen());
+}
+
+/**
+ * Verify that the pre-roll holds the audio just before the chunk which opened the gate.
+ */
+TEST(VoiceActivityGateTest, preRoll) {
+    auto gate = VoiceActivityGate::create(SAMPLE_RATE_HZ, CONFIG);
+    ASSERT_TRUE(gate);
+    std::vector<int16_t> quiet(5 * CHUNK_SAMPLES);
+    for (size_t i = 0; i < quiet.size(); ++i) {
+        quiet[i] = static_cast<int16_t>(i % 100);
+    }
+    // Chunks of uneven sizes wrap around the ring.
+    AudioInputStream::Index index = 1000;
+    for (size_t offset = 0; offset < quiet.size();) {
+        size_t count = std::min<size_t>(70, quiet.size() - offset);
+        ASSERT_FALSE(gate->process(quiet.data() + offset, count, index + offset));
+        offset += count;
+    }
+    auto loud = makeChunk(5000);
+    ASSERT_TRUE(gate->process(loud.data(), loud.size(), index + quiet.size()));
+
+    std::vector<int16_t> preRoll;
+    AudioInputStream::Index preRollIndex = 0;
+    gate->takePreRoll(&preRoll, &preRollIndex);
+    size_t preRollSamples = SAMPLE_RATE_HZ * 25 / 1000;
+    ASSERT_EQ(preRoll.size(), preRollSamples);
+    EXPECT_EQ(preRollIndex, index + quiet.size() - preRollSamples);
+    EXPECT_EQ(preRoll, std::vector<int16_t>(quiet.end() - preRollSamples, quiet.end()));
+
+    // The pre-roll is only given once.
+    gate->takePreRoll(&preRoll, &preRollIndex);
+    EXPECT_TRUE(preRoll.empty());
+}
+
+/**
+ * Verify that the pre-roll is dropped if audio was skipped just before the gate opened.
+ */
+TEST(VoiceActivityGateTest, preRollDroppedAfterGap) {
+    auto gate = VoiceActivityGate::create(SAMPLE_RATE_HZ, CONFIG);
+    ASSERT_TRUE(gate);
+    auto quiet = makeChunk(10);
+    ASSERT_FALSE(gate->process(quiet.data(), quiet.size(), 0));
+    auto loud = makeChunk(5000);
+    ASSERT_TRUE(gate->process(loud.data(), loud.size(), 10 * CHUNK_SAMPLES));
+    std::vector<int16_t> preRoll;
+    AudioInputStream::Index preRollIndex = 0;
+    gate->takePreRoll(&preRoll, &preRollIndex);
+    EXPECT_TRUE(preRoll.empty());
+}
+
+/**
+ * Verify that a detector with a gate only runs its engine while the gate is open, catching up on the pre-roll first.
+ */
+TEST(VoiceActivityGateTest, detectorRunsOnlyWhileOpen) {
+    RecordingDetector detector;
+    detector.setVoiceActivityGate(VoiceActivityGate::create(SAMPLE_RATE_HZ, CONFIG));
+    AudioInputStream::Index index = 0;
+    auto process = [&](int16_t amplitude) {
+        auto chunk = makeChunk(amplitude);
+        EXPECT_TRUE(detector.processAudio(chunk.data(), chunk.size(), index));
+        index += chunk.size();
+    };
+    for (int i = 0; i < 10; ++i) {
+        process(10);
+    }
+    EXPECT_TRUE(detector.chunks.empty());
+
+    process(5000);
+    size_t preRollSamples = SAMPLE_RATE_HZ * 25 / 1000;
+    ASSERT_EQ(detector.chunks.size(), 2u);
+    EXPECT_EQ(detector.chunks[0].first, 10 * CHUNK_SAMPLES - preRollSamples);
+    EXPECT_EQ(detector.chunks[0].second, preRollSamples);
+    EXPECT_EQ(detector.chunks[1].first, 10 * CHUNK_SAMPLES);
+    EXPECT_EQ(detector.chunks[1].second, CHUNK_SAMPLES);
+
+    // All of the audio is accounted for, whether or not the engine ran.
+    EXPECT_EQ(detector.getCpuUsage().numSamples, 11 * CHUNK_SAMPLES);
+
+    // Without the gate, every chunk is processed.
+    detector.setVoiceActivityGate(nullptr);
+    process(10);
+    EXPECT_EQ(detector.chunks.size(), 3u);
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
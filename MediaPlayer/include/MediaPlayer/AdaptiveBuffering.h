@@ -0,0 +1,118 @@
+/*
+ * AdaptiveBuffering.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_ADAPTIVE_BUFFERING_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_ADAPTIVE_BUFFERING_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * Decides how much of a url stream the decoder buffers before playing, and grows it when the stream keeps running dry.
+ *
+ * The buffer starts with the configured size and duration, which are applied to the @c uridecodebin of url sources
+ * and from there to its @c queue2.  After a number of buffer underruns in a row, both are doubled, up to their
+ * maximums, so that a player on a flaky network rebuffers less often at the cost of a longer wait each time.  The
+ * grown buffer is kept for the following streams, since the network usually stays as it is.
+ *
+ * This class is not thread-safe; it is used from the main loop of the player.
+ */
+class AdaptiveBuffering {
+public:
+    /**
+     * Create an @c AdaptiveBuffering.
+     *
+     * @param bufferSizeBytes The initial size of the buffer, or 0 to start from the default of GStreamer.
+     * @param bufferDuration The initial duration of the buffer, or 0 to start from the default of GStreamer.
+     * @param maxBufferSizeBytes The size the buffer may grow to.
+     * @param maxBufferDuration The duration the buffer may grow to.
+     * @param underrunsBeforeGrowth The number of underruns after which the buffer grows, or 0 to never grow it.
+     * @return The new @c AdaptiveBuffering, or @c nullptr if a parameter is negative or an initial value exceeds its
+     * maximum.
+     */
+    static std::unique_ptr<AdaptiveBuffering> create(
+        int64_t bufferSizeBytes,
+        std::chrono::milliseconds bufferDuration,
+        int64_t maxBufferSizeBytes,
+        std::chrono::milliseconds maxBufferDuration,
+        int underrunsBeforeGrowth);
+
+    /**
+     * Get the size of the buffer.
+     *
+     * @return The size of the buffer, or 0 if the default of GStreamer is used.
+     */
+    int64_t getBufferSizeBytes() const;
+
+    /**
+     * Get the duration of the buffer.
+     *
+     * @return The duration of the buffer, or 0 if the default of GStreamer is used.
+     */
+    std::chrono::milliseconds getBufferDuration() const;
+
+    /**
+     * Count a buffer underrun, growing the buffer if there were enough of them.
+     *
+     * @return Whether the buffer grew, in which case its new size and duration should be applied.
+     */
+    bool onBufferUnderrun();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param bufferSizeBytes The initial size of the buffer.
+     * @param bufferDuration The initial duration of the buffer.
+     * @param maxBufferSizeBytes The size the buffer may grow to.
+     * @param maxBufferDuration The duration the buffer may grow to.
+     * @param underrunsBeforeGrowth The number of underruns after which the buffer grows.
+     */
+    AdaptiveBuffering(
+        int64_t bufferSizeBytes,
+        std::chrono::milliseconds bufferDuration,
+        int64_t maxBufferSizeBytes,
+        std::chrono::milliseconds maxBufferDuration,
+        int underrunsBeforeGrowth);
+
+    /// The size of the buffer, or 0 for the default of GStreamer.
+    int64_t m_bufferSizeBytes;
+
+    /// The duration of the buffer, or 0 for the default of GStreamer.
+    std::chrono::milliseconds m_bufferDuration;
+
+    /// The size the buffer may grow to.
+    const int64_t m_maxBufferSizeBytes;
+
+    /// The duration the buffer may grow to.
+    const std::chrono::milliseconds m_maxBufferDuration;
+
+    /// The number of underruns after which the buffer grows, or 0 to never grow it.
+    const int m_underrunsBeforeGrowth;
+
+    /// The number of underruns since the buffer last grew.
+    int m_underruns;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_ADAPTIVE_BUFFERING_H_
@@ -18,12 +18,16 @@
 #ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_ATTACHMENT_READER_SOURCE_H_
 #define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_ATTACHMENT_READER_SOURCE_H_
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <gst/gst.h>
 #include <gst/app/gstappsrc.h>
 
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
+#include <AVSCommon/Utils/Metrics/MemoryAccounting.h>
 
 #include "MediaPlayer/BaseStreamSource.h"
 
@@ -32,17 +36,33 @@ namespace mediaPlayer {
 
 class AttachmentReaderSource : public BaseStreamSource {
 public:
+    /// How data is moved from the attachment into the appsrc element.
+    enum class FeedMode {
+        /// Data is read from the main loop, retrying on a back-off schedule while the attachment has none.
+        POLL,
+
+        /**
+         * Data is read on a thread of its own, which waits on the attachment and pushes each chunk into the appsrc
+         * element as soon as the writer delivers it.  Intended for @c BLOCKING readers.
+         */
+        PUSH
+    };
+
     /**
      * Creates an instance of the @c AttachmentReaderSource and installs the source within the GStreamer pipeline.
      *
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param attachmentReader The @c AttachmentReader from which to create the pipeline source from.
+     * @param chunkSize The number of bytes to read from the attachment at once.
+     * @param feedMode How data is moved from the attachment into the pipeline.
      *
      * @return An instance of the @c AttachmentReaderSource if successful else a @c nullptr.
      */
     static std::unique_ptr<AttachmentReaderSource> create(
         PipelineInterface* pipeline,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        size_t chunkSize = DEFAULT_CHUNK_SIZE,
+        FeedMode feedMode = FeedMode::POLL);
 
     ~AttachmentReaderSource();
 
@@ -57,22 +77,71 @@ private:
      *
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param attachmentReader The @c AttachmentReader from which to create the pipeline source from.
+     * @param chunkSize The number of bytes to read from the attachment at once.
+     * @param feedMode How data is moved from the attachment into the pipeline.
      */
     AttachmentReaderSource(
         PipelineInterface* pipeline,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        size_t chunkSize,
+        FeedMode feedMode);
 
     /// @name Overridden BaseStreamSource methods.
     /// @{
     bool isOpen() override;
     void close() override;
     gboolean handleReadData() override;
-    void terminate() override{};
+    void startFeeding() override;
+    void stopFeeding() override;
+    /// @}
+
+    /// @name Overridden SourceInterface methods.
+    /// @{
+    void terminate() override;
     /// @}
 
+    /**
+     * The main loop of @c m_feedThread in @c FeedMode::PUSH.
+     */
+    void feedLoop();
+
+    /**
+     * Read a chunk from the attachment, waiting for it if need be, and push it into the appsrc element.  Called on
+     * @c m_feedThread.
+     *
+     * @return @c false if there is an error or end of data from the attachment, else @c true.
+     */
+    bool feedChunk();
+
+    /**
+     * Count the bytes queued in the appsrc element in @c MemoryAccounting.  Called after each chunk is pushed.
+     */
+    void updateMemoryAccounting();
+
 private:
     /// The @c AttachmentReader to read audioData from.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
+
+    /// How data is moved from the attachment into the pipeline.
+    const FeedMode m_feedMode;
+
+    /// Serializes access to @c m_isFeeding and @c m_isShuttingDown.
+    std::mutex m_feedMutex;
+
+    /// Notified when @c m_isFeeding or @c m_isShuttingDown change.
+    std::condition_variable m_feedTrigger;
+
+    /// Whether the appsrc element wants data.
+    bool m_isFeeding;
+
+    /// Whether @c m_feedThread should exit.
+    bool m_isShuttingDown;
+
+    /// The bytes queued in the appsrc element, as counted in @c MemoryAccounting.
+    avsCommon::utils::metrics::MemoryAccounting::Allocation m_memory;
+
+    /// The thread which feeds the pipeline in @c FeedMode::PUSH, started when data is first needed.
+    std::thread m_feedThread;
 };
 
 }  // namespace mediaPlayer
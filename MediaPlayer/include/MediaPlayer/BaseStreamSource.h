@@ -32,12 +32,16 @@ namespace mediaPlayer {
 
 class BaseStreamSource : public SourceInterface {
 public:
+    /// The number of bytes pushed into the appsrc element with each read, unless told otherwise.
+    static const size_t DEFAULT_CHUNK_SIZE = 4096;
+
     /**
      * Constructor.
      *
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
+     * @param chunkSize The number of bytes to read at once into each buffer pushed into the appsrc element.
      */
-    BaseStreamSource(PipelineInterface* pipeline);
+    BaseStreamSource(PipelineInterface* pipeline, size_t chunkSize = DEFAULT_CHUNK_SIZE);
 
     ~BaseStreamSource() override;
 
@@ -50,7 +54,8 @@ protected:
      * Initializes a source. Creates all the necessary pipeline elements such that audio output from the final
      * element should be decoded output that can be input to the @c converter of the @c AudioPipeline. Adding
      * the elements to the @c pipeline of the @c AudioPipeline, linking the elements and setting up the
-     * callbacks for signals should be handled.
+     * callbacks for signals should be handled.  If the pipeline already has an appsrc element, it is reused along with
+     * the decoder after it, and only the callbacks are set up.
      *
      * @return @c true if the initialization was successful else @c false.
      */
@@ -75,6 +80,18 @@ protected:
      */
     virtual gboolean handleReadData() = 0;
 
+    /**
+     * Start feeding data into the appsrc element, called when it needs data.  By default this installs the
+     * @c onReadData() handler, which polls @c handleReadData() from the main loop.
+     */
+    virtual void startFeeding();
+
+    /**
+     * Stop feeding data into the appsrc element, called when it has enough data.  By default this uninstalls the
+     * @c onReadData() handler.
+     */
+    virtual void stopFeeding();
+
     /**
      * Get the AppSrc to which this instance should feed audio data.
      *
@@ -82,6 +99,14 @@ protected:
      */
     GstAppSrc* getAppSrc() const;
 
+    /**
+     * Get an empty buffer of the chunk size to read data into.  Buffers come from a @c GstBufferPool and return to it
+     * once the pipeline is done with them, so that steady playback does not allocate a buffer for each read.
+     *
+     * @return A buffer, or @c nullptr if none could be had.  The caller owns a reference to the buffer.
+     */
+    GstBuffer* acquireBuffer();
+
     /**
      * Signal gstreamer about the end of data from this instance.
      */
@@ -109,6 +134,19 @@ protected:
     void clearOnReadDataHandler();
 
 private:
+    /**
+     * Connect the handlers of the need-data and enough-data signals of the appsrc element.
+     *
+     * @param appsrc The appsrc element.
+     * @return @c true if the handlers were connected else @c false.
+     */
+    bool connectSignals(GstAppSrc* appsrc);
+
+    /**
+     * Set up @c m_bufferPool.  If this fails, buffers are allocated for each read instead.
+     */
+    void initBufferPool();
+
     /**
      * The callback for pushing data into the appsrc element.
      *
@@ -151,6 +189,12 @@ private:
     /// The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
     PipelineInterface* m_pipeline;
 
+    /// The number of bytes to read at once into each buffer.
+    const size_t m_chunkSize;
+
+    /// The pool of buffers of @c m_chunkSize bytes, or @c nullptr if one could not be set up.
+    GstBufferPool* m_bufferPool;
+
     /// The sourceId used to identify the installation of the @c onReadData() handler.
     guint m_sourceId;
 
@@ -0,0 +1,110 @@
+/*
+ * FileSource.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_FILE_SOURCE_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_FILE_SOURCE_H_
+
+#include <memory>
+#include <string>
+
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+#include "MediaPlayer/BaseStreamSource.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A source which plays a local file.  The file is mapped into memory once, and each chunk pushed into the appsrc
+ * element wraps a region of the mapping rather than a copy of it, so playing the file again, as when it repeats, reads
+ * nothing from disk and copies nothing.
+ */
+class FileSource : public BaseStreamSource {
+public:
+    /**
+     * Create a file source.
+     *
+     * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
+     * @param path The path of the file to play.
+     * @param repeat Whether the file should be replayed until stopped.
+     * @param chunkSize The number of bytes of the file to push at once.
+     * @return The source, or @c nullptr if the file could not be mapped or the source not set up.
+     */
+    static std::unique_ptr<FileSource> create(
+        PipelineInterface* pipeline,
+        const std::string& path,
+        bool repeat,
+        size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * Destructor.
+     */
+    ~FileSource() override;
+
+private:
+    /// A file mapped read-only into memory, which stays mapped while the buffers wrapping it are in use.
+    class MappedFile;
+
+    /**
+     * Constructor.
+     *
+     * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
+     * @param file The mapped file to play.
+     * @param repeat Whether the file should be replayed until stopped.
+     * @param chunkSize The number of bytes of the file to push at once.
+     */
+    FileSource(PipelineInterface* pipeline, std::shared_ptr<const MappedFile> file, bool repeat, size_t chunkSize);
+
+    /**
+     * Release the reference to a @c MappedFile held by a buffer, once the pipeline is done with the buffer.
+     *
+     * @param file A heap-allocated @c std::shared_ptr to the @c MappedFile.
+     */
+    static void releaseMappedFile(gpointer file);
+
+    /// @name Overridden SourceInterface methods.
+    /// @{
+    bool isPlaybackRemote() const override;
+
+    void terminate() override{};
+    /// @}
+
+    /// @name Overridden BaseStreamSource methods.
+    /// @{
+    bool isOpen() override;
+    void close() override;
+    gboolean handleReadData() override;
+    /// @}
+
+    /// The mapped file, or @c nullptr once closed.
+    std::shared_ptr<const MappedFile> m_file;
+
+    /// The offset in the file of the next chunk to push.
+    size_t m_offset;
+
+    /// Play the file over and over until told to stop.
+    const bool m_repeat;
+
+    /// The number of bytes of the file to push at once.
+    const size_t m_chunkSize;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_FILE_SOURCE_H_
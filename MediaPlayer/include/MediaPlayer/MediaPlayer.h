@@ -23,21 +23,31 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <queue>
 
 #include <gst/gst.h>
 #include <gst/app/gstappsrc.h>
+#include <gst/audio/audio.h>
 
+#include <AVSCommon/AVS/AudioInputStream.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerObserverInterface.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
+#include <PlaylistParser/PlaylistCache.h>
 
+#include "MediaPlayer/AdaptiveBuffering.h"
 #include "MediaPlayer/OffsetManager.h"
 #include "MediaPlayer/PipelineInterface.h"
+#include "MediaPlayer/PlaybackReferenceTap.h"
+#include "MediaPlayer/SampleOffsetTracker.h"
+#include "MediaPlayer/SharedMainLoop.h"
 #include "MediaPlayer/SourceInterface.h"
+#include "MediaPlayer/StutterMetrics.h"
 
 namespace alexaClientSDK {
 namespace mediaPlayer {
@@ -53,11 +63,14 @@ public:
      * Creates an instance of the @c MediaPlayer.
      *
      * @param contentFetcherFactory Used to create objects that can fetch remote HTTP content.
+     * @param playbackReferenceStream A stream to copy the audio played to, as the reference for acoustic echo
+     * cancellation, or @c nullptr for none.  See @c PlaybackReferenceTap for its format.
      * @return An instance of the @c MediaPlayer if successful else a @c nullptr.
      */
     static std::shared_ptr<MediaPlayer> create(
         std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory =
-            nullptr);
+            nullptr,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> playbackReferenceStream = nullptr);
 
     /**
      * Destructor.
@@ -68,9 +81,17 @@ public:
     /// @{
     avsCommon::utils::mediaPlayer::MediaPlayerStatus setSource(
         std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader) override;
+    /**
+     * An attachment of @c SourceFormat::MPEG is played through the fixed MP3 decoder of
+     * @c setupPersistentMp3Elements(), whether or not it is configured for all attachments.
+     */
+    avsCommon::utils::mediaPlayer::MediaPlayerStatus setSource(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        avsCommon::utils::mediaPlayer::SourceFormat format) override;
     avsCommon::utils::mediaPlayer::MediaPlayerStatus setSource(std::shared_ptr<std::istream> stream, bool repeat)
         override;
     avsCommon::utils::mediaPlayer::MediaPlayerStatus setSource(const std::string& url) override;
+    avsCommon::utils::mediaPlayer::MediaPlayerStatus setFileSource(const std::string& path, bool repeat) override;
 
     avsCommon::utils::mediaPlayer::MediaPlayerStatus play() override;
     avsCommon::utils::mediaPlayer::MediaPlayerStatus stop() override;
@@ -86,9 +107,39 @@ public:
      * The function will always return MediaPlayerStatus::SUCCESS.
      */
     avsCommon::utils::mediaPlayer::MediaPlayerStatus setOffset(std::chrono::milliseconds offset) override;
+    avsCommon::utils::mediaPlayer::MediaPlayerStatus setVolume(double volume) override;
+    /**
+     * Sets the volume element to the configured "bargeInVolumePercent" from the calling thread.  How soon this is
+     * heard depends on how much audio the sink buffers, which "audioSinkBufferTimeUs" bounds.
+     */
+    void attenuateForBargeIn() override;
     void setObserver(std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerObserverInterface> observer) override;
+
+    /*
+     * These queue the operation on the main event loop and return without waiting for it, and @c onCompleted is called
+     * on the main event loop.  A url source is still set by @c setSourceAsync() before it returns, because the
+     * playlist parser needs the main event loop while the source is created.  @c playAsync() checks and prepares the
+     * source on the main event loop too, so it may follow @c setSourceAsync() at once.
+     */
+    void setSourceAsync(
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+        StatusCallback onCompleted = nullptr) override;
+    void setSourceAsync(const std::string& url, StatusCallback onCompleted = nullptr) override;
+    void setSourceAsync(std::shared_ptr<std::istream> stream, bool repeat, StatusCallback onCompleted = nullptr)
+        override;
+    void playAsync(StatusCallback onCompleted = nullptr) override;
+    void stopAsync(StatusCallback onCompleted = nullptr) override;
+    void pauseAsync(StatusCallback onCompleted = nullptr) override;
+    void resumeAsync(StatusCallback onCompleted = nullptr) override;
     /// @}
 
+    /**
+     * Get the stutters of the stream being played, or of the last one played.  This does not use the main loop.
+     *
+     * @return The number and durations of the buffer underruns during playback of the stream.
+     */
+    StutterMetrics::Summary getStutterSummary() const;
+
     /// @name Overridden PipelineInterface methods.
     /// @{
     void setAppSrc(GstAppSrc* appSrc) override;
@@ -121,6 +172,9 @@ private:
         /// The converter element.
         GstElement* converter;
 
+        /// The volume element, between the converter and the sink.
+        GstElement* volume;
+
         /// The sink element.
         GstElement* audioSink;
 
@@ -132,6 +186,7 @@ private:
                 appsrc{nullptr},
                 decoder{nullptr},
                 converter{nullptr},
+                volume{nullptr},
                 audioSink{nullptr},
                 pipeline{nullptr} {};
     };
@@ -140,12 +195,16 @@ private:
      * Constructor.
      *
      * @param contentFetcherFactory Used to create objects that can fetch remote HTTP content.
+     * @param playbackReferenceStream A stream to copy the audio played to, or @c nullptr for none.
      */
     MediaPlayer(
-        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory);
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> playbackReferenceStream);
 
     /**
-     * Initializes GStreamer and starts a main event loop on a new thread.
+     * Initializes GStreamer and starts a main event loop on a new thread.  The pipeline is created here unless the
+     * configuration asks for it to be created lazily, when it is created on the main loop instead: ahead of time once
+     * the loop is idle if prewarming is enabled, and otherwise when a source is first set.
      *
      * @return @c SUCCESS if initialization was successful. Else @c FAILURE.
      */
@@ -166,19 +225,85 @@ private:
      */
     static gboolean onCallback(const std::function<gboolean()>* callback);
 
+    /**
+     * Queues a handler on the main event loop without waiting for it, and passes the status it sets to a callback.
+     *
+     * @param handler The handler to call on the main event loop with the promise of the status.
+     * @param onCompleted The callback to pass the status to, or @c nullptr.
+     */
+    void queueAsyncHandler(
+        std::function<void(std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus>*)> handler,
+        StatusCallback onCompleted);
+
+    /**
+     * Deletes a callback queued by @c queueAsyncHandler(), once the main event loop is done with it.
+     *
+     * @param callback The @c std::function<gboolean()> to delete.
+     */
+    static void deleteAsyncCallback(gpointer callback);
+
     /**
      * Creates the @c AudioPipeline with the permanent elements and links them together.  The permanent elements
-     * are converter and audioSink.
+     * are converter, volume and audioSink.
      *
      * @return @c true if all the elements were created and linked successfully else @c false.
      */
     bool setupPipeline();
 
+    /**
+     * Creates the pipeline with @c setupPipeline() if it has not been created yet.
+     *
+     * @note This method must only be called on the main event loop.
+     *
+     * @return Whether the pipeline exists.
+     */
+    bool ensurePipeline();
+
+    /**
+     * Sets the device, buffer-time and latency-time properties of the sink element from the configuration.
+     *
+     * @param config The configuration of the @c MediaPlayer.
+     * @return @c false if a property is configured which the sink does not have, else @c true.
+     */
+    bool configureAudioSink(const avsCommon::utils::configuration::ConfigurationNode& config);
+
+    /**
+     * Links an element to the audio sink.  If there is a @c m_playbackReferenceTap, a tee is put between them, which
+     * also feeds the tap.
+     *
+     * @param element The element to feed the audio sink, already in the pipeline.
+     * @return @c true if the elements were linked successfully else @c false.
+     */
+    bool linkToAudioSink(GstElement* element);
+
+    /**
+     * Creates a bin which converts audio to the sample rate and channels set in the configuration, to sit between
+     * the converter and the sink.
+     *
+     * @param config The configuration of the @c MediaPlayer.
+     * @param[out] bin The new bin, or @c nullptr if no output format is configured.
+     * @return @c true if the bin was created or is not needed, else @c false.
+     */
+    bool createOutputFormatElements(const avsCommon::utils::configuration::ConfigurationNode& config, GstElement** bin);
+
     /**
      * Stops the currently playing audio and removes the transient elements.  The transient elements
      * are appsrc and decoder.
+     *
+     * @param keepPersistentElements Whether to keep the appsrc and decoder built by
+     *     @c setupPersistentMp3Elements(), so that the next attachment source can reuse them.
+     */
+    void tearDownTransientPipelineElements(bool keepPersistentElements = false);
+
+    /**
+     * Creates an appsrc and a fixed MP3 decoder in place of the transient elements, and links them to the converter.
+     * Unlike a decodebin, the decoder keeps its elements and links from one source to the next, so nothing needs to
+     * be found or negotiated again before the next attachment plays.  The appsrc declares MPEG audio caps up front, so
+     * the parser need not find the format either.
+     *
+     * @return @c true if the elements were created and linked successfully else @c false.
      */
-    void tearDownTransientPipelineElements();
+    bool setupPersistentMp3Elements();
 
     /*
      * Resets the @c AudioPipeline.
@@ -218,6 +343,17 @@ private:
      */
     static gboolean onBusMessage(GstBus* bus, GstMessage* msg, gpointer mediaPlayer);
 
+    /**
+     * The probe on the sink pad of the volume element, which feeds the decoded audio and its segment and format events
+     * to @c m_sampleOffsetTracker.  Called on the streaming thread.
+     *
+     * @param pad The pad.
+     * @param info The buffer or event flowing through the pad.
+     * @param mediaPlayer The instance of the mediaPlayer that the @c pad is part of.
+     * @return @c GST_PAD_PROBE_OK, to let the data through.
+     */
+    static GstPadProbeReturn onPlaybackProbe(GstPad* pad, GstPadProbeInfo* info, gpointer mediaPlayer);
+
     /**
      * Performs actions based on the message.
      *
@@ -233,10 +369,12 @@ private:
      * @param promise A promise to fulfill with a @ MediaPlayerStatus value once the source has been set
      * (or the operation failed).
      * @param reader The @c AttachmentReader with which to receive the audio to play.
+     * @param format The format of the audio, if known.
      */
     void handleSetAttachmentReaderSource(
         std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus>* promise,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+        avsCommon::utils::mediaPlayer::SourceFormat format = avsCommon::utils::mediaPlayer::SourceFormat::UNKNOWN);
 
     void handleSetSource(std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus> promise, std::string url);
 
@@ -252,6 +390,19 @@ private:
         std::shared_ptr<std::istream> stream,
         bool repeat);
 
+    /**
+     * Worker thread handler for setting a local file as the source of audio to play.
+     *
+     * @param promise A promise to fulfill with a @ MediaPlayerStatus value once the source has been set
+     * (or the operation failed).
+     * @param path The path of the file to play.
+     * @param repeat Whether the file should be replayed until stopped.
+     */
+    void handleSetFileSource(
+        std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus>* promise,
+        const std::string& path,
+        bool repeat);
+
     /**
      * Worker thread handler for starting playback of the current audio source.
      *
@@ -291,13 +442,6 @@ private:
      */
     void handleResume(std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus>* promise);
 
-    /**
-     * Worker thread handler for getting the current playback position.
-     *
-     * @param promise A promise to fulfill with the offset once the value has been determined.
-     */
-    void handleGetOffset(std::promise<std::chrono::milliseconds>* promise);
-
     /**
      * Worker thread handler for setting the playback position.
      *
@@ -308,6 +452,19 @@ private:
         std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus>* promise,
         std::chrono::milliseconds offset);
 
+    /**
+     * Worker thread handler for setting the volume.
+     *
+     * @param promise A promise to fulfill with a @c MediaPlayerStatus value once the volume has been set.
+     * @param volume The volume, from 0.0 to 1.0.
+     */
+    void handleSetVolume(std::promise<avsCommon::utils::mediaPlayer::MediaPlayerStatus>* promise, double volume);
+
+    /**
+     * Restores the volume set with @c setVolume() if @c attenuateForBargeIn() has lowered it since.
+     */
+    void releaseBargeInAttenuation();
+
     /**
      * Worker thread handler for setting the observer.
      *
@@ -358,6 +515,11 @@ private:
      */
     void sendBufferRefilled();
 
+    /**
+     * Apply the buffer size and duration decided by @c m_adaptiveBuffering to the decoder of the url source.
+     */
+    void applyBufferSettings();
+
     /**
      * Used to obtain seeking information about the pipeline.
      *
@@ -384,17 +546,48 @@ private:
     /// An instance of the @c OffsetManager.
     OffsetManager m_offsetManager;
 
+    /// Tracks the offset from the audio which has been decoded, so that @c getOffset() does not use the main loop.
+    SampleOffsetTracker m_sampleOffsetTracker;
+
     /// Used to create objects that can fetch remote HTTP content.
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> m_contentFetcherFactory;
 
+    /// The stream to copy the audio played to, or @c nullptr for none.
+    std::shared_ptr<avsCommon::avs::AudioInputStream> m_playbackReferenceStream;
+
+    /// The branch of the pipeline which copies the audio played into @c m_playbackReferenceStream, if there is one.
+    std::unique_ptr<PlaybackReferenceTap> m_playbackReferenceTap;
+
+    /// The volume of the output while it is attenuated for a barge-in, from 0.0 to 1.0.
+    double m_bargeInVolume;
+
+    /// Serializes setting the volume element, which @c attenuateForBargeIn() does off the main loop, and the members
+    /// below.
+    std::mutex m_volumeMutex;
+
+    /// The volume last set with @c setVolume().
+    double m_volume;
+
+    /// Whether the output is attenuated for a barge-in.
+    bool m_isAttenuatedForBargeIn;
+
+    /// The entries the playlists of url sources were resolved to, so that replaying a url does not resolve it again.
+    std::shared_ptr<playlistParser::PlaylistCache> m_playlistCache;
+
+    /// Decides the buffering of url sources, or @c nullptr to leave it to GStreamer.
+    std::unique_ptr<AdaptiveBuffering> m_adaptiveBuffering;
+
+    /// Counts the stutters of the stream being played.
+    StutterMetrics m_stutterMetrics;
+
+    /// The url of the url source, or empty if the source is not a url.  Its resolution is dropped if playing it fails.
+    std::string m_sourceUrl;
+
     /// An instance of the @c AudioPipeline.
     AudioPipeline m_pipeline;
 
-    /// Main event loop.
-    GMainLoop* m_mainLoop;
-
-    // Main loop thread
-    std::thread m_mainLoopThread;
+    /// The main event loop shared by all players, which dispatches this player's callbacks and bus messages.
+    std::shared_ptr<SharedMainLoop> m_mainLoop;
 
     // Set Source thread.
     std::thread m_setSourceThread;
@@ -402,6 +595,15 @@ private:
     /// Bus Id to track the bus.
     guint m_busWatchId;
 
+    /// Whether attachment sources are played through a persistent MP3 decoder instead of a decodebin.
+    bool m_usePersistentMp3Pipeline;
+
+    /// Whether the appsrc and decoder in @c m_pipeline are the persistent ones.
+    bool m_hasPersistentElements;
+
+    /// Whether creating the pipeline has failed, after which @c ensurePipeline() does not try again.
+    bool m_pipelineSetupFailed;
+
     /// Flag to indicate when a playback started notification has been sent to the observer.
     bool m_playbackStartedSent;
 
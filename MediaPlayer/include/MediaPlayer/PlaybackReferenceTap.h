@@ -0,0 +1,95 @@
+/*
+ * PlaybackReferenceTap.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_PLAYBACK_REFERENCE_TAP_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_PLAYBACK_REFERENCE_TAP_H_
+
+#include <memory>
+
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A branch of the pipeline which copies the audio handed to the sink into an @c AudioInputStream, as a reference of
+ * what the speaker plays for acoustic echo cancellation.
+ *
+ * The audio is converted to the format of the microphone stream: 16-bit linear PCM, 16 kHz, mono.  It is written as
+ * it is rendered, synchronized to the clock of the pipeline, so the timeline which the @c Writer records maps each
+ * index of the reference to the time it was played.  A reader can use it to line the reference up with the
+ * microphone stream.  Nothing is written while nothing plays.
+ */
+class PlaybackReferenceTap {
+public:
+    /// The sample rate of the reference, which is that of the microphone stream.
+    static const int SAMPLE_RATE_HZ = 16000;
+
+    /**
+     * Create a @c PlaybackReferenceTap.
+     *
+     * @param stream The stream to write the reference to.  Its words must be 16-bit samples, and it must not have a
+     * writer already.
+     * @return The @c PlaybackReferenceTap, or @c nullptr if the stream is not valid or the elements could not be made.
+     */
+    static std::unique_ptr<PlaybackReferenceTap> create(std::shared_ptr<avsCommon::avs::AudioInputStream> stream);
+
+    /**
+     * Destructor.  Closes the writer of the stream.  The pipeline must have been stopped.
+     */
+    ~PlaybackReferenceTap();
+
+    /**
+     * Get the bin of the branch, which has a sink pad to link to a @c tee.  This keeps a reference to the bin of its
+     * own, so the pipeline the bin is added to takes another.
+     *
+     * @return The bin of the branch.
+     */
+    GstElement* getBin() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param writer The writer of the reference.
+     * @param bin The bin of the branch.
+     */
+    PlaybackReferenceTap(std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> writer, GstElement* bin);
+
+    /**
+     * The callback of the appsink for each sample it renders.
+     *
+     * @param sink The appsink.
+     * @param tap The @c PlaybackReferenceTap.
+     * @return @c GST_FLOW_OK always, so that a full stream never stops playback.
+     */
+    static GstFlowReturn onNewSample(GstAppSink* sink, gpointer tap);
+
+    /// The writer of the reference.
+    const std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
+
+    /// The bin of the branch.
+    GstElement* const m_bin;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_PLAYBACK_REFERENCE_TAP_H_
@@ -0,0 +1,106 @@
+/*
+ * SampleOffsetTracker.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SAMPLE_OFFSET_TRACKER_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SAMPLE_OFFSET_TRACKER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * Tracks the offset of the stream from the decoded audio flowing through the pipeline.
+ *
+ * The streaming thread reports the start of each segment, the format of the audio and the size of each buffer.  The
+ * offset is the stream time at which the segment started, plus the duration of the samples counted since.  It is
+ * published in an atomic, so that @c getOffset() never waits for the streaming thread or the main loop.
+ */
+class SampleOffsetTracker {
+public:
+    /**
+     * Constructor.  The offset is invalid until a segment has started.
+     */
+    SampleOffsetTracker();
+
+    /**
+     * Start counting from a new segment, such as after a seek or at the start of a stream.
+     *
+     * @param streamTime The offset in the stream at which the segment starts.
+     */
+    void startSegment(std::chrono::nanoseconds streamTime);
+
+    /**
+     * Set the format of the audio counted from now on.
+     *
+     * @param sampleRate The number of frames per second.
+     * @param bytesPerFrame The size of a frame of all channels, in bytes.
+     */
+    void setFormat(int sampleRate, int bytesPerFrame);
+
+    /**
+     * Count a buffer of audio.  Ignored until a segment has started and the format is known.
+     *
+     * @param numBytes The size of the buffer.
+     */
+    void addBytes(uint64_t numBytes);
+
+    /**
+     * Forget the stream, making the offset invalid until the next segment starts.
+     */
+    void reset();
+
+    /**
+     * Get the offset.  This does not block.
+     *
+     * @return The offset, or a negative duration if it is not known.
+     */
+    std::chrono::milliseconds getOffset() const;
+
+private:
+    /// Recompute @c m_offset.  Called with @c m_mutex held.
+    void publish();
+
+    /// Serializes the updates from the streaming thread and @c reset().
+    std::mutex m_mutex;
+
+    /// Whether a segment has started since the last reset.
+    bool m_isSegmentStarted;
+
+    /// The stream time at which the samples in @c m_frames start.
+    std::chrono::nanoseconds m_baseTime;
+
+    /// The number of frames counted since @c m_baseTime.
+    uint64_t m_frames;
+
+    /// The number of frames per second, or 0 if not known.
+    int m_sampleRate;
+
+    /// The size of a frame in bytes, or 0 if not known.
+    int m_bytesPerFrame;
+
+    /// The offset in milliseconds, or -1 if it is not known.
+    std::atomic<int64_t> m_offset;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SAMPLE_OFFSET_TRACKER_H_
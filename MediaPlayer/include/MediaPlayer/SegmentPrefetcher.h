@@ -0,0 +1,179 @@
+/*
+ * SegmentPrefetcher.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SEGMENT_PREFETCHER_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SEGMENT_PREFETCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * Downloads the next entries of a playlist while the current one plays, so that the next entry can start without
+ * waiting for its fetch.
+ *
+ * The URLs are given to @c prefetch() in the order they will be played.  At most @c depth entries are held at once,
+ * and they are downloaded one at a time, in order.  An entry which would take the cache over @c maxBytes (such as a
+ * live stream) is abandoned and left to be streamed from the network, as are entries which have been held for longer
+ * than @c maxAge when they are needed.
+ *
+ * @note Abandoning an entry destroys its @c HTTPContentFetcherInterface, which for a fetcher running its transfer
+ * on a thread of its own waits for the transfer to finish.  For playlists of live streams, use a factory whose
+ * fetchers can stop a transfer early.
+ */
+class SegmentPrefetcher {
+public:
+    /// The content of a downloaded entry.
+    using Segment = std::shared_ptr<const std::vector<uint8_t>>;
+
+    /**
+     * Create a @c SegmentPrefetcher.
+     *
+     * @param contentFetcherFactory The factory used to create the fetchers which download the entries.
+     * @param depth The maximum number of entries to hold.
+     * @param maxBytes The maximum number of bytes to hold.
+     * @param maxAge How long a downloaded entry remains usable.
+     * @return The new @c SegmentPrefetcher, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<SegmentPrefetcher> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        size_t depth,
+        size_t maxBytes,
+        std::chrono::seconds maxAge);
+
+    /**
+     * Destructor.  Stops any download in progress.
+     */
+    ~SegmentPrefetcher();
+
+    /**
+     * Add the URL of an entry to be played after the ones already added.
+     *
+     * @param url The URL of the entry.
+     */
+    void prefetch(const std::string& url);
+
+    /**
+     * Get the content of the next entry to be played, forgetting the entries queued before it.  If the entry has not
+     * been downloaded yet, its download is cancelled, since the caller will now stream it itself.
+     *
+     * @param url The URL of the entry.
+     * @return The content of the entry, or @c nullptr if it has not been downloaded.
+     */
+    Segment take(const std::string& url);
+
+private:
+    /// A downloaded entry.
+    struct CachedSegment {
+        /// The URL of the entry.
+        std::string url;
+
+        /// The content of the entry.
+        Segment data;
+
+        /// When the download finished.
+        std::chrono::steady_clock::time_point fetchedAt;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param contentFetcherFactory The factory used to create the fetchers which download the entries.
+     * @param depth The maximum number of entries to hold.
+     * @param maxBytes The maximum number of bytes to hold.
+     * @param maxAge How long a downloaded entry remains usable.
+     */
+    SegmentPrefetcher(
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        size_t depth,
+        size_t maxBytes,
+        std::chrono::seconds maxAge);
+
+    /// The main loop of @c m_thread.
+    void downloadLoop();
+
+    /**
+     * Download an entry.  Called on @c m_thread without @c m_mutex held.
+     *
+     * @param url The URL of the entry.
+     * @return The content of the entry, or @c nullptr if the download failed, was cancelled or went over budget.
+     */
+    std::shared_ptr<std::vector<uint8_t>> download(const std::string& url);
+
+    /**
+     * Whether the download in progress should stop.
+     *
+     * @param numBytes The number of bytes downloaded so far.
+     * @return Whether the download should stop.
+     */
+    bool shouldStopDownload(size_t numBytes);
+
+    /// The factory used to create the fetchers which download the entries.
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> m_contentFetcherFactory;
+
+    /// The maximum number of entries to hold.
+    const size_t m_depth;
+
+    /// The maximum number of bytes to hold.
+    const size_t m_maxBytes;
+
+    /// How long a downloaded entry remains usable.
+    const std::chrono::seconds m_maxAge;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when there may be something for @c m_thread to do.
+    std::condition_variable m_wakeTrigger;
+
+    /// The URLs added with @c prefetch() which have not been downloaded yet.
+    std::deque<std::string> m_pendingUrls;
+
+    /// The downloaded entries, in the order they will be played.
+    std::deque<CachedSegment> m_segments;
+
+    /// The total size of @c m_segments, in bytes.
+    size_t m_cachedBytes;
+
+    /// The URL being downloaded, or empty.
+    std::string m_downloadingUrl;
+
+    /// Whether the download of @c m_downloadingUrl has been cancelled.
+    bool m_isDownloadCancelled;
+
+    /// Whether @c m_thread should exit.
+    bool m_isShuttingDown;
+
+    /// The thread which downloads the entries.
+    std::thread m_thread;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SEGMENT_PREFETCHER_H_
@@ -0,0 +1,82 @@
+/*
+ * SharedMainLoop.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SHARED_MAIN_LOOP_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SHARED_MAIN_LOOP_H_
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <glib.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A @c GMainLoop running the default @c GMainContext on a thread of its own, shared by every @c MediaPlayer.
+ *
+ * The callbacks queued with @c g_idle_add(), the bus watches and the timeouts of all the players are dispatched on
+ * this one thread, which serializes them just as when each player ran the default context itself.  The loop is
+ * created by the first @c acquire() and stopped when the last reference to it is released.
+ */
+class SharedMainLoop {
+public:
+    /**
+     * Get the shared main loop, starting it if no one holds it.
+     *
+     * @return The shared main loop, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<SharedMainLoop> acquire();
+
+    /**
+     * Destructor.  Stops the loop and waits for its thread to exit.
+     */
+    ~SharedMainLoop();
+
+    /**
+     * Whether the caller is running on the loop's thread.
+     *
+     * @return Whether the caller is running on the loop's thread.
+     */
+    bool isLoopThread() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param mainLoop The loop to run.
+     */
+    SharedMainLoop(GMainLoop* mainLoop);
+
+    /// Serializes @c acquire().
+    static std::mutex m_instanceMutex;
+
+    /// The current shared main loop, if anyone holds it.
+    static std::weak_ptr<SharedMainLoop> m_instance;
+
+    /// The loop.
+    GMainLoop* m_mainLoop;
+
+    /// The thread running @c m_mainLoop.
+    std::thread m_thread;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_SHARED_MAIN_LOOP_H_
@@ -0,0 +1,100 @@
+/*
+ * StutterMetrics.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_STUTTER_METRICS_H_
+#define ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_STUTTER_METRICS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * Counts the stutters of the stream being played, which are the times playback stopped because the buffer ran dry,
+ * and how long they lasted.  Updated from the main loop of the player, and read from any thread.
+ */
+class StutterMetrics {
+public:
+    /// The stutters of a stream.
+    struct Summary {
+        /// The number of stutters.
+        uint64_t count;
+
+        /// The total time spent stuttering, including an ongoing stutter.
+        std::chrono::milliseconds totalDuration;
+
+        /// The duration of the longest stutter, including an ongoing stutter.
+        std::chrono::milliseconds maxDuration;
+    };
+
+    /**
+     * Constructor.
+     */
+    StutterMetrics();
+
+    /**
+     * Start counting the stutters of a new stream, forgetting those of the previous one.
+     */
+    void startStream();
+
+    /**
+     * Count the start of a stutter.  Ignored while a stutter is ongoing.
+     *
+     * @param now The time the stutter started.
+     */
+    void onStutterStarted(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * Count the end of a stutter.  Ignored if no stutter is ongoing.
+     *
+     * @param now The time the stutter finished.
+     */
+    void onStutterFinished(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * Get the stutters of the current stream.
+     *
+     * @param now The time up to which an ongoing stutter is counted.
+     * @return The stutters of the current stream.
+     */
+    Summary getSummary(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+
+    /**
+     * Log the stutters of the current stream, if it had any.
+     */
+    void dump() const;
+
+private:
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The stutters of the current stream which have finished.
+    Summary m_finished;
+
+    /// Whether a stutter is ongoing.
+    bool m_isStuttering;
+
+    /// When the ongoing stutter started.
+    std::chrono::steady_clock::time_point m_stutterStart;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIA_PLAYER_INCLUDE_MEDIA_PLAYER_STUTTER_METRICS_H_
@@ -29,6 +29,7 @@
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserObserverInterface.h>
 
+#include "MediaPlayer/SegmentPrefetcher.h"
 #include "MediaPlayer/SourceInterface.h"
 
 namespace alexaClientSDK {
@@ -45,13 +46,21 @@ public:
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param playlistParser The @c PlaylistParserInterface which will parse playlist urls.
      * @param url The url from which to create the pipeline source from.
+     * @param prefetcher If not @c nullptr, used to download the entries after the first one of a playlist while the
+     * previous ones play.
      *
      * @return An instance of the @c UrlSource if successful else a @c nullptr.
      */
     static std::shared_ptr<UrlSource> create(
         PipelineInterface* pipeline,
         std::shared_ptr<avsCommon::utils::playlistParser::PlaylistParserInterface> playlistParser,
-        const std::string& url);
+        const std::string& url,
+        std::unique_ptr<SegmentPrefetcher> prefetcher = nullptr);
+
+    /**
+     * Destructor.
+     */
+    ~UrlSource() override;
 
     void onPlaylistEntryParsed(
         int requestId,
@@ -81,11 +90,36 @@ private:
      * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
      * @param playlistParser The @c PlaylistParserInterface which will parse playlist urls.
      * @param url The @c url from which to create the pipeline source from.
+     * @param prefetcher Used to download the entries after the first one of a playlist, or @c nullptr.
      */
     UrlSource(
         PipelineInterface* pipeline,
         std::shared_ptr<avsCommon::utils::playlistParser::PlaylistParserInterface> playlistParser,
-        const std::string& url);
+        const std::string& url,
+        std::unique_ptr<SegmentPrefetcher> prefetcher);
+
+    /**
+     * The callback for the decoder's source-setup signal, emitted when the decoder has created its source element.
+     *
+     * @param decoder The decoder.
+     * @param source The source element.
+     * @param pointer The @c UrlSource which connected the signal.
+     */
+    static void onSourceSetup(GstElement* decoder, GstElement* source, gpointer pointer);
+
+    /**
+     * Feed @c m_prefetchedSegment to the appsrc the decoder created for it.
+     *
+     * @param source The source element created by the decoder.
+     */
+    void handleSourceSetup(GstElement* source);
+
+    /**
+     * Get the uri the decoder should read the current entry from.  Called with @c m_mutex held.
+     *
+     * @return The uri of the current entry.
+     */
+    std::string getDecoderUriLocked() const;
 
     /**
      * Initializes the UrlSource by doing the following:
@@ -119,6 +153,21 @@ private:
 
     /// The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
     PipelineInterface* m_pipeline;
+
+    /// Downloads the entries after the first one of a playlist, or @c nullptr.
+    std::unique_ptr<SegmentPrefetcher> m_prefetcher;
+
+    /// The number of entries parsed from the playlist so far.
+    size_t m_numEntriesParsed;
+
+    /// The downloaded content of the entry at @c m_url, or @c nullptr if it is streamed from @c m_url.
+    SegmentPrefetcher::Segment m_prefetchedSegment;
+
+    /// The decoder element, referenced so that @c m_sourceSetupHandlerId can be disconnected.
+    GstElement* m_decoder;
+
+    /// The id of the handler of the decoder's source-setup signal.
+    gulong m_sourceSetupHandlerId;
 };
 
 }  // namespace mediaPlayer
@@ -0,0 +1,109 @@
+/*
+ * AdaptiveBuffering.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/AdaptiveBuffering.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AdaptiveBuffering");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The size of the buffer of @c queue2 when @c uridecodebin is left to its default, from which the buffer grows.
+static const int64_t GSTREAMER_DEFAULT_BUFFER_SIZE_BYTES = 2 * 1024 * 1024;
+
+/// The duration of the buffer of @c queue2 when @c uridecodebin is left to its default, from which the buffer grows.
+static const std::chrono::milliseconds GSTREAMER_DEFAULT_BUFFER_DURATION(2000);
+
+/// The factor by which the buffer grows.
+static const int GROWTH_FACTOR = 2;
+
+std::unique_ptr<AdaptiveBuffering> AdaptiveBuffering::create(
+    int64_t bufferSizeBytes,
+    std::chrono::milliseconds bufferDuration,
+    int64_t maxBufferSizeBytes,
+    std::chrono::milliseconds maxBufferDuration,
+    int underrunsBeforeGrowth) {
+    if (bufferSizeBytes < 0 || bufferDuration.count() < 0 || underrunsBeforeGrowth < 0 ||
+        bufferSizeBytes > maxBufferSizeBytes || bufferDuration > maxBufferDuration) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidParameters")
+                        .d("bufferSizeBytes", bufferSizeBytes)
+                        .d("bufferDurationMs", bufferDuration.count())
+                        .d("maxBufferSizeBytes", maxBufferSizeBytes)
+                        .d("maxBufferDurationMs", maxBufferDuration.count())
+                        .d("underrunsBeforeGrowth", underrunsBeforeGrowth));
+        return nullptr;
+    }
+    return std::unique_ptr<AdaptiveBuffering>(new AdaptiveBuffering(
+        bufferSizeBytes, bufferDuration, maxBufferSizeBytes, maxBufferDuration, underrunsBeforeGrowth));
+}
+
+AdaptiveBuffering::AdaptiveBuffering(
+    int64_t bufferSizeBytes,
+    std::chrono::milliseconds bufferDuration,
+    int64_t maxBufferSizeBytes,
+    std::chrono::milliseconds maxBufferDuration,
+    int underrunsBeforeGrowth) :
+        m_bufferSizeBytes{bufferSizeBytes},
+        m_bufferDuration{bufferDuration},
+        m_maxBufferSizeBytes{maxBufferSizeBytes},
+        m_maxBufferDuration{maxBufferDuration},
+        m_underrunsBeforeGrowth{underrunsBeforeGrowth},
+        m_underruns{0} {
+}
+
+int64_t AdaptiveBuffering::getBufferSizeBytes() const {
+    return m_bufferSizeBytes;
+}
+
+std::chrono::milliseconds AdaptiveBuffering::getBufferDuration() const {
+    return m_bufferDuration;
+}
+
+bool AdaptiveBuffering::onBufferUnderrun() {
+    if (0 == m_underrunsBeforeGrowth || ++m_underruns < m_underrunsBeforeGrowth) {
+        return false;
+    }
+    m_underruns = 0;
+    auto size = m_bufferSizeBytes > 0 ? m_bufferSizeBytes : GSTREAMER_DEFAULT_BUFFER_SIZE_BYTES;
+    auto duration = m_bufferDuration.count() > 0 ? m_bufferDuration : GSTREAMER_DEFAULT_BUFFER_DURATION;
+    size = std::min(size * GROWTH_FACTOR, m_maxBufferSizeBytes);
+    duration = std::min(duration * GROWTH_FACTOR, m_maxBufferDuration);
+    if (size <= m_bufferSizeBytes && duration <= m_bufferDuration) {
+        return false;
+    }
+    m_bufferSizeBytes = std::max(size, m_bufferSizeBytes);
+    m_bufferDuration = std::max(duration, m_bufferDuration);
+    ACSDK_INFO(
+        LX("bufferGrown").d("bufferSizeBytes", m_bufferSizeBytes).d("bufferDurationMs", m_bufferDuration.count()));
+    return true;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
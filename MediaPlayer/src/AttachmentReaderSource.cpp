@@ -39,13 +39,19 @@ static const std::string TAG("AttachmentReaderSource");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/// The number of bytes read from the attachment with each read in the read loop.
-static const unsigned int CHUNK_SIZE(4096);
+/**
+ * How long @c FeedMode::PUSH waits for the attachment before checking whether it should stop.  This only bounds how
+ * long stopping takes: data is pushed as soon as it is written.
+ */
+static const std::chrono::milliseconds FEED_READ_TIMEOUT(100);
 
 std::unique_ptr<AttachmentReaderSource> AttachmentReaderSource::create(
     PipelineInterface* pipeline,
-    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader) {
-    std::unique_ptr<AttachmentReaderSource> result(new AttachmentReaderSource(pipeline, attachmentReader));
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader,
+    size_t chunkSize,
+    FeedMode feedMode) {
+    std::unique_ptr<AttachmentReaderSource> result(
+        new AttachmentReaderSource(pipeline, attachmentReader, chunkSize, feedMode));
     if (result->init()) {
         return result;
     }
@@ -53,14 +59,21 @@ std::unique_ptr<AttachmentReaderSource> AttachmentReaderSource::create(
 };
 
 AttachmentReaderSource::~AttachmentReaderSource() {
+    terminate();
     close();
 }
 
 AttachmentReaderSource::AttachmentReaderSource(
     PipelineInterface* pipeline,
-    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader) :
-        BaseStreamSource{pipeline},
-        m_reader{reader} {};
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+    size_t chunkSize,
+    FeedMode feedMode) :
+        BaseStreamSource{pipeline, chunkSize},
+        m_reader{reader},
+        m_feedMode{feedMode},
+        m_isFeeding{false},
+        m_isShuttingDown{false},
+        m_memory{metrics::MemoryAccounting::Category::MEDIA_BUFFERS} {};
 
 bool AttachmentReaderSource::isPlaybackRemote() const {
     return false;
@@ -83,10 +96,10 @@ gboolean AttachmentReaderSource::handleReadData() {
         return false;
     }
 
-    auto buffer = gst_buffer_new_allocate(nullptr, CHUNK_SIZE, nullptr);
+    auto buffer = acquireBuffer();
 
     if (!buffer) {
-        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "gstBufferNewAllocateFailed"));
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "acquireBufferFailed"));
         signalEndOfData();
         return false;
     }
@@ -127,6 +140,7 @@ gboolean AttachmentReaderSource::handleReadData() {
                                     .d("error", gst_flow_get_name(flowRet)));
                     break;
                 }
+                updateMemoryAccounting();
                 return true;
             }
         // Fall through to retry reading later.
@@ -148,5 +162,122 @@ gboolean AttachmentReaderSource::handleReadData() {
     return false;
 }
 
+void AttachmentReaderSource::updateMemoryAccounting() {
+    // The level drops as the pipeline consumes the buffers, and is sampled again with the next push.
+    m_memory.resize(gst_app_src_get_current_level_bytes(getAppSrc()));
+}
+
+void AttachmentReaderSource::terminate() {
+    {
+        std::lock_guard<std::mutex> lock(m_feedMutex);
+        m_isShuttingDown = true;
+    }
+    m_feedTrigger.notify_all();
+    if (m_feedThread.joinable()) {
+        m_feedThread.join();
+    }
+}
+
+void AttachmentReaderSource::startFeeding() {
+    if (FeedMode::POLL == m_feedMode) {
+        BaseStreamSource::startFeeding();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_feedMutex);
+    m_isFeeding = true;
+    if (!m_feedThread.joinable() && !m_isShuttingDown) {
+        m_feedThread = std::thread(&AttachmentReaderSource::feedLoop, this);
+    }
+    m_feedTrigger.notify_all();
+}
+
+void AttachmentReaderSource::stopFeeding() {
+    if (FeedMode::POLL == m_feedMode) {
+        BaseStreamSource::stopFeeding();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_feedMutex);
+    m_isFeeding = false;
+}
+
+void AttachmentReaderSource::feedLoop() {
+    std::unique_lock<std::mutex> lock(m_feedMutex);
+    while (true) {
+        m_feedTrigger.wait(lock, [this]() { return m_isFeeding || m_isShuttingDown; });
+        if (m_isShuttingDown) {
+            return;
+        }
+        lock.unlock();
+        auto isOpen = feedChunk();
+        lock.lock();
+        if (!isOpen) {
+            return;
+        }
+    }
+}
+
+bool AttachmentReaderSource::feedChunk() {
+    if (!m_reader) {
+        return false;
+    }
+
+    auto buffer = acquireBuffer();
+    if (!buffer) {
+        ACSDK_ERROR(LX("feedChunkFailed").d("reason", "acquireBufferFailed"));
+        signalEndOfData();
+        return false;
+    }
+
+    GstMapInfo info;
+    if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE)) {
+        ACSDK_ERROR(LX("feedChunkFailed").d("reason", "gstBufferMapFailed"));
+        gst_buffer_unref(buffer);
+        signalEndOfData();
+        return false;
+    }
+    auto status = AttachmentReader::ReadStatus::OK;
+    auto size = m_reader->read(info.data, info.size, &status, FEED_READ_TIMEOUT);
+    gst_buffer_unmap(buffer, &info);
+
+    if (size > 0) {
+        if (size < info.size) {
+            gst_buffer_resize(buffer, 0, size);
+        }
+        // The appsrc element takes the reference to the buffer, and is safe to push into from any thread.
+        auto flowRet = gst_app_src_push_buffer(getAppSrc(), buffer);
+        if (flowRet != GST_FLOW_OK) {
+            ACSDK_ERROR(LX("feedChunkFailed")
+                            .d("reason", "gstAppSrcPushBufferFailed")
+                            .d("error", gst_flow_get_name(flowRet)));
+            signalEndOfData();
+            return false;
+        }
+        updateMemoryAccounting();
+    } else {
+        gst_buffer_unref(buffer);
+    }
+
+    switch (status) {
+        case AttachmentReader::ReadStatus::OK:
+        case AttachmentReader::ReadStatus::OK_TIMEDOUT:
+            return true;
+        case AttachmentReader::ReadStatus::OK_WOULDBLOCK: {
+            // A non-blocking reader has no data; wait as a blocking one would rather than spin.
+            std::unique_lock<std::mutex> lock(m_feedMutex);
+            m_feedTrigger.wait_for(lock, FEED_READ_TIMEOUT, [this]() { return m_isShuttingDown; });
+            return true;
+        }
+        case AttachmentReader::ReadStatus::CLOSED:
+            break;
+        case AttachmentReader::ReadStatus::ERROR_OVERRUN:
+        case AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+        case AttachmentReader::ReadStatus::ERROR_INTERNAL:
+            ACSDK_ERROR(LX("feedChunkFailed").d("reason", "readFailed").d("error", static_cast<int>(status)));
+            break;
+    }
+    signalEndOfData();
+    return false;
+}
+
 }  // namespace mediaPlayer
 }  // namespace alexaClientSDK
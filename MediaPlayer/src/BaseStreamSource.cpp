@@ -42,8 +42,18 @@ static const std::string TAG("BaseStreamSource");
 /// The interval to wait (in milliseconds) between successive attempts to read audio data when none is available.
 static const guint RETRY_INTERVALS_MILLISECONDS[] = {0, 10, 10, 10, 20, 20, 50, 100};
 
-BaseStreamSource::BaseStreamSource(PipelineInterface* pipeline) :
+/// The number of buffers allocated up front when the pool of buffers is set up.
+static const guint MIN_POOLED_BUFFERS = 4;
+
+/// One in how many logs of (re)scheduling reads are sent to the log, since they happen for each chunk of audio.
+static const uint64_t RETRY_LOG_SAMPLE_RATE = 100;
+
+const size_t BaseStreamSource::DEFAULT_CHUNK_SIZE;
+
+BaseStreamSource::BaseStreamSource(PipelineInterface* pipeline, size_t chunkSize) :
         m_pipeline{pipeline},
+        m_chunkSize{chunkSize},
+        m_bufferPool{nullptr},
         m_sourceId{0},
         m_sourceRetryCount{0},
         m_handleNeedDataFunction{[this]() { return handleNeedData(); }},
@@ -68,10 +78,32 @@ BaseStreamSource::~BaseStreamSource() {
         }
     }
     uninstallOnReadDataHandler();
+    if (m_bufferPool) {
+        // Buffers still held by the pipeline keep the pool alive until they are released.
+        gst_buffer_pool_set_active(m_bufferPool, FALSE);
+        gst_object_unref(m_bufferPool);
+    }
 }
 
 bool BaseStreamSource::init() {
-    auto appsrc = reinterpret_cast<GstAppSrc*>(gst_element_factory_make("appsrc", "src"));
+    if (0 == m_chunkSize) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "zeroChunkSize"));
+        return false;
+    }
+    initBufferPool();
+
+    if (!m_pipeline) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "pipelineIsNotSet"));
+        return false;
+    }
+
+    // A persistent appsrc element left in the pipeline by the previous source is reused as it is.
+    auto appsrc = m_pipeline->getAppSrc();
+    if (appsrc) {
+        return connectSignals(appsrc);
+    }
+
+    appsrc = reinterpret_cast<GstAppSrc*>(gst_element_factory_make("appsrc", "src"));
     if (!appsrc) {
         ACSDK_ERROR(LX("initFailed").d("reason", "createSourceElementFailed"));
         return false;
@@ -84,11 +116,6 @@ bool BaseStreamSource::init() {
         return false;
     }
 
-    if (!m_pipeline) {
-        ACSDK_ERROR(LX("initFailed").d("reason", "pipelineIsNotSet"));
-        return false;
-    }
-
     if (!gst_bin_add(GST_BIN(m_pipeline->getPipeline()), reinterpret_cast<GstElement*>(appsrc))) {
         ACSDK_ERROR(LX("initFailed").d("reason", "addingAppSrcToPipelineFailed"));
         return false;
@@ -108,6 +135,17 @@ bool BaseStreamSource::init() {
         ACSDK_ERROR(LX("initFailed").d("reason", "createSourceToDecoderLinkFailed"));
         return false;
     }
+    if (!connectSignals(appsrc)) {
+        return false;
+    }
+
+    m_pipeline->setAppSrc(appsrc);
+    m_pipeline->setDecoder(decoder);
+
+    return true;
+}
+
+bool BaseStreamSource::connectSignals(GstAppSrc* appsrc) {
     /*
      * When the appsrc needs data, it emits the signal need-data. Connect the need-data signal to the onNeedData
      * callback which handles pushing data to the appsrc element.
@@ -126,11 +164,41 @@ bool BaseStreamSource::init() {
         ACSDK_ERROR(LX("initFailed").d("reason", "connectEnoughDataSignalFailed"));
         return false;
     }
+    return true;
+}
 
-    m_pipeline->setAppSrc(appsrc);
-    m_pipeline->setDecoder(decoder);
+void BaseStreamSource::initBufferPool() {
+    auto pool = gst_buffer_pool_new();
+    if (!pool) {
+        ACSDK_WARN(LX("initBufferPoolFailed").d("reason", "gstBufferPoolNewFailed"));
+        return;
+    }
+    auto config = gst_buffer_pool_get_config(pool);
+    // No upper bound on the number of buffers: the appsrc element already bounds how much data is queued.
+    gst_buffer_pool_config_set_params(config, nullptr, m_chunkSize, MIN_POOLED_BUFFERS, 0);
+    if (!gst_buffer_pool_set_config(pool, config)) {
+        ACSDK_WARN(LX("initBufferPoolFailed").d("reason", "gstBufferPoolSetConfigFailed"));
+        gst_object_unref(pool);
+        return;
+    }
+    if (!gst_buffer_pool_set_active(pool, TRUE)) {
+        ACSDK_WARN(LX("initBufferPoolFailed").d("reason", "gstBufferPoolSetActiveFailed"));
+        gst_object_unref(pool);
+        return;
+    }
+    m_bufferPool = pool;
+}
 
-    return true;
+GstBuffer* BaseStreamSource::acquireBuffer() {
+    if (m_bufferPool) {
+        GstBuffer* buffer = nullptr;
+        auto flowRet = gst_buffer_pool_acquire_buffer(m_bufferPool, &buffer, nullptr);
+        if (GST_FLOW_OK == flowRet && buffer) {
+            return buffer;
+        }
+        ACSDK_WARN(LX("acquireBufferFromPoolFailed").d("result", gst_flow_get_name(flowRet)));
+    }
+    return gst_buffer_new_allocate(nullptr, m_chunkSize, nullptr);
 }
 
 GstAppSrc* BaseStreamSource::getAppSrc() const {
@@ -152,6 +220,14 @@ void BaseStreamSource::signalEndOfData() {
     clearOnReadDataHandler();
 }
 
+void BaseStreamSource::startFeeding() {
+    installOnReadDataHandler();
+}
+
+void BaseStreamSource::stopFeeding() {
+    uninstallOnReadDataHandler();
+}
+
 void BaseStreamSource::installOnReadDataHandler() {
     if (!isOpen()) {
         return;
@@ -159,7 +235,9 @@ void BaseStreamSource::installOnReadDataHandler() {
     if (m_sourceId != 0) {
         // Remove the existing source if it was timer based.  Otherwise it is already properly installed.
         if (m_sourceRetryCount != 0) {
-            ACSDK_DEBUG9(LX("installOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
+            ACSDK_DEBUG9_EVERY_N(
+                RETRY_LOG_SAMPLE_RATE,
+                LX("installOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
             if (!g_source_remove(m_sourceId)) {
                 ACSDK_ERROR(
                     LX("installOnReadDataHandlerError").d("reason", "gSourceRemoveFailed").d("sourceId", m_sourceId));
@@ -170,12 +248,15 @@ void BaseStreamSource::installOnReadDataHandler() {
     }
     m_sourceRetryCount = 0;
     m_sourceId = g_idle_add(reinterpret_cast<GSourceFunc>(&onReadData), this);
-    ACSDK_DEBUG9(LX("installOnReadDataHandler").d("action", "newSourceId").d("sourceId", m_sourceId));
+    ACSDK_DEBUG9_EVERY_N(
+        RETRY_LOG_SAMPLE_RATE, LX("installOnReadDataHandler").d("action", "newSourceId").d("sourceId", m_sourceId));
 }
 
 void BaseStreamSource::updateOnReadDataHandler() {
     if (m_sourceRetryCount < sizeof(RETRY_INTERVALS_MILLISECONDS) / sizeof(RETRY_INTERVALS_MILLISECONDS[0])) {
-        ACSDK_DEBUG9(LX("updateOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
+        ACSDK_DEBUG9_EVERY_N(
+            RETRY_LOG_SAMPLE_RATE,
+            LX("updateOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
         if (!g_source_remove(m_sourceId)) {
             ACSDK_ERROR(
                 LX("updateOnReadDataHandlerError").d("reason", "gSourceRemoveFailed").d("sourceId", m_sourceId));
@@ -183,10 +264,12 @@ void BaseStreamSource::updateOnReadDataHandler() {
         auto interval = RETRY_INTERVALS_MILLISECONDS[m_sourceRetryCount];
         m_sourceRetryCount++;
         m_sourceId = g_timeout_add(interval, reinterpret_cast<GSourceFunc>(&onReadData), this);
-        ACSDK_DEBUG9(LX("updateOnReadDataHandlerNewSourceId")
-                         .d("action", "newSourceId")
-                         .d("sourceId", m_sourceId)
-                         .d("sourceRetryCount", m_sourceRetryCount));
+        ACSDK_DEBUG9_EVERY_N(
+            RETRY_LOG_SAMPLE_RATE,
+            LX("updateOnReadDataHandlerNewSourceId")
+                .d("action", "newSourceId")
+                .d("sourceId", m_sourceId)
+                .d("sourceRetryCount", m_sourceRetryCount));
     }
 }
 
@@ -207,7 +290,7 @@ void BaseStreamSource::clearOnReadDataHandler() {
 }
 
 void BaseStreamSource::onNeedData(GstElement* pipeline, guint size, gpointer pointer) {
-    ACSDK_DEBUG9(LX("onNeedDataCalled").d("size", size));
+    ACSDK_DEBUG9_EVERY_N(RETRY_LOG_SAMPLE_RATE, LX("onNeedDataCalled").d("size", size));
     auto source = static_cast<BaseStreamSource*>(pointer);
     std::lock_guard<std::mutex> lock(source->m_callbackIdMutex);
     if (source->m_needDataCallbackId) {
@@ -221,7 +304,7 @@ gboolean BaseStreamSource::handleNeedData() {
     ACSDK_DEBUG9(LX("handleNeedDataCalled"));
     std::lock_guard<std::mutex> lock(m_callbackIdMutex);
     m_needDataCallbackId = 0;
-    installOnReadDataHandler();
+    startFeeding();
     return false;
 }
 
@@ -240,7 +323,7 @@ gboolean BaseStreamSource::handleEnoughData() {
     ACSDK_DEBUG9(LX("handleEnoughDataCalled"));
     std::lock_guard<std::mutex> lock(m_callbackIdMutex);
     m_enoughDataCallbackId = 0;
-    uninstallOnReadDataHandler();
+    stopFeeding();
     return false;
 }
 
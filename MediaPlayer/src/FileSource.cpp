@@ -0,0 +1,198 @@
+/*
+ * FileSource.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/FileSource.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("FileSource");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+class FileSource::MappedFile {
+public:
+    /**
+     * Map a file.
+     *
+     * @param path The path of the file.
+     * @return The mapped file, or @c nullptr on failure.
+     */
+    static std::shared_ptr<const MappedFile> create(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            ACSDK_ERROR(LX("mapFileFailed").d("reason", "openFailed").d("path", path).d("error", strerror(errno)));
+            return nullptr;
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+            ACSDK_ERROR(LX("mapFileFailed").d("reason", "emptyOrUnreadable").d("path", path));
+            ::close(fd);
+            return nullptr;
+        }
+        void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid once the file is closed.
+        ::close(fd);
+        if (MAP_FAILED == data) {
+            ACSDK_ERROR(LX("mapFileFailed").d("reason", "mmapFailed").d("path", path).d("error", strerror(errno)));
+            return nullptr;
+        }
+        return std::shared_ptr<const MappedFile>(new MappedFile(data, status.st_size));
+    }
+
+    /// Destructor.  Unmaps the file.
+    ~MappedFile() {
+        munmap(m_data, m_size);
+    }
+
+    /// The start of the content.
+    void* data() const {
+        return m_data;
+    }
+
+    /// The size of the content.
+    size_t size() const {
+        return m_size;
+    }
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param data The start of the mapping.
+     * @param size The size of the mapping.
+     */
+    MappedFile(void* data, size_t size) : m_data{data}, m_size{size} {
+    }
+
+    /// The start of the mapping.
+    void* const m_data;
+
+    /// The size of the mapping.
+    const size_t m_size;
+};
+
+std::unique_ptr<FileSource> FileSource::create(
+    PipelineInterface* pipeline,
+    const std::string& path,
+    bool repeat,
+    size_t chunkSize) {
+    auto file = MappedFile::create(path);
+    if (!file) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "mapFileFailed"));
+        return nullptr;
+    }
+    std::unique_ptr<FileSource> result(new FileSource(pipeline, std::move(file), repeat, chunkSize));
+    if (result->init()) {
+        return result;
+    }
+    return nullptr;
+}
+
+FileSource::FileSource(
+    PipelineInterface* pipeline,
+    std::shared_ptr<const MappedFile> file,
+    bool repeat,
+    size_t chunkSize) :
+        BaseStreamSource{pipeline, chunkSize},
+        m_file{std::move(file)},
+        m_offset{0},
+        m_repeat{repeat},
+        m_chunkSize{chunkSize} {
+}
+
+FileSource::~FileSource() {
+    close();
+}
+
+void FileSource::releaseMappedFile(gpointer file) {
+    delete static_cast<std::shared_ptr<const MappedFile>*>(file);
+}
+
+bool FileSource::isPlaybackRemote() const {
+    return false;
+}
+
+bool FileSource::isOpen() {
+    return m_file != nullptr;
+}
+
+void FileSource::close() {
+    // Buffers still held by the pipeline keep the file mapped until they are released.
+    m_file.reset();
+}
+
+gboolean FileSource::handleReadData() {
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "fileIsNotOpen"));
+        return false;
+    }
+
+    if (m_offset >= m_file->size()) {
+        if (!m_repeat) {
+            signalEndOfData();
+            return false;
+        }
+        m_offset = 0;
+    }
+
+    auto size = std::min(m_chunkSize, m_file->size() - m_offset);
+    // The buffer wraps the mapping rather than a copy of it, and holds a reference which keeps it mapped.
+    auto reference = new std::shared_ptr<const MappedFile>(m_file);
+    auto buffer = gst_buffer_new_wrapped_full(
+        GST_MEMORY_FLAG_READONLY, m_file->data(), m_file->size(), m_offset, size, reference, &releaseMappedFile);
+    if (!buffer) {
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "gstBufferNewWrappedFullFailed"));
+        delete reference;
+        signalEndOfData();
+        return false;
+    }
+    m_offset += size;
+    ACSDK_DEBUG9(LX("read").d("size", size).d("offset", m_offset));
+
+    installOnReadDataHandler();
+    auto flowRet = gst_app_src_push_buffer(getAppSrc(), buffer);
+    if (flowRet != GST_FLOW_OK) {
+        ACSDK_ERROR(LX("handleReadDataFailed")
+                        .d("reason", "gstAppSrcPushBufferFailed")
+                        .d("error", gst_flow_get_name(flowRet)));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -16,14 +16,18 @@
  */
 
 #include <cstring>
+#include <utility>
 
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
 #include <PlaylistParser/PlaylistParser.h>
 
 #include "MediaPlayer/AttachmentReaderSource.h"
 #include "MediaPlayer/ErrorTypeConversion.h"
+#include "MediaPlayer/FileSource.h"
 #include "MediaPlayer/IStreamSource.h"
+#include "MediaPlayer/SegmentPrefetcher.h"
 #include "MediaPlayer/UrlSource.h"
 
 #include "MediaPlayer/MediaPlayer.h"
@@ -45,13 +49,154 @@ static const std::string TAG("MediaPlayer");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// Configuration key for the @c MediaPlayer settings.
+static const std::string CONFIG_KEY_MEDIA_PLAYER = "mediaPlayer";
+
+/// Configuration key for the number of playlist entries to download ahead of the one playing.  0 disables this.
+static const std::string CONFIG_KEY_PREFETCH_DEPTH = "prefetchDepth";
+
+/// Configuration key for the maximum number of bytes of playlist entries to download ahead.
+static const std::string CONFIG_KEY_PREFETCH_MAX_BYTES = "prefetchMaxBytes";
+
+/// Configuration key for how many seconds a playlist entry downloaded ahead remains usable.
+static const std::string CONFIG_KEY_PREFETCH_MAX_AGE_SECONDS = "prefetchMaxAgeSeconds";
+
+/// The default number of playlist entries to download ahead of the one playing.
+static const int DEFAULT_PREFETCH_DEPTH = 0;
+
+/// The default maximum number of bytes of playlist entries to download ahead.
+static const int DEFAULT_PREFETCH_MAX_BYTES = 4 * 1024 * 1024;
+
+/// The default number of seconds a playlist entry downloaded ahead remains usable.
+static const int DEFAULT_PREFETCH_MAX_AGE_SECONDS = 60;
+
+/// Configuration key for how many seconds the entries a playlist was resolved to are reused for.  0 disables this.
+static const std::string CONFIG_KEY_PLAYLIST_CACHE_TTL_SECONDS = "playlistCacheTtlSeconds";
+
+/// Configuration key for the largest number of playlist resolutions kept.
+static const std::string CONFIG_KEY_PLAYLIST_CACHE_MAX_ENTRIES = "playlistCacheMaxEntries";
+
+/// The default number of seconds the entries a playlist was resolved to are reused for.
+static const int DEFAULT_PLAYLIST_CACHE_TTL_SECONDS = 300;
+
+/// The default largest number of playlist resolutions kept.
+static const int DEFAULT_PLAYLIST_CACHE_MAX_ENTRIES = 16;
+
+/// Configuration key for the initial size of the buffer of url sources.  0 leaves it to GStreamer.
+static const std::string CONFIG_KEY_BUFFER_SIZE_BYTES = "bufferSizeBytes";
+
+/// Configuration key for the initial duration of the buffer of url sources.  0 leaves it to GStreamer.
+static const std::string CONFIG_KEY_BUFFER_DURATION_MS = "bufferDurationMs";
+
+/// Configuration key for the size the buffer of url sources may grow to.
+static const std::string CONFIG_KEY_MAX_BUFFER_SIZE_BYTES = "maxBufferSizeBytes";
+
+/// Configuration key for the duration the buffer of url sources may grow to.
+static const std::string CONFIG_KEY_MAX_BUFFER_DURATION_MS = "maxBufferDurationMs";
+
+/// Configuration key for the number of buffer underruns after which the buffer grows.  0 never grows it.
+static const std::string CONFIG_KEY_UNDERRUNS_BEFORE_BUFFER_GROWTH = "underrunsBeforeBufferGrowth";
+
+/// The default size the buffer of url sources may grow to.
+static const int DEFAULT_MAX_BUFFER_SIZE_BYTES = 8 * 1024 * 1024;
+
+/// The default duration the buffer of url sources may grow to.
+static const int DEFAULT_MAX_BUFFER_DURATION_MS = 10000;
+
+/// The default number of buffer underruns after which the buffer grows.
+static const int DEFAULT_UNDERRUNS_BEFORE_BUFFER_GROWTH = 2;
+
+/// The number of nanoseconds in a millisecond, the unit of the @c buffer-duration of @c uridecodebin.
+static const gint64 NANOSECONDS_PER_MILLISECOND = 1000000;
+
+/// Key under "mediaPlayer" for whether attachments are played through a persistent MP3 decoder.
+static const std::string CONFIG_KEY_PERSISTENT_MP3_PIPELINE = "persistentMp3Pipeline";
+
+/// Key under "mediaPlayer" for the volume, in percent, the output drops to at once when the user barges in.
+static const std::string CONFIG_KEY_BARGE_IN_VOLUME_PERCENT = "bargeInVolumePercent";
+
+/// The volume, in percent, the output drops to when the user barges in, unless configured otherwise.
+static const int DEFAULT_BARGE_IN_VOLUME_PERCENT = 10;
+
+/// The volume of the output until it is set.
+static const double FULL_VOLUME = 1.0;
+
+/// Key under "mediaPlayer" for the name of the GStreamer sink element to play to, such as "alsasink".
+static const std::string CONFIG_KEY_AUDIO_SINK = "audioSink";
+
+/// Key under "mediaPlayer" for the "device" property of the sink, such as "hw:0,0" for @c alsasink.
+static const std::string CONFIG_KEY_AUDIO_SINK_DEVICE = "audioSinkDevice";
+
+/// Key under "mediaPlayer" for the "buffer-time" property of the sink, in microseconds.
+static const std::string CONFIG_KEY_AUDIO_SINK_BUFFER_TIME = "audioSinkBufferTimeUs";
+
+/// Key under "mediaPlayer" for the "latency-time" property of the sink, in microseconds.
+static const std::string CONFIG_KEY_AUDIO_SINK_LATENCY_TIME = "audioSinkLatencyTimeUs";
+
+/// Key under "mediaPlayer" for the sample rate to convert all audio to before the sink.  0 leaves it to the sink.
+static const std::string CONFIG_KEY_OUTPUT_SAMPLE_RATE = "outputSampleRate";
+
+/// Key under "mediaPlayer" for the number of channels to convert all audio to before the sink.  0 leaves it to the
+/// sink.
+static const std::string CONFIG_KEY_OUTPUT_CHANNELS = "outputChannels";
+
+/// The sink used when none is configured, which probes for the platform's sink on start.
+static const std::string DEFAULT_AUDIO_SINK = "autoaudiosink";
+
+/// Key under "mediaPlayer" for the path of a GStreamer registry cache generated ahead of time, such as at install.
+static const std::string CONFIG_KEY_GSTREAMER_REGISTRY_PATH = "gstreamerRegistryPath";
+
+/// Key under "mediaPlayer" for whether GStreamer checks the plugins against the registry cache when it starts.
+static const std::string CONFIG_KEY_GSTREAMER_REGISTRY_UPDATE = "gstreamerRegistryUpdate";
+
+/// Key under "mediaPlayer" for whether the pipeline is created when it is first needed instead of by @c create().
+static const std::string CONFIG_KEY_LAZY_PIPELINE = "lazyPipeline";
+
+/// Key under "mediaPlayer" for whether a lazily created pipeline is created on the main loop as soon as it is idle.
+static const std::string CONFIG_KEY_PREWARM_PIPELINE = "prewarmPipeline";
+
 /// Timeout value for calls to @c gst_element_get_state() calls.
 static const unsigned int TIMEOUT_ZERO_NANOSECONDS(0);
 
+/// The least time between logs of buffering messages, which are posted for each change of the buffered percentage.
+static const std::chrono::seconds BUS_MESSAGE_LOG_INTERVAL(1);
+
+/**
+ * Initializes GStreamer, pointing it at the configured registry cache first.  The variables already set in the
+ * environment of the process take precedence, as they do for the GStreamer tools.
+ *
+ * @param config The configuration of the @c MediaPlayer.
+ * @return Whether GStreamer was initialized.
+ */
+static bool initializeGStreamer(const configuration::ConfigurationNode& config) {
+    std::string registryPath;
+    config.getString(CONFIG_KEY_GSTREAMER_REGISTRY_PATH, &registryPath);
+    if (!registryPath.empty()) {
+        g_setenv("GST_REGISTRY", registryPath.c_str(), FALSE);
+        bool updateRegistry = true;
+        config.getBool(CONFIG_KEY_GSTREAMER_REGISTRY_UPDATE, &updateRegistry, true);
+        if (!updateRegistry) {
+            // Trust the cache as it is, instead of checking every plugin file for changes.
+            g_setenv("GST_REGISTRY_UPDATE", "no", FALSE);
+        }
+        ACSDK_DEBUG5(LX("initializeGStreamer").d("registryPath", registryPath).d("updateRegistry", updateRegistry));
+    }
+    GError* error = nullptr;
+    if (!gst_init_check(nullptr, nullptr, &error)) {
+        ACSDK_ERROR(LX("initializeGStreamerFailed").d("reason", error ? error->message : "unknown"));
+        if (error) {
+            g_error_free(error);
+        }
+        return false;
+    }
+    return true;
+}
+
 std::shared_ptr<MediaPlayer> MediaPlayer::create(
-    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) {
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    std::shared_ptr<avsCommon::avs::AudioInputStream> playbackReferenceStream) {
     ACSDK_DEBUG9(LX("createCalled"));
-    std::shared_ptr<MediaPlayer> mediaPlayer(new MediaPlayer(contentFetcherFactory));
+    std::shared_ptr<MediaPlayer> mediaPlayer(new MediaPlayer(contentFetcherFactory, playbackReferenceStream));
     if (mediaPlayer->init()) {
         return mediaPlayer;
     } else {
@@ -70,14 +215,23 @@ MediaPlayer::~MediaPlayer() {
     if (m_setSourceThread.joinable()) {
         m_setSourceThread.join();
     }
-    g_main_loop_quit(m_mainLoop);
-    if (m_mainLoopThread.joinable()) {
-        m_mainLoopThread.join();
+    // The loop keeps running for the other players, so stop watching the bus from it, after which no more bus
+    // messages are dispatched to this player.
+    if (m_busWatchId) {
+        std::promise<void> promise;
+        auto future = promise.get_future();
+        std::function<gboolean()> callback = [this, &promise]() {
+            g_source_remove(m_busWatchId);
+            promise.set_value();
+            return false;
+        };
+        queueCallback(&callback);
+        future.wait();
+    }
+    if (m_pipeline.pipeline) {
+        gst_object_unref(m_pipeline.pipeline);
     }
-    gst_object_unref(m_pipeline.pipeline);
     resetPipeline();
-    g_source_remove(m_busWatchId);
-    g_main_loop_unref(m_mainLoop);
 }
 
 MediaPlayerStatus MediaPlayer::setSource(std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader) {
@@ -92,6 +246,20 @@ MediaPlayerStatus MediaPlayer::setSource(std::shared_ptr<avsCommon::avs::attachm
     return future.get();
 }
 
+MediaPlayerStatus MediaPlayer::setSource(
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+    SourceFormat format) {
+    ACSDK_DEBUG9(LX("setSourceCalled").d("sourceType", "AttachmentReader").d("format", static_cast<int>(format)));
+    std::promise<MediaPlayerStatus> promise;
+    auto future = promise.get_future();
+    std::function<gboolean()> callback = [this, &promise, &reader, format]() {
+        handleSetAttachmentReaderSource(&promise, std::move(reader), format);
+        return false;
+    };
+    queueCallback(&callback);
+    return future.get();
+}
+
 MediaPlayerStatus MediaPlayer::setSource(std::shared_ptr<std::istream> stream, bool repeat) {
     ACSDK_DEBUG9(LX("setSourceCalled").d("sourceType", "istream"));
     std::promise<MediaPlayerStatus> promise;
@@ -104,6 +272,18 @@ MediaPlayerStatus MediaPlayer::setSource(std::shared_ptr<std::istream> stream, b
     return future.get();
 }
 
+MediaPlayerStatus MediaPlayer::setFileSource(const std::string& path, bool repeat) {
+    ACSDK_DEBUG9(LX("setSourceCalled").d("sourceType", "File").d("path", path));
+    std::promise<MediaPlayerStatus> promise;
+    auto future = promise.get_future();
+    std::function<gboolean()> callback = [this, &promise, &path, repeat]() {
+        handleSetFileSource(&promise, path, repeat);
+        return false;
+    };
+    queueCallback(&callback);
+    return future.get();
+}
+
 MediaPlayerStatus MediaPlayer::setSource(const std::string& url) {
     ACSDK_DEBUG9(LX("setSourceForUrlCalled").sensitive("url", url));
     std::promise<MediaPlayerStatus> promise;
@@ -191,29 +371,116 @@ MediaPlayerStatus MediaPlayer::resume() {
 }
 
 std::chrono::milliseconds MediaPlayer::getOffset() {
-    ACSDK_DEBUG9(LX("getOffsetCalled"));
-    std::promise<std::chrono::milliseconds> promise;
+    auto offset = m_sampleOffsetTracker.getOffset();
+    ACSDK_DEBUG9(LX("getOffsetCalled").d("offsetInMs", offset.count()));
+    return offset.count() < 0 ? MEDIA_PLAYER_INVALID_OFFSET : offset;
+}
+
+void MediaPlayer::setSourceAsync(
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+    StatusCallback onCompleted) {
+    ACSDK_DEBUG9(LX("setSourceAsyncCalled").d("sourceType", "AttachmentReader"));
+    queueAsyncHandler(
+        [this, reader](std::promise<MediaPlayerStatus>* promise) { handleSetAttachmentReaderSource(promise, reader); },
+        std::move(onCompleted));
+}
+
+void MediaPlayer::setSourceAsync(const std::string& url, StatusCallback onCompleted) {
+    auto status = setSource(url);
+    if (onCompleted) {
+        onCompleted(status);
+    }
+}
+
+void MediaPlayer::setSourceAsync(std::shared_ptr<std::istream> stream, bool repeat, StatusCallback onCompleted) {
+    ACSDK_DEBUG9(LX("setSourceAsyncCalled").d("sourceType", "istream"));
+    queueAsyncHandler(
+        [this, stream, repeat](std::promise<MediaPlayerStatus>* promise) {
+            handleSetIStreamSource(promise, stream, repeat);
+        },
+        std::move(onCompleted));
+}
+
+void MediaPlayer::playAsync(StatusCallback onCompleted) {
+    ACSDK_DEBUG9(LX("playAsyncCalled"));
+    queueAsyncHandler(
+        [this](std::promise<MediaPlayerStatus>* promise) {
+            // The source is checked on the main event loop, after any source set by an earlier setSourceAsync().
+            if (!m_source) {
+                ACSDK_ERROR(LX("playAsyncFailed").d("reason", "sourceNotSet"));
+                promise->set_value(MediaPlayerStatus::FAILURE);
+                return;
+            }
+            // A url source may wait here for its playlist parser, which runs on a thread of its own.
+            m_source->preprocess();
+            handlePlay(promise);
+        },
+        std::move(onCompleted));
+}
+
+void MediaPlayer::stopAsync(StatusCallback onCompleted) {
+    ACSDK_DEBUG9(LX("stopAsyncCalled"));
+    queueAsyncHandler(
+        [this](std::promise<MediaPlayerStatus>* promise) { handleStop(promise); }, std::move(onCompleted));
+}
+
+void MediaPlayer::pauseAsync(StatusCallback onCompleted) {
+    ACSDK_DEBUG9(LX("pauseAsyncCalled"));
+    queueAsyncHandler(
+        [this](std::promise<MediaPlayerStatus>* promise) { handlePause(promise); }, std::move(onCompleted));
+}
+
+void MediaPlayer::resumeAsync(StatusCallback onCompleted) {
+    ACSDK_DEBUG9(LX("resumeAsyncCalled"));
+    queueAsyncHandler(
+        [this](std::promise<MediaPlayerStatus>* promise) { handleResume(promise); }, std::move(onCompleted));
+}
+
+MediaPlayerStatus MediaPlayer::setOffset(std::chrono::milliseconds offset) {
+    ACSDK_DEBUG9(LX("setOffsetCalled"));
+    std::promise<MediaPlayerStatus> promise;
     auto future = promise.get_future();
-    std::function<gboolean()> callback = [this, &promise]() {
-        handleGetOffset(&promise);
+    std::function<gboolean()> callback = [this, &promise, offset]() {
+        handleSetOffset(&promise, offset);
         return false;
     };
     queueCallback(&callback);
     return future.get();
 }
 
-MediaPlayerStatus MediaPlayer::setOffset(std::chrono::milliseconds offset) {
-    ACSDK_DEBUG9(LX("setOffsetCalled"));
+MediaPlayerStatus MediaPlayer::setVolume(double volume) {
+    ACSDK_DEBUG9(LX("setVolumeCalled").d("volume", volume));
     std::promise<MediaPlayerStatus> promise;
     auto future = promise.get_future();
-    std::function<gboolean()> callback = [this, &promise, offset]() {
-        handleSetOffset(&promise, offset);
+    std::function<gboolean()> callback = [this, &promise, volume]() {
+        handleSetVolume(&promise, volume);
         return false;
     };
     queueCallback(&callback);
     return future.get();
 }
 
+void MediaPlayer::attenuateForBargeIn() {
+    ACSDK_DEBUG5(LX("attenuateForBargeIn").d("volume", m_bargeInVolume));
+    std::lock_guard<std::mutex> lock(m_volumeMutex);
+    if (m_isAttenuatedForBargeIn || !m_pipeline.volume || m_volume <= m_bargeInVolume) {
+        return;
+    }
+    m_isAttenuatedForBargeIn = true;
+    // The volume element locks its own properties, so this need not wait for the main loop.
+    g_object_set(m_pipeline.volume, "volume", m_bargeInVolume, nullptr);
+}
+
+void MediaPlayer::releaseBargeInAttenuation() {
+    std::lock_guard<std::mutex> lock(m_volumeMutex);
+    if (!m_isAttenuatedForBargeIn) {
+        return;
+    }
+    ACSDK_DEBUG5(LX("releaseBargeInAttenuation").d("volume", m_volume));
+    m_isAttenuatedForBargeIn = false;
+    g_object_set(m_pipeline.volume, "volume", m_volume, nullptr);
+}
+
 void MediaPlayer::setObserver(std::shared_ptr<MediaPlayerObserverInterface> observer) {
     ACSDK_DEBUG9(LX("setObserverCalled"));
     std::promise<void> promise;
@@ -247,8 +514,17 @@ GstElement* MediaPlayer::getPipeline() const {
 }
 
 MediaPlayer::MediaPlayer(
-    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) :
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    std::shared_ptr<avsCommon::avs::AudioInputStream> playbackReferenceStream) :
         m_contentFetcherFactory{contentFetcherFactory},
+        m_playbackReferenceStream{playbackReferenceStream},
+        m_bargeInVolume{DEFAULT_BARGE_IN_VOLUME_PERCENT / 100.0},
+        m_volume{FULL_VOLUME},
+        m_isAttenuatedForBargeIn{false},
+        m_busWatchId{0},
+        m_usePersistentMp3Pipeline{false},
+        m_hasPersistentElements{false},
+        m_pipelineSetupFailed{false},
         m_playbackStartedSent{false},
         m_playbackFinishedSent{false},
         m_isPaused{false},
@@ -257,23 +533,101 @@ MediaPlayer::MediaPlayer(
 }
 
 bool MediaPlayer::init() {
-    if (false == gst_init_check(NULL, NULL, NULL)) {
+    auto config = configuration::ConfigurationNode::getRoot()[CONFIG_KEY_MEDIA_PLAYER];
+    // GStreamer is initialized once per process, by the first player.
+    static const bool isGStreamerInitialized = initializeGStreamer(config);
+    if (!isGStreamerInitialized) {
         ACSDK_ERROR(LX("initPlayerFailed").d("reason", "gstInitCheckFailed"));
         return false;
     }
 
-    if (!(m_mainLoop = g_main_loop_new(nullptr, false))) {
-        ACSDK_ERROR(LX("initPlayerFailed").d("reason", "gstMainLoopNewFailed"));
+    if (!(m_mainLoop = SharedMainLoop::acquire())) {
+        ACSDK_ERROR(LX("initPlayerFailed").d("reason", "acquireMainLoopFailed"));
         return false;
     };
 
-    m_mainLoopThread = std::thread(g_main_loop_run, m_mainLoop);
+    bool lazyPipeline = false;
+    config.getBool(CONFIG_KEY_LAZY_PIPELINE, &lazyPipeline, false);
+    if (!lazyPipeline) {
+        if (!setupPipeline()) {
+            ACSDK_ERROR(LX("initPlayerFailed").d("reason", "setupPipelineFailed"));
+            return false;
+        }
+    } else {
+        bool prewarmPipeline = true;
+        config.getBool(CONFIG_KEY_PREWARM_PIPELINE, &prewarmPipeline, true);
+        if (prewarmPipeline) {
+            /*
+             * Create the pipeline once the main loop has nothing else to do, so that the first use usually finds it
+             * ready without create() having waited for it.  This is queued like the async handlers, so it runs before
+             * the callbacks the destructor waits for.
+             */
+            auto callback = new std::function<gboolean()>([this]() {
+                ensurePipeline();
+                return false;
+            });
+            g_idle_add_full(
+                G_PRIORITY_DEFAULT_IDLE, reinterpret_cast<GSourceFunc>(&onCallback), callback, &deleteAsyncCallback);
+        }
+    }
+
+    config.getBool(CONFIG_KEY_PERSISTENT_MP3_PIPELINE, &m_usePersistentMp3Pipeline, false);
 
+    int bargeInVolumePercent = DEFAULT_BARGE_IN_VOLUME_PERCENT;
+    config.getInt(CONFIG_KEY_BARGE_IN_VOLUME_PERCENT, &bargeInVolumePercent, DEFAULT_BARGE_IN_VOLUME_PERCENT);
+    if (bargeInVolumePercent < 0 || bargeInVolumePercent > 100) {
+        ACSDK_WARN(LX("invalidBargeInVolume").d("percent", bargeInVolumePercent));
+        bargeInVolumePercent = DEFAULT_BARGE_IN_VOLUME_PERCENT;
+    }
+    m_bargeInVolume = bargeInVolumePercent / 100.0;
+
+    int playlistCacheTtlSeconds = 0;
+    int playlistCacheMaxEntries = 0;
+    config.getInt(CONFIG_KEY_PLAYLIST_CACHE_TTL_SECONDS, &playlistCacheTtlSeconds, DEFAULT_PLAYLIST_CACHE_TTL_SECONDS);
+    config.getInt(CONFIG_KEY_PLAYLIST_CACHE_MAX_ENTRIES, &playlistCacheMaxEntries, DEFAULT_PLAYLIST_CACHE_MAX_ENTRIES);
+    if (playlistCacheTtlSeconds > 0 && playlistCacheMaxEntries > 0) {
+        m_playlistCache = alexaClientSDK::playlistParser::PlaylistCache::create(
+            std::chrono::seconds(playlistCacheTtlSeconds), playlistCacheMaxEntries);
+    }
+
+    int bufferSizeBytes = 0;
+    int bufferDurationMs = 0;
+    int maxBufferSizeBytes = 0;
+    int maxBufferDurationMs = 0;
+    int underrunsBeforeGrowth = 0;
+    config.getInt(CONFIG_KEY_BUFFER_SIZE_BYTES, &bufferSizeBytes, 0);
+    config.getInt(CONFIG_KEY_BUFFER_DURATION_MS, &bufferDurationMs, 0);
+    config.getInt(CONFIG_KEY_MAX_BUFFER_SIZE_BYTES, &maxBufferSizeBytes, DEFAULT_MAX_BUFFER_SIZE_BYTES);
+    config.getInt(CONFIG_KEY_MAX_BUFFER_DURATION_MS, &maxBufferDurationMs, DEFAULT_MAX_BUFFER_DURATION_MS);
+    config.getInt(
+        CONFIG_KEY_UNDERRUNS_BEFORE_BUFFER_GROWTH, &underrunsBeforeGrowth, DEFAULT_UNDERRUNS_BEFORE_BUFFER_GROWTH);
+    m_adaptiveBuffering = AdaptiveBuffering::create(
+        bufferSizeBytes,
+        std::chrono::milliseconds(bufferDurationMs),
+        maxBufferSizeBytes,
+        std::chrono::milliseconds(maxBufferDurationMs),
+        underrunsBeforeGrowth);
+    if (!m_adaptiveBuffering) {
+        ACSDK_WARN(LX("adaptiveBufferingDisabled").d("reason", "invalidConfiguration"));
+    }
+
+    return true;
+}
+
+bool MediaPlayer::ensurePipeline() {
+    if (m_pipeline.pipeline) {
+        return true;
+    }
+    // Trying again would not go any better, and would leak the elements the failed attempt made.
+    if (m_pipelineSetupFailed) {
+        return false;
+    }
+    ACSDK_DEBUG5(LX("ensurePipeline").m("creating the pipeline"));
     if (!setupPipeline()) {
-        ACSDK_ERROR(LX("initPlayerFailed").d("reason", "setupPipelineFailed"));
+        ACSDK_ERROR(LX("ensurePipelineFailed").d("reason", "setupPipelineFailed"));
+        m_pipelineSetupFailed = true;
         return false;
     }
-
     return true;
 }
 
@@ -284,9 +638,50 @@ bool MediaPlayer::setupPipeline() {
         return false;
     }
 
-    m_pipeline.audioSink = gst_element_factory_make("autoaudiosink", "audio_sink");
+    auto volume = gst_element_factory_make("volume", "volume");
+    if (!volume) {
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createVolumeElementFailed"));
+        return false;
+    }
+    {
+        // attenuateForBargeIn() reads the element off the main loop, and a volume set before a lazily created
+        // pipeline existed applies from its start.
+        std::lock_guard<std::mutex> lock(m_volumeMutex);
+        g_object_set(volume, "volume", m_volume, nullptr);
+        m_pipeline.volume = volume;
+    }
+    // All decoded audio passes the volume element, whichever source and decoder it came from.
+    GstPad* volumePad = gst_element_get_static_pad(m_pipeline.volume, "sink");
+    gst_pad_add_probe(
+        volumePad,
+        static_cast<GstPadProbeType>(GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM),
+        &MediaPlayer::onPlaybackProbe,
+        this,
+        nullptr);
+    gst_object_unref(volumePad);
+
+    auto config = configuration::ConfigurationNode::getRoot()[CONFIG_KEY_MEDIA_PLAYER];
+    std::string sinkName;
+    config.getString(CONFIG_KEY_AUDIO_SINK, &sinkName, DEFAULT_AUDIO_SINK);
+    m_pipeline.audioSink = gst_element_factory_make(sinkName.c_str(), "audio_sink");
     if (!m_pipeline.audioSink) {
-        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createAudioSinkElementFailed"));
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createAudioSinkElementFailed").d("audioSink", sinkName));
+        return false;
+    }
+    if (!configureAudioSink(config)) {
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "configureAudioSinkFailed").d("audioSink", sinkName));
+        return false;
+    }
+
+    if (m_playbackReferenceStream &&
+        !(m_playbackReferenceTap = PlaybackReferenceTap::create(m_playbackReferenceStream))) {
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createPlaybackReferenceTapFailed"));
+        return false;
+    }
+
+    GstElement* outputFormat = nullptr;
+    if (!createOutputFormatElements(config, &outputFormat)) {
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createOutputFormatElementsFailed"));
         return false;
     }
 
@@ -301,9 +696,17 @@ bool MediaPlayer::setupPipeline() {
     gst_object_unref(bus);
 
     // Link only the converter and sink here. Src will be linked in respective source files.
-    gst_bin_add_many(GST_BIN(m_pipeline.pipeline), m_pipeline.converter, m_pipeline.audioSink, nullptr);
-
-    if (!gst_element_link(m_pipeline.converter, m_pipeline.audioSink)) {
+    gst_bin_add_many(
+        GST_BIN(m_pipeline.pipeline), m_pipeline.converter, m_pipeline.volume, m_pipeline.audioSink, nullptr);
+
+    if (outputFormat) {
+        gst_bin_add(GST_BIN(m_pipeline.pipeline), outputFormat);
+        if (!gst_element_link_many(m_pipeline.converter, m_pipeline.volume, outputFormat, nullptr) ||
+            !linkToAudioSink(outputFormat)) {
+            ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createConverterToSinkLinkFailed"));
+            return false;
+        }
+    } else if (!gst_element_link(m_pipeline.converter, m_pipeline.volume) || !linkToAudioSink(m_pipeline.volume)) {
         ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createConverterToSinkLinkFailed"));
         return false;
     }
@@ -311,10 +714,120 @@ bool MediaPlayer::setupPipeline() {
     return true;
 }
 
-void MediaPlayer::tearDownTransientPipelineElements() {
+bool MediaPlayer::linkToAudioSink(GstElement* element) {
+    if (!m_playbackReferenceTap) {
+        return gst_element_link(element, m_pipeline.audioSink);
+    }
+    auto tee = gst_element_factory_make("tee", "reference_tee");
+    auto queue = gst_element_factory_make("queue", "audio_sink_queue");
+    if (!tee || !queue) {
+        ACSDK_ERROR(LX("linkToAudioSinkFailed").d("reason", "createElementFailed"));
+        for (auto created : {tee, queue}) {
+            if (created) {
+                gst_object_unref(created);
+            }
+        }
+        return false;
+    }
+    // The tap takes exactly what the sink is given, after the volume and the output format.
+    gst_bin_add_many(GST_BIN(m_pipeline.pipeline), tee, queue, m_playbackReferenceTap->getBin(), nullptr);
+    return gst_element_link_many(element, tee, queue, m_pipeline.audioSink, nullptr) &&
+           gst_element_link(tee, m_playbackReferenceTap->getBin());
+}
+
+bool MediaPlayer::configureAudioSink(const configuration::ConfigurationNode& config) {
+    GObjectClass* sinkClass = G_OBJECT_GET_CLASS(m_pipeline.audioSink);
+
+    std::string device;
+    if (config.getString(CONFIG_KEY_AUDIO_SINK_DEVICE, &device) && !device.empty()) {
+        if (!g_object_class_find_property(sinkClass, "device")) {
+            ACSDK_ERROR(LX("configureAudioSinkFailed").d("reason", "sinkHasNoDeviceProperty"));
+            return false;
+        }
+        g_object_set(m_pipeline.audioSink, "device", device.c_str(), nullptr);
+    }
+
+    // buffer-time and latency-time are properties of GstAudioBaseSink, which all the audio output sinks derive from.
+    const std::pair<std::string, const char*> timeProperties[] = {
+        {CONFIG_KEY_AUDIO_SINK_BUFFER_TIME, "buffer-time"}, {CONFIG_KEY_AUDIO_SINK_LATENCY_TIME, "latency-time"}};
+    for (const auto& timeProperty : timeProperties) {
+        int microseconds = 0;
+        if (!config.getInt(timeProperty.first, &microseconds) || microseconds <= 0) {
+            continue;
+        }
+        if (!g_object_class_find_property(sinkClass, timeProperty.second)) {
+            ACSDK_ERROR(LX("configureAudioSinkFailed")
+                            .d("reason", "sinkHasNoTimeProperty")
+                            .d("property", timeProperty.second));
+            return false;
+        }
+        g_object_set(m_pipeline.audioSink, timeProperty.second, static_cast<gint64>(microseconds), nullptr);
+    }
+    return true;
+}
+
+bool MediaPlayer::createOutputFormatElements(const configuration::ConfigurationNode& config, GstElement** bin) {
+    *bin = nullptr;
+    int sampleRate = 0;
+    int channels = 0;
+    config.getInt(CONFIG_KEY_OUTPUT_SAMPLE_RATE, &sampleRate);
+    config.getInt(CONFIG_KEY_OUTPUT_CHANNELS, &channels);
+    if (sampleRate <= 0 && channels <= 0) {
+        return true;
+    }
+
+    GstElement* resampler = gst_element_factory_make("audioresample", "resampler");
+    GstElement* capsFilter = gst_element_factory_make("capsfilter", "output_format");
+    if (!resampler || !capsFilter) {
+        ACSDK_ERROR(LX("createOutputFormatElementsFailed").d("reason", "createElementFailed"));
+        return false;
+    }
+
+    // Pin the format the sink sees, so that it is negotiated once to the output's native format rather than to
+    // whatever each stream carries.
+    GstCaps* caps = gst_caps_new_empty_simple("audio/x-raw");
+    if (sampleRate > 0) {
+        gst_caps_set_simple(caps, "rate", G_TYPE_INT, sampleRate, nullptr);
+    }
+    if (channels > 0) {
+        gst_caps_set_simple(caps, "channels", G_TYPE_INT, channels, nullptr);
+    }
+    g_object_set(capsFilter, "caps", caps, nullptr);
+    gst_caps_unref(caps);
+
+    *bin = gst_bin_new("output_format_bin");
+    gst_bin_add_many(GST_BIN(*bin), resampler, capsFilter, nullptr);
+    if (!gst_element_link(resampler, capsFilter)) {
+        ACSDK_ERROR(LX("createOutputFormatElementsFailed").d("reason", "linkResamplerToCapsFilterFailed"));
+        gst_object_unref(*bin);
+        *bin = nullptr;
+        return false;
+    }
+    GstPad* sinkPad = gst_element_get_static_pad(resampler, "sink");
+    GstPad* srcPad = gst_element_get_static_pad(capsFilter, "src");
+    gst_element_add_pad(*bin, gst_ghost_pad_new("sink", sinkPad));
+    gst_element_add_pad(*bin, gst_ghost_pad_new("src", srcPad));
+    gst_object_unref(sinkPad);
+    gst_object_unref(srcPad);
+    ACSDK_INFO(LX("outputFormatPinned").d("sampleRate", sampleRate).d("channels", channels));
+    return true;
+}
+
+void MediaPlayer::tearDownTransientPipelineElements(bool keepPersistentElements) {
     ACSDK_DEBUG9(LX("tearDownTransientPipelineElements"));
     if (m_pipeline.pipeline) {
         doStop();
+        // Stop any thread of the source which pushes into the appsrc element before the element goes away.
+        if (m_source) {
+            m_source->terminate();
+        }
+        if (keepPersistentElements && m_hasPersistentElements) {
+            // The old source must let go of the appsrc element before the next one takes it over.
+            m_source.reset();
+            m_offsetManager.clear();
+            return;
+        }
+        m_hasPersistentElements = false;
         if (m_pipeline.appsrc) {
             gst_bin_remove(GST_BIN(m_pipeline.pipeline), GST_ELEMENT(m_pipeline.appsrc));
         }
@@ -328,12 +841,63 @@ void MediaPlayer::tearDownTransientPipelineElements() {
     m_offsetManager.clear();
 }
 
+bool MediaPlayer::setupPersistentMp3Elements() {
+    auto appsrc = reinterpret_cast<GstAppSrc*>(gst_element_factory_make("appsrc", "src"));
+    auto parser = gst_element_factory_make("mpegaudioparse", "mp3_parser");
+    auto mp3Decoder = gst_element_factory_make("mpg123audiodec", "mp3_decoder");
+    auto decoder = gst_bin_new("decoder");
+    if (!appsrc || !parser || !mp3Decoder || !decoder) {
+        ACSDK_ERROR(LX("setupPersistentMp3ElementsFailed").d("reason", "createElementFailed"));
+        for (auto element : {reinterpret_cast<GstElement*>(appsrc), parser, mp3Decoder, decoder}) {
+            if (element) {
+                gst_object_unref(element);
+            }
+        }
+        return false;
+    }
+    gst_app_src_set_stream_type(appsrc, GST_APP_STREAM_TYPE_STREAM);
+    // Declaring the format spares the parser typefinding the start of each stream.
+    auto caps = gst_caps_new_simple("audio/mpeg", "mpegversion", G_TYPE_INT, 1, nullptr);
+    gst_app_src_set_caps(appsrc, caps);
+    gst_caps_unref(caps);
+
+    // Wrap the parser and the decoder in a bin with the pads of a decoder, so it can stand in for a decodebin.
+    gst_bin_add_many(GST_BIN(decoder), parser, mp3Decoder, nullptr);
+    auto sinkPad = gst_element_get_static_pad(parser, "sink");
+    auto srcPad = gst_element_get_static_pad(mp3Decoder, "src");
+    bool isBinReady = gst_element_link(parser, mp3Decoder) &&
+                      gst_element_add_pad(decoder, gst_ghost_pad_new("sink", sinkPad)) &&
+                      gst_element_add_pad(decoder, gst_ghost_pad_new("src", srcPad));
+    gst_object_unref(sinkPad);
+    gst_object_unref(srcPad);
+    if (!isBinReady) {
+        ACSDK_ERROR(LX("setupPersistentMp3ElementsFailed").d("reason", "createDecoderBinFailed"));
+        gst_object_unref(appsrc);
+        gst_object_unref(decoder);
+        return false;
+    }
+
+    gst_bin_add_many(GST_BIN(m_pipeline.pipeline), reinterpret_cast<GstElement*>(appsrc), decoder, nullptr);
+    if (!gst_element_link_many(reinterpret_cast<GstElement*>(appsrc), decoder, m_pipeline.converter, nullptr)) {
+        ACSDK_ERROR(LX("setupPersistentMp3ElementsFailed").d("reason", "linkElementsFailed"));
+        gst_bin_remove(GST_BIN(m_pipeline.pipeline), reinterpret_cast<GstElement*>(appsrc));
+        gst_bin_remove(GST_BIN(m_pipeline.pipeline), decoder);
+        return false;
+    }
+
+    m_pipeline.appsrc = appsrc;
+    m_pipeline.decoder = decoder;
+    m_hasPersistentElements = true;
+    return true;
+}
+
 void MediaPlayer::resetPipeline() {
     ACSDK_DEBUG9(LX("resetPipeline"));
     m_pipeline.pipeline = nullptr;
     m_pipeline.appsrc = nullptr;
     m_pipeline.decoder = nullptr;
     m_pipeline.converter = nullptr;
+    m_pipeline.volume = nullptr;
     m_pipeline.audioSink = nullptr;
 }
 
@@ -404,6 +968,64 @@ gboolean MediaPlayer::onCallback(const std::function<gboolean()>* callback) {
     return (*callback)();
 }
 
+void MediaPlayer::queueAsyncHandler(
+    std::function<void(std::promise<MediaPlayerStatus>*)> handler,
+    StatusCallback onCompleted) {
+    /*
+     * Nobody waits for this callback, so it is allocated here and deleted by the main event loop once it has run.
+     * The destructor waits for the main event loop, so the callbacks queued before it run while this still exists.
+     */
+    auto callback = new std::function<gboolean()>([handler, onCompleted]() {
+        std::promise<MediaPlayerStatus> promise;
+        auto future = promise.get_future();
+        handler(&promise);
+        auto status = future.get();
+        if (onCompleted) {
+            onCompleted(status);
+        }
+        return false;
+    });
+    g_idle_add_full(
+        G_PRIORITY_DEFAULT_IDLE, reinterpret_cast<GSourceFunc>(&onCallback), callback, &deleteAsyncCallback);
+}
+
+void MediaPlayer::deleteAsyncCallback(gpointer callback) {
+    delete static_cast<std::function<gboolean()>*>(callback);
+}
+
+GstPadProbeReturn MediaPlayer::onPlaybackProbe(GstPad* pad, GstPadProbeInfo* info, gpointer pointer) {
+    auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
+    if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER) {
+        mediaPlayer->m_sampleOffsetTracker.addBytes(gst_buffer_get_size(GST_PAD_PROBE_INFO_BUFFER(info)));
+        return GST_PAD_PROBE_OK;
+    }
+    GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+    switch (GST_EVENT_TYPE(event)) {
+        case GST_EVENT_CAPS: {
+            GstCaps* caps = nullptr;
+            GstAudioInfo audioInfo;
+            gst_event_parse_caps(event, &caps);
+            if (gst_audio_info_from_caps(&audioInfo, caps)) {
+                mediaPlayer->m_sampleOffsetTracker.setFormat(
+                    GST_AUDIO_INFO_RATE(&audioInfo), GST_AUDIO_INFO_BPF(&audioInfo));
+            }
+            break;
+        }
+        case GST_EVENT_SEGMENT: {
+            const GstSegment* segment = nullptr;
+            gst_event_parse_segment(event, &segment);
+            if (GST_FORMAT_TIME == segment->format) {
+                // A seek is followed by a segment starting at the new position.
+                mediaPlayer->m_sampleOffsetTracker.startSegment(std::chrono::nanoseconds(segment->time));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return GST_PAD_PROBE_OK;
+}
+
 void MediaPlayer::onPadAdded(GstElement* decoder, GstPad* pad, gpointer pointer) {
     ACSDK_DEBUG9(LX("onPadAddedCalled"));
     auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
@@ -474,6 +1096,10 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
                             .d("source", messageSrcName)
                             .d("error", error->message)
                             .d("debug", debug ? debug : "noInfo"));
+            if (m_playlistCache && !m_sourceUrl.empty()) {
+                // The url may have been resolved to entries which no longer play, so resolve it again next time.
+                m_playlistCache->invalidate(m_sourceUrl);
+            }
             sendPlaybackError(gerrorToErrorType(error, m_source->isPlaybackRemote()), error->message);
             g_error_free(error);
             g_free(debug);
@@ -496,6 +1122,7 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
                         sendPlaybackStarted();
                     } else {
                         if (m_isBufferUnderrun) {
+                            m_stutterMetrics.onStutterFinished();
                             sendBufferRefilled();
                             m_isBufferUnderrun = false;
                         } else if (m_isPaused) {
@@ -536,7 +1163,9 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
         case GST_MESSAGE_BUFFERING: {
             gint bufferPercent = 0;
             gst_message_parse_buffering(message, &bufferPercent);
-            ACSDK_DEBUG9(LX("handleBusMessage").d("message", "GST_MESSAGE_BUFFERING").d("percent", bufferPercent));
+            ACSDK_DEBUG9_RATE_LIMITED(
+                BUS_MESSAGE_LOG_INTERVAL,
+                LX("handleBusMessage").d("message", "GST_MESSAGE_BUFFERING").d("percent", bufferPercent));
 
             if (bufferPercent < 100) {
                 if (GST_STATE_CHANGE_FAILURE == gst_element_set_state(m_pipeline.pipeline, GST_STATE_PAUSED)) {
@@ -547,6 +1176,12 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
                 }
                 // Only enter bufferUnderrun after playback has started.
                 if (m_playbackStartedSent) {
+                    if (!m_isBufferUnderrun) {
+                        m_stutterMetrics.onStutterStarted();
+                        if (m_adaptiveBuffering && !m_sourceUrl.empty() && m_adaptiveBuffering->onBufferUnderrun()) {
+                            applyBufferSettings();
+                        }
+                    }
                     m_isBufferUnderrun = true;
                 }
             } else {
@@ -578,12 +1213,26 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
 
 void MediaPlayer::handleSetAttachmentReaderSource(
     std::promise<MediaPlayerStatus>* promise,
-    std::shared_ptr<AttachmentReader> reader) {
+    std::shared_ptr<AttachmentReader> reader,
+    SourceFormat format) {
     ACSDK_DEBUG(LX("handleSetSourceCalled"));
+    if (!ensurePipeline()) {
+        ACSDK_ERROR(LX("handleSetAttachmentReaderSourceFailed").d("reason", "noPipeline"));
+        promise->set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
 
-    tearDownTransientPipelineElements();
+    bool usePersistentMp3Pipeline = m_usePersistentMp3Pipeline || SourceFormat::MPEG == format;
+    tearDownTransientPipelineElements(usePersistentMp3Pipeline);
+    if (usePersistentMp3Pipeline && !m_hasPersistentElements && !setupPersistentMp3Elements()) {
+        ACSDK_WARN(LX("handleSetAttachmentReaderSource").d("action", "fallBackToDecodebin"));
+    }
+    m_sourceUrl.clear();
+    m_stutterMetrics.startStream();
 
-    m_source = AttachmentReaderSource::create(this, reader);
+    // The attachments played here are read with BLOCKING readers, so let the source wait on the writer for data.
+    m_source = AttachmentReaderSource::create(
+        this, reader, BaseStreamSource::DEFAULT_CHUNK_SIZE, AttachmentReaderSource::FeedMode::PUSH);
 
     if (!m_source) {
         ACSDK_ERROR(LX("handleSetAttachmentReaderSourceFailed").d("reason", "sourceIsNullptr"));
@@ -591,6 +1240,12 @@ void MediaPlayer::handleSetAttachmentReaderSource(
         return;
     }
 
+    // The persistent decoder is already linked to the converter.
+    if (m_hasPersistentElements) {
+        promise->set_value(MediaPlayerStatus::SUCCESS);
+        return;
+    }
+
     /*
      * Once the source pad for the decoder has been added, the decoder emits the pad-added signal. Connect the signal
      * to the callback which performs the linking of the decoder source pad to the converter sink pad.
@@ -609,9 +1264,16 @@ void MediaPlayer::handleSetIStreamSource(
     std::shared_ptr<std::istream> stream,
     bool repeat) {
     ACSDK_DEBUG(LX("handleSetSourceCalled"));
+    if (!ensurePipeline()) {
+        ACSDK_ERROR(LX("handleSetIStreamSourceFailed").d("reason", "noPipeline"));
+        promise->set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
 
     tearDownTransientPipelineElements();
 
+    m_sourceUrl.clear();
+    m_stutterMetrics.startStream();
     m_source = IStreamSource::create(this, stream, repeat);
 
     if (!m_source) {
@@ -633,15 +1295,85 @@ void MediaPlayer::handleSetIStreamSource(
     promise->set_value(MediaPlayerStatus::SUCCESS);
 }
 
+void MediaPlayer::handleSetFileSource(std::promise<MediaPlayerStatus>* promise, const std::string& path, bool repeat) {
+    ACSDK_DEBUG(LX("handleSetSourceCalled"));
+    if (!ensurePipeline()) {
+        ACSDK_ERROR(LX("handleSetFileSourceFailed").d("reason", "noPipeline"));
+        promise->set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
+
+    tearDownTransientPipelineElements();
+
+    m_sourceUrl.clear();
+    m_stutterMetrics.startStream();
+    m_source = FileSource::create(this, path, repeat);
+
+    if (!m_source) {
+        ACSDK_ERROR(LX("handleSetFileSourceFailed").d("reason", "sourceIsNullptr"));
+        promise->set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
+
+    /*
+     * Once the source pad for the decoder has been added, the decoder emits the pad-added signal. Connect the signal
+     * to the callback which performs the linking of the decoder source pad to the converter sink pad.
+     */
+    if (!g_signal_connect(m_pipeline.decoder, "pad-added", G_CALLBACK(onPadAdded), this)) {
+        ACSDK_ERROR(LX("handleSetFileSourceFailed").d("reason", "connectPadAddedSignalFailed"));
+        promise->set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
+
+    promise->set_value(MediaPlayerStatus::SUCCESS);
+}
+
+/**
+ * Create a @c SegmentPrefetcher as configured by the "mediaPlayer" configuration node.
+ *
+ * @param contentFetcherFactory The factory used to create the fetchers which download the entries.
+ * @return The new @c SegmentPrefetcher, or @c nullptr if prefetching is disabled.
+ */
+static std::unique_ptr<SegmentPrefetcher> createSegmentPrefetcher(
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) {
+    auto configuration = configuration::ConfigurationNode::getRoot()[CONFIG_KEY_MEDIA_PLAYER];
+    int depth = 0;
+    int maxBytes = 0;
+    int maxAgeSeconds = 0;
+    configuration.getInt(CONFIG_KEY_PREFETCH_DEPTH, &depth, DEFAULT_PREFETCH_DEPTH);
+    configuration.getInt(CONFIG_KEY_PREFETCH_MAX_BYTES, &maxBytes, DEFAULT_PREFETCH_MAX_BYTES);
+    configuration.getInt(CONFIG_KEY_PREFETCH_MAX_AGE_SECONDS, &maxAgeSeconds, DEFAULT_PREFETCH_MAX_AGE_SECONDS);
+    if (depth <= 0) {
+        return nullptr;
+    }
+    if (maxBytes <= 0 || maxAgeSeconds <= 0) {
+        ACSDK_ERROR(LX("createSegmentPrefetcherFailed").d("maxBytes", maxBytes).d("maxAgeSeconds", maxAgeSeconds));
+        return nullptr;
+    }
+    return SegmentPrefetcher::create(
+        contentFetcherFactory, depth, maxBytes, std::chrono::seconds(maxAgeSeconds));
+}
+
 void MediaPlayer::handleSetSource(std::promise<MediaPlayerStatus> promise, std::string url) {
     ACSDK_DEBUG(LX("handleSetSourceForUrlCalled"));
-    m_source =
-        UrlSource::create(this, alexaClientSDK::playlistParser::PlaylistParser::create(m_contentFetcherFactory), url);
+    if (!ensurePipeline()) {
+        ACSDK_ERROR(LX("handleSetSourceForUrlFailed").d("reason", "noPipeline"));
+        promise.set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
+    m_sourceUrl = url;
+    m_stutterMetrics.startStream();
+    m_source = UrlSource::create(
+        this,
+        alexaClientSDK::playlistParser::PlaylistParser::create(m_contentFetcherFactory, m_playlistCache),
+        url,
+        createSegmentPrefetcher(m_contentFetcherFactory));
     if (!m_source) {
         ACSDK_ERROR(LX("handleSetSourceForUrlFailed").d("reason", "sourceIsNullptr"));
         promise.set_value(MediaPlayerStatus::FAILURE);
         return;
     }
+    applyBufferSettings();
 
     /*
      * This works with audio only sources. This does not work for any source that has more than one stream.
@@ -661,6 +1393,7 @@ void MediaPlayer::handleSetSource(std::promise<MediaPlayerStatus> promise, std::
 
 void MediaPlayer::handlePlay(std::promise<MediaPlayerStatus>* promise) {
     ACSDK_DEBUG(LX("handlePlayCalled"));
+    releaseBargeInAttenuation();
 
     // If the player was in PLAYING state or was pending transition to PLAYING state, stop playing audio.
     if (MediaPlayerStatus::SUCCESS != doStop()) {
@@ -669,10 +1402,19 @@ void MediaPlayer::handlePlay(std::promise<MediaPlayerStatus>* promise) {
         return;
     }
 
+    if (!m_source) {
+        ACSDK_ERROR(LX("handlePlayFailed").d("reason", "sourceNotSet"));
+        promise->set_value(MediaPlayerStatus::FAILURE);
+        return;
+    }
+
     m_playbackFinishedSent = false;
 
-    gboolean attemptBuffering;
-    g_object_get(m_pipeline.decoder, "use-buffering", &attemptBuffering, NULL);
+    // Only a decodebin buffers; the persistent decoder plays attachments, which need no buffering.
+    gboolean attemptBuffering = FALSE;
+    if (!m_hasPersistentElements) {
+        g_object_get(m_pipeline.decoder, "use-buffering", &attemptBuffering, NULL);
+    }
     ACSDK_DEBUG(LX("handlePlay").d("attemptBuffering", attemptBuffering));
 
     GstState startingState = GST_STATE_PLAYING;
@@ -707,6 +1449,11 @@ void MediaPlayer::handleStop(std::promise<MediaPlayerStatus>* promise) {
 }
 
 MediaPlayerStatus MediaPlayer::doStop() {
+    // A pipeline which has not been created yet has nothing playing.
+    if (!m_pipeline.pipeline) {
+        ACSDK_DEBUG9(LX("doStopSuccess").d("reason", "noPipeline"));
+        return MediaPlayerStatus::SUCCESS;
+    }
     GstState state;
     GstState pending;
 
@@ -733,6 +1480,8 @@ MediaPlayerStatus MediaPlayer::doStop() {
             ACSDK_DEBUG9(LX("doStopPending"));
             return MediaPlayerStatus::PENDING;
         } else {
+            // The streaming threads have stopped, so nothing more will be counted for this stream.
+            m_sampleOffsetTracker.reset();
             sendPlaybackFinished();
         }
     }
@@ -779,6 +1528,7 @@ void MediaPlayer::handlePause(std::promise<MediaPlayerStatus>* promise) {
 
 void MediaPlayer::handleResume(std::promise<MediaPlayerStatus>* promise) {
     ACSDK_DEBUG(LX("handleResumeCalled"));
+    releaseBargeInAttenuation();
     if (!m_source) {
         ACSDK_ERROR(LX("handleResumeFailed").d("reason", "sourceNotSet"));
         promise->set_value(MediaPlayerStatus::FAILURE);
@@ -815,52 +1565,29 @@ void MediaPlayer::handleResume(std::promise<MediaPlayerStatus>* promise) {
     return;
 }
 
-void MediaPlayer::handleGetOffset(std::promise<std::chrono::milliseconds>* promise) {
-    ACSDK_DEBUG(LX("handleGetOffsetCalled"));
-    gint64 position = -1;
-    GstState state;
+void MediaPlayer::handleSetOffset(std::promise<MediaPlayerStatus>* promise, std::chrono::milliseconds offset) {
+    ACSDK_DEBUG(LX("handleSetOffsetCalled"));
+    m_offsetManager.setSeekPoint(offset);
+    promise->set_value(MediaPlayerStatus::SUCCESS);
+}
 
-    // Check if pipeline is set.
-    if (!m_pipeline.pipeline) {
-        ACSDK_INFO(LX("handleGetOffsetStopped").m("pipelineNotSet"));
-        promise->set_value(MEDIA_PLAYER_INVALID_OFFSET);
+void MediaPlayer::handleSetVolume(std::promise<MediaPlayerStatus>* promise, double volume) {
+    ACSDK_DEBUG(LX("handleSetVolumeCalled").d("volume", volume));
+    if (volume < 0.0 || volume > 1.0) {
+        ACSDK_ERROR(LX("handleSetVolumeFailed").d("reason", "volumeOutOfRange").d("volume", volume));
+        promise->set_value(MediaPlayerStatus::FAILURE);
         return;
     }
-
-    auto stateChangeRet = gst_element_get_state(m_pipeline.pipeline, &state, NULL, TIMEOUT_ZERO_NANOSECONDS);
-
-    if (GST_STATE_CHANGE_FAILURE == stateChangeRet) {
-        // Getting the state failed.
-        ACSDK_ERROR(LX("handleGetOffsetFailed").d("reason", "getElementGetStateFailure"));
-    } else if (GST_STATE_CHANGE_SUCCESS != stateChangeRet) {
-        // Getting the state was not successful (GST_STATE_CHANGE_ASYNC or GST_STATE_CHANGE_NO_PREROLL).
-        ACSDK_INFO(LX("handleGetOffset")
-                       .d("reason", "getElementGetStateUnsuccessful")
-                       .d("stateChangeReturn", gst_element_state_change_return_get_name(stateChangeRet)));
-    } else if (GST_STATE_PAUSED != state && GST_STATE_PLAYING != state) {
-        // Invalid State.
-        std::ostringstream expectedStates;
-        expectedStates << gst_element_state_get_name(GST_STATE_PAUSED) << "/"
-                       << gst_element_state_get_name(GST_STATE_PLAYING);
-        ACSDK_ERROR(LX("handleGetOffsetFailed")
-                        .d("reason", "invalidPipelineState")
-                        .d("state", gst_element_state_get_name(state))
-                        .d("expectedStates", expectedStates.str()));
-    } else if (!gst_element_query_position(m_pipeline.pipeline, GST_FORMAT_TIME, &position)) {
-        // Query Failed.
-        ACSDK_ERROR(LX("handleGetOffsetInMillisecondsFailed").d("reason", "gstElementQueryPositionError"));
-    } else {
-        // Query succeeded.
-        promise->set_value(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(position)));
-        return;
+    {
+        std::lock_guard<std::mutex> lock(m_volumeMutex);
+        m_volume = volume;
+        m_isAttenuatedForBargeIn = false;
+        // The volume element applies the change from the next buffer on, whatever the state of the pipeline.  A
+        // pipeline which has not been created yet starts at this volume.
+        if (m_pipeline.volume) {
+            g_object_set(m_pipeline.volume, "volume", volume, nullptr);
+        }
     }
-
-    promise->set_value(MEDIA_PLAYER_INVALID_OFFSET);
-}
-
-void MediaPlayer::handleSetOffset(std::promise<MediaPlayerStatus>* promise, std::chrono::milliseconds offset) {
-    ACSDK_DEBUG(LX("handleSetOffsetCalled"));
-    m_offsetManager.setSeekPoint(offset);
     promise->set_value(MediaPlayerStatus::SUCCESS);
 }
 
@@ -887,6 +1614,8 @@ void MediaPlayer::sendPlaybackFinished() {
         m_source->terminate();
     }
     m_source.reset();
+    m_stutterMetrics.onStutterFinished();
+    m_stutterMetrics.dump();
     m_isPaused = false;
     m_playbackStartedSent = false;
     if (!m_playbackFinishedSent) {
@@ -933,5 +1662,27 @@ void MediaPlayer::sendBufferRefilled() {
     }
 }
 
+void MediaPlayer::applyBufferSettings() {
+    if (!m_adaptiveBuffering || !m_pipeline.decoder) {
+        return;
+    }
+    // uridecodebin passes these on to the queue2 it buffers streams with, including one which is already buffering.
+    if (m_adaptiveBuffering->getBufferSizeBytes() > 0) {
+        g_object_set(
+            m_pipeline.decoder, "buffer-size", static_cast<gint>(m_adaptiveBuffering->getBufferSizeBytes()), NULL);
+    }
+    if (m_adaptiveBuffering->getBufferDuration().count() > 0) {
+        g_object_set(
+            m_pipeline.decoder,
+            "buffer-duration",
+            static_cast<gint64>(m_adaptiveBuffering->getBufferDuration().count() * NANOSECONDS_PER_MILLISECOND),
+            NULL);
+    }
+}
+
+StutterMetrics::Summary MediaPlayer::getStutterSummary() const {
+    return m_stutterMetrics.getSummary();
+}
+
 }  // namespace mediaPlayer
 }  // namespace alexaClientSDK
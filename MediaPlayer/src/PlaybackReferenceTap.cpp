@@ -0,0 +1,154 @@
+/*
+ * PlaybackReferenceTap.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/PlaybackReferenceTap.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+using namespace avsCommon::avs;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PlaybackReferenceTap");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The size in bytes of a sample of the reference.
+static const size_t SAMPLE_SIZE_BYTES = 2;
+
+/// The most audio queued ahead of the appsink before the oldest is dropped, so that the tap never holds up playback.
+static const guint64 MAX_QUEUED_NANOSECONDS = 200 * GST_MSECOND;
+
+/// The "leaky" value of a queue which drops the oldest buffers when full.
+static const gint QUEUE_LEAKY_DOWNSTREAM = 2;
+
+const int PlaybackReferenceTap::SAMPLE_RATE_HZ;
+
+std::unique_ptr<PlaybackReferenceTap> PlaybackReferenceTap::create(std::shared_ptr<AudioInputStream> stream) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (stream->getWordSize() != SAMPLE_SIZE_BYTES) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedWordSize").d("wordSize", stream->getWordSize()));
+        return nullptr;
+    }
+
+    auto queue = gst_element_factory_make("queue", "reference_queue");
+    auto converter = gst_element_factory_make("audioconvert", "reference_converter");
+    auto resampler = gst_element_factory_make("audioresample", "reference_resampler");
+    auto capsFilter = gst_element_factory_make("capsfilter", "reference_format");
+    auto appsink = gst_element_factory_make("appsink", "reference_sink");
+    if (!queue || !converter || !resampler || !capsFilter || !appsink) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createElementFailed"));
+        for (auto element : {queue, converter, resampler, capsFilter, appsink}) {
+            if (element) {
+                gst_object_unref(element);
+            }
+        }
+        return nullptr;
+    }
+
+    g_object_set(queue, "leaky", QUEUE_LEAKY_DOWNSTREAM, "max-size-time", MAX_QUEUED_NANOSECONDS, nullptr);
+    g_object_set(queue, "max-size-buffers", 0, "max-size-bytes", 0, nullptr);
+    auto caps = gst_caps_new_simple(
+        "audio/x-raw",
+        "format",
+        G_TYPE_STRING,
+        "S16LE",
+        "rate",
+        G_TYPE_INT,
+        SAMPLE_RATE_HZ,
+        "channels",
+        G_TYPE_INT,
+        1,
+        "layout",
+        G_TYPE_STRING,
+        "interleaved",
+        nullptr);
+    g_object_set(capsFilter, "caps", caps, nullptr);
+    gst_caps_unref(caps);
+    // Render in step with the audio sink, without holding up the pipeline's state changes to preroll.
+    g_object_set(appsink, "sync", TRUE, "async", FALSE, nullptr);
+
+    auto bin = gst_bin_new("reference_bin");
+    gst_bin_add_many(GST_BIN(bin), queue, converter, resampler, capsFilter, appsink, nullptr);
+    if (!gst_element_link_many(queue, converter, resampler, capsFilter, appsink, nullptr)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "linkElementsFailed"));
+        gst_object_unref(bin);
+        return nullptr;
+    }
+    auto sinkPad = gst_element_get_static_pad(queue, "sink");
+    gst_element_add_pad(bin, gst_ghost_pad_new("sink", sinkPad));
+    gst_object_unref(sinkPad);
+
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createWriterFailed"));
+        gst_object_unref(bin);
+        return nullptr;
+    }
+
+    std::unique_ptr<PlaybackReferenceTap> tap(new PlaybackReferenceTap(std::move(writer), bin));
+    GstAppSinkCallbacks callbacks = {};
+    callbacks.new_sample = &PlaybackReferenceTap::onNewSample;
+    gst_app_sink_set_callbacks(GST_APP_SINK(appsink), &callbacks, tap.get(), nullptr);
+    return tap;
+}
+
+PlaybackReferenceTap::PlaybackReferenceTap(std::unique_ptr<AudioInputStream::Writer> writer, GstElement* bin) :
+        m_writer{std::move(writer)},
+        m_bin{GST_ELEMENT(gst_object_ref_sink(bin))} {
+}
+
+PlaybackReferenceTap::~PlaybackReferenceTap() {
+    m_writer->close();
+    gst_object_unref(m_bin);
+}
+
+GstElement* PlaybackReferenceTap::getBin() const {
+    return m_bin;
+}
+
+GstFlowReturn PlaybackReferenceTap::onNewSample(GstAppSink* sink, gpointer tap) {
+    auto sample = gst_app_sink_pull_sample(sink);
+    if (!sample) {
+        return GST_FLOW_OK;
+    }
+    auto self = static_cast<PlaybackReferenceTap*>(tap);
+    auto buffer = gst_sample_get_buffer(sample);
+    GstMapInfo info;
+    if (buffer && gst_buffer_map(buffer, &info, GST_MAP_READ)) {
+        auto written = self->m_writer->write(info.data, info.size / SAMPLE_SIZE_BYTES);
+        if (written < 0) {
+            ACSDK_WARN(LX("writeReferenceFailed").d("error", written));
+        }
+        gst_buffer_unmap(buffer, &info);
+    }
+    gst_sample_unref(sample);
+    return GST_FLOW_OK;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
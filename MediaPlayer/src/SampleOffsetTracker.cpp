@@ -0,0 +1,91 @@
+/*
+ * SampleOffsetTracker.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "MediaPlayer/SampleOffsetTracker.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// The value of @c m_offset while the offset is not known.
+static const int64_t INVALID_OFFSET = -1;
+
+SampleOffsetTracker::SampleOffsetTracker() :
+        m_isSegmentStarted{false},
+        m_baseTime{0},
+        m_frames{0},
+        m_sampleRate{0},
+        m_bytesPerFrame{0},
+        m_offset{INVALID_OFFSET} {
+}
+
+void SampleOffsetTracker::startSegment(std::chrono::nanoseconds streamTime) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isSegmentStarted = true;
+    m_baseTime = streamTime;
+    m_frames = 0;
+    publish();
+}
+
+void SampleOffsetTracker::setFormat(int sampleRate, int bytesPerFrame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (sampleRate == m_sampleRate && bytesPerFrame == m_bytesPerFrame) {
+        return;
+    }
+    // Fold the frames counted at the old rate into the base, so that they keep their duration.
+    if (m_sampleRate > 0) {
+        m_baseTime += std::chrono::nanoseconds(m_frames * std::nano::den / m_sampleRate);
+    }
+    m_frames = 0;
+    m_sampleRate = sampleRate > 0 ? sampleRate : 0;
+    m_bytesPerFrame = bytesPerFrame > 0 ? bytesPerFrame : 0;
+}
+
+void SampleOffsetTracker::addBytes(uint64_t numBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isSegmentStarted || 0 == m_bytesPerFrame) {
+        return;
+    }
+    m_frames += numBytes / m_bytesPerFrame;
+    publish();
+}
+
+void SampleOffsetTracker::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isSegmentStarted = false;
+    m_baseTime = std::chrono::nanoseconds::zero();
+    m_frames = 0;
+    publish();
+}
+
+std::chrono::milliseconds SampleOffsetTracker::getOffset() const {
+    return std::chrono::milliseconds(m_offset.load());
+}
+
+void SampleOffsetTracker::publish() {
+    if (!m_isSegmentStarted) {
+        m_offset = INVALID_OFFSET;
+        return;
+    }
+    auto offset = m_baseTime;
+    if (m_sampleRate > 0) {
+        offset += std::chrono::nanoseconds(m_frames * std::nano::den / m_sampleRate);
+    }
+    m_offset = std::chrono::duration_cast<std::chrono::milliseconds>(offset).count();
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -0,0 +1,210 @@
+/*
+ * SegmentPrefetcher.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/SegmentPrefetcher.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SegmentPrefetcher");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// How long to block waiting for data before checking whether the download should stop.
+static const std::chrono::milliseconds READ_TIMEOUT(100);
+
+/// The number of bytes to read at once.  A read waits for all of them, so the download wakes once per chunk.
+static const size_t READ_CHUNK_SIZE = 16 * 1024;
+
+std::unique_ptr<SegmentPrefetcher> SegmentPrefetcher::create(
+    std::shared_ptr<HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    size_t depth,
+    size_t maxBytes,
+    std::chrono::seconds maxAge) {
+    if (!contentFetcherFactory) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullContentFetcherFactory"));
+        return nullptr;
+    }
+    if (0 == depth || 0 == maxBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroBudget").d("depth", depth).d("maxBytes", maxBytes));
+        return nullptr;
+    }
+    return std::unique_ptr<SegmentPrefetcher>(new SegmentPrefetcher(contentFetcherFactory, depth, maxBytes, maxAge));
+}
+
+SegmentPrefetcher::SegmentPrefetcher(
+    std::shared_ptr<HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    size_t depth,
+    size_t maxBytes,
+    std::chrono::seconds maxAge) :
+        m_contentFetcherFactory{contentFetcherFactory},
+        m_depth{depth},
+        m_maxBytes{maxBytes},
+        m_maxAge{maxAge},
+        m_cachedBytes{0},
+        m_isDownloadCancelled{false},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&SegmentPrefetcher::downloadLoop, this);
+}
+
+SegmentPrefetcher::~SegmentPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeTrigger.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SegmentPrefetcher::prefetch(const std::string& url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pendingUrls.push_back(url);
+    m_wakeTrigger.notify_all();
+}
+
+SegmentPrefetcher::Segment SegmentPrefetcher::take(const std::string& url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto match = std::find_if(
+        m_segments.begin(), m_segments.end(), [&url](const CachedSegment& segment) { return segment.url == url; });
+    if (match != m_segments.end()) {
+        // Forget the entry and any entries before it, which will not be played now.
+        auto segment = *match;
+        for (auto it = m_segments.begin(); it != match + 1; ++it) {
+            m_cachedBytes -= it->data->size();
+        }
+        m_segments.erase(m_segments.begin(), match + 1);
+        m_wakeTrigger.notify_all();
+        if (std::chrono::steady_clock::now() - segment.fetchedAt > m_maxAge) {
+            ACSDK_DEBUG(LX("takeSegmentExpired").sensitive("url", url));
+            return nullptr;
+        }
+        ACSDK_DEBUG9(LX("takeSegmentHit").d("size", segment.data->size()).sensitive("url", url));
+        return segment.data;
+    }
+
+    // The entry has not been downloaded.  Stop downloading it, or forget it and any entries queued before it.
+    if (m_downloadingUrl == url) {
+        m_isDownloadCancelled = true;
+    } else {
+        auto it = std::find(m_pendingUrls.begin(), m_pendingUrls.end(), url);
+        if (it != m_pendingUrls.end()) {
+            m_pendingUrls.erase(m_pendingUrls.begin(), it + 1);
+        }
+    }
+    ACSDK_DEBUG9(LX("takeSegmentMiss").sensitive("url", url));
+    return nullptr;
+}
+
+void SegmentPrefetcher::downloadLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeTrigger.wait(lock, [this]() {
+            return m_isShuttingDown || (!m_pendingUrls.empty() && m_segments.size() < m_depth);
+        });
+        if (m_isShuttingDown) {
+            return;
+        }
+        m_downloadingUrl = m_pendingUrls.front();
+        m_pendingUrls.pop_front();
+        m_isDownloadCancelled = false;
+        auto url = m_downloadingUrl;
+        lock.unlock();
+
+        auto data = download(url);
+
+        lock.lock();
+        if (data && !m_isDownloadCancelled && m_cachedBytes + data->size() <= m_maxBytes) {
+            m_cachedBytes += data->size();
+            m_segments.push_back({url, data, std::chrono::steady_clock::now()});
+        }
+        m_downloadingUrl.clear();
+    }
+}
+
+std::shared_ptr<std::vector<uint8_t>> SegmentPrefetcher::download(const std::string& url) {
+    auto fetcher = m_contentFetcherFactory->create(url);
+    if (!fetcher) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "nullFetcher").sensitive("url", url));
+        return nullptr;
+    }
+    auto content = fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    if (!content || !content->dataStream) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "getContentFailed").sensitive("url", url));
+        return nullptr;
+    }
+    auto reader = content->dataStream->createReader(AttachmentReader::Policy::BLOCKING);
+    if (!reader) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "createReaderFailed").sensitive("url", url));
+        return nullptr;
+    }
+
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (status != AttachmentReader::ReadStatus::CLOSED) {
+        if (shouldStopDownload(data->size())) {
+            ACSDK_DEBUG(LX("downloadAbandoned").d("size", data->size()).sensitive("url", url));
+            return nullptr;
+        }
+        size_t size = data->size();
+        data->resize(size + READ_CHUNK_SIZE);
+        auto count = reader->readAtLeast(data->data() + size, READ_CHUNK_SIZE, READ_CHUNK_SIZE, &status, READ_TIMEOUT);
+        data->resize(size + count);
+        switch (status) {
+            case AttachmentReader::ReadStatus::OK:
+            case AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+            case AttachmentReader::ReadStatus::OK_TIMEDOUT:
+            case AttachmentReader::ReadStatus::CLOSED:
+                break;
+            case AttachmentReader::ReadStatus::ERROR_OVERRUN:
+            case AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case AttachmentReader::ReadStatus::ERROR_INTERNAL:
+                ACSDK_ERROR(LX("downloadFailed").d("reason", "readFailed").sensitive("url", url));
+                return nullptr;
+        }
+    }
+    // The status code is known once the body has started, and the body has ended, so this does not block.
+    auto statusCode = content->statusCode.get();
+    if (statusCode != 200) {
+        ACSDK_ERROR(LX("downloadFailed").d("reason", "unexpectedStatusCode").d("statusCode", statusCode));
+        return nullptr;
+    }
+    data->shrink_to_fit();
+    return data;
+}
+
+bool SegmentPrefetcher::shouldStopDownload(size_t numBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isShuttingDown || m_isDownloadCancelled || m_cachedBytes + numBytes > m_maxBytes;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
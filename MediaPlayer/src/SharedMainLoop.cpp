@@ -0,0 +1,97 @@
+/*
+ * SharedMainLoop.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <future>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
+
+#include "MediaPlayer/SharedMainLoop.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SharedMainLoop");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::mutex SharedMainLoop::m_instanceMutex;
+
+std::weak_ptr<SharedMainLoop> SharedMainLoop::m_instance;
+
+std::shared_ptr<SharedMainLoop> SharedMainLoop::acquire() {
+    std::lock_guard<std::mutex> lock(m_instanceMutex);
+    auto instance = m_instance.lock();
+    if (instance) {
+        return instance;
+    }
+    auto mainLoop = g_main_loop_new(nullptr, false);
+    if (!mainLoop) {
+        ACSDK_ERROR(LX("acquireFailed").d("reason", "gMainLoopNewFailed"));
+        return nullptr;
+    }
+    instance = std::shared_ptr<SharedMainLoop>(new SharedMainLoop(mainLoop));
+    m_instance = instance;
+    return instance;
+}
+
+/**
+ * Fulfil the promise passed to it.  Queued before the loop starts, so that its call shows the loop is running.
+ *
+ * @param promise The @c std::promise<void> to fulfil.
+ * @return @c FALSE, so that the callback runs once.
+ */
+static gboolean onLoopStarted(gpointer promise) {
+    static_cast<std::promise<void>*>(promise)->set_value();
+    return FALSE;
+}
+
+SharedMainLoop::SharedMainLoop(GMainLoop* mainLoop) : m_mainLoop{mainLoop} {
+    ACSDK_DEBUG9(LX("startingMainLoop"));
+    // Wait for the loop to be running, since a g_main_loop_quit() which comes before g_main_loop_run() is lost.
+    std::promise<void> started;
+    auto future = started.get_future();
+    g_idle_add(&onLoopStarted, &started);
+    m_thread = avsCommon::utils::threading::ThreadFactory::createThread(
+        avsCommon::utils::threading::ThreadRole::MEDIA, "gst-main-loop", [mainLoop]() { g_main_loop_run(mainLoop); });
+    future.wait();
+}
+
+SharedMainLoop::~SharedMainLoop() {
+    ACSDK_DEBUG9(LX("stoppingMainLoop"));
+    g_main_loop_quit(m_mainLoop);
+    if (isLoopThread()) {
+        // The last holder let go from a callback; the loop exits once that callback returns.
+        m_thread.detach();
+    } else if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    g_main_loop_unref(m_mainLoop);
+}
+
+bool SharedMainLoop::isLoopThread() const {
+    return std::this_thread::get_id() == m_thread.get_id();
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -0,0 +1,92 @@
+/*
+ * StutterMetrics.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/StutterMetrics.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("StutterMetrics");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+StutterMetrics::StutterMetrics() :
+        m_finished{0, std::chrono::milliseconds::zero(), std::chrono::milliseconds::zero()},
+        m_isStuttering{false} {
+}
+
+void StutterMetrics::startStream() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished = {0, std::chrono::milliseconds::zero(), std::chrono::milliseconds::zero()};
+    m_isStuttering = false;
+}
+
+void StutterMetrics::onStutterStarted(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isStuttering) {
+        return;
+    }
+    m_isStuttering = true;
+    m_stutterStart = now;
+}
+
+void StutterMetrics::onStutterFinished(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isStuttering) {
+        return;
+    }
+    m_isStuttering = false;
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_stutterStart);
+    ++m_finished.count;
+    m_finished.totalDuration += duration;
+    m_finished.maxDuration = std::max(m_finished.maxDuration, duration);
+}
+
+StutterMetrics::Summary StutterMetrics::getSummary(std::chrono::steady_clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto summary = m_finished;
+    if (m_isStuttering) {
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_stutterStart);
+        ++summary.count;
+        summary.totalDuration += duration;
+        summary.maxDuration = std::max(summary.maxDuration, duration);
+    }
+    return summary;
+}
+
+void StutterMetrics::dump() const {
+    auto summary = getSummary();
+    if (summary.count > 0) {
+        ACSDK_INFO(LX("streamStutters")
+                       .d("count", summary.count)
+                       .d("totalMs", summary.totalDuration.count())
+                       .d("maxMs", summary.maxDuration.count()));
+    }
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
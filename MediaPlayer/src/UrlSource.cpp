@@ -17,6 +17,8 @@
 
 #include <cstring>
 
+#include <gst/app/gstappsrc.h>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 #include "MediaPlayer/UrlSource.h"
@@ -39,10 +41,14 @@ static const std::string TAG("UrlSource");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The uri which makes the decoder create an appsrc, which @c handleSourceSetup() feeds a downloaded entry to.
+static const std::string APPSRC_URI = "appsrc://";
+
 std::shared_ptr<UrlSource> UrlSource::create(
     PipelineInterface* pipeline,
     std::shared_ptr<PlaylistParserInterface> playlistParser,
-    const std::string& url) {
+    const std::string& url,
+    std::unique_ptr<SegmentPrefetcher> prefetcher) {
     if (!pipeline) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullPipeline"));
         return nullptr;
@@ -52,7 +58,7 @@ std::shared_ptr<UrlSource> UrlSource::create(
         return nullptr;
     }
     ACSDK_DEBUG9(LX("UrlSourceCreate").sensitive("url", url));
-    std::shared_ptr<UrlSource> result(new UrlSource(pipeline, playlistParser, url));
+    std::shared_ptr<UrlSource> result(new UrlSource(pipeline, playlistParser, url, std::move(prefetcher)));
     if (result->init()) {
         return result;
     }
@@ -62,12 +68,28 @@ std::shared_ptr<UrlSource> UrlSource::create(
 UrlSource::UrlSource(
     PipelineInterface* pipeline,
     std::shared_ptr<PlaylistParserInterface> playlistParser,
-    const std::string& url) :
+    const std::string& url,
+    std::unique_ptr<SegmentPrefetcher> prefetcher) :
         m_url{url},
         m_playlistParser{playlistParser},
         m_hasReceivedAPlaylistCallback{false},
         m_isValid{true},
-        m_pipeline{pipeline} {
+        m_pipeline{pipeline},
+        m_prefetcher{std::move(prefetcher)},
+        m_numEntriesParsed{0},
+        m_decoder{nullptr},
+        m_sourceSetupHandlerId{0} {
+}
+
+UrlSource::~UrlSource() {
+    // Stop downloading before the decoder (and any callback into this instance) goes away.
+    m_prefetcher.reset();
+    if (m_decoder) {
+        if (m_sourceSetupHandlerId) {
+            g_signal_handler_disconnect(m_decoder, m_sourceSetupHandlerId);
+        }
+        gst_object_unref(m_decoder);
+    }
 }
 
 bool UrlSource::init() {
@@ -94,6 +116,15 @@ bool UrlSource::init() {
         return false;
     }
 
+    if (m_prefetcher) {
+        m_decoder = GST_ELEMENT(gst_object_ref(decoder));
+        m_sourceSetupHandlerId = g_signal_connect(decoder, "source-setup", G_CALLBACK(onSourceSetup), this);
+        if (!m_sourceSetupHandlerId) {
+            ACSDK_WARN(LX("prefetchDisabled").d("reason", "connectSourceSetupSignalFailed"));
+            m_prefetcher.reset();
+        }
+    }
+
     m_pipeline->setAppSrc(nullptr);
     m_pipeline->setDecoder(decoder);
 
@@ -105,21 +136,56 @@ bool UrlSource::hasAdditionalData() {
     if (m_url.empty()) {
         return false;
     }
-    g_object_set(m_pipeline->getDecoder(), "uri", m_url.c_str(), NULL);
+    g_object_set(m_pipeline->getDecoder(), "uri", getDecoderUriLocked().c_str(), NULL);
     return true;
 }
 
 bool UrlSource::handleEndOfStream() {
     std::lock_guard<std::mutex> lock{m_mutex};
+    m_prefetchedSegment.reset();
     if (!m_audioUrlQueue.empty()) {
         m_url = m_audioUrlQueue.front();
         m_audioUrlQueue.pop();
+        if (m_prefetcher) {
+            m_prefetchedSegment = m_prefetcher->take(m_url);
+        }
     } else {
         m_url.clear();
     }
     return true;
 }
 
+std::string UrlSource::getDecoderUriLocked() const {
+    return m_prefetchedSegment ? APPSRC_URI : m_url;
+}
+
+void UrlSource::onSourceSetup(GstElement* decoder, GstElement* source, gpointer pointer) {
+    static_cast<UrlSource*>(pointer)->handleSourceSetup(source);
+}
+
+void UrlSource::handleSourceSetup(GstElement* source) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (!m_prefetchedSegment || !GST_IS_APP_SRC(source)) {
+        return;
+    }
+    ACSDK_DEBUG9(LX("playingPrefetchedSegment").d("size", m_prefetchedSegment->size()).sensitive("url", m_url));
+    // The buffer keeps the segment alive until GStreamer is done with it.
+    auto holder = new SegmentPrefetcher::Segment(m_prefetchedSegment);
+    auto buffer = gst_buffer_new_wrapped_full(
+        GST_MEMORY_FLAG_READONLY,
+        const_cast<uint8_t*>((*holder)->data()),
+        (*holder)->size(),
+        0,
+        (*holder)->size(),
+        holder,
+        [](gpointer data) { delete static_cast<SegmentPrefetcher::Segment*>(data); });
+    auto appsrc = GST_APP_SRC(source);
+    if (gst_app_src_push_buffer(appsrc, buffer) != GST_FLOW_OK) {
+        ACSDK_ERROR(LX("handleSourceSetupFailed").d("reason", "pushBufferFailed"));
+    }
+    gst_app_src_end_of_stream(appsrc);
+}
+
 void UrlSource::preprocess() {
     // Waits until at least one callback has occurred from the PlaylistParser
     m_playlistParsedPromise.get_future().get();
@@ -160,8 +226,16 @@ void UrlSource::onPlaylistEntryParsed(
             break;
         case avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS:
         case avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING:
+            if (url.empty()) {
+                // The end of a playlist whose last entry was already reported.
+                break;
+            }
             ACSDK_DEBUG9(LX("urlParsedSuccessfully").sensitive("url", url));
             m_audioUrlQueue.push(url);
+            // The first entry is played as soon as it is parsed, so only the ones after it are downloaded ahead.
+            if (m_prefetcher && m_numEntriesParsed++ > 0) {
+                m_prefetcher->prefetch(url);
+            }
             break;
         default:
             ACSDK_ERROR(LX("onPlaylistParsedError").d("reason", "unknownParseResult"));
@@ -0,0 +1,105 @@
+/*
+ * AdaptiveBufferingTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AdaptiveBufferingTest.cpp
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/AdaptiveBuffering.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+/// The initial size of the buffer used by the tests.
+static const int64_t BUFFER_SIZE_BYTES = 1024 * 1024;
+
+/// The initial duration of the buffer used by the tests.
+static const std::chrono::milliseconds BUFFER_DURATION(1000);
+
+/// The size the buffer may grow to in the tests.
+static const int64_t MAX_BUFFER_SIZE_BYTES = 3 * 1024 * 1024;
+
+/// The duration the buffer may grow to in the tests.
+static const std::chrono::milliseconds MAX_BUFFER_DURATION(5000);
+
+/// The number of underruns after which the buffer grows in the tests.
+static const int UNDERRUNS_BEFORE_GROWTH = 2;
+
+/**
+ * Verify that negative values, and initial values above their maximums, are rejected.
+ */
+TEST(AdaptiveBufferingTest, createWithInvalidParameters) {
+    EXPECT_FALSE(AdaptiveBuffering::create(
+        -1, BUFFER_DURATION, MAX_BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION, UNDERRUNS_BEFORE_GROWTH));
+    EXPECT_FALSE(AdaptiveBuffering::create(
+        BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION * 2, MAX_BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION, 1));
+    EXPECT_FALSE(
+        AdaptiveBuffering::create(BUFFER_SIZE_BYTES, BUFFER_DURATION, MAX_BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION, -1));
+}
+
+/**
+ * Verify that the buffer doubles after the configured number of underruns, up to its maximums.
+ */
+TEST(AdaptiveBufferingTest, growAfterRepeatedUnderruns) {
+    auto buffering = AdaptiveBuffering::create(
+        BUFFER_SIZE_BYTES, BUFFER_DURATION, MAX_BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION, UNDERRUNS_BEFORE_GROWTH);
+    ASSERT_TRUE(buffering);
+    EXPECT_FALSE(buffering->onBufferUnderrun());
+    EXPECT_TRUE(buffering->onBufferUnderrun());
+    EXPECT_EQ(buffering->getBufferSizeBytes(), 2 * BUFFER_SIZE_BYTES);
+    EXPECT_EQ(buffering->getBufferDuration(), 2 * BUFFER_DURATION);
+
+    EXPECT_FALSE(buffering->onBufferUnderrun());
+    EXPECT_TRUE(buffering->onBufferUnderrun());
+    EXPECT_EQ(buffering->getBufferSizeBytes(), MAX_BUFFER_SIZE_BYTES);
+    EXPECT_EQ(buffering->getBufferDuration(), 4 * BUFFER_DURATION);
+
+    EXPECT_FALSE(buffering->onBufferUnderrun());
+    EXPECT_TRUE(buffering->onBufferUnderrun());
+    EXPECT_EQ(buffering->getBufferDuration(), MAX_BUFFER_DURATION);
+
+    EXPECT_FALSE(buffering->onBufferUnderrun());
+    EXPECT_FALSE(buffering->onBufferUnderrun());
+}
+
+/**
+ * Verify that a buffer left to the defaults of GStreamer keeps them until it grows, and never grows if growth is off.
+ */
+TEST(AdaptiveBufferingTest, defaultsAndNoGrowth) {
+    auto buffering = AdaptiveBuffering::create(
+        0, std::chrono::milliseconds::zero(), MAX_BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION, 1);
+    ASSERT_TRUE(buffering);
+    EXPECT_EQ(buffering->getBufferSizeBytes(), 0);
+    EXPECT_TRUE(buffering->onBufferUnderrun());
+    EXPECT_GT(buffering->getBufferSizeBytes(), 0);
+    EXPECT_GT(buffering->getBufferDuration().count(), 0);
+
+    buffering =
+        AdaptiveBuffering::create(BUFFER_SIZE_BYTES, BUFFER_DURATION, MAX_BUFFER_SIZE_BYTES, MAX_BUFFER_DURATION, 0);
+    ASSERT_TRUE(buffering);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(buffering->onBufferUnderrun());
+    }
+    EXPECT_EQ(buffering->getBufferSizeBytes(), BUFFER_SIZE_BYTES);
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -19,6 +19,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -38,6 +39,7 @@ namespace mediaPlayer {
 namespace test {
 
 using namespace avsCommon::utils::mediaPlayer;
+using namespace avsCommon::avs;
 using namespace avsCommon::avs::attachment;
 using namespace avsCommon::utils::memory;
 using namespace ::testing;
@@ -505,6 +507,24 @@ TEST_F(MediaPlayerTest, testStartPlayWaitForEnd) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished());
 }
 
+/**
+ * Set the source of the @c MediaPlayer with @c setSourceAsync() and play it with @c playAsync() at once, without
+ * waiting for the source to be set.  Check that both succeed and that the audio plays till the end.
+ */
+TEST_F(MediaPlayerTest, testSetSourceAsyncThenPlayAsync) {
+    std::promise<MediaPlayerStatus> setSourcePromise;
+    std::promise<MediaPlayerStatus> playPromise;
+    m_mediaPlayer->setSourceAsync(
+        std::make_shared<MockAttachmentReader>(),
+        [&setSourcePromise](MediaPlayerStatus status) { setSourcePromise.set_value(status); });
+    m_mediaPlayer->playAsync([&playPromise](MediaPlayerStatus status) { playPromise.set_value(status); });
+
+    ASSERT_NE(MediaPlayerStatus::FAILURE, setSourcePromise.get_future().get());
+    ASSERT_NE(MediaPlayerStatus::FAILURE, playPromise.get_future().get());
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted());
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished());
+}
+
 /**
  * Set the source of the @c MediaPlayer to a url representing a single audio file. Playback audio till the end.
  * Check whether the playback started and playback finished notifications are received.
@@ -974,6 +994,32 @@ TEST_F(MediaPlayerTest, testRepeatUrl) {
     }
 }
 
+/**
+ * Play an audio file through a @c MediaPlayer with a playback reference stream.  Expect the played audio to be in the
+ * stream, at the sample rate of the reference, once the playback has finished.
+ */
+TEST_F(MediaPlayerTest, testPlaybackReference) {
+    const size_t referenceWords = PlaybackReferenceTap::SAMPLE_RATE_HZ * 2 * MP3_FILE_LENGTH.count() / 1000;
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(AudioInputStream::calculateBufferSize(referenceWords, 2));
+    std::shared_ptr<AudioInputStream> referenceStream = AudioInputStream::create(buffer, 2);
+    ASSERT_TRUE(referenceStream);
+    auto reader = referenceStream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    auto mediaPlayer = MediaPlayer::create(std::make_shared<MockContentFetcherFactory>(), referenceStream);
+    ASSERT_TRUE(mediaPlayer);
+    auto playerObserver = std::make_shared<MockPlayerObserver>();
+    mediaPlayer->setObserver(playerObserver);
+
+    ASSERT_NE(MediaPlayerStatus::FAILURE, mediaPlayer->setFileSource(inputsDirPath + MP3_FILE_PATH, false));
+    ASSERT_NE(MediaPlayerStatus::FAILURE, mediaPlayer->play());
+    ASSERT_TRUE(playerObserver->waitForPlaybackStarted());
+    ASSERT_TRUE(playerObserver->waitForPlaybackFinished());
+
+    std::vector<int16_t> samples(referenceWords);
+    auto read = reader->read(samples.data(), samples.size());
+    auto minimumWords = PlaybackReferenceTap::SAMPLE_RATE_HZ * (MP3_FILE_LENGTH - TOLERANCE).count() / 1000;
+    ASSERT_GE(read, minimumWords);
+}
+
 }  // namespace test
 }  // namespace mediaPlayer
 }  // namespace alexaClientSDK
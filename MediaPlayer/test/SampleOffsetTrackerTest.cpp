@@ -0,0 +1,87 @@
+/*
+ * SampleOffsetTrackerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SampleOffsetTrackerTest.cpp
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/SampleOffsetTracker.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+/// The sample rate used by the tests.
+static const int SAMPLE_RATE = 16000;
+
+/// The size of a frame of 16-bit stereo audio.
+static const int BYTES_PER_FRAME = 4;
+
+/// The number of bytes in one second of audio at @c SAMPLE_RATE.
+static const uint64_t BYTES_PER_SECOND = SAMPLE_RATE * BYTES_PER_FRAME;
+
+/**
+ * Verify that the offset is invalid until a segment starts, and after a reset.
+ */
+TEST(SampleOffsetTrackerTest, invalidWithoutSegment) {
+    SampleOffsetTracker tracker;
+    ASSERT_LT(tracker.getOffset().count(), 0);
+    tracker.setFormat(SAMPLE_RATE, BYTES_PER_FRAME);
+    tracker.addBytes(BYTES_PER_SECOND);
+    ASSERT_LT(tracker.getOffset().count(), 0);
+
+    tracker.startSegment(std::chrono::nanoseconds::zero());
+    ASSERT_EQ(tracker.getOffset(), std::chrono::milliseconds::zero());
+    tracker.reset();
+    ASSERT_LT(tracker.getOffset().count(), 0);
+}
+
+/**
+ * Verify that the offset counts the samples since the start of the segment.
+ */
+TEST(SampleOffsetTrackerTest, countsSamplesFromSegmentStart) {
+    SampleOffsetTracker tracker;
+    tracker.setFormat(SAMPLE_RATE, BYTES_PER_FRAME);
+    tracker.startSegment(std::chrono::seconds(10));
+    tracker.addBytes(BYTES_PER_SECOND);
+    tracker.addBytes(BYTES_PER_SECOND / 2);
+    ASSERT_EQ(tracker.getOffset(), std::chrono::milliseconds(11500));
+
+    // A seek starts a new segment.
+    tracker.startSegment(std::chrono::seconds(3));
+    tracker.addBytes(BYTES_PER_SECOND / 4);
+    ASSERT_EQ(tracker.getOffset(), std::chrono::milliseconds(3250));
+}
+
+/**
+ * Verify that samples counted before a change of format keep their duration.
+ */
+TEST(SampleOffsetTrackerTest, keepsOffsetAcrossFormatChange) {
+    SampleOffsetTracker tracker;
+    tracker.setFormat(SAMPLE_RATE, BYTES_PER_FRAME);
+    tracker.startSegment(std::chrono::nanoseconds::zero());
+    tracker.addBytes(BYTES_PER_SECOND);
+    tracker.setFormat(SAMPLE_RATE * 2, BYTES_PER_FRAME / 2);
+    tracker.addBytes(BYTES_PER_SECOND);
+    ASSERT_EQ(tracker.getOffset(), std::chrono::milliseconds(2000));
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
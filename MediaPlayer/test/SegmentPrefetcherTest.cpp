@@ -0,0 +1,201 @@
+/*
+ * SegmentPrefetcherTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SegmentPrefetcherTest.cpp
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/Attachment/InProcessAttachment.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+#include "MediaPlayer/SegmentPrefetcher.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The URLs of the entries used by the tests.
+static const std::string URL_1 = "http://example.com/1.mp3";
+static const std::string URL_2 = "http://example.com/2.mp3";
+static const std::string URL_3 = "http://example.com/3.mp3";
+
+/// The number of entries held by most tests.
+static const size_t DEPTH = 2;
+
+/// The byte budget of most tests.
+static const size_t MAX_BYTES = 1024;
+
+/// The time budget of most tests.
+static const std::chrono::seconds MAX_AGE(60);
+
+/// How long to wait for the prefetcher to download the entries.
+static const std::chrono::milliseconds DOWNLOAD_DELAY(200);
+
+/// A content fetcher which returns its content at once.
+class MockContentFetcher : public HTTPContentFetcherInterface {
+public:
+    MockContentFetcher(const std::string& content) : m_content{content} {
+    }
+
+    std::unique_ptr<HTTPContent> getContent(FetchOptions fetchOption) override {
+        std::promise<long> statusPromise;
+        statusPromise.set_value(200);
+        std::promise<std::string> contentTypePromise;
+        contentTypePromise.set_value("audio/mpeg");
+        auto stream = std::make_shared<InProcessAttachment>(m_content);
+        auto writer = stream->createWriter();
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        writer->write(m_content.data(), m_content.size(), &writeStatus);
+        writer->close();
+        return memory::make_unique<HTTPContent>(
+            HTTPContent{statusPromise.get_future(), contentTypePromise.get_future(), stream});
+    }
+
+private:
+    /// The content to return.
+    std::string m_content;
+};
+
+/// A factory of @c MockContentFetcher, returning the content of each URL from a map.
+class MockContentFetcherFactory : public HTTPContentFetcherInterfaceFactoryInterface {
+public:
+    std::unique_ptr<HTTPContentFetcherInterface> create(const std::string& url) override {
+        return memory::make_unique<MockContentFetcher>(m_contents[url]);
+    }
+
+    /// The content of each URL.
+    std::unordered_map<std::string, std::string> m_contents;
+};
+
+/**
+ * Our GTest class.
+ */
+class SegmentPrefetcherTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /// The factory of the fetchers used by the prefetcher.
+    std::shared_ptr<MockContentFetcherFactory> m_factory;
+};
+
+void SegmentPrefetcherTest::SetUp() {
+    m_factory = std::make_shared<MockContentFetcherFactory>();
+    m_factory->m_contents[URL_1] = "one";
+    m_factory->m_contents[URL_2] = "two";
+    m_factory->m_contents[URL_3] = "three";
+}
+
+/**
+ * Convert a @c Segment to a string.
+ *
+ * @param segment The segment.
+ * @return The content of the segment.
+ */
+static std::string toString(SegmentPrefetcher::Segment segment) {
+    return std::string(segment->begin(), segment->end());
+}
+
+/**
+ * Verify that entries are downloaded in order, including those queued beyond @c DEPTH.
+ */
+TEST_F(SegmentPrefetcherTest, downloadsInOrder) {
+    auto prefetcher = SegmentPrefetcher::create(m_factory, DEPTH, MAX_BYTES, MAX_AGE);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch(URL_1);
+    prefetcher->prefetch(URL_2);
+    prefetcher->prefetch(URL_3);
+    std::this_thread::sleep_for(DOWNLOAD_DELAY);
+
+    auto segment = prefetcher->take(URL_1);
+    ASSERT_TRUE(segment);
+    ASSERT_EQ(toString(segment), "one");
+    segment = prefetcher->take(URL_2);
+    ASSERT_TRUE(segment);
+    ASSERT_EQ(toString(segment), "two");
+    // The third entry only starts downloading once an entry has been taken.
+    std::this_thread::sleep_for(DOWNLOAD_DELAY);
+    segment = prefetcher->take(URL_3);
+    ASSERT_TRUE(segment);
+    ASSERT_EQ(toString(segment), "three");
+}
+
+/**
+ * Verify that taking an entry forgets the entries before it.
+ */
+TEST_F(SegmentPrefetcherTest, takeSkipsEarlierEntries) {
+    auto prefetcher = SegmentPrefetcher::create(m_factory, DEPTH, MAX_BYTES, MAX_AGE);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch(URL_1);
+    prefetcher->prefetch(URL_2);
+    std::this_thread::sleep_for(DOWNLOAD_DELAY);
+
+    auto segment = prefetcher->take(URL_2);
+    ASSERT_TRUE(segment);
+    ASSERT_EQ(toString(segment), "two");
+    ASSERT_FALSE(prefetcher->take(URL_1));
+}
+
+/**
+ * Verify that an entry over the byte budget is not held.
+ */
+TEST_F(SegmentPrefetcherTest, abandonsEntryOverBudget) {
+    m_factory->m_contents[URL_1] = std::string(MAX_BYTES + 1, 'x');
+    auto prefetcher = SegmentPrefetcher::create(m_factory, DEPTH, MAX_BYTES, MAX_AGE);
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch(URL_1);
+    prefetcher->prefetch(URL_2);
+    std::this_thread::sleep_for(DOWNLOAD_DELAY);
+
+    ASSERT_FALSE(prefetcher->take(URL_1));
+    auto segment = prefetcher->take(URL_2);
+    ASSERT_TRUE(segment);
+    ASSERT_EQ(toString(segment), "two");
+}
+
+/**
+ * Verify that an entry held for longer than the time budget is not used.
+ */
+TEST_F(SegmentPrefetcherTest, expiresOldEntries) {
+    auto prefetcher = SegmentPrefetcher::create(m_factory, DEPTH, MAX_BYTES, std::chrono::seconds(0));
+    ASSERT_TRUE(prefetcher);
+    prefetcher->prefetch(URL_1);
+    std::this_thread::sleep_for(DOWNLOAD_DELAY);
+    ASSERT_FALSE(prefetcher->take(URL_1));
+}
+
+/**
+ * Verify that invalid parameters are rejected.
+ */
+TEST_F(SegmentPrefetcherTest, createWithInvalidParameters) {
+    ASSERT_FALSE(SegmentPrefetcher::create(nullptr, DEPTH, MAX_BYTES, MAX_AGE));
+    ASSERT_FALSE(SegmentPrefetcher::create(m_factory, 0, MAX_BYTES, MAX_AGE));
+    ASSERT_FALSE(SegmentPrefetcher::create(m_factory, DEPTH, 0, MAX_AGE));
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
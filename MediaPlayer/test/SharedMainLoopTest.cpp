@@ -0,0 +1,89 @@
+/*
+ * SharedMainLoopTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SharedMainLoopTest.cpp
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/SharedMainLoop.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+/// How long to wait for a callback to be dispatched.
+static const std::chrono::seconds WAIT_TIMEOUT(5);
+
+/// The data passed to @c onIdle.
+struct IdleData {
+    /// The loop which should dispatch the callback.
+    std::shared_ptr<SharedMainLoop> loop;
+
+    /// Fulfilled with whether the callback ran on the loop's thread.
+    std::promise<bool> ranOnLoopThread;
+};
+
+/**
+ * Record whether the callback runs on the loop's thread.
+ *
+ * @param data The @c IdleData.
+ * @return @c FALSE, so that the callback runs once.
+ */
+static gboolean onIdle(gpointer data) {
+    auto idleData = static_cast<IdleData*>(data);
+    idleData->ranOnLoopThread.set_value(idleData->loop->isLoopThread());
+    return FALSE;
+}
+
+/**
+ * Verify that every holder gets the same loop, and that a new one is started once all have released it.
+ */
+TEST(SharedMainLoopTest, sharedWhileHeld) {
+    auto first = SharedMainLoop::acquire();
+    ASSERT_TRUE(first);
+    auto second = SharedMainLoop::acquire();
+    ASSERT_EQ(first, second);
+    ASSERT_FALSE(first->isLoopThread());
+
+    std::weak_ptr<SharedMainLoop> released = first;
+    first.reset();
+    second.reset();
+    ASSERT_TRUE(released.expired());
+    auto third = SharedMainLoop::acquire();
+    ASSERT_TRUE(third);
+}
+
+/**
+ * Verify that callbacks queued on the default context are dispatched on the loop's thread.
+ */
+TEST(SharedMainLoopTest, dispatchesDefaultContext) {
+    IdleData data;
+    data.loop = SharedMainLoop::acquire();
+    ASSERT_TRUE(data.loop);
+    auto future = data.ranOnLoopThread.get_future();
+    g_idle_add(&onIdle, &data);
+    ASSERT_EQ(future.wait_for(WAIT_TIMEOUT), std::future_status::ready);
+    ASSERT_TRUE(future.get());
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
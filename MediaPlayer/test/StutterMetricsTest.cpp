@@ -0,0 +1,71 @@
+/*
+ * StutterMetricsTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file StutterMetricsTest.cpp
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/StutterMetrics.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+/**
+ * Verify that finished stutters are counted with their total and longest durations.
+ */
+TEST(StutterMetricsTest, countStutters) {
+    StutterMetrics metrics;
+    auto start = std::chrono::steady_clock::now();
+    metrics.onStutterStarted(start);
+    metrics.onStutterStarted(start + std::chrono::milliseconds(50));
+    metrics.onStutterFinished(start + std::chrono::milliseconds(100));
+    metrics.onStutterFinished(start + std::chrono::milliseconds(150));
+    metrics.onStutterStarted(start + std::chrono::milliseconds(1000));
+    metrics.onStutterFinished(start + std::chrono::milliseconds(1300));
+
+    auto summary = metrics.getSummary(start + std::chrono::milliseconds(2000));
+    EXPECT_EQ(summary.count, 2u);
+    EXPECT_EQ(summary.totalDuration, std::chrono::milliseconds(400));
+    EXPECT_EQ(summary.maxDuration, std::chrono::milliseconds(300));
+}
+
+/**
+ * Verify that an ongoing stutter is counted up to now, and that a new stream starts from no stutters.
+ */
+TEST(StutterMetricsTest, ongoingStutterAndNewStream) {
+    StutterMetrics metrics;
+    auto start = std::chrono::steady_clock::now();
+    metrics.onStutterStarted(start);
+    auto summary = metrics.getSummary(start + std::chrono::milliseconds(500));
+    EXPECT_EQ(summary.count, 1u);
+    EXPECT_EQ(summary.totalDuration, std::chrono::milliseconds(500));
+    EXPECT_EQ(summary.maxDuration, std::chrono::milliseconds(500));
+
+    metrics.startStream();
+    summary = metrics.getSummary(start + std::chrono::milliseconds(1000));
+    EXPECT_EQ(summary.count, 0u);
+    EXPECT_EQ(summary.totalDuration, std::chrono::milliseconds::zero());
+    metrics.onStutterFinished(start + std::chrono::milliseconds(1000));
+    EXPECT_EQ(metrics.getSummary().count, 0u);
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
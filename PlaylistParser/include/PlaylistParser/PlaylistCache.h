@@ -0,0 +1,129 @@
+/*
+ * PlaylistCache.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLIST_PARSER_INCLUDE_PLAYLIST_PARSER_PLAYLIST_CACHE_H_
+#define ALEXA_CLIENT_SDK_PLAYLIST_PARSER_INCLUDE_PLAYLIST_PARSER_PLAYLIST_CACHE_H_
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * An in-memory cache of the entries which playlists were resolved to, so that resuming a recently played station does
+ * not download and parse its playlists again.  Resolutions expire after a fixed time, and can be invalidated early,
+ * for example when playing one of their entries fails.
+ *
+ * The cache is shared by the @c PlaylistParser instances created for successive sources, and is thread-safe.
+ */
+class PlaylistCache {
+public:
+    /// The types of playlist which were not parsed in a resolution.
+    using PlaylistTypes = std::vector<avsCommon::utils::playlistParser::PlaylistParserInterface::PlaylistType>;
+
+    /**
+     * Create a @c PlaylistCache.
+     *
+     * @param timeToLive How long a resolution is used for after it was made.
+     * @param maxResolutions The largest number of resolutions kept.  The oldest one is dropped to make room.
+     * @return The new @c PlaylistCache, or @c nullptr if a parameter is not positive.
+     */
+    static std::shared_ptr<PlaylistCache> create(std::chrono::seconds timeToLive, size_t maxResolutions);
+
+    /**
+     * Get the entries a playlist was resolved to.
+     *
+     * @param url The url of the playlist.
+     * @param playlistTypesToNotBeParsed The playlist types which are not parsed.
+     * @param[out] urls The entries of the playlist, in order.
+     * @return Whether the playlist has an unexpired resolution.
+     */
+    bool get(const std::string& url, const PlaylistTypes& playlistTypesToNotBeParsed, std::vector<std::string>* urls);
+
+    /**
+     * Keep the entries a playlist was resolved to.
+     *
+     * @param url The url of the playlist.
+     * @param playlistTypesToNotBeParsed The playlist types which were not parsed.
+     * @param urls The entries of the playlist, in order.
+     */
+    void put(
+        const std::string& url,
+        const PlaylistTypes& playlistTypesToNotBeParsed,
+        const std::vector<std::string>& urls);
+
+    /**
+     * Drop the resolutions of a playlist, and those containing an entry, for example after playing it failed.
+     *
+     * @param url The url of the playlist or of the entry.
+     */
+    void invalidate(const std::string& url);
+
+private:
+    /// A playlist resolution.
+    struct Resolution {
+        /// The url of the playlist.
+        std::string url;
+
+        /// The entries of the playlist, in order.
+        std::vector<std::string> urls;
+
+        /// When the resolution expires.
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param timeToLive How long a resolution is used for after it was made.
+     * @param maxResolutions The largest number of resolutions kept.
+     */
+    PlaylistCache(std::chrono::seconds timeToLive, size_t maxResolutions);
+
+    /**
+     * Build the key of a resolution.
+     *
+     * @param url The url of the playlist.
+     * @param playlistTypesToNotBeParsed The playlist types which are not parsed.
+     * @return The key of the resolution.
+     */
+    static std::string makeKey(const std::string& url, const PlaylistTypes& playlistTypesToNotBeParsed);
+
+    /// How long a resolution is used for after it was made.
+    const std::chrono::seconds m_timeToLive;
+
+    /// The largest number of resolutions kept.
+    const size_t m_maxResolutions;
+
+    /// Serializes access to @c m_resolutions.
+    std::mutex m_mutex;
+
+    /// The resolutions, by key.
+    std::unordered_map<std::string, Resolution> m_resolutions;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLIST_PARSER_INCLUDE_PLAYLIST_PARSER_PLAYLIST_CACHE_H_
@@ -18,15 +18,20 @@
 #ifndef ALEXA_CLIENT_SDK_PLAYLIST_PARSER_INCLUDE_PLAYLIST_PARSER_PLAYLIST_PARSER_H_
 #define ALEXA_CLIENT_SDK_PLAYLIST_PARSER_INCLUDE_PLAYLIST_PARSER_PLAYLIST_PARSER_H_
 
+#include <chrono>
 #include <deque>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
+#include "PlaylistParser/PlaylistCache.h"
+
 namespace alexaClientSDK {
 namespace playlistParser {
 
@@ -39,10 +44,12 @@ public:
      * Creates a new @c PlaylistParser instance.
      *
      * @param contentFetcherFactory A factory that can create @c HTTPContentFetcherInterfaces.
+     * @param cache The cache of playlist resolutions to consult and fill, or @c nullptr to resolve each playlist.
      * @return An @c std::unique_ptr to a new @c PlaylistParser if successful or @c nullptr otherwise.
      */
     static std::unique_ptr<PlaylistParser> create(
-        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory);
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        std::shared_ptr<PlaylistCache> cache = nullptr);
 
     int parsePlaylist(
         std::string url,
@@ -58,16 +65,60 @@ private:
      *
      * @param contentFetcherFactory The object that will be used to create objects with which to fetch content from
      * urls.
+     * @param cache The cache of playlist resolutions, or @c nullptr.
      */
     PlaylistParser(
-        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory);
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        std::shared_ptr<PlaylistCache> cache);
+
+    /// An entry of a playlist, whose content-type has been requested.
+    struct PlaylistEntry {
+        /// The url of the entry.
+        std::string url;
+
+        /// The fetcher requesting the content-type of the entry.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> contentFetcher;
+
+        /// The content returned by @c contentFetcher, or @c nullptr if it could not be requested.
+        std::unique_ptr<avsCommon::utils::HTTPContent> httpContent;
+    };
+
+    /// A playlist whose body is being read.
+    struct OpenPlaylist {
+        /// The url of the playlist.
+        std::string url;
+
+        /// The type of the playlist.
+        PlaylistType type;
+
+        /// The fetcher downloading the body of the playlist.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> contentFetcher;
+
+        /// The content returned by @c contentFetcher.
+        std::unique_ptr<avsCommon::utils::HTTPContent> httpContent;
+
+        /// The reader of the body of the playlist.
+        std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> reader;
+
+        /// The data which has been read from @c reader but not parsed yet.
+        std::string unparsedData;
+
+        /// Whether all of the body has been read from @c reader.
+        bool isClosed;
+
+        /// The next entry of the playlist, if it has been read ahead.
+        std::unique_ptr<PlaylistEntry> nextEntry;
+    };
 
     /**
-     * Parses the playlist pointed to by the url specified in a depth first search manner.
+     * Parses the playlist pointed to by the url specified in a depth first search manner.  The body of each playlist
+     * is parsed as it arrives, so that each entry is reported as soon as it is known, without waiting for the rest of
+     * its playlist.
      *
      * @param id The id of the request.
      * @param observer The observer to notify.
      * @param rootUrl The initial URL to parse.
+     * @param playlistTypesToNotBeParsed The playlist types to report as entries instead of parsing them.
      */
     void doDepthFirstSearch(
         int id,
@@ -76,25 +127,75 @@ private:
         std::vector<PlaylistType> playlistTypesToNotBeParsed);
 
     /**
-     * Parses an M3U playlist and returns the "children" URLs in the order they appeared in the playlist.
+     * Starts requesting the content-type of an entry.
+     *
+     * @param url The url of the entry.
+     * @return The entry.
+     */
+    std::unique_ptr<PlaylistEntry> startEntry(const std::string& url) const;
+
+    /**
+     * Starts downloading the body of a playlist.
      *
-     * @param content The content to parse.
-     * @return A vector of URLs in the order they appeared in the playlist.
+     * @param url The url of the playlist.
+     * @param type The type of the playlist.
+     * @return The playlist, or @c nullptr if an error occurred.
+     * @note This function should be used to retrieve content specifically from playlist URLs. Attempting to use this
+     * on a media URL could be blocking forever as the URL might point to a live stream.
      */
-    static std::vector<std::string> parseM3UContent(const std::string& playlistURL, const std::string& content);
+    std::unique_ptr<OpenPlaylist> openPlaylist(const std::string& url, PlaylistType type) const;
 
     /**
-     * Parses an PLS playlist and returns the "children" URLs in the order they appeared in the playlist.
+     * Reads the next line of the body of a playlist.
      *
-     * @param content The content to parse.
-     * @return A vector of URLs in the order they appeared in the playlist.
+     * @param playlist The playlist to read from.
+     * @param [out] line The line read.
+     * @param timeout How long to wait for each chunk of the body, or zero to wait until it arrives.
+     * @param [out] readFailed Set to @c true if reading the body failed.
+     * @return @c true if a line was read or @c false at the end of the body, on timeout or on error.
      */
-    static std::vector<std::string> parsePLSContent(const std::string& playlistURL, const std::string& content);
+    static bool readLine(
+        OpenPlaylist* playlist,
+        std::string* line,
+        std::chrono::milliseconds timeout,
+        bool* readFailed);
+
+    /**
+     * Reads the body of a playlist up to its next entry, unless it has already been read, and starts requesting the
+     * content-type of that entry into @c OpenPlaylist::nextEntry.  @c OpenPlaylist::nextEntry is left @c nullptr at
+     * the end of the playlist, or if the timeout expired first, in which case @c OpenPlaylist::isClosed is @c false.
+     *
+     * @param playlist The playlist to read from.
+     * @param timeout How long to wait for each chunk of the body, or zero to wait until it arrives.
+     * @return @c true if no error occured or @c false otherwise.
+     */
+    bool readNextEntry(OpenPlaylist* playlist, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+        const;
+
+    /**
+     * Parses a line of an M3U playlist.
+     *
+     * @param playlistURL The url of the playlist, with which relative urls are resolved.
+     * @param line The line to parse.
+     * @param [out] url The url of the entry on the line.
+     * @return @c true if the line holds an entry or @c false otherwise.
+     */
+    static bool parseM3ULine(const std::string& playlistURL, const std::string& line, std::string* url);
+
+    /**
+     * Parses a line of a PLS playlist.
+     *
+     * @param playlistURL The url of the playlist, with which relative urls are resolved.
+     * @param line The line to parse.
+     * @param [out] url The url of the entry on the line.
+     * @return @c true if the line holds an entry or @c false otherwise.
+     */
+    static bool parsePLSLine(const std::string& playlistURL, const std::string& line, std::string* url);
 
     /**
      * Determines the playlist type of an M3U playlist.
      *
-     * @param playlistContent The M3U playlist in @c std::string format.
+     * @param playlistContent The M3U playlist in @c std::string format, of which only the first line is needed.
      * @return @c true if the playlist is M3U8 or @c false otherwise
      */
     static bool isM3UPlaylistM3U8(const std::string& playlistContent);
@@ -107,17 +208,6 @@ private:
      */
     static void removeCarriageReturnFromLine(std::string* line);
 
-    /**
-     * Retrieves content from a URL and stores it into a string.
-     *
-     * @param url The URL to retrieve from.
-     * @param [out] content The playlist content.
-     * @return @c true if no error occured or @c false otherwise.
-     * @note This function should be used to retrieve content specifically from playlist URLs. Attempting to use this
-     * on a media URL could be blocking forever as the URL might point to a live stream.
-     */
-    bool getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const;
-
     /**
      * Determines whether the provided url is an absolute url as opposed to a relative url. This is done by simply
      * checking to see if the string contains the substring "://".
@@ -145,6 +235,9 @@ private:
     /// Used to retrieve content from URLs
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> m_contentFetcherFactory;
 
+    /// The cache of playlist resolutions, or @c nullptr.
+    std::shared_ptr<PlaylistCache> m_cache;
+
     /**
      * @c Executor which queues up operations from asynchronous API calls.
      *
@@ -0,0 +1,128 @@
+/*
+ * PlaylistCache.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "PlaylistParser/PlaylistCache.h"
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PlaylistCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// Separates the url of a playlist from the playlist types in the key of a resolution.
+static const char KEY_SEPARATOR = ' ';
+
+std::shared_ptr<PlaylistCache> PlaylistCache::create(std::chrono::seconds timeToLive, size_t maxResolutions) {
+    if (timeToLive.count() <= 0 || 0 == maxResolutions) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidParameters")
+                        .d("timeToLiveSeconds", timeToLive.count())
+                        .d("maxResolutions", maxResolutions));
+        return nullptr;
+    }
+    return std::shared_ptr<PlaylistCache>(new PlaylistCache(timeToLive, maxResolutions));
+}
+
+PlaylistCache::PlaylistCache(std::chrono::seconds timeToLive, size_t maxResolutions) :
+        m_timeToLive{timeToLive},
+        m_maxResolutions{maxResolutions} {
+}
+
+bool PlaylistCache::get(
+    const std::string& url,
+    const PlaylistTypes& playlistTypesToNotBeParsed,
+    std::vector<std::string>* urls) {
+    if (!urls) {
+        ACSDK_ERROR(LX("getFailed").d("reason", "nullUrls"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_resolutions.find(makeKey(url, playlistTypesToNotBeParsed));
+    if (it == m_resolutions.end()) {
+        return false;
+    }
+    if (it->second.expiry <= std::chrono::steady_clock::now()) {
+        m_resolutions.erase(it);
+        return false;
+    }
+    *urls = it->second.urls;
+    return true;
+}
+
+void PlaylistCache::put(
+    const std::string& url,
+    const PlaylistTypes& playlistTypesToNotBeParsed,
+    const std::vector<std::string>& urls) {
+    if (urls.empty()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto key = makeKey(url, playlistTypesToNotBeParsed);
+    m_resolutions.erase(key);
+    // Make room by dropping the expired resolutions, then the oldest one.
+    for (auto it = m_resolutions.begin(); it != m_resolutions.end();) {
+        it = it->second.expiry <= now ? m_resolutions.erase(it) : std::next(it);
+    }
+    if (m_resolutions.size() >= m_maxResolutions) {
+        using ResolutionEntry = std::pair<const std::string, Resolution>;
+        m_resolutions.erase(std::min_element(
+            m_resolutions.begin(), m_resolutions.end(), [](const ResolutionEntry& lhs, const ResolutionEntry& rhs) {
+                return lhs.second.expiry < rhs.second.expiry;
+            }));
+    }
+    m_resolutions[key] = {url, urls, now + m_timeToLive};
+}
+
+void PlaylistCache::invalidate(const std::string& url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_resolutions.begin(); it != m_resolutions.end();) {
+        const auto& resolution = it->second;
+        if (resolution.url == url || std::find(resolution.urls.begin(), resolution.urls.end(), url) !=
+                                         resolution.urls.end()) {
+            ACSDK_DEBUG9(LX("invalidated").sensitive("url", resolution.url));
+            it = m_resolutions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string PlaylistCache::makeKey(const std::string& url, const PlaylistTypes& playlistTypesToNotBeParsed) {
+    auto types = playlistTypesToNotBeParsed;
+    std::sort(types.begin(), types.end());
+    std::string key = url;
+    for (auto type : types) {
+        key += KEY_SEPARATOR;
+        key += std::to_string(static_cast<int>(type));
+    }
+    return key;
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
@@ -44,6 +44,12 @@ static const std::string PLS_CONTENT_TYPE = "scpls";
 /// The number of bytes read from the attachment with each read in the read loop.
 static const size_t CHUNK_SIZE(1024);
 
+/**
+ * How long to wait for the next entry of a playlist before reporting the current one.  If it has not arrived by then,
+ * the current entry is reported as ongoing, and the end of parsing is reported separately.
+ */
+static const std::chrono::milliseconds NEXT_ENTRY_TIMEOUT(20);
+
 /// The id of each request.
 static int g_id = 0;
 
@@ -57,11 +63,12 @@ static const std::string PLS_PLAYLIST_HEADER = "[playlist]";
 static const std::string PLS_FILE = "File";
 
 std::unique_ptr<PlaylistParser> PlaylistParser::create(
-    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) {
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    std::shared_ptr<PlaylistCache> cache) {
     if (!contentFetcherFactory) {
         return nullptr;
     }
-    return std::unique_ptr<PlaylistParser>(new PlaylistParser(contentFetcherFactory));
+    return std::unique_ptr<PlaylistParser>(new PlaylistParser(contentFetcherFactory, cache));
 }
 
 int PlaylistParser::parsePlaylist(
@@ -84,8 +91,10 @@ int PlaylistParser::parsePlaylist(
 }
 
 PlaylistParser::PlaylistParser(
-    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) :
-        m_contentFetcherFactory{contentFetcherFactory} {
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    std::shared_ptr<PlaylistCache> cache) :
+        m_contentFetcherFactory{contentFetcherFactory},
+        m_cache{cache} {
 }
 
 void PlaylistParser::doDepthFirstSearch(
@@ -95,203 +104,277 @@ void PlaylistParser::doDepthFirstSearch(
     std::vector<PlaylistType> playlistTypesToNotBeParsed) {
     /*
      * A depth first search, as follows:
-     * 1. Push root to vector.
-     * 2. While vector isn't empty, pop from front and push children, in the order they appeared, to front of vector.
+     * 1. Start with the root as the current entry.
+     * 2. If the current entry is a playlist to parse, open it and push it onto the stack of open playlists.
+     *    Otherwise, notify the observer of the entry.
+     * 3. The next entry is the next one read from the innermost open playlist, popping the playlists which have
+     *    ended.
+     *
+     * The next entry of a playlist is read ahead before notifying the observer, to tell whether parsing is still
+     * ongoing. Requesting the content-type of that entry at the time it is read ahead overlaps the request with the
+     * handling of the current entry. If the rest of a playlist has not arrived yet, the entry is reported as ongoing
+     * without waiting for it, and the end of parsing is reported with an empty url.
+     *
+     * The entries a playlist was resolved to are kept in the cache, if there is one, and reported from there the next
+     * time without fetching anything.  A url which is not a playlist is not cached, nor is a failed resolution.
      */
-    std::deque<std::string> urlsToParse;
-    urlsToParse.push_front(rootUrl);
-    while (!urlsToParse.empty()) {
-        auto url = urlsToParse.front();
-        urlsToParse.pop_front();
-        auto contentFetcher = m_contentFetcherFactory->create(url);
-        auto httpContent = contentFetcher->getContent(
-            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
-        if (!httpContent || !(*httpContent)) {
+    std::vector<std::string> resolvedUrls;
+    if (m_cache && m_cache->get(rootUrl, playlistTypesToNotBeParsed, &resolvedUrls)) {
+        ACSDK_DEBUG9(LX("resolvedFromCache").sensitive("url", rootUrl).d("entries", resolvedUrls.size()));
+        for (size_t i = 0; i < resolvedUrls.size(); ++i) {
+            observer->onPlaylistEntryParsed(
+                id,
+                resolvedUrls[i],
+                i + 1 < resolvedUrls.size() ? avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING
+                                            : avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+        }
+        return;
+    }
+    std::vector<std::unique_ptr<OpenPlaylist>> openPlaylists;
+    bool isSuccessPending = false;
+    bool isPlaylist = false;
+    auto entry = startEntry(rootUrl);
+    while (entry) {
+        const std::string url = entry->url;
+        if (!entry->httpContent || !(*entry->httpContent)) {
             ACSDK_ERROR(LX("getHTTPContent").d("reason", "badHTTPContentReceived"));
             observer->onPlaylistEntryParsed(id, url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
             return;
         }
-        std::string contentType = httpContent->contentType.get();
+        std::string contentType = entry->httpContent->contentType.get();
+        entry.reset();
         ACSDK_DEBUG9(LX("PlaylistParser").d("contentType", contentType).sensitive("url", url));
         std::transform(contentType.begin(), contentType.end(), contentType.begin(), ::tolower);
         // Checking the HTML content type to see if the URL is a playlist.
+        std::unique_ptr<OpenPlaylist> playlist;
         if (contentType.find(M3U_CONTENT_TYPE) != std::string::npos) {
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(url, &playlistContent)) {
+            playlist = openPlaylist(url, PlaylistType::M3U);
+            std::string firstLine;
+            bool readFailed = false;
+            if (playlist) {
+                readLine(playlist.get(), &firstLine, std::chrono::milliseconds(0), &readFailed);
+            }
+            if (!playlist || readFailed) {
                 ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", url));
                 observer->onPlaylistEntryParsed(id, url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
                 return;
             }
-            // This playlist may either be M3U or M3U8 so some additional parsing is required.
-            bool isM3U8 = isM3UPlaylistM3U8(playlistContent);
-            if (isM3U8) {
+            // This playlist may either be M3U or M3U8, which is told apart by its first line.
+            if (isM3UPlaylistM3U8(firstLine)) {
                 ACSDK_DEBUG9(LX("isM3U8Playlist").sensitive("url", url));
+                playlist->type = PlaylistType::M3U8;
             } else {
                 ACSDK_DEBUG9(LX("isPlainM3UPlaylist").sensitive("url", url));
             }
-            // TODO: investigate refactoring the two std::finds into a common place
-            if (std::find(
-                    playlistTypesToNotBeParsed.begin(),
-                    playlistTypesToNotBeParsed.end(),
-                    isM3U8 ? PlaylistType::M3U8 : PlaylistType::M3U) != playlistTypesToNotBeParsed.end()) {
-                observer->onPlaylistEntryParsed(
-                    id,
-                    url,
-                    urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                        : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
-                continue;
-            }
-            auto childrenUrls = parseM3UContent(url, playlistContent);
-            if (childrenUrls.empty()) {
-                ACSDK_ERROR(LX("noChildrenURLs"));
-                observer->onPlaylistEntryParsed(id, url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
-                return;
-            }
-            for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
-                urlsToParse.push_front(*reverseIt);
-            }
+            // Put the first line back, since it may be an entry of a plain M3U playlist.
+            playlist->unparsedData.insert(0, firstLine + '\n');
         } else if (contentType.find(PLS_CONTENT_TYPE) != std::string::npos) {
             ACSDK_DEBUG9(LX("isPLSPlaylist").sensitive("url", url));
             /*
              * This is for sure a PLS playlist, so if PLS is one of the desired playlist types to not be parsed, then
-             * notify and return immediately.
+             * there is no need to download it.
              */
-            if (std::find(playlistTypesToNotBeParsed.begin(), playlistTypesToNotBeParsed.end(), PlaylistType::PLS) !=
+            if (std::find(playlistTypesToNotBeParsed.begin(), playlistTypesToNotBeParsed.end(), PlaylistType::PLS) ==
                 playlistTypesToNotBeParsed.end()) {
-                observer->onPlaylistEntryParsed(
-                    id,
-                    url,
-                    urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                        : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
-                continue;
-            }
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(url, &playlistContent)) {
-                observer->onPlaylistEntryParsed(id, url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
-                return;
+                playlist = openPlaylist(url, PlaylistType::PLS);
+                if (!playlist) {
+                    observer->onPlaylistEntryParsed(
+                        id, url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
+                    return;
+                }
             }
-            auto childrenUrls = parsePLSContent(url, playlistContent);
-            if (childrenUrls.empty()) {
+        }
+
+        if (playlist &&
+            std::find(playlistTypesToNotBeParsed.begin(), playlistTypesToNotBeParsed.end(), playlist->type) ==
+                playlistTypesToNotBeParsed.end()) {
+            if (!readNextEntry(playlist.get()) || !playlist->nextEntry) {
+                ACSDK_ERROR(LX("noChildrenURLs").sensitive("url", url));
                 observer->onPlaylistEntryParsed(id, url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
                 return;
             }
-            for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
-                urlsToParse.push_front(*reverseIt);
-            }
+            openPlaylists.push_back(std::move(playlist));
+            isPlaylist = true;
         } else {
-            // This is a non-playlist URL or a playlist that we don't support (M3U, M3U8, PLS).
+            /*
+             * This is a non-playlist URL, a playlist that we don't support (M3U, M3U8, PLS) or one not to be parsed.
+             * Parsing is still ongoing if any of the open playlists has another entry.
+             */
+            bool hasMoreEntries = false;
+            for (auto it = openPlaylists.rbegin(); it != openPlaylists.rend() && !hasMoreEntries; ++it) {
+                if (!readNextEntry(it->get(), NEXT_ENTRY_TIMEOUT)) {
+                    observer->onPlaylistEntryParsed(
+                        id, (*it)->url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
+                    return;
+                }
+                hasMoreEntries = (*it)->nextEntry || !(*it)->isClosed;
+            }
+            isSuccessPending = hasMoreEntries;
+            resolvedUrls.push_back(url);
             observer->onPlaylistEntryParsed(
                 id,
                 url,
-                urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                    : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
+                hasMoreEntries ? avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING
+                               : avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+        }
+
+        while (!entry && !openPlaylists.empty()) {
+            auto& innermost = openPlaylists.back();
+            if (!readNextEntry(innermost.get())) {
+                observer->onPlaylistEntryParsed(
+                    id, innermost->url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR);
+                return;
+            }
+            entry = std::move(innermost->nextEntry);
+            if (!entry) {
+                openPlaylists.pop_back();
+            }
         }
     }
+    if (m_cache && isPlaylist) {
+        m_cache->put(rootUrl, playlistTypesToNotBeParsed, resolvedUrls);
+    }
+    if (isSuccessPending) {
+        observer->onPlaylistEntryParsed(id, "", avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+    }
 }
 
-bool PlaylistParser::getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const {
-    if (!content) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullString"));
-        return false;
+std::unique_ptr<PlaylistParser::PlaylistEntry> PlaylistParser::startEntry(const std::string& url) const {
+    std::unique_ptr<PlaylistEntry> entry(new PlaylistEntry());
+    entry->url = url;
+    entry->contentFetcher = m_contentFetcherFactory->create(url);
+    if (entry->contentFetcher) {
+        entry->httpContent = entry->contentFetcher->getContent(
+            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
     }
-    auto contentFetcher = m_contentFetcherFactory->create(url);
-    auto httpContent =
-        contentFetcher->getContent(avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
-    if (!httpContent) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullHTTPContentReceived"));
-        return false;
+    return entry;
+}
+
+std::unique_ptr<PlaylistParser::OpenPlaylist> PlaylistParser::openPlaylist(const std::string& url, PlaylistType type)
+    const {
+    std::unique_ptr<OpenPlaylist> playlist(new OpenPlaylist());
+    playlist->url = url;
+    playlist->type = type;
+    playlist->isClosed = false;
+    playlist->contentFetcher = m_contentFetcherFactory->create(url);
+    if (!playlist->contentFetcher) {
+        ACSDK_ERROR(LX("openPlaylistFailed").d("reason", "nullContentFetcher"));
+        return nullptr;
     }
-    if (!(*httpContent)) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "badHTTPContentReceived"));
-        return false;
+    playlist->httpContent = playlist->contentFetcher->getContent(
+        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    if (!playlist->httpContent) {
+        ACSDK_ERROR(LX("openPlaylistFailed").d("reason", "nullHTTPContentReceived"));
+        return nullptr;
     }
-    auto reader = httpContent->dataStream->createReader(avsCommon::avs::attachment::AttachmentReader::Policy::BLOCKING);
-    if (!reader) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "failedToCreateStreamReader"));
-        return false;
+    if (!(*playlist->httpContent)) {
+        ACSDK_ERROR(LX("openPlaylistFailed").d("reason", "badHTTPContentReceived"));
+        return nullptr;
     }
-    avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus =
-        avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
-    std::string playlistContent;
+    playlist->reader =
+        playlist->httpContent->dataStream->createReader(avsCommon::avs::attachment::AttachmentReader::Policy::BLOCKING);
+    if (!playlist->reader) {
+        ACSDK_ERROR(LX("openPlaylistFailed").d("reason", "failedToCreateStreamReader"));
+        return nullptr;
+    }
+    return playlist;
+}
+
+bool PlaylistParser::readLine(
+    OpenPlaylist* playlist,
+    std::string* line,
+    std::chrono::milliseconds timeout,
+    bool* readFailed) {
     std::vector<char> buffer(CHUNK_SIZE, 0);
-    bool streamClosed = false;
-    while (!streamClosed) {
-        auto bytesRead = reader->read(buffer.data(), buffer.size(), &readStatus);
+    while (true) {
+        auto endOfLine = playlist->unparsedData.find('\n');
+        if (endOfLine != std::string::npos) {
+            *line = playlist->unparsedData.substr(0, endOfLine);
+            playlist->unparsedData.erase(0, endOfLine + 1);
+            removeCarriageReturnFromLine(line);
+            return true;
+        }
+        if (playlist->isClosed) {
+            if (playlist->unparsedData.empty()) {
+                return false;
+            }
+            // The last line of the body need not end with a line break.
+            line->swap(playlist->unparsedData);
+            playlist->unparsedData.clear();
+            removeCarriageReturnFromLine(line);
+            return true;
+        }
+        avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus =
+            avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
+        auto bytesRead = playlist->reader->read(buffer.data(), buffer.size(), &readStatus, timeout);
         switch (readStatus) {
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED:
-                streamClosed = true;
-                if (bytesRead == 0) {
-                    break;
-                }
+                playlist->isClosed = true;
             /* FALL THROUGH - to add any data received even if closed */
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
-                playlistContent.append(buffer.data(), bytesRead);
+                playlist->unparsedData.append(buffer.data(), bytesRead);
                 break;
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
+                playlist->unparsedData.append(buffer.data(), bytesRead);
+                return false;
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_OVERRUN:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_INTERNAL:
-                ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "readError"));
+                ACSDK_ERROR(LX("readLineFailed").d("reason", "readError"));
+                *readFailed = true;
                 return false;
         }
     }
-    *content = playlistContent;
-    return true;
 }
 
-std::vector<std::string> PlaylistParser::parseM3UContent(const std::string& playlistURL, const std::string& content) {
+bool PlaylistParser::readNextEntry(OpenPlaylist* playlist, std::chrono::milliseconds timeout) const {
+    std::string line;
+    bool readFailed = false;
+    while (!playlist->nextEntry && readLine(playlist, &line, timeout, &readFailed)) {
+        std::string url;
+        bool isEntry = PlaylistType::PLS == playlist->type ? parsePLSLine(playlist->url, line, &url)
+                                                           : parseM3ULine(playlist->url, line, &url);
+        if (isEntry) {
+            playlist->nextEntry = startEntry(url);
+        }
+    }
+    return !readFailed;
+}
+
+bool PlaylistParser::parseM3ULine(const std::string& playlistURL, const std::string& line, std::string* url) {
     /*
      * An M3U playlist is formatted such that all metadata information is prepended with a '#' and everything else is a
      * URL to play.
      */
-    std::vector<std::string> urlsParsed;
-    std::istringstream iss(content);
-    std::string line;
-    while (std::getline(iss, line)) {
-        removeCarriageReturnFromLine(&line);
-        std::istringstream iss2(line);
-        char firstChar;
-        iss2 >> firstChar;
-        if (!iss2 || firstChar == '#') {
-            continue;
-        }
-        // at this point, "line" is a url
-        if (isURLAbsolute(line)) {
-            urlsParsed.push_back(line);
-        } else {
-            std::string absoluteURL;
-            if (getAbsoluteURLFromRelativePathToURL(playlistURL, line, &absoluteURL)) {
-                urlsParsed.push_back(absoluteURL);
-            }
-        }
+    std::istringstream iss(line);
+    char firstChar;
+    iss >> firstChar;
+    if (!iss || firstChar == '#') {
+        return false;
     }
-    return urlsParsed;
+    // at this point, "line" is a url
+    if (isURLAbsolute(line)) {
+        *url = line;
+        return true;
+    }
+    return getAbsoluteURLFromRelativePathToURL(playlistURL, line, url);
 }
 
-std::vector<std::string> PlaylistParser::parsePLSContent(const std::string& playlistURL, const std::string& content) {
+bool PlaylistParser::parsePLSLine(const std::string& playlistURL, const std::string& line, std::string* url) {
     /*
      * A PLS playlist is formatted such that all URLs to play are prepended with "File'N'=", where 'N' refers to the
      * numbered URL. For example "File1=url.com ... File2="anotherurl.com".
      */
-    std::vector<std::string> urlsParsed;
-    std::istringstream iss(content);
-    std::string line;
-    while (std::getline(iss, line)) {
-        removeCarriageReturnFromLine(&line);
-        if (line.compare(0, PLS_FILE.length(), PLS_FILE) == 0) {
-            std::string url = line.substr(line.find_first_of('=') + 1);
-            if (isURLAbsolute(url)) {
-                urlsParsed.push_back(url);
-            } else {
-                std::string absoluteURL;
-                if (getAbsoluteURLFromRelativePathToURL(playlistURL, url, &absoluteURL)) {
-                    urlsParsed.push_back(absoluteURL);
-                }
-            }
-        }
+    if (line.compare(0, PLS_FILE.length(), PLS_FILE) != 0) {
+        return false;
+    }
+    std::string entry = line.substr(line.find_first_of('=') + 1);
+    if (isURLAbsolute(entry)) {
+        *url = entry;
+        return true;
     }
-    return urlsParsed;
+    return getAbsoluteURLFromRelativePathToURL(playlistURL, entry, url);
 }
 
 void PlaylistParser::removeCarriageReturnFromLine(std::string* line) {
@@ -0,0 +1,118 @@
+/*
+ * PlaylistCacheTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "PlaylistParser/PlaylistCache.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+using PlaylistType = avsCommon::utils::playlistParser::PlaylistParserInterface::PlaylistType;
+
+/// How long the resolutions of the caches under test are used for.
+static const std::chrono::seconds TIME_TO_LIVE(60);
+
+/// The largest number of resolutions kept by the caches under test.
+static const size_t MAX_RESOLUTIONS = 2;
+
+/// A playlist url.
+static const std::string PLAYLIST_URL_1 = "http://example.com/station1.m3u";
+
+/// Another playlist url.
+static const std::string PLAYLIST_URL_2 = "http://example.com/station2.pls";
+
+/// A third playlist url.
+static const std::string PLAYLIST_URL_3 = "http://example.com/station3.m3u";
+
+/// The entries the playlists are resolved to.
+static const std::vector<std::string> ENTRY_URLS = {"http://example.com/stream1.mp3", "http://example.com/stream2.mp3"};
+
+/**
+ * Verify that a cache can not be created with a time to live or a number of resolutions of zero.
+ */
+TEST(PlaylistCacheTest, createWithInvalidParameters) {
+    EXPECT_FALSE(PlaylistCache::create(std::chrono::seconds(0), MAX_RESOLUTIONS));
+    EXPECT_FALSE(PlaylistCache::create(TIME_TO_LIVE, 0));
+}
+
+/**
+ * Verify that a resolution is found only for the playlist types it was made with.
+ */
+TEST(PlaylistCacheTest, putAndGet) {
+    auto cache = PlaylistCache::create(TIME_TO_LIVE, MAX_RESOLUTIONS);
+    ASSERT_TRUE(cache);
+    std::vector<std::string> urls;
+    EXPECT_FALSE(cache->get(PLAYLIST_URL_1, {}, &urls));
+    cache->put(PLAYLIST_URL_1, {PlaylistType::M3U8, PlaylistType::PLS}, ENTRY_URLS);
+    ASSERT_TRUE(cache->get(PLAYLIST_URL_1, {PlaylistType::PLS, PlaylistType::M3U8}, &urls));
+    EXPECT_EQ(urls, ENTRY_URLS);
+    EXPECT_FALSE(cache->get(PLAYLIST_URL_1, {}, &urls));
+}
+
+/**
+ * Verify that a resolution is not used once it expired.
+ */
+TEST(PlaylistCacheTest, expiry) {
+    auto cache = PlaylistCache::create(std::chrono::seconds(1), MAX_RESOLUTIONS);
+    ASSERT_TRUE(cache);
+    cache->put(PLAYLIST_URL_1, {}, ENTRY_URLS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    std::vector<std::string> urls;
+    EXPECT_FALSE(cache->get(PLAYLIST_URL_1, {}, &urls));
+}
+
+/**
+ * Verify that invalidating a playlist or one of its entries drops its resolutions only.
+ */
+TEST(PlaylistCacheTest, invalidate) {
+    auto cache = PlaylistCache::create(TIME_TO_LIVE, MAX_RESOLUTIONS);
+    ASSERT_TRUE(cache);
+    std::vector<std::string> urls;
+    cache->put(PLAYLIST_URL_1, {}, ENTRY_URLS);
+    cache->put(PLAYLIST_URL_2, {}, {PLAYLIST_URL_3});
+    cache->invalidate(ENTRY_URLS.back());
+    EXPECT_FALSE(cache->get(PLAYLIST_URL_1, {}, &urls));
+    EXPECT_TRUE(cache->get(PLAYLIST_URL_2, {}, &urls));
+    cache->invalidate(PLAYLIST_URL_2);
+    EXPECT_FALSE(cache->get(PLAYLIST_URL_2, {}, &urls));
+}
+
+/**
+ * Verify that the oldest resolution is dropped to make room for a new one.
+ */
+TEST(PlaylistCacheTest, evictOldest) {
+    auto cache = PlaylistCache::create(TIME_TO_LIVE, MAX_RESOLUTIONS);
+    ASSERT_TRUE(cache);
+    std::vector<std::string> urls;
+    cache->put(PLAYLIST_URL_1, {}, ENTRY_URLS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    cache->put(PLAYLIST_URL_2, {}, ENTRY_URLS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    cache->put(PLAYLIST_URL_3, {}, ENTRY_URLS);
+    EXPECT_FALSE(cache->get(PLAYLIST_URL_1, {}, &urls));
+    EXPECT_TRUE(cache->get(PLAYLIST_URL_2, {}, &urls));
+    EXPECT_TRUE(cache->get(PLAYLIST_URL_3, {}, &urls));
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
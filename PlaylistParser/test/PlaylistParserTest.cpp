@@ -15,6 +15,7 @@
  * permissions and limitations under the License.
  */
 
+#include <atomic>
 #include <memory>
 #include <chrono>
 #include <mutex>
@@ -40,6 +41,9 @@ using namespace avsCommon::avs;
 /// Short time out for when callbacks are expected not to occur.
 static const auto SHORT_TIMEOUT = std::chrono::milliseconds(50);
 
+/// Time out for when callbacks are expected to occur.
+static const auto LONG_TIMEOUT = std::chrono::milliseconds(1000);
+
 /// Test M3U url.
 static const std::string TEST_M3U_PLAYLIST_URL{"http://sanjayisthecoolest.com/sample.m3u"};
 
@@ -116,6 +120,15 @@ static const std::vector<std::string> TEST_HLS_RECURSIVE_PLAYLIST_URLS = {
 
 static const size_t NUM_PARSES_EXPECTED_WHEN_NO_PARSING = 1;
 
+/// A test playlist whose body is still being downloaded.
+static const std::string TEST_STREAMING_PLAYLIST_URL{"http://sanjayisthecoolest.com/streaming.m3u"};
+
+/// The part of @c TEST_STREAMING_PLAYLIST_URL which has been downloaded.
+static const std::string TEST_STREAMING_PLAYLIST_CONTENT = "http://stream.radiotime.com/sample.mp3\n";
+
+/// The rest of @c TEST_STREAMING_PLAYLIST_URL.
+static const std::string TEST_STREAMING_PLAYLIST_REMAINING_CONTENT = "http://live-mp3-128.kexp.org\n";
+
 static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     // Valid playlist content types
     {TEST_M3U_PLAYLIST_URL, "audio/mpegurl"},
@@ -123,6 +136,7 @@ static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     {TEST_HLS_PLAYLIST_URL, "application/vnd.apple.mpegurl"},
     {TEST_PLS_PLAYLIST_URL, "audio/x-scpls"},
     {TEST_HLS_RECURSIVE_PLAYLIST_URL, "audio/mpegurl"},
+    {TEST_STREAMING_PLAYLIST_URL, "audio/mpegurl"},
     // Not playlist content types
     {"http://stream.radiotime.com/sample.mp3", "audio/mpeg"},
     {"http://live-mp3-128.kexp.org", "audio/mpeg"},
@@ -139,12 +153,24 @@ static const std::unordered_map<std::string, std::string> urlsToContent{
     {TEST_M3U_RELATIVE_PLAYLIST_URL, TEST_M3U_RELATIVE_PLAYLIST_CONTENT},
     {TEST_HLS_PLAYLIST_URL, TEST_HLS_PLAYLIST_CONTENT},
     {TEST_PLS_PLAYLIST_URL, TEST_PLS_CONTENT},
-    {TEST_HLS_RECURSIVE_PLAYLIST_URL, TEST_HLS_RECURSIVE_PLAYLIST_CONTENT}};
+    {TEST_HLS_RECURSIVE_PLAYLIST_URL, TEST_HLS_RECURSIVE_PLAYLIST_CONTENT},
+    {TEST_STREAMING_PLAYLIST_URL, TEST_STREAMING_PLAYLIST_CONTENT}};
 
 /// A mock content fetcher
 class MockContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
 public:
-    MockContentFetcher(const std::string& url) : m_url{url} {
+    /**
+     * Constructor.
+     *
+     * @param url The url to fetch.
+     * @param streamingWriter Where to keep the writer of the body of @c TEST_STREAMING_PLAYLIST_URL, which is left
+     * open so that the download of the body has not finished.
+     */
+    MockContentFetcher(
+        const std::string& url,
+        std::shared_ptr<std::unique_ptr<avsCommon::avs::attachment::AttachmentWriter>> streamingWriter) :
+            m_url{url},
+            m_streamingWriter{streamingWriter} {
     }
 
     std::unique_ptr<avsCommon::utils::HTTPContent> getContent(FetchOptions fetchOption) {
@@ -197,17 +223,31 @@ private:
         }
         avsCommon::avs::attachment::AttachmentWriter::WriteStatus writeStatus;
         writer->write(string.data(), string.size(), &writeStatus);
+        if (TEST_STREAMING_PLAYLIST_URL == m_url) {
+            *m_streamingWriter = std::move(writer);
+        }
         return stream;
     };
 
     std::string m_url;
+
+    std::shared_ptr<std::unique_ptr<avsCommon::avs::attachment::AttachmentWriter>> m_streamingWriter;
 };
 
 /// A mock factory that creates mock content fetchers
 class MockContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface {
+public:
     std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> create(const std::string& url) {
-        return avsCommon::utils::memory::make_unique<MockContentFetcher>(url);
+        ++numFetchersCreated;
+        return avsCommon::utils::memory::make_unique<MockContentFetcher>(url, streamingWriter);
     }
+
+    /// The number of content fetchers created so far.
+    std::atomic<int> numFetchersCreated{0};
+
+    /// The writer of the body of @c TEST_STREAMING_PLAYLIST_URL, once it has been fetched.
+    std::shared_ptr<std::unique_ptr<avsCommon::avs::attachment::AttachmentWriter>> streamingWriter =
+        std::make_shared<std::unique_ptr<avsCommon::avs::attachment::AttachmentWriter>>();
 };
 
 /**
@@ -266,6 +306,11 @@ protected:
         testObserver = std::make_shared<TestParserObserver>();
     }
 
+    void TearDown() {
+        // Let a parse blocked on the body of TEST_STREAMING_PLAYLIST_URL finish.
+        mockFactory->streamingWriter->reset();
+    }
+
     /// A mock factory to create mock content fetchers
     std::shared_ptr<MockContentFetcherFactory> mockFactory;
 
@@ -392,6 +437,60 @@ TEST_F(PlaylistParserTest, testNotParsingCertainPlaylistTypes) {
     ASSERT_EQ(results.at(0).url, TEST_HLS_PLAYLIST_URL);
 }
 
+/**
+ * Tests that the entries of a playlist are reported while its body is still being downloaded.
+ * Calls @c parsePlaylist and expects the first entry before the rest of the body arrives.
+ */
+TEST_F(PlaylistParserTest, testParsingStreamingPlaylist) {
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_STREAMING_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(1, LONG_TIMEOUT);
+    ASSERT_EQ(1u, results.size());
+    ASSERT_EQ(results.at(0).url, TEST_M3U_PLAYLIST_URLS.at(0));
+    ASSERT_EQ(results.at(0).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
+
+    avsCommon::avs::attachment::AttachmentWriter::WriteStatus writeStatus;
+    (*mockFactory->streamingWriter)
+        ->write(
+            TEST_STREAMING_PLAYLIST_REMAINING_CONTENT.data(),
+            TEST_STREAMING_PLAYLIST_REMAINING_CONTENT.size(),
+            &writeStatus);
+    results = testObserver->waitForNCallbacks(TEST_M3U_PLAYLIST_URLS.size(), LONG_TIMEOUT);
+    ASSERT_EQ(TEST_M3U_PLAYLIST_URLS.size(), results.size());
+    ASSERT_EQ(results.at(1).url, TEST_M3U_PLAYLIST_URLS.at(1));
+    ASSERT_EQ(results.at(1).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
+
+    // The end of the body is only known after the last entry was reported, so it is reported on its own.
+    mockFactory->streamingWriter->reset();
+    results = testObserver->waitForNCallbacks(TEST_M3U_PLAYLIST_URLS.size() + 1, LONG_TIMEOUT);
+    ASSERT_EQ(TEST_M3U_PLAYLIST_URLS.size() + 1, results.size());
+    ASSERT_TRUE(results.at(2).url.empty());
+    ASSERT_EQ(results.at(2).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+}
+
+/**
+ * Tests that a playlist resolved with a cache is resolved again from the cache, without fetching anything.
+ * Calls @c parsePlaylist twice and expects the same entries from both, but content fetched only by the first.
+ */
+TEST_F(PlaylistParserTest, testParsingCachedPlaylist) {
+    auto cache = PlaylistCache::create(std::chrono::seconds(60), 1);
+    ASSERT_TRUE(cache);
+    playlistParser = PlaylistParser::create(mockFactory, cache);
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_M3U_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES, results.size());
+    auto numFetchersCreated = mockFactory->numFetchersCreated.load();
+
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_M3U_PLAYLIST_URL, testObserver));
+    results = testObserver->waitForNCallbacks(2 * TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES);
+    ASSERT_EQ(2 * TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES, results.size());
+    for (unsigned int i = 0; i < TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES; ++i) {
+        auto& result = results.at(TEST_M3U_PLAYLIST_URL_EXPECTED_PARSES + i);
+        ASSERT_EQ(result.url, TEST_M3U_PLAYLIST_URLS.at(i));
+        ASSERT_EQ(result.parseResult, results.at(i).parseResult);
+    }
+    ASSERT_EQ(mockFactory->numFetchersCreated.load(), numFetchersCreated);
+}
+
 }  // namespace test
 }  // namespace playlistParser
 }  // namespace alexaClientSDK
\ No newline at end of file
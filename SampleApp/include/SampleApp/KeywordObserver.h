@@ -20,9 +20,11 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <AVSCommon/AVS/AudioInputStream.h>
 #include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
 #include <DefaultClient/DefaultClient.h>
 
 namespace alexaClientSDK {
@@ -38,10 +40,13 @@ public:
      *
      * @param client The default SDK client.
      * @param audioProvider The audio provider from which to stream audio data from.
+     * @param bargeInMediaPlayers The media players to attenuate at once when a wake word is detected, before the
+     * client is notified of it.
      */
     KeywordObserver(
         std::shared_ptr<defaultClient::DefaultClient> client,
-        capabilityAgents::aip::AudioProvider audioProvider);
+        capabilityAgents::aip::AudioProvider audioProvider,
+        std::vector<std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface>> bargeInMediaPlayers = {});
 
     void onKeyWordDetected(
         std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
@@ -55,6 +60,9 @@ private:
 
     /// The audio provider.
     capabilityAgents::aip::AudioProvider m_audioProvider;
+
+    /// The media players to attenuate when a wake word is detected.
+    std::vector<std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface>> m_bargeInMediaPlayers;
 };
 
 }  // namespace sampleApp
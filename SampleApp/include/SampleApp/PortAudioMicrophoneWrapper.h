@@ -18,6 +18,8 @@
 #ifndef ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_PORT_AUDIO_MICROPHONE_WRAPPER_H_
 #define ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_PORT_AUDIO_MICROPHONE_WRAPPER_H_
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
@@ -28,11 +30,20 @@
 namespace alexaClientSDK {
 namespace sampleApp {
 
-/// This acts as a wrapper around PortAudio, a cross-platform open-source audio I/O library.
+/**
+ * This acts as a wrapper around PortAudio, a cross-platform open-source audio I/O library.
+ *
+ * By default, audio is copied into the stream from PortAudio's callback, which is called with buffers of whatever size
+ * the host API chooses.  If @c "captureIntervalInMilliseconds" is set in the @c "sampleApp" configuration, audio is
+ * instead read on a capture thread of our own in fixed periods of that length, directly into space reserved in the
+ * stream, so each period costs one write to the stream and readers wake up at a steady rate.  Setting
+ * @c "realTimeCapture" to @c true there also runs the capture thread with real-time scheduling, where the process is
+ * permitted to.
+ */
 class PortAudioMicrophoneWrapper {
 public:
     /**
-     * Creates a @c PortAudioMicrophoneWrapper.
+     * Creates a @c PortAudioMicrophoneWrapper, configured from the @c "sampleApp" configuration.
      *
      * @param stream The shared data stream to write to.
      * @return A unique_ptr to a @c PortAudioMicrophoneWrapper if creation was successful and @c nullptr otherwise.
@@ -88,6 +99,15 @@ private:
     /// Initializes PortAudio
     bool initialize();
 
+    /**
+     * The loop run by @c m_captureThread in fixed period mode, which reads each period from PortAudio into space
+     * reserved in the stream until @c m_isCapturing is cleared.
+     */
+    void captureLoop();
+
+    /// Raises the priority of the calling thread to real-time scheduling, if permitted.
+    static void setRealTimePriority();
+
     /// The stream of audio data.
     const std::shared_ptr<avsCommon::avs::AudioInputStream> m_audioInputStream;
 
@@ -97,6 +117,18 @@ private:
     /// The PortAudio stream
     PaStream* m_paStream;
 
+    /// The number of samples read in each period, or zero if audio is delivered by @c PortAudioCallback().
+    unsigned long m_samplesPerPeriod;
+
+    /// Whether the capture thread runs with real-time scheduling.
+    bool m_isRealTimeCapture;
+
+    /// Whether @c m_captureThread should keep reading.
+    std::atomic<bool> m_isCapturing;
+
+    /// The thread which reads audio in fixed period mode.
+    std::thread m_captureThread;
+
     /**
      * A lock to seralize access to startStreamingMicrophoneData() and stopStreamingMicrophoneData() between different
      * threads.
@@ -20,6 +20,7 @@
 
 #include "ConsolePrinter.h"
 #include "UserInputManager.h"
+#include "UtteranceBenchmark.h"
 
 #ifdef KWD
 #include <KWD/AbstractKeywordDetector.h>
@@ -47,7 +48,10 @@ public:
         const std::string& pathToInputFolder,
         const std::string& logLevel = "");
 
-    /// Runs the application, blocking until the user asks the application to quit.
+    /**
+     * Runs the application, blocking until the user asks the application to quit, or until the utterance benchmark is
+     * done if one is configured.
+     */
     void run();
 
 private:
@@ -65,6 +69,9 @@ private:
     /// The @c UserInputManager which controls the client.
     std::unique_ptr<UserInputManager> m_userInputManager;
 
+    /// The benchmark which stands in for the user and the microphone, if one is configured.
+    std::shared_ptr<UtteranceBenchmark> m_utteranceBenchmark;
+
 #ifdef KWD
     /// The Wakeword Detector which can wake up the client using audio input.
     std::unique_ptr<kwd::AbstractKeywordDetector> m_keywordDetector;
@@ -18,6 +18,10 @@
 #ifndef ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_UI_MANAGER_H_
 #define ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_UI_MANAGER_H_
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
 #include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/ConnectionStatusObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
@@ -30,12 +34,37 @@ namespace sampleApp {
 /**
  * This class manages the states that the user will see when interacting with the Sample Application. For now, it simply
  * prints states to the screen.
+ *
+ * The observer callbacks are called on SDK threads, so they only record the new state and queue at most one update
+ * on an internal executor, which does the printing and calls the @c StateIndicator, if one is set.  A burst of state
+ * changes is coalesced into a single update showing the latest state.
  */
 class UIManager
         : public avsCommon::sdkInterfaces::DialogUXStateObserverInterface
         , public avsCommon::sdkInterfaces::ConnectionStatusObserverInterface
         , public avsCommon::sdkInterfaces::SingleSettingObserverInterface {
 public:
+    /**
+     * A hook to drive a state indicator, such as LEDs, alongside the printed state.  It is called on the internal
+     * executor with the latest dialog UX and connection states whenever either changes, so it may block without
+     * stalling the SDK.
+     */
+    using StateIndicator = std::function<void(
+        DialogUXState dialogState,
+        avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status connectionStatus)>;
+
+    /**
+     * Constructor.
+     */
+    UIManager();
+
+    /**
+     * Sets the @c StateIndicator to call on state changes.
+     *
+     * @param stateIndicator The hook to call, or an empty function to stop calling one.
+     */
+    void setStateIndicator(StateIndicator stateIndicator);
+
     void onDialogUXStateChanged(DialogUXState state) override;
 
     void onConnectionStatusChanged(const Status status, const ChangedReason reason) override;
@@ -78,18 +107,45 @@ public:
     void microphoneOn();
 
 private:
+    /**
+     * Queues an update of the displayed state unless one is already queued.  The update picks up the latest state
+     * when it runs.
+     */
+    void scheduleStateUpdate();
+
+    /**
+     * Applies the latest dialog UX and connection states, printing them and calling the @c StateIndicator if either
+     * changed.  This should only be used within the internal executor.
+     */
+    void updateState();
+
     /**
      * Prints the current state of Alexa after checking what the appropriate message to display is based on the current
      * component states. This should only be used within the internal executor.
      */
     void printState();
 
-    /// The current dialog UX state of the SDK
+    /// The latest dialog UX state reported by the SDK.
+    std::atomic<DialogUXState> m_latestDialogState;
+
+    /// The latest connection state reported by the SDK.
+    std::atomic<avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status> m_latestConnectionStatus;
+
+    /// Whether an update of the displayed state is queued on @c m_executor.
+    std::atomic_flag m_isStateUpdateQueued;
+
+    /// The dialog UX state last displayed.  This should only be accessed within the internal executor.
     DialogUXState m_dialogState;
 
-    /// The current connection state of the SDK.
+    /// The connection state last displayed.  This should only be accessed within the internal executor.
     avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status m_connectionStatus;
 
+    /// Serializes access to @c m_stateIndicator.
+    std::mutex m_stateIndicatorMutex;
+
+    /// The hook to call on state changes.
+    StateIndicator m_stateIndicator;
+
     /// An internal executor that performs execution of callable objects passed to it sequentially but asynchronously.
     avsCommon::utils::threading::Executor m_executor;
 };
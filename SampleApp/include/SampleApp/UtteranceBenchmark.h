@@ -0,0 +1,163 @@
+/*
+ * UtteranceBenchmark.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_UTTERANCE_BENCHMARK_H_
+#define ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_UTTERANCE_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
+#include <DefaultClient/DefaultClient.h>
+
+namespace alexaClientSDK {
+namespace sampleApp {
+
+/**
+ * Measures the latency of voice interactions by playing recorded utterances into the audio input stream in place of
+ * the microphone, at the pace a microphone would.  Each utterance goes through the whole SDK: the keyword detector,
+ * if there is one, the @c AudioInputProcessor, the transport, the directive sequencer and the
+ * @c SpeechSynthesizer.  Without a keyword detector, each utterance is started as tap to talk.
+ *
+ * The latencies come from @c DialogLatencyTracer, measured from the end of the wakeword, or from the start of the
+ * utterance without a keyword detector.  They are printed as percentiles once every utterance has been played the
+ * number of times asked for.
+ *
+ * The utterances are listed in a script, one path to a WAV file per line, relative to the script.  Blank lines and
+ * lines starting with '#' are skipped.  The files must be 16 kHz, 16 bit, mono LPCM, as those in
+ * @c Integration/inputs are.  With a keyword detector, each utterance must start with the wakeword.
+ */
+class UtteranceBenchmark : public avsCommon::sdkInterfaces::DialogUXStateObserverInterface {
+public:
+    /**
+     * Create an @c UtteranceBenchmark.
+     *
+     * @param client The client to benchmark.
+     * @param stream The stream the client reads audio from.  The benchmark is its only writer.
+     * @param tapToTalkAudioProvider The audio provider to start utterances with when there is no keyword detector.
+     * @param hasKeywordDetector Whether a keyword detector starts the utterances.
+     * @param scriptFilePath The path of the script listing the utterances.
+     * @param iterations How many times to play each utterance.
+     * @return The benchmark, or @c nullptr if the script or one of its utterances could not be read.
+     */
+    static std::shared_ptr<UtteranceBenchmark> create(
+        std::shared_ptr<defaultClient::DefaultClient> client,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        capabilityAgents::aip::AudioProvider tapToTalkAudioProvider,
+        bool hasKeywordDetector,
+        const std::string& scriptFilePath,
+        int iterations);
+
+    void onDialogUXStateChanged(
+        avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState newState) override;
+
+    /**
+     * Play every utterance the number of times asked for, then print the latencies.  This blocks until done.
+     */
+    void run();
+
+private:
+    /// An utterance of the script.
+    struct Utterance {
+        /// The path of the WAV file.
+        std::string path;
+
+        /// The samples of the utterance.
+        std::vector<int16_t> samples;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param client The client to benchmark.
+     * @param writer The writer to the stream the client reads audio from.
+     * @param tapToTalkAudioProvider The audio provider to start utterances with when there is no keyword detector.
+     * @param hasKeywordDetector Whether a keyword detector starts the utterances.
+     * @param utterances The utterances of the script.
+     * @param iterations How many times to play each utterance.
+     */
+    UtteranceBenchmark(
+        std::shared_ptr<defaultClient::DefaultClient> client,
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> writer,
+        capabilityAgents::aip::AudioProvider tapToTalkAudioProvider,
+        bool hasKeywordDetector,
+        std::vector<Utterance> utterances,
+        int iterations);
+
+    /**
+     * Play an utterance, followed by silence until the interaction it started is over.
+     *
+     * @param utterance The utterance.
+     * @return Whether the utterance started an interaction which ended in time.
+     */
+    bool playUtterance(const Utterance& utterance);
+
+    /**
+     * Write samples to the stream at the pace of a microphone.
+     *
+     * @param samples The samples, or @c nullptr for silence.
+     * @param count The number of samples.
+     */
+    void writeAtMicrophonePace(const int16_t* samples, size_t count);
+
+    /**
+     * Print the latencies recorded by @c DialogLatencyTracer.
+     *
+     * @param failures The number of utterances which did not complete an interaction.
+     */
+    void printReport(int failures);
+
+    /// The client to benchmark.
+    std::shared_ptr<defaultClient::DefaultClient> m_client;
+
+    /// The writer to the stream the client reads audio from.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
+
+    /// The audio provider to start utterances with when there is no keyword detector.
+    capabilityAgents::aip::AudioProvider m_tapToTalkAudioProvider;
+
+    /// Whether a keyword detector starts the utterances.
+    const bool m_hasKeywordDetector;
+
+    /// The utterances of the script.
+    const std::vector<Utterance> m_utterances;
+
+    /// How many times to play each utterance.
+    const int m_iterations;
+
+    /// When the next samples are due, as a microphone would deliver them.
+    std::chrono::steady_clock::time_point m_nextWriteTime;
+
+    /// Mutex to guard the members below, which the writing thread polls as it writes.
+    std::mutex m_mutex;
+
+    /// The current dialog state.
+    avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState m_dialogState;
+
+    /// Whether the dialog has left @c IDLE since the current utterance started.
+    bool m_hasDialogStarted;
+};
+
+}  // namespace sampleApp
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_SAMPLE_APP_INCLUDE_SAMPLE_APP_UTTERANCE_BENCHMARK_H_
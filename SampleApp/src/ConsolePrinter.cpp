@@ -29,17 +29,30 @@ std::mutex ConsolePrinter::m_mutex;
 ConsolePrinter::ConsolePrinter() : avsCommon::utils::logger::Logger(avsCommon::utils::logger::Level::UNKNOWN) {
 }
 
+/**
+ * Write a string to @c std::cout with one write and one flush.  The caller must hold @c ConsolePrinter::m_mutex.
+ *
+ * @param output The string to write, including its trailing newline.
+ */
+static void write(const std::string& output) {
+    std::cout.write(output.data(), output.size());
+    std::cout.flush();
+}
+
 void ConsolePrinter::simplePrint(const std::string& stringToPrint) {
+    std::string output = stringToPrint + '\n';
     std::lock_guard<std::mutex> lock{m_mutex};
-    std::cout << stringToPrint << std::endl;
+    write(output);
 }
 
 void ConsolePrinter::prettyPrint(const std::string& stringToPrint) {
-    std::lock_guard<std::mutex> lock{m_mutex};
+    // The output is formatted before the lock is taken, so the lock is only held for the write.
     std::string line(stringToPrint.size() + 16, '#');
-    std::cout << line << std::endl;
-    std::cout << "#       " << stringToPrint << "       #" << std::endl;
-    std::cout << line << std::endl;
+    std::string output;
+    output.reserve(3 * (line.size() + 1));
+    output.append(line).append("\n#       ").append(stringToPrint).append("       #\n").append(line).append("\n");
+    std::lock_guard<std::mutex> lock{m_mutex};
+    write(output);
 }
 
 void ConsolePrinter::emit(
@@ -47,8 +60,9 @@ void ConsolePrinter::emit(
     std::chrono::system_clock::time_point time,
     const char* threadMoniker,
     const char* text) {
+    std::string output = avsCommon::utils::logger::formatLogString(level, time, threadMoniker, text) + '\n';
     std::lock_guard<std::mutex> lock{m_mutex};
-    std::cout << avsCommon::utils::logger::formatLogString(level, time, threadMoniker, text) << std::endl;
+    write(output);
 }
 
 }  // namespace sampleApp
@@ -22,9 +22,11 @@ namespace sampleApp {
 
 KeywordObserver::KeywordObserver(
     std::shared_ptr<defaultClient::DefaultClient> client,
-    capabilityAgents::aip::AudioProvider audioProvider) :
+    capabilityAgents::aip::AudioProvider audioProvider,
+    std::vector<std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface>> bargeInMediaPlayers) :
         m_client{client},
-        m_audioProvider{audioProvider} {
+        m_audioProvider{audioProvider},
+        m_bargeInMediaPlayers{std::move(bargeInMediaPlayers)} {
 }
 
 void KeywordObserver::onKeyWordDetected(
@@ -40,6 +42,10 @@ void KeywordObserver::onKeyWordDetected(
     } else if (
         endIndex != avsCommon::sdkInterfaces::KeyWordObserverInterface::UNSPECIFIED_INDEX &&
         beginIndex != avsCommon::sdkInterfaces::KeyWordObserverInterface::UNSPECIFIED_INDEX) {
+        // Quieten the device now, rather than once the focus change for the recognition reaches the players.
+        for (const auto& mediaPlayer : m_bargeInMediaPlayers) {
+            mediaPlayer->attenuateForBargeIn();
+        }
         if (m_client) {
             m_client->notifyOfWakeWord(m_audioProvider, beginIndex, endIndex, keyword);
         }
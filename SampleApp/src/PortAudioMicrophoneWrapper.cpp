@@ -15,6 +15,12 @@
  * permissions and limitations under the License.
  */
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
+
 #include "SampleApp/PortAudioMicrophoneWrapper.h"
 #include "SampleApp/ConsolePrinter.h"
 
@@ -22,12 +28,22 @@ namespace alexaClientSDK {
 namespace sampleApp {
 
 using avsCommon::avs::AudioInputStream;
+using avsCommon::utils::configuration::ConfigurationNode;
 
 static const int NUM_INPUT_CHANNELS = 1;
 static const int NUM_OUTPUT_CHANNELS = 0;
 static const double SAMPLE_RATE = 16000;
 static const unsigned long PREFERRED_SAMPLES_PER_CALLBACK = paFramesPerBufferUnspecified;
 
+/// The key in our config file to find the root of SampleApp configuration.
+static const std::string SAMPLE_APP_CONFIG_KEY = "sampleApp";
+
+/// The key in our config for the capture period, which enables fixed period capture.
+static const std::string CAPTURE_INTERVAL_KEY = "captureIntervalInMilliseconds";
+
+/// The key in our config for whether the capture thread runs with real-time scheduling.
+static const std::string REAL_TIME_CAPTURE_KEY = "realTimeCapture";
+
 std::unique_ptr<PortAudioMicrophoneWrapper> PortAudioMicrophoneWrapper::create(
     std::shared_ptr<AudioInputStream> stream) {
     if (!stream) {
@@ -44,10 +60,17 @@ std::unique_ptr<PortAudioMicrophoneWrapper> PortAudioMicrophoneWrapper::create(
 
 PortAudioMicrophoneWrapper::PortAudioMicrophoneWrapper(std::shared_ptr<AudioInputStream> stream) :
         m_audioInputStream{stream},
-        m_paStream{nullptr} {
+        m_paStream{nullptr},
+        m_samplesPerPeriod{0},
+        m_isRealTimeCapture{false},
+        m_isCapturing{false} {
 }
 
 PortAudioMicrophoneWrapper::~PortAudioMicrophoneWrapper() {
+    m_isCapturing = false;
+    if (m_captureThread.joinable()) {
+        m_captureThread.join();
+    }
     Pa_StopStream(m_paStream);
     Pa_CloseStream(m_paStream);
     Pa_Terminate();
@@ -59,6 +82,15 @@ bool PortAudioMicrophoneWrapper::initialize() {
         ConsolePrinter::simplePrint("Failed to create stream writer");
         return false;
     }
+    auto config = ConfigurationNode::getRoot()[SAMPLE_APP_CONFIG_KEY];
+    std::chrono::milliseconds captureInterval;
+    config.getDuration<std::chrono::milliseconds>(
+        CAPTURE_INTERVAL_KEY, &captureInterval, std::chrono::milliseconds::zero());
+    if (captureInterval > std::chrono::milliseconds::zero()) {
+        m_samplesPerPeriod = static_cast<unsigned long>(SAMPLE_RATE * captureInterval.count() / 1000);
+    }
+    config.getBool(REAL_TIME_CAPTURE_KEY, &m_isRealTimeCapture, false);
+
     PaError err;
     err = Pa_Initialize();
     if (err != paNoError) {
@@ -71,8 +103,8 @@ bool PortAudioMicrophoneWrapper::initialize() {
         NUM_OUTPUT_CHANNELS,
         paInt16,
         SAMPLE_RATE,
-        PREFERRED_SAMPLES_PER_CALLBACK,
-        PortAudioCallback,
+        m_samplesPerPeriod > 0 ? m_samplesPerPeriod : PREFERRED_SAMPLES_PER_CALLBACK,
+        m_samplesPerPeriod > 0 ? nullptr : PortAudioCallback,
         this);
     if (err != paNoError) {
         ConsolePrinter::simplePrint("Failed to open PortAudio default stream");
@@ -88,11 +120,21 @@ bool PortAudioMicrophoneWrapper::startStreamingMicrophoneData() {
         ConsolePrinter::simplePrint("Failed to start PortAudio stream");
         return false;
     }
+    if (m_samplesPerPeriod > 0 && !m_captureThread.joinable()) {
+        m_isCapturing = true;
+        m_captureThread = avsCommon::utils::threading::ThreadFactory::createThread(
+            avsCommon::utils::threading::ThreadRole::AUDIO_CAPTURE, "mic-capture", [this]() { captureLoop(); });
+    }
     return true;
 }
 
 bool PortAudioMicrophoneWrapper::stopStreamingMicrophoneData() {
     std::lock_guard<std::mutex> lock{m_mutex};
+    // Each read returns within a period, so the capture thread notices promptly.
+    m_isCapturing = false;
+    if (m_captureThread.joinable()) {
+        m_captureThread.join();
+    }
     PaError err = Pa_StopStream(m_paStream);
     if (err != paNoError) {
         ConsolePrinter::simplePrint("Failed to stop PortAudio stream");
@@ -117,5 +159,42 @@ int PortAudioMicrophoneWrapper::PortAudioCallback(
     return paContinue;
 }
 
+void PortAudioMicrophoneWrapper::captureLoop() {
+    if (m_isRealTimeCapture) {
+        setRealTimePriority();
+    }
+    AudioInputStream::Writer::Span spans[2];
+    while (m_isCapturing) {
+        ssize_t reserved = m_writer->reserve(m_samplesPerPeriod, spans);
+        if (reserved <= 0) {
+            ConsolePrinter::simplePrint("Failed to reserve space in stream.");
+            return;
+        }
+        // The reservation may wrap around the end of the buffer, in which case it is read in two parts.
+        for (const auto& span : spans) {
+            if (0 == span.nWords) {
+                continue;
+            }
+            PaError err = Pa_ReadStream(m_paStream, span.data, span.nWords);
+            // An overflow means samples were dropped before this read, but the samples read are still valid.
+            if (err != paNoError && err != paInputOverflowed) {
+                m_writer->commit(0);
+                ConsolePrinter::simplePrint("Failed to read from PortAudio stream.");
+                return;
+            }
+        }
+        m_writer->commit(reserved);
+    }
+}
+
+void PortAudioMicrophoneWrapper::setRealTimePriority() {
+    sched_param param;
+    // The lowest real-time priority is enough to preempt every normally scheduled thread.
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        ConsolePrinter::simplePrint("Failed to set real-time priority for capture; capturing at normal priority.");
+    }
+}
+
 }  // namespace sampleApp
 }  // namespace alexaClientSDK
\ No newline at end of file
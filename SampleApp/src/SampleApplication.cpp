@@ -24,12 +24,19 @@
 #elif KWD_SENSORY
 #include <Sensory/SensoryKeywordDetector.h>
 #endif
+#include <ACL/Transport/ContentFetchBandwidthGovernor.h>
 #include <ACL/Transport/HTTPContentFetcherFactory.h>
 #include <Alerts/Storage/SQLiteAlertStorage.h>
 #include <Settings/SQLiteSettingStorage.h>
+#include <SQLiteStorage/SQLiteDatabaseService.h>
 #include <AuthDelegate/AuthDelegate.h>
+#include <AuthDelegate/HttpPost.h>
+#include <AuthDelegate/SQLiteAuthTokenStorage.h>
 #include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/Logger/LoggerSinkManager.h>
+#include <AVSCommon/Utils/Memory/LockedAllocator.h>
+#include <AVSCommon/Utils/Memory/MemoryBudget.h>
 #include <MediaPlayer/MediaPlayer.h>
 
 #include <algorithm>
@@ -57,6 +64,47 @@ static const std::chrono::seconds AMOUNT_OF_AUDIO_DATA_IN_BUFFER = std::chrono::
 /// The size of the ring buffer.
 static const size_t BUFFER_SIZE_IN_SAMPLES = (SAMPLE_RATE_HZ)*AMOUNT_OF_AUDIO_DATA_IN_BUFFER.count();
 
+/// The largest download rate of each content fetch while the user is in a dialog with Alexa, in bytes per second.
+static const curl_off_t CONTENT_FETCH_MAX_RECV_SPEED_DURING_DIALOG = 16 * 1024;
+
+/// The key in our config file to find the root of the settings of the cache of fetched content.
+static const std::string HTTP_CONTENT_CACHE_CONFIG_KEY = "httpContentCache";
+/// The key in our config file to find the directory of the cache of fetched content.
+static const std::string HTTP_CONTENT_CACHE_DIRECTORY_KEY = "directory";
+/// The key in our config file to find the largest size of the cache of fetched content, in bytes.
+static const std::string HTTP_CONTENT_CACHE_MAX_SIZE_KEY = "maxSizeBytes";
+/// The key in our config file to find the largest size of a response in the cache of fetched content, in bytes.
+static const std::string HTTP_CONTENT_CACHE_MAX_ENTRY_SIZE_KEY = "maxEntrySizeBytes";
+/// The default largest size of the cache of fetched content, in bytes.
+static const int DEFAULT_HTTP_CONTENT_CACHE_MAX_SIZE = 8 * 1024 * 1024;
+/// The default largest size of a response in the cache of fetched content, in bytes.
+static const int DEFAULT_HTTP_CONTENT_CACHE_MAX_ENTRY_SIZE = 1024 * 1024;
+
+/// The key in our config file to find the root of the settings of the memory budget.
+static const std::string MEMORY_BUDGET_CONFIG_KEY = "memoryBudget";
+/// The key in our config file to find the most bytes the buffers of attachments and audio streams may hold.
+static const std::string MEMORY_BUDGET_MAX_BYTES_KEY = "maxBytes";
+/// The key in our config file to find the most bytes the buffers of low priority attachments may hold.
+static const std::string MEMORY_BUDGET_LOW_PRIORITY_MAX_BYTES_KEY = "lowPriorityMaxBytes";
+
+/// The key in our config file to find the root of the settings of the memory of the audio input stream.
+static const std::string AUDIO_BUFFER_MEMORY_CONFIG_KEY = "audioBufferMemory";
+/// The key in our config file to find whether the audio input stream's buffer is faulted in when it is created.
+static const std::string AUDIO_BUFFER_MEMORY_PREFAULT_KEY = "prefault";
+/// The key in our config file to find whether the audio input stream's buffer is locked into RAM.
+static const std::string AUDIO_BUFFER_MEMORY_LOCK_KEY = "lock";
+/// The key in our config file to find whether the audio input stream's buffer uses huge pages.
+static const std::string AUDIO_BUFFER_MEMORY_HUGE_PAGES_KEY = "hugePages";
+
+/// The key in our config file to find the root of the settings of the utterance benchmark.
+static const std::string UTTERANCE_BENCHMARK_CONFIG_KEY = "utteranceBenchmark";
+/// The key in our config file to find the script of the utterance benchmark, which enables it.
+static const std::string UTTERANCE_BENCHMARK_SCRIPT_KEY = "scriptFilePath";
+/// The key in our config file to find how many times the utterance benchmark plays each utterance.
+static const std::string UTTERANCE_BENCHMARK_ITERATIONS_KEY = "iterations";
+/// The default number of times the utterance benchmark plays each utterance.
+static const int DEFAULT_UTTERANCE_BENCHMARK_ITERATIONS = 10;
+
 #ifdef KWD_KITTAI
 /// The sensitivity of the Kitt.ai engine.
 static const double KITT_AI_SENSITIVITY = 0.6;
@@ -68,6 +116,14 @@ static const float KITT_AI_AUDIO_GAIN = 2.0;
 static const bool KITT_AI_APPLY_FRONT_END_PROCESSING = true;
 #endif
 
+#ifdef KWD
+/**
+ * Whether the keyword detector loads its model while the rest of the application starts.  The stream holds
+ * @c AMOUNT_OF_AUDIO_DATA_IN_BUFFER of audio, which covers the time the model takes to load.
+ */
+static const bool KWD_INITIALIZE_ASYNCHRONOUSLY = true;
+#endif
+
 /// A set of all log levels.
 static const std::set<alexaClientSDK::avsCommon::utils::logger::Level> allLevels = {
     alexaClientSDK::avsCommon::utils::logger::Level::DEBUG9,
@@ -120,6 +176,10 @@ std::unique_ptr<SampleApplication> SampleApplication::create(
 }
 
 void SampleApplication::run() {
+    if (m_utteranceBenchmark) {
+        m_utteranceBenchmark->run();
+        return;
+    }
     m_userInputManager->run();
 }
 
@@ -164,7 +224,49 @@ bool SampleApplication::initialize(
         return false;
     }
 
-    auto httpContentFetcherFactory = std::make_shared<acl::HTTPContentFetcherFactory>();
+    /*
+     * If a budget is configured, the buffers of attachments and of the audio input stream are reserved from it, so
+     * that a burst of attachments cannot exhaust the memory of the device.  It must be set before they are created.
+     */
+    auto memoryBudgetConfig = avsCommon::utils::configuration::ConfigurationNode::getRoot()[MEMORY_BUDGET_CONFIG_KEY];
+    int memoryBudgetMaxBytes = 0;
+    if (memoryBudgetConfig.getInt(MEMORY_BUDGET_MAX_BYTES_KEY, &memoryBudgetMaxBytes) && memoryBudgetMaxBytes > 0) {
+        int lowPriorityMaxBytes = 0;
+        memoryBudgetConfig.getInt(MEMORY_BUDGET_LOW_PRIORITY_MAX_BYTES_KEY, &lowPriorityMaxBytes, memoryBudgetMaxBytes);
+        avsCommon::utils::memory::MemoryBudget::setDefault(avsCommon::utils::memory::MemoryBudget::create(
+            static_cast<uint64_t>(memoryBudgetMaxBytes), static_cast<uint64_t>(std::max(0, lowPriorityMaxBytes))));
+    }
+
+    /*
+     * Run all the content fetches on one thread and one set of connections.  If the service can't be created, each
+     * fetch uses a thread and connection of its own.  While the user is speaking to Alexa or waiting for the response,
+     * the fetches are slowed down to leave the bandwidth to the dialog.
+     */
+    auto httpContentFetchService = acl::LibCurlHttpContentFetchService::create();
+    auto contentFetchBandwidthGovernor =
+        acl::ContentFetchBandwidthGovernor::create(CONTENT_FETCH_MAX_RECV_SPEED_DURING_DIALOG);
+
+    /*
+     * If a directory is configured for it, responses such as alert assets and playlists are cached on disk, so that
+     * they are not downloaded again each time they are used.
+     */
+    std::shared_ptr<acl::HTTPContentCache> httpContentCache;
+    auto cacheConfig = avsCommon::utils::configuration::ConfigurationNode::getRoot()[HTTP_CONTENT_CACHE_CONFIG_KEY];
+    std::string cacheDirectory;
+    if (cacheConfig.getString(HTTP_CONTENT_CACHE_DIRECTORY_KEY, &cacheDirectory)) {
+        int maxSize = 0;
+        int maxEntrySize = 0;
+        cacheConfig.getInt(HTTP_CONTENT_CACHE_MAX_SIZE_KEY, &maxSize, DEFAULT_HTTP_CONTENT_CACHE_MAX_SIZE);
+        cacheConfig.getInt(
+            HTTP_CONTENT_CACHE_MAX_ENTRY_SIZE_KEY, &maxEntrySize, DEFAULT_HTTP_CONTENT_CACHE_MAX_ENTRY_SIZE);
+        httpContentCache = acl::HTTPContentCache::create(
+            cacheDirectory, static_cast<size_t>(std::max(0, maxSize)), static_cast<size_t>(std::max(0, maxEntrySize)));
+        if (!httpContentCache) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create the cache of fetched content!");
+        }
+    }
+    auto httpContentFetcherFactory = std::make_shared<acl::HTTPContentFetcherFactory>(
+        httpContentFetchService, contentFetchBandwidthGovernor, httpContentCache);
 
     /*
      * Creating the media players. Here, the default GStreamer based MediaPlayer is being created. However, any
@@ -188,13 +290,21 @@ bool SampleApplication::initialize(
         return false;
     }
 
+    /*
+     * The alerts, settings and certified sender storages share one database file, written by a single storage thread,
+     * if the "sqliteStorage" configuration has a "sharedDatabaseFilePath".  Otherwise each has a file of its own.
+     */
+    auto sharedDatabase = alexaClientSDK::storage::sqliteStorage::SQLiteDatabaseService::getFromConfiguration();
+
     // Creating the alert storage object to be used for rendering and storing alerts.
-    auto alertStorage = std::make_shared<alexaClientSDK::capabilityAgents::alerts::storage::SQLiteAlertStorage>();
+    auto alertStorage =
+        std::make_shared<alexaClientSDK::capabilityAgents::alerts::storage::SQLiteAlertStorage>(sharedDatabase);
 
     /*
      * Creating settings storage object to be used for storing <key, value> pairs of AVS Settings.
      */
-    auto settingsStorage = std::make_shared<alexaClientSDK::capabilityAgents::settings::SQLiteSettingStorage>();
+    auto settingsStorage =
+        std::make_shared<alexaClientSDK::capabilityAgents::settings::SQLiteSettingStorage>(sharedDatabase);
 
     /*
      * Creating the UI component that observes various components and prints to the console accordingly.
@@ -209,10 +319,13 @@ bool SampleApplication::initialize(
 
     /*
      * Creating the AuthDelegate - this component takes care of LWA and authorization of the client. At the moment,
-     * this must be done and authorization must be achieved prior to making the call to connect().
+     * this must be done and authorization must be achieved prior to making the call to connect().  Its requests to
+     * LWA run on the content fetch service too, so that they reuse its connections and do not block.
      */
     std::shared_ptr<alexaClientSDK::authDelegate::AuthDelegate> authDelegate =
-        alexaClientSDK::authDelegate::AuthDelegate::create();
+        alexaClientSDK::authDelegate::AuthDelegate::create(
+            alexaClientSDK::authDelegate::HttpPost::create(httpContentFetchService),
+            std::make_shared<alexaClientSDK::authDelegate::SQLiteAuthTokenStorage>());
 
     authDelegate->addAuthObserver(connectionObserver);
 
@@ -228,8 +341,9 @@ bool SampleApplication::initialize(
             authDelegate,
             alertStorage,
             settingsStorage,
-            {userInterfaceManager},
-            {connectionObserver, userInterfaceManager});
+            {userInterfaceManager, contentFetchBandwidthGovernor},
+            {connectionObserver, userInterfaceManager},
+            httpContentFetcherFactory);
 
     if (!client) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create default SDK client!");
@@ -258,10 +372,25 @@ bool SampleApplication::initialize(
     client->sendDefaultSettings();
     /*
      * Creating the buffer (Shared Data Stream) that will hold user audio data. This is the main input into the SDK.
+     * The device cannot listen without it, so it is reserved from the memory budget at a high priority, and keeps its
+     * reservation for as long as it exists.  Its memory may be faulted in and locked up front, so that neither the
+     * microphone nor the keyword detector ever waits for a page fault.
      */
     size_t bufferSize = alexaClientSDK::avsCommon::avs::AudioInputStream::calculateBufferSize(
         BUFFER_SIZE_IN_SAMPLES, WORD_SIZE, MAX_READERS);
-    auto buffer = std::make_shared<alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer>(bufferSize);
+    auto audioBufferMemoryConfig =
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[AUDIO_BUFFER_MEMORY_CONFIG_KEY];
+    avsCommon::utils::memory::LockedMemoryOptions audioBufferMemoryOptions;
+    audioBufferMemoryConfig.getBool(AUDIO_BUFFER_MEMORY_PREFAULT_KEY, &audioBufferMemoryOptions.prefault);
+    audioBufferMemoryConfig.getBool(AUDIO_BUFFER_MEMORY_LOCK_KEY, &audioBufferMemoryOptions.lock);
+    audioBufferMemoryConfig.getBool(AUDIO_BUFFER_MEMORY_HUGE_PAGES_KEY, &audioBufferMemoryOptions.hugePages);
+    std::shared_ptr<avsCommon::utils::memory::MemoryBudget::Reservation> bufferReservation =
+        avsCommon::utils::memory::MemoryBudget::getDefault()->reserve(
+            bufferSize, bufferSize, avsCommon::utils::memory::MemoryBudget::Priority::HIGH);
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer> buffer(
+        new alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer(
+            bufferSize, 0, avsCommon::utils::memory::LockedAllocator<uint8_t>(audioBufferMemoryOptions)),
+        [bufferReservation](alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer* released) { delete released; });
     std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> sharedDataStream =
         alexaClientSDK::avsCommon::avs::AudioInputStream::create(buffer, WORD_SIZE, MAX_READERS);
 
@@ -309,11 +438,29 @@ bool SampleApplication::initialize(
         holdCanOverride,
         holdCanBeOverridden);
 
-    std::shared_ptr<alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper> micWrapper =
-        alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper::create(sharedDataStream);
-    if (!micWrapper) {
-        alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create PortAudioMicrophoneWrapper!");
-        return false;
+    /*
+     * If the utterance benchmark is configured, it plays recorded utterances into the stream in place of the
+     * microphone, and reports their latencies.
+     */
+    auto benchmarkConfig =
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[UTTERANCE_BENCHMARK_CONFIG_KEY];
+    std::string benchmarkScriptFilePath;
+    if (benchmarkConfig.getString(UTTERANCE_BENCHMARK_SCRIPT_KEY, &benchmarkScriptFilePath)) {
+        int iterations = 0;
+        benchmarkConfig.getInt(
+            UTTERANCE_BENCHMARK_ITERATIONS_KEY, &iterations, DEFAULT_UTTERANCE_BENCHMARK_ITERATIONS);
+#ifdef KWD
+        bool hasKeywordDetector = true;
+#else
+        bool hasKeywordDetector = false;
+#endif
+        m_utteranceBenchmark = UtteranceBenchmark::create(
+            client, sharedDataStream, tapToTalkAudioProvider, hasKeywordDetector, benchmarkScriptFilePath, iterations);
+        if (!m_utteranceBenchmark) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create the utterance benchmark!");
+            return false;
+        }
+        client->addAlexaDialogStateObserver(m_utteranceBenchmark);
     }
 
 // Creating wake word audio provider, if necessary
@@ -331,7 +478,11 @@ bool SampleApplication::initialize(
         wakeCanBeOverridden);
 
     // This observer is notified any time a keyword is detected and notifies the DefaultClient to start recognizing.
-    auto keywordObserver = std::make_shared<alexaClientSDK::sampleApp::KeywordObserver>(client, wakeWordAudioProvider);
+    auto keywordObserver = std::make_shared<alexaClientSDK::sampleApp::KeywordObserver>(
+        client,
+        wakeWordAudioProvider,
+        std::vector<std::shared_ptr<alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface>>{
+            speakMediaPlayer, audioMediaPlayer, alertsMediaPlayer});
 
 #if defined(KWD_KITTAI)
     m_keywordDetector = alexaClientSDK::kwd::KittAiKeyWordDetector::create(
@@ -343,7 +494,10 @@ bool SampleApplication::initialize(
         pathToInputFolder + "/common.res",
         {{pathToInputFolder + "/alexa.umdl", "ALEXA", KITT_AI_SENSITIVITY}},
         KITT_AI_AUDIO_GAIN,
-        KITT_AI_APPLY_FRONT_END_PROCESSING);
+        KITT_AI_APPLY_FRONT_END_PROCESSING,
+        std::chrono::milliseconds(20),
+        std::chrono::milliseconds(0),
+        KWD_INITIALIZE_ASYNCHRONOUSLY);
     if (!m_keywordDetector) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create KittAiKeywWordDetector!");
         return false;
@@ -355,13 +509,30 @@ bool SampleApplication::initialize(
         {keywordObserver},
         std::unordered_set<
             std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>(),
-        pathToInputFolder + "/spot-alexa-rpi-31000.snsr");
+        pathToInputFolder + "/spot-alexa-rpi-31000.snsr",
+        std::chrono::milliseconds(10),
+        std::chrono::milliseconds(0),
+        KWD_INITIALIZE_ASYNCHRONOUSLY);
     if (!m_keywordDetector) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create SensoryKeywWordDetector!");
         return false;
     }
 #endif
 
+#endif
+
+    if (m_utteranceBenchmark) {
+        return true;
+    }
+
+    std::shared_ptr<alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper> micWrapper =
+        alexaClientSDK::sampleApp::PortAudioMicrophoneWrapper::create(sharedDataStream);
+    if (!micWrapper) {
+        alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create PortAudioMicrophoneWrapper!");
+        return false;
+    }
+
+#ifdef KWD
     // If wake word is enabled, then creating the interaction manager with a wake word audio provider.
     auto interactionManager = std::make_shared<alexaClientSDK::sampleApp::InteractionManager>(
         client,
@@ -89,24 +89,27 @@ static const std::string LOCALE_MESSAGE =
     "| Press '3' followed by Enter to change the language to German.              |\n"
     "+----------------------------------------------------------------------------+\n";
 
+UIManager::UIManager() :
+        m_latestDialogState{DialogUXState::IDLE},
+        m_latestConnectionStatus{avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status::DISCONNECTED},
+        m_isStateUpdateQueued(ATOMIC_FLAG_INIT),
+        m_dialogState{DialogUXState::IDLE},
+        m_connectionStatus{avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status::DISCONNECTED} {
+}
+
+void UIManager::setStateIndicator(StateIndicator stateIndicator) {
+    std::lock_guard<std::mutex> lock{m_stateIndicatorMutex};
+    m_stateIndicator = std::move(stateIndicator);
+}
+
 void UIManager::onDialogUXStateChanged(DialogUXState state) {
-    m_executor.submit([this, state]() {
-        if (state == m_dialogState) {
-            return;
-        }
-        m_dialogState = state;
-        printState();
-    });
+    m_latestDialogState = state;
+    scheduleStateUpdate();
 }
 
 void UIManager::onConnectionStatusChanged(const Status status, const ChangedReason reason) {
-    m_executor.submit([this, status]() {
-        if (m_connectionStatus == status) {
-            return;
-        }
-        m_connectionStatus = status;
-        printState();
-    });
+    m_latestConnectionStatus = status;
+    scheduleStateUpdate();
 }
 
 void UIManager::onSettingChanged(const std::string& key, const std::string& value) {
@@ -144,6 +147,30 @@ void UIManager::microphoneOn() {
     m_executor.submit([this]() { printState(); });
 }
 
+void UIManager::scheduleStateUpdate() {
+    if (!m_isStateUpdateQueued.test_and_set()) {
+        m_executor.submit([this]() { updateState(); });
+    }
+}
+
+void UIManager::updateState() {
+    // Cleared before the states are read, so a change made while this runs queues another update.
+    m_isStateUpdateQueued.clear();
+    auto dialogState = m_latestDialogState.load();
+    auto connectionStatus = m_latestConnectionStatus.load();
+    if (dialogState == m_dialogState && connectionStatus == m_connectionStatus) {
+        return;
+    }
+    m_dialogState = dialogState;
+    m_connectionStatus = connectionStatus;
+    printState();
+
+    std::lock_guard<std::mutex> lock{m_stateIndicatorMutex};
+    if (m_stateIndicator) {
+        m_stateIndicator(m_dialogState, m_connectionStatus);
+    }
+}
+
 void UIManager::printState() {
     if (m_connectionStatus == avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status::DISCONNECTED) {
         ConsolePrinter::prettyPrint("Client not connected!");
@@ -0,0 +1,247 @@
+/*
+ * UtteranceBenchmark.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "SampleApp/UtteranceBenchmark.h"
+#include "SampleApp/ConsolePrinter.h"
+
+#include <AVSCommon/Utils/Metrics/DialogLatencyTracer.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace alexaClientSDK {
+namespace sampleApp {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::metrics;
+
+/// The sample rate of the utterances.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// How often the microphone is simulated to deliver samples.
+static const std::chrono::milliseconds WRITE_PERIOD(10);
+
+/// The number of samples delivered each @c WRITE_PERIOD.
+static const size_t SAMPLES_PER_WRITE = SAMPLE_RATE_HZ * WRITE_PERIOD.count() / 1000;
+
+/// The size of the header of the WAV files.
+static const size_t WAV_HEADER_SIZE = 44;
+
+/// The silence between the end of an interaction and the next utterance.
+static const std::chrono::seconds SILENCE_BETWEEN_UTTERANCES(1);
+
+/// How long an interaction may take to start after the end of its utterance.
+static const std::chrono::seconds DIALOG_START_TIMEOUT(5);
+
+/// How long an interaction may take from the end of its utterance until it is over.
+static const std::chrono::seconds DIALOG_END_TIMEOUT(60);
+
+/// The marks reported, with their descriptions, in the order they are reported.
+static const std::vector<std::pair<DialogLatencyTracer::Mark, std::string>> REPORTED_MARKS = {
+    {DialogLatencyTracer::Mark::SEND_START, "Recognize sent"},
+    {DialogLatencyTracer::Mark::SEND_END, "End of upload"},
+    {DialogLatencyTracer::Mark::FIRST_DIRECTIVE, "First directive"},
+    {DialogLatencyTracer::Mark::FIRST_AUDIO, "First TTS audio"},
+    {DialogLatencyTracer::Mark::SPEECH_FINISHED, "TTS finished"}};
+
+/**
+ * Read the samples of a WAV file.
+ *
+ * @param path The path of the file.
+ * @param[out] samples The samples.
+ * @return Whether the file could be read.
+ */
+static bool readWavFile(const std::string& path, std::vector<int16_t>* samples) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        return false;
+    }
+    auto size = static_cast<size_t>(file.tellg());
+    if (size <= WAV_HEADER_SIZE) {
+        return false;
+    }
+    samples->resize((size - WAV_HEADER_SIZE) / sizeof(int16_t));
+    file.seekg(WAV_HEADER_SIZE, std::ios::beg);
+    file.read(reinterpret_cast<char*>(samples->data()), samples->size() * sizeof(int16_t));
+    return !file.bad();
+}
+
+std::shared_ptr<UtteranceBenchmark> UtteranceBenchmark::create(
+    std::shared_ptr<defaultClient::DefaultClient> client,
+    std::shared_ptr<AudioInputStream> stream,
+    capabilityAgents::aip::AudioProvider tapToTalkAudioProvider,
+    bool hasKeywordDetector,
+    const std::string& scriptFilePath,
+    int iterations) {
+    if (!client || !stream) {
+        ConsolePrinter::simplePrint("Failed to create the utterance benchmark without a client and a stream!");
+        return nullptr;
+    }
+    std::ifstream script(scriptFilePath);
+    if (!script.good()) {
+        ConsolePrinter::simplePrint("Failed to read the utterance benchmark script " + scriptFilePath + "!");
+        return nullptr;
+    }
+    auto directoryEnd = scriptFilePath.rfind('/');
+    std::string directory = std::string::npos == directoryEnd ? "" : scriptFilePath.substr(0, directoryEnd + 1);
+    std::vector<Utterance> utterances;
+    std::string line;
+    while (std::getline(script, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || '#' == line[0]) {
+            continue;
+        }
+        Utterance utterance;
+        utterance.path = '/' == line[0] ? line : directory + line;
+        if (!readWavFile(utterance.path, &utterance.samples)) {
+            ConsolePrinter::simplePrint("Failed to read the utterance " + utterance.path + "!");
+            return nullptr;
+        }
+        utterances.push_back(std::move(utterance));
+    }
+    if (utterances.empty()) {
+        ConsolePrinter::simplePrint("The utterance benchmark script " + scriptFilePath + " lists no utterances!");
+        return nullptr;
+    }
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    if (!writer) {
+        ConsolePrinter::simplePrint("Failed to create a writer for the utterance benchmark!");
+        return nullptr;
+    }
+    return std::shared_ptr<UtteranceBenchmark>(new UtteranceBenchmark(
+        client, writer, tapToTalkAudioProvider, hasKeywordDetector, std::move(utterances), std::max(iterations, 1)));
+}
+
+UtteranceBenchmark::UtteranceBenchmark(
+    std::shared_ptr<defaultClient::DefaultClient> client,
+    std::shared_ptr<AudioInputStream::Writer> writer,
+    capabilityAgents::aip::AudioProvider tapToTalkAudioProvider,
+    bool hasKeywordDetector,
+    std::vector<Utterance> utterances,
+    int iterations) :
+        m_client{client},
+        m_writer{writer},
+        m_tapToTalkAudioProvider{tapToTalkAudioProvider},
+        m_hasKeywordDetector{hasKeywordDetector},
+        m_utterances{std::move(utterances)},
+        m_iterations{iterations},
+        m_dialogState{DialogUXState::IDLE},
+        m_hasDialogStarted{false} {
+}
+
+void UtteranceBenchmark::onDialogUXStateChanged(DialogUXState newState) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_dialogState = newState;
+    if (DialogUXState::IDLE != newState) {
+        m_hasDialogStarted = true;
+    }
+}
+
+void UtteranceBenchmark::run() {
+    auto& tracer = DialogLatencyTracer::instance();
+    tracer.reset();
+    tracer.setEnabled(true);
+
+    ConsolePrinter::simplePrint(
+        "Playing " + std::to_string(m_utterances.size()) + " utterances " + std::to_string(m_iterations) +
+        " times each.");
+    m_nextWriteTime = std::chrono::steady_clock::now();
+    int failures = 0;
+    for (int iteration = 0; iteration < m_iterations; ++iteration) {
+        for (const auto& utterance : m_utterances) {
+            if (!playUtterance(utterance)) {
+                ConsolePrinter::simplePrint("The interaction of " + utterance.path + " did not complete.");
+                ++failures;
+            }
+            writeAtMicrophonePace(nullptr, SAMPLE_RATE_HZ * SILENCE_BETWEEN_UTTERANCES.count());
+        }
+    }
+
+    // Disabling the tracer forgets the traces of failed interactions, and keeps the latencies.
+    tracer.setEnabled(false);
+    printReport(failures);
+}
+
+bool UtteranceBenchmark::playUtterance(const Utterance& utterance) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasDialogStarted = false;
+    }
+    if (!m_hasKeywordDetector && !m_client->notifyOfTapToTalk(m_tapToTalkAudioProvider).get()) {
+        return false;
+    }
+    writeAtMicrophonePace(utterance.samples.data(), utterance.samples.size());
+
+    // Keep the microphone going with silence, as the end of speech is detected in the cloud.
+    auto utteranceEnd = std::chrono::steady_clock::now();
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_hasDialogStarted && DialogUXState::IDLE == m_dialogState) {
+                return true;
+            }
+            auto elapsed = std::chrono::steady_clock::now() - utteranceEnd;
+            if ((!m_hasDialogStarted && elapsed >= DIALOG_START_TIMEOUT) || elapsed >= DIALOG_END_TIMEOUT) {
+                return false;
+            }
+        }
+        writeAtMicrophonePace(nullptr, SAMPLES_PER_WRITE);
+    }
+}
+
+void UtteranceBenchmark::writeAtMicrophonePace(const int16_t* samples, size_t count) {
+    static const std::vector<int16_t> silence(SAMPLES_PER_WRITE, 0);
+    for (size_t offset = 0; offset < count; offset += SAMPLES_PER_WRITE) {
+        std::this_thread::sleep_until(m_nextWriteTime);
+        m_nextWriteTime += WRITE_PERIOD;
+        auto size = std::min(SAMPLES_PER_WRITE, count - offset);
+        if (m_writer->write(samples ? samples + offset : silence.data(), size) < 0) {
+            ConsolePrinter::simplePrint("Failed to write to the audio input stream!");
+        }
+    }
+}
+
+void UtteranceBenchmark::printReport(int failures) {
+    std::ostringstream report;
+    report << "Latency from " << (m_hasKeywordDetector ? "the end of the wakeword" : "the start of the utterance")
+           << ", in milliseconds, over " << m_iterations * m_utterances.size() - failures << " interactions ("
+           << failures << " incomplete):\n";
+    report << std::left << std::setw(18) << "" << std::right << std::setw(8) << "count" << std::setw(10) << "p50"
+           << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max";
+    auto summaries = DialogLatencyTracer::instance().getSummaries();
+    for (const auto& reported : REPORTED_MARKS) {
+        for (const auto& summary : summaries) {
+            if (summary.mark != reported.first) {
+                continue;
+            }
+            report << "\n"
+                   << std::left << std::setw(18) << reported.second << std::right << std::setw(8) << summary.count
+                   << std::fixed << std::setprecision(1) << std::setw(10) << summary.p50.count() / 1000.0
+                   << std::setw(10) << summary.p90.count() / 1000.0 << std::setw(10) << summary.p99.count() / 1000.0
+                   << std::setw(10) << summary.max.count() / 1000.0;
+        }
+    }
+    ConsolePrinter::simplePrint(report.str());
+}
+
+}  // namespace sampleApp
+}  // namespace alexaClientSDK
@@ -0,0 +1,175 @@
+/*
+ * SQLiteDatabaseService.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_DATABASE_SERVICE_H_
+#define ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_DATABASE_SERVICE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sqlite3.h>
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+
+/**
+ * A database file shared by the SQLite storages of the SDK, with a single connection used by a single storage thread.
+ *
+ * Operations are submitted to the storage thread, which runs them in order and returns their results through
+ * futures, so that their callers do not have to wait for the disk.  The operations queued while the thread is busy
+ * are run together in one transaction, so that when several components persist at once their changes reach the disk
+ * with a single commit.  Each operation runs within a nested transaction of its own, and an operation which fails
+ * has its changes rolled back without affecting the others.  The result of an operation is only delivered once the
+ * transaction holding it is committed.
+ *
+ * The shared database is optional, and is used when the "sqliteStorage" configuration node has a
+ * "sharedDatabaseFilePath".  Its journaling may be tuned there with 'enableWriteAheadLog' (a boolean) and
+ * 'synchronous' (one of "OFF", "NORMAL", "FULL" or "EXTRA"), for example:
+ *
+ * @code{.json}
+ * "sqliteStorage": {
+ *     "sharedDatabaseFilePath": "/var/lib/alexa/shared.db",
+ *     "enableWriteAheadLog": true
+ * }
+ * @endcode
+ *
+ * This class is thread-safe.
+ */
+class SQLiteDatabaseService {
+public:
+    /**
+     * An operation on the database.  It is given the connection to the database, and returns whether it succeeded.
+     * An operation which fails has its changes rolled back.
+     */
+    using Operation = std::function<bool(sqlite3* dbHandle)>;
+
+    /**
+     * Create an @c SQLiteDatabaseService, creating its database file if it does not exist.
+     *
+     * @param filePath The path of the database file.
+     * @return The new @c SQLiteDatabaseService, or @c nullptr if the database could not be opened.
+     */
+    static std::shared_ptr<SQLiteDatabaseService> create(const std::string& filePath);
+
+    /**
+     * Get the shared database set up in the configuration, creating it if it is not in use already.  Every caller
+     * gets the same @c SQLiteDatabaseService for as long as one of them holds it.
+     *
+     * @return The shared database, or @c nullptr if none is configured or it could not be opened.
+     */
+    static std::shared_ptr<SQLiteDatabaseService> getFromConfiguration();
+
+    /**
+     * Destructor.  Runs the operations still queued, then closes the database.
+     */
+    ~SQLiteDatabaseService();
+
+    /**
+     * Queue an operation to run on the storage thread.
+     *
+     * @param operation The operation.
+     * @return A future for whether the operation succeeded and its changes were committed.
+     */
+    std::future<bool> submit(Operation operation);
+
+    /**
+     * Run an operation on the storage thread and wait for its result.  On the storage thread itself, the operation is
+     * run immediately, within the transaction of the operation calling it.
+     *
+     * @param operation The operation.
+     * @return Whether the operation succeeded and its changes were committed.
+     */
+    bool run(Operation operation);
+
+    /**
+     * Get whether the calling thread is the storage thread.
+     *
+     * @return Whether the calling thread is the storage thread.
+     */
+    bool isStorageThread() const;
+
+    /**
+     * Get the path of the database file.
+     *
+     * @return The path of the database file.
+     */
+    std::string getFilePath() const;
+
+private:
+    /// An operation waiting to be run.
+    struct PendingOperation {
+        /// The operation.
+        Operation operation;
+
+        /// The promise for the result of the operation.
+        std::shared_ptr<std::promise<bool>> result;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param filePath The path of the database file.
+     * @param dbHandle The connection to the database.
+     */
+    SQLiteDatabaseService(const std::string& filePath, sqlite3* dbHandle);
+
+    /**
+     * The loop of the storage thread, which runs the queued operations in batches until shutdown.
+     */
+    void storageLoop();
+
+    /**
+     * Run a batch of operations within one transaction, and deliver their results once it is committed.
+     *
+     * @param batch The operations.
+     */
+    void runBatch(std::deque<PendingOperation>* batch);
+
+    /// The path of the database file.
+    const std::string m_filePath;
+
+    /// The connection to the database, only used on the storage thread.
+    sqlite3* m_dbHandle;
+
+    /// Serializes access to @c m_queue and @c m_isShuttingDown.
+    std::mutex m_mutex;
+
+    /// Notified when an operation is queued, or on shutdown.
+    std::condition_variable m_wakeTrigger;
+
+    /// The operations waiting to be run, oldest first.
+    std::deque<PendingOperation> m_queue;
+
+    /// Whether the destructor has asked the storage thread to finish.
+    bool m_isShuttingDown;
+
+    /// The storage thread.
+    std::thread m_thread;
+};
+
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_DATABASE_SERVICE_H_
@@ -19,6 +19,9 @@
 #define ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_STATEMENT_H_
 
 #include <sqlite3.h>
+
+#include <cstddef>
+#include <functional>
 #include <string>
 
 namespace alexaClientSDK {
@@ -34,9 +37,55 @@ namespace sqliteStorage {
  * for SQLite for further guidance.  This is a good place to begin:
  *
  * https://sqlite.org/c3ref/intro.html
+ *
+ * Queries returning many rows may be read with @c forEachRow(), with the positions of their columns found once with
+ * @c getColumnIndex(), and their text read through @c getColumnTextView(), so that reading a row does not copy its
+ * fields.
  */
 class SQLiteStatement {
 public:
+    /**
+     * A view of the text of a column of the current row.  The text belongs to SQLite, and is only valid until the
+     * next @c step(), @c reset() or @c finalize() of the statement, or until the column is read as another type.
+     */
+    class TextView {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param data The text, which need not be null-terminated.
+         * @param size The length of the text, in bytes.
+         */
+        TextView(const char* data, size_t size);
+
+        /// @return The text, which is not null-terminated.
+        const char* data() const;
+
+        /// @return The length of the text, in bytes.
+        size_t size() const;
+
+        /// @return Whether the text is empty.
+        bool empty() const;
+
+        /// @return A copy of the text.
+        std::string toString() const;
+
+        /**
+         * Compare the text with a string.
+         *
+         * @param other The string.
+         * @return Whether the text is the same as @c other.
+         */
+        bool operator==(const std::string& other) const;
+
+    private:
+        /// The text.
+        const char* m_data;
+
+        /// The length of the text, in bytes.
+        size_t m_size;
+    };
+
     /**
      * Constructor.
      *
@@ -65,6 +114,15 @@ public:
      */
     bool step();
 
+    /**
+     * Performs the query, calling a visitor on each row of its results.  While the visitor runs, the columns of the row
+     * are read from this statement.  The statement must not have been stepped since it was prepared or reset.
+     *
+     * @param visitor The function called on each row.  It returns whether to go on to the next row.
+     * @return Whether every row was visited, which is @c false if a step failed or the visitor stopped early.
+     */
+    bool forEachRow(const std::function<bool(const SQLiteStatement& row)>& visitor);
+
     /**
      * Resets a statement object to be re-executed with different bound parameters.
      *
@@ -131,6 +189,16 @@ public:
      */
     std::string getColumnName(int index) const;
 
+    /**
+     * Returns the position of a column in the results.  SQLite does not guarantee the order of the columns of
+     * @c SELECT @c *, so the positions should be found before reading the rows, rather than matching the names of the
+     * columns on every row.
+     *
+     * @param columnName The name of the column.
+     * @return The position of the column, or -1 if the results have no column with this name.
+     */
+    int getColumnIndex(const std::string& columnName) const;
+
     /**
      * Returns the text value of a particular column in the current row being evaluated.
      * NOTE: The left-most index for SQLite lookup operations begins at 0.
@@ -148,6 +216,15 @@ public:
      */
     std::string getColumnText(int index) const;
 
+    /**
+     * Returns the text value of a particular column in the current row being evaluated, without copying it.  The
+     * conversions and errors are the same as those of @c getColumnText(), and a @c NULL value reads as empty text.
+     *
+     * @param index The index of the column being queried (left-most column is 0).
+     * @return A view of the text value of the column, valid until the statement is next stepped.
+     */
+    TextView getColumnTextView(int index) const;
+
     /**
      * Returns the integer value of a particular column in the current row being evaluated.
      * NOTE: The left-most index for SQLite lookup operations begins at 0.
@@ -0,0 +1,145 @@
+/*
+ * SQLiteStatementCache.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_STATEMENT_CACHE_H_
+#define ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_STATEMENT_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <sqlite3.h>
+
+#include "SQLiteStorage/SQLiteStatement.h"
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+
+/**
+ * A cache of the prepared statements used on one database connection, so that statements which are run repeatedly
+ * are parsed and planned by SQLite only once.
+ *
+ * Statements are keyed by an id chosen by the caller, which must always be used with the same SQL.  A statement is
+ * borrowed from the cache through a @c ScopedStatement, which resets the statement and clears its bindings when it
+ * goes out of scope, so that the next caller finds it ready to bind.
+ *
+ * The cache must be cleared with @c clear() before its database connection is closed, since SQLite cannot close a
+ * connection with unfinalized statements.  This class is not thread-safe.
+ */
+class SQLiteStatementCache {
+public:
+    /**
+     * A statement borrowed from the cache.  It is returned to the cache when this object is destroyed.
+     */
+    class ScopedStatement {
+    public:
+        /**
+         * Move constructor.
+         *
+         * @param other The statement to take over.
+         */
+        ScopedStatement(ScopedStatement&& other);
+
+        /**
+         * Destructor.  Resets the statement and clears its bindings, and returns it to the cache.
+         */
+        ~ScopedStatement();
+
+        /**
+         * Returns whether the statement was prepared successfully.
+         *
+         * @return Whether the statement was prepared successfully.
+         */
+        bool isValid();
+
+        /// @return The borrowed statement.
+        SQLiteStatement* operator->();
+
+        /// @return The borrowed statement.
+        SQLiteStatement& operator*();
+
+    private:
+        /**
+         * Constructor.
+         *
+         * @param statement The borrowed statement.
+         * @param inUse The flag of the cache entry to clear when the statement is returned, or @c nullptr if the
+         *     statement is not held by the cache.
+         * @param uncached The statement, if it is not held by the cache.
+         */
+        ScopedStatement(SQLiteStatement* statement, bool* inUse, std::unique_ptr<SQLiteStatement> uncached);
+
+        /// Copying would return the statement to the cache twice.
+        ScopedStatement(const ScopedStatement&) = delete;
+
+        /// Copying would return the statement to the cache twice.
+        ScopedStatement& operator=(const ScopedStatement&) = delete;
+
+        /// The borrowed statement.
+        SQLiteStatement* m_statement;
+
+        /// The flag of the cache entry to clear when the statement is returned, or @c nullptr.
+        bool* m_inUse;
+
+        /// The statement, if it is not held by the cache.
+        std::unique_ptr<SQLiteStatement> m_uncached;
+
+        friend class SQLiteStatementCache;
+    };
+
+    /**
+     * Destructor.  Finalizes the cached statements.
+     */
+    ~SQLiteStatementCache();
+
+    /**
+     * Borrow the statement with the given id, preparing it with the given SQL on first use.  If the statement is
+     * already borrowed, a statement which is not cached is prepared instead.  A statement which fails to prepare is
+     * not cached.
+     *
+     * @param dbHandle The database connection the statement is run on.
+     * @param id The id of the statement.
+     * @param sqlString The SQL of the statement.
+     * @return The borrowed statement, which must be checked with @c isValid().
+     */
+    ScopedStatement get(sqlite3* dbHandle, int id, const std::string& sqlString);
+
+    /**
+     * Finalize all the cached statements.  No statement may be borrowed when this is called.
+     */
+    void clear();
+
+private:
+    /// A cached statement.
+    struct Entry {
+        /// The prepared statement.
+        std::unique_ptr<SQLiteStatement> statement;
+
+        /// Whether the statement is borrowed.
+        bool inUse;
+    };
+
+    /// The cached statements, keyed by id.
+    std::unordered_map<int, Entry> m_statements;
+};
+
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_STORAGE_SQLITE_STORAGE_INCLUDE_SQLITE_STORAGE_SQLITE_STATEMENT_CACHE_H_
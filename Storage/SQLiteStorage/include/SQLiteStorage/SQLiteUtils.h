@@ -92,6 +92,29 @@ bool getTableMaxIntValue(sqlite3* dbHandle, const std::string& tableName, const
  */
 bool tableExists(sqlite3* dbHandle, const std::string& tableName);
 
+/**
+ * Reads the version of the schema of a component's tables, which the component recorded with @c setSchemaVersion().
+ * Versions are kept per component rather than per database, so that components sharing a database upgrade their
+ * tables independently.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @param component The name of the component.
+ * @param[out] version The version, which is zero if none has been recorded.
+ * @return Whether the version was read.
+ */
+bool getSchemaVersion(sqlite3* dbHandle, const std::string& component, int* version);
+
+/**
+ * Records the version of the schema of a component's tables.  This should be done in the transaction which brings
+ * the tables to that version, so that an interrupted upgrade is retried in full.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @param component The name of the component.
+ * @param version The version.
+ * @return Whether the version was recorded.
+ */
+bool setSchemaVersion(sqlite3* dbHandle, const std::string& component, int version);
+
 /**
  * Deletes all records from a table.
  *
@@ -112,6 +135,52 @@ bool clearTable(sqlite3* dbHandle, const std::string& tableName);
  */
 bool dropTable(sqlite3* dbHandle, const std::string& tableName);
 
+/**
+ * Switches an open database to write-ahead logging, so that a commit appends to the log instead of rewriting the
+ * database and its rollback journal.  The setting is persistent, and applies to every connection to the database.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @return Whether the database is now in write-ahead logging mode.
+ */
+bool enableWriteAheadLog(sqlite3* dbHandle);
+
+/**
+ * Sets how often SQLite waits for the content of a connection to reach the disk.  The setting only applies to the
+ * given connection.  See https://sqlite.org/pragma.html#pragma_synchronous for the meaning of each level.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @param level One of "OFF", "NORMAL", "FULL" or "EXTRA".
+ * @return Whether the level was valid and was set.
+ */
+bool setSynchronous(sqlite3* dbHandle, const std::string& level);
+
+/**
+ * Starts a transaction, so that the following changes are written to the disk together by @c commitTransaction().
+ * Within a transaction, such as the one grouping the operations of an @c SQLiteDatabaseService, this starts a nested
+ * transaction, whose changes are written to the disk when the enclosing transaction is committed.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @return Whether the transaction was started.
+ */
+bool beginTransaction(sqlite3* dbHandle);
+
+/**
+ * Commits the most recent transaction started by @c beginTransaction().  If the commit fails, the transaction is
+ * rolled back.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @return Whether the transaction was committed.
+ */
+bool commitTransaction(sqlite3* dbHandle);
+
+/**
+ * Rolls back the most recent transaction started by @c beginTransaction(), discarding its changes.
+ *
+ * @param dbHandle A SQLite handle to an open database.
+ * @return Whether the transaction was rolled back.
+ */
+bool rollbackTransaction(sqlite3* dbHandle);
+
 }  // namespace sqliteStorage
 }  // namespace storage
 }  // namespace alexaClientSDK
@@ -0,0 +1,214 @@
+/*
+ * SQLiteDatabaseService.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "SQLiteStorage/SQLiteDatabaseService.h"
+
+#include <vector>
+
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <AVSCommon/Utils/File/FileUtils.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadFactory.h>
+
+#include "SQLiteStorage/SQLiteUtils.h"
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+
+using namespace avsCommon::utils::configuration;
+using namespace avsCommon::utils::file;
+using namespace avsCommon::utils::logger;
+using namespace avsCommon::utils::threading;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SQLiteDatabaseService");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The key in our config file to find the root of settings for the shared database.
+static const std::string SQLITE_STORAGE_CONFIGURATION_ROOT_KEY = "sqliteStorage";
+/// The key in our config file to find the path of the shared database.
+static const std::string SHARED_DATABASE_FILE_PATH_KEY = "sharedDatabaseFilePath";
+/// The key in our config file to find whether the shared database uses write-ahead logging.
+static const std::string ENABLE_WRITE_AHEAD_LOG_KEY = "enableWriteAheadLog";
+/// The key in our config file to find the synchronous level of the shared database.
+static const std::string SYNCHRONOUS_KEY = "synchronous";
+
+std::shared_ptr<SQLiteDatabaseService> SQLiteDatabaseService::create(const std::string& filePath) {
+    if (filePath.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "emptyFilePath"));
+        return nullptr;
+    }
+
+    sqlite3* dbHandle = fileExists(filePath) ? openSQLiteDatabase(filePath) : createSQLiteDatabase(filePath);
+    if (!dbHandle) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "openDatabaseFailed").d("filePath", filePath));
+        return nullptr;
+    }
+
+    auto configurationRoot = ConfigurationNode::getRoot()[SQLITE_STORAGE_CONFIGURATION_ROOT_KEY];
+    bool enableWriteAheadLogging = false;
+    configurationRoot.getBool(ENABLE_WRITE_AHEAD_LOG_KEY, &enableWriteAheadLogging, false);
+    // Failing to apply the journaling settings is not fatal, since the database still works with the SQLite defaults.
+    if (enableWriteAheadLogging && !enableWriteAheadLog(dbHandle)) {
+        ACSDK_WARN(LX("createWarning").d("reason", "enableWriteAheadLogFailed"));
+    }
+    std::string synchronous;
+    if (configurationRoot.getString(SYNCHRONOUS_KEY, &synchronous) && !setSynchronous(dbHandle, synchronous)) {
+        ACSDK_WARN(LX("createWarning").d("reason", "setSynchronousFailed").d("synchronous", synchronous));
+    }
+
+    return std::shared_ptr<SQLiteDatabaseService>(new SQLiteDatabaseService(filePath, dbHandle));
+}
+
+std::shared_ptr<SQLiteDatabaseService> SQLiteDatabaseService::getFromConfiguration() {
+    std::string filePath;
+    ConfigurationNode::getRoot()[SQLITE_STORAGE_CONFIGURATION_ROOT_KEY].getString(
+        SHARED_DATABASE_FILE_PATH_KEY, &filePath);
+    if (filePath.empty()) {
+        return nullptr;
+    }
+
+    // Leaked so that it outlives the services held by static objects.
+    static auto mutex = new std::mutex;
+    static auto sharedService = new std::weak_ptr<SQLiteDatabaseService>;
+    std::lock_guard<std::mutex> lock(*mutex);
+    auto service = sharedService->lock();
+    if (!service || service->getFilePath() != filePath) {
+        service = create(filePath);
+        *sharedService = service;
+    }
+    return service;
+}
+
+SQLiteDatabaseService::SQLiteDatabaseService(const std::string& filePath, sqlite3* dbHandle) :
+        m_filePath{filePath},
+        m_dbHandle{dbHandle},
+        m_isShuttingDown{false} {
+    m_thread = ThreadFactory::createThread(ThreadRole::BACKGROUND, "sqlite-storage", [this]() { storageLoop(); });
+}
+
+SQLiteDatabaseService::~SQLiteDatabaseService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeTrigger.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (!closeSQLiteDatabase(m_dbHandle)) {
+        ACSDK_ERROR(LX("closeFailed").d("filePath", m_filePath));
+    }
+}
+
+std::future<bool> SQLiteDatabaseService::submit(Operation operation) {
+    auto result = std::make_shared<std::promise<bool>>();
+    auto future = result->get_future();
+    if (!operation) {
+        ACSDK_ERROR(LX("submitFailed").d("reason", "nullOperation"));
+        result->set_value(false);
+        return future;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back({std::move(operation), result});
+    }
+    m_wakeTrigger.notify_one();
+    return future;
+}
+
+bool SQLiteDatabaseService::run(Operation operation) {
+    if (!isStorageThread()) {
+        return submit(std::move(operation)).get();
+    }
+    if (!operation) {
+        ACSDK_ERROR(LX("runFailed").d("reason", "nullOperation"));
+        return false;
+    }
+    // Nested within the transaction of the running operation, whose commit also commits this one.
+    if (!beginTransaction(m_dbHandle)) {
+        return false;
+    }
+    if (!operation(m_dbHandle)) {
+        rollbackTransaction(m_dbHandle);
+        return false;
+    }
+    return commitTransaction(m_dbHandle);
+}
+
+bool SQLiteDatabaseService::isStorageThread() const {
+    return std::this_thread::get_id() == m_thread.get_id();
+}
+
+std::string SQLiteDatabaseService::getFilePath() const {
+    return m_filePath;
+}
+
+void SQLiteDatabaseService::storageLoop() {
+    std::deque<PendingOperation> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeTrigger.wait(lock, [this]() { return m_isShuttingDown || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            batch.swap(m_queue);
+        }
+        runBatch(&batch);
+        batch.clear();
+    }
+}
+
+void SQLiteDatabaseService::runBatch(std::deque<PendingOperation>* batch) {
+    std::vector<bool> results;
+    results.reserve(batch->size());
+    bool isInTransaction = beginTransaction(m_dbHandle);
+    if (!isInTransaction) {
+        ACSDK_ERROR(LX("runBatchFailed").d("reason", "beginTransactionFailed").d("operations", batch->size()));
+    }
+    for (auto& pending : *batch) {
+        bool succeeded = false;
+        if (isInTransaction && beginTransaction(m_dbHandle)) {
+            succeeded = pending.operation(m_dbHandle);
+            if (succeeded) {
+                succeeded = commitTransaction(m_dbHandle);
+            } else {
+                rollbackTransaction(m_dbHandle);
+            }
+        }
+        results.push_back(succeeded);
+    }
+    if (isInTransaction && !commitTransaction(m_dbHandle)) {
+        ACSDK_ERROR(LX("runBatchFailed").d("reason", "commitTransactionFailed").d("operations", batch->size()));
+        isInTransaction = false;
+    }
+    for (size_t i = 0; i < batch->size(); ++i) {
+        (*batch)[i].result->set_value(isInTransaction && results[i]);
+    }
+}
+
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
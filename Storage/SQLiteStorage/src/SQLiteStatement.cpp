@@ -144,7 +144,7 @@ bool SQLiteStatement::bindStringParameter(int index, const std::string& value) {
         index,                                    // the position to bind to
         value.c_str(),                            // the value to bind
         SQLITE_PARSE_STRING_UNTIL_NUL_CHARACTER,  // SQLite string parsing instruction
-        nullptr);                                 // optional destructor for SQLite to call once done
+        SQLITE_TRANSIENT);                        // have SQLite copy the value, which may be a temporary
 
     if (rcode != SQLITE_OK) {
         ACSDK_ERROR(LX("SQLiteStatement::bindStringParameterFailed")
@@ -158,6 +158,18 @@ bool SQLiteStatement::bindStringParameter(int index, const std::string& value) {
     return true;
 }
 
+bool SQLiteStatement::forEachRow(const std::function<bool(const SQLiteStatement& row)>& visitor) {
+    if (!step()) {
+        return false;
+    }
+    while (SQLITE_ROW == m_stepResult) {
+        if (!visitor(*this) || !step()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 sqlite3_stmt* SQLiteStatement::getHandle() {
     return m_handle;
 }
@@ -179,16 +191,40 @@ std::string SQLiteStatement::getColumnName(int index) const {
     return sqlite3_column_name(m_handle, index);
 }
 
+int SQLiteStatement::getColumnIndex(const std::string& columnName) const {
+    int numberColumns = getColumnCount();
+    for (int i = 0; i < numberColumns; ++i) {
+        const char* name = sqlite3_column_name(m_handle, i);
+        if (name && columnName == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 std::string SQLiteStatement::getColumnText(int index) const {
     if (index < SQLITE_RESULT_FIELD_LEFT_MOST_INDEX) {
         ACSDK_ERROR(LX("SQLiteStatement::getColumnTextFailed").d("invalid position", index));
         return "";
     }
 
+    return getColumnTextView(index).toString();
+}
+
+SQLiteStatement::TextView SQLiteStatement::getColumnTextView(int index) const {
+    if (index < SQLITE_RESULT_FIELD_LEFT_MOST_INDEX) {
+        ACSDK_ERROR(LX("SQLiteStatement::getColumnTextViewFailed").d("invalid position", index));
+        return TextView("", 0);
+    }
+
     // The reinterpret_cast is needed due to SQLite storing text data as utf8 (ie. const unsigned char*).
     // We are ok in our implementation to do the cast, since we know we're storing as regular ascii.
+    // The text must be read before its size, so that the size is that of the text after any conversion.
     const char* rowValue = reinterpret_cast<const char*>(sqlite3_column_text(m_handle, index));
-    return std::string(rowValue);
+    if (!rowValue) {
+        return TextView("", 0);
+    }
+    return TextView(rowValue, static_cast<size_t>(sqlite3_column_bytes(m_handle, index)));
 }
 
 int SQLiteStatement::getColumnInt(int index) const {
@@ -221,6 +257,29 @@ void SQLiteStatement::finalize() {
     }
 }
 
+SQLiteStatement::TextView::TextView(const char* data, size_t size) : m_data{data}, m_size{size} {
+}
+
+const char* SQLiteStatement::TextView::data() const {
+    return m_data;
+}
+
+size_t SQLiteStatement::TextView::size() const {
+    return m_size;
+}
+
+bool SQLiteStatement::TextView::empty() const {
+    return 0 == m_size;
+}
+
+std::string SQLiteStatement::TextView::toString() const {
+    return std::string(m_data, m_size);
+}
+
+bool SQLiteStatement::TextView::operator==(const std::string& other) const {
+    return other.size() == m_size && 0 == other.compare(0, m_size, m_data, m_size);
+}
+
 }  // namespace sqliteStorage
 }  // namespace storage
 }  // namespace alexaClientSDK
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+ * SQLiteStatementCache.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "SQLiteStorage/SQLiteStatementCache.h"
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+
+using namespace avsCommon::utils::logger;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SQLiteStatementCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+SQLiteStatementCache::ScopedStatement::ScopedStatement(
+    SQLiteStatement* statement,
+    bool* inUse,
+    std::unique_ptr<SQLiteStatement> uncached) :
+        m_statement{statement},
+        m_inUse{inUse},
+        m_uncached{std::move(uncached)} {
+}
+
+SQLiteStatementCache::ScopedStatement::ScopedStatement(ScopedStatement&& other) :
+        m_statement{other.m_statement},
+        m_inUse{other.m_inUse},
+        m_uncached{std::move(other.m_uncached)} {
+    other.m_statement = nullptr;
+    other.m_inUse = nullptr;
+}
+
+SQLiteStatementCache::ScopedStatement::~ScopedStatement() {
+    if (!m_inUse) {
+        return;
+    }
+    // The result of the reset is the result of the last step, which the borrower has already handled.
+    if (m_statement->isValid()) {
+        sqlite3_reset(m_statement->getHandle());
+        sqlite3_clear_bindings(m_statement->getHandle());
+    }
+    *m_inUse = false;
+}
+
+bool SQLiteStatementCache::ScopedStatement::isValid() {
+    return m_statement && m_statement->isValid();
+}
+
+SQLiteStatement* SQLiteStatementCache::ScopedStatement::operator->() {
+    return m_statement;
+}
+
+SQLiteStatement& SQLiteStatementCache::ScopedStatement::operator*() {
+    return *m_statement;
+}
+
+SQLiteStatementCache::~SQLiteStatementCache() {
+    clear();
+}
+
+SQLiteStatementCache::ScopedStatement SQLiteStatementCache::get(
+    sqlite3* dbHandle,
+    int id,
+    const std::string& sqlString) {
+    auto it = m_statements.find(id);
+    if (it != m_statements.end() && !it->second.inUse) {
+        if (it->second.statement->isValid()) {
+            it->second.inUse = true;
+            return ScopedStatement(it->second.statement.get(), &it->second.inUse, nullptr);
+        }
+        // The statement was finalized by a borrower, so prepare it again.
+        m_statements.erase(it);
+        it = m_statements.end();
+    }
+
+    std::unique_ptr<SQLiteStatement> statement(new SQLiteStatement(dbHandle, sqlString));
+    if (it != m_statements.end() || !statement->isValid()) {
+        if (it != m_statements.end()) {
+            ACSDK_DEBUG9(LX("getUncached").d("reason", "statementInUse").d("id", id));
+        }
+        auto raw = statement.get();
+        return ScopedStatement(raw, nullptr, std::move(statement));
+    }
+
+    auto& entry = m_statements[id];
+    entry.statement = std::move(statement);
+    entry.inUse = true;
+    return ScopedStatement(entry.statement.get(), &entry.inUse, nullptr);
+}
+
+void SQLiteStatementCache::clear() {
+    for (auto& entry : m_statements) {
+        if (entry.second.inUse) {
+            ACSDK_ERROR(LX("clearFailed").d("reason", "statementInUse").d("id", entry.first));
+        }
+    }
+    m_statements.clear();
+}
+
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
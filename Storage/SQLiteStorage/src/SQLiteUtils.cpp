@@ -21,9 +21,11 @@
 
 #include <AVSCommon/Utils/File/FileUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Metrics/MemoryAccounting.h>
 #include <AVSCommon/Utils/String/StringUtils.h>
 
 #include <fstream>
+#include <mutex>
 
 namespace alexaClientSDK {
 namespace storage {
@@ -31,6 +33,7 @@ namespace sqliteStorage {
 
 using namespace avsCommon::utils::file;
 using namespace avsCommon::utils::logger;
+using namespace avsCommon::utils::metrics;
 using namespace avsCommon::utils::string;
 
 /// String to identify log entries originating from this file.
@@ -43,6 +46,12 @@ static const std::string TAG("SQLiteUtils");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// The name of the savepoints marking the transactions of @c beginTransaction(), which may be nested.
+static const std::string TRANSACTION_SAVEPOINT_NAME = "acsdk_transaction";
+
+/// The name of the table recording the schema version of each component's tables.
+static const std::string SCHEMA_VERSIONS_TABLE_NAME = "schema_versions";
+
 /**
  * A utility function to open or create a SQLite database, depending on the flags being passed in.
  * The possible flags defined by SQLite for this operation are as follows:
@@ -62,6 +71,13 @@ static const std::string TAG("SQLiteUtils");
  * @return Whether the operation was successful.
  */
 static sqlite3* openSQLiteDatabaseHelper(const std::string& filePath, int sqliteFlags) {
+    // SQLite counts the memory of all its connections, page caches included.
+    static std::once_flag samplerFlag;
+    std::call_once(samplerFlag, []() {
+        MemoryAccounting::setSampler(
+            MemoryAccounting::Category::SQLITE, []() { return static_cast<uint64_t>(sqlite3_memory_used()); });
+    });
+
     sqlite3* dbHandle = nullptr;
 
     int rcode = sqlite3_open_v2(
@@ -281,6 +297,50 @@ bool tableExists(sqlite3* dbHandle, const std::string& tableName) {
     return (1 == count);
 }
 
+bool getSchemaVersion(sqlite3* dbHandle, const std::string& component, int* version) {
+    if (!dbHandle || !version) {
+        ACSDK_ERROR(LX("getSchemaVersionFailed").d("reason", "nullptr"));
+        return false;
+    }
+
+    *version = 0;
+    if (!tableExists(dbHandle, SCHEMA_VERSIONS_TABLE_NAME)) {
+        return true;
+    }
+
+    SQLiteStatement statement(
+        dbHandle, "SELECT version FROM " + SCHEMA_VERSIONS_TABLE_NAME + " WHERE component=?;");
+    if (!statement.isValid() || !statement.bindStringParameter(1, component) || !statement.step()) {
+        ACSDK_ERROR(LX("getSchemaVersionFailed").d("component", component));
+        return false;
+    }
+
+    const int RESULT_COLUMN_POSITION = 0;
+    if (SQLITE_ROW == statement.getStepResult()) {
+        *version = statement.getColumnInt(RESULT_COLUMN_POSITION);
+    }
+    return true;
+}
+
+bool setSchemaVersion(sqlite3* dbHandle, const std::string& component, int version) {
+    if (!performQuery(
+            dbHandle,
+            "CREATE TABLE IF NOT EXISTS " + SCHEMA_VERSIONS_TABLE_NAME +
+                " (component TEXT PRIMARY KEY NOT NULL, version INT NOT NULL);")) {
+        ACSDK_ERROR(LX("setSchemaVersionFailed").m("Table could not be created."));
+        return false;
+    }
+
+    SQLiteStatement statement(
+        dbHandle, "INSERT OR REPLACE INTO " + SCHEMA_VERSIONS_TABLE_NAME + " (component, version) VALUES (?, ?);");
+    if (!statement.isValid() || !statement.bindStringParameter(1, component) ||
+        !statement.bindIntParameter(2, version) || !statement.step()) {
+        ACSDK_ERROR(LX("setSchemaVersionFailed").d("component", component).d("version", version));
+        return false;
+    }
+    return true;
+}
+
 bool clearTable(sqlite3* dbHandle, const std::string& tableName) {
     if (!dbHandle) {
         ACSDK_ERROR(LX("clearTableFailed").m("dbHandle was nullptr."));
@@ -327,6 +387,67 @@ bool dropTable(sqlite3* dbHandle, const std::string& tableName) {
     return true;
 }
 
+bool enableWriteAheadLog(sqlite3* dbHandle) {
+    if (!dbHandle) {
+        ACSDK_ERROR(LX("enableWriteAheadLogFailed").m("dbHandle was nullptr."));
+        return false;
+    }
+
+    // The pragma returns the journal mode in effect, which is unchanged if WAL is not supported (eg. in-memory).
+    SQLiteStatement statement(dbHandle, "PRAGMA journal_mode=WAL;");
+
+    if (!statement.isValid()) {
+        ACSDK_ERROR(LX("enableWriteAheadLogFailed").m("Could not create statement."));
+        return false;
+    }
+
+    if (!statement.step() || statement.getStepResult() != SQLITE_ROW) {
+        ACSDK_ERROR(LX("enableWriteAheadLogFailed").m("Could not step to next row."));
+        return false;
+    }
+
+    const int RESULT_COLUMN_POSITION = 0;
+    std::string journalMode = statement.getColumnText(RESULT_COLUMN_POSITION);
+    if (journalMode != "wal") {
+        ACSDK_ERROR(LX("enableWriteAheadLogFailed").d("journalMode", journalMode));
+        return false;
+    }
+
+    return true;
+}
+
+bool setSynchronous(sqlite3* dbHandle, const std::string& level) {
+    if (level != "OFF" && level != "NORMAL" && level != "FULL" && level != "EXTRA") {
+        ACSDK_ERROR(LX("setSynchronousFailed").d("reason", "invalidLevel").d("level", level));
+        return false;
+    }
+
+    return performQuery(dbHandle, "PRAGMA synchronous=" + level + ";");
+}
+
+bool beginTransaction(sqlite3* dbHandle) {
+    // Outside of a transaction, a savepoint starts one; within one, it starts a nested transaction.
+    return performQuery(dbHandle, "SAVEPOINT " + TRANSACTION_SAVEPOINT_NAME + ";");
+}
+
+bool commitTransaction(sqlite3* dbHandle) {
+    if (performQuery(dbHandle, "RELEASE " + TRANSACTION_SAVEPOINT_NAME + ";")) {
+        return true;
+    }
+
+    // A failed commit may leave the transaction open for a retry.  End it, so the next transaction can begin.
+    if (dbHandle && !sqlite3_get_autocommit(dbHandle)) {
+        rollbackTransaction(dbHandle);
+    }
+    return false;
+}
+
+bool rollbackTransaction(sqlite3* dbHandle) {
+    // Rolling back to a savepoint keeps it open, so it is released after its changes are discarded.
+    return performQuery(dbHandle, "ROLLBACK TO " + TRANSACTION_SAVEPOINT_NAME + ";") &&
+           performQuery(dbHandle, "RELEASE " + TRANSACTION_SAVEPOINT_NAME + ";");
+}
+
 }  // namespace sqliteStorage
 }  // namespace storage
 }  // namespace alexaClientSDK
\ No newline at end of file
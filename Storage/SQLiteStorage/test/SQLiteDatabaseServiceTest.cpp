@@ -0,0 +1,236 @@
+/*
+ * SQLiteDatabaseServiceTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SQLiteDatabaseServiceTest.cpp
+
+#include <unistd.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/File/FileUtils.h>
+
+#include "SQLiteStorage/SQLiteDatabaseService.h"
+#include "SQLiteStorage/SQLiteUtils.h"
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+namespace test {
+
+using namespace avsCommon::utils::file;
+
+/// The name of the table used by the tests.
+static const std::string TABLE_NAME = "test";
+
+/// The SQL string to create the table used by the tests.
+static const std::string CREATE_TABLE_SQL_STRING = "CREATE TABLE " + TABLE_NAME + " (value INT NOT NULL);";
+
+/// A timeout long enough that a test waiting for it to expire would be reported as a failure.
+static const std::chrono::seconds LONG_TIMEOUT(10);
+
+/**
+ * Our GTest class.
+ */
+class SQLiteDatabaseServiceTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Build an operation inserting a row in the test table.
+     *
+     * @param value The value of the row.
+     * @return The operation.
+     */
+    static SQLiteDatabaseService::Operation insert(int value);
+
+    /**
+     * Keep the storage thread busy until @c release() is called, so that the operations submitted meanwhile are
+     * queued behind each other.
+     *
+     * @param onStart An operation run on the storage thread before waiting.
+     * @return A future for the result of the operation keeping the storage thread busy.
+     */
+    std::future<bool> block(SQLiteDatabaseService::Operation onStart = nullptr);
+
+    /**
+     * Let the storage thread go on after @c block().
+     */
+    void release();
+
+    /**
+     * Count the rows of the test table.
+     *
+     * @return The number of rows, or -1 if they could not be counted.
+     */
+    int countRows();
+
+    /// The path of the database file.
+    std::string m_filePath;
+
+    /// The service under test.
+    std::shared_ptr<SQLiteDatabaseService> m_service;
+
+    /// The promise set by @c release().
+    std::promise<void> m_release;
+};
+
+void SQLiteDatabaseServiceTest::SetUp() {
+    m_filePath = "/tmp/SQLiteDatabaseServiceTest." + std::to_string(getpid()) + ".db";
+    removeFile(m_filePath);
+    m_service = SQLiteDatabaseService::create(m_filePath);
+    ASSERT_TRUE(m_service);
+    ASSERT_TRUE(m_service->run([](sqlite3* dbHandle) { return performQuery(dbHandle, CREATE_TABLE_SQL_STRING); }));
+}
+
+void SQLiteDatabaseServiceTest::TearDown() {
+    m_service.reset();
+    removeFile(m_filePath);
+}
+
+SQLiteDatabaseService::Operation SQLiteDatabaseServiceTest::insert(int value) {
+    return [value](sqlite3* dbHandle) {
+        return performQuery(dbHandle, "INSERT INTO " + TABLE_NAME + " (value) VALUES (" + std::to_string(value) + ");");
+    };
+}
+
+std::future<bool> SQLiteDatabaseServiceTest::block(SQLiteDatabaseService::Operation onStart) {
+    auto started = std::make_shared<std::promise<void>>();
+    auto released = m_release.get_future().share();
+    auto result = m_service->submit([onStart, started, released](sqlite3* dbHandle) {
+        if (onStart) {
+            onStart(dbHandle);
+        }
+        started->set_value();
+        return released.wait_for(LONG_TIMEOUT) == std::future_status::ready;
+    });
+    started->get_future().wait_for(LONG_TIMEOUT);
+    return result;
+}
+
+void SQLiteDatabaseServiceTest::release() {
+    m_release.set_value();
+}
+
+int SQLiteDatabaseServiceTest::countRows() {
+    int numberRows = -1;
+    m_service->run([&numberRows](sqlite3* dbHandle) { return getNumberTableRows(dbHandle, TABLE_NAME, &numberRows); });
+    return numberRows;
+}
+
+/**
+ * Verify that a service can not be created without a file path.
+ */
+TEST_F(SQLiteDatabaseServiceTest, createWithoutFilePath) {
+    EXPECT_FALSE(SQLiteDatabaseService::create(""));
+}
+
+/**
+ * Verify that operations run on the storage thread, and that their changes are found again by a service re-created
+ * on the same file.
+ */
+TEST_F(SQLiteDatabaseServiceTest, operationsArePersisted) {
+    EXPECT_FALSE(m_service->isStorageThread());
+    auto onStorageThread = m_service->submit([this](sqlite3*) { return m_service->isStorageThread(); });
+    ASSERT_EQ(onStorageThread.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_TRUE(onStorageThread.get());
+
+    EXPECT_TRUE(m_service->submit(insert(1)).get());
+    EXPECT_TRUE(m_service->run(insert(2)));
+    m_service = SQLiteDatabaseService::create(m_filePath);
+    ASSERT_TRUE(m_service);
+    EXPECT_EQ(countRows(), 2);
+}
+
+/**
+ * Verify that the changes of a failed operation are rolled back, and those of the operations committed with it are
+ * kept.
+ */
+TEST_F(SQLiteDatabaseServiceTest, failedOperationIsRolledBack) {
+    auto blocker = block();
+    auto first = m_service->submit(insert(1));
+    auto failed = m_service->submit([](sqlite3* dbHandle) {
+        insert(2)(dbHandle);
+        return false;
+    });
+    auto last = m_service->submit(insert(3));
+    release();
+
+    EXPECT_TRUE(blocker.get());
+    EXPECT_TRUE(first.get());
+    EXPECT_FALSE(failed.get());
+    EXPECT_TRUE(last.get());
+    EXPECT_EQ(countRows(), 2);
+}
+
+/**
+ * Verify that the operations queued while the storage thread is busy are committed together.
+ */
+TEST_F(SQLiteDatabaseServiceTest, queuedOperationsAreCommittedTogether) {
+    int numberCommits = 0;
+    auto blocker = block([&numberCommits](sqlite3* dbHandle) {
+        sqlite3_commit_hook(
+            dbHandle,
+            [](void* numberCommits) {
+                ++*static_cast<int*>(numberCommits);
+                return 0;
+            },
+            &numberCommits);
+        return true;
+    });
+    std::vector<std::future<bool>> results;
+    for (int i = 0; i < 5; ++i) {
+        results.push_back(m_service->submit(insert(i)));
+    }
+    release();
+
+    EXPECT_TRUE(blocker.get());
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get());
+    }
+    // The operation installing the hook writes nothing, so the only commit is that of the operations queued behind it.
+    EXPECT_EQ(numberCommits, 1);
+    m_service->run([](sqlite3* dbHandle) {
+        sqlite3_commit_hook(dbHandle, nullptr, nullptr);
+        return true;
+    });
+    EXPECT_EQ(countRows(), 5);
+}
+
+/**
+ * Verify that an operation run from the storage thread is nested in the calling operation, and rolled back with it.
+ */
+TEST_F(SQLiteDatabaseServiceTest, nestedRunIsRolledBackWithCaller) {
+    auto result = m_service->submit([this](sqlite3*) {
+        EXPECT_TRUE(m_service->run(insert(1)));
+        return false;
+    });
+    ASSERT_EQ(result.wait_for(LONG_TIMEOUT), std::future_status::ready);
+    EXPECT_FALSE(result.get());
+    EXPECT_EQ(countRows(), 0);
+}
+
+}  // namespace test
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
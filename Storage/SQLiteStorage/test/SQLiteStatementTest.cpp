@@ -0,0 +1,130 @@
+/*
+ * SQLiteStatementTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SQLiteStatementTest.cpp
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SQLiteStorage/SQLiteStatement.h"
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+namespace test {
+
+/// The SQL string to create and fill the table used by the tests.
+static const std::string CREATE_TABLE_SQL_STRING =
+    "CREATE TABLE test (id INT NOT NULL, name TEXT);"
+    "INSERT INTO test VALUES (1, 'one');"
+    "INSERT INTO test VALUES (2, NULL);"
+    "INSERT INTO test VALUES (3, 'three');";
+
+/// The SQL string to read the table used by the tests.
+static const std::string SELECT_SQL_STRING = "SELECT * FROM test ORDER BY id;";
+
+/**
+ * Our GTest class.
+ */
+class SQLiteStatementTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /// The in-memory database holding the table used by the tests.
+    sqlite3* m_dbHandle = nullptr;
+};
+
+void SQLiteStatementTest::SetUp() {
+    ASSERT_EQ(sqlite3_open(":memory:", &m_dbHandle), SQLITE_OK);
+    ASSERT_EQ(sqlite3_exec(m_dbHandle, CREATE_TABLE_SQL_STRING.c_str(), nullptr, nullptr, nullptr), SQLITE_OK);
+}
+
+void SQLiteStatementTest::TearDown() {
+    sqlite3_close(m_dbHandle);
+}
+
+/**
+ * Verify that the columns are found by name, and that an unknown name is not found.
+ */
+TEST_F(SQLiteStatementTest, getColumnIndex) {
+    SQLiteStatement statement(m_dbHandle, SELECT_SQL_STRING);
+    ASSERT_TRUE(statement.isValid());
+    EXPECT_EQ(statement.getColumnIndex("id"), 0);
+    EXPECT_EQ(statement.getColumnIndex("name"), 1);
+    EXPECT_EQ(statement.getColumnIndex("unknown"), -1);
+}
+
+/**
+ * Verify that every row is visited in order, with the text read through views and a @c NULL read as empty.
+ */
+TEST_F(SQLiteStatementTest, forEachRowVisitsEveryRow) {
+    SQLiteStatement statement(m_dbHandle, SELECT_SQL_STRING);
+    ASSERT_TRUE(statement.isValid());
+    int idColumn = statement.getColumnIndex("id");
+    int nameColumn = statement.getColumnIndex("name");
+
+    std::vector<int> ids;
+    std::vector<std::string> names;
+    EXPECT_TRUE(statement.forEachRow([&](const SQLiteStatement& row) {
+        ids.push_back(row.getColumnInt(idColumn));
+        auto name = row.getColumnTextView(nameColumn);
+        EXPECT_EQ(name.size(), name.toString().size());
+        names.push_back(name.toString());
+        return true;
+    }));
+
+    EXPECT_EQ(ids, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(names, (std::vector<std::string>{"one", "", "three"}));
+    EXPECT_EQ(statement.getStepResult(), SQLITE_DONE);
+}
+
+/**
+ * Verify that the visit stops at the first row for which the visitor returns @c false.
+ */
+TEST_F(SQLiteStatementTest, forEachRowStopsEarly) {
+    SQLiteStatement statement(m_dbHandle, SELECT_SQL_STRING);
+    ASSERT_TRUE(statement.isValid());
+    int visited = 0;
+    EXPECT_FALSE(statement.forEachRow([&](const SQLiteStatement& row) {
+        ++visited;
+        return !(row.getColumnTextView(1) == "one");
+    }));
+    EXPECT_EQ(visited, 1);
+}
+
+/**
+ * Verify that a query returning no row visits nothing and succeeds.
+ */
+TEST_F(SQLiteStatementTest, forEachRowWithoutRows) {
+    SQLiteStatement statement(m_dbHandle, "SELECT * FROM test WHERE id > 3;");
+    ASSERT_TRUE(statement.isValid());
+    int visited = 0;
+    EXPECT_TRUE(statement.forEachRow([&](const SQLiteStatement&) {
+        ++visited;
+        return true;
+    }));
+    EXPECT_EQ(visited, 0);
+}
+
+}  // namespace test
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
@@ -0,0 +1,82 @@
+/*
+ * SQLiteUtilsTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SQLiteUtilsTest.cpp
+
+#include <gtest/gtest.h>
+
+#include "SQLiteStorage/SQLiteUtils.h"
+
+namespace alexaClientSDK {
+namespace storage {
+namespace sqliteStorage {
+namespace test {
+
+/**
+ * Our GTest class.
+ */
+class SQLiteUtilsTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /// The in-memory database used by the tests.
+    sqlite3* m_dbHandle = nullptr;
+};
+
+void SQLiteUtilsTest::SetUp() {
+    ASSERT_EQ(sqlite3_open(":memory:", &m_dbHandle), SQLITE_OK);
+}
+
+void SQLiteUtilsTest::TearDown() {
+    sqlite3_close(m_dbHandle);
+}
+
+/**
+ * Verify that a component which has not recorded a schema version reads as version zero.
+ */
+TEST_F(SQLiteUtilsTest, schemaVersionDefaultsToZero) {
+    int version = -1;
+    EXPECT_TRUE(getSchemaVersion(m_dbHandle, "alerts", &version));
+    EXPECT_EQ(version, 0);
+
+    ASSERT_TRUE(setSchemaVersion(m_dbHandle, "settings", 1));
+    version = -1;
+    EXPECT_TRUE(getSchemaVersion(m_dbHandle, "alerts", &version));
+    EXPECT_EQ(version, 0);
+}
+
+/**
+ * Verify that the schema versions are recorded per component, and that recording a version replaces the previous one.
+ */
+TEST_F(SQLiteUtilsTest, setSchemaVersion) {
+    ASSERT_TRUE(setSchemaVersion(m_dbHandle, "alerts", 2));
+    ASSERT_TRUE(setSchemaVersion(m_dbHandle, "settings", 1));
+    ASSERT_TRUE(setSchemaVersion(m_dbHandle, "alerts", 3));
+
+    int version = 0;
+    EXPECT_TRUE(getSchemaVersion(m_dbHandle, "alerts", &version));
+    EXPECT_EQ(version, 3);
+    EXPECT_TRUE(getSchemaVersion(m_dbHandle, "settings", &version));
+    EXPECT_EQ(version, 1);
+}
+
+}  // namespace test
+}  // namespace sqliteStorage
+}  // namespace storage
+}  // namespace alexaClientSDK
@@ -41,7 +41,6 @@ private:
 	};
 	
 	std::string boundary;
-	bool boundaryIndex[256];
 	std::vector<char> lookbehind;
 	State state;
 	int flags;
@@ -63,17 +62,6 @@ private:
 		userData      = NULL;
 	}
 	
-	void indexBoundary() {
-		const char *current;
-		const char *end = boundary.c_str() + boundary.size();
-		
-		memset(boundaryIndex, 0, sizeof(boundaryIndex));
-		
-		for (current = boundary.c_str(); current < end; current++) {
-			boundaryIndex[(unsigned char) *current] = true;
-		}
-	}
-	
 	void callback(Callback cb, const char *buffer = NULL, size_t start = UNMARKED,
 		size_t end = UNMARKED, bool allowEmpty = false)
 	{
@@ -105,10 +93,6 @@ private:
 		return c | 0x20;
 	}
 	
-	inline bool isBoundaryChar(char c) const {
-		return boundaryIndex[(unsigned char) c];
-	}
-	
 	bool isHeaderFieldCharacter(char c) const {
 		return (c >= 'a' && c <= 'z')
 			|| (c >= 'A' && c <= 'Z')
@@ -121,18 +105,30 @@ private:
 	}
 	
 	void processPartData(size_t &prevIndex, size_t &index, const char *buffer,
-		size_t len, size_t boundaryEnd, size_t &i, char c, State &state, int &flags)
+		size_t len, size_t &i, char c, State &state, int &flags)
 	{
 		prevIndex = index;
 		
 		if (index == 0) {
-			// boyer-moore derived algorithm to safely skip non-boundary data
-			while (i + boundary.size() <= len) {
-				if (isBoundaryChar(buffer[i + boundaryEnd])) {
+			// every boundary starts with CR, so skip straight to the next one
+			// with memchr and check for a whole boundary there with memcmp.
+			// a CR which does not start a boundary stays part of the run of
+			// data, so the run is reported in one callback rather than split
+			// around each CR.  a CR too close to the end of the buffer to be
+			// checked is left to the byte-at-a-time matching below.
+			while (i < len) {
+				const char *cr = (const char *) memchr(buffer + i, CR, len - i);
+				if (cr == NULL) {
+					i = len;
 					break;
 				}
-				
-				i += boundary.size();
+				i = cr - buffer;
+				if (len - i < boundary.size()
+					|| memcmp(buffer + i, boundary.data(), boundary.size()) == 0)
+				{
+					break;
+				}
+				i++;
 			}
 			if (i == len) {
 				return;
@@ -260,7 +256,6 @@ public:
 	void setBoundary(const std::string &boundary) {
 		reset();
 		this->boundary = "\r\n--" + boundary;
-		indexBoundary();
 		lookbehind.resize(boundary.size() + 8);
 		state = START;
 		errorReason = "No error.";
@@ -275,7 +270,6 @@ public:
 		int flags           = this->flags;
 		size_t prevIndex    = this->index;
 		size_t index        = this->index;
-		size_t boundaryEnd  = boundary.size() - 1;
 		size_t i;
 		char c, cl;
 		
@@ -380,7 +374,7 @@ public:
 				state = PART_DATA;
 				partDataMark = i;
 			case PART_DATA:
-				processPartData(prevIndex, index, buffer, len, boundaryEnd, i, c, state, flags);
+				processPartData(prevIndex, index, buffer, len, i, c, state, flags);
 				break;
 			default:
 				return i;
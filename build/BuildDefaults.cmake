@@ -30,5 +30,11 @@ include(MediaPlayer)
 # Setup PortAudio variables.
 include(PortAudio)
 
+# Setup Opus variables.
+include(Opus)
+
+# Setup event compression variables.
+include(EventCompression)
+
 # Setup Test Options variables.
 include(TestOptions)
\ No newline at end of file
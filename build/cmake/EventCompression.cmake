@@ -0,0 +1,17 @@
+#
+# Set up gzip compression of the metadata of events sent to AVS.
+#
+# To build with event compression, run the following command,
+#     cmake <path-to-source>
+#       -DEVENT_COMPRESSION=ON
+#
+# Compression must then also be enabled at run time, with "acl": {"compressEventMetadata": true}, and only for
+# endpoints which accept a gzip Content-Encoding on the metadata part of events.
+#
+
+option(EVENT_COMPRESSION "Enable gzip compression of the metadata of events sent to AVS." OFF)
+
+if(EVENT_COMPRESSION)
+    find_package(ZLIB REQUIRED)
+    add_definitions(-DEVENT_COMPRESSION)
+endif()
@@ -5,6 +5,10 @@
 #     -DACSDK_EMIT_SENSITIVE_LOGS=ON
 # Note that this option is only honored in DEBUG builds.
 #
+# To compile out all log lines below a given severity, include the following option on the cmake command line:
+#     -DACSDK_MIN_LOG_LEVEL=<DEBUG9|...|DEBUG0|INFO|WARN|ERROR|CRITICAL|NONE>
+# DEBUG levels are always compiled out of non-DEBUG builds.
+#
 
 option(ACSDK_EMIT_SENSITIVE_LOGS "Enable Logging of sensitive information." OFF)
 
@@ -17,3 +21,17 @@ if (ACSDK_EMIT_SENSITIVE_LOGS)
         message(FATAL_ERROR "FATAL_ERROR: ACSDK_EMIT_SENSITIVE_LOGS=ON in non-DEBUG build.")
     endif()
 endif()
+
+set(ACSDK_MIN_LOG_LEVEL "" CACHE STRING "Lowest severity of log lines to compile in.")
+set(ACSDK_LOG_LEVELS DEBUG9 DEBUG8 DEBUG7 DEBUG6 DEBUG5 DEBUG4 DEBUG3 DEBUG2 DEBUG1 DEBUG0 INFO WARN ERROR CRITICAL NONE)
+set_property(CACHE ACSDK_MIN_LOG_LEVEL PROPERTY STRINGS ${ACSDK_LOG_LEVELS})
+
+if (ACSDK_MIN_LOG_LEVEL)
+    string(TOUPPER ${ACSDK_MIN_LOG_LEVEL} MIN_LOG_LEVEL_UPPER)
+    list(FIND ACSDK_LOG_LEVELS ${MIN_LOG_LEVEL_UPPER} MIN_LOG_LEVEL_INDEX)
+    if (MIN_LOG_LEVEL_INDEX EQUAL -1)
+        message(FATAL_ERROR "FATAL_ERROR: Unknown ACSDK_MIN_LOG_LEVEL=${ACSDK_MIN_LOG_LEVEL}.")
+    endif()
+    message("Compiling out log lines below ${MIN_LOG_LEVEL_UPPER}.")
+    add_definitions(-DACSDK_MIN_LOG_LEVEL=ACSDK_LOG_LEVEL_${MIN_LOG_LEVEL_UPPER})
+endif()
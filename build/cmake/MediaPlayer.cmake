@@ -11,6 +11,6 @@ option(GSTREAMER_MEDIA_PLAYER "Enable GStreamer based media player." OFF)
 set(PKG_CONFIG_USE_CMAKE_PREFIX_PATH ON)
 if(GSTREAMER_MEDIA_PLAYER)
     find_package(PkgConfig)
-    pkg_check_modules(GST REQUIRED gstreamer-1.0>=1.8 gstreamer-app-1.0>=1.8)
+    pkg_check_modules(GST REQUIRED gstreamer-1.0>=1.8 gstreamer-app-1.0>=1.8 gstreamer-audio-1.0>=1.8)
     add_definitions(-DGSTREAMER_MEDIA_PLAYER)
 endif()
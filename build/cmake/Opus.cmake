@@ -0,0 +1,21 @@
+#
+# Set up the Opus encoder for the audio of Recognize events.
+#
+# To build with Opus, run the following command,
+#     cmake <path-to-source>
+#       -DOPUS=ON
+#           -DOPUS_LIB_PATH=<path-to-opus-lib>
+#           -DOPUS_INCLUDE_DIR=<path-to-opus-include-dir>
+#
+
+option(OPUS "Enable Opus encoding of the audio uploaded with Recognize events." OFF)
+
+if(OPUS)
+    if(NOT OPUS_LIB_PATH)
+        message(FATAL_ERROR "Must pass library path of Opus to enable it.")
+    endif()
+    if(NOT OPUS_INCLUDE_DIR)
+        message(FATAL_ERROR "Must pass include dir path of Opus to enable it.")
+    endif()
+    add_definitions(-DOPUS)
+endif()
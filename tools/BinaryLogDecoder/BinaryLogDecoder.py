@@ -0,0 +1,103 @@
+#
+# Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License").
+# You may not use this file except in compliance with the License.
+# A copy of the License is located at
+#
+#  http://aws.amazon.com/apache2.0
+#
+# or in the "license" file accompanying this file. This file is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+# express or implied. See the License for the specific language governing
+# permissions and limitations under the License.
+#
+
+# Converts a file written by BinaryLogger (see AVSCommon/Utils/include/AVSCommon/Utils/Logger/BinaryLogger.h) to the
+# text format written by ConsoleLogger.
+#
+# Usage: python BinaryLogDecoder.py <binaryLogFile> [<byteOrder>]
+# where <byteOrder> is '<' (little endian, the default) or '>' (big endian), matching the device that wrote the file.
+
+import struct
+import sys
+import time
+
+MAGIC = b'ACSDKBLG'
+VERSION = 1
+PADDING_LEVEL = 0xff
+
+# Layouts of BinaryLogFileHeader and BinaryLogRecordHeader, without the byte order prefix.
+FILE_HEADER_FORMAT = '8sIIIIIIqqQQ'
+RECORD_HEADER_FORMAT = 'IIIBBxxq'
+
+# Characters used for each Level, as returned by convertLevelToChar().
+LEVEL_CHARS = '9876543210IWECNU'
+
+
+def formatTime(nanoseconds):
+    seconds = nanoseconds // 1000000000
+    millis = (nanoseconds // 1000000) % 1000
+    return time.strftime('%Y-%m-%d %H:%M:%S', time.gmtime(seconds)) + '.%03d' % millis
+
+
+def decode(data, byteOrder):
+    fileHeaderFormat = byteOrder + FILE_HEADER_FORMAT
+    recordHeaderFormat = byteOrder + RECORD_HEADER_FORMAT
+    fileHeaderSize = struct.calcsize(fileHeaderFormat)
+    recordHeaderSize = struct.calcsize(recordHeaderFormat)
+
+    (magic, version, fileRecordHeaderSize, dictionarySize, ringSize, dictionaryUsed, dictionaryCount,
+     wallClockAnchor, monotonicAnchor, begin, end) = struct.unpack_from(fileHeaderFormat, data, 0)
+    if magic != MAGIC:
+        raise ValueError('not a binary log file')
+    if version != VERSION or fileRecordHeaderSize != recordHeaderSize:
+        raise ValueError('unsupported version %d (or wrong byte order)' % version)
+
+    names = [None]
+    offset = fileHeaderSize
+    dictionaryEnd = fileHeaderSize + dictionaryUsed
+    while offset < dictionaryEnd and len(names) <= dictionaryCount:
+        (length,) = struct.unpack_from(byteOrder + 'H', data, offset)
+        offset += 2
+        names.append(data[offset:offset + length].decode('utf-8', 'replace'))
+        offset += length
+
+    ring = fileHeaderSize + dictionarySize
+    position = begin
+    while position < end:
+        offset = position % ringSize
+        untilWrap = ringSize - offset
+        if untilWrap < recordHeaderSize:
+            position += untilWrap
+            continue
+        (length, sourceId, eventId, level, monikerLength, timestamp) = struct.unpack_from(
+            recordHeaderFormat, data, ring + offset)
+        if length < recordHeaderSize or length > untilWrap:
+            raise ValueError('corrupt record at position %d' % position)
+        position += length
+        if level == PADDING_LEVEL:
+            continue
+        body = data[ring + offset + recordHeaderSize:ring + offset + length]
+        moniker = body[:monikerLength].decode('utf-8', 'replace')
+        text = body[monikerLength:].decode('utf-8', 'replace')
+        if sourceId:
+            text = names[sourceId] + ':' + names[eventId] + text
+        levelChar = LEVEL_CHARS[level] if level < len(LEVEL_CHARS) else '?'
+        yield '%s [%s] %s %s' % (formatTime(wallClockAnchor + timestamp - monotonicAnchor), moniker, levelChar, text)
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.stderr.write('Usage: python BinaryLogDecoder.py <binaryLogFile> [<byteOrder>]\n')
+        return 1
+    byteOrder = sys.argv[2] if len(sys.argv) > 2 else '<'
+    with open(sys.argv[1], 'rb') as logFile:
+        data = logFile.read()
+    for line in decode(data, byteOrder):
+        print(line)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())